@@ -19,6 +19,26 @@
 
 namespace pw::allocator {
 
+size_t Allocator::DoAllocateBatch(Layout layout, span<void*> ptrs) {
+  size_t count = 0;
+  for (void*& ptr : ptrs) {
+    ptr = DoAllocate(layout);
+    if (ptr == nullptr) {
+      break;
+    }
+    ++count;
+  }
+  return count;
+}
+
+void Allocator::DoDeallocateBatch(span<void* const> ptrs, Layout layout) {
+  for (void* ptr : ptrs) {
+    if (ptr != nullptr) {
+      DoDeallocate(ptr, layout);
+    }
+  }
+}
+
 void* Allocator::DoReallocate(void* ptr, Layout layout, size_t new_size) {
   if (new_size == 0) {
     return nullptr;
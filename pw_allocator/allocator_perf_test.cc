@@ -0,0 +1,176 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/block_allocator.h"
+#include "pw_allocator/buffer.h"
+#include "pw_allocator/chunk_pool.h"
+#include "pw_allocator/freelist_heap.h"
+#include "pw_allocator/libc_allocator.h"
+#include "pw_allocator/test_harness.h"
+#include "pw_assert/assert.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_perf_test/state.h"
+#include "pw_random/xor_shift.h"
+
+namespace pw::allocator {
+namespace {
+
+// Benchmark parameters.
+//
+// Every benchmark replays the same synthetic trace of allocation,
+// deallocation, and reallocation requests, generated from `kSeed`. Each
+// iteration handles a single request, so the reported mean is the cost per
+// operation and the reported maximum is the worst-case latency.
+constexpr size_t kCapacity = 0x2000;
+constexpr size_t kMaxSize = 0x100;
+constexpr size_t kMaxAllocations = 64;
+constexpr size_t kNumRequests = 1000;
+constexpr uint64_t kSeed = 0x5eed;
+
+/// Test harness that forwards generated requests to a given allocator.
+class Benchmark : public test::AllocatorTestHarness<kMaxAllocations> {
+ public:
+  explicit Benchmark(Allocator& allocator) : allocator_(allocator) {}
+
+ private:
+  Allocator* Init() override { return &allocator_; }
+
+  Allocator& allocator_;
+};
+
+/// Adapts `FreeListHeap` to the `Allocator` interface.
+class FreeListHeapAllocator : public Allocator {
+ public:
+  explicit FreeListHeapAllocator(ByteSpan region) : heap_(region) {}
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override {
+    void* ptr = heap_.Allocate(layout.size());
+    if (reinterpret_cast<uintptr_t>(ptr) % layout.alignment() != 0) {
+      heap_.Free(ptr);
+      return nullptr;
+    }
+    return ptr;
+  }
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, Layout) override { heap_.Free(ptr); }
+
+  FreeListHeapBuffer<> heap_;
+};
+
+/// Handles generated requests until the perf test framework stops.
+void PerformRequests(perf_test::State& state, Allocator& allocator) {
+  Benchmark benchmark(allocator);
+  random::XorShiftStarRng64 prng(kSeed);
+  while (state.KeepRunning()) {
+    benchmark.GenerateRequest(prng, kMaxSize);
+  }
+  benchmark.Reset();
+}
+
+/// Returns the portion of a block allocator's free memory that is not part
+/// of its largest free block, in percent.
+template <typename BlockAllocatorType>
+size_t GetFragmentation(const BlockAllocatorType& allocator) {
+  size_t total = 0;
+  size_t largest = 0;
+  for (const auto* block : allocator.blocks()) {
+    if (!block->Used()) {
+      total += block->InnerSize();
+      largest = std::max(largest, block->InnerSize());
+    }
+  }
+  return total == 0 ? 0 : ((total - largest) * 100) / total;
+}
+
+/// Replays the trace without timing it, and logs the peak fragmentation.
+template <typename BlockAllocatorType>
+void LogPeakFragmentation(const char* name, BlockAllocatorType& allocator) {
+  Benchmark benchmark(allocator);
+  random::XorShiftStarRng64 prng(kSeed);
+  size_t peak = 0;
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    benchmark.GenerateRequest(prng, kMaxSize);
+    peak = std::max(peak, GetFragmentation(allocator));
+  }
+  benchmark.Reset();
+  PW_LOG_INFO("%s: peak fragmentation is %u%%",
+              name,
+              static_cast<unsigned>(peak));
+}
+
+template <typename BlockAllocatorType>
+void BlockAllocatorPerfTest(perf_test::State& state, const char* name) {
+  static WithBuffer<BlockAllocatorType, kCapacity> allocator;
+  PW_ASSERT(allocator->Init(allocator.as_bytes()).ok());
+  PerformRequests(state, *allocator);
+  LogPeakFragmentation(name, *allocator);
+  allocator->Reset();
+}
+
+void DualFirstFitPerfTest(perf_test::State& state) {
+  using DualFirstFit = DualFirstFitBlockAllocator<uint16_t>;
+  static WithBuffer<DualFirstFit, kCapacity> allocator;
+  PW_ASSERT(allocator->Init(allocator.as_bytes()).ok());
+  allocator->set_threshold(kMaxSize / 2);
+  PerformRequests(state, *allocator);
+  LogPeakFragmentation("DualFirstFit", *allocator);
+  allocator->Reset();
+}
+
+void FreeListHeapPerfTest(perf_test::State& state) {
+  alignas(uintptr_t) static std::array<std::byte, kCapacity> buffer;
+  FreeListHeapAllocator allocator(buffer);
+  PerformRequests(state, allocator);
+}
+
+void LibCAllocatorPerfTest(perf_test::State& state) {
+  LibCAllocator allocator;
+  PerformRequests(state, allocator);
+}
+
+void ChunkPoolPerfTest(perf_test::State& state) {
+  // Each chunk can satisfy any generated request.
+  alignas(kMaxSize) static std::array<std::byte, kCapacity> buffer;
+  ChunkPool allocator(buffer, Layout(kMaxSize, kMaxSize));
+  PerformRequests(state, allocator);
+}
+
+using FirstFit = FirstFitBlockAllocator<uint16_t>;
+using LastFit = LastFitBlockAllocator<uint16_t>;
+using BestFit = BestFitBlockAllocator<uint16_t>;
+using WorstFit = WorstFitBlockAllocator<uint16_t>;
+using Tlsf = TlsfBlockAllocator<uint16_t>;
+
+PW_PERF_TEST(FirstFitPerfTest, BlockAllocatorPerfTest<FirstFit>, "FirstFit");
+PW_PERF_TEST(LastFitPerfTest, BlockAllocatorPerfTest<LastFit>, "LastFit");
+PW_PERF_TEST(BestFitPerfTest, BlockAllocatorPerfTest<BestFit>, "BestFit");
+PW_PERF_TEST(WorstFitPerfTest, BlockAllocatorPerfTest<WorstFit>, "WorstFit");
+PW_PERF_TEST(DualFirstFitPerfTest, DualFirstFitPerfTest);
+PW_PERF_TEST(TlsfPerfTest, BlockAllocatorPerfTest<Tlsf>, "Tlsf");
+PW_PERF_TEST(FreeListHeapPerfTest, FreeListHeapPerfTest);
+PW_PERF_TEST(LibCAllocatorPerfTest, LibCAllocatorPerfTest);
+PW_PERF_TEST(ChunkPoolPerfTest, ChunkPoolPerfTest);
+
+}  // namespace
+}  // namespace pw::allocator
@@ -14,9 +14,11 @@
 
 #include "pw_allocator/allocator.h"
 
+#include <array>
 #include <cstddef>
 
 #include "pw_allocator/testing.h"
+#include "pw_span/span.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::allocator {
@@ -179,6 +181,48 @@ class DerivedAllocator : public BaseAllocator {
   size_t value_;
 };
 
+TEST(AllocatorTest, AllocateBatch) {
+  test::AllocatorForTest<256> allocator;
+  constexpr Layout layout = Layout::Of<uint32_t[2]>();
+  std::array<void*, 4> ptrs;
+  EXPECT_EQ(allocator.AllocateBatch(layout, span(ptrs)), ptrs.size());
+  for (void* ptr : ptrs) {
+    EXPECT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(allocator.metrics().num_allocations.value(), ptrs.size());
+  EXPECT_EQ(allocator.metrics().num_failures.value(), 0U);
+
+  allocator.DeallocateBatch(span(ptrs), layout);
+  EXPECT_EQ(allocator.metrics().num_deallocations.value(), ptrs.size());
+}
+
+TEST(AllocatorTest, AllocateBatchZeroSize) {
+  test::AllocatorForTest<256> allocator;
+  std::array<void*, 4> ptrs;
+  EXPECT_EQ(allocator.AllocateBatch(Layout(0, 1), span(ptrs)), 0U);
+  for (void* ptr : ptrs) {
+    EXPECT_EQ(ptr, nullptr);
+  }
+}
+
+TEST(AllocatorTest, AllocateBatchPartialFailure) {
+  test::AllocatorForTest<256> allocator;
+  constexpr Layout layout = Layout::Of<std::byte[64]>();
+  std::array<void*, 8> ptrs;
+  size_t count = allocator.AllocateBatch(layout, span(ptrs));
+  EXPECT_GT(count, 0U);
+  EXPECT_LT(count, ptrs.size());
+  for (size_t i = count; i < ptrs.size(); ++i) {
+    EXPECT_EQ(ptrs[i], nullptr);
+  }
+  EXPECT_EQ(allocator.metrics().num_allocations.value(), count);
+  EXPECT_EQ(allocator.metrics().num_failures.value(), 1U);
+
+  // Null pointers are skipped.
+  allocator.DeallocateBatch(span(ptrs), layout);
+  EXPECT_EQ(allocator.metrics().num_deallocations.value(), count);
+}
+
 TEST(AllocatorTest, IsEqualFailsWithDifferentObjects) {
   std::array<std::byte, 8> buffer;
   DerivedAllocator derived1(1, buffer.data());
@@ -15,6 +15,7 @@
 #include "pw_allocator/block_allocator.h"
 
 #include <cstdint>
+#include <cstring>
 #include <limits>
 
 #include "pw_allocator/allocator.h"
@@ -23,6 +24,7 @@
 #include "pw_assert/check.h"
 #include "pw_bytes/alignment.h"
 #include "pw_bytes/span.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_unit_test/framework.h"
 #include "pw_unit_test/framework_backend.h"
@@ -245,12 +247,13 @@ void UseMemory(void* ptr, size_t size) { std::memset(ptr, 0x5a, size); }
     test_case(test_fixture);                                        \
   }
 
-#define TEST_FOREACH_STRATEGY(test_case) \
-  TEST_ONE_STRATEGY(FirstFit, test_case) \
-  TEST_ONE_STRATEGY(LastFit, test_case)  \
-  TEST_ONE_STRATEGY(BestFit, test_case)  \
-  TEST_ONE_STRATEGY(WorstFit, test_case) \
-  TEST_ONE_STRATEGY(DualFirstFit, test_case)
+#define TEST_FOREACH_STRATEGY(test_case)   \
+  TEST_ONE_STRATEGY(FirstFit, test_case)     \
+  TEST_ONE_STRATEGY(LastFit, test_case)      \
+  TEST_ONE_STRATEGY(BestFit, test_case)      \
+  TEST_ONE_STRATEGY(WorstFit, test_case)     \
+  TEST_ONE_STRATEGY(DualFirstFit, test_case) \
+  TEST_ONE_STRATEGY(Tlsf, test_case)
 
 // Unit tests.
 
@@ -264,6 +267,7 @@ TEST_ONE_STRATEGY(FirstFit, CanAutomaticallyInit)
 TEST_ONE_STRATEGY(LastFit, CanAutomaticallyInit)
 TEST_ONE_STRATEGY(BestFit, CanAutomaticallyInit)
 TEST_ONE_STRATEGY(WorstFit, CanAutomaticallyInit)
+TEST_ONE_STRATEGY(Tlsf, CanAutomaticallyInit)
 TEST(BlockAllocatorTest, CanAutomaticallyInit_DualFirstFit) {
   std::array<std::byte, kCapacity> buffer;
   ByteSpan bytes(buffer);
@@ -453,6 +457,76 @@ TEST(DualFirstFit, AllocatesUsingThreshold) {
   EXPECT_EQ(test_fixture.NextAfter(2), test_fixture[3]);
 }
 
+TEST(Tlsf, AllocatesFromSizeClass) {
+  TestFixture<TlsfBlockAllocator<OffsetType>> test_fixture;
+  auto& allocator = test_fixture.GetAllocator({
+      {kLargerOuterSize, Preallocation::kIndexFree},
+      {kSmallerOuterSize, 1},
+      {kLargeOuterSize, Preallocation::kIndexFree},
+      {Preallocation::kSizeRemaining, 3},
+  });
+
+  // The request is satisfied by the block in its size class, even though the
+  // first block could also hold it.
+  test_fixture[2] = allocator.Allocate(Layout(kLargeInnerSize, 1));
+  EXPECT_EQ(test_fixture.NextAfter(1), test_fixture[2]);
+  EXPECT_EQ(test_fixture.NextAfter(2), test_fixture[3]);
+  test_fixture[0] = allocator.Allocate(Layout(kLargeInnerSize, 1));
+  EXPECT_EQ(test_fixture.NextAfter(0), test_fixture[1]);
+  EXPECT_EQ(allocator.Allocate(Layout(kLargeInnerSize, 1)), nullptr);
+}
+
+TEST(Tlsf, ReindexesMergedBlocks) {
+  TestFixture<TlsfBlockAllocator<OffsetType>> test_fixture;
+  auto& allocator = test_fixture.GetAllocator();
+  constexpr Layout kSmall = Layout::Of<std::byte[kSmallInnerSize]>();
+  for (size_t i = 0; i < kNumPtrs; ++i) {
+    test_fixture[i] = allocator.Allocate(kSmall);
+    ASSERT_NE(test_fixture[i], nullptr);
+  }
+
+  // Free every other block, then the rest, to exercise merging both ways.
+  for (size_t i = 0; i < kNumPtrs; i += 2) {
+    allocator.Deallocate(test_fixture[i], kSmall);
+    test_fixture[i] = nullptr;
+  }
+  for (size_t i = 1; i < kNumPtrs; i += 2) {
+    allocator.Deallocate(test_fixture[i], kSmall);
+    test_fixture[i] = nullptr;
+  }
+
+  // All the memory should be available in a single block again.
+  size_t num_blocks = 0;
+  for (auto* block : allocator.blocks()) {
+    EXPECT_FALSE(block->Used());
+    ++num_blocks;
+  }
+  EXPECT_EQ(num_blocks, 1U);
+  constexpr Layout kHalf = Layout::Of<std::byte[kCapacity / 2]>();
+  test_fixture[0] = allocator.Allocate(kHalf);
+  ASSERT_NE(test_fixture[0], nullptr);
+  UseMemory(test_fixture[0], kHalf.size());
+}
+
+TEST(Tlsf, ResizeReindexesTrailingBlock) {
+  TestFixture<TlsfBlockAllocator<OffsetType>> test_fixture;
+  auto& allocator = test_fixture.GetAllocator({
+      {kLargeOuterSize, 0},
+      {kLargeOuterSize, Preallocation::kIndexFree},
+      {Preallocation::kSizeRemaining, 2},
+  });
+
+  // Shrinking returns space to the trailing free block.
+  Layout old_layout(kLargeInnerSize, 1);
+  ASSERT_TRUE(allocator.Resize(test_fixture[0], old_layout, kSmallInnerSize));
+
+  // The enlarged trailing block can satisfy a request it could not before.
+  size_t inner_size = kLargeInnerSize + kLargeInnerSize / 2;
+  test_fixture[1] = allocator.Allocate(Layout(inner_size, 1));
+  ASSERT_NE(test_fixture[1], nullptr);
+  UseMemory(test_fixture[1], inner_size);
+}
+
 template <typename TestFixtureType>
 void DeallocateNull(TestFixtureType& test_fixture) {
   auto& allocator = test_fixture.GetAllocator();
@@ -490,6 +564,156 @@ void DeallocateShuffled(TestFixtureType& test_fixture) {
 }
 TEST_FOREACH_STRATEGY(DeallocateShuffled)
 
+template <typename TestFixtureType>
+void AllocateBatch(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator();
+  constexpr Layout layout = Layout::Of<std::byte[kSmallInnerSize]>();
+  std::array<void*, kNumPtrs> ptrs;
+  EXPECT_EQ(allocator.AllocateBatch(layout, span(ptrs)), kNumPtrs);
+  for (size_t i = 0; i < kNumPtrs; ++i) {
+    ASSERT_NE(ptrs[i], nullptr);
+    UseMemory(ptrs[i], kSmallInnerSize);
+    for (size_t j = 0; j < i; ++j) {
+      EXPECT_NE(ptrs[i], ptrs[j]);
+    }
+  }
+  allocator.DeallocateBatch(span(ptrs), layout);
+
+  // All memory should have been returned and merged.
+  void* ptr = allocator.Allocate(Layout(kCapacity / 2, 1));
+  EXPECT_NE(ptr, nullptr);
+  allocator.Deallocate(ptr, Layout(kCapacity / 2, 1));
+}
+TEST_FOREACH_STRATEGY(AllocateBatch)
+
+template <typename TestFixtureType>
+void AllocateBatchPartial(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator();
+  constexpr Layout layout = Layout::Of<std::byte[kLargeInnerSize]>();
+  std::array<void*, kNumPtrs> ptrs;
+  size_t count = allocator.AllocateBatch(layout, span(ptrs));
+  EXPECT_GT(count, 0U);
+  EXPECT_LT(count, kNumPtrs);
+  for (size_t i = 0; i < kNumPtrs; ++i) {
+    if (i < count) {
+      EXPECT_NE(ptrs[i], nullptr);
+    } else {
+      EXPECT_EQ(ptrs[i], nullptr);
+    }
+  }
+
+  // Null pointers are ignored.
+  allocator.DeallocateBatch(span(ptrs), layout);
+}
+TEST_FOREACH_STRATEGY(AllocateBatchPartial)
+
+TEST(BlockAllocatorTest, AllocateBatchIsContiguous) {
+  TestFixture<FirstFitBlockAllocator<OffsetType>> test_fixture;
+  auto& allocator = test_fixture.GetAllocator();
+  using BlockType = FirstFitBlockAllocator<OffsetType>::BlockType;
+  constexpr Layout layout = Layout::Of<std::byte[kSmallInnerSize]>();
+  std::array<void*, 4> ptrs;
+  ASSERT_EQ(allocator.AllocateBatch(layout, span(ptrs)), ptrs.size());
+  for (size_t i = 1; i < ptrs.size(); ++i) {
+    BlockType* prev = BlockType::FromUsableSpace(ptrs[i - 1]);
+    EXPECT_EQ(prev->Next(), BlockType::FromUsableSpace(ptrs[i]));
+  }
+  allocator.DeallocateBatch(span(ptrs), layout);
+}
+
+template <typename TestFixtureType>
+void DeferredCoalescingReusesBlock(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator();
+  allocator.SetMaxDeferred(4);
+  constexpr Layout layout = Layout::Of<std::byte[kSmallInnerSize]>();
+  test_fixture[0] = allocator.Allocate(layout);
+  ASSERT_NE(test_fixture[0], nullptr);
+  void* ptr = test_fixture[0];
+  allocator.Deallocate(test_fixture[0], layout);
+  test_fixture[0] = nullptr;
+  EXPECT_EQ(allocator.num_deferred(), 1U);
+
+  // The parked block is reused for an allocation of the same size.
+  test_fixture[0] = allocator.Allocate(layout);
+  EXPECT_EQ(test_fixture[0], ptr);
+  EXPECT_EQ(allocator.num_deferred(), 0U);
+}
+TEST_FOREACH_STRATEGY(DeferredCoalescingReusesBlock)
+
+template <typename TestFixtureType>
+void DeferredCoalescingCompact(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator();
+  allocator.SetMaxDeferred(4);
+  constexpr Layout layout = Layout::Of<std::byte[kSmallInnerSize]>();
+  for (size_t i = 0; i < 6; ++i) {
+    test_fixture[i] = allocator.Allocate(layout);
+    ASSERT_NE(test_fixture[i], nullptr);
+  }
+  for (size_t i = 0; i < 6; ++i) {
+    allocator.Deallocate(test_fixture[i], layout);
+    test_fixture[i] = nullptr;
+  }
+
+  // Blocks beyond the limit are freed eagerly.
+  EXPECT_EQ(allocator.num_deferred(), 4U);
+  size_t num_used = 0;
+  for (const auto* block : allocator.blocks()) {
+    num_used += block->Used() ? 1 : 0;
+  }
+  EXPECT_EQ(num_used, 4U);
+
+  allocator.Compact();
+  EXPECT_EQ(allocator.num_deferred(), 0U);
+  for (const auto* block : allocator.blocks()) {
+    EXPECT_FALSE(block->Used());
+  }
+}
+TEST_FOREACH_STRATEGY(DeferredCoalescingCompact)
+
+template <typename TestFixtureType>
+void DeferredCoalescingOnExhaustion(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator();
+  allocator.SetMaxDeferred(kNumPtrs);
+  constexpr Layout layout = Layout::Of<std::byte[kLargeInnerSize]>();
+  size_t count = 0;
+  for (; count < kNumPtrs; ++count) {
+    test_fixture[count] = allocator.Allocate(layout);
+    if (test_fixture[count] == nullptr) {
+      break;
+    }
+  }
+  for (size_t i = 0; i < count; ++i) {
+    allocator.Deallocate(test_fixture[i], layout);
+    test_fixture[i] = nullptr;
+  }
+  EXPECT_EQ(allocator.num_deferred(), count);
+
+  // A request that no parked block can satisfy merges the parked blocks.
+  constexpr Layout large_layout(kCapacity / 2, 1);
+  test_fixture[0] = allocator.Allocate(large_layout);
+  EXPECT_NE(test_fixture[0], nullptr);
+  EXPECT_EQ(allocator.num_deferred(), 0U);
+}
+TEST_FOREACH_STRATEGY(DeferredCoalescingOnExhaustion)
+
+TEST(BlockAllocatorTest, SetMaxDeferredCompacts) {
+  TestFixture<FirstFitBlockAllocator<OffsetType>> test_fixture;
+  auto& allocator = test_fixture.GetAllocator();
+  allocator.SetMaxDeferred(4);
+  constexpr Layout layout = Layout::Of<std::byte[kSmallInnerSize]>();
+  for (size_t i = 0; i < 2; ++i) {
+    test_fixture[i] = allocator.Allocate(layout);
+    ASSERT_NE(test_fixture[i], nullptr);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    allocator.Deallocate(test_fixture[i], layout);
+    test_fixture[i] = nullptr;
+  }
+  EXPECT_EQ(allocator.num_deferred(), 2U);
+  allocator.SetMaxDeferred(1);
+  EXPECT_EQ(allocator.num_deferred(), 0U);
+}
+
 TEST(BlockAllocatorTest, DisablePoisoning) {
   using BlockAllocatorType = FirstFitBlockAllocator<OffsetType, 0>;
   using BlockType = BlockAllocatorType::BlockType;
@@ -757,6 +981,87 @@ void ResizeSmallLargerFailure(TestFixtureType& test_fixture) {
 }
 TEST_FOREACH_STRATEGY(ResizeSmallLargerFailure)
 
+template <typename TestFixtureType>
+void ReallocateLargerInPlace(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator({
+      {kLargeOuterSize, 0},
+      {kLargeOuterSize, Preallocation::kIndexFree},
+      {kSmallOuterSize, 2},
+  });
+  void* ptr = test_fixture[0];
+  Layout old_layout(kLargeInnerSize, 1);
+  size_t new_size = kLargeInnerSize * 2;
+  test_fixture[0] = allocator.Reallocate(ptr, old_layout, new_size);
+  EXPECT_EQ(test_fixture[0], ptr);
+  UseMemory(test_fixture[0], kLargeInnerSize * 2);
+}
+TEST_FOREACH_STRATEGY(ReallocateLargerInPlace)
+
+template <typename TestFixtureType>
+void ReallocateLargerIntoPrev(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator({
+      {kLargeOuterSize, Preallocation::kIndexFree},
+      {kLargeOuterSize, 0},
+      {kSmallOuterSize, 2},
+  });
+  void* ptr = test_fixture[0];
+  auto* bytes = static_cast<uint8_t*>(ptr);
+  for (size_t i = 0; i < kLargeInnerSize; ++i) {
+    bytes[i] = static_cast<uint8_t>(i);
+  }
+  Layout old_layout(kLargeInnerSize, 1);
+  size_t new_size = kLargeInnerSize * 2;
+  test_fixture[0] = allocator.Reallocate(ptr, old_layout, new_size);
+  ASSERT_NE(test_fixture[0], nullptr);
+  EXPECT_LT(test_fixture[0], ptr);
+  bytes = static_cast<uint8_t*>(test_fixture[0]);
+  for (size_t i = 0; i < kLargeInnerSize; ++i) {
+    EXPECT_EQ(bytes[i], static_cast<uint8_t>(i));
+  }
+  UseMemory(test_fixture[0], kLargeInnerSize * 2);
+}
+TEST_FOREACH_STRATEGY(ReallocateLargerIntoPrev)
+
+template <typename TestFixtureType>
+void ReallocateLargerMoves(TestFixtureType& test_fixture) {
+  auto& allocator = test_fixture.GetAllocator({
+      {kLargeOuterSize, 0},
+      {kSmallOuterSize, 1},
+  });
+  void* ptr = test_fixture[0];
+  std::memset(ptr, 0x5a, kLargeInnerSize);
+  Layout old_layout(kLargeInnerSize, 1);
+  size_t new_size = kLargeInnerSize * 2;
+  test_fixture[0] = allocator.Reallocate(ptr, old_layout, new_size);
+  ASSERT_NE(test_fixture[0], nullptr);
+  EXPECT_NE(test_fixture[0], ptr);
+  auto* bytes = static_cast<uint8_t*>(test_fixture[0]);
+  for (size_t i = 0; i < kLargeInnerSize; ++i) {
+    EXPECT_EQ(bytes[i], 0x5a);
+  }
+}
+TEST_FOREACH_STRATEGY(ReallocateLargerMoves)
+
+TEST(BlockAllocatorTest, ReallocateIntoPoisonedPrev) {
+  using BlockAllocatorType = FirstFitBlockAllocator<OffsetType, 1>;
+  TestFixture<BlockAllocatorType> test_fixture;
+  auto& allocator = test_fixture.GetAllocator();
+  constexpr Layout layout = Layout::Of<std::byte[kLargeInnerSize]>();
+  void* prev = allocator.Allocate(layout);
+  ASSERT_NE(prev, nullptr);
+  test_fixture[0] = allocator.Allocate(layout);
+  ASSERT_NE(test_fixture[0], nullptr);
+  test_fixture[1] = allocator.Allocate(layout);
+  ASSERT_NE(test_fixture[1], nullptr);
+
+  // Poisoned memory is overwritten by the moved data without triggering a
+  // corruption check.
+  allocator.Deallocate(prev, layout);
+  test_fixture[0] =
+      allocator.Reallocate(test_fixture[0], layout, kLargeInnerSize * 2);
+  EXPECT_EQ(test_fixture[0], prev);
+}
+
 TEST(DualFirstFit, ResizeLargeSmallerAcrossThreshold) {
   TestFixture<DualFirstFitBlockAllocator<OffsetType>> test_fixture;
   auto& allocator = test_fixture.GetAllocator({{kDualFitThreshold * 2, 0}});
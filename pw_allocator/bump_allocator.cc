@@ -0,0 +1,67 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/bump_allocator.h"
+
+#include <cstdint>
+
+#include "pw_bytes/alignment.h"
+
+namespace pw::allocator {
+
+void BumpAllocator::Init(ByteSpan region) {
+  region_ = region;
+  offset_ = 0;
+}
+
+void BumpAllocator::RollBack(Checkpoint checkpoint) {
+  if (checkpoint.offset_ < offset_) {
+    offset_ = checkpoint.offset_;
+  }
+}
+
+void* BumpAllocator::DoAllocate(Layout layout) {
+  auto begin = reinterpret_cast<uintptr_t>(region_.data());
+  uintptr_t addr = AlignUp(begin + offset_, layout.alignment());
+  size_t offset = addr - begin;
+  if (offset > region_.size() || region_.size() - offset < layout.size()) {
+    return nullptr;
+  }
+  offset_ = offset + layout.size();
+  return region_.data() + offset;
+}
+
+bool BumpAllocator::DoResize(void* ptr, Layout layout, size_t new_size) {
+  auto* bytes = static_cast<std::byte*>(ptr);
+  if (bytes < region_.data() ||
+      bytes + layout.size() != region_.data() + offset_) {
+    return false;
+  }
+  size_t offset = static_cast<size_t>(bytes - region_.data());
+  if (region_.size() - offset < new_size) {
+    return false;
+  }
+  offset_ = offset + new_size;
+  return true;
+}
+
+Status BumpAllocator::DoQuery(const void* ptr, Layout) const {
+  const auto* bytes = static_cast<const std::byte*>(ptr);
+  if (bytes < region_.data() || bytes >= region_.data() + offset_) {
+    return Status::OutOfRange();
+  }
+  return OkStatus();
+}
+
+}  // namespace pw::allocator
@@ -0,0 +1,152 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/bump_allocator.h"
+
+#include <array>
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::allocator {
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kCapacity = 256;
+
+class BumpAllocatorTest : public ::testing::Test {
+ protected:
+  BumpAllocatorTest() { allocator_.Init(buffer_); }
+
+  alignas(uint64_t) std::array<std::byte, kCapacity> buffer_;
+  BumpAllocator allocator_;
+};
+
+// Unit tests.
+
+TEST_F(BumpAllocatorTest, AllocatesSequentially) {
+  void* ptr1 = allocator_.Allocate(Layout(16, 1));
+  void* ptr2 = allocator_.Allocate(Layout(16, 1));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_EQ(ptr1, buffer_.data());
+  EXPECT_EQ(ptr2, buffer_.data() + 16);
+  EXPECT_EQ(allocator_.used(), 32U);
+}
+
+TEST_F(BumpAllocatorTest, AlignsAllocations) {
+  ASSERT_NE(allocator_.Allocate(Layout(1, 1)), nullptr);
+  void* ptr = allocator_.Allocate(Layout(8, alignof(uint64_t)));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(uint64_t), 0U);
+  EXPECT_EQ(allocator_.used(), 16U);
+}
+
+TEST_F(BumpAllocatorTest, AllocateFailsWhenExhausted) {
+  EXPECT_NE(allocator_.Allocate(Layout(kCapacity - 8, 1)), nullptr);
+  EXPECT_EQ(allocator_.Allocate(Layout(16, 1)), nullptr);
+  EXPECT_NE(allocator_.Allocate(Layout(8, 1)), nullptr);
+  EXPECT_EQ(allocator_.Allocate(Layout(1, 1)), nullptr);
+}
+
+TEST_F(BumpAllocatorTest, DeallocateDoesNotReclaimMemory) {
+  void* ptr = allocator_.Allocate(Layout(16, 1));
+  ASSERT_NE(ptr, nullptr);
+  allocator_.Deallocate(ptr, Layout(16, 1));
+  EXPECT_EQ(allocator_.used(), 16U);
+  EXPECT_NE(allocator_.Allocate(Layout(16, 1)), ptr);
+}
+
+TEST_F(BumpAllocatorTest, ResizeMostRecentAllocation) {
+  void* ptr1 = allocator_.Allocate(Layout(16, 1));
+  void* ptr2 = allocator_.Allocate(Layout(16, 1));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_FALSE(allocator_.Resize(ptr1, Layout(16, 1), 32));
+  EXPECT_TRUE(allocator_.Resize(ptr2, Layout(16, 1), 32));
+  EXPECT_EQ(allocator_.used(), 48U);
+  EXPECT_TRUE(allocator_.Resize(ptr2, Layout(32, 1), 8));
+  EXPECT_EQ(allocator_.used(), 24U);
+  EXPECT_FALSE(allocator_.Resize(ptr2, Layout(8, 1), kCapacity));
+}
+
+TEST_F(BumpAllocatorTest, Reset) {
+  void* ptr = allocator_.Allocate(Layout(kCapacity, 1));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator_.Allocate(Layout(1, 1)), nullptr);
+  allocator_.Reset();
+  EXPECT_EQ(allocator_.used(), 0U);
+  EXPECT_EQ(allocator_.Allocate(Layout(kCapacity, 1)), ptr);
+}
+
+TEST_F(BumpAllocatorTest, RollBackToCheckpoint) {
+  ASSERT_NE(allocator_.Allocate(Layout(16, 1)), nullptr);
+  BumpAllocator::Checkpoint checkpoint = allocator_.GetCheckpoint();
+  void* ptr = allocator_.Allocate(Layout(32, 1));
+  ASSERT_NE(ptr, nullptr);
+  allocator_.RollBack(checkpoint);
+  EXPECT_EQ(allocator_.used(), 16U);
+  EXPECT_EQ(allocator_.Allocate(Layout(32, 1)), ptr);
+
+  // Rolling back to a later checkpoint after an earlier one has no effect.
+  BumpAllocator::Checkpoint later = allocator_.GetCheckpoint();
+  allocator_.RollBack(checkpoint);
+  allocator_.RollBack(later);
+  EXPECT_EQ(allocator_.used(), 16U);
+}
+
+TEST_F(BumpAllocatorTest, RollBackToStaleCheckpointAfterReallocating) {
+  ASSERT_NE(allocator_.Allocate(Layout(16, 1)), nullptr);
+  BumpAllocator::Checkpoint checkpoint = allocator_.GetCheckpoint();
+  ASSERT_NE(allocator_.Allocate(Layout(32, 1)), nullptr);
+  BumpAllocator::Checkpoint stale = allocator_.GetCheckpoint();
+  allocator_.RollBack(checkpoint);
+
+  // Once memory is allocated past the stale checkpoint again, rolling back to
+  // it releases that memory.
+  ASSERT_NE(allocator_.Allocate(Layout(64, 1)), nullptr);
+  EXPECT_EQ(allocator_.used(), 80U);
+  allocator_.RollBack(stale);
+  EXPECT_EQ(allocator_.used(), 48U);
+}
+
+TEST_F(BumpAllocatorTest, ScopedCheckpointReleasesMemory) {
+  ASSERT_NE(allocator_.Allocate(Layout(16, 1)), nullptr);
+  {
+    ScopedCheckpoint scope(allocator_);
+    EXPECT_NE(allocator_.Allocate(Layout(64, 1)), nullptr);
+    {
+      ScopedCheckpoint nested(allocator_);
+      EXPECT_NE(allocator_.Allocate(Layout(64, 1)), nullptr);
+      EXPECT_EQ(allocator_.used(), 144U);
+    }
+    EXPECT_EQ(allocator_.used(), 80U);
+  }
+  EXPECT_EQ(allocator_.used(), 16U);
+}
+
+TEST_F(BumpAllocatorTest, Query) {
+  void* ptr = allocator_.Allocate(Layout(16, 1));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator_.Query(ptr, Layout(16, 1)), OkStatus());
+  EXPECT_EQ(allocator_.Query(buffer_.data() + 16, Layout(16, 1)),
+            Status::OutOfRange());
+  uint64_t other;
+  EXPECT_EQ(allocator_.Query(&other, Layout::Of<uint64_t>()),
+            Status::OutOfRange());
+}
+
+}  // namespace
+}  // namespace pw::allocator
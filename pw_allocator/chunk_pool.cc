@@ -0,0 +1,138 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/chunk_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_bytes/alignment.h"
+
+namespace pw::allocator {
+namespace {
+
+constexpr uint32_t kIndexMask = 0xFFFF;
+constexpr uint32_t kTagShift = 16;
+
+constexpr uint32_t Pack(uint16_t index, uint32_t tag) {
+  return (tag << kTagShift) | index;
+}
+
+constexpr uint16_t IndexOf(uint32_t head) {
+  return static_cast<uint16_t>(head & kIndexMask);
+}
+
+constexpr uint32_t NextTag(uint32_t head) { return (head >> kTagShift) + 1; }
+
+}  // namespace
+
+ChunkPool::ChunkPool(ByteSpan region, const Layout& layout)
+    : alignment_(std::max(layout.alignment(), alignof(Index))) {
+  chunk_size_ = AlignUp(std::max(layout.size(), sizeof(Index)), alignment_);
+  auto addr = reinterpret_cast<uintptr_t>(region.data());
+  auto aligned = AlignUp(addr, alignment_);
+  size_t offset = aligned - addr;
+  if (offset < region.size()) {
+    begin_ = region.data() + offset;
+    size_t num_chunks = (region.size() - offset) / chunk_size_;
+    num_chunks_ = static_cast<Index>(std::min(num_chunks, size_t(kNone)));
+  }
+  for (Index i = 0; i < num_chunks_; ++i) {
+    SetNext(i, i + 1 == num_chunks_ ? kNone : static_cast<Index>(i + 1));
+  }
+  Index first = num_chunks_ == 0 ? kNone : 0;
+  head_.store(Pack(first, 0), std::memory_order_release);
+}
+
+void* ChunkPool::DoAllocate(Layout layout) {
+  if (layout.size() > chunk_size_ || layout.alignment() > alignment_) {
+    return nullptr;
+  }
+  uint32_t head = head_.load(std::memory_order_acquire);
+  Index index;
+  uint32_t desired;
+  do {
+    index = IndexOf(head);
+    if (index == kNone) {
+      return nullptr;
+    }
+    // If another context pops this chunk first, the value read here may be
+    // stale, but the tag ensures the exchange below will fail.
+    desired = Pack(GetNext(index), NextTag(head));
+  } while (!head_.compare_exchange_weak(head,
+                                        desired,
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire));
+  return begin_ + (index * chunk_size_);
+}
+
+void ChunkPool::DoDeallocate(void* ptr, Layout) {
+  Index index = GetIndex(ptr);
+  if (index == kNone) {
+    return;
+  }
+  uint32_t head = head_.load(std::memory_order_relaxed);
+  uint32_t desired;
+  do {
+    SetNext(index, IndexOf(head));
+    desired = Pack(index, NextTag(head));
+  } while (!head_.compare_exchange_weak(head,
+                                        desired,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed));
+}
+
+bool ChunkPool::DoResize(void* ptr, Layout, size_t new_size) {
+  return GetIndex(ptr) != kNone && new_size <= chunk_size_;
+}
+
+Result<Layout> ChunkPool::DoGetLayout(const void* ptr) const {
+  if (GetIndex(ptr) == kNone) {
+    return Status::NotFound();
+  }
+  return layout();
+}
+
+Status ChunkPool::DoQuery(const void* ptr, Layout layout) const {
+  if (GetIndex(ptr) == kNone || layout.size() > chunk_size_ ||
+      layout.alignment() > alignment_) {
+    return Status::OutOfRange();
+  }
+  return OkStatus();
+}
+
+ChunkPool::Index ChunkPool::GetIndex(const void* ptr) const {
+  auto addr = reinterpret_cast<uintptr_t>(ptr);
+  auto begin = reinterpret_cast<uintptr_t>(begin_);
+  if (begin_ == nullptr || addr < begin) {
+    return kNone;
+  }
+  size_t offset = addr - begin;
+  if (offset % chunk_size_ != 0 || offset / chunk_size_ >= num_chunks_) {
+    return kNone;
+  }
+  return static_cast<Index>(offset / chunk_size_);
+}
+
+ChunkPool::Index ChunkPool::GetNext(Index index) const {
+  Index next;
+  std::memcpy(&next, begin_ + (index * chunk_size_), sizeof(next));
+  return next;
+}
+
+void ChunkPool::SetNext(Index index, Index next) {
+  std::memcpy(begin_ + (index * chunk_size_), &next, sizeof(next));
+}
+
+}  // namespace pw::allocator
@@ -0,0 +1,138 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/chunk_pool.h"
+
+#include <array>
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::allocator {
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kNumChunks = 4;
+
+struct U64Pair final {
+  uint64_t first;
+  uint64_t second;
+};
+
+using PoolForTest = TypedPool<U64Pair, kNumChunks>;
+
+// Unit tests.
+
+TEST(ChunkPoolTest, CarvesRegionIntoChunks) {
+  alignas(uint32_t) std::array<std::byte, 100> buffer;
+  ChunkPool pool(buffer, Layout(24, alignof(uint32_t)));
+  EXPECT_EQ(pool.num_chunks(), 4U);
+  EXPECT_EQ(pool.layout(), Layout(24, alignof(uint32_t)));
+}
+
+TEST(ChunkPoolTest, AlignsRegion) {
+  alignas(uint64_t) std::array<std::byte, 36> buffer;
+  ChunkPool pool(ByteSpan(buffer).subspan(1), Layout(8, alignof(uint64_t)));
+  EXPECT_EQ(pool.num_chunks(), 3U);
+  void* ptr = pool.Allocate(Layout(8, alignof(uint64_t)));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(uint64_t), 0U);
+  pool.Deallocate(ptr, Layout(8, alignof(uint64_t)));
+}
+
+TEST(ChunkPoolTest, AllocatesEveryChunk) {
+  PoolForTest pool;
+  std::array<U64Pair*, kNumChunks> ptrs;
+  for (auto& ptr : ptrs) {
+    ptr = pool.New<U64Pair>();
+    ASSERT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(pool.Allocate(Layout::Of<U64Pair>()), nullptr);
+  for (size_t i = 1; i < kNumChunks; ++i) {
+    EXPECT_NE(ptrs[i - 1], ptrs[i]);
+  }
+  for (auto* ptr : ptrs) {
+    pool.Delete(ptr);
+  }
+}
+
+TEST(ChunkPoolTest, ReusesMostRecentlyFreedChunk) {
+  PoolForTest pool;
+  void* ptr1 = pool.Allocate(Layout::Of<U64Pair>());
+  void* ptr2 = pool.Allocate(Layout::Of<U64Pair>());
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  pool.Deallocate(ptr1, Layout::Of<U64Pair>());
+  EXPECT_EQ(pool.Allocate(Layout::Of<U64Pair>()), ptr1);
+  pool.Deallocate(ptr1, Layout::Of<U64Pair>());
+  pool.Deallocate(ptr2, Layout::Of<U64Pair>());
+}
+
+TEST(ChunkPoolTest, AllocateFailsForLayoutsThatDoNotFit) {
+  PoolForTest pool;
+  EXPECT_EQ(pool.Allocate(Layout(sizeof(U64Pair) + 1, 1)), nullptr);
+  EXPECT_EQ(pool.Allocate(Layout(8, alignof(U64Pair) * 2)), nullptr);
+
+  void* ptr = pool.Allocate(Layout(1, 1));
+  EXPECT_NE(ptr, nullptr);
+  pool.Deallocate(ptr, Layout(1, 1));
+}
+
+TEST(ChunkPoolTest, ResizeWithinChunk) {
+  PoolForTest pool;
+  void* ptr = pool.Allocate(Layout(4, 1));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(pool.Resize(ptr, Layout(4, 1), sizeof(U64Pair)));
+  EXPECT_FALSE(pool.Resize(ptr, Layout(sizeof(U64Pair), 1), 32));
+  pool.Deallocate(ptr, Layout(sizeof(U64Pair), 1));
+}
+
+TEST(ChunkPoolTest, GetLayoutAndQuery) {
+  PoolForTest pool;
+  void* ptr = pool.Allocate(Layout::Of<U64Pair>());
+  ASSERT_NE(ptr, nullptr);
+
+  Result<Layout> layout = pool.GetLayout(ptr);
+  ASSERT_EQ(layout.status(), OkStatus());
+  EXPECT_EQ(layout->size(), sizeof(U64Pair));
+  EXPECT_EQ(pool.Query(ptr, Layout::Of<U64Pair>()), OkStatus());
+
+  auto* misaligned = static_cast<std::byte*>(ptr) + 1;
+  EXPECT_EQ(pool.GetLayout(misaligned).status(), Status::NotFound());
+  EXPECT_EQ(pool.Query(misaligned, Layout(1, 1)), Status::OutOfRange());
+
+  uint64_t other;
+  EXPECT_EQ(pool.GetLayout(&other).status(), Status::NotFound());
+  EXPECT_EQ(pool.Query(&other, Layout::Of<uint64_t>()), Status::OutOfRange());
+  pool.Deallocate(ptr, Layout::Of<U64Pair>());
+}
+
+TEST(ChunkPoolTest, DeallocateIgnoresForeignPointers) {
+  PoolForTest pool;
+  uint64_t other;
+  pool.Deallocate(&other, Layout::Of<uint64_t>());
+  std::array<void*, kNumChunks> ptrs;
+  for (auto& ptr : ptrs) {
+    ptr = pool.Allocate(Layout::Of<U64Pair>());
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_NE(ptr, &other);
+  }
+  for (auto* ptr : ptrs) {
+    pool.Deallocate(ptr, Layout::Of<U64Pair>());
+  }
+}
+
+}  // namespace
+}  // namespace pw::allocator
@@ -31,10 +31,15 @@ Status FreeList::AddChunk(span<std::byte> chunk) {
 
   unsigned short chunk_ptr = FindChunkPtrForSize(chunk.size(), false);
 
-  // Add it to the correct list.
+  // Add it to the correct list, keeping the list sorted by size. This ensures
+  // the first suitable chunk found by `FindChunk` is also the smallest.
   aliased.node->size = chunk.size();
-  aliased.node->next = chunks_[chunk_ptr];
-  chunks_[chunk_ptr] = aliased.node;
+  FreeListNode** link = &chunks_[chunk_ptr];
+  while (*link != nullptr && (*link)->size < chunk.size()) {
+    link = &(*link)->next;
+  }
+  aliased.node->next = *link;
+  *link = aliased.node;
 
   return OkStatus();
 }
@@ -100,6 +105,10 @@ Status FreeList::RemoveChunk(span<std::byte> chunk) {
 
   while (aliased.node->next != nullptr) {
     aliased_next.node = aliased.node->next;
+    if (aliased_next.node->size > chunk.size()) {
+      // The list is sorted, so the chunk cannot appear after this node.
+      break;
+    }
     if (aliased_next.data == chunk.data()) {
       // Found it, remove this node out of the chain
       aliased.node->next = aliased_next.node->next;
@@ -117,6 +117,34 @@ TEST(FreeList, FindReturnsCorrectChunkInSameBucket) {
   EXPECT_EQ(chunk.size(), kN1);
 }
 
+TEST(FreeList, FindReturnsBestFitInSameBucket) {
+  // If we have several values in the same bucket, ensure that the allocation
+  // will pick the smallest one that fits, regardless of insertion order.
+  FreeListBuffer<SIZE> list(example_sizes);
+  constexpr size_t kN1 = 500;
+  constexpr size_t kN2 = 300;
+  constexpr size_t kN3 = 400;
+
+  byte data1[kN1] = {std::byte(0)};
+  byte data2[kN2] = {std::byte(0)};
+  byte data3[kN3] = {std::byte(0)};
+
+  // List should now be 300 -> 400 -> 500 -> NULL
+  ASSERT_EQ(OkStatus(), list.AddChunk(span(data1, kN1)));
+  ASSERT_EQ(OkStatus(), list.AddChunk(span(data2, kN2)));
+  ASSERT_EQ(OkStatus(), list.AddChunk(span(data3, kN3)));
+
+  auto chunk = list.FindChunk(kN2 + 1);
+  EXPECT_EQ(chunk.size(), kN3);
+  EXPECT_EQ(chunk.data(), data3);
+
+  // Removing from the middle of a sorted list preserves the remaining order.
+  ASSERT_EQ(OkStatus(), list.RemoveChunk(chunk));
+  chunk = list.FindChunk(kN2 + 1);
+  EXPECT_EQ(chunk.size(), kN1);
+  EXPECT_EQ(chunk.data(), data1);
+}
+
 TEST(FreeList, FindCanMoveUpThroughBuckets) {
   // Ensure that finding a chunk will move up through buckets if no appropriate
   // chunks were found in a given bucket
@@ -0,0 +1,59 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/profiling_allocator.h"
+
+#include <chrono>
+
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::allocator {
+
+ProfilingAllocator::ProfilingAllocator(metric::Token token,
+                                       Allocator& allocator,
+                                       chrono::VirtualSystemClock& clock)
+    : allocator_(allocator),
+      clock_(clock),
+      group_(token),
+      allocate_latency_(PW_TOKENIZE_STRING_DOMAIN_EXPR("metrics",
+                                                       "allocate_latency_us")),
+      deallocate_latency_(PW_TOKENIZE_STRING_DOMAIN_EXPR(
+          "metrics", "deallocate_latency_us")),
+      free_block_sizes_(
+          PW_TOKENIZE_STRING_DOMAIN_EXPR("metrics", "free_block_sizes")) {
+  group_.Add(free_block_sizes_.group());
+  group_.Add(deallocate_latency_.group());
+  group_.Add(allocate_latency_.group());
+}
+
+void* ProfilingAllocator::DoAllocate(Layout layout) {
+  chrono::SystemClock::time_point start = clock_.now();
+  void* ptr = allocator_.Allocate(layout);
+  allocate_latency_.Record(ElapsedUs(start));
+  return ptr;
+}
+
+void ProfilingAllocator::DoDeallocate(void* ptr, Layout layout) {
+  chrono::SystemClock::time_point start = clock_.now();
+  allocator_.Deallocate(ptr, layout);
+  deallocate_latency_.Record(ElapsedUs(start));
+}
+
+uint32_t ProfilingAllocator::ElapsedUs(chrono::SystemClock::time_point start) {
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      clock_.now() - start);
+  return internal::ClampU32(static_cast<size_t>(elapsed.count()));
+}
+
+}  // namespace pw::allocator
@@ -0,0 +1,154 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/profiling_allocator.h"
+
+#include <chrono>
+
+#include "pw_allocator/block_allocator.h"
+#include "pw_allocator/buffer.h"
+#include "pw_allocator/histogram.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::allocator {
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kCapacity = 1024;
+static constexpr metric::Token kToken = 1U;
+
+/// Clock that advances by a fixed step every time it is read.
+class SteppingClock : public chrono::VirtualSystemClock {
+ public:
+  void set_step(chrono::SystemClock::duration step) { step_ = step; }
+
+  chrono::SystemClock::time_point now() override {
+    now_ += step_;
+    return now_;
+  }
+
+ private:
+  chrono::SystemClock::time_point now_;
+  chrono::SystemClock::duration step_{0};
+};
+
+class ProfilingAllocatorTest : public ::testing::Test {
+ protected:
+  using BlockAllocatorType = FirstFitBlockAllocator<uint32_t>;
+
+  ProfilingAllocatorTest() : profiler_(kToken, *allocator_, clock_) {
+    EXPECT_EQ(allocator_->Init(allocator_.as_bytes()), OkStatus());
+  }
+
+  WithBuffer<BlockAllocatorType, kCapacity, uint32_t> allocator_;
+  SteppingClock clock_;
+  ProfilingAllocator profiler_;
+};
+
+// Unit tests.
+
+TEST(Log2HistogramTest, BucketFor) {
+  EXPECT_EQ(Log2Histogram::BucketFor(0), 0U);
+  EXPECT_EQ(Log2Histogram::BucketFor(1), 1U);
+  EXPECT_EQ(Log2Histogram::BucketFor(2), 2U);
+  EXPECT_EQ(Log2Histogram::BucketFor(3), 2U);
+  EXPECT_EQ(Log2Histogram::BucketFor(4), 3U);
+  EXPECT_EQ(Log2Histogram::BucketFor(16383), 14U);
+  EXPECT_EQ(Log2Histogram::BucketFor(16384), 15U);
+  EXPECT_EQ(Log2Histogram::BucketFor(0xFFFFFFFFU), 15U);
+}
+
+TEST(Log2HistogramTest, RecordAndClear) {
+  Log2Histogram histogram(kToken);
+  histogram.Record(0);
+  histogram.Record(5);
+  histogram.Record(7);
+  histogram.Record(100000);
+  EXPECT_EQ(histogram.count(0), 1U);
+  EXPECT_EQ(histogram.count(3), 2U);
+  EXPECT_EQ(histogram.count(Log2Histogram::kNumBuckets - 1), 1U);
+  EXPECT_EQ(histogram.group().metrics().size(), Log2Histogram::kNumBuckets);
+
+  histogram.Clear();
+  for (size_t i = 0; i < Log2Histogram::kNumBuckets; ++i) {
+    EXPECT_EQ(histogram.count(i), 0U);
+  }
+}
+
+TEST_F(ProfilingAllocatorTest, RecordsAllocateLatency) {
+  clock_.set_step(std::chrono::duration_cast<chrono::SystemClock::duration>(
+      std::chrono::microseconds(10)));
+  void* ptr = profiler_.Allocate(Layout(32, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(profiler_.allocate_latency().count(Log2Histogram::BucketFor(10)),
+            1U);
+
+  // Failed requests are also timed.
+  EXPECT_EQ(profiler_.Allocate(Layout(kCapacity * 2, 4)), nullptr);
+  EXPECT_EQ(profiler_.allocate_latency().count(Log2Histogram::BucketFor(10)),
+            2U);
+
+  profiler_.Deallocate(ptr, Layout(32, 4));
+}
+
+TEST_F(ProfilingAllocatorTest, RecordsDeallocateLatency) {
+  void* ptr = profiler_.Allocate(Layout(32, 4));
+  ASSERT_NE(ptr, nullptr);
+  clock_.set_step(std::chrono::duration_cast<chrono::SystemClock::duration>(
+      std::chrono::microseconds(300)));
+  profiler_.Deallocate(ptr, Layout(32, 4));
+  EXPECT_EQ(
+      profiler_.deallocate_latency().count(Log2Histogram::BucketFor(300)),
+      1U);
+  EXPECT_EQ(profiler_.allocate_latency().count(0), 1U);
+}
+
+TEST_F(ProfilingAllocatorTest, UpdateFragmentation) {
+  profiler_.UpdateFragmentation(allocator_->blocks());
+  EXPECT_EQ(profiler_.num_free_blocks(), 1U);
+  size_t initial = profiler_.largest_free_block();
+  EXPECT_GT(initial, 0U);
+
+  // Free every other allocation to leave holes.
+  std::array<void*, 4> ptrs;
+  for (auto& ptr : ptrs) {
+    ptr = profiler_.Allocate(Layout(64, 4));
+    ASSERT_NE(ptr, nullptr);
+  }
+  profiler_.Deallocate(ptrs[0], Layout(64, 4));
+  profiler_.Deallocate(ptrs[2], Layout(64, 4));
+
+  profiler_.UpdateFragmentation(allocator_->blocks());
+  EXPECT_EQ(profiler_.num_free_blocks(), 3U);
+  EXPECT_LT(profiler_.largest_free_block(), initial);
+  EXPECT_EQ(profiler_.free_block_sizes().count(Log2Histogram::BucketFor(64)),
+            2U);
+
+  profiler_.Deallocate(ptrs[1], Layout(64, 4));
+  profiler_.Deallocate(ptrs[3], Layout(64, 4));
+  profiler_.UpdateFragmentation(allocator_->blocks());
+  EXPECT_EQ(profiler_.num_free_blocks(), 1U);
+  EXPECT_EQ(profiler_.largest_free_block(), initial);
+}
+
+TEST_F(ProfilingAllocatorTest, MetricsAreInGroup) {
+  const metric::Group& group = profiler_.metric_group();
+  EXPECT_EQ(group.children().size(), 3U);
+  EXPECT_EQ(group.metrics().size(), 2U);
+}
+
+}  // namespace
+}  // namespace pw::allocator
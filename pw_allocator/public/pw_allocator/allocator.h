@@ -20,6 +20,7 @@
 #include "pw_assert/assert.h"
 #include "pw_preprocessor/compiler.h"
 #include "pw_result/result.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
 
 namespace pw::allocator {
@@ -101,6 +102,28 @@ class Allocator {
     return layout.size() != 0 ? DoAllocate(layout) : nullptr;
   }
 
+  /// Allocates multiple blocks of memory with the same size and alignment.
+  ///
+  /// Allocations are made in order until either every element of `ptrs` has
+  /// been filled or a request fails, in which case the remaining elements are
+  /// set to `nullptr`. This allows implementations to avoid repeated overhead,
+  /// such as acquiring a lock or searching for free memory, when many
+  /// allocations are needed at once.
+  ///
+  /// Each allocation must be individually released by passing it to either
+  /// `Deallocate` or `DeallocateBatch`.
+  ///
+  /// @param[in]  layout      Describes each of the memory blocks to allocate.
+  /// @param[out] ptrs        Receives the allocated pointers.
+  /// @returns    The number of blocks that were allocated.
+  size_t AllocateBatch(Layout layout, span<void*> ptrs) {
+    size_t count = layout.size() != 0 ? DoAllocateBatch(layout, ptrs) : 0;
+    for (size_t i = count; i < ptrs.size(); ++i) {
+      ptrs[i] = nullptr;
+    }
+    return count;
+  }
+
   /// Constructs and object of type `T` from the given `args`
   ///
   /// The return value is nullable, as allocating memory for the object may
@@ -145,6 +168,19 @@ class Allocator {
     }
   }
 
+  /// Releases multiple previously-allocated blocks of memory with the same
+  /// layout.
+  ///
+  /// Each non-null pointer must have been previously obtained from this
+  /// allocator, and must be described by `layout`; otherwise the behavior is
+  /// undefined. Null pointers are ignored.
+  ///
+  /// @param[in]  ptrs          Pointers to previously-allocated memory.
+  /// @param[in]  layout        Describes each of the memory blocks.
+  void DeallocateBatch(span<void* const> ptrs, Layout layout) {
+    DoDeallocateBatch(ptrs, layout);
+  }
+
   /// Destroys the object at ``ptr`` and deallocates the associated memory.
   ///
   /// The given pointer must have been previously obtained from a call to
@@ -279,6 +315,28 @@ class Allocator {
   /// @param[in]  layout        Describes the memory to be deallocated.
   virtual void DoDeallocate(void* ptr, Layout layout) = 0;
 
+  /// Virtual `AllocateBatch` function that can be overridden by derived
+  /// classes.
+  ///
+  /// The default implementation calls `DoAllocate` for each pointer, and stops
+  /// at the first failure.
+  ///
+  /// @param[in]  layout        Describes the memory to be allocated. Guaranteed
+  ///                           to have a non-zero size.
+  /// @param[out] ptrs          Receives the allocated pointers.
+  /// @returns    The number of leading elements of `ptrs` that were allocated.
+  virtual size_t DoAllocateBatch(Layout layout, span<void*> ptrs);
+
+  /// Virtual `DeallocateBatch` function that can be overridden by derived
+  /// classes.
+  ///
+  /// The default implementation calls `DoDeallocate` for each non-null
+  /// pointer.
+  ///
+  /// @param[in]  ptrs          Pointers to memory, which may be null.
+  /// @param[in]  layout        Describes the memory to be deallocated.
+  virtual void DoDeallocateBatch(span<void* const> ptrs, Layout layout);
+
   /// Virtual `Resize` function implemented by derived classes.
   ///
   /// The default implementation simply returns `false`, indicating that
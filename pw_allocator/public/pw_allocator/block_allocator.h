@@ -13,12 +13,20 @@
 // the License.
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
 
+#include "lib/stdcompat/bit.h"
 #include "pw_allocator/allocator.h"
 #include "pw_allocator/block.h"
+#include "pw_bytes/alignment.h"
 #include "pw_bytes/span.h"
+#include "pw_preprocessor/compiler.h"
 #include "pw_result/result.h"
 #include "pw_status/status.h"
 
@@ -116,6 +124,31 @@ class BlockAllocator : public GenericBlockAllocator {
   /// blocks from this allocator.
   void Reset();
 
+  /// Sets the maximum number of deallocated blocks to defer coalescing for.
+  ///
+  /// By default, deallocated blocks are immediately merged with any free
+  /// neighbors. When this value is non-zero, up to `max_deferred` deallocated
+  /// blocks are instead parked in a quick-list without modifying their
+  /// neighbors. Subsequent allocations of a similar size are satisfied from the
+  /// quick-list without searching for a free block. Parked blocks are merged
+  /// when the quick-list is full, when an allocation cannot otherwise be
+  /// satisfied, or when `Compact` is called.
+  ///
+  /// Parked blocks are still marked as used, and are reported as such when
+  /// iterating over `blocks()`.
+  ///
+  /// If the new limit is less than the number of parked blocks, all parked
+  /// blocks are merged.
+  ///
+  /// @param[in]  max_deferred  Maximum number of parked blocks.
+  void SetMaxDeferred(uint16_t max_deferred);
+
+  /// Returns the number of deallocated blocks whose coalescing was deferred.
+  size_t num_deferred() const { return num_deferred_; }
+
+  /// Frees and merges all deallocated blocks whose coalescing was deferred.
+  void Compact();
+
  protected:
   using ReverseRange = typename BlockType::ReverseRange;
 
@@ -127,12 +160,30 @@ class BlockAllocator : public GenericBlockAllocator {
   /// @copydoc Allocator::Allocate
   void* DoAllocate(Layout layout) override;
 
+  /// @copydoc Allocator::AllocateBatch
+  ///
+  /// After the first block is chosen, each subsequent allocation is split from
+  /// the free block immediately following the previous one, if possible. This
+  /// allocates runs of contiguous memory without repeating the search for a
+  /// free block.
+  size_t DoAllocateBatch(Layout layout, span<void*> ptrs) override;
+
   /// @copydoc Allocator::Deallocate
   void DoDeallocate(void* ptr, Layout layout) override;
 
   /// @copydoc Allocator::Resize
   bool DoResize(void* ptr, Layout layout, size_t new_size) override;
 
+  /// @copydoc Allocator::Reallocate
+  ///
+  /// This method avoids allocating a new block where possible. It first tries
+  /// to resize the block in place, growing into or splitting off a trailing
+  /// free block. If that is not sufficient and the preceding block is free,
+  /// the blocks are merged and the data is moved to the start of the merged
+  /// block. Only if both of these fail is new memory allocated and the data
+  /// copied.
+  void* DoReallocate(void* ptr, Layout layout, size_t new_size) override;
+
   /// @copydoc Allocator::GetLayout
   Result<Layout> DoGetLayout(const void* ptr) const override;
 
@@ -147,6 +198,27 @@ class BlockAllocator : public GenericBlockAllocator {
   /// @param  layout  Same as ``Allocator::Allocate``.
   virtual BlockType* ChooseBlock(Layout layout) = 0;
 
+  /// Indicates that a free block is about to be merged or otherwise modified.
+  ///
+  /// This method is called before a free block is merged with a neighbor that
+  /// is being freed or resized. Derived allocators that index free blocks can
+  /// override it to remove the block from their index. The default
+  /// implementation does nothing.
+  ///
+  /// @param  block   A free block that is about to be invalidated.
+  virtual void ReserveBlock(BlockType* /*block*/) {}
+
+  /// Indicates that a block has become free.
+  ///
+  /// This method is called after a block is freed or after a free block is
+  /// created or enlarged, e.g. when initializing the allocator, deallocating
+  /// memory, or shrinking an allocation. Derived allocators that index free
+  /// blocks can override it to add the block to their index. The default
+  /// implementation does nothing.
+  ///
+  /// @param  block   A free block that may be used to satisfy requests.
+  virtual void RecycleBlock(BlockType* /*block*/) {}
+
   /// Returns the block associated with a pointer.
   ///
   /// If the given pointer is to this allocator's memory region, but not to a
@@ -167,10 +239,46 @@ class BlockAllocator : public GenericBlockAllocator {
   /// allocated or freed.
   void UpdateLast(BlockType* block);
 
+  /// Returns a block that can satisfy the given layout, or null if none is
+  /// available.
+  ///
+  /// Parked blocks are checked first, followed by `ChooseBlock`. If neither
+  /// yields a block, parked blocks are merged and `ChooseBlock` is retried.
+  BlockType* AllocateBlock(Layout layout);
+
+  /// Removes and returns a parked block that can satisfy the given layout, or
+  /// null if none is found.
+  ///
+  /// A parked block matches if it is suitably aligned and is no larger than
+  /// a block that `ChooseBlock` could have returned for the same layout.
+  BlockType* TakeDeferred(Layout layout);
+
+  /// Frees a block and merges it with its free neighbors, if any.
+  void FreeBlock(BlockType* block);
+
+  /// Attempts to grow a block into the free block that precedes it.
+  ///
+  /// @returns  The moved block's usable space, or null if the preceding block
+  ///           is not free or the merged blocks are too small.
+  void* ReallocateIntoPrev(BlockType* block, Layout layout, size_t new_size);
+
+  /// Returns the parked block following the given one in the quick-list.
+  ///
+  /// The link is stored in the parked block's usable space.
+  static BlockType* GetNextDeferred(BlockType* block);
+
+  /// Sets the parked block following the given one in the quick-list.
+  static void SetNextDeferred(BlockType* block, BlockType* next);
+
   // Represents the range of blocks for this allocator.
   BlockType* first_ = nullptr;
   BlockType* last_ = nullptr;
   uint16_t unpoisoned_ = 0;
+
+  // Quick-list of deallocated blocks whose coalescing has been deferred.
+  BlockType* deferred_ = nullptr;
+  uint16_t num_deferred_ = 0;
+  uint16_t max_deferred_ = 0;
 };
 
 }  // namespace internal
@@ -379,6 +487,222 @@ class DualFirstFitBlockAllocator
   size_t threshold_ = 0;
 };
 
+/// Block allocator that uses a "two-level segregated fit" allocation strategy.
+///
+/// In this strategy, the allocator keeps an index of free blocks grouped into
+/// size classes. The first level of the index divides sizes into powers of
+/// two, and the second level linearly subdivides each of those ranges. Each
+/// size class has a list of free blocks, and a pair of bitmaps records which
+/// lists are non-empty. Free list links are stored in the usable space of the
+/// free blocks themselves.
+///
+/// A request is handled by rounding its size up to the next size class and
+/// using bit scans to find the first non-empty list whose blocks are all
+/// guaranteed to satisfy it. As a result, allocating and deallocating take
+/// bounded, constant time regardless of the number of blocks, making this
+/// strategy well-suited to real-time code. The rounding may leave a request
+/// unsatisfied even though a block in its own size class would fit it, so this
+/// strategy may fail sooner than others when memory is nearly exhausted.
+///
+/// Free blocks too small to hold the free list links are not indexed. They are
+/// reclaimed when a neighboring block is freed and merged with them.
+///
+/// Since free blocks hold free list links, this allocator does not support
+/// poisoning. Its index requires
+/// `(kNumFirstLevel * kNumSecondLevel + 1) * sizeof(void*)` bytes in addition
+/// to the region, where `kNumFirstLevel` grows with the addressable range of
+/// `OffsetType`. Smaller offset types therefore also reduce this overhead.
+template <typename OffsetType = uintptr_t, size_t kAlign = alignof(OffsetType)>
+class TlsfBlockAllocator
+    : public internal::BlockAllocator<OffsetType, 0, kAlign> {
+ public:
+  using Base = internal::BlockAllocator<OffsetType, 0, kAlign>;
+  using BlockType = typename Base::BlockType;
+
+  constexpr TlsfBlockAllocator() : Base() {}
+
+  // Note: This does not delegate to `Base(region)`, as free blocks can only be
+  // indexed once this object is fully constructed.
+  explicit TlsfBlockAllocator(ByteSpan region) : Base() {
+    PW_ASSERT(Base::Init(region).ok());
+  }
+
+ private:
+  /// Log2 of the number of second-level size classes per first-level class.
+  static constexpr size_t kSecondLevelLog2 = 4;
+  static constexpr size_t kNumSecondLevel = size_t(1) << kSecondLevelLog2;
+
+  /// Sizes below this value are subdivided linearly in units of `kAlignment`.
+  static constexpr size_t kAlignLog2 =
+      cpp20::countr_zero(size_t(BlockType::kAlignment));
+  static constexpr size_t kFirstLevelShift = kSecondLevelLog2 + kAlignLog2;
+  static constexpr size_t kSmallSize = size_t(1) << kFirstLevelShift;
+
+  /// Largest inner size of a block that can be addressed using `OffsetType`.
+  static constexpr size_t kMaxSize =
+      std::numeric_limits<OffsetType>::max() >
+              std::numeric_limits<size_t>::max() / BlockType::kAlignment
+          ? std::numeric_limits<size_t>::max()
+          : size_t(std::numeric_limits<OffsetType>::max()) *
+                BlockType::kAlignment;
+  static constexpr size_t kNumFirstLevel =
+      cpp20::bit_width(kMaxSize) - kFirstLevelShift + 1;
+  static_assert(kNumFirstLevel <= std::numeric_limits<size_t>::digits);
+
+  /// Links stored in the usable space of an indexed free block.
+  struct FreeNode {
+    BlockType* prev;
+    BlockType* next;
+  };
+  static constexpr size_t kMinIndexedSize = sizeof(FreeNode);
+
+  /// @copydoc Allocator::Allocate
+  BlockType* ChooseBlock(Layout layout) override {
+    size_t inner_size = AlignUp(layout.size(), BlockType::kAlignment);
+    size_t search_size = inner_size;
+    if (layout.alignment() > BlockType::kAlignment &&
+        PW_ADD_OVERFLOW(search_size,
+                        layout.alignment() + BlockType::kBlockOverhead,
+                        &search_size)) {
+      return nullptr;
+    }
+
+    // Check the head of the request's own size class, which may fit.
+    size_t fl, sl;
+    MapSize(search_size, fl, sl);
+    if (fl >= kNumFirstLevel) {
+      return nullptr;
+    }
+    BlockType* block = free_lists_[fl][sl];
+    if (block == nullptr ||
+        !block->CanAllocFirst(layout.size(), layout.alignment()).ok()) {
+      // Round up to the next size class, whose blocks are all large enough.
+      size_t msb = cpp20::bit_width(search_size) - 1;
+      if (search_size >= kSmallSize &&
+          PW_ADD_OVERFLOW(search_size,
+                          (size_t(1) << (msb - kSecondLevelLog2)) - 1,
+                          &search_size)) {
+        return nullptr;
+      }
+      MapSize(search_size, fl, sl);
+      block = FindSuitableBlock(fl, sl);
+    }
+    if (block == nullptr) {
+      return nullptr;
+    }
+
+    RemoveBlock(block);
+    BlockType* chosen = block;
+    auto end = reinterpret_cast<uintptr_t>(block) + block->OuterSize();
+    if (!BlockType::AllocFirst(block, layout.size(), layout.alignment())
+             .ok()) {
+      InsertBlock(chosen);
+      return nullptr;
+    }
+
+    // Index any leading or trailing space split from the chosen block.
+    if (block != chosen) {
+      InsertBlock(chosen);
+    }
+    if (!block->Last() && reinterpret_cast<uintptr_t>(block->Next()) < end) {
+      InsertBlock(block->Next());
+    }
+    return block;
+  }
+
+  /// @copydoc BlockAllocator::ReserveBlock
+  void ReserveBlock(BlockType* block) override { RemoveBlock(block); }
+
+  /// @copydoc BlockAllocator::RecycleBlock
+  void RecycleBlock(BlockType* block) override { InsertBlock(block); }
+
+  /// Returns the first- and second-level indices of the size class that
+  /// contains blocks with the given inner size.
+  static void MapSize(size_t size, size_t& fl, size_t& sl) {
+    if (size < kSmallSize) {
+      fl = 0;
+      sl = size >> kAlignLog2;
+    } else {
+      size_t msb = cpp20::bit_width(size) - 1;
+      fl = msb - kFirstLevelShift + 1;
+      sl = (size >> (msb - kSecondLevelLog2)) ^ kNumSecondLevel;
+    }
+  }
+
+  /// Returns the head of the first non-empty free list at or above the given
+  /// size class, or null if no such list exists.
+  BlockType* FindSuitableBlock(size_t fl, size_t sl) const {
+    if (fl >= kNumFirstLevel) {
+      return nullptr;
+    }
+    size_t sl_map = sl_bitmaps_[fl] & (~size_t(0) << sl);
+    if (sl_map == 0) {
+      if (fl + 1 >= kNumFirstLevel) {
+        return nullptr;
+      }
+      size_t fl_map = fl_bitmap_ & (~size_t(0) << (fl + 1));
+      if (fl_map == 0) {
+        return nullptr;
+      }
+      fl = cpp20::countr_zero(fl_map);
+      sl_map = sl_bitmaps_[fl];
+    }
+    sl = cpp20::countr_zero(sl_map);
+    return free_lists_[fl][sl];
+  }
+
+  static FreeNode* GetNode(BlockType* block) {
+    return std::launder(reinterpret_cast<FreeNode*>(block->UsableSpace()));
+  }
+
+  /// Adds a free block to the index, if it is large enough to hold links.
+  void InsertBlock(BlockType* block) {
+    if (block->InnerSize() < kMinIndexedSize) {
+      return;
+    }
+    size_t fl, sl;
+    MapSize(block->InnerSize(), fl, sl);
+    BlockType*& head = free_lists_[fl][sl];
+    new (block->UsableSpace()) FreeNode{nullptr, head};
+    if (head != nullptr) {
+      GetNode(head)->prev = block;
+    }
+    head = block;
+    fl_bitmap_ |= size_t(1) << fl;
+    sl_bitmaps_[fl] |= static_cast<uint16_t>(1U << sl);
+  }
+
+  /// Removes a free block from the index, if it was large enough to be added.
+  void RemoveBlock(BlockType* block) {
+    if (block->InnerSize() < kMinIndexedSize) {
+      return;
+    }
+    size_t fl, sl;
+    MapSize(block->InnerSize(), fl, sl);
+    FreeNode* node = GetNode(block);
+    if (node->next != nullptr) {
+      GetNode(node->next)->prev = node->prev;
+    }
+    if (node->prev != nullptr) {
+      GetNode(node->prev)->next = node->next;
+      return;
+    }
+    BlockType*& head = free_lists_[fl][sl];
+    head = node->next;
+    if (head == nullptr) {
+      sl_bitmaps_[fl] &= static_cast<uint16_t>(~(1U << sl));
+      if (sl_bitmaps_[fl] == 0) {
+        fl_bitmap_ &= ~(size_t(1) << fl);
+      }
+    }
+  }
+
+  size_t fl_bitmap_ = 0;
+  std::array<uint16_t, kNumFirstLevel> sl_bitmaps_ = {};
+  std::array<std::array<BlockType*, kNumSecondLevel>, kNumFirstLevel>
+      free_lists_ = {};
+};
+
 // Template method implementations
 
 namespace internal {
@@ -426,11 +750,19 @@ Status BlockAllocator<OffsetType, kPoisonInterval, kAlign>::Init(
   }
   first_ = begin;
   last_ = end;
+  deferred_ = nullptr;
+  num_deferred_ = 0;
+  for (auto* block : blocks()) {
+    if (!block->Used()) {
+      RecycleBlock(block);
+    }
+  }
   return OkStatus();
 }
 
 template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
 void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::Reset() {
+  Compact();
   for (auto* block : blocks()) {
     if (block->Used()) {
       CrashOnAllocated(block);
@@ -438,13 +770,32 @@ void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::Reset() {
   }
 }
 
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::SetMaxDeferred(
+    uint16_t max_deferred) {
+  max_deferred_ = max_deferred;
+  if (num_deferred_ > max_deferred_) {
+    Compact();
+  }
+}
+
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::Compact() {
+  while (deferred_ != nullptr) {
+    BlockType* block = deferred_;
+    deferred_ = GetNextDeferred(block);
+    FreeBlock(block);
+  }
+  num_deferred_ = 0;
+}
+
 template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
 void* BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoAllocate(
     Layout layout) {
   if (layout.size() == 0) {
     return nullptr;
   }
-  BlockType* block = ChooseBlock(layout);
+  BlockType* block = AllocateBlock(layout);
   if (block == nullptr) {
     return nullptr;
   }
@@ -452,6 +803,47 @@ void* BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoAllocate(
   return block->UsableSpace();
 }
 
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+size_t BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoAllocateBatch(
+    Layout layout, span<void*> ptrs) {
+  BlockType* prev = nullptr;
+  size_t count = 0;
+  for (void*& ptr : ptrs) {
+    BlockType* block = nullptr;
+    if (prev != nullptr && !prev->Last() && !prev->Next()->Used()) {
+      block = prev->Next();
+      if (block->CanAllocFirst(layout.size(), layout.alignment()).ok()) {
+        ReserveBlock(block);
+        BlockType* chosen = block;
+        auto end = reinterpret_cast<uintptr_t>(block) + block->OuterSize();
+        PW_ASSERT(
+            BlockType::AllocFirst(block, layout.size(), layout.alignment())
+                .ok());
+        if (block != chosen) {
+          RecycleBlock(chosen);
+        }
+        if (!block->Last() &&
+            reinterpret_cast<uintptr_t>(block->Next()) < end) {
+          RecycleBlock(block->Next());
+        }
+      } else {
+        block = nullptr;
+      }
+    }
+    if (block == nullptr) {
+      block = AllocateBlock(layout);
+      if (block == nullptr) {
+        break;
+      }
+    }
+    UpdateLast(block);
+    ptr = block->UsableSpace();
+    prev = block;
+    ++count;
+  }
+  return count;
+}
+
 template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
 void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoDeallocate(
     void* ptr, Layout) {
@@ -461,9 +853,31 @@ void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoDeallocate(
   }
   BlockType* block = *result;
 
+  // Park the block instead of freeing it, if deferring coalescing.
+  if (num_deferred_ < max_deferred_ &&
+      block->InnerSize() >= sizeof(BlockType*)) {
+    SetNextDeferred(block, deferred_);
+    deferred_ = block;
+    ++num_deferred_;
+    return;
+  }
+  FreeBlock(block);
+}
+
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::FreeBlock(
+    BlockType* block) {
   // Free the block and merge it with its neighbors, if possible.
+  BlockType* prev = block->Prev();
+  if (prev != nullptr && !prev->Used()) {
+    ReserveBlock(prev);
+  }
+  if (!block->Last() && !block->Next()->Used()) {
+    ReserveBlock(block->Next());
+  }
   BlockType::Free(block);
   UpdateLast(block);
+  RecycleBlock(block);
 
   if constexpr (kPoisonInterval != 0) {
     ++unpoisoned_;
@@ -483,13 +897,93 @@ bool BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoResize(
   }
   BlockType* block = *result;
 
-  if (!BlockType::Resize(block, new_size).ok()) {
+  // Resizing may merge with or split off a trailing free block.
+  if (!block->Last() && !block->Next()->Used()) {
+    ReserveBlock(block->Next());
+  }
+  Status status = BlockType::Resize(block, new_size);
+  if (!block->Last() && !block->Next()->Used()) {
+    RecycleBlock(block->Next());
+  }
+  if (!status.ok()) {
     return false;
   }
   UpdateLast(block);
   return true;
 }
 
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+void* BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoReallocate(
+    void* ptr, Layout layout, size_t new_size) {
+  if (ptr != nullptr && layout.size() != 0) {
+    if (DoResize(ptr, layout, new_size)) {
+      return ptr;
+    }
+    if (auto result = FromUsableSpace(ptr); result.ok()) {
+      void* new_ptr = ReallocateIntoPrev(*result, layout, new_size);
+      if (new_ptr != nullptr) {
+        return new_ptr;
+      }
+    }
+  }
+  void* new_ptr = DoAllocate(Layout(new_size, layout.alignment()));
+  if (new_ptr == nullptr) {
+    return nullptr;
+  }
+  if (ptr != nullptr && layout.size() != 0) {
+    std::memcpy(new_ptr, ptr, std::min(new_size, layout.size()));
+    DoDeallocate(ptr, layout);
+  }
+  return new_ptr;
+}
+
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+void* BlockAllocator<OffsetType, kPoisonInterval, kAlign>::ReallocateIntoPrev(
+    BlockType* block, Layout layout, size_t new_size) {
+  BlockType* prev = block->Prev();
+  if (prev == nullptr || prev->Used()) {
+    return nullptr;
+  }
+
+  // Only move the data to the start of the preceding block. This guarantees
+  // padding is not needed, and that the data is never overwritten by a block
+  // header.
+  auto addr = reinterpret_cast<uintptr_t>(prev->UsableSpace());
+  if (addr % layout.alignment() != 0) {
+    return nullptr;
+  }
+  BlockType* next = block->Last() ? nullptr : block->Next();
+  if (next != nullptr && next->Used()) {
+    next = nullptr;
+  }
+  size_t available = prev->InnerSize() + block->OuterSize();
+  if (next != nullptr) {
+    available += next->OuterSize();
+  }
+  if (available < AlignUp(new_size, BlockType::kAlignment)) {
+    return nullptr;
+  }
+
+  // Merge the blocks, move the data, and split off any unneeded space.
+  ReserveBlock(prev);
+  if (next != nullptr) {
+    ReserveBlock(next);
+  }
+  std::byte* data = block->UsableSpace();
+  block->MarkFree();
+  PW_ASSERT(BlockType::MergeNext(prev).ok());
+  if (next != nullptr) {
+    PW_ASSERT(BlockType::MergeNext(prev).ok());
+  }
+  std::memmove(prev->UsableSpace(), data, std::min(new_size, layout.size()));
+  PW_ASSERT(BlockType::AllocFirst(prev, new_size, layout.alignment()).ok());
+  if (!prev->Last() && !prev->Next()->Used()) {
+    RecycleBlock(prev->Next());
+  }
+  UpdateLast(prev);
+  return prev->UsableSpace();
+}
+
 template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
 Result<Layout> BlockAllocator<OffsetType, kPoisonInterval, kAlign>::DoGetLayout(
     const void* ptr) const {
@@ -529,5 +1023,62 @@ void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::UpdateLast(
   }
 }
 
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+typename BlockAllocator<OffsetType, kPoisonInterval, kAlign>::BlockType*
+BlockAllocator<OffsetType, kPoisonInterval, kAlign>::AllocateBlock(
+    Layout layout) {
+  BlockType* block = TakeDeferred(layout);
+  if (block != nullptr) {
+    return block;
+  }
+  block = ChooseBlock(layout);
+  if (block == nullptr && deferred_ != nullptr) {
+    Compact();
+    block = ChooseBlock(layout);
+  }
+  return block;
+}
+
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+typename BlockAllocator<OffsetType, kPoisonInterval, kAlign>::BlockType*
+BlockAllocator<OffsetType, kPoisonInterval, kAlign>::TakeDeferred(
+    Layout layout) {
+  size_t max_size =
+      AlignUp(layout.size(), BlockType::kAlignment) + BlockType::kBlockOverhead;
+  BlockType* prev = nullptr;
+  for (BlockType* block = deferred_; block != nullptr;
+       block = GetNextDeferred(block)) {
+    size_t inner_size = block->InnerSize();
+    auto addr = reinterpret_cast<uintptr_t>(block->UsableSpace());
+    if (layout.size() <= inner_size && inner_size < max_size &&
+        addr % layout.alignment() == 0) {
+      if (prev == nullptr) {
+        deferred_ = GetNextDeferred(block);
+      } else {
+        SetNextDeferred(prev, GetNextDeferred(block));
+      }
+      --num_deferred_;
+      return block;
+    }
+    prev = block;
+  }
+  return nullptr;
+}
+
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+typename BlockAllocator<OffsetType, kPoisonInterval, kAlign>::BlockType*
+BlockAllocator<OffsetType, kPoisonInterval, kAlign>::GetNextDeferred(
+    BlockType* block) {
+  BlockType* next;
+  std::memcpy(&next, block->UsableSpace(), sizeof(next));
+  return next;
+}
+
+template <typename OffsetType, uint16_t kPoisonInterval, uint16_t kAlign>
+void BlockAllocator<OffsetType, kPoisonInterval, kAlign>::SetNextDeferred(
+    BlockType* block, BlockType* next) {
+  std::memcpy(block->UsableSpace(), &next, sizeof(next));
+}
+
 }  // namespace internal
 }  // namespace pw::allocator
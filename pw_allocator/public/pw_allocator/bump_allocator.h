@@ -0,0 +1,136 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_allocator/allocator.h"
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+
+namespace pw::allocator {
+
+/// Allocator that carves memory sequentially from a region.
+///
+/// Allocating memory simply advances, or "bumps", a pointer into the region,
+/// and deallocating memory does nothing. Memory is only reclaimed when the
+/// allocator is `Reset` or rolled back to a `Checkpoint`. This makes it very
+/// fast and free of fragmentation, which is well suited to data with a common,
+/// bounded lifetime, such as the temporary objects used to decode a request
+/// and encode its response.
+///
+/// This allocator is NOT thread-safe. Use a `SynchronizedAllocator` to share
+/// it between threads.
+class BumpAllocator : public Allocator {
+ public:
+  /// Opaque marker of how much memory had been allocated at some point.
+  class Checkpoint {
+   private:
+    friend class BumpAllocator;
+    constexpr explicit Checkpoint(size_t offset) : offset_(offset) {}
+    size_t offset_;
+  };
+
+  /// Constructs a BumpAllocator without initializing it.
+  constexpr BumpAllocator() = default;
+
+  /// Constructs a BumpAllocator and initializes it.
+  ///
+  /// @param[in]  region  The memory to allocate from.
+  explicit BumpAllocator(ByteSpan region) { Init(region); }
+
+  /// Sets the memory region to be used by this allocator.
+  ///
+  /// Any memory previously allocated from this object must no longer be in
+  /// use.
+  ///
+  /// @param[in]  region  The memory to allocate from.
+  void Init(ByteSpan region);
+
+  /// Returns the total number of bytes this allocator can hand out.
+  size_t capacity() const { return region_.size(); }
+
+  /// Returns the number of bytes that have been allocated, including any
+  /// padding used to align allocations.
+  size_t used() const { return offset_; }
+
+  /// Returns a marker of the current allocation state.
+  Checkpoint GetCheckpoint() const { return Checkpoint(offset_); }
+
+  /// Releases all memory allocated since the given checkpoint was taken.
+  ///
+  /// Any memory allocated after the checkpoint must no longer be in use.
+  ///
+  /// If less memory is in use than when the checkpoint was taken, this has no
+  /// effect. Otherwise the allocator returns to the checkpoint's state. This is
+  /// true even for a checkpoint made stale by a more recent rollback or reset
+  /// to an earlier point: once memory has been allocated past it again,
+  /// rolling back to it releases that memory. Checkpoints should therefore be
+  /// rolled back in the reverse order they were taken, as `ScopedCheckpoint`
+  /// does, and not used again after an earlier checkpoint is rolled back.
+  void RollBack(Checkpoint checkpoint);
+
+  /// Releases all memory allocated from this object.
+  ///
+  /// Any memory previously allocated from this object must no longer be in
+  /// use.
+  void Reset() { offset_ = 0; }
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void*, Layout) override {}
+
+  /// @copydoc Allocator::Resize
+  ///
+  /// Only the most recent allocation can be resized.
+  bool DoResize(void* ptr, Layout layout, size_t new_size) override;
+
+  /// @copydoc Allocator::Query
+  Status DoQuery(const void* ptr, Layout layout) const override;
+
+  ByteSpan region_;
+  size_t offset_ = 0;
+};
+
+/// RAII type that rolls back a `BumpAllocator` when it goes out of scope.
+///
+/// This can be used to give a routine, such as an RPC method handler, a
+/// temporary arena whose memory is released wholesale when it completes, e.g.
+///
+/// @code{.cpp}
+///   void MyService::MyMethod(const Request& request, Response& response) {
+///     ScopedCheckpoint scope(arena_);
+///     Foo* foo = arena_.New<Foo>(request);
+///     ...
+///   }  // All memory allocated from `arena_` is released here.
+/// @endcode
+class ScopedCheckpoint {
+ public:
+  explicit ScopedCheckpoint(BumpAllocator& allocator)
+      : allocator_(allocator), checkpoint_(allocator.GetCheckpoint()) {}
+
+  ~ScopedCheckpoint() { allocator_.RollBack(checkpoint_); }
+
+  ScopedCheckpoint(const ScopedCheckpoint&) = delete;
+  ScopedCheckpoint& operator=(const ScopedCheckpoint&) = delete;
+
+ private:
+  BumpAllocator& allocator_;
+  BumpAllocator::Checkpoint checkpoint_;
+};
+
+}  // namespace pw::allocator
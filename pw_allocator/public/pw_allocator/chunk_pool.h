@@ -0,0 +1,128 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "pw_allocator/allocator.h"
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+
+namespace pw::allocator {
+
+/// Allocator that hands out fixed-size chunks of memory from a region.
+///
+/// The region is divided into equally sized chunks, each large enough to hold
+/// the layout given on construction. Requests for memory that fit within that
+/// layout are satisfied with a chunk, and all other requests fail.
+///
+/// Free chunks are tracked by an intrusive stack that is updated using atomic
+/// compare-and-swap operations, so both `Allocate` and `Deallocate` are
+/// lock-free and take constant time. The stack head includes a generation tag
+/// to guard against ABA problems. As a result, this allocator may be shared
+/// between threads and interrupt handlers without additional synchronization,
+/// provided the target supports lock-free 32-bit atomics.
+///
+/// A region may hold at most 65535 chunks; any remaining memory is unused.
+class ChunkPool : public Allocator {
+ public:
+  /// Constructs a pool from a region of memory.
+  ///
+  /// @param[in]  region  Memory to carve into chunks.
+  /// @param[in]  layout  Describes the memory to be returned by each chunk.
+  ChunkPool(ByteSpan region, const Layout& layout);
+
+  /// Returns the layout that every chunk can hold.
+  Layout layout() const { return Layout(chunk_size_, alignment_); }
+
+  /// Returns the total number of chunks in the pool.
+  size_t num_chunks() const { return num_chunks_; }
+
+ private:
+  using Index = uint16_t;
+  static constexpr Index kNone = std::numeric_limits<Index>::max();
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, Layout layout) override;
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, Layout layout, size_t new_size) override;
+
+  /// @copydoc Allocator::GetLayout
+  Result<Layout> DoGetLayout(const void* ptr) const override;
+
+  /// @copydoc Allocator::Query
+  Status DoQuery(const void* ptr, Layout layout) const override;
+
+  /// Returns the index of the chunk that starts at `ptr`, or `kNone` if `ptr`
+  /// does not point to the start of a chunk in this pool.
+  Index GetIndex(const void* ptr) const;
+
+  /// Returns the index of the next free chunk stored in a free chunk.
+  Index GetNext(Index index) const;
+
+  /// Stores the index of the next free chunk in a free chunk.
+  void SetNext(Index index, Index next);
+
+  std::byte* begin_ = nullptr;
+  size_t chunk_size_ = 0;
+  size_t alignment_ = 1;
+  Index num_chunks_ = 0;
+
+  // The low 16 bits are the index of the first free chunk. The high 16 bits
+  // are a tag that is incremented on every update.
+  std::atomic<uint32_t> head_;
+};
+
+/// Pool of chunks that can each hold an object of type `T`.
+///
+/// This class owns the memory used by the pool, and is intended to be used to
+/// quickly allocate objects of a single type, e.g.
+///
+/// @code{.cpp}
+///   TypedPool<MyObject, 8> pool;
+///   MyObject* obj = pool.New<MyObject>(arg1, arg2);
+///   ...
+///   pool.Delete(obj);
+/// @endcode
+///
+/// @tparam   T             Type of objects to allocate.
+/// @tparam   kNumObjects   Maximum number of objects that can be allocated.
+template <typename T, size_t kNumObjects>
+class TypedPool : public ChunkPool {
+ public:
+  static_assert(kNumObjects < std::numeric_limits<uint16_t>::max(),
+                "TypedPool can hold at most 65534 objects");
+
+  TypedPool() : ChunkPool(buffer_, Layout::Of<Chunk>()) {}
+
+ private:
+  // Each chunk must be able to hold a free list index when not in use.
+  union Chunk {
+    alignas(T) std::array<std::byte, sizeof(T)> object;
+    uint16_t next;
+  };
+
+  alignas(Chunk) std::array<std::byte, sizeof(Chunk) * kNumObjects> buffer_;
+};
+
+}  // namespace pw::allocator
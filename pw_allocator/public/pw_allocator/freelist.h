@@ -34,7 +34,8 @@ class FreeListBuffer;
 ///
 /// Each added chunk will be added to the smallest bucket under which it fits.
 /// If it does not fit into any user-provided bucket, it will be added to the
-/// default bucket.
+/// default bucket. Each bucket is kept sorted by chunk size, so that the first
+/// suitable chunk is also the smallest.
 ///
 /// As an example, assume that the `FreeList` is configured with buckets of
 /// sizes {64, 128, 256, and 512} bytes. The internal state may look like the
@@ -44,8 +45,8 @@ class FreeListBuffer;
 /// bucket[0] (64B) --> chunk[12B] --> chunk[42B] --> chunk[64B] --> NULL
 /// bucket[1] (128B) --> chunk[65B] --> chunk[72B] --> NULL
 /// bucket[2] (256B) --> NULL
-/// bucket[3] (512B) --> chunk[312B] --> chunk[512B] --> chunk[416B] --> NULL
-/// bucket[4] (implicit) --> chunk[1024B] --> chunk[513B] --> NULL
+/// bucket[3] (512B) --> chunk[312B] --> chunk[416B] --> chunk[512B] --> NULL
+/// bucket[4] (implicit) --> chunk[513B] --> chunk[1024B] --> NULL
 /// @endcode
 ///
 /// Note that added chunks should be aligned to a 4-byte boundary.
@@ -66,6 +67,9 @@ class FreeList {
 
   /// Adds a chunk to this freelist.
   ///
+  /// The chunk is inserted into its bucket in order of size. This takes time
+  /// proportional to the number of smaller chunks in the same bucket.
+  ///
   /// @returns
   /// * @pw_status{OK} - The chunk was added successfully.
   /// * @pw_status{OUT_OF_RANGE} - The chunk could not be added for size
@@ -74,8 +78,8 @@ class FreeList {
 
   /// Finds an eligible chunk for an allocation of size `size`.
   ///
-  /// @note This returns the first allocation possible within a given bucket;
-  /// It does not currently optimize for finding the smallest chunk.
+  /// Since buckets are sorted by size, this returns the smallest chunk that
+  /// can satisfy the allocation, i.e. the best fit.
   ///
   /// @returns
   /// * On success - A span representing the chunk.
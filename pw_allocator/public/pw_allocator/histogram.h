@@ -0,0 +1,26 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_metric/histogram.h"
+
+namespace pw::allocator {
+
+/// Counts values using 16 buckets whose bounds are powers of two.
+///
+/// This is the `pw_metric` histogram used by `ProfilingAllocator`; see
+/// `pw::metric::Log2Histogram` for details.
+using Log2Histogram = metric::Log2Histogram<16>;
+
+}  // namespace pw::allocator
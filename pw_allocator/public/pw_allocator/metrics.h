@@ -45,6 +45,8 @@ PW_ALLOCATOR_METRICS_DECLARE(num_deallocations);
 PW_ALLOCATOR_METRICS_DECLARE(num_resizes);
 PW_ALLOCATOR_METRICS_DECLARE(num_reallocations);
 PW_ALLOCATOR_METRICS_DECLARE(num_failures);
+PW_ALLOCATOR_METRICS_DECLARE(num_cache_hits);
+PW_ALLOCATOR_METRICS_DECLARE(num_cache_misses);
 #undef PW_ALLOCATOR_METRICS_DECLARE
 
 /// Enables a metric for in a metrics struct.
@@ -81,6 +83,8 @@ struct AllMetrics {
   PW_ALLOCATOR_METRICS_ENABLE(num_resizes);
   PW_ALLOCATOR_METRICS_ENABLE(num_reallocations);
   PW_ALLOCATOR_METRICS_ENABLE(num_failures);
+  PW_ALLOCATOR_METRICS_ENABLE(num_cache_hits);
+  PW_ALLOCATOR_METRICS_ENABLE(num_cache_misses);
 };
 
 /// A predefined metric struct that enables no allocator metrics.
@@ -137,6 +141,17 @@ class Metrics final {
   /// may indicated memory becoming exhausted and/or high fragmentation.
   void RecordFailure();
 
+  /// Records requests that were satisfied by or returned to a cache.
+  ///
+  /// @param  count             Number of requests that hit a cache.
+  void RecordCacheHits(size_t count);
+
+  /// Records requests that could not be satisfied by or returned to a cache,
+  /// and were forwarded to another allocator instead.
+  ///
+  /// @param  count             Number of requests that missed a cache.
+  void RecordCacheMisses(size_t count);
+
  private:
   /// @copydoc RecordAllocation
   void RecordAllocationImpl(uint32_t new_size);
@@ -186,6 +201,12 @@ Metrics<MetricsType>::Metrics(metric::Token token) : group_(token) {
   if constexpr (has_num_failures<MetricsType>::value) {
     group_.Add(metrics_.num_failures);
   }
+  if constexpr (has_num_cache_hits<MetricsType>::value) {
+    group_.Add(metrics_.num_cache_hits);
+  }
+  if constexpr (has_num_cache_misses<MetricsType>::value) {
+    group_.Add(metrics_.num_cache_misses);
+  }
 }
 
 template <typename MetricsType>
@@ -278,5 +299,19 @@ void Metrics<MetricsType>::RecordFailure() {
   }
 }
 
+template <typename MetricsType>
+void Metrics<MetricsType>::RecordCacheHits(size_t count) {
+  if constexpr (has_num_cache_hits<MetricsType>::value) {
+    metrics_.num_cache_hits.Increment(internal::ClampU32(count));
+  }
+}
+
+template <typename MetricsType>
+void Metrics<MetricsType>::RecordCacheMisses(size_t count) {
+  if constexpr (has_num_cache_misses<MetricsType>::value) {
+    metrics_.num_cache_misses.Increment(internal::ClampU32(count));
+  }
+}
+
 }  // namespace internal
 }  // namespace pw::allocator
@@ -0,0 +1,145 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/histogram.h"
+#include "pw_allocator/metrics.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_metric/metric.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+
+namespace pw::allocator {
+
+/// Wraps an `Allocator` and records how its performance changes over time.
+///
+/// This allocator records the latencies of calls to `Allocate` and
+/// `Deallocate`, in microseconds, as `Log2Histogram`s. It can also record the
+/// fragmentation of a block-based allocator's free memory: the size of the
+/// largest free block, the number of free blocks, and a histogram of free
+/// blocks by size. Together, these can be used to detect heap degradation in
+/// the field before allocations start failing.
+///
+/// All metrics are part of this allocator's metric group, and can be exported
+/// using `pw::metric::MetricService`.
+///
+/// Like `TrackingAllocator`, this class is NOT thread-safe; wrap it in a
+/// `SynchronizedAllocator` if needed.
+class ProfilingAllocator : public Allocator {
+ public:
+  /// Constructs a profiling allocator.
+  ///
+  /// @param[in]  token     Name of the metric group for this allocator.
+  /// @param[in]  allocator Allocator to forward requests to.
+  /// @param[in]  clock     Clock used to measure latencies.
+  ProfilingAllocator(metric::Token token,
+                     Allocator& allocator,
+                     chrono::VirtualSystemClock& clock =
+                         chrono::VirtualSystemClock::RealClock());
+
+  const metric::Group& metric_group() const { return group_; }
+  metric::Group& metric_group() { return group_; }
+
+  /// Returns the histogram of `Allocate` latencies.
+  const Log2Histogram& allocate_latency() const { return allocate_latency_; }
+
+  /// Returns the histogram of `Deallocate` latencies.
+  const Log2Histogram& deallocate_latency() const {
+    return deallocate_latency_;
+  }
+
+  /// Returns the histogram of free block sizes, in bytes.
+  const Log2Histogram& free_block_sizes() const { return free_block_sizes_; }
+
+  /// Returns the size of the largest free block, in bytes.
+  uint32_t largest_free_block() const { return largest_free_block_.value(); }
+
+  /// Returns the number of free blocks.
+  uint32_t num_free_blocks() const { return num_free_blocks_.value(); }
+
+  /// Updates the fragmentation metrics from a range of blocks, such as those
+  /// returned by `BlockAllocator::blocks()`.
+  ///
+  /// Walking the blocks takes time proportional to their number, so this
+  /// should be called periodically, e.g. before metrics are exported, rather
+  /// than on every request.
+  template <typename BlockRange>
+  void UpdateFragmentation(BlockRange&& blocks);
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, Layout layout) override;
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, Layout layout, size_t new_size) override {
+    return allocator_.Resize(ptr, layout, new_size);
+  }
+
+  /// @copydoc Allocator::Reallocate
+  void* DoReallocate(void* ptr, Layout layout, size_t new_size) override {
+    return allocator_.Reallocate(ptr, layout, new_size);
+  }
+
+  /// @copydoc Allocator::GetLayout
+  Result<Layout> DoGetLayout(const void* ptr) const override {
+    return allocator_.GetLayout(ptr);
+  }
+
+  /// @copydoc Allocator::Query
+  Status DoQuery(const void* ptr, Layout layout) const override {
+    return allocator_.Query(ptr, layout);
+  }
+
+  /// Returns the microseconds elapsed since `start`.
+  uint32_t ElapsedUs(chrono::SystemClock::time_point start);
+
+  Allocator& allocator_;
+  chrono::VirtualSystemClock& clock_;
+  metric::Group group_;
+  Log2Histogram allocate_latency_;
+  Log2Histogram deallocate_latency_;
+  Log2Histogram free_block_sizes_;
+  PW_METRIC(group_, largest_free_block_, "largest_free_block", 0U);
+  PW_METRIC(group_, num_free_blocks_, "num_free_blocks", 0U);
+};
+
+// Template method implementations.
+
+template <typename BlockRange>
+void ProfilingAllocator::UpdateFragmentation(BlockRange&& blocks) {
+  size_t largest = 0;
+  size_t count = 0;
+  free_block_sizes_.Clear();
+  for (const auto* block : blocks) {
+    if (block->Used()) {
+      continue;
+    }
+    size_t inner_size = block->InnerSize();
+    largest = std::max(largest, inner_size);
+    ++count;
+    free_block_sizes_.Record(internal::ClampU32(inner_size));
+  }
+  largest_free_block_.Set(internal::ClampU32(largest));
+  num_free_blocks_.Set(internal::ClampU32(count));
+}
+
+}  // namespace pw::allocator
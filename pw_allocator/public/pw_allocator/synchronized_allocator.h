@@ -44,12 +44,24 @@ class SynchronizedAllocator : public Allocator {
     return allocator->Allocate(layout);
   }
 
+  /// @copydoc Allocator::AllocateBatch
+  size_t DoAllocateBatch(Layout layout, span<void*> ptrs) override {
+    pointer_type allocator = borrowable_.acquire();
+    return allocator->AllocateBatch(layout, ptrs);
+  }
+
   /// @copydoc Allocator::Deallocate
   void DoDeallocate(void* ptr, Layout layout) override {
     pointer_type allocator = borrowable_.acquire();
     return allocator->Deallocate(ptr, layout);
   }
 
+  /// @copydoc Allocator::DeallocateBatch
+  void DoDeallocateBatch(span<void* const> ptrs, Layout layout) override {
+    pointer_type allocator = borrowable_.acquire();
+    allocator->DeallocateBatch(ptrs, layout);
+  }
+
   /// @copydoc Allocator::Resize
   bool DoResize(void* ptr, Layout layout, size_t new_size) override {
     pointer_type allocator = borrowable_.acquire();
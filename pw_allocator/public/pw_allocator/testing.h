@@ -124,6 +124,16 @@ class AllocatorForTest : public Allocator {
     tracker_.Deallocate(ptr, layout);
   }
 
+  /// @copydoc Allocator::AllocateBatch
+  size_t DoAllocateBatch(Layout layout, span<void*> ptrs) override {
+    return tracker_.AllocateBatch(layout, ptrs);
+  }
+
+  /// @copydoc Allocator::DeallocateBatch
+  void DoDeallocateBatch(span<void* const> ptrs, Layout layout) override {
+    tracker_.DeallocateBatch(ptrs, layout);
+  }
+
   /// @copydoc Allocator::Reallocate
   void* DoReallocate(void* ptr, Layout layout, size_t new_size) override {
     return tracker_.Reallocate(ptr, layout, new_size);
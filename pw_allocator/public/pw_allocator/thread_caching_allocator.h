@@ -0,0 +1,269 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/metrics.h"
+#include "pw_metric/metric.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_thread/id.h"
+
+namespace pw::allocator {
+
+/// Wraps an `Allocator` with per-thread caches of recently freed memory.
+///
+/// Each thread that uses this allocator claims one of `kNumThreads` caches.
+/// Each cache holds up to `kCacheDepth` freed pointers for each of the
+/// `kNumLayouts` layouts given on construction. Requests are mapped to the
+/// smallest of these layouts that can satisfy them. A request for a cached
+/// layout is satisfied from the calling thread's cache when possible, and
+/// freed memory is returned to the calling thread's cache until it is full.
+/// Only misses are forwarded to the wrapped allocator, which is typically a
+/// `SynchronizedAllocator`. Since each cache is only ever accessed by the
+/// thread that claimed it, hits do not need to acquire any lock.
+///
+/// Requests that do not fit any cached layout, and requests made by threads
+/// when no cache is available to be claimed, are forwarded directly to the
+/// wrapped allocator.
+///
+/// A thread that exits should call `ReleaseThreadCache` to return its cached
+/// memory and allow its cache to be claimed by another thread. This allocator
+/// must NOT be used from interrupt context.
+///
+/// @tparam kNumThreads   Maximum number of threads with caches.
+/// @tparam kNumLayouts   Number of distinct layouts that can be cached.
+/// @tparam kCacheDepth   Maximum number of pointers cached per thread and
+///                       layout.
+/// @tparam MetricsType   Struct that enables allocator cache metrics. See
+///                       `PW_ALLOCATOR_METRICS_ENABLE`.
+template <size_t kNumThreads,
+          size_t kNumLayouts,
+          size_t kCacheDepth,
+          typename MetricsType = NoMetrics>
+class ThreadCachingAllocator : public Allocator {
+ public:
+  using metric_type = MetricsType;
+
+  /// Constructs a thread-caching allocator.
+  ///
+  /// @param[in]  token     Name of the metric group for this allocator.
+  /// @param[in]  allocator Thread-safe allocator to forward misses to.
+  /// @param[in]  layouts   Layouts to cache, in order of increasing size.
+  ThreadCachingAllocator(metric::Token token,
+                         Allocator& allocator,
+                         const std::array<Layout, kNumLayouts>& layouts)
+      : allocator_(allocator), layouts_(layouts), metrics_(token) {}
+
+  /// Returns all cached memory to the wrapped allocator.
+  ///
+  /// There MUST NOT be any concurrent calls to this object when it is
+  /// destroyed.
+  ~ThreadCachingAllocator() override {
+    for (auto& cache : caches_) {
+      Flush(cache);
+    }
+  }
+
+  const metric::Group& metric_group() const { return metrics_.group(); }
+  metric::Group& metric_group() { return metrics_.group(); }
+
+  const MetricsType& metrics() const { return metrics_.metrics(); }
+
+  /// Adds cache hits and misses since the last update to the metrics.
+  ///
+  /// To avoid contention, hits and misses are counted by each cache and only
+  /// copied to the metrics when this method is called. Calls to it must not be
+  /// made concurrently, e.g. by only calling it from the thread that dumps or
+  /// serves the metrics.
+  void UpdateMetrics() {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    for (auto& cache : caches_) {
+      hits += cache.hits.load(std::memory_order_relaxed);
+      misses += cache.misses.load(std::memory_order_relaxed);
+    }
+    metrics_.RecordCacheHits(static_cast<uint32_t>(hits - reported_hits_));
+    metrics_.RecordCacheMisses(
+        static_cast<uint32_t>(misses - reported_misses_));
+    reported_hits_ = hits;
+    reported_misses_ = misses;
+  }
+
+  /// Returns the calling thread's cached memory to the wrapped allocator and
+  /// makes its cache available to other threads.
+  void ReleaseThreadCache() {
+    ThreadCache* cache = FindCache(this_thread::get_id());
+    if (cache != nullptr) {
+      Flush(*cache);
+      cache->state.store(kUnclaimed, std::memory_order_release);
+    }
+  }
+
+ private:
+  enum State : uint8_t {
+    kUnclaimed,
+    kClaiming,
+    kClaimed,
+  };
+
+  struct Magazine {
+    std::array<void*, kCacheDepth> ptrs;
+    size_t count = 0;
+  };
+
+  struct ThreadCache {
+    std::atomic<uint8_t> state = kUnclaimed;
+    thread::Id id;
+    std::array<Magazine, kNumLayouts> magazines;
+
+    // These are only written by the owning thread, but may be read by any.
+    std::atomic<uint32_t> hits = 0;
+    std::atomic<uint32_t> misses = 0;
+  };
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override {
+    size_t index = FindLayout(layout);
+    if (index == kNumLayouts) {
+      return allocator_.Allocate(layout);
+    }
+    ThreadCache* cache = GetCache();
+    if (cache != nullptr) {
+      Magazine& magazine = cache->magazines[index];
+      if (magazine.count != 0) {
+        Count(cache->hits);
+        return magazine.ptrs[--magazine.count];
+      }
+      Count(cache->misses);
+    }
+    return allocator_.Allocate(layouts_[index]);
+  }
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, Layout layout) override {
+    size_t index = FindLayout(layout);
+    if (index == kNumLayouts) {
+      allocator_.Deallocate(ptr, layout);
+      return;
+    }
+    ThreadCache* cache = GetCache();
+    if (cache != nullptr) {
+      Magazine& magazine = cache->magazines[index];
+      if (magazine.count < kCacheDepth) {
+        Count(cache->hits);
+        magazine.ptrs[magazine.count++] = ptr;
+        return;
+      }
+      Count(cache->misses);
+    }
+    allocator_.Deallocate(ptr, layouts_[index]);
+  }
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, Layout layout, size_t new_size) override {
+    size_t index = FindLayout(layout);
+    if (index == kNumLayouts) {
+      return allocator_.Resize(ptr, layout, new_size);
+    }
+    // Cached memory must retain its cached layout. Resizing is only possible
+    // if the new size maps to the same layout.
+    return FindLayout(Layout(new_size, layout.alignment())) == index;
+  }
+
+  /// @copydoc Allocator::GetLayout
+  Result<Layout> DoGetLayout(const void* ptr) const override {
+    return allocator_.GetLayout(ptr);
+  }
+
+  /// @copydoc Allocator::Query
+  Status DoQuery(const void* ptr, Layout layout) const override {
+    size_t index = FindLayout(layout);
+    return index == kNumLayouts ? allocator_.Query(ptr, layout)
+                                : allocator_.Query(ptr, layouts_[index]);
+  }
+
+  /// Returns the index of the smallest cached layout that can satisfy the
+  /// given layout, or `kNumLayouts` if there is no such layout.
+  size_t FindLayout(Layout layout) const {
+    for (size_t i = 0; i < kNumLayouts; ++i) {
+      if (layout.size() <= layouts_[i].size() &&
+          layout.alignment() <= layouts_[i].alignment()) {
+        return i;
+      }
+    }
+    return kNumLayouts;
+  }
+
+  /// Returns the cache claimed by the given thread, or null if it has none.
+  ThreadCache* FindCache(thread::Id id) {
+    for (auto& cache : caches_) {
+      if (cache.state.load(std::memory_order_acquire) == kClaimed &&
+          cache.id == id) {
+        return &cache;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Returns the calling thread's cache, claiming one if needed. Returns null
+  /// if the thread has no cache and none are available.
+  ThreadCache* GetCache() {
+    thread::Id id = this_thread::get_id();
+    ThreadCache* cache = FindCache(id);
+    if (cache != nullptr) {
+      return cache;
+    }
+    for (auto& candidate : caches_) {
+      uint8_t expected = kUnclaimed;
+      if (candidate.state.compare_exchange_strong(
+              expected, kClaiming, std::memory_order_acquire)) {
+        candidate.id = id;
+        candidate.state.store(kClaimed, std::memory_order_release);
+        return &candidate;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Returns all the memory held by a cache to the wrapped allocator.
+  void Flush(ThreadCache& cache) {
+    for (size_t i = 0; i < kNumLayouts; ++i) {
+      Magazine& magazine = cache.magazines[i];
+      while (magazine.count != 0) {
+        allocator_.Deallocate(magazine.ptrs[--magazine.count], layouts_[i]);
+      }
+    }
+  }
+
+  /// Increments a counter that is only written by a single thread.
+  static void Count(std::atomic<uint32_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  Allocator& allocator_;
+  const std::array<Layout, kNumLayouts> layouts_;
+  std::array<ThreadCache, kNumThreads> caches_;
+  internal::Metrics<MetricsType> metrics_;
+  uint32_t reported_hits_ = 0;
+  uint32_t reported_misses_ = 0;
+};
+
+}  // namespace pw::allocator
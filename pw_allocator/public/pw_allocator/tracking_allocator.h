@@ -70,12 +70,34 @@ class TrackingAllocatorImpl : public Allocator {
     return ptr;
   }
 
+  /// @copydoc Allocator::AllocateBatch
+  size_t DoAllocateBatch(Layout layout, span<void*> ptrs) override {
+    size_t count = allocator_.AllocateBatch(layout, ptrs);
+    for (size_t i = 0; i < count; ++i) {
+      metrics_.RecordAllocation(layout.size());
+    }
+    if (count < ptrs.size()) {
+      metrics_.RecordFailure();
+    }
+    return count;
+  }
+
   /// @copydoc Allocator::Deallocate
   void DoDeallocate(void* ptr, Layout layout) override {
     allocator_.Deallocate(ptr, layout);
     metrics_.RecordDeallocation(layout.size());
   }
 
+  /// @copydoc Allocator::DeallocateBatch
+  void DoDeallocateBatch(span<void* const> ptrs, Layout layout) override {
+    allocator_.DeallocateBatch(ptrs, layout);
+    for (void* ptr : ptrs) {
+      if (ptr != nullptr) {
+        metrics_.RecordDeallocation(layout.size());
+      }
+    }
+  }
+
   /// @copydoc Allocator::Resize
   bool DoResize(void* ptr, Layout layout, size_t new_size) override {
     if (!allocator_.Resize(ptr, layout, new_size)) {
@@ -0,0 +1,183 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/thread_caching_allocator.h"
+
+#include "pw_allocator/metrics.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_allocator/testing.h"
+#include "pw_sync/binary_semaphore.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::allocator {
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kCapacity = 1024;
+static constexpr size_t kNumThreads = 2;
+static constexpr size_t kCacheDepth = 4;
+static constexpr metric::Token kToken = 1U;
+
+struct CacheMetrics {
+  PW_ALLOCATOR_METRICS_ENABLE(num_cache_hits);
+  PW_ALLOCATOR_METRICS_ENABLE(num_cache_misses);
+};
+
+constexpr std::array<Layout, 2> kLayouts = {
+    Layout(16, alignof(uint32_t)),
+    Layout(64, alignof(uint32_t)),
+};
+
+using ThreadCachingAllocatorForTest =
+    ThreadCachingAllocator<kNumThreads,
+                           kLayouts.size(),
+                           kCacheDepth,
+                           CacheMetrics>;
+
+class ThreadCachingAllocatorTest : public ::testing::Test {
+ protected:
+  ThreadCachingAllocatorTest()
+      : synchronized_(allocator_), caching_(kToken, synchronized_, kLayouts) {}
+
+  test::AllocatorForTest<kCapacity> allocator_;
+  SynchronizedAllocator<sync::Mutex> synchronized_;
+  ThreadCachingAllocatorForTest caching_;
+};
+
+/// Thread body that allocates and frees memory, then releases its cache.
+class Worker : public thread::ThreadCore {
+ public:
+  Worker(ThreadCachingAllocatorForTest& allocator) : allocator_(allocator) {}
+
+  void* ptr() const { return ptr_; }
+
+  void Wait() { done_.acquire(); }
+
+ private:
+  void Run() override {
+    ptr_ = allocator_.Allocate(kLayouts[0]);
+    allocator_.Deallocate(ptr_, kLayouts[0]);
+    allocator_.ReleaseThreadCache();
+    done_.release();
+  }
+
+  ThreadCachingAllocatorForTest& allocator_;
+  void* ptr_ = nullptr;
+  sync::BinarySemaphore done_;
+};
+
+// Unit tests.
+
+TEST_F(ThreadCachingAllocatorTest, ReusesFreedMemory) {
+  void* ptr1 = caching_.Allocate(kLayouts[0]);
+  ASSERT_NE(ptr1, nullptr);
+  caching_.Deallocate(ptr1, kLayouts[0]);
+  EXPECT_EQ(allocator_.metrics().num_deallocations.value(), 0U);
+
+  void* ptr2 = caching_.Allocate(kLayouts[0]);
+  EXPECT_EQ(ptr1, ptr2);
+  EXPECT_EQ(allocator_.metrics().num_allocations.value(), 1U);
+  caching_.Deallocate(ptr2, kLayouts[0]);
+}
+
+TEST_F(ThreadCachingAllocatorTest, MapsRequestsToCachedLayouts) {
+  void* ptr = caching_.Allocate(Layout(32, 1));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator_.allocate_size(), kLayouts[1].size());
+
+  EXPECT_TRUE(caching_.Resize(ptr, Layout(32, 1), 48));
+  EXPECT_FALSE(caching_.Resize(ptr, Layout(48, 1), 8));
+  caching_.Deallocate(ptr, Layout(48, 1));
+
+  EXPECT_EQ(caching_.Allocate(Layout(40, 1)), ptr);
+  caching_.Deallocate(ptr, Layout(40, 1));
+}
+
+TEST_F(ThreadCachingAllocatorTest, ForwardsUncachedLayouts) {
+  constexpr Layout kLarge(128, alignof(uint32_t));
+  void* ptr = caching_.Allocate(kLarge);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator_.allocate_size(), kLarge.size());
+  caching_.Deallocate(ptr, kLarge);
+  EXPECT_EQ(allocator_.deallocate_ptr(), ptr);
+  EXPECT_EQ(allocator_.deallocate_size(), kLarge.size());
+}
+
+TEST_F(ThreadCachingAllocatorTest, ForwardsWhenCacheIsFull) {
+  std::array<void*, kCacheDepth + 1> ptrs;
+  for (auto& ptr : ptrs) {
+    ptr = caching_.Allocate(kLayouts[1]);
+    ASSERT_NE(ptr, nullptr);
+  }
+  for (auto* ptr : ptrs) {
+    caching_.Deallocate(ptr, kLayouts[1]);
+  }
+  EXPECT_EQ(allocator_.metrics().num_deallocations.value(), 1U);
+  EXPECT_EQ(allocator_.deallocate_ptr(), ptrs.back());
+}
+
+TEST_F(ThreadCachingAllocatorTest, RecordsHitsAndMisses) {
+  void* ptr = caching_.Allocate(kLayouts[0]);
+  caching_.Deallocate(ptr, kLayouts[0]);
+  ptr = caching_.Allocate(kLayouts[0]);
+  caching_.Deallocate(ptr, kLayouts[0]);
+
+  const CacheMetrics& metrics = caching_.metrics();
+  EXPECT_EQ(metrics.num_cache_hits.value(), 0U);
+  EXPECT_EQ(metrics.num_cache_misses.value(), 0U);
+
+  caching_.UpdateMetrics();
+  EXPECT_EQ(metrics.num_cache_hits.value(), 3U);
+  EXPECT_EQ(metrics.num_cache_misses.value(), 1U);
+
+  caching_.UpdateMetrics();
+  EXPECT_EQ(metrics.num_cache_hits.value(), 3U);
+  EXPECT_EQ(metrics.num_cache_misses.value(), 1U);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ReleaseThreadCacheReturnsMemory) {
+  void* ptr = caching_.Allocate(kLayouts[0]);
+  caching_.Deallocate(ptr, kLayouts[0]);
+  EXPECT_EQ(allocator_.metrics().num_deallocations.value(), 0U);
+  caching_.ReleaseThreadCache();
+  EXPECT_EQ(allocator_.metrics().num_deallocations.value(), 1U);
+  EXPECT_EQ(allocator_.deallocate_ptr(), ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ThreadsUseSeparateCaches) {
+  void* ptr = caching_.Allocate(kLayouts[0]);
+  caching_.Deallocate(ptr, kLayouts[0]);
+
+  // Memory cached by this thread is not used by the worker.
+  Worker worker(caching_);
+  thread::test::TestThreadContext context;
+  thread::Thread thread(context.options(), worker);
+  worker.Wait();
+  if (thread.joinable()) {
+    thread.join();
+  }
+  EXPECT_NE(worker.ptr(), ptr);
+  EXPECT_EQ(allocator_.deallocate_ptr(), worker.ptr());
+
+  EXPECT_EQ(caching_.Allocate(kLayouts[0]), ptr);
+  caching_.Deallocate(ptr, kLayouts[0]);
+}
+
+}  // namespace
+}  // namespace pw::allocator
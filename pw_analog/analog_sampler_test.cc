@@ -0,0 +1,169 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_analog/analog_sampler.h"
+
+#include <algorithm>
+#include <array>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::analog {
+namespace {
+
+constexpr size_t kChannels = 2;
+
+// Fake sampler that fills buffers with increasing values when Complete() is
+// called, in place of a DMA interrupt.
+class TestAnalogSampler : public AnalogSampler {
+ public:
+  size_t GetChannelCount() const override { return kChannels; }
+
+  AnalogInput::Limits GetLimits() const override {
+    return {.min = 0, .max = 4095};
+  }
+
+  bool sampling() const { return callback_ != nullptr; }
+
+  void Complete() {
+    span<int32_t> filled = buffers_[next_];
+    for (int32_t& sample : filled) {
+      sample = next_sample_++;
+    }
+    Callback callback = std::move(callback_);
+    if (continuous_) {
+      next_ ^= 1;
+      callback(OkStatus(), filled);
+      callback_ = std::move(callback);
+    } else {
+      callback(OkStatus(), filled);
+    }
+  }
+
+ private:
+  Status DoStartBurst(span<int32_t> buffer, Callback&& on_complete) override {
+    if (sampling()) {
+      return Status::FailedPrecondition();
+    }
+    buffers_ = {buffer, buffer};
+    continuous_ = false;
+    next_ = 0;
+    callback_ = std::move(on_complete);
+    return OkStatus();
+  }
+
+  Status DoStartContinuous(span<int32_t> first,
+                           span<int32_t> second,
+                           Callback&& on_buffer_full) override {
+    if (sampling()) {
+      return Status::FailedPrecondition();
+    }
+    buffers_ = {first, second};
+    continuous_ = true;
+    next_ = 0;
+    callback_ = std::move(on_buffer_full);
+    return OkStatus();
+  }
+
+  void DoStop() override { callback_ = nullptr; }
+
+  std::array<span<int32_t>, 2> buffers_;
+  bool continuous_ = false;
+  size_t next_ = 0;
+  int32_t next_sample_ = 0;
+  Callback callback_;
+};
+
+TEST(AnalogSamplerTest, Burst) {
+  TestAnalogSampler sampler;
+  std::array<int32_t, 2 * kChannels> buffer{};
+  struct {
+    Status status = Status::Unknown();
+    span<int32_t> samples;
+  } result;
+
+  ASSERT_EQ(OkStatus(),
+            sampler.StartBurst(buffer,
+                               [&result](Status status, span<int32_t> s) {
+                                 result.status = status;
+                                 result.samples = s;
+                               }));
+  sampler.Complete();
+
+  EXPECT_EQ(OkStatus(), result.status);
+  EXPECT_EQ(result.samples.data(), buffer.data());
+  EXPECT_EQ(result.samples.size(), buffer.size());
+  EXPECT_TRUE(std::equal(buffer.begin(),
+                         buffer.end(),
+                         std::array<int32_t, 4>{0, 1, 2, 3}.begin()));
+  EXPECT_FALSE(sampler.sampling());
+}
+
+TEST(AnalogSamplerTest, BurstAlreadySampling) {
+  TestAnalogSampler sampler;
+  std::array<int32_t, kChannels> buffer{};
+  ASSERT_EQ(OkStatus(), sampler.StartBurst(buffer, [](Status, auto) {}));
+  EXPECT_EQ(Status::FailedPrecondition(),
+            sampler.StartBurst(buffer, [](Status, auto) {}));
+  sampler.Stop();
+  EXPECT_EQ(OkStatus(), sampler.StartBurst(buffer, [](Status, auto) {}));
+}
+
+TEST(AnalogSamplerTest, InvalidBuffers) {
+  TestAnalogSampler sampler;
+  std::array<int32_t, kChannels + 1> partial_scan{};
+  std::array<int32_t, kChannels> buffer{};
+
+  EXPECT_EQ(Status::InvalidArgument(),
+            sampler.StartBurst(span<int32_t>(), [](Status, auto) {}));
+  EXPECT_EQ(Status::InvalidArgument(),
+            sampler.StartBurst(partial_scan, [](Status, auto) {}));
+  EXPECT_EQ(Status::InvalidArgument(),
+            sampler.StartContinuous(buffer, partial_scan, [](Status, auto) {}));
+  EXPECT_FALSE(sampler.sampling());
+}
+
+TEST(AnalogSamplerTest, ContinuousAlternatesBuffers) {
+  TestAnalogSampler sampler;
+  std::array<int32_t, kChannels> first{};
+  std::array<int32_t, kChannels> second{};
+  struct {
+    std::array<int32_t*, 3> buffers{};
+    size_t count = 0;
+  } filled;
+
+  ASSERT_EQ(OkStatus(),
+            sampler.StartContinuous(
+                first,
+                second,
+                [&filled](Status status, span<int32_t> samples) {
+                  EXPECT_EQ(OkStatus(), status);
+                  filled.buffers[filled.count++] = samples.data();
+                }));
+  sampler.Complete();
+  sampler.Complete();
+  sampler.Complete();
+  sampler.Stop();
+
+  EXPECT_EQ(filled.count, 3u);
+  EXPECT_EQ(filled.buffers[0], first.data());
+  EXPECT_EQ(filled.buffers[1], second.data());
+  EXPECT_EQ(filled.buffers[2], first.data());
+  EXPECT_EQ(first[0], 4);
+  EXPECT_EQ(second[0], 2);
+  EXPECT_FALSE(sampler.sampling());
+}
+
+}  // namespace
+}  // namespace pw::analog
@@ -13,6 +13,8 @@
 // the License.
 #include "pw_analog/microvolt_input.h"
 
+#include <iterator>
+
 #include "pw_unit_test/framework.h"
 
 namespace pw {
@@ -276,6 +278,64 @@ TEST(MicrovoltInputTest, ReadMicrovoltsWithInvertedReferenceAtMin) {
   ASSERT_EQ(result.status(), pw::Status::Internal());
 }
 
+TEST(MicrovoltInputTest, ConvertSpanMatchesSingleReads) {
+  TestMicrovoltInput voltage_input =
+      TestMicrovoltInput({.min = kBipolarLimitsMin, .max = kBipolarLimitsMax},
+                         {.max_voltage_uv = kBipolarReferenceMaxVoltageUv,
+                          .min_voltage_uv = kBipolarReferenceMinVoltageUv});
+  constexpr int32_t kSamples[] = {
+      kBipolarLimitsMin, -1234, 0, 1, kBipolarLimitsMax / 3, kBipolarLimitsMax};
+  int32_t microvolts[std::size(kSamples)] = {};
+
+  ASSERT_EQ(OkStatus(),
+            voltage_input.ConvertToMicrovolts(kSamples, microvolts));
+
+  for (size_t i = 0; i < std::size(kSamples); ++i) {
+    voltage_input.SetSampleValue(kSamples[i]);
+    Result<int32_t> result = voltage_input.TryReadMicrovoltsFor(kTimeout);
+    ASSERT_TRUE(result.status().ok());
+    EXPECT_EQ(microvolts[i], result.value());
+  }
+}
+
+TEST(MicrovoltInputTest, ConvertSpanInPlace) {
+  int32_t samples[] = {kLimitsMin, kLimitsMax / 2, kLimitsMax};
+  ASSERT_EQ(OkStatus(),
+            MicrovoltInput::ConvertToMicrovolts(
+                {.min = kLimitsMin, .max = kLimitsMax},
+                {.max_voltage_uv = kReferenceMaxVoltageUv,
+                 .min_voltage_uv = kReferenceMinVoltageUv},
+                samples,
+                samples));
+  EXPECT_EQ(samples[0], 0);
+  EXPECT_EQ(samples[1], kReferenceMaxVoltageUv / 2);
+  EXPECT_EQ(samples[2], kReferenceMaxVoltageUv);
+}
+
+TEST(MicrovoltInputTest, ConvertSpanOutputTooSmall) {
+  constexpr int32_t kSamples[] = {1, 2, 3};
+  int32_t microvolts[2] = {};
+  EXPECT_EQ(Status::InvalidArgument(),
+            MicrovoltInput::ConvertToMicrovolts(
+                {.min = kLimitsMin, .max = kLimitsMax},
+                {.max_voltage_uv = kReferenceMaxVoltageUv,
+                 .min_voltage_uv = kReferenceMinVoltageUv},
+                kSamples,
+                microvolts));
+}
+
+TEST(MicrovoltInputTest, ConvertSpanCornerCase) {
+  constexpr int32_t kSamples[] = {0};
+  int32_t microvolts[1] = {};
+  EXPECT_EQ(Status::Internal(),
+            MicrovoltInput::ConvertToMicrovolts(
+                {.min = kCornerLimitsMin, .max = kCornerLimitsMax},
+                {.max_voltage_uv = kCornerReferenceMaxVoltageUv,
+                 .min_voltage_uv = kCornerReferenceMinVoltageUv},
+                kSamples,
+                microvolts));
+}
+
 }  // namespace
 }  // namespace analog
 }  // namespace pw
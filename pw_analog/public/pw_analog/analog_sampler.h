@@ -0,0 +1,123 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_analog/analog_input.h"
+#include "pw_function/function.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::analog {
+
+/// Interface for acquiring blocks of analog-to-digital (ADC) samples from one
+/// or more channels into caller-provided buffers.
+///
+/// Unlike `AnalogInput`, which returns one sample per call, an `AnalogSampler`
+/// fills a whole buffer and signals completion through a callback. This lets
+/// an implementation program a DMA controller to write samples directly into
+/// the buffer, so no thread has to spin on individual reads during high-rate
+/// acquisition.
+///
+/// Samples from multiple channels are interleaved in scan order: sample `i` of
+/// channel `c` is at `buffer[i * GetChannelCount() + c]`. Buffers must hold a
+/// whole number of scans.
+///
+/// As with `AnalogInput`, the ADC backend is up to the user to implement.
+/// Only one burst or continuous acquisition may be in progress at a time.
+class AnalogSampler {
+ public:
+  /// Called when a buffer has been filled, or when sampling fails. This may be
+  /// called from interrupt context, so it must not block.
+  ///
+  /// @param[in] status OK if `samples` was filled, or the reason sampling
+  /// stopped.
+  ///
+  /// @param[in] samples The samples that were written to the buffer.
+  using Callback = Function<void(Status status, span<int32_t> samples)>;
+
+  virtual ~AnalogSampler() = default;
+
+  /// Fills `buffer` with samples once, then invokes `on_complete`.
+  ///
+  /// The buffer must remain valid and untouched until `on_complete` is invoked
+  /// or `Stop()` returns.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - Sampling started.
+  /// * @pw_status{INVALID_ARGUMENT} - The buffer is empty or does not hold a
+  ///   whole number of scans.
+  /// * @pw_status{FAILED_PRECONDITION} - Sampling is already in progress.
+  /// * Other statuses left up to the implementer.
+  Status StartBurst(span<int32_t> buffer, Callback&& on_complete) {
+    if (!IsValidBuffer(buffer)) {
+      return Status::InvalidArgument();
+    }
+    return DoStartBurst(buffer, std::move(on_complete));
+  }
+
+  /// Samples continuously, filling `first` and `second` in turn until
+  /// `Stop()` is called. `on_buffer_full` is invoked each time one of the
+  /// buffers is filled. The caller must finish with that buffer before the
+  /// other one fills, since sampling then restarts into it.
+  ///
+  /// Both buffers must remain valid until `Stop()` returns.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - Sampling started.
+  /// * @pw_status{INVALID_ARGUMENT} - A buffer is empty or does not hold a
+  ///   whole number of scans.
+  /// * @pw_status{FAILED_PRECONDITION} - Sampling is already in progress.
+  /// * Other statuses left up to the implementer.
+  Status StartContinuous(span<int32_t> first,
+                         span<int32_t> second,
+                         Callback&& on_buffer_full) {
+    if (!IsValidBuffer(first) || !IsValidBuffer(second)) {
+      return Status::InvalidArgument();
+    }
+    return DoStartContinuous(first, second, std::move(on_buffer_full));
+  }
+
+  /// Stops any burst or continuous sampling in progress. No callbacks are
+  /// invoked after this returns. Does nothing if sampling is not in progress.
+  void Stop() { DoStop(); }
+
+  /// @returns The number of channels in each scan. This value does not change
+  /// at runtime.
+  virtual size_t GetChannelCount() const = 0;
+
+  /// @returns The range of the ADC samples. These values do not change at
+  /// runtime.
+  virtual AnalogInput::Limits GetLimits() const = 0;
+
+ private:
+  bool IsValidBuffer(span<int32_t> buffer) const {
+    return !buffer.empty() && buffer.size() % GetChannelCount() == 0u;
+  }
+
+  /// Starts a burst. The buffer has been validated.
+  virtual Status DoStartBurst(span<int32_t> buffer, Callback&& on_complete) = 0;
+
+  /// Starts continuous sampling. The buffers have been validated.
+  virtual Status DoStartContinuous(span<int32_t> first,
+                                   span<int32_t> second,
+                                   Callback&& on_buffer_full) = 0;
+
+  /// Stops sampling. Must not return while a callback may still be invoked.
+  virtual void DoStop() = 0;
+};
+
+}  // namespace pw::analog
@@ -12,9 +12,16 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 #pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
 #include "pw_analog/analog_input.h"
 #include "pw_chrono/system_clock.h"
 #include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
 #include "pw_status/try.h"
 
 namespace pw::analog {
@@ -69,21 +76,57 @@ class MicrovoltInput : public AnalogInput {
       chrono::SystemClock::time_point deadline) {
     PW_TRY_ASSIGN(const int32_t sample, TryReadUntil(deadline));
 
-    const References reference = GetReferences();
-    const AnalogInput::Limits limits = GetLimits();
+    int32_t microvolts;
+    PW_TRY(ConvertToMicrovolts(span(&sample, 1), span(&microvolts, 1)));
+    return microvolts;
+  }
+
+  /// Converts samples from this input, e.g. ones read in bulk by an
+  /// `AnalogSampler`, to microvolts. See the static overload.
+  Status ConvertToMicrovolts(span<const int32_t> samples,
+                             span<int32_t> microvolts) const {
+    return ConvertToMicrovolts(
+        GetLimits(), GetReferences(), samples, microvolts);
+  }
+
+  /// Converts each sample to microvolts, storing it at the same index in
+  /// `microvolts`, which may be the same span as `samples`. This gives the same
+  /// results as converting each sample individually, but checks the references
+  /// once and runs a single loop over the samples, which compilers can unroll
+  /// or vectorize.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - The samples were converted.
+  /// * @pw_status{INVALID_ARGUMENT} - `microvolts` is smaller than `samples`.
+  /// * @pw_status{INTERNAL} - The reference voltage difference does not fit in
+  ///   an `int32_t`.
+  static Status ConvertToMicrovolts(AnalogInput::Limits limits,
+                                    References reference,
+                                    span<const int32_t> samples,
+                                    span<int32_t> microvolts) {
+    if (microvolts.size() < samples.size()) {
+      return Status::InvalidArgument();
+    }
 
     constexpr int64_t kMaxReferenceDiffUv = std::numeric_limits<int32_t>::max();
 
-    if (std::abs(static_cast<int64_t>(reference.max_voltage_uv) -
-                 static_cast<int64_t>(reference.min_voltage_uv)) >
-        kMaxReferenceDiffUv) {
+    const int64_t reference_diff_uv =
+        static_cast<int64_t>(reference.max_voltage_uv) -
+        static_cast<int64_t>(reference.min_voltage_uv);
+    if (std::abs(reference_diff_uv) > kMaxReferenceDiffUv) {
       return pw::Status::Internal();
     }
+    const int64_t limits_diff =
+        static_cast<int64_t>(limits.max) - static_cast<int64_t>(limits.min);
 
-    return (((static_cast<int64_t>(sample) - static_cast<int64_t>(limits.min)) *
-             (reference.max_voltage_uv - reference.min_voltage_uv)) /
-            (limits.max - limits.min)) +
-           reference.min_voltage_uv;
+    for (size_t i = 0; i < samples.size(); ++i) {
+      microvolts[i] = static_cast<int32_t>(
+          (((static_cast<int64_t>(samples[i]) - limits.min) *
+            reference_diff_uv) /
+           limits_diff) +
+          reference.min_voltage_uv);
+    }
+    return OkStatus();
   }
 
  private:
@@ -0,0 +1,63 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/atomic_waker.h"
+
+#include <mutex>
+
+namespace pw::async2 {
+
+void AtomicWaker::Register(Context& cx) {
+  Waker waker = cx.GetWaker(WaitReason::Unspecified());
+  std::lock_guard lock(dispatcher_lock());
+  if (waker.task_ == nullptr) {
+    // There is no task to wake.
+    return;
+  }
+  // The ``Waker`` for a running task refers to that task's dispatcher.
+  DispatcherBase* dispatcher = waker.task_->dispatcher_;
+  waker_.MoveAssignLocked(waker);
+  DispatcherBase* current = dispatcher_.load(std::memory_order_relaxed);
+  if (current != dispatcher) {
+    if (current != nullptr) {
+      current->RemoveAtomicWakerLocked(*this);
+    }
+    dispatcher->AddAtomicWakerLocked(*this);
+  }
+}
+
+void AtomicWaker::Wake() {
+  DispatcherBase* dispatcher = dispatcher_.load(std::memory_order_acquire);
+  if (dispatcher == nullptr) {
+    return;
+  }
+  if (queued_.exchange(true, std::memory_order_acq_rel)) {
+    // Already signaled; the dispatcher has not yet woken the task.
+    return;
+  }
+  dispatcher->PushSignaledAtomicWaker(*this);
+}
+
+void AtomicWaker::Clear() {
+  // Declared before the lock is taken, as destroying a ``Waker`` acquires it.
+  Waker empty;
+  std::lock_guard lock(dispatcher_lock());
+  DispatcherBase* dispatcher = dispatcher_.load(std::memory_order_relaxed);
+  if (dispatcher != nullptr) {
+    dispatcher->RemoveAtomicWakerLocked(*this);
+  }
+  waker_.MoveAssignLocked(empty);
+}
+
+}  // namespace pw::async2
@@ -0,0 +1,148 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/atomic_waker.h"
+
+#include <mutex>
+#include <optional>
+
+#include "gtest/gtest.h"
+#include "pw_async2/dispatcher.h"
+
+namespace pw::async2 {
+namespace {
+
+class SignaledTask : public Task {
+ public:
+  SignaledTask(AtomicWaker& waker) : waker_(waker) {}
+
+  bool signaled = false;
+  int polled = 0;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    ++polled;
+    if (signaled) {
+      return Ready();
+    }
+    waker_.Register(cx);
+    return Pending();
+  }
+
+  AtomicWaker& waker_;
+};
+
+TEST(AtomicWaker, WakeWithoutRegisteredTaskDoesNothing) {
+  AtomicWaker waker;
+  waker.Wake();
+}
+
+TEST(AtomicWaker, WakeRunsRegisteredTask) {
+  AtomicWaker waker;
+  SignaledTask task(waker);
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_EQ(task.polled, 1);
+
+  task.signaled = true;
+  waker.Wake();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(task.polled, 2);
+}
+
+TEST(AtomicWaker, WakeDoesNotRequireDispatcherLock) {
+  AtomicWaker waker;
+  SignaledTask task(waker);
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  task.signaled = true;
+  {
+    // Waking while holding the lock would deadlock if ``Wake`` acquired it.
+    std::lock_guard lock(dispatcher_lock());
+    waker.Wake();
+  }
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+}
+
+TEST(AtomicWaker, RepeatedWakesAreCoalesced) {
+  AtomicWaker waker;
+  SignaledTask task(waker);
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  waker.Wake();
+  waker.Wake();
+  waker.Wake();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_EQ(task.polled, 2);
+}
+
+TEST(AtomicWaker, RunToCompletionWakesForSignal) {
+  AtomicWaker waker;
+  SignaledTask task(waker);
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  task.signaled = true;
+  waker.Wake();
+  dispatcher.RunToCompletion(task);
+  EXPECT_EQ(task.polled, 2);
+}
+
+TEST(AtomicWaker, ClearedWakerDoesNotWakeTask) {
+  AtomicWaker waker;
+  SignaledTask task(waker);
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  waker.Clear();
+  waker.Wake();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_EQ(task.polled, 1);
+}
+
+TEST(AtomicWaker, DestroyingSignaledWakerIsSafe) {
+  std::optional<AtomicWaker> waker;
+  waker.emplace();
+  SignaledTask task(*waker);
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  waker->Wake();
+  waker.reset();
+  task.signaled = true;
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+}
+
+TEST(AtomicWaker, DestroyingDispatcherUnregistersWaker) {
+  AtomicWaker waker;
+  SignaledTask task(waker);
+  {
+    Dispatcher dispatcher;
+    dispatcher.Post(task);
+    EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  }
+  // The waker no longer refers to the destroyed dispatcher.
+  waker.Wake();
+}
+
+}  // namespace
+}  // namespace pw::async2
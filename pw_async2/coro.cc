@@ -0,0 +1,51 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/coro.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace pw::async2::internal {
+namespace {
+
+using ::pw::allocator::Allocator;
+
+// Coroutine frames are aligned as if by ``operator new``. The allocator that
+// produced the frame is stored in a header immediately before it.
+constexpr size_t kFrameAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+constexpr size_t kHeaderSize = std::max(sizeof(Allocator*), kFrameAlignment);
+
+allocator::Layout FrameLayout(size_t size) {
+  return allocator::Layout(kHeaderSize + size, kFrameAlignment);
+}
+
+}  // namespace
+
+void* CoroAllocate(CoroContext& coro_cx, size_t size) {
+  void* ptr = coro_cx.alloc().Allocate(FrameLayout(size));
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+  *static_cast<Allocator**>(ptr) = &coro_cx.alloc();
+  return static_cast<std::byte*>(ptr) + kHeaderSize;
+}
+
+void CoroDeallocate(void* ptr, size_t size) {
+  void* header = static_cast<std::byte*>(ptr) - kHeaderSize;
+  Allocator* alloc = *static_cast<Allocator**>(header);
+  alloc->Deallocate(header, FrameLayout(size));
+}
+
+}  // namespace pw::async2::internal
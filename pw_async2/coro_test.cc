@@ -0,0 +1,194 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/coro.h"
+
+#include <optional>
+
+#include "gtest/gtest.h"
+#include "pw_allocator/null_allocator.h"
+#include "pw_allocator/testing.h"
+#include "pw_async2/coro_or_else_task.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_result/result.h"
+
+namespace pw::async2 {
+namespace {
+
+using ::pw::allocator::NullAllocator;
+using ::pw::allocator::test::AllocatorForTest;
+
+/// Future which becomes ready with a value once ``Set`` is called.
+class ValueFuture {
+ public:
+  Poll<int> Pend(Context& cx) {
+    ++polled;
+    if (value_.has_value()) {
+      return Ready(int(*value_));
+    }
+    waker_ = cx.GetWaker(WaitReason::Unspecified());
+    return Pending();
+  }
+
+  void Set(int value) {
+    value_ = value;
+    std::move(waker_).Wake();
+  }
+
+  int polled = 0;
+
+ private:
+  std::optional<int> value_;
+  Waker waker_;
+};
+
+Coro<Result<int>> ImmediatelyReturnsFive(CoroContext&) { co_return 5; }
+
+Coro<Result<int>> AddTwo(CoroContext&,
+                         ValueFuture& first,
+                         ValueFuture& second) {
+  int a = co_await first;
+  int b = co_await second;
+  co_return a + b;
+}
+
+Coro<Status> AddAndCheck(CoroContext& coro_cx,
+                         ValueFuture& first,
+                         ValueFuture& second,
+                         int expected) {
+  Result<int> sum = co_await AddTwo(coro_cx, first, second);
+  if (!sum.ok()) {
+    co_return sum.status();
+  }
+  co_return *sum == expected ? OkStatus() : Status::DataLoss();
+}
+
+/// Task which pends a ``Coro`` and stores its output.
+class CoroTask : public Task {
+ public:
+  CoroTask(Coro<Result<int>>&& coro) : coro_(std::move(coro)) {}
+
+  std::optional<Result<int>> output;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    Poll<Result<int>> poll = coro_.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    output = *poll;
+    return Ready();
+  }
+
+  Coro<Result<int>> coro_;
+};
+
+TEST(Coro, ReturnsValueWithoutAwaiting) {
+  AllocatorForTest<256> alloc;
+  CoroContext coro_cx(alloc);
+  CoroTask task(ImmediatelyReturnsFive(coro_cx));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  ASSERT_TRUE(task.output.has_value());
+  ASSERT_TRUE(task.output->ok());
+  EXPECT_EQ(**task.output, 5);
+}
+
+TEST(Coro, SuspendsUntilAwaitedFuturesAreReady) {
+  AllocatorForTest<256> alloc;
+  CoroContext coro_cx(alloc);
+  ValueFuture first;
+  ValueFuture second;
+  CoroTask task(AddTwo(coro_cx, first, second));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_EQ(first.polled, 1);
+  first.Set(3);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_EQ(second.polled, 1);
+  second.Set(4);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+
+  ASSERT_TRUE(task.output.has_value());
+  ASSERT_TRUE(task.output->ok());
+  EXPECT_EQ(**task.output, 7);
+}
+
+TEST(Coro, FramesAreAllocatedFromContextAllocator) {
+  AllocatorForTest<256> alloc;
+  CoroContext coro_cx(alloc);
+  ValueFuture first;
+  ValueFuture second;
+  {
+    Coro<Result<int>> coro = AddTwo(coro_cx, first, second);
+    EXPECT_TRUE(coro.IsValid());
+    EXPECT_NE(alloc.allocate_size(), 0u);
+    EXPECT_EQ(alloc.deallocate_ptr(), nullptr);
+  }
+  // Destroying an unfinished ``Coro`` frees its frame.
+  EXPECT_NE(alloc.deallocate_ptr(), nullptr);
+  EXPECT_EQ(alloc.deallocate_size(), alloc.allocate_size());
+}
+
+TEST(Coro, AllocationFailureReturnsInternal) {
+  NullAllocator alloc;
+  CoroContext coro_cx(alloc);
+  CoroTask task(ImmediatelyReturnsFive(coro_cx));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  ASSERT_TRUE(task.output.has_value());
+  EXPECT_EQ(task.output->status(), Status::Internal());
+}
+
+TEST(CoroOrElseTask, RunsNestedCoroutinesToCompletion) {
+  AllocatorForTest<512> alloc;
+  CoroContext coro_cx(alloc);
+  ValueFuture first;
+  ValueFuture second;
+  std::optional<Status> error;
+  CoroOrElseTask task(AddAndCheck(coro_cx, first, second, 10),
+                      [&error](Status status) { error = status; });
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  first.Set(6);
+  second.Set(4);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_FALSE(error.has_value());
+}
+
+TEST(CoroOrElseTask, InvokesOrElseOnError) {
+  AllocatorForTest<512> alloc;
+  CoroContext coro_cx(alloc);
+  ValueFuture first;
+  ValueFuture second;
+  first.Set(1);
+  second.Set(1);
+  std::optional<Status> error;
+  CoroOrElseTask task(AddAndCheck(coro_cx, first, second, 10),
+                      [&error](Status status) { error = status; });
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(*error, Status::DataLoss());
+}
+
+}  // namespace
+}  // namespace pw::async2
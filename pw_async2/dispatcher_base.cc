@@ -14,17 +14,49 @@
 
 #include "pw_async2/dispatcher_base.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <mutex>
 
 #include "pw_assert/check.h"
+#include "pw_async2/atomic_waker.h"
+#include "pw_async2/time_future.h"
 #include "pw_sync/lock_annotations.h"
+#include "pw_trace/trace.h"
 
 namespace pw::async2 {
+namespace {
+
+#if PW_ASYNC2_ENABLE_METRICS
+uint32_t ToMicroseconds(chrono::SystemClock::duration duration) {
+  int64_t us =
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  return static_cast<uint32_t>(
+      std::clamp<int64_t>(us, 0, std::numeric_limits<uint32_t>::max()));
+}
+#endif  // PW_ASYNC2_ENABLE_METRICS
+
+#if PW_ASYNC2_ENABLE_TRACING
+// Groups trace events by task.
+uint32_t TraceId(const Task& task) {
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&task));
+}
+#endif  // PW_ASYNC2_ENABLE_TRACING
+
+}  // namespace
 
 void Context::ReEnqueue() { waker_->Clone(WaitReason::Unspecified()).Wake(); }
 
 Waker Context::GetWaker(WaitReason reason) { return waker_->Clone(reason); }
 
+void Task::set_priority(Priority priority) {
+  std::lock_guard lock(dispatcher_lock());
+  PW_DCHECK(state_ == State::kUnposted);
+  priority_ = priority;
+}
+
 void Task::RemoveAllWakersLocked() {
   while (wakers_ != nullptr) {
     Waker* current = wakers_;
@@ -66,18 +98,26 @@ Waker::Waker(Waker&& other) noexcept {
 
 Waker& Waker::operator=(Waker&& other) noexcept {
   std::lock_guard lock(dispatcher_lock());
+  MoveAssignLocked(other);
+  return *this;
+}
+
+void Waker::MoveAssignLocked(Waker& other) {
   RemoveFromTaskWakerListLocked();
   if (other.task_ == nullptr) {
-    return *this;
+    return;
   }
   Task& task = *other.task_;
   task.RemoveWakerLocked(other);
   task.AddWakerLocked(*this);
-  return *this;
 }
 
 void Waker::Wake() && {
   std::lock_guard lock(dispatcher_lock());
+  WakeLocked();
+}
+
+void Waker::WakeLocked() {
   if (task_ != nullptr) {
     task_->dispatcher_->WakeTask(*task_);
     RemoveFromTaskWakerListLocked();
@@ -125,11 +165,21 @@ void Waker::RemoveFromTaskWakerListLocked() {
 
 void DispatcherBase::Deregister() {
   std::lock_guard lock(dispatcher_lock());
-  UnpostTaskList(first_woken_);
-  first_woken_ = nullptr;
-  last_woken_ = nullptr;
+  for (WokenQueue& queue : woken_) {
+    UnpostTaskList(queue.first);
+    queue = WokenQueue();
+  }
+#if PW_ASYNC2_ENABLE_METRICS
+  metrics_.queue_depth_.Set(0);
+#endif  // PW_ASYNC2_ENABLE_METRICS
   UnpostTaskList(sleeping_);
   sleeping_ = nullptr;
+  timers_.Clear([](internal::TimerWheelNode& node) {
+    static_cast<TimeFuture&>(node).dispatcher_ = nullptr;
+  });
+  while (atomic_wakers_ != nullptr) {
+    RemoveAtomicWakerLocked(*atomic_wakers_);
+  }
 }
 
 void DispatcherBase::UnpostTaskList(Task* task) {
@@ -156,30 +206,39 @@ void DispatcherBase::RemoveTaskFromList(Task& task) {
 }
 
 void DispatcherBase::RemoveWokenTaskLocked(Task& task) {
-  RemoveTaskFromList(task);
-  if (first_woken_ == &task) {
-    first_woken_ = task.next_;
+  WokenQueue& queue = woken_queue(task);
+  if (queue.first == &task) {
+    queue.first = task.next_;
   }
-  if (last_woken_ == &task) {
-    last_woken_ = task.prev_;
+  if (queue.last == &task) {
+    queue.last = task.prev_;
   }
+#if PW_ASYNC2_ENABLE_METRICS
+  metrics_.RecordDequeued();
+#endif  // PW_ASYNC2_ENABLE_METRICS
+  RemoveTaskFromList(task);
 }
 
 void DispatcherBase::RemoveSleepingTaskLocked(Task& task) {
-  RemoveTaskFromList(task);
   if (sleeping_ == &task) {
     sleeping_ = task.next_;
   }
+  RemoveTaskFromList(task);
 }
 
 void DispatcherBase::AddTaskToWokenList(Task& task) {
-  if (first_woken_ == nullptr) {
-    first_woken_ = &task;
+  WokenQueue& queue = woken_queue(task);
+  if (queue.first == nullptr) {
+    queue.first = &task;
   } else {
-    last_woken_->next_ = &task;
-    task.prev_ = last_woken_;
+    queue.last->next_ = &task;
+    task.prev_ = queue.last;
   }
-  last_woken_ = &task;
+  queue.last = &task;
+#if PW_ASYNC2_ENABLE_METRICS
+  task.metrics_.woken_at_ = chrono::SystemClock::now();
+  metrics_.RecordEnqueued();
+#endif  // PW_ASYNC2_ENABLE_METRICS
 }
 
 void DispatcherBase::AddTaskToSleepingList(Task& task) {
@@ -191,6 +250,9 @@ void DispatcherBase::AddTaskToSleepingList(Task& task) {
 }
 
 void DispatcherBase::WakeTask(Task& task) {
+#if PW_ASYNC2_ENABLE_TRACING
+  PW_TRACE_INSTANT("Wake", "pw_async2", TraceId(task));
+#endif  // PW_ASYNC2_ENABLE_TRACING
   switch (task.state_) {
     case Task::State::kWoken:
       // Do nothing-- this has already been woken.
@@ -202,7 +264,11 @@ void DispatcherBase::WakeTask(Task& task) {
       // Wake again to indicate that this task should be run once more,
       // as the state of the world may have changed since the task
       // started running.
-      break;
+      //
+      // The task is requeued by ``RunOneTask`` once its current ``Pend``
+      // call returns so that no other thread can ``Pend`` it concurrently.
+      task.state_ = Task::State::kWoken;
+      return;
     case Task::State::kSleeping:
       RemoveSleepingTaskLocked(task);
       // Wake away!
@@ -210,30 +276,170 @@ void DispatcherBase::WakeTask(Task& task) {
   }
   task.state_ = Task::State::kWoken;
   AddTaskToWokenList(task);
-  if (wants_wake_) {
-    // Note: it's quite annoying to make this call under the lock, as it can
-    // result in extra thread wakeup/sleep cycles.
-    //
-    // However, releasing the lock first would allow for the possibility that
-    // the ``Dispatcher`` has been destroyed, making the call invalid.
+  // Note: it's quite annoying to make this call under the lock, as it can
+  // result in extra thread wakeup/sleep cycles.
+  //
+  // However, releasing the lock first would allow for the possibility that
+  // the ``Dispatcher`` has been destroyed, making the call invalid.
+  WakeOneSleeper();
+}
+
+bool DispatcherBase::TryClaimSleeper() {
+  size_t num_sleepers = num_sleepers_.load(std::memory_order_seq_cst);
+  while (num_sleepers != 0) {
+    if (num_sleepers_.compare_exchange_weak(num_sleepers,
+                                            num_sleepers - 1,
+                                            std::memory_order_seq_cst)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DispatcherBase::WakeOneSleeper() {
+  if (TryClaimSleeper()) {
+    DoWake();
+  }
+}
+
+void DispatcherBase::WakeAllSleepersLocked() {
+  while (TryClaimSleeper()) {
     DoWake();
   }
 }
 
+void DispatcherBase::AddAtomicWakerLocked(AtomicWaker& waker) {
+  waker.next_ = atomic_wakers_;
+  waker.prev_ = nullptr;
+  if (atomic_wakers_ != nullptr) {
+    atomic_wakers_->prev_ = &waker;
+  }
+  atomic_wakers_ = &waker;
+  waker.dispatcher_.store(this, std::memory_order_release);
+}
+
+void DispatcherBase::RemoveAtomicWakerLocked(AtomicWaker& waker) {
+  if (waker.queued_.load(std::memory_order_acquire)) {
+    // The waker cannot be unlinked from the middle of the lock-free stack, so
+    // drain the whole stack instead.
+    DrainSignaledAtomicWakersLocked();
+  }
+  if (waker.prev_ != nullptr) {
+    waker.prev_->next_ = waker.next_;
+  } else {
+    atomic_wakers_ = waker.next_;
+  }
+  if (waker.next_ != nullptr) {
+    waker.next_->prev_ = waker.prev_;
+  }
+  waker.next_ = nullptr;
+  waker.prev_ = nullptr;
+  waker.dispatcher_.store(nullptr, std::memory_order_release);
+}
+
+void DispatcherBase::PushSignaledAtomicWaker(AtomicWaker& waker) {
+  AtomicWaker* head = signaled_.load(std::memory_order_relaxed);
+  do {
+    waker.next_signaled_ = head;
+  } while (!signaled_.compare_exchange_weak(
+      head, &waker, std::memory_order_release, std::memory_order_relaxed));
+  WakeOneSleeper();
+}
+
+void DispatcherBase::DrainSignaledAtomicWakersLocked() {
+  AtomicWaker* waker = signaled_.exchange(nullptr, std::memory_order_acquire);
+  while (waker != nullptr) {
+    AtomicWaker* next = waker->next_signaled_;
+    waker->next_signaled_ = nullptr;
+    waker->queued_.store(false, std::memory_order_release);
+    waker->waker_.WakeLocked();
+    waker = next;
+  }
+}
+
+void DispatcherBase::AddTimerLocked(TimeFuture& timer,
+                                    chrono::SystemClock::time_point deadline) {
+  timers_.Insert(timer, deadline);
+  timer.dispatcher_ = this;
+}
+
+void DispatcherBase::RemoveTimerLocked(TimeFuture& timer) {
+  timers_.Remove(timer);
+  timer.dispatcher_ = nullptr;
+}
+
+void DispatcherBase::ReplaceTimerLocked(TimeFuture& old_timer,
+                                        TimeFuture& new_timer) {
+  timers_.Replace(old_timer, new_timer);
+  old_timer.dispatcher_ = nullptr;
+  new_timer.dispatcher_ = this;
+}
+
+void DispatcherBase::ExpireTimersLocked(chrono::SystemClock::time_point now) {
+  timers_.Advance(now, [](internal::TimerWheelNode& node) {
+    TimeFuture& timer = static_cast<TimeFuture&>(node);
+    timer.dispatcher_ = nullptr;
+    timer.waker_.WakeLocked();
+  });
+}
+
 Task* DispatcherBase::PopWokenTask() {
-  if (first_woken_ == nullptr) {
+  WokenQueue* selected = nullptr;
+  for (size_t i = woken_.size(); i-- > 0;) {
+    WokenQueue& queue = woken_[i];
+    if (queue.first == nullptr) {
+      queue.passed_over = 0;
+    } else if (selected == nullptr) {
+      selected = &queue;
+    } else if (internal::config::kStarvationLimit != 0 &&
+               ++queue.passed_over > internal::config::kStarvationLimit) {
+      // This queue has waited long enough; run it ahead of the higher
+      // priority queues.
+      selected = &queue;
+    }
+  }
+  if (selected == nullptr) {
     return nullptr;
   }
-  Task& task = *first_woken_;
+  selected->passed_over = 0;
+
+  Task& task = *selected->first;
   if (task.next_ != nullptr) {
     task.next_->prev_ = nullptr;
   } else {
-    last_woken_ = nullptr;
+    selected->last = nullptr;
   }
-  first_woken_ = task.next_;
+  selected->first = task.next_;
   task.prev_ = nullptr;
   task.next_ = nullptr;
+#if PW_ASYNC2_ENABLE_METRICS
+  metrics_.RecordDequeued();
+  metrics_.RecordRun(
+      ToMicroseconds(chrono::SystemClock::now() - task.metrics_.woken_at_));
+#endif  // PW_ASYNC2_ENABLE_METRICS
   return &task;
 }
 
+#if PW_ASYNC2_ENABLE_METRICS || PW_ASYNC2_ENABLE_TRACING
+
+DispatcherBase::PollRecorder::PollRecorder(Task& task)
+    : task_(task), start_(chrono::SystemClock::now()) {
+#if PW_ASYNC2_ENABLE_TRACING
+  PW_TRACE_START("Pend", "pw_async2", TraceId(task_));
+#endif  // PW_ASYNC2_ENABLE_TRACING
+}
+
+DispatcherBase::PollRecorder::~PollRecorder() {
+#if PW_ASYNC2_ENABLE_TRACING
+  PW_TRACE_END("Pend", "pw_async2", TraceId(task_));
+#endif  // PW_ASYNC2_ENABLE_TRACING
+#if PW_ASYNC2_ENABLE_METRICS
+  uint32_t duration_us = ToMicroseconds(chrono::SystemClock::now() - start_);
+  std::lock_guard lock(dispatcher_lock());
+  task_.metrics_.RecordPoll(duration_us);
+#endif  // PW_ASYNC2_ENABLE_METRICS
+}
+
+#endif  // PW_ASYNC2_ENABLE_METRICS || PW_ASYNC2_ENABLE_TRACING
+
 }  // namespace pw::async2
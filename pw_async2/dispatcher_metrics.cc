@@ -0,0 +1,50 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/dispatcher_metrics.h"
+
+#include <algorithm>
+
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::async2 {
+
+void TaskMetrics::RecordPoll(uint32_t duration_us) {
+  polls_.Increment();
+  poll_time_us_.Increment(duration_us);
+  max_poll_time_us_.Set(std::max(max_poll_time_us_.value(), duration_us));
+}
+
+DispatcherMetrics::DispatcherMetrics()
+    : wake_to_run_us_(
+          PW_TOKENIZE_STRING_DOMAIN_EXPR("metrics", "wake_to_run_us")) {
+  group_.Add(wake_to_run_us_.group());
+}
+
+void DispatcherMetrics::RecordEnqueued() {
+  queue_depth_.Increment();
+  max_queue_depth_.Set(
+      std::max(max_queue_depth_.value(), queue_depth_.value()));
+}
+
+void DispatcherMetrics::RecordDequeued() {
+  queue_depth_.Set(queue_depth_.value() - 1);
+}
+
+void DispatcherMetrics::RecordRun(uint32_t wake_to_run_us) {
+  polls_.Increment();
+  wake_to_run_us_.Record(wake_to_run_us);
+}
+
+}  // namespace pw::async2
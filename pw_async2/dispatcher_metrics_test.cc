@@ -0,0 +1,96 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/dispatcher_metrics.h"
+
+#include "gtest/gtest.h"
+#include "pw_async2/dispatcher.h"
+
+namespace pw::async2 {
+namespace {
+
+// These tests only run if the module is configured with
+// ``PW_ASYNC2_ENABLE_METRICS``.
+#if PW_ASYNC2_ENABLE_METRICS
+
+class YieldingTask : public Task {
+ public:
+  YieldingTask(int yields) : yields_(yields) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (yields_-- == 0) {
+      return Ready();
+    }
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  int yields_;
+};
+
+TEST(DispatcherMetrics, CountsPollsPerTaskAndDispatcher) {
+  YieldingTask first(2);
+  YieldingTask second(4);
+  Dispatcher dispatcher;
+  dispatcher.Post(first);
+  dispatcher.Post(second);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+
+  EXPECT_EQ(first.metrics().polls(), 3u);
+  EXPECT_EQ(second.metrics().polls(), 5u);
+  EXPECT_EQ(dispatcher.metrics().polls(), 8u);
+  EXPECT_GE(first.metrics().poll_time_us(), first.metrics().max_poll_time_us());
+}
+
+TEST(DispatcherMetrics, TracksQueueDepth) {
+  YieldingTask first(0);
+  YieldingTask second(0);
+  YieldingTask third(0);
+  Dispatcher dispatcher;
+  dispatcher.Post(first);
+  dispatcher.Post(second);
+  dispatcher.Post(third);
+  EXPECT_EQ(dispatcher.metrics().queue_depth(), 3u);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(dispatcher.metrics().queue_depth(), 0u);
+  EXPECT_EQ(dispatcher.metrics().max_queue_depth(), 3u);
+}
+
+TEST(DispatcherMetrics, RecordsWakeToRunLatencyForEveryRun) {
+  YieldingTask task(3);
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+
+  const allocator::Log2Histogram& histogram =
+      dispatcher.metrics().wake_to_run_us();
+  uint32_t runs = 0;
+  for (size_t i = 0; i < allocator::Log2Histogram::kNumBuckets; ++i) {
+    runs += histogram.count(i);
+  }
+  EXPECT_EQ(runs, 4u);
+}
+
+#else
+
+TEST(DispatcherMetrics, DisabledByDefault) {
+  EXPECT_FALSE(internal::config::kEnableMetrics);
+}
+
+#endif  // PW_ASYNC2_ENABLE_METRICS
+
+}  // namespace
+}  // namespace pw::async2
@@ -148,6 +148,115 @@ TEST(Dispatcher, PostToDispatcherFromInsidePendSucceeds) {
   EXPECT_EQ(posted_task.destroyed, 1);
 }
 
+TEST(Dispatcher, WakingOneSleepingTaskLeavesOthersSleeping) {
+  MockTask first;
+  MockTask second;
+  Dispatcher dispatcher;
+  dispatcher.Post(first);
+  dispatcher.Post(second);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  // ``second`` is at the front of the sleeping list.
+  second.should_complete = true;
+  std::move(*second.last_waker).Wake();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_EQ(second.destroyed, 1);
+
+  first.should_complete = true;
+  std::move(*first.last_waker).Wake();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(first.destroyed, 1);
+}
+
+/// Task which records the order in which tasks were run.
+class OrderTask : public Task {
+ public:
+  OrderTask(Priority priority, int id, pw::Vector<int>& order)
+      : Task(priority), id_(id), order_(order) {}
+
+ private:
+  Poll<> DoPend(Context&) override {
+    order_.push_back(id_);
+    return Ready();
+  }
+
+  int id_;
+  pw::Vector<int>& order_;
+};
+
+TEST(Dispatcher, HigherPriorityTasksRunFirst) {
+  pw::Vector<int, 4> order;
+  OrderTask low(Task::Priority::kLow, 0, order);
+  OrderTask normal(Task::Priority::kNormal, 1, order);
+  OrderTask high(Task::Priority::kHigh, 2, order);
+  OrderTask second_high(Task::Priority::kHigh, 3, order);
+  Dispatcher dispatcher;
+  dispatcher.Post(low);
+  dispatcher.Post(normal);
+  dispatcher.Post(high);
+  dispatcher.Post(second_high);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+
+  ASSERT_EQ(order.size(), 4u);
+  EXPECT_EQ(order[0], 2);
+  EXPECT_EQ(order[1], 3);
+  EXPECT_EQ(order[2], 1);
+  EXPECT_EQ(order[3], 0);
+}
+
+TEST(Dispatcher, DefaultPriorityIsNormal) {
+  MockTask task;
+  EXPECT_EQ(task.priority(), Task::Priority::kNormal);
+  task.set_priority(Task::Priority::kLow);
+  EXPECT_EQ(task.priority(), Task::Priority::kLow);
+}
+
+TEST(Dispatcher, StarvedLowPriorityTaskEventuallyRuns) {
+  constexpr size_t kLimit = internal::config::kStarvationLimit;
+  constexpr int kHighRuns = static_cast<int>(kLimit) + 4;
+
+  class BusyTask : public Task {
+   public:
+    BusyTask() : Task(Priority::kHigh) {}
+    int runs = 0;
+
+   private:
+    Poll<> DoPend(Context& cx) override {
+      if (++runs == kHighRuns) {
+        return Ready();
+      }
+      cx.ReEnqueue();
+      return Pending();
+    }
+  };
+
+  class StarvingTask : public Task {
+   public:
+    StarvingTask(const BusyTask& busy) : Task(Priority::kLow), busy_(busy) {}
+    int busy_runs_before = -1;
+
+   private:
+    Poll<> DoPend(Context&) override {
+      busy_runs_before = busy_.runs;
+      return Ready();
+    }
+    const BusyTask& busy_;
+  };
+
+  BusyTask busy;
+  StarvingTask starving(busy);
+  Dispatcher dispatcher;
+  dispatcher.Post(busy);
+  dispatcher.Post(starving);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+
+  if constexpr (kLimit == 0) {
+    EXPECT_EQ(starving.busy_runs_before, kHighRuns);
+  } else {
+    EXPECT_EQ(starving.busy_runs_before, static_cast<int>(kLimit));
+  }
+}
+
 TEST(Dispatcher, RunToCompletionPendsPostedTask) {
   MockTask task;
   task.should_complete = true;
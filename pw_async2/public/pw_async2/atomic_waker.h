@@ -0,0 +1,84 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::async2 {
+
+/// A slot for a single ``Waker`` which can be woken without acquiring
+/// ``dispatcher_lock()``.
+///
+/// ``AtomicWaker`` is intended for signaling a ``Task`` from contexts in which
+/// taking a lock is undesirable or impossible, such as interrupt handlers.
+/// Calling ``Wake`` pushes the ``AtomicWaker`` onto a lock-free queue owned by
+/// the ``Dispatcher`` and wakes the ``Dispatcher`` if it is sleeping. The
+/// registered ``Task`` is then woken by the ``Dispatcher`` the next time it
+/// runs. Repeated calls to ``Wake`` before then are coalesced.
+///
+/// A ``Task`` registers with an ``AtomicWaker`` by calling ``Register`` from
+/// its ``Pend`` function before returning ``Pending``, usually after checking
+/// whatever condition ``Wake`` signals.
+///
+/// ``Wake`` must not race with the destruction of the ``AtomicWaker`` or of
+/// the ``Dispatcher`` on which the registered ``Task`` runs.
+class AtomicWaker {
+ public:
+  AtomicWaker() = default;
+
+  AtomicWaker(const AtomicWaker&) = delete;
+  AtomicWaker& operator=(const AtomicWaker&) = delete;
+  AtomicWaker(AtomicWaker&&) = delete;
+  AtomicWaker& operator=(AtomicWaker&&) = delete;
+
+  ~AtomicWaker() PW_LOCKS_EXCLUDED(dispatcher_lock()) { Clear(); }
+
+  /// Arranges for the current ``Task`` to be woken by the next call to
+  /// ``Wake``, replacing any previously registered ``Task``.
+  void Register(Context& cx) PW_LOCKS_EXCLUDED(dispatcher_lock());
+
+  /// Wakes the registered ``Task``, if any.
+  ///
+  /// This operation is lock-free and may be called from interrupt context,
+  /// provided that the ``Dispatcher`` backend's ``DoWake`` may be as well.
+  void Wake();
+
+  /// Unregisters the current ``Task``, if any, without waking it.
+  void Clear() PW_LOCKS_EXCLUDED(dispatcher_lock());
+
+ private:
+  friend class DispatcherBase;
+
+  // The dispatcher of the registered task, or null if none is registered.
+  std::atomic<DispatcherBase*> dispatcher_ = nullptr;
+
+  // Whether this ``AtomicWaker`` is in its dispatcher's signaled queue.
+  std::atomic<bool> queued_ = false;
+
+  // Link in the dispatcher's lock-free queue of signaled ``AtomicWaker`` s.
+  // Written only by the thread which set ``queued_`` and by the dispatcher
+  // while draining the queue.
+  AtomicWaker* next_signaled_ = nullptr;
+
+  // Links in the dispatcher's list of registered ``AtomicWaker`` s.
+  AtomicWaker* next_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
+  AtomicWaker* prev_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
+
+  Waker waker_;
+};
+
+}  // namespace pw::async2
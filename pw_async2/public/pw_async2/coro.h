@@ -0,0 +1,276 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "pw_allocator/allocator.h"
+#include "pw_assert/assert.h"
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/poll.h"
+#include "pw_status/status.h"
+
+namespace pw::async2 {
+
+/// Context required for creating and executing coroutines.
+///
+/// A ``CoroContext`` must be passed as the first parameter of every coroutine
+/// that returns a ``Coro<T>`` (or the second, for member functions). The
+/// coroutine's frame is allocated from its ``Allocator``. The ``Allocator``
+/// must outlive every ``Coro`` created with it.
+class CoroContext {
+ public:
+  explicit CoroContext(allocator::Allocator& alloc) : alloc_(alloc) {}
+
+  allocator::Allocator& alloc() const { return alloc_; }
+
+ private:
+  allocator::Allocator& alloc_;
+};
+
+template <typename T>
+class Coro;
+
+namespace internal {
+
+// Allocates memory for a coroutine frame from ``coro_cx``'s allocator.
+void* CoroAllocate(CoroContext& coro_cx, size_t size);
+
+// Frees a coroutine frame allocated by ``CoroAllocate``.
+void CoroDeallocate(void* ptr, size_t size);
+
+// Type-erased awaitable that is pending, stored by the promise so that
+// ``Coro::Pend`` can poll it without resuming the coroutine.
+class PendingAwaitable {
+ public:
+  constexpr PendingAwaitable() = default;
+
+  template <typename Awaitable>
+  constexpr explicit PendingAwaitable(Awaitable& awaitable)
+      : awaitable_(&awaitable), pend_([](void* self, Context& cx) {
+          return static_cast<Awaitable*>(self)->PendOnce(cx);
+        }) {}
+
+  bool empty() const { return awaitable_ == nullptr; }
+
+  // Returns whether the awaited value is ready.
+  bool Pend(Context& cx) const { return pend_(awaitable_, cx); }
+
+ private:
+  void* awaitable_ = nullptr;
+  bool (*pend_)(void*, Context&) = nullptr;
+};
+
+// The awaitable produced by ``co_await`` on a type with a ``Pend`` method.
+template <typename Pendable, typename Promise>
+class Awaitable {
+ public:
+  using ValueType = PendOutputType<Pendable>;
+
+  Awaitable(Pendable& pendable, Promise& promise)
+      : pendable_(pendable), promise_(promise) {}
+
+  bool await_ready() { return PendOnce(*promise_.context_); }
+
+  void await_suspend(std::coroutine_handle<>) {
+    promise_.pending_ = PendingAwaitable(*this);
+  }
+
+  ValueType await_resume() { return std::move(*value_); }
+
+  bool PendOnce(Context& cx) {
+    Poll<ValueType> poll = pendable_.Pend(cx);
+    if (poll.IsPending()) {
+      return false;
+    }
+    value_.emplace(std::move(*poll));
+    return true;
+  }
+
+ private:
+  Pendable& pendable_;
+  Promise& promise_;
+  std::optional<ValueType> value_;
+};
+
+// The promise type of a ``Coro<T>``.
+template <typename T>
+class CoroPromiseType {
+ public:
+  // Coroutine frames are allocated using the ``CoroContext`` argument.
+  // Allocation failure results in an invalid ``Coro``.
+  template <typename... Args>
+  static void* operator new(size_t size,
+                            CoroContext& coro_cx,
+                            const Args&...) noexcept {
+    return CoroAllocate(coro_cx, size);
+  }
+
+  // Overload for member function coroutines, whose first argument is the
+  // object on which the member function was invoked.
+  template <typename Receiver, typename... Args>
+  static void* operator new(size_t size,
+                            const Receiver&,
+                            CoroContext& coro_cx,
+                            const Args&...) noexcept {
+    return CoroAllocate(coro_cx, size);
+  }
+
+  static void operator delete(void* ptr, size_t size) noexcept {
+    CoroDeallocate(ptr, size);
+  }
+
+  static Coro<T> get_return_object_on_allocation_failure() {
+    return Coro<T>(std::coroutine_handle<CoroPromiseType>());
+  }
+
+  Coro<T> get_return_object() {
+    return Coro<T>(std::coroutine_handle<CoroPromiseType>::from_promise(*this));
+  }
+
+  // Coroutines do not start running until they are first ``Pend``'d.
+  std::suspend_always initial_suspend() { return {}; }
+
+  // The frame is kept alive after completion so that the output can be read.
+  std::suspend_always final_suspend() noexcept { return {}; }
+
+  template <typename U>
+  void return_value(U&& value) {
+    output_.emplace(std::forward<U>(value));
+  }
+
+  void unhandled_exception() { PW_ASSERT(false); }
+
+  template <typename Pendable>
+  Awaitable<std::remove_reference_t<Pendable>, CoroPromiseType>
+  await_transform(Pendable&& pendable) {
+    return Awaitable<std::remove_reference_t<Pendable>, CoroPromiseType>(
+        pendable, *this);
+  }
+
+ private:
+  friend class Coro<T>;
+  template <typename, typename>
+  friend class Awaitable;
+
+  // The context of the ``Pend`` call currently running the coroutine.
+  Context* context_ = nullptr;
+
+  // The awaitable on which the coroutine is suspended, if any.
+  PendingAwaitable pending_;
+
+  std::optional<T> output_;
+};
+
+}  // namespace internal
+
+/// An asynchronous coroutine which implements the C++20 coroutine API.
+///
+/// A ``Coro<T>`` is returned by functions which use ``co_await`` and
+/// ``co_return``, and is itself a future: ``Pend`` runs the coroutine until it
+/// completes, returning ``Ready(value)``, or until it awaits a value which is
+/// not yet available, returning ``Pending``.
+///
+/// Inside a coroutine, ``co_await`` may be applied to any object with a
+/// ``Pend(Context&)`` method returning a ``Poll``, including other ``Coro``
+/// s. If the result is ``Pending``, the coroutine is suspended and the
+/// enclosing ``Task`` is woken once progress can be made.
+///
+/// The first argument of every coroutine must be a ``CoroContext&``, whose
+/// ``Allocator`` is used to allocate the coroutine's frame. If that allocation
+/// fails, the returned ``Coro`` is invalid, and ``Pend`` returns
+/// ``Ready(Status::Internal())``. ``T`` must therefore be constructible from a
+/// ``Status``, such as ``Status`` or ``Result<U>``.
+///
+/// .. code-block:: cpp
+///
+///    Coro<Status> ReceiveAndSend(CoroContext&, Receiver& receiver,
+///                                Sender& sender) {
+///      Result<Data> data = co_await receiver.Receive();
+///      if (!data.ok()) {
+///        co_return data.status();
+///      }
+///      co_return co_await sender.Send(std::move(*data));
+///    }
+template <typename T>
+class Coro final {
+ public:
+  using promise_type = internal::CoroPromiseType<T>;
+
+  /// Creates an empty, invalid ``Coro``.
+  static Coro Empty() { return Coro(std::coroutine_handle<promise_type>()); }
+
+  Coro(Coro&& other) : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Coro& operator=(Coro&& other) {
+    Release();
+    handle_ = std::exchange(other.handle_, nullptr);
+    return *this;
+  }
+
+  ~Coro() { Release(); }
+
+  /// Returns whether this ``Coro`` refers to a coroutine which has not yet
+  /// completed. A ``Coro`` is invalid if its frame could not be allocated, or
+  /// once ``Pend`` has returned ``Ready``.
+  [[nodiscard]] bool IsValid() const { return handle_ != nullptr; }
+
+  /// Runs the coroutine until it completes or must wait.
+  ///
+  /// Returns ``Ready(Status::Internal())`` if this ``Coro`` is invalid.
+  Poll<T> Pend(Context& cx) {
+    if (!IsValid()) {
+      return Ready(T(Status::Internal()));
+    }
+    promise_type& promise = handle_.promise();
+    promise.context_ = &cx;
+    // Poll the value being awaited without resuming the coroutine, so that
+    // spurious wakeups do not require a round trip through the frame.
+    if (!promise.pending_.empty()) {
+      if (!promise.pending_.Pend(cx)) {
+        promise.context_ = nullptr;
+        return Pending();
+      }
+      promise.pending_ = internal::PendingAwaitable();
+    }
+    handle_.resume();
+    promise.context_ = nullptr;
+    if (!handle_.done()) {
+      return Pending();
+    }
+    Poll<T> output = Ready(std::move(*promise.output_));
+    Release();
+    return output;
+  }
+
+ private:
+  friend class internal::CoroPromiseType<T>;
+
+  explicit Coro(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  void Release() {
+    if (handle_ != nullptr) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+}  // namespace pw::async2
@@ -0,0 +1,68 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <utility>
+
+#include "pw_async2/coro.h"
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/poll.h"
+#include "pw_function/function.h"
+#include "pw_status/status.h"
+
+namespace pw::async2 {
+
+/// A ``Task`` that runs a ``Coro<Status>``, invoking an error handler if the
+/// coroutine fails.
+///
+/// This allows coroutines to be ``Post`` ed to a ``Dispatcher`` directly:
+///
+/// .. code-block:: cpp
+///
+///    CoroContext coro_cx(allocator);
+///    CoroOrElseTask task(ReceiveAndSend(coro_cx, receiver, sender),
+///                        [](Status status) {
+///                          PW_LOG_ERROR("Failed: %s", status.str());
+///                        });
+///    dispatcher.Post(task);
+///
+/// If the coroutine frame could not be allocated, ``or_else`` is invoked with
+/// ``Status::Internal()`` the first time the ``Task`` runs.
+class CoroOrElseTask : public Task {
+ public:
+  CoroOrElseTask(Coro<Status>&& coro, Function<void(Status)>&& or_else)
+      : coro_(std::move(coro)), or_else_(std::move(or_else)) {}
+
+  CoroOrElseTask(Priority priority,
+                 Coro<Status>&& coro,
+                 Function<void(Status)>&& or_else)
+      : Task(priority), coro_(std::move(coro)), or_else_(std::move(or_else)) {}
+
+ private:
+  Poll<> DoPend(Context& cx) final {
+    Poll<Status> result = coro_.Pend(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    if (!result->ok()) {
+      or_else_(*result);
+    }
+    return Ready();
+  }
+
+  Coro<Status> coro_;
+  Function<void(Status)> or_else_;
+};
+
+}  // namespace pw::async2
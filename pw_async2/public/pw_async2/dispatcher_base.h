@@ -13,10 +13,18 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <optional>
+#include <utility>
 
 #include "pw_assert/assert.h"
+#include "pw_async2/dispatcher_metrics.h"
+#include "pw_async2/internal/config.h"
+#include "pw_async2/internal/timer_wheel.h"
 #include "pw_async2/poll.h"
 #include "pw_chrono/system_clock.h"
 #include "pw_sync/interrupt_spin_lock.h"
@@ -39,7 +47,9 @@ inline pw::sync::InterruptSpinLock& dispatcher_lock() {
   return *lock;
 }
 
+class AtomicWaker;
 class DispatcherBase;
+class TimeFuture;
 class Waker;
 class WaitReason;
 
@@ -86,6 +96,23 @@ class Context {
   Waker* waker_;
 };
 
+namespace internal {
+
+template <typename T>
+struct PollValue;
+
+template <typename T>
+struct PollValue<Poll<T>> {
+  using type = T;
+};
+
+// The type of the value produced by ``Future::Pend`` once ready.
+template <typename Future>
+using PendOutputType = typename PollValue<decltype(
+    std::declval<Future&>().Pend(std::declval<Context&>()))>::type;
+
+}  // namespace internal
+
 /// A task which may complete one or more asynchronous operations.
 ///
 /// The ``Task`` interface is commonly implemented by users wishing to schedule
@@ -109,14 +136,34 @@ class Context {
 /// being ``Pend``'d by a ``Dispatcher``. The best way to ensure this is to
 /// create ``Task`` objects that continue to live until they receive a
 /// ``DoDestroy`` call or which outlive their associated ``Dispatcher``.
+///
+/// Each ``Task`` has a ``Priority``. Woken ``Task`` s are run in priority
+/// order, and in the order they were woken within a priority. To prevent
+/// starvation, a woken ``Task`` that has been passed over in favor of
+/// higher-priority ``Task`` s ``PW_ASYNC2_STARVATION_LIMIT`` times in a row is
+/// run next regardless of its priority.
 class Task {
+  friend class AtomicWaker;
   friend class Waker;
   friend class DispatcherBase;
+  friend class TimeFuture;
   template <typename T>
   friend class DispatcherImpl;
 
  public:
+  /// The scheduling priority of a ``Task``.
+  enum class Priority : uint8_t {
+    kLow,
+    kNormal,
+    kHigh,
+  };
+
+  /// The number of distinct ``Priority`` levels.
+  static constexpr size_t kNumPriorities =
+      static_cast<size_t>(Priority::kHigh) + 1;
+
   Task() = default;
+  explicit Task(Priority priority) : priority_(priority) {}
   Task(Task&) = delete;
   Task(Task&&) = delete;
   Task& operator=(Task&) = delete;
@@ -155,6 +202,23 @@ class Task {
   // This should only be called by ``Task`` s delegating to other ``Task`` s.
   void Destroy() { DoDestroy(); }
 
+  /// Returns the scheduling priority of this ``Task``.
+  Priority priority() const { return priority_; }
+
+  /// Sets the scheduling priority of this ``Task``.
+  ///
+  /// Precondition: the ``Task`` must not be posted to a ``Dispatcher``.
+  void set_priority(Priority priority) PW_LOCKS_EXCLUDED(dispatcher_lock());
+
+#if PW_ASYNC2_ENABLE_METRICS
+  /// Returns the run-time statistics recorded for this ``Task``.
+  ///
+  /// These are updated by the ``Dispatcher`` while holding
+  /// ``dispatcher_lock()``.
+  const TaskMetrics& metrics() const { return metrics_; }
+  TaskMetrics& metrics() { return metrics_; }
+#endif  // PW_ASYNC2_ENABLE_METRICS
+
  private:
   /// Attempts to advance this ``Task`` to completion.
   ///
@@ -201,12 +265,22 @@ class Task {
   enum class State {
     kUnposted,
     kRunning,
+    // The task is in the woken list, or, if it was woken while running, will
+    // be added to it once its current ``Pend`` call returns.
     kWoken,
     kSleeping,
   };
   // The current state of the task.
   State state_ PW_GUARDED_BY(dispatcher_lock()) = State::kUnposted;
 
+  // The scheduling priority of the task. This is only modified while the task
+  // is unposted, so the dispatcher may read it without synchronization.
+  Priority priority_ = Priority::kNormal;
+
+#if PW_ASYNC2_ENABLE_METRICS
+  TaskMetrics metrics_;
+#endif  // PW_ASYNC2_ENABLE_METRICS
+
   // A pointer to the dispatcher this task is associated with.
   //
   // This will be non-null when `state_` is anything other than `kUnposted`.
@@ -251,8 +325,10 @@ class WaitReason {
 /// ``Waker`` s are most commonly created by ``Dispatcher`` s, which pass them
 /// into ``Task::Pend`` via its ``Context`` argument.
 class Waker {
+  friend class AtomicWaker;
   friend class Task;
   friend class DispatcherBase;
+  friend class TimeFuture;
   template <typename T>
   friend class DispatcherImpl;
 
@@ -315,6 +391,12 @@ class Waker {
     InsertIntoTaskWakerList();
   }
 
+  // Implementations of ``Wake`` and ``operator=`` for callers that already
+  // hold the lock.
+  void WakeLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  void MoveAssignLocked(Waker& other)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
   void InsertIntoTaskWakerList();
   void InsertIntoTaskWakerListLocked()
       PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
@@ -337,6 +419,11 @@ class Waker {
 /// behavior and standardize the interface of these ``Dispatcher`` s,
 /// and to prevent build system cycles due to ``Task`` needing to refer
 /// to the ``Dispatcher`` class.
+///
+/// The run methods of a ``Dispatcher`` may be called from several threads at
+/// once in order to spread ``Task`` s across multiple cores. Each ``Task`` is
+/// only ever ``Pend`` 'd by one thread at a time: a ``Task`` that is woken
+/// while running is requeued once its current ``Pend`` call returns.
 class DispatcherBase {
  public:
   DispatcherBase() = default;
@@ -346,6 +433,14 @@ class DispatcherBase {
   DispatcherBase& operator=(DispatcherBase&&) = delete;
   virtual ~DispatcherBase() {}
 
+#if PW_ASYNC2_ENABLE_METRICS
+  /// Returns the run-time statistics recorded for this ``Dispatcher``.
+  ///
+  /// These are updated while holding ``dispatcher_lock()``.
+  const DispatcherMetrics& metrics() const { return metrics_; }
+  DispatcherMetrics& metrics() { return metrics_; }
+#endif  // PW_ASYNC2_ENABLE_METRICS
+
  protected:
   /// Check that a task is posted on this ``Dispatcher``.
   bool HasPostedTask(Task& task)
@@ -363,7 +458,9 @@ class DispatcherBase {
   void Deregister() PW_LOCKS_EXCLUDED(dispatcher_lock());
 
  private:
+  friend class AtomicWaker;
   friend class Task;
+  friend class TimeFuture;
   friend class Waker;
   template <typename Impl>
   friend class DispatcherImpl;
@@ -373,6 +470,10 @@ class DispatcherBase {
   /// This method's implementation should ensure that the ``Dispatcher`` comes
   /// back from sleep and begins invoking ``RunOneTask`` again.
   ///
+  /// Each call corresponds to exactly one prior call to
+  /// ``AttemptRequestWake`` that returned ``SleepInfo::Indefinitely()``, and
+  /// should wake one sleeping thread.
+  ///
   /// Note: the ``dispatcher_lock()`` may or may not be held here, so it must
   /// not be acquired by ``DoWake``, nor may ``DoWake`` assume that it has been
   /// acquired.
@@ -390,6 +491,23 @@ class DispatcherBase {
   // For use by ``WakeTask`` and ``DispatcherImpl::Post``.
   void AddTaskToWokenList(Task&) PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
+  // Records metrics and trace events for a single ``Pend`` call of a task
+  // popped by ``RunOneTask``. This does nothing unless
+  // ``PW_ASYNC2_ENABLE_METRICS`` or ``PW_ASYNC2_ENABLE_TRACING`` is set.
+  class PollRecorder {
+   public:
+#if PW_ASYNC2_ENABLE_METRICS || PW_ASYNC2_ENABLE_TRACING
+    explicit PollRecorder(Task& task);
+    ~PollRecorder();
+
+   private:
+    Task& task_;
+    chrono::SystemClock::time_point start_;
+#else
+    constexpr explicit PollRecorder(Task&) {}
+#endif  // PW_ASYNC2_ENABLE_METRICS || PW_ASYNC2_ENABLE_TRACING
+  };
+
   // For use by ``RunOneTask``.
   void AddTaskToSleepingList(Task&)
       PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
@@ -397,14 +515,107 @@ class DispatcherBase {
   // For use by ``Waker``.
   void WakeTask(Task&) PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
+  // Claims one of the outstanding requests to be woken by ``DoWake``.
+  // Returns false if no thread is waiting to be woken.
+  bool TryClaimSleeper();
+
+  // Wakes one thread that is sleeping on this dispatcher, if any.
+  //
+  // This does not require the lock, but callers that do not hold it must
+  // otherwise ensure that the dispatcher is not destroyed during the call.
+  void WakeOneSleeper();
+
+  // Wakes every thread that is sleeping on this dispatcher.
+  void WakeAllSleepersLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
+  // For use by ``AtomicWaker``.
+  void AddAtomicWakerLocked(AtomicWaker&)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  void RemoveAtomicWakerLocked(AtomicWaker&)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  void PushSignaledAtomicWaker(AtomicWaker&);
+
+  // Wakes the tasks registered with every ``AtomicWaker`` that has been
+  // signaled since the last call.
+  void DrainSignaledAtomicWakersLocked()
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
+  // Returns whether any ``AtomicWaker`` has been signaled but not drained.
+  bool HasSignaledAtomicWakers() const {
+    return signaled_.load(std::memory_order_acquire) != nullptr;
+  }
+
+  // For use by ``TimeFuture``.
+  void AddTimerLocked(TimeFuture&, chrono::SystemClock::time_point deadline)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  void RemoveTimerLocked(TimeFuture&)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+  void ReplaceTimerLocked(TimeFuture& old_timer, TimeFuture& new_timer)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
+  // Wakes the tasks waiting on every ``TimeFuture`` whose deadline is at or
+  // before ``now``.
+  void ExpireTimersLocked(chrono::SystemClock::time_point now)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
+
+  // Returns whether any tasks are waiting to be run.
+  bool HasWokenTasksLocked() const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock()) {
+    for (const WokenQueue& queue : woken_) {
+      if (queue.first != nullptr) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns whether no tasks are woken, sleeping, or running.
+  bool HasNoTasksLocked() const PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock()) {
+    return !HasWokenTasksLocked() && sleeping_ == nullptr && num_running_ == 0;
+  }
+
   // For use by ``RunOneTask``.
+  //
+  // Returns the next task to run: the first task in the highest-priority
+  // non-empty queue, unless a lower-priority queue has been passed over more
+  // than ``PW_ASYNC2_STARVATION_LIMIT`` times in a row.
   Task* PopWokenTask() PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock());
 
-  Task* first_woken_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
-  Task* last_woken_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
+  struct WokenQueue {
+    Task* first = nullptr;
+    Task* last = nullptr;
+    // The number of consecutive times a task was taken from a higher-priority
+    // queue while this one was non-empty.
+    size_t passed_over = 0;
+  };
+
+  WokenQueue& woken_queue(const Task& task)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(dispatcher_lock()) {
+    return woken_[static_cast<size_t>(task.priority_)];
+  }
+
+  // FIFO queues of woken tasks, indexed by ``Task::Priority``.
+  std::array<WokenQueue, Task::kNumPriorities> woken_
+      PW_GUARDED_BY(dispatcher_lock());
   // Note: the sleeping list's order is not significant.
   Task* sleeping_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
-  bool wants_wake_ PW_GUARDED_BY(dispatcher_lock()) = false;
+  // The number of tasks currently being ``Pend``'d.
+  size_t num_running_ PW_GUARDED_BY(dispatcher_lock()) = 0;
+  // The number of threads sleeping until ``DoWake`` is called.
+  //
+  // This is atomic rather than guarded by the lock so that ``AtomicWaker``
+  // can wake the dispatcher without acquiring the lock.
+  std::atomic<size_t> num_sleepers_ = 0;
+  // Lock-free stack of ``AtomicWaker`` s that have been signaled but whose
+  // tasks have not yet been woken.
+  std::atomic<AtomicWaker*> signaled_ = nullptr;
+  // ``AtomicWaker`` s registered with tasks on this dispatcher.
+  AtomicWaker* atomic_wakers_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
+  // Pending ``TimeFuture`` s, sorted by deadline.
+  internal::TimerWheel timers_ PW_GUARDED_BY(dispatcher_lock());
+#if PW_ASYNC2_ENABLE_METRICS
+  DispatcherMetrics metrics_;
+#endif  // PW_ASYNC2_ENABLE_METRICS
 };
 
 /// Information about whether and when to sleep until as returned by
@@ -418,14 +629,31 @@ class [[nodiscard]] SleepInfo {
  public:
   bool should_sleep() const { return should_sleep_; }
 
+  /// Returns the time at which the ``Dispatcher`` should wake up even if it
+  /// has not received a ``DoWake`` call, or ``std::nullopt`` if it should
+  /// sleep until ``DoWake`` is called.
+  ///
+  /// A ``Dispatcher`` that wakes up at this time must call
+  /// ``CancelRequestWake`` before running tasks again.
+  std::optional<chrono::SystemClock::time_point> wake_time() const {
+    return wake_time_;
+  }
+
  private:
-  SleepInfo(bool should_sleep) : should_sleep_(should_sleep) {}
+  SleepInfo(bool should_sleep,
+            std::optional<chrono::SystemClock::time_point> wake_time)
+      : should_sleep_(should_sleep), wake_time_(wake_time) {}
 
-  static SleepInfo DontSleep() { return SleepInfo(false); }
+  static SleepInfo DontSleep() { return SleepInfo(false, std::nullopt); }
 
-  static SleepInfo Indefinitely() { return SleepInfo(true); }
+  static SleepInfo Indefinitely() { return SleepInfo(true, std::nullopt); }
+
+  static SleepInfo Until(chrono::SystemClock::time_point wake_time) {
+    return SleepInfo(true, wake_time);
+  }
 
   bool should_sleep_;
+  std::optional<chrono::SystemClock::time_point> wake_time_;
 };
 
 /// Information about the result of a call to ``RunOneTask``.
@@ -481,10 +709,7 @@ class DispatcherImpl : public DispatcherBase {
       task.state_ = Task::State::kWoken;
       task.dispatcher_ = this;
       AddTaskToWokenList(task);
-      if (wants_wake_) {
-        wake_dispatcher = true;
-        wants_wake_ = false;
-      }
+      wake_dispatcher = TryClaimSleeper();
     }
     // Note: unlike in ``WakeTask``, here we know that the ``Dispatcher`` will
     // not be destroyed out from under our feet because we're in a method being
@@ -530,17 +755,43 @@ class DispatcherImpl : public DispatcherBase {
   /// be done.
   SleepInfo AttemptRequestWake() PW_LOCKS_EXCLUDED(dispatcher_lock()) {
     std::lock_guard lock(dispatcher_lock());
-    // Don't allow sleeping if there are already tasks waiting to be run.
-    if (first_woken_ != nullptr) {
-      return SleepInfo::DontSleep();
+    if (!timers_.empty()) {
+      ExpireTimersLocked(chrono::SystemClock::now());
     }
     /// Indicate that the ``Dispatcher`` is sleeping and will need a ``DoWake``
     /// call once more work can be done.
-    wants_wake_ = true;
-    // Once timers are added, this should check them.
+    ///
+    /// This is done before checking for work so that an ``AtomicWaker``
+    /// signaled concurrently either is seen below or sees this request.
+    num_sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    // Don't allow sleeping if there are already tasks waiting to be run, or
+    // if there are no tasks left that could be woken.
+    if (HasWokenTasksLocked() || HasSignaledAtomicWakers() ||
+        HasNoTasksLocked()) {
+      if (TryClaimSleeper()) {
+        return SleepInfo::DontSleep();
+      }
+      // A ``DoWake`` call has already been made for this request, so the
+      // sleep will end immediately.
+      return SleepInfo::Indefinitely();
+    }
+    std::optional<chrono::SystemClock::time_point> next_timer =
+        timers_.NextDeadline();
+    if (next_timer.has_value()) {
+      return SleepInfo::Until(*next_timer);
+    }
     return SleepInfo::Indefinitely();
   }
 
+  /// Indicates that a ``Dispatcher`` which called ``AttemptRequestWake`` has
+  /// stopped sleeping without receiving a ``DoWake`` call, such as when the
+  /// ``SleepInfo::wake_time`` passed.
+  void CancelRequestWake() PW_LOCKS_EXCLUDED(dispatcher_lock()) {
+    // If no request can be claimed, a ``DoWake`` call raced with the timeout
+    // and the next attempt to sleep will end immediately.
+    static_cast<void>(TryClaimSleeper());
+  }
+
   /// Attempts to run a single task, returning whether any tasks were
   /// run, and whether `task_to_look_for` was run.
   [[nodiscard]] RunOneTaskResult RunOneTask(Task* task_to_look_for)
@@ -548,17 +799,28 @@ class DispatcherImpl : public DispatcherBase {
     Task* task;
     {
       std::lock_guard lock(dispatcher_lock());
+      if (HasSignaledAtomicWakers()) {
+        DrainSignaledAtomicWakersLocked();
+      }
+      if (!timers_.empty()) {
+        ExpireTimersLocked(chrono::SystemClock::now());
+      }
       task = PopWokenTask();
       if (task == nullptr) {
-        return RunOneTaskResult(false, false, false);
+        return RunOneTaskResult(
+            /*completed_all_tasks=*/HasNoTasksLocked(),
+            /*completed_main_task=*/false,
+            /*ran_a_task=*/false);
       }
       task->state_ = Task::State::kRunning;
+      ++num_running_;
     }
 
     bool complete;
     {
       Waker waker(*task);
       Context context(self(), waker);
+      PollRecorder recorder(*task);
       complete = task->Pend(context).IsReady();
     }
     if (complete) {
@@ -571,15 +833,19 @@ class DispatcherImpl : public DispatcherBase {
             PW_DASSERT(false);
             PW_UNREACHABLE;
           case Task::State::kRunning:
-            break;
           case Task::State::kWoken:
-            RemoveWokenTaskLocked(*task);
+            // A task woken while running is not requeued until it returns.
             break;
         }
         task->state_ = Task::State::kUnposted;
         task->dispatcher_ = nullptr;
         task->RemoveAllWakersLocked();
-        all_complete = first_woken_ == nullptr && sleeping_ == nullptr;
+        --num_running_;
+        all_complete = HasNoTasksLocked();
+        if (all_complete) {
+          // Let any other threads running this dispatcher return.
+          WakeAllSleepersLocked();
+        }
       }
       task->DoDestroy();
       return RunOneTaskResult(
@@ -588,9 +854,13 @@ class DispatcherImpl : public DispatcherBase {
           /*ran_a_task=*/true);
     } else {
       std::lock_guard lock(dispatcher_lock());
+      --num_running_;
       if (task->state_ == Task::State::kRunning) {
         task->state_ = Task::State::kSleeping;
         AddTaskToSleepingList(*task);
+      } else {
+        AddTaskToWokenList(*task);
+        WakeOneSleeper();
       }
       return RunOneTaskResult(
           /*completed_all_tasks=*/false,
@@ -0,0 +1,100 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_allocator/histogram.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_metric/metric.h"
+
+namespace pw::async2 {
+
+class DispatcherBase;
+
+/// Run-time statistics for a single ``Task``.
+///
+/// These are only recorded if ``PW_ASYNC2_ENABLE_METRICS`` is set. The
+/// metrics may be exported by adding ``group()`` to another metric group.
+class TaskMetrics {
+ public:
+  TaskMetrics() = default;
+
+  const metric::Group& group() const { return group_; }
+  metric::Group& group() { return group_; }
+
+  /// Returns the number of times the ``Task`` has been ``Pend``'d.
+  uint32_t polls() const { return polls_.value(); }
+
+  /// Returns the total time spent in the ``Task``'s ``Pend``, in microseconds.
+  uint32_t poll_time_us() const { return poll_time_us_.value(); }
+
+  /// Returns the longest single ``Pend`` call, in microseconds.
+  uint32_t max_poll_time_us() const { return max_poll_time_us_.value(); }
+
+ private:
+  friend class DispatcherBase;
+
+  void RecordPoll(uint32_t duration_us);
+
+  PW_METRIC_GROUP(group_, "task");
+  PW_METRIC(group_, polls_, "polls", 0u);
+  PW_METRIC(group_, poll_time_us_, "poll_time_us", 0u);
+  PW_METRIC(group_, max_poll_time_us_, "max_poll_time_us", 0u);
+
+  // When the task was last added to a woken queue.
+  chrono::SystemClock::time_point woken_at_;
+};
+
+/// Run-time statistics for a ``Dispatcher``.
+///
+/// These are only recorded if ``PW_ASYNC2_ENABLE_METRICS`` is set. The
+/// metrics may be exported by adding ``group()`` to another metric group.
+class DispatcherMetrics {
+ public:
+  DispatcherMetrics();
+
+  const metric::Group& group() const { return group_; }
+  metric::Group& group() { return group_; }
+
+  /// Returns the total number of ``Pend`` calls made by the ``Dispatcher``.
+  uint32_t polls() const { return polls_.value(); }
+
+  /// Returns the number of woken ``Task`` s waiting to run.
+  uint32_t queue_depth() const { return queue_depth_.value(); }
+
+  /// Returns the largest number of woken ``Task`` s that have waited to run.
+  uint32_t max_queue_depth() const { return max_queue_depth_.value(); }
+
+  /// Returns the histogram of the time between ``Task`` s being woken and
+  /// being run, in microseconds.
+  const allocator::Log2Histogram& wake_to_run_us() const {
+    return wake_to_run_us_;
+  }
+
+ private:
+  friend class DispatcherBase;
+
+  void RecordEnqueued();
+  void RecordDequeued();
+  void RecordRun(uint32_t wake_to_run_us);
+
+  PW_METRIC_GROUP(group_, "dispatcher");
+  PW_METRIC(group_, polls_, "polls", 0u);
+  PW_METRIC(group_, queue_depth_, "queue_depth", 0u);
+  PW_METRIC(group_, max_queue_depth_, "max_queue_depth", 0u);
+  allocator::Log2Histogram wake_to_run_us_;
+};
+
+}  // namespace pw::async2
@@ -0,0 +1,51 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Configuration macros for the pw_async2 module.
+#pragma once
+
+#include <cstddef>
+
+// The number of times in a row that a woken ``Task`` may be passed over in
+// favor of higher-priority ``Task`` s before it is run anyway.
+//
+// This bounds how long a low-priority ``Task`` can be starved by a stream of
+// higher-priority work. Setting this to ``0`` disables starvation protection,
+// so woken ``Task`` s always run in strict priority order.
+#ifndef PW_ASYNC2_STARVATION_LIMIT
+#define PW_ASYNC2_STARVATION_LIMIT 8
+#endif  // PW_ASYNC2_STARVATION_LIMIT
+
+// Whether ``Task`` s and ``Dispatcher`` s record run-time ``pw_metric``
+// statistics, such as poll counts, poll durations, and wake-to-run latency.
+//
+// This adds a ``TaskMetrics`` to every ``Task`` and a ``DispatcherMetrics`` to
+// every ``Dispatcher``, and reads the system clock around every ``Pend`` call.
+#ifndef PW_ASYNC2_ENABLE_METRICS
+#define PW_ASYNC2_ENABLE_METRICS 0
+#endif  // PW_ASYNC2_ENABLE_METRICS
+
+// Whether ``Dispatcher`` s emit ``pw_trace`` events when ``Task`` s are woken
+// and ``Pend``'d. Events are grouped by ``Task`` using trace IDs.
+#ifndef PW_ASYNC2_ENABLE_TRACING
+#define PW_ASYNC2_ENABLE_TRACING 0
+#endif  // PW_ASYNC2_ENABLE_TRACING
+
+namespace pw::async2::internal::config {
+
+inline constexpr size_t kStarvationLimit = PW_ASYNC2_STARVATION_LIMIT;
+inline constexpr bool kEnableMetrics = PW_ASYNC2_ENABLE_METRICS;
+inline constexpr bool kEnableTracing = PW_ASYNC2_ENABLE_TRACING;
+
+}  // namespace pw::async2::internal::config
@@ -0,0 +1,149 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_function/function.h"
+
+namespace pw::async2::internal {
+
+class TimerWheel;
+
+/// An intrusive entry in a ``TimerWheel``.
+class TimerWheelNode {
+ public:
+  TimerWheelNode() = default;
+  TimerWheelNode(const TimerWheelNode&) = delete;
+  TimerWheelNode& operator=(const TimerWheelNode&) = delete;
+
+  /// Returns whether this node is in a ``TimerWheel``.
+  bool in_wheel() const { return prev_next_ != nullptr; }
+
+ private:
+  friend class TimerWheel;
+
+  // The node's deadline, in ``SystemClock`` ticks.
+  uint64_t expiry_ = 0;
+
+  // The next node in this node's slot.
+  TimerWheelNode* next_ = nullptr;
+
+  // The pointer to this node in its slot, either the slot head or the
+  // ``next_`` field of the previous node. Null if not in a wheel.
+  TimerWheelNode** prev_next_ = nullptr;
+};
+
+/// A hierarchical timer wheel.
+///
+/// Nodes are sorted into ``kNumLevels`` levels of ``kSlotsPerLevel`` slots
+/// each, where each slot at level ``L`` covers ``kSlotsPerLevel ^ L`` clock
+/// ticks. Inserting and removing a node are ``O(1)``, and advancing the wheel
+/// visits at most ``kSlotsPerLevel`` slots per level regardless of how much
+/// time has passed. A node whose slot is visited before its deadline is
+/// moved down to a finer level.
+///
+/// Deadlines further out than the top level can represent are parked in the
+/// top level and re-sorted each time their slot is visited.
+///
+/// ``TimerWheel`` is not thread-safe; callers must synchronize access.
+class TimerWheel {
+ public:
+  static constexpr size_t kBitsPerLevel = 6;
+  static constexpr size_t kSlotsPerLevel = size_t{1} << kBitsPerLevel;
+  static constexpr size_t kNumLevels = 6;
+
+  TimerWheel() = default;
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /// Returns whether the wheel contains any nodes.
+  bool empty() const { return size_ == 0; }
+
+  /// Returns the number of nodes in the wheel.
+  size_t size() const { return size_; }
+
+  /// Adds a node that should expire at ``deadline``.
+  ///
+  /// Deadlines at or before the last time passed to ``Advance`` expire on the
+  /// next call to ``Advance`` with a later time.
+  ///
+  /// Precondition: ``node`` must not already be in a wheel.
+  void Insert(TimerWheelNode& node, chrono::SystemClock::time_point deadline);
+
+  /// Removes a node from the wheel, if it is in one.
+  void Remove(TimerWheelNode& node);
+
+  /// Replaces ``old_node`` with ``new_node`` at the same position.
+  ///
+  /// Precondition: ``old_node`` is in this wheel and ``new_node`` is not in
+  /// any wheel.
+  void Replace(TimerWheelNode& old_node, TimerWheelNode& new_node);
+
+  /// Removes every node whose deadline is at or before ``now`` and passes it
+  /// to ``on_expired``.
+  ///
+  /// ``on_expired`` must not modify the wheel.
+  void Advance(chrono::SystemClock::time_point now,
+               const Function<void(TimerWheelNode&)>& on_expired);
+
+  /// Removes every node from the wheel and passes it to ``on_removed``.
+  void Clear(const Function<void(TimerWheelNode&)>& on_removed);
+
+  /// Returns a time at or before the earliest deadline in the wheel, or
+  /// ``std::nullopt`` if the wheel is empty.
+  ///
+  /// The returned time is exact for deadlines within ``kSlotsPerLevel`` ticks
+  /// of the last call to ``Advance``. Later deadlines are rounded down to the
+  /// start of their slot, so a caller that sleeps until the returned time and
+  /// then calls ``Advance`` may find that nothing has expired yet.
+  std::optional<chrono::SystemClock::time_point> NextDeadline() const;
+
+ private:
+  static constexpr size_t kSlotMask = kSlotsPerLevel - 1;
+
+  static uint64_t ToTicks(chrono::SystemClock::time_point time) {
+    return static_cast<uint64_t>(time.time_since_epoch().count());
+  }
+
+  static chrono::SystemClock::time_point FromTicks(uint64_t ticks) {
+    return chrono::SystemClock::time_point(
+        chrono::SystemClock::duration(static_cast<int64_t>(ticks)));
+  }
+
+  // Links a node whose ``expiry_`` is set into the slot for its deadline.
+  void Link(TimerWheelNode& node);
+
+  // Unlinks a node from its slot without updating ``size_``.
+  static void Unlink(TimerWheelNode& node);
+
+  TimerWheelNode*& slot(size_t level, size_t index) {
+    return slots_[(level * kSlotsPerLevel) + index];
+  }
+
+  const TimerWheelNode* slot(size_t level, size_t index) const {
+    return slots_[(level * kSlotsPerLevel) + index];
+  }
+
+  // The last time passed to ``Advance``, in ticks.
+  uint64_t now_ = 0;
+  size_t size_ = 0;
+  std::array<TimerWheelNode*, kNumLevels * kSlotsPerLevel> slots_{};
+};
+
+}  // namespace pw::async2::internal
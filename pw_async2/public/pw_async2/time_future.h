@@ -0,0 +1,112 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <optional>
+#include <utility>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/internal/timer_wheel.h"
+#include "pw_async2/poll.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::async2 {
+
+/// A future which completes once the ``SystemClock`` reaches a deadline.
+///
+/// Pending ``TimeFuture`` s are stored in a timer wheel owned by the
+/// ``Dispatcher`` that runs the ``Task`` which pends them, rather than each
+/// holding a separate timer. Starting and cancelling a ``TimeFuture`` are
+/// ``O(1)``, and a ``Dispatcher`` only ever waits for its earliest deadline.
+///
+/// Destroying a ``TimeFuture`` cancels it.
+class TimeFuture final : public internal::TimerWheelNode {
+ public:
+  /// Creates a ``TimeFuture`` which completes at ``deadline``.
+  explicit TimeFuture(chrono::SystemClock::time_point deadline)
+      : deadline_(deadline) {}
+
+  /// Creates a ``TimeFuture`` which completes after ``delay`` has elapsed.
+  static TimeFuture After(chrono::SystemClock::duration delay) {
+    return TimeFuture(chrono::SystemClock::TimePointAfterAtLeast(delay));
+  }
+
+  TimeFuture(TimeFuture&& other) PW_LOCKS_EXCLUDED(dispatcher_lock());
+  TimeFuture& operator=(TimeFuture&& other)
+      PW_LOCKS_EXCLUDED(dispatcher_lock());
+  ~TimeFuture() PW_LOCKS_EXCLUDED(dispatcher_lock());
+
+  /// Returns ``Ready`` if the deadline has passed. Otherwise, arranges for the
+  /// current ``Task`` to be woken at the deadline and returns ``Pending``.
+  Poll<> Pend(Context& cx) PW_LOCKS_EXCLUDED(dispatcher_lock());
+
+  /// Returns the time at which this future completes.
+  chrono::SystemClock::time_point deadline() const { return deadline_; }
+
+ private:
+  friend class DispatcherBase;
+
+  chrono::SystemClock::time_point deadline_;
+
+  // The dispatcher whose timer wheel this future is in, if any.
+  DispatcherBase* dispatcher_ PW_GUARDED_BY(dispatcher_lock()) = nullptr;
+
+  // The waker to wake once the deadline passes.
+  Waker waker_;
+};
+
+/// A future which completes with the output of another future, or with
+/// ``std::nullopt`` if a deadline passes first.
+///
+/// ``Future`` may be any type with a ``Pend(Context&)`` method returning a
+/// ``Poll``. ``TimeoutFuture`` s are most easily created using ``Timeout``.
+template <typename Future>
+class TimeoutFuture {
+ public:
+  using ValueType = internal::PendOutputType<Future>;
+
+  TimeoutFuture(Future&& future, TimeFuture&& timer)
+      : future_(std::move(future)), timer_(std::move(timer)) {}
+
+  /// Returns the output of the wrapped future if it is ready, ``std::nullopt``
+  /// if the deadline has passed, or ``Pending`` otherwise.
+  Poll<std::optional<ValueType>> Pend(Context& cx) {
+    Poll<ValueType> result = future_.Pend(cx);
+    if (result.IsReady()) {
+      return Ready(std::optional<ValueType>(std::move(result.value())));
+    }
+    if (timer_.Pend(cx).IsReady()) {
+      return Ready(std::optional<ValueType>());
+    }
+    return Pending();
+  }
+
+  /// Returns the wrapped future.
+  Future& future() { return future_; }
+
+ private:
+  Future future_;
+  TimeFuture timer_;
+};
+
+/// Wraps ``future`` so that it completes with ``std::nullopt`` if it has not
+/// completed within ``timeout``.
+template <typename Future>
+TimeoutFuture<Future> Timeout(Future future,
+                              chrono::SystemClock::duration timeout) {
+  return TimeoutFuture<Future>(std::move(future), TimeFuture::After(timeout));
+}
+
+}  // namespace pw::async2
@@ -0,0 +1,78 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/time_future.h"
+
+#include <mutex>
+
+namespace pw::async2 {
+
+TimeFuture::TimeFuture(TimeFuture&& other) : deadline_(other.deadline_) {
+  std::lock_guard lock(dispatcher_lock());
+  // The waker must be moved under the lock in order to ensure that there is
+  // no race between moving the ``TimeFuture`` and its deadline expiring.
+  waker_.MoveAssignLocked(other.waker_);
+  if (other.dispatcher_ != nullptr) {
+    other.dispatcher_->ReplaceTimerLocked(other, *this);
+  }
+}
+
+TimeFuture& TimeFuture::operator=(TimeFuture&& other) {
+  std::lock_guard lock(dispatcher_lock());
+  if (dispatcher_ != nullptr) {
+    dispatcher_->RemoveTimerLocked(*this);
+  }
+  deadline_ = other.deadline_;
+  waker_.MoveAssignLocked(other.waker_);
+  if (other.dispatcher_ != nullptr) {
+    other.dispatcher_->ReplaceTimerLocked(other, *this);
+  }
+  return *this;
+}
+
+TimeFuture::~TimeFuture() {
+  std::lock_guard lock(dispatcher_lock());
+  if (dispatcher_ != nullptr) {
+    dispatcher_->RemoveTimerLocked(*this);
+  }
+}
+
+Poll<> TimeFuture::Pend(Context& cx) {
+  if (chrono::SystemClock::now() >= deadline_) {
+    std::lock_guard lock(dispatcher_lock());
+    if (dispatcher_ != nullptr) {
+      dispatcher_->RemoveTimerLocked(*this);
+    }
+    return Ready();
+  }
+
+  Waker waker = cx.GetWaker(WaitReason::Unspecified());
+  std::lock_guard lock(dispatcher_lock());
+  if (waker.task_ == nullptr) {
+    // There is no task to wake.
+    return Pending();
+  }
+  // The ``Waker`` for a running task refers to that task's dispatcher.
+  DispatcherBase* dispatcher = waker.task_->dispatcher_;
+  waker_.MoveAssignLocked(waker);
+  if (dispatcher_ != dispatcher) {
+    if (dispatcher_ != nullptr) {
+      dispatcher_->RemoveTimerLocked(*this);
+    }
+    dispatcher->AddTimerLocked(*this, deadline_);
+  }
+  return Pending();
+}
+
+}  // namespace pw::async2
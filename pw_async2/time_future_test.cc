@@ -0,0 +1,158 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/time_future.h"
+
+#include <chrono>
+#include <optional>
+
+#include "gtest/gtest.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_chrono/system_clock.h"
+
+namespace pw::async2 {
+namespace {
+
+using ::pw::chrono::SystemClock;
+using namespace std::chrono_literals;
+
+class TimerTask : public Task {
+ public:
+  TimerTask(SystemClock::duration delay) : timer_(TimeFuture::After(delay)) {}
+
+  int polled = 0;
+  std::optional<SystemClock::time_point> completed_at;
+
+  const TimeFuture& timer() const { return *timer_; }
+
+  void CancelTimer() { timer_.reset(); }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    ++polled;
+    if (!timer_.has_value() || timer_->Pend(cx).IsPending()) {
+      return Pending();
+    }
+    completed_at = SystemClock::now();
+    return Ready();
+  }
+
+  std::optional<TimeFuture> timer_;
+};
+
+/// Future which never completes.
+class NeverFuture {
+ public:
+  Poll<int> Pend(Context&) { return Pending(); }
+};
+
+/// Future which completes immediately.
+class NowFuture {
+ public:
+  Poll<int> Pend(Context&) { return Ready(7); }
+};
+
+template <typename Future>
+class TimeoutTask : public Task {
+ public:
+  TimeoutTask(TimeoutFuture<Future>&& future) : future_(std::move(future)) {}
+
+  std::optional<std::optional<int>> result;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    Poll<std::optional<int>> poll = future_.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  }
+
+  TimeoutFuture<Future> future_;
+};
+
+TEST(TimeFuture, ExpiredDeadlineIsReadyImmediately) {
+  TimerTask task(SystemClock::duration(0));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsReady());
+  EXPECT_EQ(task.polled, 1);
+}
+
+TEST(TimeFuture, RunToCompletionWaitsForDeadline) {
+  TimerTask task(SystemClock::for_at_least(5ms));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsPending());
+
+  dispatcher.RunToCompletion(task);
+  ASSERT_TRUE(task.completed_at.has_value());
+  EXPECT_GE(*task.completed_at, task.timer().deadline());
+  EXPECT_EQ(task.polled, 2);
+}
+
+TEST(TimeFuture, TimersCompleteInDeadlineOrder) {
+  TimerTask later(SystemClock::for_at_least(10ms));
+  TimerTask sooner(SystemClock::for_at_least(2ms));
+  Dispatcher dispatcher;
+  dispatcher.Post(later);
+  dispatcher.Post(sooner);
+
+  dispatcher.RunToCompletion(sooner);
+  EXPECT_TRUE(sooner.completed_at.has_value());
+  EXPECT_FALSE(later.completed_at.has_value());
+  dispatcher.RunToCompletion();
+  ASSERT_TRUE(later.completed_at.has_value());
+  EXPECT_GE(*later.completed_at, *sooner.completed_at);
+}
+
+TEST(TimeFuture, DestroyingPendingFutureCancelsIt) {
+  TimerTask task(SystemClock::for_at_least(2ms));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  task.CancelTimer();
+  SystemClock::time_point deadline = SystemClock::TimePointAfterAtLeast(5ms);
+  while (SystemClock::now() < deadline) {
+  }
+  // The cancelled timer must not wake the task.
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_EQ(task.polled, 1);
+}
+
+TEST(Timeout, ReturnsValueWhenFutureCompletes) {
+  TimeoutTask<NowFuture> task(
+      Timeout(NowFuture(), SystemClock::for_at_least(1h)));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsReady());
+  ASSERT_TRUE(task.result.has_value());
+  ASSERT_TRUE(task.result->has_value());
+  EXPECT_EQ(**task.result, 7);
+}
+
+TEST(Timeout, ReturnsNulloptWhenDeadlinePasses) {
+  TimeoutTask<NeverFuture> task(
+      Timeout(NeverFuture(), SystemClock::for_at_least(2ms)));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion(task);
+  ASSERT_TRUE(task.result.has_value());
+  EXPECT_FALSE(task.result->has_value());
+}
+
+}  // namespace
+}  // namespace pw::async2
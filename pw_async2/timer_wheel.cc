@@ -0,0 +1,171 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/internal/timer_wheel.h"
+
+#include <algorithm>
+
+#include "pw_assert/check.h"
+
+namespace pw::async2::internal {
+
+void TimerWheel::Insert(TimerWheelNode& node,
+                        chrono::SystemClock::time_point deadline) {
+  PW_DCHECK(!node.in_wheel());
+  node.expiry_ = ToTicks(deadline);
+  Link(node);
+  ++size_;
+}
+
+void TimerWheel::Remove(TimerWheelNode& node) {
+  if (node.in_wheel()) {
+    Unlink(node);
+    --size_;
+  }
+}
+
+void TimerWheel::Replace(TimerWheelNode& old_node, TimerWheelNode& new_node) {
+  PW_DCHECK(old_node.in_wheel());
+  PW_DCHECK(!new_node.in_wheel());
+  new_node.expiry_ = old_node.expiry_;
+  new_node.next_ = old_node.next_;
+  new_node.prev_next_ = old_node.prev_next_;
+  *new_node.prev_next_ = &new_node;
+  if (new_node.next_ != nullptr) {
+    new_node.next_->prev_next_ = &new_node.next_;
+  }
+  old_node.next_ = nullptr;
+  old_node.prev_next_ = nullptr;
+}
+
+void TimerWheel::Link(TimerWheelNode& node) {
+  // Expired nodes are placed in the next slot so that they are visited by the
+  // next call to ``Advance``.
+  uint64_t expiry = std::max(node.expiry_, now_ + 1);
+  uint64_t delta = expiry - now_;
+
+  // Find the finest level whose slots span the delta. Every level's slots
+  // cover one tick of the level above, so this is the level at which the
+  // deadline falls in a slot after the current one.
+  size_t level = 0;
+  while (level < kNumLevels - 1 &&
+         (delta >> (kBitsPerLevel * (level + 1))) != 0) {
+    ++level;
+  }
+  size_t shift = kBitsPerLevel * level;
+  uint64_t bucket = expiry >> shift;
+  uint64_t last_bucket = (now_ >> shift) + kSlotsPerLevel;
+  if (bucket > last_bucket) {
+    // The deadline is beyond the range of the wheel. Park the node in the
+    // furthest slot; it will be re-sorted once that slot is reached.
+    bucket = last_bucket;
+  }
+
+  TimerWheelNode*& head = slot(level, bucket & kSlotMask);
+  node.next_ = head;
+  node.prev_next_ = &head;
+  if (head != nullptr) {
+    head->prev_next_ = &node.next_;
+  }
+  head = &node;
+}
+
+void TimerWheel::Unlink(TimerWheelNode& node) {
+  *node.prev_next_ = node.next_;
+  if (node.next_ != nullptr) {
+    node.next_->prev_next_ = node.prev_next_;
+  }
+  node.next_ = nullptr;
+  node.prev_next_ = nullptr;
+}
+
+void TimerWheel::Advance(chrono::SystemClock::time_point now,
+                         const Function<void(TimerWheelNode&)>& on_expired) {
+  uint64_t ticks = ToTicks(now);
+  if (ticks <= now_) {
+    return;
+  }
+
+  // Detach every slot that has been reached since the last advance. Nodes
+  // that have not yet expired are collected and re-sorted relative to the
+  // new time.
+  TimerWheelNode* pending = nullptr;
+  for (size_t level = 0; level < kNumLevels; ++level) {
+    size_t shift = kBitsPerLevel * level;
+    uint64_t first = now_ >> shift;
+    uint64_t last = ticks >> shift;
+    if (first == last) {
+      // No slots of this level or any coarser level have been reached.
+      break;
+    }
+    uint64_t count = std::min<uint64_t>(last - first, kSlotsPerLevel);
+    for (uint64_t i = 1; i <= count; ++i) {
+      TimerWheelNode*& head = slot(level, (first + i) & kSlotMask);
+      while (head != nullptr) {
+        TimerWheelNode& node = *head;
+        Unlink(node);
+        if (node.expiry_ <= ticks) {
+          --size_;
+          on_expired(node);
+        } else {
+          node.next_ = pending;
+          pending = &node;
+        }
+      }
+    }
+  }
+
+  now_ = ticks;
+  while (pending != nullptr) {
+    TimerWheelNode& node = *pending;
+    pending = node.next_;
+    Link(node);
+  }
+}
+
+void TimerWheel::Clear(const Function<void(TimerWheelNode&)>& on_removed) {
+  for (TimerWheelNode*& head : slots_) {
+    while (head != nullptr) {
+      TimerWheelNode& node = *head;
+      Unlink(node);
+      on_removed(node);
+    }
+  }
+  size_ = 0;
+}
+
+std::optional<chrono::SystemClock::time_point> TimerWheel::NextDeadline()
+    const {
+  if (empty()) {
+    return std::nullopt;
+  }
+  std::optional<uint64_t> next;
+  for (size_t level = 0; level < kNumLevels; ++level) {
+    size_t shift = kBitsPerLevel * level;
+    uint64_t current = now_ >> shift;
+    for (uint64_t i = 1; i <= kSlotsPerLevel; ++i) {
+      if (slot(level, (current + i) & kSlotMask) == nullptr) {
+        continue;
+      }
+      uint64_t start = (current + i) << shift;
+      if (!next.has_value() || start < *next) {
+        next = start;
+      }
+      break;
+    }
+  }
+  return FromTicks(*next);
+}
+
+}  // namespace pw::async2::internal
@@ -0,0 +1,172 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/internal/timer_wheel.h"
+
+#include <array>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "pw_containers/vector.h"
+
+namespace pw::async2::internal {
+namespace {
+
+using ::pw::chrono::SystemClock;
+
+SystemClock::time_point At(int64_t ticks) {
+  return SystemClock::time_point(SystemClock::duration(ticks));
+}
+
+class Timer : public TimerWheelNode {
+ public:
+  int id = 0;
+};
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  void Advance(int64_t ticks) {
+    wheel_.Advance(At(ticks), [this](TimerWheelNode& node) {
+      expired_.push_back(static_cast<Timer&>(node).id);
+    });
+  }
+
+  TimerWheel wheel_;
+  Vector<int, 16> expired_;
+};
+
+TEST_F(TimerWheelTest, EmptyWheelHasNoDeadline) {
+  EXPECT_TRUE(wheel_.empty());
+  EXPECT_FALSE(wheel_.NextDeadline().has_value());
+}
+
+TEST_F(TimerWheelTest, NodesExpireAtTheirDeadlines) {
+  std::array<Timer, 3> timers;
+  const std::array<int64_t, 3> deadlines = {5, 100, 10000};
+  for (size_t i = 0; i < timers.size(); ++i) {
+    timers[i].id = static_cast<int>(i);
+    wheel_.Insert(timers[i], At(deadlines[i]));
+  }
+  EXPECT_EQ(wheel_.size(), 3u);
+
+  Advance(4);
+  EXPECT_TRUE(expired_.empty());
+  Advance(5);
+  ASSERT_EQ(expired_.size(), 1u);
+  EXPECT_EQ(expired_[0], 0);
+  EXPECT_FALSE(timers[0].in_wheel());
+
+  Advance(99);
+  EXPECT_EQ(expired_.size(), 1u);
+  Advance(100);
+  ASSERT_EQ(expired_.size(), 2u);
+  EXPECT_EQ(expired_[1], 1);
+
+  Advance(9999);
+  EXPECT_EQ(expired_.size(), 2u);
+  Advance(10000);
+  ASSERT_EQ(expired_.size(), 3u);
+  EXPECT_EQ(expired_[2], 2);
+  EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTest, LargeJumpExpiresEverythingDue) {
+  std::array<Timer, 4> timers;
+  const std::array<int64_t, 4> deadlines = {1, 70, 5000, 300000};
+  for (size_t i = 0; i < timers.size(); ++i) {
+    wheel_.Insert(timers[i], At(deadlines[i]));
+  }
+  Advance(6000);
+  EXPECT_EQ(expired_.size(), 3u);
+  EXPECT_TRUE(timers[3].in_wheel());
+  Advance(300000);
+  EXPECT_EQ(expired_.size(), 4u);
+}
+
+TEST_F(TimerWheelTest, DeadlineBeyondRangeIsResorted) {
+  constexpr int64_t kFarAway = int64_t{1} << 40;
+  Timer timer;
+  wheel_.Insert(timer, At(kFarAway));
+  Advance(kFarAway - 1);
+  EXPECT_TRUE(expired_.empty());
+  Advance(kFarAway);
+  EXPECT_EQ(expired_.size(), 1u);
+}
+
+TEST_F(TimerWheelTest, RemovedNodesDoNotExpire) {
+  Timer timer1;
+  Timer timer2;
+  timer2.id = 2;
+  wheel_.Insert(timer1, At(10));
+  wheel_.Insert(timer2, At(10));
+  wheel_.Remove(timer1);
+  EXPECT_FALSE(timer1.in_wheel());
+  Advance(20);
+  ASSERT_EQ(expired_.size(), 1u);
+  EXPECT_EQ(expired_[0], 2);
+}
+
+TEST_F(TimerWheelTest, ReplacedNodeExpiresInstead) {
+  Timer old_timer;
+  Timer new_timer;
+  new_timer.id = 1;
+  wheel_.Insert(old_timer, At(10));
+  wheel_.Replace(old_timer, new_timer);
+  EXPECT_FALSE(old_timer.in_wheel());
+  EXPECT_TRUE(new_timer.in_wheel());
+  Advance(10);
+  ASSERT_EQ(expired_.size(), 1u);
+  EXPECT_EQ(expired_[0], 1);
+}
+
+TEST_F(TimerWheelTest, ExpiredDeadlineFiresOnNextAdvance) {
+  Advance(100);
+  Timer timer;
+  wheel_.Insert(timer, At(50));
+  Advance(101);
+  EXPECT_EQ(expired_.size(), 1u);
+}
+
+TEST_F(TimerWheelTest, NextDeadlineIsAtOrBeforeEarliest) {
+  Timer near;
+  wheel_.Insert(near, At(42));
+  ASSERT_TRUE(wheel_.NextDeadline().has_value());
+  EXPECT_EQ(*wheel_.NextDeadline(), At(42));
+
+  Timer far;
+  wheel_.Insert(far, At(10000));
+  EXPECT_EQ(*wheel_.NextDeadline(), At(42));
+
+  wheel_.Remove(near);
+  ASSERT_TRUE(wheel_.NextDeadline().has_value());
+  EXPECT_LE(*wheel_.NextDeadline(), At(10000));
+  EXPECT_GT(*wheel_.NextDeadline(), At(0));
+}
+
+TEST_F(TimerWheelTest, ClearRemovesAllNodes) {
+  std::array<Timer, 3> timers;
+  for (size_t i = 0; i < timers.size(); ++i) {
+    wheel_.Insert(timers[i], At(static_cast<int64_t>(1 + (i * 1000))));
+  }
+  size_t removed = 0;
+  wheel_.Clear([&removed](TimerWheelNode&) { ++removed; });
+  EXPECT_EQ(removed, 3u);
+  EXPECT_TRUE(wheel_.empty());
+  for (const auto& timer : timers) {
+    EXPECT_FALSE(timer.in_wheel());
+  }
+}
+
+}  // namespace
+}  // namespace pw::async2::internal
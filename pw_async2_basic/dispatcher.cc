@@ -53,8 +53,13 @@ void Dispatcher::DoRunToCompletion(Task* task) {
     }
     if (!result.ran_a_task()) {
       SleepInfo sleep_info = AttemptRequestWake();
-      if (sleep_info.should_sleep()) {
+      if (!sleep_info.should_sleep()) {
+        continue;
+      }
+      if (!sleep_info.wake_time().has_value()) {
         notify_.acquire();
+      } else if (!notify_.try_acquire_until(*sleep_info.wake_time())) {
+        CancelRequestWake();
       }
     }
   }
@@ -0,0 +1,198 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <atomic>
+
+#include "pw_async2/atomic_waker.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::async2 {
+namespace {
+
+constexpr size_t kNumWorkers = 4;
+constexpr size_t kNumTasks = 16;
+constexpr int kNumYields = 100;
+
+/// Task which yields to the dispatcher a fixed number of times, and records
+/// whether it was ever ``Pend``'d by two threads at once.
+class YieldingTask : public Task {
+ public:
+  int polled() const { return polled_; }
+  bool overlapped() const { return overlapped_.load(); }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (in_pend_.exchange(true)) {
+      overlapped_.store(true);
+    }
+    ++polled_;
+    bool done = polled_ > kNumYields;
+    if (!done) {
+      cx.ReEnqueue();
+    }
+    in_pend_.store(false);
+    return done ? Poll<>(Ready()) : Poll<>(Pending());
+  }
+
+  std::atomic<bool> in_pend_ = false;
+  std::atomic<bool> overlapped_ = false;
+  int polled_ = 0;
+};
+
+/// Task which waits to be woken once before completing.
+class SleepingTask : public Task {
+ public:
+  bool waiting() const { return waiting_.load(); }
+
+  void Wake() { std::move(waker_).Wake(); }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (waiting_.load()) {
+      return Ready();
+    }
+    waker_ = cx.GetWaker(WaitReason::Unspecified());
+    waiting_.store(true);
+    return Pending();
+  }
+
+  std::atomic<bool> waiting_ = false;
+  Waker waker_;
+};
+
+/// Task which completes once it has observed a number of signals, each
+/// delivered through an ``AtomicWaker``.
+class SignalCountingTask : public Task {
+ public:
+  /// Signals the task. May be called from any thread.
+  void Signal() {
+    signals_.fetch_add(1);
+    waker_.Wake();
+  }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (signals_.load() >= kNumYields) {
+      return Ready();
+    }
+    waker_.Register(cx);
+    // Check again in case a signal arrived before the waker was registered.
+    if (signals_.load() >= kNumYields) {
+      return Ready();
+    }
+    return Pending();
+  }
+
+  std::atomic<int> signals_ = 0;
+  AtomicWaker waker_;
+};
+
+/// Runs a dispatcher to completion on a dedicated thread.
+class Worker {
+ public:
+  void Start(Dispatcher& dispatcher) {
+    thread_ = thread::Thread(
+        context_.options(),
+        [](void* arg) { static_cast<Dispatcher*>(arg)->RunToCompletion(); },
+        &dispatcher);
+  }
+
+  void Join() { thread_.join(); }
+
+ private:
+  thread::Thread thread_;
+  thread::test::TestThreadContext context_;
+};
+
+TEST(DispatcherThreadTest, RunToCompletionFromManyThreadsRunsAllTasks) {
+  Dispatcher dispatcher;
+  std::array<YieldingTask, kNumTasks> tasks;
+  for (auto& task : tasks) {
+    dispatcher.Post(task);
+  }
+
+  std::array<Worker, kNumWorkers> workers;
+  for (auto& worker : workers) {
+    worker.Start(dispatcher);
+  }
+  for (auto& worker : workers) {
+    worker.Join();
+  }
+
+  for (auto& task : tasks) {
+    EXPECT_EQ(task.polled(), kNumYields + 1);
+    EXPECT_FALSE(task.overlapped());
+  }
+}
+
+TEST(DispatcherThreadTest, IdleWorkersWakeForPostedTasks) {
+  Dispatcher dispatcher;
+  SleepingTask sleeper;
+  dispatcher.Post(sleeper);
+
+  std::array<Worker, kNumWorkers> workers;
+  for (auto& worker : workers) {
+    worker.Start(dispatcher);
+  }
+
+  // Once the sleeping task has run, the workers have nothing left to do.
+  while (!sleeper.waiting()) {
+  }
+  YieldingTask task;
+  dispatcher.Post(task);
+  sleeper.Wake();
+  for (auto& worker : workers) {
+    worker.Join();
+  }
+
+  EXPECT_EQ(task.polled(), kNumYields + 1);
+  EXPECT_FALSE(task.overlapped());
+}
+
+TEST(DispatcherThreadTest, AtomicWakerWakesSleepingWorkers) {
+  Dispatcher dispatcher;
+  SignalCountingTask task;
+  dispatcher.Post(task);
+
+  std::array<Worker, kNumWorkers> workers;
+  for (auto& worker : workers) {
+    worker.Start(dispatcher);
+  }
+
+  thread::test::TestThreadContext context;
+  thread::Thread signaler(
+      context.options(),
+      [](void* arg) {
+        for (int i = 0; i < kNumYields; ++i) {
+          static_cast<SignalCountingTask*>(arg)->Signal();
+        }
+      },
+      &task);
+  signaler.join();
+  for (auto& worker : workers) {
+    worker.Join();
+  }
+}
+
+TEST(DispatcherThreadTest, RunToCompletionWithNoTasksReturns) {
+  Dispatcher dispatcher;
+  dispatcher.RunToCompletion();
+}
+
+}  // namespace
+}  // namespace pw::async2
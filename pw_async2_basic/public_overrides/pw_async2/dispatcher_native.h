@@ -14,7 +14,7 @@
 #pragma once
 
 #include "pw_async2/dispatcher_base.h"
-#include "pw_sync/timed_thread_notification.h"
+#include "pw_sync/counting_semaphore.h"
 
 namespace pw::async2 {
 
@@ -46,13 +46,17 @@ class Dispatcher final : public DispatcherImpl<Dispatcher> {
   // Any additional public methods added here (or in another ``Dispatcher``
   // backend) would be backend-specific and should be clearly marked with a
   // ``...Native`` suffix.
+  //
+  // ``RunToCompletion`` may be called from several threads at once, each of
+  // which runs tasks until all posted tasks have completed.
  private:
   void DoWake() final { notify_.release(); }
   Poll<> DoRunUntilStalled(Task* task);
   void DoRunToCompletion(Task* task);
   friend class DispatcherImpl<Dispatcher>;
 
-  pw::sync::TimedThreadNotification notify_;
+  // Released once for each sleeping thread that should wake up.
+  pw::sync::CountingSemaphore notify_;
 };
 
 }  // namespace pw::async2
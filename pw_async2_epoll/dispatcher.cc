@@ -0,0 +1,253 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+#include "pw_assert/check.h"
+#include "pw_async2/dispatcher_native.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_span/span.h"
+
+namespace pw::async2 {
+namespace {
+
+// The maximum number of events handled by each call to ``epoll_wait``.
+constexpr int kMaxEventsPerWait = 16;
+
+// Converts a ``SleepInfo`` wake time to an ``epoll_wait`` timeout, rounding
+// up so that the dispatcher never wakes before the deadline.
+int TimeoutMs(std::optional<chrono::SystemClock::time_point> wake_time) {
+  if (!wake_time.has_value()) {
+    return -1;
+  }
+  chrono::SystemClock::time_point now = chrono::SystemClock::now();
+  if (*wake_time <= now) {
+    return 0;
+  }
+  int64_t ms =
+      std::chrono::ceil<std::chrono::milliseconds>(*wake_time - now).count();
+  return static_cast<int>(
+      std::min<int64_t>(ms, std::numeric_limits<int>::max()));
+}
+
+}  // namespace
+
+Dispatcher::Dispatcher() {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  PW_CHECK_INT_GE(epoll_fd_,
+                  0,
+                  "Failed to create epoll instance: %s",
+                  std::strerror(errno));
+
+  wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+  PW_CHECK_INT_GE(
+      wake_fd_, 0, "Failed to create eventfd: %s", std::strerror(errno));
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = wake_fd_;
+  PW_CHECK_INT_EQ(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event),
+                  0,
+                  "Failed to add eventfd to epoll set: %s",
+                  std::strerror(errno));
+}
+
+Dispatcher::~Dispatcher() {
+  Deregister();
+  {
+    std::lock_guard lock(wakers_lock_);
+    wakers_.clear();
+  }
+  close(wake_fd_);
+  close(epoll_fd_);
+}
+
+Status Dispatcher::NativeRegisterFileDescriptor(int fd,
+                                                FileDescriptorType type) {
+  epoll_event event{};
+  event.events = EPOLLET;
+  if (type != FileDescriptorType::kWritable) {
+    event.events |= EPOLLIN | EPOLLRDHUP;
+  }
+  if (type != FileDescriptorType::kReadable) {
+    event.events |= EPOLLOUT;
+  }
+  event.data.fd = fd;
+
+  std::lock_guard lock(wakers_lock_);
+  if (!wakers_.try_emplace(fd).second) {
+    return Status::AlreadyExists();
+  }
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+    PW_LOG_ERROR("Failed to register fd %d with epoll: %s",
+                 fd,
+                 std::strerror(errno));
+    wakers_.erase(fd);
+    return Status::Internal();
+  }
+  return OkStatus();
+}
+
+Status Dispatcher::NativeUnregisterFileDescriptor(int fd) {
+  std::lock_guard lock(wakers_lock_);
+  if (wakers_.erase(fd) == 0) {
+    return Status::NotFound();
+  }
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr) != 0) {
+    PW_LOG_WARN("Failed to remove fd %d from epoll set: %s",
+                fd,
+                std::strerror(errno));
+  }
+  return OkStatus();
+}
+
+Status Dispatcher::NativeAddReadWakerForFileDescriptor(int fd, Context& cx) {
+  Waker waker = cx.GetWaker(WaitReason::Unspecified());
+  std::lock_guard lock(wakers_lock_);
+  auto it = wakers_.find(fd);
+  if (it == wakers_.end()) {
+    return Status::NotFound();
+  }
+  it->second.read = std::move(waker);
+  return OkStatus();
+}
+
+Status Dispatcher::NativeAddWriteWakerForFileDescriptor(int fd, Context& cx) {
+  Waker waker = cx.GetWaker(WaitReason::Unspecified());
+  std::lock_guard lock(wakers_lock_);
+  auto it = wakers_.find(fd);
+  if (it == wakers_.end()) {
+    return Status::NotFound();
+  }
+  it->second.write = std::move(waker);
+  return OkStatus();
+}
+
+void Dispatcher::DoWake() {
+  const uint64_t value = 1;
+  // The write can only fail if the counter would overflow, in which case the
+  // dispatcher is already guaranteed to wake.
+  static_cast<void>(write(wake_fd_, &value, sizeof(value)));
+}
+
+bool Dispatcher::WaitForEvents(int timeout_ms, bool sleeping) {
+  std::array<epoll_event, kMaxEventsPerWait> events;
+  int count =
+      epoll_wait(epoll_fd_, events.data(), kMaxEventsPerWait, timeout_ms);
+  if (count < 0) {
+    if (errno != EINTR) {
+      PW_LOG_ERROR("epoll_wait failed: %s", std::strerror(errno));
+    }
+    count = 0;
+  }
+
+  // Wakers are moved out of the map so that they can be woken without holding
+  // ``wakers_lock_``.
+  std::array<Waker, kMaxEventsPerWait * 2> to_wake;
+  size_t num_to_wake = 0;
+  bool notified = false;
+  {
+    std::lock_guard lock(wakers_lock_);
+    for (const epoll_event& event :
+         span(events.data(), static_cast<size_t>(count))) {
+      if (event.data.fd == wake_fd_) {
+        uint64_t value;
+        if (sleeping && !notified &&
+            read(wake_fd_, &value, sizeof(value)) == sizeof(value)) {
+          notified = true;
+        }
+        continue;
+      }
+      auto it = wakers_.find(event.data.fd);
+      if (it == wakers_.end()) {
+        // The file descriptor was unregistered by another thread.
+        continue;
+      }
+      constexpr uint32_t kHangUp = EPOLLHUP | EPOLLERR;
+      if ((event.events & (EPOLLIN | EPOLLRDHUP | kHangUp)) != 0) {
+        to_wake[num_to_wake++] = std::move(it->second.read);
+      }
+      if ((event.events & (EPOLLOUT | kHangUp)) != 0) {
+        to_wake[num_to_wake++] = std::move(it->second.write);
+      }
+    }
+  }
+
+  // Give up this thread's wake request before waking tasks, so that the
+  // wakeups below do not spend a ``DoWake`` call on a thread that is already
+  // awake.
+  if (sleeping && !notified) {
+    CancelRequestWake();
+  }
+  for (Waker& waker : span(to_wake.data(), num_to_wake)) {
+    std::move(waker).Wake();
+  }
+  return notified || num_to_wake > 0;
+}
+
+Poll<> Dispatcher::DoRunUntilStalled(Task* task) {
+  {
+    std::lock_guard lock(dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was stalled, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  while (true) {
+    RunOneTaskResult result = RunOneTask(task);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      return Ready();
+    }
+    // Before stalling, check for file descriptors that are already ready.
+    if (!result.ran_a_task() && !WaitForEvents(0, /*sleeping=*/false)) {
+      return Pending();
+    }
+  }
+}
+
+void Dispatcher::DoRunToCompletion(Task* task) {
+  {
+    std::lock_guard lock(dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was complete, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  while (true) {
+    RunOneTaskResult result = RunOneTask(task);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      return;
+    }
+    if (!result.ran_a_task()) {
+      SleepInfo sleep_info = AttemptRequestWake();
+      if (!sleep_info.should_sleep()) {
+        continue;
+      }
+      WaitForEvents(TimeoutMs(sleep_info.wake_time()), /*sleeping=*/true);
+    }
+  }
+}
+
+}  // namespace pw::async2
@@ -0,0 +1,178 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#include "pw_assert/check.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/time_future.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::async2 {
+namespace {
+
+using namespace std::chrono_literals;
+
+/// Non-blocking pipe which is closed on destruction.
+class Pipe {
+ public:
+  Pipe() { PW_CHECK_INT_EQ(pipe2(fds_.data(), O_NONBLOCK | O_CLOEXEC), 0); }
+  ~Pipe() {
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+
+  int read_fd() const { return fds_[0]; }
+  int write_fd() const { return fds_[1]; }
+
+ private:
+  std::array<int, 2> fds_;
+};
+
+/// Task which completes once it has read a byte from a file descriptor.
+class ReadingTask : public Task {
+ public:
+  ReadingTask(Dispatcher& dispatcher, int fd)
+      : dispatcher_(dispatcher), fd_(fd) {}
+
+  int polled = 0;
+  std::byte value{0};
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    ++polled;
+    // The waker must be registered before reading, as readiness is reported
+    // edge-triggered.
+    PW_CHECK_OK(dispatcher_.NativeAddReadWakerForFileDescriptor(fd_, cx));
+    if (read(fd_, &value, 1) != 1) {
+      return Pending();
+    }
+    return Ready();
+  }
+
+  Dispatcher& dispatcher_;
+  int fd_;
+};
+
+/// Task which writes a byte to a file descriptor, optionally after a delay.
+class WritingTask : public Task {
+ public:
+  WritingTask(int fd, chrono::SystemClock::duration delay)
+      : fd_(fd), timer_(TimeFuture::After(delay)) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (timer_.Pend(cx).IsPending()) {
+      return Pending();
+    }
+    const std::byte value{42};
+    PW_CHECK_INT_EQ(write(fd_, &value, 1), 1);
+    return Ready();
+  }
+
+  int fd_;
+  TimeFuture timer_;
+};
+
+TEST(EpollDispatcher, RegisterFileDescriptorTwiceFails) {
+  Dispatcher dispatcher;
+  Pipe pipe;
+  EXPECT_EQ(OkStatus(),
+            dispatcher.NativeRegisterFileDescriptor(
+                pipe.read_fd(), FileDescriptorType::kReadable));
+  EXPECT_EQ(Status::AlreadyExists(),
+            dispatcher.NativeRegisterFileDescriptor(
+                pipe.read_fd(), FileDescriptorType::kReadable));
+  EXPECT_EQ(OkStatus(),
+            dispatcher.NativeUnregisterFileDescriptor(pipe.read_fd()));
+  EXPECT_EQ(Status::NotFound(),
+            dispatcher.NativeUnregisterFileDescriptor(pipe.read_fd()));
+}
+
+TEST(EpollDispatcher, RunUntilStalledWakesReadyFileDescriptors) {
+  Dispatcher dispatcher;
+  Pipe pipe;
+  ASSERT_EQ(OkStatus(),
+            dispatcher.NativeRegisterFileDescriptor(
+                pipe.read_fd(), FileDescriptorType::kReadable));
+
+  ReadingTask task(dispatcher, pipe.read_fd());
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsPending());
+  EXPECT_EQ(task.polled, 1);
+
+  const std::byte value{7};
+  ASSERT_EQ(write(pipe.write_fd(), &value, 1), 1);
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsReady());
+  EXPECT_EQ(task.polled, 2);
+  EXPECT_EQ(task.value, value);
+
+  EXPECT_EQ(OkStatus(),
+            dispatcher.NativeUnregisterFileDescriptor(pipe.read_fd()));
+}
+
+TEST(EpollDispatcher, RunToCompletionSleepsUntilFileDescriptorIsReady) {
+  Dispatcher dispatcher;
+  Pipe pipe;
+  ASSERT_EQ(OkStatus(),
+            dispatcher.NativeRegisterFileDescriptor(
+                pipe.read_fd(), FileDescriptorType::kReadable));
+
+  ReadingTask reader(dispatcher, pipe.read_fd());
+  WritingTask writer(pipe.write_fd(), chrono::SystemClock::for_at_least(5ms));
+  dispatcher.Post(reader);
+  dispatcher.Post(writer);
+  dispatcher.RunToCompletion();
+
+  EXPECT_EQ(reader.polled, 2);
+  EXPECT_EQ(reader.value, std::byte{42});
+
+  EXPECT_EQ(OkStatus(),
+            dispatcher.NativeUnregisterFileDescriptor(pipe.read_fd()));
+}
+
+TEST(EpollDispatcher, AddWakerForUnregisteredFileDescriptorFails) {
+  Dispatcher dispatcher;
+  Pipe pipe;
+
+  class : public Task {
+   public:
+    Dispatcher* dispatcher;
+    int fd;
+    Status read_status;
+    Status write_status;
+
+   private:
+    Poll<> DoPend(Context& cx) override {
+      read_status = dispatcher->NativeAddReadWakerForFileDescriptor(fd, cx);
+      write_status = dispatcher->NativeAddWriteWakerForFileDescriptor(fd, cx);
+      return Ready();
+    }
+  } adding_task;
+  adding_task.dispatcher = &dispatcher;
+  adding_task.fd = pipe.read_fd();
+
+  dispatcher.Post(adding_task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(adding_task.read_status, Status::NotFound());
+  EXPECT_EQ(adding_task.write_status, Status::NotFound());
+}
+
+}  // namespace
+}  // namespace pw::async2
@@ -0,0 +1,130 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <unordered_map>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::async2 {
+
+/// The kinds of readiness a file descriptor registered with the
+/// ``Dispatcher`` reports.
+enum class FileDescriptorType {
+  kReadable,
+  kWritable,
+  kReadWrite,
+};
+
+// Implementor's note:
+//
+// This class defines the "epoll" backend for the ``Dispatcher`` facade.
+//
+// In addition to running tasks, the dispatcher waits on an epoll instance
+// while it has no work to do, so tasks may be woken when file descriptors
+// become readable or writable. ``DoWake`` writes to an eventfd that is part of
+// the same epoll set.
+class Dispatcher final : public DispatcherImpl<Dispatcher> {
+ public:
+  Dispatcher();
+  Dispatcher(Dispatcher&) = delete;
+  Dispatcher(Dispatcher&&) = delete;
+  Dispatcher& operator=(Dispatcher&) = delete;
+  Dispatcher& operator=(Dispatcher&&) = delete;
+  ~Dispatcher() final;
+
+  /// Adds ``fd`` to the set of file descriptors this ``Dispatcher`` waits on.
+  ///
+  /// The file descriptor should be non-blocking. Readiness is reported
+  /// edge-triggered: callers must register a waker with
+  /// ``NativeAddReadWakerForFileDescriptor`` or
+  /// ``NativeAddWriteWakerForFileDescriptor`` *before* attempting an
+  /// operation that may fail with ``EAGAIN``.
+  ///
+  /// * OK - The file descriptor was registered.
+  /// * ALREADY_EXISTS - The file descriptor is already registered.
+  /// * INTERNAL - ``epoll_ctl`` failed.
+  Status NativeRegisterFileDescriptor(int fd, FileDescriptorType type)
+      PW_LOCKS_EXCLUDED(wakers_lock_);
+
+  /// Removes ``fd`` from the set of file descriptors this ``Dispatcher`` waits
+  /// on, dropping any wakers registered for it. This must be called before
+  /// ``fd`` is closed.
+  ///
+  /// * OK - The file descriptor was unregistered.
+  /// * NOT_FOUND - The file descriptor is not registered.
+  Status NativeUnregisterFileDescriptor(int fd)
+      PW_LOCKS_EXCLUDED(wakers_lock_);
+
+  /// Arranges for the task running ``cx`` to be woken the next time ``fd``
+  /// becomes readable, replacing any previously registered read waker.
+  ///
+  /// * OK - The waker was registered.
+  /// * NOT_FOUND - The file descriptor is not registered.
+  Status NativeAddReadWakerForFileDescriptor(int fd, Context& cx)
+      PW_LOCKS_EXCLUDED(wakers_lock_);
+
+  /// Arranges for the task running ``cx`` to be woken the next time ``fd``
+  /// becomes writable, replacing any previously registered write waker.
+  ///
+  /// * OK - The waker was registered.
+  /// * NOT_FOUND - The file descriptor is not registered.
+  Status NativeAddWriteWakerForFileDescriptor(int fd, Context& cx)
+      PW_LOCKS_EXCLUDED(wakers_lock_);
+
+  // NOTE: the remainder of the public interface of ``Dispatcher`` is defined
+  // in ``DispatcherImpl``.
+  //
+  // ``RunToCompletion`` may be called from several threads at once, each of
+  // which waits on the same epoll instance when it has no tasks to run.
+ private:
+  struct FileDescriptorWakers {
+    Waker read;
+    Waker write;
+  };
+
+  void DoWake() final;
+  Poll<> DoRunUntilStalled(Task* task);
+  void DoRunToCompletion(Task* task);
+  friend class DispatcherImpl<Dispatcher>;
+
+  // Waits up to ``timeout_ms`` milliseconds for events and wakes the tasks
+  // waiting on file descriptors that became ready. A negative timeout waits
+  // indefinitely.
+  //
+  // If ``sleeping`` is true, the calling thread has called
+  // ``AttemptRequestWake``; the wake request is either consumed from the
+  // eventfd or cancelled before any tasks are woken.
+  //
+  // Returns whether any tasks may have been woken or the thread was notified
+  // through ``DoWake``.
+  bool WaitForEvents(int timeout_ms, bool sleeping)
+      PW_LOCKS_EXCLUDED(wakers_lock_);
+
+  int epoll_fd_;
+  // eventfd in semaphore mode. Written once for each ``DoWake`` call, and read
+  // once by each thread that is woken.
+  int wake_fd_;
+
+  // Guards the wakers for registered file descriptors. This is acquired
+  // before, and never while holding, ``dispatcher_lock()``.
+  sync::Mutex wakers_lock_;
+  std::unordered_map<int, FileDescriptorWakers> wakers_
+      PW_GUARDED_BY(wakers_lock_);
+};
+
+}  // namespace pw::async2
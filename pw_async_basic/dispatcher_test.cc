@@ -13,6 +13,7 @@
 // the License.
 #include "pw_async_basic/dispatcher.h"
 
+#include <array>
 #include <vector>
 
 #include "pw_chrono/system_clock.h"
@@ -228,4 +229,40 @@ TEST(DispatcherBasic, TasksCancelledByRunFor) {
   ASSERT_EQ(count, 3);
 }
 
+TEST(DispatcherBasic, RepostKeepsEarlierDueTime) {
+  int count = 0;
+  Task task([&count]([[maybe_unused]] Context& c, Status status) {
+    ASSERT_OK(status);
+    ++count;
+  });
+
+  BasicDispatcher dispatcher;
+  dispatcher.PostAfter(task, 1h);
+  dispatcher.Post(task);  // Moves the task earlier.
+  dispatcher.PostAfter(task, 1h);  // Ignored, since the task is due sooner.
+  dispatcher.RunUntilIdle();
+  ASSERT_EQ(count, 1);
+}
+
+TEST(DispatcherBasic, CancelManyTasks) {
+  int count = 0;
+  auto inc_count = [&count]([[maybe_unused]] Context& c, Status status) {
+    ASSERT_OK(status);
+    ++count;
+  };
+  std::array<Task, 32> tasks;
+
+  BasicDispatcher dispatcher;
+  for (Task& task : tasks) {
+    task.set_function(inc_count);
+    dispatcher.Post(task);
+  }
+  for (size_t i = 0; i < tasks.size(); i += 2) {
+    ASSERT_TRUE(dispatcher.Cancel(tasks[i]));
+    ASSERT_FALSE(dispatcher.Cancel(tasks[i]));
+  }
+  dispatcher.RunUntilIdle();
+  ASSERT_EQ(count, 16);
+}
+
 }  // namespace pw::async
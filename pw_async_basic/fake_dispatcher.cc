@@ -65,7 +65,7 @@ bool NativeFakeDispatcher::ExecuteDueTasks() {
   while (!task_queue_.empty() && task_queue_.front().due_time() <= now() &&
          !stop_requested_) {
     ::pw::async::backend::NativeTask& task = task_queue_.front();
-    task_queue_.pop_front();
+    task_queue_.Pop();
 
     Context ctx{&dispatcher_, &task.task_};
     task(ctx, OkStatus());
@@ -84,7 +84,7 @@ bool NativeFakeDispatcher::DrainTaskQueue() {
   bool task_ran = false;
   while (!task_queue_.empty()) {
     ::pw::async::backend::NativeTask& task = task_queue_.front();
-    task_queue_.pop_front();
+    task_queue_.Pop();
 
     PW_LOG_DEBUG("running cancelled task");
     Context ctx{&dispatcher_, &task.task_};
@@ -109,29 +109,21 @@ void NativeFakeDispatcher::PostAt(Task& task,
 }
 
 bool NativeFakeDispatcher::Cancel(Task& task) {
-  return task_queue_.remove(task.native_type());
+  return task_queue_.Remove(task.native_type());
 }
 
 void NativeFakeDispatcher::PostTaskInternal(
     ::pw::async::backend::NativeTask& task,
     chrono::SystemClock::time_point time_due) {
-  if (!task.unlisted()) {
+  if (task_queue_.contains(task)) {
     if (task.due_time() <= time_due) {
       // No need to repost a task that was already queued to run.
       return;
     }
-    // The task needs its time updated, so we have to move it to
-    // a different part of the list.
-    task.unlist();
+    // The task needs its time updated, so it is queued again.
+    task_queue_.Remove(task);
   }
-  task.set_due_time(time_due);
-  auto it_front = task_queue_.begin();
-  auto it_behind = task_queue_.before_begin();
-  while (it_front != task_queue_.end() && time_due >= it_front->due_time()) {
-    ++it_front;
-    ++it_behind;
-  }
-  task_queue_.insert_after(it_behind, task);
+  task_queue_.Push(task, time_due);
 }
 
 }  // namespace pw::async::test::backend
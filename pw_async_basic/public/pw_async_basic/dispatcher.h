@@ -15,6 +15,7 @@
 
 #include "pw_async/dispatcher.h"
 #include "pw_async/task.h"
+#include "pw_async_basic/internal/task_queue.h"
 #include "pw_sync/interrupt_spin_lock.h"
 #include "pw_sync/lock_annotations.h"
 #include "pw_sync/timed_thread_notification.h"
@@ -23,6 +24,11 @@
 namespace pw::async {
 
 /// BasicDispatcher is a generic implementation of Dispatcher.
+///
+/// Posted tasks are kept in a pairing heap ordered by due time, with tasks due
+/// at the same time run in the order they were posted. Posting a task is O(1),
+/// and running or canceling one is amortized O(log n), so large numbers of
+/// timeouts can be posted and canceled cheaply.
 class BasicDispatcher final : public Dispatcher, public thread::ThreadCore {
  public:
   explicit BasicDispatcher() = default;
@@ -62,8 +68,8 @@ class BasicDispatcher final : public Dispatcher, public thread::ThreadCore {
   }
 
  private:
-  // Insert |task| into task_queue_ maintaining its min-heap property, keyed by
-  // |time_due|.
+  // Insert |task| into task_queue_, keyed by |time_due|. If |task| is already
+  // queued, it keeps the earlier of its due times.
   void PostTaskInternal(backend::NativeTask& task,
                         chrono::SystemClock::time_point time_due)
       PW_LOCKS_EXCLUDED(lock_);
@@ -83,7 +89,7 @@ class BasicDispatcher final : public Dispatcher, public thread::ThreadCore {
   sync::TimedThreadNotification timed_notification_;
   bool stop_requested_ PW_GUARDED_BY(lock_) = false;
   // A priority queue of scheduled Tasks sorted by earliest due times first.
-  IntrusiveList<backend::NativeTask> task_queue_ PW_GUARDED_BY(lock_);
+  internal::TaskQueue task_queue_ PW_GUARDED_BY(lock_);
 };
 
 }  // namespace pw::async
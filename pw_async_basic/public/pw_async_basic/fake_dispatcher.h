@@ -15,7 +15,7 @@
 
 #include "pw_async/dispatcher.h"
 #include "pw_async/task.h"
-#include "pw_containers/intrusive_list.h"
+#include "pw_async_basic/internal/task_queue.h"
 
 namespace pw::async::test::backend {
 
@@ -43,8 +43,8 @@ class NativeFakeDispatcher final {
   chrono::SystemClock::time_point now() { return now_; }
 
  private:
-  // Insert |task| into task_queue_ maintaining its min-heap property, keyed by
-  // |time_due|.
+  // Insert |task| into task_queue_, keyed by |time_due|. If |task| is already
+  // queued, it keeps the earlier of its due times.
   void PostTaskInternal(::pw::async::backend::NativeTask& task,
                         chrono::SystemClock::time_point time_due);
 
@@ -61,7 +61,7 @@ class NativeFakeDispatcher final {
   bool stop_requested_ = false;
 
   // A priority queue of scheduled tasks sorted by earliest due times first.
-  IntrusiveList<::pw::async::backend::NativeTask> task_queue_;
+  ::pw::async::internal::TaskQueue task_queue_;
 
   // Tracks the current time as viewed by the test dispatcher.
   chrono::SystemClock::time_point now_;
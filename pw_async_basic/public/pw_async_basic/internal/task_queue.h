@@ -0,0 +1,82 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+
+namespace pw::async::backend {
+class NativeTask;
+}  // namespace pw::async::backend
+
+namespace pw::async::internal {
+
+// Queue of tasks ordered by due time, used by the pw_async_basic dispatchers.
+// Tasks with the same due time are dequeued in the order they were pushed.
+//
+// The queue is an intrusive pairing heap: each task stores its own links, so
+// the queue never allocates. Push is O(1), and Pop and Remove are amortized
+// O(log n). This keeps dispatchers fast when many timeouts are posted and
+// canceled, unlike a sorted list, which takes O(n) to insert or remove.
+//
+// TaskQueue is not thread safe; dispatchers guard it with their own lock.
+class TaskQueue {
+ public:
+  constexpr TaskQueue() = default;
+
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+
+  bool empty() const { return root_ == nullptr; }
+
+  // Returns the task that is due first. The queue must not be empty.
+  backend::NativeTask& front() const { return *root_; }
+
+  // Returns true if the task is in this queue.
+  bool contains(const backend::NativeTask& task) const;
+
+  // Adds a task that is not in any queue, to be due at `due_time`.
+  void Push(backend::NativeTask& task,
+            chrono::SystemClock::time_point due_time);
+
+  // Removes the task that is due first. The queue must not be empty.
+  void Pop();
+
+  // Removes a task from the queue. Returns false if it is not in the queue.
+  bool Remove(backend::NativeTask& task);
+
+ private:
+  // Returns true if `lhs` is due before `rhs`.
+  static bool DueBefore(const backend::NativeTask& lhs,
+                        const backend::NativeTask& rhs);
+
+  // Combines two heaps, returning the new root. Both must be roots with no
+  // siblings.
+  static backend::NativeTask* Meld(backend::NativeTask* lhs,
+                                   backend::NativeTask* rhs);
+
+  // Combines a list of sibling heaps into one heap with the standard two-pass
+  // pairing, returning the new root.
+  static backend::NativeTask* MergePairs(backend::NativeTask* first);
+
+  backend::NativeTask* root_ = nullptr;
+
+  // Counts pushes to order tasks with the same due time. Comparisons handle
+  // wrapping, so only the order of tasks pushed within 2^31 pushes of each
+  // other matters.
+  uint32_t next_sequence_ = 0;
+};
+
+}  // namespace pw::async::internal
@@ -13,10 +13,12 @@
 // the License.
 #pragma once
 
+#include <cstdint>
+
 #include "pw_async/context.h"
 #include "pw_async/task_function.h"
+#include "pw_async_basic/internal/task_queue.h"
 #include "pw_chrono/system_clock.h"
-#include "pw_containers/intrusive_list.h"
 
 namespace pw::async {
 class BasicDispatcher;
@@ -28,10 +30,11 @@ class NativeFakeDispatcher;
 namespace pw::async::backend {
 
 // Task backend for BasicDispatcher.
-class NativeTask final : public IntrusiveList<NativeTask>::Item {
+class NativeTask final {
  private:
   friend class ::pw::async::Task;
   friend class ::pw::async::BasicDispatcher;
+  friend class ::pw::async::internal::TaskQueue;
   friend class ::pw::async::test::backend::NativeFakeDispatcher;
 
   NativeTask(::pw::async::Task& task) : task_(task) {}
@@ -41,9 +44,6 @@ class NativeTask final : public IntrusiveList<NativeTask>::Item {
   void set_function(TaskFunction&& f) { func_ = std::move(f); }
 
   pw::chrono::SystemClock::time_point due_time() const { return due_time_; }
-  void set_due_time(chrono::SystemClock::time_point due_time) {
-    due_time_ = due_time;
-  }
 
   TaskFunction func_ = nullptr;
   // task_ is placed after func_ to take advantage of the padding that would
@@ -52,6 +52,14 @@ class NativeTask final : public IntrusiveList<NativeTask>::Item {
   // padding would be added here, which is just enough for a pointer.
   Task& task_;
   pw::chrono::SystemClock::time_point due_time_;
+
+  // Links for the dispatcher's TaskQueue, a pairing heap. heap_prev_ points to
+  // the left sibling, or to the parent for a first child.
+  NativeTask* heap_child_ = nullptr;
+  NativeTask* heap_next_ = nullptr;
+  NativeTask* heap_prev_ = nullptr;
+  const internal::TaskQueue* queue_ = nullptr;  // The queue holding this task.
+  uint32_t sequence_ = 0;  // Orders tasks with the same due_time_.
 };
 
 using NativeTaskHandle = NativeTask&;
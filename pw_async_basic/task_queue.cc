@@ -0,0 +1,140 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async_basic/internal/task_queue.h"
+
+#include "pw_assert/check.h"
+#include "pw_async_basic/task.h"
+
+namespace pw::async::internal {
+
+using backend::NativeTask;
+
+bool TaskQueue::contains(const NativeTask& task) const {
+  return task.queue_ == this;
+}
+
+void TaskQueue::Push(NativeTask& task,
+                     chrono::SystemClock::time_point due_time) {
+  PW_DCHECK(task.queue_ == nullptr, "Task is already queued");
+  task.due_time_ = due_time;
+  task.sequence_ = next_sequence_++;
+  task.queue_ = this;
+  root_ = root_ == nullptr ? &task : Meld(root_, &task);
+}
+
+void TaskQueue::Pop() {
+  NativeTask& task = *root_;
+  root_ = MergePairs(task.heap_child_);
+  task.heap_child_ = nullptr;
+  task.queue_ = nullptr;
+}
+
+bool TaskQueue::Remove(NativeTask& task) {
+  if (!contains(task)) {
+    return false;
+  }
+  if (&task == root_) {
+    Pop();
+    return true;
+  }
+
+  // Cut the task's subtree out of its parent's list of children. A first child
+  // links back to its parent; other children link back to their left sibling.
+  NativeTask& prev = *task.heap_prev_;
+  if (prev.heap_child_ == &task) {
+    prev.heap_child_ = task.heap_next_;
+  } else {
+    prev.heap_next_ = task.heap_next_;
+  }
+  if (task.heap_next_ != nullptr) {
+    task.heap_next_->heap_prev_ = &prev;
+  }
+
+  // The task's children keep the heap order among themselves, so merge them
+  // back in as one heap.
+  NativeTask* children = MergePairs(task.heap_child_);
+  if (children != nullptr) {
+    root_ = Meld(root_, children);
+  }
+
+  task.heap_child_ = nullptr;
+  task.heap_next_ = nullptr;
+  task.heap_prev_ = nullptr;
+  task.queue_ = nullptr;
+  return true;
+}
+
+bool TaskQueue::DueBefore(const NativeTask& lhs, const NativeTask& rhs) {
+  if (lhs.due_time_ != rhs.due_time_) {
+    return lhs.due_time_ < rhs.due_time_;
+  }
+  return static_cast<int32_t>(lhs.sequence_ - rhs.sequence_) < 0;
+}
+
+NativeTask* TaskQueue::Meld(NativeTask* lhs, NativeTask* rhs) {
+  if (DueBefore(*rhs, *lhs)) {
+    NativeTask* swap = lhs;
+    lhs = rhs;
+    rhs = swap;
+  }
+  // Make rhs the first child of lhs.
+  rhs->heap_prev_ = lhs;
+  rhs->heap_next_ = lhs->heap_child_;
+  if (rhs->heap_next_ != nullptr) {
+    rhs->heap_next_->heap_prev_ = rhs;
+  }
+  lhs->heap_child_ = rhs;
+  return lhs;
+}
+
+NativeTask* TaskQueue::MergePairs(NativeTask* first) {
+  if (first == nullptr) {
+    return nullptr;
+  }
+
+  // First pass: meld siblings in pairs from left to right. The results are
+  // kept in a stack, linked through heap_next_, so the last pair is on top.
+  NativeTask* stack = nullptr;
+  while (first != nullptr) {
+    NativeTask* lhs = first;
+    NativeTask* rhs = lhs->heap_next_;
+    first = rhs == nullptr ? nullptr : rhs->heap_next_;
+
+    lhs->heap_next_ = nullptr;
+    lhs->heap_prev_ = nullptr;
+    NativeTask* merged = lhs;
+    if (rhs != nullptr) {
+      rhs->heap_next_ = nullptr;
+      rhs->heap_prev_ = nullptr;
+      merged = Meld(lhs, rhs);
+    }
+    merged->heap_next_ = stack;
+    stack = merged;
+  }
+
+  // Second pass: meld the pairs from right to left into a single heap.
+  NativeTask* root = stack;
+  stack = stack->heap_next_;
+  root->heap_next_ = nullptr;
+  while (stack != nullptr) {
+    NativeTask* next = stack;
+    stack = next->heap_next_;
+    next->heap_next_ = nullptr;
+    root = Meld(root, next);
+  }
+  return root;
+}
+
+}  // namespace pw::async::internal
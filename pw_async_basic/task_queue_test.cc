@@ -0,0 +1,191 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async_basic/internal/task_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "pw_async/task.h"
+#include "pw_unit_test/framework.h"
+
+using namespace std::chrono_literals;
+
+namespace pw::async::internal {
+namespace {
+
+using chrono::SystemClock;
+
+constexpr SystemClock::time_point kStart{};
+
+TEST(TaskQueue, StartsEmpty) {
+  TaskQueue queue;
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TaskQueue, PopsInDueTimeOrder) {
+  TaskQueue queue;
+  std::array<Task, 4> tasks;
+  queue.Push(tasks[0].native_type(), kStart + 3s);
+  queue.Push(tasks[1].native_type(), kStart + 1s);
+  queue.Push(tasks[2].native_type(), kStart + 4s);
+  queue.Push(tasks[3].native_type(), kStart + 2s);
+
+  for (size_t index : {1, 3, 0, 2}) {
+    ASSERT_FALSE(queue.empty());
+    EXPECT_EQ(&queue.front(), &tasks[index].native_type());
+    queue.Pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TaskQueue, SameDueTimeIsFifo) {
+  TaskQueue queue;
+  std::array<Task, 5> tasks;
+  for (Task& task : tasks) {
+    queue.Push(task.native_type(), kStart + 1s);
+  }
+
+  for (Task& task : tasks) {
+    ASSERT_FALSE(queue.empty());
+    EXPECT_EQ(&queue.front(), &task.native_type());
+    queue.Pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TaskQueue, Remove) {
+  TaskQueue queue;
+  std::array<Task, 5> tasks;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    queue.Push(tasks[i].native_type(), kStart + std::chrono::seconds(i));
+  }
+
+  EXPECT_TRUE(queue.Remove(tasks[0].native_type()));  // The front task
+  EXPECT_TRUE(queue.Remove(tasks[3].native_type()));
+  EXPECT_FALSE(queue.Remove(tasks[3].native_type()));
+  EXPECT_FALSE(queue.contains(tasks[3].native_type()));
+  EXPECT_TRUE(queue.contains(tasks[2].native_type()));
+
+  for (size_t index : {1, 2, 4}) {
+    ASSERT_FALSE(queue.empty());
+    EXPECT_EQ(&queue.front(), &tasks[index].native_type());
+    queue.Pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TaskQueue, RemoveFromOtherQueueFails) {
+  TaskQueue queue;
+  TaskQueue other;
+  Task task;
+  EXPECT_FALSE(queue.Remove(task.native_type()));
+
+  other.Push(task.native_type(), kStart);
+  EXPECT_FALSE(queue.Remove(task.native_type()));
+  EXPECT_TRUE(other.Remove(task.native_type()));
+  EXPECT_TRUE(other.empty());
+}
+
+TEST(TaskQueue, RequeueAfterRemove) {
+  TaskQueue queue;
+  Task early;
+  Task late;
+  queue.Push(early.native_type(), kStart + 1s);
+  queue.Push(late.native_type(), kStart + 2s);
+
+  ASSERT_TRUE(queue.Remove(early.native_type()));
+  queue.Push(early.native_type(), kStart + 3s);
+
+  EXPECT_EQ(&queue.front(), &late.native_type());
+  queue.Pop();
+  EXPECT_EQ(&queue.front(), &early.native_type());
+  queue.Pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+// Compares the queue against a sorted list while randomly posting, popping,
+// and removing tasks, with many tasks sharing due times.
+TEST(TaskQueue, MatchesSortedOrder) {
+  constexpr size_t kTasks = 64;
+  std::array<Task, kTasks> tasks;
+  TaskQueue queue;
+
+  struct Expected {
+    SystemClock::time_point due_time;
+    uint32_t order;
+    size_t index;
+  };
+  std::vector<Expected> expected;
+  uint32_t next_order = 0;
+
+  uint32_t random = 12345;
+  auto next_random = [&random]() {
+    random = random * 1103515245u + 12345u;
+    return random >> 16;
+  };
+
+  for (int step = 0; step < 5000; ++step) {
+    const size_t index = next_random() % kTasks;
+    const bool queued = queue.contains(tasks[index].native_type());
+    const auto by_index = [index](const Expected& e) {
+      return e.index == index;
+    };
+
+    switch (next_random() % 3) {
+      case 0:  // Post or remove a random task.
+        if (queued) {
+          ASSERT_TRUE(queue.Remove(tasks[index].native_type()));
+          expected.erase(
+              std::find_if(expected.begin(), expected.end(), by_index));
+        } else {
+          const auto due_time =
+              kStart + std::chrono::milliseconds(next_random() % 8);
+          queue.Push(tasks[index].native_type(), due_time);
+          expected.push_back({due_time, next_order++, index});
+        }
+        break;
+      case 1:  // Post a random task.
+        if (!queued) {
+          const auto due_time =
+              kStart + std::chrono::milliseconds(next_random() % 8);
+          queue.Push(tasks[index].native_type(), due_time);
+          expected.push_back({due_time, next_order++, index});
+        }
+        break;
+      case 2:  // Pop the front task.
+        if (!expected.empty()) {
+          const auto first = std::min_element(
+              expected.begin(),
+              expected.end(),
+              [](const Expected& lhs, const Expected& rhs) {
+                return lhs.due_time != rhs.due_time
+                           ? lhs.due_time < rhs.due_time
+                           : lhs.order < rhs.order;
+              });
+          ASSERT_FALSE(queue.empty());
+          ASSERT_EQ(&queue.front(), &tasks[first->index].native_type());
+          queue.Pop();
+          expected.erase(first);
+        }
+        break;
+    }
+    ASSERT_EQ(queue.empty(), expected.empty());
+  }
+}
+
+}  // namespace
+}  // namespace pw::async::internal
@@ -15,9 +15,38 @@
 #include "pw_base64/base64.h"
 
 #include <cstdint>
+#include <cstring>
 
 #include "pw_assert/check.h"
 
+// Host builds for x86 CPUs encode and decode with SIMD instructions: 24 bytes
+// at a time with AVX2, and 12 bytes at a time with SSSE3. Other targets,
+// including MCUs, use the scalar implementation, which has no lookup tables
+// beyond the ones below. Each instruction set is used by default when the
+// compiler targets it (e.g. with -mavx2, -mssse3 or -march=native). Define
+// PW_BASE64_USE_AVX2 or PW_BASE64_USE_SSSE3 to 0 or 1 to override the default.
+#ifndef PW_BASE64_USE_AVX2
+#ifdef __AVX2__
+#define PW_BASE64_USE_AVX2 1
+#else
+#define PW_BASE64_USE_AVX2 0
+#endif
+#endif  // PW_BASE64_USE_AVX2
+
+#ifndef PW_BASE64_USE_SSSE3
+#ifdef __SSSE3__
+#define PW_BASE64_USE_SSSE3 1
+#else
+#define PW_BASE64_USE_SSSE3 0
+#endif
+#endif  // PW_BASE64_USE_SSSE3
+
+#if PW_BASE64_USE_AVX2
+#include <immintrin.h>
+#elif PW_BASE64_USE_SSSE3
+#include <tmmintrin.h>
+#endif  // PW_BASE64_USE_AVX2
+
 namespace pw::base64 {
 namespace {
 
@@ -84,6 +113,234 @@ constexpr uint8_t Byte2(uint8_t bits2, uint8_t bits3) {
   return static_cast<uint8_t>((bits2 & 0b000011) << 6) | bits3;
 }
 
+#if PW_BASE64_USE_SSSE3 || PW_BASE64_USE_AVX2
+
+// SIMD encoding and decoding, based on the algorithms described by Wojciech
+// Muła and Daniel Lemire in "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions" (https://arxiv.org/abs/1704.00605). The AVX2 functions apply
+// the same steps as the SSSE3 ones to each 128-bit lane.
+
+// Number of source bytes and characters handled by each 128-bit SIMD step.
+constexpr size_t kSimdBinaryBytes = 12;
+constexpr size_t kSimdEncodedChars = 16;
+
+// Byte offsets that convert the 6-bit values to characters, indexed as
+// described in EncodeSimd().
+alignas(16) constexpr int8_t kSimdEncodeOffsets[16] = {
+    'a' - 26,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    '0' - 52,
+    kChar62 - 62,
+    kChar63 - 63,
+    'A',
+    0,
+    0,
+};
+
+#endif  // PW_BASE64_USE_SSSE3 || PW_BASE64_USE_AVX2
+
+#if PW_BASE64_USE_SSSE3
+
+// Encodes 12 bytes as 16 characters. The 16 bytes from `bytes` must be
+// readable, but only the first 12 are encoded.
+inline void EncodeSimd(const uint8_t* bytes, char* output) {
+  __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+
+  // Arrange each group of 3 bytes (a, b, c) as the 32-bit word b, a, c, b, then
+  // shift each of the 4 bit groups into its own byte.
+  in = _mm_shuffle_epi8(
+      in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m128i bit_groups_0_2 =
+      _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)),
+                      _mm_set1_epi32(0x04000040));
+  const __m128i bit_groups_1_3 =
+      _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)),
+                      _mm_set1_epi32(0x01000010));
+  const __m128i bits = _mm_or_si128(bit_groups_0_2, bit_groups_1_3);
+
+  // Map each 6-bit value to the index of the offset that converts it to its
+  // character: 13 for A-Z, 0 for a-z, 1-10 for 0-9, 11 for + and 12 for /.
+  __m128i offset_index = _mm_subs_epu8(bits, _mm_set1_epi8(51));
+  const __m128i is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), bits);
+  offset_index =
+      _mm_or_si128(offset_index, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+
+  const __m128i offsets =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kSimdEncodeOffsets));
+  const __m128i chars =
+      _mm_add_epi8(_mm_shuffle_epi8(offsets, offset_index), bits);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(output), chars);
+}
+
+// Returns a mask of the characters between `min` and `max`, inclusive.
+inline __m128i InRange(__m128i chars, char min, char max) {
+  return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(min - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(max + 1), chars));
+}
+
+// Decodes 16 characters from either alphabet, without padding, as 12 bytes.
+// Returns false without writing anything if any of the characters is not a
+// valid Base64 character other than padding.
+inline bool DecodeSimd(const char* base64, uint8_t* output) {
+  const __m128i chars =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(base64));
+
+  const __m128i upper = InRange(chars, 'A', 'Z');
+  const __m128i lower = InRange(chars, 'a', 'z');
+  const __m128i digit = InRange(chars, '0', '9');
+  const __m128i char_62 =
+      _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('+')),
+                   _mm_cmpeq_epi8(chars, _mm_set1_epi8('-')));
+  const __m128i char_63 =
+      _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('/')),
+                   _mm_cmpeq_epi8(chars, _mm_set1_epi8('_')));
+
+  const __m128i alphanumeric = _mm_or_si128(_mm_or_si128(upper, lower), digit);
+  const __m128i valid =
+      _mm_or_si128(alphanumeric, _mm_or_si128(char_62, char_63));
+  if (_mm_movemask_epi8(valid) != 0xffff) {
+    return false;
+  }
+
+  const __m128i shift = _mm_or_si128(
+      _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                   _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+      _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+  __m128i bits = _mm_and_si128(_mm_add_epi8(chars, shift), alphanumeric);
+  bits = _mm_or_si128(bits, _mm_and_si128(char_62, _mm_set1_epi8(62)));
+  bits = _mm_or_si128(bits, _mm_and_si128(char_63, _mm_set1_epi8(63)));
+
+  // Combine the 6-bit values into 12-bit and then 24-bit values, and pack the
+  // 3 bytes of each into the output in big-endian order.
+  const __m128i pairs = _mm_maddubs_epi16(bits, _mm_set1_epi32(0x01400140));
+  const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  const __m128i bytes = _mm_shuffle_epi8(
+      groups,
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  alignas(16) uint8_t decoded[16];
+  _mm_store_si128(reinterpret_cast<__m128i*>(decoded), bytes);
+  std::memcpy(output, decoded, kSimdBinaryBytes);
+  return true;
+}
+
+#endif  // PW_BASE64_USE_SSSE3
+
+#if PW_BASE64_USE_AVX2
+
+// Number of source bytes and characters handled by each AVX2 step.
+constexpr size_t kAvx2BinaryBytes = 2 * kSimdBinaryBytes;
+constexpr size_t kAvx2EncodedChars = 2 * kSimdEncodedChars;
+
+// Bytes read by each AVX2 encoding step: 16 bytes for each 128-bit lane, with
+// the second lane starting 12 bytes in.
+constexpr size_t kAvx2EncodeReadBytes = kSimdBinaryBytes + sizeof(__m128i);
+
+// Encodes 24 bytes as 32 characters. The 28 bytes from `bytes` must be
+// readable, but only the first 24 are encoded.
+inline void EncodeAvx2(const uint8_t* bytes, char* output) {
+  // Load 12 bytes into the low half of each 128-bit lane.
+  __m256i in = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))),
+      _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(bytes + kSimdBinaryBytes)),
+      1);
+
+  in = _mm256_shuffle_epi8(
+      in,
+      _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                       1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m256i bit_groups_0_2 =
+      _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+                         _mm256_set1_epi32(0x04000040));
+  const __m256i bit_groups_1_3 =
+      _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+                         _mm256_set1_epi32(0x01000010));
+  const __m256i bits = _mm256_or_si256(bit_groups_0_2, bit_groups_1_3);
+
+  __m256i offset_index = _mm256_subs_epu8(bits, _mm256_set1_epi8(51));
+  const __m256i is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), bits);
+  offset_index = _mm256_or_si256(
+      offset_index, _mm256_and_si256(is_upper, _mm256_set1_epi8(13)));
+
+  const __m256i offsets = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kSimdEncodeOffsets)));
+  const __m256i chars =
+      _mm256_add_epi8(_mm256_shuffle_epi8(offsets, offset_index), bits);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), chars);
+}
+
+// Returns a mask of the characters between `min` and `max`, inclusive.
+inline __m256i InRangeAvx2(__m256i chars, char min, char max) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8(min - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(max + 1), chars));
+}
+
+// Decodes 32 characters from either alphabet, without padding, as 24 bytes.
+// Returns false without writing anything if any of the characters is not a
+// valid Base64 character other than padding.
+inline bool DecodeAvx2(const char* base64, uint8_t* output) {
+  const __m256i chars =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base64));
+
+  const __m256i upper = InRangeAvx2(chars, 'A', 'Z');
+  const __m256i lower = InRangeAvx2(chars, 'a', 'z');
+  const __m256i digit = InRangeAvx2(chars, '0', '9');
+  const __m256i char_62 =
+      _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('+')),
+                      _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('-')));
+  const __m256i char_63 =
+      _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('/')),
+                      _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_')));
+
+  const __m256i alphanumeric =
+      _mm256_or_si256(_mm256_or_si256(upper, lower), digit);
+  const __m256i valid =
+      _mm256_or_si256(alphanumeric, _mm256_or_si256(char_62, char_63));
+  if (_mm256_movemask_epi8(valid) != -1) {
+    return false;
+  }
+
+  const __m256i shift = _mm256_or_si256(
+      _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')),
+                      _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+      _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+  __m256i bits =
+      _mm256_and_si256(_mm256_add_epi8(chars, shift), alphanumeric);
+  bits = _mm256_or_si256(bits, _mm256_and_si256(char_62, _mm256_set1_epi8(62)));
+  bits = _mm256_or_si256(bits, _mm256_and_si256(char_63, _mm256_set1_epi8(63)));
+
+  const __m256i pairs =
+      _mm256_maddubs_epi16(bits, _mm256_set1_epi32(0x01400140));
+  const __m256i groups =
+      _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+  const __m256i lane_bytes = _mm256_shuffle_epi8(
+      groups,
+      _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                       2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  // Each lane now holds 12 decoded bytes followed by 4 unused ones. Move the
+  // second lane's bytes next to the first's.
+  const __m256i bytes = _mm256_permutevar8x32_epi32(
+      lane_bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+  alignas(32) uint8_t decoded[32];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(decoded), bytes);
+  std::memcpy(output, decoded, kAvx2BinaryBytes);
+  return true;
+}
+
+#endif  // PW_BASE64_USE_AVX2
+
 }  // namespace
 
 extern "C" void pw_Base64Encode(const void* binary_data,
@@ -91,8 +348,24 @@ extern "C" void pw_Base64Encode(const void* binary_data,
                                 char* output) {
   const uint8_t* bytes = static_cast<const uint8_t*>(binary_data);
 
-  // Encode groups of 3 source bytes into 4 output characters.
   size_t remaining = binary_size_bytes;
+#if PW_BASE64_USE_AVX2
+  for (; remaining >= kAvx2EncodeReadBytes; remaining -= kAvx2BinaryBytes) {
+    EncodeAvx2(bytes, output);
+    bytes += kAvx2BinaryBytes;
+    output += kAvx2EncodedChars;
+  }
+#endif  // PW_BASE64_USE_AVX2
+#if PW_BASE64_USE_SSSE3
+  // Each step loads 16 bytes, so stop while there are at least that many left.
+  for (; remaining >= sizeof(__m128i); remaining -= kSimdBinaryBytes) {
+    EncodeSimd(bytes, output);
+    bytes += kSimdBinaryBytes;
+    output += kSimdEncodedChars;
+  }
+#endif  // PW_BASE64_USE_SSSE3
+
+  // Encode groups of 3 source bytes into 4 output characters.
   for (; remaining >= 3u; remaining -= 3u, bytes += 3) {
     *output++ = BitGroup0Char(bytes[0]);
     *output++ = BitGroup1Char(bytes[0], bytes[1]);
@@ -124,7 +397,28 @@ extern "C" size_t pw_Base64Decode(const char* base64,
   }
 
   uint8_t* binary = static_cast<uint8_t*>(output);
-  for (size_t ch = 0; ch < base64_size_bytes; ch += kEncodedGroupSize) {
+  size_t ch = 0;
+  // Padding and invalid characters are left for the scalar loop.
+#if PW_BASE64_USE_AVX2
+  for (; ch + kAvx2EncodedChars <= base64_size_bytes;
+       ch += kAvx2EncodedChars) {
+    if (!DecodeAvx2(&base64[ch], binary)) {
+      break;
+    }
+    binary += kAvx2BinaryBytes;
+  }
+#endif  // PW_BASE64_USE_AVX2
+#if PW_BASE64_USE_SSSE3
+  for (; ch + kSimdEncodedChars <= base64_size_bytes;
+       ch += kSimdEncodedChars) {
+    if (!DecodeSimd(&base64[ch], binary)) {
+      break;
+    }
+    binary += kSimdBinaryBytes;
+  }
+#endif  // PW_BASE64_USE_SSSE3
+
+  for (; ch < base64_size_bytes; ch += kEncodedGroupSize) {
     const uint8_t char0 = CharToBits(base64[ch + 0]);
     const uint8_t char1 = CharToBits(base64[ch + 1]);
     const uint8_t char2 = CharToBits(base64[ch + 2]);
@@ -0,0 +1,66 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "pw_base64/base64.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+
+namespace pw::base64 {
+namespace {
+
+// Roughly the size of a tokenized log message, and of a larger blob.
+constexpr size_t kSmallSize = 24;
+constexpr size_t kLargeSize = 1024;
+
+template <size_t kSize>
+std::array<std::byte, kSize> Data() {
+  std::array<std::byte, kSize> data;
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(i * 37);
+  }
+  return data;
+}
+
+template <size_t kSize>
+void EncodeTest(perf_test::State& state) {
+  const std::array<std::byte, kSize> data = Data<kSize>();
+  std::array<char, EncodedSize(kSize)> encoded;
+  while (state.KeepRunning()) {
+    Encode(data, encoded.data());
+  }
+}
+
+template <size_t kSize>
+void DecodeTest(perf_test::State& state) {
+  const std::array<std::byte, kSize> data = Data<kSize>();
+  std::array<char, EncodedSize(kSize)> encoded;
+  Encode(data, encoded.data());
+
+  std::array<std::byte, MaxDecodedSize(EncodedSize(kSize))> decoded;
+  while (state.KeepRunning()) {
+    Decode(std::string_view(encoded.data(), encoded.size()), decoded.data());
+  }
+}
+
+PW_PERF_TEST(EncodeSmall, EncodeTest<kSmallSize>);
+PW_PERF_TEST(EncodeLarge, EncodeTest<kLargeSize>);
+PW_PERF_TEST(DecodeSmall, DecodeTest<kSmallSize>);
+PW_PERF_TEST(DecodeLarge, DecodeTest<kLargeSize>);
+
+}  // namespace
+}  // namespace pw::base64
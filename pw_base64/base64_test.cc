@@ -308,6 +308,72 @@ TEST(Base64, Decode_UrlSafeDecode) {
   EXPECT_STREQ("\xf9\xff\xffYo!", output);
 }
 
+// Long enough to be encoded and decoded in multiple SIMD steps, when enabled.
+constexpr char kLongBinary[] =
+    "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"
+    "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f"
+    "\x20\x21\x22\x23\x24\x25\x26\x27\x28\x29\x2a\x2b\x2c\x2d\x2e\x2f"
+    "\x30\x31\x32\x33\x34\x35\x36\x37\x38\x39\x3a\x3b\x3c\x3d\x3e\x3f"
+    "\x40\x41\x42\x43\x44\x45\x46\x47\x48\x49\x4a\x4b\x4c\x4d\x4e\x4f"
+    "\x50\x51\x52\x53\x54\x55\x56\x57\x58\x59\x5a\x5b\x5c\x5d\x5e\x5f"
+    "\x60\x61\x62\x63";
+constexpr char kLongEncoded[] =
+    "AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8gISIjJCUmJygpKissLS4vMDEyMzQ1"
+    "Njc4OTo7PD0+P0BBQkNERUZHSElKS0xNTk9QUVJTVFVWV1hZWltcXV5fYGFiYw==";
+
+TEST(Base64, Encode_LongData) {
+  char output[sizeof(kLongEncoded)] = {};
+  EXPECT_EQ(sizeof(kLongEncoded) - 1,
+            Encode(as_bytes(span(kLongBinary, sizeof(kLongBinary) - 1)),
+                   span(output)));
+  EXPECT_STREQ(kLongEncoded, output);
+}
+
+TEST(Base64, Decode_LongData) {
+  char output[MaxDecodedSize(sizeof(kLongEncoded) - 1)];
+  ASSERT_EQ(sizeof(kLongBinary) - 1, Decode(kLongEncoded, output));
+  EXPECT_EQ(0, std::memcmp(kLongBinary, output, sizeof(kLongBinary) - 1));
+}
+
+TEST(Base64, EncodeDecode_LongDataPrefixes) {
+  // Every multiple of 3 bytes, to cover each split between the SIMD steps and
+  // the scalar loop.
+  for (size_t size = 0; size < sizeof(kLongBinary); size += 3) {
+    const std::string_view expected(kLongEncoded, EncodedSize(size));
+
+    char encoded[sizeof(kLongEncoded)] = {};
+    ASSERT_EQ(expected.size(),
+              Encode(as_bytes(span(kLongBinary, size)), span(encoded)));
+    EXPECT_EQ(expected, std::string_view(encoded, expected.size()));
+
+    char decoded[sizeof(kLongBinary)] = {};
+    ASSERT_EQ(size, Decode(expected, decoded));
+    EXPECT_EQ(0, std::memcmp(kLongBinary, decoded, size));
+  }
+}
+
+TEST(Base64, Decode_EntireAlphabet) {
+  constexpr char kStandard[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  constexpr char kUrlSafe[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+  constexpr char kExpected[] =
+      "\x00\x10\x83\x10\x51\x87\x20\x92\x8b\x30\xd3\x8f\x41\x14\x93\x51"
+      "\x55\x97\x61\x96\x9b\x71\xd7\x9f\x82\x18\xa3\x92\x59\xa7\xa2\x9a"
+      "\xab\xb2\xdb\xaf\xc3\x1c\xb3\xd3\x5d\xb7\xe3\x9e\xbb\xf3\xdf\xbf";
+
+  char output[48];
+  ASSERT_EQ(sizeof(output), Decode(kStandard, output));
+  EXPECT_EQ(0, std::memcmp(kExpected, output, sizeof(output)));
+
+  ASSERT_EQ(sizeof(output), Decode(kUrlSafe, output));
+  EXPECT_EQ(0, std::memcmp(kExpected, output, sizeof(output)));
+
+  char encoded[sizeof(kStandard)] = {};
+  Encode(as_bytes(span(output)), encoded);
+  EXPECT_STREQ(kStandard, encoded);
+}
+
 TEST(Base64, Empty) {
   char buffer[] = "DO NOT TOUCH";
   EXPECT_EQ(0u, EncodedSize(0));
@@ -0,0 +1,56 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+
+namespace pw::base64 {
+
+/// @brief Base64-encodes the rest of the data from a `pw::stream`, writing the
+/// encoded characters to another stream.
+///
+/// The data is read and encoded in small chunks, so inputs of any size can be
+/// encoded without a buffer for the whole input or output. The input ends when
+/// the reader returns `OUT_OF_RANGE` or no data. Padding is only added at the
+/// end of the output.
+///
+/// This always returns the number of characters written, even on error.
+///
+/// @retval OK  The whole input was encoded.
+///
+/// Any error from reading the input or writing the output is returned as is.
+StatusWithSize Encode(stream::Reader& input, stream::Writer& output);
+
+/// @brief Decodes the rest of the Base64 data from a `pw::stream`, writing the
+/// decoded bytes to another stream. Both the standard and URL-safe alphabets
+/// are supported.
+///
+/// The data is read and decoded in small chunks, so inputs of any size can be
+/// decoded without a buffer for the whole input or output. The input ends when
+/// the reader returns `OUT_OF_RANGE` or no data.
+///
+/// This always returns the number of bytes written, even on error.
+///
+/// @retval OK         The whole input was decoded.
+/// @retval DATA_LOSS  The input is not valid Base64: it has invalid
+///                    characters, its size is not a multiple of 4, or there
+///                    is data after the padding. Data decoded before the
+///                    invalid chunk was already written.
+///
+/// Any other error from reading the input or writing the output is returned as
+/// is.
+StatusWithSize Decode(stream::Reader& input, stream::Writer& output);
+
+}  // namespace pw::base64
@@ -0,0 +1,128 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_base64/stream.h"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "pw_base64/base64.h"
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+
+namespace pw::base64 {
+namespace {
+
+// Number of bytes encoded at a time. This is a multiple of 3, so padding is
+// only needed for the last chunk, and of 12, to suit the SIMD implementation.
+constexpr size_t kChunkBinarySize = 48;
+constexpr size_t kChunkEncodedSize = EncodedSize(kChunkBinarySize);
+
+static_assert(MaxDecodedSize(kChunkEncodedSize) == kChunkBinarySize);
+
+// Reads until the buffer is full or the input ends. Returns the number of bytes
+// read, which is less than the buffer size only at the end of the input.
+Result<size_t> ReadChunk(stream::Reader& input, ByteSpan buffer) {
+  size_t size = 0;
+  while (size < buffer.size()) {
+    Result<ByteSpan> result = input.Read(buffer.subspan(size));
+    if (result.status().IsOutOfRange()) {
+      break;
+    }
+    if (!result.ok()) {
+      return result.status();
+    }
+    if (result->empty()) {
+      break;
+    }
+    size += result->size();
+  }
+  return size;
+}
+
+}  // namespace
+
+StatusWithSize Encode(stream::Reader& input, stream::Writer& output) {
+  std::array<std::byte, kChunkBinarySize> binary;
+  std::array<char, kChunkEncodedSize> encoded;
+  size_t written = 0;
+
+  while (true) {
+    Result<size_t> read = ReadChunk(input, binary);
+    if (!read.ok()) {
+      return StatusWithSize(read.status(), written);
+    }
+    if (*read == 0u) {
+      break;
+    }
+
+    const size_t size = EncodedSize(*read);
+    Encode(span(binary).first(*read), encoded.data());
+    if (Status status = output.Write(as_bytes(span(encoded).first(size)));
+        !status.ok()) {
+      return StatusWithSize(status, written);
+    }
+    written += size;
+
+    if (*read < binary.size()) {
+      break;
+    }
+  }
+
+  return StatusWithSize(written);
+}
+
+StatusWithSize Decode(stream::Reader& input, stream::Writer& output) {
+  std::array<char, kChunkEncodedSize> encoded;
+  std::array<std::byte, kChunkBinarySize> binary;
+  size_t written = 0;
+  bool padded = false;
+
+  while (true) {
+    Result<size_t> read = ReadChunk(input, as_writable_bytes(span(encoded)));
+    if (!read.ok()) {
+      return StatusWithSize(read.status(), written);
+    }
+    if (*read == 0u) {
+      break;
+    }
+
+    // Padding may only appear in the last group of the input.
+    const std::string_view chunk(encoded.data(), *read);
+    if (padded) {
+      return StatusWithSize::DataLoss(written);
+    }
+    padded = chunk.back() == '=';
+
+    // Every valid chunk decodes to at least one byte.
+    const size_t size = Decode(chunk, binary);
+    if (size == 0u) {
+      return StatusWithSize::DataLoss(written);
+    }
+    if (Status status = output.Write(span(binary).first(size)); !status.ok()) {
+      return StatusWithSize(status, written);
+    }
+    written += size;
+
+    if (*read < encoded.size()) {
+      break;
+    }
+  }
+
+  return StatusWithSize(written);
+}
+
+}  // namespace pw::base64
@@ -0,0 +1,161 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_base64/stream.h"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "pw_base64/base64.h"
+#include "pw_bytes/span.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::base64 {
+namespace {
+
+using namespace std::literals::string_view_literals;
+
+std::string_view AsString(ConstByteSpan data) {
+  return std::string_view(reinterpret_cast<const char*>(data.data()),
+                          data.size());
+}
+
+// Long enough to be encoded in several chunks.
+constexpr size_t kLongDataSize = 200;
+
+std::array<std::byte, kLongDataSize> LongData() {
+  std::array<std::byte, kLongDataSize> data;
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(i * 7);
+  }
+  return data;
+}
+
+TEST(Base64Stream, Encode) {
+  stream::MemoryReader reader(as_bytes(span("hi!?", 4)));
+  stream::MemoryWriterBuffer<16> writer;
+
+  const StatusWithSize result = Encode(reader, writer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), 8u);
+  EXPECT_EQ(AsString(writer.WrittenData()), "aGkhPw=="sv);
+}
+
+TEST(Base64Stream, Encode_Empty) {
+  stream::MemoryReader reader(ConstByteSpan{});
+  stream::MemoryWriterBuffer<16> writer;
+
+  const StatusWithSize result = Encode(reader, writer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), 0u);
+  EXPECT_EQ(writer.bytes_written(), 0u);
+}
+
+TEST(Base64Stream, Encode_LongData) {
+  const auto data = LongData();
+  stream::MemoryReader reader(data);
+  stream::MemoryWriterBuffer<EncodedSize(kLongDataSize)> writer;
+
+  const StatusWithSize result = Encode(reader, writer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), EncodedSize(kLongDataSize));
+
+  // The output matches encoding the whole input at once.
+  std::array<char, EncodedSize(kLongDataSize)> expected;
+  Encode(data, expected.data());
+  EXPECT_EQ(AsString(writer.WrittenData()),
+            std::string_view(expected.data(), expected.size()));
+}
+
+TEST(Base64Stream, Encode_OutputFull) {
+  const auto data = LongData();
+  stream::MemoryReader reader(data);
+  stream::MemoryWriterBuffer<100> writer;
+
+  const StatusWithSize result = Encode(reader, writer);
+  EXPECT_EQ(result.status(), Status::ResourceExhausted());
+  EXPECT_EQ(result.size(), 64u);
+}
+
+TEST(Base64Stream, Decode) {
+  constexpr std::string_view kEncoded = "aGkhPw==";
+  stream::MemoryReader reader(as_bytes(span(kEncoded)));
+  stream::MemoryWriterBuffer<16> writer;
+
+  const StatusWithSize result = Decode(reader, writer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), 4u);
+  EXPECT_EQ(AsString(writer.WrittenData()), "hi!?"sv);
+}
+
+TEST(Base64Stream, Decode_LongData) {
+  const auto data = LongData();
+  std::array<char, EncodedSize(kLongDataSize)> encoded;
+  Encode(data, encoded.data());
+
+  stream::MemoryReader reader(as_bytes(span(encoded)));
+  stream::MemoryWriterBuffer<kLongDataSize> writer;
+
+  const StatusWithSize result = Decode(reader, writer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), data.size());
+  EXPECT_EQ(AsString(writer.WrittenData()), AsString(data));
+}
+
+TEST(Base64Stream, Decode_UrlSafe) {
+  constexpr std::string_view kEncoded = "-f__WW8h";
+  stream::MemoryReader reader(as_bytes(span(kEncoded)));
+  stream::MemoryWriterBuffer<16> writer;
+
+  const StatusWithSize result = Decode(reader, writer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(AsString(writer.WrittenData()), "\xf9\xff\xffYo!"sv);
+}
+
+TEST(Base64Stream, Decode_InvalidCharacter) {
+  constexpr std::string_view kEncoded = "aGk*";
+  stream::MemoryReader reader(as_bytes(span(kEncoded)));
+  stream::MemoryWriterBuffer<16> writer;
+
+  const StatusWithSize result = Decode(reader, writer);
+  EXPECT_EQ(result.status(), Status::DataLoss());
+  EXPECT_EQ(result.size(), 0u);
+}
+
+TEST(Base64Stream, Decode_IncorrectSize) {
+  constexpr std::string_view kEncoded = "aGkhP";
+  stream::MemoryReader reader(as_bytes(span(kEncoded)));
+  stream::MemoryWriterBuffer<16> writer;
+
+  EXPECT_EQ(Decode(reader, writer).status(), Status::DataLoss());
+}
+
+TEST(Base64Stream, Decode_DataAfterPadding) {
+  // Padding ends the first chunk of 64 characters, but more data follows.
+  std::array<char, 68> encoded;
+  encoded.fill('A');
+  encoded[62] = '=';
+  encoded[63] = '=';
+  stream::MemoryReader reader(as_bytes(span(encoded)));
+  stream::MemoryWriterBuffer<64> writer;
+
+  const StatusWithSize result = Decode(reader, writer);
+  EXPECT_EQ(result.status(), Status::DataLoss());
+  EXPECT_EQ(result.size(), 46u);
+}
+
+}  // namespace
+}  // namespace pw::base64
@@ -0,0 +1,200 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Tests for stack usage and RAM attribution reports."""
+
+import unittest
+
+from pw_bloat.memory_report import (
+    CallGraph,
+    OTHER_MODULE,
+    module_for_symbol,
+    parse_ram_symbols,
+    ram_table,
+)
+
+# Output of `gcc -O2 -fcallgraph-info=su`, trimmed.
+# pylint: disable=line-too-long
+_CALLGRAPH_INFO = r'''graph: { title: "threads.cc"
+node: { title: "_Z4leafi" label: "int leaf(int)\nthreads.cc:2:5\n112 bytes (static)" }
+node: { title: "_Z3midi" label: "int mid(int)\nthreads.cc:3:5\n208 bytes (static)" }
+edge: { sourcename: "_Z3midi" targetname: "_Z4leafi" label: "threads.cc:3:56" }
+node: { title: "_Z3Runv" label: "void Run()\nthreads.cc:5:6\n8 bytes (static)" }
+edge: { sourcename: "_Z3Runv" targetname: "_Z3midi" label: "threads.cc:5:14" }
+edge: { sourcename: "_Z3Runv" targetname: "_Z4leafi" label: "threads.cc:5:22" }
+node: { title: "_Z4Run2v" label: "void Run2()\nthreads.cc:6:6\n16 bytes (static)" }
+node: { title: "__indirect_call" label: "Indirect Call Placeholder" shape : ellipse }
+edge: { sourcename: "_Z4Run2v" targetname: "__indirect_call" label: "threads.cc:6:20" }
+node: { title: "_Z3exti" label: "int ext(int)\nthreads.cc:1:12" shape : ellipse }
+edge: { sourcename: "_Z4Run2v" targetname: "_Z3exti" label: "threads.cc:6:30" }
+node: { title: "_Z3reci" label: "int rec(int)\nthreads.cc:7:5\n24 bytes (static)" }
+edge: { sourcename: "_Z3reci" targetname: "_Z3reci" label: "threads.cc:7:40" }
+node: { title: "_Z4Run3v" label: "void Run3()\nthreads.cc:8:6\n8 bytes (static)" }
+edge: { sourcename: "_Z4Run3v" targetname: "_Z3reci" label: "threads.cc:8:15" }
+node: { title: "_Z3vlai" label: "int vla(int)\nthreads.cc:9:5\n32 bytes (dynamic)" }
+node: { title: "_Z7boundedv" label: "int bounded()\nthreads.cc:10:5\n48 bytes (dynamic,bounded)" }
+}
+'''
+# pylint: enable=line-too-long
+
+_BLOATY_TSV = [
+    'sections\tcompileunits\tsymbols\tvmsize\tfilesize',
+    '.bss\t../../pw_rpc/server.cc\tpw::rpc::internal::encoding_buffer\t1024\t0',
+    '.bss\t../../app/main.cc\t'
+    'pw::log_rpc::(anonymous namespace)::drains\t512\t0',
+    '.bss\t../../app/main.cc\tpw::transfer::thread_buffer\t256\t0',
+    '.data\t../../app/main.cc\tg_counter\t4\t4',
+    '.text\t../../pw_rpc/server.cc\tpw::rpc::Server::ProcessPacket()\t640\t640',
+    '.heap\t[section .heap]\t[section .heap]\t8192\t0',
+]
+
+
+class CallGraphTest(unittest.TestCase):
+    """Tests worst-case stack usage computed from a call graph."""
+
+    def setUp(self) -> None:
+        self.graph = CallGraph()
+        self.graph.parse(_CALLGRAPH_INFO)
+
+    def test_parses_functions(self) -> None:
+        leaf = self.graph.functions['_Z4leafi']
+        self.assertEqual(leaf.display_name, 'int leaf(int)')
+        self.assertEqual(leaf.location, 'threads.cc:2:5')
+        self.assertEqual(leaf.frame_size, 112)
+        self.assertEqual(self.graph.functions['_Z3midi'].callees, {'_Z4leafi'})
+        self.assertIsNone(self.graph.functions['_Z3exti'].frame_size)
+
+    def test_roots(self) -> None:
+        self.assertEqual(
+            self.graph.roots(),
+            ['_Z3Runv', '_Z3vlai', '_Z4Run2v', '_Z4Run3v', '_Z7boundedv'],
+        )
+
+    def test_find(self) -> None:
+        self.assertEqual(
+            self.graph.find('void Run*()'), ['_Z3Runv', '_Z4Run2v', '_Z4Run3v']
+        )
+        self.assertEqual(self.graph.find('_Z3midi'), ['_Z3midi'])
+
+    def test_deepest_path(self) -> None:
+        usage = self.graph.stack_usage('_Z3Runv')
+        self.assertEqual(usage.size_bytes, 8 + 208 + 112)
+        self.assertEqual(
+            usage.path, ('void Run()', 'int mid(int)', 'int leaf(int)')
+        )
+        self.assertTrue(usage.bounded)
+        self.assertEqual(usage.notes(), [])
+
+    def test_indirect_and_unknown_calls(self) -> None:
+        usage = self.graph.stack_usage('_Z4Run2v')
+        self.assertEqual(usage.size_bytes, 16)
+        self.assertTrue(usage.indirect_calls)
+        self.assertEqual(usage.unknown_functions, {'int ext(int)'})
+        self.assertFalse(usage.bounded)
+
+    def test_recursion(self) -> None:
+        usage = self.graph.stack_usage('_Z4Run3v')
+        self.assertEqual(usage.size_bytes, 8 + 24)
+        self.assertTrue(usage.recursion)
+        self.assertFalse(usage.bounded)
+
+    def test_dynamic_frames(self) -> None:
+        self.assertTrue(self.graph.stack_usage('_Z3vlai').unbounded_frames)
+        self.assertTrue(self.graph.stack_usage('_Z7boundedv').bounded)
+
+    def test_duplicate_local_functions_keep_largest_frame(self) -> None:
+        self.graph.parse(
+            'node: { title: "_Z4leafi" label: "int leaf(int)\\n'
+            'other.cc:1:5\\n400 bytes (static)" }'
+        )
+        self.graph.parse(
+            'node: { title: "_Z4leafi" label: "int leaf(int)\\n'
+            'other.cc:1:5\\n16 bytes (static)" }'
+        )
+        self.assertEqual(self.graph.functions['_Z4leafi'].frame_size, 400)
+
+
+class RamAttributionTest(unittest.TestCase):
+    """Tests attribution of RAM symbols to modules."""
+
+    def test_module_from_compile_unit(self) -> None:
+        self.assertEqual(
+            module_for_symbol('buffer', '../../pw_rpc/raw/server.cc'), 'pw_rpc'
+        )
+        self.assertEqual(
+            module_for_symbol(
+                'buffer', 'pw_log_rpc/public/pw_log_rpc/log_service.h'
+            ),
+            'pw_log_rpc',
+        )
+
+    def test_module_from_namespace(self) -> None:
+        self.assertEqual(
+            module_for_symbol('pw::log_rpc::RpcLogDrain::buffer'), 'pw_log_rpc'
+        )
+        self.assertEqual(
+            module_for_symbol('pw::allocator::(anonymous namespace)::arena'),
+            'pw_allocator',
+        )
+        self.assertEqual(
+            module_for_symbol('pw::transfer::buffer', '../../app/main.cc'),
+            'pw_transfer',
+        )
+
+    def test_unknown_module(self) -> None:
+        self.assertEqual(module_for_symbol('g_counter'), OTHER_MODULE)
+        self.assertEqual(module_for_symbol('pw::Vector<int>'), OTHER_MODULE)
+
+    def test_parse_ram_symbols(self) -> None:
+        symbols = parse_ram_symbols(_BLOATY_TSV)
+        self.assertEqual(
+            [(s.section, s.name, s.size_bytes, s.module) for s in symbols],
+            [
+                (
+                    '.bss',
+                    'pw::rpc::internal::encoding_buffer',
+                    1024,
+                    'pw_rpc',
+                ),
+                (
+                    '.bss',
+                    'pw::log_rpc::(anonymous namespace)::drains',
+                    512,
+                    'pw_log_rpc',
+                ),
+                ('.bss', 'pw::transfer::thread_buffer', 256, 'pw_transfer'),
+                ('.data', 'g_counter', 4, OTHER_MODULE),
+                ('.heap', '[section .heap]', 8192, OTHER_MODULE),
+            ],
+        )
+
+    def test_parse_ram_symbols_without_compile_units(self) -> None:
+        symbols = parse_ram_symbols(
+            [
+                'sections\tsymbols\tvmsize\tfilesize',
+                '.zero_init_ram\tpw::rpc::buffer\t64\t0',
+                '.code\tmain\t32\t32',
+            ]
+        )
+        self.assertEqual(len(symbols), 1)
+        self.assertEqual(symbols[0].module, 'pw_rpc')
+
+    def test_ram_table_groups_small_symbols(self) -> None:
+        table = ram_table(parse_ram_symbols(_BLOATY_TSV), min_size_bytes=300)
+        self.assertIn('pw::rpc::internal::encoding_buffer', table)
+        self.assertNotIn('pw::transfer::thread_buffer', table)
+        self.assertIn('(symbols under 300 B)', table)
+
+
+if __name__ == '__main__':
+    unittest.main()
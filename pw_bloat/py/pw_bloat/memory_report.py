@@ -0,0 +1,536 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Reports worst-case stack usage and attributes RAM to Pigweed modules.
+
+Stack usage is computed from the call graph files (``.ci``) that GCC writes
+next to each object file when compiling with ``-fcallgraph-info=su``. These
+record the stack frame of every function, as ``-fstack-usage`` does, along
+with the functions it calls directly.
+
+RAM attribution runs Bloaty on the binary and assigns each symbol in its RAM
+sections to the Pigweed module whose sources define it, as determined from
+the compile unit or, failing that, the symbol's namespace.
+"""
+
+import argparse
+import csv
+import dataclasses
+import fnmatch
+import json
+import logging
+from pathlib import Path
+import re
+import subprocess
+import sys
+import tempfile
+from typing import (
+    Dict,
+    FrozenSet,
+    Iterable,
+    List,
+    Optional,
+    Sequence,
+    Set,
+    Tuple,
+)
+
+import pw_cli.argument_types
+
+from pw_bloat.bloat import run_bloaty
+from pw_bloat.label import DataSourceMap
+from pw_bloat.label_output import BloatTableOutput
+
+_LOG = logging.getLogger(__name__)
+
+# GCC's placeholder callee for calls through function pointers and vtables.
+_INDIRECT_CALL = '__indirect_call'
+
+_NODE_RE = re.compile(
+    r'^node: \{ title: "(?P<title>[^"]*)" label: "(?P<label>[^"]*)"'
+)
+_EDGE_RE = re.compile(
+    r'^edge: \{ sourcename: "(?P<source>[^"]*)" '
+    r'targetname: "(?P<target>[^"]*)"'
+)
+_STACK_SIZE_RE = re.compile(r'^(?P<size>\d+) bytes \((?P<qualifiers>[\w,]+)\)$')
+
+_DEFAULT_RAM_SECTIONS = r'\.(bss|data|noinit|heap|stack)\b|_ram$'
+
+# Directory components such as "pw_rpc" in "../../pw_rpc/server.cc".
+_MODULE_DIR_RE = re.compile(r'(?:^|/)(pw_\w+)(?=/)')
+_MODULE_NAMESPACE_RE = re.compile(r'\bpw::([a-z][a-z0-9_]*)::')
+
+OTHER_MODULE = '(other)'
+
+
+@dataclasses.dataclass
+class Function:
+    """A function in the call graph."""
+
+    name: str
+    display_name: str
+    location: str = ''
+    frame_size: Optional[int] = None
+    unbounded_frame: bool = False
+    callees: Set[str] = dataclasses.field(default_factory=set)
+
+
+@dataclasses.dataclass(frozen=True)
+class StackUsage:
+    """The worst-case stack usage of a function and everything it calls.
+
+    The size is only an upper bound if ``bounded`` is true. Otherwise, it
+    covers the direct calls that could be followed, and the other fields
+    describe what could not.
+    """
+
+    size_bytes: int
+    path: Tuple[str, ...] = ()
+    recursion: bool = False
+    indirect_calls: bool = False
+    unbounded_frames: bool = False
+    unknown_functions: FrozenSet[str] = frozenset()
+
+    @property
+    def bounded(self) -> bool:
+        return not (
+            self.recursion
+            or self.indirect_calls
+            or self.unbounded_frames
+            or self.unknown_functions
+        )
+
+    def notes(self) -> List[str]:
+        """Describes why the size is not an upper bound, if it is not."""
+        notes = []
+        if self.recursion:
+            notes.append('recursion')
+        if self.indirect_calls:
+            notes.append('indirect calls')
+        if self.unbounded_frames:
+            notes.append('dynamic stack allocation')
+        if self.unknown_functions:
+            count = len(self.unknown_functions)
+            notes.append(
+                f'{count} callee{"s" if count != 1 else ""} without stack info'
+            )
+        return notes
+
+
+class CallGraph:
+    """Functions and their stack frames from GCC call graph files."""
+
+    def __init__(self) -> None:
+        self.functions: Dict[str, Function] = {}
+
+    @classmethod
+    def from_files(cls, paths: Iterable[Path]) -> 'CallGraph':
+        graph = cls()
+        for path in paths:
+            graph.parse(path.read_text())
+        return graph
+
+    def parse(self, callgraph_info: str) -> None:
+        """Adds the contents of a .ci file to the graph."""
+        for line in callgraph_info.splitlines():
+            if match := _NODE_RE.match(line):
+                self._add_node(match['title'], match['label'].split(r'\n'))
+            elif match := _EDGE_RE.match(line):
+                self._function(match['source']).callees.add(match['target'])
+
+    def _function(self, name: str, display_name: str = '') -> Function:
+        if name not in self.functions:
+            self.functions[name] = Function(name, display_name or name)
+        return self.functions[name]
+
+    def _add_node(self, name: str, label: Sequence[str]) -> None:
+        if name == _INDIRECT_CALL:
+            return
+
+        function = self._function(name, label[0])
+        if function.display_name == name:
+            function.display_name = label[0]
+        if len(label) > 1 and not function.location:
+            function.location = label[1]
+
+        for line in label[2:]:
+            if match := _STACK_SIZE_RE.match(line):
+                qualifiers = match['qualifiers'].split(',')
+                # Functions with internal linkage from different files can
+                # share a name. Keep the largest frame, to stay conservative.
+                function.frame_size = max(
+                    int(match['size']), function.frame_size or 0
+                )
+                function.unbounded_frame |= (
+                    'dynamic' in qualifiers and 'bounded' not in qualifiers
+                )
+
+    def roots(self) -> List[str]:
+        """Returns the functions that no other function calls directly.
+
+        These include thread entry points and interrupt handlers, which are
+        only reached through function pointers or vtables.
+        """
+        called: Set[str] = set()
+        for function in self.functions.values():
+            called.update(function.callees - {function.name})
+
+        return sorted(
+            name
+            for name, function in self.functions.items()
+            if function.frame_size is not None and name not in called
+        )
+
+    def find(self, pattern: str) -> List[str]:
+        """Returns the functions whose name matches a glob pattern.
+
+        The pattern is matched against both the assembler name and the
+        display name, which includes the return type and parameters, e.g.
+        "void pw::work_queue::WorkQueue::Run()".
+        """
+        return sorted(
+            name
+            for name, function in self.functions.items()
+            if fnmatch.fnmatchcase(name, pattern)
+            or fnmatch.fnmatchcase(function.display_name, pattern)
+        )
+
+    def stack_usage(self, name: str) -> StackUsage:
+        """Returns the worst-case stack usage of a function."""
+        return self._stack_usage(name, set(), {})
+
+    def _stack_usage(
+        self, name: str, active: Set[str], memo: Dict[str, StackUsage]
+    ) -> StackUsage:
+        if name == _INDIRECT_CALL:
+            return StackUsage(0, indirect_calls=True)
+
+        function = self.functions.get(name)
+        if function is None or function.frame_size is None:
+            display_name = function.display_name if function else name
+            return StackUsage(
+                0, (display_name,), unknown_functions=frozenset([display_name])
+            )
+
+        if name in memo:
+            return memo[name]
+
+        active.add(name)
+        deepest = StackUsage(0)
+        recursion = False
+        indirect_calls = False
+        unbounded_frames = function.unbounded_frame
+        unknown_functions: Set[str] = set()
+
+        for callee in sorted(function.callees):
+            if callee in active:
+                recursion = True
+                continue
+
+            usage = self._stack_usage(callee, active, memo)
+            recursion |= usage.recursion
+            indirect_calls |= usage.indirect_calls
+            unbounded_frames |= usage.unbounded_frames
+            unknown_functions |= usage.unknown_functions
+            if usage.size_bytes > deepest.size_bytes:
+                deepest = usage
+
+        active.remove(name)
+
+        memo[name] = StackUsage(
+            function.frame_size + deepest.size_bytes,
+            (function.display_name, *deepest.path),
+            recursion,
+            indirect_calls,
+            unbounded_frames,
+            frozenset(unknown_functions),
+        )
+        return memo[name]
+
+
+@dataclasses.dataclass(frozen=True)
+class RamSymbol:
+    """A symbol in a RAM section of a binary."""
+
+    section: str
+    name: str
+    size_bytes: int
+    module: str
+
+
+def module_for_symbol(name: str, compile_unit: Optional[str] = None) -> str:
+    """Returns the Pigweed module that defines a symbol.
+
+    The module is taken from the path of the compile unit that defines the
+    symbol, if known, or else from the symbol's namespace, e.g. "pw_log_rpc"
+    for "pw::log_rpc::RpcLogDrain". Symbols that match neither are attributed
+    to OTHER_MODULE.
+    """
+    if compile_unit and (modules := _MODULE_DIR_RE.findall(compile_unit)):
+        return modules[-1]
+
+    if match := _MODULE_NAMESPACE_RE.search(name):
+        return f'pw_{match[1]}'
+
+    return OTHER_MODULE
+
+
+def parse_ram_symbols(
+    bloaty_tsv: Iterable[str], ram_sections: str = _DEFAULT_RAM_SECTIONS
+) -> List[RamSymbol]:
+    """Reads the RAM symbols from a Bloaty TSV report.
+
+    The report's data sources must be "sections", optionally
+    "compileunits", and "symbols", in that order.
+    """
+    reader = csv.reader(bloaty_tsv, delimiter='\t')
+    header = next(reader)
+    vmsize_index = header.index('vmsize')
+    compile_unit_index = (
+        header.index('compileunits') if 'compileunits' in header else None
+    )
+    sections_pattern = re.compile(ram_sections)
+
+    symbols = []
+    for row in reader:
+        section, name = row[0], row[vmsize_index - 1]
+        size = int(row[vmsize_index])
+        if size == 0 or not sections_pattern.search(section):
+            continue
+
+        compile_unit = (
+            row[compile_unit_index] if compile_unit_index is not None else None
+        )
+        symbols.append(
+            RamSymbol(
+                section, name, size, module_for_symbol(name, compile_unit)
+            )
+        )
+
+    return symbols
+
+
+def ram_report(elf: Path) -> List[str]:
+    """Runs Bloaty to list the symbols in an ELF file by compile unit.
+
+    Falls back to symbols alone if the ELF has no debug information.
+    """
+    with tempfile.NamedTemporaryFile() as empty_config:
+        try:
+            output = run_bloaty(
+                str(elf),
+                empty_config.name,
+                data_sources=('sections', 'compileunits', 'symbols'),
+                extra_args=('--tsv',),
+            )
+        except subprocess.CalledProcessError:
+            _LOG.warning(
+                'Failed to read compile units from %s; attributing symbols '
+                'by namespace only',
+                elf,
+            )
+            output = run_bloaty(
+                str(elf),
+                empty_config.name,
+                data_sources=('sections', 'symbols'),
+                extra_args=('--tsv',),
+            )
+
+    return output.decode('utf-8').splitlines()
+
+
+def ram_table(symbols: Iterable[RamSymbol], min_size_bytes: int = 0) -> str:
+    """Tabulates RAM usage by module, listing symbols of at least a size.
+
+    Smaller symbols are summed into one row per module.
+    """
+    ds_map = DataSourceMap(['modules', 'symbols'])
+    smaller: Dict[str, int] = {}
+    for symbol in symbols:
+        if symbol.size_bytes >= min_size_bytes:
+            ds_map.insert_label_hierarchy(
+                [symbol.module, symbol.name], symbol.size_bytes
+            )
+        else:
+            smaller[symbol.module] = (
+                smaller.get(symbol.module, 0) + symbol.size_bytes
+            )
+
+    for module, size in smaller.items():
+        ds_map.insert_label_hierarchy(
+            [module, f'(symbols under {min_size_bytes} B)'], size
+        )
+
+    return BloatTableOutput(ds_map).create_table()
+
+
+def stack_table(usages: Dict[str, StackUsage], show_paths: bool) -> str:
+    """Tabulates the worst-case stack usage of entry points."""
+    ordered = sorted(usages.items(), key=lambda item: -item[1].size_bytes)
+
+    rows = [('entry point', 'stack', 'notes')]
+    for name, usage in ordered:
+        size = f'{usage.size_bytes:,}'
+        if not usage.bounded:
+            size = '>=' + size
+        rows.append((name, size, ', '.join(usage.notes())))
+
+    widths = [max(len(row[i]) for row in rows) for i in range(3)]
+    lines = [
+        f'{row[0]:<{widths[0]}}  {row[1]:>{widths[1]}}  {row[2]}'.rstrip()
+        for row in rows
+    ]
+    lines.insert(1, f'{"-" * widths[0]}  {"-" * widths[1]}  -----')
+
+    if show_paths:
+        for name, usage in ordered:
+            lines.append('')
+            lines.append(f'Deepest call path from {name}:')
+            lines.extend(f'  {function}' for function in usage.path)
+
+    return '\n'.join(lines)
+
+
+def _find_callgraph_files(paths: Iterable[Path]) -> List[Path]:
+    files: List[Path] = []
+    for path in paths:
+        files.extend(sorted(path.rglob('*.ci')) if path.is_dir() else [path])
+    return files
+
+
+def _parse_args() -> argparse.Namespace:
+    """Return a CLI argument parser for this module."""
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog='Hint: try this:\n'
+        '   python -m pw_bloat.memory_report out/obj '
+        '--elf my_app.elf --entry "*::Run()"',
+    )
+    parser.add_argument(
+        'callgraph_info',
+        nargs='*',
+        type=Path,
+        help=(
+            'GCC call graph (.ci) files, or directories to search for them, '
+            'from compiling with -fcallgraph-info=su'
+        ),
+    )
+    parser.add_argument(
+        '--entry',
+        action='append',
+        default=[],
+        help=(
+            'Glob pattern for the entry points to report, e.g. thread '
+            'functions; may be repeated. Defaults to all functions that are '
+            'not called directly.'
+        ),
+    )
+    parser.add_argument(
+        '--paths',
+        action='store_true',
+        help='Print the deepest call path from each entry point',
+    )
+    parser.add_argument(
+        '--elf',
+        type=Path,
+        help='Binary whose RAM symbols to attribute to modules',
+    )
+    parser.add_argument(
+        '--ram-sections',
+        default=_DEFAULT_RAM_SECTIONS,
+        help='Regular expression matching the names of RAM sections',
+    )
+    parser.add_argument(
+        '--min-size',
+        type=int,
+        default=256,
+        help='Smallest RAM symbol, in bytes, to list individually',
+    )
+    parser.add_argument(
+        '--json',
+        action='store_true',
+        help='Print the report as JSON',
+    )
+    parser.add_argument(
+        '-l',
+        '--loglevel',
+        type=pw_cli.argument_types.log_level,
+        default=logging.INFO,
+        help='Set the log level (debug, info, warning, error, critical)',
+    )
+    return parser.parse_args()
+
+
+def main() -> int:
+    """Reports stack usage and RAM usage by module."""
+    args = _parse_args()
+
+    logging.basicConfig(format='%(message)s', level=args.loglevel)
+
+    if not args.callgraph_info and args.elf is None:
+        _LOG.error('Provide call graph files, an ELF file, or both')
+        return 1
+
+    usages: Dict[str, StackUsage] = {}
+    if args.callgraph_info:
+        graph = CallGraph.from_files(_find_callgraph_files(args.callgraph_info))
+        if args.entry:
+            entries = [name for p in args.entry for name in graph.find(p)]
+        else:
+            entries = graph.roots()
+        if not entries:
+            _LOG.error('No entry points found in the call graph')
+            return 1
+
+        usages = {
+            graph.functions[name].display_name: graph.stack_usage(name)
+            for name in entries
+        }
+
+    symbols: List[RamSymbol] = []
+    if args.elf is not None:
+        symbols = parse_ram_symbols(ram_report(args.elf), args.ram_sections)
+
+    if args.json:
+        print(
+            json.dumps(
+                {
+                    'stack': {
+                        name: {
+                            'size_bytes': usage.size_bytes,
+                            'bounded': usage.bounded,
+                            'notes': usage.notes(),
+                            'path': list(usage.path),
+                        }
+                        for name, usage in usages.items()
+                    },
+                    'ram': [dataclasses.asdict(s) for s in symbols],
+                },
+                indent=2,
+            )
+        )
+        return 0
+
+    if usages:
+        print(stack_table(usages, args.paths))
+    if symbols:
+        if usages:
+            print()
+        print(ram_table(symbols, args.min_size))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -72,6 +72,7 @@ Status BlobStore::Init() {
 Status BlobStore::LoadMetadata() {
   write_address_ = 0;
   flash_address_ = 0;
+  erased_address_ = 0;
   file_name_length_ = 0;
   valid_data_ = false;
 
@@ -144,6 +145,12 @@ StatusWithSize BlobStore::ResumeWrite() {
     return StatusWithSize::Unavailable();
   }
 
+  // Resume finds the end of the written data by scanning for erased flash,
+  // which only works if the partition after the data was erased.
+  if (erase_mode_ == EraseMode::kIncremental) {
+    return StatusWithSize::Unimplemented();
+  }
+
   // Clear any existing blob state or KVS key, to provide a consistent starting
   // point for resume.
   //
@@ -428,18 +435,25 @@ Status BlobStore::CommitToFlash(ConstByteSpan source, size_t data_bytes) {
     data_bytes = source.size_bytes();
   }
 
+  Status status;
+  if (erase_mode_ == EraseMode::kIncremental) {
+    status = EraseThrough(flash_address_ + source.size_bytes());
+  }
+
   flash_erased_ = false;
-  StatusWithSize result = partition_.Write(flash_address_, source);
+  if (status.ok()) {
+    status = partition_.Write(flash_address_, source).status();
+  }
   flash_address_ += data_bytes;
   if (checksum_algo_ != nullptr) {
     checksum_algo_->Update(source.first(data_bytes));
   }
 
-  if (!result.status().ok()) {
+  if (!status.ok()) {
     valid_data_ = false;
   }
 
-  return result.status();
+  return status;
 }
 
 // Needs to be in .cc file since PW_CHECK doesn't like being in .h files.
@@ -456,13 +470,54 @@ size_t BlobStore::WriteBufferBytesFree() const {
 }
 
 Status BlobStore::EraseIfNeeded() {
-  if (flash_address_ == 0) {
-    // Always just erase. Erase is smart enough to only erase if needed.
-    return Erase();
+  if (flash_address_ != 0) {
+    return OkStatus();
+  }
+
+  if (erase_mode_ == EraseMode::kIncremental) {
+    // Sectors are erased as they are written to, in CommitToFlash. The blob is
+    // valid as soon as it is started, as with a full erase.
+    valid_data_ = true;
+    return OkStatus();
+  }
+
+  // Always just erase. Erase is smart enough to only erase if needed.
+  return Erase();
+}
+
+Status BlobStore::EraseThrough(size_t end_address) {
+  if (erased_address_ >= end_address) {
+    return OkStatus();
   }
+  PW_DCHECK_UINT_GE(erased_address_, flash_address_);
+
+  const size_t sector_size = partition_.sector_size_bytes();
+  const size_t end_sector = (end_address + sector_size - 1) / sector_size;
+  const size_t sectors_to_erase = end_sector - erased_address_ / sector_size;
+
+  PW_LOG_DEBUG("Blob erasing %u sectors at 0x%x",
+               static_cast<unsigned>(sectors_to_erase),
+               static_cast<unsigned>(erased_address_));
+  PW_TRY(partition_.Erase(erased_address_, sectors_to_erase));
+  erased_address_ = end_sector * sector_size;
   return OkStatus();
 }
 
+Status BlobStore::EraseAhead(size_t max_sectors) {
+  if (!ValidToWrite()) {
+    return Status::DataLoss();
+  }
+  PW_TRY(EraseIfNeeded());
+  if (erase_mode_ == EraseMode::kFullPartition) {
+    return OkStatus();
+  }
+
+  const size_t sectors_left =
+      (MaxDataSizeBytes() - erased_address_) / partition_.sector_size_bytes();
+  return EraseThrough(erased_address_ + std::min(max_sectors, sectors_left) *
+                                            partition_.sector_size_bytes());
+}
+
 StatusWithSize BlobStore::Read(size_t offset, ByteSpan dest) const {
   if (!HasData()) {
     return StatusWithSize::FailedPrecondition();
@@ -482,11 +537,7 @@ Result<ConstByteSpan> BlobStore::GetMemoryMappedBlob() const {
     return Status::FailedPrecondition();
   }
 
-  std::byte* mcu_address = partition_.PartitionAddressToMcuAddress(0);
-  if (mcu_address == nullptr) {
-    return Status::Unimplemented();
-  }
-  return ConstByteSpan(mcu_address, ReadableDataBytes());
+  return partition_.GetMemoryMappedRegion(0, ReadableDataBytes());
 }
 
 size_t BlobStore::ReadableDataBytes() const {
@@ -518,6 +569,7 @@ Status BlobStore::Erase() {
   PW_TRY(partition_.Erase());
 
   flash_erased_ = true;
+  erased_address_ = MaxDataSizeBytes();
 
   // Blob data is considered valid as soon as the flash is erased. Even though
   // there are 0 bytes written, they are valid.
@@ -532,6 +584,7 @@ Status BlobStore::Invalidate() {
   ResetChecksum();
   write_address_ = 0;
   flash_address_ = 0;
+  erased_address_ = flash_erased_ ? MaxDataSizeBytes() : 0;
   file_name_length_ = 0;
 
   Status status = kvs_.acquire()->Delete(MetadataKey());
@@ -664,6 +717,20 @@ StatusWithSize BlobStore::BlobWriter::Resume() {
   return sws;
 }
 
+StatusWithSize BlobStore::BlobWriter::ReadCommittedData(size_t offset,
+                                                        ByteSpan dest) const {
+  if (!open_) {
+    return StatusWithSize::FailedPrecondition();
+  }
+  if (offset >= store_.flash_address_) {
+    return StatusWithSize(0);
+  }
+
+  const size_t read_size =
+      std::min(dest.size_bytes(), size_t(store_.flash_address_ - offset));
+  return store_.partition_.Read(offset, dest.first(read_size));
+}
+
 // Validates and commits BlobStore metadata to KVS.
 //
 // 1. Finalize checksum calculation.
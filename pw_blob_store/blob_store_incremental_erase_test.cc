@@ -0,0 +1,274 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_blob_store/blob_store.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/test_key_value_store.h"
+#include "pw_random/xor_shift.h"
+#include "pw_span/span.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::blob_store {
+namespace {
+
+// Counts the sectors that are erased, and optionally fails erases.
+class ErasePartition : public kvs::FlashPartition {
+ public:
+  using kvs::FlashPartition::Erase;
+  using kvs::FlashPartition::FlashPartition;
+
+  Status Erase(Address address, size_t num_sectors) override {
+    if (!erase_status.ok()) {
+      return erase_status;
+    }
+    sectors_erased += num_sectors;
+    return kvs::FlashPartition::Erase(address, num_sectors);
+  }
+
+  size_t sectors_erased = 0;
+  Status erase_status;
+};
+
+class BlobStoreIncrementalEraseTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kFlashAlignment = 16;
+  static constexpr size_t kSectorSize = 512;
+  static constexpr size_t kSectorCount = 4;
+  static constexpr size_t kBlobDataSize = kSectorCount * kSectorSize;
+  static constexpr size_t kWriteSize = 64;
+  static constexpr std::byte kOldData{0x5a};
+
+  BlobStoreIncrementalEraseTest()
+      : flash_(kFlashAlignment),
+        partition_(&flash_),
+        blob_("IncrementalBlob",
+              partition_,
+              &checksum_,
+              kvs::TestKvs(),
+              kWriteSize,
+              BlobStore::EraseMode::kIncremental) {
+    // Start with the partition full of old data, so that erases are visible.
+    std::memset(flash_.buffer().data(),
+                static_cast<int>(kOldData),
+                flash_.buffer().size());
+    random::XorShiftStarRng64 rng(0x1234abcd);
+    rng.Get(source_);
+    EXPECT_EQ(OkStatus(), blob_.Init());
+  }
+
+  // Writes source_ from offset start to end in chunks of chunk_size.
+  void WriteSource(BlobStore::BlobWriter& writer,
+                   size_t start,
+                   size_t end,
+                   size_t chunk_size) {
+    for (size_t offset = start; offset < end; offset += chunk_size) {
+      const size_t write_size = std::min(chunk_size, end - offset);
+      ASSERT_EQ(OkStatus(),
+                writer.Write(span(source_).subspan(offset, write_size)));
+    }
+  }
+
+  void VerifyBlob(size_t size) {
+    BlobStore::BlobReader reader(blob_);
+    ASSERT_EQ(OkStatus(), reader.Open());
+    Result<ConstByteSpan> result = reader.GetMemoryMappedBlob();
+    ASSERT_EQ(OkStatus(), result.status());
+    ASSERT_EQ(size, result->size());
+    EXPECT_EQ(0, std::memcmp(result->data(), source_.data(), size));
+    EXPECT_EQ(OkStatus(), reader.Close());
+  }
+
+  bool SectorHasOldData(size_t sector) {
+    const std::byte* data = flash_.buffer().data() + sector * kSectorSize;
+    for (size_t i = 0; i < kSectorSize; ++i) {
+      if (data[i] != kOldData) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash_;
+  ErasePartition partition_;
+  kvs::ChecksumCrc16 checksum_;
+  BlobStoreBuffer<kWriteSize> blob_;
+  std::array<std::byte, kBlobDataSize> source_;
+};
+
+TEST_F(BlobStoreIncrementalEraseTest, FirstWrite_ErasesOnlyFirstSector) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  EXPECT_EQ(0u, partition_.sectors_erased);
+
+  WriteSource(writer, 0, kWriteSize, kWriteSize);
+  EXPECT_EQ(1u, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+
+  VerifyBlob(kWriteSize);
+  for (size_t sector = 1; sector < kSectorCount; ++sector) {
+    EXPECT_TRUE(SectorHasOldData(sector));
+  }
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, Write_WholePartition) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+
+  for (size_t sector = 0; sector < kSectorCount; ++sector) {
+    // Each sector is erased when the first data is written to it.
+    WriteSource(
+        writer, sector * kSectorSize, (sector + 1) * kSectorSize, kWriteSize);
+    EXPECT_EQ(sector + 1, partition_.sectors_erased);
+  }
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kBlobDataSize);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, Write_LargeChunkErasesAllSectorsItSpans) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+
+  WriteSource(writer, 0, kSectorSize + kWriteSize, kSectorSize + kWriteSize);
+  EXPECT_EQ(2u, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kSectorSize + kWriteSize);
+  EXPECT_TRUE(SectorHasOldData(2));
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, PartialFinalChunk) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+
+  WriteSource(writer, 0, kSectorSize + 10, 10);
+  EXPECT_EQ(1u, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  EXPECT_EQ(2u, partition_.sectors_erased);
+  VerifyBlob(kSectorSize + 10);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, EraseAhead) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  EXPECT_EQ(Status::FailedPrecondition(), writer.EraseAhead(1));
+  ASSERT_EQ(OkStatus(), writer.Open());
+
+  ASSERT_EQ(OkStatus(), writer.EraseAhead(2));
+  EXPECT_EQ(2u, partition_.sectors_erased);
+  EXPECT_FALSE(SectorHasOldData(1));
+  EXPECT_TRUE(SectorHasOldData(2));
+
+  // Writes to sectors that are already erased don't erase them again.
+  WriteSource(writer, 0, 2 * kSectorSize, kWriteSize);
+  EXPECT_EQ(2u, partition_.sectors_erased);
+
+  // Erasing ahead stops at the end of the partition.
+  ASSERT_EQ(OkStatus(), writer.EraseAhead(kSectorCount));
+  EXPECT_EQ(kSectorCount, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.EraseAhead(1));
+  EXPECT_EQ(kSectorCount, partition_.sectors_erased);
+
+  WriteSource(writer, 2 * kSectorSize, kBlobDataSize, kWriteSize);
+  EXPECT_EQ(kSectorCount, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kBlobDataSize);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, ExplicitErase_ErasesWholePartition) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ASSERT_EQ(OkStatus(), writer.Erase());
+  const size_t erased = partition_.sectors_erased;
+  for (size_t sector = 0; sector < kSectorCount; ++sector) {
+    EXPECT_FALSE(SectorHasOldData(sector));
+  }
+
+  WriteSource(writer, 0, kBlobDataSize, kWriteSize);
+  EXPECT_EQ(erased, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kBlobDataSize);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, NewBlob_ErasesWrittenSectorsAgain) {
+  {
+    BlobStore::BlobWriterWithBuffer writer(blob_);
+    ASSERT_EQ(OkStatus(), writer.Open());
+    WriteSource(writer, 0, kSectorSize, kWriteSize);
+    ASSERT_EQ(OkStatus(), writer.Close());
+  }
+  EXPECT_EQ(1u, partition_.sectors_erased);
+
+  // Write a different blob, with the data in reverse order.
+  std::reverse(source_.begin(), source_.end());
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  WriteSource(writer, 0, kWriteSize, kWriteSize);
+  EXPECT_EQ(2u, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kWriteSize);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, Discard_ErasesWrittenSectorsAgain) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  WriteSource(writer, 0, kWriteSize, kWriteSize);
+  ASSERT_EQ(OkStatus(), writer.Discard());
+
+  WriteSource(writer, 0, kWriteSize, kWriteSize);
+  EXPECT_EQ(2u, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kWriteSize);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, DeferredWriter_ErasesOnFlush) {
+  BlobStore::DeferredWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ASSERT_EQ(OkStatus(), writer.Write(span(source_).first(kWriteSize)));
+  EXPECT_EQ(0u, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Flush());
+  EXPECT_EQ(1u, partition_.sectors_erased);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kWriteSize);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, EraseError_FailsWrite) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  partition_.erase_status = Status::Internal();
+  EXPECT_EQ(Status::DataLoss(), writer.Write(span(source_).first(kWriteSize)));
+  EXPECT_EQ(Status::DataLoss(), writer.Write(span(source_).first(kWriteSize)));
+  EXPECT_FALSE(blob_.HasData());
+
+  // A discarded blob can be written once erasing works again.
+  partition_.erase_status = OkStatus();
+  ASSERT_EQ(OkStatus(), writer.Discard());
+  WriteSource(writer, 0, kWriteSize, kWriteSize);
+  ASSERT_EQ(OkStatus(), writer.Close());
+  VerifyBlob(kWriteSize);
+}
+
+TEST_F(BlobStoreIncrementalEraseTest, Resume_Unimplemented) {
+  BlobStore::BlobWriterWithBuffer writer(blob_);
+  EXPECT_EQ(Status::Unimplemented(), writer.Resume().status());
+  EXPECT_FALSE(writer.IsOpen());
+}
+
+}  // namespace
+}  // namespace pw::blob_store
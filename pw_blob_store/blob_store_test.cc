@@ -995,6 +995,48 @@ TEST_F(BlobStoreTest, ResumePartialAfterRebootBlob) {
   VerifyBlob(second_blob, kBlobDataSize);
 }
 
+TEST_F(BlobStoreTest, ReadCommittedDataAfterResume) {
+  InitSourceBufferToRandom(0x11309);
+
+  kvs::ChecksumCrc16 checksum;
+  constexpr size_t kBufferSize = 16;
+  BlobStoreBuffer<kBufferSize> blob(
+      "TestBlobBlock", partition_, &checksum, kvs::TestKvs(), kBufferSize);
+  EXPECT_EQ(OkStatus(), blob.Init());
+  ASSERT_GE(kSectorCount, 3U);
+
+  BlobStore::BlobWriterWithBuffer writer(blob);
+  std::array<std::byte, 64> read_buffer;
+  EXPECT_EQ(Status::FailedPrecondition(),
+            writer.ReadCommittedData(0, read_buffer).status());
+
+  EXPECT_EQ(OkStatus(), writer.Open());
+  EXPECT_EQ(OkStatus(), writer.Write(source_buffer_));
+  EXPECT_EQ(OkStatus(), writer.Abandon());
+
+  StatusWithSize resume_sws = writer.Resume();
+  ASSERT_EQ(OkStatus(), resume_sws.status());
+  ASSERT_GE(resume_sws.size(), read_buffer.size());
+
+  StatusWithSize read_sws = writer.ReadCommittedData(0, read_buffer);
+  ASSERT_EQ(OkStatus(), read_sws.status());
+  EXPECT_EQ(read_buffer.size(), read_sws.size());
+  EXPECT_EQ(0,
+            std::memcmp(
+                source_buffer_.data(), read_buffer.data(), read_sws.size()));
+
+  // Only the data kept by the resume can be read.
+  const size_t offset = resume_sws.size() - 10;
+  read_sws = writer.ReadCommittedData(offset, read_buffer);
+  ASSERT_EQ(OkStatus(), read_sws.status());
+  EXPECT_EQ(10u, read_sws.size());
+  EXPECT_EQ(0, std::memcmp(&source_buffer_[offset], read_buffer.data(), 10));
+  EXPECT_EQ(0u,
+            writer.ReadCommittedData(resume_sws.size(), read_buffer).size());
+
+  EXPECT_EQ(OkStatus(), writer.Abandon());
+}
+
 TEST_F(BlobStoreTest, ResumeAbandonBlobBackedUpToZero) {
   InitSourceBufferToRandom(0x11309);
 
@@ -0,0 +1,350 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_blob_store/compressed_blob.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_bytes/endian.h"
+#include "pw_result/result.h"
+#include "pw_status/try.h"
+#include "pw_stream/seek.h"
+
+namespace pw::blob_store {
+
+using compressed_blob::kHeaderSizeBytes;
+using compressed_blob::kMagic;
+using compressed_blob::kMaxLiteralRun;
+using compressed_blob::kMaxMatchLength;
+using compressed_blob::kMaxWindowSizeBytes;
+using compressed_blob::kMinMatchLength;
+using compressed_blob::kMinWindowSizeBytes;
+using compressed_blob::kTrailerSizeBytes;
+using compressed_blob::kVersion;
+
+namespace {
+
+constexpr std::byte kMatchFlag{0x80};
+
+// Fills all of `dest`; running out of data is DATA_LOSS.
+Status ReadExact(stream::Reader& reader, ByteSpan dest) {
+  while (!dest.empty()) {
+    Result<ByteSpan> result = reader.Read(dest);
+    if (result.status().IsOutOfRange()) {
+      return Status::DataLoss();
+    }
+    PW_TRY(result.status());
+    dest = dest.subspan(result.value().size());
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+CompressingBlobWriter::CompressingBlobWriter(BlobStore::BlobWriter& writer,
+                                             ByteSpan buffer)
+    : writer_(writer),
+      buffer_(buffer),
+      window_size_(buffer.size() > kMaxMatchLength
+                       ? std::min(buffer.size() - kMaxMatchLength,
+                                  kMaxWindowSizeBytes)
+                       : 0) {}
+
+Status CompressingBlobWriter::Open() {
+  if (window_size_ < kMinWindowSizeBytes) {
+    return Status::InvalidArgument();
+  }
+  PW_TRY(writer_.Open());
+
+  position_ = 0;
+  literal_start_ = 0;
+  end_ = 0;
+  uncompressed_size_ = 0;
+
+  std::array<std::byte, kHeaderSizeBytes> header;
+  std::memcpy(header.data(), kMagic.data(), kMagic.size());
+  header[kMagic.size()] = std::byte{kVersion};
+  const auto window_size =
+      bytes::CopyInOrder(endian::little, static_cast<uint32_t>(window_size_));
+  std::memcpy(&header[kMagic.size() + 1], window_size.data(), 4);
+  return writer_.Write(header);
+}
+
+Status CompressingBlobWriter::Close() {
+  if (!writer_.IsOpen()) {
+    return Status::FailedPrecondition();
+  }
+
+  Status status = Encode(/*flush=*/true);
+  if (status.ok()) {
+    status = writer_.Write(bytes::CopyInOrder(
+        endian::little, static_cast<uint32_t>(uncompressed_size_)));
+  }
+  if (!status.ok()) {
+    writer_.Abandon().IgnoreError();
+    return status;
+  }
+  return writer_.Close();
+}
+
+size_t CompressingBlobWriter::ConservativeLimit(LimitType limit) const {
+  if (limit != LimitType::kWrite) {
+    return 0;
+  }
+  // Incompressible data takes one extra byte per run of literals.
+  const size_t available = writer_.ConservativeWriteLimit();
+  if (available <= kTrailerSizeBytes) {
+    return 0;
+  }
+  return (available - kTrailerSizeBytes) / (kMaxLiteralRun + 1) *
+         kMaxLiteralRun;
+}
+
+Status CompressingBlobWriter::DoWrite(ConstByteSpan data) {
+  if (!writer_.IsOpen()) {
+    return Status::FailedPrecondition();
+  }
+  if (uncompressed_size_ + data.size() > UINT32_MAX) {
+    return Status::ResourceExhausted();
+  }
+
+  while (!data.empty()) {
+    if (end_ == buffer_.size()) {
+      Compact();
+    }
+    const size_t size = std::min(data.size(), buffer_.size() - end_);
+    std::memcpy(&buffer_[end_], data.data(), size);
+    end_ += size;
+    uncompressed_size_ += size;
+    data = data.subspan(size);
+    PW_TRY(Encode(/*flush=*/false));
+  }
+  return OkStatus();
+}
+
+Status CompressingBlobWriter::Encode(bool flush) {
+  while (end_ - position_ >= kMaxMatchLength ||
+         (flush && position_ < end_)) {
+    // Find the longest match in the window for the data at position_.
+    const size_t max_length = std::min(end_ - position_, kMaxMatchLength);
+    const size_t window_start =
+        position_ > window_size_ ? position_ - window_size_ : 0;
+    size_t best_length = 0;
+    size_t best_start = 0;
+    for (size_t start = window_start; start < position_; ++start) {
+      size_t length = 0;
+      while (length < max_length &&
+             buffer_[start + length] == buffer_[position_ + length]) {
+        length += 1;
+      }
+      if (length > best_length) {
+        best_length = length;
+        best_start = start;
+        if (length == max_length) {
+          break;
+        }
+      }
+    }
+
+    if (best_length < kMinMatchLength) {
+      position_ += 1;
+      if (position_ - literal_start_ == kMaxLiteralRun) {
+        PW_TRY(WriteLiterals());
+      }
+      continue;
+    }
+
+    PW_TRY(WriteLiterals());
+    const uint16_t distance = static_cast<uint16_t>(position_ - best_start - 1);
+    const std::array<std::byte, 3> token = {
+        kMatchFlag | static_cast<std::byte>(best_length - kMinMatchLength),
+        static_cast<std::byte>(distance & 0xff),
+        static_cast<std::byte>(distance >> 8),
+    };
+    PW_TRY(writer_.Write(token));
+    position_ += best_length;
+    literal_start_ = position_;
+  }
+
+  return flush ? WriteLiterals() : OkStatus();
+}
+
+Status CompressingBlobWriter::WriteLiterals() {
+  const size_t count = position_ - literal_start_;
+  if (count == 0) {
+    return OkStatus();
+  }
+  const std::byte token = static_cast<std::byte>(count - 1);
+  PW_TRY(writer_.Write(span(&token, 1)));
+  PW_TRY(writer_.Write(buffer_.subspan(literal_start_, count)));
+  literal_start_ = position_;
+  return OkStatus();
+}
+
+void CompressingBlobWriter::Compact() {
+  // Pending literals are always within the window, since runs are shorter
+  // than the smallest window.
+  const size_t keep_from =
+      position_ > window_size_ ? position_ - window_size_ : 0;
+  std::memmove(buffer_.data(), buffer_.data() + keep_from, end_ - keep_from);
+  position_ -= keep_from;
+  literal_start_ -= keep_from;
+  end_ -= keep_from;
+}
+
+Status DecompressingBlobReader::Open() {
+  PW_TRY(reader_.Open());
+
+  Status status = [this]() -> Status {
+    const size_t blob_size = reader_.ConservativeReadLimit();
+    if (blob_size < kHeaderSizeBytes + kTrailerSizeBytes) {
+      return Status::DataLoss();
+    }
+
+    std::array<std::byte, kTrailerSizeBytes> trailer;
+    PW_TRY(reader_.Seek(static_cast<ptrdiff_t>(blob_size - trailer.size())));
+    PW_TRY(ReadExact(reader_, trailer));
+    uncompressed_size_ =
+        bytes::ReadInOrder<uint32_t>(endian::little, trailer.data());
+
+    std::array<std::byte, kHeaderSizeBytes> header;
+    PW_TRY(reader_.Seek(0));
+    PW_TRY(ReadExact(reader_, header));
+    if (std::memcmp(header.data(), kMagic.data(), kMagic.size()) != 0) {
+      return Status::DataLoss();
+    }
+    if (header[kMagic.size()] != std::byte{kVersion}) {
+      return Status::Unimplemented();
+    }
+    window_size_ = bytes::ReadInOrder<uint32_t>(endian::little,
+                                                &header[kMagic.size() + 1]);
+    if (window_size_ == 0 || window_size_ > kMaxWindowSizeBytes) {
+      return Status::DataLoss();
+    }
+    if (window_size_ > window_.size()) {
+      return Status::ResourceExhausted();
+    }
+    return Restart();
+  }();
+
+  if (!status.ok()) {
+    reader_.Close().IgnoreError();
+  }
+  return status;
+}
+
+Status DecompressingBlobReader::Close() {
+  position_ = 0;
+  uncompressed_size_ = 0;
+  return reader_.Close();
+}
+
+Status DecompressingBlobReader::Restart() {
+  PW_TRY(reader_.Seek(static_cast<ptrdiff_t>(kHeaderSizeBytes)));
+  compressed_remaining_ = reader_.ConservativeReadLimit() - kTrailerSizeBytes;
+  position_ = 0;
+  token_remaining_ = 0;
+  match_distance_ = 0;
+  in_match_ = false;
+  input_position_ = 0;
+  input_size_ = 0;
+  return OkStatus();
+}
+
+Status DecompressingBlobReader::DoSeek(ptrdiff_t offset, Whence origin) {
+  if (!IsOpen()) {
+    return Status::FailedPrecondition();
+  }
+
+  size_t target = position_;
+  PW_TRY(stream::CalculateSeek(offset, origin, uncompressed_size_, target));
+  if (target < position_) {
+    PW_TRY(Restart());
+  }
+
+  // Decompress and discard data up to the new position.
+  std::array<std::byte, 16> discard;
+  while (position_ < target) {
+    PW_TRY(Decompress(
+        span(discard).first(std::min(discard.size(), target - position_))));
+  }
+  return OkStatus();
+}
+
+StatusWithSize DecompressingBlobReader::DoRead(ByteSpan dest) {
+  if (!IsOpen()) {
+    return StatusWithSize::FailedPrecondition();
+  }
+  if (position_ == uncompressed_size_) {
+    return StatusWithSize::OutOfRange();
+  }
+
+  dest = dest.first(std::min(dest.size(), uncompressed_size_ - position_));
+  PW_TRY_WITH_SIZE(Decompress(dest));
+  return StatusWithSize(dest.size());
+}
+
+Status DecompressingBlobReader::Decompress(ByteSpan dest) {
+  for (std::byte& out : dest) {
+    if (token_remaining_ == 0) {
+      std::byte token;
+      PW_TRY(ReadCompressedByte(token));
+      in_match_ = (token & kMatchFlag) != std::byte{0};
+      token_remaining_ = static_cast<size_t>(token & ~kMatchFlag);
+      if (in_match_) {
+        std::byte low;
+        std::byte high;
+        PW_TRY(ReadCompressedByte(low));
+        PW_TRY(ReadCompressedByte(high));
+        token_remaining_ += kMinMatchLength;
+        match_distance_ =
+            (static_cast<size_t>(high) << 8 | static_cast<size_t>(low)) + 1;
+        if (match_distance_ > position_ || match_distance_ > window_size_) {
+          return Status::DataLoss();
+        }
+      } else {
+        token_remaining_ += 1;
+      }
+    }
+
+    if (in_match_) {
+      out = window_[(position_ - match_distance_) % window_size_];
+    } else {
+      PW_TRY(ReadCompressedByte(out));
+    }
+    window_[position_ % window_size_] = out;
+    position_ += 1;
+    token_remaining_ -= 1;
+  }
+  return OkStatus();
+}
+
+Status DecompressingBlobReader::ReadCompressedByte(std::byte& out) {
+  if (input_position_ == input_size_) {
+    if (compressed_remaining_ == 0) {
+      return Status::DataLoss();
+    }
+    const size_t size = std::min(input_.size(), compressed_remaining_);
+    PW_TRY(ReadExact(reader_, span(input_).first(size)));
+    compressed_remaining_ -= size;
+    input_position_ = 0;
+    input_size_ = size;
+  }
+  out = input_[input_position_++];
+  return OkStatus();
+}
+
+}  // namespace pw::blob_store
@@ -0,0 +1,224 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_blob_store/compressed_blob.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_blob_store/blob_store.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/test_key_value_store.h"
+#include "pw_random/xor_shift.h"
+#include "pw_span/span.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::blob_store {
+namespace {
+
+using compressed_blob::kHeaderSizeBytes;
+using compressed_blob::kMaxLiteralRun;
+using compressed_blob::kMaxMatchLength;
+using compressed_blob::kTrailerSizeBytes;
+
+class CompressedBlobTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kFlashAlignment = 16;
+  static constexpr size_t kSectorSize = 1024;
+  static constexpr size_t kSectorCount = 8;
+  static constexpr size_t kDataSize = 3000;
+  static constexpr size_t kWindowSize = 256;
+
+  CompressedBlobTest()
+      : flash_(kFlashAlignment),
+        partition_(&flash_),
+        blob_("CompressedBlob", partition_, nullptr, kvs::TestKvs(), 64) {}
+
+  void SetUp() override { ASSERT_EQ(OkStatus(), blob_.Init()); }
+
+  // Fills data_ with text-like data that has plenty of repeats.
+  void FillCompressible() {
+    constexpr char kWords[][9] = {
+        "sensor ", "reading ", "ok ", "error ", "value ", "=", "42 ", "\n"};
+    random::XorShiftStarRng64 rng(0x5eed);
+    size_t offset = 0;
+    while (offset < data_.size()) {
+      uint8_t pick;
+      rng.GetInt(pick);
+      const char* word = kWords[pick % std::size(kWords)];
+      for (size_t i = 0; word[i] != '\0' && offset < data_.size(); ++i) {
+        data_[offset++] = static_cast<std::byte>(word[i]);
+      }
+    }
+  }
+
+  void FillRandom() {
+    random::XorShiftStarRng64 rng(0xabcdef);
+    rng.Get(data_);
+  }
+
+  // Writes `data` to the blob through a CompressingBlobWriter.
+  void WriteCompressed(ConstByteSpan data, size_t chunk_size) {
+    BlobStore::BlobWriterWithBuffer<0> writer(blob_);
+    std::array<std::byte, kWindowSize + kMaxMatchLength> buffer;
+    CompressingBlobWriter compressor(writer, buffer);
+    ASSERT_EQ(OkStatus(), compressor.Open());
+    EXPECT_EQ(compressor.window_size(), kWindowSize);
+    while (!data.empty()) {
+      const size_t size = std::min(chunk_size, data.size());
+      ASSERT_EQ(OkStatus(), compressor.Write(data.first(size)));
+      data = data.subspan(size);
+    }
+    ASSERT_EQ(OkStatus(), compressor.Close());
+  }
+
+  // Reads the whole decompressed blob in chunks and checks it against `data`.
+  void ExpectContents(ConstByteSpan data, size_t chunk_size) {
+    BlobStore::BlobReader reader(blob_);
+    std::array<std::byte, kWindowSize> window;
+    DecompressingBlobReader decompressor(reader, window);
+    ASSERT_EQ(OkStatus(), decompressor.Open());
+    EXPECT_EQ(decompressor.uncompressed_size(), data.size());
+
+    std::array<std::byte, kDataSize> read_buffer{};
+    size_t offset = 0;
+    while (offset < data.size()) {
+      EXPECT_EQ(decompressor.ConservativeReadLimit(), data.size() - offset);
+      const size_t size = std::min(chunk_size, data.size() - offset);
+      auto result = decompressor.Read(span(read_buffer).subspan(offset, size));
+      ASSERT_EQ(OkStatus(), result.status());
+      ASSERT_EQ(result.value().size(), size);
+      offset += size;
+    }
+    EXPECT_EQ(decompressor.ConservativeReadLimit(), 0u);
+    EXPECT_EQ(decompressor.Read(read_buffer).status(), Status::OutOfRange());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), read_buffer.begin()));
+    EXPECT_EQ(OkStatus(), decompressor.Close());
+  }
+
+  size_t StoredSize() {
+    BlobStore::BlobReader reader(blob_);
+    EXPECT_EQ(OkStatus(), reader.Open());
+    const size_t size = reader.ConservativeReadLimit();
+    EXPECT_EQ(OkStatus(), reader.Close());
+    return size;
+  }
+
+  kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash_;
+  kvs::FlashPartition partition_;
+  BlobStoreBuffer<64> blob_;
+  std::array<std::byte, kDataSize> data_{};
+};
+
+TEST_F(CompressedBlobTest, CompressibleDataRoundTrips) {
+  FillCompressible();
+  WriteCompressed(data_, 100);
+  EXPECT_LT(StoredSize(), kDataSize / 2);
+  ExpectContents(data_, 100);
+}
+
+TEST_F(CompressedBlobTest, IncompressibleDataGrowsOnlySlightly) {
+  FillRandom();
+  WriteCompressed(data_, 100);
+  EXPECT_LE(StoredSize(),
+            kHeaderSizeBytes + kDataSize + kDataSize / kMaxLiteralRun + 1 +
+                kTrailerSizeBytes);
+  ExpectContents(data_, 100);
+}
+
+TEST_F(CompressedBlobTest, RepeatedByteCompressesToLongMatches) {
+  std::fill(data_.begin(), data_.end(), std::byte{0xff});
+  WriteCompressed(data_, kDataSize);
+  // One literal, then matches that overlap the data they produce.
+  EXPECT_LE(StoredSize(),
+            kHeaderSizeBytes + 2 + 3 * (kDataSize / kMaxMatchLength + 1) +
+                kTrailerSizeBytes);
+  ExpectContents(data_, kDataSize);
+}
+
+TEST_F(CompressedBlobTest, SmallWritesAndReads) {
+  FillCompressible();
+  WriteCompressed(data_, 1);
+  ExpectContents(data_, 1);
+  ExpectContents(data_, 7);
+}
+
+TEST_F(CompressedBlobTest, EmptyBlob) {
+  WriteCompressed(ConstByteSpan(), 1);
+  EXPECT_EQ(StoredSize(), kHeaderSizeBytes + kTrailerSizeBytes);
+  ExpectContents(ConstByteSpan(), 1);
+}
+
+TEST_F(CompressedBlobTest, Seek) {
+  FillCompressible();
+  WriteCompressed(data_, 256);
+
+  BlobStore::BlobReader reader(blob_);
+  std::array<std::byte, kWindowSize> window;
+  DecompressingBlobReader decompressor(reader, window);
+  ASSERT_EQ(OkStatus(), decompressor.Open());
+
+  std::array<std::byte, 32> read_buffer;
+  for (size_t offset : {1000u, 2900u, 10u, 0u, 1500u}) {
+    ASSERT_EQ(OkStatus(), decompressor.Seek(static_cast<ptrdiff_t>(offset)));
+    EXPECT_EQ(decompressor.Tell(), offset);
+    ASSERT_EQ(OkStatus(), decompressor.Read(read_buffer).status());
+    EXPECT_EQ(std::memcmp(read_buffer.data(), &data_[offset], 32), 0);
+  }
+
+  ASSERT_EQ(OkStatus(), decompressor.Seek(-8, stream::Stream::kEnd));
+  EXPECT_EQ(decompressor.Tell(), kDataSize - 8);
+  EXPECT_EQ(decompressor.Seek(1, stream::Stream::kEnd), Status::OutOfRange());
+  EXPECT_EQ(OkStatus(), decompressor.Close());
+}
+
+TEST_F(CompressedBlobTest, WriterBufferTooSmall) {
+  BlobStore::BlobWriterWithBuffer<0> writer(blob_);
+  std::array<std::byte, compressed_blob::kMinWriterBufferSizeBytes - 1> buffer;
+  CompressingBlobWriter compressor(writer, buffer);
+  EXPECT_EQ(compressor.Open(), Status::InvalidArgument());
+  EXPECT_FALSE(writer.IsOpen());
+}
+
+TEST_F(CompressedBlobTest, ReaderWindowTooSmall) {
+  FillCompressible();
+  WriteCompressed(data_, 100);
+
+  BlobStore::BlobReader reader(blob_);
+  std::array<std::byte, kWindowSize - 1> window;
+  DecompressingBlobReader decompressor(reader, window);
+  EXPECT_EQ(decompressor.Open(), Status::ResourceExhausted());
+  EXPECT_FALSE(reader.IsOpen());
+}
+
+TEST_F(CompressedBlobTest, UncompressedBlobIsDataLoss) {
+  FillRandom();
+  BlobStore::BlobWriterWithBuffer<0> writer(blob_);
+  ASSERT_EQ(OkStatus(), writer.Open());
+  ASSERT_EQ(OkStatus(), writer.Write(data_));
+  ASSERT_EQ(OkStatus(), writer.Close());
+
+  BlobStore::BlobReader reader(blob_);
+  std::array<std::byte, kWindowSize> window;
+  DecompressingBlobReader decompressor(reader, window);
+  EXPECT_EQ(decompressor.Open(), Status::DataLoss());
+  EXPECT_FALSE(reader.IsOpen());
+}
+
+}  // namespace
+}  // namespace pw::blob_store
@@ -55,6 +55,21 @@ namespace pw::blob_store {
 //  3) BlobReader::Close().
 class BlobStore {
  public:
+  // How the partition is erased when a new blob is written.
+  enum class EraseMode {
+    // The whole partition is erased when the first data of a blob is written,
+    // unless it was already erased.
+    kFullPartition,
+
+    // Each sector is erased just before data is first written to it, so the
+    // first write doesn't wait for the whole partition to be erased. Sectors
+    // can also be erased ahead of the data with BlobWriter::EraseAhead().
+    //
+    // The partition after the end of the blob is not erased, so writes can't
+    // be resumed with BlobWriter::Resume().
+    kIncremental,
+  };
+
   // Implement the stream::Writer and erase interface for a BlobStore. If not
   // already erased, the Write will do any needed erase.
   //
@@ -123,6 +138,7 @@ class BlobStore {
     //   OK, size - Number of bytes already written in the resumed blob write.
     //   UNAVAILABLE - Unable to resume, another writer or reader instance is
     //     already open.
+    //   UNIMPLEMENTED - The BlobStore uses EraseMode::kIncremental.
     StatusWithSize Resume();
 
     // Finalize a completed blob write and change the writer state to closed.
@@ -165,6 +181,21 @@ class BlobStore {
       return open_ ? store_.Erase() : Status::FailedPrecondition();
     }
 
+    // Erase up to max_sectors sectors after those that are already erased, so
+    // that later writes don't wait for them to be erased. This can be called
+    // while waiting for more data, to spread out the erase of the partition.
+    // With EraseMode::kFullPartition, this erases the whole partition if it
+    // is not already erased. Returns:
+    //
+    // OK - success, or the rest of the partition is already erased.
+    // FAILED_PRECONDITION - not open.
+    // DATA_LOSS - a previous write failed.
+    // [error status] - flash erase failed.
+    Status EraseAhead(size_t max_sectors) {
+      return open_ ? store_.EraseAhead(max_sectors)
+                   : Status::FailedPrecondition();
+    }
+
     // Discard the current blob write and keep the writer in the opened state,
     // ready to start a new/clean blob write. Any written bytes to this point
     // are considered invalid and discarded.
@@ -213,6 +244,16 @@ class BlobStore {
       return open_ ? store_.write_address_ : 0;
     }
 
+    // Reads data of the current write session that has been committed to
+    // flash, e.g. to check the data that Resume() kept. Data that is still
+    // buffered is not read. Returns:
+    //
+    //   OK, size - Number of bytes read. Fewer than dest.size() bytes are read
+    //       if fewer than that are committed after offset.
+    //   FAILED_PRECONDITION - not open.
+    //   [error status] - flash read failed.
+    StatusWithSize ReadCommittedData(size_t offset, ByteSpan dest) const;
+
     // Get the current running checksum for the current write session.
     //
     // Returns:
@@ -426,18 +467,21 @@ class BlobStore {
   //     This should be chosen to balance optimal write size and required buffer
   //     size. Must be greater than or equal to flash write alignment, less than
   //     or equal to flash sector size.
+  // erase_mode - How the partition is erased for a new blob.
   BlobStore(std::string_view name,
             kvs::FlashPartition& partition,
             kvs::ChecksumAlgorithm* checksum_algo,
             sync::Borrowable<kvs::KeyValueStore> kvs,
             ByteSpan write_buffer,
-            size_t flash_write_size_bytes)
+            size_t flash_write_size_bytes,
+            EraseMode erase_mode = EraseMode::kFullPartition)
       : name_(name),
         partition_(partition),
         checksum_algo_(checksum_algo),
         kvs_(kvs),
         write_buffer_(write_buffer),
         flash_write_size_bytes_(flash_write_size_bytes),
+        erase_mode_(erase_mode),
         initialized_(false),
         valid_data_(false),
         flash_erased_(false),
@@ -445,6 +489,7 @@ class BlobStore {
         readers_open_(0),
         write_address_(0),
         flash_address_(0),
+        erased_address_(0),
         file_name_length_(0) {}
 
   BlobStore(const BlobStore&) = delete;
@@ -575,6 +620,13 @@ class BlobStore {
 
   Status EraseIfNeeded();
 
+  // Erases sectors after erased_address_ until the flash is erased up to at
+  // least end_address.
+  Status EraseThrough(size_t end_address);
+
+  // Erases up to max_sectors sectors after erased_address_.
+  Status EraseAhead(size_t max_sectors);
+
   // Read valid data. Attempts to read the lesser of output.size_bytes() or
   // available bytes worth of data. Returns:
   //
@@ -643,6 +695,8 @@ class BlobStore {
   // alignment, LE flash sector size.
   const size_t flash_write_size_bytes_;
 
+  const EraseMode erase_mode_;
+
   //
   // Internal state for Blob store
   //
@@ -672,6 +726,11 @@ class BlobStore {
   // bytes is write_address_ - flash_address_.
   kvs::FlashPartition::Address flash_address_;
 
+  // End of the erased flash after flash_address_. Always on a sector boundary.
+  // Only tracked for EraseMode::kIncremental; the full partition erase sets it
+  // to the end of the partition.
+  kvs::FlashPartition::Address erased_address_;
+
   // Length of the stored blob's filename.
   size_t file_name_length_;
 };
@@ -691,6 +750,7 @@ class BlobStore {
 //     This should be chosen to balance optimal write size and required buffer
 //     size. Must be greater than or equal to flash write alignment, less than
 //     or equal to flash sector size.
+// erase_mode - How the partition is erased for a new blob.
 
 template <size_t kBufferSizeBytes>
 class BlobStoreBuffer : public BlobStore {
@@ -699,13 +759,15 @@ class BlobStoreBuffer : public BlobStore {
                            kvs::FlashPartition& partition,
                            kvs::ChecksumAlgorithm* checksum_algo,
                            sync::Borrowable<kvs::KeyValueStore> kvs,
-                           size_t flash_write_size_bytes)
+                           size_t flash_write_size_bytes,
+                           EraseMode erase_mode = EraseMode::kFullPartition)
       : BlobStore(name,
                   partition,
                   checksum_algo,
                   kvs,
                   buffer_,
-                  flash_write_size_bytes) {}
+                  flash_write_size_bytes,
+                  erase_mode) {}
 
  private:
   std::array<std::byte, kBufferSizeBytes> buffer_;
@@ -0,0 +1,202 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_blob_store/blob_store.h"
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+
+namespace pw::blob_store {
+
+// Compressed blobs store their contents with a small LZ77 codec, chosen for
+// its tiny RAM footprint rather than its ratio. A CompressingBlobWriter
+// compresses data on the fly as it is written to a BlobStore, and a
+// DecompressingBlobReader streams the original contents back.
+//
+// The codec's window is sized by the buffers the writer and reader are given.
+// Data compresses better with a larger window, and the reader's buffer must be
+// at least as large as the window the blob was written with.
+//
+// Compressed blob format:
+//
+//   header:   "PWLZ", version (1 byte), window size (4 bytes, little endian)
+//   tokens:   0b0nnnnnnn: a run of n + 1 literal bytes follows
+//             0b1nnnnnnn: copy n + kMinMatchLength bytes from
+//                         (next 2 bytes, little endian) + 1 bytes back
+//   trailer:  uncompressed size (4 bytes, little endian)
+namespace compressed_blob {
+
+inline constexpr std::array<std::byte, 4> kMagic = {
+    std::byte{'P'}, std::byte{'W'}, std::byte{'L'}, std::byte{'Z'}};
+inline constexpr uint8_t kVersion = 1;
+inline constexpr size_t kHeaderSizeBytes = kMagic.size() + 1 + 4;
+inline constexpr size_t kTrailerSizeBytes = 4;
+
+inline constexpr size_t kMaxLiteralRun = 128;
+inline constexpr size_t kMinMatchLength = 4;
+inline constexpr size_t kMaxMatchLength = kMinMatchLength + 127;
+inline constexpr size_t kMaxWindowSizeBytes = 1 << 16;
+
+// The window must hold a full literal run; the writer additionally needs room
+// to look ahead for a match.
+inline constexpr size_t kMinWindowSizeBytes = kMaxLiteralRun;
+inline constexpr size_t kMinWriterBufferSizeBytes =
+    kMinWindowSizeBytes + kMaxMatchLength;
+
+}  // namespace compressed_blob
+
+// Compresses data written to it into a blob. The blob is opened and closed
+// through the CompressingBlobWriter rather than the BlobWriter it wraps.
+//
+// `buffer` holds the compression window followed by room to look ahead for
+// matches; the window is `buffer.size() - kMaxMatchLength` bytes, up to
+// kMaxWindowSizeBytes. Finding matches searches the whole window, so larger
+// windows also take more CPU per byte.
+class CompressingBlobWriter final : public stream::NonSeekableWriter {
+ public:
+  CompressingBlobWriter(BlobStore::BlobWriter& writer, ByteSpan buffer);
+
+  CompressingBlobWriter(const CompressingBlobWriter&) = delete;
+  CompressingBlobWriter& operator=(const CompressingBlobWriter&) = delete;
+
+  // Opens the underlying writer and starts a new compressed blob. Returns:
+  //
+  //   OK - success.
+  //   INVALID_ARGUMENT - The buffer is smaller than kMinWriterBufferSizeBytes.
+  //
+  // Other errors are from BlobWriter::Open().
+  Status Open();
+
+  // Compresses any buffered data, then finishes and closes the blob. Returns
+  // any error from writing the remaining data or from BlobWriter::Close().
+  Status Close();
+
+  bool IsOpen() const { return writer_.IsOpen(); }
+
+  // The number of bytes written to the blob before compression.
+  size_t uncompressed_size() const { return uncompressed_size_; }
+
+  size_t window_size() const { return window_size_; }
+
+ private:
+  Status DoWrite(ConstByteSpan data) override;
+
+  size_t ConservativeLimit(LimitType limit) const override;
+
+  // Encodes buffered data, keeping enough unencoded data to find a full
+  // length match unless flushing.
+  Status Encode(bool flush);
+
+  // Drops data from the front of the buffer that is outside of the window.
+  void Compact();
+
+  Status WriteLiterals();
+
+  BlobStore::BlobWriter& writer_;
+  ByteSpan buffer_;
+  size_t window_size_;
+
+  // Data in buffer_ before position_ is encoded; data from position_ to end_
+  // is waiting to be encoded. Literals from literal_start_ to position_ are
+  // waiting to be written as a single run.
+  size_t position_ = 0;
+  size_t literal_start_ = 0;
+  size_t end_ = 0;
+  size_t uncompressed_size_ = 0;
+};
+
+// Reads back the original contents of a blob written by a
+// CompressingBlobWriter.
+//
+// `window_buffer` holds recently decompressed data, and must be at least as
+// large as the window the blob was written with. Seeking forward decompresses
+// and discards data up to the new position; seeking backward starts over from
+// the beginning of the blob.
+class DecompressingBlobReader final : public stream::SeekableReader {
+ public:
+  DecompressingBlobReader(BlobStore::BlobReader& reader,
+                          ByteSpan window_buffer)
+      : reader_(reader), window_(window_buffer) {}
+
+  DecompressingBlobReader(const DecompressingBlobReader&) = delete;
+  DecompressingBlobReader& operator=(const DecompressingBlobReader&) = delete;
+
+  // Opens the underlying reader and checks the compressed blob. Returns:
+  //
+  //   OK - success.
+  //   DATA_LOSS - The blob is not a valid compressed blob.
+  //   UNIMPLEMENTED - The blob uses an unsupported format version.
+  //   RESOURCE_EXHAUSTED - The window buffer is smaller than the blob's window.
+  //
+  // Other errors are from BlobReader::Open().
+  Status Open();
+
+  Status Close();
+
+  bool IsOpen() const { return reader_.IsOpen(); }
+
+  // The size of the blob's contents after decompression.
+  size_t uncompressed_size() const { return uncompressed_size_; }
+
+ private:
+  size_t ConservativeLimit(LimitType limit) const override {
+    return limit == LimitType::kRead && IsOpen()
+               ? uncompressed_size_ - position_
+               : 0;
+  }
+
+  size_t DoTell() override { return position_; }
+
+  Status DoSeek(ptrdiff_t offset, Whence origin) override;
+
+  StatusWithSize DoRead(ByteSpan dest) override;
+
+  // Goes back to the first token of the blob.
+  Status Restart();
+
+  // Decompresses into `dest`, which must not extend past the end of the data.
+  Status Decompress(ByteSpan dest);
+
+  Status ReadCompressedByte(std::byte& out);
+
+  BlobStore::BlobReader& reader_;
+  ByteSpan window_;
+  size_t window_size_ = 0;
+  size_t uncompressed_size_ = 0;
+
+  // Position in the uncompressed data.
+  size_t position_ = 0;
+
+  // Compressed token bytes that have not been read from the blob yet.
+  size_t compressed_remaining_ = 0;
+
+  // The token being decompressed.
+  size_t token_remaining_ = 0;
+  size_t match_distance_ = 0;
+  bool in_match_ = false;
+
+  // Buffers compressed data read from the blob.
+  std::array<std::byte, 16> input_;
+  size_t input_position_ = 0;
+  size_t input_size_ = 0;
+};
+
+}  // namespace pw::blob_store
@@ -118,6 +118,7 @@ MethodType GetMethodType(OpCode opcode) {
       return MethodType::kResponse;
 
     case kNotification:
+    case kMultipleHandleValueNotification:
       return MethodType::kNotification;
     case kIndication:
       return MethodType::kIndication;
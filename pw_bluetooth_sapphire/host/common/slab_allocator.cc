@@ -14,16 +14,115 @@
 
 #include "pw_bluetooth_sapphire/internal/host/common/slab_allocator.h"
 
+#include <atomic>
 #include <memory>
 
+#include "pw_allocator/chunk_pool.h"
+#include "pw_bluetooth_sapphire/config.h"
 #include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
 #include "pw_bluetooth_sapphire/internal/host/common/slab_buffer.h"
+#include "pw_toolchain/no_destructor.h"
 
 namespace bt {
+namespace {
+
+// A fixed number of chunks that each hold a |T|, with usage statistics.
+template <typename T, size_t kNumBuffers>
+class BufferPool {
+ public:
+  // Returns nullptr if the pool is exhausted.
+  void* Allocate() {
+    void* ptr = chunks_.Allocate(pw::allocator::Layout::Of<T>());
+    if (ptr == nullptr) {
+      exhausted_count_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    const size_t in_use = in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t max_in_use = max_in_use_.load(std::memory_order_relaxed);
+    while (in_use > max_in_use &&
+           !max_in_use_.compare_exchange_weak(
+               max_in_use, in_use, std::memory_order_relaxed)) {
+    }
+    return ptr;
+  }
+
+  void Deallocate(void* ptr) {
+    chunks_.Deallocate(ptr, pw::allocator::Layout::Of<T>());
+    in_use_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  BufferPoolStats stats() const {
+    return BufferPoolStats{
+        .buffer_size = T::kBackingSize,
+        .num_buffers = kNumBuffers,
+        .in_use = in_use_.load(std::memory_order_relaxed),
+        .max_in_use = max_in_use_.load(std::memory_order_relaxed),
+        .exhausted_count = exhausted_count_.load(std::memory_order_relaxed),
+    };
+  }
+
+ private:
+  pw::allocator::TypedPool<T, kNumBuffers> chunks_;
+  std::atomic<size_t> in_use_{0};
+  std::atomic<size_t> max_in_use_{0};
+  std::atomic<size_t> exhausted_count_{0};
+};
+
+// A SlabBuffer that lives in a BufferPool. Deleting it through a
+// MutableByteBufferPtr returns its memory to the pool.
+template <size_t BackingBufferSize, size_t kNumBuffers>
+class PooledBuffer final : public SlabBuffer<BackingBufferSize> {
+ public:
+  static constexpr size_t kBackingSize = BackingBufferSize;
+
+  explicit PooledBuffer(size_t size) : SlabBuffer<BackingBufferSize>(size) {}
+
+  // Returns nullptr, so that the new-expression also yields nullptr, when the
+  // pool is exhausted.
+  static void* operator new(size_t) noexcept { return pool().Allocate(); }
+  static void operator delete(void* ptr) { pool().Deallocate(ptr); }
+
+  // The pool is never destroyed, so buffers may outlive static destructors.
+  static BufferPool<PooledBuffer, kNumBuffers>& pool() {
+    static pw::NoDestructor<BufferPool<PooledBuffer, kNumBuffers>> pool;
+    return *pool;
+  }
+};
+
+using SmallBuffer =
+    PooledBuffer<kSmallBufferSize, PW_BLUETOOTH_SAPPHIRE_SMALL_BUFFER_COUNT>;
+using LargeBuffer =
+    PooledBuffer<kLargeBufferSize, PW_BLUETOOTH_SAPPHIRE_LARGE_BUFFER_COUNT>;
+
+template <typename Buffer>
+MutableByteBufferPtr NewPooledBuffer(size_t size) {
+  if (MutableByteBuffer* buffer = new Buffer(size); buffer != nullptr) {
+    return MutableByteBufferPtr(buffer);
+  }
+  return std::make_unique<DynamicByteBuffer>(size);
+}
+
+}  // namespace
 
 MutableByteBufferPtr NewBuffer(size_t size) {
-  // TODO(fxbug.dev/42058160): Use Pigweed's slab allocator
+  if (size == 0) {
+    return std::make_unique<DynamicByteBuffer>();
+  }
+  if constexpr (PW_BLUETOOTH_SAPPHIRE_SMALL_BUFFER_COUNT > 0) {
+    if (size <= kSmallBufferSize) {
+      return NewPooledBuffer<SmallBuffer>(size);
+    }
+  }
+  if constexpr (PW_BLUETOOTH_SAPPHIRE_LARGE_BUFFER_COUNT > 0) {
+    if (size <= kLargeBufferSize) {
+      return NewPooledBuffer<LargeBuffer>(size);
+    }
+  }
   return std::make_unique<DynamicByteBuffer>(size);
 }
 
+BufferPoolStats SmallBufferPoolStats() { return SmallBuffer::pool().stats(); }
+
+BufferPoolStats LargeBufferPoolStats() { return LargeBuffer::pool().stats(); }
+
 }  // namespace bt
@@ -14,6 +14,8 @@
 
 #include "pw_bluetooth_sapphire/internal/host/common/slab_allocator.h"
 
+#include <vector>
+
 #include "pw_unit_test/framework.h"
 
 namespace bt {
@@ -45,5 +47,67 @@ TEST(SlabAllocatorTest, NewBuffer) {
   EXPECT_EQ(0U, buffer->size());
 }
 
+TEST(SlabAllocatorTest, PooledBuffersReturnToPool) {
+  const BufferPoolStats before = SmallBufferPoolStats();
+  EXPECT_EQ(kSmallBufferSize, before.buffer_size);
+  if (before.num_buffers == 0) {
+    GTEST_SKIP() << "Small buffer pool is disabled";
+  }
+
+  auto buffer = NewBuffer(kSmallBufferSize / 2);
+  ASSERT_TRUE(buffer);
+  buffer->Fill(0xAB);
+  EXPECT_EQ(before.in_use + 1, SmallBufferPoolStats().in_use);
+  EXPECT_EQ(before.in_use, LargeBufferPoolStats().in_use);
+
+  buffer.reset();
+  EXPECT_EQ(before.in_use, SmallBufferPoolStats().in_use);
+  EXPECT_GE(SmallBufferPoolStats().max_in_use, before.in_use + 1);
+}
+
+TEST(SlabAllocatorTest, LargeBuffersUseLargePool) {
+  const BufferPoolStats before = LargeBufferPoolStats();
+  EXPECT_EQ(kLargeBufferSize, before.buffer_size);
+  if (before.num_buffers == 0) {
+    GTEST_SKIP() << "Large buffer pool is disabled";
+  }
+
+  auto buffer = NewBuffer(kSmallBufferSize + 1);
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(kSmallBufferSize + 1, buffer->size());
+  EXPECT_EQ(before.in_use + 1, LargeBufferPoolStats().in_use);
+
+  auto oversized = NewBuffer(kLargeBufferSize + 1);
+  ASSERT_TRUE(oversized);
+  EXPECT_EQ(before.in_use + 1, LargeBufferPoolStats().in_use);
+}
+
+TEST(SlabAllocatorTest, ExhaustedPoolFallsBackToHeap) {
+  const BufferPoolStats before = SmallBufferPoolStats();
+  std::vector<MutableByteBufferPtr> buffers;
+  for (size_t i = before.in_use; i < before.num_buffers; ++i) {
+    buffers.push_back(NewBuffer(kSmallBufferSize));
+    ASSERT_TRUE(buffers.back());
+  }
+  EXPECT_EQ(before.num_buffers, SmallBufferPoolStats().in_use);
+  EXPECT_EQ(before.exhausted_count, SmallBufferPoolStats().exhausted_count);
+
+  auto extra = NewBuffer(kSmallBufferSize);
+  ASSERT_TRUE(extra);
+  EXPECT_EQ(kSmallBufferSize, extra->size());
+  extra->Fill(0xCD);
+  EXPECT_EQ(before.num_buffers, SmallBufferPoolStats().in_use);
+
+  if (before.num_buffers != 0) {
+    EXPECT_EQ(before.exhausted_count + 1,
+              SmallBufferPoolStats().exhausted_count);
+  }
+
+  buffers.clear();
+  extra.reset();
+  EXPECT_EQ(before.in_use, SmallBufferPoolStats().in_use);
+  EXPECT_EQ(before.num_buffers, SmallBufferPoolStats().max_in_use);
+}
+
 }  // namespace
 }  // namespace bt
@@ -23,6 +23,10 @@ namespace {
 constexpr const char* kInspectPeerIdPropertyName = "peer_id";
 constexpr const char* kInspectPeerAddressPropertyName = "peer_address";
 constexpr const char* kInspectRefsPropertyName = "ref_count";
+constexpr const char* kInspectMaxTxOctetsPropertyName = "max_tx_octets";
+constexpr const char* kInspectMaxRxOctetsPropertyName = "max_rx_octets";
+constexpr const char* kInspectTxPhyPropertyName = "tx_phy";
+constexpr const char* kInspectRxPhyPropertyName = "rx_phy";
 
 // Connection parameters to use when the peer's preferred connection parameters
 // are not known.
@@ -119,6 +123,8 @@ LowEnergyConnection::LowEnergyConnection(
 
 LowEnergyConnection::~LowEnergyConnection() {
   cmd_->RemoveEventHandler(conn_update_cmpl_handler_id_);
+  cmd_->RemoveEventHandler(data_length_change_handler_id_);
+  cmd_->RemoveEventHandler(phy_update_cmpl_handler_id_);
 
   // Unregister this link from the GATT profile and the L2CAP plane. This
   // invalidates all L2CAP channels that are associated with this link.
@@ -263,6 +269,7 @@ void LowEnergyConnection::OnInterrogationComplete() {
   BT_ASSERT(!interrogation_completed_);
   interrogation_completed_ = true;
   MaybeUpdateConnectionParameters();
+  MaybeMaximizeThroughput();
 }
 
 void LowEnergyConnection::AttachInspect(inspect::Node& parent,
@@ -274,6 +281,10 @@ void LowEnergyConnection::AttachInspect(inspect::Node& parent,
       kInspectPeerAddressPropertyName,
       link_.get() ? link_->peer_address().ToString() : "");
   refs_.AttachInspect(inspect_node_, kInspectRefsPropertyName);
+  max_tx_octets_.AttachInspect(inspect_node_, kInspectMaxTxOctetsPropertyName);
+  max_rx_octets_.AttachInspect(inspect_node_, kInspectMaxRxOctetsPropertyName);
+  tx_phy_.AttachInspect(inspect_node_, kInspectTxPhyPropertyName);
+  rx_phy_.AttachInspect(inspect_node_, kInspectRxPhyPropertyName);
 }
 
 void LowEnergyConnection::StartConnectionPauseTimeout() {
@@ -295,6 +306,24 @@ void LowEnergyConnection::RegisterEventHandlers() {
         }
         return hci::CommandChannel::EventCallbackResult::kRemove;
       });
+  data_length_change_handler_id_ = cmd_->AddLEMetaEventHandler(
+      hci_spec::kLEDataLengthChangeSubeventCode,
+      [self](const hci::EmbossEventPacket& event) {
+        if (self.is_alive()) {
+          self->OnLEDataLengthChange(event);
+          return hci::CommandChannel::EventCallbackResult::kContinue;
+        }
+        return hci::CommandChannel::EventCallbackResult::kRemove;
+      });
+  phy_update_cmpl_handler_id_ = cmd_->AddLEMetaEventHandler(
+      hci_spec::kLEPHYUpdateCompleteSubeventCode,
+      [self](const hci::EmbossEventPacket& event) {
+        if (self.is_alive()) {
+          self->OnLEPhyUpdateComplete(event);
+          return hci::CommandChannel::EventCallbackResult::kContinue;
+        }
+        return hci::CommandChannel::EventCallbackResult::kRemove;
+      });
 }
 
 // Connection parameter updates by the peripheral are not allowed until the
@@ -608,6 +637,135 @@ void LowEnergyConnection::OnLEConnectionUpdateComplete(
   peer_->MutLe().SetConnectionParameters(params);
 }
 
+void LowEnergyConnection::MaybeMaximizeThroughput() {
+  if (!connection_options_.maximize_throughput) {
+    return;
+  }
+
+  BT_ASSERT(peer_.is_alive());
+  BT_ASSERT(peer_->le()->features().has_value());
+
+  // TODO(fxbug.dev/42126713): check local controller support for these
+  // features (mask is currently in Adapter le state, consider propagating
+  // down). Controllers that do not support them reject the commands.
+  const uint64_t le_features = peer_->le()->features()->le_features;
+  if (le_features &
+      static_cast<uint64_t>(
+          hci_spec::LESupportedFeature::kLEDataPacketLengthExtension)) {
+    RequestMaxDataLength();
+  }
+  if (le_features &
+      static_cast<uint64_t>(hci_spec::LESupportedFeature::kLE2MPHY)) {
+    Request2mPhy();
+  }
+}
+
+void LowEnergyConnection::RequestMaxDataLength() {
+  bt_log(DEBUG,
+         "gap-le",
+         "requesting maximum data length (peer: %s)",
+         bt_str(peer_id()));
+  auto command = hci::EmbossCommandPacket::New<
+      pw::bluetooth::emboss::LESetDataLengthCommandWriter>(
+      hci_spec::kLESetDataLength);
+  auto view = command.view_t();
+  view.connection_handle().Write(handle());
+  view.tx_octets().Write(hci_spec::kLEMaxTxOctetsMax);
+  view.tx_time().Write(hci_spec::kLEMaxTxTimeMax);
+
+  // The resulting data length is reported by the HCI LE Data Length Change
+  // event, which is only generated if the data length changes.
+  auto complete_cb = [handle = handle()](auto id,
+                                         const hci::EventPacket& event) {
+    hci_is_error(event,
+                 WARN,
+                 "gap-le",
+                 "controller rejected data length (handle: %#.4x)",
+                 handle);
+  };
+  cmd_->SendCommand(std::move(command), std::move(complete_cb));
+}
+
+void LowEnergyConnection::Request2mPhy() {
+  bt_log(DEBUG, "gap-le", "requesting LE 2M PHY (peer: %s)", bt_str(peer_id()));
+  auto command = hci::EmbossCommandPacket::New<
+      pw::bluetooth::emboss::LESetPHYCommandWriter>(hci_spec::kLESetPHY);
+  auto view = command.view_t();
+  view.connection_handle().Write(handle());
+  view.all_phys().no_tx_preference().Write(false);
+  view.all_phys().no_rx_preference().Write(false);
+  view.tx_phys().le_2m().Write(true);
+  view.rx_phys().le_2m().Write(true);
+  view.phy_options().Write(
+      pw::bluetooth::emboss::LEPHYOptions::NO_PREFERRED_CODING);
+
+  // The resulting PHYs are reported by the HCI LE PHY Update Complete event.
+  auto status_cb = [handle = handle()](auto id, const hci::EventPacket& event) {
+    BT_ASSERT(event.event_code() == hci_spec::kCommandStatusEventCode);
+    hci_is_error(event,
+                 WARN,
+                 "gap-le",
+                 "controller rejected PHY update (handle: %#.4x)",
+                 handle);
+  };
+  cmd_->SendCommand(std::move(command),
+                    std::move(status_cb),
+                    hci_spec::kCommandStatusEventCode);
+}
+
+void LowEnergyConnection::OnLEDataLengthChange(
+    const hci::EmbossEventPacket& event) {
+  BT_ASSERT(event.event_code() == hci_spec::kLEMetaEventCode);
+  auto payload =
+      event.view<pw::bluetooth::emboss::LEDataLengthChangeSubeventView>();
+
+  // Ignore events for other connections.
+  if (payload.connection_handle().Read() != link_->handle()) {
+    return;
+  }
+
+  max_tx_octets_.Set(payload.max_tx_octets().UncheckedRead());
+  max_rx_octets_.Set(payload.max_rx_octets().UncheckedRead());
+  bt_log(INFO,
+         "gap-le",
+         "data length changed (peer: %s, max tx octets: %hu, max rx octets: "
+         "%hu)",
+         bt_str(peer_id()),
+         *max_tx_octets_,
+         *max_rx_octets_);
+}
+
+void LowEnergyConnection::OnLEPhyUpdateComplete(
+    const hci::EmbossEventPacket& event) {
+  BT_ASSERT(event.event_code() == hci_spec::kLEMetaEventCode);
+  auto payload =
+      event.view<pw::bluetooth::emboss::LEPHYUpdateCompleteSubeventView>();
+
+  // Ignore events for other connections.
+  if (payload.connection_handle().Read() != link_->handle()) {
+    return;
+  }
+
+  if (payload.status().Read() != pw::bluetooth::emboss::StatusCode::SUCCESS) {
+    bt_log(WARN,
+           "gap-le",
+           "HCI LE PHY Update Complete event with error "
+           "(peer: %s, status: %#.2hhx)",
+           bt_str(peer_id()),
+           static_cast<unsigned char>(payload.status().Read()));
+    return;
+  }
+
+  tx_phy_.Set(static_cast<uint8_t>(payload.tx_phy().UncheckedRead()));
+  rx_phy_.Set(static_cast<uint8_t>(payload.rx_phy().UncheckedRead()));
+  bt_log(INFO,
+         "gap-le",
+         "PHY updated (peer: %s, tx PHY: %hhu, rx PHY: %hhu)",
+         bt_str(peer_id()),
+         *tx_phy_,
+         *rx_phy_);
+}
+
 void LowEnergyConnection::MaybeUpdateConnectionParameters() {
   if (connection_parameters_update_requested_ || conn_pause_central_timeout_ ||
       conn_pause_peripheral_timeout_ || !interrogation_completed_) {
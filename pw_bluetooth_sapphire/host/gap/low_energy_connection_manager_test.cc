@@ -2512,6 +2512,88 @@ TEST_F(LowEnergyConnectionManagerTest,
   EXPECT_FALSE(peer->temporary());
 }
 
+TEST_F(LowEnergyConnectionManagerTest,
+       MaximizeThroughputRequestsMaxDataLengthAnd2mPhy) {
+  constexpr hci_spec::LESupportedFeatures kLEFeatures{
+      static_cast<uint64_t>(
+          hci_spec::LESupportedFeature::kLEDataPacketLengthExtension) |
+      static_cast<uint64_t>(hci_spec::LESupportedFeature::kLE2MPHY)};
+
+  auto* peer = peer_cache()->NewPeer(kAddress0, /*connectable=*/true);
+  auto fake_peer = std::make_unique<FakePeer>(kAddress0, dispatcher());
+  fake_peer->set_le_features(kLEFeatures);
+  FakePeer* fake_peer_ptr = fake_peer.get();
+  test_device()->AddPeer(std::move(fake_peer));
+
+  std::unique_ptr<LowEnergyConnectionHandle> conn;
+  LowEnergyConnectionOptions options;
+  options.maximize_throughput = true;
+  conn_mgr()->Connect(
+      peer->identifier(),
+      [&](auto result) {
+        ASSERT_EQ(fit::ok(), result);
+        conn = std::move(result).value();
+      },
+      options);
+  RunUntilIdle();
+  ASSERT_TRUE(conn);
+  EXPECT_EQ(hci_spec::kLEMaxTxOctetsMax, fake_peer_ptr->le_max_tx_octets());
+  EXPECT_EQ(hci_spec::LEPHY::kLE2M, fake_peer_ptr->le_phy());
+}
+
+TEST_F(LowEnergyConnectionManagerTest,
+       MaximizeThroughputSkipsFeaturesPeerDoesNotSupport) {
+  constexpr hci_spec::LESupportedFeatures kLEFeatures{static_cast<uint64_t>(
+      hci_spec::LESupportedFeature::kLEDataPacketLengthExtension)};
+
+  auto* peer = peer_cache()->NewPeer(kAddress0, /*connectable=*/true);
+  auto fake_peer = std::make_unique<FakePeer>(kAddress0, dispatcher());
+  fake_peer->set_le_features(kLEFeatures);
+  FakePeer* fake_peer_ptr = fake_peer.get();
+  test_device()->AddPeer(std::move(fake_peer));
+
+  std::unique_ptr<LowEnergyConnectionHandle> conn;
+  LowEnergyConnectionOptions options;
+  options.maximize_throughput = true;
+  conn_mgr()->Connect(
+      peer->identifier(),
+      [&](auto result) {
+        ASSERT_EQ(fit::ok(), result);
+        conn = std::move(result).value();
+      },
+      options);
+  RunUntilIdle();
+  ASSERT_TRUE(conn);
+  EXPECT_EQ(hci_spec::kLEMaxTxOctetsMax, fake_peer_ptr->le_max_tx_octets());
+  EXPECT_EQ(hci_spec::LEPHY::kLE1M, fake_peer_ptr->le_phy());
+}
+
+TEST_F(LowEnergyConnectionManagerTest, DataLengthAndPhyAreNotChangedByDefault) {
+  constexpr hci_spec::LESupportedFeatures kLEFeatures{
+      static_cast<uint64_t>(
+          hci_spec::LESupportedFeature::kLEDataPacketLengthExtension) |
+      static_cast<uint64_t>(hci_spec::LESupportedFeature::kLE2MPHY)};
+
+  auto* peer = peer_cache()->NewPeer(kAddress0, /*connectable=*/true);
+  auto fake_peer = std::make_unique<FakePeer>(kAddress0, dispatcher());
+  fake_peer->set_le_features(kLEFeatures);
+  FakePeer* fake_peer_ptr = fake_peer.get();
+  test_device()->AddPeer(std::move(fake_peer));
+
+  std::unique_ptr<LowEnergyConnectionHandle> conn;
+  conn_mgr()->Connect(
+      peer->identifier(),
+      [&](auto result) {
+        ASSERT_EQ(fit::ok(), result);
+        conn = std::move(result).value();
+      },
+      kConnectionOptions);
+  RunUntilIdle();
+  ASSERT_TRUE(conn);
+  EXPECT_EQ(hci_spec::kLEMaxTxOctetsMin, fake_peer_ptr->le_max_tx_octets());
+  EXPECT_EQ(hci_spec::LEPHY::kLE1M, fake_peer_ptr->le_phy());
+}
+
 TEST_F(LowEnergyConnectionManagerTest, ConnectInterrogationFailure) {
   // Set up a connection.
   auto* peer = peer_cache()->NewPeer(kAddress0, /*connectable=*/true);
@@ -3953,7 +4035,11 @@ TEST_F(LowEnergyConnectionManagerTest, Inspect) {
             PropertyList(UnorderedElementsAre(
                 StringIs("peer_id", peer->identifier().ToString()),
                 StringIs("peer_address", peer->address().ToString()),
-                IntIs("ref_count", 1)))));
+                IntIs("ref_count", 1),
+                UintIs("max_tx_octets", hci_spec::kLEMaxTxOctetsMin),
+                UintIs("max_rx_octets", hci_spec::kLEMaxTxOctetsMin),
+                UintIs("tx_phy", 1),
+                UintIs("rx_phy", 1)))));
 
   auto connections_matcher = AllOf(NodeMatches(NameMatches("connections")),
                                    ChildrenMatch(ElementsAre(conn_matcher)));
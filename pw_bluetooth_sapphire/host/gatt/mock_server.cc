@@ -37,4 +37,14 @@ void MockServer::SendUpdate(IdType service_id,
   }
 }
 
+void MockServer::SendNotifications(
+    const std::vector<NotificationUpdate>& updates) {
+  for (const NotificationUpdate& update : updates) {
+    SendUpdate(update.service_id,
+               update.chrc_id,
+               update.value,
+               /*indicate_cb=*/nullptr);
+  }
+}
+
 }  // namespace bt::gatt::testing
@@ -16,6 +16,9 @@
 
 #include <lib/fit/function.h>
 
+#include <utility>
+#include <vector>
+
 #include "pw_bluetooth_sapphire/internal/host/att/att.h"
 #include "pw_bluetooth_sapphire/internal/host/att/database.h"
 #include "pw_bluetooth_sapphire/internal/host/att/permissions.h"
@@ -92,15 +95,25 @@ class AttBasedServer final : public Server {
   // Convenience "alias"
   inline att::Database::WeakPtr db() { return local_services_->database(); }
 
+  // Returns a Handle Value Notification or Indication PDU carrying |value|.
+  static ByteBufferPtr NewHandleValuePdu(att::OpCode opcode,
+                                         att::Handle handle,
+                                         BufferView value) {
+    auto buffer =
+        NewBuffer(sizeof(att::Header) + sizeof(att::Handle) + value.size());
+    BT_ASSERT(buffer);
+    att::PacketWriter writer(opcode, buffer.get());
+    auto params = writer.mutable_payload<att::AttributeData>();
+    params->handle = htole16(handle);
+    writer.mutable_payload_data().Write(value, sizeof(att::AttributeData));
+    return buffer;
+  }
+
   // Server overrides:
   void SendUpdate(IdType service_id,
                   IdType chrc_id,
                   BufferView value,
                   IndicationCallback indicate_cb) override {
-    auto buffer =
-        NewBuffer(sizeof(att::Header) + sizeof(att::Handle) + value.size());
-    BT_ASSERT(buffer);
-
     LocalServiceManager::ClientCharacteristicConfig config;
     if (!local_services_->GetCharacteristicConfig(
             service_id, chrc_id, peer_id_, &config)) {
@@ -128,11 +141,10 @@ class AttBasedServer final : public Server {
       return;
     }
 
-    att::PacketWriter writer(
-        indicate_cb ? att::kIndication : att::kNotification, buffer.get());
-    auto rsp_params = writer.mutable_payload<att::AttributeData>();
-    rsp_params->handle = htole16(config.handle);
-    writer.mutable_payload_data().Write(value, sizeof(att::AttributeData));
+    auto buffer = NewHandleValuePdu(
+        indicate_cb ? att::kIndication : att::kNotification,
+        config.handle,
+        value);
 
     if (!indicate_cb) {
       [[maybe_unused]] bool _ = att_->SendWithoutResponse(std::move(buffer));
@@ -156,6 +168,70 @@ class AttBasedServer final : public Server {
     att_->StartTransaction(std::move(buffer), std::move(transaction_cb));
   }
 
+  void SendNotifications(
+      const std::vector<NotificationUpdate>& updates) override {
+    // Look up the handles of the characteristics that the peer has configured
+    // for notifications.
+    std::vector<std::pair<att::Handle, BufferView>> values;
+    values.reserve(updates.size());
+    for (const NotificationUpdate& update : updates) {
+      LocalServiceManager::ClientCharacteristicConfig config;
+      if (!local_services_->GetCharacteristicConfig(
+              update.service_id, update.chrc_id, peer_id_, &config) ||
+          !config.notify) {
+        bt_log(TRACE,
+               "gatt",
+               "peer has not enabled notifications: %s",
+               bt_str(peer_id_));
+        continue;
+      }
+      values.emplace_back(config.handle, update.value);
+    }
+
+    size_t next = 0;
+    while (next < values.size()) {
+      // Find how many of the following values fit in a single PDU.
+      size_t end = next;
+      size_t pdu_size = sizeof(att::Header);
+      while (multiple_notifications_supported_ && end < values.size() &&
+             pdu_size + sizeof(att::HandleLengthValue) +
+                     values[end].second.size() <=
+                 att_->mtu()) {
+        pdu_size += sizeof(att::HandleLengthValue) + values[end].second.size();
+        end++;
+      }
+
+      // A Multiple Handle Value Notification must contain at least two values.
+      if (end - next < 2) {
+        const auto& [handle, value] = values[next];
+        [[maybe_unused]] bool _ = att_->SendWithoutResponse(
+            NewHandleValuePdu(att::kNotification, handle, value));
+        next++;
+        continue;
+      }
+
+      auto buffer = NewBuffer(pdu_size);
+      BT_ASSERT(buffer);
+      att::PacketWriter writer(att::kMultipleHandleValueNotification,
+                               buffer.get());
+      auto payload = writer.mutable_payload_data();
+      size_t offset = 0;
+      for (; next < end; next++) {
+        const auto& [handle, value] = values[next];
+        payload.WriteObj(htole16(handle), offset);
+        payload.WriteObj(htole16(static_cast<uint16_t>(value.size())),
+                         offset + sizeof(att::Handle));
+        payload.Write(value, offset + sizeof(att::HandleLengthValue));
+        offset += sizeof(att::HandleLengthValue) + value.size();
+      }
+      [[maybe_unused]] bool _ = att_->SendWithoutResponse(std::move(buffer));
+    }
+  }
+
+  void SetMultipleHandleValueNotificationsSupported(bool supported) override {
+    multiple_notifications_supported_ = supported;
+  }
+
   void ShutDown() override { att_->ShutDown(); }
 
   // ATT protocol request handlers:
@@ -978,6 +1054,9 @@ class AttBasedServer final : public Server {
   LocalServiceManager::WeakPtr local_services_;
   att::Bearer::WeakPtr att_;
 
+  // True if the peer supports Multiple Handle Value Notifications.
+  bool multiple_notifications_supported_ = false;
+
   // The queue data structure used for queued writes (see Vol 3, Part F, 3.4.6).
   att::PrepareWriteQueue prepare_queue_;
 
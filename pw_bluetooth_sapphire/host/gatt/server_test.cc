@@ -2905,6 +2905,136 @@ TEST_F(ServerTest, SendNotification) {
                        /*indicate_cb=*/nullptr);
 }
 
+TEST_F(ServerTest, SendNotificationsWithoutMultipleSupportSendsEachValue) {
+  SvcIdAndChrcHandle registered0 =
+      RegisterSvcWithConfiguredChrc(kTestSvcType, kTestChrcId, kTestChrcType);
+  SvcIdAndChrcHandle registered1 =
+      RegisterSvcWithConfiguredChrc(kTestSvcType, kTestChrcId, kTestType16);
+
+  // clang-format off
+  const StaticByteBuffer kExpected0{
+    att::kNotification,  // Opcode
+    LowerBits(registered0.chrc_val_handle),
+    UpperBits(registered0.chrc_val_handle),
+    'f', 'o', 'o'
+  };
+  const StaticByteBuffer kExpected1{
+    att::kNotification,  // Opcode
+    LowerBits(registered1.chrc_val_handle),
+    UpperBits(registered1.chrc_val_handle),
+    'b', 'a', 'r'
+  };
+  // clang-format on
+
+  EXPECT_PACKET_OUT(kExpected0);
+  EXPECT_PACKET_OUT(kExpected1);
+  server()->SendNotifications({
+      {registered0.svc_id, kTestChrcId, kTestValue1.view()},
+      {registered1.svc_id, kTestChrcId, kTestValue2.view()},
+  });
+  EXPECT_TRUE(AllExpectedPacketsSent());
+}
+
+TEST_F(ServerTest, SendNotificationsSkipsUnconfiguredCharacteristics) {
+  SvcIdAndChrcHandle registered =
+      RegisterSvcWithConfiguredChrc(kTestSvcType, kTestChrcId, kTestChrcType);
+  SvcIdAndChrcHandle indicate_only = RegisterSvcWithConfiguredChrc(
+      kTestSvcType, kTestChrcId, kTestType16, kCCCIndicationBit);
+  IdType unconfigured_svc_id =
+      RegisterSvcWithSingleChrc(kTestSvcType, kTestChrcId, kTestType128);
+  server()->SetMultipleHandleValueNotificationsSupported(true);
+
+  // A single value is sent as a regular notification.
+  // clang-format off
+  const StaticByteBuffer kExpected{
+    att::kNotification,  // Opcode
+    LowerBits(registered.chrc_val_handle), UpperBits(registered.chrc_val_handle),
+    'f', 'o', 'o'
+  };
+  // clang-format on
+
+  EXPECT_PACKET_OUT(kExpected);
+  server()->SendNotifications({
+      {indicate_only.svc_id, kTestChrcId, kTestValue2.view()},
+      {registered.svc_id, kTestChrcId, kTestValue1.view()},
+      {unconfigured_svc_id, kTestChrcId, kTestValue3.view()},
+  });
+  EXPECT_TRUE(AllExpectedPacketsSent());
+}
+
+TEST_F(ServerTest, SendNotificationsPacksMultipleHandleValueNotification) {
+  SvcIdAndChrcHandle registered0 =
+      RegisterSvcWithConfiguredChrc(kTestSvcType, kTestChrcId, kTestChrcType);
+  SvcIdAndChrcHandle registered1 =
+      RegisterSvcWithConfiguredChrc(kTestSvcType, kTestChrcId, kTestType16);
+  server()->SetMultipleHandleValueNotificationsSupported(true);
+
+  // clang-format off
+  const StaticByteBuffer kExpected{
+    att::kMultipleHandleValueNotification,  // Opcode
+    LowerBits(registered0.chrc_val_handle),
+    UpperBits(registered0.chrc_val_handle),
+    0x03, 0x00,  // length: 3
+    'f', 'o', 'o',
+    LowerBits(registered1.chrc_val_handle),
+    UpperBits(registered1.chrc_val_handle),
+    0x00, 0x00,  // length: 0
+    LowerBits(registered0.chrc_val_handle),
+    UpperBits(registered0.chrc_val_handle),
+    0x03, 0x00,  // length: 3
+    'b', 'a', 'r'
+  };
+  // clang-format on
+
+  EXPECT_PACKET_OUT(kExpected);
+  server()->SendNotifications({
+      {registered0.svc_id, kTestChrcId, kTestValue1.view()},
+      {registered1.svc_id, kTestChrcId, BufferView()},
+      {registered0.svc_id, kTestChrcId, kTestValue2.view()},
+  });
+  EXPECT_TRUE(AllExpectedPacketsSent());
+}
+
+TEST_F(ServerTest, SendNotificationsSplitsValuesAtMtu) {
+  SvcIdAndChrcHandle registered0 =
+      RegisterSvcWithConfiguredChrc(kTestSvcType, kTestChrcId, kTestChrcType);
+  SvcIdAndChrcHandle registered1 =
+      RegisterSvcWithConfiguredChrc(kTestSvcType, kTestChrcId, kTestType16);
+  server()->SetMultipleHandleValueNotificationsSupported(true);
+
+  // Two 3-byte values fit in a 15-byte PDU, but three do not.
+  att()->set_mtu(15);
+
+  // clang-format off
+  const StaticByteBuffer kExpectedMultiple{
+    att::kMultipleHandleValueNotification,  // Opcode
+    LowerBits(registered0.chrc_val_handle),
+    UpperBits(registered0.chrc_val_handle),
+    0x03, 0x00,  // length: 3
+    'f', 'o', 'o',
+    LowerBits(registered1.chrc_val_handle),
+    UpperBits(registered1.chrc_val_handle),
+    0x03, 0x00,  // length: 3
+    'b', 'a', 'r'
+  };
+  const StaticByteBuffer kExpectedSingle{
+    att::kNotification,  // Opcode
+    LowerBits(registered0.chrc_val_handle),
+    UpperBits(registered0.chrc_val_handle),
+    'b', 'a', 'z'
+  };
+  // clang-format on
+
+  EXPECT_PACKET_OUT(kExpectedMultiple);
+  EXPECT_PACKET_OUT(kExpectedSingle);
+  server()->SendNotifications({
+      {registered0.svc_id, kTestChrcId, kTestValue1.view()},
+      {registered1.svc_id, kTestChrcId, kTestValue2.view()},
+      {registered0.svc_id, kTestChrcId, kTestValue3.view()},
+  });
+  EXPECT_TRUE(AllExpectedPacketsSent());
+}
+
 TEST_F(ServerTest, TrySendIndicationNoCccConfig) {
   IdType svc_id =
       RegisterSvcWithSingleChrc(kTestSvcType, kTestChrcId, kTestChrcType);
@@ -443,22 +443,29 @@ void ChannelImpl::HandleRxPdu(PDU&& pdu) {
     return;
   }
 
-  // Buffer the packets if the channel hasn't been activated.
-  if (!active_) {
-    pending_rx_sdus_.emplace(std::move(sdu));
-    // Tracing: we assume pending_rx_sdus_ is only filled once and use the
-    // length of queue for trace ids.
-    TRACE_FLOW_BEGIN("bluetooth",
-                     "ChannelImpl::HandleRxPdu queued",
-                     pending_rx_sdus_.size());
-    return;
-  }
-
-  BT_ASSERT(rx_cb_);
-  {
-    TRACE_DURATION("bluetooth", "ChannelImpl::HandleRxPdu callback");
-    rx_cb_(std::move(sdu));
-  }
+  // The PDU may also have completed SDUs that |rx_engine_| held while waiting
+  // for it. Channel may be destroyed or closed in rx_cb_, so we need to check
+  // self and |rx_engine_| after calling rx_cb_.
+  auto self = GetWeakPtr();
+  do {
+    // Buffer the packets if the channel hasn't been activated.
+    if (!active_) {
+      pending_rx_sdus_.emplace(std::move(sdu));
+      // Tracing: we assume pending_rx_sdus_ is only filled once and use the
+      // length of queue for trace ids.
+      TRACE_FLOW_BEGIN("bluetooth",
+                       "ChannelImpl::HandleRxPdu queued",
+                       pending_rx_sdus_.size());
+    } else {
+      BT_ASSERT(rx_cb_);
+      TRACE_DURATION("bluetooth", "ChannelImpl::HandleRxPdu callback");
+      rx_cb_(std::move(sdu));
+    }
+    if (!self.is_alive() || !rx_engine_) {
+      return;
+    }
+    sdu = rx_engine_->PopPendingSdu();
+  } while (sdu);
 }
 
 void ChannelImpl::CleanUp() {
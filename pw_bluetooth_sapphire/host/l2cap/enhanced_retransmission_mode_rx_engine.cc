@@ -77,6 +77,39 @@ bool IsMpsValid(const PDU& pdu) {
   return true;
 }
 
+// I-Frames received up to this many frames ahead of the expected TxSeq are
+// held while the missing frames are requested with SREJ frames. This is less
+// than half of the sequence number space so that duplicates of frames that
+// were already received aren't mistaken for new frames.
+constexpr uint8_t kMaxSelectiveRejectDistance =
+    EnhancedControlField::kMaxSeqNum / 2;
+
+// Returns the number of frames from |low| up to, but excluding, |high|.
+uint8_t NumFramesBetween(uint8_t low, uint8_t high) {
+  if (high < low) {
+    high += (EnhancedControlField::kMaxSeqNum + 1);
+  }
+  return high - low;
+}
+
+uint8_t NextSeqNum(uint8_t seq_num) {
+  return seq_num == EnhancedControlField::kMaxSeqNum
+             ? 0
+             : static_cast<uint8_t>(seq_num + 1);
+}
+
+// Returns the information payload of an unsegmented I-Frame, or nullptr if
+// |pdu| is too short to contain one.
+ByteBufferPtr ReleaseInformationPayload(PDU& pdu) {
+  const auto header_len = sizeof(SimpleInformationFrameHeader);
+  const auto footer_len = sizeof(FrameCheckSequence);
+  if (pdu.length() < header_len + footer_len) {
+    return nullptr;
+  }
+  const auto payload_len = pdu.length() - header_len - footer_len;
+  return pdu.ReleasePayload(header_len, payload_len);
+}
+
 }  // namespace
 
 using Engine = EnhancedRetransmissionModeRxEngine;
@@ -132,13 +165,19 @@ ByteBufferPtr Engine::ProcessPdu(PDU pdu) {
   return std::visit(std::move(frame_processor), header);
 }
 
+ByteBufferPtr Engine::PopPendingSdu() {
+  if (pending_sdus_.empty()) {
+    return nullptr;
+  }
+  ByteBufferPtr sdu = std::move(pending_sdus_.front());
+  pending_sdus_.pop();
+  return sdu;
+}
+
 ByteBufferPtr Engine::ProcessFrame(const SimpleInformationFrameHeader header,
                                    PDU pdu) {
   if (header.tx_seq() != next_seqnum_) {
-    // TODO(quiche): Send REJ frame.
-    // TODO(quiche): Add histogram for |header.tx_seq() - next_seqnum_|. This
-    // will give us an upper bound on the potential benefit of sending SREJ
-    // frames.
+    HoldOutOfSequenceFrame(header, std::move(pdu));
     return nullptr;
   }
 
@@ -151,6 +190,15 @@ ByteBufferPtr Engine::ProcessFrame(const SimpleInformationFrameHeader header,
 
   AdvanceSeqNum();
 
+  // This frame may have been the last one missing before frames that were
+  // held, which are now in sequence and can be delivered after it.
+  for (auto held = held_sdus_.find(next_seqnum_); held != held_sdus_.end();
+       held = held_sdus_.find(next_seqnum_)) {
+    pending_sdus_.push(std::move(held->second));
+    held_sdus_.erase(held);
+    AdvanceSeqNum();
+  }
+
   if (ack_seq_num_callback_) {
     ack_seq_num_callback_(next_seqnum_);
   }
@@ -160,17 +208,57 @@ ByteBufferPtr Engine::ProcessFrame(const SimpleInformationFrameHeader header,
   send_frame_callback_(std::make_unique<DynamicByteBuffer>(
       BufferView(&ack_frame, sizeof(ack_frame))));
 
-  const auto header_len = sizeof(header);
-  const auto footer_len = sizeof(FrameCheckSequence);
-  if (pdu.length() < header_len + footer_len) {
-    return nullptr;
+  ByteBufferPtr sdu = ReleaseInformationPayload(pdu);
+  if (!sdu) {
+    return PopPendingSdu();
   }
-  const auto payload_len = pdu.length() - header_len - footer_len;
-  auto sdu = std::make_unique<DynamicByteBuffer>(payload_len);
-  pdu.Copy(sdu.get(), header_len, payload_len);
   return sdu;
 }
 
+void Engine::HoldOutOfSequenceFrame(const SimpleInformationFrameHeader header,
+                                    PDU pdu) {
+  const uint8_t tx_seq = header.tx_seq();
+  if (NumFramesBetween(next_seqnum_, tx_seq) > kMaxSelectiveRejectDistance) {
+    // This is likely a duplicate of a frame that we already received.
+    return;
+  }
+
+  if (header.designates_part_of_segmented_sdu()) {
+    // TODO(quiche): Send REJ frame, as we don't hold segmented frames.
+    return;
+  }
+
+  if (held_sdus_.count(tx_seq)) {
+    return;
+  }
+
+  ByteBufferPtr sdu = ReleaseInformationPayload(pdu);
+  if (!sdu) {
+    return;
+  }
+
+  // Send SREJ frames for every frame that is missing between the newest frame
+  // that was held or requested and this one (Core Spec v5.0, Vol 3, Part A,
+  // Sec 8.6.1.4). If this frame precedes |next_srej_seqnum_|, then it is the
+  // retransmission of a frame that was already requested.
+  if (held_sdus_.empty()) {
+    next_srej_seqnum_ = next_seqnum_;
+  }
+  if (NumFramesBetween(next_seqnum_, tx_seq) >=
+      NumFramesBetween(next_seqnum_, next_srej_seqnum_)) {
+    for (; next_srej_seqnum_ != tx_seq;
+         next_srej_seqnum_ = NextSeqNum(next_srej_seqnum_)) {
+      SimpleSupervisoryFrame srej(SupervisoryFunction::SelectiveReject);
+      srej.set_receive_seq_num(next_srej_seqnum_);
+      send_frame_callback_(std::make_unique<DynamicByteBuffer>(
+          BufferView(&srej, sizeof(srej))));
+    }
+    next_srej_seqnum_ = NextSeqNum(tx_seq);
+  }
+
+  held_sdus_.emplace(tx_seq, std::move(sdu));
+}
+
 ByteBufferPtr Engine::ProcessFrame(const SimpleStartOfSduFrameHeader, PDU pdu) {
   // TODO(quiche): Implement validation and handling of Start-of-SDU frames.
   return nullptr;
@@ -255,10 +343,7 @@ ByteBufferPtr Engine::ProcessFrame(std::monostate, PDU pdu) {
 }
 
 void Engine::AdvanceSeqNum() {
-  ++next_seqnum_;
-  if (next_seqnum_ > EnhancedControlField::kMaxSeqNum) {
-    next_seqnum_ = 0;
-  }
+  next_seqnum_ = NextSeqNum(next_seqnum_);
 }
 
 }  // namespace bt::l2cap::internal
@@ -14,6 +14,8 @@
 
 #include "pw_bluetooth_sapphire/internal/host/l2cap/enhanced_retransmission_mode_rx_engine.h"
 
+#include <vector>
+
 #include "pw_bluetooth_sapphire/internal/host/l2cap/fragmenter.h"
 #include "pw_bluetooth_sapphire/internal/host/testing/test_helpers.h"
 #include "pw_unit_test/framework.h"
@@ -680,5 +682,135 @@ TEST(EnhancedRetransmissionModeRxEngineTest,
   EXPECT_TRUE(connection_failed);
 }
 
+// Builds an unsegmented I-Frame with |tx_seq| whose payload is |data|. See
+// Core Spec, v5, Vol 3, Part A, Table 3.2 for the first two bytes.
+PDU MakeInformationFrame(uint8_t tx_seq, uint8_t data) {
+  return Fragmenter(kTestHandle)
+      .BuildFrame(kTestChannelId,
+                  StaticByteBuffer(tx_seq << 1, 0, data),
+                  FrameCheckSequenceOption::kIncludeFcs);
+}
+
+void VerifyIsSupervisoryFrame(const ByteBuffer* buf,
+                              SupervisoryFunction function,
+                              uint8_t receive_seq_num) {
+  ASSERT_TRUE(buf);
+  ASSERT_EQ(sizeof(SimpleSupervisoryFrame), buf->size());
+  const auto sframe = buf->To<SimpleSupervisoryFrame>();
+  EXPECT_EQ(function, sframe.function());
+  EXPECT_EQ(receive_seq_num, sframe.receive_seq_num());
+  EXPECT_FALSE(sframe.is_poll_request());
+}
+
+TEST(EnhancedRetransmissionModeRxEngineTest,
+     ProcessPduSelectivelyRejectsMissingFrameAndHoldsLaterFrames) {
+  std::vector<ByteBufferPtr> sent_frames;
+  auto tx_callback = [&](ByteBufferPtr pdu) {
+    sent_frames.push_back(std::move(pdu));
+  };
+  Engine rx_engine(tx_callback, NoOpFailureCallback);
+
+  ASSERT_TRUE(rx_engine.ProcessPdu(MakeInformationFrame(0, 'a')));
+  sent_frames.clear();
+
+  // The frame with TxSeq=1 is missing, so it is requested once.
+  EXPECT_FALSE(rx_engine.ProcessPdu(MakeInformationFrame(2, 'c')));
+  EXPECT_FALSE(rx_engine.ProcessPdu(MakeInformationFrame(3, 'd')));
+  EXPECT_FALSE(rx_engine.PopPendingSdu());
+  ASSERT_EQ(1u, sent_frames.size());
+  RETURN_IF_FATAL(VerifyIsSupervisoryFrame(
+      sent_frames[0].get(), SupervisoryFunction::SelectiveReject, 1));
+  sent_frames.clear();
+
+  // Receiving the missing frame delivers it and then the frames held after it,
+  // and acknowledges all of them.
+  ByteBufferPtr sdu = rx_engine.ProcessPdu(MakeInformationFrame(1, 'b'));
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('b'), *sdu));
+  sdu = rx_engine.PopPendingSdu();
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('c'), *sdu));
+  sdu = rx_engine.PopPendingSdu();
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('d'), *sdu));
+  EXPECT_FALSE(rx_engine.PopPendingSdu());
+  ASSERT_EQ(1u, sent_frames.size());
+  RETURN_IF_FATAL(VerifyIsSupervisoryFrame(
+      sent_frames[0].get(), SupervisoryFunction::ReceiverReady, 4));
+
+  // Frames are in sequence again.
+  sent_frames.clear();
+  EXPECT_TRUE(rx_engine.ProcessPdu(MakeInformationFrame(4, 'e')));
+  ASSERT_EQ(1u, sent_frames.size());
+  RETURN_IF_FATAL(VerifyIsSupervisoryFrame(
+      sent_frames[0].get(), SupervisoryFunction::ReceiverReady, 5));
+}
+
+TEST(EnhancedRetransmissionModeRxEngineTest,
+     ProcessPduSelectivelyRejectsEachMissingFrame) {
+  std::vector<ByteBufferPtr> sent_frames;
+  auto tx_callback = [&](ByteBufferPtr pdu) {
+    sent_frames.push_back(std::move(pdu));
+  };
+  Engine rx_engine(tx_callback, NoOpFailureCallback);
+
+  EXPECT_FALSE(rx_engine.ProcessPdu(MakeInformationFrame(2, 'c')));
+  ASSERT_EQ(2u, sent_frames.size());
+  RETURN_IF_FATAL(VerifyIsSupervisoryFrame(
+      sent_frames[0].get(), SupervisoryFunction::SelectiveReject, 0));
+  RETURN_IF_FATAL(VerifyIsSupervisoryFrame(
+      sent_frames[1].get(), SupervisoryFunction::SelectiveReject, 1));
+  sent_frames.clear();
+
+  // A gap after the held frame is requested too, but the retransmission of an
+  // already-requested frame is only held.
+  EXPECT_FALSE(rx_engine.ProcessPdu(MakeInformationFrame(4, 'e')));
+  EXPECT_FALSE(rx_engine.ProcessPdu(MakeInformationFrame(1, 'b')));
+  ASSERT_EQ(1u, sent_frames.size());
+  RETURN_IF_FATAL(VerifyIsSupervisoryFrame(
+      sent_frames[0].get(), SupervisoryFunction::SelectiveReject, 3));
+  sent_frames.clear();
+
+  ByteBufferPtr sdu = rx_engine.ProcessPdu(MakeInformationFrame(0, 'a'));
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('a'), *sdu));
+  sdu = rx_engine.PopPendingSdu();
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('b'), *sdu));
+  sdu = rx_engine.PopPendingSdu();
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('c'), *sdu));
+  EXPECT_FALSE(rx_engine.PopPendingSdu());
+  ASSERT_EQ(1u, sent_frames.size());
+  RETURN_IF_FATAL(VerifyIsSupervisoryFrame(
+      sent_frames[0].get(), SupervisoryFunction::ReceiverReady, 3));
+  sent_frames.clear();
+
+  // The frame with TxSeq=4 is still held until TxSeq=3 arrives.
+  sdu = rx_engine.ProcessPdu(MakeInformationFrame(3, 'd'));
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('d'), *sdu));
+  sdu = rx_engine.PopPendingSdu();
+  ASSERT_TRUE(sdu);
+  EXPECT_TRUE(ContainersEqual(StaticByteBuffer('e'), *sdu));
+  EXPECT_FALSE(rx_engine.PopPendingSdu());
+}
+
+TEST(EnhancedRetransmissionModeRxEngineTest,
+     ProcessPduDoesNotSelectivelyRejectForDuplicateFrame) {
+  size_t n_frames_sent = 0;
+  auto tx_callback = [&](ByteBufferPtr) { ++n_frames_sent; };
+  Engine rx_engine(tx_callback, NoOpFailureCallback);
+
+  ASSERT_TRUE(rx_engine.ProcessPdu(MakeInformationFrame(0, 'a')));
+  ASSERT_TRUE(rx_engine.ProcessPdu(MakeInformationFrame(1, 'b')));
+  n_frames_sent = 0;
+
+  // The peer may retransmit frames that we have already acknowledged.
+  EXPECT_FALSE(rx_engine.ProcessPdu(MakeInformationFrame(1, 'b')));
+  EXPECT_FALSE(rx_engine.PopPendingSdu());
+  EXPECT_EQ(0u, n_frames_sent);
+}
+
 }  // namespace
 }  // namespace bt::l2cap::internal
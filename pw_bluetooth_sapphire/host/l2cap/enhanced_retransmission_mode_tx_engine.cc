@@ -14,10 +14,12 @@
 
 #include "pw_bluetooth_sapphire/internal/host/l2cap/enhanced_retransmission_mode_tx_engine.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "pw_bluetooth_sapphire/internal/host/common/assert.h"
 #include "pw_bluetooth_sapphire/internal/host/common/log.h"
+#include "pw_bluetooth_sapphire/internal/host/common/slab_allocator.h"
 #include "pw_bluetooth_sapphire/internal/host/l2cap/frame_headers.h"
 
 namespace bt::l2cap::internal {
@@ -94,9 +96,10 @@ bool Engine::QueueSdu(ByteBufferPtr sdu) {
 
   const auto seq_num = GetNextTxSeq();
   SimpleInformationFrameHeader header(seq_num);
-  DynamicByteBuffer frame(sizeof(header) + sdu->size());
-  auto body = frame.mutable_view(sizeof(header));
-  frame.WriteObj(header);
+  MutableByteBufferPtr frame = NewBuffer(sizeof(header) + sdu->size());
+  BT_ASSERT(frame);
+  auto body = frame->mutable_view(sizeof(header));
+  frame->WriteObj(header);
   sdu->Copy(&body);
 
   // TODO(fxbug.dev/42086227): Limit the size of the queue.
@@ -144,12 +147,24 @@ void Engine::UpdateAckSeq(uint8_t new_seq, bool is_poll_response) {
     return;
   }
 
+  // The newest acknowledged frame gives the best round-trip time sample, as
+  // older frames may have waited for the peer to acknowledge them together.
+  std::optional<pw::chrono::SystemClock::time_point> acked_first_tx_time;
   auto n_frames_to_discard = n_frames_acked;
   while (n_frames_to_discard) {
     BT_DEBUG_ASSERT(!pending_pdus_.empty());
+    const PendingPdu& acked_pdu = pending_pdus_.front();
+    if (acked_pdu.tx_count == 1) {
+      acked_first_tx_time = acked_pdu.first_tx_time;
+    } else {
+      acked_first_tx_time.reset();
+    }
     pending_pdus_.pop_front();
     --n_frames_to_discard;
   }
+  if (acked_first_tx_time.has_value()) {
+    UpdateRoundTripTime(pw_dispatcher_.now() - *acked_first_tx_time);
+  }
 
   expected_ack_seq_ = new_seq;
   if (expected_ack_seq_ == next_tx_seq_) {
@@ -252,7 +267,7 @@ void Engine::MaybeSendQueuedData() {
          NumUnackedFrames() < n_frames_in_tx_window_) {
     BT_DEBUG_ASSERT(it->tx_count == 0);
     SendPdu(&*it);
-    last_tx_seq_ = it->buf.To<SimpleInformationFrameHeader>().tx_seq();
+    last_tx_seq_ = it->buf->To<SimpleInformationFrameHeader>().tx_seq();
     ++it;
   }
 }
@@ -306,7 +321,31 @@ void Engine::StartReceiverReadyPollTimer() {
   BT_DEBUG_ASSERT(!monitor_task_.is_pending());
   n_receiver_ready_polls_sent_ = 0;
   receiver_ready_poll_task_.Cancel();
-  receiver_ready_poll_task_.PostAfter(kErtmReceiverReadyPollTimerDuration);
+  receiver_ready_poll_task_.PostAfter(ReceiverReadyPollTimeout());
+}
+
+void Engine::UpdateRoundTripTime(pw::chrono::SystemClock::duration sample) {
+  if (!smoothed_rtt_.has_value()) {
+    smoothed_rtt_ = sample;
+    rtt_variation_ = sample / 2;
+    return;
+  }
+  const auto deviation = sample > *smoothed_rtt_ ? sample - *smoothed_rtt_
+                                                 : *smoothed_rtt_ - sample;
+  rtt_variation_ = (rtt_variation_ * 3 + deviation) / 4;
+  smoothed_rtt_ = (*smoothed_rtt_ * 7 + sample) / 8;
+}
+
+pw::chrono::SystemClock::duration Engine::ReceiverReadyPollTimeout() const {
+  const pw::chrono::SystemClock::duration max_timeout =
+      kErtmReceiverReadyPollTimerDuration;
+  if (!smoothed_rtt_.has_value()) {
+    return max_timeout;
+  }
+  const pw::chrono::SystemClock::duration min_timeout =
+      kErtmMinReceiverReadyPollTimerDuration;
+  return std::clamp(
+      *smoothed_rtt_ + rtt_variation_ * 4, min_timeout, max_timeout);
 }
 
 void Engine::StartMonitorTimer() {
@@ -360,8 +399,11 @@ uint8_t Engine::NumUnackedFrames() {
 
 void Engine::SendPdu(PendingPdu* pdu) {
   BT_DEBUG_ASSERT(pdu);
-  pdu->buf.AsMutable<SimpleInformationFrameHeader>()->set_receive_seq_num(
+  pdu->buf->AsMutable<SimpleInformationFrameHeader>()->set_receive_seq_num(
       req_seqnum_);
+  if (pdu->tx_count == 0) {
+    pdu->first_tx_time = pw_dispatcher_.now();
+  }
 
   // Prevent tx_count from overflowing to zero, as that would be
   // indistinguishable from "never transmitted." This is only possible when
@@ -371,7 +413,13 @@ void Engine::SendPdu(PendingPdu* pdu) {
     pdu->tx_count++;
   }
   StartReceiverReadyPollTimer();
-  send_frame_callback_(std::make_unique<DynamicByteBuffer>(pdu->buf));
+
+  // Send a copy from the buffer pools, as |pdu| must be kept for
+  // retransmission until it is acknowledged.
+  MutableByteBufferPtr frame = NewBuffer(pdu->buf->size());
+  BT_ASSERT(frame);
+  pdu->buf->Copy(frame.get());
+  send_frame_callback_(std::move(frame));
 }
 
 bool Engine::RetransmitUnackedData(std::optional<uint8_t> only_with_seq,
@@ -403,7 +451,7 @@ bool Engine::RetransmitUnackedData(std::optional<uint8_t> only_with_seq,
     BT_DEBUG_ASSERT(cur_frame != pending_pdus_.end());
 
     const auto control_field =
-        cur_frame->buf.To<SimpleInformationFrameHeader>();
+        cur_frame->buf->To<SimpleInformationFrameHeader>();
     if (only_with_seq.has_value() && control_field.tx_seq() != *only_with_seq) {
       continue;
     }
@@ -420,7 +468,7 @@ bool Engine::RetransmitUnackedData(std::optional<uint8_t> only_with_seq,
     }
 
     if (set_is_poll_response) {
-      cur_frame->buf.AsMutable<EnhancedControlField>()->set_is_poll_response();
+      cur_frame->buf->AsMutable<EnhancedControlField>()->set_is_poll_response();
 
       // Per "Retransmit-I-frames" of Core Spec v5.0 Vol 3, Part A, Sec 8.6.5.6,
       // "the F-bit of all other [than the first] unacknowledged I-frames sent
@@ -431,7 +479,7 @@ bool Engine::RetransmitUnackedData(std::optional<uint8_t> only_with_seq,
     // TODO(fxbug.dev/42087625): If the task is already running, we should not
     // restart it.
     SendPdu(&*cur_frame);
-    *cur_frame->buf.AsMutable<EnhancedControlField>() = control_field;
+    *cur_frame->buf->AsMutable<EnhancedControlField>() = control_field;
   }
 
   return true;
@@ -2393,5 +2393,99 @@ TEST_F(
   EXPECT_EQ(0u, n_info_frames);
 }
 
+TEST_F(EnhancedRetransmissionModeTxEngineTest,
+       ReceiverReadyPollTimeoutAdaptsToMeasuredRoundTripTime) {
+  ByteBufferPtr last_pdu;
+  auto tx_callback = [&](auto pdu) { last_pdu = std::move(pdu); };
+  TxEngine tx_engine(kTestChannelId,
+                     kDefaultMTU,
+                     kDefaultMaxTransmissions,
+                     kDefaultTxWindow,
+                     tx_callback,
+                     NoOpFailureCallback,
+                     dispatcher());
+
+  // Measure a round-trip time of 200 ms.
+  tx_engine.QueueSdu(std::make_unique<DynamicByteBuffer>(kDefaultPayload));
+  ASSERT_FALSE(RunFor(std::chrono::milliseconds(200)));
+  tx_engine.UpdateAckSeq(1, /*is_poll_response=*/false);
+
+  // The timeout is the smoothed round-trip time plus four times its variation,
+  // which starts at half of the first sample.
+  tx_engine.QueueSdu(std::make_unique<DynamicByteBuffer>(kDefaultPayload));
+  last_pdu = nullptr;
+  EXPECT_FALSE(RunFor(std::chrono::milliseconds(599)));
+  EXPECT_FALSE(last_pdu);
+  SCOPED_TRACE("");
+  EXPECT_TRUE(RunFor(std::chrono::milliseconds(1)));
+  VerifyIsReceiverReadyPollFrame(last_pdu.get());
+}
+
+TEST_F(EnhancedRetransmissionModeTxEngineTest,
+       ReceiverReadyPollTimeoutIsAtLeastMinimumDuration) {
+  ByteBufferPtr last_pdu;
+  auto tx_callback = [&](auto pdu) { last_pdu = std::move(pdu); };
+  TxEngine tx_engine(kTestChannelId,
+                     kDefaultMTU,
+                     kDefaultMaxTransmissions,
+                     kDefaultTxWindow,
+                     tx_callback,
+                     NoOpFailureCallback,
+                     dispatcher());
+
+  // Acknowledge a frame without any delay.
+  tx_engine.QueueSdu(std::make_unique<DynamicByteBuffer>(kDefaultPayload));
+  tx_engine.UpdateAckSeq(1, /*is_poll_response=*/false);
+
+  tx_engine.QueueSdu(std::make_unique<DynamicByteBuffer>(kDefaultPayload));
+  last_pdu = nullptr;
+  EXPECT_FALSE(RunFor(kErtmMinReceiverReadyPollTimerDuration -
+                      std::chrono::milliseconds(1)));
+  EXPECT_FALSE(last_pdu);
+  SCOPED_TRACE("");
+  EXPECT_TRUE(RunFor(std::chrono::milliseconds(1)));
+  VerifyIsReceiverReadyPollFrame(last_pdu.get());
+}
+
+TEST_F(EnhancedRetransmissionModeTxEngineTest,
+       AckOfRetransmittedFrameDoesNotChangeReceiverReadyPollTimeout) {
+  size_t n_info_frames = 0;
+  ByteBufferPtr last_pdu;
+  auto tx_callback = [&](ByteBufferPtr pdu) {
+    if (pdu && pdu->size() >= sizeof(EnhancedControlField) &&
+        pdu->To<EnhancedControlField>().designates_information_frame()) {
+      ++n_info_frames;
+    }
+    last_pdu = std::move(pdu);
+  };
+  TxEngine tx_engine(kTestChannelId,
+                     kDefaultMTU,
+                     /*max_transmissions=*/2,
+                     kDefaultTxWindow,
+                     tx_callback,
+                     NoOpFailureCallback,
+                     dispatcher());
+
+  // Poll for the unacknowledged frame, then retransmit it when the poll
+  // response doesn't acknowledge it.
+  tx_engine.QueueSdu(std::make_unique<DynamicByteBuffer>(kDefaultPayload));
+  ASSERT_TRUE(RunFor(kErtmReceiverReadyPollTimerDuration));
+  tx_engine.UpdateAckSeq(0, /*is_poll_response=*/true);
+  ASSERT_EQ(2u, n_info_frames);
+
+  // It's ambiguous which transmission this acknowledges, so it's not used to
+  // measure the round-trip time.
+  tx_engine.UpdateAckSeq(1, /*is_poll_response=*/false);
+
+  tx_engine.QueueSdu(std::make_unique<DynamicByteBuffer>(kDefaultPayload));
+  last_pdu = nullptr;
+  EXPECT_FALSE(RunFor(kErtmReceiverReadyPollTimerDuration -
+                      std::chrono::milliseconds(1)));
+  EXPECT_FALSE(last_pdu);
+  SCOPED_TRACE("");
+  EXPECT_TRUE(RunFor(std::chrono::milliseconds(1)));
+  VerifyIsReceiverReadyPollFrame(last_pdu.get());
+}
+
 }  // namespace
 }  // namespace bt::l2cap::internal
@@ -16,6 +16,7 @@
 
 #include <cpp-string/string_printf.h>
 
+#include <algorithm>
 #include <functional>
 
 #include "pw_bluetooth_sapphire/internal/host/common/assert.h"
@@ -336,6 +337,16 @@ bool LogicalLink::HasAvailablePacket() const {
   return false;
 }
 
+uint8_t LogicalLink::tx_weight() const {
+  uint8_t weight = kDefaultTxWeight;
+  for (auto& [_, channel] : channels_) {
+    if (channel->HasPDUs() || channel->HasFragments()) {
+      weight = std::max(weight, channel->tx_weight());
+    }
+  }
+  return weight;
+}
+
 void LogicalLink::RoundRobinChannels() {
   // Go through all channels in map
   if (next(current_channel_) == channels_.end()) {
@@ -350,16 +361,31 @@ bool LogicalLink::IsNextPacketContinuingFragment() const {
          current_pdus_channel_->HasFragments();
 }
 
+bool LogicalLink::CurrentChannelMaySendNextPdu() const {
+  return current_pdus_channel_.is_alive() &&
+         current_pdus_channel_->HasPDUs() &&
+         current_channel_pdus_remaining_ > 0;
+}
+
 std::unique_ptr<hci::ACLDataPacket> LogicalLink::GetNextOutboundPacket() {
   for (size_t i = 0; i < channels_.size(); i++) {
     if (!IsNextPacketContinuingFragment()) {
-      current_pdus_channel_ = ChannelImpl::WeakPtr();
+      if (!CurrentChannelMaySendNextPdu()) {
+        current_pdus_channel_ = ChannelImpl::WeakPtr();
 
-      // Go to next channel to try and get next packet to send
-      RoundRobinChannels();
+        // Go to next channel to try and get next packet to send
+        RoundRobinChannels();
+
+        if (current_channel_->second->HasPDUs()) {
+          current_pdus_channel_ = current_channel_->second->GetWeakPtr();
+          current_channel_pdus_remaining_ =
+              current_pdus_channel_->tx_weight();
+        }
+      }
 
-      if (current_channel_->second->HasPDUs()) {
-        current_pdus_channel_ = current_channel_->second->GetWeakPtr();
+      if (current_pdus_channel_.is_alive()) {
+        // The next packet starts a new PDU.
+        current_channel_pdus_remaining_--;
       }
     }
 
@@ -300,5 +300,93 @@ TEST(PduTest, ReadMultipleFragments) {
   EXPECT_EQ("is a tesXXXXXXX", pdu_data.AsString());
 }
 
+TEST(PduTest, ReleasePayloadSingleFragmentDoesNotCopy) {
+  Recombiner recombiner(0x0001);
+
+  // clang-format off
+
+  auto packet = PacketFromBytes(
+    // ACL data header
+    0x01, 0x00, 0x08, 0x00,
+
+    // Basic l2cap header
+    0x04, 0x00, 0xFF, 0xFF, 'T', 'e', 's', 't'
+  );
+
+  // clang-format on
+
+  const uint8_t* payload_data =
+      packet->view().payload_data().data() + sizeof(BasicHeader);
+  auto result = recombiner.ConsumeFragment(std::move(packet));
+  ASSERT_TRUE(result.pdu);
+
+  PDU pdu = std::move(*result.pdu);
+  ByteBufferPtr payload = pdu.ReleasePayload();
+  EXPECT_FALSE(pdu.is_valid());
+  ASSERT_TRUE(payload);
+  EXPECT_EQ("Test", payload->AsString());
+  EXPECT_EQ(payload_data, payload->data());
+}
+
+TEST(PduTest, ReleasePayloadSingleFragmentSubrange) {
+  Recombiner recombiner(0x0001);
+
+  // clang-format off
+
+  auto packet = PacketFromBytes(
+    // ACL data header
+    0x01, 0x00, 0x08, 0x00,
+
+    // Basic l2cap header
+    0x04, 0x00, 0xFF, 0xFF, 'T', 'e', 's', 't'
+  );
+
+  // clang-format on
+
+  auto result = recombiner.ConsumeFragment(std::move(packet));
+  ASSERT_TRUE(result.pdu);
+
+  ByteBufferPtr payload = result.pdu->ReleasePayload(1, 2);
+  ASSERT_TRUE(payload);
+  EXPECT_EQ("es", payload->AsString());
+}
+
+TEST(PduTest, ReleasePayloadMultipleFragments) {
+  Recombiner recombiner(0x0001);
+
+  // clang-format off
+
+  // Partial initial fragment
+  auto packet0 = PacketFromBytes(
+    // ACL data header (PBF: initial fragment)
+    0x01, 0x00, 0x0A, 0x00,
+
+    // Basic l2cap header
+    0x0F, 0x00, 0xFF, 0xFF, 'T', 'h', 'i', 's', ' ', 'i'
+  );
+
+  // Continuation fragment
+  auto packet1 = PacketFromBytes(
+    // ACL data header (PBF: continuing fragment)
+    0x01, 0x10, 0x09, 0x00,
+
+    // L2CAP PDU fragment
+    's', ' ', 'a', ' ', 't', 'e', 's', 't', '!'
+  );
+
+  // clang-format on
+
+  EXPECT_FALSE(recombiner.ConsumeFragment(std::move(packet0)).frames_dropped);
+  auto result = recombiner.ConsumeFragment(std::move(packet1));
+  ASSERT_TRUE(result.pdu);
+  EXPECT_EQ(2u, result.pdu->fragment_count());
+
+  // Release bytes spanning both fragments.
+  ByteBufferPtr payload = result.pdu->ReleasePayload(5, 8);
+  EXPECT_FALSE(result.pdu->is_valid());
+  ASSERT_TRUE(payload);
+  EXPECT_EQ("is a tes", payload->AsString());
+}
+
 }  // namespace
 }  // namespace bt
@@ -1306,6 +1306,76 @@ void FakeController::OnLEConnectionUpdateCommandReceived(
   NotifyLEConnectionParameters(peer->address(), conn_params);
 }
 
+void FakeController::OnLESetDataLength(
+    const pw::bluetooth::emboss::LESetDataLengthCommandView& params) {
+  hci_spec::ConnectionHandle handle = params.connection_handle().Read();
+  FakePeer* peer = FindByConnHandle(handle);
+  if (!peer) {
+    RespondWithCommandComplete(
+        hci_spec::kLESetDataLength,
+        pw::bluetooth::emboss::StatusCode::UNKNOWN_CONNECTION_ID);
+    return;
+  }
+
+  RespondWithCommandComplete(hci_spec::kLESetDataLength,
+                             pw::bluetooth::emboss::StatusCode::SUCCESS);
+
+  // The Data Length Change event is only sent if the data length changed.
+  uint16_t max_tx_octets = params.tx_octets().UncheckedRead();
+  if (max_tx_octets == peer->le_max_tx_octets()) {
+    return;
+  }
+  peer->set_le_max_tx_octets(max_tx_octets);
+
+  auto packet = hci::EmbossEventPacket::New<
+      pw::bluetooth::emboss::LEDataLengthChangeSubeventWriter>(
+      hci_spec::kLEMetaEventCode);
+  auto view = packet.view_t();
+  view.le_meta_event().subevent_code().Write(
+      hci_spec::kLEDataLengthChangeSubeventCode);
+  view.connection_handle().CopyFrom(params.connection_handle());
+  view.max_tx_octets().UncheckedWrite(max_tx_octets);
+  view.max_tx_time().UncheckedCopyFrom(params.tx_time());
+  view.max_rx_octets().UncheckedWrite(max_tx_octets);
+  view.max_rx_time().UncheckedCopyFrom(params.tx_time());
+  SendCommandChannelPacket(packet.data());
+}
+
+void FakeController::OnLESetPHY(
+    const pw::bluetooth::emboss::LESetPHYCommandView& params) {
+  hci_spec::ConnectionHandle handle = params.connection_handle().Read();
+  FakePeer* peer = FindByConnHandle(handle);
+  if (!peer) {
+    RespondWithCommandStatus(
+        hci_spec::kLESetPHY,
+        pw::bluetooth::emboss::StatusCode::UNKNOWN_CONNECTION_ID);
+    return;
+  }
+
+  RespondWithCommandStatus(hci_spec::kLESetPHY,
+                           pw::bluetooth::emboss::StatusCode::SUCCESS);
+
+  // Use the LE 2M PHY in both directions if the host prefers it for either,
+  // and the LE 1M PHY otherwise.
+  hci_spec::LEPHY phy =
+      params.tx_phys().le_2m().Read() || params.rx_phys().le_2m().Read()
+          ? hci_spec::LEPHY::kLE2M
+          : hci_spec::LEPHY::kLE1M;
+  peer->set_le_phy(phy);
+
+  auto packet = hci::EmbossEventPacket::New<
+      pw::bluetooth::emboss::LEPHYUpdateCompleteSubeventWriter>(
+      hci_spec::kLEMetaEventCode);
+  auto view = packet.view_t();
+  view.le_meta_event().subevent_code().Write(
+      hci_spec::kLEPHYUpdateCompleteSubeventCode);
+  view.status().Write(pw::bluetooth::emboss::StatusCode::SUCCESS);
+  view.connection_handle().CopyFrom(params.connection_handle());
+  view.tx_phy().Write(static_cast<pw::bluetooth::emboss::LEPHY>(phy));
+  view.rx_phy().Write(static_cast<pw::bluetooth::emboss::LEPHY>(phy));
+  SendCommandChannelPacket(packet.data());
+}
+
 void FakeController::OnDisconnectCommandReceived(
     const pw::bluetooth::emboss::DisconnectCommandView& params) {
   hci_spec::ConnectionHandle handle = params.connection_handle().Read();
@@ -4023,6 +4093,7 @@ void FakeController::HandleReceivedCommandPacket(
     case hci_spec::kLESetAdvertisingEnable:
     case hci_spec::kLESetAdvertisingParameters:
     case hci_spec::kLESetAdvertisingSetRandomAddress:
+    case hci_spec::kLESetDataLength:
     case hci_spec::kLESetEventMask:
     case hci_spec::kLESetExtendedAdvertisingData:
     case hci_spec::kLESetExtendedAdvertisingEnable:
@@ -4030,6 +4101,7 @@ void FakeController::HandleReceivedCommandPacket(
     case hci_spec::kLESetExtendedScanEnable:
     case hci_spec::kLESetExtendedScanParameters:
     case hci_spec::kLESetExtendedScanResponseData:
+    case hci_spec::kLESetPHY:
     case hci_spec::kLESetRandomAddress:
     case hci_spec::kLESetScanEnable:
     case hci_spec::kLESetScanParameters:
@@ -4377,6 +4449,19 @@ void FakeController::HandleReceivedCommandPacket(
       OnLEConnectionUpdateCommandReceived(params);
       break;
     }
+    case hci_spec::kLESetDataLength: {
+      const auto& params =
+          command_packet
+              .view<pw::bluetooth::emboss::LESetDataLengthCommandView>();
+      OnLESetDataLength(params);
+      break;
+    }
+    case hci_spec::kLESetPHY: {
+      const auto& params =
+          command_packet.view<pw::bluetooth::emboss::LESetPHYCommandView>();
+      OnLESetPHY(params);
+      break;
+    }
     case hci_spec::kLEStartEncryption: {
       const auto& params =
           command_packet
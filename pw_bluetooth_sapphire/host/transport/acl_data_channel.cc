@@ -16,6 +16,7 @@
 
 #include <endian.h>
 
+#include <algorithm>
 #include <iterator>
 
 #include "lib/fit/function.h"
@@ -53,8 +54,15 @@ class AclDataChannelImpl final : public AclDataChannel {
       fit::callback<void(fit::result<fit::failed>)> callback) override;
 
  private:
-  using ConnectionMap = std::unordered_map<hci_spec::ConnectionHandle,
-                                           WeakPtr<ConnectionInterface>>;
+  struct ConnectionData {
+    WeakPtr<ConnectionInterface> connection;
+    // The number of packets the connection may still send in its current
+    // round-robin turn.
+    size_t deficit = 0;
+  };
+
+  using ConnectionMap =
+      std::unordered_map<hci_spec::ConnectionHandle, ConnectionData>;
 
   struct PendingPacketData {
     bt::LinkType ll_type = bt::LinkType::kACL;
@@ -68,9 +76,9 @@ class AclDataChannelImpl final : public AclDataChannel {
 
   // Sends next queued packets over the ACL data channel while the controller
   // has free buffer slots. If controller buffers are free and some links have
-  // queued packets, we round-robin iterate through links, sending a packet from
-  // each link with queued packets until the controller is full or we run out of
-  // packets.
+  // queued packets, we round-robin iterate through links, sending up to
+  // |tx_weight()| packets from each link with queued packets until the
+  // controller is full or we run out of packets.
   void TrySendNextPackets();
 
   // Returns the number of free controller buffer slots for packets of type
@@ -104,9 +112,12 @@ class AclDataChannelImpl final : public AclDataChannel {
   // on |connection|.
   void IncrementPendingPacketsForLink(WeakPtr<ConnectionInterface>& connection);
 
-  // Sends queued packets from links in a round-robin fashion, starting with
-  // |current_link|. |current_link| will be incremented to the next link that
-  // should send packets (according to the round-robin policy).
+  // Sends queued packets from links using deficit round-robin scheduling,
+  // starting with |current_link|. Each turn, a link may send up to its
+  // |tx_weight()| packets. If buffer space runs out partway through a turn, the
+  // link keeps the rest of its turn for when space becomes available.
+  // |current_link| will be incremented to the next link that should send
+  // packets (according to the round-robin policy).
   void SendPackets(ConnectionMap::iterator& current_link);
 
   // Handler for HCI_Buffer_Overflow_event.
@@ -231,8 +242,8 @@ void AclDataChannelImpl::RegisterConnection(
          "hci",
          "ACL register connection (handle: %#.4x)",
          connection->handle());
-  auto [_, inserted] =
-      registered_connections_.emplace(connection->handle(), connection);
+  auto [_, inserted] = registered_connections_.emplace(
+      connection->handle(), ConnectionData{connection});
   BT_ASSERT_MSG(inserted,
                 "connection with handle %#.4x already registered",
                 connection->handle());
@@ -279,12 +290,13 @@ void AclDataChannelImpl::IncrementRoundRobinIterator(
       conn_iter = registered_connections_.begin();
     }
   } while (!IsBrEdrBufferShared() &&
-           conn_iter->second->type() != connection_type &&
+           conn_iter->second.connection->type() != connection_type &&
            conn_iter != original_conn_iter);
 
   // When buffer isn't shared, we must ensure |conn_iter| is assigned to a link
   // of the same type.
-  if (!IsBrEdrBufferShared() && conn_iter->second->type() != connection_type) {
+  if (!IsBrEdrBufferShared() &&
+      conn_iter->second.connection->type() != connection_type) {
     // There are no connections of |connection_type| in
     // |registered_connections_|.
     conn_iter = registered_connections_.end();
@@ -302,7 +314,7 @@ void AclDataChannelImpl::IncrementPendingPacketsForLink(
 void AclDataChannelImpl::SendPackets(ConnectionMap::iterator& current_link) {
   BT_DEBUG_ASSERT(current_link != registered_connections_.end());
   const ConnectionMap::iterator original_link = current_link;
-  const LinkType link_type = original_link->second->type();
+  const LinkType link_type = original_link->second.connection->type();
   size_t free_buffer_packets = GetNumFreePacketsForLinkType(link_type);
   bool is_packet_queued = true;
 
@@ -318,18 +330,38 @@ void AclDataChannelImpl::SendPackets(ConnectionMap::iterator& current_link) {
       is_packet_queued = false;
     }
 
-    if (!current_link->second->HasAvailablePacket()) {
+    ConnectionData& data = current_link->second;
+    if (!data.connection->HasAvailablePacket()) {
+      // A link that runs out of packets forfeits the rest of its turn.
+      data.deficit = 0;
       continue;
     }
 
-    // If there is an available packet, send and update packet counts
-    ACLDataPacketPtr packet = current_link->second->GetNextOutboundPacket();
-    BT_DEBUG_ASSERT(packet);
-    hci_->SendAclData(packet->view().data().subspan());
+    if (data.deficit == 0) {
+      // Start a new turn for this link.
+      data.deficit = std::max<size_t>(data.connection->tx_weight(), 1);
+    }
 
-    is_packet_queued = true;
-    free_buffer_packets--;
-    IncrementPendingPacketsForLink(current_link->second);
+    // While there are available packets, send and update packet counts
+    while (free_buffer_packets != 0 && data.deficit != 0 &&
+           data.connection->HasAvailablePacket()) {
+      ACLDataPacketPtr packet = data.connection->GetNextOutboundPacket();
+      BT_DEBUG_ASSERT(packet);
+      hci_->SendAclData(packet->view().data().subspan());
+
+      is_packet_queued = true;
+      free_buffer_packets--;
+      data.deficit--;
+      IncrementPendingPacketsForLink(data.connection);
+    }
+
+    if (!data.connection->HasAvailablePacket()) {
+      data.deficit = 0;
+    } else if (data.deficit != 0) {
+      // Buffer space ran out partway through this link's turn, so resume with
+      // this link once space is available.
+      break;
+    }
   }
 }
 
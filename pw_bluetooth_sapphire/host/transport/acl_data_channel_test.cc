@@ -1150,6 +1150,92 @@ TEST_F(AclDataChannelTest,
   EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
 }
 
+TEST_F(AclDataChannelTest, LinksShareBufferInProportionToTxWeight) {
+  // A single buffer slot makes the order in which links are served independent
+  // of the order in which connections are registered.
+  InitializeACLDataChannel(DataBufferInfo(kMaxMtu, /*max_num_packets=*/1),
+                           DataBufferInfo());
+
+  FakeAclConnection connection_0(acl_data_channel(), kConnectionHandle0);
+  FakeAclConnection connection_1(acl_data_channel(), kConnectionHandle1);
+  connection_0.set_tx_weight(2);
+
+  acl_data_channel()->RegisterConnection(connection_0.GetWeakPtr());
+  acl_data_channel()->RegisterConnection(connection_1.GetWeakPtr());
+
+  auto queue_packet = [](FakeAclConnection& connection, uint8_t payload) {
+    ACLDataPacketPtr packet =
+        ACLDataPacket::New(connection.handle(),
+                           hci_spec::ACLPacketBoundaryFlag::kFirstNonFlushable,
+                           hci_spec::ACLBroadcastFlag::kPointToPoint,
+                           /*payload_size=*/1);
+    packet->mutable_view()->mutable_payload_data()[0] = payload;
+    connection.QueuePacket(std::move(packet));
+  };
+  auto expect_packet = [this](hci_spec::ConnectionHandle handle,
+                              uint8_t payload) {
+    EXPECT_ACL_PACKET_OUT(test_device(),
+                          StaticByteBuffer(
+                              // ACL data header (length 1)
+                              LowerBits(handle),
+                              UpperBits(handle),
+                              // payload length
+                              0x01,
+                              0x00,
+                              // payload
+                              payload));
+  };
+
+  // The first packet fills the controller buffer and leaves |connection_1|
+  // next in turn.
+  expect_packet(kConnectionHandle0, 0);
+  queue_packet(connection_0, 0);
+  RunUntilIdle();
+  EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+
+  for (uint8_t i = 1; i <= 6; ++i) {
+    queue_packet(connection_0, i);
+    queue_packet(connection_1, i);
+  }
+  RunUntilIdle();
+
+  // |connection_0| sends two packets for each packet sent by |connection_1|,
+  // even though buffer space is only freed one packet at a time.
+  const std::pair<hci_spec::ConnectionHandle, uint8_t> kExpectedOrder[] = {
+      {kConnectionHandle1, 1},
+      {kConnectionHandle0, 1},
+      {kConnectionHandle0, 2},
+      {kConnectionHandle1, 2},
+      {kConnectionHandle0, 3},
+      {kConnectionHandle0, 4},
+      {kConnectionHandle1, 3},
+      {kConnectionHandle0, 5},
+      {kConnectionHandle0, 6},
+  };
+  hci_spec::ConnectionHandle last_handle = kConnectionHandle0;
+  for (const auto& [handle, payload] : kExpectedOrder) {
+    expect_packet(handle, payload);
+    test_device()->SendCommandChannelPacket(
+        bt::testing::NumberOfCompletedPacketsPacket(last_handle, 1));
+    RunUntilIdle();
+    EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+    last_handle = handle;
+  }
+
+  EXPECT_EQ(connection_0.queued_packets().size(), 0u);
+  EXPECT_EQ(connection_1.queued_packets().size(), 3u);
+
+  // With |connection_0| idle, |connection_1| gets all of the buffer space.
+  for (uint8_t payload = 4; payload <= 6; ++payload) {
+    expect_packet(kConnectionHandle1, payload);
+    test_device()->SendCommandChannelPacket(
+        bt::testing::NumberOfCompletedPacketsPacket(last_handle, 1));
+    RunUntilIdle();
+    EXPECT_TRUE(test_device()->AllExpectedDataPacketsSent());
+    last_handle = kConnectionHandle1;
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(AclDataChannelTest,
                          AclDataChannelBREDRAndBothBuffers,
                          ::testing::ValuesIn(bredr_both_buffers));
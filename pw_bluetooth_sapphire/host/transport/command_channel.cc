@@ -45,6 +45,45 @@ static bool IsAsync(hci_spec::EventCode code) {
          code != hci_spec::kCommandStatusEventCode;
 }
 
+// Returns true for commands that only write controller state, so that sending
+// the same command twice in a row has the same effect as sending it once.
+static bool IsCoalescable(hci_spec::OpCode opcode) {
+  switch (opcode) {
+    case hci_spec::kLESetExtendedScanEnable:
+    case hci_spec::kLESetExtendedScanParameters:
+    case hci_spec::kLESetScanEnable:
+    case hci_spec::kLESetScanParameters:
+    case hci_spec::kWritePageScanActivity:
+    case hci_spec::kWritePageScanType:
+    case hci_spec::kWriteScanEnable:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static BufferView CommandPacketData(
+    const CommandChannel::CommandPacketVariant& packet) {
+  return std::visit(
+      overloaded{
+          [](const std::unique_ptr<CommandPacket>& p) {
+            return p->view().data();
+          },
+          [](const EmbossCommandPacket& p) { return p.data(); }},
+      packet);
+}
+
+// Names of the inspect properties for the buckets of a
+// CommandChannel::LatencyHistogram.
+constexpr std::array<const char*, CommandChannel::kNumLatencyBuckets>
+    kLatencyBucketNames = {"lt_1ms",
+                           "lt_4ms",
+                           "lt_16ms",
+                           "lt_64ms",
+                           "lt_256ms",
+                           "lt_1024ms",
+                           "ge_1024ms"};
+
 static std::string EventTypeToString(CommandChannel::EventType event_type) {
   switch (event_type) {
     case CommandChannel::EventType::kHciEvent:
@@ -79,6 +118,7 @@ CommandChannel::TransactionData::TransactionData(
       exclusions_(std::move(exclusions)),
       callback_(std::move(callback)),
       timeout_task_(channel_->dispatcher_),
+      queued_time_(channel_->dispatcher_.now()),
       handler_id_(0u) {
   BT_DEBUG_ASSERT(transaction_id != 0u);
   exclusions_.insert(opcode_);
@@ -113,39 +153,84 @@ void CommandChannel::TransactionData::Complete(
     std::unique_ptr<EventPacket> event) {
   timeout_task_.Cancel();
 
-  std::visit(
-      [this, &event](auto& cb) {
-        using T = std::decay_t<decltype(cb)>;
-
-        if (!cb) {
-          return;
-        }
+  auto complete = [&event](TransactionId id, CommandCallbackVariant& callback) {
+    std::visit(
+        [id, &event](auto& cb) {
+          using T = std::decay_t<decltype(cb)>;
+
+          if (!cb) {
+            return;
+          }
+
+          // Call callback_ synchronously to ensure that asynchronous status &
+          // complete events are not handled out of order if they are
+          // dispatched from the HCI API simultaneously.
+          if constexpr (std::is_same_v<T, CommandCallback>) {
+            cb(id, *event);
+          } else {
+            EmbossEventPacket packet =
+                EmbossEventPacket::New(event->view().size());
+            MutableBufferView view = packet.mutable_data();
+            event->view().data().Copy(&view);
+            cb(id, packet);
+          }
+
+          // Asynchronous commands will have an additional reference to
+          // callback_ in the event map. Clear this reference to ensure that
+          // destruction or unexpected command complete events or status events
+          // do not call this reference to callback_ twice.
+          cb = nullptr;
+        },
+        callback);
+  };
 
-        // Call callback_ synchronously to ensure that asynchronous status &
-        // complete events are not handled out of order if they are dispatched
-        // from the HCI API simultaneously.
-        if constexpr (std::is_same_v<T, CommandCallback>) {
-          cb(transaction_id_, *event);
-        } else {
-          EmbossEventPacket packet =
-              EmbossEventPacket::New(event->view().size());
-          MutableBufferView view = packet.mutable_data();
-          event->view().data().Copy(&view);
-          cb(transaction_id_, packet);
-        }
+  complete(transaction_id_, callback_);
 
-        // Asynchronous commands will have an additional reference to callback_
-        // in the event map. Clear this reference to ensure that destruction or
-        // unexpected command complete events or status events do not call this
-        // reference to callback_ twice.
-        cb = nullptr;
-      },
-      callback_);
+  // Only synchronous commands are coalesced, so these are called once.
+  auto coalesced = std::move(coalesced_);
+  coalesced_.clear();
+  for (auto& [id, callback] : coalesced) {
+    complete(id, callback);
+  }
 }
 
 void CommandChannel::TransactionData::Cancel() {
   timeout_task_.Cancel();
   std::visit([](auto& cb) { cb = nullptr; }, callback_);
+  coalesced_.clear();
+}
+
+void CommandChannel::TransactionData::AddCoalescedTransaction(
+    TransactionId id, CommandCallbackVariant callback) {
+  coalesced_.emplace_back(id, std::move(callback));
+}
+
+bool CommandChannel::TransactionData::HasTransaction(TransactionId id) const {
+  return id == transaction_id_ ||
+         std::any_of(coalesced_.begin(),
+                     coalesced_.end(),
+                     [id](const auto& entry) { return entry.first == id; });
+}
+
+bool CommandChannel::TransactionData::RemoveCoalescedTransaction(
+    TransactionId id) {
+  if (coalesced_.empty()) {
+    return false;
+  }
+
+  auto it = coalesced_.begin();
+  if (id == transaction_id_) {
+    // The command is still sent for the oldest coalesced transaction.
+    transaction_id_ = it->first;
+    callback_ = std::move(it->second);
+  } else {
+    it = std::find_if(coalesced_.begin(),
+                      coalesced_.end(),
+                      [id](const auto& entry) { return entry.first == id; });
+    BT_DEBUG_ASSERT(it != coalesced_.end());
+  }
+  coalesced_.erase(it);
+  return true;
 }
 
 CommandChannel::EventCallbackVariant
@@ -268,6 +353,16 @@ CommandChannel::TransactionId CommandChannel::SendExclusiveCommandInternal(
   const TransactionId transaction_id = next_transaction_id_.value();
   next_transaction_id_.Set(transaction_id + 1);
 
+  // A transaction never runs alongside another with the same opcode.
+  exclusions.insert(opcode);
+  if (MaybeCoalesceCommand(transaction_id,
+                           command_packet,
+                           callback,
+                           complete_event_code,
+                           exclusions)) {
+    return transaction_id;
+  }
+
   std::unique_ptr<CommandChannel::TransactionData> data =
       std::make_unique<TransactionData>(this,
                                         transaction_id,
@@ -289,11 +384,44 @@ CommandChannel::TransactionId CommandChannel::SendExclusiveCommandInternal(
   return transaction_id;
 }
 
+bool CommandChannel::MaybeCoalesceCommand(
+    TransactionId id,
+    const CommandPacketVariant& command_packet,
+    CommandCallbackVariant& callback,
+    hci_spec::EventCode complete_event_code,
+    const std::unordered_set<hci_spec::OpCode>& exclusions) {
+  if (send_queue_.empty() || IsAsync(complete_event_code)) {
+    return false;
+  }
+
+  // Only coalesce with the last queued command so that the order of commands
+  // sent to the controller is unchanged.
+  QueuedCommand& last = send_queue_.back();
+  TransactionData& data = *last.data;
+  if (!IsCoalescable(data.opcode()) ||
+      data.complete_event_code() != complete_event_code ||
+      data.exclusions() != exclusions ||
+      !(CommandPacketData(last.packet) == CommandPacketData(command_packet))) {
+    return false;
+  }
+
+  bt_log(TRACE,
+         "hci",
+         "coalescing command id %zu into queued command id %zu",
+         id,
+         data.id());
+  data.AddCoalescedTransaction(id, std::move(callback));
+  OpcodeMetrics& metrics = GetOpcodeMetrics(data.opcode());
+  metrics.metrics.coalesced_count++;
+  metrics.coalesced_count.Set(metrics.metrics.coalesced_count);
+  return true;
+}
+
 bool CommandChannel::RemoveQueuedCommand(TransactionId transaction_id) {
   auto it = std::find_if(send_queue_.begin(),
                          send_queue_.end(),
                          [transaction_id](const QueuedCommand& cmd) {
-                           return cmd.data->id() == transaction_id;
+                           return cmd.data->HasTransaction(transaction_id);
                          });
   if (it == send_queue_.end()) {
     // The transaction to remove has already finished or never existed.
@@ -304,13 +432,84 @@ bool CommandChannel::RemoveQueuedCommand(TransactionId transaction_id) {
 
   bt_log(TRACE, "hci", "removing queued command id: %zu", transaction_id);
   TransactionData& data = *it->data;
+
+  // The command is still needed by other transactions coalesced into it.
+  if (data.RemoveCoalescedTransaction(transaction_id)) {
+    return true;
+  }
+
   data.Cancel();
 
   RemoveEventHandlerInternal(data.handler_id());
   send_queue_.erase(it);
+  UpdateSendQueueDepth();
   return true;
 }
 
+const CommandChannel::CommandMetrics* CommandChannel::command_metrics(
+    hci_spec::OpCode opcode) const {
+  auto it = command_metrics_.find(opcode);
+  if (it == command_metrics_.end()) {
+    return nullptr;
+  }
+  return &it->second.metrics;
+}
+
+CommandChannel::OpcodeMetrics& CommandChannel::GetOpcodeMetrics(
+    hci_spec::OpCode opcode) {
+  auto [it, inserted] = command_metrics_.try_emplace(opcode);
+  if (inserted) {
+    AttachOpcodeMetricsInspect(opcode, it->second);
+  }
+  return it->second;
+}
+
+void CommandChannel::AttachOpcodeMetricsInspect(hci_spec::OpCode opcode,
+                                                OpcodeMetrics& metrics) {
+  metrics.node = command_metrics_node_.CreateChild(
+      bt_lib_cpp_string::StringPrintf("opcode_%#.4x", opcode));
+  metrics.response_count = metrics.node.CreateUint(
+      "response_count", metrics.metrics.response_count);
+  metrics.coalesced_count = metrics.node.CreateUint(
+      "coalesced_count", metrics.metrics.coalesced_count);
+
+  auto attach_histogram = [&node = metrics.node](
+                              const char* name,
+                              const LatencyHistogram& histogram,
+                              LatencyHistogramInspect& histogram_inspect) {
+    histogram_inspect.node = node.CreateChild(name);
+    for (size_t i = 0; i < kNumLatencyBuckets; i++) {
+      histogram_inspect.buckets[i] = histogram_inspect.node.CreateUint(
+          kLatencyBucketNames[i], histogram[i]);
+    }
+  };
+  attach_histogram(
+      "queue_latency", metrics.metrics.queue_latency, metrics.queue_latency);
+  attach_histogram("response_latency",
+                   metrics.metrics.response_latency,
+                   metrics.response_latency);
+}
+
+void CommandChannel::RecordLatency(
+    pw::chrono::SystemClock::duration latency,
+    LatencyHistogram& histogram,
+    LatencyHistogramInspect& histogram_inspect) {
+  size_t bucket = 0;
+  while (bucket < kLatencyBucketBounds.size() &&
+         latency >= kLatencyBucketBounds[bucket]) {
+    bucket++;
+  }
+  histogram[bucket]++;
+  histogram_inspect.buckets[bucket].Set(histogram[bucket]);
+}
+
+void CommandChannel::UpdateSendQueueDepth() {
+  send_queue_depth_.Set(send_queue_.size());
+  if (*send_queue_depth_ > *max_send_queue_depth_) {
+    max_send_queue_depth_.Set(*send_queue_depth_);
+  }
+}
+
 CommandChannel::EventHandlerId CommandChannel::AddEventHandler(
     hci_spec::EventCode event_code,
     EventCallbackVariant event_callback_variant) {
@@ -462,6 +661,7 @@ void CommandChannel::RemoveEventHandlerInternal(EventHandlerId handler_id) {
 void CommandChannel::TrySendQueuedCommands() {
   if (allowed_command_packets_.value() == 0) {
     bt_log(TRACE, "hci", "controller queue full, waiting");
+    UpdateSendQueueDepth();
     return;
   }
 
@@ -512,6 +712,7 @@ void CommandChannel::TrySendQueuedCommands() {
     }
     ++it;
   }
+  UpdateSendQueueDepth();
 }
 
 void CommandChannel::SendQueuedCommand(QueuedCommand&& cmd) {
@@ -527,6 +728,13 @@ void CommandChannel::SendQueuedCommand(QueuedCommand&& cmd) {
 
   std::unique_ptr<TransactionData>& transaction = cmd.data;
 
+  const pw::chrono::SystemClock::time_point now = dispatcher_.now();
+  transaction->set_sent_time(now);
+  OpcodeMetrics& metrics = GetOpcodeMetrics(transaction->opcode());
+  RecordLatency(now - transaction->queued_time(),
+                metrics.metrics.queue_latency,
+                metrics.queue_latency);
+
   transaction->StartTimer();
 
   MaybeAddTransactionHandler(transaction.get());
@@ -655,6 +863,13 @@ void CommandChannel::UpdateTransaction(std::unique_ptr<EventPacket> event) {
   std::unique_ptr<TransactionData>& transaction_ref = it->second;
   BT_DEBUG_ASSERT(transaction_ref->opcode() == matching_opcode);
 
+  OpcodeMetrics& metrics = GetOpcodeMetrics(matching_opcode);
+  metrics.metrics.response_count++;
+  metrics.response_count.Set(metrics.metrics.response_count);
+  RecordLatency(dispatcher_.now() - transaction_ref->sent_time(),
+                metrics.metrics.response_latency,
+                metrics.response_latency);
+
   // If the command is synchronous or there's no handler to cleanup, we're done.
   if (transaction_ref->handler_id() == 0u) {
     std::unique_ptr<TransactionData> transaction = std::move(it->second);
@@ -854,6 +1069,13 @@ void CommandChannel::AttachInspect(inspect::Node& parent,
                                        "next_event_handler_id");
   allowed_command_packets_.AttachInspect(command_channel_node_,
                                          "allowed_command_packets");
+  send_queue_depth_.AttachInspect(command_channel_node_, "send_queue_depth");
+  max_send_queue_depth_.AttachInspect(command_channel_node_,
+                                      "max_send_queue_depth");
+  command_metrics_node_ = command_channel_node_.CreateChild("command_metrics");
+  for (auto& [opcode, metrics] : command_metrics_) {
+    AttachOpcodeMetricsInspect(opcode, metrics);
+  }
 }
 
 }  // namespace bt::hci
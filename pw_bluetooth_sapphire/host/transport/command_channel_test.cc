@@ -2122,6 +2122,194 @@ TEST_F(
   EXPECT_NE(0u, id);
 }
 
+EmbossCommandPacket MakeWriteScanEnable(bool inquiry, bool page) {
+  auto packet = EmbossCommandPacket::New<
+      pw::bluetooth::emboss::WriteScanEnableCommandWriter>(
+      hci_spec::kWriteScanEnable);
+  packet.view_t().scan_enable().inquiry().Write(inquiry);
+  packet.view_t().scan_enable().page().Write(page);
+  return packet;
+}
+
+// Tests:
+//  - An identical state-writing command queued behind another is not sent.
+//  - Both commands' callbacks receive the completion event, in order.
+//  - A different command with the same opcode is still sent.
+TEST_F(CommandChannelTest, CoalescesIdenticalQueuedCommands) {
+  auto req_reset =
+      StaticByteBuffer(LowerBits(hci_spec::kReset),
+                       UpperBits(hci_spec::kReset),  // HCI_Reset opcode
+                       0x00                          // parameter_total_size
+      );
+  auto rsp_reset =
+      StaticByteBuffer(hci_spec::kCommandCompleteEventCode,
+                       0x04,  // parameter_total_size (4 byte payload)
+                       0x01,  // num_hci_command_packets (1 can be sent)
+                       LowerBits(hci_spec::kReset),
+                       UpperBits(hci_spec::kReset),  // HCI_Reset opcode
+                       pw::bluetooth::emboss::StatusCode::SUCCESS);
+  auto req_page_scan = StaticByteBuffer(LowerBits(hci_spec::kWriteScanEnable),
+                                        UpperBits(hci_spec::kWriteScanEnable),
+                                        0x01,  // parameter_total_size
+                                        0x02   // page scan enabled
+  );
+  auto req_inquiry_page_scan =
+      StaticByteBuffer(LowerBits(hci_spec::kWriteScanEnable),
+                       UpperBits(hci_spec::kWriteScanEnable),
+                       0x01,  // parameter_total_size
+                       0x03   // inquiry and page scan enabled
+      );
+  auto rsp_scan_enable =
+      StaticByteBuffer(hci_spec::kCommandCompleteEventCode,
+                       0x04,  // parameter_total_size (4 byte payload)
+                       0x01,  // num_hci_command_packets (1 can be sent)
+                       LowerBits(hci_spec::kWriteScanEnable),
+                       UpperBits(hci_spec::kWriteScanEnable),
+                       pw::bluetooth::emboss::StatusCode::SUCCESS);
+  EXPECT_CMD_PACKET_OUT(test_device(), req_reset, );
+  EXPECT_CMD_PACKET_OUT(test_device(), req_page_scan, &rsp_scan_enable);
+  EXPECT_CMD_PACKET_OUT(test_device(), req_inquiry_page_scan, &rsp_scan_enable);
+
+  int transaction_count = 0u;
+  test_device()->SetTransactionCallback(
+      [&transaction_count]() { transaction_count++; });
+
+  std::vector<CommandChannel::TransactionId> completed;
+  auto cb = [&completed](CommandChannel::TransactionId id,
+                         const EventPacket& event) {
+    EXPECT_EQ(hci_spec::kCommandCompleteEventCode, event.event_code());
+    completed.push_back(id);
+  };
+
+  // Queue the commands behind a reset so that they are not sent immediately.
+  auto reset_id = cmd_channel()->SendCommand(
+      hci::EmbossCommandPacket::New<pw::bluetooth::emboss::ResetCommandWriter>(
+          hci_spec::kReset),
+      cb);
+  auto id0 = cmd_channel()->SendCommand(MakeWriteScanEnable(false, true), cb);
+  auto id1 = cmd_channel()->SendCommand(MakeWriteScanEnable(false, true), cb);
+  auto id2 = cmd_channel()->SendCommand(MakeWriteScanEnable(true, true), cb);
+  EXPECT_NE(0u, id0);
+  EXPECT_NE(0u, id1);
+  EXPECT_NE(id0, id1);
+  EXPECT_NE(0u, id2);
+  RunUntilIdle();
+  EXPECT_EQ(1, transaction_count);
+
+  test_device()->SendCommandChannelPacket(rsp_reset);
+  RunUntilIdle();
+  EXPECT_EQ(3, transaction_count);
+  EXPECT_THAT(completed, ElementsAre(reset_id, id0, id1, id2));
+
+  const CommandChannel::CommandMetrics* metrics =
+      cmd_channel()->command_metrics(hci_spec::kWriteScanEnable);
+  ASSERT_TRUE(metrics);
+  EXPECT_EQ(1u, metrics->coalesced_count);
+  EXPECT_EQ(2u, metrics->response_count);
+}
+
+// Tests:
+//  - Removing the command that another was coalesced into still sends it for
+//  the remaining transaction.
+TEST_F(CommandChannelTest, RemoveQueuedCoalescedCommand) {
+  auto req_reset =
+      StaticByteBuffer(LowerBits(hci_spec::kReset),
+                       UpperBits(hci_spec::kReset),  // HCI_Reset opcode
+                       0x00                          // parameter_total_size
+      );
+  auto rsp_reset =
+      StaticByteBuffer(hci_spec::kCommandCompleteEventCode,
+                       0x04,  // parameter_total_size (4 byte payload)
+                       0x01,  // num_hci_command_packets (1 can be sent)
+                       LowerBits(hci_spec::kReset),
+                       UpperBits(hci_spec::kReset),  // HCI_Reset opcode
+                       pw::bluetooth::emboss::StatusCode::SUCCESS);
+  auto req_page_scan = StaticByteBuffer(LowerBits(hci_spec::kWriteScanEnable),
+                                        UpperBits(hci_spec::kWriteScanEnable),
+                                        0x01,  // parameter_total_size
+                                        0x02   // page scan enabled
+  );
+  auto rsp_scan_enable =
+      StaticByteBuffer(hci_spec::kCommandCompleteEventCode,
+                       0x04,  // parameter_total_size (4 byte payload)
+                       0x01,  // num_hci_command_packets (1 can be sent)
+                       LowerBits(hci_spec::kWriteScanEnable),
+                       UpperBits(hci_spec::kWriteScanEnable),
+                       pw::bluetooth::emboss::StatusCode::SUCCESS);
+  EXPECT_CMD_PACKET_OUT(test_device(), req_reset, );
+  EXPECT_CMD_PACKET_OUT(test_device(), req_page_scan, &rsp_scan_enable);
+
+  std::vector<CommandChannel::TransactionId> completed;
+  auto cb = [&completed](CommandChannel::TransactionId id, const EventPacket&) {
+    completed.push_back(id);
+  };
+
+  cmd_channel()->SendCommand(
+      hci::EmbossCommandPacket::New<pw::bluetooth::emboss::ResetCommandWriter>(
+          hci_spec::kReset),
+      nullptr);
+  auto id0 = cmd_channel()->SendCommand(MakeWriteScanEnable(false, true), cb);
+  auto id1 = cmd_channel()->SendCommand(MakeWriteScanEnable(false, true), cb);
+  auto id2 = cmd_channel()->SendCommand(MakeWriteScanEnable(false, true), cb);
+  RunUntilIdle();
+
+  EXPECT_TRUE(cmd_channel()->RemoveQueuedCommand(id0));
+  EXPECT_FALSE(cmd_channel()->RemoveQueuedCommand(id0));
+  EXPECT_TRUE(cmd_channel()->RemoveQueuedCommand(id2));
+
+  test_device()->SendCommandChannelPacket(rsp_reset);
+  RunUntilIdle();
+  EXPECT_THAT(completed, ElementsAre(id1));
+}
+
+TEST_F(CommandChannelTest, CommandMetrics) {
+  auto req_reset =
+      StaticByteBuffer(LowerBits(hci_spec::kReset),
+                       UpperBits(hci_spec::kReset),  // HCI_Reset opcode
+                       0x00                          // parameter_total_size
+      );
+  auto rsp_reset =
+      StaticByteBuffer(hci_spec::kCommandCompleteEventCode,
+                       0x04,  // parameter_total_size (4 byte payload)
+                       0x01,  // num_hci_command_packets (1 can be sent)
+                       LowerBits(hci_spec::kReset),
+                       UpperBits(hci_spec::kReset),  // HCI_Reset opcode
+                       pw::bluetooth::emboss::StatusCode::SUCCESS);
+  EXPECT_CMD_PACKET_OUT(test_device(), req_reset, );
+  EXPECT_CMD_PACKET_OUT(test_device(), req_reset, );
+
+  EXPECT_EQ(nullptr, cmd_channel()->command_metrics(hci_spec::kReset));
+
+  // Reset is not coalesced, so the second one waits for the first to complete.
+  for (int i = 0; i < 2; i++) {
+    cmd_channel()->SendCommand(
+        hci::EmbossCommandPacket::New<
+            pw::bluetooth::emboss::ResetCommandWriter>(hci_spec::kReset),
+        nullptr);
+  }
+  RunUntilIdle();
+  EXPECT_EQ(1u, cmd_channel()->max_send_queue_depth());
+
+  RunFor(std::chrono::milliseconds(10));
+  test_device()->SendCommandChannelPacket(rsp_reset);
+  RunUntilIdle();
+
+  RunFor(std::chrono::milliseconds(100));
+  test_device()->SendCommandChannelPacket(rsp_reset);
+  RunUntilIdle();
+
+  const CommandChannel::CommandMetrics* metrics =
+      cmd_channel()->command_metrics(hci_spec::kReset);
+  ASSERT_TRUE(metrics);
+  EXPECT_EQ(2u, metrics->response_count);
+  EXPECT_EQ(0u, metrics->coalesced_count);
+  // The first reset was sent immediately and the second after 10 ms.
+  EXPECT_THAT(metrics->queue_latency, ElementsAre(1, 0, 1, 0, 0, 0, 0));
+  // The controller took 10 ms and 100 ms to respond.
+  EXPECT_THAT(metrics->response_latency, ElementsAre(0, 0, 1, 0, 1, 0, 0));
+  EXPECT_EQ(1u, cmd_channel()->max_send_queue_depth());
+}
+
 #ifndef NINSPECT
 TEST_F(CommandChannelTest, InspectHierarchy) {
   cmd_channel()->AttachInspect(inspector_.GetRoot(), "command_channel");
@@ -2129,8 +2317,10 @@ TEST_F(CommandChannelTest, InspectHierarchy) {
   auto command_channel_matcher = AllOf(NodeMatches(AllOf(
       NameMatches("command_channel"),
       PropertyList(UnorderedElementsAre(UintIs("allowed_command_packets", 1),
+                                        UintIs("max_send_queue_depth", 0),
                                         UintIs("next_event_handler_id", 1),
-                                        UintIs("next_transaction_id", 1))))));
+                                        UintIs("next_transaction_id", 1),
+                                        UintIs("send_queue_depth", 0))))));
 
   EXPECT_THAT(inspect::ReadFromVmo(inspector_.DuplicateVmo()).value(),
               ChildrenMatch(ElementsAre(command_channel_matcher)));
@@ -152,6 +152,11 @@ std::optional<pw::bluetooth::emboss::StatusCode> EmbossEventPacket::StatusCode()
                   LEReadRemoteFeaturesCompleteSubeventView>();
         }
 
+        case hci_spec::kLEPHYUpdateCompleteSubeventCode: {
+          return StatusCodeFromView<
+              pw::bluetooth::emboss::LEPHYUpdateCompleteSubeventView>();
+        }
+
         default: {
           BT_PANIC("Emboss LE meta subevent (%#.2x) not implemented",
                    subevent_code);
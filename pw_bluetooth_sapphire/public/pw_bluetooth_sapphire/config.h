@@ -22,3 +22,14 @@
 #ifndef PW_BLUETOOTH_SAPPHIRE_TRACE_ENABLED
 #define NTRACE 1
 #endif  // PW_BLUETOOTH_SAPPHIRE_TRACE_ENABLED
+
+// The number of small (64 byte) and large (2048 byte) packet buffers that
+// bt::NewBuffer() allocates from static pools. Buffers are allocated from the
+// heap when the pool for their size is exhausted, or when the count is 0.
+#ifndef PW_BLUETOOTH_SAPPHIRE_SMALL_BUFFER_COUNT
+#define PW_BLUETOOTH_SAPPHIRE_SMALL_BUFFER_COUNT 128
+#endif  // PW_BLUETOOTH_SAPPHIRE_SMALL_BUFFER_COUNT
+
+#ifndef PW_BLUETOOTH_SAPPHIRE_LARGE_BUFFER_COUNT
+#define PW_BLUETOOTH_SAPPHIRE_LARGE_BUFFER_COUNT 16
+#endif  // PW_BLUETOOTH_SAPPHIRE_LARGE_BUFFER_COUNT
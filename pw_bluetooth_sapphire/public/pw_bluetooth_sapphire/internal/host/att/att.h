@@ -344,6 +344,23 @@ struct ExecuteWriteRequestParams {
 constexpr OpCode kNotification = 0x1B;
 using NotificationParams = AttributeData;
 
+// ===================================
+// Multiple Handle Value Notification
+constexpr OpCode kMultipleHandleValueNotification = 0x23;
+
+// Each entry in the parameters of a Multiple Handle Value Notification. A PDU
+// contains two or more entries and may only be sent to a client that has
+// enabled the feature in its Client Supported Features characteristic (v5.3,
+// Vol. 3, Part F, 3.4.7.4).
+struct HandleLengthValue {
+  HandleLengthValue() = default;
+  BT_DISALLOW_COPY_ASSIGN_AND_MOVE(HandleLengthValue);
+
+  Handle handle;
+  uint16_t length;
+  uint8_t value[];
+} __attribute__((packed));
+
 // =========================
 // Handle Value Indication
 constexpr OpCode kIndication = 0x1D;
@@ -26,14 +26,38 @@ constexpr size_t kSlabSize = 32767;
 
 // Returns a slab-allocated byte buffer with |size| bytes of capacity. The
 // underlying allocation occupies |kSmallBufferSize| or |kLargeBufferSize| bytes
-// of memory, unless:
+// of memory from a fixed-size pool, unless:
 //  * |size| is 0, which returns a zero-sized byte buffer with no underlying
 //  slab allocation.
-//  * |size| exceeds |kLargeBufferSize|, which falls back to the system
-//  allocator.
+//  * |size| exceeds |kLargeBufferSize|, or the pool for its size is exhausted,
+//  which falls back to the system allocator.
 //    NOTE: In this case, if allocation fails, panic.
 //
+// The pool sizes are set by PW_BLUETOOTH_SAPPHIRE_SMALL_BUFFER_COUNT and
+// PW_BLUETOOTH_SAPPHIRE_LARGE_BUFFER_COUNT.
+//
 // Returns nullptr for failures to allocate.
 [[nodiscard]] MutableByteBufferPtr NewBuffer(size_t size);
 
+// Usage of one of the buffer pools behind NewBuffer().
+struct BufferPoolStats {
+  // Capacity of each buffer in the pool.
+  size_t buffer_size = 0;
+
+  // Number of buffers in the pool.
+  size_t num_buffers = 0;
+
+  // Number of buffers currently allocated, and the most ever allocated at once.
+  size_t in_use = 0;
+  size_t max_in_use = 0;
+
+  // Number of buffers that were allocated from the system allocator because
+  // the pool was exhausted.
+  size_t exhausted_count = 0;
+};
+
+// Returns the usage of the |kSmallBufferSize| and |kLargeBufferSize| pools.
+BufferPoolStats SmallBufferPoolStats();
+BufferPoolStats LargeBufferPoolStats();
+
 }  // namespace bt
@@ -75,8 +75,10 @@ constexpr uint64_t BuildLEEventMask() {
   ENABLE_EVT(kLEAdvertisingReport);
   ENABLE_EVT(kLEConnectionComplete);
   ENABLE_EVT(kLEConnectionUpdateComplete);
+  ENABLE_EVT(kLEDataLengthChange);
   ENABLE_EVT(kLEExtendedAdvertisingSetTerminated);
   ENABLE_EVT(kLELongTermKeyRequest);
+  ENABLE_EVT(kLEPHYUpdateComplete);
   ENABLE_EVT(kLEReadRemoteFeaturesComplete);
 
 #undef ENABLE_EVT
@@ -271,6 +271,25 @@ class LowEnergyConnection final : public sm::Delegate {
   // v5.2, Vol 6, Part B, Sec 5.1.7.1).
   void OnLEConnectionUpdateComplete(const hci::EmbossEventPacket& event);
 
+  // If |connection_options_| request it, asks the controller to use the
+  // maximum data length and the LE 2M PHY on this connection, as supported by
+  // the peer. Interrogation must have completed before this may be called.
+  void MaybeMaximizeThroughput();
+
+  // Sends an HCI LE Set Data Length command requesting the maximum LL Data PDU
+  // payload size and transmit time.
+  void RequestMaxDataLength();
+
+  // Sends an HCI LE Set PHY command requesting the LE 2M PHY in both
+  // directions.
+  void Request2mPhy();
+
+  // These events report the data length and PHY in use on the connection,
+  // whether they were changed at the request of either host or by the Link
+  // Layer.
+  void OnLEDataLengthChange(const hci::EmbossEventPacket& event);
+  void OnLEPhyUpdateComplete(const hci::EmbossEventPacket& event);
+
   // Updates or requests an update of the connection parameters, for central and
   // peripheral roles respectively, if interrogation has completed.
   // TODO(fxbug.dev/42159733): Wait to update connection parameters until all
@@ -349,6 +368,21 @@ class LowEnergyConnection final : public sm::Delegate {
   // Event handler ID for the HCI LE Connection Update Complete event.
   hci::CommandChannel::EventHandlerId conn_update_cmpl_handler_id_;
 
+  // Event handler IDs for the HCI LE Data Length Change and LE PHY Update
+  // Complete events.
+  hci::CommandChannel::EventHandlerId data_length_change_handler_id_;
+  hci::CommandChannel::EventHandlerId phy_update_cmpl_handler_id_;
+
+  // The maximum LL Data PDU payload sizes, in octets, and the PHYs currently
+  // used on this connection. These start at the values that every connection
+  // is established with.
+  UintInspectable<uint16_t> max_tx_octets_{hci_spec::kLEMaxTxOctetsMin};
+  UintInspectable<uint16_t> max_rx_octets_{hci_spec::kLEMaxTxOctetsMin};
+  UintInspectable<uint8_t> tx_phy_{
+      static_cast<uint8_t>(hci_spec::LEPHY::kLE1M)};
+  UintInspectable<uint8_t> rx_phy_{
+      static_cast<uint8_t>(hci_spec::LEPHY::kLE1M)};
+
   // Called with the status of the next HCI LE Connection Update Complete event.
   // The HCI LE Connection Update command does not have its own complete event
   // handler because the HCI LE Connection Complete event can be generated for
@@ -39,6 +39,11 @@ struct LowEnergyConnectionOptions {
   // When true, skip scanning before connecting. This should only be true when
   // the connection is initiated as a result of a directed advertisement.
   bool auto_connect = false;
+
+  // When true, request the maximum LE data length and the LE 2M PHY once the
+  // connection has been interrogated, if the peer supports them. This
+  // increases throughput at the cost of higher peak power consumption.
+  bool maximize_throughput = false;
 };
 
 namespace internal {
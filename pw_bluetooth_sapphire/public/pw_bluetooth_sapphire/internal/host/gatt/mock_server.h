@@ -39,18 +39,29 @@ class MockServer : public Server {
 
   bool was_shut_down() const { return was_shut_down_; }
 
+  bool multiple_handle_value_notifications_supported() const {
+    return multiple_handle_value_notifications_supported_;
+  }
+
  private:
   // Server overrides:
   void SendUpdate(IdType service_id,
                   IdType chrc_id,
                   BufferView value,
                   IndicationCallback indicate_cb) override;
+  // Calls the update handler for each of |updates|.
+  void SendNotifications(
+      const std::vector<NotificationUpdate>& updates) override;
+  void SetMultipleHandleValueNotificationsSupported(bool supported) override {
+    multiple_handle_value_notifications_supported_ = supported;
+  }
   void ShutDown() override { was_shut_down_ = true; }
 
   PeerId peer_id_;
   LocalServiceManager::WeakPtr local_services_;
   UpdateHandler update_handler_ = nullptr;
   bool was_shut_down_ = false;
+  bool multiple_handle_value_notifications_supported_ = false;
   WeakSelf<MockServer> weak_self_;
 };
 
@@ -15,6 +15,8 @@
 #pragma once
 #include <lib/fit/function.h>
 
+#include <vector>
+
 #include "pw_bluetooth_sapphire/internal/host/att/bearer.h"
 #include "pw_bluetooth_sapphire/internal/host/att/database.h"
 #include "pw_bluetooth_sapphire/internal/host/common/uuid.h"
@@ -32,6 +34,14 @@ class PacketReader;
 namespace gatt {
 using IndicationCallback = att::ResultCallback<>;
 
+// A characteristic value to notify as part of a batch. See
+// Server::SendNotifications.
+struct NotificationUpdate {
+  IdType service_id;
+  IdType chrc_id;
+  BufferView value;
+};
+
 // A GATT Server implements the server-role of the ATT protocol over a single
 // ATT Bearer. A unique Server instance should exist for each logical link that
 // supports GATT.
@@ -66,6 +76,22 @@ class Server {
                           BufferView value,
                           IndicationCallback indicate_cb) = 0;
 
+  // Sends a Handle-Value notification for each of |updates| that the peer has
+  // configured for notifications, in order. Updates for characteristics that
+  // the peer has not configured are skipped.
+  //
+  // If the peer supports Multiple Handle Value Notifications, consecutive
+  // values are packed into as few ATT PDUs as the MTU allows, which reduces the
+  // number of L2CAP SDUs and ACL packets sent. Otherwise, each value is sent in
+  // its own notification, as with SendUpdate.
+  virtual void SendNotifications(
+      const std::vector<NotificationUpdate>& updates) = 0;
+
+  // Sets whether the peer supports receiving Multiple Handle Value
+  // Notifications, as indicated by the peer writing to the Client Supported
+  // Features characteristic. This is false by default.
+  virtual void SetMultipleHandleValueNotificationsSupported(bool supported) = 0;
+
   // Shuts down the transport on which this Server operates, which may also
   // disconnect any other objects using the same transport, like the
   // gatt::Client.
@@ -24,6 +24,7 @@
 #include <queue>
 
 #include "pw_bluetooth/vendor.h"
+#include "pw_bluetooth_sapphire/internal/host/common/assert.h"
 #include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
 #include "pw_bluetooth_sapphire/internal/host/common/inspect.h"
 #include "pw_bluetooth_sapphire/internal/host/common/macros.h"
@@ -49,6 +50,10 @@ namespace bt::l2cap {
 // Maximum count of packets a channel can queue before it must drop old packets
 constexpr uint16_t kDefaultTxMaxQueuedCount = 500;
 
+// Default relative share of outbound bandwidth for a channel. See
+// Channel::set_tx_weight().
+constexpr uint8_t kDefaultTxWeight = 1;
+
 // Represents a L2CAP channel. Each instance is owned by a service
 // implementation that operates on the corresponding channel. Instances can only
 // be obtained from a ChannelManager.
@@ -242,6 +247,19 @@ class Channel : public WeakSelf<Channel> {
     return requested_acl_priority_;
   }
 
+  // Sets the relative share of outbound bandwidth that this channel gets while
+  // other channels also have data queued. Each turn, a channel may start
+  // sending up to |weight| PDUs before the next channel on the same link gets a
+  // turn, and a link may send up to the largest weight of its channels with
+  // queued data in packets before the next link sharing the controller buffer
+  // gets a turn. Latency-sensitive channels (e.g. HID or audio) should be given
+  // a higher weight than bulk data channels. |weight| must be at least 1.
+  void set_tx_weight(uint8_t weight) {
+    BT_ASSERT(weight > 0);
+    tx_weight_ = weight;
+  }
+  uint8_t tx_weight() const { return tx_weight_; }
+
  protected:
   const ChannelId id_;
   const ChannelId remote_id_;
@@ -253,6 +271,8 @@ class Channel : public WeakSelf<Channel> {
   // The ACL priority that was requested by a client and accepted by the
   // controller.
   pw::bluetooth::AclPriority requested_acl_priority_;
+  // Relative share of outbound bandwidth. See set_tx_weight().
+  uint8_t tx_weight_ = kDefaultTxWeight;
 
   BT_DISALLOW_COPY_AND_ASSIGN_ALLOW_MOVE(Channel);
 };
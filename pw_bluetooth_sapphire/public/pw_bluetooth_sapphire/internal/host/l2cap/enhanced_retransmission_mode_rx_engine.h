@@ -13,6 +13,8 @@
 // the License.
 
 #pragma once
+#include <queue>
+#include <unordered_map>
 #include <variant>
 
 #include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
@@ -24,6 +26,10 @@ namespace bt::l2cap::internal {
 // Implements the receiver state and logic for an L2CAP channel operating in
 // Enhanced Retransmission Mode.
 //
+// When I-Frames are missing, frames received after them are held and the
+// missing frames are requested with Selective Reject (SREJ) frames. Once the
+// missing frames arrive, the held SDUs are returned by PopPendingSdu().
+//
 // THREAD-SAFETY: This class is not thread-safe.
 class EnhancedRetransmissionModeRxEngine final : public RxEngine {
  public:
@@ -36,6 +42,7 @@ class EnhancedRetransmissionModeRxEngine final : public RxEngine {
   ~EnhancedRetransmissionModeRxEngine() override = default;
 
   ByteBufferPtr ProcessPdu(PDU) override;
+  ByteBufferPtr PopPendingSdu() override;
 
   // Set a callback to be invoked when any frame is received that indicates the
   // peer's acknowledgment for the sequence of packets that it received from the
@@ -102,11 +109,27 @@ class EnhancedRetransmissionModeRxEngine final : public RxEngine {
   ByteBufferPtr ProcessFrame(std::monostate, PDU);
   void AdvanceSeqNum();
 
+  // Holds the SDU of an I-Frame that follows missing frames, and sends SREJ
+  // frames for those that haven't already been requested.
+  void HoldOutOfSequenceFrame(const SimpleInformationFrameHeader, PDU);
+
   // We assume that the Extended Window Size option is _not_ enabled. In such
   // cases, the sequence number is a 6-bit counter that wraps on overflow. See
   // Core Spec Ver 5, Vol 3, Part A, Secs 5.7 and 8.3.
   uint8_t next_seqnum_;  // (AKA Expected-TxSeq)
 
+  // SDUs of frames received after missing frames, keyed by their TxSeq. The
+  // engine is in the SREJ_SENT state of Core Spec v5.0, Vol 3, Part A,
+  // Sec 8.6.5.11 while this is non-empty.
+  std::unordered_map<uint8_t, ByteBufferPtr> held_sdus_;
+
+  // The TxSeq following the newest frame that was held or requested with an
+  // SREJ frame. Only valid while |held_sdus_| is non-empty.
+  uint8_t next_srej_seqnum_ = 0;
+
+  // Held SDUs that are now in sequence, to be returned by PopPendingSdu().
+  std::queue<ByteBufferPtr> pending_sdus_;
+
   // Represents the RemoteBusy state variable (Core Spec v5.0, Vol 3, Part A,
   // Section 8.6.5.3) for whether the peer has sent a Receiver Not Ready.
   bool remote_is_busy_;
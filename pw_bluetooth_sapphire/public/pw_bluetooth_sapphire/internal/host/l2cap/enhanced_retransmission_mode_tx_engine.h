@@ -16,6 +16,7 @@
 #include <lib/fit/function.h>
 
 #include <list>
+#include <optional>
 
 #include "pw_bluetooth_sapphire/internal/host/common/smart_task.h"
 #include "pw_bluetooth_sapphire/internal/host/l2cap/tx_engine.h"
@@ -121,10 +122,13 @@ class EnhancedRetransmissionModeTxEngine final : public TxEngine {
 
  private:
   struct PendingPdu {
-    PendingPdu(DynamicByteBuffer buf_in)
+    PendingPdu(MutableByteBufferPtr buf_in)
         : buf(std::move(buf_in)), tx_count(0) {}
-    DynamicByteBuffer buf;
+    MutableByteBufferPtr buf;
     uint8_t tx_count;
+
+    // Time of the first transmission, used to measure the round-trip time.
+    pw::chrono::SystemClock::time_point first_tx_time;
   };
 
   // State of a request from a peer to retransmit a frame of unacked data (SREJ
@@ -167,6 +171,16 @@ class EnhancedRetransmissionModeTxEngine final : public TxEngine {
   //   Part A, Section 8.6.5.6, "Start-RetransTimer".
   void StartReceiverReadyPollTimer();
 
+  // Updates the round-trip time estimate with |sample|, the time between the
+  // first transmission of a frame and its acknowledgment. Callers must only
+  // pass samples for frames that were transmitted once, as it is ambiguous
+  // which transmission a retransmitted frame's acknowledgment is for.
+  void UpdateRoundTripTime(pw::chrono::SystemClock::duration sample);
+
+  // Returns the duration of the receiver ready poll timer, which is derived
+  // from the round-trip time estimate once one is available.
+  pw::chrono::SystemClock::duration ReceiverReadyPollTimeout() const;
+
   // Starts the monitor timer.  If already running, the existing timer is
   // cancelled, and a new timer is started.
   //
@@ -262,6 +276,11 @@ class EnhancedRetransmissionModeTxEngine final : public TxEngine {
   // RejActioned variable defined in Core Spec v5.0 Vol 3, Part A, Sec 8.6.5.3.
   bool retransmitted_range_during_poll_;
 
+  // Round-trip time estimate, maintained as in RFC 6298, Sec 2. Unset until
+  // the first acknowledgment of a frame that was transmitted once.
+  std::optional<pw::chrono::SystemClock::duration> smoothed_rtt_;
+  pw::chrono::SystemClock::duration rtt_variation_{};
+
   uint8_t n_receiver_ready_polls_sent_;
   bool remote_is_busy_;
   std::list<PendingPdu> pending_pdus_;
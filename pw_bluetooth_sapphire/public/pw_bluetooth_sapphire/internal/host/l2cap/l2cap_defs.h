@@ -33,6 +33,11 @@ static constexpr auto kErtmReceiverReadyPollTimerDuration = std::chrono::seconds
 static_assert(kErtmReceiverReadyPollTimerDuration <= std::chrono::milliseconds(std::numeric_limits<uint16_t>::max()));
 static constexpr uint16_t kErtmReceiverReadyPollTimerMsecs = static_cast<uint16_t>(std::chrono::duration_cast<std::chrono::milliseconds>(kErtmReceiverReadyPollTimerDuration).count());
 
+// Once the round-trip time to the peer has been measured, the receiver ready poll timer is shortened
+// to a timeout derived from it (as in RFC 6298), but is never shorter than this duration nor longer
+// than kErtmReceiverReadyPollTimerDuration.
+static constexpr auto kErtmMinReceiverReadyPollTimerDuration = std::chrono::milliseconds(100);
+
 // See Core Spec v5.0, Volume 3, Part A, Sec 8.6.2.1. Note that we assume there is no flush timeout
 // on the underlying logical link. If the link _does_ have a flush timeout, then our implementation
 // will be slower to trigger the monitor timeout than the specification recommends.
@@ -178,6 +178,10 @@ class LogicalLink : public hci::AclDataChannel::ConnectionInterface {
   bt::LinkType type() const override { return type_; }
   std::unique_ptr<hci::ACLDataPacket> GetNextOutboundPacket() override;
   bool HasAvailablePacket() const override;
+  // Returns the largest tx weight of the channels that have queued data, so
+  // that a link is scheduled according to its most latency-sensitive active
+  // channel.
+  uint8_t tx_weight() const override;
 
  private:
   friend class ChannelImpl;
@@ -253,6 +257,10 @@ class LogicalLink : public hci::AclDataChannel::ConnectionInterface {
   // already in the process of being sent
   bool IsNextPacketContinuingFragment() const;
 
+  // Return true if |current_pdus_channel_| has another PDU queued and may start
+  // sending it in its current round robin turn
+  bool CurrentChannelMaySendNextPdu() const;
+
   // Round robins through channels in logical link to get next packet to send
   // Returns nullptr if there are no connections with pending packets
   void RoundRobinChannels();
@@ -299,6 +307,10 @@ class LogicalLink : public hci::AclDataChannel::ConnectionInterface {
   // Channel that Logical Link is currently sending PDUs from
   ChannelImpl::WeakPtr current_pdus_channel_;
 
+  // Number of PDUs that |current_pdus_channel_| may still start sending in its
+  // current round robin turn
+  uint8_t current_channel_pdus_remaining_ = 0;
+
   // Manages the L2CAP signaling channel on this logical link. Depending on
   // |type_| this will either implement the LE or BR/EDR signaling commands.
   std::unique_ptr<SignalingChannel> signaling_channel_;
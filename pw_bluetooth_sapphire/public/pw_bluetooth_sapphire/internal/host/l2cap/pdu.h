@@ -15,6 +15,7 @@
 #pragma once
 #include <endian.h>
 
+#include <limits>
 #include <list>
 
 #include "pw_bluetooth_sapphire/internal/host/common/assert.h"
@@ -86,6 +87,17 @@ class PDU final {
   // this is called, the PDU will become invalid.
   FragmentList ReleaseFragments();
 
+  // Releases up to |size| bytes of the basic-frame information payload starting
+  // at offset |pos| as a contiguous buffer. Once this is called, the PDU will
+  // become invalid.
+  //
+  // If the PDU consists of a single fragment, which is the case for any PDU
+  // that fits in one ACL data packet, the returned buffer takes ownership of
+  // the fragment and refers to the payload in place without copying it.
+  // Otherwise, the payload is copied out of the fragments as by Copy().
+  ByteBufferPtr ReleasePayload(
+      size_t pos = 0, size_t size = std::numeric_limits<std::size_t>::max());
+
   void set_trace_id(trace_flow_id_t id) { trace_id_ = id; }
   trace_flow_id_t trace_id() { return trace_id_; }
 
@@ -36,6 +36,13 @@ class RxEngine {
   // * The caller must ensure that |pdu.is_valid() == true|.
   virtual ByteBufferPtr ProcessPdu(PDU pdu) = 0;
 
+  // Returns an SDU that was completed by an earlier call to ProcessPdu() but
+  // not returned by it, or nullptr if there are none. This happens when a PDU
+  // completes more than one SDU, e.g. by filling in a gap before PDUs that
+  // were received out of sequence. Callers should call this until it returns
+  // nullptr after each call to ProcessPdu().
+  virtual ByteBufferPtr PopPendingSdu() { return nullptr; }
+
  private:
   BT_DISALLOW_COPY_AND_ASSIGN_ALLOW_MOVE(RxEngine);
 };
@@ -590,6 +590,13 @@ class FakeController final : public ControllerTestDoubleBase,
   void OnLEConnectionUpdateCommandReceived(
       const pw::bluetooth::emboss::LEConnectionUpdateCommandView& params);
 
+  // Called when a HCI_LE_Set_Data_Length command is received.
+  void OnLESetDataLength(
+      const pw::bluetooth::emboss::LESetDataLengthCommandView& params);
+
+  // Called when a HCI_LE_Set_PHY command is received.
+  void OnLESetPHY(const pw::bluetooth::emboss::LESetPHYCommandView& params);
+
   // Called when a HCI_Disconnect command is received.
   void OnDisconnectCommandReceived(
       const pw::bluetooth::emboss::DisconnectCommandView& params);
@@ -145,6 +145,16 @@ class FakePeer {
     le_features_ = le_features;
   }
 
+  // The maximum LL Data PDU payload size and the PHY most recently requested
+  // for the connection to this peer with the HCI LE Set Data Length and LE Set
+  // PHY commands.
+  uint16_t le_max_tx_octets() const { return le_max_tx_octets_; }
+  void set_le_max_tx_octets(uint16_t max_tx_octets) {
+    le_max_tx_octets_ = max_tx_octets;
+  }
+  hci_spec::LEPHY le_phy() const { return le_phy_; }
+  void set_le_phy(hci_spec::LEPHY phy) { le_phy_ = phy; }
+
   // The response status that will be returned when this device receives a LE
   // Create Connection command.
   pw::bluetooth::emboss::StatusCode connect_response() const {
@@ -241,6 +251,8 @@ class FakePeer {
   bool supports_ll_conn_update_procedure_;
 
   hci_spec::LESupportedFeatures le_features_;
+  uint16_t le_max_tx_octets_ = hci_spec::kLEMaxTxOctetsMin;
+  hci_spec::LEPHY le_phy_ = hci_spec::LEPHY::kLE1M;
 
   bool should_batch_reports_;
   DynamicByteBuffer adv_data_;
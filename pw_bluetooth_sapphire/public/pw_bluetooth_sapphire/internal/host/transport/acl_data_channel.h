@@ -44,6 +44,10 @@ class Transport;
 //
 // This currently only supports the Packet-based Data Flow Control as defined in
 // Core Spec v5.0, Vol 2, Part E, Section 4.1.1.
+//
+// Links that share a controller buffer are scheduled using deficit round-robin
+// weighted by ConnectionInterface::tx_weight(), so that a link carrying bulk
+// data cannot starve latency-sensitive links of buffer credits.
 class AclDataChannel {
  public:
   // This interface will be implemented by l2cap::LogicalLink
@@ -60,6 +64,12 @@ class AclDataChannel {
 
     // Returns true if link has a queued packet
     virtual bool HasAvailablePacket() const = 0;
+
+    // Returns the relative share of controller buffer credits that this link
+    // should get while other links sharing the same buffer also have queued
+    // packets. A link with weight N may send up to N packets per round-robin
+    // turn. Must be at least 1.
+    virtual uint8_t tx_weight() const = 0;
   };
 
   // Registers a connection. Failure to register a connection before sending
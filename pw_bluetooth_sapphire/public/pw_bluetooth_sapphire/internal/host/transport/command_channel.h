@@ -16,13 +16,17 @@
 #include <lib/fit/function.h>
 #include <pw_async/dispatcher.h>
 #include <pw_async/task.h>
+#include <pw_chrono/system_clock.h>
 
+#include <array>
 #include <list>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "pw_bluetooth/controller.h"
 #include "pw_bluetooth_sapphire/internal/host/common/byte_buffer.h"
@@ -106,6 +110,12 @@ class CommandChannel final {
   // order. If strict ordering of commands is required, use
   // SequentialCommandRunner or callbacks for sequencing.
   //
+  // NOTE: Commands that only write controller state (e.g. scan parameters and
+  // scan enable) are coalesced: if such a command is identical to the most
+  // recently queued command that has not been sent yet, it is not sent again.
+  // Instead, |callback| is called with the events for the queued command,
+  // after that command's callback.
+  //
   // See Bluetooth Core Spec v5.0, Volume 2, Part E, Section 4.4 "Command Flow
   // Control" for more information about the HCI command flow control.
   using CommandCallback =
@@ -156,6 +166,41 @@ class CommandChannel final {
   // effect and returns false.
   [[nodiscard]] bool RemoveQueuedCommand(TransactionId id);
 
+  // Histogram of command latencies. Bucket i counts latencies under
+  // kLatencyBucketBounds[i]; the last bucket counts the rest.
+  static constexpr std::array<pw::chrono::SystemClock::duration, 6>
+      kLatencyBucketBounds = {std::chrono::milliseconds(1),
+                              std::chrono::milliseconds(4),
+                              std::chrono::milliseconds(16),
+                              std::chrono::milliseconds(64),
+                              std::chrono::milliseconds(256),
+                              std::chrono::milliseconds(1024)};
+  static constexpr size_t kNumLatencyBuckets = kLatencyBucketBounds.size() + 1;
+  using LatencyHistogram = std::array<size_t, kNumLatencyBuckets>;
+
+  // Statistics about the commands queued with one opcode.
+  struct CommandMetrics {
+    // Number of commands that the controller has responded to.
+    size_t response_count = 0;
+
+    // Number of commands that were coalesced into an identical queued command.
+    size_t coalesced_count = 0;
+
+    // Time from being queued until being sent to the controller.
+    LatencyHistogram queue_latency = {};
+
+    // Time from being sent until the controller responded with an HCI Command
+    // Status or Command Complete event.
+    LatencyHistogram response_latency = {};
+  };
+
+  // Returns the metrics for commands with |opcode|, or nullptr if no such
+  // command has been queued.
+  const CommandMetrics* command_metrics(hci_spec::OpCode opcode) const;
+
+  // The largest number of commands that have waited in the send queue at once.
+  size_t max_send_queue_depth() const { return *max_send_queue_depth_; }
+
   // Used to identify an individual HCI event handler that was registered with
   // this CommandChannel.
   using EventHandlerId = size_t;
@@ -302,6 +347,29 @@ class CommandChannel final {
     // Makes an EventCallback that calls |callback_| correctly.
     EventCallbackVariant MakeCallback();
 
+    // Adds transaction |id|, for an identical command that was coalesced into
+    // this one. |callback| will be called after |callback_| on completion.
+    void AddCoalescedTransaction(TransactionId id,
+                                 CommandCallbackVariant callback);
+
+    // Returns true if |id| is this transaction or was coalesced into it.
+    bool HasTransaction(TransactionId id) const;
+
+    // If other transactions were coalesced into this one, removes transaction
+    // |id| and returns true. If |id| is this transaction, the oldest coalesced
+    // transaction takes its place. Returns false if there are no coalesced
+    // transactions.
+    bool RemoveCoalescedTransaction(TransactionId id);
+
+    // The time at which this transaction was queued and sent, respectively.
+    pw::chrono::SystemClock::time_point queued_time() const {
+      return queued_time_;
+    }
+    pw::chrono::SystemClock::time_point sent_time() const { return sent_time_; }
+    void set_sent_time(pw::chrono::SystemClock::time_point time) {
+      sent_time_ = time;
+    }
+
     hci_spec::EventCode complete_event_code() const {
       return complete_event_code_;
     }
@@ -329,6 +397,13 @@ class CommandChannel final {
     CommandCallbackVariant callback_;
     bt::SmartTask timeout_task_;
 
+    // Transactions for identical commands that were coalesced into this one,
+    // oldest first.
+    std::vector<std::pair<TransactionId, CommandCallbackVariant>> coalesced_;
+
+    pw::chrono::SystemClock::time_point queued_time_;
+    pw::chrono::SystemClock::time_point sent_time_;
+
     // If non-zero, the id of the handler registered for this transaction.
     // Always zero if this transaction is synchronous.
     EventHandlerId handler_id_;
@@ -390,6 +465,44 @@ class CommandChannel final {
   // Removes internal event handler structures for |id|.
   void RemoveEventHandlerInternal(EventHandlerId id);
 
+  // If |command_packet| can be coalesced into the last queued command, adds
+  // transaction |id| to it and returns true.
+  bool MaybeCoalesceCommand(
+      TransactionId id,
+      const CommandPacketVariant& command_packet,
+      CommandCallbackVariant& callback,
+      hci_spec::EventCode complete_event_code,
+      const std::unordered_set<hci_spec::OpCode>& exclusions);
+
+  // Per-opcode CommandMetrics and their inspect properties.
+  struct LatencyHistogramInspect {
+    inspect::Node node;
+    std::array<inspect::UintProperty, kNumLatencyBuckets> buckets;
+  };
+  struct OpcodeMetrics {
+    CommandMetrics metrics;
+    inspect::Node node;
+    inspect::UintProperty response_count;
+    inspect::UintProperty coalesced_count;
+    LatencyHistogramInspect queue_latency;
+    LatencyHistogramInspect response_latency;
+  };
+
+  // Returns the metrics for |opcode|, creating them if needed.
+  OpcodeMetrics& GetOpcodeMetrics(hci_spec::OpCode opcode);
+
+  // Creates the inspect node for |metrics| under |command_metrics_node_|.
+  void AttachOpcodeMetricsInspect(hci_spec::OpCode opcode,
+                                  OpcodeMetrics& metrics);
+
+  // Adds |latency| to |histogram| and updates its inspect properties.
+  static void RecordLatency(pw::chrono::SystemClock::duration latency,
+                            LatencyHistogram& histogram,
+                            LatencyHistogramInspect& histogram_inspect);
+
+  // Updates the send queue depth metrics.
+  void UpdateSendQueueDepth();
+
   // Sends any queued commands that can be processed unambiguously and complete.
   void TrySendQueuedCommands();
 
@@ -472,8 +585,15 @@ class CommandChannel final {
   std::unordered_multimap<hci_spec::EventCode, EventHandlerId>
       vendor_subevent_code_handlers_;
 
+  // The number of commands in |send_queue_| and the largest it has been.
+  UintInspectable<size_t> send_queue_depth_;
+  UintInspectable<size_t> max_send_queue_depth_;
+
+  std::unordered_map<hci_spec::OpCode, OpcodeMetrics> command_metrics_;
+
   // Command channel inspect node.
   inspect::Node command_channel_node_;
+  inspect::Node command_metrics_node_;
 
   pw::async::Dispatcher& dispatcher_;
 
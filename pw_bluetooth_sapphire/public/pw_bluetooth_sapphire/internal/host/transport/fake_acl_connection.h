@@ -42,6 +42,8 @@ class FakeAclConnection : public AclDataChannel::ConnectionInterface {
     return queued_packets_;
   }
 
+  void set_tx_weight(uint8_t weight) { tx_weight_ = weight; }
+
   WeakPtr<ConnectionInterface> GetWeakPtr() {
     return weak_interface_.GetWeakPtr();
   }
@@ -62,10 +64,13 @@ class FakeAclConnection : public AclDataChannel::ConnectionInterface {
 
   bool HasAvailablePacket() const override { return !queued_packets_.empty(); }
 
+  uint8_t tx_weight() const override { return tx_weight_; }
+
  private:
   hci_spec::ConnectionHandle handle_;
   bt::LinkType type_;
   AclDataChannel* data_channel_;
+  uint8_t tx_weight_ = 1;
   std::queue<ACLDataPacketPtr> queued_packets_;
   WeakSelf<ConnectionInterface> weak_interface_;
 };
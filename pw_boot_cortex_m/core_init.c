@@ -52,11 +52,12 @@
 //     3.7. pw_boot_PostMain()
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
-#include <string.h>
 
 #include "pw_boot/boot.h"
 #include "pw_boot_cortex_m/boot.h"
+#include "pw_boot_cortex_m/internal/memory_init.h"
 #include "pw_preprocessor/arch.h"
 #include "pw_preprocessor/compiler.h"
 
@@ -86,16 +87,22 @@ void __libc_init_array(void);
 // completes. The context before this function violates the C spec
 // (Section 6.7.8, paragraph 10 for example, which requires uninitialized static
 // values to be zero-initialized).
+//
+// The sections are initialized with LDM/STM bursts rather than the C library's
+// memcpy() and memset(), which are often byte loops on embedded toolchains.
+// Variables tagged PW_BOOT_LAZY_ZERO_INIT are not zeroed here; see
+// pw_boot_cortex_m/deferred_init.h.
 void StaticMemoryInit(void) {
   // Static-init RAM (load static values into ram, .data section init).
-  memcpy(&_pw_static_init_ram_start,
-         &_pw_static_init_flash_start,
-         &_pw_static_init_ram_end - &_pw_static_init_ram_start);
+  _pw_boot_CopyMemory(
+      &_pw_static_init_ram_start,
+      &_pw_static_init_flash_start,
+      (size_t)(&_pw_static_init_ram_end - &_pw_static_init_ram_start));
 
   // Zero-init RAM (.bss section init).
-  memset(&_pw_zero_init_ram_start,
-         0,
-         &_pw_zero_init_ram_end - &_pw_zero_init_ram_start);
+  _pw_boot_ZeroMemory(
+      &_pw_zero_init_ram_start,
+      (size_t)(&_pw_zero_init_ram_end - &_pw_zero_init_ram_start));
 }
 
 // WARNING: This code is run immediately upon boot, and performs initialization
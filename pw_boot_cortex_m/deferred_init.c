@@ -0,0 +1,38 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_boot_cortex_m/deferred_init.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pw_boot_cortex_m/internal/memory_init.h"
+
+// Extern symbols provided by linker script.
+extern uint8_t _pw_lazy_zero_init_ram_start;
+extern uint8_t _pw_lazy_zero_init_ram_end;
+extern void (*const _pw_boot_deferred_init_array_start[])(void);
+extern void (*const _pw_boot_deferred_init_array_end[])(void);
+
+void pw_boot_RunDeferredInit(void) {
+  _pw_boot_ZeroMemory(
+      &_pw_lazy_zero_init_ram_start,
+      (size_t)(&_pw_lazy_zero_init_ram_end - &_pw_lazy_zero_init_ram_start));
+
+  for (void (*const* init)(void) = _pw_boot_deferred_init_array_start;
+       init < _pw_boot_deferred_init_array_end;
+       ++init) {
+    (*init)();
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+// Opt-in deferral of initialization that is not needed on the boot critical
+// path. pw_boot_Entry() zeroes .bss and runs static constructors before main();
+// with large RAM images, this can noticeably delay boot. Variables and
+// initializers tagged with the macros below are instead handled when the
+// application calls pw_boot_RunDeferredInit(), e.g. from a low-priority thread
+// once the time-critical parts of the system are running.
+//
+// Using these requires the pw_boot_cortex_m:deferred_init target and a linker
+// script that provides the symbols described in the module documentation, as
+// basic_cortex_m.ld does.
+
+#include "pw_preprocessor/compiler.h"
+#include "pw_preprocessor/util.h"
+
+// Places a zero-initialized variable in a region that pw_boot_RunDeferredInit()
+// zeroes, rather than pw_boot_Entry(). The variable must not have an
+// initializer or a constructor, since it is zeroed after static constructors
+// run. Its contents are undefined until pw_boot_RunDeferredInit() returns.
+//
+// Linker scripts without a lazy zero init region place these variables in .bss,
+// so they are zeroed at boot as usual.
+//
+//   PW_BOOT_LAZY_ZERO_INIT static uint8_t log_buffer[32768];
+//
+#define PW_BOOT_LAZY_ZERO_INIT \
+  PW_PLACE_IN_SECTION(".bss.pw_boot_lazy_zero_init")
+
+// Registers a `void function(void)` to be run by pw_boot_RunDeferredInit(),
+// after lazily zeroed variables have been zeroed. Functions run in link order.
+// May be used at most once per function name in a translation unit.
+//
+//   static void InitLogBuffer(void) { ... }
+//   PW_BOOT_DEFERRED_INIT(InitLogBuffer);
+//
+#define PW_BOOT_DEFERRED_INIT(function)                       \
+  static void (*const _pw_boot_deferred_init_##function)(void) \
+      PW_KEEP_IN_SECTION(".pw_boot_deferred_init_array") = function
+
+PW_EXTERN_C_START
+
+// Zeroes the variables tagged with PW_BOOT_LAZY_ZERO_INIT, then runs the
+// functions registered with PW_BOOT_DEFERRED_INIT. Must be called exactly once,
+// after main() starts. Nothing that relies on deferred initialization may run
+// until this returns.
+void pw_boot_RunDeferredInit(void);
+
+PW_EXTERN_C_END
@@ -0,0 +1,89 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+// Memory initialization routines shared by core_init.c and deferred_init.c.
+// These run before static memory is initialized, so they must not use any
+// static variables or call into the C library.
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Copies size_bytes from src to dest. Both must be word-aligned, which the
+// linker script guarantees for the sections initialized at boot. Whole 16-byte
+// blocks are copied with LDM/STM bursts, then any remaining words and bytes.
+static inline void _pw_boot_CopyMemory(uint8_t* dest,
+                                       const uint8_t* src,
+                                       size_t size_bytes) {
+  size_t blocks = size_bytes / 16u;
+  if (blocks != 0u) {
+    asm volatile(
+        "1:                                 \n"
+        "  ldmia %[src]!, {r3, r4, r5, r6}  \n"
+        "  stmia %[dest]!, {r3, r4, r5, r6} \n"
+        "  subs %[blocks], %[blocks], #1    \n"
+        "  bne 1b                           \n"
+        // clang-format off
+        : /*output=*/ [dest] "+l"(dest), [src] "+l"(src), [blocks] "+l"(blocks)
+        : /*input=*/
+        : /*clobbers=*/ "r3", "r4", "r5", "r6", "cc", "memory"
+        // clang-format on
+    );
+  }
+
+  uint32_t* dest_word = (uint32_t*)dest;
+  const uint32_t* src_word = (const uint32_t*)src;
+  for (size_t i = 0; i < (size_bytes % 16u) / 4u; ++i) {
+    *dest_word++ = *src_word++;
+  }
+
+  dest = (uint8_t*)dest_word;
+  src = (const uint8_t*)src_word;
+  for (size_t i = 0; i < size_bytes % 4u; ++i) {
+    *dest++ = *src++;
+  }
+}
+
+// Zeroes size_bytes at dest, which must be word-aligned. Whole 16-byte blocks
+// are zeroed with STM bursts, then any remaining words and bytes.
+static inline void _pw_boot_ZeroMemory(uint8_t* dest, size_t size_bytes) {
+  size_t blocks = size_bytes / 16u;
+  if (blocks != 0u) {
+    asm volatile(
+        "  movs r3, #0                      \n"
+        "  movs r4, #0                      \n"
+        "  movs r5, #0                      \n"
+        "  movs r6, #0                      \n"
+        "1:                                 \n"
+        "  stmia %[dest]!, {r3, r4, r5, r6} \n"
+        "  subs %[blocks], %[blocks], #1    \n"
+        "  bne 1b                           \n"
+        // clang-format off
+        : /*output=*/ [dest] "+l"(dest), [blocks] "+l"(blocks)
+        : /*input=*/
+        : /*clobbers=*/ "r3", "r4", "r5", "r6", "cc", "memory"
+        // clang-format on
+    );
+  }
+
+  uint32_t* dest_word = (uint32_t*)dest;
+  for (size_t i = 0; i < (size_bytes % 16u) / 4u; ++i) {
+    *dest_word++ = 0u;
+  }
+
+  dest = (uint8_t*)dest_word;
+  for (size_t i = 0; i < size_bytes % 4u; ++i) {
+    *dest++ = 0u;
+  }
+}
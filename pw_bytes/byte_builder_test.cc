@@ -16,6 +16,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstring>
 
 #include "pw_unit_test/framework.h"
 
@@ -414,6 +415,89 @@ TEST(ByteBuffer, Putting16ByteInts_Exhausted_kBigEndian) {
   EXPECT_EQ(Status::ResourceExhausted(), bb.status());
 }
 
+TEST(ByteBuffer, PuttingIntArrays_kLittleEndian) {
+  ByteBuffer<14> bb;
+  constexpr uint16_t kUint16s[] = {0x0102, 0x0304};
+  constexpr int16_t kInt16s[] = {-2};
+  constexpr uint32_t kUint32s[] = {0x05060708, 0x090A0B0C};
+  bb.PutUint16(kUint16s).PutInt16(kInt16s).PutUint32(kUint32s);
+
+  EXPECT_EQ(OkStatus(), bb.status());
+  ASSERT_EQ(14u, bb.size());
+  constexpr auto kExpected = bytes::Array<0x02,
+                                          0x01,
+                                          0x04,
+                                          0x03,
+                                          0xFE,
+                                          0xFF,
+                                          0x08,
+                                          0x07,
+                                          0x06,
+                                          0x05,
+                                          0x0C,
+                                          0x0B,
+                                          0x0A,
+                                          0x09>();
+  EXPECT_EQ(0, std::memcmp(bb.data(), kExpected.data(), kExpected.size()));
+}
+
+TEST(ByteBuffer, PuttingIntArrays_kBigEndian) {
+  ByteBuffer<24> bb;
+  constexpr int32_t kInt32s[] = {-1, 0x01020304};
+  constexpr uint64_t kUint64s[] = {0x1112131415161718};
+  constexpr int64_t kInt64s[] = {0};
+  bb.PutInt32(kInt32s, endian::big)
+      .PutUint64(kUint64s, endian::big)
+      .PutInt64(kInt64s, endian::big);
+
+  EXPECT_EQ(OkStatus(), bb.status());
+  ASSERT_EQ(24u, bb.size());
+  constexpr auto kExpected = bytes::Array<0xFF,
+                                          0xFF,
+                                          0xFF,
+                                          0xFF,
+                                          0x01,
+                                          0x02,
+                                          0x03,
+                                          0x04,
+                                          0x11,
+                                          0x12,
+                                          0x13,
+                                          0x14,
+                                          0x15,
+                                          0x16,
+                                          0x17,
+                                          0x18,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0>();
+  EXPECT_EQ(0, std::memcmp(bb.data(), kExpected.data(), kExpected.size()));
+}
+
+TEST(ByteBuffer, PuttingIntArrays_Exhausted) {
+  ByteBuffer<7> bb;
+  constexpr uint16_t kValues[] = {1, 2, 3, 4};
+  bb.PutUint16(span(kValues).first(2));
+  EXPECT_EQ(OkStatus(), bb.status());
+
+  // None of the values are appended if they do not all fit.
+  bb.PutUint16(span(kValues).last(2));
+  EXPECT_EQ(4u, bb.size());
+  EXPECT_EQ(Status::ResourceExhausted(), bb.status());
+}
+
+TEST(ByteBuffer, PuttingIntArrays_Empty) {
+  ByteBuffer<2> bb;
+  bb.PutUint32(span<const uint32_t>());
+  EXPECT_EQ(0u, bb.size());
+  EXPECT_EQ(OkStatus(), bb.status());
+}
+
 TEST(ByteBuffer, Putting32ByteInts_Full_kLittleEndian) {
   ByteBuffer<8> bb;
   bb.PutInt32(0xFFFFFFF1);
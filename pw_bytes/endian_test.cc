@@ -16,6 +16,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstring>
 
 #include "pw_unit_test/framework.h"
 
@@ -296,5 +297,72 @@ TEST(ReadInOrder, PartialBigEndian) {
   EXPECT_EQ(0x01020304, ReadInOrder<int32_t>(endian::big, buffer.data(), 100));
 }
 
+TEST(ConvertOrder, Span_SameOrderCopies) {
+  constexpr std::array<uint16_t, 3> kInput = {0x0102, 0x0304, 0x0506};
+  std::array<uint16_t, 3> output = {};
+  ConvertOrder<uint16_t>(endian::big, endian::big, kInput, output);
+  EXPECT_EQ(output, kInput);
+}
+
+TEST(ConvertOrder, Span_DifferentOrderSwaps) {
+  constexpr std::array<uint32_t, 3> kInput = {
+      0x01020304, 0x05060708, 0xA0B0C0D0};
+  std::array<uint32_t, 3> output = {};
+  ConvertOrder<uint32_t>(endian::little, endian::big, kInput, output);
+  constexpr std::array<uint32_t, 3> kExpected = {
+      0x04030201, 0x08070605, 0xD0C0B0A0};
+  EXPECT_EQ(output, kExpected);
+}
+
+TEST(ConvertOrder, Span_InPlace) {
+  std::array<int64_t, 2> values = {0x0102030405060708, -2};
+  ConvertOrder<int64_t>(endian::native, kNonNative, values, values);
+  EXPECT_EQ(values[0], 0x0807060504030201);
+  EXPECT_EQ(values[1], static_cast<int64_t>(0xFEFFFFFFFFFFFFFF));
+}
+
+TEST(CopyInOrder, Span_LittleEndian) {
+  constexpr std::array<uint16_t, 2> kValues = {0x0102, 0x0304};
+  std::array<std::byte, 4> buffer = {};
+  CopyInOrder<uint16_t>(endian::little, kValues, buffer.data());
+  EXPECT_EQ(buffer, (Array<0x02, 0x01, 0x04, 0x03>()));
+}
+
+TEST(CopyInOrder, Span_BigEndian) {
+  constexpr std::array<int32_t, 2> kValues = {0x01020304, -1};
+  std::array<std::byte, 8> buffer = {};
+  CopyInOrder<int32_t>(endian::big, kValues, buffer.data());
+  EXPECT_EQ(buffer,
+            (Array<0x01, 0x02, 0x03, 0x04, 0xFF, 0xFF, 0xFF, 0xFF>()));
+}
+
+TEST(CopyInOrder, Span_MatchesSingleValues) {
+  constexpr std::array<uint64_t, 2> kValues = {0x0102030405060708,
+                                               0x1112131415161718};
+  for (endian order : {endian::little, endian::big}) {
+    std::array<std::byte, 16> buffer = {};
+    CopyInOrder<uint64_t>(order, kValues, buffer.data());
+    const auto first = CopyInOrder(order, kValues[0]);
+    const auto second = CopyInOrder(order, kValues[1]);
+    EXPECT_EQ(0, std::memcmp(&buffer[0], first.data(), first.size()));
+    EXPECT_EQ(0, std::memcmp(&buffer[8], second.data(), second.size()));
+  }
+}
+
+TEST(ReadInOrder, Span) {
+  constexpr auto kBuffer = Array<1, 2, 3, 4, 5, 6>();
+  std::array<uint16_t, 3> values = {};
+
+  ReadInOrder<uint16_t>(endian::little, kBuffer.data(), values);
+  EXPECT_EQ(values, (std::array<uint16_t, 3>{0x0201, 0x0403, 0x0605}));
+
+  ReadInOrder<uint16_t>(endian::big, kBuffer.data(), values);
+  EXPECT_EQ(values, (std::array<uint16_t, 3>{0x0102, 0x0304, 0x0506}));
+}
+
+TEST(ReadInOrder, Span_Empty) {
+  ReadInOrder<uint32_t>(endian::big, nullptr, span<uint32_t>());
+}
+
 }  // namespace
 }  // namespace pw::bytes
@@ -324,6 +324,39 @@ class ByteBuilder {
     return PutUint64(static_cast<uint64_t>(value), order);
   }
 
+  /// Put methods for inserting arrays of 16-, 32-, and 64-bit ints. Space for
+  /// all of the values is checked once. If they do not all fit, none are
+  /// appended and the status is set to RESOURCE_EXHAUSTED.
+  ByteBuilder& PutUint16(span<const uint16_t> values,
+                         endian order = endian::little) {
+    return WriteInOrder(values, order);
+  }
+
+  ByteBuilder& PutInt16(span<const int16_t> values,
+                        endian order = endian::little) {
+    return WriteInOrder(values, order);
+  }
+
+  ByteBuilder& PutUint32(span<const uint32_t> values,
+                         endian order = endian::little) {
+    return WriteInOrder(values, order);
+  }
+
+  ByteBuilder& PutInt32(span<const int32_t> values,
+                        endian order = endian::little) {
+    return WriteInOrder(values, order);
+  }
+
+  ByteBuilder& PutUint64(span<const uint64_t> values,
+                         endian order = endian::little) {
+    return WriteInOrder(values, order);
+  }
+
+  ByteBuilder& PutInt64(span<const int64_t> values,
+                        endian order = endian::little) {
+    return WriteInOrder(values, order);
+  }
+
  protected:
   /// Functions to support ByteBuffer copies.
   constexpr ByteBuilder(const ByteSpan& buffer, const ByteBuilder& other)
@@ -339,6 +372,16 @@ class ByteBuilder {
   ByteBuilder& WriteInOrder(T value) {
     return append(&value, sizeof(value));
   }
+
+  template <typename T>
+  ByteBuilder& WriteInOrder(span<const T> values, endian order) {
+    std::byte* const append_destination = buffer_.data() + size_;
+    if (ResizeForAppend(values.size_bytes()) != 0u) {
+      bytes::CopyInOrder(order, values, append_destination);
+    }
+    return *this;
+  }
+
   size_t ResizeForAppend(size_t bytes_to_append);
 
   const ByteSpan buffer_;
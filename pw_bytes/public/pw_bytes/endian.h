@@ -202,4 +202,61 @@ template <typename T>
   return true;
 }
 
+// Bulk conversions for arrays of values. These are written as simple loops over
+// the values so that the compiler can vectorize the byte swaps on platforms
+// that support it.
+
+// Converts each value in input from one byte order to the other and stores it
+// at the same index in output. input and output may be the same span, but must
+// not otherwise overlap.
+//
+// The output span **MUST** be at least as large as the input span!
+template <typename T>
+void ConvertOrder(endian from, endian to, span<const T> input, span<T> output) {
+  static_assert(std::is_integral_v<T>);
+  if (from == to) {
+    if (input.data() != output.data()) {
+      std::copy(input.begin(), input.end(), output.begin());
+    }
+    return;
+  }
+  for (size_t i = 0; i < input.size(); ++i) {
+    output[i] = internal::ReverseBytes(input[i]);
+  }
+}
+
+// Copies values to a buffer with the specified endianness. This is equivalent
+// to copying each element of CopyInOrder to the buffer in turn.
+//
+// The buffer **MUST** be at least values.size_bytes() bytes large!
+template <typename T>
+void CopyInOrder(endian order, span<const T> values, void* buffer) {
+  static_assert(std::is_integral_v<T>);
+  if (order == endian::native) {
+    if (!values.empty()) {
+      std::memcpy(buffer, values.data(), values.size_bytes());
+    }
+    return;
+  }
+  std::byte* const output = static_cast<std::byte*>(buffer);
+  for (size_t i = 0; i < values.size(); ++i) {
+    const T value = internal::ReverseBytes(values[i]);
+    std::memcpy(&output[i * sizeof(T)], &value, sizeof(value));
+  }
+}
+
+// Reads values.size() values with the specified endianness from a buffer.
+//
+// The buffer **MUST** be at least values.size_bytes() bytes large!
+template <typename T>
+void ReadInOrder(endian order, const void* buffer, span<T> values) {
+  static_assert(std::is_integral_v<T>);
+  if (!values.empty()) {
+    std::memcpy(values.data(), buffer, values.size_bytes());
+  }
+  if (order != endian::native) {
+    ConvertOrder<T>(order, endian::native, values, values);
+  }
+}
+
 }  // namespace pw::bytes
@@ -13,6 +13,7 @@
 // the License.
 #include "pw_channel/channel.h"
 
+#include <array>
 #include <optional>
 
 #include "gtest/gtest.h"
@@ -454,6 +455,140 @@ TEST(Channel, Conversions) {
 #endif  // PW_NC_TEST
 }
 
+class ReservingStub : public Stub {
+ public:
+  ReservingStub(pw::multibuf::Reservation reservation, const Stub* lower)
+      : reservation_(reservation), lower_(lower) {}
+
+ private:
+  pw::multibuf::Reservation DoGetWriteReservation() const override {
+    if (lower_ == nullptr) {
+      return reservation_;
+    }
+    return reservation_ + lower_->write_reservation();
+  }
+
+  pw::multibuf::Reservation reservation_;
+  const Stub* lower_;
+};
+
+TEST(Channel, WriteReservationDefaultsToEmpty) {
+  const Stub channel;
+  EXPECT_EQ(channel.write_reservation().headroom, 0u);
+  EXPECT_EQ(channel.write_reservation().tailroom, 0u);
+}
+
+TEST(Channel, WriteReservationAccumulatesAcrossLayers) {
+  const ReservingStub lower({4, 2}, nullptr);
+  const ReservingStub upper({8, 0}, &lower);
+  EXPECT_EQ(upper.write_reservation().headroom, 12u);
+  EXPECT_EQ(upper.write_reservation().tailroom, 2u);
+  EXPECT_EQ(upper.write_reservation().size(), 14u);
+}
+
+class CountingWriter : public pw::channel::DatagramWriter {
+ public:
+  int writes = 0;
+  int fail_after = -1;
+
+ private:
+  pw::async2::Poll<> DoPollReadyToWrite(pw::async2::Context&) override {
+    return pw::async2::Ready();
+  }
+
+  pw::Result<pw::channel::WriteToken> DoWrite(
+      pw::multibuf::MultiBuf&&) override {
+    if (writes == fail_after) {
+      return pw::Status::Unavailable();
+    }
+    writes += 1;
+    return CreateWriteToken(static_cast<uint32_t>(writes));
+  }
+
+  pw::async2::Poll<pw::Result<pw::channel::WriteToken>> DoPollFlush(
+      pw::async2::Context&) override {
+    return pw::async2::Ready(pw::Result<pw::channel::WriteToken>(
+        CreateWriteToken(static_cast<uint32_t>(writes))));
+  }
+
+  pw::async2::Poll<pw::Status> DoPollClose(pw::async2::Context&) override {
+    return pw::async2::Ready(pw::OkStatus());
+  }
+};
+
+class BatchingWriter : public CountingWriter {
+ public:
+  int batches = 0;
+  size_t last_batch_size = 0;
+
+ private:
+  pw::Result<pw::channel::WriteToken> DoWriteBatch(
+      pw::span<pw::multibuf::MultiBuf> batch) override {
+    batches += 1;
+    last_batch_size = batch.size();
+    return CreateWriteToken(static_cast<uint32_t>(batches));
+  }
+};
+
+TEST(Channel, WriteBatchDefaultsToWritingEachBuffer) {
+  CountingWriter channel;
+  std::array<pw::multibuf::MultiBuf, 3> batch;
+
+  pw::Result<pw::channel::WriteToken> first = channel.Write({});
+  pw::Result<pw::channel::WriteToken> token = channel.WriteBatch(batch);
+  ASSERT_TRUE(first.ok());
+  ASSERT_TRUE(token.ok());
+  EXPECT_EQ(channel.writes, 4);
+  EXPECT_GT(*token, *first);
+}
+
+TEST(Channel, WriteBatchStopsAtFirstFailure) {
+  CountingWriter channel;
+  channel.fail_after = 2;
+  std::array<pw::multibuf::MultiBuf, 4> batch;
+
+  EXPECT_EQ(channel.WriteBatch(batch).status(), pw::Status::Unavailable());
+  EXPECT_EQ(channel.writes, 2);
+}
+
+TEST(Channel, WriteBatchRejectsEmptyBatch) {
+  CountingWriter channel;
+  EXPECT_EQ(channel.WriteBatch({}).status(), pw::Status::InvalidArgument());
+  EXPECT_EQ(channel.writes, 0);
+}
+
+TEST(Channel, WriteBatchOverrideReceivesWholeBatch) {
+  BatchingWriter channel;
+  std::array<pw::multibuf::MultiBuf, 5> batch;
+
+  EXPECT_TRUE(channel.WriteBatch(batch).ok());
+  EXPECT_EQ(channel.batches, 1);
+  EXPECT_EQ(channel.last_batch_size, 5u);
+  EXPECT_EQ(channel.writes, 0);
+}
+
+TEST(Channel, WriteBatchFailsAfterClose) {
+  pw::async2::Dispatcher dispatcher;
+
+  class : public pw::async2::Task {
+   public:
+    CountingWriter channel;
+
+   private:
+    pw::async2::Poll<> DoPend(pw::async2::Context& cx) override {
+      EXPECT_EQ(pw::async2::Ready(pw::OkStatus()), channel.PollClose(cx));
+      std::array<pw::multibuf::MultiBuf, 2> batch;
+      EXPECT_EQ(pw::Status::FailedPrecondition(),
+                channel.WriteBatch(batch).status());
+      EXPECT_EQ(channel.writes, 0);
+      return pw::async2::Ready();
+    }
+  } test_task;
+  dispatcher.Post(test_task);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+}
+
 #if PW_NC_TEST(CannotUseByteChannelAsDatagramChannel)
 PW_NC_EXPECT("Cannot use a byte channel as a datagram channel");
 void ByteChannelNcTest(pw::channel::ByteChannel<kReliable, kReadable>& bytes) {
@@ -0,0 +1,441 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/epoll_channel.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "pw_log/log.h"
+#include "pw_status/try.h"
+
+namespace pw::channel {
+namespace {
+
+using async2::FileDescriptorType;
+
+// Makes ``fd`` non-blocking and registers it with ``dispatcher``.
+Status RegisterFileDescriptor(int fd, async2::Dispatcher& dispatcher) {
+  int flags = fcntl(fd, F_GETFL);
+  if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+    PW_LOG_ERROR("Failed to make fd %d non-blocking: %s",
+                 fd,
+                 std::strerror(errno));
+    return Status::Internal();
+  }
+  return dispatcher.NativeRegisterFileDescriptor(
+      fd, FileDescriptorType::kReadWrite);
+}
+
+bool IsSocket(int fd) {
+  int type;
+  socklen_t length = sizeof(type);
+  return getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &length) == 0;
+}
+
+bool WouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+
+// Allocates a contiguous buffer into ``buffer``, waiting for memory to become
+// available if necessary.
+async2::Poll<Status> PendReadBuffer(
+    async2::Context& cx,
+    multibuf::MultiBufAllocator& allocator,
+    size_t min_size,
+    size_t desired_size,
+    std::optional<multibuf::MultiBufAllocationFuture>& allocation,
+    std::optional<multibuf::MultiBuf>& buffer) {
+  if (buffer.has_value()) {
+    return async2::Ready(OkStatus());
+  }
+  if (!allocation.has_value()) {
+    allocation.emplace(
+        allocator, min_size, desired_size, /*needs_contiguous=*/true);
+  }
+  async2::Poll<std::optional<multibuf::MultiBuf>> result =
+      allocation->Pend(cx);
+  if (result.IsPending()) {
+    return async2::Pending();
+  }
+  allocation.reset();
+  if (!result->has_value()) {
+    return async2::Ready(Status::ResourceExhausted());
+  }
+  buffer = std::move(**result);
+  return async2::Ready(OkStatus());
+}
+
+}  // namespace
+
+EpollChannel::EpollChannel(int channel_fd,
+                           async2::Dispatcher& dispatcher,
+                           multibuf::MultiBufAllocator& allocator)
+    : channel_fd_(channel_fd),
+      is_socket_(IsSocket(channel_fd)),
+      dispatcher_(dispatcher),
+      allocator_(allocator) {
+  if (!RegisterFileDescriptor(channel_fd_, dispatcher_).ok()) {
+    close(channel_fd_);
+    channel_fd_ = -1;
+    set_closed();
+  }
+}
+
+async2::Poll<Result<multibuf::MultiBuf>> EpollChannel::DoPollRead(
+    async2::Context& cx, size_t max_bytes) {
+  if (max_bytes == 0) {
+    return multibuf::MultiBuf();
+  }
+  async2::Poll<Status> allocated = PendReadBuffer(cx,
+                                                  allocator_,
+                                                  kMinimumReadSize,
+                                                  kDesiredReadSize,
+                                                  read_allocation_,
+                                                  read_buffer_);
+  if (allocated.IsPending()) {
+    return async2::Pending();
+  }
+  if (!allocated->ok()) {
+    return *allocated;
+  }
+
+  // The waker must be registered before reading so that data which arrives
+  // after a failed read is not missed.
+  PW_TRY(dispatcher_.NativeAddReadWakerForFileDescriptor(channel_fd_, cx));
+  multibuf::Chunk& chunk = *read_buffer_->ChunkBegin();
+  ssize_t bytes_read;
+  do {
+    bytes_read =
+        read(channel_fd_, chunk.data(), std::min(chunk.size(), max_bytes));
+  } while (bytes_read < 0 && errno == EINTR);
+
+  if (bytes_read > 0) {
+    multibuf::MultiBuf data = std::move(*read_buffer_);
+    read_buffer_.reset();
+    data.Truncate(static_cast<size_t>(bytes_read));
+    return data;
+  }
+  if (bytes_read == 0) {
+    return Status::OutOfRange();
+  }
+  if (WouldBlock()) {
+    return async2::Pending();
+  }
+  return Fail("read");
+}
+
+async2::Poll<> EpollChannel::DoPollReadyToWrite(async2::Context& cx) {
+  if (!pending_write_.has_value()) {
+    return async2::Ready();
+  }
+  if (!dispatcher_.NativeAddWriteWakerForFileDescriptor(channel_fd_, cx)
+           .ok()) {
+    return async2::Ready();
+  }
+  if (WritePending().IsUnavailable()) {
+    return async2::Pending();
+  }
+  // Either the queue was drained or the channel was closed due to an error,
+  // in which case the next write reports that the channel is closed.
+  return async2::Ready();
+}
+
+Result<WriteToken> EpollChannel::DoWrite(multibuf::MultiBuf&& data) {
+  if (pending_write_.has_value()) {
+    pending_write_->PushSuffix(std::move(data));
+  } else {
+    pending_write_ = std::move(data);
+  }
+  ++write_token_;
+  Status status = WritePending();
+  if (!status.ok() && !status.IsUnavailable()) {
+    return status;
+  }
+  return CreateWriteToken(write_token_);
+}
+
+Result<WriteToken> EpollChannel::DoWriteBatch(span<multibuf::MultiBuf> batch) {
+  // Combine the batch so that it is submitted with a single vectored write.
+  for (multibuf::MultiBuf& data : batch) {
+    if (pending_write_.has_value()) {
+      pending_write_->PushSuffix(std::move(data));
+    } else {
+      pending_write_ = std::move(data);
+    }
+    ++write_token_;
+  }
+  Status status = WritePending();
+  if (!status.ok() && !status.IsUnavailable()) {
+    return status;
+  }
+  return CreateWriteToken(write_token_);
+}
+
+async2::Poll<Result<WriteToken>> EpollChannel::DoPollFlush(
+    async2::Context& cx) {
+  if (pending_write_.has_value()) {
+    PW_TRY(dispatcher_.NativeAddWriteWakerForFileDescriptor(channel_fd_, cx));
+    Status status = WritePending();
+    if (status.IsUnavailable()) {
+      return async2::Pending();
+    }
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return CreateWriteToken(write_token_);
+}
+
+async2::Poll<Status> EpollChannel::DoPollClose(async2::Context&) {
+  Status status = OkStatus();
+  if (pending_write_.has_value() && !WritePending().ok()) {
+    status = Status::DataLoss();
+  }
+  Cleanup();
+  return status;
+}
+
+Status EpollChannel::WritePending() {
+  while (pending_write_.has_value()) {
+    std::array<ConstByteSpan, kMaxChunksPerWrite> spans;
+    size_t num_spans = pending_write_->GetChunkSpans(spans);
+    if (num_spans == 0) {
+      pending_write_.reset();
+      break;
+    }
+    std::array<iovec, kMaxChunksPerWrite> iov;
+    for (size_t i = 0; i < num_spans; ++i) {
+      iov[i].iov_base = const_cast<std::byte*>(spans[i].data());
+      iov[i].iov_len = spans[i].size();
+    }
+
+    ssize_t written;
+    if (is_socket_) {
+      msghdr message{};
+      message.msg_iov = iov.data();
+      message.msg_iovlen = num_spans;
+      written = sendmsg(channel_fd_, &message, MSG_NOSIGNAL);
+    } else {
+      written = writev(channel_fd_, iov.data(), static_cast<int>(num_spans));
+    }
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (WouldBlock()) {
+        return Status::Unavailable();
+      }
+      return Fail("write");
+    }
+    pending_write_->DiscardPrefix(static_cast<size_t>(written));
+  }
+  return OkStatus();
+}
+
+Status EpollChannel::Fail(const char* operation) {
+  PW_LOG_ERROR("EpollChannel %s on fd %d failed: %s",
+               operation,
+               channel_fd_,
+               std::strerror(errno));
+  Cleanup();
+  return Status::Internal();
+}
+
+void EpollChannel::Cleanup() {
+  if (channel_fd_ < 0) {
+    return;
+  }
+  dispatcher_.NativeUnregisterFileDescriptor(channel_fd_).IgnoreError();
+  close(channel_fd_);
+  channel_fd_ = -1;
+  set_closed();
+}
+
+EpollDatagramChannel::EpollDatagramChannel(
+    int socket_fd,
+    async2::Dispatcher& dispatcher,
+    multibuf::MultiBufAllocator& allocator,
+    size_t max_datagram_size)
+    : socket_fd_(socket_fd),
+      dispatcher_(dispatcher),
+      allocator_(allocator),
+      max_datagram_size_(max_datagram_size) {
+  if (!RegisterFileDescriptor(socket_fd_, dispatcher_).ok()) {
+    close(socket_fd_);
+    socket_fd_ = -1;
+    set_closed();
+  }
+}
+
+async2::Poll<Result<multibuf::MultiBuf>> EpollDatagramChannel::DoPollRead(
+    async2::Context& cx, size_t) {
+  async2::Poll<Status> allocated = PendReadBuffer(cx,
+                                                  allocator_,
+                                                  max_datagram_size_,
+                                                  max_datagram_size_,
+                                                  read_allocation_,
+                                                  read_buffer_);
+  if (allocated.IsPending()) {
+    return async2::Pending();
+  }
+  if (!allocated->ok()) {
+    return *allocated;
+  }
+
+  // The waker must be registered before receiving so that datagrams which
+  // arrive after a failed receive are not missed.
+  PW_TRY(dispatcher_.NativeAddReadWakerForFileDescriptor(socket_fd_, cx));
+  multibuf::Chunk& chunk = *read_buffer_->ChunkBegin();
+  ssize_t received;
+  do {
+    received = recv(socket_fd_, chunk.data(), chunk.size(), MSG_TRUNC);
+  } while (received < 0 && errno == EINTR);
+
+  if (received >= 0) {
+    if (static_cast<size_t>(received) > chunk.size()) {
+      // The datagram did not fit and has been truncated. The buffer is kept
+      // for the next read.
+      return Status::DataLoss();
+    }
+    multibuf::MultiBuf datagram = std::move(*read_buffer_);
+    read_buffer_.reset();
+    datagram.Truncate(static_cast<size_t>(received));
+    return datagram;
+  }
+  if (WouldBlock()) {
+    return async2::Pending();
+  }
+  if (errno == ECONNREFUSED) {
+    // A previous datagram was rejected by the peer.
+    return Status::Unavailable();
+  }
+  return Fail("recv");
+}
+
+async2::Poll<> EpollDatagramChannel::DoPollReadyToWrite(async2::Context& cx) {
+  if (writable_) {
+    return async2::Ready();
+  }
+  if (!dispatcher_.NativeAddWriteWakerForFileDescriptor(socket_fd_, cx).ok()) {
+    return async2::Ready();
+  }
+  // Check for space after registering the waker so that space freed in the
+  // meantime is not missed.
+  pollfd poll_fd{};
+  poll_fd.fd = socket_fd_;
+  poll_fd.events = POLLOUT;
+  if (poll(&poll_fd, 1, 0) == 0) {
+    return async2::Pending();
+  }
+  writable_ = true;
+  return async2::Ready();
+}
+
+Result<WriteToken> EpollDatagramChannel::DoWrite(multibuf::MultiBuf&& data) {
+  return DoWriteBatch(span(&data, 1));
+}
+
+Result<WriteToken> EpollDatagramChannel::DoWriteBatch(
+    span<multibuf::MultiBuf> batch) {
+  while (!batch.empty()) {
+    PW_TRY_ASSIGN(
+        size_t sent,
+        Send(batch.first(std::min(batch.size(), kMaxDatagramsPerSend))));
+    batch = batch.subspan(sent);
+  }
+  return CreateWriteToken(write_token_);
+}
+
+async2::Poll<Result<WriteToken>> EpollDatagramChannel::DoPollFlush(
+    async2::Context&) {
+  // Datagrams are handed to the kernel as soon as they are written.
+  return CreateWriteToken(write_token_);
+}
+
+async2::Poll<Status> EpollDatagramChannel::DoPollClose(async2::Context&) {
+  Cleanup();
+  return OkStatus();
+}
+
+Result<size_t> EpollDatagramChannel::Send(span<multibuf::MultiBuf> datagrams) {
+  std::array<mmsghdr, kMaxDatagramsPerSend> messages{};
+  std::array<std::array<iovec, kMaxChunksPerDatagram>, kMaxDatagramsPerSend>
+      iovs;
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    if (datagrams[i].Chunks().size() > kMaxChunksPerDatagram) {
+      return Status::InvalidArgument();
+    }
+    std::array<ConstByteSpan, kMaxChunksPerDatagram> spans;
+    size_t num_spans = datagrams[i].GetChunkSpans(spans);
+    for (size_t j = 0; j < num_spans; ++j) {
+      iovs[i][j].iov_base = const_cast<std::byte*>(spans[j].data());
+      iovs[i][j].iov_len = spans[j].size();
+    }
+    messages[i].msg_hdr.msg_iov = iovs[i].data();
+    messages[i].msg_hdr.msg_iovlen = num_spans;
+  }
+
+  int sent;
+  do {
+    sent = sendmmsg(socket_fd_,
+                    messages.data(),
+                    static_cast<unsigned int>(datagrams.size()),
+                    MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+
+  if (sent < 0) {
+    if (WouldBlock()) {
+      writable_ = false;
+      return Status::Unavailable();
+    }
+    if (errno == ECONNREFUSED) {
+      return Status::Unavailable();
+    }
+    return Fail("sendmmsg");
+  }
+  for (multibuf::MultiBuf& datagram :
+       datagrams.first(static_cast<size_t>(sent))) {
+    datagram.Release();
+  }
+  write_token_ += static_cast<uint32_t>(sent);
+  return static_cast<size_t>(sent);
+}
+
+Status EpollDatagramChannel::Fail(const char* operation) {
+  PW_LOG_ERROR("EpollDatagramChannel %s on fd %d failed: %s",
+               operation,
+               socket_fd_,
+               std::strerror(errno));
+  Cleanup();
+  return Status::Internal();
+}
+
+void EpollDatagramChannel::Cleanup() {
+  if (socket_fd_ < 0) {
+    return;
+  }
+  dispatcher_.NativeUnregisterFileDescriptor(socket_fd_).IgnoreError();
+  close(socket_fd_);
+  socket_fd_ = -1;
+  set_closed();
+}
+
+}  // namespace pw::channel
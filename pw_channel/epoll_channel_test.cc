@@ -0,0 +1,259 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/epoll_channel.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+
+#include "pw_allocator/testing.h"
+#include "pw_assert/check.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_bytes/array.h"
+#include "pw_multibuf/simple_allocator.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using ::pw::allocator::test::AllocatorForTest;
+using ::pw::async2::Context;
+using ::pw::async2::Dispatcher;
+using ::pw::async2::Pending;
+using ::pw::async2::Poll;
+using ::pw::async2::Ready;
+using ::pw::async2::Task;
+using ::pw::channel::EpollChannel;
+using ::pw::channel::EpollDatagramChannel;
+using ::pw::multibuf::MultiBuf;
+
+constexpr auto kData = pw::bytes::Array<1, 2, 3, 4, 5, 6, 7, 8>();
+
+class EpollChannelTest : public ::testing::Test {
+ protected:
+  EpollChannelTest() : allocator_(data_area_, meta_alloc_) {}
+
+  // Creates a connected pair of sockets of the given type. The first is
+  // passed to the channel under test and the second is used by the test.
+  void CreateSocketPair(int type) {
+    std::array<int, 2> fds;
+    PW_CHECK_INT_EQ(socketpair(AF_UNIX, type, 0, fds.data()), 0);
+    channel_fd_ = fds[0];
+    peer_fd_ = fds[1];
+  }
+
+  ~EpollChannelTest() override {
+    if (peer_fd_ >= 0) {
+      close(peer_fd_);
+    }
+  }
+
+  MultiBuf MakeMultiBuf(pw::ConstByteSpan contents) {
+    std::optional<MultiBuf> buffer = allocator_.Allocate(contents.size());
+    PW_CHECK(buffer.has_value());
+    std::copy(contents.begin(), contents.end(), buffer->begin());
+    return std::move(*buffer);
+  }
+
+  Dispatcher dispatcher_;
+  std::array<std::byte, 2048> data_area_;
+  AllocatorForTest<2048> meta_alloc_;
+  pw::multibuf::SimpleAllocator allocator_;
+  int channel_fd_ = -1;
+  int peer_fd_ = -1;
+};
+
+/// Task which reads once from a channel.
+template <typename Channel>
+class ReadTask : public Task {
+ public:
+  explicit ReadTask(Channel* channel) : channel_(*channel) {}
+
+  int polled = 0;
+  std::optional<pw::Result<MultiBuf>> result;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    ++polled;
+    Poll<pw::Result<MultiBuf>> poll = channel_.PollRead(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = std::move(*poll);
+    return Ready();
+  }
+
+  Channel& channel_;
+};
+
+/// Task which flushes a channel.
+template <typename Channel>
+class FlushTask : public Task {
+ public:
+  explicit FlushTask(Channel* channel) : channel_(*channel) {}
+
+  std::optional<pw::Result<pw::channel::WriteToken>> result;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    auto poll = channel_.PollFlush(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  }
+
+  Channel& channel_;
+};
+
+TEST_F(EpollChannelTest, ReadWakesTaskWhenDataArrives) {
+  CreateSocketPair(SOCK_STREAM);
+  EpollChannel channel(channel_fd_, dispatcher_, allocator_);
+  ASSERT_TRUE(channel.is_open());
+
+  ReadTask<EpollChannel> task(&channel);
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsPending());
+
+  ASSERT_EQ(write(peer_fd_, kData.data(), kData.size()),
+            static_cast<ssize_t>(kData.size()));
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsReady());
+  EXPECT_EQ(task.polled, 2);
+  ASSERT_TRUE(task.result.has_value());
+  ASSERT_EQ(task.result->status(), pw::OkStatus());
+  ASSERT_EQ((*task.result)->size(), kData.size());
+  EXPECT_TRUE(std::equal(kData.begin(), kData.end(), (*task.result)->begin()));
+}
+
+TEST_F(EpollChannelTest, ReadReportsEndOfStream) {
+  CreateSocketPair(SOCK_STREAM);
+  EpollChannel channel(channel_fd_, dispatcher_, allocator_);
+  close(peer_fd_);
+  peer_fd_ = -1;
+
+  ReadTask<EpollChannel> task(&channel);
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsReady());
+  ASSERT_TRUE(task.result.has_value());
+  EXPECT_EQ(task.result->status(), pw::Status::OutOfRange());
+}
+
+TEST_F(EpollChannelTest, WriteBatchIsSentInOrder) {
+  CreateSocketPair(SOCK_STREAM);
+  EpollChannel channel(channel_fd_, dispatcher_, allocator_);
+
+  std::array<MultiBuf, 2> batch = {
+      MakeMultiBuf(pw::span(kData).first(3)),
+      MakeMultiBuf(pw::span(kData).subspan(3)),
+  };
+  pw::Result<pw::channel::WriteToken> token = channel.WriteBatch(batch);
+  ASSERT_EQ(token.status(), pw::OkStatus());
+
+  FlushTask<EpollChannel> flush(&channel);
+  dispatcher_.Post(flush);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(flush).IsReady());
+  ASSERT_TRUE(flush.result.has_value());
+  ASSERT_EQ(flush.result->status(), pw::OkStatus());
+  EXPECT_GE(**flush.result, *token);
+
+  std::array<std::byte, kData.size()> received;
+  ASSERT_EQ(read(peer_fd_, received.data(), received.size()),
+            static_cast<ssize_t>(kData.size()));
+  EXPECT_EQ(received, kData);
+}
+
+TEST_F(EpollChannelTest, CloseClosesFileDescriptor) {
+  CreateSocketPair(SOCK_STREAM);
+  EpollChannel channel(channel_fd_, dispatcher_, allocator_);
+
+  class : public Task {
+   public:
+    EpollChannel* channel;
+
+   private:
+    Poll<> DoPend(Context& cx) override {
+      EXPECT_EQ(channel->PollClose(cx), Ready(pw::OkStatus()));
+      return Ready();
+    }
+  } close_task;
+  close_task.channel = &channel;
+  dispatcher_.Post(close_task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+  EXPECT_FALSE(channel.is_open());
+
+  // The peer observes the end of the stream.
+  std::byte byte;
+  EXPECT_EQ(read(peer_fd_, &byte, 1), 0);
+}
+
+TEST_F(EpollChannelTest, DatagramsArePreserved) {
+  CreateSocketPair(SOCK_DGRAM);
+  EpollDatagramChannel channel(channel_fd_, dispatcher_, allocator_, 64);
+
+  ASSERT_EQ(send(peer_fd_, kData.data(), 3, 0), 3);
+  ASSERT_EQ(send(peer_fd_, kData.data(), 0, 0), 0);
+
+  ReadTask<EpollDatagramChannel> first(&channel);
+  dispatcher_.Post(first);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(first).IsReady());
+  ASSERT_TRUE(first.result.has_value());
+  ASSERT_EQ(first.result->status(), pw::OkStatus());
+  EXPECT_EQ((*first.result)->size(), 3u);
+
+  // Zero-length datagrams are delivered as empty reads.
+  ReadTask<EpollDatagramChannel> second(&channel);
+  dispatcher_.Post(second);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(second).IsReady());
+  ASSERT_TRUE(second.result.has_value());
+  ASSERT_EQ(second.result->status(), pw::OkStatus());
+  EXPECT_EQ((*second.result)->size(), 0u);
+}
+
+TEST_F(EpollChannelTest, OversizedDatagramIsDataLoss) {
+  CreateSocketPair(SOCK_DGRAM);
+  EpollDatagramChannel channel(channel_fd_, dispatcher_, allocator_, 4);
+
+  ASSERT_EQ(send(peer_fd_, kData.data(), kData.size(), 0),
+            static_cast<ssize_t>(kData.size()));
+
+  ReadTask<EpollDatagramChannel> task(&channel);
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsReady());
+  ASSERT_TRUE(task.result.has_value());
+  EXPECT_EQ(task.result->status(), pw::Status::DataLoss());
+}
+
+TEST_F(EpollChannelTest, DatagramWriteBatchSendsEachDatagram) {
+  CreateSocketPair(SOCK_DGRAM);
+  EpollDatagramChannel channel(channel_fd_, dispatcher_, allocator_, 64);
+
+  std::array<MultiBuf, 3> batch = {
+      MakeMultiBuf(pw::span(kData).first(1)),
+      MakeMultiBuf(pw::span(kData).first(2)),
+      MakeMultiBuf(pw::span(kData).first(3)),
+  };
+  pw::Result<pw::channel::WriteToken> token = channel.WriteBatch(batch);
+  ASSERT_EQ(token.status(), pw::OkStatus());
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    std::array<std::byte, 16> received;
+    EXPECT_EQ(recv(peer_fd_, received.data(), received.size(), 0),
+              static_cast<ssize_t>(i + 1));
+  }
+}
+
+}  // namespace
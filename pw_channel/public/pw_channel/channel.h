@@ -36,6 +36,7 @@
 #include "pw_multibuf/allocator.h"
 #include "pw_multibuf/multibuf.h"
 #include "pw_result/result.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
 
 namespace pw::channel {
@@ -233,6 +234,19 @@ class AnyChannel {
   /// channels that do not support writing.
   multibuf::MultiBufAllocator& GetWriteAllocator();
 
+  /// Returns the headroom and tailroom that writers should reserve when
+  /// allocating buffers to pass to ``Write``.
+  ///
+  /// Channels that wrap the data they write in a header or trailer before
+  /// forwarding it to another channel should return their own sizes added to
+  /// the lower channel's ``write_reservation()``. Writers can then allocate
+  /// once for the whole stack, and each layer can claim its header or trailer
+  /// in place with ``MultiBuf::ClaimPrefix`` or ``MultiBuf::ClaimSuffix``
+  /// instead of copying the payload.
+  multibuf::Reservation write_reservation() const {
+    return DoGetWriteReservation();
+  }
+
   /// Writes using a previously allocated MultiBuf. Returns a token that
   /// refers to this write. These tokens are monotonically increasing, and
   /// FlushPoll() returns the value of the latest token it has flushed.
@@ -263,6 +277,37 @@ class AnyChannel {
     return DoWrite(std::move(data));
   }
 
+  /// Writes a batch of previously allocated ``MultiBuf`` s, in order. Each
+  /// ``MultiBuf`` is subject to the same requirements as in ``Write``, and
+  /// each is moved from once it is accepted.
+  ///
+  /// Returns a single token covering the whole batch: once ``PollFlush``
+  /// returns a token greater than or equal to it, every ``MultiBuf`` in the
+  /// batch has been flushed.
+  ///
+  /// By default, this calls ``Write`` for each ``MultiBuf``. Implementations
+  /// may override this to submit the batch at once, for example with a single
+  /// ``writev`` or ``sendmmsg`` call.
+  ///
+  /// May fail with the following error codes:
+  ///
+  /// * OK - All data was accepted by the channel.
+  /// * INVALID_ARGUMENT - The batch is empty.
+  /// * UNIMPLEMENTED - The channel does not support writing.
+  /// * UNAVAILABLE - A write failed due to a transient error (only applies
+  ///   to unreliable channels). ``MultiBuf`` s preceding the failed one may
+  ///   have been accepted.
+  /// * FAILED_PRECONDITION - The channel is closed.
+  Result<WriteToken> WriteBatch(span<multibuf::MultiBuf> batch) {
+    if (!is_open()) {
+      return Status::FailedPrecondition();
+    }
+    if (batch.empty()) {
+      return Status::InvalidArgument();
+    }
+    return DoWriteBatch(batch);
+  }
+
   /// Flushes pending writes.
   ///
   /// Returns a ``async2::Poll`` indicating whether or not flushing has
@@ -389,8 +434,23 @@ class AnyChannel {
 
   virtual async2::Poll<> DoPollReadyToWrite(async2::Context& cx) = 0;
 
+  virtual multibuf::Reservation DoGetWriteReservation() const { return {}; }
+
   virtual Result<WriteToken> DoWrite(multibuf::MultiBuf&& buffer) = 0;
 
+  // Called with a non-empty batch. Tokens increase monotonically, so the token
+  // of the final write covers the whole batch.
+  virtual Result<WriteToken> DoWriteBatch(span<multibuf::MultiBuf> batch) {
+    Result<WriteToken> token;
+    for (multibuf::MultiBuf& buffer : batch) {
+      token = DoWrite(std::move(buffer));
+      if (!token.ok()) {
+        break;
+      }
+    }
+    return token;
+  }
+
   virtual async2::Poll<Result<WriteToken>> DoPollFlush(async2::Context& cx) = 0;
 
   // Seek functions
@@ -0,0 +1,178 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/poll.h"
+#include "pw_channel/channel.h"
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::channel {
+
+/// @defgroup pw_channel_epoll
+/// @{
+
+/// A reliable byte channel over a file descriptor, such as a TCP or Unix
+/// stream socket or a serial port, that is driven by the epoll ``Dispatcher``
+/// backend (``pw_async2_epoll``).
+///
+/// The channel takes ownership of the file descriptor, makes it non-blocking,
+/// and registers it with the ``Dispatcher``. The file descriptor is closed when
+/// the channel is closed or destroyed. Serial ports must already be configured
+/// (e.g. with ``termios``) as desired.
+///
+/// Data that the file descriptor does not accept immediately is queued, and
+/// ``PollReadyToWrite`` returns ``Pending`` until the queue has been handed to
+/// the kernel. ``WriteBatch`` queues the whole batch and submits it with a
+/// single vectored write.
+class EpollChannel : public ByteReaderWriter {
+ public:
+  /// Creates a channel for ``channel_fd``.
+  ///
+  /// Read buffers are allocated from ``allocator``. If the file descriptor
+  /// cannot be registered with ``dispatcher``, the channel starts closed.
+  EpollChannel(int channel_fd,
+               async2::Dispatcher& dispatcher,
+               multibuf::MultiBufAllocator& allocator);
+
+  EpollChannel(const EpollChannel&) = delete;
+  EpollChannel& operator=(const EpollChannel&) = delete;
+
+  ~EpollChannel() override { Cleanup(); }
+
+ private:
+  static constexpr size_t kMinimumReadSize = 64;
+  static constexpr size_t kDesiredReadSize = 1024;
+  // The maximum number of chunks passed to each vectored write.
+  static constexpr size_t kMaxChunksPerWrite = 16;
+
+  async2::Poll<Result<multibuf::MultiBuf>> DoPollRead(
+      async2::Context& cx, size_t max_bytes) override;
+
+  async2::Poll<> DoPollReadyToWrite(async2::Context& cx) override;
+
+  Result<WriteToken> DoWrite(multibuf::MultiBuf&& data) override;
+
+  Result<WriteToken> DoWriteBatch(span<multibuf::MultiBuf> batch) override;
+
+  async2::Poll<Result<WriteToken>> DoPollFlush(async2::Context& cx) override;
+
+  async2::Poll<Status> DoPollClose(async2::Context& cx) override;
+
+  // Writes as much of ``pending_write_`` as the file descriptor accepts.
+  // Returns OK once it has all been written, UNAVAILABLE if the write would
+  // block, or another error if the write failed and the channel was closed.
+  Status WritePending();
+
+  // Logs the error from a failed I/O operation and closes the channel.
+  Status Fail(const char* operation);
+
+  void Cleanup();
+
+  int channel_fd_;
+  // Sockets are written with ``sendmsg`` so that writes to a disconnected
+  // peer fail with ``EPIPE`` rather than raising ``SIGPIPE``.
+  bool is_socket_;
+  async2::Dispatcher& dispatcher_;
+  multibuf::MultiBufAllocator& allocator_;
+
+  std::optional<multibuf::MultiBufAllocationFuture> read_allocation_;
+  std::optional<multibuf::MultiBuf> read_buffer_;
+  std::optional<multibuf::MultiBuf> pending_write_;
+  uint32_t write_token_ = 0;
+};
+
+/// A datagram channel over a connected datagram socket, such as a UDP or Unix
+/// datagram socket, that is driven by the epoll ``Dispatcher`` backend
+/// (``pw_async2_epoll``).
+///
+/// The channel takes ownership of the socket, makes it non-blocking, and
+/// registers it with the ``Dispatcher``. The socket is closed when the channel
+/// is closed or destroyed.
+///
+/// Each ``Write`` sends one datagram immediately, so ``PollFlush`` is always
+/// ready. ``WriteBatch`` sends the whole batch with as few ``sendmmsg`` calls
+/// as possible. Since the channel is unreliable, writes fail with
+/// ``UNAVAILABLE`` if the socket's send buffer is full; use
+/// ``PollReadyToWrite`` to wait for space. Each datagram written may consist
+/// of at most 8 chunks.
+class EpollDatagramChannel : public DatagramReaderWriter {
+ public:
+  /// Creates a channel for ``socket_fd``.
+  ///
+  /// Each read allocates a contiguous buffer of ``max_datagram_size`` bytes
+  /// from ``allocator``. Datagrams larger than this are discarded and reported
+  /// as ``DATA_LOSS``. If the socket cannot be registered with
+  /// ``dispatcher``, the channel starts closed.
+  EpollDatagramChannel(int socket_fd,
+                       async2::Dispatcher& dispatcher,
+                       multibuf::MultiBufAllocator& allocator,
+                       size_t max_datagram_size);
+
+  EpollDatagramChannel(const EpollDatagramChannel&) = delete;
+  EpollDatagramChannel& operator=(const EpollDatagramChannel&) = delete;
+
+  ~EpollDatagramChannel() override { Cleanup(); }
+
+ private:
+  // The maximum number of datagrams passed to each ``sendmmsg`` call.
+  static constexpr size_t kMaxDatagramsPerSend = 16;
+  // The maximum number of chunks in each datagram written.
+  static constexpr size_t kMaxChunksPerDatagram = 8;
+
+  async2::Poll<Result<multibuf::MultiBuf>> DoPollRead(
+      async2::Context& cx, size_t max_bytes) override;
+
+  async2::Poll<> DoPollReadyToWrite(async2::Context& cx) override;
+
+  Result<WriteToken> DoWrite(multibuf::MultiBuf&& data) override;
+
+  Result<WriteToken> DoWriteBatch(span<multibuf::MultiBuf> batch) override;
+
+  async2::Poll<Result<WriteToken>> DoPollFlush(async2::Context& cx) override;
+
+  async2::Poll<Status> DoPollClose(async2::Context& cx) override;
+
+  // Sends up to ``kMaxDatagramsPerSend`` datagrams in a single call, returning
+  // the number sent.
+  Result<size_t> Send(span<multibuf::MultiBuf> datagrams);
+
+  // Logs the error from a failed I/O operation and closes the channel.
+  Status Fail(const char* operation);
+
+  void Cleanup();
+
+  int socket_fd_;
+  async2::Dispatcher& dispatcher_;
+  multibuf::MultiBufAllocator& allocator_;
+  size_t max_datagram_size_;
+
+  std::optional<multibuf::MultiBufAllocationFuture> read_allocation_;
+  std::optional<multibuf::MultiBuf> read_buffer_;
+  // Cleared when a send would block, and set once the socket is writable.
+  bool writable_ = true;
+  uint32_t write_token_ = 0;
+};
+
+/// @}
+
+}  // namespace pw::channel
@@ -14,6 +14,8 @@
 
 #include "pw_checksum/crc16_ccitt.h"
 
+#include <array>
+
 namespace pw::checksum {
 namespace {
 
@@ -52,11 +54,55 @@ constexpr uint16_t kCrc16CcittTable[256]{
     0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0,  // 256
 };
 
+// Generates the lookup tables for a slicing-by-8 CRC-16-CCITT. Table k holds
+// the CRC of each byte value followed by k zero bytes, so 8 bytes can be
+// processed with one independent lookup per byte.
+constexpr std::array<std::array<uint16_t, 256>, 8>
+GenerateSlicingCrc16CcittTables() {
+  std::array<std::array<uint16_t, 256>, 8> tables{};
+  for (size_t i = 0; i < 256; ++i) {
+    tables[0][i] = kCrc16CcittTable[i];
+  }
+  for (size_t k = 1; k < tables.size(); ++k) {
+    for (size_t i = 0; i < 256; ++i) {
+      const uint16_t previous = tables[k - 1][i];
+      tables[k][i] = static_cast<uint16_t>(
+          kCrc16CcittTable[previous >> 8u] ^
+          static_cast<uint16_t>(previous << 8u));
+    }
+  }
+  return tables;
+}
+
 }  // namespace
 
-extern "C" uint16_t pw_checksum_Crc16Ccitt(const void* data,
-                                           size_t size_bytes,
-                                           uint16_t value) {
+extern "C" uint16_t _pw_checksum_InternalCrc16CcittSliceBy8(const void* data,
+                                                            size_t size_bytes,
+                                                            uint16_t value) {
+  static constexpr std::array<std::array<uint16_t, 256>, 8> kTables =
+      GenerateSlicingCrc16CcittTables();
+  const uint8_t* array = static_cast<const uint8_t*>(data);
+
+  for (; size_bytes >= 8; size_bytes -= 8, array += 8) {
+    // The CRC so far only affects the first two bytes of each chunk.
+    value = static_cast<uint16_t>(
+        kTables[7][(value >> 8u) ^ array[0]] ^
+        kTables[6][(value & 0xffu) ^ array[1]] ^ kTables[5][array[2]] ^
+        kTables[4][array[3]] ^ kTables[3][array[4]] ^ kTables[2][array[5]] ^
+        kTables[1][array[6]] ^ kTables[0][array[7]]);
+  }
+
+  for (size_t i = 0; i < size_bytes; ++i) {
+    value = kTables[0][((value >> 8u) ^ array[i]) & 0xffu] ^
+            static_cast<uint16_t>(value << 8u);
+  }
+
+  return value;
+}
+
+extern "C" uint16_t _pw_checksum_InternalCrc16CcittEightBit(const void* data,
+                                                            size_t size_bytes,
+                                                            uint16_t value) {
   const uint8_t* const array = static_cast<const uint8_t*>(data);
 
   for (size_t i = 0; i < size_bytes; ++i) {
@@ -67,4 +113,18 @@ extern "C" uint16_t pw_checksum_Crc16Ccitt(const void* data,
   return value;
 }
 
+#if PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL != PW_CHECKSUM_CRC16_CCITT_EXTERNAL
+
+extern "C" uint16_t pw_checksum_Crc16Ccitt(const void* data,
+                                           size_t size_bytes,
+                                           uint16_t value) {
+#if PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL == PW_CHECKSUM_CRC16_CCITT_SLICE_BY_8
+  return _pw_checksum_InternalCrc16CcittSliceBy8(data, size_bytes, value);
+#else
+  return _pw_checksum_InternalCrc16CcittEightBit(data, size_bytes, value);
+#endif  // PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL
+}
+
+#endif  // PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL != EXTERNAL
+
 }  // namespace pw::checksum
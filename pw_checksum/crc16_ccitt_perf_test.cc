@@ -33,5 +33,13 @@ PW_PERF_TEST_SIMPLE(CcittCalculationString,
                     Crc16Ccitt::Calculate,
                     as_bytes(span(kString)));
 
+PW_PERF_TEST_SIMPLE(CcittSliceBy8CalculationBytes,
+                    Crc16CcittSliceBy8::Calculate,
+                    kBytes);
+
+PW_PERF_TEST_SIMPLE(CcittSliceBy8CalculationString,
+                    Crc16CcittSliceBy8::Calculate,
+                    as_bytes(span(kString)));
+
 }  // namespace
 }  // namespace pw::checksum
@@ -16,6 +16,7 @@
 
 #include <string_view>
 
+#include "pw_bytes/span.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::checksum {
@@ -67,6 +68,30 @@ TEST(Crc16Class, String) {
   EXPECT_EQ(crc16.value(), kStringCrc);
 }
 
+TEST(Crc16, Implementations) {
+  EXPECT_EQ(Crc16CcittSliceBy8::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc16CcittEightBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc16CcittSliceBy8::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc16CcittEightBit::Calculate(as_bytes(span(kString))), kStringCrc);
+}
+
+// Checks every length and alignment of a slice of kString, to cover both the
+// multi-byte and the single byte loops, and a CRC carried between calls.
+TEST(Crc16, ImplementationsMatchForAllLengthsAndAlignments) {
+  const ConstByteSpan string = as_bytes(span(kString));
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t size = 0; size <= string.size() - offset; ++size) {
+      const ConstByteSpan data = string.subspan(offset, size);
+      const uint16_t expected = Crc16CcittEightBit::Calculate(data);
+      EXPECT_EQ(Crc16CcittSliceBy8::Calculate(data), expected);
+      EXPECT_EQ(Crc16CcittSliceBy8::Calculate(
+                    data.subspan(size / 2),
+                    Crc16CcittSliceBy8::Calculate(data.first(size / 2))),
+                expected);
+    }
+  }
+}
+
 extern "C" uint16_t CallChecksumCrc16Ccitt(const void* data, size_t size_bytes);
 
 TEST(Crc16FromC, Buffer) {
@@ -14,6 +14,13 @@
 
 #include "pw_checksum/crc32.h"
 
+#include <array>
+#include <cstring>
+
+#ifdef __ARM_FEATURE_CRC32
+#include <arm_acle.h>
+#endif  // __ARM_FEATURE_CRC32
+
 namespace pw::checksum {
 namespace {
 
@@ -47,12 +54,62 @@ constexpr std::array<uint32_t, (1 << kBits)> GenerateCrc32Table() {
   return table;
 }
 
+// Generates the lookup tables for a slicing-by-N CRC32 implementation. Table k
+// holds the CRC of each byte value followed by k zero bytes, so N bytes can be
+// processed with one lookup per byte and no dependency between the lookups.
+template <std::size_t kSlices, uint32_t kPolynomial>
+constexpr std::array<std::array<uint32_t, 256>, kSlices>
+GenerateSlicingCrc32Tables() {
+  std::array<std::array<uint32_t, 256>, kSlices> tables{};
+  tables[0] = GenerateCrc32Table<8, kPolynomial>();
+  for (std::size_t k = 1; k < kSlices; ++k) {
+    for (uint32_t i = 0; i < 256; ++i) {
+      const uint32_t previous = tables[k - 1][i];
+      tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+    }
+  }
+  return tables;
+}
+
+// Reads 4 bytes as a little-endian value, regardless of the host's byte order.
+constexpr uint32_t ReadLittleEndian32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) |
+         (static_cast<uint32_t>(bytes[1]) << 8) |
+         (static_cast<uint32_t>(bytes[2]) << 16) |
+         (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
 // Reversed polynomial for the commonly used CRC32 variant. See:
 // https://en.wikipedia.org/wiki/Cyclic_redundancy_check#Polynomial_representations_of_cyclic_redundancy_checks
 constexpr uint32_t kCrc32Polynomial = 0xEDB88320;
 
 }  // namespace
 
+extern "C" uint32_t _pw_checksum_InternalCrc32SliceBy8(const void* data,
+                                                       size_t size_bytes,
+                                                       uint32_t state) {
+  static constexpr std::array<std::array<uint32_t, 256>, 8> kCrc32Tables =
+      GenerateSlicingCrc32Tables<8, kCrc32Polynomial>();
+  const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
+
+  for (; size_bytes >= 8; size_bytes -= 8, data_bytes += 8) {
+    const uint32_t low = state ^ ReadLittleEndian32(data_bytes);
+    const uint32_t high = ReadLittleEndian32(data_bytes + 4);
+    state = kCrc32Tables[7][low & 0xFFu] ^
+            kCrc32Tables[6][(low >> 8) & 0xFFu] ^
+            kCrc32Tables[5][(low >> 16) & 0xFFu] ^
+            kCrc32Tables[4][low >> 24] ^ kCrc32Tables[3][high & 0xFFu] ^
+            kCrc32Tables[2][(high >> 8) & 0xFFu] ^
+            kCrc32Tables[1][(high >> 16) & 0xFFu] ^ kCrc32Tables[0][high >> 24];
+  }
+
+  for (size_t i = 0; i < size_bytes; ++i) {
+    state = kCrc32Tables[0][(state ^ data_bytes[i]) & 0xFFu] ^ (state >> 8);
+  }
+
+  return state;
+}
+
 extern "C" uint32_t _pw_checksum_InternalCrc32EightBit(const void* data,
                                                        size_t size_bytes,
                                                        uint32_t state) {
@@ -95,4 +152,38 @@ extern "C" uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
   return state;
 }
 
+#ifdef __ARM_FEATURE_CRC32
+
+// The ARMv8 CRC32 instructions use the same polynomial and bit order as the
+// software implementations, so they operate directly on the CRC32 state.
+extern "C" uint32_t _pw_checksum_InternalCrc32Armv8(const void* data,
+                                                    size_t size_bytes,
+                                                    uint32_t state) {
+  const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
+
+#if defined(__aarch64__)
+  for (; size_bytes >= sizeof(uint64_t); size_bytes -= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data_bytes, sizeof(word));
+    state = __crc32d(state, word);
+    data_bytes += sizeof(word);
+  }
+#endif  // defined(__aarch64__)
+
+  for (; size_bytes >= sizeof(uint32_t); size_bytes -= sizeof(uint32_t)) {
+    uint32_t word;
+    std::memcpy(&word, data_bytes, sizeof(word));
+    state = __crc32w(state, word);
+    data_bytes += sizeof(word);
+  }
+
+  for (size_t i = 0; i < size_bytes; ++i) {
+    state = __crc32b(state, data_bytes[i]);
+  }
+
+  return state;
+}
+
+#endif  // __ARM_FEATURE_CRC32
+
 }  // namespace pw::checksum
@@ -28,6 +28,20 @@ constexpr std::string_view kString =
     "people very angry and been widely regarded as a bad move.";
 constexpr auto kBytes = bytes::Array<1, 2, 3, 4, 5, 6, 7, 8, 9>();
 
+void Crc32SliceBy8Test(perf_test::State& state, span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32SliceBy8::Calculate(data);
+  }
+}
+
+#ifdef __ARM_FEATURE_CRC32
+void Crc32Armv8Test(perf_test::State& state, span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32Armv8::Calculate(data);
+  }
+}
+#endif  // __ARM_FEATURE_CRC32
+
 void Crc32OneBitTest(perf_test::State& state, span<const std::byte> data) {
   while (state.KeepRunning()) {
     Crc32OneBit::Calculate(data);
@@ -49,10 +63,17 @@ void Crc32EightBitTest(perf_test::State& state, span<const std::byte> data) {
 PW_PERF_TEST(CrcOneBitStringTest, Crc32OneBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcFourBitStringTest, Crc32FourBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcEightBitStringTest, Crc32EightBitTest, as_bytes(span(kString)));
+PW_PERF_TEST(CrcSliceBy8StringTest, Crc32SliceBy8Test, as_bytes(span(kString)));
 
 PW_PERF_TEST(CrcOneBitBytesTest, Crc32OneBitTest, kBytes);
 PW_PERF_TEST(CrcFourBitBytesTest, Crc32FourBitTest, kBytes);
 PW_PERF_TEST(CrcEightBitBytesTest, Crc32EightBitTest, kBytes);
+PW_PERF_TEST(CrcSliceBy8BytesTest, Crc32SliceBy8Test, kBytes);
+
+#ifdef __ARM_FEATURE_CRC32
+PW_PERF_TEST(CrcArmv8StringTest, Crc32Armv8Test, as_bytes(span(kString)));
+PW_PERF_TEST(CrcArmv8BytesTest, Crc32Armv8Test, kBytes);
+#endif  // __ARM_FEATURE_CRC32
 
 }  // namespace
 }  // namespace pw::checksum
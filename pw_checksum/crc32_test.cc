@@ -17,6 +17,7 @@
 
 #include "public/pw_checksum/crc32.h"
 #include "pw_bytes/array.h"
+#include "pw_bytes/span.h"
 #include "pw_span/span.h"
 #include "pw_unit_test/framework.h"
 
@@ -41,6 +42,8 @@ constexpr uint32_t kStringCrc = 0x9EC87F88;
 
 TEST(Crc32, Empty) {
   EXPECT_EQ(Crc32::Calculate(span<std::byte>()), PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32SliceBy8::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
   EXPECT_EQ(Crc32EightBit::Calculate(span<std::byte>()),
             PW_CHECKSUM_EMPTY_CRC32);
   EXPECT_EQ(Crc32FourBit::Calculate(span<std::byte>()),
@@ -50,6 +53,7 @@ TEST(Crc32, Empty) {
 
 TEST(Crc32, Buffer) {
   EXPECT_EQ(Crc32::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32SliceBy8::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
@@ -57,6 +61,7 @@ TEST(Crc32, Buffer) {
 
 TEST(Crc32, String) {
   EXPECT_EQ(Crc32::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32SliceBy8::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kString))), kStringCrc);
@@ -73,6 +78,7 @@ void TestByByte() {
 
 TEST(Crc32Class, ByteByByte) {
   TestByByte<Crc32>();
+  TestByByte<Crc32SliceBy8>();
   TestByByte<Crc32EightBit>();
   TestByByte<Crc32FourBit>();
   TestByByte<Crc32OneBit>();
@@ -87,6 +93,7 @@ void TestBuffer() {
 
 TEST(Crc32Class, Buffer) {
   TestBuffer<Crc32>();
+  TestBuffer<Crc32SliceBy8>();
   TestBuffer<Crc32EightBit>();
   TestBuffer<Crc32FourBit>();
   TestBuffer<Crc32OneBit>();
@@ -102,6 +109,7 @@ void TestBufferAppend() {
 
 TEST(Crc32Class, BufferAppend) {
   TestBufferAppend<Crc32>();
+  TestBufferAppend<Crc32SliceBy8>();
   TestBufferAppend<Crc32EightBit>();
   TestBufferAppend<Crc32FourBit>();
   TestBufferAppend<Crc32OneBit>();
@@ -116,11 +124,30 @@ void TestString() {
 
 TEST(Crc32Class, String) {
   TestString<Crc32>();
+  TestString<Crc32SliceBy8>();
   TestString<Crc32EightBit>();
   TestString<Crc32FourBit>();
   TestString<Crc32OneBit>();
 }
 
+// Checks every length and alignment of a slice of kString, to cover both the
+// multi-byte and the single byte loops of each implementation.
+TEST(Crc32, ImplementationsMatchForAllLengthsAndAlignments) {
+  const ConstByteSpan string = as_bytes(span(kString));
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t size = 0; size <= string.size() - offset; ++size) {
+      const ConstByteSpan data = string.subspan(offset, size);
+      const uint32_t expected = Crc32OneBit::Calculate(data);
+      EXPECT_EQ(Crc32SliceBy8::Calculate(data), expected);
+      EXPECT_EQ(Crc32EightBit::Calculate(data), expected);
+      EXPECT_EQ(Crc32FourBit::Calculate(data), expected);
+#ifdef __ARM_FEATURE_CRC32
+      EXPECT_EQ(Crc32Armv8::Calculate(data), expected);
+#endif  // __ARM_FEATURE_CRC32
+    }
+  }
+}
+
 extern "C" uint32_t CallChecksumCrc32(const void* data, size_t size_bytes);
 extern "C" uint32_t CallChecksumCrc32Append(const void* data,
                                             size_t size_bytes,
@@ -23,15 +23,27 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "pw_checksum/internal/config.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
-// C API for calculating the CRC-16-CCITT of an array of data.
+// C API for calculating the CRC-16-CCITT of an array of data. Uses the
+// implementation selected by PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL.
 uint16_t pw_checksum_Crc16Ccitt(const void* data,
                                 size_t size_bytes,
                                 uint16_t initial_value);
 
+// Internal implementation functions for CRC-16-CCITT. Do not call them
+// directly; use the Crc16Ccitt classes instead.
+uint16_t _pw_checksum_InternalCrc16CcittSliceBy8(const void* data,
+                                                 size_t size_bytes,
+                                                 uint16_t value);
+uint16_t _pw_checksum_InternalCrc16CcittEightBit(const void* data,
+                                                 size_t size_bytes,
+                                                 uint16_t value);
+
 #ifdef __cplusplus
 }  // extern "C"
 
@@ -41,7 +53,12 @@ uint16_t pw_checksum_Crc16Ccitt(const void* data,
 namespace pw::checksum {
 
 // Calculates the CRC-16-CCITT for all data passed to Update.
-class Crc16Ccitt {
+//
+// kChecksumFunction updates a CRC-16-CCITT value with more data. Targets with
+// a CRC peripheral can use it by instantiating Crc16CcittImpl with a function
+// that drives the peripheral.
+template <uint16_t (*kChecksumFunction)(const void*, size_t, uint16_t)>
+class Crc16CcittImpl {
  public:
   static constexpr uint16_t kInitialValue = 0xFFFF;
 
@@ -50,8 +67,7 @@ class Crc16Ccitt {
   // Crc16Ccitt class or pass the previous value as the initial_value argument.
   static uint16_t Calculate(span<const std::byte> data,
                             uint16_t initial_value = kInitialValue) {
-    return pw_checksum_Crc16Ccitt(
-        data.data(), data.size_bytes(), initial_value);
+    return kChecksumFunction(data.data(), data.size_bytes(), initial_value);
   }
 
   static uint16_t Calculate(std::byte data,
@@ -59,7 +75,7 @@ class Crc16Ccitt {
     return Calculate(ConstByteSpan(&data, 1), initial_value);
   }
 
-  constexpr Crc16Ccitt() : value_(kInitialValue) {}
+  constexpr Crc16CcittImpl() : value_(kInitialValue) {}
 
   void Update(span<const std::byte> data) { value_ = Calculate(data, value_); }
 
@@ -75,6 +91,12 @@ class Crc16Ccitt {
   uint16_t value_;
 };
 
+using Crc16Ccitt = Crc16CcittImpl<pw_checksum_Crc16Ccitt>;
+using Crc16CcittSliceBy8 =
+    Crc16CcittImpl<_pw_checksum_InternalCrc16CcittSliceBy8>;
+using Crc16CcittEightBit =
+    Crc16CcittImpl<_pw_checksum_InternalCrc16CcittEightBit>;
+
 }  // namespace pw::checksum
 
 #endif  // __cplusplus
@@ -35,6 +35,10 @@ extern "C" {
 #define _PW_CHECKSUM_CRC32_INITIAL_STATE 0xFFFFFFFFu
 
 // Internal implementation function for CRC32. Do not call it directly.
+uint32_t _pw_checksum_InternalCrc32SliceBy8(const void* data,
+                                            size_t size_bytes,
+                                            uint32_t state);
+
 uint32_t _pw_checksum_InternalCrc32EightBit(const void* data,
                                             size_t size_bytes,
                                             uint32_t state);
@@ -46,12 +50,22 @@ uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
                                           size_t size_bytes,
                                           uint32_t state);
 
-#if PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS
+#ifdef __ARM_FEATURE_CRC32
+uint32_t _pw_checksum_InternalCrc32Armv8(const void* data,
+                                         size_t size_bytes,
+                                         uint32_t state);
+#endif  // __ARM_FEATURE_CRC32
+
+#if PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_8
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32SliceBy8
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32EightBit
 #elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_4BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32FourBit
 #elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_1BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32OneBit
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_ARMV8
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32Armv8
 #endif
 
 // Calculates the CRC32 for the provided data.
@@ -82,6 +96,10 @@ namespace pw::checksum {
 //
 // This class is more efficient than the CRC32 C functions since it doesn't
 // finalize the value each time it is appended to.
+//
+// kChecksumFunction updates a CRC32 state that has not been finalized. Targets
+// with a CRC peripheral can use it by instantiating Crc32Impl with a function
+// that drives the peripheral.
 template <uint32_t (*kChecksumFunction)(const void*, size_t, uint32_t)>
 class Crc32Impl {
  public:
@@ -113,9 +131,13 @@ class Crc32Impl {
 };
 
 using Crc32 = Crc32Impl<_pw_checksum_InternalCrc32>;
+using Crc32SliceBy8 = Crc32Impl<_pw_checksum_InternalCrc32SliceBy8>;
 using Crc32EightBit = Crc32Impl<_pw_checksum_InternalCrc32EightBit>;
 using Crc32FourBit = Crc32Impl<_pw_checksum_InternalCrc32FourBit>;
 using Crc32OneBit = Crc32Impl<_pw_checksum_InternalCrc32OneBit>;
+#ifdef __ARM_FEATURE_CRC32
+using Crc32Armv8 = Crc32Impl<_pw_checksum_InternalCrc32Armv8>;
+#endif  // __ARM_FEATURE_CRC32
 
 }  // namespace pw::checksum
 
@@ -14,16 +14,45 @@
 
 #pragma once
 
+#define PW_CHECKSUM_CRC32_SLICE_BY_8 64
 #define PW_CHECKSUM_CRC32_8BITS 8
 #define PW_CHECKSUM_CRC32_4BITS 4
 #define PW_CHECKSUM_CRC32_1BITS 1
 
+// Uses the ARMv8 CRC32 instructions. Only available when compiling for a target
+// with the CRC extension, which defines __ARM_FEATURE_CRC32.
+#define PW_CHECKSUM_CRC32_ARMV8 100
+
 #ifndef PW_CHECKSUM_CRC32_DEFAULT_IMPL
 #define PW_CHECKSUM_CRC32_DEFAULT_IMPL PW_CHECKSUM_CRC32_8BITS
 #endif  // PW_CHECKSUM_CRC32_DEFAULT_IMPL
 
+#define PW_CHECKSUM_CRC16_CCITT_SLICE_BY_8 64
+#define PW_CHECKSUM_CRC16_CCITT_8BITS 8
+
+// pw_checksum does not define pw_checksum_Crc16Ccitt. Instead, the target
+// provides it, e.g. to use a CRC peripheral.
+#define PW_CHECKSUM_CRC16_CCITT_EXTERNAL 0
+
+#ifndef PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL
+#define PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL PW_CHECKSUM_CRC16_CCITT_8BITS
+#endif  // PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL
+
 #ifdef __cplusplus
-static_assert(PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS ||
+static_assert(PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL ==
+                  PW_CHECKSUM_CRC16_CCITT_SLICE_BY_8 ||
+              PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL ==
+                  PW_CHECKSUM_CRC16_CCITT_8BITS ||
+              PW_CHECKSUM_CRC16_CCITT_DEFAULT_IMPL ==
+                  PW_CHECKSUM_CRC16_CCITT_EXTERNAL);
+static_assert(PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_8 ||
+              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS ||
               PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_4BITS ||
-              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_1BITS);
+              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_1BITS ||
+              PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_ARMV8);
 #endif  // __cplusplus
+
+#if PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_ARMV8 && \
+    !defined(__ARM_FEATURE_CRC32)
+#error "PW_CHECKSUM_CRC32_ARMV8 requires a target with the ARM CRC extension"
+#endif
@@ -24,6 +24,11 @@
 using TheChecksum = pw::checksum::Crc16Ccitt;
 #endif
 
+#ifdef USE_CRC32_SLICE_BY_8_CHECKSUM
+#include "pw_checksum/crc32.h"
+using TheChecksum = pw::checksum::Crc32SliceBy8;
+#endif
+
 #ifdef USE_CRC32_8BIT_CHECKSUM
 #include "pw_checksum/crc32.h"
 using TheChecksum = pw::checksum::Crc32EightBit;
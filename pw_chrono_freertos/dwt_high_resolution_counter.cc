@@ -0,0 +1,50 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// This counter is the Cortex-M Data Watchpoint and Trace (DWT) unit's cycle
+// counter. The documentation can be found here:
+// https://developer.arm.com/documentation/ddi0403/d/Debug-Architecture/ARMv7-M-Debug/The-Data-Watchpoint-and-Trace-unit
+
+#include <cstdint>
+
+#include "pw_chrono_freertos/high_resolution_counter.h"
+
+namespace pw::chrono::freertos {
+namespace {
+
+volatile uint32_t& kDwtCtrl = *reinterpret_cast<volatile uint32_t*>(0xE0001000);
+volatile uint32_t& kDwtCyccnt =
+    *reinterpret_cast<volatile uint32_t*>(0xE0001004);
+// Some cores, such as the Cortex-M7, ignore writes to the DWT until it is
+// unlocked through the lock access register.
+volatile uint32_t& kDwtLar = *reinterpret_cast<volatile uint32_t*>(0xE0001FB0);
+volatile uint32_t& kDemcr = *reinterpret_cast<volatile uint32_t*>(0xE000EDFC);
+
+constexpr uint32_t kDemcrTrcena = 1u << 24;
+constexpr uint32_t kDwtCtrlCyccntena = 1u << 0;
+constexpr uint32_t kDwtLarUnlockKey = 0xC5ACCE55;
+
+}  // namespace
+
+uint32_t ReadHighResolutionCounter() {
+  // Enable the cycle counter on first use, or if a debugger disabled it.
+  if ((kDwtCtrl & kDwtCtrlCyccntena) == 0) {
+    kDemcr |= kDemcrTrcena;
+    kDwtLar = kDwtLarUnlockKey;
+    kDwtCtrl |= kDwtCtrlCyccntena;
+  }
+  return kDwtCyccnt;
+}
+
+}  // namespace pw::chrono::freertos
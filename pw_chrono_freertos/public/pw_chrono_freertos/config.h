@@ -28,3 +28,22 @@
 static_assert((PW_CHRONO_FREERTOS_CFG_MAX_TIMEOUT > 0) &&
                   (PW_CHRONO_FREERTOS_CFG_MAX_TIMEOUT <= portMAX_DELAY),
               "Invalid MAX timeout configuration");
+
+// The frequency in Hz of the free running hardware counter which is combined
+// with the FreeRTOS tick to give pw::chrono::SystemClock sub-tick resolution,
+// or 0 to use the FreeRTOS tick alone.
+//
+// When enabled, the SystemClock period becomes one count of the hardware
+// counter, which is read through pw::chrono::freertos::
+// ReadHighResolutionCounter(). This must be a compile time constant which is a
+// multiple of configTICK_RATE_HZ.
+#ifndef PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ
+#define PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ 0
+#endif  // PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ
+
+static_assert((PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ == 0) ||
+                  (PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ %
+                       configTICK_RATE_HZ ==
+                   0),
+              "The high resolution counter frequency must be a multiple of "
+              "the tick rate");
@@ -0,0 +1,30 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+namespace pw::chrono::freertos {
+
+// Returns the current value of the free running 32 bit hardware counter which
+// gives the FreeRTOS pw::chrono::SystemClock sub-tick resolution.
+//
+// This must be provided by the application, or by a target such as
+// pw_chrono_freertos:dwt_high_resolution_counter, when
+// PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ is set. The counter must
+// increment at PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ, wrap from
+// 0xFFFFFFFF to 0, and be safe to read from both threads and interrupts.
+uint32_t ReadHighResolutionCounter();
+
+}  // namespace pw::chrono::freertos
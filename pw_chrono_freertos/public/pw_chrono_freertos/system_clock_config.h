@@ -14,10 +14,17 @@
 #pragma once
 
 #include "FreeRTOS.h"
+#include "pw_chrono_freertos/config.h"
 
-// Use the FreeRTOS config's tick rate.
 #define PW_CHRONO_SYSTEM_CLOCK_PERIOD_SECONDS_NUMERATOR 1
+#if PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
+// Count in periods of the high resolution counter.
+#define PW_CHRONO_SYSTEM_CLOCK_PERIOD_SECONDS_DENOMINATOR \
+  PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ
+#else
+// Use the FreeRTOS config's tick rate.
 #define PW_CHRONO_SYSTEM_CLOCK_PERIOD_SECONDS_DENOMINATOR configTICK_RATE_HZ
+#endif  // PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
 
 #ifdef __cplusplus
 
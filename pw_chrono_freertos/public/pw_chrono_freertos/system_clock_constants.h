@@ -13,14 +13,36 @@
 // the License.
 #pragma once
 
+#include <cstdint>
+
+#include "FreeRTOS.h"
 #include "pw_chrono/system_clock.h"
 #include "pw_chrono_freertos/config.h"
 
 namespace pw::chrono::freertos {
 
+// The number of pw::chrono::SystemClock counts per FreeRTOS tick. This is 1
+// unless PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ is set.
+inline constexpr int64_t kCountsPerTick =
+    static_cast<int64_t>(SystemClock::period::den) /
+    (static_cast<int64_t>(configTICK_RATE_HZ) * SystemClock::period::num);
+static_assert(kCountsPerTick > 0 &&
+                  static_cast<int64_t>(SystemClock::period::den) %
+                          (static_cast<int64_t>(configTICK_RATE_HZ) *
+                           SystemClock::period::num) ==
+                      0,
+              "The SystemClock period must evenly divide the FreeRTOS tick");
+
 // Max timeout to be used by users of the FreeRTOS's pw::chrono::SystemClock
 // backend provided by this module.
 inline constexpr SystemClock::duration kMaxTimeout =
-    SystemClock::duration(PW_CHRONO_FREERTOS_CFG_MAX_TIMEOUT);
+    SystemClock::duration(PW_CHRONO_FREERTOS_CFG_MAX_TIMEOUT * kCountsPerTick);
+
+// Converts a positive duration of at most kMaxTimeout to FreeRTOS ticks. This
+// rounds up so that blocking for the result never returns early.
+constexpr TickType_t ToTicks(SystemClock::duration duration) {
+  return static_cast<TickType_t>((duration.count() + kCountsPerTick - 1) /
+                                 kCountsPerTick);
+}
 
 }  // namespace pw::chrono::freertos
@@ -20,10 +20,18 @@
 #include <mutex>
 
 #include "FreeRTOS.h"
+#include "pw_chrono_freertos/config.h"
 #include "pw_interrupt/context.h"
 #include "pw_sync/interrupt_spin_lock.h"
 #include "task.h"
 
+#if PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
+#include <algorithm>
+
+#include "pw_chrono_freertos/high_resolution_counter.h"
+#include "pw_chrono_freertos/system_clock_constants.h"
+#endif  // PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
+
 namespace pw::chrono::backend {
 namespace {
 
@@ -37,14 +45,27 @@ static_assert(!SystemClock::is_nmi_safe,
 constexpr int64_t kNativeOverflowTickCount =
     static_cast<int64_t>(std::numeric_limits<TickType_t>::max()) + 1;
 
-}  // namespace
+#if PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
+using freertos::kCountsPerTick;
 
-int64_t GetSystemClockTickCount() {
-  std::lock_guard lock(system_clock_interrupt_spin_lock);
+// The counts within a tick must be far from the 32 bit counter's wrap point to
+// tell them apart from counts in other ticks.
+static_assert(kCountsPerTick < (int64_t{1} << 30),
+              "The high resolution counter is too fast for the tick rate");
+
+// The counter's value, modulo 2^32, at the start of tick 0. This is anchored
+// to the tick on first use, so the clock may trail the tick by up to one tick.
+uint32_t counter_at_tick_zero = 0;
+bool counter_anchored = false;
+int64_t last_count = 0;
+#endif  // PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
+
+// WARNING: This must be called with the spin lock held, and more than once per
+// overflow period!
+int64_t GetTicks() {
   const TickType_t new_native_tick_count = interrupt::InInterruptContext()
                                                ? xTaskGetTickCountFromISR()
                                                : xTaskGetTickCount();
-  // WARNING: This must be called more than once per overflow period!
   if (new_native_tick_count < native_tick_count) {
     // Native tick count overflow detected!
     overflow_tick_count += kNativeOverflowTickCount;
@@ -53,4 +74,41 @@ int64_t GetSystemClockTickCount() {
   return overflow_tick_count + native_tick_count;
 }
 
+}  // namespace
+
+#if PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
+
+int64_t GetSystemClockTickCount() {
+  std::lock_guard lock(system_clock_interrupt_spin_lock);
+  const int64_t tick_start = GetTicks() * kCountsPerTick;
+  const uint32_t counter = freertos::ReadHighResolutionCounter();
+
+  // Only the counts since the start of the current tick are taken from the
+  // counter, so the counter may wrap any number of times between calls. This
+  // may exceed one tick if the tick interrupt is pending or masked.
+  int64_t counts_into_tick = static_cast<int32_t>(
+      counter - (counter_at_tick_zero + static_cast<uint32_t>(tick_start)));
+  if (!counter_anchored || counts_into_tick < -kCountsPerTick) {
+    // Anchor the counter to the current tick on first use, and again if the
+    // counter fell behind the tick, e.g. because it halted while sleeping.
+    counter_at_tick_zero = counter - static_cast<uint32_t>(tick_start);
+    counter_anchored = true;
+    counts_into_tick = 0;
+  }
+
+  // Re-anchoring may step the counter back within a tick, so never return an
+  // earlier time than before.
+  last_count = std::max(last_count, tick_start + counts_into_tick);
+  return last_count;
+}
+
+#else
+
+int64_t GetSystemClockTickCount() {
+  std::lock_guard lock(system_clock_interrupt_spin_lock);
+  return GetTicks();
+}
+
+#endif  // PW_CHRONO_FREERTOS_CFG_HIGH_RESOLUTION_COUNTER_HZ != 0
+
 }  // namespace pw::chrono::backend
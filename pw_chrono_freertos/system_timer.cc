@@ -82,7 +82,7 @@ void HandleTimerCallback(TimerHandle_t timer_handle) {
       std::min(pw::chrono::freertos::kMaxTimeout, time_until_deadline);
   PW_CHECK_UINT_EQ(
       xTimerChangePeriod(reinterpret_cast<TimerHandle_t>(&native_type.tcb),
-                         static_cast<TickType_t>(period.count()),
+                         pw::chrono::freertos::ToTicks(period),
                          0),
       pdPASS,
       "Timer command queue overflowed");
@@ -94,7 +94,8 @@ void HandleTimerCallback(TimerHandle_t timer_handle) {
 
 // FreeRTOS requires a timer to have a non-zero period.
 constexpr SystemClock::duration kMinTimerPeriod = SystemClock::duration(1);
-constexpr TickType_t kInvalidPeriod = kMinTimerPeriod.count();
+constexpr TickType_t kInvalidPeriod =
+    pw::chrono::freertos::ToTicks(kMinTimerPeriod);
 constexpr UBaseType_t kOneShotMode = pdFALSE;  // Do not use auto reload.
 
 }  // namespace
@@ -174,7 +175,7 @@ void SystemTimer::InvokeAt(SystemClock::time_point timestamp) {
 
   PW_CHECK_UINT_EQ(
       xTimerChangePeriod(reinterpret_cast<TimerHandle_t>(&native_type_.tcb),
-                         static_cast<TickType_t>(period.count()),
+                         pw::chrono::freertos::ToTicks(period),
                          0),
       pdPASS,
       "Timer command queue overflowed");
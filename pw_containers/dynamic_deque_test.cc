@@ -0,0 +1,219 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/dynamic_deque.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#include "pw_allocator/testing.h"
+#include "pw_containers_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+using allocator::Layout;
+using allocator::test::AllocatorForTest;
+using containers::test::Counter;
+
+class DynamicDequeTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Counter::Reset(); }
+
+  // The deque only move-constructs and destroys elements, never assigns them,
+  // so every element should be destroyed exactly once.
+  void TearDown() override { EXPECT_EQ(0, Live()); }
+
+  // Returns the number of elements constructed and not yet destroyed.
+  static int Live() {
+    return Counter::created + Counter::moved - Counter::destroyed;
+  }
+
+  // Checks that the deque holds first, first + 1, ..., first + count - 1.
+  template <typename Deque>
+  void ExpectSequence(const Deque& deque, int first, int count) {
+    ASSERT_EQ(static_cast<size_t>(count), deque.size());
+    for (int i = 0; i < count; ++i) {
+      EXPECT_EQ(first + i, Value(deque[static_cast<size_t>(i)]));
+    }
+  }
+
+  static int Value(int value) { return value; }
+  static int Value(const Counter& value) { return value.value; }
+
+  AllocatorForTest<512> allocator_;
+};
+
+TEST_F(DynamicDequeTest, DefaultConstructed_DoesNotAllocate) {
+  DynamicDeque<int> deque(allocator_);
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(0u, deque.capacity());
+  EXPECT_EQ(deque.begin(), deque.end());
+  EXPECT_EQ(0u, allocator_.allocate_size());
+}
+
+TEST_F(DynamicDequeTest, PushBothEnds) {
+  DynamicDeque<int> deque(allocator_);
+  for (int i = 0; i < 10; ++i) {
+    deque.push_back(10 + i);
+    deque.push_front(9 - i);
+  }
+  ExpectSequence(deque, 0, 20);
+  EXPECT_EQ(0, deque.front());
+  EXPECT_EQ(19, deque.back());
+}
+
+TEST_F(DynamicDequeTest, PopBothEnds) {
+  DynamicDeque<Counter> deque(allocator_);
+  for (int i = 0; i < 6; ++i) {
+    deque.emplace_back(i);
+  }
+  deque.pop_front();
+  deque.pop_back();
+  ExpectSequence(deque, 1, 4);
+  EXPECT_EQ(4, Live());
+}
+
+TEST_F(DynamicDequeTest, GrowWhileWrapped_ResizesInPlace) {
+  DynamicDeque<Counter> deque(allocator_);
+  deque.reserve(4);
+  for (int i = 0; i < 4; ++i) {
+    deque.emplace_back(i);
+  }
+  const Counter* data = &deque.front();
+  // Leave the contents wrapped around the end of the buffer: [4, 5, 2, 3].
+  deque.pop_front();
+  deque.emplace_back(4);
+  deque.pop_front();
+  deque.emplace_back(5);
+  ExpectSequence(deque, 2, 4);
+
+  deque.emplace_back(6);
+  EXPECT_EQ(data, allocator_.resize_ptr());
+  EXPECT_EQ(8u, deque.capacity());
+  ExpectSequence(deque, 2, 5);
+  EXPECT_EQ(5, Live());
+}
+
+TEST_F(DynamicDequeTest, GrowWhileWrapped_MovesWhenResizeFails) {
+  DynamicDeque<Counter> deque(allocator_);
+  for (int i = 0; i < 4; ++i) {
+    deque.emplace_front(3 - i);
+  }
+  void* blocker = allocator_.Allocate(Layout(16, alignof(int)));
+  ASSERT_NE(blocker, nullptr);
+
+  deque.emplace_front(-1);
+  ExpectSequence(deque, -1, 5);
+  EXPECT_EQ(5, Live());
+  allocator_.Deallocate(blocker, Layout(16, alignof(int)));
+}
+
+TEST_F(DynamicDequeTest, PushOwnElement_WhileGrowing) {
+  DynamicDeque<Counter> deque(allocator_);
+  for (int i = 0; i < 4; ++i) {
+    deque.emplace_back(i);
+  }
+  void* blocker = allocator_.Allocate(Layout(16, alignof(int)));
+  ASSERT_NE(blocker, nullptr);
+
+  ASSERT_EQ(deque.size(), deque.capacity());
+  deque.push_front(deque.back());
+  ASSERT_EQ(5u, deque.size());
+  EXPECT_EQ(3, deque.front().value);
+  EXPECT_EQ(3, deque.back().value);
+  allocator_.Deallocate(blocker, Layout(16, alignof(int)));
+}
+
+TEST_F(DynamicDequeTest, TryPush_OutOfMemory_ReturnsFalse) {
+  DynamicDeque<int> deque(allocator_);
+  deque.push_back(1);
+  allocator_.Exhaust();
+  ASSERT_TRUE(deque.try_push_back(2));
+  ASSERT_TRUE(deque.try_push_front(0));
+  ASSERT_TRUE(deque.try_push_back(3));
+  EXPECT_FALSE(deque.try_push_back(4));
+  EXPECT_FALSE(deque.try_push_front(-1));
+  EXPECT_FALSE(deque.try_reserve(100));
+  ExpectSequence(deque, 0, 4);
+}
+
+TEST_F(DynamicDequeTest, UseAsQueue_DoesNotGrow) {
+  DynamicDeque<int> deque(allocator_);
+  deque.reserve(4);
+  for (int i = 0; i < 100; ++i) {
+    deque.push_back(i);
+    if (deque.size() > 3) {
+      deque.pop_front();
+    }
+  }
+  EXPECT_EQ(4u, deque.capacity());
+  ExpectSequence(deque, 97, 3);
+}
+
+TEST_F(DynamicDequeTest, ShrinkToFit) {
+  DynamicDeque<int> deque(allocator_);
+  deque.reserve(16);
+  for (int i = 0; i < 4; ++i) {
+    deque.push_back(i);
+  }
+  deque.pop_front();
+  deque.shrink_to_fit();
+  EXPECT_EQ(3u, deque.capacity());
+  ExpectSequence(deque, 1, 3);
+
+  deque.clear();
+  deque.shrink_to_fit();
+  EXPECT_EQ(0u, deque.capacity());
+}
+
+TEST_F(DynamicDequeTest, Move) {
+  DynamicDeque<Counter> deque(allocator_);
+  deque.emplace_back(1);
+  DynamicDeque<Counter> moved(std::move(deque));
+  EXPECT_TRUE(deque.empty());  // NOLINT(bugprone-use-after-move)
+  ExpectSequence(moved, 1, 1);
+
+  DynamicDeque<Counter> assigned(allocator_);
+  assigned.emplace_back(2);
+  assigned = std::move(moved);
+  ExpectSequence(assigned, 1, 1);
+  EXPECT_EQ(1, Live());
+}
+
+TEST_F(DynamicDequeTest, Iterators) {
+  DynamicDeque<int> deque(allocator_);
+  for (int i = 0; i < 5; ++i) {
+    deque.push_front(i);
+  }
+  EXPECT_EQ(5, deque.end() - deque.begin());
+  EXPECT_EQ(2, deque.begin()[2]);
+  EXPECT_EQ(4, *deque.begin());
+  EXPECT_EQ(0, *(deque.end() - 1));
+
+  std::sort(deque.begin(), deque.end());
+  ExpectSequence(deque, 0, 5);
+
+  const DynamicDeque<int>& const_deque = deque;
+  DynamicDeque<int>::const_iterator it = deque.begin();
+  EXPECT_EQ(it, const_deque.cbegin());
+  EXPECT_EQ(5, std::distance(const_deque.begin(), const_deque.end()));
+}
+
+}  // namespace
+}  // namespace pw
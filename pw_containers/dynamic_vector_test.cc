@@ -0,0 +1,249 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/dynamic_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pw_allocator/testing.h"
+#include "pw_containers_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+using allocator::Layout;
+using allocator::test::AllocatorForTest;
+using containers::test::Counter;
+
+class DynamicVectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Counter::Reset(); }
+
+  // Returns the number of elements that have been constructed and not yet
+  // destroyed. ``Counter`` also counts assignments, so this is only accurate
+  // while no elements have been assigned to.
+  static int Live() {
+    return Counter::created + Counter::moved - Counter::destroyed;
+  }
+
+  AllocatorForTest<512> allocator_;
+};
+
+TEST_F(DynamicVectorTest, DefaultConstructed_DoesNotAllocate) {
+  DynamicVector<int> vector(allocator_);
+  EXPECT_TRUE(vector.empty());
+  EXPECT_EQ(0u, vector.size());
+  EXPECT_EQ(0u, vector.capacity());
+  EXPECT_EQ(vector.begin(), vector.end());
+  EXPECT_EQ(0u, allocator_.allocate_size());
+}
+
+TEST_F(DynamicVectorTest, PushBack_GrowsGeometrically) {
+  DynamicVector<int> vector(allocator_);
+  vector.push_back(0);
+  EXPECT_EQ(4u, vector.capacity());
+  for (int i = 1; i < 9; ++i) {
+    vector.push_back(i);
+  }
+  EXPECT_EQ(16u, vector.capacity());
+  ASSERT_EQ(9u, vector.size());
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_EQ(i, vector[static_cast<size_t>(i)]);
+  }
+  EXPECT_EQ(0, vector.front());
+  EXPECT_EQ(8, vector.back());
+}
+
+TEST_F(DynamicVectorTest, Grow_ResizesInPlaceWhenPossible) {
+  DynamicVector<int> vector(allocator_);
+  vector.push_back(1);
+  const int* data = vector.data();
+  vector.reserve(32);
+  EXPECT_EQ(data, vector.data());
+  EXPECT_EQ(data, allocator_.resize_ptr());
+  EXPECT_EQ(32 * sizeof(int), allocator_.resize_new_size());
+  EXPECT_EQ(1, vector[0]);
+}
+
+TEST_F(DynamicVectorTest, Grow_MovesWhenResizeFails) {
+  DynamicVector<Counter> vector(allocator_);
+  vector.emplace_back(1);
+  vector.emplace_back(2);
+  const Counter* data = vector.data();
+
+  // Block the memory after the vector's allocation.
+  void* blocker = allocator_.Allocate(Layout(16, alignof(int)));
+  ASSERT_NE(blocker, nullptr);
+
+  vector.reserve(16);
+  EXPECT_NE(data, vector.data());
+  ASSERT_EQ(2u, vector.size());
+  EXPECT_EQ(1, vector[0].value);
+  EXPECT_EQ(2, vector[1].value);
+  EXPECT_EQ(2, Live());
+  allocator_.Deallocate(blocker, Layout(16, alignof(int)));
+}
+
+TEST_F(DynamicVectorTest, PushBackOwnElement_WhileGrowing) {
+  DynamicVector<Counter> vector(allocator_);
+  for (int i = 0; i < 4; ++i) {
+    vector.emplace_back(i);
+  }
+  void* blocker = allocator_.Allocate(Layout(16, alignof(int)));
+  ASSERT_NE(blocker, nullptr);
+
+  ASSERT_EQ(vector.size(), vector.capacity());
+  vector.push_back(vector[1]);
+  ASSERT_EQ(5u, vector.size());
+  EXPECT_EQ(1, vector[1].value);
+  EXPECT_EQ(1, vector[4].value);
+  allocator_.Deallocate(blocker, Layout(16, alignof(int)));
+}
+
+TEST_F(DynamicVectorTest, TryPushBack_OutOfMemory_ReturnsFalse) {
+  DynamicVector<int> vector(allocator_);
+  vector.push_back(1);
+  allocator_.Exhaust();
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(vector.try_push_back(i));
+  }
+  EXPECT_FALSE(vector.try_push_back(4));
+  EXPECT_FALSE(vector.try_reserve(100));
+  EXPECT_EQ(4u, vector.size());
+  EXPECT_EQ(4u, vector.capacity());
+}
+
+TEST_F(DynamicVectorTest, TryReserve_TooLarge_ReturnsFalse) {
+  DynamicVector<int> vector(allocator_);
+  EXPECT_FALSE(vector.try_reserve(1000));
+  EXPECT_EQ(0u, vector.capacity());
+}
+
+TEST_F(DynamicVectorTest, InsertAndErase) {
+  DynamicVector<Counter> vector(allocator_);
+  for (int i : {1, 2, 4, 5}) {
+    vector.emplace_back(i);
+  }
+  auto it = vector.insert(vector.begin() + 2, Counter(3));
+  EXPECT_EQ(3, it->value);
+  it = vector.emplace(vector.begin(), 0);
+  EXPECT_EQ(0, it->value);
+  it = vector.emplace(vector.end(), 6);
+  EXPECT_EQ(6, it->value);
+  ASSERT_EQ(7u, vector.size());
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(i, vector[static_cast<size_t>(i)].value);
+  }
+
+  // Erasing shifts the later elements down and destroys the vacated slots.
+  const int destroyed = Counter::destroyed;
+  it = vector.erase(vector.begin() + 1);
+  EXPECT_EQ(2, it->value);
+  it = vector.erase(vector.begin() + 2, vector.begin() + 4);
+  EXPECT_EQ(5, it->value);
+  ASSERT_EQ(4u, vector.size());
+  EXPECT_EQ(0, vector[0].value);
+  EXPECT_EQ(2, vector[1].value);
+  EXPECT_EQ(5, vector[2].value);
+  EXPECT_EQ(6, vector[3].value);
+  EXPECT_EQ(destroyed + 3, Counter::destroyed);
+}
+
+TEST_F(DynamicVectorTest, Resize) {
+  DynamicVector<Counter> vector(allocator_);
+  vector.resize(3, Counter(7));
+  ASSERT_EQ(3u, vector.size());
+  EXPECT_EQ(7, vector[2].value);
+  vector.resize(5);
+  ASSERT_EQ(5u, vector.size());
+  EXPECT_EQ(0, vector[4].value);
+  vector.resize(1);
+  ASSERT_EQ(1u, vector.size());
+  EXPECT_EQ(1, Live());
+}
+
+TEST_F(DynamicVectorTest, PopBackAndClear) {
+  DynamicVector<Counter> vector(allocator_);
+  vector.emplace_back(1);
+  vector.emplace_back(2);
+  vector.pop_back();
+  EXPECT_EQ(1u, vector.size());
+  EXPECT_EQ(1, Live());
+  vector.clear();
+  EXPECT_TRUE(vector.empty());
+  EXPECT_EQ(0, Live());
+  EXPECT_NE(0u, vector.capacity());
+}
+
+TEST_F(DynamicVectorTest, ShrinkToFit) {
+  DynamicVector<int> vector(allocator_);
+  vector.reserve(16);
+  vector.push_back(1);
+  vector.push_back(2);
+  vector.shrink_to_fit();
+  EXPECT_EQ(2u, vector.capacity());
+  EXPECT_EQ(1, vector[0]);
+  EXPECT_EQ(2, vector[1]);
+
+  vector.clear();
+  vector.shrink_to_fit();
+  EXPECT_EQ(0u, vector.capacity());
+  EXPECT_EQ(nullptr, vector.data());
+}
+
+TEST_F(DynamicVectorTest, Move) {
+  DynamicVector<Counter> vector(allocator_);
+  vector.emplace_back(1);
+  DynamicVector<Counter> moved(std::move(vector));
+  EXPECT_EQ(0u, vector.size());  // NOLINT(bugprone-use-after-move)
+  ASSERT_EQ(1u, moved.size());
+  EXPECT_EQ(1, moved[0].value);
+
+  DynamicVector<Counter> assigned(allocator_);
+  assigned.emplace_back(2);
+  assigned = std::move(moved);
+  ASSERT_EQ(1u, assigned.size());
+  EXPECT_EQ(1, assigned[0].value);
+  EXPECT_EQ(1, Live());
+}
+
+TEST_F(DynamicVectorTest, Destructor_FreesMemory) {
+  {
+    DynamicVector<Counter> vector(allocator_);
+    vector.reserve(8);
+    vector.emplace_back(1);
+  }
+  EXPECT_EQ(0, Live());
+  EXPECT_EQ(8 * sizeof(Counter), allocator_.deallocate_size());
+}
+
+TEST_F(DynamicVectorTest, Iterate) {
+  DynamicVector<int> vector(allocator_);
+  for (int i = 0; i < 5; ++i) {
+    vector.push_back(i);
+  }
+  int expected = 0;
+  for (int value : vector) {
+    EXPECT_EQ(expected++, value);
+  }
+  for (auto it = vector.rbegin(); it != vector.rend(); ++it) {
+    EXPECT_EQ(--expected, *it);
+  }
+}
+
+}  // namespace
+}  // namespace pw
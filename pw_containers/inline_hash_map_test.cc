@@ -0,0 +1,316 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/inline_hash_map.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "pw_containers_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::containers {
+namespace {
+
+static_assert(std::is_same_v<internal::SmallestUnsigned<255>, uint8_t>);
+static_assert(std::is_same_v<internal::SmallestUnsigned<256>, uint16_t>);
+static_assert(std::is_same_v<internal::SmallestUnsigned<65536>, size_t>);
+
+// Hashes every key to the same slot, so every entry is in one run.
+struct CollidingHash {
+  size_t operator()(int) const { return 0; }
+};
+
+// Checks that every key in [0, count) maps to key * 10 and others are absent.
+template <typename Map>
+void ExpectKeysUpTo(const Map& map, int count) {
+  EXPECT_EQ(static_cast<size_t>(count), map.size());
+  for (int key = 0; key < count; ++key) {
+    ASSERT_TRUE(map.contains(key)) << key;
+    EXPECT_EQ(key * 10, map.at(key));
+  }
+  EXPECT_FALSE(map.contains(count));
+  EXPECT_FALSE(map.contains(-1));
+}
+
+TEST(InlineHashMap, DefaultConstructed_IsEmpty) {
+  InlineHashMap<int, int, 4> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.full());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(4u, map.max_size());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.end(), map.find(1));
+}
+
+TEST(InlineHashMap, InitializerList) {
+  InlineHashMap<int, char, 4> map = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ('a', map.at(1));
+  EXPECT_EQ('b', map.at(2));
+  EXPECT_EQ('c', map.at(3));
+}
+
+TEST(InlineHashMap, Insert) {
+  InlineHashMap<int, int, 8> map;
+  auto [it, inserted] = map.insert({1, 10});
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(1, it->first);
+  EXPECT_EQ(10, it->second);
+
+  auto [again, inserted_again] = map.insert({1, 20});
+  EXPECT_FALSE(inserted_again);
+  EXPECT_EQ(it, again);
+  EXPECT_EQ(10, map.at(1));
+  EXPECT_EQ(1u, map.size());
+}
+
+TEST(InlineHashMap, TryEmplace_DoesNotReplace) {
+  InlineHashMap<int, int, 8> map;
+  EXPECT_TRUE(map.try_emplace(5, 50).second);
+  EXPECT_FALSE(map.try_emplace(5, 51).second);
+  EXPECT_EQ(50, map.at(5));
+}
+
+TEST(InlineHashMap, InsertOrAssign) {
+  InlineHashMap<int, int, 8> map;
+  EXPECT_TRUE(map.insert_or_assign(5, 50).second);
+  EXPECT_FALSE(map.insert_or_assign(5, 51).second);
+  EXPECT_EQ(51, map.at(5));
+}
+
+TEST(InlineHashMap, SubscriptOperator) {
+  InlineHashMap<int, int, 8> map;
+  EXPECT_EQ(0, map[3]);
+  map[3] = 30;
+  map[4] += 40;
+  EXPECT_EQ(30, map.at(3));
+  EXPECT_EQ(40, map.at(4));
+  EXPECT_EQ(2u, map.size());
+}
+
+TEST(InlineHashMap, FindAndCount) {
+  InlineHashMap<int, int, 8> map = {{1, 10}, {2, 20}};
+  auto it = map.find(2);
+  ASSERT_NE(it, map.end());
+  it->second = 21;
+  EXPECT_EQ(21, map.at(2));
+  EXPECT_EQ(1u, map.count(2));
+  EXPECT_EQ(0u, map.count(3));
+
+  const auto& const_map = map;
+  EXPECT_EQ(10, const_map.find(1)->second);
+  EXPECT_EQ(const_map.end(), const_map.find(3));
+}
+
+TEST(InlineHashMap, Fill_AllKeysFound) {
+  InlineHashMap<int, int, 16> map;
+  for (int key = 0; key < 16; ++key) {
+    map.try_emplace(key, key * 10);
+  }
+  EXPECT_TRUE(map.full());
+  ExpectKeysUpTo(map, 16);
+}
+
+TEST(InlineHashMap, Collisions_AllKeysFound) {
+  InlineHashMap<int, int, 8, CollidingHash> map;
+  for (int key = 0; key < 8; ++key) {
+    map.try_emplace(key, key * 10);
+  }
+  ExpectKeysUpTo(map, 8);
+}
+
+TEST(InlineHashMap, Erase_ShiftsRunBack) {
+  InlineHashMap<int, int, 8, CollidingHash> map;
+  for (int key = 0; key < 6; ++key) {
+    map.try_emplace(key, key * 10);
+  }
+  EXPECT_EQ(1u, map.erase(0));
+  EXPECT_EQ(0u, map.erase(0));
+  EXPECT_EQ(1u, map.erase(3));
+  EXPECT_EQ(4u, map.size());
+  for (int key : {1, 2, 4, 5}) {
+    EXPECT_EQ(key * 10, map.at(key));
+  }
+
+  // Slots freed by erasing are reused without leaving tombstones.
+  map.try_emplace(0, 0);
+  map.try_emplace(3, 30);
+  ExpectKeysUpTo(map, 6);
+}
+
+TEST(InlineHashMap, RepeatedInsertAndErase_DoesNotDegrade) {
+  InlineHashMap<int, int, 8> map;
+  for (int round = 0; round < 1000; ++round) {
+    for (int key = 0; key < 6; ++key) {
+      map.try_emplace(round * 6 + key, key);
+    }
+    for (int key = 0; key < 6; ++key) {
+      ASSERT_EQ(1u, map.erase(round * 6 + key));
+    }
+    ASSERT_TRUE(map.empty());
+  }
+}
+
+TEST(InlineHashMap, MatchesLinearSearch) {
+  constexpr int kKeys = 64;
+  InlineHashMap<uint32_t, int, 48> map;
+  int expected[kKeys] = {};  // 0 means absent
+
+  uint32_t state = 1;
+  for (int i = 0; i < 10000; ++i) {
+    state = state * 1664525u + 1013904223u;  // LCG
+    const uint32_t key = (state >> 8) % kKeys;
+    if ((state >> 24) % 3 == 0 || map.full()) {
+      EXPECT_EQ(expected[key] != 0 ? 1u : 0u, map.erase(key));
+      expected[key] = 0;
+    } else {
+      map[key] = i + 1;
+      expected[key] = i + 1;
+    }
+  }
+
+  size_t expected_size = 0;
+  for (uint32_t key = 0; key < kKeys; ++key) {
+    if (expected[key] != 0) {
+      expected_size += 1;
+      ASSERT_TRUE(map.contains(key));
+      EXPECT_EQ(expected[key], map.at(key));
+    } else {
+      EXPECT_FALSE(map.contains(key));
+    }
+  }
+  EXPECT_EQ(expected_size, map.size());
+}
+
+TEST(InlineHashMap, Iterate_VisitsEachEntryOnce) {
+  InlineHashMap<int, int, 8> map = {{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+  int sum = 0;
+  size_t count = 0;
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(key * 10, value);
+    sum += key;
+    count += 1;
+  }
+  EXPECT_EQ(10, sum);
+  EXPECT_EQ(4u, count);
+}
+
+// Hashes every key to the same value, which tests can change.
+struct SettableHash {
+  static size_t value;
+  size_t operator()(int) const { return value; }
+};
+
+size_t SettableHash::value = 0;
+
+TEST(InlineHashMap, EraseWhileIterating) {
+  // Colliding keys in a full map wrap around the end of the table for some
+  // hashes, which exercises erase() shifting entries from the first slot to
+  // the last.
+  for (int i = 0; i < 128; ++i) {
+    SettableHash::value = static_cast<size_t>(i / 8);
+    const int start = i % 8;
+    InlineHashMap<int, int, 8, SettableHash> map;
+    for (int key = 0; key < 8; ++key) {
+      map.try_emplace(key, key * 10);
+    }
+    // Erase a different subset each time to cover runs that wrap.
+    for (int key = 0; key < start; ++key) {
+      map.erase(key);
+      map.try_emplace(key, key * 10);
+    }
+
+    int visited = 0;
+    for (auto it = map.begin(); it != map.end();) {
+      visited += 1;
+      if (it->first % 2 == 0) {
+        it = map.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    EXPECT_EQ(8, visited);
+    EXPECT_EQ(4u, map.size());
+    for (int key = 0; key < 8; ++key) {
+      EXPECT_EQ(key % 2 != 0, map.contains(key));
+    }
+  }
+}
+
+TEST(InlineHashMap, EraseAllWhileIterating) {
+  InlineHashMap<int, int, 8, CollidingHash> map;
+  for (int key = 0; key < 8; ++key) {
+    map.try_emplace(key, key);
+  }
+  int visited = 0;
+  for (auto it = map.begin(); it != map.end();) {
+    visited += 1;
+    it = map.erase(it);
+  }
+  EXPECT_EQ(8, visited);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(InlineHashMap, DestroysEntries) {
+  test::Counter::Reset();
+  {
+    InlineHashMap<int, test::Counter, 8, CollidingHash> map;
+    for (int key = 0; key < 6; ++key) {
+      map.try_emplace(key, key);
+    }
+    EXPECT_EQ(6, test::Counter::created);
+    EXPECT_EQ(0, test::Counter::destroyed);
+
+    // Erasing shifts the later entries of the run back by moving them.
+    map.erase(2);
+    EXPECT_EQ(5,
+              test::Counter::created + test::Counter::moved -
+                  test::Counter::destroyed);
+    EXPECT_EQ(5, map.at(5).value);
+
+    InlineHashMap<int, test::Counter, 8, CollidingHash> copy(map);
+    EXPECT_EQ(11, test::Counter::created);
+    copy.clear();
+    EXPECT_EQ(5,
+              test::Counter::created + test::Counter::moved -
+                  test::Counter::destroyed);
+  }
+  EXPECT_EQ(test::Counter::created + test::Counter::moved,
+            test::Counter::destroyed);
+}
+
+TEST(InlineHashMap, Copy) {
+  InlineHashMap<int, int, 8> map = {{1, 10}, {2, 20}};
+  InlineHashMap<int, int, 8> copy = {{3, 30}};
+  copy = map;
+  EXPECT_EQ(2u, copy.size());
+  EXPECT_EQ(10, copy.at(1));
+  EXPECT_EQ(20, copy.at(2));
+  EXPECT_FALSE(copy.contains(3));
+}
+
+TEST(InlineHashMap, StringViewKeys) {
+  InlineHashMap<std::string_view, int, 4> map;
+  map["one"] = 1;
+  map["two"] = 2;
+  EXPECT_EQ(1, map.at("one"));
+  EXPECT_EQ(2, map.at("two"));
+  EXPECT_FALSE(map.contains("three"));
+}
+
+}  // namespace
+}  // namespace pw::containers
@@ -143,6 +143,20 @@ void pw_InlineVarLenEntryQueue_Push(pw_InlineVarLenEntryQueue_Handle queue,
   AppendEntryKnownToFit(queue, prefix, prefix_size, data, data_size_bytes);
 }
 
+bool pw_InlineVarLenEntryQueue_TryPush(pw_InlineVarLenEntryQueue_Handle queue,
+                                       const void* data,
+                                       const uint32_t data_size_bytes) {
+  uint8_t prefix[PW_VARINT_MAX_INT32_SIZE_BYTES];
+  uint32_t prefix_size = EncodePrefix(queue, prefix, data_size_bytes);
+
+  if (prefix_size + data_size_bytes > AvailableBytes(queue)) {
+    return false;
+  }
+
+  AppendEntryKnownToFit(queue, prefix, prefix_size, data, data_size_bytes);
+  return true;
+}
+
 void pw_InlineVarLenEntryQueue_PushOverwrite(
     pw_InlineVarLenEntryQueue_Handle queue,
     const void* data,
@@ -205,11 +219,12 @@ uint32_t pw_InlineVarLenEntryQueue_Entry_Copy(
     return 0u;
   }
 
-  memcpy(dest, entry->data_1, entry->size_1);
+  const uint32_t first = to_copy < entry->size_1 ? to_copy : entry->size_1;
+  memcpy(dest, entry->data_1, first);
 
-  const uint32_t remaining = to_copy - entry->size_1;
+  const uint32_t remaining = to_copy - first;
   if (remaining != 0u) {
-    memcpy((uint8_t*)dest + entry->size_1, entry->data_2, remaining);
+    memcpy((uint8_t*)dest + first, entry->data_2, remaining);
   }
 
   return to_copy;
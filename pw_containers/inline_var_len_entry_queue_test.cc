@@ -297,6 +297,28 @@ TEST(InlineVarLenEntryQueue, MaxSizeElement) {
 
 constexpr const char* kStrings[] = {"Haart", "Sandro", "", "Gelu", "Solmyr"};
 
+TEST(InlineVarLenEntryQueueClass, TryPush) {
+  // Holds 8 bytes of entries, including their 1-byte size prefixes.
+  pw::BasicInlineVarLenEntryQueue<char, 7> queue;
+
+  EXPECT_TRUE(queue.try_push(std::string_view("abc")));   // 4 bytes
+  EXPECT_FALSE(queue.try_push(std::string_view("defg")));  // 5 bytes
+  ASSERT_EQ(queue.size(), 1u);
+  EXPECT_EQ(queue.size_bytes(), 3u);
+
+  EXPECT_TRUE(queue.try_push(std::string_view("def")));  // 4 bytes
+  EXPECT_FALSE(queue.try_push(std::string_view()));      // 1 byte
+  ASSERT_EQ(queue.size(), 2u);
+
+  queue.pop();
+  EXPECT_TRUE(queue.try_push(std::string_view("ghi")));
+  ASSERT_EQ(queue.size(), 2u);
+
+  char value[4]{};
+  queue.front().copy(value, sizeof(value));
+  EXPECT_STREQ(value, "def");
+}
+
 TEST(InlineVarLenEntryQueueClass, Iterate) {
   pw::BasicInlineVarLenEntryQueue<char, 32> queue;
 
@@ -313,6 +335,21 @@ TEST(InlineVarLenEntryQueueClass, Iterate) {
   ASSERT_EQ(i, 5u);
 }
 
+TEST(InlineVarLenEntryQueueClass, CopyPartialEntry) {
+  pw::BasicInlineVarLenEntryQueue<char, 8> queue;
+
+  // Wrap the second entry around the end of the buffer.
+  queue.push(std::string_view("abcd"));
+  queue.pop();
+  queue.push(std::string_view("efghij"));
+
+  char value[4] = {'x', 'x', 'x', 'x'};
+  EXPECT_EQ(2u, queue.front().copy(value, 2));
+  EXPECT_EQ(std::string_view(value, 4), "efxx");
+
+  EXPECT_EQ(0u, queue.front().copy(value, 0));
+}
+
 TEST(InlineVarLenEntryQueueClass, IterateOverwrittenElements) {
   pw::BasicInlineVarLenEntryQueue<char, 6> queue;
 
@@ -0,0 +1,73 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/intrusive_dlist.h"
+
+#include "pw_assert/check.h"
+
+namespace pw::intrusive_dlist_impl {
+
+DList::Item& DList::Item::operator=(DList::Item&& other) {
+  // Remove `this` object from its current list.
+  unlist();
+
+  // If `other` is listed, put `this` in its place.
+  if (!other.unlisted()) {
+    next_ = other.next_;
+    prev_ = other.prev_;
+    next_->prev_ = this;
+    prev_->next_ = this;
+    other.next_ = &other;
+    other.prev_ = &other;
+  }
+  return *this;
+}
+
+void DList::Item::unlist() {
+  // Skip over this.
+  prev_->next_ = next_;
+  next_->prev_ = prev_;
+
+  // Retain the invariant that unlisted items are self-cycles.
+  next_ = this;
+  prev_ = this;
+}
+
+void DList::insert(Item* pos, Item& item) {
+  PW_CHECK(
+      item.unlisted(),
+      "Cannot add an item to a pw::IntrusiveDList that is already in a list");
+  item.next_ = pos;
+  item.prev_ = pos->prev_;
+  pos->prev_->next_ = &item;
+  pos->prev_ = &item;
+}
+
+void DList::clear() {
+  while (!empty()) {
+    erase(*begin());
+  }
+}
+
+size_t DList::size() const {
+  size_t total = 0;
+  const Item* item = head_.next_;
+  while (item != &head_) {
+    item = item->next_;
+    total++;
+  }
+  return total;
+}
+
+}  // namespace pw::intrusive_dlist_impl
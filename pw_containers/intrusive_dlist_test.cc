@@ -0,0 +1,280 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/intrusive_dlist.h"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+class TestItem : public IntrusiveDList<TestItem>::Item {
+ public:
+  constexpr TestItem() : number_(0) {}
+  constexpr TestItem(int number) : number_(number) {}
+
+  TestItem(TestItem&&) = default;
+  TestItem& operator=(TestItem&&) = default;
+
+  int GetNumber() const { return number_; }
+
+  // Add equality comparison to ensure comparisons are done by identity rather
+  // than equality for the remove function.
+  bool operator==(const TestItem& other) const {
+    return number_ == other.number_;
+  }
+
+ private:
+  int number_;
+};
+
+template <typename List>
+void ExpectItems(const List& list,
+                 std::initializer_list<const TestItem*> items) {
+  EXPECT_EQ(list.size(), items.size());
+  auto it = list.begin();
+  for (const TestItem* item : items) {
+    ASSERT_NE(it, list.end());
+    EXPECT_EQ(item, &(*it));
+    ++it;
+  }
+  EXPECT_EQ(it, list.end());
+
+  // Walk the list backwards too, to check the previous pointers.
+  auto rit = list.rbegin();
+  for (auto item = std::rbegin(items); item != std::rend(items); ++item) {
+    ASSERT_NE(rit, list.rend());
+    EXPECT_EQ(*item, &(*rit));
+    ++rit;
+  }
+  EXPECT_EQ(rit, list.rend());
+}
+
+TEST(IntrusiveDList, Construct_Empty) {
+  IntrusiveDList<TestItem> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.size(), 0u);
+  EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST(IntrusiveDList, Construct_InitializerList) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one, &two, &thr});
+  ExpectItems(list, {&one, &two, &thr});
+}
+
+TEST(IntrusiveDList, Construct_ObjectIterator) {
+  std::array<TestItem, 3> array{{{1}, {2}, {3}}};
+  IntrusiveDList<TestItem> list(array.begin(), array.end());
+  ExpectItems(list, {&array[0], &array[1], &array[2]});
+  list.clear();
+}
+
+TEST(IntrusiveDList, Assign_ReplacesItems) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one, &two});
+  list.assign({&thr});
+  ExpectItems(list, {&thr});
+  EXPECT_TRUE(one.unlisted());
+  EXPECT_TRUE(two.unlisted());
+}
+
+TEST(IntrusiveDList, PushFrontAndBack) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list;
+  list.push_back(two);
+  list.push_front(one);
+  list.push_back(thr);
+  ExpectItems(list, {&one, &two, &thr});
+  EXPECT_EQ(&list.front(), &one);
+  EXPECT_EQ(&list.back(), &thr);
+}
+
+TEST(IntrusiveDList, PopFrontAndBack) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one, &two, &thr});
+
+  list.pop_front();
+  ExpectItems(list, {&two, &thr});
+  EXPECT_TRUE(one.unlisted());
+
+  list.pop_back();
+  ExpectItems(list, {&two});
+  EXPECT_TRUE(thr.unlisted());
+
+  list.pop_back();
+  EXPECT_TRUE(list.empty());
+  EXPECT_TRUE(two.unlisted());
+}
+
+TEST(IntrusiveDList, Insert) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one, &thr});
+
+  auto it = list.insert(std::next(list.begin()), two);
+  EXPECT_EQ(&(*it), &two);
+  ExpectItems(list, {&one, &two, &thr});
+}
+
+TEST(IntrusiveDList, Insert_AtEnd) {
+  TestItem one(1);
+  TestItem two(2);
+  IntrusiveDList<TestItem> list({&one});
+  list.insert(list.end(), two);
+  ExpectItems(list, {&one, &two});
+}
+
+TEST(IntrusiveDList, Erase_ReturnsNext) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one, &two, &thr});
+
+  auto it = list.erase(std::next(list.begin()));
+  EXPECT_EQ(&(*it), &thr);
+  ExpectItems(list, {&one, &thr});
+  EXPECT_TRUE(two.unlisted());
+
+  it = list.erase(it);
+  EXPECT_EQ(it, list.end());
+  ExpectItems(list, {&one});
+}
+
+TEST(IntrusiveDList, Erase_WhileIterating) {
+  std::array<TestItem, 6> array{{{0}, {1}, {2}, {3}, {4}, {5}}};
+  IntrusiveDList<TestItem> list(array.begin(), array.end());
+
+  for (auto it = list.begin(); it != list.end();) {
+    if (it->GetNumber() % 2 == 0) {
+      it = list.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ExpectItems(list, {&array[1], &array[3], &array[5]});
+  list.clear();
+}
+
+TEST(IntrusiveDList, Remove_ByIdentity) {
+  TestItem one(55);
+  TestItem two(55);
+  TestItem thr(55);
+  IntrusiveDList<TestItem> list({&one, &two, &thr});
+
+  EXPECT_TRUE(list.remove(two));
+  ExpectItems(list, {&one, &thr});
+  EXPECT_FALSE(list.remove(two));
+
+  EXPECT_TRUE(list.remove(thr));
+  EXPECT_TRUE(list.remove(one));
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(IntrusiveDList, Unlist_RemovesFromList) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one, &two, &thr});
+
+  two.unlist();
+  ExpectItems(list, {&one, &thr});
+  two.unlist();  // Unlisting an unlisted item does nothing.
+  EXPECT_TRUE(two.unlisted());
+}
+
+TEST(IntrusiveDList, Destructor_RemovesItem) {
+  TestItem one(1);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one});
+  {
+    TestItem two(2);
+    list.push_back(two);
+    list.push_back(thr);
+    ExpectItems(list, {&one, &two, &thr});
+  }
+  ExpectItems(list, {&one, &thr});
+}
+
+TEST(IntrusiveDList, MoveItem_TakesPosition) {
+  TestItem one(1);
+  TestItem two(2);
+  TestItem thr(3);
+  IntrusiveDList<TestItem> list({&one, &two, &thr});
+
+  TestItem moved(std::move(two));
+  ExpectItems(list, {&one, &moved, &thr});
+  EXPECT_TRUE(two.unlisted());
+
+  TestItem unlisted(4);
+  moved = std::move(unlisted);
+  ExpectItems(list, {&one, &thr});
+  EXPECT_TRUE(moved.unlisted());
+}
+
+TEST(IntrusiveDList, ConstIteration) {
+  TestItem one(1);
+  TestItem two(2);
+  IntrusiveDList<TestItem> list({&one, &two});
+  const IntrusiveDList<TestItem>& const_list = list;
+
+  int sum = 0;
+  for (const TestItem& item : const_list) {
+    sum += item.GetNumber();
+  }
+  EXPECT_EQ(sum, 3);
+  EXPECT_EQ(&const_list.front(), &one);
+  EXPECT_EQ(&const_list.back(), &two);
+  EXPECT_EQ(list.cbegin(), const_list.begin());
+}
+
+class Base : public IntrusiveDList<Base>::Item {
+ public:
+  constexpr Base(int value) : value_(value) {}
+  int value() const { return value_; }
+
+ private:
+  int value_;
+};
+
+class Derived : public Base {
+ public:
+  constexpr Derived(int value) : Base(value) {}
+};
+
+TEST(IntrusiveDList, ListOfBaseClass) {
+  Derived one(1);
+  Base two(2);
+  IntrusiveDList<Base> list({&one, &two});
+  EXPECT_EQ(list.front().value(), 1);
+  EXPECT_EQ(list.back().value(), 2);
+}
+
+}  // namespace
+}  // namespace pw
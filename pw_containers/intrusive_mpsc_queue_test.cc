@@ -0,0 +1,95 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/intrusive_mpsc_queue.h"
+
+#include <array>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+class TestItem : public IntrusiveMpscQueue<TestItem>::Item {
+ public:
+  constexpr TestItem(int value = 0) : value_(value) {}
+
+  int value() const { return value_; }
+
+ private:
+  int value_;
+};
+
+TEST(IntrusiveMpscQueue, DefaultConstructed_IsEmpty) {
+  IntrusiveMpscQueue<TestItem> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(nullptr, queue.pop());
+}
+
+TEST(IntrusiveMpscQueue, PushSingle_PopSingle) {
+  IntrusiveMpscQueue<TestItem> queue;
+  TestItem item(1);
+  queue.push(item);
+  EXPECT_FALSE(queue.empty());
+  EXPECT_EQ(&item, queue.pop());
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(nullptr, queue.pop());
+}
+
+TEST(IntrusiveMpscQueue, PopsInPushOrder) {
+  IntrusiveMpscQueue<TestItem> queue;
+  std::array<TestItem, 5> items = {{{0}, {1}, {2}, {3}, {4}}};
+  for (TestItem& item : items) {
+    queue.push(item);
+  }
+  for (int i = 0; i < 5; ++i) {
+    TestItem* item = queue.pop();
+    ASSERT_NE(nullptr, item);
+    EXPECT_EQ(i, item->value());
+  }
+  EXPECT_EQ(nullptr, queue.pop());
+}
+
+TEST(IntrusiveMpscQueue, InterleavedPushAndPop) {
+  IntrusiveMpscQueue<TestItem> queue;
+  std::array<TestItem, 3> items = {{{0}, {1}, {2}}};
+  int next_pop = 0;
+  for (int round = 0; round < 10; ++round) {
+    queue.push(items[static_cast<size_t>(round % 3)]);
+    if (round % 2 == 1) {
+      TestItem* item = queue.pop();
+      ASSERT_NE(nullptr, item);
+      EXPECT_EQ(next_pop % 3, item->value());
+      ++next_pop;
+      item = queue.pop();
+      ASSERT_NE(nullptr, item);
+      EXPECT_EQ(next_pop % 3, item->value());
+      ++next_pop;
+    }
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(IntrusiveMpscQueue, ReuseItemAfterPop) {
+  IntrusiveMpscQueue<TestItem> queue;
+  TestItem item(7);
+  for (int i = 0; i < 3; ++i) {
+    queue.push(item);
+    EXPECT_EQ(&item, queue.pop());
+  }
+  EXPECT_EQ(nullptr, queue.pop());
+}
+
+}  // namespace
+}  // namespace pw
@@ -0,0 +1,472 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "pw_allocator/allocator.h"
+#include "pw_assert/assert.h"
+
+namespace pw {
+
+/// A double-ended queue whose storage is obtained from a
+/// `pw::allocator::Allocator`.
+///
+/// `DynamicDeque` is a ring buffer, like `pw::InlineDeque`, but instead of a
+/// fixed capacity it grows as elements are added. Capacity grows
+/// geometrically for amortized O(1) pushes at either end. Each time it grows,
+/// the deque first asks the allocator to `Resize` the existing allocation in
+/// place; then only the elements from the front of the deque to the old end
+/// of the buffer need to move, and only if the contents wrap around. Otherwise
+/// it allocates a new buffer and moves the elements over.
+///
+/// Operations that may allocate come in two forms. The `try_` forms (e.g.
+/// `try_push_back()`) return `false` if memory could not be allocated and
+/// leave the deque unchanged. The others (e.g. `push_back()`) crash instead,
+/// like `pw::InlineDeque` does when it is full.
+///
+/// Growing the deque invalidates all iterators, pointers, and references.
+template <typename T>
+class DynamicDeque {
+ private:
+  template <bool kIsConst>
+  class Iterator;
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  /// Creates an empty deque that allocates from `allocator`. No memory is
+  /// allocated until elements are added or `reserve()` is called.
+  constexpr explicit DynamicDeque(allocator::Allocator& allocator) noexcept
+      : allocator_(&allocator),
+        data_(nullptr),
+        head_(0),
+        size_(0),
+        capacity_(0) {}
+
+  DynamicDeque(const DynamicDeque&) = delete;
+  DynamicDeque& operator=(const DynamicDeque&) = delete;
+
+  /// Takes ownership of `other`'s allocation. `other` is left empty.
+  DynamicDeque(DynamicDeque&& other) noexcept
+      : allocator_(other.allocator_),
+        data_(std::exchange(other.data_, nullptr)),
+        head_(std::exchange(other.head_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+  DynamicDeque& operator=(DynamicDeque&& other) noexcept {
+    if (this != &other) {
+      clear();
+      Deallocate();
+      allocator_ = other.allocator_;
+      data_ = std::exchange(other.data_, nullptr);
+      head_ = std::exchange(other.head_, 0);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  ~DynamicDeque() {
+    clear();
+    Deallocate();
+  }
+
+  allocator::Allocator& get_allocator() const { return *allocator_; }
+
+  // Access
+
+  reference at(size_type index) {
+    PW_ASSERT(index < size());
+    return data_[Physical(index)];
+  }
+  const_reference at(size_type index) const {
+    PW_ASSERT(index < size());
+    return data_[Physical(index)];
+  }
+
+  reference operator[](size_type index) {
+    PW_DASSERT(index < size());
+    return data_[Physical(index)];
+  }
+  const_reference operator[](size_type index) const {
+    PW_DASSERT(index < size());
+    return data_[Physical(index)];
+  }
+
+  reference front() {
+    PW_DASSERT(!empty());
+    return data_[head_];
+  }
+  const_reference front() const {
+    PW_DASSERT(!empty());
+    return data_[head_];
+  }
+
+  reference back() {
+    PW_DASSERT(!empty());
+    return data_[Physical(size_ - 1)];
+  }
+  const_reference back() const {
+    PW_DASSERT(!empty());
+    return data_[Physical(size_ - 1)];
+  }
+
+  // Iterate
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size_); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cend() const noexcept { return const_iterator(this, size_); }
+
+  // Capacity
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0u; }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return capacity_; }
+  static constexpr size_type max_size() noexcept {
+    return std::numeric_limits<size_type>::max() / 2 / sizeof(T);
+  }
+
+  /// Ensures there is room for at least `new_capacity` elements. Crashes if
+  /// the memory cannot be allocated.
+  void reserve(size_type new_capacity) {
+    PW_ASSERT(try_reserve(new_capacity));
+  }
+
+  /// Ensures there is room for at least `new_capacity` elements.
+  ///
+  /// @returns `false` if the memory could not be allocated, in which case the
+  /// deque is unchanged.
+  [[nodiscard]] bool try_reserve(size_type new_capacity) {
+    return new_capacity <= capacity_ || Reallocate(new_capacity);
+  }
+
+  /// Releases unused capacity. The allocation is resized in place if the
+  /// elements are at its start and the allocator supports it; otherwise, the
+  /// elements are moved to a new, exact size allocation if one is available.
+  void shrink_to_fit() {
+    if (size_ == capacity_) {
+      return;
+    }
+    if (size_ == 0u) {
+      Deallocate();
+    } else if (head_ == 0u &&
+               allocator_->Resize(data_, layout(capacity_), bytes(size_))) {
+      capacity_ = size_;
+    } else {
+      MoveTo(size_);
+    }
+  }
+
+  // Modify
+
+  void clear() noexcept {
+    for (size_type i = 0; i < size_; ++i) {
+      std::destroy_at(&data_[Physical(i)]);
+    }
+    head_ = 0;
+    size_ = 0;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void push_front(const T& value) { emplace_front(value); }
+
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    PW_ASSERT(try_emplace_back(std::forward<Args>(args)...));
+    return back();
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    PW_ASSERT(try_emplace_front(std::forward<Args>(args)...));
+    return front();
+  }
+
+  [[nodiscard]] bool try_push_back(const T& value) {
+    return try_emplace_back(value);
+  }
+
+  [[nodiscard]] bool try_push_back(T&& value) {
+    return try_emplace_back(std::move(value));
+  }
+
+  [[nodiscard]] bool try_push_front(const T& value) {
+    return try_emplace_front(value);
+  }
+
+  [[nodiscard]] bool try_push_front(T&& value) {
+    return try_emplace_front(std::move(value));
+  }
+
+  /// Constructs an element at the back of the deque.
+  ///
+  /// @returns `false` if the deque needed to grow and the memory could not be
+  /// allocated, in which case the deque is unchanged.
+  template <typename... Args>
+  [[nodiscard]] bool try_emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      // Growing may move the elements, which the arguments may refer to.
+      T value(std::forward<Args>(args)...);
+      if (!Grow()) {
+        return false;
+      }
+      new (&data_[Physical(size_)]) T(std::move(value));
+    } else {
+      new (&data_[Physical(size_)]) T(std::forward<Args>(args)...);
+    }
+    size_ += 1;
+    return true;
+  }
+
+  /// Constructs an element at the front of the deque.
+  ///
+  /// @returns `false` if the deque needed to grow and the memory could not be
+  /// allocated, in which case the deque is unchanged.
+  template <typename... Args>
+  [[nodiscard]] bool try_emplace_front(Args&&... args) {
+    if (size_ == capacity_) {
+      // Growing may move the elements, which the arguments may refer to.
+      T value(std::forward<Args>(args)...);
+      if (!Grow()) {
+        return false;
+      }
+      new (&data_[PreviousHead()]) T(std::move(value));
+    } else {
+      new (&data_[PreviousHead()]) T(std::forward<Args>(args)...);
+    }
+    head_ = PreviousHead();
+    size_ += 1;
+    return true;
+  }
+
+  void pop_back() {
+    PW_DASSERT(!empty());
+    size_ -= 1;
+    std::destroy_at(&data_[Physical(size_)]);
+  }
+
+  void pop_front() {
+    PW_DASSERT(!empty());
+    std::destroy_at(&data_[head_]);
+    head_ = Physical(1);
+    size_ -= 1;
+  }
+
+ private:
+  static constexpr size_type kMinCapacity = 4;
+
+  static constexpr size_t bytes(size_type count) { return count * sizeof(T); }
+
+  static constexpr allocator::Layout layout(size_type count) {
+    return allocator::Layout(bytes(count), alignof(T));
+  }
+
+  // Maps an index from the front of the deque to an index into data_.
+  size_type Physical(size_type index) const {
+    const size_type physical = head_ + index;
+    return physical < capacity_ ? physical : physical - capacity_;
+  }
+
+  size_type PreviousHead() const {
+    return head_ == 0u ? capacity_ - 1 : head_ - 1;
+  }
+
+  // Grows the capacity geometrically, or by one element if memory is tight.
+  bool Grow() {
+    if (size_ == max_size()) {
+      return false;
+    }
+    const size_type new_capacity = capacity_ < max_size() / 2
+                                       ? std::max(capacity_ * 2, kMinCapacity)
+                                       : max_size();
+    return Reallocate(new_capacity) ||
+           (new_capacity > size_ + 1 && Reallocate(size_ + 1));
+  }
+
+  // Changes the capacity, resizing the allocation in place if possible.
+  bool Reallocate(size_type new_capacity) {
+    if (new_capacity > max_size()) {
+      return false;
+    }
+    const size_type old_capacity = capacity_;
+    if (!allocator_->Resize(data_, layout(capacity_), bytes(new_capacity))) {
+      return MoveTo(new_capacity);
+    }
+    capacity_ = new_capacity;
+
+    // If the contents wrapped around the old end of the buffer, move the
+    // elements from the front of the deque to the old end so that they end at
+    // the new end instead. Go backwards, since the ranges may overlap.
+    if (head_ + size_ > old_capacity) {
+      const size_type count = old_capacity - head_;
+      const size_type new_head = new_capacity - count;
+      for (size_type i = count; i > 0; --i) {
+        T& source = data_[head_ + i - 1];
+        new (&data_[new_head + i - 1]) T(std::move(source));
+        std::destroy_at(&source);
+      }
+      head_ = new_head;
+    }
+    return true;
+  }
+
+  // Moves the elements to the start of a new allocation.
+  bool MoveTo(size_type new_capacity) {
+    T* new_data = static_cast<T*>(allocator_->Allocate(layout(new_capacity)));
+    if (new_data == nullptr) {
+      return false;
+    }
+    for (size_type i = 0; i < size_; ++i) {
+      T& source = data_[Physical(i)];
+      new (&new_data[i]) T(std::move(source));
+      std::destroy_at(&source);
+    }
+    Deallocate();
+    data_ = new_data;
+    head_ = 0;
+    capacity_ = new_capacity;
+    return true;
+  }
+
+  void Deallocate() {
+    allocator_->Deallocate(data_, layout(capacity_));
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  allocator::Allocator* allocator_;
+  T* data_;
+  size_type head_;
+  size_type size_;
+  size_type capacity_;
+};
+
+template <typename T>
+template <bool kIsConst>
+class DynamicDeque<T>::Iterator {
+ public:
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<kIsConst, const T*, T*>;
+  using reference = std::conditional_t<kIsConst, const T&, T&>;
+  using iterator_category = std::random_access_iterator_tag;
+
+  constexpr Iterator() = default;
+
+  // Allow converting an iterator to a const_iterator.
+  template <bool kOtherConst,
+            typename = std::enable_if_t<kIsConst && !kOtherConst>>
+  constexpr Iterator(const Iterator<kOtherConst>& other)
+      : deque_(other.deque_), index_(other.index_) {}
+
+  reference operator*() const { return (*deque_)[index_]; }
+  pointer operator->() const { return &(*deque_)[index_]; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  Iterator& operator++() {
+    index_ += 1;
+    return *this;
+  }
+  Iterator operator++(int) {
+    Iterator original = *this;
+    operator++();
+    return original;
+  }
+
+  Iterator& operator--() {
+    index_ -= 1;
+    return *this;
+  }
+  Iterator operator--(int) {
+    Iterator original = *this;
+    operator--();
+    return original;
+  }
+
+  Iterator& operator+=(difference_type n) {
+    index_ = static_cast<size_type>(static_cast<difference_type>(index_) + n);
+    return *this;
+  }
+  Iterator& operator-=(difference_type n) { return *this += -n; }
+
+  friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+  friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+  friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+
+  friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) {
+    return static_cast<difference_type>(lhs.index_) -
+           static_cast<difference_type>(rhs.index_);
+  }
+
+  friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+    return lhs.index_ == rhs.index_;
+  }
+  friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+    return lhs.index_ != rhs.index_;
+  }
+  friend bool operator<(const Iterator& lhs, const Iterator& rhs) {
+    return lhs.index_ < rhs.index_;
+  }
+  friend bool operator>(const Iterator& lhs, const Iterator& rhs) {
+    return rhs < lhs;
+  }
+  friend bool operator<=(const Iterator& lhs, const Iterator& rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const Iterator& lhs, const Iterator& rhs) {
+    return !(lhs < rhs);
+  }
+
+ private:
+  friend class DynamicDeque;
+  template <bool>
+  friend class Iterator;
+
+  using DequePointer =
+      std::conditional_t<kIsConst, const DynamicDeque*, DynamicDeque*>;
+
+  constexpr Iterator(DequePointer deque, size_type index)
+      : deque_(deque), index_(index) {}
+
+  DequePointer deque_ = nullptr;
+  size_type index_ = 0;
+};
+
+}  // namespace pw
@@ -0,0 +1,360 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "pw_allocator/allocator.h"
+#include "pw_assert/assert.h"
+
+namespace pw {
+
+/// A vector whose storage is obtained from a `pw::allocator::Allocator`.
+///
+/// Unlike `pw::Vector`, `DynamicVector` has no fixed capacity: it starts empty
+/// and grows as elements are added, so memory is only committed for what is
+/// actually used. Capacity grows geometrically for amortized O(1) appends.
+/// Each time it grows, the vector first asks the allocator to `Resize` the
+/// existing allocation in place, which avoids moving any elements. Only if
+/// that fails does it allocate a new buffer and move the elements over.
+///
+/// Operations that may allocate come in two forms. The `try_` forms (e.g.
+/// `try_push_back()`) return `false` if memory could not be allocated and
+/// leave the vector unchanged. The others (e.g. `push_back()`) crash instead,
+/// like `pw::Vector` does when it is full.
+///
+/// Growing the vector invalidates all iterators, pointers, and references.
+template <typename T>
+class DynamicVector {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /// Creates an empty vector that allocates from `allocator`. No memory is
+  /// allocated until elements are added or `reserve()` is called.
+  constexpr explicit DynamicVector(allocator::Allocator& allocator) noexcept
+      : allocator_(&allocator), data_(nullptr), size_(0), capacity_(0) {}
+
+  DynamicVector(const DynamicVector&) = delete;
+  DynamicVector& operator=(const DynamicVector&) = delete;
+
+  /// Takes ownership of `other`'s allocation. `other` is left empty.
+  DynamicVector(DynamicVector&& other) noexcept
+      : allocator_(other.allocator_),
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+  DynamicVector& operator=(DynamicVector&& other) noexcept {
+    if (this != &other) {
+      clear();
+      Deallocate();
+      allocator_ = other.allocator_;
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  ~DynamicVector() {
+    clear();
+    Deallocate();
+  }
+
+  allocator::Allocator& get_allocator() const { return *allocator_; }
+
+  // Access
+
+  reference at(size_type index) {
+    PW_ASSERT(index < size());
+    return data_[index];
+  }
+  const_reference at(size_type index) const {
+    PW_ASSERT(index < size());
+    return data_[index];
+  }
+
+  reference operator[](size_type index) {
+    PW_DASSERT(index < size());
+    return data_[index];
+  }
+  const_reference operator[](size_type index) const {
+    PW_DASSERT(index < size());
+    return data_[index];
+  }
+
+  reference front() { return data_[0]; }
+  const_reference front() const { return data_[0]; }
+
+  reference back() { return data_[size_ - 1]; }
+  const_reference back() const { return data_[size_ - 1]; }
+
+  T* data() noexcept { return data_; }
+  const T* data() const noexcept { return data_; }
+
+  // Iterate
+
+  iterator begin() noexcept { return data_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator cbegin() const noexcept { return data_; }
+
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+  const_iterator cend() const noexcept { return data_ + size_; }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const { return crbegin(); }
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(cend());
+  }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const { return crend(); }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(cbegin());
+  }
+
+  // Capacity
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0u; }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return capacity_; }
+  static constexpr size_type max_size() noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+
+  /// Ensures there is room for at least `new_capacity` elements. Crashes if
+  /// the memory cannot be allocated.
+  void reserve(size_type new_capacity) {
+    PW_ASSERT(try_reserve(new_capacity));
+  }
+
+  /// Ensures there is room for at least `new_capacity` elements.
+  ///
+  /// @returns `false` if the memory could not be allocated, in which case the
+  /// vector is unchanged.
+  [[nodiscard]] bool try_reserve(size_type new_capacity) {
+    return new_capacity <= capacity_ || Reallocate(new_capacity, [](T*) {});
+  }
+
+  /// Releases unused capacity. The allocation is resized in place if the
+  /// allocator supports it; otherwise, the elements are moved to a new, exact
+  /// size allocation if one is available.
+  void shrink_to_fit() {
+    if (size_ == capacity_) {
+      return;
+    }
+    if (size_ == 0u) {
+      Deallocate();
+    } else if (allocator_->Resize(data_, layout(capacity_), bytes(size_))) {
+      capacity_ = size_;
+    } else {
+      MoveTo(size_, [](T*) {});
+    }
+  }
+
+  // Modify
+
+  void clear() noexcept {
+    std::destroy(begin(), end());
+    size_ = 0;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    PW_ASSERT(try_emplace_back(std::forward<Args>(args)...));
+    return back();
+  }
+
+  [[nodiscard]] bool try_push_back(const T& value) {
+    return try_emplace_back(value);
+  }
+
+  [[nodiscard]] bool try_push_back(T&& value) {
+    return try_emplace_back(std::move(value));
+  }
+
+  /// Constructs an element at the end of the vector.
+  ///
+  /// @returns `false` if the vector needed to grow and the memory could not
+  /// be allocated, in which case the vector is unchanged.
+  template <typename... Args>
+  [[nodiscard]] bool try_emplace_back(Args&&... args) {
+    auto construct = [&](T* slot) {
+      new (slot) T(std::forward<Args>(args)...);
+    };
+    if (size_ < capacity_) {
+      construct(&data_[size_]);
+    } else if (!Grow(construct)) {
+      return false;
+    }
+    size_ += 1;
+    return true;
+  }
+
+  void pop_back() {
+    PW_DASSERT(!empty());
+    size_ -= 1;
+    std::destroy_at(&data_[size_]);
+  }
+
+  iterator insert(const_iterator position, const T& value) {
+    return emplace(position, value);
+  }
+
+  iterator insert(const_iterator position, T&& value) {
+    return emplace(position, std::move(value));
+  }
+
+  /// Constructs an element before `position`, shifting the others back.
+  /// Crashes if the memory cannot be allocated.
+  template <typename... Args>
+  iterator emplace(const_iterator position, Args&&... args) {
+    const size_type index = static_cast<size_type>(position - cbegin());
+    PW_DASSERT(index <= size_);
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return end() - 1;
+    }
+    // Construct the value first, since the arguments may refer to elements.
+    T value(std::forward<Args>(args)...);
+    reserve(size_ + 1);
+    new (&data_[size_]) T(std::move(back()));
+    size_ += 1;
+    std::move_backward(begin() + index, end() - 2, end() - 1);
+    data_[index] = std::move(value);
+    return begin() + index;
+  }
+
+  iterator erase(const_iterator position) {
+    return erase(position, position + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator destination = begin() + (first - cbegin());
+    iterator source = begin() + (last - cbegin());
+    iterator new_end = std::move(source, end(), destination);
+    std::destroy(new_end, end());
+    size_ = static_cast<size_type>(new_end - begin());
+    return destination;
+  }
+
+  /// Resizes the vector to `count` elements, value-initializing any new ones.
+  /// Crashes if the memory cannot be allocated.
+  void resize(size_type count) { resize(count, T()); }
+
+  void resize(size_type count, const T& value) {
+    if (count <= size_) {
+      std::destroy(begin() + count, end());
+    } else if (count <= capacity_) {
+      std::uninitialized_fill(end(), begin() + count, value);
+    } else {
+      const T copy(value);  // value may refer to an element.
+      reserve(count);
+      std::uninitialized_fill(end(), begin() + count, copy);
+    }
+    size_ = count;
+  }
+
+ private:
+  static constexpr size_type kMinCapacity = 4;
+
+  static constexpr size_t bytes(size_type count) { return count * sizeof(T); }
+
+  static constexpr allocator::Layout layout(size_type count) {
+    return allocator::Layout(bytes(count), alignof(T));
+  }
+
+  // Grows the capacity geometrically, or by one element if memory is tight,
+  // and calls construct with the slot for a new element at the end.
+  template <typename Construct>
+  bool Grow(const Construct& construct) {
+    if (size_ == max_size()) {
+      return false;
+    }
+    const size_type new_capacity = capacity_ < max_size() / 2
+                                       ? std::max(capacity_ * 2, kMinCapacity)
+                                       : max_size();
+    return Reallocate(new_capacity, construct) ||
+           (new_capacity > size_ + 1 && Reallocate(size_ + 1, construct));
+  }
+
+  // Changes the capacity, resizing the allocation in place if possible, and
+  // calls construct with the slot for a new element at the end.
+  template <typename Construct>
+  bool Reallocate(size_type new_capacity, const Construct& construct) {
+    if (new_capacity > max_size()) {
+      return false;
+    }
+    if (allocator_->Resize(data_, layout(capacity_), bytes(new_capacity))) {
+      capacity_ = new_capacity;
+      construct(&data_[size_]);
+      return true;
+    }
+    return MoveTo(new_capacity, construct);
+  }
+
+  // Moves the elements to a new allocation with the given capacity. The new
+  // element is constructed first, since its arguments may refer to elements.
+  template <typename Construct>
+  bool MoveTo(size_type new_capacity, const Construct& construct) {
+    T* new_data = static_cast<T*>(allocator_->Allocate(layout(new_capacity)));
+    if (new_data == nullptr) {
+      return false;
+    }
+    construct(&new_data[size_]);
+    for (size_type i = 0; i < size_; ++i) {
+      new (&new_data[i]) T(std::move(data_[i]));
+      std::destroy_at(&data_[i]);
+    }
+    Deallocate();
+    data_ = new_data;
+    capacity_ = new_capacity;
+    return true;
+  }
+
+  void Deallocate() {
+    allocator_->Deallocate(data_, layout(capacity_));
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  allocator::Allocator* allocator_;
+  T* data_;
+  size_type size_;
+  size_type capacity_;
+};
+
+}  // namespace pw
@@ -0,0 +1,447 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_containers/flat_map.h"
+#include "pw_containers/internal/raw_storage.h"
+
+namespace pw::containers {
+namespace internal {
+
+// The smallest unsigned type that can hold values up to kMax.
+template <size_t kMax>
+using SmallestUnsigned = std::conditional_t<
+    (kMax <= UINT8_MAX),
+    uint8_t,
+    std::conditional_t<(kMax <= UINT16_MAX), uint16_t, size_t>>;
+
+}  // namespace internal
+
+/// A fixed-capacity, open-addressed hash map that stores its entries inline.
+///
+/// `InlineHashMap` never allocates. Entries are placed with linear probing and
+/// Robin Hood ordering: each slot records how far its entry is from its home
+/// slot, and entries are kept sorted by home slot within each run. Lookups
+/// stop as soon as they reach an entry closer to home than the key would be,
+/// so misses are as cheap as hits. Erasing shifts the rest of the run back by
+/// one slot instead of leaving a tombstone, so the table does not degrade
+/// after many insertions and removals.
+///
+/// Up to `kCapacity` entries may be stored. Probe sequences grow quickly as
+/// the table fills, so size `kCapacity` with some headroom (e.g. 25%) over the
+/// expected number of entries. Inserting into a full map crashes, like
+/// `pw::Vector::push_back()`; check `full()` first if that is possible.
+///
+/// Like `std::unordered_map`, the iteration order is unspecified. Inserting
+/// may move entries, which invalidates all iterators, pointers, and references.
+/// Erasing invalidates iterators, pointers, and references to entries after the
+/// erased entry; `erase(iterator)` returns an iterator that continues the
+/// iteration without skipping or repeating entries.
+///
+/// @tparam Key Key type. Must be copy constructible, since entries are moved
+///     between slots and `value_type`'s key is `const`.
+/// @tparam Value Mapped type. Must be move constructible.
+/// @tparam kCapacity Maximum number of entries.
+/// @tparam Hash Hash function for `Key`.
+/// @tparam KeyEqual Equality comparison for `Key`.
+template <typename Key,
+          typename Value,
+          size_t kCapacity,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class InlineHashMap {
+ private:
+  template <bool kIsConst>
+  class Iterator;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = Pair<const key_type, mapped_type>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  static_assert(kCapacity > 0u, "InlineHashMap capacity must be nonzero");
+  static_assert(std::is_copy_constructible_v<key_type>,
+                "InlineHashMap keys must be copy constructible");
+  static_assert(std::is_move_constructible_v<mapped_type>,
+                "InlineHashMap values must be move constructible");
+
+  constexpr InlineHashMap() noexcept : distances_{}, size_(0) {}
+
+  InlineHashMap(std::initializer_list<value_type> items) : InlineHashMap() {
+    for (const value_type& item : items) {
+      insert(item);
+    }
+  }
+
+  InlineHashMap(const InlineHashMap& other) : InlineHashMap() {
+    CopyFrom(other);
+  }
+
+  InlineHashMap& operator=(const InlineHashMap& other) {
+    if (this != &other) {
+      clear();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+
+  ~InlineHashMap() { clear(); }
+
+  // Iterators
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, kCapacity); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cend() const noexcept {
+    return const_iterator(this, kCapacity);
+  }
+
+  // Capacity
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0u; }
+  bool full() const noexcept { return size_ == kCapacity; }
+  size_type size() const noexcept { return size_; }
+  static constexpr size_type max_size() noexcept { return kCapacity; }
+
+  // Lookup
+
+  /// Returns the value for `key`, which must be present.
+  mapped_type& at(const key_type& key) {
+    const size_t slot = FindSlot(key);
+    PW_ASSERT(slot != kCapacity);
+    return entry(slot).second;
+  }
+
+  const mapped_type& at(const key_type& key) const {
+    const size_t slot = FindSlot(key);
+    PW_ASSERT(slot != kCapacity);
+    return entry(slot).second;
+  }
+
+  /// Returns the value for `key`, inserting a value-initialized one if `key` is
+  /// not present.
+  mapped_type& operator[](const key_type& key) {
+    return try_emplace(key).first->second;
+  }
+
+  iterator find(const key_type& key) { return iterator(this, FindSlot(key)); }
+
+  const_iterator find(const key_type& key) const {
+    return const_iterator(this, FindSlot(key));
+  }
+
+  size_type count(const key_type& key) const {
+    return contains(key) ? 1u : 0u;
+  }
+
+  bool contains(const key_type& key) const {
+    return FindSlot(key) != kCapacity;
+  }
+
+  // Modifiers
+
+  void clear() noexcept {
+    for (size_t slot = 0; slot < kCapacity; ++slot) {
+      if (distances_[slot] != 0u) {
+        entry(slot).~value_type();
+        distances_[slot] = 0;
+      }
+    }
+    size_ = 0;
+  }
+
+  /// Inserts a copy of `item` if its key is not already present.
+  ///
+  /// @returns An iterator to the entry with the key, and `true` if it was
+  /// inserted.
+  std::pair<iterator, bool> insert(const value_type& item) {
+    return try_emplace(item.first, item.second);
+  }
+
+  /// Inserts an entry with `key` and a value constructed from `args` if `key`
+  /// is not present. If it is, `args` are not used.
+  ///
+  /// @returns An iterator to the entry with the key, and `true` if it was
+  /// inserted.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return TryEmplace(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+
+  /// Inserts an entry, or assigns `value` to the existing entry for `key`.
+  ///
+  /// @returns An iterator to the entry with the key, and `true` if it was
+  /// inserted.
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  /// Removes the entry at `position`.
+  ///
+  /// @returns An iterator to the entry that followed the erased one.
+  iterator erase(const_iterator position) {
+    // Iteration stops at limit_. Slots from there to the end hold entries that
+    // were already visited: at first none, but erasing can shift entries from
+    // the first slot to the last. When the entry at the limit (or the first
+    // slot, for the initial limit) shifts back, the limit must move with it.
+    size_t limit = position.limit_;
+    if (EraseSlot(position.slot_, limit % kCapacity)) {
+      limit -= 1;
+    }
+    return iterator(this, position.slot_, limit);
+  }
+
+  iterator erase(iterator position) {
+    return erase(const_iterator(position));
+  }
+
+  /// Removes the entry for `key`, if present.
+  ///
+  /// @returns The number of entries removed (0 or 1).
+  size_type erase(const key_type& key) {
+    const size_t slot = FindSlot(key);
+    if (slot == kCapacity) {
+      return 0;
+    }
+    EraseSlot(slot, kCapacity);
+    return 1;
+  }
+
+ private:
+  // Each slot stores 0 if empty, or 1 + its entry's distance from its home
+  // slot. Distances never reach kCapacity, so kCapacity fits in the type.
+  using Distance = internal::SmallestUnsigned<kCapacity>;
+
+  static constexpr size_t NextSlot(size_t slot) {
+    return slot + 1 == kCapacity ? 0 : slot + 1;
+  }
+
+  static constexpr size_t PreviousSlot(size_t slot) {
+    return slot == 0 ? kCapacity - 1 : slot - 1;
+  }
+
+  static size_t HomeSlot(const key_type& key) {
+    // std::hash is the identity for integers in common implementations, and
+    // pointers have zeros in their low bits, so mix the hash before reducing.
+    constexpr unsigned kHalfBits = sizeof(size_t) * 8 / 2;
+    constexpr size_t kMultiplier = sizeof(size_t) == 8
+                                       ? static_cast<size_t>(0x9e3779b97f4a7c15u)
+                                       : static_cast<size_t>(0x9e3779b9u);
+    size_t hash = hasher()(key);
+    hash ^= hash >> kHalfBits;
+    hash *= kMultiplier;
+    hash ^= hash >> kHalfBits;
+    return hash % kCapacity;
+  }
+
+  value_type& entry(size_t slot) { return slots_.data()[slot]; }
+  const value_type& entry(size_t slot) const { return slots_.data()[slot]; }
+
+  // Returns the first occupied slot in [slot, limit), or kCapacity if none.
+  size_t NextOccupied(size_t slot, size_t limit) const {
+    for (; slot < limit; ++slot) {
+      if (distances_[slot] != 0u) {
+        return slot;
+      }
+    }
+    return kCapacity;
+  }
+
+  // Returns the slot that holds key, or kCapacity if it is not present.
+  size_t FindSlot(const key_type& key) const {
+    size_t slot = HomeSlot(key);
+    for (size_t distance = 1; distance <= distances_[slot]; ++distance) {
+      if (distances_[slot] == distance && key_equal()(entry(slot).first, key)) {
+        return slot;
+      }
+      slot = NextSlot(slot);
+    }
+    return kCapacity;
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(K&& key, Args&&... args) {
+    size_t slot = HomeSlot(key);
+    size_t distance = 1;
+    for (; distance <= distances_[slot]; ++distance) {
+      if (distances_[slot] == distance && key_equal()(entry(slot).first, key)) {
+        return {iterator(this, slot), false};
+      }
+      slot = NextSlot(slot);
+    }
+
+    PW_ASSERT(!full());
+
+    // The slot is empty or holds an entry that is closer to its home. Shift
+    // the rest of the run forward to make room, keeping it ordered.
+    size_t empty = slot;
+    while (distances_[empty] != 0u) {
+      empty = NextSlot(empty);
+    }
+    while (empty != slot) {
+      const size_t previous = PreviousSlot(empty);
+      Relocate(previous, empty);
+      distances_[empty] = static_cast<Distance>(distances_[previous] + 1u);
+      empty = previous;
+    }
+
+    new (&entry(slot)) value_type{key_type(std::forward<K>(key)),
+                                  mapped_type(std::forward<Args>(args)...)};
+    distances_[slot] = static_cast<Distance>(distance);
+    size_ += 1;
+    return {iterator(this, slot), true};
+  }
+
+  // Removes the entry in slot and shifts the rest of its run back by one.
+  // Returns true if the entry in the watched slot was shifted.
+  bool EraseSlot(size_t slot, size_t watched) {
+    entry(slot).~value_type();
+
+    bool watched_moved = false;
+    size_t next = NextSlot(slot);
+    for (size_t moved = 1; moved < size_ && distances_[next] > 1u; ++moved) {
+      Relocate(next, slot);
+      distances_[slot] = static_cast<Distance>(distances_[next] - 1u);
+      watched_moved = watched_moved || next == watched;
+      slot = next;
+      next = NextSlot(next);
+    }
+    distances_[slot] = 0;
+    size_ -= 1;
+    return watched_moved;
+  }
+
+  // Moves the entry in from to the empty slot to.
+  void Relocate(size_t from, size_t to) {
+    value_type& source = entry(from);
+    new (&entry(to)) value_type{source.first, std::move(source.second)};
+    source.~value_type();
+  }
+
+  // Copies other's entries slot for slot into this empty map, which avoids
+  // rehashing them.
+  void CopyFrom(const InlineHashMap& other) {
+    for (size_t slot = 0; slot < kCapacity; ++slot) {
+      if (other.distances_[slot] != 0u) {
+        new (&entry(slot)) value_type(other.entry(slot));
+        distances_[slot] = other.distances_[slot];
+      }
+    }
+    size_ = other.size_;
+  }
+
+  internal::RawStorage<value_type, kCapacity> slots_;
+  std::array<Distance, kCapacity> distances_;
+  size_t size_;
+};
+
+template <typename Key,
+          typename Value,
+          size_t kCapacity,
+          typename Hash,
+          typename KeyEqual>
+template <bool kIsConst>
+class InlineHashMap<Key, Value, kCapacity, Hash, KeyEqual>::Iterator {
+ public:
+  using value_type = InlineHashMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<kIsConst, const value_type*, value_type*>;
+  using reference =
+      std::conditional_t<kIsConst, const value_type&, value_type&>;
+  using iterator_category = std::forward_iterator_tag;
+
+  constexpr Iterator() = default;
+
+  // Allow converting an iterator to a const_iterator.
+  template <bool kOtherConst,
+            typename = std::enable_if_t<kIsConst && !kOtherConst>>
+  constexpr Iterator(const Iterator<kOtherConst>& other)
+      : map_(other.map_), slot_(other.slot_), limit_(other.limit_) {}
+
+  reference operator*() const { return map_->entry(slot_); }
+  pointer operator->() const { return &map_->entry(slot_); }
+
+  Iterator& operator++() {
+    slot_ = map_->NextOccupied(slot_ + 1, limit_);
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator original = *this;
+    operator++();
+    return original;
+  }
+
+  template <bool kOtherConst>
+  bool operator==(const Iterator<kOtherConst>& other) const {
+    return slot_ == other.slot_;
+  }
+
+  template <bool kOtherConst>
+  bool operator!=(const Iterator<kOtherConst>& other) const {
+    return slot_ != other.slot_;
+  }
+
+ private:
+  friend class InlineHashMap;
+  template <bool>
+  friend class Iterator;
+
+  using MapPointer =
+      std::conditional_t<kIsConst, const InlineHashMap*, InlineHashMap*>;
+
+  // Points to the first occupied slot at or after slot and before limit.
+  Iterator(MapPointer map, size_t slot, size_t limit = kCapacity)
+      : map_(map), slot_(map->NextOccupied(slot, limit)), limit_(limit) {}
+
+  MapPointer map_ = nullptr;
+  size_t slot_ = kCapacity;
+  size_t limit_ = kCapacity;
+};
+
+}  // namespace pw::containers
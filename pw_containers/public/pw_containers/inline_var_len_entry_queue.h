@@ -97,6 +97,14 @@ void pw_InlineVarLenEntryQueue_Push(pw_InlineVarLenEntryQueue_Handle queue,
                                     const void* data,
                                     uint32_t data_size_bytes);
 
+/// Appends an entry to the end of the queue if there is room for it.
+///
+/// @returns `true` if the entry was added, or `false` if there is not enough
+/// remaining space for it, in which case the queue is unchanged.
+bool pw_InlineVarLenEntryQueue_TryPush(pw_InlineVarLenEntryQueue_Handle queue,
+                                       const void* data,
+                                       uint32_t data_size_bytes);
+
 /// Appends an entry to the end of the queue, removing entries with `Pop`
 /// as necessary to make room.
 ///
@@ -427,6 +435,12 @@ class BasicInlineVarLenEntryQueue<T, containers::internal::kGenericSized> {
         array_, value.data(), static_cast<size_type>(value.size()));
   }
 
+  /// @copydoc pw_InlineVarLenEntryQueue_TryPush
+  [[nodiscard]] bool try_push(span<const T> value) {
+    return pw_InlineVarLenEntryQueue_TryPush(
+        array_, value.data(), static_cast<size_type>(value.size()));
+  }
+
   /// @copydoc pw_InlineVarLenEntryQueue_PushOverwrite
   void push_overwrite(span<const T> value) {
     pw_InlineVarLenEntryQueue_PushOverwrite(
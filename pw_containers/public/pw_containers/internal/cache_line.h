@@ -0,0 +1,23 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+// The alignment of the producer's and consumer's state in the lock-free
+// single-producer single-consumer queues. The producer and consumer write their
+// indices independently, so by default each is padded to a typical cache line
+// size to avoid false sharing. Targets without data caches may set this to 4 to
+// save RAM.
+#ifndef PW_CONTAINERS_CACHE_LINE_SIZE
+#define PW_CONTAINERS_CACHE_LINE_SIZE 64
+#endif  // PW_CONTAINERS_CACHE_LINE_SIZE
@@ -0,0 +1,232 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace pw {
+
+template <typename>
+class IntrusiveDList;
+
+namespace intrusive_dlist_impl {
+
+template <typename T, typename I>
+class Iterator {
+ public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_cv_t<T>;
+  using pointer = T*;
+  using reference = T&;
+  using iterator_category = std::bidirectional_iterator_tag;
+
+  constexpr explicit Iterator() : item_(nullptr) {}
+
+  constexpr Iterator& operator++() {
+    item_ = static_cast<I*>(item_->next_);
+    return *this;
+  }
+
+  constexpr Iterator operator++(int) {
+    Iterator previous_value(item_);
+    operator++();
+    return previous_value;
+  }
+
+  constexpr Iterator& operator--() {
+    item_ = static_cast<I*>(item_->prev_);
+    return *this;
+  }
+
+  constexpr Iterator operator--(int) {
+    Iterator previous_value(item_);
+    operator--();
+    return previous_value;
+  }
+
+  constexpr const T& operator*() const { return *static_cast<T*>(item_); }
+  constexpr T& operator*() { return *static_cast<T*>(item_); }
+
+  constexpr const T* operator->() const { return static_cast<T*>(item_); }
+  constexpr T* operator->() { return static_cast<T*>(item_); }
+
+  template <typename U, typename J>
+  constexpr bool operator==(const Iterator<U, J>& rhs) const {
+    return item_ == rhs.item_;
+  }
+
+  template <typename U, typename J>
+  constexpr bool operator!=(const Iterator<U, J>& rhs) const {
+    return item_ != rhs.item_;
+  }
+
+ private:
+  template <typename, typename>
+  friend class Iterator;
+
+  template <typename>
+  friend class ::pw::IntrusiveDList;
+
+  // Only allow IntrusiveDList to create iterators that point to something.
+  constexpr explicit Iterator(I* item) : item_{item} {}
+
+  I* item_;
+};
+
+class DList {
+ public:
+  class Item {
+   public:
+    /// Items are not copyable.
+    Item(const Item&) = delete;
+
+    /// Items are not copyable.
+    Item& operator=(const Item&) = delete;
+
+    /// Returns whether this object is not part of a list.
+    ///
+    /// This is O(1) whether the object is in a list or not.
+    bool unlisted() const { return this == next_; }
+
+    /// Unlink this from the list it is a part of, if any.
+    ///
+    /// This is O(1).
+    void unlist();
+
+   protected:
+    /// Default constructor.
+    ///
+    /// Unlisted items are self-cycles, in both directions.
+    constexpr Item() : next_(this), prev_(this) {}
+
+    /// Destructor.
+    ///
+    /// This is O(1).
+    ~Item() { unlist(); }
+
+    /// Move constructor.
+    ///
+    /// This uses the move assignment operator. See the note on that method.
+    Item(Item&& other) : Item() { *this = std::move(other); }
+
+    /// Move assignment operator.
+    ///
+    /// Upon returning, this object is in the list that `other` had been a part
+    /// of, in `other`'s position, and `other` is unlisted. This is O(1).
+    Item& operator=(Item&& other);
+
+   private:
+    friend class DList;
+
+    template <typename T, typename I>
+    friend class Iterator;
+
+    // Unlisted items must be self-cycles (next_ == prev_ == this).
+    Item* next_;
+    Item* prev_;
+  };
+
+  constexpr DList() = default;
+
+  template <typename Iterator>
+  DList(Iterator first, Iterator last) : DList() {
+    AssignFromIterator(first, last);
+  }
+
+  // Intrusive lists cannot be copied, since each Item can only be in one list.
+  DList(const DList&) = delete;
+  DList& operator=(const DList&) = delete;
+
+  template <typename Iterator>
+  void assign(Iterator first, Iterator last) {
+    clear();
+    AssignFromIterator(first, last);
+  }
+
+  bool empty() const noexcept { return begin() == end(); }
+
+  /// Inserts an item into a list before the item given by `pos`.
+  ///
+  /// This is O(1). The ownership of the item is not changed.
+  static void insert(Item* pos, Item& item);
+
+  /// Removes an item from a list.
+  ///
+  /// This is O(1). The item is not destroyed.
+  static void erase(Item& item) { item.unlist(); }
+
+  void clear();
+
+  /// Returns a pointer to the first item.
+  constexpr Item* begin() noexcept { return head_.next_; }
+  constexpr const Item* begin() const noexcept { return head_.next_; }
+
+  /// Returns a pointer to the last item.
+  constexpr Item* before_end() noexcept { return head_.prev_; }
+  constexpr const Item* before_end() const noexcept { return head_.prev_; }
+
+  /// Returns a pointer to the sentinel item.
+  constexpr Item* end() noexcept { return &head_; }
+  constexpr const Item* end() const noexcept { return &head_; }
+
+  /// Returns the number of items in the list by looping around the cycle.
+  ///
+  /// This is O(n), where "n" is the number of items in the list.
+  size_t size() const;
+
+ private:
+  /// Adds items to the list from the provided range.
+  ///
+  /// This is O(n), where "n" is the number of items in the range.
+  template <typename Iterator>
+  void AssignFromIterator(Iterator first, Iterator last);
+
+  // Use an Item for the sentinel. As with intrusive_list_impl::List, this
+  // makes end() unique for each DList and ensures that items already in a list
+  // cannot be added to another.
+  Item head_;
+};
+
+template <typename Iterator>
+void DList::AssignFromIterator(Iterator first, Iterator last) {
+  for (Iterator it = first; it != last; ++it) {
+    if constexpr (std::is_pointer<std::remove_reference_t<decltype(*it)>>()) {
+      insert(end(), **it);
+    } else {
+      insert(end(), *it);
+    }
+  }
+}
+
+// Gets the element type from an Item. This is used to check that an
+// IntrusiveDList element class inherits from Item, either directly or through
+// another class.
+template <typename T, bool kIsItem = std::is_base_of<DList::Item, T>()>
+struct GetListElementTypeFromItem {
+  using Type = void;
+};
+
+template <typename T>
+struct GetListElementTypeFromItem<T, true> {
+  using Type = typename T::PwIntrusiveDListElementType;
+};
+
+template <typename T>
+using ElementTypeFromItem = typename GetListElementTypeFromItem<T>::Type;
+
+}  // namespace intrusive_dlist_impl
+}  // namespace pw
@@ -0,0 +1,200 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include "pw_containers/internal/intrusive_dlist_impl.h"
+
+namespace pw {
+
+// IntrusiveDList provides doubly-linked list functionality for derived class
+// items. Like IntrusiveList, IntrusiveDList<T> is a handle to access and
+// manipulate the list, and IntrusiveDList<T>::Item is a base class items must
+// inherit from.
+//
+// Each item has a pointer to the previous item as well as the next one, so
+// items can be removed from anywhere in the list, or unlisted, in O(1) time.
+// Prefer IntrusiveDList over IntrusiveList when items are frequently removed
+// in an arbitrary order. IntrusiveList uses one fewer pointer per item.
+//
+// As with IntrusiveList:
+//
+// - An instantiated IntrusiveDList::Item must remain in scope for the
+//   lifetime of the IntrusiveDList it has been added to.
+// - A linked list item CANNOT be included in two lists.
+//
+// Usage:
+//
+//   class TestItem
+//      : public IntrusiveDList<TestItem>::Item {}
+//
+//   IntrusiveDList<TestItem> test_items;
+//
+//   auto item = TestItem();
+//   test_items.push_back(item);
+//
+//   for (auto& test_item : test_items) {
+//     // Do a thing.
+//   }
+//
+//   test_items.remove(item);  // O(1)
+//
+template <typename T>
+class IntrusiveDList {
+ public:
+  class Item : public intrusive_dlist_impl::DList::Item {
+   protected:
+    constexpr Item() = default;
+
+   private:
+    // GetListElementTypeFromItem is used to find the element type from an item.
+    // It is used to ensure list items inherit from the correct Item type.
+    template <typename, bool>
+    friend struct intrusive_dlist_impl::GetListElementTypeFromItem;
+
+    using PwIntrusiveDListElementType = T;
+  };
+
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using pointer = T*;
+  using reference = T&;
+  using iterator = intrusive_dlist_impl::Iterator<T, Item>;
+  using const_iterator =
+      intrusive_dlist_impl::Iterator<std::add_const_t<T>, const Item>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  constexpr IntrusiveDList() { CheckItemType(); }
+
+  // Constructs an IntrusiveDList from an iterator over Items. The iterator may
+  // dereference as either Item& (e.g. from std::array<Item>) or Item* (e.g.
+  // from std::initializer_list<Item*>).
+  template <typename Iterator>
+  IntrusiveDList(Iterator first, Iterator last) : list_(first, last) {
+    CheckItemType();
+  }
+
+  // Constructs an IntrusiveDList from a std::initializer_list of pointers to
+  // items.
+  IntrusiveDList(std::initializer_list<Item*> items)
+      : IntrusiveDList(items.begin(), items.end()) {}
+
+  template <typename Iterator>
+  void assign(Iterator first, Iterator last) {
+    list_.assign(first, last);
+  }
+
+  void assign(std::initializer_list<Item*> items) {
+    list_.assign(items.begin(), items.end());
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return list_.empty(); }
+
+  void push_front(T& item) { list_.insert(list_.begin(), item); }
+
+  void push_back(T& item) { list_.insert(list_.end(), item); }
+
+  // Inserts an item before pos. Returns an iterator to the inserted item.
+  iterator insert(iterator pos, T& item) {
+    list_.insert(pos.item_, item);
+    return iterator(&item);
+  }
+
+  // Removes the first item in the list. The list must not be empty.
+  void pop_front() { list_.erase(*list_.begin()); }
+
+  // Removes the last item in the list. The list must not be empty.
+  void pop_back() { list_.erase(*list_.before_end()); }
+
+  // Removes the item at pos from the list and returns an iterator to the item
+  // that followed it. The item is not destructed. This is O(1).
+  iterator erase(iterator pos) {
+    iterator next = std::next(pos);
+    list_.erase(*pos.item_);
+    return next;
+  }
+
+  // Removes all items from the list. The items themselves are not destructed.
+  void clear() { list_.clear(); }
+
+  // Removes this specific item from the list, if it is listed. Returns true if
+  // the item was removed; false if it was not in a list. This is O(1), so it
+  // does not check which list the item is in; the item must either be in this
+  // list or be unlisted.
+  bool remove(T& item) {
+    Item& list_item = item;
+    if (list_item.unlisted()) {
+      return false;
+    }
+    list_.erase(list_item);
+    return true;
+  }
+
+  // Reference to the first element in the list. Undefined behavior if empty().
+  T& front() { return *static_cast<T*>(list_.begin()); }
+  const T& front() const { return *static_cast<const T*>(list_.begin()); }
+
+  // Reference to the last element in the list. Undefined behavior if empty().
+  T& back() { return *static_cast<T*>(list_.before_end()); }
+  const T& back() const {
+    return *static_cast<const T*>(list_.before_end());
+  }
+
+  iterator begin() noexcept {
+    return iterator(static_cast<Item*>(list_.begin()));
+  }
+  const_iterator begin() const noexcept {
+    return const_iterator(static_cast<const Item*>(list_.begin()));
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+
+  iterator end() noexcept { return iterator(static_cast<Item*>(list_.end())); }
+  const_iterator end() const noexcept {
+    return const_iterator(static_cast<const Item*>(list_.end()));
+  }
+  const_iterator cend() const noexcept { return end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // Operation is O(size).
+  size_t size() const { return list_.size(); }
+
+ private:
+  // Check that T is an Item in a function, since the class T will not be fully
+  // defined when the IntrusiveDList<T> class is instantiated.
+  static constexpr void CheckItemType() {
+    static_assert(
+        std::is_base_of<intrusive_dlist_impl::ElementTypeFromItem<T>, T>(),
+        "IntrusiveDList items must be derived from IntrusiveDList<T>::Item, "
+        "where T is the item or one of its bases.");
+  }
+
+  intrusive_dlist_impl::DList list_;
+};
+
+}  // namespace pw
@@ -0,0 +1,143 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+
+namespace pw {
+
+/// A lock-free, multi-producer single-consumer intrusive queue.
+///
+/// Any number of threads or interrupts may push concurrently while one
+/// consumer pops. Items are linked through an `IntrusiveMpscQueue<T>::Item`
+/// base class, so the queue never allocates and its capacity is bounded only
+/// by the items the caller owns. As with `IntrusiveList`, an item must outlive
+/// its time in the queue and may only be in one queue at a time.
+///
+/// `push()` is wait-free: one atomic exchange and one store. It is safe to call
+/// from interrupts, but requires atomic read-modify-write instructions, which
+/// some targets (e.g. ARMv6-M) lack.
+///
+/// `pop()` never blocks, but is not linearizable: if a producer is interrupted
+/// between its exchange and its store, `pop()` returns `nullptr` for that
+/// item, and any pushed after it, until the producer resumes. Consumers that
+/// need to wait should pair the queue with a notification primitive.
+///
+/// Usage:
+///
+///   class Event : public IntrusiveMpscQueue<Event>::Item {};
+///
+///   IntrusiveMpscQueue<Event> events;
+///
+///   // Producers (any thread or interrupt):
+///   events.push(event);
+///
+///   // Consumer:
+///   while (Event* event = events.pop()) {
+///     Handle(*event);
+///   }
+///
+template <typename T>
+class IntrusiveMpscQueue {
+ public:
+  class Item {
+   protected:
+    constexpr Item() = default;
+
+   private:
+    friend class IntrusiveMpscQueue;
+
+    std::atomic<Item*> next_{nullptr};
+  };
+
+  using element_type = T;
+  using pointer = T*;
+  using reference = T&;
+
+  static_assert(std::atomic<Item*>::is_always_lock_free,
+                "IntrusiveMpscQueue requires lock-free atomic pointers");
+
+  constexpr IntrusiveMpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+  IntrusiveMpscQueue(const IntrusiveMpscQueue&) = delete;
+  IntrusiveMpscQueue& operator=(const IntrusiveMpscQueue&) = delete;
+
+  /// Adds an item to the back of the queue. May be called concurrently from
+  /// any number of producers.
+  void push(T& item) {
+    Item* node = &static_cast<Item&>(item);
+    node->next_.store(nullptr, std::memory_order_relaxed);
+    Push(node);
+  }
+
+  /// Removes and returns the item at the front of the queue, or `nullptr` if
+  /// no item is ready. Consumer only.
+  T* pop() {
+    Item* tail = tail_;
+    Item* next = tail->next_.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      // Skip over the stub.
+      tail_ = next;
+      tail = next;
+      next = next->next_.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+      // A producer has exchanged the head but not yet linked its item.
+      return nullptr;
+    }
+    // `tail` is the last item. Push the stub behind it so it can be unlinked.
+    stub_.next_.store(nullptr, std::memory_order_relaxed);
+    Push(&stub_);
+    next = tail->next_.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    return nullptr;
+  }
+
+  /// Returns true if there are no items ready to pop. Consumer only.
+  [[nodiscard]] bool empty() const {
+    return tail_ == &stub_ &&
+           stub_.next_.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  // Item's constructor is protected, so the stub wraps it.
+  struct Stub : public Item {};
+
+  void Push(Item* node) {
+    Item* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next_.store(node, std::memory_order_release);
+  }
+
+  // Most recently pushed item. Written by producers.
+  std::atomic<Item*> head_;
+
+  // Oldest item, which may be the stub. Written by the consumer.
+  Item* tail_;
+
+  // Placeholder that keeps the queue non-empty, so producers never need to
+  // update the tail.
+  Stub stub_;
+};
+
+}  // namespace pw
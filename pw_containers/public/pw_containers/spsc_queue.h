@@ -0,0 +1,197 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_containers/internal/cache_line.h"
+#include "pw_containers/internal/raw_storage.h"
+
+namespace pw {
+
+/// A fixed-capacity, lock-free, single-producer single-consumer queue.
+///
+/// One thread or interrupt may push while another pops, without any locks.
+/// Both sides are wait-free: every operation completes in a bounded number of
+/// steps and never blocks, so `SpscQueue` is safe to use from interrupts,
+/// e.g. to pass samples from an ISR to a thread.
+///
+/// Only one producer and one consumer may use the queue at a time. Producer
+/// functions are marked "producer only" and consumer functions "consumer
+/// only". Functions that are not marked may be called from either, but their
+/// results may be stale by the time they return.
+///
+/// The producer and consumer each keep their index, and a cached copy of the
+/// other's index, on separate cache lines (see `PW_CONTAINERS_CACHE_LINE_SIZE`)
+/// so that they only share a line when one side actually needs the other's
+/// progress.
+///
+/// @tparam T Element type. Elements are constructed in place by the producer
+///     and destroyed by the consumer.
+/// @tparam kCapacity Maximum number of elements in the queue.
+template <typename T, size_t kCapacity>
+class SpscQueue {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  static_assert(kCapacity > 0u, "SpscQueue capacity must be nonzero");
+  static_assert(kCapacity <= std::numeric_limits<size_type>::max() / 2,
+                "SpscQueue capacity is too large");
+  static_assert(std::atomic<size_type>::is_always_lock_free,
+                "SpscQueue requires lock-free atomic indices");
+
+  constexpr SpscQueue() noexcept = default;
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /// Destroys any elements remaining in the queue. Neither the producer nor
+  /// the consumer may be using the queue.
+  ~SpscQueue() {
+    while (front() != nullptr) {
+      pop();
+    }
+  }
+
+  // Capacity
+
+  static constexpr size_type capacity() noexcept { return kCapacity; }
+  static constexpr size_type max_size() noexcept { return kCapacity; }
+
+  size_type size() const noexcept {
+    const size_type tail = producer_.tail.load(std::memory_order_acquire);
+    const size_type head = consumer_.head.load(std::memory_order_acquire);
+    return Distance(head, tail);
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return size() == 0u; }
+  bool full() const noexcept { return size() == kCapacity; }
+
+  // Producer
+
+  /// Copies `value` into the queue. Producer only.
+  ///
+  /// @returns `false` if the queue is full.
+  [[nodiscard]] bool try_push(const T& value) { return try_emplace(value); }
+
+  /// Moves `value` into the queue. Producer only.
+  ///
+  /// @returns `false` if the queue is full, in which case `value` is
+  /// unchanged.
+  [[nodiscard]] bool try_push(T&& value) {
+    return try_emplace(std::move(value));
+  }
+
+  /// Constructs an element at the back of the queue. Producer only.
+  ///
+  /// @returns `false` if the queue is full.
+  template <typename... Args>
+  [[nodiscard]] bool try_emplace(Args&&... args) {
+    const size_type tail = producer_.tail.load(std::memory_order_relaxed);
+    if (Distance(producer_.cached_head, tail) == kCapacity) {
+      // The queue looked full the last time the head was read. Check again.
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      if (Distance(producer_.cached_head, tail) == kCapacity) {
+        return false;
+      }
+    }
+    new (&storage_.data()[Slot(tail)]) T(std::forward<Args>(args)...);
+    producer_.tail.store(Next(tail), std::memory_order_release);
+    return true;
+  }
+
+  // Consumer
+
+  /// Returns the element at the front of the queue, or `nullptr` if the queue
+  /// is empty. The element remains valid until `pop()`. Consumer only.
+  T* front() {
+    const size_type head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.cached_tail) {
+      // The queue looked empty the last time the tail was read. Check again.
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.cached_tail) {
+        return nullptr;
+      }
+    }
+    return &storage_.data()[Slot(head)];
+  }
+
+  /// Removes the element at the front of the queue, which must not be empty.
+  /// Consumer only.
+  void pop() {
+    const size_type head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.cached_tail) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+    }
+    PW_DASSERT(head != consumer_.cached_tail);
+    std::destroy_at(&storage_.data()[Slot(head)]);
+    consumer_.head.store(Next(head), std::memory_order_release);
+  }
+
+  /// Removes and returns the element at the front of the queue, or
+  /// `std::nullopt` if the queue is empty. Consumer only.
+  std::optional<T> try_pop() {
+    T* element = front();
+    if (element == nullptr) {
+      return std::nullopt;
+    }
+    std::optional<T> value(std::move(*element));
+    pop();
+    return value;
+  }
+
+ private:
+  // Indices run from 0 to 2 * kCapacity - 1, so that a full queue (distance
+  // kCapacity) can be told apart from an empty one (distance 0) without
+  // leaving a slot unused.
+  static constexpr size_type Next(size_type index) {
+    return index + 1 == 2 * kCapacity ? 0 : index + 1;
+  }
+
+  static constexpr size_type Slot(size_type index) {
+    return index < kCapacity ? index : index - kCapacity;
+  }
+
+  static constexpr size_type Distance(size_type head, size_type tail) {
+    return tail >= head ? tail - head : tail + 2 * kCapacity - head;
+  }
+
+  // Written by the producer.
+  struct alignas(PW_CONTAINERS_CACHE_LINE_SIZE) Producer {
+    std::atomic<size_type> tail{0};
+    size_type cached_head = 0;
+  };
+
+  // Written by the consumer.
+  struct alignas(PW_CONTAINERS_CACHE_LINE_SIZE) Consumer {
+    std::atomic<size_type> head{0};
+    size_type cached_tail = 0;
+  };
+
+  Producer producer_;
+  Consumer consumer_;
+  containers::internal::RawStorage<T, kCapacity> storage_;
+};
+
+}  // namespace pw
@@ -0,0 +1,178 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "pw_containers/internal/cache_line.h"
+#include "pw_containers/internal/raw_storage.h"
+#include "pw_span/span.h"
+
+namespace pw {
+
+/// A lock-free, single-producer single-consumer queue of variable-length
+/// binary entries.
+///
+/// Like `InlineVarLenEntryQueue`, entries are stored inline in a ring buffer,
+/// but the producer and consumer may run concurrently, e.g. one in an ISR and
+/// the other in a thread. Entries are always contiguous, so the producer can
+/// reserve space, encode an entry directly into the queue, and commit it, and
+/// the consumer can read it in place before popping it. Neither side copies
+/// the entry or takes a lock.
+///
+/// Each entry takes a 4-byte size prefix plus its data, rounded up to a
+/// multiple of 4 bytes. When an entry does not fit before the end of the
+/// buffer, it is placed at the start instead and the space at the end is
+/// skipped. Because of this, an entry is only guaranteed to fit in an empty
+/// queue if it is at most `max_entry_size_bytes()`, about half the capacity.
+///
+/// Only one producer and one consumer may use the queue at a time.
+///
+/// `SpscVarLenEntryQueue` instances are declared with their capacity in bytes
+/// (`SpscVarLenEntryQueue<256>`), but may be referred to without it
+/// (`SpscVarLenEntryQueue<>&`).
+template <size_t kCapacityBytes = containers::internal::kGenericSized>
+class SpscVarLenEntryQueue;
+
+/// Generic-capacity base of `SpscVarLenEntryQueue`. The member functions are
+/// implemented here.
+template <>
+class SpscVarLenEntryQueue<containers::internal::kGenericSized> {
+ public:
+  using size_type = uint32_t;
+
+  SpscVarLenEntryQueue(const SpscVarLenEntryQueue&) = delete;
+  SpscVarLenEntryQueue& operator=(const SpscVarLenEntryQueue&) = delete;
+
+  /// Size of the ring buffer, including the space used for size prefixes.
+  size_type capacity_bytes() const { return buffer_size_; }
+
+  /// The largest entry that is guaranteed to fit when the queue is empty.
+  size_type max_entry_size_bytes() const {
+    return (buffer_size_ / 2 - kPrefixSize) & ~(kAlignment - 1);
+  }
+
+  /// Returns true if the queue has no committed entries. The result may be
+  /// stale by the time it returns.
+  [[nodiscard]] bool empty() const {
+    return consumer_.head.load(std::memory_order_acquire) ==
+           producer_.tail.load(std::memory_order_acquire);
+  }
+
+  // Producer
+
+  /// Reserves `size_bytes` contiguous bytes for a new entry. The entry is not
+  /// visible to the consumer until it is passed to `commit()`. Calling
+  /// `try_reserve()` again before committing discards the earlier
+  /// reservation. Producer only.
+  ///
+  /// @returns The reserved bytes, or `std::nullopt` if there is not
+  /// currently enough contiguous space.
+  std::optional<span<std::byte>> try_reserve(size_type size_bytes);
+
+  /// Adds the most recent reservation to the queue as an entry of
+  /// `size_bytes`, which must not exceed the reserved size. Producer only.
+  void commit(size_type size_bytes);
+
+  /// Copies `entry` into the queue. Producer only.
+  ///
+  /// @returns `false` if there is not enough space for the entry.
+  [[nodiscard]] bool try_push(span<const std::byte> entry);
+
+  // Consumer
+
+  /// Returns the oldest entry, which remains valid until `pop()`, or
+  /// `std::nullopt` if the queue is empty. Consumer only.
+  std::optional<span<const std::byte>> front();
+
+  /// Removes the oldest entry. The queue must not be empty. Consumer only.
+  void pop();
+
+ protected:
+  static constexpr size_type kPrefixSize = sizeof(size_type);
+  static constexpr size_type kAlignment = alignof(size_type);
+
+  constexpr SpscVarLenEntryQueue(std::byte* buffer, size_type buffer_size)
+      : buffer_(buffer), buffer_size_(buffer_size) {}
+
+  ~SpscVarLenEntryQueue() = default;
+
+ private:
+  // Written in place of a size prefix to mark that the next entry is at the
+  // start of the buffer.
+  static constexpr size_type kWrapMarker =
+      std::numeric_limits<size_type>::max();
+
+  static constexpr size_type EncodedSize(size_type size_bytes) {
+    return kPrefixSize + ((size_bytes + kAlignment - 1) & ~(kAlignment - 1));
+  }
+
+  size_type ReadPrefix(size_type offset) const;
+  void WritePrefix(size_type offset, size_type value);
+
+  // Returns the offset of the entry at `head`, skipping a wrap marker.
+  size_type EntryOffset(size_type head) const;
+
+  // Returns the offset at which an encoded entry of `size` fits before
+  // `head`, or `buffer_size_` if it does not fit.
+  size_type FindSpace(size_type head, size_type tail, size_type size) const;
+
+  // The head and tail are byte offsets into the buffer. The queue is empty
+  // when they are equal, so the producer never advances the tail onto the
+  // head.
+  struct alignas(PW_CONTAINERS_CACHE_LINE_SIZE) Producer {
+    std::atomic<size_type> tail{0};
+    size_type cached_head = 0;
+    size_type reserved_offset = 0;
+    size_type reserved_size = 0;
+  };
+
+  struct alignas(PW_CONTAINERS_CACHE_LINE_SIZE) Consumer {
+    std::atomic<size_type> head{0};
+    size_type cached_tail = 0;
+  };
+
+  Producer producer_;
+  Consumer consumer_;
+  std::byte* const buffer_;
+  const size_type buffer_size_;
+};
+
+template <size_t kCapacityBytes>
+class SpscVarLenEntryQueue
+    : public SpscVarLenEntryQueue<containers::internal::kGenericSized> {
+ private:
+  using Base = SpscVarLenEntryQueue<containers::internal::kGenericSized>;
+
+  static constexpr size_t kBufferSize =
+      (kCapacityBytes + Base::kAlignment - 1) & ~size_t{Base::kAlignment - 1};
+
+  static_assert(kBufferSize >= 4 * Base::kPrefixSize,
+                "SpscVarLenEntryQueue capacity is too small");
+  static_assert(kBufferSize < std::numeric_limits<Base::size_type>::max(),
+                "SpscVarLenEntryQueue capacity is too large");
+
+ public:
+  constexpr SpscVarLenEntryQueue()
+      : Base(buffer_, static_cast<Base::size_type>(kBufferSize)) {}
+
+ private:
+  alignas(Base::size_type) std::byte buffer_[kBufferSize] = {};
+};
+
+}  // namespace pw
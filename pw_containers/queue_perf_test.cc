@@ -0,0 +1,87 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/inline_queue.h"
+#include "pw_containers/intrusive_mpsc_queue.h"
+#include "pw_containers/spsc_queue.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw {
+namespace {
+
+// Each iteration fills the queue and then drains it, so that every push and
+// pop is measured, including the wrap around the end of the buffer.
+constexpr size_t kCapacity = 16;
+
+// Baseline: InlineQueue has no synchronization at all.
+void InlineQueueTest(perf_test::State& state) {
+  InlineQueue<uint32_t, kCapacity> queue;
+  uint32_t sum = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t i = 0; i < kCapacity; ++i) {
+      queue.push(i);
+    }
+    while (!queue.empty()) {
+      sum += queue.front();
+      queue.pop();
+    }
+  }
+  static_cast<void>(sum);
+}
+
+void SpscQueueTest(perf_test::State& state) {
+  SpscQueue<uint32_t, kCapacity> queue;
+  uint32_t sum = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t i = 0; i < kCapacity; ++i) {
+      static_cast<void>(queue.try_push(i));
+    }
+    while (const uint32_t* value = queue.front()) {
+      sum += *value;
+      queue.pop();
+    }
+  }
+  static_cast<void>(sum);
+}
+
+class QueueItem : public IntrusiveMpscQueue<QueueItem>::Item {
+ public:
+  uint32_t value = 0;
+};
+
+void IntrusiveMpscQueueTest(perf_test::State& state) {
+  IntrusiveMpscQueue<QueueItem> queue;
+  std::array<QueueItem, kCapacity> items;
+  uint32_t sum = 0;
+  while (state.KeepRunning()) {
+    for (QueueItem& item : items) {
+      queue.push(item);
+    }
+    while (const QueueItem* item = queue.pop()) {
+      sum += item->value;
+    }
+  }
+  static_cast<void>(sum);
+}
+
+PW_PERF_TEST(InlineQueuePushPop, InlineQueueTest);
+PW_PERF_TEST(SpscQueuePushPop, SpscQueueTest);
+PW_PERF_TEST(IntrusiveMpscQueuePushPop, IntrusiveMpscQueueTest);
+
+}  // namespace
+}  // namespace pw
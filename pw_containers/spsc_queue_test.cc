@@ -0,0 +1,140 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/spsc_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "pw_containers_private/test_helpers.h"
+#include "pw_polyfill/language_feature_macros.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+using containers::test::Counter;
+
+class SpscQueueTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Counter::Reset(); }
+
+  // Every element that was constructed must have been destroyed.
+  void TearDown() override {
+    EXPECT_EQ(Counter::created + Counter::moved, Counter::destroyed);
+  }
+};
+
+// The producer's and consumer's state must not share a cache line.
+static_assert(sizeof(SpscQueue<uint8_t, 1>) >=
+              2 * PW_CONTAINERS_CACHE_LINE_SIZE + 1);
+
+TEST_F(SpscQueueTest, DefaultConstructed_IsEmpty) {
+  SpscQueue<int, 4> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.full());
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_EQ(4u, queue.capacity());
+  EXPECT_EQ(nullptr, queue.front());
+  EXPECT_EQ(std::nullopt, queue.try_pop());
+}
+
+TEST_F(SpscQueueTest, PushUntilFull) {
+  SpscQueue<int, 3> queue;
+  EXPECT_TRUE(queue.try_push(1));
+  EXPECT_TRUE(queue.try_push(2));
+  EXPECT_TRUE(queue.try_push(3));
+  EXPECT_TRUE(queue.full());
+  EXPECT_FALSE(queue.try_push(4));
+  EXPECT_EQ(3u, queue.size());
+
+  EXPECT_EQ(1, queue.try_pop());
+  EXPECT_FALSE(queue.full());
+  EXPECT_TRUE(queue.try_push(4));
+  EXPECT_EQ(2, queue.try_pop());
+  EXPECT_EQ(3, queue.try_pop());
+  EXPECT_EQ(4, queue.try_pop());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(SpscQueueTest, FrontAndPop) {
+  SpscQueue<Counter, 2> queue;
+  ASSERT_TRUE(queue.try_emplace(5));
+  ASSERT_NE(nullptr, queue.front());
+  EXPECT_EQ(5, queue.front()->value);
+  EXPECT_EQ(1, Counter::created);
+  EXPECT_EQ(0, Counter::destroyed);
+  queue.pop();
+  EXPECT_EQ(1, Counter::destroyed);
+  EXPECT_EQ(nullptr, queue.front());
+}
+
+TEST_F(SpscQueueTest, PopWithoutFront) {
+  SpscQueue<Counter, 2> queue;
+  ASSERT_TRUE(queue.try_emplace(1));
+  ASSERT_TRUE(queue.try_emplace(2));
+  queue.pop();
+  EXPECT_EQ(1, Counter::destroyed);
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(SpscQueueTest, WrapAround_PreservesOrder) {
+  SpscQueue<int, 3> queue;
+  int next_push = 0;
+  int next_pop = 0;
+  for (int i = 0; i < 100; ++i) {
+    while (queue.try_push(next_push)) {
+      ++next_push;
+    }
+    // Pop a varying number of elements to move the indices around.
+    for (int j = 0; j <= i % 3; ++j) {
+      std::optional<int> value = queue.try_pop();
+      ASSERT_TRUE(value.has_value());
+      EXPECT_EQ(next_pop++, *value);
+    }
+  }
+  EXPECT_EQ(static_cast<size_t>(next_push - next_pop), queue.size());
+}
+
+TEST_F(SpscQueueTest, TryPush_Full_DoesNotMove) {
+  SpscQueue<std::unique_ptr<int>, 1> queue;
+  ASSERT_TRUE(queue.try_push(std::make_unique<int>(1)));
+  auto value = std::make_unique<int>(2);
+  EXPECT_FALSE(queue.try_push(std::move(value)));
+  ASSERT_NE(nullptr, value);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(2, *value);
+}
+
+TEST_F(SpscQueueTest, Destructor_DestroysElements) {
+  {
+    SpscQueue<Counter, 4> queue;
+    ASSERT_TRUE(queue.try_emplace(1));
+    ASSERT_TRUE(queue.try_emplace(2));
+    EXPECT_EQ(2, Counter::created);
+    EXPECT_EQ(0, Counter::destroyed);
+  }
+  EXPECT_EQ(2, Counter::destroyed);
+}
+
+TEST_F(SpscQueueTest, ConstantInitialized) {
+  PW_CONSTINIT static SpscQueue<int, 4> queue;
+  EXPECT_TRUE(queue.try_push(1));
+  EXPECT_EQ(1, queue.try_pop());
+}
+
+}  // namespace
+}  // namespace pw
@@ -0,0 +1,139 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/spsc_var_len_entry_queue.h"
+
+#include <cstring>
+
+#include "pw_assert/check.h"
+
+namespace pw {
+
+using Queue = SpscVarLenEntryQueue<>;
+
+Queue::size_type Queue::ReadPrefix(size_type offset) const {
+  size_type value;
+  std::memcpy(&value, &buffer_[offset], sizeof(value));
+  return value;
+}
+
+void Queue::WritePrefix(size_type offset, size_type value) {
+  std::memcpy(&buffer_[offset], &value, sizeof(value));
+}
+
+Queue::size_type Queue::EntryOffset(size_type head) const {
+  return ReadPrefix(head) == kWrapMarker ? 0 : head;
+}
+
+Queue::size_type Queue::FindSpace(size_type head,
+                                  size_type tail,
+                                  size_type size) const {
+  if (tail < head) {
+    // The free space is [tail, head). Leave at least one byte before the head.
+    return size < head - tail ? tail : buffer_size_;
+  }
+  // The free space is [tail, buffer_size_) and [0, head). Filling the end
+  // exactly wraps the tail to 0, which is only allowed if the head is not 0.
+  const size_type end_space = buffer_size_ - tail;
+  if (size < end_space || (size == end_space && head != 0)) {
+    return tail;
+  }
+  // Skip the end of the buffer, which needs room for the wrap marker.
+  return size < head ? 0 : buffer_size_;
+}
+
+std::optional<span<std::byte>> Queue::try_reserve(size_type size_bytes) {
+  if (size_bytes > buffer_size_ - kPrefixSize) {
+    return std::nullopt;
+  }
+  const size_type size = EncodedSize(size_bytes);
+  const size_type tail = producer_.tail.load(std::memory_order_relaxed);
+  size_type offset = FindSpace(producer_.cached_head, tail, size);
+  if (offset == buffer_size_) {
+    // There was not enough space the last time the head was read. Try again.
+    producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+    offset = FindSpace(producer_.cached_head, tail, size);
+    if (offset == buffer_size_) {
+      producer_.reserved_size = 0;
+      return std::nullopt;
+    }
+  }
+  producer_.reserved_offset = offset;
+  producer_.reserved_size = size;
+  return span(&buffer_[offset + kPrefixSize], size_bytes);
+}
+
+void Queue::commit(size_type size_bytes) {
+  PW_DCHECK_UINT_LE(EncodedSize(size_bytes), producer_.reserved_size);
+  const size_type tail = producer_.tail.load(std::memory_order_relaxed);
+  const size_type offset = producer_.reserved_offset;
+  if (offset != tail) {
+    // The entry wrapped to the start of the buffer.
+    WritePrefix(tail, kWrapMarker);
+  }
+  WritePrefix(offset, size_bytes);
+
+  size_type new_tail = offset + EncodedSize(size_bytes);
+  if (new_tail == buffer_size_) {
+    new_tail = 0;
+  }
+  producer_.reserved_size = 0;
+  producer_.tail.store(new_tail, std::memory_order_release);
+}
+
+bool Queue::try_push(span<const std::byte> entry) {
+  const auto size_bytes = static_cast<size_type>(entry.size());
+  if (size_bytes != entry.size()) {
+    return false;
+  }
+  std::optional<span<std::byte>> reserved = try_reserve(size_bytes);
+  if (!reserved.has_value()) {
+    return false;
+  }
+  if (!entry.empty()) {
+    std::memcpy(reserved->data(), entry.data(), entry.size());
+  }
+  commit(size_bytes);
+  return true;
+}
+
+std::optional<span<const std::byte>> Queue::front() {
+  const size_type head = consumer_.head.load(std::memory_order_relaxed);
+  if (head == consumer_.cached_tail) {
+    // The queue was empty the last time the tail was read. Check again.
+    consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+    if (head == consumer_.cached_tail) {
+      return std::nullopt;
+    }
+  }
+  const size_type offset = EntryOffset(head);
+  return span<const std::byte>(&buffer_[offset + kPrefixSize],
+                               ReadPrefix(offset));
+}
+
+void Queue::pop() {
+  const size_type head = consumer_.head.load(std::memory_order_relaxed);
+  if (head == consumer_.cached_tail) {
+    consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+  }
+  PW_DCHECK_UINT_NE(head, consumer_.cached_tail, "Popped an empty queue");
+  const size_type offset = EntryOffset(head);
+  size_type new_head = offset + EncodedSize(ReadPrefix(offset));
+  if (new_head == buffer_size_) {
+    new_head = 0;
+  }
+  consumer_.head.store(new_head, std::memory_order_release);
+}
+
+}  // namespace pw
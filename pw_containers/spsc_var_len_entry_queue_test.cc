@@ -0,0 +1,200 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/spsc_var_len_entry_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_containers/inline_deque.h"
+#include "pw_span/span.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+// Fills an entry with bytes derived from its sequence number and size.
+void Fill(span<std::byte> entry, uint32_t sequence) {
+  for (size_t i = 0; i < entry.size(); ++i) {
+    entry[i] = static_cast<std::byte>(sequence * 31 + i);
+  }
+}
+
+bool Matches(span<const std::byte> entry, uint32_t sequence) {
+  for (size_t i = 0; i < entry.size(); ++i) {
+    if (entry[i] != static_cast<std::byte>(sequence * 31 + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(SpscVarLenEntryQueue, DefaultConstructed_IsEmpty) {
+  SpscVarLenEntryQueue<64> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(64u, queue.capacity_bytes());
+  EXPECT_EQ(std::nullopt, queue.front());
+}
+
+TEST(SpscVarLenEntryQueue, Capacity_RoundsUp) {
+  SpscVarLenEntryQueue<33> queue;
+  EXPECT_EQ(36u, queue.capacity_bytes());
+}
+
+TEST(SpscVarLenEntryQueue, ReserveCommitFrontPop) {
+  SpscVarLenEntryQueue<64> queue;
+  std::optional<span<std::byte>> entry = queue.try_reserve(5);
+  ASSERT_TRUE(entry.has_value());
+  ASSERT_EQ(5u, entry->size());
+  Fill(*entry, 1);
+  EXPECT_TRUE(queue.empty());  // Not visible until committed.
+  queue.commit(5);
+  EXPECT_FALSE(queue.empty());
+
+  std::optional<span<const std::byte>> front = queue.front();
+  ASSERT_TRUE(front.has_value());
+  EXPECT_EQ(entry->data(), front->data());  // Read in place.
+  ASSERT_EQ(5u, front->size());
+  EXPECT_TRUE(Matches(*front, 1));
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscVarLenEntryQueue, CommitLessThanReserved) {
+  SpscVarLenEntryQueue<64> queue;
+  std::optional<span<std::byte>> entry = queue.try_reserve(20);
+  ASSERT_TRUE(entry.has_value());
+  Fill(entry->first(3), 2);
+  queue.commit(3);
+
+  std::optional<span<const std::byte>> front = queue.front();
+  ASSERT_TRUE(front.has_value());
+  ASSERT_EQ(3u, front->size());
+  EXPECT_TRUE(Matches(*front, 2));
+}
+
+TEST(SpscVarLenEntryQueue, EmptyEntry) {
+  SpscVarLenEntryQueue<16> queue;
+  ASSERT_TRUE(queue.try_push({}));
+  std::optional<span<const std::byte>> front = queue.front();
+  ASSERT_TRUE(front.has_value());
+  EXPECT_TRUE(front->empty());
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscVarLenEntryQueue, TryReserve_Full_ReturnsNullopt) {
+  SpscVarLenEntryQueue<32> queue;
+  std::array<std::byte, 8> data{};
+  // Each entry takes 12 bytes, and the tail may not catch up to the head.
+  EXPECT_TRUE(queue.try_push(data));
+  EXPECT_TRUE(queue.try_push(data));
+  EXPECT_FALSE(queue.try_push(data));
+  EXPECT_EQ(std::nullopt, queue.try_reserve(8));
+  // Filling the last 8 bytes would wrap the tail onto the head.
+  EXPECT_FALSE(queue.try_push(span(data).first(1)));
+  EXPECT_TRUE(queue.try_push({}));
+  EXPECT_EQ(std::nullopt, queue.try_reserve(0));
+}
+
+TEST(SpscVarLenEntryQueue, TryReserve_TooLarge_ReturnsNullopt) {
+  SpscVarLenEntryQueue<32> queue;
+  EXPECT_EQ(std::nullopt, queue.try_reserve(29));
+  EXPECT_EQ(std::nullopt, queue.try_reserve(UINT32_MAX));
+}
+
+TEST(SpscVarLenEntryQueue, EntryWrapsToStart_StaysContiguous) {
+  SpscVarLenEntryQueue<32> queue;
+  std::array<std::byte, 4> data{};
+  ASSERT_TRUE(queue.try_push(data));  // [0, 8)
+  ASSERT_TRUE(queue.try_push(data));  // [8, 16)
+  ASSERT_TRUE(queue.try_push(data));  // [16, 24)
+  queue.pop();
+  queue.pop();
+
+  // 8 bytes remain at the end, so a 12-byte entry goes at the start.
+  std::optional<span<std::byte>> entry = queue.try_reserve(8);
+  ASSERT_TRUE(entry.has_value());
+  Fill(*entry, 3);
+  queue.commit(8);
+
+  queue.pop();
+  std::optional<span<const std::byte>> front = queue.front();
+  ASSERT_TRUE(front.has_value());
+  EXPECT_EQ(entry->data(), front->data());
+  EXPECT_TRUE(Matches(*front, 3));
+}
+
+TEST(SpscVarLenEntryQueue, MaxEntrySize_AlwaysFitsWhenEmpty) {
+  SpscVarLenEntryQueue<60> queue;
+  const uint32_t max_size = queue.max_entry_size_bytes();
+  ASSERT_GT(max_size, 0u);
+  // Move the head and tail through every position in the buffer.
+  for (int i = 0; i < 60; ++i) {
+    ASSERT_TRUE(queue.empty());
+    std::optional<span<std::byte>> entry = queue.try_reserve(max_size);
+    ASSERT_TRUE(entry.has_value()) << "at step " << i;
+    queue.commit(max_size);
+    queue.pop();
+    ASSERT_TRUE(queue.try_push({}));
+    queue.pop();
+  }
+}
+
+TEST(SpscVarLenEntryQueue, GenericSizedReference) {
+  SpscVarLenEntryQueue<48> queue;
+  SpscVarLenEntryQueue<>& generic = queue;
+  std::array<std::byte, 3> data{};
+  EXPECT_TRUE(generic.try_push(data));
+  EXPECT_EQ(48u, generic.capacity_bytes());
+  EXPECT_FALSE(queue.empty());
+}
+
+TEST(SpscVarLenEntryQueue, MatchesReferenceQueue) {
+  SpscVarLenEntryQueue<100> queue;
+  // Sizes of the entries that should be in the queue.
+  InlineDeque<uint32_t, 64> expected_sizes;
+  uint32_t next_push = 0;
+  uint32_t next_pop = 0;
+  uint32_t random = 1;
+
+  for (int i = 0; i < 5000; ++i) {
+    random = random * 1103515245u + 12345u;
+    const uint32_t size = (random >> 16) % 40;
+    if ((random >> 8) % 3 != 0) {
+      std::optional<span<std::byte>> entry = queue.try_reserve(size);
+      if (entry.has_value()) {
+        Fill(*entry, next_push++);
+        queue.commit(size);
+        expected_sizes.push_back(size);
+      }
+    } else if (!expected_sizes.empty()) {
+      std::optional<span<const std::byte>> front = queue.front();
+      ASSERT_TRUE(front.has_value());
+      ASSERT_EQ(expected_sizes.front(), front->size());
+      ASSERT_TRUE(Matches(*front, next_pop++));
+      queue.pop();
+      expected_sizes.pop_front();
+    } else {
+      ASSERT_TRUE(queue.empty());
+    }
+  }
+  EXPECT_GT(next_pop, 1000u);
+}
+
+}  // namespace
+}  // namespace pw
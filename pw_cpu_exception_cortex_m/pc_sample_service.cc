@@ -0,0 +1,122 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_cpu_exception_cortex_m/pc_sample_service.h"
+
+#include <array>
+#include <new>
+
+#include "pw_cpu_exception_cortex_m_protos/pc_samples.pwpb.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_status/status.h"
+#include "pw_status/try.h"
+#include "pw_varint/varint.h"
+
+namespace pw::cpu_exception::cortex_m {
+namespace {
+
+constexpr size_t kSamplesPerResponse = 16;
+
+// Each sample is a nested message, with a one-byte key and length.
+constexpr size_t kMaxEncodedSampleSizeBytes =
+    pwpb::PcSample::kMaxEncodedSizeBytes + 2;
+
+// The sizes of the total_samples and dropped_samples fields.
+constexpr size_t kMaxEncodedCountsSizeBytes =
+    2 * (1 + varint::kMaxVarint32SizeBytes);
+
+constexpr size_t kEncodeBufferSize =
+    kSamplesPerResponse * kMaxEncodedSampleSizeBytes +
+    kMaxEncodedCountsSizeBytes;
+
+bool ShouldClear(ConstByteSpan request) {
+  protobuf::Decoder decoder(request);
+  bool clear = false;
+  while (decoder.Next().ok()) {
+    if (decoder.FieldNumber() ==
+        static_cast<uint32_t>(pwpb::GetSamplesRequest::Fields::kClear)) {
+      decoder.ReadBool(&clear).IgnoreError();  // Treated as false on error.
+    }
+  }
+  return clear;
+}
+
+class SampleBatcher {
+ public:
+  SampleBatcher(rpc::RawServerWriter& writer) : writer_(writer) {}
+
+  Status WriteCounts(uint32_t total_samples, uint32_t dropped_samples) {
+    PW_TRY(encoder_.WriteTotalSamples(total_samples));
+    return encoder_.WriteDroppedSamples(dropped_samples);
+  }
+
+  Status Write(const PcSample& sample) {
+    {
+      pwpb::PcSample::StreamEncoder sample_encoder =
+          encoder_.GetSamplesEncoder();
+      PW_TRY(sample_encoder.WritePc(sample.pc));
+      PW_TRY(sample_encoder.WriteCaller(sample.caller));
+      PW_TRY(sample_encoder.WriteCount(sample.count));
+    }
+    if (++samples_in_batch_ == kSamplesPerResponse) {
+      return Flush();
+    }
+    return OkStatus();
+  }
+
+  // Sends the current batch. The first batch is always sent, so clients
+  // receive the sample counts even if there are no samples.
+  Status Flush() {
+    if (samples_in_batch_ == 0 && batches_sent_ != 0) {
+      return OkStatus();
+    }
+    Status status = writer_.Write(encoder_);
+    // MemoryEncoder can't be cleared or reassigned, so construct a new one.
+    encoder_.~MemoryEncoder();
+    new (&encoder_) pwpb::GetSamplesResponse::MemoryEncoder(buffer_);
+    samples_in_batch_ = 0;
+    batches_sent_ += 1;
+    return status;
+  }
+
+ private:
+  rpc::RawServerWriter& writer_;
+  std::array<std::byte, kEncodeBufferSize> buffer_;
+  pwpb::GetSamplesResponse::MemoryEncoder encoder_{buffer_};
+  size_t samples_in_batch_ = 0;
+  size_t batches_sent_ = 0;
+};
+
+}  // namespace
+
+void PcSampleService::GetSamples(ConstByteSpan request,
+                                 rpc::RawServerWriter& writer) {
+  SampleBatcher batcher(writer);
+  Status status =
+      batcher.WriteCounts(table_.total_samples(), table_.dropped_samples());
+  table_.ForEachSample([&batcher, &status](const PcSample& sample) {
+    if (status.ok()) {
+      status = batcher.Write(sample);
+    }
+  });
+  status.Update(batcher.Flush());
+
+  if (status.ok() && ShouldClear(request)) {
+    table_.ClearCounts();
+  }
+  writer.Finish(status).IgnoreError();
+}
+
+}  // namespace pw::cpu_exception::cortex_m
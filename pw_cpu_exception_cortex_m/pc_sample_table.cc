@@ -0,0 +1,67 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_cpu_exception_cortex_m/pc_sample_table.h"
+
+#include <algorithm>
+
+namespace pw::cpu_exception::cortex_m::internal {
+
+void BasicPcSampleTable::Record(uint32_t pc, uint32_t caller) {
+  Increment(total_samples_);
+
+  // Thumb instructions are halfword-aligned, so drop the PC's low bit. This
+  // also spreads consecutive PCs across consecutive slots.
+  size_t index = ((pc >> 1) ^ (caller * 0x9E3779B1u)) % slots_.size();
+  const size_t probes = std::min(kMaxProbes, slots_.size());
+  for (size_t i = 0; i < probes; ++i) {
+    Slot& slot = slots_[index];
+    const uint32_t slot_pc = slot.pc.load(std::memory_order_relaxed);
+    if (slot_pc == 0) {
+      // Claim the slot. Readers skip it until its PC is published.
+      slot.caller.store(caller, std::memory_order_relaxed);
+      slot.count.store(1, std::memory_order_relaxed);
+      slot.pc.store(pc, std::memory_order_release);
+      return;
+    }
+    if (slot_pc == pc &&
+        slot.caller.load(std::memory_order_relaxed) == caller) {
+      Increment(slot.count);
+      return;
+    }
+    index = (index + 1) % slots_.size();
+  }
+  Increment(dropped_samples_);
+}
+
+void BasicPcSampleTable::ClearCounts() {
+  for (Slot& slot : slots_) {
+    slot.count.store(0, std::memory_order_relaxed);
+  }
+  total_samples_.store(0, std::memory_order_relaxed);
+  dropped_samples_.store(0, std::memory_order_relaxed);
+}
+
+void BasicPcSampleTable::Reset() {
+  for (Slot& slot : slots_) {
+    slot.pc.store(0, std::memory_order_relaxed);
+    slot.caller.store(0, std::memory_order_relaxed);
+    slot.count.store(0, std::memory_order_relaxed);
+  }
+  total_samples_.store(0, std::memory_order_relaxed);
+  dropped_samples_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace pw::cpu_exception::cortex_m::internal
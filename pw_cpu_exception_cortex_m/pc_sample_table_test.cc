@@ -0,0 +1,113 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_cpu_exception_cortex_m/pc_sample_table.h"
+
+#include <algorithm>
+
+#include "pw_containers/vector.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::cpu_exception::cortex_m {
+namespace {
+
+// Returns the table's samples, sorted by PC and caller.
+template <typename Table>
+Vector<PcSample, 16> Samples(const Table& table) {
+  Vector<PcSample, 16> samples;
+  table.ForEachSample(
+      [&samples](const PcSample& sample) { samples.push_back(sample); });
+  std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+    return a.pc != b.pc ? a.pc < b.pc : a.caller < b.caller;
+  });
+  return samples;
+}
+
+TEST(PcSampleTable, CountsSamplesOfEachPc) {
+  PcSampleTable<8> table;
+  table.Record(0x1000, 0);
+  table.Record(0x2002, 0);
+  table.Record(0x1000, 0);
+  table.Record(0x1000, 0);
+
+  Vector<PcSample, 16> samples = Samples(table);
+  ASSERT_EQ(samples.size(), 2u);
+  EXPECT_EQ(samples[0].pc, 0x1000u);
+  EXPECT_EQ(samples[0].count, 3u);
+  EXPECT_EQ(samples[1].pc, 0x2002u);
+  EXPECT_EQ(samples[1].count, 1u);
+  EXPECT_EQ(table.total_samples(), 4u);
+  EXPECT_EQ(table.dropped_samples(), 0u);
+}
+
+TEST(PcSampleTable, CountsCallersSeparately) {
+  PcSampleTable<8> table;
+  table.Record(0x1000, 0x3000);
+  table.Record(0x1000, 0x4000);
+  table.Record(0x1000, 0x4000);
+
+  Vector<PcSample, 16> samples = Samples(table);
+  ASSERT_EQ(samples.size(), 2u);
+  EXPECT_EQ(samples[0].caller, 0x3000u);
+  EXPECT_EQ(samples[0].count, 1u);
+  EXPECT_EQ(samples[1].caller, 0x4000u);
+  EXPECT_EQ(samples[1].count, 2u);
+}
+
+TEST(PcSampleTable, DropsSamplesWhenFull) {
+  PcSampleTable<4> table;
+  for (uint32_t pc = 0x1000; pc < 0x1000 + 5 * 2; pc += 2) {
+    table.Record(pc, 0);
+  }
+  // Samples of PCs already in the table are still counted.
+  table.Record(0x1000, 0);
+
+  EXPECT_EQ(Samples(table).size(), 4u);
+  EXPECT_EQ(table.total_samples(), 6u);
+  EXPECT_EQ(table.dropped_samples(), 1u);
+}
+
+TEST(PcSampleTable, ClearCountsKeepsSlots) {
+  PcSampleTable<2> table;
+  table.Record(0x1000, 0);
+  table.Record(0x2000, 0);
+  table.ClearCounts();
+
+  EXPECT_EQ(Samples(table).size(), 0u);
+  EXPECT_EQ(table.total_samples(), 0u);
+
+  table.Record(0x2000, 0);
+  table.Record(0x3000, 0);
+  Vector<PcSample, 16> samples = Samples(table);
+  ASSERT_EQ(samples.size(), 1u);
+  EXPECT_EQ(samples[0].pc, 0x2000u);
+  EXPECT_EQ(samples[0].count, 1u);
+  EXPECT_EQ(table.dropped_samples(), 1u);
+}
+
+TEST(PcSampleTable, ResetFreesSlots) {
+  PcSampleTable<1> table;
+  table.Record(0x1000, 0);
+  table.Reset();
+  table.Record(0x2000, 0);
+
+  Vector<PcSample, 16> samples = Samples(table);
+  ASSERT_EQ(samples.size(), 1u);
+  EXPECT_EQ(samples[0].pc, 0x2000u);
+  EXPECT_EQ(table.dropped_samples(), 0u);
+}
+
+}  // namespace
+}  // namespace pw::cpu_exception::cortex_m
@@ -0,0 +1,76 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_cpu_exception_cortex_m/pc_sampler.h"
+
+#include <atomic>
+
+#include "pw_cpu_exception_cortex_m/cpu_state.h"
+#include "pw_preprocessor/compiler.h"
+
+namespace pw::cpu_exception::cortex_m {
+namespace {
+
+std::atomic<internal::BasicPcSampleTable*> active_table{nullptr};
+PcSamplingOptions active_options;
+
+}  // namespace
+
+void StartPcSampling(internal::BasicPcSampleTable& table,
+                     const PcSamplingOptions& options) {
+  StopPcSampling();
+  active_options = options;
+  active_table.store(&table, std::memory_order_release);
+}
+
+void StopPcSampling() {
+  active_table.store(nullptr, std::memory_order_release);
+}
+
+}  // namespace pw::cpu_exception::cortex_m
+
+// Called by pw_cpu_exception_cortex_m_SamplePcIsr with the registers that the
+// CPU pushed when the sampling interrupt was taken.
+PW_EXTERN_C void pw_cpu_exception_cortex_m_RecordPcSample(
+    const pw::cpu_exception::cortex_m::ExceptionRegisters* frame) {
+  using namespace pw::cpu_exception::cortex_m;
+
+  internal::BasicPcSampleTable* table =
+      active_table.load(std::memory_order_acquire);
+  if (table != nullptr) {
+    table->Record(frame->pc, active_options.sample_callers ? frame->lr : 0);
+  }
+  if (active_options.acknowledge_interrupt != nullptr) {
+    active_options.acknowledge_interrupt();
+  }
+}
+
+// Finds the stacked registers, then tail-calls the sample handler, which
+// returns from the interrupt through the EXC_RETURN value still in lr.
+PW_NO_PROLOGUE void pw_cpu_exception_cortex_m_SamplePcIsr(void) {
+  asm volatile(
+      // clang-format off
+      // Stack flag is bit index 2 (0x4) of exc_return value stored in lr. When
+      // this bit is set, the Process Stack Pointer (PSP) was in use, so the CPU
+      // pushed the interrupted registers there. Otherwise, they are on the Main
+      // Stack Pointer (MSP). (See ARMv7-M Section B1.5.8 for more details)
+      " tst lr, #(1 << 2)                                     \n"
+      " ite eq                                                \n"
+      " mrseq r0, msp                                         \n"
+      " mrsne r0, psp                                         \n"
+      " b pw_cpu_exception_cortex_m_RecordPcSample            \n"
+      // clang-format on
+  );
+}
@@ -0,0 +1,39 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include "pw_bytes/span.h"
+#include "pw_cpu_exception_cortex_m/pc_sample_table.h"
+#include "pw_cpu_exception_cortex_m_protos/pc_samples.raw_rpc.pb.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+
+namespace pw::cpu_exception::cortex_m {
+
+// Sends the samples in a PcSampleTable when requested by GetSamples(). Like
+// pw_metric's MetricService, the samples are all sent from the RPC thread
+// before GetSamples() returns.
+class PcSampleService final
+    : public pw_rpc::raw::PcSampler::Service<PcSampleService> {
+ public:
+  explicit PcSampleService(internal::BasicPcSampleTable& table)
+      : table_(table) {}
+
+  void GetSamples(ConstByteSpan request, rpc::RawServerWriter& writer);
+
+ private:
+  internal::BasicPcSampleTable& table_;
+};
+
+}  // namespace pw::cpu_exception::cortex_m
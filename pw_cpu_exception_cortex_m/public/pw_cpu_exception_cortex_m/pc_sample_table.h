@@ -0,0 +1,123 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_span/span.h"
+
+namespace pw::cpu_exception::cortex_m {
+
+// The number of times a PC, and optionally its caller, was sampled.
+struct PcSample {
+  uint32_t pc;
+  uint32_t caller;  // 0 if callers aren't sampled.
+  uint32_t count;
+};
+
+namespace internal {
+
+// The storage-independent logic of a PcSampleTable.
+class BasicPcSampleTable {
+ public:
+  // Linear probing stops after this many slots, so that recording a sample
+  // takes a bounded time. Samples that don't find a slot are dropped.
+  static constexpr size_t kMaxProbes = 16;
+
+  BasicPcSampleTable(const BasicPcSampleTable&) = delete;
+  BasicPcSampleTable& operator=(const BasicPcSampleTable&) = delete;
+
+  // Counts a sample of `pc` called from `caller`. This must only be called
+  // from one context at a time, such as a single sampling interrupt.
+  void Record(uint32_t pc, uint32_t caller);
+
+  // Calls `function` with each sample that has been counted since the last
+  // ClearCounts() or Reset(). This may be called while samples are recorded,
+  // in which case it sees each sample's count at the time it's read.
+  template <typename Function>
+  void ForEachSample(Function&& function) const {
+    for (const Slot& slot : slots_) {
+      const uint32_t pc = slot.pc.load(std::memory_order_acquire);
+      const uint32_t count = slot.count.load(std::memory_order_relaxed);
+      if (pc != 0 && count != 0) {
+        function(PcSample{
+            pc, slot.caller.load(std::memory_order_relaxed), count});
+      }
+    }
+  }
+
+  // Resets every sample's count to zero, while keeping their slots. This may
+  // be called while samples are recorded, though a sample recorded at the
+  // same time may be lost.
+  void ClearCounts();
+
+  // Removes all samples. This must not be called while samples are recorded.
+  void Reset();
+
+  // The number of samples recorded, including dropped samples.
+  uint32_t total_samples() const {
+    return total_samples_.load(std::memory_order_relaxed);
+  }
+
+  // The number of samples dropped because the table was full.
+  uint32_t dropped_samples() const {
+    return dropped_samples_.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  struct Slot {
+    std::atomic<uint32_t> pc{0};  // 0 if unused.
+    std::atomic<uint32_t> caller{0};
+    std::atomic<uint32_t> count{0};
+  };
+
+  constexpr BasicPcSampleTable(span<Slot> slots) : slots_(slots) {}
+
+ private:
+  static void Increment(std::atomic<uint32_t>& value) {
+    // There is only one writer, so a read-modify-write isn't needed.
+    value.store(value.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+  }
+
+  span<Slot> slots_;
+  std::atomic<uint32_t> total_samples_{0};
+  std::atomic<uint32_t> dropped_samples_{0};
+};
+
+}  // namespace internal
+
+// A fixed-size hash table that counts how often each PC is sampled by a
+// statistical profiler. Each distinct PC (and caller, if sampled) takes one
+// of kCapacity slots, and samples are recorded without locks or allocation,
+// so they may be recorded from an interrupt.
+//
+// Hot functions contain few distinct PCs relative to their samples, so a few
+// hundred slots are typically enough to profile a firmware image.
+template <size_t kCapacity>
+class PcSampleTable : public internal::BasicPcSampleTable {
+ public:
+  static_assert(kCapacity > 0);
+
+  constexpr PcSampleTable() : BasicPcSampleTable(slots_) {}
+
+ private:
+  std::array<Slot, kCapacity> slots_;
+};
+
+}  // namespace pw::cpu_exception::cortex_m
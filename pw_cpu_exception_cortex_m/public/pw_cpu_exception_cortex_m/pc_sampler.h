@@ -0,0 +1,57 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+// A statistical profiler that samples the PC interrupted by a periodic
+// interrupt. To use it, route a timer interrupt, such as SysTick, to
+// pw_cpu_exception_cortex_m_SamplePcIsr, and call StartPcSampling() with a
+// PcSampleTable to collect the samples in.
+
+#include "pw_cpu_exception_cortex_m/pc_sample_table.h"
+#include "pw_preprocessor/util.h"
+
+namespace pw::cpu_exception::cortex_m {
+
+struct PcSamplingOptions {
+  // Whether to also record the interrupted LR with each PC. For a leaf
+  // function this is its caller, so this gives one level of call stack, at
+  // the cost of more slots per function. In non-leaf functions the LR may be
+  // stale.
+  bool sample_callers = false;
+
+  // Called after each sample is recorded, for timers whose interrupt must be
+  // acknowledged. May be null.
+  void (*acknowledge_interrupt)() = nullptr;
+};
+
+// Starts recording samples into `table`, which must outlive sampling. The
+// sampling interrupt also reads the options, so call this before the
+// interrupt is enabled, or while it is masked.
+void StartPcSampling(internal::BasicPcSampleTable& table,
+                     const PcSamplingOptions& options = {});
+
+// Stops recording samples. Once this returns, the table is no longer written.
+void StopPcSampling();
+
+}  // namespace pw::cpu_exception::cortex_m
+
+PW_EXTERN_C_START
+
+// The sampling interrupt handler. This reads the PC from the registers the CPU
+// stacked on interrupt entry, so it must be installed directly in the vector
+// table rather than called from another handler.
+void pw_cpu_exception_cortex_m_SamplePcIsr(void);
+
+PW_EXTERN_C_END
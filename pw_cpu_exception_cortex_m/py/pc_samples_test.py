@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Tests summarizing PC samples."""
+
+import textwrap
+import unittest
+from typing import NamedTuple
+
+from pw_cpu_exception_cortex_m import pc_samples
+import pw_symbolizer
+
+
+class _Sample(NamedTuple):
+    pc: int
+    caller: int
+    count: int
+
+
+_SYMBOLIZER = pw_symbolizer.FakeSymbolizer(
+    [
+        pw_symbolizer.Symbol(0x1000, 'Compute'),
+        pw_symbolizer.Symbol(0x1002, 'Compute'),
+        pw_symbolizer.Symbol(0x2000, 'Idle'),
+        pw_symbolizer.Symbol(0x3001, 'MainLoop'),
+    ]
+)
+
+
+class SamplesByFunctionTest(unittest.TestCase):
+    """Tests totaling samples by function."""
+
+    def test_totals_pcs_in_the_same_function(self):
+        functions = pc_samples.samples_by_function(
+            [
+                _Sample(pc=0x2000, caller=0, count=3),
+                _Sample(pc=0x1000, caller=0, count=2),
+                _Sample(pc=0x1002, caller=0, count=4),
+            ],
+            _SYMBOLIZER,
+        )
+        self.assertEqual(
+            [(f.name, f.count) for f in functions],
+            [('Compute', 6), ('Idle', 3)],
+        )
+
+    def test_unknown_pcs_are_named_by_address(self):
+        functions = pc_samples.samples_by_function(
+            [_Sample(pc=0xABCD, caller=0, count=1)], _SYMBOLIZER
+        )
+        self.assertEqual(functions[0].name, '0x0000ABCD')
+
+    def test_totals_callers(self):
+        # MainLoop's return address is 0x3003 with the Thumb bit set, which
+        # symbolizes at the call instruction, 0x3001.
+        functions = pc_samples.samples_by_function(
+            [
+                _Sample(pc=0x1000, caller=0x3003, count=2),
+                _Sample(pc=0x1002, caller=0x3003, count=1),
+            ],
+            _SYMBOLIZER,
+        )
+        self.assertEqual(functions[0].callers, {'MainLoop': 3})
+
+
+class FormatReportTest(unittest.TestCase):
+    """Tests the human-readable report."""
+
+    def test_report(self):
+        functions = pc_samples.samples_by_function(
+            [
+                _Sample(pc=0x1000, caller=0x3003, count=6),
+                _Sample(pc=0x2000, caller=0, count=3),
+            ],
+            _SYMBOLIZER,
+        )
+        self.assertEqual(
+            pc_samples.format_report(functions, dropped_samples=1),
+            textwrap.dedent(
+                '''\
+                10 samples, 1 dropped
+                 60.00%        6 Compute
+                                        6   from MainLoop
+                 30.00%        3 Idle'''
+            ),
+        )
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,76 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Summarizes samples from the Cortex-M PC sampling profiler."""
+
+from dataclasses import dataclass, field
+from typing import Any, Dict, Iterable, List
+
+import pw_symbolizer
+
+
+@dataclass
+class FunctionSamples:
+    """The samples of PCs within one function."""
+
+    name: str
+    count: int = 0
+    callers: Dict[str, int] = field(default_factory=dict)
+
+
+def _function_name(symbolizer: pw_symbolizer.Symbolizer, address: int) -> str:
+    symbol = symbolizer.symbolize(address)
+    return symbol.name if symbol.name else f'0x{address:08X}'
+
+
+def samples_by_function(
+    samples: Iterable[Any], symbolizer: pw_symbolizer.Symbolizer
+) -> List[FunctionSamples]:
+    """Totals PcSample protos by the function containing each PC.
+
+    Returns the functions with the most samples first.
+    """
+    functions: Dict[str, FunctionSamples] = {}
+    for sample in samples:
+        name = _function_name(symbolizer, sample.pc)
+        function = functions.setdefault(name, FunctionSamples(name))
+        function.count += sample.count
+
+        if sample.caller:
+            # The LR is a Thumb return address, so clear the Thumb bit and step
+            # back into the call instruction, which is in the calling function.
+            caller = _function_name(symbolizer, (sample.caller & ~1) - 1)
+            function.callers[caller] = (
+                function.callers.get(caller, 0) + sample.count
+            )
+
+    return sorted(functions.values(), key=lambda f: f.count, reverse=True)
+
+
+def format_report(
+    functions: List[FunctionSamples],
+    dropped_samples: int = 0,
+    max_functions: int = 20,
+) -> str:
+    """Formats the hottest functions as a human-readable table."""
+    total = sum(function.count for function in functions) + dropped_samples
+    lines = [f'{total} samples, {dropped_samples} dropped']
+    for function in functions[:max_functions]:
+        percent = 100 * function.count / total if total else 0
+        lines.append(f'{percent:6.2f}% {function.count:8} {function.name}')
+        callers = sorted(
+            function.callers.items(), key=lambda item: item[1], reverse=True
+        )
+        for caller, count in callers:
+            lines.append(f'{"":17}{count:8}   from {caller}')
+    return '\n'.join(lines)
@@ -37,45 +37,25 @@ class Defer {
 
 constexpr size_t kP256CurveOrderBytes = 32;
 
-Status VerifyP256Signature(ConstByteSpan public_key,
-                           ConstByteSpan digest,
-                           ConstByteSpan signature) {
-  // Use a local structure to avoid going over the default inline storage
-  // for the `cleanup` callable used below.
-  struct {
-    // The elliptic curve group.
-    mbedtls_ecp_group grp;
-    // The public key point.
-    mbedtls_ecp_point Q;
-    // The signature (r, s).
-    mbedtls_mpi r, s;
-  } ctx;
-
-  const uint8_t* public_key_data =
-      reinterpret_cast<const uint8_t*>(public_key.data());
-  const uint8_t* digest_data = reinterpret_cast<const uint8_t*>(digest.data());
-  const uint8_t* signature_data =
-      reinterpret_cast<const uint8_t*>(signature.data());
+namespace backend {
 
+Status DoInit(NativeP256Verifier& ctx) {
   // These init functions never fail.
   mbedtls_ecp_group_init(&ctx.grp);
   mbedtls_ecp_point_init(&ctx.Q);
-  mbedtls_mpi_init(&ctx.r);
-  mbedtls_mpi_init(&ctx.s);
-
-  // Auto clean up on exit.
-  Defer cleanup([&ctx](void) {
-    mbedtls_ecp_group_free(&ctx.grp);
-    mbedtls_ecp_point_free(&ctx.Q);
-    mbedtls_mpi_free(&ctx.r);
-    mbedtls_mpi_free(&ctx.s);
-  });
 
   // Load the curve parameters.
   if (mbedtls_ecp_group_load(&ctx.grp, MBEDTLS_ECP_DP_SECP256R1)) {
     return Status::Internal();
   }
 
+  return OkStatus();
+}
+
+Status DoSetPublicKey(NativeP256Verifier& ctx, ConstByteSpan public_key) {
+  const uint8_t* public_key_data =
+      reinterpret_cast<const uint8_t*>(public_key.data());
+
   // Load the public key.
   if (mbedtls_ecp_point_read_binary(
           &ctx.grp, &ctx.Q, public_key_data, public_key.size())) {
@@ -83,14 +63,47 @@ Status VerifyP256Signature(ConstByteSpan public_key,
     return Status::InvalidArgument();
   }
 
+  // Make sure the public key is on the curve.
+  if (mbedtls_ecp_check_pubkey(&ctx.grp, &ctx.Q)) {
+    PW_LOG_DEBUG("Bad public key curve");
+    return Status::InvalidArgument();
+  }
+
+  return OkStatus();
+}
+
+Status DoVerify(NativeP256Verifier& ctx,
+                ConstByteSpan digest,
+                ConstByteSpan signature) {
+  const uint8_t* digest_data = reinterpret_cast<const uint8_t*>(digest.data());
+  const uint8_t* signature_data =
+      reinterpret_cast<const uint8_t*>(signature.data());
+
+  // Use a local structure to avoid going over the default inline storage
+  // for the `cleanup` callable used below.
+  struct {
+    // The signature (r, s).
+    mbedtls_mpi r, s;
+  } sig;
+
+  // These init functions never fail.
+  mbedtls_mpi_init(&sig.r);
+  mbedtls_mpi_init(&sig.s);
+
+  // Auto clean up on exit.
+  Defer cleanup([&sig](void) {
+    mbedtls_mpi_free(&sig.r);
+    mbedtls_mpi_free(&sig.s);
+  });
+
   // Load the signature.
   if (signature.size() != kP256CurveOrderBytes * 2) {
     PW_LOG_DEBUG("Bad signature format");
     return Status::InvalidArgument();
   }
 
-  if (mbedtls_mpi_read_binary(&ctx.r, signature_data, kP256CurveOrderBytes) ||
-      mbedtls_mpi_read_binary(&ctx.s,
+  if (mbedtls_mpi_read_binary(&sig.r, signature_data, kP256CurveOrderBytes) ||
+      mbedtls_mpi_read_binary(&sig.s,
                               signature_data + kP256CurveOrderBytes,
                               kP256CurveOrderBytes)) {
     return Status::Internal();
@@ -104,7 +117,7 @@ Status VerifyP256Signature(ConstByteSpan public_key,
 
   // Verify the signature.
   if (mbedtls_ecdsa_verify(
-          &ctx.grp, digest_data, digest.size(), &ctx.Q, &ctx.r, &ctx.s)) {
+          &ctx.grp, digest_data, digest.size(), &ctx.Q, &sig.r, &sig.s)) {
     PW_LOG_DEBUG("Signature verification failed");
     return Status::Unauthenticated();
   }
@@ -112,4 +125,11 @@ Status VerifyP256Signature(ConstByteSpan public_key,
   return OkStatus();
 }
 
+void DoDeinit(NativeP256Verifier& ctx) {
+  mbedtls_ecp_group_free(&ctx.grp);
+  mbedtls_ecp_point_free(&ctx.Q);
+}
+
+}  // namespace backend
+
 }  // namespace pw::crypto::ecdsa
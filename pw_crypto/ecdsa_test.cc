@@ -159,5 +159,60 @@ TEST(EcdsaP256, TamperedPubkey) {
                                   AS_BYTES(TEST_SIGNATURE)));
 }
 
+TEST(P256Verifier, VerifyWithoutKeyFails) {
+  P256Verifier verifier;
+  ASSERT_EQ(Status::FailedPrecondition(),
+            verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+}
+
+TEST(P256Verifier, VerifiesRepeatedly) {
+  P256Verifier verifier;
+  ASSERT_OK(verifier.SetPublicKey(AS_BYTES(TEST_PUBKEY)));
+  ASSERT_OK(verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+  ASSERT_EQ(
+      Status::Unauthenticated(),
+      verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TAMPERED_SIGNATURE)));
+  ASSERT_EQ(
+      Status::Unauthenticated(),
+      verifier.Verify(AS_BYTES(TAMPERED_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+  ASSERT_EQ(Status::InvalidArgument(),
+            verifier.Verify(AS_BYTES(SHORT_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+  ASSERT_EQ(Status::InvalidArgument(),
+            verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(SHORT_SIGNATURE)));
+  ASSERT_OK(verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+}
+
+TEST(P256Verifier, MalformedPublicKey) {
+  P256Verifier verifier;
+  ASSERT_EQ(Status::InvalidArgument(),
+            verifier.SetPublicKey(AS_BYTES(MALFORMED_PUBKEY_MISSING_HEADER)));
+  ASSERT_EQ(Status::FailedPrecondition(),
+            verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+}
+
+TEST(P256Verifier, FailedRekeyClearsKey) {
+  P256Verifier verifier;
+  ASSERT_OK(verifier.SetPublicKey(AS_BYTES(TEST_PUBKEY)));
+  ASSERT_FAIL(verifier.SetPublicKey(AS_BYTES(MALFORMED_PUBKEY_WRONG_HEADER)));
+  ASSERT_EQ(Status::FailedPrecondition(),
+            verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+}
+
+TEST(P256Verifier, Rekey) {
+  P256Verifier verifier;
+  ASSERT_OK(verifier.SetPublicKey(AS_BYTES(TEST_PUBKEY)));
+  ASSERT_OK(verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+
+  // A key that parses but is not the signer's key fails verification.
+  Status status = verifier.SetPublicKey(AS_BYTES(TAMPERED_PUBKEY));
+  if (status.ok()) {
+    ASSERT_FAIL(
+        verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+  }
+
+  ASSERT_OK(verifier.SetPublicKey(AS_BYTES(TEST_PUBKEY)));
+  ASSERT_OK(verifier.Verify(AS_BYTES(TEST_DIGEST), AS_BYTES(TEST_SIGNATURE)));
+}
+
 }  // namespace
 }  // namespace pw::crypto::ecdsa
@@ -14,6 +14,7 @@
 #define PW_LOG_MODULE_NAME "ECDSA-UECC"
 #define PW_LOG_LEVEL PW_LOG_LEVEL_WARN
 
+#include <algorithm>
 #include <cstring>
 
 #include "pw_crypto/ecdsa.h"
@@ -26,15 +27,14 @@ constexpr size_t kP256CurveOrderBytes = 32;
 constexpr size_t kP256PublicKeySize = 2 * kP256CurveOrderBytes + 1;
 constexpr size_t kP256SignatureSize = kP256CurveOrderBytes * 2;
 
-Status VerifyP256Signature(ConstByteSpan public_key,
-                           ConstByteSpan digest,
-                           ConstByteSpan signature) {
-  // Signature expected in raw format (r||s)
-  if (signature.size() != kP256SignatureSize) {
-    PW_LOG_DEBUG("Bad signature format");
-    return Status::InvalidArgument();
-  }
+namespace backend {
 
+Status DoInit(NativeP256Verifier& ctx) {
+  ctx.curve = uECC_secp256r1();
+  return OkStatus();
+}
+
+Status DoSetPublicKey(NativeP256Verifier& ctx, ConstByteSpan public_key) {
   // Supports SEC 1 uncompressed form (04||X||Y) only.
   if (public_key.size() != kP256PublicKeySize ||
       std::to_integer<uint8_t>(public_key.data()[0]) != 0x04) {
@@ -42,59 +42,70 @@ Status VerifyP256Signature(ConstByteSpan public_key,
     return Status::InvalidArgument();
   }
 
+  static_assert(sizeof(ctx.public_key) == kP256PublicKeySize - 1);
+  memcpy(ctx.public_key, public_key.data() + 1, sizeof(ctx.public_key));
+
 #if defined(uECC_VLI_NATIVE_LITTLE_ENDIAN) && uECC_VLI_NATIVE_LITTLE_ENDIAN
   // uECC_VLI_NATIVE_LITTLE_ENDIAN is defined with a non-zero value when
   // pw_crypto_ECDSA_BACKEND is set to "//pw_crypto:ecdsa_uecc_little_endian".
   //
   // Since pw_crypto APIs are big endian only (standard practice), here we
   // need to convert input parameters to little endian.
-  //
-  // Additionally uECC requires these little endian buffers to be word aligned
-  // in case unaligned accesses are not supported by the hardware. We choose
-  // the maximum 8-byte alignment to avoid referrencing internal uECC headers.
+  std::reverse(ctx.public_key, ctx.public_key + kP256CurveOrderBytes);  // X
+  std::reverse(ctx.public_key + kP256CurveOrderBytes,
+               ctx.public_key + sizeof(ctx.public_key));  // Y
+#endif  // uECC_VLI_NATIVE_LITTLE_ENDIAN
+
+  // Make sure the public key is on the curve.
+  if (!uECC_valid_public_key(ctx.public_key, ctx.curve)) {
+    PW_LOG_DEBUG("Bad public key curve");
+    return Status::InvalidArgument();
+  }
+
+  return OkStatus();
+}
+
+Status DoVerify(NativeP256Verifier& ctx,
+                ConstByteSpan digest,
+                ConstByteSpan signature) {
+  // Signature expected in raw format (r||s)
+  if (signature.size() != kP256SignatureSize) {
+    PW_LOG_DEBUG("Bad signature format");
+    return Status::InvalidArgument();
+  }
+
+  // Digests must be at least 32 bytes. Digests longer than 32
+  // bytes are truncated to 32 bytes.
+  if (digest.size() < kP256CurveOrderBytes) {
+    PW_LOG_DEBUG("Digest is too short");
+    return Status::InvalidArgument();
+  }
+  digest = digest.first(kP256CurveOrderBytes);
+
+#if defined(uECC_VLI_NATIVE_LITTLE_ENDIAN) && uECC_VLI_NATIVE_LITTLE_ENDIAN
+  // Convert the big endian inputs to word-aligned little endian buffers, as
+  // for the public key.
   alignas(8) uint8_t signature_bytes[kP256SignatureSize];
   memcpy(signature_bytes, signature.data(), sizeof(signature_bytes));
   std::reverse(signature_bytes, signature_bytes + kP256CurveOrderBytes);  // r
   std::reverse(signature_bytes + kP256CurveOrderBytes,
                signature_bytes + sizeof(signature_bytes));  // s
 
-  alignas(8) uint8_t public_key_bytes[kP256PublicKeySize - 1];
-  memcpy(public_key_bytes, public_key.data() + 1, sizeof(public_key_bytes));
-  std::reverse(public_key_bytes, public_key_bytes + kP256CurveOrderBytes);  // X
-  std::reverse(public_key_bytes + kP256CurveOrderBytes,
-               public_key_bytes + sizeof(public_key_bytes));  // Y
-
   alignas(8) uint8_t digest_bytes[kP256CurveOrderBytes];
   memcpy(digest_bytes, digest.data(), sizeof(digest_bytes));
   std::reverse(digest_bytes, digest_bytes + sizeof(digest_bytes));
 #else
-  const uint8_t* public_key_bytes =
-      reinterpret_cast<const uint8_t*>(public_key.data()) + 1;
   const uint8_t* digest_bytes = reinterpret_cast<const uint8_t*>(digest.data());
   const uint8_t* signature_bytes =
       reinterpret_cast<const uint8_t*>(signature.data());
 #endif  // uECC_VLI_NATIVE_LITTLE_ENDIAN
 
-  uECC_Curve curve = uECC_secp256r1();
-  // Make sure the public key is on the curve.
-  if (!uECC_valid_public_key(public_key_bytes, curve)) {
-    PW_LOG_DEBUG("Bad public key curve");
-    return Status::InvalidArgument();
-  }
-
-  // Digests must be at least 32 bytes. Digests longer than 32
-  // bytes are truncated to 32 bytes.
-  if (digest.size() < kP256CurveOrderBytes) {
-    PW_LOG_DEBUG("Digest is too short");
-    return Status::InvalidArgument();
-  }
-
   // Verify the signature.
-  if (!uECC_verify(public_key_bytes,
+  if (!uECC_verify(ctx.public_key,
                    digest_bytes,
                    digest.size(),
                    signature_bytes,
-                   curve)) {
+                   ctx.curve)) {
     PW_LOG_DEBUG("Signature verification failed");
     return Status::Unauthenticated();
   }
@@ -102,4 +113,8 @@ Status VerifyP256Signature(ConstByteSpan public_key,
   return OkStatus();
 }
 
+void DoDeinit(NativeP256Verifier&) {}
+
+}  // namespace backend
+
 }  // namespace pw::crypto::ecdsa
@@ -15,10 +15,98 @@
 #pragma once
 
 #include "pw_bytes/span.h"
+#include "pw_crypto/ecdsa_backend.h"
 #include "pw_status/status.h"
 
 namespace pw::crypto::ecdsa {
 
+namespace backend {
+
+// Primitive operations to be implemented by backends.
+Status DoInit(NativeP256Verifier& ctx);
+Status DoSetPublicKey(NativeP256Verifier& ctx, ConstByteSpan public_key);
+Status DoVerify(NativeP256Verifier& ctx,
+                ConstByteSpan digest,
+                ConstByteSpan signature);
+void DoDeinit(NativeP256Verifier& ctx);
+
+}  // namespace backend
+
+/// Verifies ECDSA signatures over the NIST P256 curve against one public key.
+///
+/// The public key is parsed and validated once, in `SetPublicKey()`, and the
+/// backend keeps the curve parameters, along with any tables it precomputes
+/// from them, for the lifetime of the verifier. Use a `P256Verifier` instead
+/// of repeated `VerifyP256Signature()` calls when checking several signatures,
+/// e.g. the signatures of a bundle against a set of trusted keys.
+///
+/// Usage:
+///
+/// @code{.cpp}
+/// pw::crypto::ecdsa::P256Verifier verifier;
+/// if (!verifier.SetPublicKey(public_key).ok()) {
+///     // handle errors.
+/// }
+///
+/// for (pw::ConstByteSpan signature : signatures) {
+///   if (verifier.Verify(digest, signature).ok()) {
+///     // A signature is valid.
+///   }
+/// }
+/// @endcode
+class P256Verifier {
+ public:
+  P256Verifier() : has_key_(false) {
+    ready_ = backend::DoInit(native_ctx_).ok();
+  }
+
+  ~P256Verifier() { backend::DoDeinit(native_ctx_); }
+
+  P256Verifier(const P256Verifier&) = delete;
+  P256Verifier& operator=(const P256Verifier&) = delete;
+
+  /// Parses and validates `public_key`, replacing any previous key.
+  ///
+  /// @param[in] public_key A byte string in SEC 1 uncompressed form
+  /// ``(0x04||X||Y)``, which is exactly 65 bytes.
+  ///
+  /// @returns @pw_status{OK} if the key was loaded,
+  /// @pw_status{INVALID_ARGUMENT} if the key is malformed or not on the curve, or
+  /// @pw_status{FAILED_PRECONDITION} if the backend failed to initialize.
+  /// On failure, the verifier has no key until the next successful call.
+  Status SetPublicKey(ConstByteSpan public_key) {
+    if (!ready_) {
+      return Status::FailedPrecondition();
+    }
+    Status status = backend::DoSetPublicKey(native_ctx_, public_key);
+    has_key_ = status.ok();
+    return status;
+  }
+
+  /// Verifies the `signature` of `digest` using the current public key.
+  ///
+  /// @param[in] digest A raw byte string, truncated to 32 bytes.
+  ///
+  /// @param[in] signature A raw byte string ``(r||s)`` of exactly 64 bytes.
+  ///
+  /// @returns @pw_status{OK} for a successful verification,
+  /// @pw_status{UNAUTHENTICATED} if the signature does not match,
+  /// @pw_status{INVALID_ARGUMENT} if `digest` or `signature` is malformed,
+  /// or @pw_status{FAILED_PRECONDITION} if no public key is loaded.
+  Status Verify(ConstByteSpan digest, ConstByteSpan signature) {
+    if (!has_key_) {
+      return Status::FailedPrecondition();
+    }
+    return backend::DoVerify(native_ctx_, digest, signature);
+  }
+
+ private:
+  bool ready_;
+  bool has_key_;
+  // Backend-specific context.
+  backend::NativeP256Verifier native_ctx_;
+};
+
 /// Verifies the `signature` of `digest` using `public_key`.
 ///
 /// Example:
@@ -48,8 +136,14 @@ namespace pw::crypto::ecdsa {
 ///
 /// @returns @pw_status{OK} for a successful verification, or an error
 /// ``Status`` otherwise.
-Status VerifyP256Signature(ConstByteSpan public_key,
-                           ConstByteSpan digest,
-                           ConstByteSpan signature);
+inline Status VerifyP256Signature(ConstByteSpan public_key,
+                                  ConstByteSpan digest,
+                                  ConstByteSpan signature) {
+  P256Verifier verifier;
+  if (Status status = verifier.SetPublicKey(public_key); !status.ok()) {
+    return status;
+  }
+  return verifier.Verify(digest, signature);
+}
 
 }  // namespace pw::crypto::ecdsa
@@ -0,0 +1,32 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "uECC.h"
+
+namespace pw::crypto::ecdsa::backend {
+
+struct NativeP256Verifier {
+  uECC_Curve curve;
+  // The validated public key (X||Y), in the byte order uECC expects. uECC
+  // requires word alignment in case unaligned accesses are not supported by
+  // the hardware. The maximum 8-byte alignment avoids referencing internal
+  // uECC headers.
+  alignas(8) uint8_t public_key[64];
+};
+
+}  // namespace pw::crypto::ecdsa::backend
@@ -182,4 +182,39 @@ inline Status Hash(stream::Reader& reader, ByteSpan out_digest) {
   return sha256.Final(out_digest);
 }
 
+/// Calculates the SHA256 digest of the content of `reader`, reading it in
+/// chunks the size of `buffer`, and stores the result in `out_digest`.
+/// `out_digest` must be at least `kDigestSizeBytes` long.
+///
+/// Reading large chunks reduces the per-call overhead of both the reader and
+/// the backend, which can process whole blocks directly from `buffer`.
+///
+/// @code{.cpp}
+/// std::array<std::byte, 4096> buffer;
+/// std::byte digest[32];
+/// if (!pw::crypto::sha256::Hash(reader, buffer, digest).ok()) {
+///     // Handle errors.
+/// }
+/// @endcode
+inline Status Hash(stream::Reader& reader,
+                   ByteSpan buffer,
+                   ByteSpan out_digest) {
+  if (out_digest.size() < kDigestSizeBytes || buffer.empty()) {
+    return Status::InvalidArgument();
+  }
+
+  Sha256 sha256;
+  while (true) {
+    Result<ByteSpan> res = reader.Read(buffer);
+    if (res.status().IsOutOfRange()) {
+      break;
+    }
+
+    PW_TRY(res.status());
+    sha256.Update(res.value());
+  }
+
+  return sha256.Final(out_digest);
+}
+
 }  // namespace pw::crypto::sha256
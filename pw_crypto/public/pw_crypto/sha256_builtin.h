@@ -0,0 +1,48 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Set to 0 to always use the portable implementation of the SHA256 block
+// function, even when the target supports the ARMv8 Cryptography Extensions or
+// the x86 SHA extensions.
+#ifndef PW_CRYPTO_SHA256_BUILTIN_ACCELERATION
+#define PW_CRYPTO_SHA256_BUILTIN_ACCELERATION 1
+#endif  // PW_CRYPTO_SHA256_BUILTIN_ACCELERATION
+
+namespace pw::crypto::sha256::backend {
+
+// A SHA256 implementation with no external dependencies.
+//
+// The block function uses the SHA256 instructions of the ARMv8 Cryptography
+// Extensions when compiled for a target with them (e.g. with
+// `-march=armv8-a+crypto`), and the x86 SHA extensions when the processor
+// supports them, which is detected at runtime. Otherwise, it falls back to a
+// portable implementation.
+struct NativeSha256Context {
+  // The intermediate hash value.
+  std::array<uint32_t, 8> state;
+
+  // The number of message bytes hashed so far.
+  uint64_t total_bytes;
+
+  // Message bytes that do not yet fill a complete block.
+  std::array<std::byte, 64> block;
+};
+
+}  // namespace pw::crypto::sha256::backend
@@ -0,0 +1,328 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#define PW_LOG_MODULE_NAME "SHA256-BUILTIN"
+#define PW_LOG_LEVEL PW_LOG_LEVEL_WARN
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_crypto/sha256.h"
+#include "pw_status/status.h"
+
+#if PW_CRYPTO_SHA256_BUILTIN_ACCELERATION && defined(__ARM_FEATURE_SHA2)
+#define PW_CRYPTO_SHA256_BUILTIN_ARMV8 1
+#include <arm_neon.h>
+#elif PW_CRYPTO_SHA256_BUILTIN_ACCELERATION && \
+    (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PW_CRYPTO_SHA256_BUILTIN_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace pw::crypto::sha256::backend {
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+alignas(16) constexpr uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr std::array<uint32_t, 8> kInitialState = {
+    0x6a09e667,
+    0xbb67ae85,
+    0x3c6ef372,
+    0xa54ff53a,
+    0x510e527f,
+    0x9b05688c,
+    0x1f83d9ab,
+    0x5be0cd19,
+};
+
+constexpr uint32_t RotateRight(uint32_t value, int bits) {
+  return (value >> bits) | (value << (32 - bits));
+}
+
+uint32_t LoadBigEndian(const std::byte* data) {
+  return (static_cast<uint32_t>(data[0]) << 24) |
+         (static_cast<uint32_t>(data[1]) << 16) |
+         (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+void StoreBigEndian(uint32_t value, std::byte* data) {
+  data[0] = static_cast<std::byte>(value >> 24);
+  data[1] = static_cast<std::byte>(value >> 16);
+  data[2] = static_cast<std::byte>(value >> 8);
+  data[3] = static_cast<std::byte>(value);
+}
+
+void ProcessBlocksPortable(std::array<uint32_t, 8>& state,
+                           const std::byte* data,
+                           size_t num_blocks) {
+  for (; num_blocks > 0; --num_blocks, data += kBlockSize) {
+    uint32_t w[64];
+    for (int t = 0; t < 16; ++t) {
+      w[t] = LoadBigEndian(&data[4 * t]);
+    }
+    for (int t = 16; t < 64; ++t) {
+      const uint32_t s0 = RotateRight(w[t - 15], 7) ^
+                          RotateRight(w[t - 15], 18) ^ (w[t - 15] >> 3);
+      const uint32_t s1 = RotateRight(w[t - 2], 17) ^
+                          RotateRight(w[t - 2], 19) ^ (w[t - 2] >> 10);
+      w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+    for (int t = 0; t < 64; ++t) {
+      const uint32_t s1 =
+          RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+      const uint32_t choose = (e & f) ^ (~e & g);
+      const uint32_t temp1 = h + s1 + choose + kRoundConstants[t] + w[t];
+      const uint32_t s0 =
+          RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+      const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+      const uint32_t temp2 = s0 + majority;
+      h = g;
+      g = f;
+      f = e;
+      e = d + temp1;
+      d = c;
+      c = b;
+      b = a;
+      a = temp1 + temp2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+#if PW_CRYPTO_SHA256_BUILTIN_ARMV8
+
+void ProcessBlocksArmv8(std::array<uint32_t, 8>& state,
+                        const std::byte* data,
+                        size_t num_blocks) {
+  uint32x4_t abcd = vld1q_u32(&state[0]);
+  uint32x4_t efgh = vld1q_u32(&state[4]);
+
+  for (; num_blocks > 0; --num_blocks, data += kBlockSize) {
+    const uint32x4_t abcd_saved = abcd;
+    const uint32x4_t efgh_saved = efgh;
+
+    // Message words, in groups of four.
+    uint32x4_t msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(
+          vld1q_u8(reinterpret_cast<const uint8_t*>(&data[16 * i]))));
+    }
+
+    // Each iteration performs four rounds, and computes the message words for
+    // the rounds four iterations later.
+    for (int i = 0; i < 16; ++i) {
+      const uint32x4_t words =
+          vaddq_u32(msg[i % 4], vld1q_u32(&kRoundConstants[4 * i]));
+      if (i < 12) {
+        msg[i % 4] =
+            vsha256su1q_u32(vsha256su0q_u32(msg[i % 4], msg[(i + 1) % 4]),
+                            msg[(i + 2) % 4],
+                            msg[(i + 3) % 4]);
+      }
+      const uint32x4_t abcd_previous = abcd;
+      abcd = vsha256hq_u32(abcd, efgh, words);
+      efgh = vsha256h2q_u32(efgh, abcd_previous, words);
+    }
+
+    abcd = vaddq_u32(abcd, abcd_saved);
+    efgh = vaddq_u32(efgh, efgh_saved);
+  }
+
+  vst1q_u32(&state[0], abcd);
+  vst1q_u32(&state[4], efgh);
+}
+
+#elif PW_CRYPTO_SHA256_BUILTIN_X86
+
+bool HasShaExtensions() {
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  const bool has_ssse3 = (ecx & bit_SSSE3) != 0;
+  const bool has_sse4_1 = (ecx & bit_SSE4_1) != 0;
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  return has_ssse3 && has_sse4_1 && (ebx & bit_SHA) != 0;
+}
+
+__attribute__((target("sha,sse4.1,ssse3"))) void ProcessBlocksX86(
+    std::array<uint32_t, 8>& state, const std::byte* data, size_t num_blocks) {
+  // The SHA instructions operate on the state as ABEF and CDGH.
+  const __m128i byte_swap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+  __m128i efgh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+  const __m128i cdab = _mm_shuffle_epi32(abcd, 0xb1);
+  efgh = _mm_shuffle_epi32(efgh, 0x1b);
+  __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+  __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+  for (; num_blocks > 0; --num_blocks, data += kBlockSize) {
+    const __m128i abef_saved = abef;
+    const __m128i cdgh_saved = cdgh;
+
+    // Message words, in groups of four.
+    __m128i msg[4];
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[16 * i])),
+          byte_swap);
+    }
+
+    // Each iteration performs four rounds, and computes the message words for
+    // the rounds four iterations later.
+    for (int i = 0; i < 16; ++i) {
+      __m128i words = _mm_add_epi32(
+          msg[i % 4],
+          _mm_load_si128(
+              reinterpret_cast<const __m128i*>(&kRoundConstants[4 * i])));
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, words);
+      words = _mm_shuffle_epi32(words, 0x0e);
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, words);
+      if (i < 12) {
+        const __m128i next =
+            _mm_add_epi32(_mm_sha256msg1_epu32(msg[i % 4], msg[(i + 1) % 4]),
+                          _mm_alignr_epi8(
+                              msg[(i + 3) % 4], msg[(i + 2) % 4], 4));
+        msg[i % 4] = _mm_sha256msg2_epu32(next, msg[(i + 3) % 4]);
+      }
+    }
+
+    abef = _mm_add_epi32(abef, abef_saved);
+    cdgh = _mm_add_epi32(cdgh, cdgh_saved);
+  }
+
+  const __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+  const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+  abcd = _mm_blend_epi16(feba, dchg, 0xf0);
+  efgh = _mm_alignr_epi8(dchg, feba, 8);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), abcd);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), efgh);
+}
+
+#endif
+
+void ProcessBlocks(std::array<uint32_t, 8>& state,
+                   const std::byte* data,
+                   size_t num_blocks) {
+#if PW_CRYPTO_SHA256_BUILTIN_ARMV8
+  ProcessBlocksArmv8(state, data, num_blocks);
+#elif PW_CRYPTO_SHA256_BUILTIN_X86
+  static const bool has_sha_extensions = HasShaExtensions();
+  if (has_sha_extensions) {
+    ProcessBlocksX86(state, data, num_blocks);
+    return;
+  }
+  ProcessBlocksPortable(state, data, num_blocks);
+#else
+  ProcessBlocksPortable(state, data, num_blocks);
+#endif
+}
+
+}  // namespace
+
+Status DoInit(NativeSha256Context& ctx) {
+  ctx.state = kInitialState;
+  ctx.total_bytes = 0;
+  return OkStatus();
+}
+
+Status DoUpdate(NativeSha256Context& ctx, ConstByteSpan data) {
+  size_t buffered = static_cast<size_t>(ctx.total_bytes % kBlockSize);
+  ctx.total_bytes += data.size();
+
+  // Complete a partially filled block first.
+  if (buffered != 0) {
+    const size_t num_bytes = std::min(kBlockSize - buffered, data.size());
+    std::memcpy(&ctx.block[buffered], data.data(), num_bytes);
+    data = data.subspan(num_bytes);
+    buffered += num_bytes;
+    if (buffered < kBlockSize) {
+      return OkStatus();
+    }
+    ProcessBlocks(ctx.state, ctx.block.data(), 1);
+  }
+
+  // Hash whole blocks directly from the input, without copying them.
+  const size_t num_blocks = data.size() / kBlockSize;
+  if (num_blocks != 0) {
+    ProcessBlocks(ctx.state, data.data(), num_blocks);
+    data = data.subspan(num_blocks * kBlockSize);
+  }
+
+  if (!data.empty()) {
+    std::memcpy(ctx.block.data(), data.data(), data.size());
+  }
+  return OkStatus();
+}
+
+Status DoFinal(NativeSha256Context& ctx, ByteSpan out_digest) {
+  const uint64_t total_bits = ctx.total_bytes * 8;
+  size_t buffered = static_cast<size_t>(ctx.total_bytes % kBlockSize);
+
+  // Pad the message with a 1 bit, zeros, and its length in bits.
+  ctx.block[buffered++] = std::byte{0x80};
+  if (buffered > kBlockSize - sizeof(total_bits)) {
+    std::memset(&ctx.block[buffered], 0, kBlockSize - buffered);
+    ProcessBlocks(ctx.state, ctx.block.data(), 1);
+    buffered = 0;
+  }
+  std::memset(&ctx.block[buffered], 0, kBlockSize - buffered);
+  for (size_t i = 0; i < sizeof(total_bits); ++i) {
+    ctx.block[kBlockSize - 1 - i] =
+        static_cast<std::byte>(total_bits >> (8 * i));
+  }
+  ProcessBlocks(ctx.state, ctx.block.data(), 1);
+
+  for (size_t i = 0; i < ctx.state.size(); ++i) {
+    StoreBigEndian(ctx.state[i], &out_digest[4 * i]);
+  }
+  return OkStatus();
+}
+
+}  // namespace pw::crypto::sha256::backend
@@ -14,6 +14,8 @@
 
 #include "pw_crypto/sha256.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 
 #include "pw_stream/memory_stream.h"
@@ -99,6 +101,64 @@ TEST(Hash, AcceptsLargerDigestBufferForReaderBasedAPI) {
   ASSERT_OK(Hash(reader, digest));
 }
 
+TEST(Hash, ComputesCorrectDigestFromReaderWithBuffer) {
+  std::byte digest[kDigestSizeBytes];
+  ConstByteSpan message = AS_BYTES("Hello, Pigweed!");
+
+  std::array<std::byte, 4> buffer;
+  stream::MemoryReader reader(message);
+  ASSERT_OK(Hash(reader, buffer, digest));
+  ASSERT_EQ(0,
+            std::memcmp(digest, SHA256_HASH_OF_HELLO_PIGWEED, sizeof(digest)));
+}
+
+TEST(Hash, EmptyBufferForReaderBasedAPI) {
+  std::byte digest[kDigestSizeBytes];
+  ConstByteSpan empty;
+  stream::MemoryReader reader(empty);
+  ASSERT_FAIL(Hash(reader, ByteSpan(), digest));
+}
+
+// From FIPS 180-2 Appendix B.2: a message that needs two blocks when padded.
+#define TWO_BLOCK_MESSAGE \
+  "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"
+#define SHA256_HASH_OF_TWO_BLOCK_MESSAGE                             \
+  "\x24\x8d\x6a\x61\xd2\x06\x38\xb8\xe5\xc0\x26\x93\x0c\x3e\x60\x39" \
+  "\xa3\x3c\xe4\x59\x64\xff\x21\x67\xf6\xec\xed\xd4\x19\xdb\x06\xc1"
+
+TEST(Hash, ComputesCorrectDigestOfTwoBlockMessage) {
+  std::byte digest[kDigestSizeBytes];
+
+  ASSERT_OK(Hash(AS_BYTES(TWO_BLOCK_MESSAGE), digest));
+  ASSERT_EQ(0,
+            std::memcmp(
+                digest, SHA256_HASH_OF_TWO_BLOCK_MESSAGE, sizeof(digest)));
+}
+
+// From FIPS 180-2 Appendix B.3: one million repetitions of 'a'.
+#define SHA256_HASH_OF_MILLION_A                                     \
+  "\xcd\xc7\x6e\x5c\x99\x14\xfb\x92\x81\xa1\xc7\xe2\x84\xd7\x3e\x67" \
+  "\xf1\x80\x9a\x48\xa4\x97\x20\x0e\x04\x6d\x39\xcc\xc7\x11\x2c\xd0"
+
+TEST(Sha256, ComputesCorrectDigestOfLongMessageInUnevenChunks) {
+  std::array<std::byte, 1000> chunk;
+  std::memset(chunk.data(), 'a', chunk.size());
+
+  // Feed the message in chunks of varying sizes, so that updates start and
+  // end at many different offsets within a block.
+  Sha256 h;
+  size_t remaining = 1000000;
+  for (size_t i = 0; remaining > 0; ++i) {
+    const size_t size = std::min(remaining, (i * 37) % chunk.size());
+    h.Update(span(chunk).first(size));
+    remaining -= size;
+  }
+
+  std::byte digest[kDigestSizeBytes];
+  ASSERT_OK(h.Final(digest));
+  ASSERT_EQ(0, std::memcmp(digest, SHA256_HASH_OF_MILLION_A, sizeof(digest)));
+}
+
 TEST(Sha256, AllowsSkippedUpdate) {
   std::byte digest[kDigestSizeBytes];
 
@@ -17,6 +17,9 @@
 #include <fcntl.h>
 #include <linux/gpio.h>
 
+#include <cerrno>
+#include <utility>
+
 #include "pw_digital_io/digital_io.h"
 #include "pw_result/result.h"
 #include "pw_status/status.h"
@@ -92,6 +95,24 @@ Result<OwnedFd> LinuxDigitalIoChip::Impl::GetLineHandle(uint32_t offset,
   return OwnedFd(req.fd);
 }
 
+Result<OwnedFd> LinuxDigitalIoChip::Impl::GetLineEventHandle(
+    uint32_t offset, uint32_t handle_flags, uint32_t event_flags) {
+  struct gpioevent_request req = {
+      .lineoffset = offset,
+      .handleflags = handle_flags,
+      .eventflags = event_flags,
+      .consumer_label = "pw_digital_io_linux",
+      .fd = -1,
+  };
+  if (fd_.ioctl(GPIO_GET_LINEEVENT_IOCTL, &req) < 0) {
+    return Status::Internal();
+  }
+  if (req.fd < 0) {
+    return Status::Internal();
+  }
+  return OwnedFd(req.fd);
+}
+
 Result<LinuxDigitalIn> LinuxDigitalIoChip::GetInputLine(
     const LinuxInputConfig& config) {
   if (!impl_) {
@@ -100,6 +121,15 @@ Result<LinuxDigitalIn> LinuxDigitalIoChip::GetInputLine(
   return LinuxDigitalIn(impl_, config);
 }
 
+Result<LinuxDigitalInInterrupt> LinuxDigitalIoChip::GetInterruptLine(
+    const LinuxInputConfig& config,
+    std::shared_ptr<LinuxGpioNotifier> notifier) {
+  if (!impl_ || !notifier) {
+    return Status::FailedPrecondition();
+  }
+  return LinuxDigitalInInterrupt(impl_, config, std::move(notifier));
+}
+
 Result<LinuxDigitalOut> LinuxDigitalIoChip::GetOutputLine(
     const LinuxOutputConfig& config) {
   if (!impl_) {
@@ -120,7 +150,7 @@ Status LinuxDigitalIn::DoEnable(bool enable) {
     PW_TRY_ASSIGN(fd_, chip_->GetLineHandle(config_.index, config_.GetFlags()));
   } else {
     // Close the open file handle and release the line request.
-    fd_ = {};
+    fd_.Close();
   }
   return OkStatus();
 }
@@ -141,6 +171,145 @@ Result<State> FdGetState(OwnedFd& fd) {
 
 Result<State> LinuxDigitalIn::DoGetState() { return FdGetState(fd_); }
 
+//
+// LinuxDigitalInInterrupt
+//
+
+namespace {
+
+constexpr ssize_t kEventSize = sizeof(struct gpioevent_data);
+
+// Line events are reported in terms of the line's logical state, so an
+// activating edge is a rising edge even on an active-low line.
+uint32_t GetEventFlags(InterruptTrigger trigger) {
+  switch (trigger) {
+    case InterruptTrigger::kActivatingEdge:
+      return GPIOEVENT_REQUEST_RISING_EDGE;
+    case InterruptTrigger::kDeactivatingEdge:
+      return GPIOEVENT_REQUEST_FALLING_EDGE;
+    case InterruptTrigger::kBothEdges:
+      return GPIOEVENT_REQUEST_BOTH_EDGES;
+  }
+  return GPIOEVENT_REQUEST_BOTH_EDGES;
+}
+
+}  // namespace
+
+LinuxDigitalInInterrupt::LinuxDigitalInInterrupt(
+    LinuxDigitalInInterrupt&& other)
+    : DigitalInInterrupt(std::move(other)),
+      chip_(std::move(other.chip_)),
+      config_(other.config_),
+      notifier_(std::move(other.notifier_)),
+      fd_(std::move(other.fd_)),
+      registered_(std::exchange(other.registered_, false)),
+      trigger_(other.trigger_),
+      handler_(std::move(other.handler_)),
+      interrupts_enabled_(other.interrupts_enabled_.exchange(false)) {
+  // The notifier refers to the line's handler by address.
+  if (registered_) {
+    notifier_->UnregisterLine(fd_.fd(), other).IgnoreError();
+    registered_ = notifier_->RegisterLine(fd_.fd(), *this).ok();
+  }
+}
+
+LinuxDigitalInInterrupt::~LinuxDigitalInInterrupt() { CloseLine(); }
+
+Status LinuxDigitalInInterrupt::OpenLine() {
+  if (handler_ == nullptr) {
+    PW_TRY_ASSIGN(fd_, chip_->GetLineHandle(config_.index, config_.GetFlags()));
+    return OkStatus();
+  }
+  PW_TRY_ASSIGN(fd_,
+                chip_->GetLineEventHandle(config_.index,
+                                          config_.GetFlags(),
+                                          GetEventFlags(trigger_)));
+  // Events are read until none remain, so reads must not block.
+  const int flags = fcntl(fd_.fd(), F_GETFL);
+  if (flags < 0 || fcntl(fd_.fd(), F_SETFL, flags | O_NONBLOCK) != 0) {
+    fd_.Close();
+    return Status::Internal();
+  }
+  if (Status status = notifier_->RegisterLine(fd_.fd(), *this); !status.ok()) {
+    fd_.Close();
+    return status;
+  }
+  registered_ = true;
+  return OkStatus();
+}
+
+void LinuxDigitalInInterrupt::CloseLine() {
+  if (registered_) {
+    notifier_->UnregisterLine(fd_.fd(), *this).IgnoreError();
+    registered_ = false;
+  }
+  // Close the open file handle and release the line request.
+  fd_.Close();
+}
+
+Status LinuxDigitalInInterrupt::DoEnable(bool enable) {
+  if (!enable) {
+    CloseLine();
+    return OkStatus();
+  }
+  if (enabled()) {
+    return OkStatus();
+  }
+  return OpenLine();
+}
+
+Result<State> LinuxDigitalInInterrupt::DoGetState() {
+  return FdGetState(fd_);
+}
+
+Status LinuxDigitalInInterrupt::DoSetInterruptHandler(
+    InterruptTrigger trigger, InterruptHandler&& handler) {
+  if (handler == nullptr) {
+    if (interrupts_enabled_) {
+      return Status::FailedPrecondition();
+    }
+  } else if (handler_ != nullptr) {
+    return Status::FailedPrecondition();
+  }
+  // Request the line again, with or without edge detection. Closing the line
+  // also waits for the notifier to finish running the old handler.
+  const bool was_enabled = enabled();
+  CloseLine();
+  handler_ = std::move(handler);
+  trigger_ = trigger;
+  if (!was_enabled) {
+    return OkStatus();
+  }
+  return OpenLine();
+}
+
+Status LinuxDigitalInInterrupt::DoEnableInterruptHandler(bool enable) {
+  if (!enable) {
+    interrupts_enabled_ = false;
+    return OkStatus();
+  }
+  if (handler_ == nullptr || !enabled()) {
+    return Status::FailedPrecondition();
+  }
+  // Discard the events that occurred while interrupts were disabled.
+  struct gpioevent_data event;
+  while (read(fd_.fd(), &event, sizeof(event)) == kEventSize) {
+  }
+  interrupts_enabled_ = true;
+  return OkStatus();
+}
+
+void LinuxDigitalInInterrupt::HandleEvents() {
+  struct gpioevent_data event;
+  while (read(fd_.fd(), &event, sizeof(event)) == kEventSize) {
+    if (!interrupts_enabled_) {
+      continue;
+    }
+    handler_(event.id == GPIOEVENT_EVENT_RISING_EDGE ? State::kActive
+                                                     : State::kInactive);
+  }
+}
+
 //
 // LinuxDigitalOut
 //
@@ -156,7 +325,7 @@ Status LinuxDigitalOut::DoEnable(bool enable) {
         chip_->GetLineHandle(config_.index, config_.GetFlags(), default_value));
   } else {
     // Close the open file handle and release the line request.
-    fd_ = {};
+    fd_.Close();
   }
   return OkStatus();
 }
@@ -15,11 +15,15 @@
 
 #include <linux/gpio.h>
 
+#include <unistd.h>
+
 #include <algorithm>
 #include <cstdarg>
 #include <functional>
+#include <vector>
 
 #include "pw_digital_io_linux/digital_io.h"
+#include "pw_digital_io_linux/notifier.h"
 #include "pw_log/log.h"
 #include "pw_result/result.h"
 #include "pw_unit_test/framework.h"
@@ -70,6 +74,37 @@ class DigitalIoTest : public ::testing::Test {
   bool line1_fd_open_ = false;
   bool line1_active_low_ = false;
 
+  // Line 2: Input with edge events. Event handles are the read end of a pipe,
+  // so that they can be waited on with epoll.
+  static constexpr int kLine2InputFd = 9002;
+  uint8_t line2_value_ = 0;
+  bool line2_fd_open_ = false;
+  int line2_event_fd_ = -1;
+  int line2_event_writer_ = -1;
+  uint32_t line2_event_flags_ = 0;
+
+  int DoChipLineeventIoctl(struct gpioevent_request* req) {
+    if (req->lineoffset != 2) {
+      PW_LOG_ERROR("%s: Line %u does not support events",
+                   __FUNCTION__,
+                   req->lineoffset);
+      return -1;
+    }
+    if ((req->handleflags & GPIOHANDLE_REQUEST_INPUT) == 0) {
+      PW_LOG_ERROR("%s: Line 2 is input-only", __FUNCTION__);
+      return -1;
+    }
+    int fds[2];
+    if (pipe(fds) != 0) {
+      return -1;
+    }
+    line2_event_fd_ = fds[0];
+    line2_event_writer_ = fds[1];
+    line2_event_flags_ = req->eventflags;
+    req->fd = line2_event_fd_;
+    return 0;
+  }
+
   int DoChipLinehandleIoctl(struct gpiohandle_request* req) {
     uint32_t const direction =
         req->flags & (GPIOHANDLE_REQUEST_OUTPUT | GPIOHANDLE_REQUEST_INPUT);
@@ -110,6 +145,14 @@ class DigitalIoTest : public ::testing::Test {
         line1_active_low_ = active_low;
         line1_value_ = default_value ^ active_low;
         return 0;
+      case 2:
+        if (direction != GPIOHANDLE_REQUEST_INPUT) {
+          PW_LOG_ERROR("%s: Line 2 is input-only", __FUNCTION__);
+          return -1;
+        }
+        req->fd = kLine2InputFd;
+        line2_fd_open_ = true;
+        return 0;
       default:
         PW_LOG_ERROR("%s: Line %u not supported", __FUNCTION__, offset);
         return -1;
@@ -121,6 +164,9 @@ class DigitalIoTest : public ::testing::Test {
       case GPIO_GET_LINEHANDLE_IOCTL:
         return DoChipLinehandleIoctl(
             static_cast<struct gpiohandle_request*>(arg));
+      case GPIO_GET_LINEEVENT_IOCTL:
+        return DoChipLineeventIoctl(
+            static_cast<struct gpioevent_request*>(arg));
       default:
         PW_LOG_ERROR("%s: Unhandled request=0x%lX", __FUNCTION__, request);
         return -1;
@@ -140,7 +186,14 @@ class DigitalIoTest : public ::testing::Test {
         data->values[0] = value;
         PW_LOG_DEBUG("Got line 1 as %u", value);
         return 0;
+      case kLine2InputFd:
+        data->values[0] = line2_value_;
+        return 0;
       default:
+        if (fd == line2_event_fd_) {
+          data->values[0] = line2_value_;
+          return 0;
+        }
         PW_LOG_ERROR("%s: Incorrect fd=%d", __FUNCTION__, fd);
         return -1;
     }
@@ -176,7 +229,8 @@ class DigitalIoTest : public ::testing::Test {
     if (fd == kChipFd) {
       return DoChipIoctl(request, arg);
     }
-    if (fd == kLine0InputFd || fd == kLine1OutputFd) {
+    if (fd == kLine0InputFd || fd == kLine1OutputFd || fd == kLine2InputFd ||
+        fd == line2_event_fd_) {
       return DoLinehandleIoctl(fd, request, arg);
     }
     return __real_ioctl(fd, request, arg);
@@ -197,6 +251,15 @@ class DigitalIoTest : public ::testing::Test {
         EXPECT_TRUE(line1_fd_open_);
         line1_fd_open_ = false;
         return 0;
+      case kLine2InputFd:
+        EXPECT_TRUE(line2_fd_open_);
+        line2_fd_open_ = false;
+        return 0;
+    }
+    if (fd == line2_event_fd_) {
+      __real_close(line2_event_writer_);
+      line2_event_fd_ = -1;
+      line2_event_writer_ = -1;
     }
     return __real_close(fd);
   }
@@ -220,10 +283,39 @@ class DigitalIoTest : public ::testing::Test {
 
   bool GetLine1State() { return line1_value_; }
 
+  // Sets line 2 and reports the edge, if its events were requested.
+  void SetLine2State(bool state) {
+    if (line2_value_ == state) {
+      return;
+    }
+    line2_value_ = state;
+    if (line2_event_writer_ < 0) {
+      return;
+    }
+    const uint32_t edge = state ? GPIOEVENT_REQUEST_RISING_EDGE
+                                : GPIOEVENT_REQUEST_FALLING_EDGE;
+    if ((line2_event_flags_ & edge) == 0) {
+      return;
+    }
+    struct gpioevent_data event = {
+        .timestamp = 0,
+        .id = state ? uint32_t{GPIOEVENT_EVENT_RISING_EDGE}
+                    : uint32_t{GPIOEVENT_EVENT_FALLING_EDGE},
+    };
+    ASSERT_EQ(write(line2_event_writer_, &event, sizeof(event)),
+              static_cast<ssize_t>(sizeof(event)));
+  }
+
+  bool Line2EventsRequested() { return line2_event_fd_ >= 0; }
+
+  bool Line2HandleOpen() { return line2_fd_open_; }
+
   void ExpectAllFdsClosed() {
     EXPECT_FALSE(chip_fd_open_);
     EXPECT_FALSE(line0_fd_open_);
     EXPECT_FALSE(line1_fd_open_);
+    EXPECT_FALSE(line2_fd_open_);
+    EXPECT_LT(line2_event_fd_, 0);
   }
 };
 
@@ -381,5 +473,169 @@ TEST_F(DigitalIoTest, OutputGetState) {
   ExpectAllFdsClosed();
 }
 
+TEST_F(DigitalIoTest, InterruptHandlerRunsOnEdges) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+
+  LinuxInputConfig config(
+      /* index= */ 2,
+      /* polarity= */ Polarity::kActiveHigh);
+
+  auto input_result = chip.GetInterruptLine(config, *notifier);
+  ASSERT_EQ(OkStatus(), input_result.status());
+  {
+    auto input = std::move(input_result.value());
+    std::vector<State> states;
+
+    ASSERT_EQ(OkStatus(),
+              input.SetInterruptHandler(
+                  InterruptTrigger::kBothEdges,
+                  [&states](State state) { states.push_back(state); }));
+    ASSERT_EQ(OkStatus(), input.Enable());
+    ASSERT_TRUE(Line2EventsRequested());
+    ASSERT_EQ(OkStatus(), input.EnableInterruptHandler());
+
+    SetLine2State(true);
+    auto lines = (*notifier)->WaitForEvents(0);
+    ASSERT_EQ(OkStatus(), lines.status());
+    EXPECT_EQ(1u, lines.value());
+
+    SetLine2State(false);
+    lines = (*notifier)->WaitForEvents(0);
+    ASSERT_EQ(OkStatus(), lines.status());
+    EXPECT_EQ(1u, lines.value());
+
+    ASSERT_EQ(2u, states.size());
+    EXPECT_EQ(State::kActive, states[0]);
+    EXPECT_EQ(State::kInactive, states[1]);
+
+    // The line's state can be read while edge events are requested.
+    auto state = input.GetState();
+    ASSERT_EQ(OkStatus(), state.status());
+    EXPECT_EQ(State::kInactive, state.value());
+
+    ASSERT_EQ(OkStatus(), input.DisableInterruptHandler());
+    ASSERT_EQ(OkStatus(), input.Disable());
+  }
+  chip.Close();
+  ExpectAllFdsClosed();
+}
+
+TEST_F(DigitalIoTest, InterruptHandlerOnlyRunsOnTrigger) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+
+  LinuxInputConfig config(
+      /* index= */ 2,
+      /* polarity= */ Polarity::kActiveHigh);
+
+  auto input_result = chip.GetInterruptLine(config, *notifier);
+  ASSERT_EQ(OkStatus(), input_result.status());
+  {
+    auto input = std::move(input_result.value());
+    int activations = 0;
+
+    ASSERT_EQ(OkStatus(), input.Enable());
+    ASSERT_EQ(OkStatus(),
+              input.SetInterruptHandler(InterruptTrigger::kActivatingEdge,
+                                        [&activations](State state) {
+                                          EXPECT_EQ(State::kActive, state);
+                                          activations += 1;
+                                        }));
+    ASSERT_EQ(OkStatus(), input.EnableInterruptHandler());
+
+    SetLine2State(true);
+    SetLine2State(false);
+    auto lines = (*notifier)->WaitForEvents(0);
+    ASSERT_EQ(OkStatus(), lines.status());
+    EXPECT_EQ(1, activations);
+
+    ASSERT_EQ(OkStatus(), input.Disable());
+  }
+  chip.Close();
+  ExpectAllFdsClosed();
+}
+
+TEST_F(DigitalIoTest, InterruptHandlerDisabledDropsEvents) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+
+  LinuxInputConfig config(
+      /* index= */ 2,
+      /* polarity= */ Polarity::kActiveHigh);
+
+  auto input_result = chip.GetInterruptLine(config, *notifier);
+  ASSERT_EQ(OkStatus(), input_result.status());
+  {
+    auto input = std::move(input_result.value());
+    int calls = 0;
+
+    ASSERT_EQ(OkStatus(),
+              input.SetInterruptHandler(InterruptTrigger::kBothEdges,
+                                        [&calls](State) { calls += 1; }));
+    // Interrupts cannot be enabled until the line is enabled.
+    EXPECT_EQ(Status::FailedPrecondition(), input.EnableInterruptHandler());
+    ASSERT_EQ(OkStatus(), input.Enable());
+
+    // Events while interrupts are disabled are not delivered, even after
+    // interrupts are enabled.
+    SetLine2State(true);
+    ASSERT_EQ(OkStatus(), input.EnableInterruptHandler());
+    auto lines = (*notifier)->WaitForEvents(0);
+    ASSERT_EQ(OkStatus(), lines.status());
+    EXPECT_EQ(0, calls);
+
+    ASSERT_EQ(OkStatus(), input.DisableInterruptHandler());
+    SetLine2State(false);
+    lines = (*notifier)->WaitForEvents(0);
+    ASSERT_EQ(OkStatus(), lines.status());
+    EXPECT_EQ(0, calls);
+
+    ASSERT_EQ(OkStatus(), input.Disable());
+  }
+  chip.Close();
+  ExpectAllFdsClosed();
+}
+
+TEST_F(DigitalIoTest, ClearInterruptHandlerReleasesEvents) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+
+  LinuxInputConfig config(
+      /* index= */ 2,
+      /* polarity= */ Polarity::kActiveHigh);
+
+  auto input_result = chip.GetInterruptLine(config, *notifier);
+  ASSERT_EQ(OkStatus(), input_result.status());
+  {
+    auto input = std::move(input_result.value());
+
+    // Without a handler, the line is requested without edge detection.
+    ASSERT_EQ(OkStatus(), input.Enable());
+    EXPECT_TRUE(Line2HandleOpen());
+    EXPECT_FALSE(Line2EventsRequested());
+
+    ASSERT_EQ(OkStatus(),
+              input.SetInterruptHandler(InterruptTrigger::kBothEdges,
+                                        [](State) {}));
+    EXPECT_FALSE(Line2HandleOpen());
+    EXPECT_TRUE(Line2EventsRequested());
+
+    // A second handler cannot be set.
+    EXPECT_EQ(Status::FailedPrecondition(),
+              input.SetInterruptHandler(InterruptTrigger::kBothEdges,
+                                        [](State) {}));
+
+    ASSERT_EQ(OkStatus(), input.EnableInterruptHandler());
+    ASSERT_EQ(OkStatus(), input.ClearInterruptHandler());
+    EXPECT_TRUE(Line2HandleOpen());
+    EXPECT_FALSE(Line2EventsRequested());
+
+    ASSERT_EQ(OkStatus(), input.Disable());
+  }
+  chip.Close();
+  ExpectAllFdsClosed();
+}
+
 }  // namespace
 }  // namespace pw::digital_io
@@ -0,0 +1,165 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_digital_io_linux/notifier.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_log/log.h"
+#include "pw_span/span.h"
+
+namespace pw::digital_io {
+namespace {
+
+// The maximum number of events handled by each call to ``epoll_wait``.
+constexpr int kMaxEventsPerWait = 16;
+
+}  // namespace
+
+Result<std::shared_ptr<LinuxGpioNotifier>> LinuxGpioNotifier::Create() {
+  OwnedFd epoll_fd(epoll_create1(EPOLL_CLOEXEC));
+  if (!epoll_fd.valid()) {
+    PW_LOG_ERROR("Failed to create epoll instance: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+  OwnedFd cancel_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+  if (!cancel_fd.valid()) {
+    PW_LOG_ERROR("Failed to create eventfd: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+  // The cancel eventfd is the only entry without a handler.
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  if (epoll_ctl(epoll_fd.fd(), EPOLL_CTL_ADD, cancel_fd.fd(), &event) != 0) {
+    PW_LOG_ERROR("Failed to add eventfd to epoll set: %s",
+                 std::strerror(errno));
+    return Status::Internal();
+  }
+  return std::shared_ptr<LinuxGpioNotifier>(
+      new LinuxGpioNotifier(std::move(epoll_fd), std::move(cancel_fd)));
+}
+
+LinuxGpioNotifier::~LinuxGpioNotifier() {
+  if (!handlers_.empty()) {
+    PW_LOG_WARN("GPIO notifier destroyed with %u lines registered",
+                static_cast<unsigned>(handlers_.size()));
+  }
+}
+
+Status LinuxGpioNotifier::RegisterLine(int fd, Handler& handler) {
+  std::lock_guard lock(lock_);
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLPRI;
+  event.data.ptr = &handler;
+  if (epoll_ctl(epoll_fd_.fd(), EPOLL_CTL_ADD, fd, &event) != 0) {
+    PW_LOG_ERROR("Failed to register GPIO line fd %d with epoll: %s",
+                 fd,
+                 std::strerror(errno));
+    return Status::Internal();
+  }
+  handlers_.insert(&handler);
+  return OkStatus();
+}
+
+Status LinuxGpioNotifier::UnregisterLine(int fd, Handler& handler) {
+  std::unique_lock lock(lock_);
+  handlers_.erase(&handler);
+  const int result = epoll_ctl(epoll_fd_.fd(), EPOLL_CTL_DEL, fd, nullptr);
+  // A handler that unregisters itself cannot wait for itself to return.
+  if (waiting_thread_ != std::this_thread::get_id()) {
+    handler_returned_.wait(
+        lock, [this, &handler] { return running_handler_ != &handler; });
+  }
+  if (result != 0) {
+    PW_LOG_WARN("Failed to remove GPIO line fd %d from epoll set: %s",
+                fd,
+                std::strerror(errno));
+    return Status::Internal();
+  }
+  return OkStatus();
+}
+
+Result<unsigned> LinuxGpioNotifier::WaitForEvents(int timeout_ms) {
+  std::array<epoll_event, kMaxEventsPerWait> events;
+  int count;
+  do {
+    count = epoll_wait(
+        epoll_fd_.fd(), events.data(), kMaxEventsPerWait, timeout_ms);
+  } while (count < 0 && errno == EINTR);
+  if (count < 0) {
+    PW_LOG_ERROR("epoll_wait failed: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  unsigned lines = 0;
+  bool cancelled = false;
+  std::unique_lock lock(lock_);
+  waiting_thread_ = std::this_thread::get_id();
+  for (const epoll_event& event :
+       span(events.data(), static_cast<size_t>(count))) {
+    auto* handler = static_cast<Handler*>(event.data.ptr);
+    if (handler == nullptr) {
+      uint64_t value;
+      cancelled = read(cancel_fd_.fd(), &value, sizeof(value)) > 0;
+      continue;
+    }
+    // The line may have been unregistered after epoll_wait returned.
+    if (handlers_.count(handler) == 0) {
+      continue;
+    }
+    running_handler_ = handler;
+    lock.unlock();
+    handler->HandleEvents();
+    lock.lock();
+    running_handler_ = nullptr;
+    handler_returned_.notify_all();
+    lines += 1;
+  }
+  waiting_thread_ = std::thread::id();
+  if (cancelled) {
+    return Status::Cancelled();
+  }
+  return lines;
+}
+
+void LinuxGpioNotifier::CancelWait() {
+  const uint64_t value = 1;
+  if (write(cancel_fd_.fd(), &value, sizeof(value)) < 0) {
+    PW_LOG_ERROR("Failed to cancel GPIO notifier wait: %s",
+                 std::strerror(errno));
+  }
+}
+
+void LinuxGpioNotifier::Run() {
+  while (true) {
+    Result<unsigned> result = WaitForEvents(-1);
+    if (result.status().IsCancelled()) {
+      return;
+    }
+    if (!result.ok()) {
+      PW_LOG_ERROR("Stopping GPIO notifier: %s", result.status().str());
+      return;
+    }
+  }
+}
+
+}  // namespace pw::digital_io
@@ -0,0 +1,131 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_digital_io_linux/notifier.h"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::digital_io {
+namespace {
+
+// A line whose events are signalled through an eventfd.
+class FakeLine : public LinuxGpioNotifier::Handler {
+ public:
+  FakeLine() : fd_(eventfd(0, EFD_NONBLOCK)) {}
+
+  int fd() const { return fd_.fd(); }
+
+  int events() const { return events_; }
+
+  void Signal() {
+    const uint64_t value = 1;
+    ASSERT_EQ(write(fd_.fd(), &value, sizeof(value)),
+              static_cast<ssize_t>(sizeof(value)));
+  }
+
+  // Unregisters the line from its own handler.
+  void UnregisterOnEvent(LinuxGpioNotifier& notifier) {
+    unregister_from_ = &notifier;
+  }
+
+ private:
+  void HandleEvents() override {
+    uint64_t value;
+    while (read(fd_.fd(), &value, sizeof(value)) > 0) {
+      events_ += 1;
+    }
+    if (unregister_from_ != nullptr) {
+      EXPECT_EQ(OkStatus(), unregister_from_->UnregisterLine(fd(), *this));
+      unregister_from_ = nullptr;
+    }
+  }
+
+  OwnedFd fd_;
+  int events_ = 0;
+  LinuxGpioNotifier* unregister_from_ = nullptr;
+};
+
+TEST(LinuxGpioNotifier, RunsHandlerOfSignalledLine) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+  FakeLine line;
+  FakeLine other_line;
+  ASSERT_EQ(OkStatus(), (*notifier)->RegisterLine(line.fd(), line));
+  ASSERT_EQ(OkStatus(), (*notifier)->RegisterLine(other_line.fd(), other_line));
+
+  auto lines = (*notifier)->WaitForEvents(0);
+  ASSERT_EQ(OkStatus(), lines.status());
+  EXPECT_EQ(0u, lines.value());
+
+  line.Signal();
+  lines = (*notifier)->WaitForEvents(0);
+  ASSERT_EQ(OkStatus(), lines.status());
+  EXPECT_EQ(1u, lines.value());
+  EXPECT_EQ(1, line.events());
+  EXPECT_EQ(0, other_line.events());
+
+  EXPECT_EQ(OkStatus(), (*notifier)->UnregisterLine(line.fd(), line));
+  EXPECT_EQ(OkStatus(),
+            (*notifier)->UnregisterLine(other_line.fd(), other_line));
+}
+
+TEST(LinuxGpioNotifier, UnregisteredLineIsNotHandled) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+  FakeLine line;
+  ASSERT_EQ(OkStatus(), (*notifier)->RegisterLine(line.fd(), line));
+  ASSERT_EQ(OkStatus(), (*notifier)->UnregisterLine(line.fd(), line));
+
+  line.Signal();
+  auto lines = (*notifier)->WaitForEvents(0);
+  ASSERT_EQ(OkStatus(), lines.status());
+  EXPECT_EQ(0u, lines.value());
+  EXPECT_EQ(0, line.events());
+
+  EXPECT_EQ(Status::Internal(), (*notifier)->UnregisterLine(line.fd(), line));
+}
+
+TEST(LinuxGpioNotifier, HandlerMayUnregisterItself) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+  FakeLine line;
+  ASSERT_EQ(OkStatus(), (*notifier)->RegisterLine(line.fd(), line));
+  line.UnregisterOnEvent(**notifier);
+
+  line.Signal();
+  auto lines = (*notifier)->WaitForEvents(0);
+  ASSERT_EQ(OkStatus(), lines.status());
+  EXPECT_EQ(1, line.events());
+
+  line.Signal();
+  lines = (*notifier)->WaitForEvents(0);
+  ASSERT_EQ(OkStatus(), lines.status());
+  EXPECT_EQ(0u, lines.value());
+}
+
+TEST(LinuxGpioNotifier, CancelWait) {
+  auto notifier = LinuxGpioNotifier::Create();
+  ASSERT_EQ(OkStatus(), notifier.status());
+  (*notifier)->CancelWait();
+  EXPECT_EQ(Status::Cancelled(), (*notifier)->WaitForEvents(-1).status());
+  EXPECT_EQ(OkStatus(), (*notifier)->WaitForEvents(0).status());
+}
+
+}  // namespace
+}  // namespace pw::digital_io
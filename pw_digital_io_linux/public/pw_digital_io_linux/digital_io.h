@@ -14,67 +14,18 @@
 
 #pragma once
 
-#include <sys/ioctl.h>
-#include <unistd.h>
-
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
 #include "pw_digital_io/digital_io.h"
 #include "pw_digital_io/polarity.h"
+#include "pw_digital_io_linux/internal/owned_fd.h"
+#include "pw_digital_io_linux/notifier.h"
 #include "pw_result/result.h"
 
 namespace pw::digital_io {
 
-// An "owned" file descriptor wrapper which closes the fd on destruction.
-// TODO(b/328262654): Move this to out a better place.
-class OwnedFd final {
- public:
-  explicit OwnedFd(int fd) : fd_(fd) {}
-  explicit OwnedFd() : OwnedFd(kInvalid) {}
-
-  ~OwnedFd() { Close(); }
-
-  // Delete copy constructor/assignment to prevent double close.
-  OwnedFd(const OwnedFd&) = delete;
-  OwnedFd& operator=(const OwnedFd&) = delete;
-
-  // Providing move constructor is required due to custom dtor.
-  OwnedFd(OwnedFd&& other) noexcept : fd_(std::exchange(other.fd_, kInvalid)) {}
-
-  OwnedFd& operator=(OwnedFd&& other) noexcept {
-    Close();
-    fd_ = std::exchange(other.fd_, kInvalid);
-    return *this;
-  }
-
-  OwnedFd& operator=(int fd) noexcept {
-    Close();
-    fd_ = fd;
-    return *this;
-  }
-
-  void Close() {
-    if (fd_ != kInvalid) {
-      close(fd_);
-    }
-    fd_ = kInvalid;
-  }
-
-  int fd() const { return fd_; }
-  bool valid() const { return fd_ != kInvalid; }
-
-  // Helper functions
-  template <typename... Args>
-  int ioctl(Args&&... args) {
-    return ::ioctl(fd_, std::forward<Args>(args)...);
-  }
-
- private:
-  static constexpr int kInvalid = -1;
-  int fd_ = kInvalid;
-};
-
 struct LinuxConfig {
   uint32_t index;
   Polarity polarity;
@@ -99,11 +50,13 @@ struct LinuxOutputConfig final : LinuxConfig {
 };
 
 class LinuxDigitalIn;
+class LinuxDigitalInInterrupt;
 class LinuxDigitalOut;
 
 /// Represents an open handle to a Linux GPIO chip (e.g. /dev/gpiochip0).
 class LinuxDigitalIoChip final {
   friend class LinuxDigitalIn;
+  friend class LinuxDigitalInInterrupt;
   friend class LinuxDigitalOut;
 
  private:
@@ -116,6 +69,10 @@ class LinuxDigitalIoChip final {
                                   uint32_t flags,
                                   uint8_t default_value = 0);
 
+    Result<OwnedFd> GetLineEventHandle(uint32_t offset,
+                                       uint32_t handle_flags,
+                                       uint32_t event_flags);
+
    private:
     OwnedFd fd_;
   };
@@ -131,6 +88,12 @@ class LinuxDigitalIoChip final {
 
   Result<LinuxDigitalIn> GetInputLine(const LinuxInputConfig& config);
 
+  /// Returns an input line that supports interrupts. Its interrupt handler is
+  /// run by `notifier`.
+  Result<LinuxDigitalInInterrupt> GetInterruptLine(
+      const LinuxInputConfig& config,
+      std::shared_ptr<LinuxGpioNotifier> notifier);
+
   Result<LinuxDigitalOut> GetOutputLine(const LinuxOutputConfig& config);
 };
 
@@ -152,6 +115,58 @@ class LinuxDigitalIn final : public DigitalIn {
   OwnedFd fd_;
 };
 
+/// An input line whose edges trigger an interrupt handler, which is run from
+/// `LinuxGpioNotifier::WaitForEvents()`.
+///
+/// While a handler is set, the line is requested with edge detection for its
+/// trigger. `ClearInterruptHandler()` must not be called from the handler.
+class LinuxDigitalInInterrupt final : public DigitalInInterrupt,
+                                      public LinuxGpioNotifier::Handler {
+  friend class LinuxDigitalIoChip;
+
+ public:
+  LinuxDigitalInInterrupt(LinuxDigitalInInterrupt&& other);
+  LinuxDigitalInInterrupt& operator=(LinuxDigitalInInterrupt&&) = delete;
+
+  ~LinuxDigitalInInterrupt() override;
+
+ private:
+  explicit LinuxDigitalInInterrupt(
+      std::shared_ptr<LinuxDigitalIoChip::Impl> chip,
+      const LinuxInputConfig& config,
+      std::shared_ptr<LinuxGpioNotifier> notifier)
+      : chip_(std::move(chip)),
+        config_(config),
+        notifier_(std::move(notifier)) {}
+
+  Status DoEnable(bool enable) override;
+  Result<State> DoGetState() override;
+  Status DoSetInterruptHandler(InterruptTrigger trigger,
+                               InterruptHandler&& handler) override;
+  Status DoEnableInterruptHandler(bool enable) override;
+
+  // Implements LinuxGpioNotifier::Handler.
+  void HandleEvents() override;
+
+  // Requests the line, with edge detection if a handler is set.
+  Status OpenLine();
+
+  // Releases the line.
+  void CloseLine();
+
+  bool enabled() { return fd_.valid(); }
+
+  std::shared_ptr<LinuxDigitalIoChip::Impl> chip_;
+  LinuxInputConfig const config_;
+  std::shared_ptr<LinuxGpioNotifier> notifier_;
+  OwnedFd fd_;
+  // Whether fd_ is a line event handle registered with the notifier.
+  bool registered_ = false;
+  InterruptTrigger trigger_ = InterruptTrigger::kActivatingEdge;
+  InterruptHandler handler_;
+  std::atomic<bool> interrupts_enabled_ = false;
+};
+
 class LinuxDigitalOut final : public DigitalInOut {
   friend class LinuxDigitalIoChip;
 
@@ -0,0 +1,112 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "pw_digital_io_linux/internal/owned_fd.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_thread/thread_core.h"
+
+namespace pw::digital_io {
+
+/// Waits for GPIO line events with epoll, and runs the handlers of the lines
+/// that have events.
+///
+/// The notifier can run on its own thread as a `pw::thread::ThreadCore`, or
+/// its epoll file descriptor can be waited on elsewhere, e.g. by an epoll
+/// `pw::async2::Dispatcher`, and `WaitForEvents(0)` called when it is
+/// readable.
+class LinuxGpioNotifier final : public thread::ThreadCore {
+ public:
+  /// Receives the events of a registered line.
+  class Handler {
+   public:
+    virtual ~Handler() = default;
+
+   private:
+    friend class LinuxGpioNotifier;
+
+    /// Called from `WaitForEvents()` when the line's file descriptor is
+    /// readable.
+    virtual void HandleEvents() = 0;
+  };
+
+  /// Creates a notifier.
+  ///
+  /// Returns:
+  /// * @pw_status{INTERNAL} - The epoll instance could not be created.
+  static Result<std::shared_ptr<LinuxGpioNotifier>> Create();
+
+  ~LinuxGpioNotifier() override;
+
+  LinuxGpioNotifier(const LinuxGpioNotifier&) = delete;
+  LinuxGpioNotifier& operator=(const LinuxGpioNotifier&) = delete;
+
+  /// The epoll file descriptor, which is readable while events are pending.
+  int fd() const { return epoll_fd_.fd(); }
+
+  /// Calls `handler` when `fd` has events.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The line was registered.
+  /// * @pw_status{INTERNAL} - `fd` could not be added to the epoll set.
+  Status RegisterLine(int fd, Handler& handler);
+
+  /// Stops calling `handler` for `fd`. Unless called from a handler, this
+  /// waits for a call to `handler` that is in progress to return.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The line was unregistered.
+  /// * @pw_status{INTERNAL} - `fd` could not be removed from the epoll set.
+  Status UnregisterLine(int fd, Handler& handler);
+
+  /// Waits up to `timeout_ms` milliseconds for events, or indefinitely if it
+  /// is negative, then runs the handlers of the lines that have events. Only
+  /// one thread may wait for events at a time.
+  ///
+  /// Returns:
+  /// * The number of lines with events.
+  /// * @pw_status{CANCELLED} - `CancelWait()` was called.
+  /// * @pw_status{INTERNAL} - `epoll_wait` failed.
+  Result<unsigned> WaitForEvents(int timeout_ms);
+
+  /// Wakes the thread waiting in `WaitForEvents()`, which returns
+  /// @pw_status{CANCELLED}, and stops `Run()`.
+  void CancelWait();
+
+ private:
+  LinuxGpioNotifier(OwnedFd&& epoll_fd, OwnedFd&& cancel_fd)
+      : epoll_fd_(std::move(epoll_fd)), cancel_fd_(std::move(cancel_fd)) {}
+
+  // Runs WaitForEvents() until CancelWait() is called.
+  void Run() override;
+
+  OwnedFd epoll_fd_;
+  OwnedFd cancel_fd_;
+
+  std::mutex lock_;
+  std::condition_variable handler_returned_;
+  std::unordered_set<Handler*> handlers_;
+  Handler* running_handler_ = nullptr;
+  std::thread::id waiting_thread_;
+};
+
+}  // namespace pw::digital_io
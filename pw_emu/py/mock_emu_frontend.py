@@ -17,6 +17,7 @@
 import json
 import os
 from pathlib import Path
+import shutil
 from typing import Any, Optional, List, Union
 import time
 
@@ -58,6 +59,7 @@ class MockEmuLauncher(Launcher):
     ):
         super().__init__('mock-emu', config_path)
         self._wdir: Optional[Path] = None
+        self._snapshot: Optional[Path] = None
         self.log = True
 
     def _pre_start(
@@ -67,7 +69,9 @@ class MockEmuLauncher(Launcher):
         pause: bool = False,
         debug: bool = False,
         args: Optional[str] = None,
+        snapshot: Optional[Path] = None,
     ) -> List[str]:
+        self._snapshot = snapshot
         channels = []
         if self._config.get_target(['pre-start-cmds']):
             self._handles.add_channel_tcp('test_subst_tcp', 'localhost', 1234)
@@ -86,6 +90,10 @@ class MockEmuLauncher(Launcher):
         if not self._wdir:
             return
 
+        # The mock emulator's state is its properties.
+        if self._snapshot:
+            shutil.copy(self._snapshot, os.path.join(self._wdir, 'props.json'))
+
         if self._config.get_emu(['gdb_channel']):
             path = os.path.join(self._wdir, 'gdb')
             wait_for_file_size(path, 5, 5)
@@ -152,3 +160,11 @@ class MockEmuConnector(Connector):
         if not self._props[path].get(prop):
             raise InvalidProperty(path, prop)
         return self._props[path][prop]
+
+    def save_snapshot(self, path: Path) -> None:
+        props_path = os.path.join(self._wdir, 'props.json')
+        if os.path.exists(props_path):
+            shutil.copy(props_path, path)
+            return
+        with open(path, 'w') as file:
+            json.dump(self._props, file)
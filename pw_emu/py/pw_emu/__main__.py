@@ -59,6 +59,7 @@ def _cmd_start(emu: Emulator, args: argparse.Namespace) -> None:
         args=args.args,
         debug=args.debug,
         foreground=args.foreground,
+        snapshot=args.snapshot,
     )
 
 
@@ -213,6 +214,12 @@ def _cmd_resume(emu: Emulator, _args: argparse.Namespace) -> None:
     emu.cont()
 
 
+def _cmd_save_snapshot(emu: Emulator, args: argparse.Namespace) -> None:
+    """Save the emulator's state to a snapshot file and leave it paused."""
+
+    emu.save_snapshot(args.snapshot)
+
+
 def get_parser() -> argparse.ArgumentParser:
     """Command line parser"""
 
@@ -302,6 +309,14 @@ def get_parser() -> argparse.ArgumentParser:
             action='store_true',
             help='Start the emulator in foreground mode',
         )
+        subparser.add_argument(
+            '--snapshot',
+            '-s',
+            metavar='FILE',
+            type=Path,
+            help='Restore a snapshot saved with save-snapshot instead of '
+            'booting the target',
+        )
 
     run = add_cmd('run', _cmd_run)
     run.add_argument(
@@ -412,6 +427,14 @@ def get_parser() -> argparse.ArgumentParser:
 
     resume = add_cmd('resume', _cmd_resume)
 
+    save_snapshot = add_cmd('save-snapshot', _cmd_save_snapshot)
+    save_snapshot.add_argument(
+        'snapshot',
+        metavar='FILE',
+        type=Path,
+        help='File to save the snapshot to',
+    )
+
     parser.epilog = f"""commands usage:
         {start.format_usage().strip()}
         {restart.format_usage().strip()}
@@ -426,6 +449,7 @@ def get_parser() -> argparse.ArgumentParser:
         {gdb_cmds.format_usage().strip()}
         {term.format_usage().strip()}
         {resume.format_usage().strip()}
+        {save_snapshot.format_usage().strip()}
     """
 
     return parser
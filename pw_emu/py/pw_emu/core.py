@@ -161,6 +161,13 @@ class InvalidProperty(Error):
         super().__init__(f'invalid property `{name}` at `{path}`')
 
 
+class SnapshotError(Error):
+    """Exception raised if saving or restoring a snapshot fails."""
+
+    def __init__(self, emu: str, msg: str) -> None:
+        super().__init__(f'{emu} snapshot error: {msg}')
+
+
 class HandlesError(Error):
     """Exception raised if the load of an emulator handle fails."""
 
@@ -634,6 +641,15 @@ class Connector(ABC):
     def get_property(self, path: str, prop: str) -> Any:
         """Returns the value of an emulator's object property."""
 
+    @abstractmethod
+    def save_snapshot(self, path: Path) -> None:
+        """Saves the emulator's state to a snapshot file.
+
+        The emulator is paused while saving and stays paused afterwards. The
+        snapshot can be restored by passing it to
+        :py:meth:`pw_emu.core.Launcher.start`.
+        """
+
 
 class Launcher(ABC):
     """Starts an emulator based on the target and configuration file."""
@@ -683,9 +699,13 @@ class Launcher(ABC):
         pause: bool = False,
         debug: bool = False,
         args: Optional[str] = None,
+        snapshot: Optional[Path] = None,
     ) -> List[str]:
         """Pre-start work, returns command to start the emulator.
 
+        If ``snapshot`` is set the emulator must restore that snapshot instead
+        of booting the target.
+
         The target and emulator configuration can be accessed through
         :py:attr:`pw_emu.core.Launcher._config` with
         :py:meth:`pw_emu.core.Config.get`,
@@ -905,11 +925,17 @@ class Launcher(ABC):
         debug: bool = False,
         foreground: bool = False,
         args: Optional[str] = None,
+        snapshot: Optional[Path] = None,
     ) -> Connector:
         """Starts the emulator for the given target.
 
         If ``file`` is set the emulator loads that file before starting.
 
+        If ``snapshot`` is set the emulator restores the state saved with
+        :py:meth:`pw_emu.core.Connector.save_snapshot` instead of booting the
+        target, and continues from there unless ``pause`` is ``True``. The
+        snapshot must have been saved from the same target.
+
         If ``pause`` is ``True`` the emulator gets paused.
 
         If ``debug`` is ``True`` the emulator runs in the foreground with
@@ -940,7 +966,12 @@ class Launcher(ABC):
         os.makedirs(wdir, mode=0o700, exist_ok=True)
 
         cmd = self._pre_start(
-            target=target, file=file, pause=pause, debug=debug, args=args
+            target=target,
+            file=file,
+            pause=pause,
+            debug=debug,
+            args=args,
+            snapshot=snapshot,
         )
 
         if debug:
@@ -73,11 +73,17 @@ class Emulator:
         debug: bool = False,
         foreground: bool = False,
         args: Optional[str] = None,
+        snapshot: Optional[Path] = None,
     ) -> None:
         """Starts the emulator for the given ``target``.
 
         If ``file`` is set the emulator loads the file before starting.
 
+        If ``snapshot`` is set the emulator restores a snapshot saved with
+        :py:meth:`save_snapshot` instead of booting the target. This skips the
+        target's boot, so tests that each start from a freshly booted target
+        can share one snapshot.
+
         If ``pause`` is ``True`` the emulator pauses until the debugger is
         connected.
 
@@ -105,6 +111,7 @@ class Emulator:
             debug=debug,
             foreground=foreground,
             args=args,
+            snapshot=snapshot,
         )
 
     def _c(self) -> Connector:
@@ -268,6 +275,18 @@ class Emulator:
 
         self._c().cont()
 
+    def save_snapshot(self, path: Path) -> None:
+        """Saves the emulator's state to the snapshot file ``path``.
+
+        The emulator is paused while saving and stays paused afterwards; use
+        :py:meth:`cont` to resume it. Pass the snapshot to :py:meth:`start` to
+        start other instances of the same target from this state.
+
+        Only QEMU supports snapshots.
+        """
+
+        self._c().save_snapshot(path)
+
 
 class TemporaryEmulator(Emulator):
     """Temporary emulator instances.
@@ -311,15 +330,21 @@ class TemporaryEmulator(Emulator):
     ) -> None:
         self._temp = tempfile.TemporaryDirectory()
         self._cleanup = cleanup
+        self._prev_wdir: Optional[str] = None
         super().__init__(Path(self._temp.name), config_path)
 
     def __enter__(self):
-        # Interoperability with pw emu cli.
-        os.environ["PW_EMU_WDIR"] = self._wdir
+        # Interoperability with pw emu cli. Restore the previous value on exit
+        # so that temporary emulators can be nested.
+        self._prev_wdir = os.environ.get("PW_EMU_WDIR")
+        os.environ["PW_EMU_WDIR"] = str(self._wdir)
         return self
 
     def __exit__(self, exc, value, traceback) -> None:
         self.stop()
-        del os.environ["PW_EMU_WDIR"]
+        if self._prev_wdir is None:
+            del os.environ["PW_EMU_WDIR"]
+        else:
+            os.environ["PW_EMU_WDIR"] = self._prev_wdir
         if self._cleanup:
             self._temp.cleanup()
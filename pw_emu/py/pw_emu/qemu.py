@@ -19,8 +19,10 @@ import json
 import logging
 import os
 import re
+import shlex
 import socket
 import sys
+import time
 
 from pathlib import Path
 from typing import Optional, Dict, List, Any
@@ -32,11 +34,15 @@ from pw_emu.core import (
     Error,
     InvalidChannelType,
     RunError,
+    SnapshotError,
     WrongEmulator,
 )
 
 _QMP_LOG = logging.getLogger('pw_qemu.qemu.qmp')
 
+# How long to wait for a snapshot to be saved or restored.
+_SNAPSHOT_TIMEOUT = 60
+
 
 class QmpError(Error):
     """Exception for QMP errors."""
@@ -99,6 +105,7 @@ class QemuLauncher(Launcher):
         }
         self._chardevs: Dict[str, Any] = {}
         self._qmp_init_sock: Optional[socket.socket] = None
+        self._snapshot: Optional[Path] = None
 
     def _set_qemu_channel_tcp(self, name: str, filename: str) -> None:
         """Parse a TCP chardev and return (host, port) tuple.
@@ -248,6 +255,7 @@ class QemuLauncher(Launcher):
         pause: bool = False,
         debug: bool = False,
         args: Optional[str] = None,
+        snapshot: Optional[Path] = None,
     ) -> List[str]:
         qemu = self._config.get_target_emu(['executable'])
         if not qemu:
@@ -272,6 +280,16 @@ class QemuLauncher(Launcher):
         if file:
             self._start_cmd.extend(['-kernel', str(file)])
 
+        # Snapshots are saved and restored through migration to a file rather
+        # than with savevm / loadvm, since those need a disk image and most
+        # microcontroller targets have none.
+        self._snapshot = snapshot
+        if snapshot:
+            if sys.platform == 'win32':
+                raise SnapshotError('qemu', 'not supported on win32')
+            path = shlex.quote(str(Path(snapshot).resolve()))
+            self._start_cmd.extend(['-incoming', f'exec:cat {path}'])
+
         self._start_cmd.extend(self._config.get_emu(['args'], entry_type=list))
         self._start_cmd.extend(
             self._config.get_target_emu(['args'], entry_type=list)
@@ -309,6 +327,23 @@ class QemuLauncher(Launcher):
             if name:
                 self._set_qemu_channel(name, chardev['filename'])
 
+        if self._snapshot:
+            self._wait_for_snapshot_restore(qmp)
+
+    @staticmethod
+    def _wait_for_snapshot_restore(qmp: QmpClient) -> None:
+        """Waits until qemu has finished loading the incoming snapshot."""
+
+        deadline = time.monotonic() + _SNAPSHOT_TIMEOUT
+        try:
+            while qmp.request('query-status')['status'] == 'inmigrate':
+                if time.monotonic() > deadline:
+                    raise RunError('qemu', 'snapshot restore timeout')
+                time.sleep(0.05)
+        except (json.decoder.JSONDecodeError, OSError):
+            # qemu exits if the snapshot can not be loaded.
+            raise RunError('qemu', 'snapshot restore failed')
+
     def _get_connector(self, wdir: Path) -> Connector:
         return QemuConnector(wdir)
 
@@ -353,3 +388,26 @@ class QemuConnector(Connector):
             'path': '{}'.format(path),
         }
         return self._q().request('qom-list', args)
+
+    def save_snapshot(self, path: Path) -> None:
+        if sys.platform == 'win32':
+            raise SnapshotError('qemu', 'not supported on win32')
+
+        # Migrating to a file saves the complete machine state, including
+        # memory and device registers, without needing a disk image.
+        self._q().request('stop')
+        dest = shlex.quote(str(Path(path).resolve()))
+        self._q().request('migrate', {'uri': f'exec:cat > {dest}'})
+
+        deadline = time.monotonic() + _SNAPSHOT_TIMEOUT
+        while True:
+            resp = self._q().request('query-migrate')
+            status = resp.get('status')
+            if status == 'completed':
+                return
+            if status in ('failed', 'cancelled'):
+                raise SnapshotError('qemu', resp.get('error-desc', status))
+            if time.monotonic() > deadline:
+                self._q().request('migrate_cancel')
+                raise SnapshotError('qemu', 'timeout')
+            time.sleep(0.05)
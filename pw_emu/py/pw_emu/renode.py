@@ -27,6 +27,7 @@ from pw_emu.core import (
     InvalidChannelType,
     Launcher,
     RunError,
+    SnapshotError,
     WrongEmulator,
 )
 
@@ -68,7 +69,11 @@ class RenodeLauncher(Launcher):
         pause: bool = False,
         debug: bool = False,
         args: Optional[str] = None,
+        snapshot: Optional[Path] = None,
     ) -> List[str]:
+        if snapshot:
+            raise SnapshotError('renode', 'restoring snapshots not supported')
+
         renode = self._config.get_target_emu(['executable'])
         if not renode:
             renode = self._config.get_emu(['executable'], optional=False)
@@ -208,3 +213,8 @@ class RenodeConnector(Connector):
 
     def set_property(self, path: str, prop: str, value: Any) -> None:
         return self._request('ExecuteCommand', [f'{path} {prop} {value}'])
+
+    def save_snapshot(self, path: Path) -> None:
+        # renode's saved state includes the terminals and their ports, so a
+        # restored instance conflicts with the original one.
+        raise SnapshotError('renode', 'saving snapshots not supported')
@@ -14,8 +14,10 @@
 # the License.
 """Emulator API tests."""
 
+import tempfile
 import unittest
 
+from pathlib import Path
 from typing import Any, Dict
 
 from pw_emu.core import (
@@ -24,6 +26,7 @@ from pw_emu.core import (
     InvalidProperty,
     InvalidPropertyPath,
 )
+from pw_emu.frontend import Emulator
 from mock_emu_frontend import _mock_emu
 from tests.common import ConfigHelperWithEmulator
 
@@ -102,6 +105,20 @@ class TestEmulator(ConfigHelperWithEmulator):
         self._emu.set_property('path1', 'prop1', 'val2')
         self.assertEqual(self._emu.get_property('path1', 'prop1'), 'val2')
 
+    def test_snapshot(self) -> None:
+        self._emu.set_property('path1', 'prop1', 'saved')
+        snapshot = Path(self._wdir.name, 'snapshot')
+        self._emu.save_snapshot(snapshot)
+        self._emu.set_property('path1', 'prop1', 'not saved')
+
+        with tempfile.TemporaryDirectory() as wdir:
+            emu = Emulator(Path(wdir), Path(self._config_file))
+            emu.start('test-target', snapshot=snapshot)
+            try:
+                self.assertEqual(emu.get_property('path1', 'prop1'), 'saved')
+            finally:
+                emu.stop()
+
     def test_get_channel_type(self) -> None:
         self.assertEqual(self._emu.get_channel_type('gdb'), 'tcp')
 
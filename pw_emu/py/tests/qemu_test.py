@@ -26,6 +26,7 @@ from pathlib import Path
 from typing import Any, Dict, Optional
 
 from pw_emu.core import InvalidChannelName, InvalidChannelType
+from pw_emu.frontend import Emulator
 from tests.common import check_prog, ConfigHelperWithEmulator
 
 
@@ -101,6 +102,23 @@ class TestQemu(ConfigHelperWithEmulator):
         with self.assertRaises(InvalidChannelName):
             self._emu.get_channel_addr('serial1')
 
+    def test_snapshot(self) -> None:
+        snapshot = Path(self._wdir.name, 'snapshot')
+        self._emu.save_snapshot(snapshot)
+        self.assertGreater(snapshot.stat().st_size, 0)
+
+        with tempfile.TemporaryDirectory() as wdir:
+            emu = Emulator(Path(wdir), Path(self._config_file))
+            emu.start(target='test-target', pause=True, snapshot=snapshot)
+            try:
+                self.assertTrue(emu.running())
+                self.assertEqual(
+                    emu.get_property('/machine', 'type'),
+                    'lm3s6965evb-machine',
+                )
+            finally:
+                emu.stop()
+
     def get_reg(self, addr: int) -> bytes:
         temp = tempfile.NamedTemporaryFile(delete=False)
         temp.close()
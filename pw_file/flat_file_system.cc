@@ -24,6 +24,7 @@
 #include "pw_bytes/span.h"
 #include "pw_file/file.pwpb.h"
 #include "pw_log/log.h"
+#include "pw_protobuf/config.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_protobuf/encoder.h"
 #include "pw_protobuf/serialized_size.h"
@@ -42,12 +43,19 @@ Status FlatFileSystemService::EnumerateFile(
   if (!sws.ok()) {
     return sws.status();
   }
+  return EncodePath(entry, sws.size(), output_encoder);
+}
+
+Status FlatFileSystemService::EncodePath(
+    Entry& entry,
+    size_t name_length,
+    pwpb::ListResponse::StreamEncoder& output_encoder) {
   {
     pwpb::Path::StreamEncoder encoder = output_encoder.GetPathsEncoder();
 
     encoder
         .WritePath(reinterpret_cast<const char*>(file_name_buffer_.data()),
-                   sws.size())
+                   name_length)
         .IgnoreError();
     encoder.WriteSizeBytes(entry.SizeBytes()).IgnoreError();
     encoder.WritePermissions(entry.Permissions()).IgnoreError();
@@ -56,21 +64,87 @@ Status FlatFileSystemService::EnumerateFile(
   return output_encoder.status();
 }
 
-void FlatFileSystemService::EnumerateAllFiles(RawServerWriter& writer) {
-  for (Entry* entry : entries_) {
+size_t FlatFileSystemService::EncodePaths(
+    pwpb::ListResponse::MemoryEncoder& encoder,
+    size_t index,
+    size_t& paths_remaining) {
+  for (; index < entries_.size() && paths_remaining > 0; ++index) {
+    Entry* entry = entries_[index];
     PW_DCHECK_NOTNULL(entry);
-    // For now, don't try to pack entries.
-    pwpb::ListResponse::MemoryEncoder encoder(encoding_buffer_);
-    if (Status status = EnumerateFile(*entry, encoder); !status.ok()) {
-      if (status != Status::NotFound()) {
+
+    StatusWithSize sws = entry->Name(file_name_buffer_);
+    if (!sws.ok()) {
+      if (sws.status() != Status::NotFound()) {
         PW_LOG_ERROR("Failed to enumerate file (id: %u) with status %d",
                      static_cast<unsigned>(entry->FileId()),
-                     static_cast<int>(status.code()));
+                     static_cast<int>(sws.status().code()));
+      }
+      continue;
+    }
+
+    // The nested Path encoder reserves space for the largest length prefix
+    // while it is open.
+    const size_t path_size_bytes =
+        protobuf::TagSizeBytes(pwpb::ListResponse::Fields::kPaths) +
+        protobuf::config::kMaxVarintSize +
+        protobuf::SizeOfFieldString(pwpb::Path::Fields::kPath, sws.size()) +
+        protobuf::SizeOfFieldUint32(
+            pwpb::Path::Fields::kSizeBytes,
+            static_cast<uint32_t>(entry->SizeBytes())) +
+        protobuf::SizeOfFieldEnum(pwpb::Path::Fields::kPermissions,
+                                  entry->Permissions()) +
+        protobuf::SizeOfFieldUint32(pwpb::Path::Fields::kFileId,
+                                    entry->FileId());
+    if (path_size_bytes > encoder.ConservativeWriteLimit()) {
+      if (encoder.size() > 0) {
+        break;  // List this entry in the next response.
       }
+      PW_LOG_ERROR("File (id: %u) is too large to enumerate",
+                   static_cast<unsigned>(entry->FileId()));
       continue;
     }
 
-    Status write_status = writer.Write(encoder);
+    if (!EncodePath(*entry, sws.size(), encoder).ok()) {
+      break;
+    }
+    paths_remaining -= 1;
+  }
+  return index;
+}
+
+void FlatFileSystemService::EnumerateAllFiles(RawServerWriter& writer,
+                                              size_t start_index,
+                                              size_t max_paths) {
+  size_t index = start_index;
+  size_t paths_remaining = max_paths == 0 ? entries_.size() : max_paths;
+
+  while (index < entries_.size() && paths_remaining > 0) {
+    pwpb::ListResponse::MemoryEncoder encoder(encoding_buffer_);
+    index = EncodePaths(encoder, index, paths_remaining);
+
+    // If the listing stopped at max_paths, tell the client where to continue.
+    bool next_index_pending = paths_remaining == 0 && index < entries_.size();
+    if (next_index_pending &&
+        encoder.ConservativeWriteLimit() >=
+            protobuf::SizeOfFieldUint32(pwpb::ListResponse::Fields::kNextIndex,
+                                        static_cast<uint32_t>(index))) {
+      encoder.WriteNextIndex(static_cast<uint32_t>(index)).IgnoreError();
+      next_index_pending = false;
+    }
+
+    Status write_status = encoder.status();
+    if (write_status.ok() && encoder.size() > 0) {
+      write_status = writer.Write(encoder);
+    }
+    if (write_status.ok() && next_index_pending) {
+      pwpb::ListResponse::MemoryEncoder next_index_encoder(encoding_buffer_);
+      next_index_encoder.WriteNextIndex(static_cast<uint32_t>(index))
+          .IgnoreError();
+      write_status = next_index_encoder.status();
+      if (write_status.ok()) {
+        write_status = writer.Write(next_index_encoder);
+      }
+    }
     if (!write_status.ok()) {
       writer.Finish(write_status)
           .IgnoreError();  // TODO: b/242598609 - Handle Status properly
@@ -84,13 +158,23 @@ void FlatFileSystemService::EnumerateAllFiles(RawServerWriter& writer) {
 void FlatFileSystemService::List(ConstByteSpan request,
                                  RawServerWriter& writer) {
   protobuf::Decoder decoder(request);
-  // If a file name was provided, try and find and enumerate the file.
+  uint32_t start_index = 0;
+  uint32_t max_paths = 0;
   while (decoder.Next().ok()) {
-    if (decoder.FieldNumber() !=
-        static_cast<uint32_t>(pwpb::ListRequest::Fields::kPath)) {
-      continue;
+    switch (static_cast<pwpb::ListRequest::Fields>(decoder.FieldNumber())) {
+      case pwpb::ListRequest::Fields::kPath:
+        break;
+      case pwpb::ListRequest::Fields::kStartIndex:
+        decoder.ReadUint32(&start_index).IgnoreError();
+        continue;
+      case pwpb::ListRequest::Fields::kMaxPaths:
+        decoder.ReadUint32(&max_paths).IgnoreError();
+        continue;
+      default:
+        continue;
     }
 
+    // If a file name was provided, try and find and enumerate the file.
     std::string_view file_name_view;
     if (!decoder.ReadString(&file_name_view).ok() || file_name_view.empty()) {
       writer.Finish(Status::DataLoss())
@@ -119,8 +203,9 @@ void FlatFileSystemService::List(ConstByteSpan request,
     return;
   }
 
-  // If no path was provided in the ListRequest, just enumerate everything.
-  EnumerateAllFiles(writer);
+  // If no path was provided in the ListRequest, enumerate everything from the
+  // requested start index.
+  EnumerateAllFiles(writer, start_index, max_paths);
 }
 
 void FlatFileSystemService::Delete(ConstByteSpan request,
@@ -135,6 +135,12 @@ size_t ValidateExpectedPaths(
   for (ConstByteSpan response : results) {
     protobuf::Decoder decoder(response);
     while (decoder.Next().ok()) {
+      if (decoder.FieldNumber() ==
+          static_cast<uint32_t>(
+              pw::file::pwpb::ListResponse::Fields::kNextIndex)) {
+        continue;
+      }
+
       constexpr uint32_t kListResponsePathsFieldNumber =
           static_cast<uint32_t>(pw::file::pwpb::ListResponse::Fields::kPaths);
       EXPECT_EQ(decoder.FieldNumber(), kListResponsePathsFieldNumber);
@@ -160,6 +166,24 @@ size_t ValidateExpectedPaths(
   return serialized_path_entry_count;
 }
 
+// Returns the next_index from a listing's responses, or -1 if there is none.
+int64_t NextIndex(const rpc::PayloadsView& results) {
+  int64_t next_index = -1;
+  for (ConstByteSpan response : results) {
+    protobuf::Decoder decoder(response);
+    while (decoder.Next().ok()) {
+      if (decoder.FieldNumber() ==
+          static_cast<uint32_t>(
+              pw::file::pwpb::ListResponse::Fields::kNextIndex)) {
+        uint32_t value;
+        EXPECT_EQ(OkStatus(), decoder.ReadUint32(&value));
+        next_index = value;
+      }
+    }
+  }
+  return next_index;
+}
+
 TEST(FlatFileSystem, EncodingBufferSizeBytes) {
   EXPECT_EQ(FlatFileSystemService::EncodingBufferSizeBytes(10),
             2u /* path nested message key and size */ + 12 /* path */ +
@@ -228,5 +252,59 @@ TEST(FlatFileSystem, List_FileMissingName) {
   EXPECT_EQ(2u, ValidateExpectedPaths(static_file_system, ctx.responses()));
 }
 
+TEST(FlatFileSystem, List_PacksPathsIntoResponses) {
+  std::array<FakeFile, 3> files{
+      {{"SNAP_001", 372, 9}, {"tokens.csv", 808, 15038202}, {"a.txt", 0, 2}}};
+  std::array<FlatFileSystemService::Entry*, 3> static_file_system{
+      &files[0], &files[1], &files[2]};
+
+  PW_RAW_TEST_METHOD_CONTEXT(FlatFileSystemServiceWithBuffer<10, 3>, List)
+  ctx(static_file_system);
+  ctx.call(ConstByteSpan());
+
+  EXPECT_TRUE(ctx.done());
+  EXPECT_EQ(OkStatus(), ctx.status());
+  EXPECT_EQ(1u, ctx.responses().size());
+  EXPECT_EQ(3u, ValidateExpectedPaths(static_file_system, ctx.responses()));
+  EXPECT_EQ(-1, NextIndex(ctx.responses()));
+}
+
+TEST(FlatFileSystem, List_Paginated) {
+  std::array<FakeFile, 4> files{{{"SNAP_001", 372, 9},
+                                 {"", 808, 15038202},
+                                 {"a.txt", 0, 2},
+                                 {"b.txt", 1, 3}}};
+  std::array<FlatFileSystemService::Entry*, 4> static_file_system{
+      &files[0], &files[1], &files[2], &files[3]};
+
+  std::array<std::byte, 16> request_buffer;
+  pwpb::ListRequest::MemoryEncoder request(request_buffer);
+  ASSERT_EQ(OkStatus(), request.WriteMaxPaths(2));
+
+  PW_RAW_TEST_METHOD_CONTEXT(FlatFileSystemServiceWithBuffer<10, 3>, List)
+  ctx(static_file_system);
+  ctx.call(request);
+
+  EXPECT_TRUE(ctx.done());
+  EXPECT_EQ(OkStatus(), ctx.status());
+  EXPECT_EQ(2u, ValidateExpectedPaths(static_file_system, ctx.responses()));
+  ASSERT_EQ(3, NextIndex(ctx.responses()));
+
+  pwpb::ListRequest::MemoryEncoder next_request(request_buffer);
+  ASSERT_EQ(OkStatus(), next_request.WriteStartIndex(3));
+  ASSERT_EQ(OkStatus(), next_request.WriteMaxPaths(2));
+
+  PW_RAW_TEST_METHOD_CONTEXT(FlatFileSystemServiceWithBuffer<10, 3>, List)
+  next_ctx(static_file_system);
+  next_ctx.call(next_request);
+
+  EXPECT_TRUE(next_ctx.done());
+  EXPECT_EQ(OkStatus(), next_ctx.status());
+  EXPECT_EQ(1u,
+            ValidateExpectedPaths(span(static_file_system).subspan(3),
+                                  next_ctx.responses()));
+  EXPECT_EQ(-1, NextIndex(next_ctx.responses()));
+}
+
 }  // namespace
 }  // namespace pw::file
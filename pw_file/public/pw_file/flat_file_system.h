@@ -102,6 +102,10 @@ class FlatFileSystemService
         entries_(entry_list) {}
 
   // Method definitions for pw.file.FileSystem.
+  //
+  // Lists as many paths in each response as fit in the encoding buffer. A
+  // ListRequest's start_index is an index into the entry list, so the paths
+  // listed after a given index are stable as long as the list is unchanged.
   void List(ConstByteSpan request, RawServerWriter& writer);
 
   // Returns:
@@ -126,7 +130,25 @@ class FlatFileSystemService
 
   Status EnumerateFile(Entry& entry,
                        pwpb::ListResponse::StreamEncoder& output_encoder);
-  void EnumerateAllFiles(RawServerWriter& writer);
+
+  // Encodes a Path for the entry, whose name of name_length bytes has already
+  // been read to file_name_buffer_.
+  Status EncodePath(Entry& entry,
+                    size_t name_length,
+                    pwpb::ListResponse::StreamEncoder& output_encoder);
+
+  // Encodes the paths of entries, starting with entries_[index], until the
+  // encoder is full or paths_remaining paths have been encoded. Returns the
+  // index of the first entry that was not encoded.
+  size_t EncodePaths(pwpb::ListResponse::MemoryEncoder& encoder,
+                     size_t index,
+                     size_t& paths_remaining);
+
+  // Lists up to max_paths paths, or all of them if max_paths is zero, starting
+  // with entries_[start_index].
+  void EnumerateAllFiles(RawServerWriter& writer,
+                         size_t start_index,
+                         size_t max_paths);
 
   const span<std::byte> encoding_buffer_;
   const span<char> file_name_buffer_;
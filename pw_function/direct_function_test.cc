@@ -0,0 +1,175 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_function/direct_function.h"
+
+#include <memory>
+
+#include "pw_compilation_testing/negative_compilation.h"
+#include "pw_polyfill/language_feature_macros.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+#if PW_NC_TEST(CallableTooLarge)
+PW_NC_EXPECT("The callable is too large");
+
+[[maybe_unused]] void TooLarge() {
+  int a = 1, b = 2, c = 3;
+  DirectFunction<int(), sizeof(int) * 2> function(
+      [a, b, c]() { return a + b + c; });
+}
+
+#elif PW_NC_TEST(CannotCopy)
+PW_NC_EXPECT("delete");
+
+[[maybe_unused]] void Copy() {
+  DirectFunction<void()> function;
+  DirectFunction<void()> copy(function);
+}
+
+#elif PW_NC_TEST(CannotCallConstCallback)
+PW_NC_EXPECT("no match");
+
+[[maybe_unused]] void CallConst(const DirectCallback<void()>& callback) {
+  callback();
+}
+
+#endif  // PW_NC_TEST
+
+// Ensure that DirectFunction can be constant initialized.
+[[maybe_unused]] PW_CONSTINIT DirectFunction<void()>
+    can_be_constant_initialized;
+
+int Multiply(int a, int b) { return a * b; }
+
+TEST(DirectFunction, FreeFunction) {
+  DirectFunction<int(int, int)> multiply(Multiply);
+  ASSERT_TRUE(multiply);
+  EXPECT_EQ(multiply(3, 7), 21);
+}
+
+TEST(DirectFunction, Null) {
+  DirectFunction<void()> function;
+  EXPECT_FALSE(function);
+  EXPECT_EQ(function, nullptr);
+
+  function = [] {};
+  EXPECT_TRUE(function);
+  EXPECT_NE(function, nullptr);
+
+  function = nullptr;
+  EXPECT_FALSE(function);
+}
+
+TEST(DirectFunction, NullFunctionPointerIsNull) {
+  int (*null_function)(int, int) = nullptr;
+  DirectFunction<int(int, int)> function(null_function);
+  EXPECT_FALSE(function);
+}
+
+TEST(DirectFunction, CapturingLambdaUsesSizeFromTemplateArgument) {
+  int a = 1, b = 2, c = 3, d = 4;
+  DirectFunction<int(int), sizeof(int) * 4> sum(
+      [a, b, c, d](int e) { return a + b + c + d + e; });
+  EXPECT_EQ(sum(5), 15);
+}
+
+TEST(DirectFunction, MutableLambdaKeepsState) {
+  DirectFunction<int()> counter([count = 0]() mutable { return ++count; });
+  EXPECT_EQ(counter(), 1);
+  EXPECT_EQ(counter(), 2);
+  EXPECT_EQ(counter(), 3);
+}
+
+TEST(DirectFunction, MoveTrivialCallable) {
+  int value = 0;
+  DirectFunction<void(int)> set([&value](int v) { value = v; });
+  DirectFunction<void(int)> moved(std::move(set));
+  EXPECT_FALSE(set);  // NOLINT(bugprone-use-after-move)
+  ASSERT_TRUE(moved);
+  moved(42);
+  EXPECT_EQ(value, 42);
+}
+
+TEST(DirectFunction, MoveNonTrivialCallable) {
+  auto value = std::make_shared<int>(7);
+  std::weak_ptr<int> weak = value;
+  DirectFunction<int(), sizeof(std::shared_ptr<int>)> get(
+      [captured = std::move(value)]() { return *captured; });
+
+  DirectFunction<int(), sizeof(std::shared_ptr<int>)> moved;
+  moved = std::move(get);
+  EXPECT_FALSE(get);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(weak.use_count(), 1);
+  EXPECT_EQ(moved(), 7);
+
+  moved = nullptr;
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(DirectFunction, DestroysCallable) {
+  auto value = std::make_shared<int>(7);
+  std::weak_ptr<int> weak = value;
+  {
+    DirectFunction<int(), sizeof(std::shared_ptr<int>)> get(
+        [captured = std::move(value)]() { return *captured; });
+    EXPECT_FALSE(weak.expired());
+  }
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(DirectFunction, ReassignDestroysPreviousCallable) {
+  auto value = std::make_shared<int>(7);
+  std::weak_ptr<int> weak = value;
+  DirectFunction<int(), sizeof(std::shared_ptr<int>)> get(
+      [captured = std::move(value)]() { return *captured; });
+  get = [] { return 3; };
+  EXPECT_TRUE(weak.expired());
+  EXPECT_EQ(get(), 3);
+}
+
+TEST(DirectCallback, DestroysCallableWhenCalled) {
+  auto value = std::make_shared<int>(7);
+  std::weak_ptr<int> weak = value;
+  DirectCallback<int(), sizeof(std::shared_ptr<int>)> get(
+      [captured = std::move(value)]() {
+        EXPECT_EQ(captured.use_count(), 1);
+        return *captured;
+      });
+
+  ASSERT_TRUE(get);
+  EXPECT_EQ(get(), 7);
+  EXPECT_FALSE(get);
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(DirectCallback, CanBeReassignedWhileCalled) {
+  DirectCallback<void(), sizeof(void*)> callback;
+  callback = [&callback] { callback = [] {}; };
+  callback();
+  EXPECT_TRUE(callback);
+  callback();
+  EXPECT_FALSE(callback);
+}
+
+TEST(DirectCallback, MoveOnlyArguments) {
+  DirectCallback<int(std::unique_ptr<int>)> take(
+      [](std::unique_ptr<int> value) { return *value; });
+  EXPECT_EQ(take(std::make_unique<int>(5)), 5);
+}
+
+}  // namespace
+}  // namespace pw
@@ -0,0 +1,227 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_function/config.h"
+#include "pw_preprocessor/compiler.h"
+
+namespace pw {
+namespace function_internal {
+
+// Operations needed to move and destroy a callable that is not trivially
+// copyable. These are not used to invoke the callable.
+struct DirectTargetOps {
+  void (*move)(void* from, void* to);
+  void (*destroy)(void* bits);
+};
+
+template <typename Callable>
+inline constexpr DirectTargetOps kDirectTargetOps = {
+    [](void* from, void* to) {
+      Callable& source = *static_cast<Callable*>(from);
+      new (to) Callable(std::move(source));
+      source.~Callable();
+    },
+    [](void* bits) { static_cast<Callable*>(bits)->~Callable(); },
+};
+
+template <std::size_t kInlineSize,
+          bool kCallOnce,
+          typename FunctionType>
+class DirectFunctionImpl;
+
+template <std::size_t kInlineSize,
+          bool kCallOnce,
+          typename Result,
+          typename... Args>
+class DirectFunctionImpl<kInlineSize, kCallOnce, Result(Args...)> {
+ private:
+  template <typename Callable>
+  static constexpr bool kIsCallable =
+      !std::is_same_v<std::decay_t<Callable>, DirectFunctionImpl> &&
+      std::is_invocable_r_v<Result, std::decay_t<Callable>&, Args...>;
+
+ public:
+  using result_type = Result;
+
+  constexpr DirectFunctionImpl() = default;
+  constexpr DirectFunctionImpl(std::nullptr_t) {}
+
+  /// Stores `callable` inline. It is a compile-time error for a callable to
+  /// be too large or too strictly aligned to fit.
+  template <typename Callable,
+            typename = std::enable_if_t<kIsCallable<Callable>>>
+  DirectFunctionImpl(Callable&& callable) {
+    Assign(std::forward<Callable>(callable));
+  }
+
+  DirectFunctionImpl(DirectFunctionImpl&& other) { MoveFrom(other); }
+
+  DirectFunctionImpl& operator=(DirectFunctionImpl&& other) {
+    if (&other != this) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  DirectFunctionImpl& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  template <typename Callable,
+            typename = std::enable_if_t<kIsCallable<Callable>>>
+  DirectFunctionImpl& operator=(Callable&& callable) {
+    Reset();
+    Assign(std::forward<Callable>(callable));
+    return *this;
+  }
+
+  DirectFunctionImpl(const DirectFunctionImpl&) = delete;
+  DirectFunctionImpl& operator=(const DirectFunctionImpl&) = delete;
+
+  ~DirectFunctionImpl() { Reset(); }
+
+  explicit operator bool() const { return invoke_ != &InvokeNull; }
+
+  friend bool operator==(const DirectFunctionImpl& function, std::nullptr_t) {
+    return !function;
+  }
+  friend bool operator!=(const DirectFunctionImpl& function, std::nullptr_t) {
+    return static_cast<bool>(function);
+  }
+
+  /// Invokes the callable. Invoking a null function crashes.
+  template <bool kOnce = kCallOnce, typename = std::enable_if_t<!kOnce>>
+  Result operator()(Args... args) const {
+    return invoke_(bits_, std::forward<Args>(args)...);
+  }
+
+  /// Invokes and then destroys the callable, leaving this callback null.
+  /// Invoking a null callback crashes.
+  template <bool kOnce = kCallOnce, typename = std::enable_if_t<kOnce>>
+  Result operator()(Args... args) {
+    DirectFunctionImpl target(std::move(*this));
+    return target.invoke_(target.bits_, std::forward<Args>(args)...);
+  }
+
+ private:
+  static Result InvokeNull(void*, Args...) {
+    PW_ASSERT(false);
+    PW_UNREACHABLE;
+  }
+
+  template <typename Callable>
+  static Result InvokeTarget(void* bits, Args... args) {
+    return std::invoke(*static_cast<Callable*>(bits),
+                       std::forward<Args>(args)...);
+  }
+
+  template <typename Callable>
+  void Assign(Callable&& callable) {
+    using Target = std::decay_t<Callable>;
+    static_assert(sizeof(Target) <= kInlineSize,
+                  "The callable is too large for this function's inline "
+                  "storage. Increase the inline size template argument or "
+                  "reduce the callable's size (e.g. capture less).");
+    static_assert(alignof(Target) <= alignof(std::max_align_t),
+                  "The callable is too strictly aligned to be stored inline");
+
+    if constexpr (std::is_pointer_v<Target> ||
+                  std::is_member_pointer_v<Target>) {
+      const Target target = callable;
+      if (target == nullptr) {
+        return;
+      }
+    }
+    new (bits_) Target(std::forward<Callable>(callable));
+    invoke_ = &InvokeTarget<Target>;
+    if constexpr (!std::is_trivially_copyable_v<Target> ||
+                  !std::is_trivially_destructible_v<Target>) {
+      ops_ = &kDirectTargetOps<Target>;
+    }
+  }
+
+  // Leaves `other` null.
+  void MoveFrom(DirectFunctionImpl& other) {
+    if (other.ops_ == nullptr) {
+      std::memcpy(bits_, other.bits_, sizeof(bits_));
+    } else {
+      other.ops_->move(other.bits_, bits_);
+    }
+    invoke_ = std::exchange(other.invoke_, &InvokeNull);
+    ops_ = std::exchange(other.ops_, nullptr);
+  }
+
+  void Reset() {
+    if (ops_ != nullptr) {
+      ops_->destroy(bits_);
+      ops_ = nullptr;
+    }
+    invoke_ = &InvokeNull;
+  }
+
+  // The callable is invoked directly through this pointer rather than through
+  // a table of operations, so calls take a single indirect branch.
+  Result (*invoke_)(void*, Args...) = &InvokeNull;
+
+  // Null if the callable is trivially copyable and destructible, or if there
+  // is no callable.
+  const DirectTargetOps* ops_ = nullptr;
+
+  alignas(std::max_align_t) mutable std::byte bits_[kInlineSize] = {};
+};
+
+}  // namespace function_internal
+
+/// `pw::DirectFunction` is a variant of @cpp_type{pw::InlineFunction} that is
+/// optimized for calls on hot paths, such as RPC and async callbacks.
+///
+/// - Callables are always stored inline. The inline size is a template
+///   argument, so each API can size its callbacks independently of
+///   `PW_FUNCTION_INLINE_CALLABLE_SIZE`. Storing a callable that doesn't fit
+///   is a compile-time error at the point where it is stored, regardless of
+///   `PW_FUNCTION_ENABLE_DYNAMIC_ALLOCATION`.
+/// - The function stores a pointer to the callable's invoker alongside the
+///   callable, so calls take a single indirect branch instead of first loading
+///   a table of operations.
+/// - Trivially copyable callables, such as function pointers and lambdas that
+///   capture pointers or integers, are moved with a `memcpy`.
+///
+/// `pw::DirectFunction` is not convertible to or from `pw::Function`.
+template <typename FunctionType,
+          std::size_t inline_target_size =
+              function_internal::config::kInlineCallableSize>
+using DirectFunction = function_internal::
+    DirectFunctionImpl<inline_target_size, /*kCallOnce=*/false, FunctionType>;
+
+/// Single-use version of @cpp_type{pw::DirectFunction}. As with
+/// @cpp_type{pw::Callback}, the callable is destroyed when it is invoked,
+/// leaving the `pw::DirectCallback` null.
+template <typename FunctionType,
+          std::size_t inline_target_size =
+              function_internal::config::kInlineCallableSize>
+using DirectCallback = function_internal::
+    DirectFunctionImpl<inline_target_size, /*kCallOnce=*/true, FunctionType>;
+
+}  // namespace pw
@@ -82,6 +82,10 @@ using internal::Http2Error;
 using internal::kMaxConcurrentStreams;
 using internal::kMaxGrpcMessageSize;
 
+// How long SendResponseMessage waits for the client to grant send window.
+constexpr auto kSendWindowTimeout =
+    chrono::SystemClock::for_at_least(std::chrono::seconds(1));
+
 // RFC 9113 §3.4
 constexpr std::string_view kExpectedConnectionPrefaceLiteral(
     "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
@@ -227,6 +231,48 @@ Status SendHeaders(SendQueue& send_queue,
   return OkStatus();
 }
 
+// RFC 9113 §6.2 and §6.1
+// Sends a HEADERS frame followed by a DATA frame, in the same write.
+Status SendHeadersAndData(SendQueue& send_queue,
+                          StreamId stream_id,
+                          ConstByteSpan headers_payload,
+                          ConstByteSpan data_payload1,
+                          ConstByteSpan data_payload2) {
+  PW_LOG_DEBUG("Conn.Send HEADERS and DATA with id=%" PRIu32 " len=%" PRIu32
+               " data_len1=%" PRIu32 " data_len2=%" PRIu32,
+               stream_id,
+               static_cast<uint32_t>(headers_payload.size()),
+               static_cast<uint32_t>(data_payload1.size()),
+               static_cast<uint32_t>(data_payload2.size()));
+  WireFrameHeader headers_frame(FrameHeader{
+      .payload_length = static_cast<uint32_t>(headers_payload.size()),
+      .type = FrameType::HEADERS,
+      .flags = FLAGS_END_HEADERS,
+      .stream_id = stream_id,
+  });
+  WireFrameHeader data_frame(FrameHeader{
+      .payload_length =
+          static_cast<uint32_t>(data_payload1.size() + data_payload2.size()),
+      .type = FrameType::DATA,
+      .flags = 0,
+      .stream_id = stream_id,
+  });
+  std::array<ConstByteSpan, 5> vector = {AsBytes(headers_frame)};
+  size_t i = 1;
+  if (!headers_payload.empty()) {
+    vector[i++] = headers_payload;
+  }
+  vector[i++] = AsBytes(data_frame);
+  if (!data_payload1.empty()) {
+    vector[i++] = data_payload1;
+  }
+  if (!data_payload2.empty()) {
+    vector[i++] = data_payload2;
+  }
+  PW_TRY(send_queue.SendBytesVector(span{vector.data(), i}));
+  return OkStatus();
+}
+
 // RFC 9113 §6.4
 Status SendRstStream(SendQueue& send_queue,
                      StreamId stream_id,
@@ -376,45 +422,118 @@ Connection::SharedState::LookupStream(StreamId id) {
   return Status::NotFound();
 }
 
-Status Connection::Writer::SendResponseMessage(StreamId stream_id,
-                                               ConstByteSpan message) {
-  auto state = connection_.LockState();
-  auto stream = state->LookupStream(stream_id);
-  if (!stream.ok()) {
-    return Status::NotFound();
+bool Connection::SharedState::CanSend(const Stream& stream,
+                                      int32_t size) const {
+  if (size > stream.send_window || size > connection_send_window) {
+    return false;
   }
+  for (const Stream& other : streams) {
+    if (&other == &stream || other.id == 0 || other.window_wait_ticket == 0) {
+      continue;
+    }
+    const bool waited_longer =
+        stream.window_wait_ticket == 0 ||
+        other.window_wait_ticket < stream.window_wait_ticket;
+    if (waited_longer && other.window_wait_size <= other.send_window) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  if (message.size() > kMaxGrpcMessageSize) {
-    PW_LOG_WARN("Message %" PRIu32 " bytes on id=%" PRIu32
-                " exceeds maximum message size",
-                static_cast<uint32_t>(message.size()),
-                stream_id);
-    return Status::InvalidArgument();
+void Connection::SharedState::StartWaitingForWindow(Stream& stream,
+                                                    int32_t size) {
+  if (stream.window_wait_ticket == 0) {
+    stream.window_wait_ticket = next_window_wait_ticket++;
+    stream.window_wait_size = size;
   }
+}
 
-  // This should block until there is enough send window.
-  if (static_cast<int32_t>(message.size()) > stream->get().send_window ||
-      static_cast<int32_t>(message.size()) > state->connection_send_window) {
-    PW_LOG_WARN("Not enough window to send %" PRIu32 " bytes on id=%" PRIu32,
-                static_cast<uint32_t>(message.size()),
-                stream_id);
-    return Status::ResourceExhausted();
+void Connection::SharedState::StopWaitingForWindow(Stream& stream) {
+  if (stream.window_wait_ticket != 0) {
+    stream.window_wait_ticket = 0;
+    stream.window_wait_size = 0;
+    NotifyWindowWaiters();
   }
+}
 
-  auto status = OkStatus();
-  if (!stream->get().started_response) {
-    stream->get().started_response = true;
-    status = SendHeaders(connection_.send_queue_,
-                         stream_id,
-                         ResponseHeadersPayload(),
-                         ConstByteSpan(),
-                         /*end_stream=*/false);
+void Connection::SharedState::NotifyWindowWaiters() {
+  for (Stream& stream : streams) {
+    if (stream.id != 0 && stream.window_wait_ticket != 0) {
+      stream.window_available.release();
+    }
+  }
+}
+
+Status Connection::Writer::SendResponseMessage(StreamId stream_id,
+                                               ConstByteSpan message) {
+  const auto deadline =
+      chrono::SystemClock::TimePointAfterAtLeast(kSendWindowTimeout);
+  const int32_t size = static_cast<int32_t>(message.size());
+
+  while (true) {
+    sync::TimedThreadNotification* window_available;
+    {
+      auto state = connection_.LockState();
+      auto stream = state->LookupStream(stream_id);
+      if (!stream.ok()) {
+        return Status::NotFound();
+      }
+
+      if (message.size() > kMaxGrpcMessageSize) {
+        PW_LOG_WARN("Message %" PRIu32 " bytes on id=%" PRIu32
+                    " exceeds maximum message size",
+                    static_cast<uint32_t>(message.size()),
+                    stream_id);
+        return Status::InvalidArgument();
+      }
+
+      if (state->CanSend(stream->get(), size)) {
+        state->StopWaitingForWindow(stream->get());
+        return SendResponseMessageLocked(*state, stream->get(), message);
+      }
+
+      state->StartWaitingForWindow(stream->get(), size);
+      window_available = &stream->get().window_available;
+    }
+
+    // Wait without holding the lock, so that the reader can process
+    // WINDOW_UPDATE frames and other streams can send.
+    if (!window_available->try_acquire_until(deadline)) {
+      auto state = connection_.LockState();
+      if (auto stream = state->LookupStream(stream_id); stream.ok()) {
+        state->StopWaitingForWindow(stream->get());
+      }
+      PW_LOG_WARN("Not enough window to send %" PRIu32 " bytes on id=%" PRIu32,
+                  static_cast<uint32_t>(message.size()),
+                  stream_id);
+      return Status::ResourceExhausted();
+    }
   }
-  if (status.ok()) {
-    // Write a Length-Prefixed-Message payload.
-    ByteBuffer<5> prefix;
-    prefix.PutUint8(0);
-    prefix.PutUint32(message.size(), endian::big);
+}
+
+Status Connection::Writer::SendResponseMessageLocked(SharedState& state,
+                                                     Stream& stream,
+                                                     ConstByteSpan message) {
+  const StreamId stream_id = stream.id;
+
+  // Write a Length-Prefixed-Message payload.
+  ByteBuffer<5> prefix;
+  prefix.PutUint8(0);
+  prefix.PutUint32(message.size(), endian::big);
+
+  Status status;
+  if (!stream.started_response) {
+    stream.started_response = true;
+    status = SendHeadersAndData(connection_.send_queue_,
+                                stream_id,
+                                state.hpack_encoder.ResponseHeaders(),
+                                prefix,
+                                message);
+    if (!status.ok()) {
+      state.hpack_encoder.InvalidateTable();
+    }
+  } else {
     status = SendData(connection_.send_queue_, stream_id, prefix, message);
   }
   if (!status.ok()) {
@@ -423,8 +542,8 @@ Status Connection::Writer::SendResponseMessage(StreamId stream_id,
                 status.code());
     return Status::Unavailable();
   }
-  stream->get().send_window -= message.size();
-  state->connection_send_window -= message.size();
+  stream.send_window -= message.size();
+  state.connection_send_window -= message.size();
   return OkStatus();
 }
 
@@ -443,23 +562,25 @@ Status Connection::Writer::SendResponseComplete(StreamId stream_id,
     PW_LOG_DEBUG("Conn.SendResponseWithTrailers id=%" PRIu32 " code=%d",
                  stream_id,
                  response_code.code());
-    status = SendHeaders(connection_.send_queue_,
-                         stream_id,
-                         ResponseHeadersPayload(),
-                         ResponseTrailersPayload(response_code),
-                         /*end_stream=*/true);
+    status = SendHeaders(
+        connection_.send_queue_,
+        stream_id,
+        state->hpack_encoder.ResponseHeadersAndTrailers(response_code),
+        ConstByteSpan(),
+        /*end_stream=*/true);
   } else {
     PW_LOG_DEBUG("Conn.SendTrailers id=%" PRIu32 " code=%d",
                  stream_id,
                  response_code.code());
     status = SendHeaders(connection_.send_queue_,
                          stream_id,
+                         state->hpack_encoder.ResponseTrailers(response_code),
                          ConstByteSpan(),
-                         ResponseTrailersPayload(response_code),
                          /*end_stream=*/true);
   }
 
   if (!status.ok()) {
+    state->hpack_encoder.InvalidateTable();
     PW_LOG_WARN("Failed sending response complete on id=%" PRIu32 " error=%d",
                 stream_id,
                 status.code());
@@ -734,25 +855,6 @@ Status Connection::Reader::ProcessHeadersFrame(const FrameHeader& frame) {
 
   last_stream_id_ = frame.stream_id;
 
-  {
-    auto state = connection_.LockState();
-    if (auto stream = state->LookupStream(frame.stream_id); stream.ok()) {
-      PW_LOG_DEBUG("Client sent HEADERS after the first stream message");
-      // grpc requests cannot contain trailers.
-      // See: https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
-      PW_TRY(SendRstStreamAndClose(stream->get(), Http2Error::PROTOCOL_ERROR));
-      return OkStatus();
-    }
-  }
-
-  if ((frame.flags & FLAGS_END_STREAM) != 0) {
-    PW_LOG_DEBUG("Client sent HEADERS with END_STREAM");
-    // grpc requests must send END_STREAM in an empty DATA frame.
-    // See: https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
-    PW_TRY(SendRstStream(
-        connection_.send_queue_, frame.stream_id, Http2Error::PROTOCOL_ERROR));
-    return OkStatus();
-  }
   if ((frame.flags & FLAGS_END_HEADERS) == 0) {
     PW_LOG_ERROR("Client sent HEADERS frame without END_HEADERS: unsupported");
     SendGoAway(Http2Error::INTERNAL_ERROR);
@@ -779,14 +881,51 @@ Status Connection::Reader::ProcessHeadersFrame(const FrameHeader& frame) {
     payload = payload.subspan(5);
   }
 
-  PW_TRY_ASSIGN(auto method_name, HpackParseRequestHeaders(payload));
+  // RFC 9113 §4.3: "A receiver MUST terminate the connection with a connection
+  // error of type COMPRESSION_ERROR if it does not decompress a field block."
+  // Decode the block before any stream errors are handled, so that the HPACK
+  // dynamic table stays in sync with the client's.
+  auto method_name = hpack_decoder_.ParseRequestHeaders(payload);
+  if (!method_name.ok() && !method_name.status().IsNotFound()) {
+    PW_LOG_ERROR("Failed to decode HEADERS on id=%" PRIu32, frame.stream_id);
+    SendGoAway(Http2Error::COMPRESSION_ERROR);
+    return Status::Internal();
+  }
+
+  {
+    auto state = connection_.LockState();
+    if (auto stream = state->LookupStream(frame.stream_id); stream.ok()) {
+      PW_LOG_DEBUG("Client sent HEADERS after the first stream message");
+      // grpc requests cannot contain trailers.
+      // See: https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
+      PW_TRY(SendRstStreamAndClose(stream->get(), Http2Error::PROTOCOL_ERROR));
+      return OkStatus();
+    }
+  }
+
+  if ((frame.flags & FLAGS_END_STREAM) != 0) {
+    PW_LOG_DEBUG("Client sent HEADERS with END_STREAM");
+    // grpc requests must send END_STREAM in an empty DATA frame.
+    // See: https://github.com/grpc/grpc/blob/v1.60.x/doc/PROTOCOL-HTTP2.md.
+    PW_TRY(SendRstStream(
+        connection_.send_queue_, frame.stream_id, Http2Error::PROTOCOL_ERROR));
+    return OkStatus();
+  }
+
+  if (!method_name.ok()) {
+    PW_LOG_DEBUG("Client sent HEADERS without :path on id=%" PRIu32,
+                 frame.stream_id);
+    return SendRstStream(
+        connection_.send_queue_, frame.stream_id, Http2Error::PROTOCOL_ERROR);
+  }
+
   if (!CreateStream(frame.stream_id).ok()) {
     PW_LOG_WARN("Too many streams, rejecting id=%" PRIu32, frame.stream_id);
     return SendRstStream(
         connection_.send_queue_, frame.stream_id, Http2Error::REFUSED_STREAM);
   }
 
-  if (const auto status = callbacks_.OnNew(frame.stream_id, method_name);
+  if (const auto status = callbacks_.OnNew(frame.stream_id, *method_name);
       !status.ok()) {
     auto state = connection_.LockState();
     if (auto stream = state->LookupStream(frame.stream_id); stream.ok()) {
@@ -910,6 +1049,9 @@ Status Connection::Reader::ProcessSettingsFrame(const FrameHeader& frame,
           }
         }
         initial_send_window_ = newval;
+        if (delta > 0) {
+          state->NotifyWindowWaiters();
+        }
         break;
       }
       case SETTINGS_MAX_FRAME_SIZE:
@@ -922,8 +1064,10 @@ Status Connection::Reader::ProcessSettingsFrame(const FrameHeader& frame,
         // We never send frame payloads larger than 16384, so we don't need to
         // track the client's preference.
         break;
+      case SETTINGS_HEADER_TABLE_SIZE:
+        connection_.LockState()->hpack_encoder.SetMaxTableSize(value);
+        break;
       // Ignore these.
-      // SETTINGS_HEADER_TABLE_SIZE: our responses don't use the dynamic table
       // SETTINGS_ENABLE_PUSH: we don't support push
       // SETTINGS_MAX_CONCURRENT_STREAMS: we don't support push
       // SETTINGS_MAX_HEADER_LIST_SIZE: we send very tiny response HEADERS
@@ -1044,6 +1188,7 @@ Status Connection::Reader::ProcessWindowUpdateFrame(const FrameHeader& frame) {
     }
   }
 
+  state->NotifyWindowWaiters();
   return OkStatus();
 }
 
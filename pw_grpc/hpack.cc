@@ -15,6 +15,8 @@
 #include "pw_grpc_private/hpack.h"
 
 #include <array>
+#include <cstring>
+#include <optional>
 
 #include "pw_assert/check.h"
 #include "pw_bytes/byte_builder.h"
@@ -28,7 +30,88 @@ namespace pw::grpc {
 
 namespace {
 #include "hpack.autogen.inc"
-}
+
+// RFC 7541 Appendix A: names of the static table entries, by index - 1.
+constexpr std::array<std::string_view, 61> kStaticTableNames = {
+    ":authority",
+    ":method",
+    ":method",
+    ":path",
+    ":path",
+    ":scheme",
+    ":scheme",
+    ":status",
+    ":status",
+    ":status",
+    ":status",
+    ":status",
+    ":status",
+    ":status",
+    "accept-charset",
+    "accept-encoding",
+    "accept-language",
+    "accept-ranges",
+    "accept",
+    "access-control-allow-origin",
+    "age",
+    "allow",
+    "authorization",
+    "cache-control",
+    "content-disposition",
+    "content-encoding",
+    "content-language",
+    "content-length",
+    "content-location",
+    "content-range",
+    "content-type",
+    "cookie",
+    "date",
+    "etag",
+    "expect",
+    "expires",
+    "from",
+    "host",
+    "if-match",
+    "if-modified-since",
+    "if-none-match",
+    "if-range",
+    "if-unmodified-since",
+    "last-modified",
+    "link",
+    "location",
+    "max-forwards",
+    "proxy-authenticate",
+    "proxy-authorization",
+    "range",
+    "referer",
+    "refresh",
+    "retry-after",
+    "server",
+    "set-cookie",
+    "strict-transport-security",
+    "transfer-encoding",
+    "user-agent",
+    "vary",
+    "via",
+    "www-authenticate",
+};
+
+// RFC 7541 §4.1: "The size of an entry is the sum of its name's length in
+// octets ..., its value's length in octets, and 32."
+constexpr uint32_t kEntryOverhead = 32;
+
+// RFC 7541 Appendix A: the static table entries used in responses.
+constexpr uint32_t kStatus200Index = 8;
+constexpr uint32_t kContentTypeIndex = 31;
+
+constexpr std::string_view kContentType = "application/grpc";
+constexpr std::string_view kGrpcStatus = "grpc-status";
+
+// Size of the header that precedes the value of a dynamic table entry in
+// HpackDecoder.
+constexpr size_t kDecoderEntryHeaderSize = 3;
+
+}  // namespace
 
 // RFC 7541 §5.1
 Result<int> HpackIntegerDecode(ConstByteSpan& input, int bits_in_first_byte) {
@@ -119,34 +202,43 @@ Result<InlineString<kHpackMaxStringSize>> HpackHuffmanDecode(
 }
 
 // RFC 7541 §6
-Result<InlineString<kHpackMaxStringSize>> HpackParseRequestHeaders(
+Result<InlineString<kHpackMaxStringSize>> HpackDecoder::ParseRequestHeaders(
     ConstByteSpan input) {
+  // The whole block is decoded, even after the path is found, so that every
+  // change it makes to the dynamic table is applied.
+  std::optional<InlineString<kHpackMaxStringSize>> path;
+
   while (!input.empty()) {
     int first = static_cast<int>(input[0]);
 
     // RFC 7541 §6.1
     if ((first & 0b1000'0000) != 0) {
       PW_TRY_ASSIGN(int index, HpackIntegerDecode(input, 7));
-      // RFC 7541 Appendix A: these are the only static table entries for :path.
-      if (index == 4) {
-        return "/";
-      }
-      if (index == 5) {
-        return "/index.html";
+      PW_TRY_ASSIGN(Field field, Lookup(index));
+      if (field.is_path && !path.has_value()) {
+        path = field.value;
       }
       continue;
     }
 
     // RFC 7541 §6.3: dynamic table size update
     if ((first & 0b1110'0000) == 0b0010'0000) {
-      // Ignore: we don't use the dynamic table.
-      PW_TRY(HpackIntegerDecode(input, 5));
+      PW_TRY_ASSIGN(int max_size, HpackIntegerDecode(input, 5));
+      // RFC 7541 §6.3: "The new maximum size MUST be lower than or equal to the
+      // limit determined by the protocol ... A value that exceeds this limit
+      // MUST be treated as a decoding error."
+      if (static_cast<uint32_t>(max_size) > kHpackDynamicHeaderTableSize) {
+        return Status::InvalidArgument();
+      }
+      max_table_size_ = static_cast<uint32_t>(max_size);
+      EvictTo(max_table_size_);
       continue;
     }
 
     // RFC 7541 §6.2
     int index;
-    if ((first & 0b1100'0000) == 0b0100'0000) {
+    const bool add_to_table = (first & 0b1100'0000) == 0b0100'0000;
+    if (add_to_table) {
       PW_TRY_ASSIGN(index, HpackIntegerDecode(input, 6));
     } else {
       PW_CHECK((first & 0b1111'0000) == 0b0000'0000 ||
@@ -154,24 +246,263 @@ Result<InlineString<kHpackMaxStringSize>> HpackParseRequestHeaders(
       PW_TRY_ASSIGN(index, HpackIntegerDecode(input, 4));
     }
 
-    // Check if the name is ":path".
-    bool is_path;
+    Field field;
     if (index == 0) {
       PW_TRY_ASSIGN(auto name, HpackStringDecode(input));
-      is_path = (name == ":path");
+      field.name_size = static_cast<uint32_t>(name.size());
+      field.is_path = (name == ":path");
     } else {
-      // RFC 7541 Appendix A: these are the only static table entries for :path.
-      is_path = (index == 4 || index == 5);
+      PW_TRY_ASSIGN(Field indexed, Lookup(index));
+      field.name_size = indexed.name_size;
+      field.is_path = indexed.is_path;
     }
+    PW_TRY_ASSIGN(field.value, HpackStringDecode(input));
 
-    // Always extract the value to advance the `input` span.
-    PW_TRY_ASSIGN(auto value, HpackStringDecode(input));
-    if (is_path) {
-      return value;
+    if (field.is_path && !path.has_value()) {
+      path = field.value;
+    }
+    if (add_to_table) {
+      Insert(field);
     }
   }
 
-  return Status::NotFound();
+  if (!path.has_value()) {
+    return Status::NotFound();
+  }
+  return *path;
+}
+
+// RFC 7541 §2.3.3
+Result<HpackDecoder::Field> HpackDecoder::Lookup(int index) const {
+  if (index <= 0) {
+    return Status::InvalidArgument();
+  }
+
+  Field field;
+  if (static_cast<size_t>(index) <= kStaticTableNames.size()) {
+    field.name_size =
+        static_cast<uint32_t>(kStaticTableNames[index - 1].size());
+    // RFC 7541 Appendix A: these are the only static table entries for :path.
+    field.is_path = (index == 4 || index == 5);
+    if (index == 4) {
+      field.value = "/";
+    } else if (index == 5) {
+      field.value = "/index.html";
+    }
+    return field;
+  }
+
+  // Dynamic table indices count from the newest entry, which is at the back of
+  // the queue.
+  const size_t newer_entries = index - kStaticTableNames.size() - 1;
+  if (newer_entries >= table_.size()) {
+    return Status::InvalidArgument();
+  }
+  auto it = table_.begin();
+  for (size_t i = newer_entries + 1; i < table_.size(); ++i) {
+    ++it;
+  }
+
+  std::array<std::byte, kDecoderEntryHeaderSize + kHpackMaxStringSize> entry;
+  (*it).copy(entry.data(), entry.size());
+  field.name_size = static_cast<uint32_t>(entry[0]);
+  field.is_path = entry[2] != std::byte{0};
+  if (field.is_path) {
+    field.value.assign(
+        reinterpret_cast<const char*>(&entry[kDecoderEntryHeaderSize]),
+        static_cast<size_t>(entry[1]));
+  }
+  return field;
+}
+
+// RFC 7541 §4.4
+void HpackDecoder::Insert(const Field& field) {
+  const uint32_t size = field.name_size +
+                        static_cast<uint32_t>(field.value.size()) +
+                        kEntryOverhead;
+  if (size > max_table_size_) {
+    // "an attempt to add an entry larger than the maximum size causes the
+    // table to be emptied of all existing entries"
+    EvictTo(0);
+    return;
+  }
+  EvictTo(max_table_size_ - size);
+
+  std::array<std::byte, kDecoderEntryHeaderSize + kHpackMaxStringSize> entry = {
+      static_cast<std::byte>(field.name_size),
+      static_cast<std::byte>(field.value.size()),
+      static_cast<std::byte>(field.is_path),
+  };
+  size_t entry_size = kDecoderEntryHeaderSize;
+  if (field.is_path) {
+    std::memcpy(&entry[entry_size], field.value.data(), field.value.size());
+    entry_size += field.value.size();
+  }
+  table_.push(span(entry).first(entry_size));
+  table_size_ += size;
+}
+
+// RFC 7541 §4.3
+void HpackDecoder::EvictTo(uint32_t max_size) {
+  while (table_size_ > max_size) {
+    std::array<std::byte, 2> sizes;
+    table_.front().copy(sizes.data(), sizes.size());
+    table_size_ -= static_cast<uint32_t>(sizes[0]) +
+                   static_cast<uint32_t>(sizes[1]) + kEntryOverhead;
+    table_.pop();
+  }
+}
+
+void HpackEncoder::SetMaxTableSize(uint32_t max_size) {
+  if (max_size != max_table_size_) {
+    max_table_size_ = max_size;
+    table_size_update_pending_ = true;
+  }
+}
+
+ConstByteSpan HpackEncoder::ResponseHeaders() {
+  StartBlock();
+  AppendHeaders();
+  return span(buffer_).first(size_);
+}
+
+ConstByteSpan HpackEncoder::ResponseTrailers(Status response_code) {
+  StartBlock();
+  AppendTrailers(response_code);
+  return span(buffer_).first(size_);
+}
+
+ConstByteSpan HpackEncoder::ResponseHeadersAndTrailers(Status response_code) {
+  StartBlock();
+  AppendHeaders();
+  AppendTrailers(response_code);
+  return span(buffer_).first(size_);
+}
+
+void HpackEncoder::StartBlock() {
+  size_ = 0;
+  if (!table_size_update_pending_) {
+    return;
+  }
+
+  // RFC 7541 §4.2: changes to the table size are signaled at the start of the
+  // next header block. Shrinking the table to 0 first evicts every entry, so
+  // that the client's table is known to be empty.
+  AppendInteger(0b0010'0000, 5, 0);
+  AppendInteger(0b0010'0000, 5, max_table_size_);
+  table_size_ = 0;
+  num_entries_ = 0;
+  content_type_entry_ = 0;
+  grpc_status_entries_.fill(0);
+  table_size_update_pending_ = false;
+}
+
+void HpackEncoder::AppendHeaders() {
+  if (content_type_entry_ != 0) {
+    AppendInteger(0b1000'0000, 7, kStatus200Index);
+    AppendIndexedEntry(content_type_entry_);
+    return;
+  }
+
+  content_type_entry_ = TryInsert(
+      kStaticTableNames[kContentTypeIndex - 1].size() + kContentType.size());
+  if (content_type_entry_ != 0) {
+    // Adds content-type with incremental indexing.
+    Append(ResponseHeadersPayload());
+    return;
+  }
+
+  // RFC 7541 §6.2.2: literal header field without indexing.
+  AppendInteger(0b1000'0000, 7, kStatus200Index);
+  AppendInteger(0b0000'0000, 4, kContentTypeIndex);
+  AppendString(kContentType);
+}
+
+void HpackEncoder::AppendTrailers(Status response_code) {
+  const uint32_t code = response_code.code();
+  PW_CHECK_UINT_LT(code, kNumStatusCodes);
+
+  uint32_t& entry = grpc_status_entries_[code];
+  if (entry != 0) {
+    AppendIndexedEntry(entry);
+    return;
+  }
+
+  const char digits[] = {static_cast<char>('0' + code / 10),
+                         static_cast<char>('0' + code % 10)};
+  const std::string_view value =
+      code < 10 ? std::string_view(&digits[1], 1) : std::string_view(digits, 2);
+
+  entry = TryInsert(kGrpcStatus.size() + value.size());
+  if (entry != 0) {
+    // Adds grpc-status with incremental indexing.
+    Append(ResponseTrailersPayload(response_code));
+    return;
+  }
+
+  // RFC 7541 §6.2.2: literal header field without indexing, new name.
+  AppendInteger(0b0000'0000, 4, 0);
+  AppendString(kGrpcStatus);
+  AppendString(value);
+}
+
+void HpackEncoder::AppendIndexedEntry(uint32_t entry) {
+  // RFC 7541 §2.3.3: the newest dynamic table entry follows the static table.
+  AppendInteger(0b1000'0000,
+                7,
+                static_cast<uint32_t>(kStaticTableNames.size()) + 1 +
+                    (num_entries_ - entry));
+}
+
+uint32_t HpackEncoder::TryInsert(uint32_t size) {
+  size += kEntryOverhead;
+  if (table_size_ + size > max_table_size_) {
+    return 0;
+  }
+  table_size_ += size;
+  return ++num_entries_;
+}
+
+// RFC 7541 §5.1
+void HpackEncoder::AppendInteger(uint8_t flags,
+                                 int bits_in_first_byte,
+                                 uint32_t value) {
+  const uint32_t max_prefix = (1u << bits_in_first_byte) - 1;
+  if (value < max_prefix) {
+    AppendByte(flags | value);
+    return;
+  }
+
+  AppendByte(flags | max_prefix);
+  value -= max_prefix;
+  while (value >= 128) {
+    AppendByte(value % 128 + 128);
+    value /= 128;
+  }
+  AppendByte(value);
+}
+
+// RFC 7541 §5.2, without Huffman encoding.
+void HpackEncoder::AppendString(std::string_view string) {
+  AppendInteger(0b0000'0000, 7, string.size());
+  Append(as_bytes(span{string}));
+}
+
+void HpackEncoder::AppendByte(uint32_t byte) {
+  PW_CHECK_UINT_LT(size_, buffer_.size());
+  buffer_[size_++] = static_cast<std::byte>(byte);
+}
+
+void HpackEncoder::Append(ConstByteSpan bytes) {
+  PW_CHECK_UINT_LE(size_ + bytes.size(), buffer_.size());
+  std::memcpy(buffer_.data() + size_, bytes.data(), bytes.size());
+  size_ += bytes.size();
+}
+
+Result<InlineString<kHpackMaxStringSize>> HpackParseRequestHeaders(
+    ConstByteSpan payload) {
+  HpackDecoder decoder;
+  return decoder.ParseRequestHeaders(payload);
 }
 
 ConstByteSpan ResponseHeadersPayload() {
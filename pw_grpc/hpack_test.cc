@@ -14,8 +14,11 @@
 
 #include "pw_grpc_private/hpack.h"
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "pw_bytes/array.h"
+#include "pw_bytes/byte_builder.h"
 
 namespace pw::grpc {
 namespace {
@@ -116,5 +119,171 @@ TEST(HpackTest, HpackParseRequestHeadersNotFound) {
   EXPECT_EQ(result.status().code(), PW_STATUS_NOT_FOUND);
 }
 
+TEST(HpackTest, HpackDecoderRequestsC3) {
+  // clang-format off
+  // Appendix C.3.1.
+  const auto kRequest1 = bytes::Array<
+      0x82, 0x86, 0x84, 0x41, 0x0f, 0x77, 0x77, 0x77, 0x2e, 0x65, 0x78, 0x61,
+      0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d>();
+  // Appendix C.3.2.
+  const auto kRequest2 = bytes::Array<
+      0x82, 0x86, 0x84, 0xbe, 0x58, 0x08, 0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63,
+      0x68, 0x65>();
+  // Appendix C.3.3.
+  const auto kRequest3 = bytes::Array<
+      0x82, 0x87, 0x85, 0xbf, 0x40, 0x0a, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d,
+      0x2d, 0x6b, 0x65, 0x79, 0x0c, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x2d,
+      0x76, 0x61, 0x6c, 0x75, 0x65>();
+  // clang-format on
+
+  HpackDecoder decoder;
+  auto result = decoder.ParseRequestHeaders(kRequest1);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(*result, "/");
+  EXPECT_EQ(decoder.table_size(), 57u);
+
+  result = decoder.ParseRequestHeaders(kRequest2);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(*result, "/");
+  EXPECT_EQ(decoder.table_size(), 110u);
+
+  result = decoder.ParseRequestHeaders(kRequest3);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(*result, "/index.html");
+  EXPECT_EQ(decoder.table_size(), 164u);
+}
+
+TEST(HpackTest, HpackDecoderIndexedPath) {
+  // :path "/pkg.Svc/Method" with incremental indexing, using the static name.
+  // clang-format off
+  const auto kFirst = bytes::Array<
+      0x44, 0x0f, 0x2f, 0x70, 0x6b, 0x67, 0x2e, 0x53, 0x76, 0x63, 0x2f, 0x4d,
+      0x65, 0x74, 0x68, 0x6f, 0x64>();
+  // clang-format on
+  const auto kIndexed = bytes::Array<0xbe>();
+
+  HpackDecoder decoder;
+  auto result = decoder.ParseRequestHeaders(kFirst);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(*result, "/pkg.Svc/Method");
+
+  for (int i = 0; i < 3; ++i) {
+    result = decoder.ParseRequestHeaders(kIndexed);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(*result, "/pkg.Svc/Method");
+  }
+}
+
+TEST(HpackTest, HpackDecoderTableSizeUpdateEvicts) {
+  const auto kInsert = bytes::Array<0x44, 0x01, 0x2f>();  // :path "/"
+  const auto kEvictAndReference = bytes::Array<0x20, 0xbe>();
+
+  HpackDecoder decoder;
+  ASSERT_TRUE(decoder.ParseRequestHeaders(kInsert).ok());
+  EXPECT_EQ(decoder.table_size(), 38u);
+
+  auto result = decoder.ParseRequestHeaders(kEvictAndReference);
+  EXPECT_EQ(result.status(), Status::InvalidArgument());
+  EXPECT_EQ(decoder.table_size(), 0u);
+}
+
+TEST(HpackTest, HpackDecoderTableSizeUpdateTooLarge) {
+  // Table size update to kHpackDynamicHeaderTableSize + 1.
+  std::array<std::byte, 6> input{};
+  ByteBuilder builder(input);
+  builder.PutUint8(0x3f);
+  uint32_t value = kHpackDynamicHeaderTableSize + 1 - 31;
+  while (value >= 128) {
+    builder.PutUint8(static_cast<uint8_t>(value % 128 + 128));
+    value /= 128;
+  }
+  builder.PutUint8(static_cast<uint8_t>(value));
+
+  HpackDecoder decoder;
+  EXPECT_EQ(decoder.ParseRequestHeaders(ConstByteSpan(builder.data(), builder.size())).status(),
+            Status::InvalidArgument());
+}
+
+TEST(HpackTest, HpackEncoderIndexesRepeatedFields) {
+  HpackEncoder encoder;
+
+  // The first response adds content-type and grpc-status to the table.
+  auto headers = encoder.ResponseHeaders();
+  EXPECT_TRUE(std::equal(headers.begin(),
+                         headers.end(),
+                         ResponseHeadersPayload().begin(),
+                         ResponseHeadersPayload().end()));
+  auto trailers = encoder.ResponseTrailers(OkStatus());
+  EXPECT_TRUE(std::equal(trailers.begin(),
+                         trailers.end(),
+                         ResponseTrailersPayload(OkStatus()).begin(),
+                         ResponseTrailersPayload(OkStatus()).end()));
+
+  // Later responses refer to the table entries.
+  const auto kIndexedHeaders = bytes::Array<0x88, 0xbf>();
+  headers = encoder.ResponseHeaders();
+  EXPECT_TRUE(std::equal(headers.begin(),
+                         headers.end(),
+                         kIndexedHeaders.begin(),
+                         kIndexedHeaders.end()));
+  const auto kIndexedTrailers = bytes::Array<0xbe>();
+  trailers = encoder.ResponseTrailers(OkStatus());
+  EXPECT_TRUE(std::equal(trailers.begin(),
+                         trailers.end(),
+                         kIndexedTrailers.begin(),
+                         kIndexedTrailers.end()));
+
+  // A new status code is added as the newest entry.
+  trailers = encoder.ResponseHeadersAndTrailers(Status::NotFound());
+  ASSERT_EQ(trailers.size(), 2 + ResponseTrailersPayload(Status::NotFound()).size());
+  EXPECT_EQ(trailers[0], std::byte{0x88});
+  EXPECT_EQ(trailers[1], std::byte{0xbf});
+  trailers = encoder.ResponseTrailers(Status::NotFound());
+  ASSERT_EQ(trailers.size(), 1u);
+  EXPECT_EQ(trailers[0], std::byte{0xbe});
+}
+
+TEST(HpackTest, HpackEncoderWithoutDynamicTable) {
+  HpackEncoder encoder;
+  encoder.SetMaxTableSize(0);
+
+  // clang-format off
+  const auto kHeaders = bytes::Array<
+      0x20, 0x20,  // Table size updates to 0.
+      0x88, 0x0f, 0x10, 0x10, 0x61, 0x70, 0x70, 0x6c, 0x69, 0x63, 0x61, 0x74,
+      0x69, 0x6f, 0x6e, 0x2f, 0x67, 0x72, 0x70, 0x63>();
+  const auto kTrailers = bytes::Array<
+      0x00, 0x0b, 0x67, 0x72, 0x70, 0x63, 0x2d, 0x73, 0x74, 0x61, 0x74, 0x75,
+      0x73, 0x02, 0x31, 0x36>();
+  // clang-format on
+
+  auto headers = encoder.ResponseHeaders();
+  EXPECT_TRUE(std::equal(
+      headers.begin(), headers.end(), kHeaders.begin(), kHeaders.end()));
+
+  // The size update is only sent once.
+  auto trailers = encoder.ResponseTrailers(Status::Unauthenticated());
+  EXPECT_TRUE(std::equal(
+      trailers.begin(), trailers.end(), kTrailers.begin(), kTrailers.end()));
+}
+
+TEST(HpackTest, HpackEncoderInvalidateTable) {
+  HpackEncoder encoder;
+  encoder.ResponseHeaders();
+  encoder.InvalidateTable();
+
+  // The table is cleared and content-type is added again.
+  const auto headers = encoder.ResponseHeaders();
+  ASSERT_GT(headers.size(), 4u);
+  EXPECT_EQ(headers[0], std::byte{0x20});
+  EXPECT_EQ(headers[1], std::byte{0x3f});  // 4096 = 31 + 0xe1 0x1f
+  EXPECT_EQ(headers[2], std::byte{0xe1});
+  EXPECT_EQ(headers[3], std::byte{0x1f});
+  EXPECT_TRUE(std::equal(headers.begin() + 4,
+                         headers.end(),
+                         ResponseHeadersPayload().begin(),
+                         ResponseHeadersPayload().end()));
+}
+
 }  // namespace
 }  // namespace pw::grpc
@@ -19,12 +19,14 @@
 #include "pw_bytes/byte_builder.h"
 #include "pw_bytes/span.h"
 #include "pw_function/function.h"
+#include "pw_grpc/internal/hpack.h"
 #include "pw_grpc/send_queue.h"
 #include "pw_result/result.h"
 #include "pw_status/status.h"
 #include "pw_stream/stream.h"
 #include "pw_string/string.h"
 #include "pw_sync/inline_borrowable.h"
+#include "pw_sync/timed_thread_notification.h"
 #include "pw_thread/thread.h"
 #include "pw_thread/thread_core.h"
 
@@ -121,13 +123,19 @@ class Connection {
   // Sends a response message for an RPC. The `message` will not be accessed
   // after this method returns. Thread safe.
   //
+  // If the stream or connection flow control window is too small for the
+  // message, blocks until the client grants more window with WINDOW_UPDATE.
+  // Streams waiting for the connection window are served in the order they
+  // started waiting, so one busy stream can't starve the others.
+  //
   // Errors are:
   //
   // * NOT_FOUND if stream_id does not reference an active stream, including
   //   RPCs that have already completed and IDs that do not refer to any prior
   //   RPC.
-  // * RESOURCE_EXHAUSTED if the flow control window is not large enough to send
-  //   this RPC immediately. In this case, no response will be send.
+  // * RESOURCE_EXHAUSTED if the flow control window did not become large
+  //   enough to send this message before a timeout. In this case, no response
+  //   will be sent.
   // * UNAVAILABLE if the connection is closed.
   Status SendResponseMessage(StreamId stream_id, pw::ConstByteSpan message) {
     return writer_.SendResponseMessage(stream_id, message);
@@ -171,11 +179,25 @@ class Connection {
     bool started_response;
     int32_t send_window;
 
+    // Set while a writer is waiting for send window: the order in which it
+    // started waiting (0 if no writer is waiting), and the size of the message
+    // it is waiting to send.
+    uint32_t window_wait_ticket;
+    int32_t window_wait_size;
+    // Released when a waiting writer should check the send window again.
+    sync::TimedThreadNotification window_available;
+
     void Reset() {
       id = 0;
       half_closed = false;
       started_response = false;
       send_window = 0;
+      if (window_wait_ticket != 0) {
+        // Wake the writer so that it sees that the stream has closed.
+        window_available.release();
+      }
+      window_wait_ticket = 0;
+      window_wait_size = 0;
     }
   };
 
@@ -185,9 +207,29 @@ class Connection {
   struct SharedState {
     pw::Result<std::reference_wrapper<Stream>> LookupStream(StreamId id);
 
+    // Returns true if a message of `size` bytes may be sent on `stream`: both
+    // windows are large enough, and no stream that started waiting earlier is
+    // only waiting for the connection window.
+    bool CanSend(const Stream& stream, int32_t size) const;
+
+    // Marks a writer on `stream` as waiting for send window.
+    void StartWaitingForWindow(Stream& stream, int32_t size);
+
+    // Marks the writer on `stream` as no longer waiting, and lets other
+    // waiting writers check whether it is now their turn.
+    void StopWaitingForWindow(Stream& stream);
+
+    // Wakes all writers that are waiting for send window.
+    void NotifyWindowWaiters();
+
     // Stream state
     std::array<Stream, internal::kMaxConcurrentStreams> streams{};
     int32_t connection_send_window = kDefaultInitialWindowSize;
+    uint32_t next_window_wait_ticket = 1;
+
+    // Response headers must be encoded in the order they are sent, so the
+    // encoder is only used while sending with the state locked.
+    HpackEncoder hpack_encoder;
   };
 
   class Writer {
@@ -198,6 +240,10 @@ class Connection {
     Status SendResponseComplete(StreamId stream_id, pw::Status response_code);
 
    private:
+    Status SendResponseMessageLocked(SharedState& state,
+                                     Stream& stream,
+                                     pw::ConstByteSpan message);
+
     Connection& connection_;
   };
 
@@ -230,6 +276,7 @@ class Connection {
     RequestCallbacks& callbacks_;
     int32_t initial_send_window_ = kDefaultInitialWindowSize;
     bool received_connection_preface_ = false;
+    HpackDecoder hpack_decoder_;
 
     std::array<std::byte, internal::kMaxFramePayloadSize> payload_scratch_{};
     StreamId last_stream_id_ = 0;
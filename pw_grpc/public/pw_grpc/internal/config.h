@@ -0,0 +1,24 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+// The maximum size, in bytes, of the HPACK dynamic table used to decode
+// request headers, as defined in RFC 7541 §4.1. It is advertised to clients
+// with SETTINGS_HEADER_TABLE_SIZE, and each connection stores a table of about
+// this size. The HTTP2 default is 4096; smaller tables save memory, but let
+// clients index fewer request headers. Set to 0 to disable the dynamic table.
+#ifndef PW_GRPC_HPACK_DYNAMIC_TABLE_SIZE
+#define PW_GRPC_HPACK_DYNAMIC_TABLE_SIZE 4096
+#endif  // PW_GRPC_HPACK_DYNAMIC_TABLE_SIZE
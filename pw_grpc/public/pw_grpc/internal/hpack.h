@@ -0,0 +1,159 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_containers/inline_var_len_entry_queue.h"
+#include "pw_grpc/internal/config.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_string/string.h"
+
+// HPACK (RFC 7541) header compression state that is kept for each connection.
+// Implemented in hpack.cc, along with the rest of the HPACK support in
+// pw_grpc_private/hpack.h.
+
+namespace pw::grpc {
+
+// Maximum size of the HPACK dynamic table for decoding request headers.
+inline constexpr uint32_t kHpackDynamicHeaderTableSize =
+    PW_GRPC_HPACK_DYNAMIC_TABLE_SIZE;
+
+// RFC 7541 §6.5.2: the initial size of the peer's HPACK dynamic table.
+inline constexpr uint32_t kHpackDefaultHeaderTableSize = 4096;
+
+// Maximum size of a string that can be returned by this API.
+inline constexpr uint32_t kHpackMaxStringSize = 127;
+
+// Decodes the request header blocks on a connection, maintaining the HPACK
+// dynamic table (RFC 7541 §2.3.2) so that clients can refer to headers that
+// they sent in earlier requests, rather than sending them again.
+//
+// The table only keeps what the server needs: the value of each indexed
+// ":path" header, and the sizes of the other headers.
+class HpackDecoder {
+ public:
+  HpackDecoder() = default;
+
+  // Parses a request header field block, returning the grpc method name.
+  // Every header block received on the connection must be passed to this, in
+  // order, to keep the dynamic table in sync with the client's.
+  //
+  // Returns NOT_FOUND if the block has no ":path" header, in which case the
+  // rest of the block was still decoded. Any other error is a decoding error
+  // that leaves the dynamic table unusable, and so must close the connection.
+  Result<InlineString<kHpackMaxStringSize>> ParseRequestHeaders(
+      ConstByteSpan payload);
+
+  // Returns the current size of the dynamic table, as defined in RFC 7541
+  // §4.1.
+  uint32_t table_size() const { return table_size_; }
+
+ private:
+  struct Field {
+    uint32_t name_size;
+    bool is_path;
+    InlineString<kHpackMaxStringSize> value;
+  };
+
+  // Returns the name size and, for ":path" fields, the value of a field in the
+  // static or dynamic table.
+  Result<Field> Lookup(int index) const;
+
+  // Adds a field to the dynamic table, evicting older fields as needed.
+  void Insert(const Field& field);
+
+  // Evicts fields until the table size is at most `max_size`.
+  void EvictTo(uint32_t max_size);
+
+  // Oldest first. Each entry is the name size, value size, and ":path" flag,
+  // followed by the value for ":path" fields. This is always smaller than the
+  // RFC 7541 §4.1 size of the field, so the queue never runs out of space.
+  InlineVarLenEntryQueue<kHpackDynamicHeaderTableSize> table_;
+  uint32_t table_size_ = 0;
+  uint32_t max_table_size_ = kHpackDynamicHeaderTableSize;
+};
+
+// Encodes response header blocks for a connection. Fields that are sent in
+// every response are added to the client's HPACK dynamic table the first time
+// they are sent, and sent as a one byte index after that.
+//
+// The encoder never adds more fields than fit in the client's table, so the
+// client never evicts them, and each field's index is known.
+class HpackEncoder {
+ public:
+  HpackEncoder() = default;
+
+  // Applies the client's SETTINGS_HEADER_TABLE_SIZE.
+  void SetMaxTableSize(uint32_t max_size);
+
+  // Clears the client's dynamic table at the start of the next header block.
+  // Call this if a header block from this encoder might not have reached the
+  // client, since the client's table is then unknown.
+  void InvalidateTable() { table_size_update_pending_ = true; }
+
+  // Returns a HEADERS payload to use for grpc Response-Headers. The payload is
+  // valid until the next call to this encoder.
+  ConstByteSpan ResponseHeaders();
+
+  // Returns a HEADERS payload to use for grpc Trailers. The payload is valid
+  // until the next call to this encoder.
+  ConstByteSpan ResponseTrailers(Status response_code);
+
+  // Returns a HEADERS payload to use for both grpc Response-Headers and
+  // Trailers, for a response with no messages. The payload is valid until the
+  // next call to this encoder.
+  ConstByteSpan ResponseHeadersAndTrailers(Status response_code);
+
+ private:
+  static constexpr size_t kNumStatusCodes = 17;
+
+  void StartBlock();
+  void AppendHeaders();
+  void AppendTrailers(Status response_code);
+
+  // Appends an indexed field for the entry added to the table as `entry`.
+  void AppendIndexedEntry(uint32_t entry);
+
+  // Adds an entry of `size` bytes to the table if it fits. Returns the entry's
+  // number, which is 1 for the first entry, or 0 if it doesn't fit.
+  uint32_t TryInsert(uint32_t size);
+
+  // RFC 7541 §5.1 and §5.2
+  void AppendInteger(uint8_t flags, int bits_in_first_byte, uint32_t value);
+  void AppendString(std::string_view string);
+  void AppendByte(uint32_t byte);
+  void Append(ConstByteSpan bytes);
+
+  uint32_t max_table_size_ = kHpackDefaultHeaderTableSize;
+  uint32_t table_size_ = 0;
+  bool table_size_update_pending_ = false;
+
+  // Number of entries added to the table, and the number of each field's
+  // entry, or 0 if it is not in the table.
+  uint32_t num_entries_ = 0;
+  uint32_t content_type_entry_ = 0;
+  std::array<uint32_t, kNumStatusCodes> grpc_status_entries_{};
+
+  std::array<std::byte, 48> buffer_{};
+  size_t size_ = 0;
+};
+
+}  // namespace pw::grpc
@@ -13,12 +13,14 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <optional>
 
 #include "pw_async/dispatcher.h"
 #include "pw_async_basic/dispatcher.h"
 #include "pw_bytes/span.h"
-#include "pw_containers/intrusive_list.h"
+#include "pw_containers/intrusive_dlist.h"
 #include "pw_status/status.h"
 #include "pw_stream/stream.h"
 #include "pw_sync/lock_annotations.h"
@@ -30,6 +32,11 @@ namespace pw::grpc {
 
 // SendQueue is a queue+thread that serializes sending lists of bytes to
 // a stream.
+//
+// Requests that are queued while the thread is busy are coalesced: their bytes
+// are copied into a buffer of kSendBufferSize bytes and written to the stream
+// together, so that many small frames cost one write rather than one write
+// each. Requests that do not fit in the buffer are written directly.
 class SendQueue : public thread::ThreadCore {
  public:
   SendQueue(stream::ReaderWriter& socket)
@@ -50,26 +57,40 @@ class SendQueue : public thread::ThreadCore {
   // Call before attempting to join thread.
   void RequestStop() { send_dispatcher_.RequestStop(); }
 
+  static constexpr size_t kSendBufferSize = 2048;
+
  private:
-  struct SendRequest : public IntrusiveList<SendRequest>::Item {
+  struct SendRequest : public IntrusiveDList<SendRequest>::Item {
     SendRequest(span<ConstByteSpan> m) : messages(m) {}
     sync::TimedThreadNotification notify;
     Status status = OkStatus();
     span<ConstByteSpan> messages;
+    // Whether the request is in send_requests_ rather than being sent. Guarded
+    // by send_mutex_.
+    bool queued = false;
   };
 
   std::optional<std::reference_wrapper<SendRequest>> NextSendRequest()
       PW_LOCKS_EXCLUDED(send_mutex_);
   void QueueSendRequest(SendRequest& request) PW_LOCKS_EXCLUDED(send_mutex_);
-  void CancelSendRequest(SendRequest& request) PW_LOCKS_EXCLUDED(send_mutex_);
+  // Returns false if the request has already been taken by the send thread,
+  // in which case it is still being sent.
+  bool CancelSendRequest(SendRequest& request) PW_LOCKS_EXCLUDED(send_mutex_);
   void ProcessSendQueue(async::Context& context, Status status)
       PW_LOCKS_EXCLUDED(send_mutex_);
 
+  // Writes the coalesced requests and completes them. Only called from the
+  // send thread.
+  void FlushBuffer(IntrusiveDList<SendRequest>& requests, size_t size);
+
   stream::ReaderWriter& socket_;
   async::BasicDispatcher send_dispatcher_;
   async::Task send_task_;
   sync::Mutex send_mutex_;
-  IntrusiveList<SendRequest> send_requests_ PW_GUARDED_BY(send_mutex_);
+  IntrusiveDList<SendRequest> send_requests_ PW_GUARDED_BY(send_mutex_);
+
+  // Only accessed from the send thread.
+  std::array<std::byte, kSendBufferSize> send_buffer_;
 };
 
 }  // namespace pw::grpc
@@ -17,18 +17,14 @@
 #include <cstdint>
 
 #include "pw_bytes/span.h"
+#include "pw_grpc/internal/hpack.h"
 #include "pw_result/result.h"
 #include "pw_string/string.h"
 
 namespace pw::grpc {
 
-// We disable the HPACK dynamic header table.
-inline constexpr uint32_t kHpackDynamicHeaderTableSize = 0;
-
-// Maximum size of a string that can be returned by this API.
-inline constexpr uint32_t kHpackMaxStringSize = 127;
-
-// Parses a request header field block, returning the grpc method name.
+// Parses a request header field block with a new HpackDecoder, returning the
+// grpc method name.
 Result<InlineString<kHpackMaxStringSize>> HpackParseRequestHeaders(
     ConstByteSpan payload);
 
@@ -14,6 +14,8 @@
 
 #include "pw_grpc/send_queue.h"
 
+#include <cstring>
+
 #include "pw_chrono/system_clock.h"
 
 namespace pw::grpc {
@@ -33,6 +35,7 @@ SendQueue::NextSendRequest() {
   }
   auto& front = send_requests_.front();
   send_requests_.pop_front();
+  front.queued = false;
   return front;
 }
 
@@ -41,26 +44,75 @@ void SendQueue::ProcessSendQueue(async::Context&, Status status) {
     return;
   }
 
+  IntrusiveDList<SendRequest> buffered;
+  size_t buffered_size = 0;
+
   auto request = NextSendRequest();
   while (request.has_value()) {
-    for (auto message : request->get().messages) {
-      request->get().status.Update(socket_.Write(message));
+    SendRequest& current = request->get();
+    size_t size = 0;
+    for (auto message : current.messages) {
+      size += message.size();
+    }
+
+    if (buffered_size + size > send_buffer_.size()) {
+      FlushBuffer(buffered, buffered_size);
+      buffered_size = 0;
     }
-    request->get().notify.release();
+
+    if (size > send_buffer_.size()) {
+      for (auto message : current.messages) {
+        current.status.Update(socket_.Write(message));
+      }
+      current.notify.release();
+    } else {
+      for (auto message : current.messages) {
+        std::memcpy(
+            send_buffer_.data() + buffered_size, message.data(), message.size());
+        buffered_size += message.size();
+      }
+      buffered.push_back(current);
+    }
+
     request = NextSendRequest();
   }
+
+  FlushBuffer(buffered, buffered_size);
+}
+
+void SendQueue::FlushBuffer(IntrusiveDList<SendRequest>& requests,
+                            size_t size) {
+  if (requests.empty()) {
+    return;
+  }
+
+  const Status status = socket_.Write(span(send_buffer_).first(size));
+  while (!requests.empty()) {
+    SendRequest& request = requests.front();
+    requests.pop_front();
+    request.status.Update(status);
+    // The request may be destroyed as soon as it is notified.
+    request.notify.release();
+  }
 }
 
 void SendQueue::QueueSendRequest(SendRequest& request) {
   std::lock_guard lock(send_mutex_);
   send_requests_.push_back(request);
+  request.queued = true;
   send_dispatcher_.Cancel(send_task_);
   send_dispatcher_.Post(send_task_);
 }
 
-void SendQueue::CancelSendRequest(SendRequest& request) {
+bool SendQueue::CancelSendRequest(SendRequest& request) {
   std::lock_guard lock(send_mutex_);
-  send_requests_.remove(request);
+  // A request taken by the send thread may be in its list of buffered
+  // requests, so only remove requests that are still queued.
+  if (!request.queued) {
+    return false;
+  }
+  request.queued = false;
+  return send_requests_.remove(request);
 }
 
 Status SendQueue::SendBytes(ConstByteSpan message) {
@@ -72,8 +124,12 @@ Status SendQueue::SendBytesVector(span<ConstByteSpan> messages) {
   SendRequest request(messages);
   QueueSendRequest(request);
   if (!request.notify.try_acquire_for(kSendTimeout)) {
-    CancelSendRequest(request);
-    return Status::DeadlineExceeded();
+    if (CancelSendRequest(request)) {
+      return Status::DeadlineExceeded();
+    }
+    // The send thread is already sending the request and will notify once it
+    // is done, so wait for that before the request goes out of scope.
+    request.notify.acquire();
   }
 
   return request.status;
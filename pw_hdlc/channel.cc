@@ -0,0 +1,222 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_hdlc/channel.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "pw_hdlc/encoded_size.h"
+#include "pw_hdlc/internal/encoder.h"
+#include "pw_status/try.h"
+
+namespace pw::hdlc {
+namespace {
+
+constexpr size_t kMaxFrameOverhead = HdlcChannel::kFrameReservation.headroom +
+                                     HdlcChannel::kFrameReservation.tailroom;
+
+// Returns the size of ``payload`` once escaped.
+size_t EscapedPayloadSize(const multibuf::MultiBuf& payload) {
+  size_t size = 0;
+  for (const multibuf::Chunk& chunk : payload.Chunks()) {
+    size += EscapedSize(ConstByteSpan(chunk.data(), chunk.size()));
+  }
+  return size;
+}
+
+}  // namespace
+
+HdlcChannel::HdlcChannel(channel::ByteReaderWriter& lower,
+                         uint64_t address,
+                         multibuf::MultiBufAllocator& allocator,
+                         size_t max_payload_size)
+    : lower_(lower),
+      address_(address),
+      allocator_(allocator),
+      frame_buffer_size_(max_payload_size + kMaxAddressSize + kControlSize +
+                         kFcsSize) {}
+
+async2::Poll<Status> HdlcChannel::PendDecoder(async2::Context& cx) {
+  if (decoder_.has_value()) {
+    return async2::Ready(OkStatus());
+  }
+  if (!frame_allocation_.has_value()) {
+    frame_allocation_.emplace(allocator_,
+                              frame_buffer_size_,
+                              frame_buffer_size_,
+                              /*needs_contiguous=*/true);
+  }
+  async2::Poll<std::optional<multibuf::MultiBuf>> buffer =
+      frame_allocation_->Pend(cx);
+  if (buffer.IsPending()) {
+    return async2::Pending();
+  }
+  frame_allocation_.reset();
+  if (!buffer->has_value()) {
+    return async2::Ready(Status::ResourceExhausted());
+  }
+  frame_buffer_ = std::move(**buffer);
+  multibuf::Chunk& chunk = *frame_buffer_->ChunkBegin();
+  decoder_.emplace(ByteSpan(chunk.data(), chunk.size()));
+  // The flag that ended the previous frame may also start the next one.
+  static_cast<void>(decoder_->Process(kFlag));
+  return async2::Ready(OkStatus());
+}
+
+std::optional<multibuf::MultiBuf> HdlcChannel::DecodeInput() {
+  size_t processed = 0;
+  std::optional<multibuf::MultiBuf> payload;
+  for (const multibuf::Chunk& chunk : input_.Chunks()) {
+    for (std::byte b : chunk) {
+      ++processed;
+      Result<Frame> frame = decoder_->Process(b);
+      if (frame.status().IsUnavailable()) {
+        continue;
+      }
+      if (!frame.ok() || frame->address() != address_) {
+        ++dropped_frames_;
+        continue;
+      }
+
+      // The frame was decoded into ``frame_buffer_``; narrow it to the
+      // payload and hand it out.
+      const multibuf::Chunk& buffer = *frame_buffer_->ChunkBegin();
+      size_t offset = static_cast<size_t>(frame->data().data() - buffer.data());
+      size_t size = frame->data().size();
+      payload = std::move(frame_buffer_);
+      frame_buffer_.reset();
+      decoder_.reset();
+      payload->Slice(offset, offset + size);
+      break;
+    }
+    if (payload.has_value()) {
+      break;
+    }
+  }
+  input_.DiscardPrefix(processed);
+  return payload;
+}
+
+async2::Poll<Result<multibuf::MultiBuf>> HdlcChannel::DoPollRead(
+    async2::Context& cx, size_t) {
+  while (true) {
+    async2::Poll<Status> ready = PendDecoder(cx);
+    if (ready.IsPending()) {
+      return async2::Pending();
+    }
+    if (!ready->ok()) {
+      return *ready;
+    }
+
+    if (input_.size() == 0) {
+      async2::Poll<Result<multibuf::MultiBuf>> read = lower_.PollRead(cx);
+      if (read.IsPending()) {
+        return async2::Pending();
+      }
+      if (!read->ok()) {
+        return read->status();
+      }
+      input_ = std::move(**read);
+    }
+
+    std::optional<multibuf::MultiBuf> payload = DecodeInput();
+    if (payload.has_value()) {
+      return std::move(*payload);
+    }
+  }
+}
+
+Status HdlcChannel::Encode(multibuf::MultiBuf& payload) {
+  // Encode the header and trailer. The payload is only included in the frame
+  // check sequence, leaving the trailer directly after the header.
+  std::array<std::byte, kMaxFrameOverhead> overhead;
+  internal::BufferEncoder encoder(overhead);
+  PW_TRY(encoder.StartUnnumberedFrame(address_));
+  const size_t header_size = encoder.size();
+
+  bool needs_escaping = false;
+  for (const multibuf::Chunk& chunk : payload.Chunks()) {
+    ConstByteSpan data(chunk.data(), chunk.size());
+    if (std::any_of(data.begin(), data.end(), NeedsEscaping)) {
+      needs_escaping = true;
+      break;
+    }
+    encoder.SkipData(data);
+  }
+
+  if (!needs_escaping && payload.ChunkBegin() != payload.ChunkEnd()) {
+    PW_TRY(encoder.FinishFrame());
+    ConstByteSpan header = encoder.frame().first(header_size);
+    ConstByteSpan trailer = encoder.frame().subspan(header_size);
+
+    multibuf::Chunk& first = *payload.ChunkBegin();
+    multibuf::Chunk* last = &first;
+    for (multibuf::Chunk& chunk : payload.Chunks()) {
+      last = &chunk;
+    }
+    if (first.ClaimPrefix(header.size())) {
+      if (last->ClaimSuffix(trailer.size())) {
+        std::memcpy(first.data(), header.data(), header.size());
+        std::memcpy(last->data() + last->size() - trailer.size(),
+                    trailer.data(),
+                    trailer.size());
+        return OkStatus();
+      }
+      first.DiscardPrefix(header.size());
+    }
+  }
+
+  // The frame cannot be built in place, so encode it into a new buffer.
+  std::optional<multibuf::MultiBuf> frame = allocator_.AllocateContiguous(
+      kMaxFrameOverhead + EscapedPayloadSize(payload),
+      lower_.write_reservation());
+  if (!frame.has_value()) {
+    return Status::ResourceExhausted();
+  }
+  multibuf::Chunk& chunk = *frame->ChunkBegin();
+  internal::BufferEncoder frame_encoder(ByteSpan(chunk.data(), chunk.size()));
+  PW_TRY(frame_encoder.StartUnnumberedFrame(address_));
+  for (const multibuf::Chunk& payload_chunk : payload.Chunks()) {
+    PW_TRY(frame_encoder.WriteData(
+        ConstByteSpan(payload_chunk.data(), payload_chunk.size())));
+  }
+  PW_TRY(frame_encoder.FinishFrame());
+  frame->Truncate(frame_encoder.size());
+  payload = std::move(*frame);
+  return OkStatus();
+}
+
+Result<channel::WriteToken> HdlcChannel::DoWrite(
+    multibuf::MultiBuf&& payload) {
+  PW_TRY(Encode(payload));
+  return lower_.Write(std::move(payload));
+}
+
+Result<channel::WriteToken> HdlcChannel::DoWriteBatch(
+    span<multibuf::MultiBuf> batch) {
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (Status status = Encode(batch[i]); !status.ok()) {
+      // Send the frames that were encoded before reporting the error.
+      if (i > 0) {
+        lower_.WriteBatch(batch.first(i)).IgnoreError();
+      }
+      return status;
+    }
+  }
+  return lower_.WriteBatch(batch);
+}
+
+}  // namespace pw::hdlc
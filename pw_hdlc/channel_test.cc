@@ -0,0 +1,295 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_hdlc/channel.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "pw_allocator/testing.h"
+#include "pw_assert/check.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_bytes/array.h"
+#include "pw_containers/vector.h"
+#include "pw_hdlc/decoder.h"
+#include "pw_hdlc/encoder.h"
+#include "pw_multibuf/simple_allocator.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::hdlc {
+namespace {
+
+using ::pw::allocator::test::AllocatorForTest;
+using ::pw::async2::Context;
+using ::pw::async2::Dispatcher;
+using ::pw::async2::Pending;
+using ::pw::async2::Poll;
+using ::pw::async2::Ready;
+using ::pw::async2::Task;
+using ::pw::multibuf::MultiBuf;
+
+constexpr uint64_t kAddress = 0x42;
+constexpr uint64_t kOtherAddress = 0x43;
+constexpr size_t kMaxPayloadSize = 64;
+constexpr auto kPayload = bytes::Array<1, 2, 3, 4, 5, 6, 7, 8>();
+// Contains a flag and an escape byte.
+constexpr auto kEscapedPayload = bytes::Array<0x7e, 1, 0x7d, 2>();
+
+/// Byte channel which reads from queued buffers and records writes.
+class FakeByteChannel : public channel::ByteReaderWriter {
+ public:
+  void PushRead(MultiBuf&& buffer) {
+    reads_.push_back(std::move(buffer));
+    std::move(read_waker_).Wake();
+  }
+
+  Vector<MultiBuf, 8> writes;
+
+ private:
+  Poll<Result<MultiBuf>> DoPollRead(Context& cx, size_t) override {
+    if (reads_.empty()) {
+      read_waker_ = cx.GetWaker(async2::WaitReason::Unspecified());
+      return Pending();
+    }
+    MultiBuf buffer = std::move(reads_.front());
+    reads_.erase(reads_.begin());
+    return Result<MultiBuf>(std::move(buffer));
+  }
+
+  Poll<> DoPollReadyToWrite(Context&) override { return Ready(); }
+
+  Result<channel::WriteToken> DoWrite(MultiBuf&& buffer) override {
+    writes.push_back(std::move(buffer));
+    return CreateWriteToken(static_cast<uint32_t>(writes.size()));
+  }
+
+  Poll<Result<channel::WriteToken>> DoPollFlush(Context&) override {
+    return Ready(Result<channel::WriteToken>(
+        CreateWriteToken(static_cast<uint32_t>(writes.size()))));
+  }
+
+  Poll<Status> DoPollClose(Context&) override { return Ready(OkStatus()); }
+
+  Vector<MultiBuf, 8> reads_;
+  async2::Waker read_waker_;
+};
+
+/// Task which reads once from a channel.
+class ReadTask : public Task {
+ public:
+  explicit ReadTask(HdlcChannel* channel) : channel_(*channel) {}
+
+  std::optional<Result<MultiBuf>> result;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    Poll<Result<MultiBuf>> poll = channel_.PollRead(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = std::move(*poll);
+    return Ready();
+  }
+
+  HdlcChannel& channel_;
+};
+
+class HdlcChannelTest : public ::testing::Test {
+ protected:
+  HdlcChannelTest()
+      : allocator_(data_area_, meta_alloc_),
+        channel_(lower_, kAddress, allocator_, kMaxPayloadSize) {}
+
+  MultiBuf MakeMultiBuf(ConstByteSpan contents,
+                        multibuf::Reservation reservation = {}) {
+    std::optional<MultiBuf> buffer =
+        allocator_.AllocateContiguous(contents.size(), reservation);
+    PW_CHECK(buffer.has_value());
+    std::copy(contents.begin(), contents.end(), buffer->begin());
+    return std::move(*buffer);
+  }
+
+  // Encodes an HDLC UI frame into ``encoded_``.
+  ConstByteSpan EncodeFrame(uint64_t address, ConstByteSpan payload) {
+    stream::MemoryWriter writer(encoded_);
+    PW_CHECK_OK(WriteUIFrame(address, payload, writer));
+    return writer.WrittenData();
+  }
+
+  // Decodes a frame written to the lower channel.
+  void ExpectFrame(const MultiBuf& written, ConstByteSpan payload) {
+    std::array<std::byte, 128> encoded;
+    ASSERT_LE(written.size(), encoded.size());
+    std::copy(written.begin(), written.end(), encoded.begin());
+
+    DecoderBuffer<128> decoder;
+    std::optional<Frame> frame;
+    for (std::byte b : span(encoded).first(written.size())) {
+      Result<Frame> result = decoder.Process(b);
+      if (result.ok()) {
+        frame = *result;
+        break;
+      }
+    }
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->address(), kAddress);
+    ASSERT_EQ(frame->data().size(), payload.size());
+    EXPECT_TRUE(
+        std::equal(payload.begin(), payload.end(), frame->data().begin()));
+  }
+
+  Dispatcher dispatcher_;
+  std::array<std::byte, 2048> data_area_;
+  AllocatorForTest<2048> meta_alloc_;
+  multibuf::SimpleAllocator allocator_;
+  FakeByteChannel lower_;
+  HdlcChannel channel_;
+  std::array<std::byte, 128> encoded_;
+};
+
+TEST_F(HdlcChannelTest, ReadReturnsFramePayload) {
+  lower_.PushRead(MakeMultiBuf(EncodeFrame(kAddress, kPayload)));
+
+  ReadTask task(&channel_);
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsReady());
+  ASSERT_TRUE(task.result.has_value());
+  ASSERT_EQ(task.result->status(), OkStatus());
+  ASSERT_EQ((*task.result)->size(), kPayload.size());
+  EXPECT_TRUE(
+      std::equal(kPayload.begin(), kPayload.end(), (*task.result)->begin()));
+}
+
+TEST_F(HdlcChannelTest, ReadReassemblesFrameSplitAcrossReads) {
+  ConstByteSpan frame = EncodeFrame(kAddress, kEscapedPayload);
+  lower_.PushRead(MakeMultiBuf(frame.first(3)));
+  lower_.PushRead(MakeMultiBuf(frame.subspan(3)));
+
+  ReadTask task(&channel_);
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsReady());
+  ASSERT_TRUE(task.result.has_value());
+  ASSERT_EQ(task.result->status(), OkStatus());
+  ASSERT_EQ((*task.result)->size(), kEscapedPayload.size());
+  EXPECT_TRUE(std::equal(kEscapedPayload.begin(),
+                         kEscapedPayload.end(),
+                         (*task.result)->begin()));
+}
+
+TEST_F(HdlcChannelTest, ReadReturnsEachFrameInOneBuffer) {
+  std::array<std::byte, 64> frames;
+  ConstByteSpan first = EncodeFrame(kAddress, kPayload);
+  std::copy(first.begin(), first.end(), frames.begin());
+  ConstByteSpan second = EncodeFrame(kAddress, kEscapedPayload);
+  std::copy(second.begin(), second.end(), frames.begin() + first.size());
+  lower_.PushRead(
+      MakeMultiBuf(span(frames).first(first.size() + second.size())));
+
+  ReadTask task1(&channel_);
+  dispatcher_.Post(task1);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task1).IsReady());
+  ASSERT_TRUE(task1.result.has_value());
+  ASSERT_EQ(task1.result->status(), OkStatus());
+  EXPECT_EQ((*task1.result)->size(), kPayload.size());
+
+  ReadTask task2(&channel_);
+  dispatcher_.Post(task2);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task2).IsReady());
+  ASSERT_TRUE(task2.result.has_value());
+  ASSERT_EQ(task2.result->status(), OkStatus());
+  EXPECT_EQ((*task2.result)->size(), kEscapedPayload.size());
+}
+
+TEST_F(HdlcChannelTest, ReadDropsFramesForOtherAddresses) {
+  lower_.PushRead(MakeMultiBuf(EncodeFrame(kOtherAddress, kPayload)));
+
+  ReadTask task(&channel_);
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsPending());
+  EXPECT_EQ(channel_.dropped_frames(), 1u);
+
+  lower_.PushRead(MakeMultiBuf(EncodeFrame(kAddress, kPayload)));
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsReady());
+  ASSERT_TRUE(task.result.has_value());
+  EXPECT_EQ(task.result->status(), OkStatus());
+}
+
+TEST_F(HdlcChannelTest, ReadDropsCorruptedFrames) {
+  ConstByteSpan frame = EncodeFrame(kAddress, kPayload);
+  std::array<std::byte, 64> corrupted;
+  std::copy(frame.begin(), frame.end(), corrupted.begin());
+  corrupted[3] ^= std::byte{0x01};
+  lower_.PushRead(MakeMultiBuf(span(corrupted).first(frame.size())));
+
+  ReadTask task(&channel_);
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsPending());
+  EXPECT_EQ(channel_.dropped_frames(), 1u);
+
+  // Decoding resumes with the next frame.
+  lower_.PushRead(MakeMultiBuf(EncodeFrame(kAddress, kPayload)));
+  EXPECT_TRUE(dispatcher_.RunUntilStalled(task).IsReady());
+  ASSERT_TRUE(task.result.has_value());
+  EXPECT_EQ(task.result->status(), OkStatus());
+}
+
+TEST_F(HdlcChannelTest, WriteReservationIncludesFraming) {
+  multibuf::Reservation reservation = channel_.write_reservation();
+  EXPECT_EQ(reservation.headroom, HdlcChannel::kFrameReservation.headroom);
+  EXPECT_EQ(reservation.tailroom, HdlcChannel::kFrameReservation.tailroom);
+}
+
+TEST_F(HdlcChannelTest, WriteFramesPayloadInPlace) {
+  MultiBuf payload = MakeMultiBuf(kPayload, channel_.write_reservation());
+  const std::byte* payload_data = payload.ChunkBegin()->data();
+
+  ASSERT_EQ(channel_.Write(std::move(payload)).status(), OkStatus());
+  ASSERT_EQ(lower_.writes.size(), 1u);
+  // The flag, address, and control bytes were written into the payload's
+  // headroom.
+  MultiBuf& written = lower_.writes[0];
+  EXPECT_EQ(written.ChunkBegin()->data(), payload_data - 3);
+  ExpectFrame(written, kPayload);
+}
+
+TEST_F(HdlcChannelTest, WriteCopiesPayloadThatNeedsEscaping) {
+  MultiBuf payload =
+      MakeMultiBuf(kEscapedPayload, channel_.write_reservation());
+  ASSERT_EQ(channel_.Write(std::move(payload)).status(), OkStatus());
+  ASSERT_EQ(lower_.writes.size(), 1u);
+  ExpectFrame(lower_.writes[0], kEscapedPayload);
+}
+
+TEST_F(HdlcChannelTest, WriteCopiesPayloadWithoutReservation) {
+  ASSERT_EQ(channel_.Write(MakeMultiBuf(kPayload)).status(), OkStatus());
+  ASSERT_EQ(lower_.writes.size(), 1u);
+  ExpectFrame(lower_.writes[0], kPayload);
+}
+
+TEST_F(HdlcChannelTest, WriteBatchFramesEachPayload) {
+  std::array<MultiBuf, 2> batch = {
+      MakeMultiBuf(kPayload, channel_.write_reservation()),
+      MakeMultiBuf(kEscapedPayload),
+  };
+  ASSERT_EQ(channel_.WriteBatch(batch).status(), OkStatus());
+  ASSERT_EQ(lower_.writes.size(), 2u);
+  ExpectFrame(lower_.writes[0], kPayload);
+  ExpectFrame(lower_.writes[1], kEscapedPayload);
+}
+
+}  // namespace
+}  // namespace pw::hdlc
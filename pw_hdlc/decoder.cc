@@ -16,13 +16,58 @@
 
 #include "pw_assert/check.h"
 #include "pw_bytes/endian.h"
+#include "pw_hdlc/internal/config.h"
 #include "pw_hdlc/internal/protocol.h"
 #include "pw_log/log.h"
 #include "pw_varint/varint.h"
 
+#if PW_HDLC_ENABLE_TRACING
+#include "pw_trace/trace.h"
+#endif  // PW_HDLC_ENABLE_TRACING
+
 using std::byte;
 
 namespace pw::hdlc {
+namespace {
+
+// Returns a word with each byte set to b.
+constexpr uint64_t RepeatByte(byte b) {
+  return uint64_t{0x0101010101010101} * static_cast<uint8_t>(b);
+}
+
+// True if any of the bytes in word is zero.
+constexpr bool HasZeroByte(uint64_t word) {
+  return ((word - uint64_t{0x0101010101010101}) & ~word &
+          uint64_t{0x8080808080808080}) != 0;
+}
+
+// Returns the index of the first flag byte in data, or if include_escape is
+// set, of the first flag or escape byte. Returns data.size() if there is none.
+// Data is scanned a word at a time, falling back to individual bytes only for
+// words which contain a match and for the unaligned tail.
+size_t FindControlByte(ConstByteSpan data, bool include_escape) {
+  constexpr uint64_t kFlagWord = RepeatByte(kFlag);
+  constexpr uint64_t kEscapeWord = RepeatByte(kEscape);
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data.data() + i, sizeof(word));
+    if (HasZeroByte(word ^ kFlagWord) ||
+        (include_escape && HasZeroByte(word ^ kEscapeWord))) {
+      break;
+    }
+  }
+
+  for (; i < data.size(); ++i) {
+    if (data[i] == kFlag || (include_escape && data[i] == kEscape)) {
+      break;
+    }
+  }
+  return i;
+}
+
+}  // namespace
 
 Result<Frame> Frame::Parse(ConstByteSpan frame) {
   uint64_t address;
@@ -63,6 +108,11 @@ Result<Frame> Decoder::Process(const byte new_byte) {
         Reset();
 
         if (status.ok()) {
+#if PW_HDLC_ENABLE_TRACING
+          // Frames arrive a byte or run at a time, so decoding is marked by an
+          // instant event when each frame completes rather than a duration.
+          PW_TRACE_INSTANT("Decoded", "pw_hdlc");
+#endif  // PW_HDLC_ENABLE_TRACING
           return Frame::Parse(buffer_.first(completed_frame_size));
         }
         return status;
@@ -118,6 +168,69 @@ void Decoder::AppendByte(byte new_byte) {
   current_frame_size_ += 1;
 }
 
+size_t Decoder::ProcessRun(ConstByteSpan data) {
+  switch (state_) {
+    case State::kInterFrame: {
+      // Count bytes to track how many are discarded.
+      const size_t discarded = FindControlByte(data, /*include_escape=*/false);
+      current_frame_size_ += discarded;
+      return discarded;
+    }
+    case State::kFrame: {
+      const size_t run_size = FindControlByte(data, /*include_escape=*/true);
+      AppendRun(data.first(run_size));
+      return run_size;
+    }
+    case State::kFrameEscape:
+      return 0;
+  }
+  PW_CRASH("Bad decoder state");
+}
+
+void Decoder::AppendRun(ConstByteSpan run) {
+  if (run.empty()) {
+    return;
+  }
+
+  if (current_frame_size_ < max_size()) {
+    const size_t copy_size =
+        std::min(run.size(), max_size() - current_frame_size_);
+    std::memcpy(buffer_.data() + current_frame_size_, run.data(), copy_size);
+  }
+
+  // Arrange the bytes held back from the checksum in the order they were read,
+  // followed by the run. All but the last four of these are added to the
+  // running checksum, and the last four are held back in their place.
+  constexpr size_t kHeldBytes = sizeof(last_read_bytes_);
+  const size_t held = std::min(current_frame_size_, kHeldBytes);
+
+  std::array<byte, kHeldBytes> held_bytes{};
+  size_t index = (last_read_bytes_index_ + kHeldBytes - held) % kHeldBytes;
+  for (size_t i = 0; i < held; ++i) {
+    held_bytes[i] = last_read_bytes_[index];
+    index = (index + 1) % kHeldBytes;
+  }
+
+  const size_t total = held + run.size();
+  const size_t checksummed = total - std::min(total, kHeldBytes);
+
+  const size_t checksummed_held = std::min(held, checksummed);
+  fcs_.Update(span(held_bytes).first(checksummed_held));
+  fcs_.Update(run.first(checksummed - checksummed_held));
+
+  // Store the remaining bytes starting from the beginning of the ring buffer.
+  const size_t remaining = total - checksummed;
+  for (size_t i = 0; i < remaining; ++i) {
+    const size_t source = checksummed + i;
+    last_read_bytes_[i] =
+        source < held ? held_bytes[source] : run[source - held];
+  }
+  last_read_bytes_index_ = remaining % kHeldBytes;
+
+  // Always increase size: if it is larger than the buffer, overflow occurred.
+  current_frame_size_ += run.size();
+}
+
 Status Decoder::CheckFrame() const {
   // Empty frames are not an error; repeated flag characters are okay.
   if (current_frame_size_ == 0u) {
@@ -14,6 +14,7 @@
 
 #include "pw_hdlc/decoder.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 
@@ -154,6 +155,76 @@ TEST(Decoder, TooLargeForBuffer_DecodesNextFrame) {
   EXPECT_EQ(OkStatus(), decoder.Process(kFlag).status());
 }
 
+TEST(Decoder, ProcessSpan_DecodesEscapedFrames) {
+  // Two frames with escaped bytes, separated by bytes which do not form a
+  // valid frame.
+  static constexpr auto kData = bytes::Concat(
+      bytes::String("~1234\xa3\xe0\xe3\x9b~"),
+      bytes::String("garbage~"),
+      bytes::String("~\x03\x03}\x5e}\x5d"
+                    "123456789abc\x6a\x69\x47\xce~"));
+
+  for (size_t split = 1; split <= kData.size(); ++split) {
+    DecoderBuffer<32> decoder;
+    std::array<Status, 3> statuses;
+    size_t count = 0;
+
+    for (size_t i = 0; i < kData.size(); i += split) {
+      decoder.Process(span(kData).subspan(i, std::min(split, kData.size() - i)),
+                      [&](const Result<Frame>& result) {
+                        ASSERT_LT(count, statuses.size());
+                        statuses[count++] = result.status();
+                      });
+    }
+
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(statuses[0], OkStatus());
+    EXPECT_EQ(statuses[1], Status::DataLoss());  // Discarded bytes.
+    EXPECT_EQ(statuses[2], OkStatus());
+  }
+}
+
+TEST(Decoder, ProcessSpan_TooLargeForBuffer_StaysWithinBufferBoundaries) {
+  std::array<byte, 16> buffer = bytes::Initialized<16>('?');
+  Decoder decoder(span(buffer.data(), 8));
+
+  Status status = Status::Unknown();
+  decoder.Process(
+      bytes::String("~12345678901234567890\xf2\x19\x63\x90~"),
+      [&status](const Result<Frame>& result) { status = result.status(); });
+
+  for (size_t i = 8; i < buffer.size(); ++i) {
+    ASSERT_EQ(byte{'?'}, buffer[i]);
+  }
+  EXPECT_EQ(Status::ResourceExhausted(), status);
+}
+
+void ProcessSpanMatchesProcessByte(ConstByteSpan data) {
+  DecoderBuffer<64> byte_decoder;
+  DecoderBuffer<64> span_decoder;
+
+  std::array<Status, 1024> byte_statuses;
+  size_t byte_count = 0;
+  for (byte b : data) {
+    Result<Frame> result = byte_decoder.Process(b);
+    if (result.status() != Status::Unavailable()) {
+      byte_statuses[byte_count++] = result.status();
+    }
+  }
+
+  size_t span_count = 0;
+  span_decoder.Process(data, [&](const Result<Frame>& result) {
+    ASSERT_LT(span_count, byte_count);
+    EXPECT_EQ(result.status(), byte_statuses[span_count]);
+    span_count += 1;
+  });
+  EXPECT_EQ(span_count, byte_count);
+}
+
+FUZZ_TEST(Decoder, ProcessSpanMatchesProcessByte)
+    .WithDomains(VectorOf<1024>(ElementOf<byte>(
+        {kFlag, kEscape, byte{0x5e}, byte{0x5d}, byte{'1'}, byte{0xa3}})));
+
 void ProcessNeverCrashes(ConstByteSpan data) {
   DecoderBuffer<1024> decoder;
   for (byte b : data) {
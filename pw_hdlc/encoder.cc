@@ -21,14 +21,38 @@
 
 #include "pw_bytes/endian.h"
 #include "pw_hdlc/encoded_size.h"
+#include "pw_hdlc/internal/config.h"
 #include "pw_hdlc/internal/encoder.h"
 #include "pw_span/span.h"
 #include "pw_varint/varint.h"
 
+#if PW_HDLC_ENABLE_TRACING
+#include "pw_trace/trace.h"
+#endif  // PW_HDLC_ENABLE_TRACING
+
 using std::byte;
 
 namespace pw::hdlc {
 namespace internal {
+namespace {
+
+// Space for the largest varint address followed by the control byte.
+constexpr size_t kMetadataBufferSize = 16;
+
+// Encodes the unescaped address and control fields of a frame header. Returns
+// the number of bytes encoded, or 0 if the address cannot be encoded.
+size_t EncodeMetadata(uint64_t address,
+                      std::byte control,
+                      span<std::byte, kMetadataBufferSize> buffer) {
+  size_t size = varint::Encode(address, buffer, kAddressFormat);
+  if (size == 0) {
+    return 0;
+  }
+  buffer[size++] = control;
+  return size;
+}
+
+}  // namespace
 
 Status EscapeAndWrite(const byte b, stream::Writer& writer) {
   if (b == kFlag) {
@@ -74,22 +98,82 @@ Status Encoder::StartFrame(uint64_t address, std::byte control) {
     return status;
   }
 
-  std::array<std::byte, 16> metadata_buffer;
-  size_t metadata_size =
-      varint::Encode(address, metadata_buffer, kAddressFormat);
+  std::array<std::byte, kMetadataBufferSize> metadata_buffer;
+  size_t metadata_size = EncodeMetadata(address, control, metadata_buffer);
   if (metadata_size == 0) {
     return Status::InvalidArgument();
   }
+  return WriteData(span(metadata_buffer).first(metadata_size));
+}
 
-  metadata_buffer[metadata_size++] = control;
+Status BufferEncoder::StartUnnumberedFrame(uint64_t address) {
+  fcs_.clear();
+  size_ = 0;
+  if (buffer_.empty()) {
+    return Status::ResourceExhausted();
+  }
+  buffer_[size_++] = kFlag;
+
+  std::array<std::byte, kMetadataBufferSize> metadata_buffer;
+  size_t metadata_size = EncodeMetadata(
+      address, UFrameControl::UnnumberedInformation().data(), metadata_buffer);
+  if (metadata_size == 0) {
+    return Status::InvalidArgument();
+  }
   return WriteData(span(metadata_buffer).first(metadata_size));
 }
 
+Status BufferEncoder::WriteData(ConstByteSpan data) {
+  // Escape the data a run at a time, only committing it once all of it fits.
+  ByteSpan output = buffer_.subspan(size_);
+  size_t written = 0;
+  size_t begin = 0;
+  while (true) {
+    const size_t end = static_cast<size_t>(
+        std::find_if(data.begin() + begin, data.end(), NeedsEscaping) -
+        data.begin());
+    const size_t run = end - begin;
+    const size_t escaped = end == data.size() ? 0 : sizeof(kEscapedFlag);
+    if (run + escaped > output.size() - written) {
+      return Status::ResourceExhausted();
+    }
+    std::memcpy(output.data() + written, data.data() + begin, run);
+    written += run;
+    if (end == data.size()) {
+      break;
+    }
+    output[written++] = kEscape;
+    output[written++] = Escape(data[end]);
+    begin = end + 1;
+  }
+
+  size_ += written;
+  fcs_.Update(data);
+  return OkStatus();
+}
+
+Status BufferEncoder::FinishFrame() {
+  if (Status status =
+          WriteData(bytes::CopyInOrder(endian::little, fcs_.value()));
+      !status.ok()) {
+    return status;
+  }
+  if (size_ == buffer_.size()) {
+    return Status::ResourceExhausted();
+  }
+  buffer_[size_++] = kFlag;
+  return OkStatus();
+}
+
 }  // namespace internal
 
 Status WriteUIFrame(uint64_t address,
                     ConstByteSpan payload,
                     stream::Writer& writer) {
+#if PW_HDLC_ENABLE_TRACING
+  PW_TRACE_SCOPE("Encode", "pw_hdlc");
+#endif  // PW_HDLC_ENABLE_TRACING
+
   if (MaxEncodedFrameSize(address, payload) > writer.ConservativeWriteLimit()) {
     return Status::ResourceExhausted();
   }
@@ -105,4 +189,39 @@ Status WriteUIFrame(uint64_t address,
   return encoder.FinishFrame();
 }
 
+Result<ConstByteSpan> EncodeUIFrame(uint64_t address,
+                                    ConstByteSpan payload,
+                                    ByteSpan buffer) {
+#if PW_HDLC_ENABLE_TRACING
+  PW_TRACE_SCOPE("Encode", "pw_hdlc");
+#endif  // PW_HDLC_ENABLE_TRACING
+
+  internal::BufferEncoder encoder(buffer);
+
+  if (Status status = encoder.StartUnnumberedFrame(address); !status.ok()) {
+    return status;
+  }
+  if (Status status = encoder.WriteData(payload); !status.ok()) {
+    return status;
+  }
+  if (Status status = encoder.FinishFrame(); !status.ok()) {
+    return status;
+  }
+  return encoder.frame();
+}
+
+Status WriteUIFrame(uint64_t address,
+                    ConstByteSpan payload,
+                    ByteSpan buffer,
+                    stream::Writer& writer) {
+  Result<ConstByteSpan> frame = EncodeUIFrame(address, payload, buffer);
+  if (!frame.ok()) {
+    return frame.status();
+  }
+  if (frame->size() > writer.ConservativeWriteLimit()) {
+    return Status::ResourceExhausted();
+  }
+  return writer.Write(*frame);
+}
+
 }  // namespace pw::hdlc
@@ -195,5 +195,128 @@ TEST(WriteUIFrame, WriterError) {
             WriteUIFrame(kAddress, bytes::Array<0x01>(), writer));
 }
 
+TEST(EncodeUIFrame, MatchesWriteUIFrame) {
+  constexpr auto kPayload =
+      bytes::Array<0x7E, 0x7B, 0x61, 0x62, 0x63, 0x7D, 0x7E, 0x64, 0x65>();
+  std::array<byte, MaxEncodedFrameSize(kPayload.size())> expected{};
+  stream::MemoryWriter writer(expected);
+  ASSERT_EQ(OkStatus(), WriteUIFrame(kAddress, kPayload, writer));
+
+  std::array<byte, MaxEncodedFrameSize(kPayload.size())> buffer{};
+  for (size_t size = 0; size <= kPayload.size(); ++size) {
+    writer.clear();
+    ASSERT_EQ(OkStatus(),
+              WriteUIFrame(kAddress, span(kPayload).first(size), writer));
+
+    Result<ConstByteSpan> frame =
+        EncodeUIFrame(kAddress, span(kPayload).first(size), buffer);
+    ASSERT_EQ(OkStatus(), frame.status());
+    EXPECT_EQ(frame->data(), buffer.data());
+    ASSERT_EQ(frame->size(), writer.bytes_written());
+    EXPECT_TRUE(std::equal(frame->begin(), frame->end(), writer.data()));
+  }
+}
+
+TEST(EncodeUIFrame, EscapesAddressAndCrc32) {
+  std::array<byte, MaxEncodedFrameSize(2)> buffer{};
+  Result<ConstByteSpan> frame =
+      EncodeUIFrame(0x7d >> 1, bytes::String("A"), buffer);
+  ASSERT_EQ(OkStatus(), frame.status());
+  constexpr auto kEscapedAddressFrame = bytes::Concat(kFlag,
+                                                      kEscape,
+                                                      byte{0x5d},
+                                                      kUnnumberedControl,
+                                                      'A',
+                                                      uint32_t{0x899E00D4},
+                                                      kFlag);
+  ASSERT_EQ(frame->size(), kEscapedAddressFrame.size());
+  EXPECT_TRUE(std::equal(
+      frame->begin(), frame->end(), kEscapedAddressFrame.begin()));
+
+  frame = EncodeUIFrame(kAddress, bytes::String("aa"), buffer);
+  ASSERT_EQ(OkStatus(), frame.status());
+  constexpr auto kEscapedCrc32Frame =
+      bytes::Concat(kFlag,
+                    kEncodedAddress,
+                    kUnnumberedControl,
+                    bytes::String("aa"),
+                    bytes::Array<0x73, 0x44, 0xe0, 0x7d, 0x5e>(),
+                    kFlag);
+  ASSERT_EQ(frame->size(), kEscapedCrc32Frame.size());
+  EXPECT_TRUE(
+      std::equal(frame->begin(), frame->end(), kEscapedCrc32Frame.begin()));
+}
+
+TEST(EncodeUIFrame, BufferTooSmall) {
+  constexpr auto kPayload = bytes::Array<0x7E, 0x7D, 0x7E, 0x7D>();
+  std::array<byte, MaxEncodedFrameSize(kPayload.size())> buffer{};
+  Result<ConstByteSpan> frame = EncodeUIFrame(kAddress, kPayload, buffer);
+  ASSERT_EQ(OkStatus(), frame.status());
+  const size_t frame_size = frame->size();
+
+  // Encoding fails wherever in the frame the buffer runs out.
+  for (size_t size = 0; size < frame_size; ++size) {
+    EXPECT_EQ(Status::ResourceExhausted(),
+              EncodeUIFrame(kAddress, kPayload, span(buffer).first(size))
+                  .status());
+  }
+}
+
+class CountingWriter : public stream::NonSeekableWriter {
+ public:
+  CountingWriter(ByteSpan buffer) : writer_(buffer) {}
+
+  const stream::MemoryWriter& writer() const { return writer_; }
+  size_t writes() const { return writes_; }
+
+ private:
+  Status DoWrite(ConstByteSpan data) override {
+    ++writes_;
+    return writer_.Write(data);
+  }
+
+  size_t ConservativeLimit(LimitType type) const override {
+    return type == LimitType::kWrite ? writer_.ConservativeWriteLimit() : 0;
+  }
+
+  stream::MemoryWriter writer_;
+  size_t writes_ = 0;
+};
+
+TEST(WriteUIFrame, WithBuffer_WritesFrameOnce) {
+  constexpr auto kPayload = bytes::Array<0x7E, 0x7B, 0x61, 0x62, 0x63, 0x7D>();
+  std::array<byte, MaxEncodedFrameSize(kPayload.size())> expected{};
+  CountingWriter expected_writer(expected);
+  ASSERT_EQ(OkStatus(), WriteUIFrame(kAddress, kPayload, expected_writer));
+  EXPECT_GT(expected_writer.writes(), 1u);
+
+  std::array<byte, MaxEncodedFrameSize(kPayload.size())> buffer{};
+  std::array<byte, MaxEncodedFrameSize(kPayload.size())> output{};
+  CountingWriter writer(output);
+  ASSERT_EQ(OkStatus(), WriteUIFrame(kAddress, kPayload, buffer, writer));
+  EXPECT_EQ(writer.writes(), 1u);
+  ASSERT_EQ(writer.writer().bytes_written(),
+            expected_writer.writer().bytes_written());
+  EXPECT_TRUE(std::equal(writer.writer().data(),
+                         writer.writer().data() + writer.writer().bytes_written(),
+                         expected_writer.writer().data()));
+}
+
+TEST(WriteUIFrame, WithBuffer_TooLargeForWriter_WritesNothing) {
+  std::array<byte, MaxEncodedFrameSize(7)> buffer{};
+  std::array<byte, 8> output{};
+  CountingWriter writer(output);
+  EXPECT_EQ(Status::ResourceExhausted(),
+            WriteUIFrame(kAddress, bytes::String("1234567"), buffer, writer));
+  EXPECT_EQ(writer.writes(), 0u);
+}
+
+TEST(WriteUIFrame, WithBuffer_WriterError) {
+  std::array<byte, MaxEncodedFrameSize(1)> buffer{};
+  ErrorWriter writer;
+  EXPECT_EQ(Status::Unimplemented(),
+            WriteUIFrame(kAddress, bytes::Array<0x01>(), buffer, writer));
+}
+
 }  // namespace
 }  // namespace pw::hdlc
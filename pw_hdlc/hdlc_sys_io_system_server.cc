@@ -12,6 +12,7 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <array>
 #include <cstddef>
 
 #include "pw_hdlc/decoder.h"
@@ -21,6 +22,7 @@
 #include "pw_log/log.h"
 #include "pw_rpc_system_server/rpc_server.h"
 #include "pw_stream/sys_io_stream.h"
+#include "pw_sys_io/sys_io.h"
 
 namespace pw::rpc::system_server {
 namespace {
@@ -32,6 +34,9 @@ constexpr size_t kMaxTransmissionUnit = 1055;
 static_assert(kMaxTransmissionUnit ==
               hdlc::MaxEncodedFrameSize(rpc::cfg::kEncodingBufferSizeBytes));
 
+// The most received bytes to decode at once.
+constexpr size_t kReadBufferSize = 64;
+
 // Used to write HDLC data to pw::sys_io.
 stream::SysIoWriter writer;
 
@@ -61,18 +66,31 @@ Status Start() {
   std::array<std::byte, kDecoderBufferSize> input_buffer;
   hdlc::Decoder decoder(input_buffer);
 
+  std::array<std::byte, kReadBufferSize> read_buffer;
+
   while (true) {
-    std::byte byte;
-    Status ret_val = pw::sys_io::ReadByte(&byte);
+    // Wait for a byte, then take any others the backend has already received
+    // (e.g. in a DMA buffer) without waiting, so they are decoded in bulk.
+    Status ret_val = pw::sys_io::ReadByte(&read_buffer[0]);
     if (!ret_val.ok()) {
       return ret_val;
     }
-    if (auto result = decoder.Process(byte); result.ok()) {
-      hdlc::Frame& frame = result.value();
-      if (frame.address() == hdlc::kDefaultRpcAddress) {
-        server.ProcessPacket(frame.data());
-      }
+    size_t bytes_read = 1;
+    while (bytes_read < read_buffer.size() &&
+           pw::sys_io::TryReadByte(&read_buffer[bytes_read]).ok()) {
+      bytes_read += 1;
     }
+
+    decoder.Process(span(read_buffer).first(bytes_read),
+                    [](Result<hdlc::Frame>& result) {
+                      if (!result.ok()) {
+                        return;
+                      }
+                      hdlc::Frame& frame = result.value();
+                      if (frame.address() == hdlc::kDefaultRpcAddress) {
+                        server.ProcessPacket(frame.data());
+                      }
+                    });
   }
 }
 
@@ -0,0 +1,127 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/poll.h"
+#include "pw_channel/channel.h"
+#include "pw_hdlc/decoder.h"
+#include "pw_hdlc/internal/protocol.h"
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::hdlc {
+
+/// Exposes a byte ``pw::channel`` as a datagram channel, with each datagram
+/// carried in an HDLC UI frame.
+///
+/// Reads decode the byte stream directly from the lower channel's
+/// ``MultiBuf`` s into a buffer allocated for each frame. The returned
+/// datagram is that buffer, sliced to the frame's payload, so payloads are
+/// not copied after decoding. Frames that fail the frame check sequence, are
+/// too large, or are addressed to a different address are dropped.
+///
+/// Writes are framed in place when possible: if the ``MultiBuf`` was
+/// allocated with at least ``write_reservation()`` and the payload contains no
+/// bytes that need escaping, the header and trailer are written into the
+/// reserved headroom and tailroom and the payload is passed to the lower
+/// channel without copying. Otherwise, the frame is encoded into a new buffer.
+///
+/// The channel is unreliable, since frames may be dropped, but it inherits the
+/// lower channel's backpressure: ``PollReadyToWrite``, ``PollFlush``, and
+/// ``PollClose`` are forwarded to it.
+class HdlcChannel : public channel::DatagramReaderWriter {
+ public:
+  /// The maximum number of bytes added before and after each payload.
+  static constexpr multibuf::Reservation kFrameReservation = {
+      /*headroom=*/sizeof(kFlag) + kMaxEscapedVarintAddressSize +
+          kMaxEscapedControlSize,
+      /*tailroom=*/kMaxEscapedFcsSize + sizeof(kFlag),
+  };
+
+  /// Creates a channel that exchanges frames for ``address`` over ``lower``.
+  ///
+  /// Frame buffers for reads and for writes that cannot be framed in place are
+  /// allocated from ``allocator``. Received frames with payloads larger than
+  /// ``max_payload_size`` are dropped.
+  HdlcChannel(channel::ByteReaderWriter& lower,
+              uint64_t address,
+              multibuf::MultiBufAllocator& allocator,
+              size_t max_payload_size);
+
+  HdlcChannel(const HdlcChannel&) = delete;
+  HdlcChannel& operator=(const HdlcChannel&) = delete;
+
+  /// Returns the number of received frames that were dropped because they
+  /// were invalid, too large, or addressed elsewhere.
+  size_t dropped_frames() const { return dropped_frames_; }
+
+ private:
+  async2::Poll<Result<multibuf::MultiBuf>> DoPollRead(async2::Context& cx,
+                                                      size_t) override;
+
+  async2::Poll<> DoPollReadyToWrite(async2::Context& cx) override {
+    return lower_.PollReadyToWrite(cx);
+  }
+
+  multibuf::Reservation DoGetWriteReservation() const override {
+    return lower_.write_reservation() + kFrameReservation;
+  }
+
+  Result<channel::WriteToken> DoWrite(multibuf::MultiBuf&& payload) override;
+
+  Result<channel::WriteToken> DoWriteBatch(
+      span<multibuf::MultiBuf> batch) override;
+
+  async2::Poll<Result<channel::WriteToken>> DoPollFlush(
+      async2::Context& cx) override {
+    return lower_.PollFlush(cx);
+  }
+
+  async2::Poll<Status> DoPollClose(async2::Context& cx) override {
+    return lower_.PollClose(cx);
+  }
+
+  // Ensures that a frame buffer and a decoder writing into it are available.
+  async2::Poll<Status> PendDecoder(async2::Context& cx);
+
+  // Decodes bytes from ``input_`` until a frame for this channel's address is
+  // complete, returning its payload.
+  std::optional<multibuf::MultiBuf> DecodeInput();
+
+  // Replaces ``payload`` with the HDLC frame that carries it.
+  Status Encode(multibuf::MultiBuf& payload);
+
+  channel::ByteReaderWriter& lower_;
+  const uint64_t address_;
+  multibuf::MultiBufAllocator& allocator_;
+  const size_t frame_buffer_size_;
+
+  std::optional<multibuf::MultiBufAllocationFuture> frame_allocation_;
+  // The buffer that ``decoder_`` decodes the current frame into.
+  std::optional<multibuf::MultiBuf> frame_buffer_;
+  std::optional<Decoder> decoder_;
+  // Bytes read from the lower channel that have not yet been decoded.
+  multibuf::MultiBuf input_;
+  size_t dropped_frames_ = 0;
+};
+
+}  // namespace pw::hdlc
@@ -103,10 +103,19 @@ class Decoder {
 
   /// @brief Processes a span of data and calls the provided callback with each
   /// frame or error.
+  ///
+  /// This is equivalent to calling `Process(std::byte)` for each byte, but
+  /// handles runs of bytes without flag or escape characters in bulk.
   template <typename F, typename... Args>
   void Process(ConstByteSpan data, F&& callback, Args&&... args) {
-    for (std::byte b : data) {
-      auto result = Process(b);
+    while (true) {
+      data = data.subspan(ProcessRun(data));
+      if (data.empty()) {
+        return;
+      }
+
+      auto result = Process(data.front());
+      data = data.subspan(1);
       if (result.status() != Status::Unavailable()) {
         std::invoke(
             std::forward<F>(callback), std::forward<Args>(args)..., result);
@@ -139,6 +148,15 @@ class Decoder {
 
   void AppendByte(std::byte new_byte);
 
+  // Processes the leading bytes of data which can be handled without going
+  // through the state machine a byte at a time: frame contents up to the next
+  // flag or escape byte, or discarded bytes up to the next flag. Returns the
+  // number of bytes processed. These bytes never complete a frame.
+  size_t ProcessRun(ConstByteSpan data);
+
+  // Appends bytes which do not need to be unescaped to the current frame.
+  void AppendRun(ConstByteSpan run);
+
   Status CheckFrame() const;
 
   bool VerifyFrameCheckSequence() const;
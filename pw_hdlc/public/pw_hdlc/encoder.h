@@ -14,6 +14,7 @@
 #pragma once
 
 #include "pw_bytes/span.h"
+#include "pw_result/result.h"
 #include "pw_status/status.h"
 #include "pw_stream/stream.h"
 
@@ -46,4 +47,46 @@ Status WriteUIFrame(uint64_t address,
                     ConstByteSpan payload,
                     stream::Writer& writer);
 
+/// @brief Encodes an HDLC unnumbered information frame (UI frame) into the
+/// provided buffer in a single pass.
+///
+/// The payload is escaped a run of bytes at a time and its frame check
+/// sequence is computed in bulk, so this is considerably faster than writing
+/// a frame to a ``pw::stream`` that copies each escaped byte. A buffer of
+/// ``MaxEncodedFrameSize(max_payload_size)`` bytes fits any frame with a
+/// payload of up to ``max_payload_size`` bytes.
+///
+/// @param address The frame address.
+///
+/// @param payload The frame data to encode.
+///
+/// @param buffer The buffer to encode the frame into.
+///
+/// @returns A ``pw::Result`` with the encoded frame, which starts at the
+/// beginning of ``buffer``, or one of the following errors:
+/// * @pw_status{RESOURCE_EXHAUSTED} - The frame does not fit in ``buffer``.
+/// * @pw_status{INVALID_ARGUMENT} - The ``address`` could not be encoded.
+Result<ConstByteSpan> EncodeUIFrame(uint64_t address,
+                                    ConstByteSpan payload,
+                                    ByteSpan buffer);
+
+/// @brief Encodes an HDLC unnumbered information frame (UI frame) into
+/// ``buffer`` with ``EncodeUIFrame()``, then writes the whole frame to the
+/// provided ``pw::stream`` writer with a single call to ``Write()``.
+///
+/// This avoids the many small writes issued by the overload without a
+/// buffer, which is costly for writers that do work on every call, such as
+/// those backed by a UART driver or a socket.
+///
+/// @returns A ``pw::Status`` instance describing the result of the operation:
+/// * @pw_status{OK} - The write finished successfully.
+/// * @pw_status{RESOURCE_EXHAUSTED} - The frame does not fit in ``buffer``,
+///   or is larger than the writer's conservative limit. Nothing is written.
+/// * @pw_status{INVALID_ARGUMENT} - The ``address`` could not be encoded.
+/// * Any error returned by the writer.
+Status WriteUIFrame(uint64_t address,
+                    ConstByteSpan payload,
+                    ByteSpan buffer,
+                    stream::Writer& writer);
+
 }  // namespace pw::hdlc
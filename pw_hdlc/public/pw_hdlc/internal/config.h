@@ -0,0 +1,23 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Configuration macros for the pw_hdlc module.
+#pragma once
+
+// Whether pw_hdlc emits pw_trace events when it encodes a frame and when it
+// decodes one. Tracing is disabled by default, in which case no trace points
+// are compiled in.
+#ifndef PW_HDLC_ENABLE_TRACING
+#define PW_HDLC_ENABLE_TRACING 0
+#endif  // PW_HDLC_ENABLE_TRACING
@@ -45,6 +45,11 @@ class Encoder {
   // StartInformationFrame call, and prior to a FinishFrame() call.
   Status WriteData(ConstByteSpan data);
 
+  // Includes data in the frame check sequence without writing it. This is
+  // used for payloads that already sit, unescaped, between the header and
+  // trailer in the output. The data must not contain bytes that need escaping.
+  void SkipData(ConstByteSpan data) { fcs_.Update(data); }
+
   // Finishes a frame. Writes the frame check sequence and a terminating flag.
   Status FinishFrame();
 
@@ -58,4 +63,37 @@ class Encoder {
   checksum::Crc32 fcs_;
 };
 
+// Encodes HDLC frames directly into a contiguous buffer. Unlike Encoder, data
+// is escaped a run of bytes at a time with no intermediate writes, so the
+// finished frame can be handed to the output with a single write.
+class BufferEncoder {
+ public:
+  constexpr BufferEncoder(ByteSpan buffer) : buffer_(buffer) {}
+
+  // Writes the header for an U-frame. After successfully calling
+  // StartUnnumberedFrame, WriteData may be called any number of times.
+  Status StartUnnumberedFrame(uint64_t address);
+
+  // Escapes data for an ongoing frame into the buffer. Returns
+  // RESOURCE_EXHAUSTED, leaving the buffer unchanged, if the escaped data does
+  // not fit.
+  Status WriteData(ConstByteSpan data);
+
+  // Includes data in the frame check sequence without writing it, as in
+  // Encoder::SkipData().
+  void SkipData(ConstByteSpan data) { fcs_.Update(data); }
+
+  // Finishes a frame. Writes the frame check sequence and a terminating flag.
+  Status FinishFrame();
+
+  // The bytes encoded so far.
+  ConstByteSpan frame() const { return buffer_.first(size_); }
+  size_t size() const { return size_; }
+
+ private:
+  ByteSpan buffer_;
+  size_t size_ = 0;
+  checksum::Crc32 fcs_;
+};
+
 }  // namespace pw::hdlc::internal
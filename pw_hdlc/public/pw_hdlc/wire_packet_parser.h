@@ -20,15 +20,45 @@ namespace pw::hdlc {
 // HDLC frame parser for routers that operates on wire-encoded frames.
 //
 // This allows routing HDLC frames through Pigweed routers without having to
-// first decode them from their wire format.
+// first decode them from their wire format. The address is read directly from
+// the escaped frame, and the frame check sequence is computed over the escaped
+// frame in place, so no part of the frame is copied.
 class WirePacketParser : public router::PacketParser {
  public:
-  constexpr WirePacketParser() : address_(0) {}
+  // When to verify a frame's FCS.
+  enum class Verification {
+    // Parse() verifies the whole frame.
+    kOnParse,
 
-  // Verifies and parses an HDLC frame. Packet passed in is expected to be a
-  // single, complete, wire-encoded frame, starting and ending with a flag.
+    // Parse() only reads the address and control fields. The frame is verified
+    // by VerifyPacket(), which a router only calls for routes that request it.
+    // Frames forwarded without verification may be corrupt; the receiving
+    // decoder is expected to reject them.
+    kDeferred,
+  };
+
+  constexpr WirePacketParser() : WirePacketParser(Verification::kOnParse) {}
+
+  explicit constexpr WirePacketParser(Verification verification)
+      : verification_(verification),
+        address_(0),
+        header_size_(0),
+        verified_(false) {}
+
+  // Parses an HDLC frame, verifying it unless verification is deferred. Packet
+  // passed in is expected to be a single, complete, wire-encoded frame,
+  // starting and ending with a flag.
   bool Parse(ConstByteSpan packet) final;
 
+  // Verifies the escaping and the FCS of the last parsed frame. A frame is only
+  // checked once, even if Parse() already verified it.
+  bool VerifyPacket() final {
+    if (!verified_) {
+      verified_ = Verify();
+    }
+    return verified_;
+  }
+
   std::optional<uint32_t> GetDestinationAddress() const override {
     return address_;
   }
@@ -37,7 +67,16 @@ class WirePacketParser : public router::PacketParser {
   constexpr uint64_t address() const { return address_; }
 
  private:
+  bool Verify() const;
+
+  Verification verification_;
   uint64_t address_;
+
+  // The escaped frame contents between the flags, and the escaped size of its
+  // address and control fields.
+  ConstByteSpan contents_;
+  size_t header_size_;
+  bool verified_;
 };
 
 }  // namespace pw::hdlc
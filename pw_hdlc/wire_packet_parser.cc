@@ -14,15 +14,39 @@
 
 #include "pw_hdlc/wire_packet_parser.h"
 
+#include <algorithm>
+#include <array>
+
 #include "pw_bytes/endian.h"
 #include "pw_checksum/crc32.h"
 #include "pw_hdlc/decoder.h"
 #include "pw_hdlc/internal/protocol.h"
 
 namespace pw::hdlc {
+namespace {
+
+// Reads one unescaped byte from escaped frame contents, starting at `offset`
+// and advancing past it. Returns false at the end of the contents or if the
+// byte is a flag or an invalid escape.
+bool ReadUnescapedByte(ConstByteSpan contents, size_t& offset, std::byte& b) {
+  if (offset >= contents.size() || contents[offset] == kFlag) {
+    return false;
+  }
+  b = contents[offset++];
+  if (b != kEscape) {
+    return true;
+  }
+  if (offset >= contents.size() || NeedsEscaping(contents[offset])) {
+    return false;
+  }
+  b = Escape(contents[offset++]);
+  return true;
+}
+
+}  // namespace
 
 bool WirePacketParser::Parse(ConstByteSpan packet) {
-  if (packet.size_bytes() < Frame::kMinContentSizeBytes) {
+  if (packet.size_bytes() < Frame::kMinContentSizeBytes + 2) {
     return false;
   }
 
@@ -30,25 +54,86 @@ bool WirePacketParser::Parse(ConstByteSpan packet) {
     return false;
   }
 
-  // Partially decode into a buffer with space only for the address and control
-  // fields of the frame. The decoder will verify the frame's FCS field.
-  std::array<std::byte, 16> buffer = {};
-  Decoder decoder(buffer);
-  Status status = Status::Unknown();
+  contents_ = packet.subspan(1, packet.size() - 2);
+  verified_ = false;
 
-  decoder.Process(packet, [&status](const Result<Frame>& result) {
-    status = result.status();
-  });
+  // Unescape only the address, which ends with the first byte that has its
+  // least significant bit set, and the control byte that follows it.
+  std::array<std::byte, kMaxAddressSize> address = {};
+  size_t address_size = 0;
+  size_t offset = 0;
+  do {
+    if (address_size == address.size() ||
+        !ReadUnescapedByte(contents_, offset, address[address_size])) {
+      return false;
+    }
+  } while ((address[address_size++] & std::byte{1}) == std::byte{0});
+
+  if (varint::Decode(span(address).first(address_size),
+                     &address_,
+                     kAddressFormat) == 0u) {
+    return false;
+  }
 
-  Result<Frame> result = Frame::Parse(buffer);
-  if (!result.ok()) {
+  std::byte control;
+  if (!ReadUnescapedByte(contents_, offset, control)) {
     return false;
   }
+  header_size_ = offset;
 
-  address_ = result.value().address();
+  return verification_ == Verification::kDeferred || VerifyPacket();
+}
+
+bool WirePacketParser::Verify() const {
+  // Find the start of the FCS by stepping back over its four bytes. Since the
+  // second byte of an escape sequence is never an escape, a byte preceded by
+  // an escape is always the second byte of an escape sequence.
+  size_t fcs_start = contents_.size();
+  for (size_t i = 0; i < kFcsSize; ++i) {
+    if (fcs_start == 0u) {
+      return false;
+    }
+    fcs_start -= 1;
+    if (fcs_start > 0u && contents_[fcs_start - 1] == kEscape) {
+      fcs_start -= 1;
+    }
+  }
+
+  if (fcs_start < header_size_) {
+    return false;
+  }
+
+  // Checksum the unescaped address, control, and payload fields one run of
+  // unescaped bytes at a time.
+  checksum::Crc32 crc;
+  ConstByteSpan data = contents_.first(fcs_start);
+  while (!data.empty()) {
+    const size_t run_size = static_cast<size_t>(
+        std::find_if(data.begin(), data.end(), NeedsEscaping) - data.begin());
+    crc.Update(data.first(run_size));
+    data = data.subspan(run_size);
+
+    if (!data.empty()) {
+      size_t offset = 0;
+      std::byte b;
+      if (!ReadUnescapedByte(data, offset, b)) {
+        return false;
+      }
+      crc.Update(b);
+      data = data.subspan(offset);
+    }
+  }
+
+  std::array<std::byte, kFcsSize> fcs;
+  size_t offset = fcs_start;
+  for (std::byte& b : fcs) {
+    if (!ReadUnescapedByte(contents_, offset, b)) {
+      return false;
+    }
+  }
 
-  // RESOURCE_EXHAUSTED is expected as the buffer is too small for the packet.
-  return status.ok() || status.IsResourceExhausted();
+  return offset == contents_.size() &&
+         bytes::ReadInOrder<uint32_t>(endian::little, fcs) == crc.value();
 }
 
 }  // namespace pw::hdlc
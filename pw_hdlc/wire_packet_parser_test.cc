@@ -146,5 +146,91 @@ TEST(WirePacketParser, Parse_EmptyPacket) {
   EXPECT_FALSE(parser.Parse({}));
 }
 
+TEST(WirePacketParser, Parse_EscapeBeforeClosingFlag) {
+  WirePacketParser parser;
+  EXPECT_FALSE(parser.Parse(bytes::Concat(kFlag,
+                                          kEncodedAddress,
+                                          kControl,
+                                          bytes::String("hello"),
+                                          0x1231d0a9,
+                                          kEscape,
+                                          kFlag)));
+}
+
+TEST(WirePacketParser, VerifyPacket_AfterParse) {
+  WirePacketParser parser;
+  const auto packet = bytes::Concat(kFlag,
+                                    kEncodedAddress,
+                                    kControl,
+                                    bytes::String("hello"),
+                                    0x1231d0a9,
+                                    kFlag);
+  ASSERT_TRUE(parser.Parse(packet));
+  EXPECT_TRUE(parser.VerifyPacket());
+}
+
+TEST(WirePacketParser, Deferred_ValidPacket) {
+  WirePacketParser parser(WirePacketParser::Verification::kDeferred);
+  const auto packet = bytes::Concat(kFlag,
+                                    kEscapedEscape,
+                                    kControl,
+                                    kEscapedEscape,
+                                    kEscapedFlag,
+                                    kEscapedFlag,
+                                    0x8ffd8fcd,
+                                    kFlag);
+  ASSERT_TRUE(parser.Parse(packet));
+  EXPECT_EQ(parser.GetDestinationAddress(), 62u);
+  EXPECT_TRUE(parser.VerifyPacket());
+}
+
+TEST(WirePacketParser, Deferred_EscapedFcs) {
+  WirePacketParser parser(WirePacketParser::Verification::kDeferred);
+  const auto packet = bytes::Concat(kFlag,
+                                    kEncodedAddress,
+                                    kControl,
+                                    uint8_t{'b'},
+                                    // FCS: fc 92 7d 7e
+                                    bytes::String("\x7d\x5e\x7d\x5d\x92\xfc"),
+                                    kFlag);
+  ASSERT_TRUE(parser.Parse(packet));
+  EXPECT_EQ(parser.GetDestinationAddress(), kAddress);
+  EXPECT_TRUE(parser.VerifyPacket());
+}
+
+TEST(WirePacketParser, Deferred_BadFcs_OnlyFailsVerification) {
+  WirePacketParser parser(WirePacketParser::Verification::kDeferred);
+  const auto packet = bytes::Concat(kFlag,
+                                    kEncodedAddress,
+                                    kControl,
+                                    bytes::String("hello"),
+                                    0x1badda7a,
+                                    kFlag);
+  ASSERT_TRUE(parser.Parse(packet));
+  EXPECT_EQ(parser.GetDestinationAddress(), kAddress);
+  EXPECT_FALSE(parser.VerifyPacket());
+}
+
+TEST(WirePacketParser, Deferred_FlagInFrame_FailsVerification) {
+  WirePacketParser parser(WirePacketParser::Verification::kDeferred);
+  const auto packet = bytes::Concat(kFlag,
+                                    kEncodedAddress,
+                                    kControl,
+                                    // inclusive-language: ignore
+                                    bytes::String("he~lo"),
+                                    0xdbae98fe,
+                                    kFlag);
+  ASSERT_TRUE(parser.Parse(packet));
+  EXPECT_FALSE(parser.VerifyPacket());
+}
+
+TEST(WirePacketParser, Deferred_InvalidAddress) {
+  WirePacketParser parser(WirePacketParser::Verification::kDeferred);
+  EXPECT_FALSE(parser.Parse(bytes::Concat(kFlag,
+                                          bytes::String("\x02\x04\x06\x08"),
+                                          kEscapedFlag,
+                                          kFlag)));
+}
+
 }  // namespace
 }  // namespace pw::hdlc
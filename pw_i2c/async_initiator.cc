@@ -0,0 +1,143 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_i2c/async_initiator.h"
+
+#include <mutex>
+#include <utility>
+
+#include "pw_assert/check.h"
+
+namespace pw::i2c {
+
+AsyncTransaction::~AsyncTransaction() {
+  if (initiator_ != nullptr) {
+    std::lock_guard lock(initiator_->lock_);
+    PW_CHECK(state_ == State::kComplete,
+             "An I2C transaction was destroyed while queued or in progress");
+  }
+}
+
+bool AsyncTransaction::submitted() const { return initiator_ != nullptr; }
+
+async2::Poll<Status> AsyncTransaction::Pend(async2::Context& cx) {
+  if (initiator_ == nullptr) {
+    return async2::Ready(Status::FailedPrecondition());
+  }
+  std::lock_guard lock(initiator_->lock_);
+  if (state_ != State::kComplete) {
+    waker_ = cx.GetWaker(async2::WaitReason::Unspecified());
+    return async2::Pending();
+  }
+  state_ = State::kIdle;
+  initiator_ = nullptr;
+  return result_;
+}
+
+Status AsyncInitiator::Submit(AsyncTransaction& transaction) {
+  if (transaction.tx_buffer().empty() && transaction.rx_buffer().empty()) {
+    return Status::InvalidArgument();
+  }
+  if (transaction.submitted()) {
+    return Status::FailedPrecondition();
+  }
+
+  AsyncTransaction* to_start = nullptr;
+  {
+    std::lock_guard lock(lock_);
+    transaction.initiator_ = this;
+    transaction.state_ = AsyncTransaction::State::kQueued;
+    queue_.push_back(transaction);
+    if (active_ == nullptr) {
+      to_start = ActivateNext();
+    }
+  }
+  // Start the transaction without the lock held, since the backend may
+  // complete it immediately.
+  if (to_start != nullptr) {
+    DoStartTransaction(*to_start);
+  }
+  return OkStatus();
+}
+
+Status AsyncInitiator::Cancel(AsyncTransaction& transaction) {
+  async2::Waker waker;
+  AsyncTransaction* next = nullptr;
+  {
+    std::lock_guard lock(lock_);
+    if (transaction.initiator_ != this) {
+      return Status::FailedPrecondition();
+    }
+    switch (transaction.state_) {
+      case AsyncTransaction::State::kQueued:
+        queue_.remove(transaction);
+        transaction.state_ = AsyncTransaction::State::kComplete;
+        transaction.result_ = Status::Cancelled();
+        waker = std::move(transaction.waker_);
+        break;
+      case AsyncTransaction::State::kActive:
+        if (!DoAbortTransaction()) {
+          return Status::Unimplemented();
+        }
+        next = CompleteActive(Status::Cancelled(), waker);
+        break;
+      case AsyncTransaction::State::kIdle:
+      case AsyncTransaction::State::kComplete:
+        return Status::FailedPrecondition();
+    }
+  }
+  std::move(waker).Wake();
+  if (next != nullptr) {
+    DoStartTransaction(*next);
+  }
+  return OkStatus();
+}
+
+void AsyncInitiator::TransactionComplete(Status status) {
+  async2::Waker waker;
+  AsyncTransaction* next;
+  {
+    std::lock_guard lock(lock_);
+    next = CompleteActive(status, waker);
+  }
+  std::move(waker).Wake();
+  if (next != nullptr) {
+    DoStartTransaction(*next);
+  }
+}
+
+AsyncTransaction* AsyncInitiator::CompleteActive(Status status,
+                                                 async2::Waker& waker) {
+  AsyncTransaction* done = active_;
+  PW_CHECK_NOTNULL(done, "No I2C transaction is in progress");
+  done->state_ = AsyncTransaction::State::kComplete;
+  done->result_ = status;
+  // Take the waker so the transaction isn't touched after the lock is
+  // released, at which point its task may destroy it.
+  waker = std::move(done->waker_);
+  return ActivateNext();
+}
+
+AsyncTransaction* AsyncInitiator::ActivateNext() {
+  if (queue_.empty()) {
+    active_ = nullptr;
+    return nullptr;
+  }
+  active_ = &queue_.front();
+  queue_.pop_front();
+  active_->state_ = AsyncTransaction::State::kActive;
+  return active_;
+}
+
+}  // namespace pw::i2c
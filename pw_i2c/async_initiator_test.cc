@@ -0,0 +1,309 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_i2c/async_initiator.h"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_bytes/array.h"
+#include "pw_containers/vector.h"
+#include "pw_i2c/address.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::i2c {
+namespace {
+
+using async2::Context;
+using async2::Dispatcher;
+using async2::Pending;
+using async2::Poll;
+using async2::Ready;
+
+constexpr Address kAddress1 = Address::SevenBit<0x01>();
+constexpr Address kAddress2 = Address::SevenBit<0x02>();
+
+// Records the started transactions, and completes them when the test calls
+// Finish(), like a driver that completes transfers in an interrupt.
+class FakeAsyncInitiator : public AsyncInitiator {
+ public:
+  const AsyncTransaction* active() const { return active_; }
+
+  const Vector<const AsyncTransaction*, 8>& started() const {
+    return started_;
+  }
+
+  int aborts() const { return aborts_; }
+
+  void set_can_abort(bool can_abort) { can_abort_ = can_abort; }
+
+  void Finish(Status status) {
+    ASSERT_NE(active_, nullptr);
+    active_ = nullptr;
+    TransactionComplete(status);
+  }
+
+ private:
+  void DoStartTransaction(const AsyncTransaction& transaction) override {
+    EXPECT_EQ(active_, nullptr);
+    active_ = &transaction;
+    started_.push_back(&transaction);
+  }
+
+  bool DoAbortTransaction() override {
+    if (!can_abort_) {
+      return false;
+    }
+    aborts_ += 1;
+    active_ = nullptr;
+    return true;
+  }
+
+  const AsyncTransaction* active_ = nullptr;
+  Vector<const AsyncTransaction*, 8> started_;
+  int aborts_ = 0;
+  bool can_abort_ = true;
+};
+
+// Pends a transaction until it completes, and stores the result.
+class PendTransactionTask : public async2::Task {
+ public:
+  explicit PendTransactionTask(AsyncTransaction& transaction)
+      : transaction_(transaction) {}
+
+  const std::optional<Status>& result() const { return result_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    Poll<Status> result = transaction_.Pend(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    result_ = *result;
+    return Ready();
+  }
+
+  AsyncTransaction& transaction_;
+  std::optional<Status> result_;
+};
+
+TEST(AsyncInitiator, SubmitStartsTransaction) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kTx = bytes::Array<1, 2>();
+  std::array<std::byte, 3> rx;
+  AsyncTransaction transaction(kAddress1, kTx, rx);
+
+  EXPECT_FALSE(transaction.submitted());
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+  EXPECT_TRUE(transaction.submitted());
+  EXPECT_EQ(initiator.active(), &transaction);
+  EXPECT_EQ(initiator.active()->address().GetSevenBit(), 0x01u);
+  EXPECT_EQ(initiator.active()->tx_buffer().data(), kTx.data());
+  EXPECT_EQ(initiator.active()->rx_buffer().data(), rx.data());
+
+  initiator.Finish(OkStatus());
+}
+
+TEST(AsyncInitiator, PendReturnsResultWhenComplete) {
+  FakeAsyncInitiator initiator;
+  std::array<std::byte, 1> rx;
+  AsyncTransaction transaction(kAddress1, ConstByteSpan(), rx);
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+
+  Dispatcher dispatcher;
+  PendTransactionTask task(transaction);
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_FALSE(task.result().has_value());
+
+  initiator.Finish(Status::Unavailable());
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(task.result(), Status::Unavailable());
+  EXPECT_FALSE(transaction.submitted());
+}
+
+TEST(AsyncInitiator, TransactionsRunInOrder) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction first(kAddress1, kTx, ByteSpan());
+  AsyncTransaction second(kAddress2, kTx, ByteSpan());
+  AsyncTransaction third(kAddress1, kTx, ByteSpan());
+  ASSERT_EQ(initiator.Submit(first), OkStatus());
+  ASSERT_EQ(initiator.Submit(second), OkStatus());
+  ASSERT_EQ(initiator.Submit(third), OkStatus());
+
+  Dispatcher dispatcher;
+  PendTransactionTask first_task(first);
+  PendTransactionTask second_task(second);
+  PendTransactionTask third_task(third);
+  dispatcher.Post(first_task);
+  dispatcher.Post(second_task);
+  dispatcher.Post(third_task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  EXPECT_EQ(initiator.active(), &first);
+  initiator.Finish(OkStatus());
+  EXPECT_EQ(initiator.active(), &second);
+  initiator.Finish(Status::DeadlineExceeded());
+  EXPECT_EQ(initiator.active(), &third);
+  initiator.Finish(OkStatus());
+  EXPECT_EQ(initiator.active(), nullptr);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(first_task.result(), OkStatus());
+  EXPECT_EQ(second_task.result(), Status::DeadlineExceeded());
+  EXPECT_EQ(third_task.result(), OkStatus());
+  ASSERT_EQ(initiator.started().size(), 3u);
+  EXPECT_EQ(initiator.started()[0], &first);
+  EXPECT_EQ(initiator.started()[1], &second);
+  EXPECT_EQ(initiator.started()[2], &third);
+}
+
+TEST(AsyncInitiator, TransactionCanBeResubmitted) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction transaction(kAddress1, kTx, ByteSpan());
+
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+    initiator.Finish(OkStatus());
+
+    Dispatcher dispatcher;
+    PendTransactionTask task(transaction);
+    dispatcher.Post(task);
+    EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+    EXPECT_EQ(task.result(), OkStatus());
+  }
+  EXPECT_EQ(initiator.started().size(), 2u);
+}
+
+TEST(AsyncInitiator, SubmitFailsIfAlreadySubmitted) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction transaction(kAddress1, kTx, ByteSpan());
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+  EXPECT_EQ(initiator.Submit(transaction), Status::FailedPrecondition());
+  initiator.Finish(OkStatus());
+
+  // The transaction stays submitted until its result is returned.
+  EXPECT_EQ(initiator.Submit(transaction), Status::FailedPrecondition());
+  Dispatcher dispatcher;
+  PendTransactionTask task(transaction);
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+}
+
+TEST(AsyncInitiator, SubmitFailsWithoutBuffers) {
+  FakeAsyncInitiator initiator;
+  AsyncTransaction transaction(kAddress1, ConstByteSpan(), ByteSpan());
+  EXPECT_EQ(initiator.Submit(transaction), Status::InvalidArgument());
+  EXPECT_FALSE(transaction.submitted());
+}
+
+TEST(AsyncInitiator, PendWithoutSubmitFails) {
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction transaction(kAddress1, kTx, ByteSpan());
+  Dispatcher dispatcher;
+  PendTransactionTask task(transaction);
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(task.result(), Status::FailedPrecondition());
+}
+
+TEST(AsyncInitiator, CancelQueuedTransaction) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction first(kAddress1, kTx, ByteSpan());
+  AsyncTransaction second(kAddress2, kTx, ByteSpan());
+  AsyncTransaction third(kAddress1, kTx, ByteSpan());
+  ASSERT_EQ(initiator.Submit(first), OkStatus());
+  ASSERT_EQ(initiator.Submit(second), OkStatus());
+  ASSERT_EQ(initiator.Submit(third), OkStatus());
+
+  Dispatcher dispatcher;
+  PendTransactionTask second_task(second);
+  dispatcher.Post(second_task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  EXPECT_EQ(initiator.Cancel(second), OkStatus());
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(second_task.result(), Status::Cancelled());
+  EXPECT_EQ(initiator.aborts(), 0);
+
+  initiator.Finish(OkStatus());
+  EXPECT_EQ(initiator.active(), &third);
+  initiator.Finish(OkStatus());
+
+  for (AsyncTransaction* transaction : {&first, &third}) {
+    PendTransactionTask task(*transaction);
+    dispatcher.Post(task);
+    EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  }
+}
+
+TEST(AsyncInitiator, CancelActiveTransactionAborts) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction first(kAddress1, kTx, ByteSpan());
+  AsyncTransaction second(kAddress2, kTx, ByteSpan());
+  ASSERT_EQ(initiator.Submit(first), OkStatus());
+  ASSERT_EQ(initiator.Submit(second), OkStatus());
+
+  EXPECT_EQ(initiator.Cancel(first), OkStatus());
+  EXPECT_EQ(initiator.aborts(), 1);
+  EXPECT_EQ(initiator.active(), &second);
+  EXPECT_EQ(initiator.Cancel(first), Status::FailedPrecondition());
+
+  Dispatcher dispatcher;
+  PendTransactionTask task(first);
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(task.result(), Status::Cancelled());
+
+  initiator.Finish(OkStatus());
+  PendTransactionTask second_task(second);
+  dispatcher.Post(second_task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+}
+
+TEST(AsyncInitiator, CancelActiveTransactionWithoutAbortRunsToCompletion) {
+  FakeAsyncInitiator initiator;
+  initiator.set_can_abort(false);
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction transaction(kAddress1, kTx, ByteSpan());
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+
+  EXPECT_EQ(initiator.Cancel(transaction), Status::Unimplemented());
+  EXPECT_EQ(initiator.active(), &transaction);
+
+  initiator.Finish(OkStatus());
+  Dispatcher dispatcher;
+  PendTransactionTask task(transaction);
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(task.result(), OkStatus());
+}
+
+TEST(AsyncInitiator, CancelUnsubmittedTransactionFails) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kTx = bytes::Array<1>();
+  AsyncTransaction transaction(kAddress1, kTx, ByteSpan());
+  EXPECT_EQ(initiator.Cancel(transaction), Status::FailedPrecondition());
+}
+
+}  // namespace
+}  // namespace pw::i2c
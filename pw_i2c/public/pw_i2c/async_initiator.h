@@ -0,0 +1,198 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/poll.h"
+#include "pw_bytes/span.h"
+#include "pw_containers/intrusive_list.h"
+#include "pw_i2c/address.h"
+#include "pw_status/status.h"
+#include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::i2c {
+
+class AsyncInitiator;
+
+/// A write, read, or write+read I2C transaction that is queued on an
+/// `AsyncInitiator`. The signal on the bus is the same as for the matching
+/// `Initiator::WriteReadFor` call.
+///
+/// The buffers must remain valid, and the `AsyncTransaction` must not be
+/// destroyed, from when it is submitted until it completes.
+class AsyncTransaction : public IntrusiveList<AsyncTransaction>::Item {
+ public:
+  /// Creates a transaction which writes `tx_buffer` and then reads into
+  /// `rx_buffer`. Either buffer may be empty for a read-only or write-only
+  /// transaction.
+  AsyncTransaction(Address device_address,
+                   ConstByteSpan tx_buffer,
+                   ByteSpan rx_buffer)
+      : address_(device_address),
+        tx_buffer_(tx_buffer),
+        rx_buffer_(rx_buffer) {}
+
+  AsyncTransaction(const AsyncTransaction&) = delete;
+  AsyncTransaction& operator=(const AsyncTransaction&) = delete;
+
+  ~AsyncTransaction();
+
+  /// Returns `Pending` while the transaction is queued or in progress, and
+  /// arranges for the current task to be woken when it completes. Then
+  /// returns `Ready` with its result, after which the transaction may be
+  /// submitted again.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - Success.
+  /// * @pw_status{UNAVAILABLE} - NACK condition occurred.
+  /// * @pw_status{DEADLINE_EXCEEDED} - The bus transaction timed out.
+  /// * @pw_status{CANCELLED} - `AsyncInitiator::Cancel` was called.
+  /// * @pw_status{FAILED_PRECONDITION} - The transaction was not submitted,
+  ///   or the initiator is not enabled.
+  /// * Other errors that the backend reports.
+  async2::Poll<Status> Pend(async2::Context& cx);
+
+  /// Returns true from when the transaction is submitted until `Pend` returns
+  /// its result.
+  bool submitted() const;
+
+  Address address() const { return address_; }
+  ConstByteSpan tx_buffer() const { return tx_buffer_; }
+  ByteSpan rx_buffer() const { return rx_buffer_; }
+
+ private:
+  friend class AsyncInitiator;
+
+  enum class State : uint8_t {
+    kIdle,
+    kQueued,
+    kActive,
+    kComplete,
+  };
+
+  const Address address_;
+  const ConstByteSpan tx_buffer_;
+  const ByteSpan rx_buffer_;
+
+  // Set while the transaction is submitted. The remaining members are guarded
+  // by the initiator's lock while it is set.
+  AsyncInitiator* initiator_ = nullptr;
+  State state_ = State::kIdle;
+  Status result_;
+  async2::Waker waker_;
+};
+
+/// Driver interface for I2C buses whose transactions complete asynchronously,
+/// such as buses driven by interrupts or DMA, or blocking drivers that are run
+/// on another thread.
+///
+/// Transactions are submitted to a per-bus queue and run one at a time in the
+/// order they were submitted, so a single task can keep many transactions
+/// outstanding, e.g. to poll many sensors, without blocking a thread for the
+/// duration of each transaction.
+///
+/// @code{.cpp}
+///   std::array<std::byte, 2> reading;
+///   pw::i2c::AsyncTransaction read(kSensorAddress, kRegister, reading);
+///
+///   // From a task:
+///   PW_TRY(initiator.Submit(read));
+///   ...
+///   Poll<Status> result = read.Pend(cx);
+/// @endcode
+///
+/// Backends implement `DoStartTransaction`, which must start a transaction and
+/// return without waiting for it, and call `TransactionComplete` when it
+/// finishes. `ThreadedAsyncInitiator` implements `AsyncInitiator` for any
+/// blocking `Initiator`.
+///
+/// @note Locks are acquired in the order `AsyncInitiator` lock, then
+/// `async2::dispatcher_lock()`.
+class AsyncInitiator {
+ public:
+  AsyncInitiator(const AsyncInitiator&) = delete;
+  AsyncInitiator& operator=(const AsyncInitiator&) = delete;
+
+  virtual ~AsyncInitiator() = default;
+
+  /// Adds a transaction to the end of the queue, and starts it if the bus is
+  /// idle. Thread- and interrupt-safe.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The transaction was queued.
+  /// * @pw_status{FAILED_PRECONDITION} - The transaction is already submitted.
+  /// * @pw_status{INVALID_ARGUMENT} - Both buffers are empty.
+  Status Submit(AsyncTransaction& transaction) PW_LOCKS_EXCLUDED(lock_);
+
+  /// Cancels a submitted transaction. A queued transaction is removed from the
+  /// queue. A transaction in progress is aborted if the backend supports it,
+  /// and otherwise runs to completion. In either case, `Pend` returns its
+  /// result as usual. Thread- and interrupt-safe.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The transaction was removed from the queue or
+  ///   aborted.
+  /// * @pw_status{UNIMPLEMENTED} - The transaction is in progress and the
+  ///   backend cannot abort it. It runs to completion.
+  /// * @pw_status{FAILED_PRECONDITION} - The transaction is not submitted to
+  ///   this initiator, or has already completed.
+  Status Cancel(AsyncTransaction& transaction) PW_LOCKS_EXCLUDED(lock_);
+
+ protected:
+  constexpr AsyncInitiator() = default;
+
+  /// Completes the transaction in progress with its result and starts the
+  /// next one, if any. Backends call this once the transaction started by
+  /// `DoStartTransaction` is done. May be called from interrupt context, or
+  /// from within `DoStartTransaction`.
+  void TransactionComplete(Status status) PW_LOCKS_EXCLUDED(lock_);
+
+ private:
+  /// Starts `transaction` on the bus. Only one transaction is in progress at
+  /// a time. May be called from any context in which `Submit` or
+  /// `TransactionComplete` is called, including interrupts.
+  virtual void DoStartTransaction(const AsyncTransaction& transaction) = 0;
+
+  /// Aborts the transaction in progress, if the backend can. Called with the
+  /// lock held, so that the transaction cannot complete concurrently, which
+  /// means the backend must not call `TransactionComplete` from here.
+  ///
+  /// @returns true if the transaction was aborted, in which case it completes
+  /// with @pw_status{CANCELLED}. The default implementation returns false,
+  /// and the transaction runs to completion.
+  virtual bool DoAbortTransaction() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return false;
+  }
+
+  // Completes the active transaction and makes the next queued transaction
+  // active. Moves the completed transaction's waker into `waker`. Returns the
+  // next transaction, or null if the queue is empty.
+  AsyncTransaction* CompleteActive(Status status, async2::Waker& waker)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Makes the next queued transaction active. Returns it, or null if the
+  // queue is empty.
+  AsyncTransaction* ActivateNext() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  friend class AsyncTransaction;
+
+  sync::InterruptSpinLock lock_;
+  IntrusiveList<AsyncTransaction> queue_ PW_GUARDED_BY(lock_);
+  AsyncTransaction* active_ PW_GUARDED_BY(lock_) = nullptr;
+};
+
+}  // namespace pw::i2c
@@ -32,6 +32,26 @@ enum class RegisterAddressSize {
   k4Bytes = 4,
 };
 
+/// A block of contiguous registers to read with
+/// `pw::i2c::RegisterDevice::ReadRegisterBlocks()`.
+struct RegisterReadBlock {
+  /// The register address to begin reading at.
+  uint32_t register_address;
+
+  /// The area to read the block's data into.
+  ByteSpan data;
+};
+
+/// A block of contiguous registers to write with
+/// `pw::i2c::RegisterDevice::WriteRegisterBlocks()`.
+struct RegisterWriteBlock {
+  /// The register address to begin writing at.
+  uint32_t register_address;
+
+  /// The data to write to the block.
+  ConstByteSpan data;
+};
+
 /// The common interface for I2C register devices. Contains methods to help
 /// read and write the device's registers.
 ///
@@ -199,6 +219,76 @@ class RegisterDevice : public Device {
                          span<uint32_t> return_data,
                          chrono::SystemClock::duration timeout);
 
+  /// Reads several blocks of registers, which need not be contiguous, using
+  /// as few bus transactions as possible. This method is byte-addressable:
+  /// a block covers the registers from its `register_address` to its
+  /// `register_address` plus the size of its `data`.
+  ///
+  /// Blocks that are listed in ascending address order, and that are
+  /// separated by at most `max_gap_bytes` registers, are read in a single
+  /// write+read transaction into `buffer` and then copied into each block's
+  /// `data`. The data is read as bytes, like `ReadRegisters()`.
+  ///
+  /// @warning Any registers in the gaps between combined blocks are read. Set
+  /// `max_gap_bytes` to 0 if reading a register has side effects, such as
+  /// clearing an interrupt.
+  ///
+  /// @pre This method assumes that you've verified that your device supports
+  /// bulk reads that auto-increment the register address.
+  ///
+  /// @param[in] blocks The blocks of registers to read.
+  ///
+  /// @param[in] buffer A buffer for reading combined blocks. Its size limits
+  /// how many registers are combined into one transaction, and must be at
+  /// least as large as the largest block.
+  ///
+  /// @param[in] max_gap_bytes The largest number of unrequested registers to
+  /// read between two blocks in order to combine them.
+  ///
+  /// @param[in] timeout The maximum duration to block waiting for all of the
+  /// I2C transactions to complete.
+  ///
+  /// @returns A `pw::Status` object with one of the following statuses:
+  /// * @pw_status{OK} - All of the blocks were read.
+  /// * @pw_status{OUT_OF_RANGE} - A block is larger than `buffer`.
+  /// * Any status that `ReadRegisters()` returns, in which case later blocks
+  ///   are not read.
+  Status ReadRegisterBlocks(span<const RegisterReadBlock> blocks,
+                            ByteSpan buffer,
+                            size_t max_gap_bytes,
+                            chrono::SystemClock::duration timeout);
+
+  /// Writes several blocks of registers, which need not be contiguous, using
+  /// as few bus transactions as possible. This method is byte-addressable.
+  ///
+  /// Blocks that are listed in ascending address order with no registers
+  /// between them are written in a single transaction. The data is written as
+  /// bytes, like `WriteRegisters()`. Registers between blocks are never
+  /// written.
+  ///
+  /// @pre This method assumes that you've verified that your device supports
+  /// bulk writes that auto-increment the register address.
+  ///
+  /// @param[in] blocks The blocks of registers to write.
+  ///
+  /// @param[in] buffer A buffer for constructing the write data. Its size
+  /// limits how many registers are combined into one transaction, and must be
+  /// at least as large as the size of a register address plus the size of the
+  /// largest block.
+  ///
+  /// @param[in] timeout The maximum duration to block waiting for all of the
+  /// I2C transactions to complete.
+  ///
+  /// @returns A `pw::Status` object with one of the following statuses:
+  /// * @pw_status{OK} - All of the blocks were written.
+  /// * @pw_status{OUT_OF_RANGE} - A block does not fit in `buffer` with its
+  ///   register address.
+  /// * Any status that `WriteRegisters()` returns, in which case later blocks
+  ///   are not written.
+  Status WriteRegisterBlocks(span<const RegisterWriteBlock> blocks,
+                             ByteSpan buffer,
+                             chrono::SystemClock::duration timeout);
+
   /// Sends a register address to write to and then writes to that address.
   ///
   /// `register_address` and `register_data` use the endianness that was
@@ -0,0 +1,66 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_chrono/system_clock.h"
+#include "pw_i2c/async_initiator.h"
+#include "pw_i2c/initiator.h"
+#include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread_core.h"
+
+namespace pw::i2c {
+
+/// Implements `AsyncInitiator` with a blocking `Initiator`, by running each
+/// transaction on a dedicated thread. This lets tasks queue transactions on
+/// buses whose drivers only provide blocking calls, such as Linux `i2c-dev`.
+///
+/// `ThreadedAsyncInitiator` is a `pw::thread::ThreadCore` that must be run on
+/// its own thread, e.g. `pw::thread::Thread(options, async_initiator)`.
+/// Transactions are only started once it runs. `RequestStop()` makes the
+/// thread return after the transaction in progress, if any. It must be stopped
+/// before it is destroyed.
+class ThreadedAsyncInitiator : public AsyncInitiator,
+                               public thread::ThreadCore {
+ public:
+  /// @param[in] initiator The blocking initiator that runs transactions. Only
+  /// its reference is stored on construction.
+  ///
+  /// @param[in] timeout The timeout for each transaction's
+  /// `Initiator::WriteReadFor` call.
+  ThreadedAsyncInitiator(Initiator& initiator,
+                         chrono::SystemClock::duration timeout)
+      : initiator_(initiator), timeout_(timeout) {}
+
+  /// Makes `Run()` return once the transaction in progress, if any, finishes.
+  /// Transactions that are still queued are not run.
+  void RequestStop() PW_LOCKS_EXCLUDED(worker_lock_);
+
+ private:
+  void Run() override PW_LOCKS_EXCLUDED(worker_lock_);
+
+  void DoStartTransaction(const AsyncTransaction& transaction) override
+      PW_LOCKS_EXCLUDED(worker_lock_);
+
+  Initiator& initiator_;
+  const chrono::SystemClock::duration timeout_;
+
+  sync::ThreadNotification work_available_;
+  sync::InterruptSpinLock worker_lock_;
+  const AsyncTransaction* to_run_ PW_GUARDED_BY(worker_lock_) = nullptr;
+  bool stop_requested_ PW_GUARDED_BY(worker_lock_) = false;
+};
+
+}  // namespace pw::i2c
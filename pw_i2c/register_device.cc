@@ -14,6 +14,8 @@
 
 #include "pw_i2c/register_device.h"
 
+#include <algorithm>
+
 #include "pw_assert/check.h"
 #include "pw_bytes/byte_builder.h"
 
@@ -82,6 +84,12 @@ Status PutRegisterData32InByteBuilder(ByteBuilder& byte_builder,
   }
 }
 
+// Returns the time left until `deadline`, which may be zero or negative.
+chrono::SystemClock::duration TimeRemaining(
+    chrono::SystemClock::time_point deadline) {
+  return deadline - chrono::SystemClock::now();
+}
+
 }  // namespace
 
 Status RegisterDevice::WriteRegisters(const uint32_t register_address,
@@ -148,5 +156,106 @@ Status RegisterDevice::ReadRegisters(uint32_t register_address,
                       timeout);
 }
 
+Status RegisterDevice::ReadRegisterBlocks(
+    span<const RegisterReadBlock> blocks,
+    ByteSpan buffer,
+    size_t max_gap_bytes,
+    chrono::SystemClock::duration timeout) {
+  const chrono::SystemClock::time_point deadline =
+      chrono::SystemClock::TimePointAfterAtLeast(timeout);
+
+  size_t first = 0;
+  while (first < blocks.size()) {
+    if (blocks[first].data.empty()) {
+      ++first;
+      continue;
+    }
+    if (blocks[first].data.size() > buffer.size()) {
+      return Status::OutOfRange();
+    }
+
+    // Combine the following blocks that are close enough to this one, and
+    // that fit in the buffer along with it.
+    const uint32_t start = blocks[first].register_address;
+    size_t end = start + blocks[first].data.size();
+    size_t last = first + 1;
+    for (; last < blocks.size(); ++last) {
+      const RegisterReadBlock& block = blocks[last];
+      if (block.data.empty()) {
+        continue;
+      }
+      if (block.register_address < end ||
+          block.register_address - end > max_gap_bytes ||
+          block.register_address + block.data.size() - start > buffer.size()) {
+        break;
+      }
+      end = block.register_address + block.data.size();
+    }
+
+    PW_TRY(ReadRegisters(
+        start, buffer.first(end - start), TimeRemaining(deadline)));
+
+    for (; first < last; ++first) {
+      const RegisterReadBlock& block = blocks[first];
+      if (block.data.empty()) {
+        continue;
+      }
+      const ConstByteSpan read =
+          buffer.subspan(block.register_address - start, block.data.size());
+      std::copy(read.begin(), read.end(), block.data.begin());
+    }
+  }
+  return OkStatus();
+}
+
+Status RegisterDevice::WriteRegisterBlocks(
+    span<const RegisterWriteBlock> blocks,
+    ByteSpan buffer,
+    chrono::SystemClock::duration timeout) {
+  const chrono::SystemClock::time_point deadline =
+      chrono::SystemClock::TimePointAfterAtLeast(timeout);
+  const size_t address_size = static_cast<size_t>(register_address_size_);
+
+  size_t first = 0;
+  while (first < blocks.size()) {
+    if (blocks[first].data.empty()) {
+      ++first;
+      continue;
+    }
+    if (address_size + blocks[first].data.size() > buffer.size()) {
+      return Status::OutOfRange();
+    }
+
+    ByteBuilder builder(buffer);
+    PutRegisterAddressInByteBuilder(builder,
+                                    blocks[first].register_address,
+                                    register_address_order_,
+                                    register_address_size_);
+
+    // Append the following blocks that start exactly where the previous one
+    // ends, as long as they fit in the buffer.
+    size_t end = blocks[first].register_address;
+    for (; first < blocks.size(); ++first) {
+      const RegisterWriteBlock& block = blocks[first];
+      if (block.data.empty()) {
+        continue;
+      }
+      if (block.register_address != end ||
+          block.data.size() > builder.max_size() - builder.size()) {
+        break;
+      }
+      builder.append(block.data);
+      end += block.data.size();
+    }
+
+    if (!builder.ok()) {
+      return Status::Internal();
+    }
+    PW_TRY(WriteFor(ConstByteSpan(builder.data(), builder.size()),
+                    TimeRemaining(deadline)));
+  }
+  return OkStatus();
+}
+
 }  // namespace i2c
 }  // namespace pw
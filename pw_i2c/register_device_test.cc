@@ -14,7 +14,10 @@
 #include "pw_i2c/register_device.h"
 
 #include "pw_assert/check.h"
+#include "pw_bytes/array.h"
 #include "pw_bytes/byte_builder.h"
+#include "pw_containers/algorithm.h"
+#include "pw_i2c/initiator_mock.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw {
@@ -800,6 +803,207 @@ TEST(RegisterDevice, WriteRegister16with2ByteBigEndianAddress) {
   }
 }
 
+TEST(RegisterDevice, ReadRegisterBlocksCombinesNearbyBlocks) {
+  constexpr auto kAddress1 = bytes::Array<0x10>();
+  constexpr auto kRead1 = bytes::Array<0xA1, 0xA2, 0xFF, 0xA3>();
+  constexpr auto kAddress2 = bytes::Array<0x20>();
+  constexpr auto kRead2 = bytes::Array<0xB1, 0xB2>();
+  auto expected_transactions = MakeExpectedTransactionArray({
+      Transaction(OkStatus(), kTestDeviceAddress, kAddress1, kRead1),
+      Transaction(OkStatus(), kTestDeviceAddress, kAddress2, kRead2),
+  });
+  MockInitiator initiator(expected_transactions);
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::little,
+                        RegisterAddressSize::k1Byte);
+
+  std::array<std::byte, 2> first;
+  std::array<std::byte, 1> second;
+  std::array<std::byte, 2> third;
+  const std::array<RegisterReadBlock, 3> blocks = {{
+      {0x10, first},
+      {0x13, second},
+      {0x20, third},
+  }};
+  std::array<std::byte, 8> buffer;
+  EXPECT_EQ(device.ReadRegisterBlocks(blocks, buffer, 1, kTimeout),
+            OkStatus());
+
+  EXPECT_TRUE(containers::Equal(first, bytes::Array<0xA1, 0xA2>()));
+  EXPECT_TRUE(containers::Equal(second, bytes::Array<0xA3>()));
+  EXPECT_TRUE(containers::Equal(third, kRead2));
+  EXPECT_EQ(initiator.Finalize(), OkStatus());
+}
+
+TEST(RegisterDevice, ReadRegisterBlocksLimitedByBuffer) {
+  constexpr auto kAddress1 = bytes::Array<0x00, 0x10>();
+  constexpr auto kRead1 = bytes::Array<0xA1, 0xA2, 0xA3, 0xA4>();
+  constexpr auto kAddress2 = bytes::Array<0x00, 0x14>();
+  constexpr auto kRead2 = bytes::Array<0xB1, 0xB2>();
+  auto expected_transactions = MakeExpectedTransactionArray({
+      Transaction(OkStatus(), kTestDeviceAddress, kAddress1, kRead1),
+      Transaction(OkStatus(), kTestDeviceAddress, kAddress2, kRead2),
+  });
+  MockInitiator initiator(expected_transactions);
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::big,
+                        RegisterAddressSize::k2Bytes);
+
+  std::array<std::byte, 2> first;
+  std::array<std::byte, 2> second;
+  std::array<std::byte, 2> third;
+  const std::array<RegisterReadBlock, 3> blocks = {{
+      {0x10, first},
+      {0x12, second},
+      {0x14, third},
+  }};
+  std::array<std::byte, 4> buffer;
+  EXPECT_EQ(device.ReadRegisterBlocks(blocks, buffer, 0, kTimeout),
+            OkStatus());
+
+  EXPECT_TRUE(containers::Equal(first, bytes::Array<0xA1, 0xA2>()));
+  EXPECT_TRUE(containers::Equal(second, bytes::Array<0xA3, 0xA4>()));
+  EXPECT_TRUE(containers::Equal(third, kRead2));
+  EXPECT_EQ(initiator.Finalize(), OkStatus());
+}
+
+TEST(RegisterDevice, ReadRegisterBlocksDoesNotCombineGapsOrUnorderedBlocks) {
+  constexpr auto kAddress1 = bytes::Array<0x10>();
+  constexpr auto kRead1 = bytes::Array<0xA1>();
+  constexpr auto kAddress2 = bytes::Array<0x12>();
+  constexpr auto kRead2 = bytes::Array<0xB1>();
+  constexpr auto kAddress3 = bytes::Array<0x11>();
+  constexpr auto kRead3 = bytes::Array<0xC1>();
+  auto expected_transactions = MakeExpectedTransactionArray({
+      Transaction(OkStatus(), kTestDeviceAddress, kAddress1, kRead1),
+      Transaction(OkStatus(), kTestDeviceAddress, kAddress2, kRead2),
+      Transaction(OkStatus(), kTestDeviceAddress, kAddress3, kRead3),
+  });
+  MockInitiator initiator(expected_transactions);
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::little,
+                        RegisterAddressSize::k1Byte);
+
+  std::array<std::byte, 1> first;
+  std::array<std::byte, 1> second;
+  std::array<std::byte, 1> third;
+  const std::array<RegisterReadBlock, 3> blocks = {{
+      {0x10, first},
+      {0x12, second},
+      {0x11, third},
+  }};
+  std::array<std::byte, 8> buffer;
+  EXPECT_EQ(device.ReadRegisterBlocks(blocks, buffer, 0, kTimeout),
+            OkStatus());
+  EXPECT_EQ(initiator.Finalize(), OkStatus());
+}
+
+TEST(RegisterDevice, ReadRegisterBlocksStopsOnError) {
+  constexpr auto kAddress1 = bytes::Array<0x10>();
+  constexpr auto kRead1 = bytes::Array<0xA1>();
+  auto expected_transactions = MakeExpectedTransactionArray({
+      Transaction(
+          Status::Unavailable(), kTestDeviceAddress, kAddress1, kRead1),
+  });
+  MockInitiator initiator(expected_transactions);
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::little,
+                        RegisterAddressSize::k1Byte);
+
+  std::array<std::byte, 1> first;
+  std::array<std::byte, 1> second;
+  const std::array<RegisterReadBlock, 2> blocks = {{
+      {0x10, first},
+      {0x20, second},
+  }};
+  std::array<std::byte, 8> buffer;
+  EXPECT_EQ(device.ReadRegisterBlocks(blocks, buffer, 0, kTimeout),
+            Status::Unavailable());
+  EXPECT_EQ(initiator.Finalize(), OkStatus());
+}
+
+TEST(RegisterDevice, ReadRegisterBlocksBlockLargerThanBuffer) {
+  MockInitiator initiator(span<Transaction>{});
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::little,
+                        RegisterAddressSize::k1Byte);
+
+  std::array<std::byte, 4> data;
+  const std::array<RegisterReadBlock, 1> blocks = {{{0x10, data}}};
+  std::array<std::byte, 2> buffer;
+  EXPECT_EQ(device.ReadRegisterBlocks(blocks, buffer, 0, kTimeout),
+            Status::OutOfRange());
+}
+
+TEST(RegisterDevice, WriteRegisterBlocksCombinesAdjacentBlocks) {
+  constexpr auto kWrite1 = bytes::Array<0x10, 0xA1, 0xA2, 0xB1>();
+  constexpr auto kWrite2 = bytes::Array<0x14, 0xC1>();
+  auto expected_transactions = MakeExpectedTransactionArray({
+      WriteTransaction(OkStatus(), kTestDeviceAddress, kWrite1),
+      WriteTransaction(OkStatus(), kTestDeviceAddress, kWrite2),
+  });
+  MockInitiator initiator(expected_transactions);
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::little,
+                        RegisterAddressSize::k1Byte);
+
+  constexpr auto kFirst = bytes::Array<0xA1, 0xA2>();
+  constexpr auto kSecond = bytes::Array<0xB1>();
+  constexpr auto kThird = bytes::Array<0xC1>();
+  const std::array<RegisterWriteBlock, 3> blocks = {{
+      {0x10, kFirst},
+      {0x12, kSecond},
+      {0x14, kThird},
+  }};
+  std::array<std::byte, 8> buffer;
+  EXPECT_EQ(device.WriteRegisterBlocks(blocks, buffer, kTimeout), OkStatus());
+  EXPECT_EQ(initiator.Finalize(), OkStatus());
+}
+
+TEST(RegisterDevice, WriteRegisterBlocksLimitedByBuffer) {
+  constexpr auto kWrite1 = bytes::Array<0x10, 0xA1, 0xA2>();
+  constexpr auto kWrite2 = bytes::Array<0x12, 0xB1, 0xB2>();
+  auto expected_transactions = MakeExpectedTransactionArray({
+      WriteTransaction(OkStatus(), kTestDeviceAddress, kWrite1),
+      WriteTransaction(OkStatus(), kTestDeviceAddress, kWrite2),
+  });
+  MockInitiator initiator(expected_transactions);
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::little,
+                        RegisterAddressSize::k1Byte);
+
+  constexpr auto kFirst = bytes::Array<0xA1, 0xA2>();
+  constexpr auto kSecond = bytes::Array<0xB1, 0xB2>();
+  const std::array<RegisterWriteBlock, 2> blocks = {{
+      {0x10, kFirst},
+      {0x12, kSecond},
+  }};
+  std::array<std::byte, 4> buffer;
+  EXPECT_EQ(device.WriteRegisterBlocks(blocks, buffer, kTimeout), OkStatus());
+  EXPECT_EQ(initiator.Finalize(), OkStatus());
+}
+
+TEST(RegisterDevice, WriteRegisterBlocksBufferTooSmall) {
+  MockInitiator initiator(span<Transaction>{});
+  RegisterDevice device(initiator,
+                        kTestDeviceAddress,
+                        endian::little,
+                        RegisterAddressSize::k2Bytes);
+
+  constexpr auto kData = bytes::Array<0xA1, 0xA2>();
+  const std::array<RegisterWriteBlock, 1> blocks = {{{0x10, kData}}};
+  std::array<std::byte, 3> buffer;
+  EXPECT_EQ(device.WriteRegisterBlocks(blocks, buffer, kTimeout),
+            Status::OutOfRange());
+}
+
 }  // namespace
 }  // namespace i2c
 }  // namespace pw
@@ -0,0 +1,62 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_i2c/threaded_async_initiator.h"
+
+#include <mutex>
+#include <utility>
+
+namespace pw::i2c {
+
+void ThreadedAsyncInitiator::RequestStop() {
+  {
+    std::lock_guard lock(worker_lock_);
+    stop_requested_ = true;
+  }
+  work_available_.release();
+}
+
+void ThreadedAsyncInitiator::DoStartTransaction(
+    const AsyncTransaction& transaction) {
+  {
+    std::lock_guard lock(worker_lock_);
+    to_run_ = &transaction;
+  }
+  work_available_.release();
+}
+
+void ThreadedAsyncInitiator::Run() {
+  while (true) {
+    work_available_.acquire();
+    const AsyncTransaction* transaction;
+    {
+      std::lock_guard lock(worker_lock_);
+      if (stop_requested_) {
+        return;
+      }
+      transaction = std::exchange(to_run_, nullptr);
+    }
+    if (transaction == nullptr) {
+      continue;
+    }
+    // Completing the transaction may start the next one, which releases
+    // work_available_ again.
+    TransactionComplete(initiator_.WriteReadFor(transaction->address(),
+                                                transaction->tx_buffer(),
+                                                transaction->rx_buffer(),
+                                                timeout_));
+  }
+}
+
+}  // namespace pw::i2c
@@ -0,0 +1,130 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_i2c/threaded_async_initiator.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_bytes/array.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_containers/algorithm.h"
+#include "pw_i2c/address.h"
+#include "pw_i2c/initiator_mock.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace pw::i2c {
+namespace {
+
+using async2::Context;
+using async2::Pending;
+using async2::Poll;
+using async2::Ready;
+
+constexpr auto kTimeout = chrono::SystemClock::for_at_least(100ms);
+constexpr Address kAddress1 = Address::SevenBit<0x01>();
+constexpr Address kAddress2 = Address::SevenBit<0x02>();
+
+// Submits a sequence of transactions at once, and waits for all of them.
+class RunTransactionsTask : public async2::Task {
+ public:
+  RunTransactionsTask(AsyncInitiator& initiator,
+                      span<AsyncTransaction*> transactions,
+                      span<Status> results)
+      : initiator_(initiator),
+        transactions_(transactions),
+        results_(results) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (!submitted_) {
+      for (AsyncTransaction* transaction : transactions_) {
+        EXPECT_EQ(initiator_.Submit(*transaction), OkStatus());
+      }
+      submitted_ = true;
+    }
+    for (; completed_ < transactions_.size(); ++completed_) {
+      Poll<Status> result = transactions_[completed_]->Pend(cx);
+      if (result.IsPending()) {
+        return Pending();
+      }
+      results_[completed_] = *result;
+    }
+    return Ready();
+  }
+
+  AsyncInitiator& initiator_;
+  span<AsyncTransaction*> transactions_;
+  span<Status> results_;
+  bool submitted_ = false;
+  size_t completed_ = 0;
+};
+
+TEST(ThreadedAsyncInitiator, RunsQueuedTransactionsOnThread) {
+  constexpr auto kWrite = bytes::Array<1, 2, 3>();
+  constexpr auto kExpectRead = bytes::Array<4, 5>();
+  auto expected = MakeExpectedTransactionArray({
+      WriteTransaction(OkStatus(), kAddress1, kWrite, kTimeout),
+      Transaction(OkStatus(), kAddress2, kWrite, kExpectRead, kTimeout),
+      ReadTransaction(Status::Unavailable(), kAddress1, kExpectRead, kTimeout),
+  });
+  MockInitiator mock(expected);
+  ThreadedAsyncInitiator initiator(mock, kTimeout);
+
+  thread::test::TestThreadContext context;
+  thread::Thread thread(context.options(), initiator);
+
+  std::array<std::byte, kExpectRead.size()> read_1;
+  std::array<std::byte, kExpectRead.size()> read_2;
+  AsyncTransaction write(kAddress1, kWrite, ByteSpan());
+  AsyncTransaction write_read(kAddress2, kWrite, read_1);
+  AsyncTransaction read(kAddress1, ConstByteSpan(), read_2);
+  std::array<AsyncTransaction*, 3> transactions = {
+      &write, &write_read, &read};
+  std::array<Status, 3> results;
+
+  async2::Dispatcher dispatcher;
+  RunTransactionsTask task(initiator, transactions, results);
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion(task);
+
+  initiator.RequestStop();
+  thread.join();
+
+  EXPECT_EQ(results[0], OkStatus());
+  EXPECT_EQ(results[1], OkStatus());
+  EXPECT_TRUE(containers::Equal(read_1, kExpectRead));
+  EXPECT_EQ(results[2], Status::Unavailable());
+  EXPECT_EQ(mock.Finalize(), OkStatus());
+}
+
+TEST(ThreadedAsyncInitiator, StopsWithoutTransactions) {
+  std::array<Transaction, 0> expected;
+  MockInitiator mock(expected);
+  ThreadedAsyncInitiator initiator(mock, kTimeout);
+
+  thread::test::TestThreadContext context;
+  thread::Thread thread(context.options(), initiator);
+  initiator.RequestStop();
+  thread.join();
+}
+
+}  // namespace
+}  // namespace pw::i2c
@@ -0,0 +1,48 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_chrono/system_clock.h"
+#include "pw_i2c/threaded_async_initiator.h"
+#include "pw_i2c_linux/initiator.h"
+
+namespace pw::i2c {
+
+/// `AsyncInitiator` implementation using the Linux userspace i2c-dev driver.
+///
+/// `i2c-dev` transfers are blocking `ioctl` calls, so they are offloaded to a
+/// thread: like `ThreadedAsyncInitiator`, this must be run on its own thread,
+/// e.g. `pw::thread::Thread(options, async_initiator)`, and stopped with
+/// `RequestStop()` before it is destroyed.
+///
+/// Takes exclusive control of an I2C bus device, as `LinuxInitiator` does. Use
+/// `LinuxInitiator::OpenI2cBus` to open and validate the bus.
+class LinuxAsyncInitiator final : public ThreadedAsyncInitiator {
+ public:
+  /// @param[in] fd Valid file descriptor for an I2C device node. The file
+  /// descriptor is closed during destruction.
+  ///
+  /// @param[in] timeout The timeout for each transaction. See
+  /// `LinuxInitiator` for how it is applied.
+  LinuxAsyncInitiator(int fd, chrono::SystemClock::duration timeout)
+      // The base only stores the reference to `initiator_`, which is not used
+      // until the thread runs, so it may refer to the member before it is
+      // constructed.
+      : ThreadedAsyncInitiator(initiator_, timeout), initiator_(fd) {}
+
+ private:
+  LinuxInitiator initiator_;
+};
+
+}  // namespace pw::i2c
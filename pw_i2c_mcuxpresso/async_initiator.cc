@@ -0,0 +1,128 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_i2c_mcuxpresso/async_initiator.h"
+
+#include "fsl_i2c.h"
+#include "hal_status.h"
+#include "pw_status/status.h"
+
+namespace pw::i2c {
+
+using internal::HalStatusToPwStatus;
+
+// inclusive-language: disable
+void McuxpressoAsyncInitiator::Enable() {
+  i2c_master_config_t master_config;
+  I2C_MasterGetDefaultConfig(&master_config);
+  master_config.baudRate_Bps = config_.baud_rate_bps;
+  I2C_MasterInit(base_, &master_config, CLOCK_GetFreq(config_.clock_name));
+
+  // Create the handle for the non-blocking transfer and register callback.
+  I2C_MasterTransferCreateHandle(
+      base_, &handle_, TransferCompleteCallback, this);
+
+  enabled_ = true;
+}
+
+void McuxpressoAsyncInitiator::Disable() {
+  I2C_MasterDeinit(base_);
+  enabled_ = false;
+}
+
+McuxpressoAsyncInitiator::~McuxpressoAsyncInitiator() { Disable(); }
+
+void McuxpressoAsyncInitiator::TransferCompleteCallback(I2C_Type*,
+                                                        i2c_master_handle_t*,
+                                                        status_t status,
+                                                        void* initiator_ptr) {
+  McuxpressoAsyncInitiator& initiator =
+      *static_cast<McuxpressoAsyncInitiator*>(initiator_ptr);
+  const AsyncTransaction* read = initiator.pending_read_;
+  initiator.pending_read_ = nullptr;
+  if (status != kStatus_Success || read == nullptr) {
+    initiator.TransactionComplete(HalStatusToPwStatus(status));
+    return;
+  }
+
+  // The write of a write+read transaction completed, so start the read.
+  const ByteSpan rx_buffer = read->rx_buffer();
+  i2c_master_transfer_t transfer{kI2C_TransferRepeatedStartFlag,
+                                 read->address().GetSevenBit(),
+                                 kI2C_Read,
+                                 0,
+                                 0,
+                                 rx_buffer.data(),
+                                 rx_buffer.size()};
+  initiator.StartTransfer(transfer);
+}
+
+void McuxpressoAsyncInitiator::StartTransfer(i2c_master_transfer_t& transfer) {
+  const status_t status =
+      I2C_MasterTransferNonBlocking(base_, &handle_, &transfer);
+  if (status != kStatus_Success) {
+    pending_read_ = nullptr;
+    TransactionComplete(HalStatusToPwStatus(status));
+  }
+}
+
+// Starts a non-blocking I2C write, read or write+read depending on the tx and
+// rx buffer states. The read of a write+read is started from the callback.
+void McuxpressoAsyncInitiator::DoStartTransaction(
+    const AsyncTransaction& transaction) {
+  if (!enabled_) {
+    TransactionComplete(Status::FailedPrecondition());
+    return;
+  }
+
+  const uint8_t address = transaction.address().GetSevenBit();
+  const ConstByteSpan tx_buffer = transaction.tx_buffer();
+  const ByteSpan rx_buffer = transaction.rx_buffer();
+
+  if (tx_buffer.empty()) {
+    i2c_master_transfer_t transfer{kI2C_TransferDefaultFlag,
+                                   address,
+                                   kI2C_Read,
+                                   0,
+                                   0,
+                                   rx_buffer.data(),
+                                   rx_buffer.size()};
+    StartTransfer(transfer);
+    return;
+  }
+
+  if (!rx_buffer.empty()) {
+    pending_read_ = &transaction;
+  }
+  i2c_master_transfer_t transfer{
+      rx_buffer.empty() ? kI2C_TransferDefaultFlag : kI2C_TransferNoStopFlag,
+      address,
+      kI2C_Write,
+      0,
+      0,
+      const_cast<std::byte*>(tx_buffer.data()),
+      tx_buffer.size()};
+  StartTransfer(transfer);
+}
+
+bool McuxpressoAsyncInitiator::DoAbortTransaction() {
+  // This is called with the AsyncInitiator lock held, which masks interrupts,
+  // so the transfer callback cannot run concurrently. Aborting does not invoke
+  // the callback.
+  I2C_MasterTransferAbort(base_, &handle_);
+  pending_read_ = nullptr;
+  return true;
+}
+// inclusive-language: enable
+
+}  // namespace pw::i2c
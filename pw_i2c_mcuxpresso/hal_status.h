@@ -0,0 +1,38 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "fsl_i2c.h"
+#include "pw_status/status.h"
+
+namespace pw::i2c::internal {
+
+// Converts an MCUXpresso SDK I2C driver status to a pw::Status.
+inline Status HalStatusToPwStatus(status_t status) {
+  switch (status) {
+    case kStatus_Success:
+      return OkStatus();
+    case kStatus_I2C_Nak:
+    case kStatus_I2C_Addr_Nak:
+      return Status::Unavailable();
+    case kStatus_I2C_InvalidParameter:
+      return Status::InvalidArgument();
+    case kStatus_I2C_Timeout:
+      return Status::DeadlineExceeded();
+    default:
+      return Status::Unknown();
+  }
+}
+
+}  // namespace pw::i2c::internal
@@ -16,29 +16,14 @@
 #include <mutex>
 
 #include "fsl_i2c.h"
+#include "hal_status.h"
 #include "pw_chrono/system_clock.h"
 #include "pw_status/status.h"
 #include "pw_status/try.h"
 
 namespace pw::i2c {
-namespace {
-
-Status HalStatusToPwStatus(status_t status) {
-  switch (status) {
-    case kStatus_Success:
-      return OkStatus();
-    case kStatus_I2C_Nak:
-    case kStatus_I2C_Addr_Nak:
-      return Status::Unavailable();
-    case kStatus_I2C_InvalidParameter:
-      return Status::InvalidArgument();
-    case kStatus_I2C_Timeout:
-      return Status::DeadlineExceeded();
-    default:
-      return Status::Unknown();
-  }
-}
-}  // namespace
+
+using internal::HalStatusToPwStatus;
 
 // inclusive-language: disable
 void McuxpressoInitiator::Enable() {
@@ -0,0 +1,76 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "fsl_i2c.h"
+#include "pw_i2c/async_initiator.h"
+#include "pw_i2c_mcuxpresso/initiator.h"
+
+namespace pw::i2c {
+
+/// `AsyncInitiator` implementation based on the interrupt-driven I2C driver in
+/// the NXP MCUXpresso SDK. Transactions are started from the caller's context
+/// and completed from the I2C interrupt, so no thread waits on the bus.
+/// Currently supports only devices with 7 bit addresses.
+///
+/// Transactions have no timeout; use `AsyncInitiator::Cancel` to abort a
+/// transaction that does not complete.
+class McuxpressoAsyncInitiator final : public AsyncInitiator {
+ public:
+  using Config = McuxpressoInitiator::Config;
+
+  McuxpressoAsyncInitiator(const Config& config)
+      : config_(config),
+        base_(reinterpret_cast<I2C_Type*>(config_.flexcomm_address)) {}
+
+  /// Should be called before submitting any transactions. Transactions that
+  /// start while the initiator is disabled fail with
+  /// @pw_status{FAILED_PRECONDITION}.
+  void Enable();
+
+  /// Must not be called while a transaction is in progress.
+  void Disable();
+
+  ~McuxpressoAsyncInitiator() final;
+
+ private:
+  void DoStartTransaction(const AsyncTransaction& transaction) override;
+  bool DoAbortTransaction() override;
+
+  // inclusive-language: disable
+  // Starts a transfer, or completes the transaction if it cannot be started.
+  void StartTransfer(i2c_master_transfer_t& transfer);
+
+  // Non-blocking I2C transfer callback, called from the I2C interrupt.
+  static void TransferCompleteCallback(I2C_Type* base,
+                                       i2c_master_handle_t* handle,
+                                       status_t status,
+                                       void* initiator_ptr);
+  // inclusive-language: enable
+
+  Config const config_;
+  I2C_Type* const base_;
+  bool enabled_ = false;
+
+  // The read of a write+read transaction, started once the write completes.
+  // Only accessed while a transaction is in progress, which the
+  // `AsyncInitiator` serializes.
+  const AsyncTransaction* pending_read_ = nullptr;
+
+  // inclusive-language: disable
+  i2c_master_handle_t handle_;
+  // inclusive-language: enable
+};
+
+}  // namespace pw::i2c
@@ -0,0 +1,147 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_intrusive_ptr/pool.h"
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "pw_intrusive_ptr/intrusive_ptr.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+class TestItem : public Pooled<TestItem> {
+ public:
+  explicit TestItem(int32_t v) : value(v) { ++instance_counter; }
+
+  ~TestItem() { --instance_counter; }
+
+  inline static int32_t instance_counter = 0;
+
+  int32_t value;
+};
+
+class NonAtomicTestItem
+    : public Pooled<NonAtomicTestItem, NonAtomicRefCounted<NonAtomicTestItem>> {
+ public:
+  explicit NonAtomicTestItem(int32_t v) : value(v) {}
+
+  int32_t value;
+};
+
+class IntrusivePtrPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override { TestItem::instance_counter = 0; }
+};
+
+TEST_F(IntrusivePtrPoolTest, MakeConstructsObject) {
+  IntrusivePtrPoolWithBuffer<TestItem, 2> pool;
+  EXPECT_EQ(pool.capacity(), 2u);
+  EXPECT_EQ(pool.available(), 2u);
+
+  IntrusivePtr<TestItem> ptr = pool.Make(42);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(ptr->value, 42);
+  EXPECT_EQ(ptr.use_count(), 1);
+  EXPECT_EQ(TestItem::instance_counter, 1);
+  EXPECT_EQ(pool.available(), 1u);
+}
+
+TEST_F(IntrusivePtrPoolTest, LastReleaseReturnsObjectToPool) {
+  IntrusivePtrPoolWithBuffer<TestItem, 1> pool;
+  {
+    IntrusivePtr<TestItem> ptr = pool.Make(1);
+    IntrusivePtr<TestItem> copy = ptr;
+    EXPECT_EQ(ptr.use_count(), 2);
+
+    ptr = nullptr;
+    EXPECT_EQ(TestItem::instance_counter, 1);
+    EXPECT_EQ(pool.available(), 0u);
+  }
+  EXPECT_EQ(TestItem::instance_counter, 0);
+  EXPECT_EQ(pool.available(), 1u);
+}
+
+TEST_F(IntrusivePtrPoolTest, MakeFailsWhenExhausted) {
+  IntrusivePtrPoolWithBuffer<TestItem, 2> pool;
+  IntrusivePtr<TestItem> first = pool.Make(1);
+  IntrusivePtr<TestItem> second = pool.Make(2);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(first, second);
+
+  EXPECT_EQ(pool.Make(3), nullptr);
+  EXPECT_EQ(pool.available(), 0u);
+  EXPECT_EQ(TestItem::instance_counter, 2);
+}
+
+TEST_F(IntrusivePtrPoolTest, ReusesReleasedStorage) {
+  IntrusivePtrPoolWithBuffer<TestItem, 2> pool;
+  IntrusivePtr<TestItem> first = pool.Make(1);
+  IntrusivePtr<TestItem> second = pool.Make(2);
+  TestItem* const second_address = second.get();
+
+  second = nullptr;
+  IntrusivePtr<TestItem> third = pool.Make(3);
+  ASSERT_NE(third, nullptr);
+  EXPECT_EQ(third.get(), second_address);
+  EXPECT_EQ(third->value, 3);
+  EXPECT_EQ(first->value, 1);
+}
+
+TEST_F(IntrusivePtrPoolTest, ConstPointerReturnsObjectToPool) {
+  IntrusivePtrPoolWithBuffer<TestItem, 1> pool;
+  {
+    IntrusivePtr<const TestItem> ptr = pool.Make(1);
+    EXPECT_EQ(pool.available(), 0u);
+  }
+  EXPECT_EQ(pool.available(), 1u);
+}
+
+TEST_F(IntrusivePtrPoolTest, NonAtomicRefCounting) {
+  IntrusivePtrPoolWithBuffer<NonAtomicTestItem, 1> pool;
+  {
+    NonAtomicTestItem::Ptr ptr = pool.Make(5);
+    NonAtomicTestItem::Ptr copy = ptr;
+    EXPECT_EQ(ptr.use_count(), 2);
+    EXPECT_EQ(copy->value, 5);
+    EXPECT_EQ(pool.Make(6), nullptr);
+  }
+  EXPECT_EQ(pool.available(), 1u);
+  EXPECT_NE(pool.Make(7), nullptr);
+}
+
+class NonAtomicHeapItem : public NonAtomicRefCounted<NonAtomicHeapItem> {
+ public:
+  NonAtomicHeapItem() { ++instance_counter; }
+  ~NonAtomicHeapItem() { --instance_counter; }
+
+  inline static int32_t instance_counter = 0;
+};
+
+TEST(NonAtomicRefCounted, DeletesObjectOnLastRelease) {
+  {
+    auto ptr = MakeRefCounted<NonAtomicHeapItem>();
+    auto copy = ptr;
+    EXPECT_EQ(ptr.use_count(), 2);
+    EXPECT_EQ(NonAtomicHeapItem::instance_counter, 1);
+  }
+  EXPECT_EQ(NonAtomicHeapItem::instance_counter, 0);
+}
+
+}  // namespace
+}  // namespace pw
@@ -47,4 +47,31 @@ class RefCountedBase {
   mutable std::atomic_int32_t ref_count_{0};
 };
 
+// Base class for NonAtomicRefCounted. Same as RefCountedBase, but the ref
+// count is a plain integer, so it must only be used from one thread at a time.
+class NonAtomicRefCountedBase {
+ public:
+  NonAtomicRefCountedBase(const NonAtomicRefCountedBase&) = delete;
+  NonAtomicRefCountedBase(NonAtomicRefCountedBase&&) = delete;
+  NonAtomicRefCountedBase& operator=(const NonAtomicRefCountedBase&) = delete;
+  NonAtomicRefCountedBase& operator=(NonAtomicRefCountedBase&&) = delete;
+
+ protected:
+  constexpr NonAtomicRefCountedBase() = default;
+  ~NonAtomicRefCountedBase();
+
+  // Increments reference counter.
+  void AddRef() const;
+
+  // Decrements reference count and returns true if the object should be
+  // deleted.
+  [[nodiscard]] bool ReleaseRef() const;
+
+  // Returns current ref count value.
+  [[nodiscard]] int32_t ref_count() const { return ref_count_; }
+
+ private:
+  mutable int32_t ref_count_ = 0;
+};
+
 }  // namespace pw::internal
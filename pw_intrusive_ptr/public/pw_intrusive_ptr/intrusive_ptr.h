@@ -36,7 +36,8 @@ namespace pw {
 //
 // IntrusivePtr by itself doesn't provide any thread-safety guarantees but if T
 // is a subclass from `RefCounted` - it is guaranteed to have atomic reference
-// counter operations.
+// counter operations. Subclasses of `NonAtomicRefCounted` use a plain counter
+// instead.
 template <typename T>
 class IntrusivePtr final {
  public:
@@ -169,6 +170,23 @@ class RefCounted : private internal::RefCountedBase {
   friend class IntrusivePtr;
 };
 
+// Same as RefCounted, but the reference counter is not atomic. This avoids the
+// cost of atomic read-modify-write operations for objects that are only ever
+// referenced from a single thread (or under an external lock).
+//
+// NonAtomicRefCounted MUST never be used as a pointer type to store derived
+// objects - it doesn't provide a virtual destructor.
+template <typename T>
+class NonAtomicRefCounted : private internal::NonAtomicRefCountedBase {
+ public:
+  // Type alias for the IntrusivePtr of ref-counted type.
+  using Ptr = IntrusivePtr<T>;
+
+ private:
+  template <typename U>
+  friend class IntrusivePtr;
+};
+
 template <typename T, typename U>
 inline bool operator==(const IntrusivePtr<T>& lhs, const IntrusivePtr<U>& rhs) {
   return lhs.get() == rhs.get();
@@ -0,0 +1,157 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_intrusive_ptr/intrusive_ptr.h"
+#include "pw_intrusive_ptr/recyclable.h"
+
+namespace pw {
+
+template <typename T>
+class IntrusivePtrPool;
+
+// Mixin for objects that are allocated from an IntrusivePtrPool<T>.
+//
+// When the last IntrusivePtr to a Pooled object is released, the object is
+// destroyed and its storage is returned to the pool's free list instead of
+// being deleted.
+//
+// RefCountBase provides the reference counting: RefCounted<T> (the default)
+// for atomic reference counting, or NonAtomicRefCounted<T> for objects that
+// are only referenced from a single thread.
+//
+// :: Example ::
+//
+// class Buffer : public pw::Pooled<Buffer, pw::NonAtomicRefCounted<Buffer>> {
+//  public:
+//   explicit Buffer(size_t size);
+// };
+//
+// pw::IntrusivePtrPoolWithBuffer<Buffer, 4> pool;
+// pw::IntrusivePtr<Buffer> buffer = pool.Make(16);
+template <typename T, typename RefCountBase = RefCounted<T>>
+class Pooled : public RefCountBase, public Recyclable<T> {
+ protected:
+  constexpr Pooled() = default;
+
+ private:
+  friend class Recyclable<T>;
+  friend class IntrusivePtrPool<T>;
+
+  void pw_recycle();
+
+  IntrusivePtrPool<T>* pool_ = nullptr;
+};
+
+// Fixed-size pool of T objects managed by IntrusivePtr. T must derive from
+// Pooled<T>.
+//
+// Objects are constructed in the pool's storage by Make() and destroyed when
+// their last reference is released. Neither operation allocates.
+//
+// The pool itself is not synchronized: calls to Make() and releases of the
+// last reference to a pooled object must not happen concurrently. The pool
+// must outlive all of its objects.
+//
+// Use IntrusivePtrPoolWithBuffer<T, kCapacity> to declare a pool with its
+// storage.
+template <typename T>
+class IntrusivePtrPool {
+ public:
+  IntrusivePtrPool(const IntrusivePtrPool&) = delete;
+  IntrusivePtrPool& operator=(const IntrusivePtrPool&) = delete;
+
+  // Constructs a T in free storage from the pool. Returns an empty pointer if
+  // the pool is exhausted.
+  template <typename... Args>
+  IntrusivePtr<T> Make(Args&&... args) {
+    Slot* slot = free_list_;
+    if (slot != nullptr) {
+      free_list_ = slot->next;
+    } else if (num_used_slots_ < capacity_) {
+      slot = &slots_[num_used_slots_++];
+    } else {
+      return nullptr;
+    }
+    --available_;
+    T* object = new (slot->storage) T(std::forward<Args>(args)...);
+    object->pool_ = this;
+    return IntrusivePtr<T>(object);
+  }
+
+  // Returns the number of objects that fit in the pool.
+  size_t capacity() const { return capacity_; }
+
+  // Returns the number of objects that can currently be made.
+  size_t available() const { return available_; }
+
+ protected:
+  union Slot {
+    Slot* next;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  constexpr IntrusivePtrPool(Slot* slots, size_t capacity)
+      : slots_(slots), capacity_(capacity), available_(capacity) {}
+
+  ~IntrusivePtrPool() { PW_ASSERT(available_ == capacity_); }
+
+ private:
+  template <typename, typename>
+  friend class Pooled;
+
+  void Recycle(T* object) {
+    object->~T();
+    // The object was constructed at the start of its slot.
+    Slot* slot = std::launder(reinterpret_cast<Slot*>(object));
+    slot->next = free_list_;
+    free_list_ = slot;
+    ++available_;
+  }
+
+  Slot* const slots_;
+  const size_t capacity_;
+  size_t available_;
+
+  // Slots past num_used_slots_ have never been used. Freed slots are kept in
+  // free_list_, so the free list never needs to be initialized up front.
+  size_t num_used_slots_ = 0;
+  Slot* free_list_ = nullptr;
+};
+
+// IntrusivePtrPool with inline storage for kCapacity objects.
+template <typename T, size_t kCapacity>
+class IntrusivePtrPoolWithBuffer : public IntrusivePtrPool<T> {
+ public:
+  static_assert(kCapacity > 0u, "An IntrusivePtrPool needs some capacity");
+
+  constexpr IntrusivePtrPoolWithBuffer()
+      : IntrusivePtrPool<T>(slots_, kCapacity) {}
+
+ private:
+  typename IntrusivePtrPool<T>::Slot slots_[kCapacity];
+};
+
+template <typename T, typename RefCountBase>
+void Pooled<T, RefCountBase>::pw_recycle() {
+  PW_ASSERT(pool_ != nullptr);  // Pooled objects must be made by a pool.
+  pool_->Recycle(static_cast<T*>(this));
+}
+
+}  // namespace pw
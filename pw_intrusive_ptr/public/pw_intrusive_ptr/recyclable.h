@@ -52,6 +52,8 @@
 // if the managed pointers handed out by the user's code are const or volatile).
 // In addition, pw_recycle must be visible to pw::Recyclable<T>, either
 // because it is public or because the T is friends with pw::Recyclable<T>.
+// pw_recycle may also be inherited from a base class of T, such as
+// pw::Pooled<T> (see pw_intrusive_ptr/pool.h).
 //
 // :: Example ::
 //
@@ -123,7 +125,8 @@ class Recyclable<T, std::enable_if_t<std::is_same_v<std::remove_cv_t<T>, T>>> {
   friend void ::pw::internal::recycle<const T>(const T*);
 
   static void pw_recycle_thunk(T* ptr) {
-    static_assert(std::is_same_v<decltype(&T::pw_recycle), void (T::*)(void)>,
+    static_assert(std::is_member_function_pointer_v<decltype(&T::pw_recycle)> &&
+                      std::is_void_v<decltype(ptr->pw_recycle())>,
                   "pw_recycle() methods must be non-static member functions "
                   "with the signature 'void pw_recycle()', and be visible to "
                   "pw::Recyclable<T> (either because they are public, or "
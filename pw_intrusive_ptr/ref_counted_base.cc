@@ -58,4 +58,19 @@ bool RefCountedBase::ReleaseRef() const {
   return refs == 1;
 }
 
+NonAtomicRefCountedBase::~NonAtomicRefCountedBase() {
+  // Poison the ref count, as in ~RefCountedBase().
+  ref_count_ = static_cast<int32_t>(0xC0000000);
+}
+
+void NonAtomicRefCountedBase::AddRef() const {
+  PW_DCHECK(ref_count_ >= 0);
+  ++ref_count_;
+}
+
+bool NonAtomicRefCountedBase::ReleaseRef() const {
+  PW_DCHECK(ref_count_ >= 1);
+  return --ref_count_ == 0;
+}
+
 }  // namespace pw::internal
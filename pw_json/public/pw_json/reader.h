@@ -0,0 +1,184 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+/// @file pw_json/reader.h
+///
+/// `pw::JsonReader` is a pull parser for JSON. Each call to `Next()` reads one
+/// token from the input and checks that it is valid where it appears. The
+/// reader does not allocate memory or copy the input; tokens refer to the
+/// original JSON text.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw {
+
+/// @defgroup pw_json_reader_api
+/// @{
+
+/// Reads JSON one token at a time. For example:
+///
+/// @code{.cpp}
+///   pw::JsonReader json(R"({"id": 5, "tags": ["a", "b"]})");
+///   while (json.Next().ok()) {
+///     if (json.token() == pw::JsonReader::Token::kKey &&
+///         json.raw_value() == "id") {
+///       PW_TRY(json.Next());
+///       PW_TRY_ASSIGN(int64_t id, json.ReadInt());
+///     }
+///   }
+/// @endcode
+class JsonReader {
+ public:
+  /// The kinds of JSON tokens.
+  enum class Token : uint8_t {
+    kNone,         ///< `Next()` has not read a token.
+    kStartObject,  ///< `{`
+    kEndObject,    ///< `}`
+    kStartArray,   ///< `[`
+    kEndArray,     ///< `]`
+    kKey,          ///< A string that names an object member.
+    kString,       ///< A string value.
+    kNumber,       ///< A number value.
+    kTrue,         ///< `true`
+    kFalse,        ///< `false`
+    kNull,         ///< `null`
+  };
+
+  /// The maximum number of nested arrays and objects.
+  static constexpr size_t kMaxDepth = 32;
+
+  constexpr explicit JsonReader(std::string_view json)
+      : json_(json),
+        position_(0),
+        token_(Token::kNone),
+        depth_(0),
+        object_levels_(0),
+        state_(State::kValue) {}
+
+  /// Reads the next token.
+  ///
+  /// @returns
+  /// - @pw_status{OK} if a token was read
+  /// - @pw_status{OUT_OF_RANGE} if the top-level value is complete and only
+  ///   whitespace follows it
+  /// - @pw_status{DATA_LOSS} if the JSON is malformed
+  /// - @pw_status{RESOURCE_EXHAUSTED} if arrays and objects are nested more
+  ///   than `kMaxDepth` deep
+  ///
+  /// After an error, `Next()` returns the same error.
+  Status Next();
+
+  /// Skips the current value. If the current token starts an array or object,
+  /// skips to its end. Other tokens are already complete, so this does
+  /// nothing.
+  Status SkipValue();
+
+  /// The most recently read token.
+  Token token() const { return token_; }
+
+  /// The number of arrays and objects that are open after the current token.
+  size_t depth() const { return depth_; }
+
+  /// The token's text. For keys and strings, this excludes the quotes and
+  /// includes any escape sequences; use `ReadString()` to unescape them.
+  std::string_view raw_value() const { return raw_value_; }
+
+  /// Unescapes the current key or string into `out`, which is not null
+  /// terminated. `\u` escapes are written as UTF-8.
+  ///
+  /// @returns
+  /// - @pw_status{OK} with the number of bytes written
+  /// - @pw_status{FAILED_PRECONDITION} if the token is not a key or string
+  /// - @pw_status{DATA_LOSS} if a `\u` escape is an unpaired UTF-16 surrogate
+  /// - @pw_status{RESOURCE_EXHAUSTED} if the string does not fit in `out`
+  StatusWithSize ReadString(span<char> out) const;
+
+  /// Reads the current number as an integer.
+  ///
+  /// @returns
+  /// - @pw_status{OK} with the value
+  /// - @pw_status{FAILED_PRECONDITION} if the token is not a number
+  /// - @pw_status{INVALID_ARGUMENT} if the number has a fraction or exponent
+  /// - @pw_status{OUT_OF_RANGE} if the number does not fit in an `int64_t`
+  Result<int64_t> ReadInt() const;
+
+  /// Reads the current `true` or `false` token.
+  ///
+  /// @returns
+  /// - @pw_status{OK} with the value
+  /// - @pw_status{FAILED_PRECONDITION} if the token is not `true` or `false`
+  Result<bool> ReadBool() const;
+
+ private:
+  // What the grammar allows next.
+  enum class State : uint8_t {
+    kValue,       // A value
+    kValueOrEnd,  // A value, or ] since the array is empty
+    kKey,         // A key
+    kKeyOrEnd,    // A key, or } since the object is empty
+    kColon,       // : after a key
+    kCommaOrEnd,  // , or the end of the innermost array or object
+    kDone,        // Only whitespace
+  };
+
+  bool in_object() const {
+    return depth_ != 0u && (object_levels_ >> (depth_ - 1) & 1u) != 0u;
+  }
+
+  Status Fail(Status status) {
+    status_ = status;
+    token_ = Token::kNone;
+    raw_value_ = {};
+    return status;
+  }
+
+  void SkipWhitespace();
+
+  Status ReadValue(char c);
+  Status ReadStart(Token token, bool object);
+  Status ReadEnd(Token token, bool object);
+  Status ReadStringToken(Token token);
+  Status ReadNumber();
+  Status ReadLiteral(std::string_view literal, Token token);
+
+  // Sets the token to the text from start up to the current position.
+  void SetToken(Token token, size_t start);
+
+  // Sets the state after a complete value.
+  void FinishValue() {
+    state_ = depth_ == 0u ? State::kDone : State::kCommaOrEnd;
+  }
+
+  std::string_view json_;
+  size_t position_;
+  std::string_view raw_value_;
+  Status status_;
+
+  Token token_;
+  uint8_t depth_;
+  uint32_t object_levels_;  // Bit i is set if nesting level i is an object.
+  State state_;
+};
+
+/// @}
+
+}  // namespace pw
@@ -0,0 +1,222 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+/// @file pw_json/stream_writer.h
+///
+/// `pw::JsonStreamWriter` serializes JSON to a `pw::stream::Writer`. Unlike
+/// `pw::JsonBuilder`, the JSON does not have to fit in memory. Tokens are
+/// collected in a small buffer, which is written to the stream when it fills
+/// up and when `Flush()` is called.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+#include "pw_string/type_to_string.h"
+
+namespace pw {
+
+/// @defgroup pw_json_stream_writer_api
+/// @{
+
+/// Writes JSON tokens to a `pw::stream::Writer`. Arrays and objects are opened
+/// and closed explicitly, and the writer adds the commas and colons between
+/// elements. For example:
+///
+/// @code{.cpp}
+///   std::array<char, 32> buffer;
+///   pw::JsonStreamWriter json(writer, buffer);
+///   json.StartObject()
+///       .Add("name", "pw_json")
+///       .Key("values")
+///       .StartArray()
+///       .Value(1)
+///       .Value(true)
+///       .EndArray()
+///       .EndObject();
+///   PW_TRY(json.Flush());
+/// @endcode
+///
+/// The writer has a sticky status, like `pw::JsonBuilder`. After an error,
+/// later calls do nothing, and the status reflects the first error.
+class JsonStreamWriter {
+ public:
+  /// The maximum number of nested arrays and objects.
+  static constexpr size_t kMaxDepth = 32;
+
+  /// Writes to `writer`, buffering output in `buffer`, which must not be empty.
+  JsonStreamWriter(stream::Writer& writer, span<char> buffer)
+      : writer_(writer),
+        buffer_(buffer),
+        buffered_(0),
+        depth_(0),
+        object_levels_(0),
+        needs_comma_(false),
+        has_key_(false),
+        done_(false) {}
+
+  JsonStreamWriter(const JsonStreamWriter&) = delete;
+  JsonStreamWriter& operator=(const JsonStreamWriter&) = delete;
+
+  /// Opens an array (`[`).
+  JsonStreamWriter& StartArray() { return Start('['); }
+
+  /// Closes the innermost array (`]`).
+  JsonStreamWriter& EndArray() { return End(']'); }
+
+  /// Opens an object (`{`).
+  JsonStreamWriter& StartObject() { return Start('{'); }
+
+  /// Closes the innermost object (`}`).
+  JsonStreamWriter& EndObject() { return End('}'); }
+
+  /// Writes a key in the innermost object. The next call must write the value.
+  JsonStreamWriter& Key(std::string_view key);
+
+  /// Writes a boolean, number, string, or `null`. Within an object, the value
+  /// must follow a `Key()` call.
+  template <typename T>
+  JsonStreamWriter& Value(const T& value);
+
+  /// Writes a key-value pair in the innermost object.
+  template <typename T>
+  JsonStreamWriter& Add(std::string_view key, const T& value) {
+    return Key(key).Value(value);
+  }
+
+  /// Writes any buffered output to the stream.
+  ///
+  /// @returns
+  /// - @pw_status{OK} if all JSON has been written
+  /// - @pw_status{FAILED_PRECONDITION} if the calls did not form valid JSON,
+  ///   such as adding a value to an object without a key
+  /// - @pw_status{RESOURCE_EXHAUSTED} if arrays and objects were nested more
+  ///   than `kMaxDepth` deep
+  /// - Any error from writing to the stream
+  Status Flush();
+
+  /// True if the top-level value is complete: all arrays and objects are
+  /// closed.
+  [[nodiscard]] bool done() const { return done_; }
+
+  /// True if no errors have occurred.
+  [[nodiscard]] bool ok() const { return status_.ok(); }
+
+  /// The first error that occurred, or `OkStatus()`. Output that has not been
+  /// flushed is not reflected; call `Flush()` for the final status.
+  Status status() const { return status_; }
+
+ private:
+  JsonStreamWriter& Start(char open);
+  JsonStreamWriter& End(char close);
+
+  // Checks that a value may be written here and writes a comma if necessary.
+  bool BeginValue();
+
+  // Updates the state after a complete value was written.
+  void FinishValue();
+
+  bool in_object() const {
+    return depth_ != 0u && (object_levels_ >> (depth_ - 1) & 1u) != 0u;
+  }
+
+  void WriteNull();
+  void WriteBool(bool value);
+  void WriteInteger(int64_t value);
+  void WriteUnsigned(uint64_t value);
+  void WriteFloat(float value);
+  void WriteQuoted(std::string_view value);
+
+  void Put(char c) {
+    if (buffered_ == buffer_.size()) {
+      FlushBuffer();
+    }
+    buffer_[buffered_++] = c;
+  }
+
+  void Put(std::string_view text) {
+    for (char c : text) {
+      Put(c);
+    }
+  }
+
+  void FlushBuffer();
+
+  stream::Writer& writer_;
+  span<char> buffer_;
+  size_t buffered_;
+  Status status_;
+
+  uint8_t depth_;
+  uint32_t object_levels_;  // Bit i is set if nesting level i is an object.
+  bool needs_comma_;        // A value was written in the innermost array/object
+  bool has_key_;            // A key was written and needs a value
+  bool done_;               // The top-level value is complete
+};
+
+/// A `JsonStreamWriter` with an integrated buffer of `kBufferSize` characters.
+template <size_t kBufferSize>
+class JsonStreamWriterBuffer final : public JsonStreamWriter {
+ public:
+  explicit JsonStreamWriterBuffer(stream::Writer& writer)
+      : JsonStreamWriter(writer, buffer_) {}
+
+ private:
+  static_assert(kBufferSize > 0u);
+
+  char buffer_[kBufferSize];
+};
+
+/// @}
+
+template <typename T>
+JsonStreamWriter& JsonStreamWriter::Value(const T& value) {
+  if (!BeginValue()) {
+    return *this;
+  }
+
+  if constexpr (std::is_null_pointer_v<T>) {
+    WriteNull();
+  } else if constexpr (std::is_same_v<T, char*> ||
+                       std::is_same_v<T, const char*>) {
+    if (value == nullptr) {
+      WriteNull();
+    } else {
+      WriteQuoted(value);
+    }
+  } else if constexpr (std::is_convertible_v<T, std::string_view>) {
+    WriteQuoted(value);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    WriteBool(value);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    WriteFloat(static_cast<float>(value));
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    WriteInteger(value);
+  } else if constexpr (std::is_integral_v<T>) {
+    WriteUnsigned(value);
+  } else {
+    static_assert(std::is_integral_v<T>,
+                  "JSON values may only be numbers, strings, or null");
+  }
+
+  FinishValue();
+  return *this;
+}
+
+}  // namespace pw
@@ -0,0 +1,446 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_json/reader.h"
+
+#include <limits>
+
+namespace pw {
+namespace {
+
+constexpr bool IsDigit(char c) { return '0' <= c && c <= '9'; }
+
+// Returns the value of a hex digit, or -1 if c is not a hex digit.
+constexpr int HexValue(char c) {
+  if (IsDigit(c)) {
+    return c - '0';
+  }
+  if ('a' <= c && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if ('A' <= c && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// Reads the 4 hex digits of a \u escape. Returns -1 if they are invalid.
+constexpr int32_t ReadHex4(std::string_view digits) {
+  if (digits.size() < 4u) {
+    return -1;
+  }
+  int32_t value = 0;
+  for (size_t i = 0; i < 4u; ++i) {
+    const int digit = HexValue(digits[i]);
+    if (digit < 0) {
+      return -1;
+    }
+    value = value << 4 | digit;
+  }
+  return value;
+}
+
+// Writes a code point as UTF-8. Returns the number of bytes, or 0 if they do
+// not fit.
+size_t WriteUtf8(uint32_t code_point, span<char> out) {
+  char bytes[4];
+  size_t size;
+  if (code_point < 0x80u) {
+    bytes[0] = static_cast<char>(code_point);
+    size = 1;
+  } else if (code_point < 0x800u) {
+    bytes[0] = static_cast<char>(0xc0u | code_point >> 6);
+    bytes[1] = static_cast<char>(0x80u | (code_point & 0x3fu));
+    size = 2;
+  } else if (code_point < 0x10000u) {
+    bytes[0] = static_cast<char>(0xe0u | code_point >> 12);
+    bytes[1] = static_cast<char>(0x80u | (code_point >> 6 & 0x3fu));
+    bytes[2] = static_cast<char>(0x80u | (code_point & 0x3fu));
+    size = 3;
+  } else {
+    bytes[0] = static_cast<char>(0xf0u | code_point >> 18);
+    bytes[1] = static_cast<char>(0x80u | (code_point >> 12 & 0x3fu));
+    bytes[2] = static_cast<char>(0x80u | (code_point >> 6 & 0x3fu));
+    bytes[3] = static_cast<char>(0x80u | (code_point & 0x3fu));
+    size = 4;
+  }
+
+  if (size > out.size()) {
+    return 0;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = bytes[i];
+  }
+  return size;
+}
+
+}  // namespace
+
+Status JsonReader::Next() {
+  if (!status_.ok()) {
+    return status_;
+  }
+
+  while (true) {
+    SkipWhitespace();
+    if (position_ == json_.size()) {
+      if (state_ == State::kDone) {
+        token_ = Token::kNone;
+        raw_value_ = {};
+        return Status::OutOfRange();
+      }
+      return Fail(Status::DataLoss());  // The JSON ended early.
+    }
+
+    const char c = json_[position_];
+    switch (state_) {
+      case State::kDone:
+        return Fail(Status::DataLoss());  // Data after the top-level value.
+      case State::kColon:
+        if (c != ':') {
+          return Fail(Status::DataLoss());
+        }
+        position_ += 1;
+        state_ = State::kValue;
+        continue;
+      case State::kCommaOrEnd:
+        if (c == ',') {
+          position_ += 1;
+          state_ = in_object() ? State::kKey : State::kValue;
+          continue;
+        }
+        if (c == ']') {
+          return ReadEnd(Token::kEndArray, false);
+        }
+        if (c == '}') {
+          return ReadEnd(Token::kEndObject, true);
+        }
+        return Fail(Status::DataLoss());
+      case State::kKeyOrEnd:
+        if (c == '}') {
+          return ReadEnd(Token::kEndObject, true);
+        }
+        [[fallthrough]];
+      case State::kKey:
+        if (c != '"') {
+          return Fail(Status::DataLoss());
+        }
+        return ReadStringToken(Token::kKey);
+      case State::kValueOrEnd:
+        if (c == ']') {
+          return ReadEnd(Token::kEndArray, false);
+        }
+        [[fallthrough]];
+      case State::kValue:
+        return ReadValue(c);
+    }
+  }
+}
+
+Status JsonReader::SkipValue() {
+  if (token_ != Token::kStartObject && token_ != Token::kStartArray) {
+    return status_;
+  }
+
+  const size_t end_depth = depth_ - 1u;
+  do {
+    if (Status status = Next(); !status.ok()) {
+      // The array or object must end before the JSON does.
+      return status.IsOutOfRange() ? Fail(Status::DataLoss()) : status;
+    }
+  } while (depth_ != end_depth ||
+           (token_ != Token::kEndObject && token_ != Token::kEndArray));
+  return OkStatus();
+}
+
+void JsonReader::SkipWhitespace() {
+  while (position_ < json_.size()) {
+    const char c = json_[position_];
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+      return;
+    }
+    position_ += 1;
+  }
+}
+
+Status JsonReader::ReadValue(char c) {
+  switch (c) {
+    case '{':
+      return ReadStart(Token::kStartObject, true);
+    case '[':
+      return ReadStart(Token::kStartArray, false);
+    case '"':
+      return ReadStringToken(Token::kString);
+    case 't':
+      return ReadLiteral("true", Token::kTrue);
+    case 'f':
+      return ReadLiteral("false", Token::kFalse);
+    case 'n':
+      return ReadLiteral("null", Token::kNull);
+    default:
+      if (c == '-' || IsDigit(c)) {
+        return ReadNumber();
+      }
+      return Fail(Status::DataLoss());
+  }
+}
+
+Status JsonReader::ReadStart(Token token, bool object) {
+  if (depth_ == kMaxDepth) {
+    return Fail(Status::ResourceExhausted());
+  }
+
+  if (object) {
+    object_levels_ |= uint32_t{1} << depth_;
+  } else {
+    object_levels_ &= ~(uint32_t{1} << depth_);
+  }
+  depth_ += 1;
+  position_ += 1;
+  SetToken(token, position_ - 1);
+  state_ = object ? State::kKeyOrEnd : State::kValueOrEnd;
+  return OkStatus();
+}
+
+Status JsonReader::ReadEnd(Token token, bool object) {
+  if (depth_ == 0u || in_object() != object) {
+    return Fail(Status::DataLoss());
+  }
+
+  depth_ -= 1;
+  position_ += 1;
+  SetToken(token, position_ - 1);
+  FinishValue();
+  return OkStatus();
+}
+
+Status JsonReader::ReadStringToken(Token token) {
+  const size_t start = position_ + 1;  // Skip the opening quote.
+  for (size_t i = start; i < json_.size(); ++i) {
+    const char c = json_[i];
+    if (c == '"') {
+      position_ = i + 1;
+      raw_value_ = json_.substr(start, i - start);
+      token_ = token;
+      if (token == Token::kKey) {
+        state_ = State::kColon;
+      } else {
+        FinishValue();
+      }
+      return OkStatus();
+    }
+    if (static_cast<unsigned char>(c) < 0x20u) {
+      return Fail(Status::DataLoss());  // Control characters must be escaped.
+    }
+    if (c != '\\') {
+      continue;
+    }
+
+    i += 1;
+    const char escaped = i < json_.size() ? json_[i] : '\0';
+    switch (escaped) {
+      case '"':
+      case '\\':
+      case '/':
+      case 'b':
+      case 'f':
+      case 'n':
+      case 'r':
+      case 't':
+        break;
+      case 'u':
+        if (ReadHex4(json_.substr(i + 1)) < 0) {
+          return Fail(Status::DataLoss());
+        }
+        i += 4;
+        break;
+      default:
+        return Fail(Status::DataLoss());
+    }
+  }
+  return Fail(Status::DataLoss());  // The string is not terminated.
+}
+
+Status JsonReader::ReadNumber() {
+  const size_t start = position_;
+  auto at = [this](size_t index) {
+    return index < json_.size() ? json_[index] : '\0';
+  };
+  auto skip_digits = [&] {
+    const size_t first = position_;
+    while (IsDigit(at(position_))) {
+      position_ += 1;
+    }
+    return position_ != first;
+  };
+
+  if (at(position_) == '-') {
+    position_ += 1;
+  }
+  // The integer part may not have leading zeros.
+  if (at(position_) == '0') {
+    position_ += 1;
+  } else if (!skip_digits()) {
+    return Fail(Status::DataLoss());
+  }
+  if (at(position_) == '.') {
+    position_ += 1;
+    if (!skip_digits()) {
+      return Fail(Status::DataLoss());
+    }
+  }
+  if (at(position_) == 'e' || at(position_) == 'E') {
+    position_ += 1;
+    if (at(position_) == '+' || at(position_) == '-') {
+      position_ += 1;
+    }
+    if (!skip_digits()) {
+      return Fail(Status::DataLoss());
+    }
+  }
+
+  SetToken(Token::kNumber, start);
+  FinishValue();
+  return OkStatus();
+}
+
+Status JsonReader::ReadLiteral(std::string_view literal, Token token) {
+  if (json_.substr(position_, literal.size()) != literal) {
+    return Fail(Status::DataLoss());
+  }
+  const size_t start = position_;
+  position_ += literal.size();
+  SetToken(token, start);
+  FinishValue();
+  return OkStatus();
+}
+
+void JsonReader::SetToken(Token token, size_t start) {
+  token_ = token;
+  raw_value_ = json_.substr(start, position_ - start);
+}
+
+StatusWithSize JsonReader::ReadString(span<char> out) const {
+  if (token_ != Token::kKey && token_ != Token::kString) {
+    return StatusWithSize::FailedPrecondition();
+  }
+
+  // The string was validated by Next(), so escapes are complete.
+  size_t written = 0;
+  for (size_t i = 0; i < raw_value_.size(); ++i) {
+    char c = raw_value_[i];
+    if (c == '\\') {
+      c = raw_value_[++i];
+      switch (c) {
+        case 'b':
+          c = '\b';
+          break;
+        case 'f':
+          c = '\f';
+          break;
+        case 'n':
+          c = '\n';
+          break;
+        case 'r':
+          c = '\r';
+          break;
+        case 't':
+          c = '\t';
+          break;
+        case 'u': {
+          uint32_t code_point =
+              static_cast<uint32_t>(ReadHex4(raw_value_.substr(i + 1)));
+          i += 4;
+          if (0xdc00u <= code_point && code_point <= 0xdfffu) {
+            return StatusWithSize::DataLoss(written);
+          }
+          // A high surrogate must be followed by an escaped low surrogate.
+          if (0xd800u <= code_point && code_point <= 0xdbffu) {
+            const std::string_view next = raw_value_.substr(i + 1);
+            const int32_t low = next.size() >= 6u && next[0] == '\\' &&
+                                        next[1] == 'u'
+                                    ? ReadHex4(next.substr(2))
+                                    : -1;
+            if (low < 0xdc00 || low > 0xdfff) {
+              return StatusWithSize::DataLoss(written);
+            }
+            code_point = 0x10000u + ((code_point - 0xd800u) << 10 |
+                                     (static_cast<uint32_t>(low) - 0xdc00u));
+            i += 6;
+          }
+          const size_t size = WriteUtf8(code_point, out.subspan(written));
+          if (size == 0u) {
+            return StatusWithSize::ResourceExhausted(written);
+          }
+          written += size;
+          continue;
+        }
+        default:  // ", \, and / are written as is.
+          break;
+      }
+    }
+
+    if (written == out.size()) {
+      return StatusWithSize::ResourceExhausted(written);
+    }
+    out[written++] = c;
+  }
+  return StatusWithSize(written);
+}
+
+Result<int64_t> JsonReader::ReadInt() const {
+  if (token_ != Token::kNumber) {
+    return Status::FailedPrecondition();
+  }
+
+  std::string_view digits = raw_value_;
+  const bool negative = digits.front() == '-';
+  if (negative) {
+    digits.remove_prefix(1);
+  }
+
+  constexpr uint64_t kMaxMagnitude =
+      uint64_t{std::numeric_limits<int64_t>::max()} + 1u;
+  uint64_t magnitude = 0;
+  for (char c : digits) {
+    if (!IsDigit(c)) {
+      return Status::InvalidArgument();  // Fractions and exponents
+    }
+    const auto digit = static_cast<uint64_t>(c - '0');
+    if (magnitude > (kMaxMagnitude - digit) / 10u) {
+      return Status::OutOfRange();
+    }
+    magnitude = magnitude * 10u + digit;
+  }
+
+  if (negative) {
+    return static_cast<int64_t>(0u - magnitude);
+  }
+  if (magnitude == kMaxMagnitude) {
+    return Status::OutOfRange();
+  }
+  return static_cast<int64_t>(magnitude);
+}
+
+Result<bool> JsonReader::ReadBool() const {
+  if (token_ == Token::kTrue) {
+    return true;
+  }
+  if (token_ == Token::kFalse) {
+    return false;
+  }
+  return Status::FailedPrecondition();
+}
+
+}  // namespace pw
@@ -0,0 +1,227 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_json/reader.h"
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <tuple>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+using namespace std::string_view_literals;
+
+using Token = JsonReader::Token;
+
+// Expects the next token to have the given type and raw value.
+void ExpectToken(JsonReader& json, Token token, std::string_view raw) {
+  ASSERT_EQ(OkStatus(), json.Next());
+  EXPECT_EQ(token, json.token());
+  EXPECT_EQ(raw, json.raw_value());
+}
+
+TEST(JsonReader, Empty_DataLoss) {
+  JsonReader json("  ");
+  EXPECT_EQ(Status::DataLoss(), json.Next());
+}
+
+TEST(JsonReader, TopLevelValues) {
+  for (auto [text, token, raw] : {
+           std::make_tuple(" null "sv, Token::kNull, "null"sv),
+           std::make_tuple("true"sv, Token::kTrue, "true"sv),
+           std::make_tuple("false"sv, Token::kFalse, "false"sv),
+           std::make_tuple("\"a b\""sv, Token::kString, "a b"sv),
+           std::make_tuple("-1.5e+3"sv, Token::kNumber, "-1.5e+3"sv),
+           std::make_tuple("0"sv, Token::kNumber, "0"sv),
+       }) {
+    JsonReader json(text);
+    ExpectToken(json, token, raw);
+    EXPECT_EQ(0u, json.depth());
+    EXPECT_EQ(Status::OutOfRange(), json.Next());
+    EXPECT_EQ(Token::kNone, json.token());
+  }
+}
+
+TEST(JsonReader, Object) {
+  JsonReader json(R"( { "a" : 1 , "b" : [ true , null ] , "c" : { } } )");
+  ExpectToken(json, Token::kStartObject, "{");
+  EXPECT_EQ(1u, json.depth());
+  ExpectToken(json, Token::kKey, "a");
+  ExpectToken(json, Token::kNumber, "1");
+  ExpectToken(json, Token::kKey, "b");
+  ExpectToken(json, Token::kStartArray, "[");
+  EXPECT_EQ(2u, json.depth());
+  ExpectToken(json, Token::kTrue, "true");
+  ExpectToken(json, Token::kNull, "null");
+  ExpectToken(json, Token::kEndArray, "]");
+  EXPECT_EQ(1u, json.depth());
+  ExpectToken(json, Token::kKey, "c");
+  ExpectToken(json, Token::kStartObject, "{");
+  ExpectToken(json, Token::kEndObject, "}");
+  ExpectToken(json, Token::kEndObject, "}");
+  EXPECT_EQ(0u, json.depth());
+  EXPECT_EQ(Status::OutOfRange(), json.Next());
+}
+
+TEST(JsonReader, EmptyArray) {
+  JsonReader json("[]");
+  ExpectToken(json, Token::kStartArray, "[");
+  ExpectToken(json, Token::kEndArray, "]");
+  EXPECT_EQ(Status::OutOfRange(), json.Next());
+}
+
+TEST(JsonReader, MalformedJson_DataLoss) {
+  for (std::string_view text : {
+           "["sv,         "[1,]"sv,      "[,1]"sv,       "[1 2]"sv,
+           "{\"a\"}"sv,   "{\"a\":}"sv,  "{\"a\":1,}"sv, "{1:2}"sv,
+           "{\"a\" 1}"sv, "[1}"sv,       "{\"a\":1]"sv,  "]"sv,
+           "1 2"sv,       "01"sv,        "-"sv,          "1."sv,
+           "1e"sv,        ".5"sv,        "+1"sv,         "tru"sv,
+           "nul"sv,       "truex"sv,     "\"abc"sv,      "\"\\x\""sv,
+           "\"\\u12g4\""sv, "\"a\nb\""sv, "'a'"sv,       "[1],"sv,
+       }) {
+    JsonReader json(text);
+    Status status;
+    while ((status = json.Next()).ok()) {
+    }
+    EXPECT_EQ(Status::DataLoss(), status);
+    EXPECT_EQ(Status::DataLoss(), json.Next());
+  }
+}
+
+TEST(JsonReader, TooDeep_ResourceExhausted) {
+  char text[JsonReader::kMaxDepth + 1];
+  for (char& c : text) {
+    c = '[';
+  }
+  JsonReader json(std::string_view(text, sizeof(text)));
+  for (size_t i = 0; i < JsonReader::kMaxDepth; ++i) {
+    ASSERT_EQ(OkStatus(), json.Next());
+  }
+  EXPECT_EQ(Status::ResourceExhausted(), json.Next());
+}
+
+TEST(JsonReader, ReadString_Unescapes) {
+  JsonReader json(R"("q\" s\\ s\/ \b\f\n\r\t )"
+                  R"(\u0041 \u00e9 \u20ac \ud83d\ude00")");
+  ASSERT_EQ(OkStatus(), json.Next());
+  char buffer[64];
+  StatusWithSize result = json.ReadString(buffer);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("q\" s\\ s/ \b\f\n\r\t A \xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"sv,
+            std::string_view(buffer, result.size()));
+}
+
+TEST(JsonReader, ReadString_Key) {
+  JsonReader json(R"({"k\u0065y": 1})");
+  ASSERT_EQ(OkStatus(), json.Next());
+  ASSERT_EQ(OkStatus(), json.Next());
+  char buffer[8];
+  StatusWithSize result = json.ReadString(buffer);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("key"sv, std::string_view(buffer, result.size()));
+}
+
+TEST(JsonReader, ReadString_TooSmall_ResourceExhausted) {
+  JsonReader json(R"("abcd")");
+  ASSERT_EQ(OkStatus(), json.Next());
+  char buffer[3];
+  StatusWithSize result = json.ReadString(buffer);
+  EXPECT_EQ(Status::ResourceExhausted(), result.status());
+  EXPECT_EQ(3u, result.size());
+}
+
+TEST(JsonReader, ReadString_UnpairedSurrogate_DataLoss) {
+  for (std::string_view text :
+       {R"("\ud83d")"sv, R"("\ude00")"sv, R"("\ud83d\u0041")"sv}) {
+    JsonReader json(text);
+    ASSERT_EQ(OkStatus(), json.Next());
+    char buffer[8];
+    EXPECT_EQ(Status::DataLoss(), json.ReadString(buffer).status());
+  }
+}
+
+TEST(JsonReader, ReadString_NotString_FailedPrecondition) {
+  JsonReader json("1");
+  ASSERT_EQ(OkStatus(), json.Next());
+  char buffer[8];
+  EXPECT_EQ(Status::FailedPrecondition(), json.ReadString(buffer).status());
+}
+
+TEST(JsonReader, ReadInt) {
+  JsonReader json("[0, -0, 42, -9223372036854775808, 9223372036854775807]");
+  ASSERT_EQ(OkStatus(), json.Next());
+  for (int64_t expected : {int64_t{0},
+                           int64_t{0},
+                           int64_t{42},
+                           std::numeric_limits<int64_t>::min(),
+                           std::numeric_limits<int64_t>::max()}) {
+    ASSERT_EQ(OkStatus(), json.Next());
+    Result<int64_t> value = json.ReadInt();
+    ASSERT_EQ(OkStatus(), value.status());
+    EXPECT_EQ(expected, *value);
+  }
+}
+
+TEST(JsonReader, ReadInt_Errors) {
+  JsonReader json(
+      R"([9223372036854775808, -9223372036854775809, 1.5, 1e3, "1"])");
+  ASSERT_EQ(OkStatus(), json.Next());
+  for (Status expected : {Status::OutOfRange(),
+                          Status::OutOfRange(),
+                          Status::InvalidArgument(),
+                          Status::InvalidArgument(),
+                          Status::FailedPrecondition()}) {
+    ASSERT_EQ(OkStatus(), json.Next());
+    EXPECT_EQ(expected, json.ReadInt().status());
+  }
+}
+
+TEST(JsonReader, ReadBool) {
+  JsonReader json("[true, false, null]");
+  ASSERT_EQ(OkStatus(), json.Next());
+  ASSERT_EQ(OkStatus(), json.Next());
+  EXPECT_EQ(true, json.ReadBool().value());
+  ASSERT_EQ(OkStatus(), json.Next());
+  EXPECT_EQ(false, json.ReadBool().value());
+  ASSERT_EQ(OkStatus(), json.Next());
+  EXPECT_EQ(Status::FailedPrecondition(), json.ReadBool().status());
+}
+
+TEST(JsonReader, SkipValue) {
+  JsonReader json(R"({"skip": {"a": [1, {"b": []}]}, "keep": 2})");
+  ASSERT_EQ(OkStatus(), json.Next());
+  ExpectToken(json, Token::kKey, "skip");
+  ExpectToken(json, Token::kStartObject, "{");
+  ASSERT_EQ(OkStatus(), json.SkipValue());
+  EXPECT_EQ(Token::kEndObject, json.token());
+  EXPECT_EQ(1u, json.depth());
+  ExpectToken(json, Token::kKey, "keep");
+  ExpectToken(json, Token::kNumber, "2");
+  ASSERT_EQ(OkStatus(), json.SkipValue());  // Does nothing
+  ExpectToken(json, Token::kEndObject, "}");
+}
+
+TEST(JsonReader, SkipValue_Truncated_DataLoss) {
+  JsonReader json(R"([[1, 2])");
+  ASSERT_EQ(OkStatus(), json.Next());
+  EXPECT_EQ(Status::DataLoss(), json.SkipValue());
+}
+
+}  // namespace
+}  // namespace pw
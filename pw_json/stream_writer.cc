@@ -0,0 +1,165 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_json/stream_writer.h"
+
+#include "pw_bytes/span.h"
+
+namespace pw {
+namespace {
+
+constexpr char NibbleToHex(uint8_t nibble) {
+  return static_cast<char>(nibble + (nibble < 10 ? '0' : ('a' - 10)));
+}
+
+}  // namespace
+
+JsonStreamWriter& JsonStreamWriter::Start(char open) {
+  if (!BeginValue()) {
+    return *this;
+  }
+  if (depth_ == kMaxDepth) {
+    status_ = Status::ResourceExhausted();
+    return *this;
+  }
+
+  if (open == '{') {
+    object_levels_ |= uint32_t{1} << depth_;
+  } else {
+    object_levels_ &= ~(uint32_t{1} << depth_);
+  }
+  depth_ += 1;
+  needs_comma_ = false;
+  has_key_ = false;
+  Put(open);
+  return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::End(char close) {
+  if (!ok()) {
+    return *this;
+  }
+  // The innermost array or object must match and may not have a dangling key.
+  if (depth_ == 0u || in_object() != (close == '}') || has_key_) {
+    status_ = Status::FailedPrecondition();
+    return *this;
+  }
+
+  depth_ -= 1;
+  Put(close);
+  FinishValue();
+  return *this;
+}
+
+JsonStreamWriter& JsonStreamWriter::Key(std::string_view key) {
+  if (!ok()) {
+    return *this;
+  }
+  if (!in_object() || has_key_) {
+    status_ = Status::FailedPrecondition();
+    return *this;
+  }
+
+  if (needs_comma_) {
+    Put(',');
+  }
+  WriteQuoted(key);
+  Put(':');
+  has_key_ = true;
+  return *this;
+}
+
+bool JsonStreamWriter::BeginValue() {
+  if (!ok()) {
+    return false;
+  }
+  // Values in objects need a key, and only one top-level value is allowed.
+  if (in_object() ? !has_key_ : done_) {
+    status_ = Status::FailedPrecondition();
+    return false;
+  }
+
+  if (needs_comma_ && !in_object()) {
+    Put(',');
+  }
+  return true;
+}
+
+void JsonStreamWriter::FinishValue() {
+  has_key_ = false;
+  needs_comma_ = true;
+  done_ = depth_ == 0u;
+}
+
+void JsonStreamWriter::WriteNull() { Put("null"); }
+
+void JsonStreamWriter::WriteBool(bool value) { Put(value ? "true" : "false"); }
+
+void JsonStreamWriter::WriteInteger(int64_t value) {
+  char digits[21];
+  Put(std::string_view(digits, string::IntToString(value, digits).size()));
+}
+
+void JsonStreamWriter::WriteUnsigned(uint64_t value) {
+  char digits[21];
+  Put(std::string_view(digits, string::IntToString(value, digits).size()));
+}
+
+void JsonStreamWriter::WriteFloat(float value) {
+  char digits[21];
+  Put(std::string_view(digits,
+                       string::FloatAsIntToString(value, digits).size()));
+}
+
+// Escapes control characters, quotation marks, and reverse solidus (\) as
+// required by RFC 8259. Like JsonBuilder, bytes >= 128 are escaped one at a
+// time rather than treated as UTF-8.
+void JsonStreamWriter::WriteQuoted(std::string_view value) {
+  Put('"');
+  for (char c : value) {
+    if (c >= '\b' && c <= '\r' && c != '\v') {
+      constexpr char kControlChars[] = {'b', 't', 'n', '?', 'f', 'r'};
+      Put('\\');
+      Put(kControlChars[c - '\b']);
+    } else if (c == '"' || c == '\\') {
+      Put('\\');
+      Put(c);
+    } else if (c >= ' ' && c <= '~') {
+      Put(c);
+    } else {
+      const auto byte = static_cast<uint8_t>(c);
+      Put("\\u00");
+      Put(NibbleToHex(static_cast<uint8_t>(byte >> 4)));
+      Put(NibbleToHex(byte & 0x0fu));
+    }
+  }
+  Put('"');
+}
+
+void JsonStreamWriter::FlushBuffer() {
+  // Output is discarded after an error, so the buffer can be reused.
+  if (status_.ok()) {
+    status_ = writer_.Write(as_bytes(buffer_.first(buffered_)));
+  }
+  buffered_ = 0;
+}
+
+Status JsonStreamWriter::Flush() {
+  if (buffered_ != 0u) {
+    FlushBuffer();
+  }
+  return status_;
+}
+
+}  // namespace pw
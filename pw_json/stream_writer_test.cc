@@ -0,0 +1,209 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_json/stream_writer.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw {
+namespace {
+
+using namespace std::string_view_literals;
+
+class JsonStreamWriterTest : public ::testing::Test {
+ protected:
+  std::string_view output() const {
+    return std::string_view(reinterpret_cast<const char*>(stream_.data()),
+                            stream_.bytes_written());
+  }
+
+  stream::MemoryWriterBuffer<256> stream_;
+};
+
+TEST_F(JsonStreamWriterTest, Value) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.Value(-123);
+  EXPECT_TRUE(json.done());
+  ASSERT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ("-123"sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, NothingWritten_FlushSucceeds) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  EXPECT_FALSE(json.done());
+  EXPECT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ(""sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, ArrayOfValues) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  const char* null_string = nullptr;
+  json.StartArray()
+      .Value(nullptr)
+      .Value(true)
+      .Value(false)
+      .Value(uint64_t{18446744073709551615u})
+      .Value(2.5f)
+      .Value("str")
+      .Value(std::string_view("view"))
+      .Value(null_string)
+      .EndArray();
+  EXPECT_TRUE(json.done());
+  ASSERT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ(
+      R"([null,true,false,18446744073709551615,3,"str","view",null])"sv,
+      output());
+}
+
+TEST_F(JsonStreamWriterTest, Object) {
+  std::array<char, 1> buffer;  // Exercise flushing after every character.
+  JsonStreamWriter json(stream_, buffer);
+  json.StartObject().Add("a", 1).Add("b", "two").EndObject();
+  ASSERT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ(R"({"a":1,"b":"two"})"sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, EmptyArrayAndObject) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.StartArray()
+      .StartObject()
+      .EndObject()
+      .StartArray()
+      .EndArray()
+      .EndArray();
+  ASSERT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ("[{},[]]"sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, Nested) {
+  JsonStreamWriterBuffer<16> json(stream_);
+  json.StartObject()
+      .Key("list")
+      .StartArray()
+      .Value(1)
+      .StartObject()
+      .Add("x", nullptr)
+      .EndObject()
+      .StartArray()
+      .EndArray()
+      .EndArray()
+      .Key("obj")
+      .StartObject()
+      .Add("y", false)
+      .EndObject()
+      .EndObject();
+  EXPECT_TRUE(json.done());
+  ASSERT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ(R"({"list":[1,{"x":null},[]],"obj":{"y":false}})"sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, EscapesStrings) {
+  JsonStreamWriterBuffer<4> json(stream_);
+  json.StartObject().Add("k\"ey", "\\\n\t\x01\x7f").EndObject();
+  ASSERT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ(R"({"k\"ey":"\\\n\t\u0001\u007f"})"sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, LargerThanBuffer) {
+  JsonStreamWriterBuffer<5> json(stream_);
+  json.StartArray();
+  for (int i = 0; i < 20; ++i) {
+    json.Value(i);
+  }
+  json.EndArray();
+  ASSERT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ("[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19]"sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, OutputIsWrittenWhenBufferIsFullOrFlushed) {
+  JsonStreamWriterBuffer<4> json(stream_);
+  json.StartArray().Value(1).Value(2);
+  EXPECT_EQ(0u, stream_.bytes_written());
+  json.EndArray();
+  EXPECT_EQ("[1,2"sv, output());
+  EXPECT_EQ(OkStatus(), json.Flush());
+  EXPECT_EQ("[1,2]"sv, output());
+}
+
+TEST_F(JsonStreamWriterTest, ValueInObjectWithoutKey_FailedPrecondition) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.StartObject().Value(1);
+  EXPECT_EQ(Status::FailedPrecondition(), json.status());
+  EXPECT_EQ(Status::FailedPrecondition(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, KeyInArray_FailedPrecondition) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.StartArray().Key("a");
+  EXPECT_EQ(Status::FailedPrecondition(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, TwoKeys_FailedPrecondition) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.StartObject().Key("a").Key("b");
+  EXPECT_EQ(Status::FailedPrecondition(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, EndWithoutValue_FailedPrecondition) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.StartObject().Key("a").EndObject();
+  EXPECT_EQ(Status::FailedPrecondition(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, MismatchedEnd_FailedPrecondition) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.StartArray().EndObject();
+  EXPECT_EQ(Status::FailedPrecondition(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, EndAtTopLevel_FailedPrecondition) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.EndArray();
+  EXPECT_EQ(Status::FailedPrecondition(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, SecondTopLevelValue_FailedPrecondition) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  json.Value(1).Value(2);
+  EXPECT_EQ(Status::FailedPrecondition(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, TooDeep_ResourceExhausted) {
+  JsonStreamWriterBuffer<8> json(stream_);
+  for (size_t i = 0; i < JsonStreamWriter::kMaxDepth; ++i) {
+    json.StartArray();
+  }
+  EXPECT_TRUE(json.ok());
+  json.StartArray();
+  EXPECT_EQ(Status::ResourceExhausted(), json.Flush());
+}
+
+TEST_F(JsonStreamWriterTest, StreamError_IsSticky) {
+  stream::MemoryWriterBuffer<4> small_stream;
+  JsonStreamWriterBuffer<4> json(small_stream);
+  json.StartArray().Value(1).Value(2).Value(3);
+  EXPECT_EQ(OkStatus(), json.status());  // Only [1,2 has been written.
+  json.Value(4).EndArray();
+  EXPECT_EQ(Status::OutOfRange(), json.Flush());
+  EXPECT_EQ(Status::OutOfRange(), json.Flush());
+  EXPECT_EQ(4u, small_stream.bytes_written());
+}
+
+}  // namespace
+}  // namespace pw
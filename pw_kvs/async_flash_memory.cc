@@ -0,0 +1,194 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_kvs/async_flash_memory.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_bytes/alignment.h"
+#include "pw_status/try.h"
+
+namespace pw::kvs {
+
+Status AsyncFlashMemory::StartRead(Address address, span<std::byte> output) {
+  if (address > size_bytes() || output.size() > size_bytes() - address) {
+    return Status::OutOfRange();
+  }
+  PW_TRY(BeginOperation());
+  return EndOperationIfFailed(DoStartRead(address, output));
+}
+
+Status AsyncFlashMemory::StartWrite(Address address,
+                                    span<const std::byte> data) {
+  if (address % alignment_bytes() != 0 ||
+      data.size() % alignment_bytes() != 0) {
+    return Status::InvalidArgument();
+  }
+  if (address > size_bytes() || data.size() > size_bytes() - address) {
+    return Status::OutOfRange();
+  }
+  PW_TRY(BeginOperation());
+  return EndOperationIfFailed(DoStartWrite(address, data));
+}
+
+Status AsyncFlashMemory::StartErase(Address address, size_t num_sectors) {
+  if (address % sector_size_bytes() != 0) {
+    return Status::InvalidArgument();
+  }
+  if (address / sector_size_bytes() + num_sectors > sector_count()) {
+    return Status::OutOfRange();
+  }
+  PW_TRY(BeginOperation());
+  return EndOperationIfFailed(DoStartErase(address, num_sectors));
+}
+
+async2::Poll<StatusWithSize> AsyncFlashMemory::PendOperation(
+    async2::Context& cx) {
+  State state = state_.load(std::memory_order_acquire);
+  if (state == kIdle) {
+    return async2::Ready(StatusWithSize::FailedPrecondition());
+  }
+  if (state == kInProgress) {
+    waker_.Register(cx);
+    // Check again, in case the operation finished before the waker was
+    // registered.
+    if (state_.load(std::memory_order_acquire) == kInProgress) {
+      return async2::Pending();
+    }
+  }
+  const StatusWithSize result = result_;
+  state_.store(kIdle, std::memory_order_release);
+  return result;
+}
+
+void AsyncFlashMemory::OperationComplete(StatusWithSize result) {
+  result_ = result;
+  state_.store(kComplete, std::memory_order_release);
+  waker_.Wake();
+}
+
+Status AsyncFlashMemory::BeginOperation() {
+  State expected = kIdle;
+  if (!state_.compare_exchange_strong(
+          expected, kInProgress, std::memory_order_acq_rel)) {
+    return Status::Unavailable();
+  }
+  return OkStatus();
+}
+
+Status AsyncFlashMemory::EndOperationIfFailed(Status status) {
+  if (!status.ok()) {
+    state_.store(kIdle, std::memory_order_release);
+  }
+  return status;
+}
+
+Status FlashMemoryAsyncAdapter::DoStartRead(Address address,
+                                            span<std::byte> output) {
+  OperationComplete(flash_.Read(flash_.start_address() + address, output));
+  return OkStatus();
+}
+
+Status FlashMemoryAsyncAdapter::DoStartWrite(Address address,
+                                             span<const std::byte> data) {
+  OperationComplete(flash_.Write(flash_.start_address() + address, data));
+  return OkStatus();
+}
+
+Status FlashMemoryAsyncAdapter::DoStartErase(Address address,
+                                             size_t num_sectors) {
+  OperationComplete(
+      StatusWithSize(flash_.Erase(flash_.start_address() + address,
+                                  num_sectors),
+                     0));
+  return OkStatus();
+}
+
+async2::Poll<StatusWithSize> AsyncFlashWriter::PendWrite(
+    async2::Context& cx, span<const std::byte> data) {
+  size_t accepted = 0;
+  while (true) {
+    span<std::byte> buffer = buffers_[filling_];
+    const size_t to_copy =
+        std::min(data.size() - accepted, buffer.size() - fill_size_);
+    std::memcpy(buffer.data() + fill_size_, data.data() + accepted, to_copy);
+    fill_size_ += to_copy;
+    accepted += to_copy;
+
+    if (fill_size_ < buffer.size()) {
+      return async2::Ready(StatusWithSize(accepted));
+    }
+
+    // The buffer is full. It can be written once the other buffer is.
+    async2::Poll<Status> previous = PendWriteInProgress(cx);
+    if (previous.IsPending()) {
+      if (accepted == 0u) {
+        return async2::Pending();
+      }
+      return async2::Ready(StatusWithSize(accepted));
+    }
+    if (!previous->ok()) {
+      return async2::Ready(StatusWithSize(*previous, accepted));
+    }
+    if (Status status = StartWritingBuffer(); !status.ok()) {
+      return async2::Ready(StatusWithSize(status, accepted));
+    }
+  }
+}
+
+async2::Poll<Status> AsyncFlashWriter::PendFlush(async2::Context& cx) {
+  while (true) {
+    async2::Poll<Status> previous = PendWriteInProgress(cx);
+    if (previous.IsPending() || !previous->ok() || fill_size_ == 0u) {
+      return previous;
+    }
+
+    span<std::byte> buffer = buffers_[filling_];
+    const size_t padded_size = AlignUp(fill_size_, flash_.alignment_bytes());
+    std::memset(buffer.data() + fill_size_,
+                static_cast<int>(flash_.erased_memory_content()),
+                padded_size - fill_size_);
+    fill_size_ = padded_size;
+
+    if (Status status = StartWritingBuffer(); !status.ok()) {
+      return status;
+    }
+  }
+}
+
+async2::Poll<Status> AsyncFlashWriter::PendWriteInProgress(
+    async2::Context& cx) {
+  if (!write_in_progress_) {
+    return async2::Ready(OkStatus());
+  }
+  async2::Poll<StatusWithSize> result = flash_.PendOperation(cx);
+  if (result.IsPending()) {
+    return async2::Pending();
+  }
+  write_in_progress_ = false;
+  return async2::Ready(result->status());
+}
+
+Status AsyncFlashWriter::StartWritingBuffer() {
+  PW_TRY(flash_.StartWrite(address_, buffers_[filling_].first(fill_size_)));
+  address_ += fill_size_;
+  write_in_progress_ = true;
+  filling_ ^= 1;
+  fill_size_ = 0;
+  return OkStatus();
+}
+
+}  // namespace pw::kvs
@@ -0,0 +1,390 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_kvs/async_flash_memory.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <utility>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+using async2::Context;
+using async2::Dispatcher;
+using async2::Pending;
+using async2::Poll;
+using async2::Ready;
+
+constexpr size_t kSectorSize = 256;
+constexpr size_t kSectors = 4;
+constexpr size_t kAlignment = 16;
+
+template <typename Func>
+class FuncTask : public async2::Task {
+ public:
+  explicit FuncTask(Func func) : func_(std::move(func)) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override { return func_(cx); }
+
+  Func func_;
+};
+
+// Starts operations on a FakeFlashMemory, but only performs them when the test
+// calls Finish(), like a DMA transfer that completes with an interrupt.
+class DmaFlash : public AsyncFlashMemory {
+ public:
+  explicit DmaFlash(FakeFlashMemory& flash)
+      : AsyncFlashMemory(
+            flash.sector_size_bytes(), flash.sector_count(), kAlignment),
+        flash_(flash) {}
+
+  bool operation_started() const { return static_cast<bool>(operation_); }
+
+  size_t operations_started() const { return operations_started_; }
+
+  // Performs the operation in progress, and reports that it is complete.
+  void Finish() {
+    ASSERT_TRUE(operation_started());
+    auto operation = std::move(operation_);
+    operation_ = nullptr;
+    OperationComplete(operation());
+  }
+
+ private:
+  Status DoStartRead(Address address, span<std::byte> output) override {
+    return Start([this, address, output] {
+      return flash_.Read(address, output);
+    });
+  }
+
+  Status DoStartWrite(Address address, span<const std::byte> data) override {
+    return Start([this, address, data] { return flash_.Write(address, data); });
+  }
+
+  Status DoStartErase(Address address, size_t num_sectors) override {
+    return Start([this, address, num_sectors] {
+      return StatusWithSize(flash_.Erase(address, num_sectors), 0);
+    });
+  }
+
+  Status Start(std::function<StatusWithSize()> operation) {
+    operation_ = std::move(operation);
+    operations_started_ += 1;
+    return OkStatus();
+  }
+
+  FakeFlashMemory& flash_;
+  std::function<StatusWithSize()> operation_;
+  size_t operations_started_ = 0;
+};
+
+template <size_t kSize>
+std::array<std::byte, kSize> MakeData(uint8_t first) {
+  std::array<std::byte, kSize> data;
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(first + i);
+  }
+  return data;
+}
+
+class AsyncFlashMemoryTest : public ::testing::Test {
+ protected:
+  AsyncFlashMemoryTest() : fake_flash_(kAlignment) {
+    EXPECT_EQ(OkStatus(), fake_flash_.Erase(0, kSectors));
+  }
+
+  // Polls flash's operation in a task until it is done, and returns the
+  // result.
+  StatusWithSize RunOperation(AsyncFlashMemory& flash) {
+    StatusWithSize result;
+    FuncTask task([&](Context& cx) -> Poll<> {
+      Poll<StatusWithSize> poll = flash.PendOperation(cx);
+      if (poll.IsPending()) {
+        return Pending();
+      }
+      result = *poll;
+      return Ready();
+    });
+    dispatcher_.Post(task);
+    EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+    return result;
+  }
+
+  FakeFlashMemoryBuffer<kSectorSize, kSectors> fake_flash_;
+  Dispatcher dispatcher_;
+};
+
+TEST_F(AsyncFlashMemoryTest, Adapter_WriteAndRead) {
+  FlashMemoryAsyncAdapter flash(fake_flash_);
+  EXPECT_EQ(kSectorSize, flash.sector_size_bytes());
+  EXPECT_EQ(kSectors, flash.sector_count());
+  EXPECT_EQ(kAlignment, flash.alignment_bytes());
+
+  const auto data = MakeData<32>(1);
+  ASSERT_EQ(OkStatus(), flash.StartWrite(kSectorSize, data));
+  EXPECT_TRUE(flash.busy());
+  StatusWithSize result = RunOperation(flash);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(data.size(), result.size());
+  EXPECT_FALSE(flash.busy());
+
+  std::array<std::byte, 32> read{};
+  ASSERT_EQ(OkStatus(), flash.StartRead(kSectorSize, read));
+  EXPECT_EQ(OkStatus(), RunOperation(flash).status());
+  EXPECT_EQ(data, read);
+
+  ASSERT_EQ(OkStatus(), flash.StartErase(kSectorSize, 1));
+  EXPECT_EQ(OkStatus(), RunOperation(flash).status());
+  ASSERT_EQ(OkStatus(), flash.StartRead(kSectorSize, read));
+  EXPECT_EQ(OkStatus(), RunOperation(flash).status());
+  for (std::byte b : read) {
+    EXPECT_EQ(std::byte{0xff}, b);
+  }
+}
+
+TEST_F(AsyncFlashMemoryTest, Adapter_ReportsFlashErrors) {
+  FlashMemoryAsyncAdapter flash(fake_flash_);
+  fake_flash_.InjectWriteError(FlashError::Unconditional(Status::DataLoss()));
+
+  const auto data = MakeData<16>(1);
+  ASSERT_EQ(OkStatus(), flash.StartWrite(0, data));
+  EXPECT_EQ(Status::DataLoss(), RunOperation(flash).status());
+}
+
+TEST_F(AsyncFlashMemoryTest, Start_ChecksArguments) {
+  FlashMemoryAsyncAdapter flash(fake_flash_);
+  const auto data = MakeData<16>(1);
+  std::array<std::byte, 16> read;
+
+  EXPECT_EQ(Status::InvalidArgument(), flash.StartWrite(1, data));
+  EXPECT_EQ(Status::InvalidArgument(),
+            flash.StartWrite(0, span(data).first(15)));
+  EXPECT_EQ(Status::OutOfRange(),
+            flash.StartWrite(kSectorSize * kSectors, data));
+  EXPECT_EQ(Status::OutOfRange(),
+            flash.StartRead(kSectorSize * kSectors - 8, read));
+  EXPECT_EQ(Status::InvalidArgument(), flash.StartErase(16, 1));
+  EXPECT_EQ(Status::OutOfRange(), flash.StartErase(kSectorSize, kSectors));
+  EXPECT_FALSE(flash.busy());
+}
+
+TEST_F(AsyncFlashMemoryTest, PendOperation_NoOperationStarted) {
+  FlashMemoryAsyncAdapter flash(fake_flash_);
+  EXPECT_EQ(Status::FailedPrecondition(), RunOperation(flash).status());
+}
+
+TEST_F(AsyncFlashMemoryTest, OneOperationAtATime) {
+  DmaFlash flash(fake_flash_);
+  const auto data = MakeData<16>(1);
+  ASSERT_EQ(OkStatus(), flash.StartWrite(0, data));
+  EXPECT_EQ(Status::Unavailable(), flash.StartWrite(16, data));
+  EXPECT_EQ(Status::Unavailable(), flash.StartErase(0, 1));
+  EXPECT_EQ(1u, flash.operations_started());
+
+  flash.Finish();
+  EXPECT_EQ(OkStatus(), RunOperation(flash).status());
+  EXPECT_EQ(OkStatus(), flash.StartWrite(16, data));
+}
+
+TEST_F(AsyncFlashMemoryTest, CompletionWakesTask) {
+  DmaFlash flash(fake_flash_);
+  const auto data = MakeData<16>(1);
+  ASSERT_EQ(OkStatus(), flash.StartWrite(0, data));
+
+  int polls = 0;
+  std::optional<StatusWithSize> result;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    ++polls;
+    Poll<StatusWithSize> poll = flash.PendOperation(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher_.Post(task);
+
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsPending());
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsPending());
+  EXPECT_EQ(1, polls);
+  EXPECT_TRUE(flash.busy());
+
+  // Nothing is written until the operation is performed.
+  std::array<std::byte, 16> read;
+  ASSERT_EQ(OkStatus(), fake_flash_.Read(0, read).status());
+  EXPECT_NE(data, read);
+
+  flash.Finish();
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+  EXPECT_EQ(2, polls);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(OkStatus(), result->status());
+
+  ASSERT_EQ(OkStatus(), fake_flash_.Read(0, read).status());
+  EXPECT_EQ(data, read);
+}
+
+TEST_F(AsyncFlashMemoryTest, Writer_FillsOneBufferWhileOtherIsWritten) {
+  DmaFlash flash(fake_flash_);
+  std::array<std::byte, 32> buffer_a;
+  std::array<std::byte, 32> buffer_b;
+  AsyncFlashWriter writer(flash, kSectorSize, buffer_a, buffer_b);
+
+  const auto data = MakeData<72>(1);
+  size_t written = 0;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    while (written < data.size()) {
+      Poll<StatusWithSize> poll =
+          writer.PendWrite(cx, span(data).subspan(written));
+      if (poll.IsPending()) {
+        return Pending();
+      }
+      EXPECT_EQ(OkStatus(), poll->status());
+      written += poll->size();
+    }
+    return Ready();
+  });
+  dispatcher_.Post(task);
+
+  // The first buffer is being written, and the second buffer is full, so the
+  // writer waits.
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsPending());
+  EXPECT_EQ(64u, written);
+  EXPECT_EQ(1u, flash.operations_started());
+
+  // Once the first write finishes, the second buffer is written and the
+  // rest of the data is copied into the first.
+  flash.Finish();
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+  EXPECT_EQ(data.size(), written);
+  EXPECT_EQ(2u, flash.operations_started());
+  EXPECT_EQ(kSectorSize + 64, writer.address());
+
+  FuncTask flush([&](Context& cx) -> Poll<> {
+    Poll<Status> poll = writer.PendFlush(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    EXPECT_EQ(OkStatus(), *poll);
+    return Ready();
+  });
+  dispatcher_.Post(flush);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsPending());
+  flash.Finish();
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsPending());
+  EXPECT_EQ(3u, flash.operations_started());
+  flash.Finish();
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+  EXPECT_FALSE(flash.busy());
+
+  // The last write is padded to the alignment with erased bytes.
+  EXPECT_EQ(kSectorSize + 64 + kAlignment, writer.address());
+  std::array<std::byte, 96> read;
+  ASSERT_EQ(OkStatus(), fake_flash_.Read(kSectorSize, read).status());
+  EXPECT_EQ(0, std::memcmp(read.data(), data.data(), data.size()));
+  for (size_t i = data.size(); i < read.size(); ++i) {
+    EXPECT_EQ(std::byte{0xff}, read[i]);
+  }
+}
+
+TEST_F(AsyncFlashMemoryTest, Writer_WithAdapter) {
+  FlashMemoryAsyncAdapter flash(fake_flash_);
+  std::array<std::byte, 48> buffer_a;
+  std::array<std::byte, 48> buffer_b;
+  AsyncFlashWriter writer(flash, 0, buffer_a, buffer_b);
+
+  const auto data = MakeData<200>(7);
+  size_t written = 0;
+  bool flushed = false;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    // Write in small pieces, as a producer would.
+    while (written < data.size()) {
+      const size_t size = std::min<size_t>(9, data.size() - written);
+      Poll<StatusWithSize> poll =
+          writer.PendWrite(cx, span(data).subspan(written, size));
+      if (poll.IsPending()) {
+        return Pending();
+      }
+      EXPECT_EQ(OkStatus(), poll->status());
+      written += poll->size();
+    }
+    Poll<Status> poll = writer.PendFlush(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    EXPECT_EQ(OkStatus(), *poll);
+    flushed = true;
+    return Ready();
+  });
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+  EXPECT_TRUE(flushed);
+
+  std::array<std::byte, 200> read;
+  ASSERT_EQ(OkStatus(), fake_flash_.Read(0, read).status());
+  EXPECT_EQ(data, read);
+}
+
+TEST_F(AsyncFlashMemoryTest, Writer_ReportsWriteErrors) {
+  DmaFlash flash(fake_flash_);
+  std::array<std::byte, 16> buffer_a;
+  std::array<std::byte, 16> buffer_b;
+  AsyncFlashWriter writer(flash, 0, buffer_a, buffer_b);
+  fake_flash_.InjectWriteError(FlashError::Unconditional(Status::DataLoss()));
+
+  const auto data = MakeData<48>(1);
+  std::optional<StatusWithSize> result;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    Poll<StatusWithSize> poll = writer.PendWrite(cx, data);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher_.Post(task);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(OkStatus(), result->status());
+  EXPECT_EQ(32u, result->size());
+
+  FuncTask retry([&](Context& cx) -> Poll<> {
+    Poll<StatusWithSize> poll =
+        writer.PendWrite(cx, span(data).subspan(32));
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher_.Post(retry);
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsPending());
+  flash.Finish();
+  EXPECT_TRUE(dispatcher_.RunUntilStalled().IsReady());
+  EXPECT_EQ(Status::DataLoss(), result->status());
+}
+
+}  // namespace
+}  // namespace pw::kvs
@@ -0,0 +1,366 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#define PW_LOG_MODULE_NAME "KVS"
+#define PW_LOG_LEVEL PW_KVS_LOG_LEVEL
+
+#include "pw_kvs/internal/checkpoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "pw_bytes/alignment.h"
+#include "pw_checksum/crc32.h"
+#include "pw_kvs/alignment.h"
+#include "pw_kvs_private/config.h"
+#include "pw_log/log.h"
+#include "pw_status/try.h"
+
+namespace pw::kvs::internal {
+namespace {
+
+// For the checkpoint magic value, use a random 32 bit integer rather than a
+// human readable 4 bytes, as for KVS entry magic values.
+constexpr uint32_t kCheckpointMagic = 0x5e2bd04c;
+
+constexpr FlashPartition::Address kNoAddress = FlashPartition::Address(-1);
+
+// Record types.
+constexpr uint8_t kCheckpointRecord = 1;
+constexpr uint8_t kInvalidatedRecord = 2;
+
+// Each KeyDescriptor is followed by the redundancy in the header's addresses,
+// with kNoAddress for missing copies.
+struct EntryRecord {
+  uint32_t key_hash;
+  uint32_t transaction_id;
+  uint32_t state;
+};
+
+static_assert(sizeof(EntryRecord) == 12);
+
+}  // namespace
+
+// A record header is followed by the number of bytes in use in each sector,
+// then by the entries.
+struct Checkpoints::RecordHeader {
+  uint32_t magic;
+  uint32_t crc;  // CRC32 of the record after this field
+  uint32_t format_magic;
+  uint32_t entry_count;
+  uint16_t sector_count;
+  uint8_t redundancy;
+  uint8_t type;
+
+  // The CRC covers the header starting from format_magic.
+  static constexpr size_t kCrcStart = 2 * sizeof(uint32_t);
+
+  // Returns the size of the record.
+  size_t size() const {
+    return sizeof(RecordHeader) + sector_count * sizeof(uint32_t) +
+           entry_count * (sizeof(EntryRecord) +
+                          redundancy * sizeof(FlashPartition::Address));
+  }
+};
+
+namespace {
+
+// Calls write for each chunk of a checkpoint record's data.
+template <typename Function>
+Status VisitRecordData(size_t sector_size_bytes,
+                       const Sectors& sectors,
+                       const EntryCache& entry_cache,
+                       Function&& write) {
+  for (const SectorDescriptor& sector : sectors) {
+    const uint32_t used_bytes = sector_size_bytes - sector.writable_bytes();
+    PW_TRY(write(as_bytes(span(&used_bytes, 1))));
+  }
+
+  for (const EntryMetadata& metadata : entry_cache) {
+    const EntryRecord record = {
+        .key_hash = metadata.hash(),
+        .transaction_id = metadata.transaction_id(),
+        .state = static_cast<uint32_t>(metadata.state()),
+    };
+    PW_TRY(write(as_bytes(span(&record, 1))));
+
+    for (size_t i = 0; i < entry_cache.redundancy(); ++i) {
+      const FlashPartition::Address address =
+          i < metadata.addresses().size() ? metadata.addresses()[i]
+                                          : kNoAddress;
+      PW_TRY(write(as_bytes(span(&address, 1))));
+    }
+  }
+  return OkStatus();
+}
+
+template <typename T>
+Status ReadObject(FlashPartition& partition,
+                  FlashPartition::Address& address,
+                  T& object) {
+  PW_TRY(partition.Read(address, sizeof(object), &object).status());
+  address += sizeof(object);
+  return OkStatus();
+}
+
+}  // namespace
+
+Status Checkpoints::Load(FlashPartition& kvs_partition,
+                         const EntryFormats& formats,
+                         Sectors& sectors,
+                         EntryCache& entry_cache) {
+  valid_ = false;
+
+  Address address;
+  RecordHeader header;
+  PW_TRY(FindNewest(address, header));
+
+  if (header.type != kCheckpointRecord) {
+    return Status::NotFound();
+  }
+
+  if (header.format_magic != formats.primary().magic ||
+      header.sector_count != sectors.size() ||
+      header.redundancy != entry_cache.redundancy() ||
+      header.entry_count > entry_cache.max_entries()) {
+    PW_LOG_WARN("Checkpoint is for a different KVS configuration");
+    return Status::DataLoss();
+  }
+
+  const size_t sector_size_bytes = kvs_partition.sector_size_bytes();
+  address += sizeof(header);
+
+  for (SectorDescriptor& sector : sectors) {
+    uint32_t used_bytes;
+    PW_TRY(ReadObject(*partition_, address, used_bytes));
+    if (used_bytes > sector_size_bytes) {
+      return Status::DataLoss();
+    }
+
+    // Sectors are only appended to while the checkpoint is valid, so a sector
+    // that was in use must still start with an entry.
+    if (used_bytes != 0) {
+      uint32_t magic;
+      if (!kvs_partition.Read(sectors.BaseAddress(sector), sizeof(magic), &magic)
+               .ok() ||
+          !formats.KnownMagic(magic)) {
+        PW_LOG_WARN("Sector %u was erased after the checkpoint was written",
+                    sectors.Index(sector));
+        return Status::DataLoss();
+      }
+    }
+    sector.set_writable_bytes(sector_size_bytes - used_bytes);
+  }
+
+  for (uint32_t i = 0; i < header.entry_count; ++i) {
+    EntryRecord record;
+    PW_TRY(ReadObject(*partition_, address, record));
+    if (record.state > static_cast<uint32_t>(EntryState::kDeleted)) {
+      return Status::DataLoss();
+    }
+
+    const KeyDescriptor descriptor = {
+        .key_hash = record.key_hash,
+        .transaction_id = record.transaction_id,
+        .state = static_cast<EntryState>(record.state),
+    };
+    for (size_t j = 0; j < header.redundancy; ++j) {
+      Address entry_address;
+      PW_TRY(ReadObject(*partition_, address, entry_address));
+      if (entry_address == kNoAddress) {
+        continue;
+      }
+      if (entry_address >= kvs_partition.size_bytes() ||
+          !entry_cache
+               .AddNewOrUpdateExisting(
+                   descriptor, entry_address, sector_size_bytes)
+               .ok()) {
+        return Status::DataLoss();
+      }
+    }
+  }
+
+  valid_ = true;
+  return OkStatus();
+}
+
+Status Checkpoints::Write(const FlashPartition& kvs_partition,
+                          const EntryFormats& formats,
+                          const Sectors& sectors,
+                          const EntryCache& entry_cache) {
+  for (const SectorDescriptor& sector : sectors) {
+    if (sector.corrupt()) {
+      return Status::FailedPrecondition();
+    }
+  }
+
+  RecordHeader header = {
+      .magic = kCheckpointMagic,
+      .crc = 0,
+      .format_magic = formats.primary().magic,
+      .entry_count = static_cast<uint32_t>(entry_cache.total_entries()),
+      .sector_count = static_cast<uint16_t>(sectors.size()),
+      .redundancy = static_cast<uint8_t>(entry_cache.redundancy()),
+      .type = kCheckpointRecord,
+  };
+  PW_TRY(Append(
+      header, kvs_partition.sector_size_bytes(), &sectors, &entry_cache));
+
+  PW_LOG_DEBUG("Wrote checkpoint of %u entries",
+               unsigned(header.entry_count));
+  valid_ = true;
+  return OkStatus();
+}
+
+Status Checkpoints::Invalidate() {
+  if (!valid_) {
+    return OkStatus();
+  }
+
+  RecordHeader header = {
+      .magic = kCheckpointMagic,
+      .crc = 0,
+      .format_magic = 0,
+      .entry_count = 0,
+      .sector_count = 0,
+      .redundancy = 0,
+      .type = kInvalidatedRecord,
+  };
+  PW_TRY(Append(header, 0, nullptr, nullptr));
+
+  valid_ = false;
+  return OkStatus();
+}
+
+Status Checkpoints::FindNewest(Address& newest, RecordHeader& newest_header) {
+  static_assert(sizeof(RecordHeader) == 20);
+  static_assert(offsetof(RecordHeader, format_magic) ==
+                RecordHeader::kCrcStart);
+
+  bool found = false;
+  Address address = 0;
+  needs_erase_ = false;
+
+  while (address + sizeof(RecordHeader) <= partition_->size_bytes()) {
+    RecordHeader header;
+    if (!partition_->Read(address, sizeof(header), &header).ok()) {
+      needs_erase_ = true;
+      break;
+    }
+
+    // Records are followed by erased flash, unless a write was interrupted.
+    if (header.magic != kCheckpointMagic) {
+      needs_erase_ = !partition_->AppearsErased(as_bytes(span(&header, 1)));
+      break;
+    }
+
+    const size_t remaining = partition_->size_bytes() - address;
+    if (header.entry_count > remaining / sizeof(EntryRecord) ||
+        header.sector_count > remaining / sizeof(uint32_t) ||
+        header.size() > remaining) {
+      needs_erase_ = true;
+      break;
+    }
+
+    checksum::Crc32 crc;
+    crc.Update(as_bytes(span(&header, 1)).subspan(RecordHeader::kCrcStart));
+    std::array<std::byte, 32> buffer;
+    bool read_error = false;
+    for (size_t offset = sizeof(header); offset < header.size();
+         offset += buffer.size()) {
+      const auto chunk =
+          span(buffer).first(std::min(buffer.size(), header.size() - offset));
+      if (!partition_->Read(address + offset, chunk).ok()) {
+        read_error = true;
+        break;
+      }
+      crc.Update(chunk);
+    }
+    if (read_error || crc.value() != header.crc) {
+      PW_LOG_WARN("Found corrupt checkpoint record at address %u",
+                  unsigned(address));
+      needs_erase_ = true;
+      break;
+    }
+
+    newest = address;
+    newest_header = header;
+    found = true;
+    address += AlignUp(header.size(), partition_->alignment_bytes());
+  }
+
+  next_address_ = address;
+  return found ? OkStatus() : Status::NotFound();
+}
+
+Status Checkpoints::Append(RecordHeader& header,
+                           size_t sector_size_bytes,
+                           const Sectors* sectors,
+                           const EntryCache* entry_cache) {
+  const size_t alignment_bytes = partition_->alignment_bytes();
+  if (alignment_bytes > kMaxFlashAlignment) {
+    return Status::InvalidArgument();
+  }
+
+  const size_t size = AlignUp(header.size(), alignment_bytes);
+  if (size > partition_->size_bytes()) {
+    PW_LOG_ERROR("Checkpoint of %u bytes does not fit in the partition",
+                 unsigned(size));
+    return Status::ResourceExhausted();
+  }
+
+  if (needs_erase_ || next_address_ + size > partition_->size_bytes()) {
+    // Erasing removes the current checkpoint, if any.
+    valid_ = false;
+    PW_TRY(partition_->Erase());
+    needs_erase_ = false;
+    next_address_ = 0;
+  }
+
+  checksum::Crc32 crc;
+  crc.Update(as_bytes(span(&header, 1)).subspan(RecordHeader::kCrcStart));
+  if (sectors != nullptr) {
+    PW_TRY(VisitRecordData(
+        sector_size_bytes, *sectors, *entry_cache, [&crc](ConstByteSpan data) {
+          crc.Update(data);
+          return OkStatus();
+        }));
+  }
+  header.crc = crc.value();
+
+  // If the write fails, the partially written record must be erased before
+  // another record is appended.
+  needs_erase_ = true;
+
+  FlashPartition::Output output(*partition_, next_address_);
+  AlignedWriterBuffer<kMaxFlashAlignment> writer(alignment_bytes, output);
+  PW_TRY(writer.Write(as_bytes(span(&header, 1))).status());
+  if (sectors != nullptr) {
+    PW_TRY(VisitRecordData(sector_size_bytes,
+                           *sectors,
+                           *entry_cache,
+                           [&writer](ConstByteSpan data) {
+                             return writer.Write(data).status();
+                           }));
+  }
+  PW_TRY(writer.Flush().status());
+
+  needs_erase_ = false;
+  next_address_ += size;
+  return OkStatus();
+}
+
+}  // namespace pw::kvs::internal
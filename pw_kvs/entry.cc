@@ -45,7 +45,12 @@ Status Entry::Read(FlashPartition& partition,
   if (partition.AppearsErased(as_bytes(span(&header.magic, 1)))) {
     return Status::NotFound();
   }
-  if (header.key_length_bytes > kMaxKeyLength) {
+  if ((header.key_length_bytes &
+       ~(kMaxKeyLength | kBatchContinuesBit | kKeyInternedBit)) != 0u) {
+    return Status::DataLoss();
+  }
+  if ((header.key_length_bytes & kKeyInternedBit) != 0u &&
+      (header.key_length_bytes & kMaxKeyLength) != sizeof(uint32_t)) {
     return Status::DataLoss();
   }
 
@@ -73,13 +78,27 @@ Status Entry::ReadKey(FlashPartition& partition,
       .status();
 }
 
+Entry::InternedKey::InternedKey(uint32_t key_hash) {
+  std::memcpy(bytes_.data(), &key_hash, sizeof(key_hash));
+}
+
+uint32_t Entry::InternedKeyHash(Key stored_key) {
+  uint32_t key_hash = 0;
+  std::memcpy(&key_hash,
+              stored_key.data(),
+              std::min(stored_key.size(), sizeof(key_hash)));
+  return key_hash;
+}
+
 Entry::Entry(FlashPartition& partition,
              Address address,
              const EntryFormat& format,
              Key key,
              span<const byte> value,
              uint16_t value_size_bytes,
-             uint32_t transaction_id)
+             uint32_t transaction_id,
+             bool batch_continues,
+             bool key_interned)
     : Entry(&partition,
             address,
             format,
@@ -87,7 +106,9 @@ Entry::Entry(FlashPartition& partition,
              .checksum = 0,
              .alignment_units =
                  alignment_bytes_to_units(partition.alignment_bytes()),
-             .key_length_bytes = static_cast<uint8_t>(key.size()),
+             .key_length_bytes = static_cast<uint8_t>(
+                 key.size() | (batch_continues ? kBatchContinuesBit : 0u) |
+                 (key_interned ? kKeyInternedBit : 0u)),
              .value_size_bytes = value_size_bytes,
              .transaction_id = transaction_id}) {
   if (checksum_algo_ != nullptr) {
@@ -106,12 +127,18 @@ StatusWithSize Entry::Write(Key key, span<const byte> value) const {
       {as_bytes(span(&header_, 1)), as_bytes(span(key)), value});
 }
 
+Status Entry::ClearBatchContinues() {
+  header_.key_length_bytes &= static_cast<uint8_t>(~kBatchContinuesBit);
+  return CalculateChecksumFromFlash();
+}
+
 Status Entry::Update(const EntryFormat& new_format,
                      uint32_t new_transaction_id) {
   checksum_algo_ = new_format.checksum;
   header_.magic = new_format.magic;
   header_.alignment_units =
       alignment_bytes_to_units(partition_->alignment_bytes());
+  header_.key_length_bytes &= static_cast<uint8_t>(~kBatchContinuesBit);
   header_.transaction_id = new_transaction_id;
 
   // If we could write the header last, we could avoid reading the entry twice
@@ -188,7 +215,13 @@ Status Entry::VerifyChecksum(Key key, span<const byte> value) const {
   if (checksum_algo_ == nullptr) {
     return header_.checksum == 0 ? OkStatus() : Status::DataLoss();
   }
-  CalculateChecksum(key, value);
+  if (key_interned()) {
+    // The checksum covers the key's hash, which is stored instead of the key.
+    const InternedKey interned_key(Hash(key));
+    CalculateChecksum(interned_key.stored_key(), value);
+  } else {
+    CalculateChecksum(key, value);
+  }
   return checksum_algo_->Verify(checksum_bytes());
 }
 
@@ -250,6 +283,7 @@ void Entry::DebugLog() const {
   PW_LOG_DEBUG("   Magic        = 0x%x", unsigned(magic()));
   PW_LOG_DEBUG("   Checksum     = 0x%x", unsigned(header_.checksum));
   PW_LOG_DEBUG("   Key length   = 0x%x", unsigned(key_length()));
+  PW_LOG_DEBUG("   Key interned = %s", key_interned() ? "yes" : "no");
   PW_LOG_DEBUG("   Value length = 0x%x", unsigned(value_size()));
   PW_LOG_DEBUG("   Entry size   = 0x%x", unsigned(size()));
   PW_LOG_DEBUG("   Alignment    = 0x%x", unsigned(alignment_bytes()));
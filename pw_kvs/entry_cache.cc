@@ -17,6 +17,7 @@
 
 #include "pw_kvs/internal/entry_cache.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "pw_assert/check.h"
@@ -64,58 +65,82 @@ StatusWithSize EntryCache::Find(FlashPartition& partition,
                                 const Sectors& sectors,
                                 const EntryFormats& formats,
                                 Key key,
-                                EntryMetadata* metadata) const {
+                                EntryMetadata* metadata,
+                                const KeyTable* key_table) const {
   const uint32_t hash = internal::Hash(key);
   Entry::KeyBuffer key_buffer;
   bool error_detected = false;
 
-  for (size_t i = 0; i < descriptors_.size(); ++i) {
-    if (descriptors_[i].key_hash == hash) {
-      bool key_found = false;
-      Key read_key;
-
-      for (Address address : addresses(i)) {
-        Status read_result =
-            Entry::ReadKey(partition, address, key.size(), key_buffer.data());
-
-        read_key = Key(key_buffer.data(), key.size());
-
-        if (read_result.ok() && hash == internal::Hash(read_key)) {
+  // Key hashes are unique, so there is at most one matching descriptor.
+  const int index = FindIndex(hash);
+  if (index == -1) {
+    return StatusWithSize::NotFound();
+  }
+  const size_t i = index;
+  bool key_found = false;
+  Key read_key;
+
+  for (Address address : addresses(i)) {
+    // An entry for an interned key stores only the key's hash, so check the
+    // header before reading the key.
+    if (key_table != nullptr) {
+      Entry entry;
+      if (Entry::Read(partition, address, formats, &entry).ok() &&
+          entry.key_interned()) {
+        read_key = key_table->Find(hash);
+        if (!read_key.empty()) {
           key_found = true;
           break;
-        } else {
-          // A hash mismatch can be caused by reading invalid data or a key hash
-          // collision of keys with differing size. To verify the data read from
-          // flash is good, validate the entry.
-          Entry entry;
-          read_result = Entry::Read(partition, address, formats, &entry);
-          if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
-            key_found = true;
-            break;
-          }
-
-          PW_LOG_WARN(
-              "   Found corrupt entry, invalidating this copy of the key");
-          error_detected = true;
-          sectors.FromAddress(address).mark_corrupt();
         }
+        PW_LOG_ERROR("Interned key 0x%08" PRIx32 " is not in the key table",
+                     hash);
+        error_detected = true;
+        continue;
       }
-      size_t error_val = error_detected ? 1 : 0;
-
-      if (!key_found) {
-        PW_LOG_ERROR("No valid entries for key. Data has been lost!");
-        return StatusWithSize::DataLoss(error_val);
-      } else if (key == read_key) {
-        PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
-        *metadata = EntryMetadata(descriptors_[i], addresses(i));
-        return StatusWithSize(error_val);
-      } else {
-        PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
-        return StatusWithSize::AlreadyExists(error_val);
+    }
+
+    Status read_result =
+        Entry::ReadKey(partition, address, key.size(), key_buffer.data());
+
+    read_key = Key(key_buffer.data(), key.size());
+
+    if (read_result.ok() && hash == internal::Hash(read_key)) {
+      key_found = true;
+      break;
+    } else {
+      // A hash mismatch can be caused by reading invalid data or a key hash
+      // collision of keys with differing size. To verify the data read from
+      // flash is good, validate the entry.
+      Entry entry;
+      read_result = Entry::Read(partition, address, formats, &entry);
+      if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
+        key_found = true;
+        break;
       }
+
+      PW_LOG_WARN("   Found corrupt entry, invalidating this copy of the key");
+      error_detected = true;
+      sectors.FromAddress(address).mark_corrupt();
     }
   }
-  return StatusWithSize::NotFound();
+  size_t error_val = error_detected ? 1 : 0;
+
+  if (!key_found) {
+    PW_LOG_ERROR("No valid entries for key. Data has been lost!");
+    return StatusWithSize::DataLoss(error_val);
+  } else if (key == read_key) {
+    PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
+    *metadata = EntryMetadata(descriptors_[i], addresses(i));
+    return StatusWithSize(error_val);
+  } else {
+    PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
+    return StatusWithSize::AlreadyExists(error_val);
+  }
+}
+
+void EntryCache::Reset() const {
+  descriptors_.clear();
+  std::fill(hash_index_.begin(), hash_index_.end(), 0);
 }
 
 EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
@@ -123,6 +148,7 @@ EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
   // TODO(hepler): DCHECK(!full());
   Address* first_address = ResetAddresses(descriptors_.size(), address);
   descriptors_.push_back(descriptor);
+  IndexInsert(descriptors_.size() - 1);
   return EntryMetadata(descriptors_.back(), span(first_address, 1));
 }
 
@@ -138,11 +164,16 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
   // deleted descriptor's space and then pops the last entry.
   Address* addresses_at_end = first_address(descriptors_.size() - 1);
 
+  IndexRemove(index_to_remove);
+
   if (index_to_remove < descriptors_.size() - 1) {
     Address* addresses_to_remove = first_address(index_to_remove);
     for (unsigned int i = 0; i < redundancy_; i++) {
       addresses_to_remove[i] = addresses_at_end[i];
     }
+    if (!hash_index_.empty()) {
+      hash_index_[FindSlot(descriptors_.size() - 1)] = index_to_remove + 1;
+    }
     descriptors_[index_to_remove] = last_desc;
   }
 
@@ -152,10 +183,10 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
   return {this, descriptors_.data() + index_to_remove};
 }
 
-// TODO(hepler): This method is the trigger of the O(valid_entries *
-// all_entries) time complexity for reading. At some cost to memory, this could
-// be optimized by using a hash table instead of scanning, but in practice this
-// should be fine for a small number of keys
+// Without a hash index, this method is the trigger of the
+// O(valid_entries * all_entries) time complexity for reading. This is fine for
+// a small number of keys; KVSs with many keys should set kUseHashIndex in their
+// KeyValueStoreBuffer.
 Status EntryCache::AddNewOrUpdateExisting(const KeyDescriptor& descriptor,
                                           Address address,
                                           size_t sector_size_bytes) const {
@@ -220,7 +251,21 @@ size_t EntryCache::present_entries() const {
 }
 
 int EntryCache::FindIndex(uint32_t key_hash) const {
-  for (size_t i = 0; i < descriptors_.size(); ++i) {
+  if (hash_index_.empty()) {
+    for (size_t i = 0; i < descriptors_.size(); ++i) {
+      if (descriptors_[i].key_hash == key_hash) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // The index always has empty slots, so probing ends at one if the hash isn't
+  // present.
+  const size_t mask = hash_index_.size() - 1;
+  for (size_t slot = HomeSlot(key_hash); hash_index_[slot] != 0;
+       slot = (slot + 1) & mask) {
+    const size_t i = hash_index_[slot] - 1;
     if (descriptors_[i].key_hash == key_hash) {
       return i;
     }
@@ -228,6 +273,49 @@ int EntryCache::FindIndex(uint32_t key_hash) const {
   return -1;
 }
 
+size_t EntryCache::FindSlot(size_t descriptor_index) const {
+  const size_t mask = hash_index_.size() - 1;
+  size_t slot = HomeSlot(descriptors_[descriptor_index].key_hash);
+  while (hash_index_[slot] != descriptor_index + 1) {
+    PW_DCHECK_UINT_NE(hash_index_[slot], 0u);
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void EntryCache::IndexInsert(size_t descriptor_index) const {
+  if (hash_index_.empty()) {
+    return;
+  }
+  const size_t mask = hash_index_.size() - 1;
+  size_t slot = HomeSlot(descriptors_[descriptor_index].key_hash);
+  while (hash_index_[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  hash_index_[slot] = descriptor_index + 1;
+}
+
+void EntryCache::IndexRemove(size_t descriptor_index) const {
+  if (hash_index_.empty()) {
+    return;
+  }
+
+  // Linear probing without tombstones: shift later entries in the probe
+  // sequence back into the hole, unless that would move an entry before its
+  // home slot.
+  const size_t mask = hash_index_.size() - 1;
+  size_t hole = FindSlot(descriptor_index);
+  for (size_t slot = (hole + 1) & mask; hash_index_[slot] != 0;
+       slot = (slot + 1) & mask) {
+    const size_t home = HomeSlot(descriptors_[hash_index_[slot] - 1].key_hash);
+    if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+      hash_index_[hole] = hash_index_[slot];
+      hole = slot;
+    }
+  }
+  hash_index_[hole] = 0;
+}
+
 void EntryCache::AddAddressIfRoom(size_t descriptor_index,
                                   Address address) const {
   Address* const existing = first_address(descriptor_index);
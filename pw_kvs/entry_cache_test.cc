@@ -194,6 +194,116 @@ TEST_F(EmptyEntryCache, Iterator_Const_CanBeAssignedFromMutable) {
   EXPECT_EQ(99u, it->first_address());
 }
 
+class HashIndexEntryCache : public ::testing::Test {
+ protected:
+  static constexpr size_t kMaxEntries = 32;
+  static constexpr size_t kRedundancy = 1;
+
+  HashIndexEntryCache()
+      : entries_(descriptors_, addresses_, kRedundancy, hash_index_) {}
+
+  // Adds or updates an entry with the hash and returns the number of entries.
+  size_t AddOrUpdate(uint32_t hash, uint32_t transaction_id) {
+    EXPECT_EQ(OkStatus(),
+              entries_.AddNewOrUpdateExisting(
+                  {hash, transaction_id, EntryState::kValid}, hash, 1));
+    return entries_.total_entries();
+  }
+
+  // Returns the transaction ID of the entry with the hash, or 0 if there is no
+  // such entry.
+  uint32_t TransactionId(uint32_t hash) const {
+    for (const EntryMetadata& entry : entries_) {
+      if (entry.hash() == hash) {
+        return entry.transaction_id();
+      }
+    }
+    return 0;
+  }
+
+  void Remove(uint32_t hash) {
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->hash() == hash) {
+        entries_.RemoveEntry(it);
+        return;
+      }
+    }
+    FAIL() << "No entry for hash " << hash;
+  }
+
+  Vector<KeyDescriptor, kMaxEntries> descriptors_;
+  EntryCache::AddressList<kMaxEntries, kRedundancy> addresses_;
+  EntryCache::HashIndex<kMaxEntries> hash_index_{};
+
+  EntryCache entries_;
+};
+
+TEST_F(HashIndexEntryCache, Size) {
+  static_assert(sizeof(hash_index_) == 64 * sizeof(uint16_t));
+  static_assert(EntryCache::HashIndexSlots(33) == 128);
+}
+
+TEST_F(HashIndexEntryCache, AddNewOrUpdateExisting_FindsCollidingSlots) {
+  // These hashes all start probing at the same slot.
+  constexpr uint32_t kHashes[] = {1, 65, 129, 193};
+  for (uint32_t hash : kHashes) {
+    AddOrUpdate(hash, 1);
+  }
+  ASSERT_EQ(4u, entries_.total_entries());
+
+  for (uint32_t hash : kHashes) {
+    EXPECT_EQ(4u, AddOrUpdate(hash, 2));
+    EXPECT_EQ(2u, TransactionId(hash));
+  }
+}
+
+TEST_F(HashIndexEntryCache, RemoveEntry_KeepsProbeSequences) {
+  // 2 starts in the slot after 1, so it is displaced by 65 and 129.
+  constexpr uint32_t kHashes[] = {1, 65, 129, 2, 3};
+  for (uint32_t hash : kHashes) {
+    AddOrUpdate(hash, 1);
+  }
+
+  Remove(65);
+  Remove(1);
+  EXPECT_EQ(0u, TransactionId(65));
+  EXPECT_EQ(0u, TransactionId(1));
+
+  // The remaining entries are still found, including the descriptors that were
+  // moved to fill the removed descriptors' places.
+  for (uint32_t hash : {129u, 2u, 3u}) {
+    EXPECT_EQ(3u, AddOrUpdate(hash, 2));
+    EXPECT_EQ(2u, TransactionId(hash));
+  }
+
+  // Removed hashes are added as new entries.
+  EXPECT_EQ(4u, AddOrUpdate(65, 3));
+  EXPECT_EQ(5u, AddOrUpdate(1, 3));
+}
+
+TEST_F(HashIndexEntryCache, Full) {
+  for (uint32_t i = 0; i < kMaxEntries; ++i) {
+    AddOrUpdate(i * 64, 1);
+  }
+  ASSERT_TRUE(entries_.full());
+  EXPECT_EQ(Status::ResourceExhausted(),
+            entries_.AddNewOrUpdateExisting(
+                {1, 1, EntryState::kValid}, 1000, 1));
+
+  for (uint32_t i = 0; i < kMaxEntries; ++i) {
+    EXPECT_EQ(kMaxEntries, AddOrUpdate(i * 64, 2));
+  }
+}
+
+TEST_F(HashIndexEntryCache, Reset_ClearsIndex) {
+  AddOrUpdate(1, 1);
+  AddOrUpdate(65, 1);
+  entries_.Reset();
+
+  EXPECT_EQ(1u, AddOrUpdate(65, 1));
+  EXPECT_EQ(2u, AddOrUpdate(1, 1));
+}
+
 constexpr size_t kSectorSize = 64;
 constexpr uint32_t kMagic = 0xa14ae726;
 // For KVS entry magic value always use a random 32 bit integer rather than a
@@ -68,6 +68,21 @@ StatusWithSize FlashPartition::Reader::DoRead(ByteSpan data) {
 
 #endif  // PW_CXX_STANDARD_IS_SUPPORTED(17)
 
+Result<ConstByteSpan> FlashMemory::GetMemoryMappedRegion(Address address,
+                                                       size_t len) const {
+  if (address < start_address() ||
+      address - start_address() > size_bytes() ||
+      len > size_bytes() - (address - start_address())) {
+    return Status::OutOfRange();
+  }
+
+  const byte* mcu_address = FlashAddressToMcuAddress(address);
+  if (mcu_address == nullptr) {
+    return Status::Unimplemented();
+  }
+  return ConstByteSpan(mcu_address, len);
+}
+
 StatusWithSize FlashPartition::Output::DoWrite(span<const byte> data) {
   PW_TRY_WITH_SIZE(flash_.Write(address_, data));
   address_ += data.size();
@@ -119,6 +134,31 @@ StatusWithSize FlashPartition::Read(Address address, span<byte> output) {
   return flash_.Read(PartitionToFlashAddress(address), output);
 }
 
+Result<ConstByteSpan> FlashPartition::GetMemoryMappedRegion(Address address,
+                                                          size_t len) const {
+  PW_TRY(CheckBounds(address, len));
+
+  const FlashMemory::Address flash_address = PartitionToFlashAddress(address);
+  const byte* mcu_address = flash_.FlashAddressToMcuAddress(flash_address);
+  if (mcu_address == nullptr) {
+    return Status::Unimplemented();
+  }
+
+  // Partitions that reserve space in each sector map their address space onto
+  // flash in pieces, so only hand out regions that map onto a single run of
+  // flash and MCU addresses.
+  if (len > 0) {
+    const FlashMemory::Address last_flash_address =
+        PartitionToFlashAddress(address + len - 1);
+    if (last_flash_address - flash_address != len - 1 ||
+        flash_.FlashAddressToMcuAddress(last_flash_address) !=
+            mcu_address + len - 1) {
+      return Status::Unimplemented();
+    }
+  }
+  return ConstByteSpan(mcu_address, len);
+}
+
 StatusWithSize FlashPartition::Write(Address address, span<const byte> data) {
   if (permission_ == PartitionPermission::kReadOnly) {
     return StatusWithSize::PermissionDenied();
@@ -503,6 +503,90 @@ TEST_F(FlashStreamTest, Invald_Ops) {
   ASSERT_EQ(writer.ConservativeReadLimit(), 0U);
 }
 
+TEST_F(FlashStreamTest, MemoryMappedRegion) {
+  InitBufferToRandom(flash_.buffer(), 0x5a5a);
+
+  Result<ConstByteSpan> region = partition_.GetMemoryMappedRegion(16, 32);
+  ASSERT_EQ(region.status(), OkStatus());
+  EXPECT_EQ(region->data(), flash_.buffer().data() + 16);
+  EXPECT_EQ(region->size(), 32u);
+
+  region = partition_.GetMemoryMappedRegion(0, kFPDataSize);
+  ASSERT_EQ(region.status(), OkStatus());
+  VerifyFlashContent(*region);
+
+  region = partition_.GetMemoryMappedRegion(kFPDataSize, 0);
+  ASSERT_EQ(region.status(), OkStatus());
+  EXPECT_TRUE(region->empty());
+}
+
+TEST_F(FlashStreamTest, MemoryMappedRegion_Out_Of_Range) {
+  EXPECT_EQ(partition_.GetMemoryMappedRegion(0, kFPDataSize + 1).status(),
+            Status::OutOfRange());
+  EXPECT_EQ(partition_.GetMemoryMappedRegion(kFPDataSize - 8, 16).status(),
+            Status::OutOfRange());
+  EXPECT_EQ(flash_.GetMemoryMappedRegion(kFPDataSize, 1).status(),
+            Status::OutOfRange());
+}
+
+class UnmappedFlash : public FakeFlashMemoryBuffer<512, 4> {
+ public:
+  std::byte* FlashAddressToMcuAddress(Address) const override {
+    return nullptr;
+  }
+};
+
+TEST(FlashMemoryMappedRegion, Unmapped_Flash) {
+  UnmappedFlash flash;
+  FlashPartition partition(&flash);
+
+  EXPECT_EQ(flash.GetMemoryMappedRegion(0, 16).status(),
+            Status::Unimplemented());
+  EXPECT_EQ(partition.GetMemoryMappedRegion(0, 16).status(),
+            Status::Unimplemented());
+}
+
+// Reserves the first kReservedBytes of each flash sector, so the partition's
+// address space is split across the sectors.
+class ReservedSpacePartition : public FlashPartition {
+ public:
+  static constexpr size_t kReservedBytes = 16;
+
+  explicit ReservedSpacePartition(FlashMemory& flash)
+      : FlashPartition(&flash) {}
+
+  size_t sector_size_bytes() const override {
+    return flash().sector_size_bytes() - kReservedBytes;
+  }
+
+  FlashMemory::Address PartitionToFlashAddress(
+      Address address) const override {
+    return (address / sector_size_bytes()) * flash().sector_size_bytes() +
+           kReservedBytes + address % sector_size_bytes();
+  }
+};
+
+TEST(FlashMemoryMappedRegion, Partition_With_Reserved_Space) {
+  FakeFlashMemoryBuffer<512, 4> flash;
+  ReservedSpacePartition partition(flash);
+  const size_t sector_size = partition.sector_size_bytes();
+
+  Result<ConstByteSpan> region = partition.GetMemoryMappedRegion(0, 32);
+  ASSERT_EQ(region.status(), OkStatus());
+  EXPECT_EQ(region->data(),
+            flash.buffer().data() + ReservedSpacePartition::kReservedBytes);
+
+  region = partition.GetMemoryMappedRegion(sector_size, sector_size);
+  ASSERT_EQ(region.status(), OkStatus());
+  EXPECT_EQ(region->data(),
+            flash.buffer().data() + flash.sector_size_bytes() +
+                ReservedSpacePartition::kReservedBytes);
+
+  // Regions that span a sector boundary are not contiguous in memory.
+  EXPECT_EQ(partition.GetMemoryMappedRegion(sector_size - 8, 16).status(),
+            Status::Unimplemented());
+}
+
 }  // namespace
 }  // namespace pw::kvs
 
@@ -26,7 +26,8 @@
 namespace pw::kvs {
 
 Status FlashPartitionWithStats::SaveStorageStats(const KeyValueStore& kvs,
-                                                 const char* label) {
+                                                 const char* label,
+                                                 const char* file_name) {
   // If empty, saving stats is disabled so do not save any stats.
   if (sector_counters_.empty()) {
     return OkStatus();
@@ -35,7 +36,6 @@ Status FlashPartitionWithStats::SaveStorageStats(const KeyValueStore& kvs,
   KeyValueStore::StorageStats stats = kvs.GetStorageStats();
   size_t utilization_percentage = (stats.in_use_bytes * 100) / size_bytes();
 
-  const char* file_name = "flash_stats.csv";
   std::FILE* out_file = std::fopen(file_name, "a+");
   if (out_file == nullptr) {
     PW_LOG_ERROR("Failed to dump to %s", file_name);
@@ -0,0 +1,123 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#define PW_LOG_MODULE_NAME "KVS"
+#define PW_LOG_LEVEL PW_KVS_LOG_LEVEL
+
+#include "pw_kvs/internal/key_table.h"
+
+#include <cstring>
+
+#include "pw_kvs/internal/entry.h"
+#include "pw_kvs/internal/hash.h"
+#include "pw_kvs_private/config.h"
+#include "pw_log/log.h"
+
+namespace pw::kvs::internal {
+
+Key KeyTable::Find(uint32_t hash) const {
+  const size_t offset = FindRecord(hash);
+  if (offset == kNotFound) {
+    return Key();
+  }
+  return KeyAt(offset, ReadHeader(offset));
+}
+
+bool KeyTable::Contains(Key key) const {
+  const Key interned = Find(Hash(key));
+  return !interned.empty() && interned == key;
+}
+
+Status KeyTable::Add(Key key) {
+  if (!writable_) {
+    return Status::FailedPrecondition();
+  }
+
+  const uint32_t hash = Hash(key);
+  const Key interned = Find(hash);
+  if (!interned.empty()) {
+    return interned == key ? OkStatus() : Status::AlreadyExists();
+  }
+
+  if (buffer_.size() - used_bytes_ < kRecordHeaderSize + key.size()) {
+    return Status::ResourceExhausted();
+  }
+
+  std::byte* record = buffer_.data() + used_bytes_;
+  const uint8_t key_size = static_cast<uint8_t>(key.size());
+  std::memcpy(record, &hash, sizeof(hash));
+  std::memcpy(record + sizeof(hash), &key_size, sizeof(key_size));
+  std::memcpy(record + kRecordHeaderSize, key.data(), key.size());
+  used_bytes_ += kRecordHeaderSize + key.size();
+  return OkStatus();
+}
+
+Status KeyTable::Load(StatusWithSize read_result) {
+  used_bytes_ = 0;
+  stored_ = true;
+  writable_ = false;
+
+  if (!read_result.ok()) {
+    PW_LOG_ERROR("Failed to read the key table: %s",
+                 read_result.status().str());
+    return Status::DataLoss();
+  }
+
+  // Check that every record is complete and matches its hash, and that no
+  // hash appears twice.
+  size_t offset = 0;
+  while (offset < read_result.size()) {
+    if (read_result.size() - offset < kRecordHeaderSize) {
+      return Status::DataLoss();
+    }
+    const RecordHeader header = ReadHeader(offset);
+    if (header.key_size == 0u || header.key_size > Entry::kMaxKeyLength ||
+        read_result.size() - offset - kRecordHeaderSize < header.key_size ||
+        Hash(KeyAt(offset, header)) != header.hash ||
+        FindRecord(header.hash) != kNotFound) {
+      PW_LOG_ERROR("Found corrupt key table record at offset %u",
+                   unsigned(offset));
+      return Status::DataLoss();
+    }
+    // Each record is only searched for once it is complete.
+    offset += kRecordHeaderSize + header.key_size;
+    used_bytes_ = offset;
+  }
+
+  writable_ = true;
+  return OkStatus();
+}
+
+size_t KeyTable::FindRecord(uint32_t hash) const {
+  size_t offset = 0;
+  while (offset < used_bytes_) {
+    const RecordHeader header = ReadHeader(offset);
+    if (header.hash == hash) {
+      return offset;
+    }
+    offset += kRecordHeaderSize + header.key_size;
+  }
+  return kNotFound;
+}
+
+KeyTable::RecordHeader KeyTable::ReadHeader(size_t offset) const {
+  RecordHeader header;
+  std::memcpy(&header.hash, buffer_.data() + offset, sizeof(header.hash));
+  std::memcpy(&header.key_size,
+              buffer_.data() + offset + sizeof(header.hash),
+              sizeof(header.key_size));
+  return header;
+}
+
+}  // namespace pw::kvs::internal
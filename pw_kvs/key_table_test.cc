@@ -0,0 +1,280 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_kvs/internal/key_table.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+using internal::KeyTable;
+using test::RebootableKvs;
+
+// Each key table record is a 5 byte header, followed by the key.
+constexpr std::string_view kKey1 = "first_key_long_enough_to_intern";
+constexpr std::string_view kKey2 = "second_key_long_enough_to_intern";
+
+TEST(KeyTable, Disabled) {
+  KeyTable table({});
+  EXPECT_FALSE(table.enabled());
+  EXPECT_EQ(Status::ResourceExhausted(), table.Add(kKey1));
+  EXPECT_FALSE(table.Contains(kKey1));
+}
+
+TEST(KeyTable, Add_Find) {
+  std::array<std::byte, 128> buffer;
+  KeyTable table(buffer);
+  ASSERT_TRUE(table.enabled());
+
+  ASSERT_EQ(OkStatus(), table.Add(kKey1));
+  ASSERT_EQ(OkStatus(), table.Add(kKey2));
+  EXPECT_EQ(2 * 5 + kKey1.size() + kKey2.size(), table.used_bytes());
+
+  EXPECT_EQ(Key(kKey1), table.Find(internal::Hash(kKey1)));
+  EXPECT_EQ(Key(kKey2), table.Find(internal::Hash(kKey2)));
+  EXPECT_TRUE(table.Find(internal::Hash("other")).empty());
+  EXPECT_TRUE(table.Contains(kKey1));
+  EXPECT_FALSE(table.Contains("other"));
+}
+
+TEST(KeyTable, Add_SameKeyTwice) {
+  std::array<std::byte, 128> buffer;
+  KeyTable table(buffer);
+  ASSERT_EQ(OkStatus(), table.Add(kKey1));
+  EXPECT_EQ(OkStatus(), table.Add(kKey1));
+  EXPECT_EQ(5 + kKey1.size(), table.used_bytes());
+}
+
+TEST(KeyTable, Add_Full) {
+  std::array<std::byte, 5 + kKey1.size() + 4> buffer;
+  KeyTable table(buffer);
+  ASSERT_EQ(OkStatus(), table.Add(kKey1));
+  EXPECT_EQ(Status::ResourceExhausted(), table.Add(kKey2));
+  EXPECT_FALSE(table.Contains(kKey2));
+}
+
+TEST(KeyTable, Truncate) {
+  std::array<std::byte, 128> buffer;
+  KeyTable table(buffer);
+  ASSERT_EQ(OkStatus(), table.Add(kKey1));
+  const size_t used_bytes = table.used_bytes();
+  ASSERT_EQ(OkStatus(), table.Add(kKey2));
+
+  table.Truncate(used_bytes);
+  EXPECT_TRUE(table.Contains(kKey1));
+  EXPECT_FALSE(table.Contains(kKey2));
+}
+
+TEST(KeyTable, Load) {
+  std::array<std::byte, 128> buffer;
+  KeyTable table(buffer);
+  ASSERT_EQ(OkStatus(), table.Add(kKey1));
+  ASSERT_EQ(OkStatus(), table.Add(kKey2));
+
+  std::array<std::byte, 128> loaded_buffer;
+  KeyTable loaded(loaded_buffer);
+  std::memcpy(loaded.buffer().data(),
+              table.contents().data(),
+              table.contents().size());
+  ASSERT_EQ(OkStatus(), loaded.Load(StatusWithSize(table.contents().size())));
+
+  EXPECT_TRUE(loaded.stored());
+  EXPECT_TRUE(loaded.Contains(kKey1));
+  EXPECT_TRUE(loaded.Contains(kKey2));
+  EXPECT_EQ(OkStatus(), loaded.Add("third_key_long_enough_to_intern"));
+}
+
+TEST(KeyTable, Load_Corrupt) {
+  std::array<std::byte, 128> buffer;
+  KeyTable table(buffer);
+  ASSERT_EQ(OkStatus(), table.Add(kKey1));
+  const size_t size = table.used_bytes();
+  buffer[size - 1] ^= std::byte{1};  // Change the key so the hash mismatches.
+
+  EXPECT_EQ(Status::DataLoss(), table.Load(StatusWithSize(size)));
+  EXPECT_FALSE(table.Contains(kKey1));
+  EXPECT_EQ(Status::FailedPrecondition(), table.Add(kKey2));
+}
+
+TEST(KeyTable, Load_Truncated) {
+  std::array<std::byte, 128> buffer;
+  KeyTable table(buffer);
+  ASSERT_EQ(OkStatus(), table.Add(kKey1));
+
+  EXPECT_EQ(Status::DataLoss(),
+            table.Load(StatusWithSize(table.used_bytes() - 1)));
+  EXPECT_EQ(Status::FailedPrecondition(), table.Add(kKey2));
+}
+
+TEST(KeyTable, Load_ReadFailed) {
+  std::array<std::byte, 128> buffer;
+  KeyTable table(buffer);
+  EXPECT_EQ(Status::DataLoss(),
+            table.Load(StatusWithSize::ResourceExhausted(128)));
+  EXPECT_TRUE(table.stored());
+  EXPECT_EQ(Status::FailedPrecondition(), table.Add(kKey1));
+}
+
+using Value = std::array<uint32_t, 4>;
+
+constexpr Value kValue1 = {1, 1, 1, 1};
+constexpr Value kValue2 = {2, 2, 2, 2};
+
+class KvsKeyTable : public ::testing::Test {
+ protected:
+  KvsKeyTable()
+      : flash_(16), partition_(&flash_), kvs_(partition_, 0x3e7a19c2) {
+    EXPECT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+    Reboot();
+  }
+
+  // Reboots the KVS with its key table enabled.
+  void Reboot() {
+    Options options;
+    options.key_table_buffer = key_table_buffer_;
+    EXPECT_EQ(OkStatus(), kvs_.Reboot(options));
+  }
+
+  // Returns the number of bytes that writing a key took.
+  size_t BytesToPut(std::string_view key, const Value& value) {
+    const size_t writable_bytes = kvs_->GetStorageStats().writable_bytes;
+    EXPECT_EQ(OkStatus(), kvs_->Put(key, value));
+    return writable_bytes - kvs_->GetStorageStats().writable_bytes;
+  }
+
+  FakeFlashMemoryBuffer<512, 4> flash_;
+  FlashPartition partition_;
+  std::array<std::byte, 128> key_table_buffer_;
+  RebootableKvs<KeyValueStoreBuffer<8, 4>> kvs_;
+};
+
+TEST_F(KvsKeyTable, Put_UpdatedKeyIsInterned) {
+  const size_t full_entry_bytes = BytesToPut(kKey1, kValue1);
+  EXPECT_EQ(1u, kvs_->size());
+
+  // The first update writes the key table, as well as the entry.
+  BytesToPut(kKey1, kValue2);
+  EXPECT_EQ(1u, kvs_->size());
+  EXPECT_EQ(7u, kvs_->max_size());
+
+  EXPECT_LT(BytesToPut(kKey1, kValue1), full_entry_bytes);
+
+  Value value{};
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey1, &value));
+  EXPECT_EQ(kValue1, value);
+  EXPECT_EQ(sizeof(Value), kvs_->ValueSize(kKey1).size());
+}
+
+TEST_F(KvsKeyTable, Put_ShortKeyIsNotInterned) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue2));
+  EXPECT_EQ(1u, kvs_->size());
+  EXPECT_EQ(8u, kvs_->max_size());
+}
+
+TEST_F(KvsKeyTable, Init_LoadsKeyTable) {
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, kValue2));
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey2, kValue1));
+
+  Reboot();
+  EXPECT_FALSE(kvs_->error_detected());
+  EXPECT_EQ(2u, kvs_->size());
+
+  Value value{};
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey1, &value));
+  EXPECT_EQ(kValue2, value);
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey2, &value));
+  EXPECT_EQ(kValue1, value);
+
+  // Interning another key after a reboot keeps the keys interned before it.
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey2, kValue2));
+  Reboot();
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey1, &value));
+  EXPECT_EQ(kValue2, value);
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey2, &value));
+  EXPECT_EQ(kValue2, value);
+}
+
+TEST_F(KvsKeyTable, Iteration_ReturnsKeysButNotKeyTable) {
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, kValue2));
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey2, kValue1));
+
+  size_t count = 0;
+  for (const auto& item : *kvs_) {
+    const std::string_view key = item.key();
+    EXPECT_TRUE(key == kKey1 || key == kKey2);
+    Value value{};
+    EXPECT_EQ(OkStatus(), item.Get(&value));
+    EXPECT_EQ(key == kKey1 ? kValue2 : kValue1, value);
+    count += 1;
+  }
+  EXPECT_EQ(2u, count);
+}
+
+TEST_F(KvsKeyTable, KeyTableKeyIsReserved) {
+  Value value{};
+  EXPECT_EQ(Status::InvalidArgument(),
+            kvs_->Put(KeyTable::kStorageKey, kValue1));
+  EXPECT_EQ(Status::InvalidArgument(),
+            kvs_->Get(KeyTable::kStorageKey, &value));
+}
+
+TEST_F(KvsKeyTable, Delete_InternedKey) {
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, kValue2));
+  ASSERT_EQ(OkStatus(), kvs_->Delete(kKey1));
+
+  Value value{};
+  EXPECT_EQ(Status::NotFound(), kvs_->Get(kKey1, &value));
+  EXPECT_EQ(0u, kvs_->size());
+
+  Reboot();
+  EXPECT_EQ(Status::NotFound(), kvs_->Get(kKey1, &value));
+  ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey1, &value));
+  EXPECT_EQ(kValue1, value);
+}
+
+TEST_F(KvsKeyTable, GarbageCollection_KeepsInternedKeys) {
+  Value value = kValue1;
+  for (uint32_t i = 0; i < 100; ++i) {
+    value[0] = i;
+    ASSERT_EQ(OkStatus(), kvs_->Put(kKey1, value));
+    ASSERT_EQ(OkStatus(), kvs_->Put(kKey2, kValue2));
+  }
+  ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+
+  Reboot();
+  EXPECT_FALSE(kvs_->error_detected());
+  EXPECT_EQ(2u, kvs_->size());
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey1, &value));
+  EXPECT_EQ(99u, value[0]);
+  ASSERT_EQ(OkStatus(), kvs_->Get(kKey2, &value));
+  EXPECT_EQ(kValue2, value);
+}
+
+}  // namespace
+}  // namespace pw::kvs
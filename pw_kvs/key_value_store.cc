@@ -31,11 +31,14 @@ namespace pw::kvs {
 namespace {
 
 using std::byte;
+using internal::KeyTable;
 
 constexpr bool InvalidKey(Key key) {
   return key.empty() || (key.size() > internal::Entry::kMaxKeyLength);
 }
 
+constexpr uint32_t kKeyTableHash = internal::Hash(KeyTable::kStorageKey);
+
 }  // namespace
 
 KeyValueStore::KeyValueStore(FlashPartition* partition,
@@ -45,12 +48,17 @@ KeyValueStore::KeyValueStore(FlashPartition* partition,
                              Vector<SectorDescriptor>& sector_descriptor_list,
                              const SectorDescriptor** temp_sectors_to_skip,
                              Vector<KeyDescriptor>& key_descriptor_list,
-                             Address* addresses)
+                             Address* addresses,
+                             span<uint16_t> hash_index)
     : partition_(*partition),
       formats_(formats),
       sectors_(sector_descriptor_list, *partition, temp_sectors_to_skip),
-      entry_cache_(key_descriptor_list, addresses, redundancy),
+      entry_cache_(key_descriptor_list, addresses, redundancy, hash_index),
       options_(options),
+      checkpoints_(options.checkpoint_partition),
+      value_cache_(options.value_cache_buffer),
+      key_table_(options.key_table_buffer),
+      background_gc_sector_(nullptr),
       initialized_(InitializationState::kNotInitialized),
       error_detected_(false),
       internal_stats_({}),
@@ -93,6 +101,7 @@ Status KeyValueStore::Init() {
   }
 
   Status metadata_result = InitializeMetadata();
+  LoadKeyTable();
 
   if (!error_detected_) {
     initialized_ = InitializationState::kReady;
@@ -148,7 +157,26 @@ Status KeyValueStore::InitializeMetadata() {
 
   sectors_.Reset();
   entry_cache_.Reset();
+  value_cache_.Clear();
+  background_gc_sector_ = nullptr;
+
+  if (checkpoints_.enabled()) {
+    Status checkpoint_status =
+        checkpoints_.Load(partition_, formats_, sectors_, entry_cache_);
+    if (checkpoint_status.ok()) {
+      PW_LOG_INFO("Loaded checkpoint with %u entries",
+                  unsigned(entry_cache_.total_entries()));
+    } else {
+      if (!checkpoint_status.IsNotFound()) {
+        PW_LOG_WARN("Checkpoint could not be loaded; reading all entries");
+      }
+      sectors_.Reset();
+      entry_cache_.Reset();
+    }
+  }
 
+  // Entries before each sector's next writable address are already loaded from
+  // the checkpoint, if there is one.
   PW_LOG_DEBUG("First pass: Read all entries from all sectors");
   Address sector_address = 0;
 
@@ -158,9 +186,10 @@ Status KeyValueStore::InitializeMetadata() {
   size_t entry_copies_missing = 0;
 
   for (SectorDescriptor& sector : sectors_) {
-    Address entry_address = sector_address;
+    Address entry_address = sectors_.NextWritableAddress(sector);
 
     size_t sector_corrupt_bytes = 0;
+    std::optional<Address> batch_start;
 
     for (int num_entries_in_sector = 0; true; num_entries_in_sector++) {
       PW_LOG_DEBUG("Load entry: sector=%u, entry#=%d, address=%u",
@@ -174,7 +203,8 @@ Status KeyValueStore::InitializeMetadata() {
       }
 
       Address next_entry_address;
-      Status status = LoadEntry(entry_address, &next_entry_address);
+      Status status =
+          LoadEntry(entry_address, &next_entry_address, batch_start);
       if (status.IsNotFound()) {
         PW_LOG_DEBUG(
             "Hit un-written data in sector; moving to the next sector");
@@ -187,6 +217,9 @@ Status KeyValueStore::InitializeMetadata() {
         error_detected_ = true;
         corrupt_entries++;
 
+        // A batch with a corrupt entry is incomplete, so it is discarded.
+        batch_start.reset();
+
         status = ScanForEntry(sector,
                               entry_address + Entry::kMinAlignmentBytes,
                               &next_entry_address);
@@ -210,6 +243,15 @@ Status KeyValueStore::InitializeMetadata() {
                                 (entry_address - sector_address));
     }
 
+    if (batch_start.has_value()) {
+      // The sector ends with a batch that was not completely written, so its
+      // entries are ignored. Nothing more may be written to the sector, since
+      // the next entry would appear to complete the batch.
+      PW_LOG_WARN("Sector %u ends with an incomplete batch; discarding it",
+                  sectors_.Index(sector));
+      sector.set_writable_bytes(0);
+    }
+
     if (sector_corrupt_bytes > 0) {
       // If the sector contains corrupt data, prevent any further entries from
       // being written to it by indicating that it has no space. This should
@@ -361,7 +403,8 @@ bool KeyValueStore::CheckForErrors() {
 }
 
 Status KeyValueStore::LoadEntry(Address entry_address,
-                                Address* next_entry_address) {
+                                Address* next_entry_address,
+                                std::optional<Address>& batch_start) {
   Entry entry;
   PW_TRY(Entry::Read(partition_, entry_address, formats_, &entry));
 
@@ -375,6 +418,35 @@ Status KeyValueStore::LoadEntry(Address entry_address,
   // A valid entry was found, so update the next entry address before doing any
   // of the checks that happen in AddNewOrUpdateExisting.
   *next_entry_address = entry.next_address();
+
+  if (entry.batch_continues()) {
+    if (!batch_start.has_value()) {
+      batch_start = entry_address;
+    }
+    return OkStatus();
+  }
+
+  // This entry completes a batch, so the batch's earlier entries, which were
+  // already verified, take effect.
+  if (batch_start.has_value()) {
+    Address address = *batch_start;
+    batch_start.reset();
+
+    while (address != entry_address) {
+      Entry batch_entry;
+      PW_TRY(Entry::Read(partition_, address, formats_, &batch_entry));
+      Entry::KeyBuffer batch_key_buffer;
+      PW_TRY_ASSIGN(size_t batch_key_length,
+                    batch_entry.ReadKey(batch_key_buffer));
+      const Key batch_key(batch_key_buffer.data(), batch_key_length);
+      PW_TRY(entry_cache_.AddNewOrUpdateExisting(
+          batch_entry.descriptor(batch_key),
+          batch_entry.address(),
+          partition_.sector_size_bytes()));
+      address = batch_entry.next_address();
+    }
+  }
+
   return entry_cache_.AddNewOrUpdateExisting(
       entry.descriptor(key), entry.address(), partition_.sector_size_bytes());
 }
@@ -449,14 +521,27 @@ StatusWithSize KeyValueStore::Get(Key key,
                                   size_t offset_bytes) const {
   PW_TRY_WITH_SIZE(CheckReadOperation(key));
 
+  if (StatusWithSize cached =
+          value_cache_.Get(key, value_buffer, offset_bytes);
+      !cached.IsNotFound()) {
+    return cached;
+  }
+
   EntryMetadata metadata;
   PW_TRY_WITH_SIZE(FindExisting(key, &metadata));
 
-  return Get(key, metadata, value_buffer, offset_bytes);
+  StatusWithSize result = Get(key, metadata, value_buffer, offset_bytes);
+
+  // Only cache values that were read, and verified, in their entirety.
+  if (result.ok() && offset_bytes == 0u && value_cache_.enabled()) {
+    value_cache_.Put(key, value_buffer.first(result.size()));
+  }
+  return result;
 }
 
 Status KeyValueStore::PutBytes(Key key, span<const byte> value) {
   PW_TRY(CheckWriteOperation(key));
+  value_cache_.Remove(key);
   PW_LOG_DEBUG("Writing key/value; key length=%u, value length=%u",
                unsigned(key.size()),
                unsigned(value.size()));
@@ -468,6 +553,8 @@ Status KeyValueStore::PutBytes(Key key, span<const byte> value) {
     return Status::InvalidArgument();
   }
 
+  InternKey(key);
+
   EntryMetadata metadata;
   Status status = FindEntry(key, &metadata);
 
@@ -489,6 +576,7 @@ Status KeyValueStore::PutBytes(Key key, span<const byte> value) {
 
 Status KeyValueStore::Delete(Key key) {
   PW_TRY(CheckWriteOperation(key));
+  value_cache_.Remove(key);
 
   EntryMetadata metadata;
   PW_TRY(FindExisting(key, &metadata));
@@ -501,29 +589,137 @@ Status KeyValueStore::Delete(Key key) {
   return WriteEntryForExistingKey(metadata, EntryState::kDeleted, key, {});
 }
 
+Status KeyValueStore::WriteBatch(span<const BatchWrite> writes) {
+  size_t batch_size = 0;
+  size_t new_keys = 0;
+
+  for (size_t i = 0; i < writes.size(); ++i) {
+    const BatchWrite& write = writes[i];
+    PW_TRY(CheckWriteOperation(write.key_));
+
+    // Each entry in the batch must be for a different key hash.
+    const uint32_t hash = internal::Hash(write.key_);
+    for (size_t j = 0; j < i; ++j) {
+      if (internal::Hash(writes[j].key_) == hash) {
+        PW_LOG_DEBUG("Key 0x%08x appears more than once in batch",
+                     unsigned(hash));
+        return writes[j].key_ == write.key_ ? Status::InvalidArgument()
+                                            : Status::AlreadyExists();
+      }
+    }
+
+    EntryMetadata metadata;
+    if (write.deleted_) {
+      PW_TRY(FindExisting(write.key_, &metadata));
+    } else if (Status status = FindEntry(write.key_, &metadata);
+               status.IsNotFound()) {
+      new_keys += 1;
+    } else {
+      PW_TRY(status);
+    }
+
+    batch_size += Entry::size(partition_, write.key_, write.value_);
+  }
+
+  if (writes.empty()) {
+    return OkStatus();
+  }
+
+  for (const BatchWrite& write : writes) {
+    value_cache_.Remove(write.key_);
+  }
+
+  PW_LOG_DEBUG("Writing batch of %u entries; %u B",
+               unsigned(writes.size()),
+               unsigned(batch_size));
+
+  if (batch_size > partition_.sector_size_bytes()) {
+    PW_LOG_DEBUG("%u B batch cannot fit in one sector", unsigned(batch_size));
+    return Status::InvalidArgument();
+  }
+
+  if (new_keys > entry_cache_.max_entries() - entry_cache_.total_entries()) {
+    PW_LOG_WARN("KVS full: trying to store %u new entries, but can't",
+                unsigned(new_keys));
+    return Status::ResourceExhausted();
+  }
+
+  // Find space for every copy of the whole batch at once. This may involve
+  // garbage collecting one or more sectors.
+  Address* reserved_addresses = entry_cache_.TempReservedAddressesForWrite();
+  PW_TRY(GetAddressesForWrite(reserved_addresses, batch_size));
+
+  // Burn a transaction ID for each entry, as CreateEntry does.
+  const uint32_t first_transaction_id = last_transaction_id_ + 1;
+  last_transaction_id_ += writes.size();
+
+  // The batch takes effect once its first copy is written, so update the key
+  // descriptors then.
+  PW_TRY(AppendBatch(writes, reserved_addresses[0], first_transaction_id));
+
+  Address address = reserved_addresses[0];
+  for (size_t i = 0; i < writes.size(); ++i) {
+    const Entry entry =
+        CreateBatchEntry(writes, i, address, first_transaction_id);
+
+    EntryMetadata metadata;
+    if (FindEntry(writes[i].key_, &metadata).ok()) {
+      Entry prior_entry;
+      PW_TRY(ReadEntry(metadata, prior_entry));
+      UpdateKeyDescriptor(entry, address, &metadata, prior_entry.size());
+    } else {
+      entry_cache_.AddNew(entry.descriptor(writes[i].key_), address);
+    }
+    address = entry.next_address();
+  }
+
+  // Write the additional copies of the batch, if redundancy is greater than 1.
+  for (size_t copy = 1; copy < redundancy(); ++copy) {
+    PW_TRY(AppendBatch(writes, reserved_addresses[copy], first_transaction_id));
+
+    address = reserved_addresses[copy];
+    for (const BatchWrite& write : writes) {
+      EntryMetadata metadata;
+      PW_TRY(FindEntry(write.key_, &metadata));
+      metadata.AddNewAddress(address);
+      address += Entry::size(partition_, write.key_, write.value_);
+    }
+  }
+  return OkStatus();
+}
+
 void KeyValueStore::Item::ReadKey() {
   key_buffer_.fill('\0');
 
   Entry entry;
-  if (kvs_.ReadEntry(*iterator_, entry).ok()) {
-    entry.ReadKey(key_buffer_)
-        .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+  if (!kvs_.ReadEntry(*iterator_, entry).ok()) {
+    return;
   }
+  if (entry.key_interned()) {
+    const Key key = kvs_.key_table_.Find(iterator_->hash());
+    std::memcpy(key_buffer_.data(), key.data(), key.size());
+    return;
+  }
+  entry.ReadKey(key_buffer_)
+      .IgnoreError();  // TODO: b/242598609 - Handle Status properly
 }
 
 KeyValueStore::iterator& KeyValueStore::iterator::operator++() {
-  // Skip to the next entry that is valid (not deleted).
+  // Skip to the next entry that is valid (not deleted) and not the key table.
   while (++item_.iterator_ != item_.kvs_.entry_cache_.end() &&
-         item_.iterator_->state() != EntryState::kValid) {
+         (item_.iterator_->state() != EntryState::kValid ||
+          item_.kvs_.IsKeyTable(*item_.iterator_))) {
   }
   return *this;
 }
 
 KeyValueStore::iterator KeyValueStore::begin() const {
   internal::EntryCache::const_iterator cache_iterator = entry_cache_.begin();
-  // Skip over any deleted entries at the start of the descriptor list.
+  // Skip over any deleted entries or the key table at the start of the
+  // descriptor list.
   while (cache_iterator != entry_cache_.end() &&
-         cache_iterator->state() != EntryState::kValid) {
+         (cache_iterator->state() != EntryState::kValid ||
+          IsKeyTable(*cache_iterator))) {
     ++cache_iterator;
   }
   return iterator(*this, cache_iterator);
@@ -532,6 +728,11 @@ KeyValueStore::iterator KeyValueStore::begin() const {
 StatusWithSize KeyValueStore::ValueSize(Key key) const {
   PW_TRY_WITH_SIZE(CheckReadOperation(key));
 
+  if (StatusWithSize cached = value_cache_.ValueSize(key);
+      !cached.IsNotFound()) {
+    return cached;
+  }
+
   EntryMetadata metadata;
   PW_TRY_WITH_SIZE(FindExisting(key, &metadata));
 
@@ -559,7 +760,12 @@ Status KeyValueStore::ReadEntry(const EntryMetadata& metadata,
 
 Status KeyValueStore::FindEntry(Key key, EntryMetadata* metadata_out) const {
   StatusWithSize find_result =
-      entry_cache_.Find(partition_, sectors_, formats_, key, metadata_out);
+      entry_cache_.Find(partition_,
+                        sectors_,
+                        formats_,
+                        key,
+                        metadata_out,
+                        key_table_.enabled() ? &key_table_ : nullptr);
 
   if (find_result.size() > 0u) {
     error_detected_ = true;
@@ -579,6 +785,77 @@ Status KeyValueStore::FindExisting(Key key, EntryMetadata* metadata_out) const {
   return status;
 }
 
+void KeyValueStore::LoadKeyTable() {
+  key_table_.Clear();
+  if (!key_table_.enabled()) {
+    return;
+  }
+
+  EntryMetadata metadata;
+  Status status = FindExisting(KeyTable::kStorageKey, &metadata);
+  if (status.IsNotFound()) {
+    return;  // No keys have been interned yet.
+  }
+  if (!status.ok()) {
+    key_table_.Load(StatusWithSize(status, 0)).IgnoreError();
+    return;
+  }
+  key_table_
+      .Load(Get(KeyTable::kStorageKey, metadata, key_table_.buffer(), 0))
+      .IgnoreError();  // Load() logs any failure.
+}
+
+void KeyValueStore::InternKey(Key key) {
+  if (!key_table_.enabled() || key.size() <= sizeof(uint32_t) ||
+      key_table_.Contains(key)) {
+    return;
+  }
+
+  // Only intern keys that are updated. Interning a key that is written once
+  // would cost more space in the key table than it saves.
+  EntryMetadata metadata;
+  if (!FindEntry(key, &metadata).ok()) {
+    return;
+  }
+
+  const size_t prior_used_bytes = key_table_.used_bytes();
+  Status status = key_table_.Add(key);
+  if (status.ok()) {
+    status = WriteKeyTable();
+  }
+  if (!status.ok()) {
+    key_table_.Truncate(prior_used_bytes);
+    PW_LOG_DEBUG("Key 0x%08x not interned: %s",
+                 unsigned(metadata.hash()),
+                 status.str());
+  }
+}
+
+Status KeyValueStore::WriteKeyTable() {
+  const span<const byte> contents = key_table_.contents();
+  if (Entry::size(partition_, KeyTable::kStorageKey, contents) >
+      partition_.sector_size_bytes()) {
+    return Status::ResourceExhausted();
+  }
+
+  EntryMetadata metadata;
+  Status status = FindEntry(KeyTable::kStorageKey, &metadata);
+  if (status.ok()) {
+    status = WriteEntryForExistingKey(
+        metadata, EntryState::kValid, KeyTable::kStorageKey, contents);
+  } else if (status.IsNotFound()) {
+    status = WriteEntryForNewKey(KeyTable::kStorageKey, contents);
+  }
+  PW_TRY(status);
+
+  key_table_.set_stored();
+  return OkStatus();
+}
+
+bool KeyValueStore::IsKeyTable(const EntryMetadata& metadata) const {
+  return key_table_.stored() && metadata.hash() == kKeyTableHash;
+}
+
 StatusWithSize KeyValueStore::Get(Key key,
                                   const EntryMetadata& metadata,
                                   span<std::byte> value_buffer,
@@ -606,10 +883,26 @@ Status KeyValueStore::FixedSizeGet(Key key,
                                    size_t size_bytes) const {
   PW_TRY(CheckWriteOperation(key));
 
+  if (StatusWithSize cached_size = value_cache_.ValueSize(key);
+      cached_size.ok()) {
+    if (cached_size.size() != size_bytes) {
+      PW_LOG_DEBUG("Requested %u B read, but value is %u B",
+                   unsigned(size_bytes),
+                   unsigned(cached_size.size()));
+      return Status::InvalidArgument();
+    }
+    return value_cache_.Get(key, span(static_cast<byte*>(value), size_bytes))
+        .status();
+  }
+
   EntryMetadata metadata;
   PW_TRY(FindExisting(key, &metadata));
 
-  return FixedSizeGet(key, metadata, value, size_bytes);
+  Status status = FixedSizeGet(key, metadata, value, size_bytes);
+  if (status.ok() && value_cache_.enabled()) {
+    value_cache_.Put(key, span(static_cast<const byte*>(value), size_bytes));
+  }
+  return status;
 }
 
 Status KeyValueStore::FixedSizeGet(Key key,
@@ -641,7 +934,8 @@ StatusWithSize KeyValueStore::ValueSize(const EntryMetadata& metadata) const {
 }
 
 Status KeyValueStore::CheckWriteOperation(Key key) const {
-  if (InvalidKey(key)) {
+  if (InvalidKey(key) ||
+      (key_table_.enabled() && key == KeyTable::kStorageKey)) {
     return Status::InvalidArgument();
   }
 
@@ -653,7 +947,8 @@ Status KeyValueStore::CheckWriteOperation(Key key) const {
 }
 
 Status KeyValueStore::CheckReadOperation(Key key) const {
-  if (InvalidKey(key)) {
+  if (InvalidKey(key) ||
+      (key_table_.enabled() && key == KeyTable::kStorageKey)) {
     return Status::InvalidArgument();
   }
 
@@ -725,14 +1020,20 @@ Status KeyValueStore::WriteEntry(Key key,
   // List of addresses for sectors with space for this entry.
   Address* reserved_addresses = entry_cache_.TempReservedAddressesForWrite();
 
+  // Entries for interned keys store the key's hash in place of the key.
+  const bool key_interned = key_table_.Contains(key);
+  const Entry::InternedKey interned_key(internal::Hash(key));
+  const Key stored_key = key_interned ? interned_key.stored_key() : key;
+
   // Find addresses to write the entry to. This may involve garbage collecting
   // one or more sectors.
-  const size_t entry_size = Entry::size(partition_, key, value);
+  const size_t entry_size = Entry::size(partition_, stored_key, value);
   PW_TRY(GetAddressesForWrite(reserved_addresses, entry_size));
 
   // Write the entry at the first address that was found.
-  Entry entry = CreateEntry(reserved_addresses[0], key, value, new_state);
-  PW_TRY(AppendEntry(entry, key, value));
+  Entry entry = CreateEntry(
+      reserved_addresses[0], stored_key, value, new_state, key_interned);
+  PW_TRY(AppendEntry(entry, stored_key, value));
 
   // After writing the first entry successfully, update the key descriptors.
   // Once a single new the entry is written, the old entries are invalidated.
@@ -743,7 +1044,7 @@ Status KeyValueStore::WriteEntry(Key key,
   // Write the additional copies of the entry, if redundancy is greater than 1.
   for (size_t i = 1; i < redundancy(); ++i) {
     entry.set_address(reserved_addresses[i]);
-    PW_TRY(AppendEntry(entry, key, value));
+    PW_TRY(AppendEntry(entry, stored_key, value));
     new_metadata.AddNewAddress(reserved_addresses[i]);
   }
   return OkStatus();
@@ -756,7 +1057,8 @@ KeyValueStore::EntryMetadata KeyValueStore::CreateOrUpdateKeyDescriptor(
     size_t prior_size) {
   // If there is no prior descriptor, create a new one.
   if (prior_metadata == nullptr) {
-    return entry_cache_.AddNew(entry.descriptor(key), entry.address());
+    return entry_cache_.AddNew(entry.descriptor(internal::Hash(key)),
+                               entry.address());
   }
 
   return UpdateKeyDescriptor(
@@ -876,9 +1178,35 @@ Status KeyValueStore::AppendEntry(const Entry& entry,
   return OkStatus();
 }
 
+Status KeyValueStore::AppendBatch(span<const BatchWrite> writes,
+                                  Address address,
+                                  uint32_t first_transaction_id) {
+  SectorDescriptor& sector = sectors_.FromAddress(address);
+  const Address batch_address = address;
+
+  for (size_t i = 0; i < writes.size(); ++i) {
+    const Entry entry =
+        CreateBatchEntry(writes, i, address, first_transaction_id);
+    if (Status status = AppendEntry(entry, writes[i].key_, writes[i].value_);
+        !status.ok()) {
+      // An incomplete batch is ignored, so none of its entries are valid.
+      sector.RemoveValidBytes(address - batch_address);
+      return status;
+    }
+    address = entry.next_address();
+  }
+  return OkStatus();
+}
+
 StatusWithSize KeyValueStore::CopyEntryToSector(Entry& entry,
                                                 SectorDescriptor* new_sector,
                                                 Address new_address) {
+  // A copy of an entry from a batch stands on its own. Since the batch is
+  // complete, the copy must not wait for the rest of the batch.
+  if (entry.batch_continues()) {
+    PW_TRY_WITH_SIZE(entry.ClearBatchContinues());
+  }
+
   const StatusWithSize result = entry.Copy(new_address);
 
   PW_TRY_WITH_SIZE(MarkSectorCorruptIfNotOk(result.status(), new_sector));
@@ -990,8 +1318,20 @@ Status KeyValueStore::FullMaintenanceHelper(MaintenanceType maintenance_type) {
   // old/state entries from flash and leave only current/valid entries.
   do_garbage_collect_pass();
 
+  // Step 4: If a sector holding data has fallen too far behind in erases, move
+  // its entries so that the sector can be reused.
+  if (overall_status.ok() && options_.wear_leveling_threshold > 0) {
+    SectorDescriptor* least_erased =
+        sectors_.FindSectorToWearLevel(options_.wear_leveling_threshold);
+    if (least_erased != nullptr) {
+      PW_LOG_INFO("Relocating entries from sector %u to level wear",
+                  sectors_.Index(least_erased));
+      overall_status = GarbageCollectSector(*least_erased, {});
+    }
+  }
+
 #if PW_KVS_REMOVE_DELETED_KEYS_IN_HEAVY_MAINTENANCE
-  // Step 4: (if heavy maintenance) garbage collect all the deleted keys.
+  // Step 5: (if heavy maintenance) garbage collect all the deleted keys.
   if (heavy) {
     // If enabled, remove deleted keys from the entry cache, including freeing
     // sector bytes used by those keys. This must only be done directly after a
@@ -1009,6 +1349,16 @@ Status KeyValueStore::FullMaintenanceHelper(MaintenanceType maintenance_type) {
   }
 #endif  // PW_KVS_REMOVE_DELETED_KEYS_IN_HEAVY_MAINTENANCE
 
+  // Step 6: Checkpoint the freshly compacted state, so that the next Init()
+  // only needs to read entries that are written after this.
+  if (overall_status.ok() && checkpoints_.enabled() && !error_detected_) {
+    overall_status = checkpoints_.Write(
+        partition_, formats_, sectors_, entry_cache_);
+    if (!overall_status.ok()) {
+      PW_LOG_ERROR("Failed to write checkpoint");
+    }
+  }
+
   if (overall_status.ok()) {
     PW_LOG_INFO("Full maintenance complete");
   } else {
@@ -1030,6 +1380,71 @@ Status KeyValueStore::PartialMaintenance() {
   return GarbageCollect(span<const Address>());
 }
 
+Status KeyValueStore::MaintenanceStep(size_t budget_bytes) {
+  if (initialized_ == InitializationState::kNotInitialized) {
+    return Status::FailedPrecondition();
+  }
+
+  CheckForErrors();
+  // Do automatic repair, if KVS options allow for it.
+  if (error_detected_ && options_.recovery != ErrorRecovery::kManual) {
+    PW_TRY(Repair());
+  }
+
+  const size_t sector_size_bytes = partition_.sector_size_bytes();
+
+  if (background_gc_sector_ == nullptr) {
+    size_t empty_sectors = 0;
+    for (const SectorDescriptor& sector : sectors_) {
+      if (sector.Empty(sector_size_bytes)) {
+        empty_sectors += 1;
+      }
+    }
+    if (empty_sectors >= options_.spare_sectors) {
+      return Status::NotFound();
+    }
+
+    SectorDescriptor* sector = sectors_.FindSectorToGarbageCollect({});
+    if (sector == nullptr || sector->RecoverableBytes(sector_size_bytes) == 0) {
+      return Status::NotFound();
+    }
+
+    PW_LOG_DEBUG("Starting background garbage collection of sector %u",
+                 sectors_.Index(sector));
+
+    // Stop writes to the sector, so that it only has to be relocated out of
+    // once. Its remaining space is reclaimed when it is erased.
+    if (!sector->corrupt()) {
+      sector->set_writable_bytes(0);
+    }
+    background_gc_sector_ = sector;
+  }
+
+  SectorDescriptor& sector = *background_gc_sector_;
+
+  // Once all entries are relocated, erase the sector in a step of its own.
+  if (sector.valid_bytes() == 0) {
+    return GarbageCollectSector(sector, {});
+  }
+
+  size_t relocated_bytes = 0;
+  for (EntryMetadata& metadata : entry_cache_) {
+    const size_t valid_bytes = sector.valid_bytes();
+    PW_TRY(RelocateKeyAddressesInSector(sector, metadata, {}));
+    relocated_bytes += valid_bytes - sector.valid_bytes();
+
+    if (relocated_bytes >= budget_bytes && relocated_bytes > 0u) {
+      break;
+    }
+  }
+
+  PW_LOG_DEBUG("Relocated %u B from sector %u; %u B remain",
+               unsigned(relocated_bytes),
+               sectors_.Index(sector),
+               unsigned(sector.valid_bytes()));
+  return OkStatus();
+}
+
 Status KeyValueStore::GarbageCollect(span<const Address> reserved_addresses) {
   PW_LOG_DEBUG("Garbage Collect a single sector");
   for ([[maybe_unused]] Address address : reserved_addresses) {
@@ -1087,12 +1502,19 @@ Status KeyValueStore::GarbageCollectSector(
 
   // Step 2: Reinitialize the sector
   if (!sector_to_gc.Empty(partition_.sector_size_bytes())) {
+    // The checkpoint describes the sector's contents, so it must be
+    // invalidated before the sector is erased.
+    PW_TRY(checkpoints_.Invalidate());
     sector_to_gc.mark_corrupt();
     internal_stats_.sector_erase_count++;
     PW_TRY(partition_.Erase(sectors_.BaseAddress(sector_to_gc), 1));
     sector_to_gc.set_writable_bytes(partition_.sector_size_bytes());
   }
 
+  if (&sector_to_gc == background_gc_sector_) {
+    background_gc_sector_ = nullptr;
+  }
+
   PW_LOG_DEBUG("  Garbage Collect sector %u complete",
                sectors_.Index(sector_to_gc));
   return OkStatus();
@@ -1307,7 +1729,8 @@ Status KeyValueStore::Repair() {
 KeyValueStore::Entry KeyValueStore::CreateEntry(Address address,
                                                 Key key,
                                                 span<const byte> value,
-                                                EntryState state) {
+                                                EntryState state,
+                                                bool key_interned) {
   // Always bump the transaction ID when creating a new entry.
   //
   // Burning transaction IDs prevents inconsistencies between flash and memory
@@ -1323,15 +1746,49 @@ KeyValueStore::Entry KeyValueStore::CreateEntry(Address address,
   last_transaction_id_ += 1;
 
   if (state == EntryState::kDeleted) {
-    return Entry::Tombstone(
-        partition_, address, formats_.primary(), key, last_transaction_id_);
+    return Entry::Tombstone(partition_,
+                            address,
+                            formats_.primary(),
+                            key,
+                            last_transaction_id_,
+                            /*batch_continues=*/false,
+                            key_interned);
   }
   return Entry::Valid(partition_,
                       address,
                       formats_.primary(),
                       key,
                       value,
-                      last_transaction_id_);
+                      last_transaction_id_,
+                      /*batch_continues=*/false,
+                      key_interned);
+}
+
+KeyValueStore::Entry KeyValueStore::CreateBatchEntry(
+    span<const BatchWrite> writes,
+    size_t index,
+    Address address,
+    uint32_t first_transaction_id) {
+  const BatchWrite& write = writes[index];
+  const uint32_t transaction_id =
+      first_transaction_id + static_cast<uint32_t>(index);
+  const bool batch_continues = index + 1 < writes.size();
+
+  if (write.deleted_) {
+    return Entry::Tombstone(partition_,
+                            address,
+                            formats_.primary(),
+                            write.key_,
+                            transaction_id,
+                            batch_continues);
+  }
+  return Entry::Valid(partition_,
+                      address,
+                      formats_.primary(),
+                      write.key_,
+                      write.value_,
+                      transaction_id,
+                      batch_continues);
 }
 
 void KeyValueStore::LogDebugInfo() const {
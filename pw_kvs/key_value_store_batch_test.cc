@@ -0,0 +1,268 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+using BatchWrite = KeyValueStore::BatchWrite;
+
+constexpr size_t kSectorSize = 512;
+constexpr size_t kSectors = 4;
+constexpr size_t kMaxEntries = 16;
+
+using Value = std::array<uint32_t, 8>;
+
+constexpr Value MakeValue(uint32_t version) {
+  Value value{};
+  for (uint32_t& word : value) {
+    word = version;
+  }
+  return value;
+}
+
+// Simulates a power loss by dropping all writes after a number of writes.
+class PowerLossPartition : public FlashPartition {
+ public:
+  using FlashPartition::FlashPartition;
+  using FlashPartition::Write;
+
+  StatusWithSize Write(Address address, span<const std::byte> data) override {
+    if (writes_until_power_loss_.has_value()) {
+      if (*writes_until_power_loss_ == 0u) {
+        return StatusWithSize::Unavailable();
+      }
+      *writes_until_power_loss_ -= 1;
+    }
+    return FlashPartition::Write(address, data);
+  }
+
+  void LosePowerAfterWrites(size_t writes) {
+    writes_until_power_loss_ = writes;
+  }
+
+  void RestorePower() { writes_until_power_loss_.reset(); }
+
+ private:
+  std::optional<size_t> writes_until_power_loss_;
+};
+
+using test::RebootableKvs;
+
+template <size_t kRedundancy>
+class KvsBatchTest : public ::testing::Test {
+ protected:
+  using Kvs = KeyValueStoreBuffer<kMaxEntries, kSectors, kRedundancy>;
+
+  KvsBatchTest()
+      : flash_(16), partition_(&flash_), kvs_(partition_, 0x1d4c7a95) {
+    EXPECT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+    Reboot();
+  }
+
+  // Restores power and reboots the KVS.
+  void Reboot() {
+    partition_.RestorePower();
+    EXPECT_EQ(OkStatus(), kvs_.Reboot());
+  }
+
+  void ExpectValue(std::string_view key, uint32_t version) {
+    Value value;
+    ASSERT_EQ(OkStatus(), kvs_->Get(key, &value));
+    EXPECT_EQ(value, MakeValue(version));
+  }
+
+  void ExpectNotFound(std::string_view key) {
+    Value value;
+    EXPECT_EQ(Status::NotFound(), kvs_->Get(key, &value));
+  }
+
+  FakeFlashMemoryBuffer<kSectorSize, kSectors> flash_;
+  PowerLossPartition partition_;
+  RebootableKvs<Kvs> kvs_;
+};
+
+using KvsBatch = KvsBatchTest<1>;
+using RedundantKvsBatch = KvsBatchTest<2>;
+
+constexpr Value kValue1 = MakeValue(1);
+constexpr Value kValue2 = MakeValue(2);
+constexpr Value kValue3 = MakeValue(3);
+
+TEST_F(KvsBatch, WriteBatch_AllKeysAreWritten) {
+  const std::array writes = {BatchWrite::Put("a", kValue1),
+                             BatchWrite::Put("b", kValue2),
+                             BatchWrite::Put("c", kValue3)};
+  ASSERT_EQ(OkStatus(), kvs_->WriteBatch(writes));
+
+  EXPECT_EQ(3u, kvs_->size());
+  ExpectValue("a", 1);
+  ExpectValue("b", 2);
+  ExpectValue("c", 3);
+
+  Reboot();
+  EXPECT_EQ(3u, kvs_->size());
+  ExpectValue("a", 1);
+  ExpectValue("b", 2);
+  ExpectValue("c", 3);
+}
+
+TEST_F(KvsBatch, WriteBatch_UpdatesAndDeletesExistingKeys) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("a", kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Put("b", kValue1));
+
+  const std::array writes = {BatchWrite::Put("a", kValue2),
+                             BatchWrite::Delete("b"),
+                             BatchWrite::Put("c", kValue3)};
+  ASSERT_EQ(OkStatus(), kvs_->WriteBatch(writes));
+
+  ExpectValue("a", 2);
+  ExpectNotFound("b");
+  ExpectValue("c", 3);
+  const KeyValueStore::StorageStats stats = kvs_->GetStorageStats();
+
+  Reboot();
+  ExpectValue("a", 2);
+  ExpectNotFound("b");
+  ExpectValue("c", 3);
+  EXPECT_EQ(stats.in_use_bytes, kvs_->GetStorageStats().in_use_bytes);
+  EXPECT_EQ(stats.reclaimable_bytes,
+            kvs_->GetStorageStats().reclaimable_bytes);
+
+  // Entries written after the batch are newer than it.
+  ASSERT_EQ(OkStatus(), kvs_->Put("a", kValue3));
+  Reboot();
+  ExpectValue("a", 3);
+}
+
+TEST_F(KvsBatch, WriteBatch_Empty) {
+  EXPECT_EQ(OkStatus(), kvs_->WriteBatch({}));
+  EXPECT_EQ(0u, kvs_->size());
+}
+
+TEST_F(KvsBatch, WriteBatch_DuplicateKey_InvalidArgument) {
+  const std::array writes = {BatchWrite::Put("a", kValue1),
+                             BatchWrite::Put("b", kValue2),
+                             BatchWrite::Delete("a")};
+  EXPECT_EQ(Status::InvalidArgument(), kvs_->WriteBatch(writes));
+  EXPECT_EQ(0u, kvs_->size());
+  EXPECT_EQ(0u, kvs_->GetStorageStats().in_use_bytes);
+}
+
+TEST_F(KvsBatch, WriteBatch_DeleteMissingKey_NotFound) {
+  const std::array writes = {BatchWrite::Put("a", kValue1),
+                             BatchWrite::Delete("b")};
+  EXPECT_EQ(Status::NotFound(), kvs_->WriteBatch(writes));
+  ExpectNotFound("a");
+}
+
+TEST_F(KvsBatch, WriteBatch_LargerThanSector_InvalidArgument) {
+  std::array<std::byte, kSectorSize / 2> value{};
+  const std::array writes = {BatchWrite::Put("a", value),
+                             BatchWrite::Put("b", value)};
+  EXPECT_EQ(Status::InvalidArgument(), kvs_->WriteBatch(writes));
+  EXPECT_EQ(0u, kvs_->size());
+}
+
+TEST_F(KvsBatch, WriteBatch_NotEnoughEntries_ResourceExhausted) {
+  constexpr char kKeys[] = "abcdefghijklmno";
+  for (size_t i = 0; i < kMaxEntries - 1; ++i) {
+    ASSERT_EQ(OkStatus(),
+              kvs_->Put(std::string_view(&kKeys[i], 1), uint8_t(i)));
+  }
+
+  const std::array writes = {BatchWrite::Put("a", kValue1),
+                             BatchWrite::Put("x", kValue1),
+                             BatchWrite::Put("y", kValue1)};
+  EXPECT_EQ(Status::ResourceExhausted(), kvs_->WriteBatch(writes));
+  EXPECT_EQ(kMaxEntries - 1, kvs_->size());
+
+  // Updating existing keys does not need new entries.
+  ASSERT_EQ(OkStatus(), kvs_->WriteBatch(span(writes).first(2)));
+  EXPECT_EQ(kMaxEntries, kvs_->size());
+}
+
+TEST_F(KvsBatch, IncompleteBatch_IsDiscardedOnInit) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("a", kValue1));
+
+  // Lose power before the last entry in the batch is written.
+  partition_.LosePowerAfterWrites(2);
+  const std::array writes = {BatchWrite::Put("a", kValue2),
+                             BatchWrite::Put("b", kValue2),
+                             BatchWrite::Put("c", kValue2)};
+  EXPECT_NE(OkStatus(), kvs_->WriteBatch(writes));
+
+  Reboot();
+  EXPECT_EQ(1u, kvs_->size());
+  ExpectValue("a", 1);
+  ExpectNotFound("b");
+  ExpectNotFound("c");
+
+  // Later writes must not complete the interrupted batch.
+  ASSERT_EQ(OkStatus(), kvs_->Put("d", kValue3));
+  Reboot();
+  EXPECT_EQ(2u, kvs_->size());
+  ExpectValue("a", 1);
+  ExpectNotFound("b");
+  ExpectValue("d", 3);
+}
+
+TEST_F(KvsBatch, RelocatedBatchEntries_AreNotDiscarded) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("b", kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Put("c", kValue1));
+
+  const std::array writes = {BatchWrite::Put("a", kValue2),
+                             BatchWrite::Put("b", kValue2)};
+  ASSERT_EQ(OkStatus(), kvs_->WriteBatch(writes));
+
+  // Relocate all entries out of the sector with the batch, so that the copy of
+  // "a", the first entry in the batch, is not followed by the rest of it.
+  ASSERT_EQ(OkStatus(), kvs_->HeavyMaintenance());
+  EXPECT_EQ(0u, kvs_->GetStorageStats().reclaimable_bytes);
+
+  Reboot();
+  EXPECT_EQ(3u, kvs_->size());
+  ExpectValue("a", 2);
+  ExpectValue("b", 2);
+  ExpectValue("c", 1);
+}
+
+TEST_F(RedundantKvsBatch, WriteBatch_WritesEveryCopy) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("a", kValue1));
+
+  const std::array writes = {BatchWrite::Put("a", kValue2),
+                             BatchWrite::Put("b", kValue3)};
+  ASSERT_EQ(OkStatus(), kvs_->WriteBatch(writes));
+  EXPECT_FALSE(kvs_->error_detected());
+
+  // Init fails if any key is missing a copy.
+  Reboot();
+  EXPECT_FALSE(kvs_->error_detected());
+  ExpectValue("a", 2);
+  ExpectValue("b", 3);
+}
+
+}  // namespace
+}  // namespace pw::kvs
@@ -0,0 +1,192 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <string_view>
+
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+constexpr size_t kSectorSize = 512;
+constexpr size_t kKvsSectors = 6;
+constexpr size_t kCheckpointSectors = 2;
+constexpr size_t kMaxEntries = 32;
+constexpr size_t kKeys = 20;
+
+using test::CountingPartition;
+using test::RebootableKvs;
+
+class KvsCheckpoint : public ::testing::Test {
+ protected:
+  using Kvs = KeyValueStoreBuffer<kMaxEntries, kKvsSectors>;
+
+  KvsCheckpoint()
+      : flash_(16),
+        kvs_partition_(&flash_, 0, kKvsSectors),
+        checkpoint_partition_(&flash_, kKvsSectors, kCheckpointSectors),
+        kvs_(kvs_partition_, 0x3e9f16b2) {
+    EXPECT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+    Reboot();
+  }
+
+  // Reboots the KVS and returns the number of bytes read from its partition
+  // by Init().
+  size_t Reboot(bool use_checkpoints = true) {
+    Options options;
+    if (use_checkpoints) {
+      options.checkpoint_partition = &checkpoint_partition_;
+    }
+    kvs_partition_.ResetCounts();
+    EXPECT_EQ(OkStatus(), kvs_.Reboot(options));
+    return kvs_partition_.bytes_read;
+  }
+
+  static std::string_view Key(size_t i) {
+    static constexpr char kKeyChars[kKeys + 1] = "abcdefghijklmnopqrst";
+    return std::string_view(&kKeyChars[i], 1);
+  }
+
+  static std::array<uint32_t, 8> Value(size_t key, uint32_t version) {
+    std::array<uint32_t, 8> value;
+    value.fill(key * 1000 + version);
+    return value;
+  }
+
+  void PutKeys(uint32_t version) {
+    for (size_t i = 0; i < kKeys; ++i) {
+      ASSERT_EQ(OkStatus(), kvs_->Put(Key(i), Value(i, version)));
+    }
+  }
+
+  void ExpectValue(size_t key, uint32_t version) {
+    std::array<uint32_t, 8> value;
+    ASSERT_EQ(OkStatus(), kvs_->Get(Key(key), &value));
+    EXPECT_EQ(value, Value(key, version));
+  }
+
+  FakeFlashMemoryBuffer<kSectorSize, kKvsSectors + kCheckpointSectors> flash_;
+  CountingPartition kvs_partition_;
+  FlashPartition checkpoint_partition_;
+  RebootableKvs<Kvs> kvs_;
+};
+
+TEST_F(KvsCheckpoint, InitFromCheckpoint_SkipsReadingEntries) {
+  PutKeys(1);
+  const size_t full_scan_bytes = Reboot();
+
+  ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+  const size_t checkpoint_bytes = Reboot();
+
+  EXPECT_LT(checkpoint_bytes, full_scan_bytes / 2);
+  EXPECT_EQ(kKeys, kvs_->size());
+  for (size_t i = 0; i < kKeys; ++i) {
+    ExpectValue(i, 1);
+  }
+}
+
+TEST_F(KvsCheckpoint, InitFromCheckpoint_LoadsEntriesWrittenAfterIt) {
+  PutKeys(1);
+  ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+
+  std::array<uint32_t, 8> value = Value(0, 2);
+  ASSERT_EQ(OkStatus(), kvs_->Put(Key(0), value));
+  ASSERT_EQ(OkStatus(), kvs_->Delete(Key(1)));
+  ASSERT_EQ(OkStatus(), kvs_->Put("new", value));
+  const size_t full_scan_bytes = Reboot(/*use_checkpoints=*/false);
+
+  EXPECT_LT(Reboot(), full_scan_bytes);
+  EXPECT_EQ(kKeys, kvs_->size());
+  ExpectValue(0, 2);
+  EXPECT_EQ(Status::NotFound(), kvs_->Get(Key(1), &value));
+  for (size_t i = 2; i < kKeys; ++i) {
+    ExpectValue(i, 1);
+  }
+  ASSERT_EQ(OkStatus(), kvs_->Get("new", &value));
+  EXPECT_EQ(value, Value(0, 2));
+}
+
+TEST_F(KvsCheckpoint, EraseInvalidatesCheckpoint) {
+  PutKeys(1);
+  ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+
+  // Overwrite the keys until a sector is garbage collected.
+  uint32_t version = 1;
+  while (kvs_->GetStorageStats().sector_erase_count == 0) {
+    PutKeys(++version);
+  }
+
+  const size_t full_scan_bytes = Reboot(/*use_checkpoints=*/false);
+  EXPECT_EQ(full_scan_bytes, Reboot());
+  for (size_t i = 0; i < kKeys; ++i) {
+    ExpectValue(i, version);
+  }
+}
+
+TEST_F(KvsCheckpoint, CorruptCheckpoint_FallsBackToFullScan) {
+  PutKeys(1);
+  ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+
+  // Flip a bit in the checkpoint's entries.
+  flash_.buffer()[kKvsSectors * kSectorSize + 64] ^= std::byte{0x01};
+
+  const size_t full_scan_bytes = Reboot(/*use_checkpoints=*/false);
+  EXPECT_EQ(full_scan_bytes, Reboot());
+  for (size_t i = 0; i < kKeys; ++i) {
+    ExpectValue(i, 1);
+  }
+
+  // The corrupt record is erased when the next checkpoint is written.
+  ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+  EXPECT_LT(Reboot(), full_scan_bytes);
+}
+
+TEST_F(KvsCheckpoint, CheckpointPartitionIsReusedWhenFull) {
+  // Each checkpoint is about 250 bytes, so the partition fills up after a few.
+  for (uint32_t version = 1; version < 12; ++version) {
+    PutKeys(version);
+    ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+    const size_t checkpoint_bytes = Reboot();
+    EXPECT_LT(checkpoint_bytes, Reboot(/*use_checkpoints=*/false));
+
+    Reboot();
+    for (size_t i = 0; i < kKeys; ++i) {
+      ExpectValue(i, version);
+    }
+  }
+}
+
+TEST_F(KvsCheckpoint, HeavyMaintenance_CheckpointsRemovedKeys) {
+  PutKeys(1);
+  ASSERT_EQ(OkStatus(), kvs_->Delete(Key(3)));
+  ASSERT_EQ(OkStatus(), kvs_->HeavyMaintenance());
+
+  Reboot();
+  EXPECT_EQ(kKeys - 1, kvs_->size());
+  std::array<uint32_t, 8> value;
+  EXPECT_EQ(Status::NotFound(), kvs_->Get(Key(3), &value));
+
+  ASSERT_EQ(OkStatus(), kvs_->Put(Key(3), Value(3, 2)));
+  Reboot();
+  EXPECT_EQ(kKeys, kvs_->size());
+  ExpectValue(3, 2);
+}
+
+}  // namespace
+}  // namespace pw::kvs
@@ -0,0 +1,227 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+constexpr size_t kSectorSize = 512;
+constexpr size_t kSectors = 4;
+constexpr size_t kMaxEntries = 16;
+constexpr size_t kKeys = 8;
+
+// With a 16 B header, a 1 B key, and 16 B alignment, each entry is 64 B, so
+// a sector holds exactly 8 entries.
+using Value = std::array<uint32_t, 8>;
+constexpr size_t kEntrySize = 64;
+
+using test::RebootableKvs;
+
+class KvsMaintenanceStep : public ::testing::Test {
+ protected:
+  using Kvs = KeyValueStoreBuffer<kMaxEntries, kSectors>;
+
+  KvsMaintenanceStep()
+      : flash_(16), partition_(&flash_), kvs_(partition_, 0x7b30a1e6) {
+    EXPECT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+  }
+
+  static std::string_view Key(size_t i) {
+    static constexpr char kKeyChars[kKeys + 1] = "abcdefgh";
+    return std::string_view(&kKeyChars[i % kKeys], 1);
+  }
+
+  static Value MakeValue(size_t key, uint32_t version) {
+    Value value;
+    value.fill(key * 1000 + version);
+    return value;
+  }
+
+  void ExpectValue(size_t key, uint32_t version) {
+    Value value;
+    ASSERT_EQ(OkStatus(), kvs_->Get(Key(key), &value));
+    EXPECT_EQ(value, MakeValue(key, version));
+  }
+
+  FakeFlashMemoryBuffer<kSectorSize, kSectors> flash_;
+  FlashPartition partition_;
+  RebootableKvs<Kvs> kvs_;
+};
+
+TEST_F(KvsMaintenanceStep, NotInitialized_FailedPrecondition) {
+  Kvs kvs(&partition_, kvs_.format());
+  EXPECT_EQ(Status::FailedPrecondition(), kvs.MaintenanceStep(kEntrySize));
+}
+
+TEST_F(KvsMaintenanceStep, NothingToCollect_NotFound) {
+  ASSERT_EQ(OkStatus(), kvs_.Reboot());
+  EXPECT_EQ(Status::NotFound(), kvs_->MaintenanceStep(kEntrySize));
+
+  // Sectors with no reclaimable space are not collected.
+  for (size_t i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(OkStatus(), kvs_->Put(Key(i), MakeValue(i, 1)));
+  }
+  Options options;
+  options.spare_sectors = kSectors;
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+  EXPECT_EQ(Status::NotFound(), kvs_->MaintenanceStep(kEntrySize));
+}
+
+TEST_F(KvsMaintenanceStep, EachStepRelocatesUpToBudget) {
+  Options options;
+  options.spare_sectors = 3;
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+
+  // Fill the first sector, then make one of its entries stale.
+  for (size_t i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(OkStatus(), kvs_->Put(Key(i), MakeValue(i, 1)));
+  }
+  ASSERT_EQ(OkStatus(), kvs_->Put(Key(0), MakeValue(0, 2)));
+  const KeyValueStore::StorageStats initial = kvs_->GetStorageStats();
+  ASSERT_EQ(kEntrySize, initial.reclaimable_bytes);
+
+  // Each step relocates one entry, then the last step erases the sector.
+  for (size_t i = 1; i < kKeys; ++i) {
+    ASSERT_EQ(OkStatus(), kvs_->MaintenanceStep(1));
+    const KeyValueStore::StorageStats stats = kvs_->GetStorageStats();
+    EXPECT_EQ(initial.sector_erase_count, stats.sector_erase_count);
+    EXPECT_EQ(kEntrySize * (i + 1), stats.reclaimable_bytes);
+  }
+  ASSERT_EQ(OkStatus(), kvs_->MaintenanceStep(1));
+  EXPECT_EQ(initial.sector_erase_count + 1,
+            kvs_->GetStorageStats().sector_erase_count);
+  EXPECT_EQ(0u, kvs_->GetStorageStats().reclaimable_bytes);
+
+  EXPECT_EQ(Status::NotFound(), kvs_->MaintenanceStep(1));
+
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+  ExpectValue(0, 2);
+  for (size_t i = 1; i < kKeys; ++i) {
+    ExpectValue(i, 1);
+  }
+}
+
+TEST_F(KvsMaintenanceStep, WritesDuringCollection_GoToOtherSectors) {
+  Options options;
+  options.spare_sectors = kSectors;
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+
+  // Half fill the first sector and make one of its entries stale.
+  for (size_t i = 0; i < kKeys / 2; ++i) {
+    ASSERT_EQ(OkStatus(), kvs_->Put(Key(i), MakeValue(i, 1)));
+  }
+  ASSERT_EQ(OkStatus(), kvs_->Put(Key(0), MakeValue(0, 2)));
+  const size_t erase_count = kvs_->GetStorageStats().sector_erase_count;
+
+  ASSERT_EQ(OkStatus(), kvs_->MaintenanceStep(1));
+  ASSERT_EQ(OkStatus(), kvs_->Put(Key(kKeys - 1), MakeValue(kKeys - 1, 1)));
+
+  // Only the entries that were in the sector when its collection started are
+  // relocated, then it is erased.
+  size_t steps = 1;
+  while (kvs_->GetStorageStats().sector_erase_count == erase_count) {
+    ASSERT_EQ(OkStatus(), kvs_->MaintenanceStep(1));
+    steps += 1;
+  }
+  EXPECT_EQ(kKeys / 2 + 1, steps);
+}
+
+TEST_F(KvsMaintenanceStep, LargeBudget_RelocatesWholeSectorInOneStep) {
+  Options options;
+  options.spare_sectors = 3;
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+
+  for (size_t i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(OkStatus(), kvs_->Put(Key(i), MakeValue(i, 1)));
+  }
+  ASSERT_EQ(OkStatus(), kvs_->Put(Key(0), MakeValue(0, 2)));
+
+  ASSERT_EQ(OkStatus(), kvs_->MaintenanceStep(kSectorSize));
+  EXPECT_EQ(kSectorSize, kvs_->GetStorageStats().reclaimable_bytes);
+  ASSERT_EQ(OkStatus(), kvs_->MaintenanceStep(kSectorSize));
+  EXPECT_EQ(0u, kvs_->GetStorageStats().reclaimable_bytes);
+  EXPECT_EQ(Status::NotFound(), kvs_->MaintenanceStep(kSectorSize));
+}
+
+TEST_F(KvsMaintenanceStep, WithoutGcOnWrite_WritesFailWhenFull) {
+  Options options;
+  options.gc_on_write = GargbageCollectOnWrite::kDisabled;
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+
+  Status status = OkStatus();
+  for (uint32_t version = 0; status.ok() && version < 100; ++version) {
+    status = kvs_->Put(Key(version), MakeValue(version % kKeys, version));
+  }
+  EXPECT_EQ(Status::ResourceExhausted(), status);
+}
+
+TEST_F(KvsMaintenanceStep, BackgroundSteps_KeepSpaceForWrites) {
+  Options options;
+  options.gc_on_write = GargbageCollectOnWrite::kDisabled;
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+
+  // Writes never garbage collect, so they only succeed if the steps between
+  // them keep sectors free.
+  constexpr uint32_t kVersions = 50;
+  for (uint32_t version = 1; version <= kVersions; ++version) {
+    for (size_t i = 0; i < kKeys; ++i) {
+      ASSERT_EQ(OkStatus(), kvs_->Put(Key(i), MakeValue(i, version)));
+      const Status step_status = kvs_->MaintenanceStep(kEntrySize);
+      ASSERT_TRUE(step_status.ok() || step_status.IsNotFound());
+    }
+  }
+  EXPECT_GT(kvs_->GetStorageStats().sector_erase_count, 0u);
+
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+  EXPECT_EQ(kKeys, kvs_->size());
+  for (size_t i = 0; i < kKeys; ++i) {
+    ExpectValue(i, kVersions);
+  }
+}
+
+TEST_F(KvsMaintenanceStep, ForegroundGcOfSectorBeingCollected) {
+  Options options;
+  options.spare_sectors = 3;
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+
+  for (size_t i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(OkStatus(), kvs_->Put(Key(i), MakeValue(i, 1)));
+  }
+  ASSERT_EQ(OkStatus(), kvs_->Put(Key(0), MakeValue(0, 2)));
+  ASSERT_EQ(OkStatus(), kvs_->MaintenanceStep(1));
+
+  // Full maintenance erases the sector being collected in the background.
+  ASSERT_EQ(OkStatus(), kvs_->HeavyMaintenance());
+  EXPECT_EQ(0u, kvs_->GetStorageStats().reclaimable_bytes);
+  EXPECT_EQ(Status::NotFound(), kvs_->MaintenanceStep(1));
+
+  ASSERT_EQ(OkStatus(), kvs_.Reboot(options));
+  ExpectValue(0, 2);
+  for (size_t i = 1; i < kKeys; ++i) {
+    ExpectValue(i, 1);
+  }
+}
+
+}  // namespace
+}  // namespace pw::kvs
@@ -56,6 +56,7 @@ struct TestParameters {
   size_t partition_start_sector;
   size_t partition_sector_count;
   size_t partition_alignment;
+  bool hash_index = false;
 };
 
 enum Options {
@@ -403,7 +404,12 @@ class KvsTester {
 
   FlashPartitionWithStatsBuffer<kMaxEntries> partition_;
 
-  KeyValueStoreBuffer<kMaxEntries, kMaxUsableSectors, kParams.redundancy> kvs_;
+  KeyValueStoreBuffer<kMaxEntries,
+                      kMaxUsableSectors,
+                      kParams.redundancy,
+                      1,
+                      kParams.hash_index>
+      kvs_;
   std::unordered_map<std::string, std::string> map_;
   std::unordered_set<std::string> deleted_;
   unsigned count_ = 0;
@@ -499,6 +505,26 @@ RUN_TESTS_WITH_PARAMETERS(LotsOfSmallSectorsRedundant,
                           .partition_sector_count = 95,
                           .partition_alignment = 32);
 
+RUN_TESTS_WITH_PARAMETERS(BasicHashIndex,
+                          .sector_size = 4 * 1024,
+                          .sector_count = 4,
+                          .sector_alignment = 16,
+                          .redundancy = 1,
+                          .partition_start_sector = 0,
+                          .partition_sector_count = 4,
+                          .partition_alignment = 16,
+                          .hash_index = true);
+
+RUN_TESTS_WITH_PARAMETERS(LotsOfSmallSectorsRedundantHashIndex,
+                          .sector_size = 160,
+                          .sector_count = 100,
+                          .sector_alignment = 32,
+                          .redundancy = 2,
+                          .partition_start_sector = 5,
+                          .partition_sector_count = 95,
+                          .partition_alignment = 32,
+                          .hash_index = true);
+
 RUN_TESTS_WITH_PARAMETERS(OnlyTwoSectors,
                           .sector_size = 4 * 1024,
                           .sector_count = 20,
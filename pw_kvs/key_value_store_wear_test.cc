@@ -15,6 +15,9 @@
 // Always use stats, these tests depend on it.
 #define PW_KVS_RECORD_PARTITION_STATS 1
 
+#include <cstdlib>
+#include <string>
+
 #include "pw_kvs/fake_flash_memory.h"
 #include "pw_kvs/flash_memory.h"
 #include "pw_kvs/flash_partition_with_stats.h"
@@ -48,6 +51,16 @@ class WearTest : public ::testing::Test {
   KeyValueStoreBuffer<kMaxEntries, kSectors> kvs_;
 };
 
+// Writes the stats to the temporary directory, so test runs do not leave files
+// in the working directory.
+std::string StatsFilePath() {
+  const char* dir = std::getenv("TEST_TMPDIR");
+  if (dir == nullptr) {
+    dir = std::getenv("TMPDIR");
+  }
+  return std::string(dir == nullptr ? "/tmp" : dir) + "/flash_stats.csv";
+}
+
 // Block of data to use for entry value. Sized to 470 so the total entry results
 // in using most of the 512 byte sector.
 uint8_t test_data[470] = {1, 2, 3, 4, 5, 6};
@@ -75,7 +88,9 @@ TEST_F(WearTest, RepeatedLargeEntry) {
 
   // Ignore error to allow test to pass on platforms where writing out the stats
   // is not possible.
-  partition_.SaveStorageStats(kvs_, "WearTest RepeatedLargeEntry")
+  partition_
+      .SaveStorageStats(
+          kvs_, "WearTest RepeatedLargeEntry", StatsFilePath().c_str())
       .IgnoreError();
 }
 
@@ -115,5 +130,31 @@ TEST_F(WearTest, TwoPassFillWithLargeAndLarger) {
             2u * partition_.average_erase_count());
 }
 
+// Write an entry that never changes, then repeatedly rewrite another entry.
+// Maintenance moves the unchanging entry once its sector falls behind on
+// erases, so that sector is erased along with the rest.
+TEST_F(WearTest, MaintenanceLevelsWearOfUnchangingEntries) {
+  constexpr size_t kThreshold = 4;
+  Options options;
+  options.wear_leveling_threshold = kThreshold;
+  KeyValueStoreBuffer<kMaxEntries, kSectors> kvs(&partition_, format, options);
+  ASSERT_EQ(OkStatus(), kvs.Init());
+  partition_.ResetCounters();
+
+  ASSERT_EQ(OkStatus(), kvs.Put("cold_entry", span(test_data)));
+
+  for (size_t i = 0; i < kSectors * 20; ++i) {
+    test_data[0]++;
+    ASSERT_EQ(OkStatus(), kvs.Put("hot_entry", span(test_data)));
+    if (i % kSectors == 0) {
+      ASSERT_EQ(OkStatus(), kvs.FullMaintenance());
+    }
+  }
+
+  EXPECT_GT(partition_.min_erase_count(), 0u);
+  EXPECT_LE(partition_.max_erase_count(),
+            partition_.min_erase_count() + kThreshold + 1u);
+}
+
 }  // namespace
 }  // namespace pw::kvs
@@ -0,0 +1,229 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/assert.h"
+#include "pw_async2/atomic_waker.h"
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/poll.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw {
+namespace kvs {
+
+// Flash memory whose operations complete asynchronously, such as flash that is
+// programmed by a DMA engine or an external flash on a SPI bus. A task starts
+// an operation with StartRead(), StartWrite() or StartErase(), and can then do
+// other work, calling PendOperation() to find out when the operation is done.
+//
+// Only one operation may be in progress at a time. Buffers passed to an
+// operation must remain valid until PendOperation() returns Ready.
+//
+// Addresses range from 0 to size_bytes(). Backends implement the DoStart
+// functions, which start an operation and return without waiting for it, and
+// call OperationComplete() when it finishes. FlashMemoryAsyncAdapter
+// implements AsyncFlashMemory for any blocking FlashMemory.
+class AsyncFlashMemory {
+ public:
+  using Address = FlashMemory::Address;
+
+  AsyncFlashMemory(const AsyncFlashMemory&) = delete;
+  AsyncFlashMemory& operator=(const AsyncFlashMemory&) = delete;
+
+  virtual ~AsyncFlashMemory() = default;
+
+  // Starts reading bytes from flash into output. Returns:
+  //
+  // OK - the read was started
+  // UNAVAILABLE - another operation is in progress
+  // OUT_OF_RANGE - read does not fit in the flash memory
+  Status StartRead(Address address, span<std::byte> output);
+
+  // Starts writing bytes to flash. Returns:
+  //
+  // OK - the write was started
+  // UNAVAILABLE - another operation is in progress
+  // INVALID_ARGUMENT - address or data size are not aligned
+  // OUT_OF_RANGE - write does not fit in the flash memory
+  Status StartWrite(Address address, span<const std::byte> data);
+
+  // Starts erasing num_sectors starting at a given address. Returns:
+  //
+  // OK - the erase was started
+  // UNAVAILABLE - another operation is in progress
+  // INVALID_ARGUMENT - address is not sector-aligned
+  // OUT_OF_RANGE - erases past the end of the memory
+  Status StartErase(Address address, size_t num_sectors);
+
+  // Returns Pending while an operation is in progress, and Ready with its
+  // result, as from the matching blocking FlashMemory call, once it finishes.
+  // Returns Ready(FAILED_PRECONDITION) if no operation was started.
+  async2::Poll<StatusWithSize> PendOperation(async2::Context& cx);
+
+  // True from when an operation is started until PendOperation() returns its
+  // result.
+  bool busy() const { return state_.load(std::memory_order_acquire) != kIdle; }
+
+  constexpr size_t sector_size_bytes() const { return sector_size_; }
+
+  constexpr size_t sector_count() const { return sector_count_; }
+
+  constexpr size_t alignment_bytes() const { return alignment_; }
+
+  constexpr size_t size_bytes() const { return sector_size_ * sector_count_; }
+
+  constexpr std::byte erased_memory_content() const {
+    return erased_memory_content_;
+  }
+
+ protected:
+  AsyncFlashMemory(size_t sector_size,
+                   size_t sector_count,
+                   size_t alignment,
+                   std::byte erased_memory_content = std::byte(0xFF))
+      : sector_size_(sector_size),
+        sector_count_(sector_count),
+        alignment_(alignment),
+        erased_memory_content_(erased_memory_content),
+        state_(kIdle) {
+    PW_ASSERT(alignment_ != 0u);
+  }
+
+  // Finishes the operation in progress with its result. Backends call this
+  // once the operation started by a DoStart function is done. May be called
+  // from interrupt context, or from within the DoStart function.
+  void OperationComplete(StatusWithSize result);
+
+ private:
+  enum State : uint8_t {
+    kIdle,
+    kInProgress,
+    kComplete,
+  };
+
+  // Start an operation, which has already been checked against the memory's
+  // size and alignment. If these return an error, the operation is not
+  // started, and OperationComplete() must not be called for it.
+  virtual Status DoStartRead(Address address, span<std::byte> output) = 0;
+
+  virtual Status DoStartWrite(Address address, span<const std::byte> data) = 0;
+
+  virtual Status DoStartErase(Address address, size_t num_sectors) = 0;
+
+  // Claims the memory for a new operation. Returns UNAVAILABLE if it is busy.
+  Status BeginOperation();
+
+  // Releases the memory if starting an operation failed.
+  Status EndOperationIfFailed(Status status);
+
+  const uint32_t sector_size_;
+  const uint32_t sector_count_;
+  const uint32_t alignment_;
+  const std::byte erased_memory_content_;
+
+  std::atomic<State> state_;
+  StatusWithSize result_;
+  async2::AtomicWaker waker_;
+};
+
+// Implements AsyncFlashMemory with a blocking FlashMemory. Each operation runs
+// to completion in its Start function, so it is Ready the first time it is
+// polled. This allows code written for AsyncFlashMemory to be used with
+// existing flash drivers. Addresses are relative to the FlashMemory's
+// start_address().
+class FlashMemoryAsyncAdapter final : public AsyncFlashMemory {
+ public:
+  explicit FlashMemoryAsyncAdapter(FlashMemory& flash)
+      : AsyncFlashMemory(flash.sector_size_bytes(),
+                         flash.sector_count(),
+                         flash.alignment_bytes(),
+                         flash.erased_memory_content()),
+        flash_(flash) {}
+
+ private:
+  Status DoStartRead(Address address, span<std::byte> output) override;
+
+  Status DoStartWrite(Address address, span<const std::byte> data) override;
+
+  Status DoStartErase(Address address, size_t num_sectors) override;
+
+  FlashMemory& flash_;
+};
+
+// Writes a stream of data to consecutive flash addresses through two buffers,
+// so that one buffer is filled while the other is being written. When writes
+// complete asynchronously, this overlaps programming the flash with producing
+// the data to write.
+//
+// Both buffers must be the same size, which must be a multiple of the flash's
+// alignment. The flash must already be erased.
+class AsyncFlashWriter {
+ public:
+  using Address = AsyncFlashMemory::Address;
+
+  AsyncFlashWriter(AsyncFlashMemory& flash,
+                   Address start_address,
+                   span<std::byte> buffer_a,
+                   span<std::byte> buffer_b)
+      : flash_(flash),
+        buffers_{buffer_a, buffer_b},
+        address_(start_address),
+        filling_(0),
+        fill_size_(0),
+        write_in_progress_(false) {
+    PW_ASSERT(buffer_a.size() == buffer_b.size());
+    PW_ASSERT(!buffer_a.empty());
+    PW_ASSERT(buffer_a.size() % flash.alignment_bytes() == 0u);
+  }
+
+  // Copies as much of data into the buffers as they have room for, and starts
+  // writing each buffer that is filled. Returns Ready with the number of
+  // bytes accepted, which may be fewer than data.size(), or Pending if both
+  // buffers are full. Returns Ready with an error if a write failed.
+  async2::Poll<StatusWithSize> PendWrite(async2::Context& cx,
+                                         span<const std::byte> data);
+
+  // Writes any buffered data, padded to the flash's alignment with erased
+  // bytes, and waits for all writes to finish.
+  async2::Poll<Status> PendFlush(async2::Context& cx);
+
+  // The address at which the next buffer will be written.
+  Address address() const { return address_; }
+
+ private:
+  // Polls the write in progress, if any. Returns Ready once no write is in
+  // progress, with the result of the last write.
+  async2::Poll<Status> PendWriteInProgress(async2::Context& cx);
+
+  // Starts writing the buffer being filled, and switches to the other buffer.
+  Status StartWritingBuffer();
+
+  AsyncFlashMemory& flash_;
+  span<std::byte> buffers_[2];
+  Address address_;
+  uint8_t filling_;
+  size_t fill_size_;
+  bool write_in_progress_;
+};
+
+}  // namespace kvs
+}  // namespace pw
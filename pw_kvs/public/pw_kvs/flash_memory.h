@@ -20,7 +20,9 @@
 
 #include "pw_assert/assert.h"
 #include "pw_kvs/alignment.h"
+#include "pw_bytes/span.h"
 #include "pw_polyfill/standard.h"
+#include "pw_result/result.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/status_with_size.h"
@@ -110,6 +112,15 @@ class FlashMemory {
   // mapped reads. Return NULL if the memory is not memory mapped.
   virtual std::byte* FlashAddressToMcuAddress(Address) const { return nullptr; }
 
+  // Returns a span of the MCU's view of len bytes of flash starting at address,
+  // which may be read directly rather than copied with Read(). Returns:
+  //
+  // OK - the region is memory mapped
+  // OUT_OF_RANGE - the region does not fit in the memory
+  // UNIMPLEMENTED - the memory is not memory mapped
+  Result<ConstByteSpan> GetMemoryMappedRegion(Address address,
+                                              size_t len) const;
+
   // start_sector() is useful for FlashMemory instances where the
   // sector start is not 0. (ex.: cases where there are portions of flash
   // that should be handled independently).
@@ -346,6 +357,12 @@ class FlashPartition {
 
   size_t size_bytes() const { return sector_count() * sector_size_bytes(); }
 
+  // The number of times each sector has been erased, indexed by partition
+  // sector, for partitions that track it, such as FlashPartitionWithStats.
+  // Empty if erase counts are not tracked. The KVS uses these counts, when
+  // available, to spread erases evenly across the partition.
+  virtual span<const size_t> sector_erase_counts() const { return {}; }
+
   // Alignment required for write address and write size.
   size_t alignment_bytes() const { return alignment_bytes_; }
 
@@ -355,6 +372,16 @@ class FlashPartition {
     return flash_.FlashAddressToMcuAddress(PartitionToFlashAddress(address));
   }
 
+  // Returns a span of the MCU's view of len bytes of the partition starting at
+  // address, for zero-copy reads. Returns:
+  //
+  // OK - the region is memory mapped
+  // OUT_OF_RANGE - the region does not fit in the partition
+  // UNIMPLEMENTED - the partition is not memory mapped, or the region is not
+  //     contiguous in the MCU's address space
+  Result<ConstByteSpan> GetMemoryMappedRegion(Address address,
+                                              size_t len) const;
+
   // Converts an address from the partition address space to the flash address
   // space. If the partition reserves additional space in the sector, the flash
   // address space may not be contiguous, and this conversion accounts for that.
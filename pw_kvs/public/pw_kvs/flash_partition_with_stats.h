@@ -30,9 +30,11 @@ namespace pw::kvs {
 
 class FlashPartitionWithStats : public FlashPartition {
  public:
-  // Save flash partition and KVS storage stats. Does not save if
-  // sector_counters_ is zero.
-  Status SaveStorageStats(const KeyValueStore& kvs, const char* label);
+  // Save flash partition and KVS storage stats by appending them to the CSV
+  // file at file_name. Does not save if sector_counters_ is zero.
+  Status SaveStorageStats(const KeyValueStore& kvs,
+                          const char* label,
+                          const char* file_name = "flash_stats.csv");
 
   using FlashPartition::Erase;
 
@@ -42,6 +44,10 @@ class FlashPartitionWithStats : public FlashPartition {
     return span(sector_counters_.data(), sector_counters_.size());
   }
 
+  span<const size_t> sector_erase_counts() const override {
+    return span(sector_counters_.data(), sector_counters_.size());
+  }
+
   size_t min_erase_count() const {
     if (sector_counters_.empty()) {
       return 0;
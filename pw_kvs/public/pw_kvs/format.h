@@ -68,7 +68,9 @@ struct EntryHeader {
 
   // The length of the key in bytes. The key is not null terminated.
   //  6 bits, 0:5 - key length - maximum 64 characters
-  //  2 bits, 6:7 - reserved
+  //  1 bit,  6   - batch continues - set for all but the last entry of a batch
+  //  1 bit,  7   - key interned - set if the entry stores the key's 32-bit
+  //                hash in place of the key; the key length is then 4
   uint8_t key_length_bytes;
 
   // Byte length of the value; maximum of 65534. The max uint16_t value (65535
@@ -0,0 +1,108 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/format.h"
+#include "pw_kvs/internal/entry_cache.h"
+#include "pw_kvs/internal/sectors.h"
+#include "pw_status/status.h"
+
+namespace pw {
+namespace kvs {
+namespace internal {
+
+// Stores checkpoints of a KVS's in-memory state in a separate flash partition.
+// A checkpoint records every KeyDescriptor with its addresses and the number
+// of bytes in use in each sector, so that the KVS can be initialized from the
+// checkpoint plus the entries that were appended to sectors after it was
+// written, instead of reading and verifying every entry.
+//
+// Because sectors are only appended to between erases, a checkpoint remains
+// valid until a KVS sector is erased. Invalidate() must be called, and must
+// succeed, before erasing a sector.
+//
+// Checkpoints are appended to the partition as checksummed records, and the
+// newest valid record is used. The partition is erased when it is full.
+class Checkpoints {
+ public:
+  using Address = FlashPartition::Address;
+
+  // Checkpoints are disabled if partition is null.
+  constexpr Checkpoints(FlashPartition* partition)
+      : partition_(partition),
+        next_address_(0),
+        valid_(false),
+        needs_erase_(false) {}
+
+  bool enabled() const { return partition_ != nullptr; }
+
+  // Loads the newest checkpoint into the sectors and entry cache, which must
+  // have just been reset. Returns:
+  //
+  //          OK: the checkpoint was loaded
+  //   NOT_FOUND: there is no valid checkpoint
+  //   DATA_LOSS: the checkpoint does not match the KVS's flash
+  //
+  // If this fails, the sectors and entry cache must be reset again before
+  // loading the KVS from flash.
+  Status Load(FlashPartition& kvs_partition,
+              const EntryFormats& formats,
+              Sectors& sectors,
+              EntryCache& entry_cache);
+
+  // Writes a checkpoint of the sectors and entry cache, which must not have
+  // any corrupt sectors.
+  Status Write(const FlashPartition& kvs_partition,
+               const EntryFormats& formats,
+               const Sectors& sectors,
+               const EntryCache& entry_cache);
+
+  // Marks the current checkpoint, if any, as out of date.
+  Status Invalidate();
+
+ private:
+  struct RecordHeader;
+
+  // Finds the newest valid record and the address at which to append the next
+  // record.
+  Status FindNewest(Address& address, RecordHeader& header);
+
+  // Appends a record. The sectors and entry cache are written after the
+  // header, unless they are null.
+  Status Append(RecordHeader& header,
+                size_t sector_size_bytes,
+                const Sectors* sectors,
+                const EntryCache* entry_cache);
+
+  FlashPartition* const partition_;
+
+  // Where the next record is written.
+  Address next_address_;
+
+  // True if the newest record is a checkpoint that matches the KVS.
+  bool valid_;
+
+  // True if the partition contains data from an incomplete write, so must be
+  // erased before writing another record.
+  bool needs_erase_;
+};
+
+}  // namespace internal
+}  // namespace kvs
+}  // namespace pw
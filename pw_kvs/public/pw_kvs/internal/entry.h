@@ -61,15 +61,26 @@ class Entry {
                         size_t key_length,
                         char* key);
 
-  // Creates a new Entry for a valid (non-deleted) entry.
+  // Creates a new Entry for a valid (non-deleted) entry. If batch_continues is
+  // true, the entry is followed by another entry in the same batch. If
+  // key_interned is true, key is an InternedKey rather than the key itself.
   static Entry Valid(FlashPartition& partition,
                      Address address,
                      const EntryFormat& format,
                      Key key,
                      span<const std::byte> value,
-                     uint32_t transaction_id) {
-    return Entry(
-        partition, address, format, key, value, value.size(), transaction_id);
+                     uint32_t transaction_id,
+                     bool batch_continues = false,
+                     bool key_interned = false) {
+    return Entry(partition,
+                 address,
+                 format,
+                 key,
+                 value,
+                 value.size(),
+                 transaction_id,
+                 batch_continues,
+                 key_interned);
   }
 
   // Creates a new Entry for a tombstone entry, which marks a deleted key.
@@ -77,19 +88,45 @@ class Entry {
                          Address address,
                          const EntryFormat& format,
                          Key key,
-                         uint32_t transaction_id) {
+                         uint32_t transaction_id,
+                         bool batch_continues = false,
+                         bool key_interned = false) {
     return Entry(partition,
                  address,
                  format,
                  key,
                  {},
                  kDeletedValueLength,
-                 transaction_id);
+                 transaction_id,
+                 batch_continues,
+                 key_interned);
   }
 
+  // An entry for an interned key stores the key's hash in place of the key.
+  // The key itself is stored once, in the KVS's KeyTable.
+  class InternedKey {
+   public:
+    explicit InternedKey(uint32_t key_hash);
+
+    // The bytes stored in place of the key, to pass to Valid() or Tombstone().
+    Key stored_key() const { return Key(bytes_.data(), bytes_.size()); }
+
+   private:
+    std::array<char, sizeof(uint32_t)> bytes_;
+  };
+
+  // Returns the key hash stored in an entry for an interned key. The key must
+  // have been read from the entry with ReadKey().
+  static uint32_t InternedKeyHash(Key stored_key);
+
   Entry() = default;
 
-  KeyDescriptor descriptor(Key key) const { return descriptor(Hash(key)); }
+  // Returns the descriptor for this entry, given the key as read from flash
+  // with ReadKey().
+  KeyDescriptor descriptor(Key stored_key) const {
+    return descriptor(key_interned() ? InternedKeyHash(stored_key)
+                                     : Hash(stored_key));
+  }
 
   KeyDescriptor descriptor(uint32_t key_hash) const {
     return KeyDescriptor{key_hash,
@@ -99,6 +136,10 @@ class Entry {
 
   StatusWithSize Write(Key key, span<const std::byte> value) const;
 
+  // Marks this entry as not being part of a batch, so that it can be copied on
+  // its own. The entire entry is read to calculate the new checksum.
+  Status ClearBatchContinues();
+
   // Changes the format and transcation ID for this entry. In order to calculate
   // the new checksum, the entire entry is read into a small stack-allocated
   // buffer. The updated entry may be written to flash using the Copy function.
@@ -124,6 +165,8 @@ class Entry {
 
   Status ValueMatches(span<const std::byte> value) const;
 
+  // Verifies the checksum against the key and value. For an entry with an
+  // interned key, key is the key itself rather than the InternedKey.
   Status VerifyChecksum(Key key, span<const std::byte> value) const;
 
   Status VerifyChecksumInFlash() const;
@@ -151,7 +194,9 @@ class Entry {
   size_t size() const { return AlignUp(content_size(), alignment_bytes()); }
 
   // The length of the key in bytes. Keys are not null terminated.
-  size_t key_length() const { return header_.key_length_bytes; }
+  size_t key_length() const {
+    return header_.key_length_bytes & kMaxKeyLength;
+  }
 
   // The size of the value, without padding. The size is 0 if this is a
   // tombstone entry.
@@ -163,6 +208,17 @@ class Entry {
 
   uint32_t transaction_id() const { return header_.transaction_id; }
 
+  // True if this entry is followed by another entry in the same batch. The
+  // entries in a batch only take effect once its last entry is written.
+  bool batch_continues() const {
+    return (header_.key_length_bytes & kBatchContinuesBit) != 0u;
+  }
+
+  // True if the entry stores an InternedKey instead of its key.
+  bool key_interned() const {
+    return (header_.key_length_bytes & kKeyInternedBit) != 0u;
+  }
+
   // True if this is a tombstone entry.
   bool deleted() const {
     return header_.value_size_bytes == kDeletedValueLength;
@@ -173,13 +229,21 @@ class Entry {
  private:
   static constexpr uint16_t kDeletedValueLength = 0xFFFF;
 
+  // Set in EntryHeader::key_length_bytes for all but the last entry in a batch.
+  static constexpr uint8_t kBatchContinuesBit = 0b1000000;
+
+  // Set in EntryHeader::key_length_bytes if the key is an InternedKey.
+  static constexpr uint8_t kKeyInternedBit = 0b10000000;
+
   Entry(FlashPartition& partition,
         Address address,
         const EntryFormat& format,
         Key key,
         span<const std::byte> value,
         uint16_t value_size_bytes,
-        uint32_t transaction_id);
+        uint32_t transaction_id,
+        bool batch_continues,
+        bool key_interned);
 
   constexpr Entry(FlashPartition* partition,
                   Address address,
@@ -21,6 +21,7 @@
 #include "pw_kvs/flash_memory.h"
 #include "pw_kvs/format.h"
 #include "pw_kvs/internal/key_descriptor.h"
+#include "pw_kvs/internal/key_table.h"
 #include "pw_kvs/internal/sectors.h"
 #include "pw_kvs/key.h"
 #include "pw_span/span.h"
@@ -152,15 +153,37 @@ class EntryCache {
   template <size_t kMaxEntries, size_t kRedundancy>
   using AddressList = Address[kMaxEntries * kRedundancy + kRedundancy];
 
+  // The number of slots in a HashIndex: the smallest power of two that is at
+  // least twice the maximum number of entries.
+  static constexpr size_t HashIndexSlots(size_t max_entries) {
+    size_t slots = 1;
+    while (slots < 2 * max_entries) {
+      slots *= 2;
+    }
+    return slots;
+  }
+
+  // The type to use for an optional hash index over the descriptors. The index
+  // is an open-addressed hash table with at least twice as many slots as there
+  // are entries, so that lookups only probe a few slots. Each slot holds a
+  // descriptor index plus one, or zero if the slot is empty.
+  template <size_t kMaxEntries>
+  using HashIndex = uint16_t[HashIndexSlots(kMaxEntries)];
+
+  // Creates an EntryCache. If hash_index is empty, entries are found by
+  // scanning the descriptors. Otherwise, hash_index must be a HashIndex for
+  // the descriptors' max_size().
   constexpr EntryCache(Vector<KeyDescriptor>& descriptors,
                        Address* addresses,
-                       size_t redundancy)
+                       size_t redundancy,
+                       span<uint16_t> hash_index = {})
       : descriptors_(descriptors),
         addresses_(addresses),
-        redundancy_(redundancy) {}
+        redundancy_(redundancy),
+        hash_index_(hash_index) {}
 
   // Clears all KeyDescriptors.
-  void Reset() const { descriptors_.clear(); }
+  void Reset() const;
 
   // Finds the metadata for an entry matching a particular key. Searches for a
   // KeyDescriptor that matches this key and sets *metadata to point to it if
@@ -174,11 +197,14 @@ class EntryCache {
   //                 key's hash collides with the hash for an existing
   //                 descriptor
   //
+  // If key_table is provided, entries that store an interned key are matched
+  // against the key in the table.
   StatusWithSize Find(FlashPartition& partition,
                       const Sectors& sectors,
                       const EntryFormats& formats,
                       Key key,
-                      EntryMetadata* metadata) const;
+                      EntryMetadata* metadata,
+                      const KeyTable* key_table = nullptr) const;
 
   // Adds a new descriptor to the descriptor list. The entry MUST be unique and
   // the EntryCache must NOT be full!
@@ -224,8 +250,24 @@ class EntryCache {
   const_iterator cend() const { return {this, descriptors_.end()}; }
 
  private:
+  // Returns the index of the descriptor with this hash, or -1 if there is
+  // none.
   int FindIndex(uint32_t key_hash) const;
 
+  // Returns the hash index slot at which probing for a hash starts.
+  size_t HomeSlot(uint32_t key_hash) const {
+    return (key_hash ^ (key_hash >> 16)) & (hash_index_.size() - 1);
+  }
+
+  // Returns the hash index slot that refers to the descriptor at the index.
+  size_t FindSlot(size_t descriptor_index) const;
+
+  // Adds the descriptor at the index to the hash index, if there is one.
+  void IndexInsert(size_t descriptor_index) const;
+
+  // Removes the descriptor at the index from the hash index, if there is one.
+  void IndexRemove(size_t descriptor_index) const;
+
   // Adds the address to the descriptor at the specified index if there is an
   // address slot available.
   void AddAddressIfRoom(size_t descriptor_index, Address address) const;
@@ -242,6 +284,7 @@ class EntryCache {
   Vector<KeyDescriptor>& descriptors_;
   FlashPartition::Address* const addresses_;
   const size_t redundancy_;
+  const span<uint16_t> hash_index_;
 };
 
 }  // namespace internal
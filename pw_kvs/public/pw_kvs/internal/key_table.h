@@ -0,0 +1,126 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_kvs/key.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw {
+namespace kvs {
+namespace internal {
+
+// A table of interned keys, stored in a caller-provided buffer. Entries for
+// interned keys store the key's hash instead of the key, and the key itself is
+// found here by its hash. No two keys in the table have the same hash.
+//
+// The KVS stores the table as the value of an entry with a reserved key. Keys
+// are only ever appended, so that every entry that references the table can
+// still be resolved by the latest copy of it.
+//
+// Records are packed back to back at the start of the buffer. Each record is
+// a header, followed by the key.
+class KeyTable {
+ public:
+  // The reserved key under which the table is stored.
+  static constexpr Key kStorageKey = Key("\0pw_kvs_key_table", 17);
+
+  explicit constexpr KeyTable(span<std::byte> buffer)
+      : buffer_(buffer), used_bytes_(0), writable_(true), stored_(false) {}
+
+  KeyTable(const KeyTable&) = delete;
+  KeyTable& operator=(const KeyTable&) = delete;
+
+  bool enabled() const { return !buffer_.empty(); }
+
+  // True if the table has been loaded from or written to flash, in which case
+  // an entry with kStorageKey exists.
+  bool stored() const { return stored_; }
+
+  // Returns the interned key with this hash, or an empty key if there is none.
+  Key Find(uint32_t hash) const;
+
+  // True if this exact key is interned.
+  bool Contains(Key key) const;
+
+  // Appends a key to the table. Returns one of:
+  //
+  //   OK - The key was added, or was already in the table.
+  //   ALREADY_EXISTS - A different key with the same hash is in the table.
+  //   RESOURCE_EXHAUSTED - The key does not fit in the buffer.
+  //   FAILED_PRECONDITION - The table could not be loaded, so it must not be
+  //       written, since that would lose the keys it holds in flash.
+  //
+  Status Add(Key key);
+
+  // Removes keys added after the table was `used_bytes` long, e.g. if writing
+  // the table to flash failed.
+  void Truncate(size_t used_bytes) { used_bytes_ = used_bytes; }
+
+  // The buffer into which to read the stored table before calling Load().
+  span<std::byte> buffer() const { return buffer_; }
+
+  // Loads the stored table, given the result of reading it into buffer().
+  // Returns DATA_LOSS, and prevents further keys from being added, if the
+  // table could not be read in full or is corrupt.
+  Status Load(StatusWithSize read_result);
+
+  // Marks the table as having been written to flash.
+  void set_stored() { stored_ = true; }
+
+  void Clear() {
+    used_bytes_ = 0;
+    writable_ = true;
+    stored_ = false;
+  }
+
+  // The table as it is stored in flash.
+  span<const std::byte> contents() const { return buffer_.first(used_bytes_); }
+
+  size_t used_bytes() const { return used_bytes_; }
+
+ private:
+  struct RecordHeader {
+    uint32_t hash;
+    uint8_t key_size;
+  };
+
+  static constexpr size_t kRecordHeaderSize = sizeof(uint32_t) + 1;
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  // Returns the offset of the record with this hash, or kNotFound.
+  size_t FindRecord(uint32_t hash) const;
+
+  RecordHeader ReadHeader(size_t offset) const;
+
+  Key KeyAt(size_t offset, const RecordHeader& header) const {
+    return Key(reinterpret_cast<const char*>(buffer_.data()) + offset +
+                   kRecordHeaderSize,
+               header.key_size);
+  }
+
+  span<std::byte> buffer_;
+  size_t used_bytes_;
+  bool writable_;
+  bool stored_;
+};
+
+}  // namespace internal
+}  // namespace kvs
+}  // namespace pw
@@ -184,6 +184,16 @@ class Sectors {
   SectorDescriptor* FindSectorToGarbageCollect(
       span<const Address> reserved_addresses) const;
 
+  // Finds the least erased sector that holds valid data, if it has been erased
+  // at least threshold fewer times than the most erased sector. Relocating its
+  // data lets the sector take a share of the erases. Returns nullptr if the
+  // partition does not track erase counts or no sector is that far behind.
+  SectorDescriptor* FindSectorToWearLevel(size_t threshold) const;
+
+  // The number of times the sector has been erased, or 0 if the partition does
+  // not track erase counts.
+  size_t EraseCount(const SectorDescriptor& sector) const;
+
   // The number of sectors in use.
   size_t size() const { return descriptors_.size(); }
 
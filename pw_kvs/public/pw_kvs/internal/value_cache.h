@@ -0,0 +1,99 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_kvs/key.h"
+#include "pw_span/span.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw {
+namespace kvs {
+namespace internal {
+
+// A bounded RAM cache of key-value pairs, stored in a caller-provided buffer.
+// When the buffer is full, the least recently read values are evicted to make
+// room for new ones.
+//
+// Records are packed back to back at the start of the buffer. Each record is a
+// header, followed by the key and the value.
+class ValueCache {
+ public:
+  explicit constexpr ValueCache(span<std::byte> buffer)
+      : buffer_(buffer), used_bytes_(0), clock_(0) {}
+
+  ValueCache(const ValueCache&) = delete;
+  ValueCache& operator=(const ValueCache&) = delete;
+
+  bool enabled() const { return !buffer_.empty(); }
+
+  // Reads a cached value, starting at offset_bytes, like Entry::ReadValue.
+  // Returns NOT_FOUND if the key is not cached, OUT_OF_RANGE if the offset is
+  // past the end of the value, or RESOURCE_EXHAUSTED if the buffer is too
+  // small for the rest of the value.
+  StatusWithSize Get(Key key, span<std::byte> value, size_t offset_bytes = 0);
+
+  // Returns the size of a cached value, or NOT_FOUND.
+  StatusWithSize ValueSize(Key key) const;
+
+  // Caches a key's value, replacing any previously cached value for the key.
+  // Values that don't fit in the cache are not cached.
+  void Put(Key key, span<const std::byte> value);
+
+  // Removes a key's value from the cache, if it is cached.
+  void Remove(Key key);
+
+  void Clear() { used_bytes_ = 0; }
+
+  // The total bytes used by cached records, including overhead.
+  size_t used_bytes() const { return used_bytes_; }
+
+ private:
+  struct RecordHeader {
+    uint32_t hash;
+    uint32_t last_used;
+    uint16_t value_size;
+    uint8_t key_size;
+    uint8_t reserved;
+  };
+
+  static constexpr size_t kNotCached = static_cast<size_t>(-1);
+
+  // Returns the offset of the key's record, or kNotCached.
+  size_t Find(Key key) const;
+
+  RecordHeader ReadHeader(size_t offset) const;
+
+  void WriteHeader(size_t offset, const RecordHeader& header);
+
+  static size_t RecordSize(const RecordHeader& header) {
+    return sizeof(RecordHeader) + header.key_size + header.value_size;
+  }
+
+  // Removes the record at offset, moving later records down to fill the gap.
+  void RemoveRecord(size_t offset);
+
+  void EvictLeastRecentlyUsed();
+
+  span<std::byte> buffer_;
+  size_t used_bytes_;
+  uint32_t clock_;
+};
+
+}  // namespace internal
+}  // namespace kvs
+}  // namespace pw
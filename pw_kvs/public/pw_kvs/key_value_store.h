@@ -16,17 +16,21 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <type_traits>
 
 #include "pw_containers/vector.h"
 #include "pw_kvs/checksum.h"
 #include "pw_kvs/flash_memory.h"
 #include "pw_kvs/format.h"
+#include "pw_kvs/internal/checkpoint.h"
 #include "pw_kvs/internal/entry.h"
 #include "pw_kvs/internal/entry_cache.h"
 #include "pw_kvs/internal/key_descriptor.h"
+#include "pw_kvs/internal/key_table.h"
 #include "pw_kvs/internal/sectors.h"
 #include "pw_kvs/internal/span_traits.h"
+#include "pw_kvs/internal/value_cache.h"
 #include "pw_kvs/key.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
@@ -78,6 +82,46 @@ struct Options {
 
   // Verify an in-flash entry's checksum after writing it.
   bool verify_on_write = true;
+
+  // Optional partition, separate from the KVS's partition, in which to store
+  // checkpoints of the KVS's state. A checkpoint is written after each
+  // successful full or heavy maintenance. If the checkpoint is still valid
+  // when Init() is called, only the entries written after it are read from
+  // flash. Erasing a sector invalidates the checkpoint, so the next Init()
+  // reads all entries. The partition must be large enough for a checkpoint of
+  // 20 + 4 * sectors + (12 + 4 * redundancy) * max_entries bytes.
+  FlashPartition* checkpoint_partition = nullptr;
+
+  // The number of empty sectors that MaintenanceStep() garbage collects to keep
+  // available. The KVS always keeps one empty sector for garbage collection,
+  // so writes can use all but one of these without garbage collecting.
+  size_t spare_sectors = 2;
+
+  // Optional buffer for a RAM cache of recently read values. Get() serves
+  // cached values without reading or verifying them in flash. When the buffer
+  // is full, the least recently read values are evicted. Each cached value
+  // uses 12 bytes of overhead plus the size of its key. Writing or deleting a
+  // key removes it from the cache.
+  span<std::byte> value_cache_buffer = {};
+
+  // Optional buffer that enables key interning. The first time an existing key
+  // is updated, it is added to a table of keys, and later entries for it store
+  // the key's 4-byte hash in place of the key. This shrinks every entry written
+  // for a frequently updated key, and lookups of it compare the key in RAM
+  // instead of reading it from flash. The table is stored in the KVS as a
+  // hidden entry, which uses one of its entries, and is rewritten each time a
+  // key is added. Each key in the table uses 5 bytes plus the size of the key.
+  // Keys that do not fit, and keys written by WriteBatch(), are stored in full.
+  // The buffer must stay large enough for the table that is stored in flash.
+  span<std::byte> key_table_buffer = {};
+
+  // If nonzero, and the partition tracks sector erase counts (see
+  // FlashPartition::sector_erase_counts()), FullMaintenance() and
+  // HeavyMaintenance() move the entries out of the least erased sector that
+  // holds data once it has been erased this many times fewer than the most
+  // erased sector. This lets sectors holding data that never changes take a
+  // share of the erases.
+  size_t wear_leveling_threshold = 0;
 };
 
 /// Flash-backed persistent key-value store (KVS) with integrated
@@ -208,6 +252,68 @@ class KeyValueStore {
   /// * @pw_status{INVALID_ARGUMENT} - `key` is empty or too long.
   Status Delete(Key key);
 
+  /// A change to one key in a `WriteBatch()`: either writing a value to the
+  /// key or deleting it. The key and value are not copied, so they must remain
+  /// valid until `WriteBatch()` returns.
+  class BatchWrite {
+   public:
+    /// Writes a value, which can be a span of bytes or a trivially copyable
+    /// object, to `key`.
+    template <typename T,
+              typename std::enable_if_t<ConvertsToSpan<T>::value>* = nullptr>
+    static BatchWrite Put(const Key& key, const T& value) {
+      return BatchWrite(key, as_bytes(internal::make_span(value)), false);
+    }
+
+    template <typename T,
+              typename std::enable_if_t<!ConvertsToSpan<T>::value>* = nullptr>
+    static BatchWrite Put(const Key& key, const T& value) {
+      CheckThatObjectCanBePutOrGet<T>();
+      return BatchWrite(key, as_bytes(span<const T>(&value, 1)), false);
+    }
+
+    /// Deletes `key`, which must be present in the KVS.
+    static BatchWrite Delete(const Key& key) {
+      return BatchWrite(key, {}, true);
+    }
+
+   private:
+    friend class KeyValueStore;
+
+    constexpr BatchWrite(Key key, span<const std::byte> value, bool deleted)
+        : key_(key), value_(value), deleted_(deleted) {}
+
+    Key key_;
+    span<const std::byte> value_;
+    bool deleted_;
+  };
+
+  /// Writes and deletes multiple keys atomically. The entries are written
+  /// contiguously to one sector (or one sector per copy, if redundancy is
+  /// greater than 1), and only take effect once the entire batch is written. If
+  /// the write is interrupted, for example by a power loss, none of the changes
+  /// in the batch are visible after the next `Init()`.
+  ///
+  /// A batch costs one search for space, which may trigger garbage collection,
+  /// rather than one per key. It must fit in a single sector.
+  ///
+  /// @param[in] writes The keys to write or delete. Each key may only appear
+  /// once in a batch.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - All entries in the batch were written.
+  /// * @pw_status{NOT_FOUND} - A key to delete is not present in the KVS.
+  /// * @pw_status{DATA_LOSS} - Checksum validation failed after writing data.
+  /// * @pw_status{RESOURCE_EXHAUSTED} - Not enough space or free entries to
+  ///   write the batch.
+  /// * @pw_status{ALREADY_EXISTS} - A key could not be added because a
+  ///   different key with the same hash is already in the KVS.
+  /// * @pw_status{FAILED_PRECONDITION} - The KVS is not initialized. Call
+  ///   `Init()` before calling this method.
+  /// * @pw_status{INVALID_ARGUMENT} - A key is empty, too long, or appears more
+  ///   than once, or the batch does not fit in a sector.
+  Status WriteBatch(span<const BatchWrite> writes);
+
   /// Returns the size of the value corresponding to the key.
   ///
   /// @param[in] key - The name of the key.
@@ -251,6 +357,31 @@ class KeyValueStore {
   /// that makes sense for the KVS implementation.
   Status PartialMaintenance();
 
+  /// Performs a bounded step of garbage collection, so that sectors can be
+  /// reclaimed incrementally in the background (for example, from a
+  /// `pw::work_queue::WorkQueue` or a low-priority thread) rather than in
+  /// `Put()`. Each step either relocates entries totalling up to
+  /// `budget_bytes` (and at least one entry) out of the sector being collected,
+  /// or erases that sector once it holds no valid entries. A new sector is only
+  /// collected while fewer than `Options::spare_sectors` sectors are empty.
+  ///
+  /// Writes are not made to the sector being collected, so its entries only
+  /// need to be relocated once. If configured for at least lazy recovery,
+  /// needed repair of corruption is done first, which is not bounded.
+  ///
+  /// The KVS is not thread safe, so steps must be synchronized with other
+  /// calls to the KVS.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - A step was done. More steps may be needed.
+  /// * @pw_status{NOT_FOUND} - There are enough empty sectors, or none of the
+  ///   sectors have reclaimable space.
+  /// * @pw_status{RESOURCE_EXHAUSTED} - There is no space to relocate entries
+  ///   to.
+  /// * @pw_status{FAILED_PRECONDITION} - The KVS is not initialized. Call
+  ///   `Init()` before calling this method.
+  Status MaintenanceStep(size_t budget_bytes);
+
   void LogDebugInfo() const;
 
   // Classes and functions to support STL-style iteration.
@@ -348,7 +479,9 @@ class KeyValueStore {
   iterator end() const { return iterator(*this, entry_cache_.end()); }
 
   /// @returns The number of valid entries in the KVS.
-  size_t size() const { return entry_cache_.present_entries(); }
+  size_t size() const {
+    return entry_cache_.present_entries() - (key_table_.stored() ? 1 : 0);
+  }
 
   /// @returns The number of valid entries and deleted entries yet to be
   /// collected.
@@ -357,7 +490,9 @@ class KeyValueStore {
   }
 
   /// @returns The maximum number of KV entries that's possible in the KVS.
-  size_t max_size() const { return entry_cache_.max_entries(); }
+  size_t max_size() const {
+    return entry_cache_.max_entries() - (key_table_.stored() ? 1 : 0);
+  }
 
   /// @returns `true` if the KVS is empty.
   size_t empty() const { return size() == 0u; }
@@ -431,7 +566,8 @@ class KeyValueStore {
                 Vector<SectorDescriptor>& sector_descriptor_list,
                 const SectorDescriptor** temp_sectors_to_skip,
                 Vector<KeyDescriptor>& key_descriptor_list,
-                Address* addresses);
+                Address* addresses,
+                span<uint16_t> hash_index = {});
 
  private:
   using EntryMetadata = internal::EntryMetadata;
@@ -448,7 +584,13 @@ class KeyValueStore {
   }
 
   Status InitializeMetadata();
-  Status LoadEntry(Address entry_address, Address* next_entry_address);
+  // Reads and verifies the entry at entry_address and adds it to the entry
+  // cache. Entries in a batch are only added when the batch's last entry is
+  // loaded; until then, batch_start holds the address of the batch's first
+  // entry.
+  Status LoadEntry(Address entry_address,
+                   Address* next_entry_address,
+                   std::optional<Address>& batch_start);
   Status ScanForEntry(const SectorDescriptor& sector,
                       Address start_address,
                       Address* next_entry_address);
@@ -481,6 +623,20 @@ class KeyValueStore {
   //
   Status FindEntry(Key key, EntryMetadata* metadata_out) const;
 
+  // Loads the key table from flash, if key interning is enabled.
+  void LoadKeyTable();
+
+  // Adds key to the key table if it is already in the KVS, so that its later
+  // entries store its hash instead. Failing to intern a key is not an error;
+  // the key is stored in full instead.
+  void InternKey(Key key);
+
+  // Writes the key table to flash.
+  Status WriteKeyTable();
+
+  // True for the entry that stores the key table, which is hidden from users.
+  bool IsKeyTable(const EntryMetadata& metadata) const;
+
   // Searches for a KeyDescriptor that matches this key and sets *metadata_out
   // to point to it if one is found.
   //
@@ -537,6 +693,11 @@ class KeyValueStore {
 
   Status AppendEntry(const Entry& entry, Key key, span<const std::byte> value);
 
+  // Writes one copy of a batch of entries, starting at address.
+  Status AppendBatch(span<const BatchWrite> writes,
+                     Address address,
+                     uint32_t first_transaction_id);
+
   StatusWithSize CopyEntryToSector(Entry& entry,
                                    SectorDescriptor* new_sector,
                                    Address new_address);
@@ -592,7 +753,14 @@ class KeyValueStore {
   internal::Entry CreateEntry(Address address,
                               Key key,
                               span<const std::byte> value,
-                              EntryState state);
+                              EntryState state,
+                              bool key_interned = false);
+
+  // Creates the entry for writes[index] in a batch.
+  Entry CreateBatchEntry(span<const BatchWrite> writes,
+                         size_t index,
+                         Address address,
+                         uint32_t first_transaction_id);
 
   void LogSectors() const;
   void LogKeyDescriptor() const;
@@ -609,6 +777,18 @@ class KeyValueStore {
 
   Options options_;
 
+  // Checkpoints of the entry cache and sectors, if enabled.
+  internal::Checkpoints checkpoints_;
+
+  // Recently read values. Updated by const methods such as Get, so mutable.
+  mutable internal::ValueCache value_cache_;
+
+  // Keys whose entries store their hash instead of the key, if enabled.
+  internal::KeyTable key_table_;
+
+  // The sector being garbage collected by MaintenanceStep(), if any.
+  SectorDescriptor* background_gc_sector_;
+
   // Threshold value for when to garbage collect all stale data. Above the
   // threshold, GC all reclaimable bytes regardless of if valid data is in
   // sector. Below the threshold, only GC sectors with reclaimable bytes and no
@@ -643,10 +823,16 @@ class KeyValueStore {
   uint32_t last_transaction_id_;
 };
 
+// A KeyValueStore with storage for its entry and sector metadata.
+//
+// If kUseHashIndex is true, keys are found with a hash index over the entries
+// instead of scanning all of them, which makes Get(), Put(), and Delete() fast
+// for KVSs with many keys. The index costs 4 to 8 bytes of RAM per entry.
 template <size_t kMaxEntries,
           size_t kMaxUsableSectors,
           size_t kRedundancy = 1,
-          size_t kEntryFormats = 1>
+          size_t kEntryFormats = 1,
+          bool kUseHashIndex = false>
 class KeyValueStoreBuffer : public KeyValueStore {
  public:
   // Constructs a KeyValueStore on the partition, with support for one
@@ -675,7 +861,8 @@ class KeyValueStoreBuffer : public KeyValueStore {
                       sectors_,
                       temp_sectors_to_skip_,
                       key_descriptors_,
-                      addresses_),
+                      addresses_,
+                      hash_index_),
         sectors_(),
         key_descriptors_(),
         formats_() {
@@ -687,6 +874,8 @@ class KeyValueStoreBuffer : public KeyValueStore {
   static_assert(kMaxUsableSectors > 0u);
   static_assert(kRedundancy > 0u);
   static_assert(kEntryFormats > 0u);
+  static_assert(!kUseHashIndex || kMaxEntries < 0xffffu,
+                "The hash index supports up to 65534 entries");
 
   Vector<SectorDescriptor, kMaxUsableSectors> sectors_;
 
@@ -707,6 +896,12 @@ class KeyValueStoreBuffer : public KeyValueStore {
   // KeyDescriptors.
   internal::EntryCache::AddressList<kRedundancy, kMaxEntries> addresses_;
 
+  // Hash index over the KeyDescriptors, if enabled.
+  std::array<uint16_t,
+             kUseHashIndex ? internal::EntryCache::HashIndexSlots(kMaxEntries)
+                           : 0>
+      hash_index_{};
+
   // EntryFormats that can be read by this KeyValueStore.
   std::array<EntryFormat, kEntryFormats> formats_;
 };
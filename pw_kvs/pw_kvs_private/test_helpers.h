@@ -0,0 +1,82 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/format.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw::kvs::test {
+
+// A FlashPartition that counts the reads made through it, to check how much
+// of the flash a KVS operation touches.
+class CountingPartition : public FlashPartition {
+ public:
+  using FlashPartition::FlashPartition;
+  using FlashPartition::Read;
+
+  StatusWithSize Read(Address address, span<std::byte> output) override {
+    reads += 1;
+    bytes_read += output.size();
+    return FlashPartition::Read(address, output);
+  }
+
+  void ResetCounts() {
+    reads = 0;
+    bytes_read = 0;
+  }
+
+  size_t reads = 0;
+  size_t bytes_read = 0;
+};
+
+// Holds a KVS that can be recreated on the same partition, to check what a
+// device finds in flash after it restarts.
+template <typename Kvs>
+class RebootableKvs {
+ public:
+  // For KVS magic value always use a random 32 bit integer rather than a
+  // human readable 4 bytes. See pw_kvs/format.h for more information.
+  RebootableKvs(FlashPartition& partition, uint32_t magic)
+      : partition_(partition),
+        format_{.magic = magic, .checksum = &checksum_} {}
+
+  // Replaces the KVS with a new one on the same flash, as if the device had
+  // restarted, and returns the result of initializing it.
+  Status Reboot(const Options& options = {}) {
+    kvs_.emplace(&partition_, format_, options);
+    return kvs_->Init();
+  }
+
+  const EntryFormat& format() const { return format_; }
+
+  Kvs& operator*() { return *kvs_; }
+  Kvs* operator->() { return &*kvs_; }
+
+ private:
+  FlashPartition& partition_;
+  ChecksumCrc16 checksum_;
+  EntryFormat format_;
+  std::optional<Kvs> kvs_;
+};
+
+}  // namespace pw::kvs::test
@@ -17,6 +17,8 @@
 
 #include "pw_kvs/internal/sectors.h"
 
+#include <algorithm>
+
 #include "pw_kvs_private/config.h"
 #include "pw_log/log.h"
 
@@ -39,7 +41,7 @@ Status Sectors::Find(FindMode find_mode,
                      size_t size,
                      span<const Address> addresses_to_skip,
                      span<const Address> reserved_addresses) {
-  SectorDescriptor* first_empty_sector = nullptr;
+  SectorDescriptor* empty_sector = nullptr;
   bool at_least_two_empty_sectors = (find_mode == kGarbageCollect);
 
   // Used for the GC reclaimable bytes check
@@ -90,8 +92,10 @@ Status Sectors::Find(FindMode find_mode,
   // sector that is found.
   //
   // Tier 2 is find sectors that are empty/erased. While scanning for a partial
-  // sector, keep track of the first empty sector and if a second empty sector
-  // was seen. If during GC then count the second empty sector as always seen.
+  // sector, keep track of an empty sector and if a second empty sector was
+  // seen. If during GC then count the second empty sector as always seen. If
+  // the partition tracks erase counts, use the least erased empty sector;
+  // otherwise use the first empty sector found.
   //
   // Tier 3 is during garbage collection, find sectors with enough space that
   // are not empty but have recoverable bytes. Pick the sector with the least
@@ -124,24 +128,27 @@ Status Sectors::Find(FindMode find_mode,
     }
 
     if (sector->Empty(sector_size_bytes)) {
-      if (first_empty_sector == nullptr) {
-        first_empty_sector = sector;
+      if (empty_sector == nullptr) {
+        empty_sector = sector;
       } else {
         at_least_two_empty_sectors = true;
+        if (EraseCount(*sector) < EraseCount(*empty_sector)) {
+          empty_sector = sector;
+        }
       }
     }
   }
 
   // Tier 2 check: If the scan for a partial sector does not find a suitable
-  // sector, use the first empty sector that was found. Normally it is required
-  // to keep 1 empty sector after the sector found here, but that rule does not
+  // sector, use the empty sector that was selected. Normally it is required to
+  // keep 1 empty sector after the sector found here, but that rule does not
   // apply during GC.
-  if (first_empty_sector != nullptr && at_least_two_empty_sectors) {
-    PW_LOG_DEBUG(
-        "  Found a usable empty sector; returning the first found (%u)",
-        Index(first_empty_sector));
-    last_new_ = first_empty_sector;
-    *found_sector = first_empty_sector;
+  if (empty_sector != nullptr && at_least_two_empty_sectors) {
+    PW_LOG_DEBUG("  Found a usable empty sector %u, erased %u times",
+                 Index(empty_sector),
+                 unsigned(EraseCount(*empty_sector)));
+    last_new_ = empty_sector;
+    *found_sector = empty_sector;
     return OkStatus();
   }
 
@@ -162,6 +169,12 @@ Status Sectors::Find(FindMode find_mode,
   return Status::ResourceExhausted();
 }
 
+size_t Sectors::EraseCount(const SectorDescriptor& sector) const {
+  const span<const size_t> erase_counts = partition_.sector_erase_counts();
+  const size_t index = Index(sector);
+  return index < erase_counts.size() ? erase_counts[index] : 0;
+}
+
 SectorDescriptor& Sectors::WearLeveledSectorFromIndex(size_t idx) const {
   return descriptors_[(Index(last_new_) + 1 + idx) % descriptors_.size()];
 }
@@ -184,26 +197,34 @@ SectorDescriptor* Sectors::FindSectorToGarbageCollect(
   // relocation needed). Use the first such sector found, as that will help the
   // KVS "rotate" around the partition. Initially this would select the sector
   // with the most reclaimable space, but that can cause GC sector selection to
-  // "ping-pong" between two sectors when updating large keys.
+  // "ping-pong" between two sectors when updating large keys. If the partition
+  // tracks erase counts, use the least erased such sector instead.
   for (size_t i = 0; i < descriptors_.size(); ++i) {
     SectorDescriptor& sector = WearLeveledSectorFromIndex(i);
     if ((sector.valid_bytes() == 0) &&
         (sector.RecoverableBytes(sector_size_bytes) > 0) &&
-        !Contains(sectors_to_skip, &sector)) {
+        !Contains(sectors_to_skip, &sector) &&
+        (sector_candidate == nullptr ||
+         EraseCount(sector) < EraseCount(*sector_candidate))) {
       sector_candidate = &sector;
-      break;
     }
   }
 
   // Step 2: If step 1 yields no sectors, just find the sector with the most
-  // reclaimable bytes but no addresses to avoid.
+  // reclaimable bytes but no addresses to avoid. Break ties with the least
+  // erased sector.
   if (sector_candidate == nullptr) {
     for (size_t i = 0; i < descriptors_.size(); ++i) {
       SectorDescriptor& sector = WearLeveledSectorFromIndex(i);
-      if ((sector.RecoverableBytes(sector_size_bytes) > candidate_bytes) &&
+      const size_t recoverable_bytes =
+          sector.RecoverableBytes(sector_size_bytes);
+      if ((recoverable_bytes > candidate_bytes ||
+           (recoverable_bytes == candidate_bytes &&
+            sector_candidate != nullptr &&
+            EraseCount(sector) < EraseCount(*sector_candidate))) &&
           !Contains(sectors_to_skip, &sector)) {
         sector_candidate = &sector;
-        candidate_bytes = sector.RecoverableBytes(sector_size_bytes);
+        candidate_bytes = recoverable_bytes;
       }
     }
   }
@@ -235,4 +256,34 @@ SectorDescriptor* Sectors::FindSectorToGarbageCollect(
   return sector_candidate;
 }
 
+SectorDescriptor* Sectors::FindSectorToWearLevel(size_t threshold) const {
+  if (partition_.sector_erase_counts().size() < descriptors_.size()) {
+    return nullptr;
+  }
+
+  // Find the least erased sector that holds data which would have to be moved
+  // for the sector to be reused.
+  SectorDescriptor* least_erased = nullptr;
+  size_t max_erase_count = 0;
+  for (SectorDescriptor& sector : descriptors_) {
+    max_erase_count = std::max(max_erase_count, EraseCount(sector));
+    if (sector.valid_bytes() > 0 && !sector.corrupt() &&
+        (least_erased == nullptr ||
+         EraseCount(sector) < EraseCount(*least_erased))) {
+      least_erased = &sector;
+    }
+  }
+
+  if (least_erased == nullptr ||
+      max_erase_count - EraseCount(*least_erased) < threshold) {
+    return nullptr;
+  }
+
+  PW_LOG_DEBUG("Sector %u is erased %u times, %u fewer than the most erased",
+               Index(least_erased),
+               unsigned(EraseCount(*least_erased)),
+               unsigned(max_erase_count - EraseCount(*least_erased)));
+  return least_erased;
+}
+
 }  // namespace pw::kvs::internal
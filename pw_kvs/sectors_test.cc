@@ -14,6 +14,8 @@
 
 #include "pw_kvs/internal/sectors.h"
 
+#include <array>
+
 #include "pw_kvs/fake_flash_memory.h"
 #include "pw_unit_test/framework.h"
 
@@ -82,5 +84,69 @@ TEST_F(SectorsTest, NextWritableAddress_PartiallyWrittenSector) {
 // TODO(hepler): Add tests for FindSpace, FindSpaceDuringGarbageCollection, and
 // FindSectorToGarbageCollect.
 
+// A partition that reports erase counts set by the test.
+class ErasesCountedPartition : public FlashPartition {
+ public:
+  explicit ErasesCountedPartition(FlashMemory* flash) : FlashPartition(flash) {}
+
+  span<const size_t> sector_erase_counts() const override {
+    return erase_counts;
+  }
+
+  std::array<size_t, 16> erase_counts = {};
+};
+
+class WearAwareSectorsTest : public ::testing::Test {
+ protected:
+  WearAwareSectorsTest()
+      : partition_(&flash_),
+        sectors_(sector_descriptors_, partition_, nullptr) {
+    sectors_.Reset();
+    partition_.erase_counts.fill(10);
+  }
+
+  FakeFlashMemoryBuffer<128, 16> flash_;
+  ErasesCountedPartition partition_;
+  Vector<SectorDescriptor, 32> sector_descriptors_;
+  Sectors sectors_;
+};
+
+TEST_F(SectorsTest, EraseCount_NotTracked) {
+  EXPECT_EQ(0u, sectors_.EraseCount(*sectors_.begin()));
+  EXPECT_EQ(nullptr, sectors_.FindSectorToWearLevel(1));
+}
+
+TEST_F(WearAwareSectorsTest, FindSpace_UsesLeastErasedEmptySector) {
+  partition_.erase_counts[7] = 3;
+  EXPECT_EQ(3u, sectors_.EraseCount(sectors_.FromAddress(7 * 128)));
+
+  SectorDescriptor* sector = nullptr;
+  ASSERT_EQ(OkStatus(), sectors_.FindSpace(&sector, 32, {}));
+  EXPECT_EQ(7u, sectors_.Index(sector));
+  EXPECT_EQ(sector, sectors_.last_new());
+}
+
+TEST_F(WearAwareSectorsTest, FindSectorToGarbageCollect_UsesLeastErased) {
+  for (size_t index : {3, 9, 12}) {
+    sectors_.FromAddress(index * 128).RemoveWritableBytes(128);
+  }
+  partition_.erase_counts[9] = 2;
+
+  SectorDescriptor* sector = sectors_.FindSectorToGarbageCollect({});
+  ASSERT_NE(nullptr, sector);
+  EXPECT_EQ(9u, sectors_.Index(sector));
+}
+
+TEST_F(WearAwareSectorsTest, FindSectorToWearLevel) {
+  SectorDescriptor& cold_sector = sectors_.FromAddress(2 * 128);
+  cold_sector.RemoveWritableBytes(64);
+  cold_sector.AddValidBytes(64);
+  partition_.erase_counts[2] = 4;
+  partition_.erase_counts[5] = 1;  // Empty, so there is nothing to move.
+
+  EXPECT_EQ(&cold_sector, sectors_.FindSectorToWearLevel(6));
+  EXPECT_EQ(nullptr, sectors_.FindSectorToWearLevel(7));
+}
+
 }  // namespace
 }  // namespace pw::kvs::internal
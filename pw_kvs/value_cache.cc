@@ -0,0 +1,146 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_kvs/internal/value_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_kvs/internal/hash.h"
+
+namespace pw::kvs::internal {
+
+StatusWithSize ValueCache::Get(Key key,
+                               span<std::byte> value,
+                               size_t offset_bytes) {
+  const size_t offset = Find(key);
+  if (offset == kNotCached) {
+    return StatusWithSize::NotFound();
+  }
+
+  RecordHeader header = ReadHeader(offset);
+  header.last_used = ++clock_;
+  WriteHeader(offset, header);
+
+  if (offset_bytes > header.value_size) {
+    return StatusWithSize::OutOfRange();
+  }
+
+  const size_t remaining_bytes = header.value_size - offset_bytes;
+  const size_t read_size = std::min(value.size(), remaining_bytes);
+  const std::byte* const cached_value =
+      buffer_.data() + offset + sizeof(RecordHeader) + header.key_size;
+  std::memcpy(value.data(), cached_value + offset_bytes, read_size);
+
+  if (read_size != remaining_bytes) {
+    return StatusWithSize::ResourceExhausted(read_size);
+  }
+  return StatusWithSize(read_size);
+}
+
+StatusWithSize ValueCache::ValueSize(Key key) const {
+  const size_t offset = Find(key);
+  if (offset == kNotCached) {
+    return StatusWithSize::NotFound();
+  }
+  return StatusWithSize(ReadHeader(offset).value_size);
+}
+
+void ValueCache::Put(Key key, span<const std::byte> value) {
+  Remove(key);
+
+  const RecordHeader header{
+      .hash = Hash(key),
+      .last_used = ++clock_,
+      .value_size = static_cast<uint16_t>(value.size()),
+      .key_size = static_cast<uint8_t>(key.size()),
+      .reserved = 0,
+  };
+  const size_t record_size = RecordSize(header);
+  if (record_size > buffer_.size()) {
+    return;
+  }
+
+  while (buffer_.size() - used_bytes_ < record_size) {
+    EvictLeastRecentlyUsed();
+  }
+
+  WriteHeader(used_bytes_, header);
+  std::byte* data = buffer_.data() + used_bytes_ + sizeof(RecordHeader);
+  std::memcpy(data, key.data(), key.size());
+  std::memcpy(data + key.size(), value.data(), value.size());
+  used_bytes_ += record_size;
+}
+
+void ValueCache::Remove(Key key) {
+  const size_t offset = Find(key);
+  if (offset != kNotCached) {
+    RemoveRecord(offset);
+  }
+}
+
+size_t ValueCache::Find(Key key) const {
+  const uint32_t hash = Hash(key);
+
+  for (size_t offset = 0; offset < used_bytes_;) {
+    const RecordHeader header = ReadHeader(offset);
+    if (header.hash == hash && header.key_size == key.size() &&
+        std::memcmp(buffer_.data() + offset + sizeof(RecordHeader),
+                    key.data(),
+                    key.size()) == 0) {
+      return offset;
+    }
+    offset += RecordSize(header);
+  }
+  return kNotCached;
+}
+
+// Records are not aligned in the buffer, so headers are copied in and out.
+ValueCache::RecordHeader ValueCache::ReadHeader(size_t offset) const {
+  RecordHeader header;
+  std::memcpy(&header, buffer_.data() + offset, sizeof(header));
+  return header;
+}
+
+void ValueCache::WriteHeader(size_t offset, const RecordHeader& header) {
+  std::memcpy(buffer_.data() + offset, &header, sizeof(header));
+}
+
+void ValueCache::RemoveRecord(size_t offset) {
+  const size_t record_size = RecordSize(ReadHeader(offset));
+  std::memmove(buffer_.data() + offset,
+               buffer_.data() + offset + record_size,
+               used_bytes_ - offset - record_size);
+  used_bytes_ -= record_size;
+}
+
+void ValueCache::EvictLeastRecentlyUsed() {
+  size_t oldest_offset = 0;
+  // Compare ages rather than timestamps, which handles the clock wrapping.
+  uint32_t oldest_age = 0;
+
+  for (size_t offset = 0; offset < used_bytes_;) {
+    const RecordHeader header = ReadHeader(offset);
+    const uint32_t age = clock_ - header.last_used;
+    if (age >= oldest_age) {
+      oldest_offset = offset;
+      oldest_age = age;
+    }
+    offset += RecordSize(header);
+  }
+  RemoveRecord(oldest_offset);
+}
+
+}  // namespace pw::kvs::internal
@@ -0,0 +1,274 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_kvs/internal/value_cache.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs_private/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+using internal::ValueCache;
+using test::CountingPartition;
+using test::RebootableKvs;
+
+template <size_t kSize>
+std::array<std::byte, kSize> MakeBytes(uint8_t value) {
+  std::array<std::byte, kSize> bytes;
+  std::memset(bytes.data(), value, bytes.size());
+  return bytes;
+}
+
+// Each record has a 12 byte header, followed by its key and value.
+constexpr size_t kRecordSize = 12 + 1 + 8;
+
+TEST(ValueCache, Disabled_NothingIsCached) {
+  ValueCache cache({});
+  EXPECT_FALSE(cache.enabled());
+
+  cache.Put("k", MakeBytes<8>(1));
+  std::array<std::byte, 8> value;
+  EXPECT_EQ(Status::NotFound(), cache.Get("k", value).status());
+  EXPECT_EQ(0u, cache.used_bytes());
+}
+
+TEST(ValueCache, Put_Get) {
+  std::array<std::byte, 64> buffer;
+  ValueCache cache(buffer);
+  ASSERT_TRUE(cache.enabled());
+
+  cache.Put("k", MakeBytes<8>(1));
+  EXPECT_EQ(kRecordSize, cache.used_bytes());
+
+  std::array<std::byte, 8> value{};
+  StatusWithSize result = cache.Get("k", value);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(8u, result.size());
+  EXPECT_EQ(MakeBytes<8>(1), value);
+
+  EXPECT_EQ(8u, cache.ValueSize("k").size());
+  EXPECT_EQ(Status::NotFound(), cache.ValueSize("x").status());
+  EXPECT_EQ(Status::NotFound(), cache.Get("x", value).status());
+}
+
+TEST(ValueCache, Get_OffsetAndSmallBuffer) {
+  std::array<std::byte, 64> buffer;
+  ValueCache cache(buffer);
+  const std::array<std::byte, 4> data = {
+      std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}};
+  cache.Put("k", data);
+
+  std::array<std::byte, 2> value{};
+  StatusWithSize result = cache.Get("k", value, 1);
+  EXPECT_EQ(Status::ResourceExhausted(), result.status());
+  EXPECT_EQ(2u, result.size());
+  EXPECT_EQ(std::byte{2}, value[0]);
+  EXPECT_EQ(std::byte{3}, value[1]);
+
+  result = cache.Get("k", value, 2);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(2u, result.size());
+
+  EXPECT_EQ(Status::OutOfRange(), cache.Get("k", value, 5).status());
+}
+
+TEST(ValueCache, Put_ReplacesExistingValue) {
+  std::array<std::byte, 64> buffer;
+  ValueCache cache(buffer);
+  cache.Put("k", MakeBytes<8>(1));
+  cache.Put("k", MakeBytes<4>(2));
+  EXPECT_EQ(kRecordSize - 4, cache.used_bytes());
+
+  std::array<std::byte, 8> value{};
+  StatusWithSize result = cache.Get("k", value);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(4u, result.size());
+  EXPECT_EQ(std::byte{2}, value[0]);
+}
+
+TEST(ValueCache, Put_ValueTooLargeIsNotCached) {
+  std::array<std::byte, 32> buffer;
+  ValueCache cache(buffer);
+  cache.Put("k", MakeBytes<32>(1));
+  EXPECT_EQ(0u, cache.used_bytes());
+  EXPECT_EQ(Status::NotFound(), cache.ValueSize("k").status());
+}
+
+TEST(ValueCache, Remove) {
+  std::array<std::byte, 64> buffer;
+  ValueCache cache(buffer);
+  cache.Put("a", MakeBytes<8>(1));
+  cache.Put("b", MakeBytes<8>(2));
+  cache.Remove("a");
+  cache.Remove("x");
+
+  std::array<std::byte, 8> value{};
+  EXPECT_EQ(Status::NotFound(), cache.Get("a", value).status());
+  ASSERT_EQ(OkStatus(), cache.Get("b", value).status());
+  EXPECT_EQ(MakeBytes<8>(2), value);
+  EXPECT_EQ(kRecordSize, cache.used_bytes());
+}
+
+TEST(ValueCache, Full_EvictsLeastRecentlyUsed) {
+  std::array<std::byte, 3 * kRecordSize> buffer;
+  ValueCache cache(buffer);
+  cache.Put("a", MakeBytes<8>(1));
+  cache.Put("b", MakeBytes<8>(2));
+  cache.Put("c", MakeBytes<8>(3));
+
+  // Reading "a" makes "b" the least recently used value.
+  std::array<std::byte, 8> value{};
+  ASSERT_EQ(OkStatus(), cache.Get("a", value).status());
+
+  cache.Put("d", MakeBytes<8>(4));
+  EXPECT_EQ(3 * kRecordSize, cache.used_bytes());
+  EXPECT_EQ(Status::NotFound(), cache.Get("b", value).status());
+  ASSERT_EQ(OkStatus(), cache.Get("a", value).status());
+  EXPECT_EQ(MakeBytes<8>(1), value);
+  ASSERT_EQ(OkStatus(), cache.Get("c", value).status());
+  EXPECT_EQ(MakeBytes<8>(3), value);
+  ASSERT_EQ(OkStatus(), cache.Get("d", value).status());
+  EXPECT_EQ(MakeBytes<8>(4), value);
+}
+
+TEST(ValueCache, Clear) {
+  std::array<std::byte, 64> buffer;
+  ValueCache cache(buffer);
+  cache.Put("k", MakeBytes<8>(1));
+  cache.Clear();
+  EXPECT_EQ(0u, cache.used_bytes());
+  EXPECT_EQ(Status::NotFound(), cache.ValueSize("k").status());
+}
+
+using Value = std::array<uint32_t, 4>;
+
+constexpr Value kValue1 = {1, 1, 1, 1};
+constexpr Value kValue2 = {2, 2, 2, 2};
+
+class KvsValueCache : public ::testing::Test {
+ protected:
+  KvsValueCache()
+      : flash_(16), partition_(&flash_), kvs_(partition_, 0x5b2c81e7) {
+    EXPECT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+    Options options;
+    options.value_cache_buffer = cache_buffer_;
+    EXPECT_EQ(OkStatus(), kvs_.Reboot(options));
+  }
+
+  // Reads a key and returns how many flash reads the Get() took.
+  size_t ReadsToGet(std::string_view key, Value& value) {
+    partition_.ResetCounts();
+    EXPECT_EQ(OkStatus(), kvs_->Get(key, &value));
+    return partition_.reads;
+  }
+
+  FakeFlashMemoryBuffer<512, 4> flash_;
+  CountingPartition partition_;
+  std::array<std::byte, 128> cache_buffer_;
+  RebootableKvs<KeyValueStoreBuffer<8, 4>> kvs_;
+};
+
+TEST_F(KvsValueCache, Get_SecondReadIsFromCache) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue1));
+
+  Value value{};
+  EXPECT_NE(0u, ReadsToGet("k", value));
+  EXPECT_EQ(kValue1, value);
+
+  value = {};
+  EXPECT_EQ(0u, ReadsToGet("k", value));
+  EXPECT_EQ(kValue1, value);
+
+  partition_.ResetCounts();
+  EXPECT_EQ(sizeof(Value), kvs_->ValueSize("k").size());
+  EXPECT_EQ(0u, partition_.reads);
+}
+
+TEST_F(KvsValueCache, FixedSizeGet_WrongSizeFromCache) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue1));
+  Value value{};
+  ReadsToGet("k", value);
+
+  uint32_t word;
+  EXPECT_EQ(Status::InvalidArgument(), kvs_->Get("k", &word));
+}
+
+TEST_F(KvsValueCache, Put_InvalidatesCachedValue) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue1));
+  Value value{};
+  ReadsToGet("k", value);
+
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue2));
+  EXPECT_NE(0u, ReadsToGet("k", value));
+  EXPECT_EQ(kValue2, value);
+}
+
+TEST_F(KvsValueCache, Delete_InvalidatesCachedValue) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue1));
+  Value value{};
+  ReadsToGet("k", value);
+
+  ASSERT_EQ(OkStatus(), kvs_->Delete("k"));
+  EXPECT_EQ(Status::NotFound(), kvs_->Get("k", &value));
+  EXPECT_EQ(Status::NotFound(), kvs_->ValueSize("k").status());
+}
+
+TEST_F(KvsValueCache, WriteBatch_InvalidatesCachedValues) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("a", kValue1));
+  ASSERT_EQ(OkStatus(), kvs_->Put("b", kValue1));
+  Value value{};
+  ReadsToGet("a", value);
+  ReadsToGet("b", value);
+
+  const std::array writes = {KeyValueStore::BatchWrite::Put("a", kValue2),
+                             KeyValueStore::BatchWrite::Delete("b")};
+  ASSERT_EQ(OkStatus(), kvs_->WriteBatch(writes));
+
+  EXPECT_NE(0u, ReadsToGet("a", value));
+  EXPECT_EQ(kValue2, value);
+  EXPECT_EQ(Status::NotFound(), kvs_->Get("b", &value));
+}
+
+TEST_F(KvsValueCache, GarbageCollection_CachedValuesRemainValid) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue1));
+  Value value{};
+  ReadsToGet("k", value);
+
+  ASSERT_EQ(OkStatus(), kvs_->FullMaintenance());
+  EXPECT_EQ(0u, ReadsToGet("k", value));
+  EXPECT_EQ(kValue1, value);
+}
+
+TEST_F(KvsValueCache, Init_ClearsCache) {
+  ASSERT_EQ(OkStatus(), kvs_->Put("k", kValue1));
+  Value value{};
+  ReadsToGet("k", value);
+
+  ASSERT_EQ(OkStatus(), kvs_->Init());
+  EXPECT_NE(0u, ReadsToGet("k", value));
+  EXPECT_EQ(kValue1, value);
+}
+
+}  // namespace
+}  // namespace pw::kvs
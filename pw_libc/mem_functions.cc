@@ -0,0 +1,227 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_libc/mem_functions.h"
+
+#include <cstdint>
+
+// This file must be built with -fno-builtin and, on GCC,
+// -fno-tree-loop-distribute-patterns, so that the compiler does not turn these
+// loops back into calls to the functions they implement.
+
+namespace pw::libc {
+namespace {
+
+using Word = uintptr_t;
+
+// A word type that may alias any object, for accessing aligned buffers.
+typedef Word __attribute__((__may_alias__)) AliasingWord;
+
+constexpr size_t kWordSize = sizeof(Word);
+
+// Buffers shorter than this are copied a byte at a time, since aligning them
+// would take longer than copying them.
+constexpr size_t kMinWordSize = 2 * kWordSize;
+
+#if defined(__ARM_FEATURE_UNALIGNED) || defined(__x86_64__) || \
+    defined(__i386__) || defined(__aarch64__)
+constexpr bool kUnalignedAccess = true;
+#else
+constexpr bool kUnalignedAccess = false;
+#endif  // unaligned access
+
+bool IsAligned(const void* pointer) {
+  return reinterpret_cast<uintptr_t>(pointer) % kWordSize == 0u;
+}
+
+// Loads a word at any alignment. __builtin_memcpy with a constant size is
+// always inlined, even with -fno-builtin.
+Word LoadWord(const unsigned char* source) {
+  Word word;
+  __builtin_memcpy(&word, source, sizeof(word));
+  return word;
+}
+
+// Copies from the start to the end. This is safe for overlapping buffers if
+// dest is before source, since each block is loaded before it is stored.
+void CopyForward(unsigned char* dest,
+                 const unsigned char* source,
+                 size_t size) {
+  if (size >= kMinWordSize) {
+    while (!IsAligned(dest)) {
+      *dest++ = *source++;
+      size -= 1;
+    }
+
+    if (IsAligned(source)) {
+      auto* d = reinterpret_cast<AliasingWord*>(dest);
+      auto* s = reinterpret_cast<const AliasingWord*>(source);
+      for (; size >= 4 * kWordSize; size -= 4 * kWordSize) {
+        const Word w0 = s[0];
+        const Word w1 = s[1];
+        const Word w2 = s[2];
+        const Word w3 = s[3];
+        d[0] = w0;
+        d[1] = w1;
+        d[2] = w2;
+        d[3] = w3;
+        d += 4;
+        s += 4;
+      }
+      for (; size >= kWordSize; size -= kWordSize) {
+        *d++ = *s++;
+      }
+      dest = reinterpret_cast<unsigned char*>(d);
+      source = reinterpret_cast<const unsigned char*>(s);
+    } else if constexpr (kUnalignedAccess) {
+      auto* d = reinterpret_cast<AliasingWord*>(dest);
+      for (; size >= kWordSize; size -= kWordSize) {
+        *d++ = LoadWord(source);
+        source += kWordSize;
+      }
+      dest = reinterpret_cast<unsigned char*>(d);
+    }
+  }
+
+  while (size-- != 0u) {
+    *dest++ = *source++;
+  }
+}
+
+// Copies from the end to the start, for overlapping buffers with dest after
+// source. dest and source point to the ends of the buffers.
+void CopyBackward(unsigned char* dest,
+                  const unsigned char* source,
+                  size_t size) {
+  if (size >= kMinWordSize) {
+    while (!IsAligned(dest)) {
+      *--dest = *--source;
+      size -= 1;
+    }
+
+    if (IsAligned(source)) {
+      auto* d = reinterpret_cast<AliasingWord*>(dest);
+      auto* s = reinterpret_cast<const AliasingWord*>(source);
+      for (; size >= 4 * kWordSize; size -= 4 * kWordSize) {
+        d -= 4;
+        s -= 4;
+        const Word w3 = s[3];
+        const Word w2 = s[2];
+        const Word w1 = s[1];
+        const Word w0 = s[0];
+        d[3] = w3;
+        d[2] = w2;
+        d[1] = w1;
+        d[0] = w0;
+      }
+      for (; size >= kWordSize; size -= kWordSize) {
+        *--d = *--s;
+      }
+      dest = reinterpret_cast<unsigned char*>(d);
+      source = reinterpret_cast<const unsigned char*>(s);
+    } else if constexpr (kUnalignedAccess) {
+      auto* d = reinterpret_cast<AliasingWord*>(dest);
+      for (; size >= kWordSize; size -= kWordSize) {
+        source -= kWordSize;
+        *--d = LoadWord(source);
+      }
+      dest = reinterpret_cast<unsigned char*>(d);
+    }
+  }
+
+  while (size-- != 0u) {
+    *--dest = *--source;
+  }
+}
+
+}  // namespace
+
+void* Memcpy(void* dest, const void* src, size_t size) {
+  CopyForward(static_cast<unsigned char*>(dest),
+              static_cast<const unsigned char*>(src),
+              size);
+  return dest;
+}
+
+void* Memmove(void* dest, const void* src, size_t size) {
+  auto* d = static_cast<unsigned char*>(dest);
+  const auto* s = static_cast<const unsigned char*>(src);
+
+  // Compare as integers, since the buffers may be unrelated objects.
+  const uintptr_t d_address = reinterpret_cast<uintptr_t>(d);
+  const uintptr_t s_address = reinterpret_cast<uintptr_t>(s);
+  if (d_address - s_address >= size) {
+    CopyForward(d, s, size);  // dest is before source or does not overlap it.
+  } else {
+    CopyBackward(d + size, s + size, size);
+  }
+  return dest;
+}
+
+void* Memset(void* dest, int value, size_t size) {
+  auto* d = static_cast<unsigned char*>(dest);
+  const auto byte = static_cast<unsigned char>(value);
+
+  if (size >= kMinWordSize) {
+    while (!IsAligned(d)) {
+      *d++ = byte;
+      size -= 1;
+    }
+
+    // Repeat the byte in every byte of a word, e.g. 0xABABABAB.
+    const Word pattern = static_cast<Word>(~Word{0} / 0xFFu) * byte;
+    auto* words = reinterpret_cast<AliasingWord*>(d);
+    for (; size >= 4 * kWordSize; size -= 4 * kWordSize) {
+      words[0] = pattern;
+      words[1] = pattern;
+      words[2] = pattern;
+      words[3] = pattern;
+      words += 4;
+    }
+    for (; size >= kWordSize; size -= kWordSize) {
+      *words++ = pattern;
+    }
+    d = reinterpret_cast<unsigned char*>(words);
+  }
+
+  while (size-- != 0u) {
+    *d++ = byte;
+  }
+  return dest;
+}
+
+int Memcmp(const void* lhs, const void* rhs, size_t size) {
+  const auto* a = static_cast<const unsigned char*>(lhs);
+  const auto* b = static_cast<const unsigned char*>(rhs);
+
+  // Skip equal words. The first difference is then found a byte at a time.
+  if (kUnalignedAccess || (IsAligned(a) && IsAligned(b))) {
+    while (size >= kWordSize && LoadWord(a) == LoadWord(b)) {
+      a += kWordSize;
+      b += kWordSize;
+      size -= kWordSize;
+    }
+  }
+
+  for (; size != 0u; --size) {
+    if (*a != *b) {
+      return *a < *b ? -1 : 1;
+    }
+    ++a;
+    ++b;
+  }
+  return 0;
+}
+
+}  // namespace pw::libc
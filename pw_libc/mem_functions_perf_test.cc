@@ -0,0 +1,74 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_libc/mem_functions.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::libc {
+namespace {
+
+// Compares pw_libc's memory functions with the toolchain's C library.
+
+constexpr size_t kBufferSize = 1024;
+
+std::array<std::byte, kBufferSize + 1> source;
+std::array<std::byte, kBufferSize + 1> dest;
+
+template <void* (*kCopy)(void*, const void*, size_t)>
+void CopyTest(perf_test::State& state, size_t offset, size_t size) {
+  while (state.KeepRunning()) {
+    kCopy(&dest[offset], source.data(), size);
+  }
+}
+
+template <void* (*kSet)(void*, int, size_t)>
+void SetTest(perf_test::State& state, size_t size) {
+  while (state.KeepRunning()) {
+    kSet(dest.data(), 0x5a, size);
+  }
+}
+
+// memmove within one buffer, with the destination after the source.
+template <void* (*kMove)(void*, const void*, size_t)>
+void MoveTest(perf_test::State& state, size_t size) {
+  while (state.KeepRunning()) {
+    kMove(&dest[1], dest.data(), size);
+  }
+}
+
+PW_PERF_TEST(Memcpy16, CopyTest<Memcpy>, 0, 16);
+PW_PERF_TEST(Memcpy256, CopyTest<Memcpy>, 0, 256);
+PW_PERF_TEST(Memcpy1024, CopyTest<Memcpy>, 0, 1024);
+PW_PERF_TEST(Memcpy256Unaligned, CopyTest<Memcpy>, 1, 256);
+PW_PERF_TEST(StdMemcpy16, CopyTest<std::memcpy>, 0, 16);
+PW_PERF_TEST(StdMemcpy256, CopyTest<std::memcpy>, 0, 256);
+PW_PERF_TEST(StdMemcpy1024, CopyTest<std::memcpy>, 0, 1024);
+PW_PERF_TEST(StdMemcpy256Unaligned, CopyTest<std::memcpy>, 1, 256);
+
+PW_PERF_TEST(Memset16, SetTest<Memset>, 16);
+PW_PERF_TEST(Memset256, SetTest<Memset>, 256);
+PW_PERF_TEST(Memset1024, SetTest<Memset>, 1024);
+PW_PERF_TEST(StdMemset16, SetTest<std::memset>, 16);
+PW_PERF_TEST(StdMemset256, SetTest<std::memset>, 256);
+PW_PERF_TEST(StdMemset1024, SetTest<std::memset>, 1024);
+
+PW_PERF_TEST(Memmove256, MoveTest<Memmove>, 256);
+PW_PERF_TEST(StdMemmove256, MoveTest<std::memmove>, 256);
+
+}  // namespace
+}  // namespace pw::libc
@@ -0,0 +1,168 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_libc/mem_functions.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::libc {
+namespace {
+
+// Covers every combination of alignments for word-sized accesses, buffers
+// shorter than a word, and buffers spanning several four-word blocks.
+constexpr size_t kMaxOffset = 2 * sizeof(uintptr_t);
+constexpr size_t kMaxSize = 80;
+constexpr size_t kBufferSize = kMaxOffset + kMaxSize + kMaxOffset;
+
+using Buffer = std::array<unsigned char, kBufferSize>;
+
+Buffer Pattern(unsigned char seed) {
+  Buffer buffer;
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = static_cast<unsigned char>(seed + i * 7);
+  }
+  return buffer;
+}
+
+// Byte-at-a-time reference implementation of memmove.
+void ReferenceMove(unsigned char* dest, const unsigned char* src, size_t size) {
+  if (dest < src) {
+    for (size_t i = 0; i < size; ++i) {
+      dest[i] = src[i];
+    }
+  } else {
+    for (size_t i = size; i > 0; --i) {
+      dest[i - 1] = src[i - 1];
+    }
+  }
+}
+
+TEST(Memcpy, AllAlignmentsAndSizes) {
+  const Buffer source = Pattern(1);
+  for (size_t dest_offset = 0; dest_offset < kMaxOffset; ++dest_offset) {
+    for (size_t src_offset = 0; src_offset < kMaxOffset; ++src_offset) {
+      for (size_t size = 0; size <= kMaxSize; ++size) {
+        Buffer dest = Pattern(100);
+        Buffer expected = Pattern(100);
+        ReferenceMove(&expected[dest_offset], &source[src_offset], size);
+
+        void* result = Memcpy(&dest[dest_offset], &source[src_offset], size);
+        EXPECT_EQ(result, &dest[dest_offset]);
+        ASSERT_EQ(dest, expected) << "dest offset " << dest_offset
+                                  << ", src offset " << src_offset
+                                  << ", size " << size;
+      }
+    }
+  }
+}
+
+TEST(Memmove, Overlapping) {
+  for (size_t dest_offset = 0; dest_offset < 2 * kMaxOffset; ++dest_offset) {
+    for (size_t src_offset = 0; src_offset < 2 * kMaxOffset; ++src_offset) {
+      for (size_t size = 0; size <= kMaxSize; ++size) {
+        Buffer buffer = Pattern(1);
+        Buffer expected = Pattern(1);
+        ReferenceMove(&expected[dest_offset], &expected[src_offset], size);
+
+        void* result = Memmove(&buffer[dest_offset], &buffer[src_offset], size);
+        EXPECT_EQ(result, &buffer[dest_offset]);
+        ASSERT_EQ(buffer, expected) << "dest offset " << dest_offset
+                                    << ", src offset " << src_offset
+                                    << ", size " << size;
+      }
+    }
+  }
+}
+
+TEST(Memmove, NonOverlapping) {
+  const Buffer source = Pattern(1);
+  Buffer dest = Pattern(100);
+  Buffer expected = Pattern(100);
+  ReferenceMove(&expected[3], &source[5], kMaxSize);
+
+  EXPECT_EQ(Memmove(&dest[3], &source[5], kMaxSize), &dest[3]);
+  EXPECT_EQ(dest, expected);
+}
+
+TEST(Memset, AllAlignmentsAndSizes) {
+  for (size_t offset = 0; offset < kMaxOffset; ++offset) {
+    for (size_t size = 0; size <= kMaxSize; ++size) {
+      Buffer buffer = Pattern(1);
+      Buffer expected = Pattern(1);
+      for (size_t i = 0; i < size; ++i) {
+        expected[offset + i] = 0xA5;
+      }
+
+      EXPECT_EQ(Memset(&buffer[offset], 0xA5, size), &buffer[offset]);
+      ASSERT_EQ(buffer, expected) << "offset " << offset << ", size " << size;
+    }
+  }
+}
+
+TEST(Memset, UsesOnlyLowByteOfValue) {
+  Buffer buffer = Pattern(1);
+  Memset(buffer.data(), -1, buffer.size());
+  for (unsigned char byte : buffer) {
+    EXPECT_EQ(byte, 0xFFu);
+  }
+
+  Memset(buffer.data(), 0x1234, buffer.size());
+  for (unsigned char byte : buffer) {
+    EXPECT_EQ(byte, 0x34u);
+  }
+}
+
+TEST(Memcmp, Equal) {
+  const Buffer lhs = Pattern(1);
+  const Buffer rhs = Pattern(1);
+  for (size_t offset = 0; offset < kMaxOffset; ++offset) {
+    for (size_t size = 0; size <= kMaxSize; ++size) {
+      EXPECT_EQ(Memcmp(&lhs[offset], &rhs[offset], size), 0);
+    }
+  }
+  EXPECT_EQ(Memcmp(&lhs[1], &rhs[2], 0), 0);
+}
+
+TEST(Memcmp, FirstDifferenceDecides) {
+  for (size_t offset = 0; offset < kMaxOffset; ++offset) {
+    for (size_t index = 0; index < kMaxSize; ++index) {
+      Buffer lhs = Pattern(1);
+      Buffer rhs = Pattern(1);
+      lhs[offset + index] = 0x10;
+      rhs[offset + index] = 0x20;
+      // A later difference in the other direction must not affect the result.
+      lhs[kBufferSize - 1] = 0xFF;
+      rhs[kBufferSize - 1] = 0x00;
+
+      const size_t size = kBufferSize - offset;
+      EXPECT_LT(Memcmp(&lhs[offset], &rhs[offset], size), 0);
+      EXPECT_GT(Memcmp(&rhs[offset], &lhs[offset], size), 0);
+      EXPECT_EQ(Memcmp(&lhs[offset], &rhs[offset], index), 0);
+    }
+  }
+}
+
+TEST(Memcmp, ComparesAsUnsignedChar) {
+  const unsigned char lhs[] = {0x80};
+  const unsigned char rhs[] = {0x7F};
+  EXPECT_GT(Memcmp(lhs, rhs, sizeof(lhs)), 0);
+  EXPECT_LT(Memcmp(rhs, lhs, sizeof(lhs)), 0);
+}
+
+}  // namespace
+}  // namespace pw::libc
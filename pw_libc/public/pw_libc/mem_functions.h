@@ -0,0 +1,40 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+namespace pw::libc {
+
+/// Word-oriented implementations of the `<string.h>` memory functions.
+///
+/// These behave exactly like their standard counterparts. They copy, set, and
+/// compare a word at a time once the destination is word-aligned, and copy
+/// blocks of four words when both buffers are aligned, which Cortex-M
+/// compilers emit as `LDM`/`STM` bursts. Misaligned sources use unaligned word
+/// loads on targets that support them, such as Armv7-M, and fall back to byte
+/// copies elsewhere, such as Armv6-M.
+///
+/// These functions are also used for the C library's `memcpy`, `memmove`,
+/// `memset`, and `memcmp` when `pw_libc` is built with
+/// `pw_libc_USE_PW_MEM_FUNCTIONS`.
+///
+/// @{
+void* Memcpy(void* dest, const void* src, size_t size);
+void* Memmove(void* dest, const void* src, size_t size);
+void* Memset(void* dest, int value, size_t size);
+int Memcmp(const void* lhs, const void* rhs, size_t size);
+/// @}
+
+}  // namespace pw::libc
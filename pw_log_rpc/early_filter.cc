@@ -0,0 +1,180 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_log_rpc/early_filter.h"
+
+#include <algorithm>
+
+#include "pw_bytes/endian.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/proto/log.pwpb.h"
+#include "pw_thread/sleep.h"
+
+namespace pw::log_rpc {
+namespace {
+
+bool IsUnconditional(const Filter::Rule& rule) {
+  return rule.level_greater_than_or_equal ==
+             log::pwpb::FilterRule::Level::ANY_LEVEL &&
+         rule.any_flags_set == 0 && rule.module_equals.empty() &&
+         rule.thread_equals.empty();
+}
+
+// Returns true if the provided log parameters match the given rule.
+bool IsRuleMet(const EarlyFilter::CompiledRule& rule,
+               uint32_t level,
+               uint32_t flags,
+               ConstByteSpan module,
+               ConstByteSpan thread) {
+  if (level < rule.level_greater_than_or_equal) {
+    return false;
+  }
+  if ((rule.any_flags_set != 0) && ((flags & rule.any_flags_set) == 0)) {
+    return false;
+  }
+  if (!rule.module_equals.empty() && !std::equal(module.begin(),
+                                                 module.end(),
+                                                 rule.module_equals.begin(),
+                                                 rule.module_equals.end())) {
+    return false;
+  }
+  if (!rule.thread_equals.empty() && !std::equal(thread.begin(),
+                                                 thread.end(),
+                                                 rule.thread_equals.begin(),
+                                                 rule.thread_equals.end())) {
+    return false;
+  }
+  return true;
+}
+
+// Returns true if every filter in the snapshot drops the log. Each filter
+// follows the action of its first rule that is met, and keeps the log if none
+// are met.
+bool SnapshotDropsLog(span<const EarlyFilter::CompiledRule> rules,
+                      uint32_t level,
+                      uint32_t flags,
+                      ConstByteSpan module,
+                      ConstByteSpan thread) {
+  if (rules.empty()) {
+    return false;
+  }
+  bool filter_drops = false;
+  bool filter_decided = false;
+  for (const EarlyFilter::CompiledRule& rule : rules) {
+    if (rule.starts_filter) {
+      if (&rule != rules.data() && !filter_drops) {
+        return false;  // The previous filter keeps the log.
+      }
+      filter_drops = false;
+      filter_decided = false;
+    }
+    if (!filter_decided && IsRuleMet(rule, level, flags, module, thread)) {
+      filter_decided = true;
+      filter_drops = rule.drop;
+    }
+  }
+  return filter_drops;
+}
+
+}  // namespace
+
+Status EarlyFilter::Update() {
+  const uint32_t target = active_.load() ^ 1u;
+
+  // Checks that started on the target snapshot before it was replaced may
+  // still be using it.
+  while (readers_[target].load() != 0) {
+    this_thread::sleep_for(chrono::SystemClock::duration(1));
+  }
+
+  const span<CompiledRule> rules = Snapshot(target);
+  size_t count = 0;
+  bool drops_logs = !filter_map_.filters().empty();
+  Status status;
+  for (const Filter& filter : filter_map_.filters()) {
+    const size_t filter_start = count;
+    bool filter_drops_logs = false;
+    for (const Filter::Rule& rule : filter.rules()) {
+      if (rule.action == Filter::Rule::Action::kInactive) {
+        continue;
+      }
+      if (count == rules.size()) {
+        status = Status::ResourceExhausted();
+        break;
+      }
+      CompiledRule& compiled = rules[count++];
+      compiled.starts_filter = (count - 1 == filter_start);
+      compiled.drop = rule.action == Filter::Rule::Action::kDrop;
+      compiled.level_greater_than_or_equal =
+          static_cast<uint32_t>(rule.level_greater_than_or_equal);
+      compiled.any_flags_set = rule.any_flags_set;
+      compiled.module_equals.assign(rule.module_equals.begin(),
+                                    rule.module_equals.end());
+      compiled.thread_equals.assign(rule.thread_equals.begin(),
+                                    rule.thread_equals.end());
+      filter_drops_logs = filter_drops_logs || compiled.drop;
+      if (IsUnconditional(rule)) {
+        break;  // Later rules are never reached.
+      }
+    }
+    // If any filter never drops logs, no log can be dropped early.
+    if (!status.ok() || !filter_drops_logs) {
+      drops_logs = false;
+      break;
+    }
+  }
+
+  rule_counts_[target] = drops_logs ? count : 0;
+  active_.store(target);
+  return status;
+}
+
+bool EarlyFilter::ShouldDropLog(uint32_t level,
+                                uint32_t flags,
+                                ConstByteSpan module,
+                                ConstByteSpan thread) const {
+  // Register as a reader of the active snapshot, retrying if it was replaced
+  // in the meantime, so that Update() doesn't overwrite it during the check.
+  uint32_t index;
+  while (true) {
+    index = active_.load();
+    readers_[index].fetch_add(1);
+    if (active_.load() == index) {
+      break;
+    }
+    readers_[index].fetch_sub(1);
+  }
+
+  const bool drop = SnapshotDropsLog(Snapshot(index).first(rule_counts_[index]),
+                                     level,
+                                     flags,
+                                     module,
+                                     thread);
+  readers_[index].fetch_sub(1);
+  return drop;
+}
+
+bool EarlyFilter::ShouldDropLog(log_tokenized::Metadata metadata,
+                                ConstByteSpan thread) const {
+  const uint32_t little_endian_module =
+      bytes::ConvertOrderTo(endian::little, metadata.module());
+  ConstByteSpan module;
+  if (metadata.module() != 0) {
+    module = as_bytes(span(&little_endian_module, 1));
+  }
+  return ShouldDropLog(metadata.level(), metadata.flags(), module, thread);
+}
+
+}  // namespace pw::log_rpc
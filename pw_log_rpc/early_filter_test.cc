@@ -0,0 +1,202 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_log_rpc/early_filter.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/endian.h"
+#include "pw_log/levels.h"
+#include "pw_log/proto/log.pwpb.h"
+#include "pw_log_rpc/log_filter.h"
+#include "pw_log_rpc/log_filter_map.h"
+#include "pw_log_tokenized/metadata.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::log_rpc {
+namespace {
+
+namespace FilterRule = ::pw::log::pwpb::FilterRule;
+
+constexpr uint32_t kSampleModule = 0x1234;
+constexpr auto kSampleModuleLittleEndian =
+    bytes::CopyInOrder<uint32_t>(endian::little, kSampleModule);
+constexpr std::array<std::byte, 3> kSampleThread = {
+    std::byte('R'), std::byte('P'), std::byte('C')};
+
+const std::array<std::byte, cfg::kMaxFilterIdBytes> kFilterId1{
+    std::byte(0xfe), std::byte(0xed), std::byte(0xba), std::byte(0xb1)};
+const std::array<std::byte, cfg::kMaxFilterIdBytes> kFilterId2{
+    std::byte(0xca), std::byte(0xfe), std::byte(0xc0), std::byte(0xc0)};
+
+Filter::Rule KeepAtOrAbove(FilterRule::Level level) {
+  return {
+      .action = Filter::Rule::Action::kKeep,
+      .level_greater_than_or_equal = level,
+      .any_flags_set = 0,
+      .module_equals{},
+      .thread_equals{},
+  };
+}
+
+const Filter::Rule kDropAll = {
+    .action = Filter::Rule::Action::kDrop,
+    .level_greater_than_or_equal = FilterRule::Level::ANY_LEVEL,
+    .any_flags_set = 0,
+    .module_equals{},
+    .thread_equals{},
+};
+
+TEST(EarlyFilter, DropsNothingBeforeUpdate) {
+  std::array<Filter::Rule, 1> rules = {kDropAll};
+  std::array<Filter, 1> filters = {Filter(kFilterId1, rules)};
+  FilterMap filter_map(filters);
+  EarlyFilterWithBuffer<4> early_filter(filter_map);
+
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0, {}));
+
+  ASSERT_EQ(early_filter.Update(), OkStatus());
+  EXPECT_TRUE(early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0, {}));
+}
+
+TEST(EarlyFilter, DropsOnlyLogsThatEveryFilterDrops) {
+  std::array<Filter::Rule, 2> rules1 = {
+      KeepAtOrAbove(FilterRule::Level::INFO_LEVEL), kDropAll};
+  std::array<Filter::Rule, 2> rules2 = {
+      KeepAtOrAbove(FilterRule::Level::WARN_LEVEL), kDropAll};
+  std::array<Filter, 2> filters = {Filter(kFilterId1, rules1),
+                                   Filter(kFilterId2, rules2)};
+  FilterMap filter_map(filters);
+  EarlyFilterWithBuffer<4> early_filter(filter_map);
+  ASSERT_EQ(early_filter.Update(), OkStatus());
+
+  EXPECT_TRUE(early_filter.ShouldDropLog(PW_LOG_LEVEL_DEBUG, 0, {}));
+  // Only the second filter drops INFO logs.
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0, {}));
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_WARN, 0, {}));
+}
+
+TEST(EarlyFilter, FilterThatNeverDropsDisablesEarlyDrops) {
+  std::array<Filter::Rule, 1> rules1 = {kDropAll};
+  std::array<Filter::Rule, 1> rules2 = {
+      KeepAtOrAbove(FilterRule::Level::ANY_LEVEL)};
+  std::array<Filter, 2> filters = {Filter(kFilterId1, rules1),
+                                   Filter(kFilterId2, rules2)};
+  FilterMap filter_map(filters);
+  EarlyFilterWithBuffer<4> early_filter(filter_map);
+  ASSERT_EQ(early_filter.Update(), OkStatus());
+
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_DEBUG, 0, {}));
+
+  // The filter's rules changing takes effect on the next update.
+  rules2[0] = kDropAll;
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_DEBUG, 0, {}));
+  ASSERT_EQ(early_filter.Update(), OkStatus());
+  EXPECT_TRUE(early_filter.ShouldDropLog(PW_LOG_LEVEL_DEBUG, 0, {}));
+}
+
+TEST(EarlyFilter, MatchesModuleFlagsAndThread) {
+  std::array<Filter::Rule, 4> rules = {{
+      {
+          .action = Filter::Rule::Action::kInactive,
+          .level_greater_than_or_equal = FilterRule::Level::ANY_LEVEL,
+          .any_flags_set = 0,
+          .module_equals{},
+          .thread_equals{},
+      },
+      {
+          .action = Filter::Rule::Action::kDrop,
+          .level_greater_than_or_equal = FilterRule::Level::ANY_LEVEL,
+          .any_flags_set = 0,
+          .module_equals{kSampleModuleLittleEndian.begin(),
+                         kSampleModuleLittleEndian.end()},
+          .thread_equals{},
+      },
+      {
+          .action = Filter::Rule::Action::kDrop,
+          .level_greater_than_or_equal = FilterRule::Level::ANY_LEVEL,
+          .any_flags_set = 0x2,
+          .module_equals{},
+          .thread_equals{kSampleThread.begin(), kSampleThread.end()},
+      },
+      KeepAtOrAbove(FilterRule::Level::ANY_LEVEL),
+  }};
+  std::array<Filter, 1> filters = {Filter(kFilterId1, rules)};
+  FilterMap filter_map(filters);
+  EarlyFilterWithBuffer<4> early_filter(filter_map);
+  ASSERT_EQ(early_filter.Update(), OkStatus());
+
+  EXPECT_TRUE(early_filter.ShouldDropLog(
+      PW_LOG_LEVEL_INFO, 0, kSampleModuleLittleEndian));
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0, {}));
+  EXPECT_TRUE(
+      early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0x3, {}, kSampleThread));
+  EXPECT_FALSE(
+      early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0x1, {}, kSampleThread));
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0x3, {}));
+}
+
+TEST(EarlyFilter, MatchesTokenizedMetadata) {
+  std::array<Filter::Rule, 3> rules = {{
+      {
+          .action = Filter::Rule::Action::kDrop,
+          .level_greater_than_or_equal = FilterRule::Level::ANY_LEVEL,
+          .any_flags_set = 0,
+          .module_equals{kSampleModuleLittleEndian.begin(),
+                         kSampleModuleLittleEndian.end()},
+          .thread_equals{},
+      },
+      KeepAtOrAbove(FilterRule::Level::WARN_LEVEL),
+      kDropAll,
+  }};
+  std::array<Filter::Rule, 1> catch_all = {kDropAll};
+  std::array<Filter, 2> filters = {Filter(kFilterId1, rules),
+                                   Filter(kFilterId2, catch_all)};
+  FilterMap filter_map(filters);
+  EarlyFilterWithBuffer<4> early_filter(filter_map);
+  ASSERT_EQ(early_filter.Update(), OkStatus());
+
+  EXPECT_TRUE(early_filter.ShouldDropLog(
+      log_tokenized::Metadata::
+          Set<PW_LOG_LEVEL_ERROR, kSampleModule, 0, 0>()));
+  EXPECT_TRUE(early_filter.ShouldDropLog(
+      log_tokenized::Metadata::Set<PW_LOG_LEVEL_INFO, 0, 0, 0>()));
+  EXPECT_FALSE(early_filter.ShouldDropLog(
+      log_tokenized::Metadata::Set<PW_LOG_LEVEL_ERROR, 0, 0, 0>()));
+}
+
+TEST(EarlyFilter, TooManyRulesDropsNothing) {
+  std::array<Filter::Rule, 3> rules = {
+      KeepAtOrAbove(FilterRule::Level::INFO_LEVEL),
+      KeepAtOrAbove(FilterRule::Level::WARN_LEVEL),
+      kDropAll};
+  std::array<Filter, 1> filters = {Filter(kFilterId1, rules)};
+  FilterMap filter_map(filters);
+  EarlyFilterWithBuffer<2> early_filter(filter_map);
+
+  EXPECT_EQ(early_filter.Update(), Status::ResourceExhausted());
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_DEBUG, 0, {}));
+
+  rules[1] = kDropAll;
+  ASSERT_EQ(early_filter.Update(), OkStatus());
+  EXPECT_TRUE(early_filter.ShouldDropLog(PW_LOG_LEVEL_DEBUG, 0, {}));
+  EXPECT_FALSE(early_filter.ShouldDropLog(PW_LOG_LEVEL_INFO, 0, {}));
+}
+
+}  // namespace
+}  // namespace pw::log_rpc
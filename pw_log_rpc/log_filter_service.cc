@@ -46,7 +46,13 @@ Status FilterService::SetFilterImpl(ConstByteSpan request) {
   }
   PW_TRY(decoder.ReadBytes(&filter_buffer));
 
-  return filter.value()->UpdateRulesFromProto(filter_buffer);
+  const Status status = filter.value()->UpdateRulesFromProto(filter_buffer);
+  if (early_filter_ != nullptr) {
+    // If the rules don't fit, the early filter stops dropping logs, and the
+    // drains still filter them.
+    early_filter_->Update().IgnoreError();
+  }
+  return status;
 }
 
 StatusWithSize FilterService::GetFilterImpl(ConstByteSpan request,
@@ -0,0 +1,123 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_containers/vector.h"
+#include "pw_log_rpc/internal/config.h"
+#include "pw_log_rpc/log_filter_map.h"
+#include "pw_log_tokenized/metadata.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::log_rpc {
+
+// An EarlyFilter lets log handlers, such as pw_log_tokenized_HandleLog(),
+// drop logs before they are encoded and added to the MultiSink, instead of
+// having each RpcLogDrain decode and drop them later.
+//
+// The EarlyFilter holds a compiled snapshot of the rules of all Filters in a
+// FilterMap. Since each filter belongs to a different drain, a log is dropped
+// early only if every filter drops it. Drains without a filter keep all logs,
+// so only check the EarlyFilter if every drain reading the MultiSink has a
+// filter from the map.
+//
+// Checking the snapshot is lock-free and safe from any context, including
+// interrupts. The snapshot is only recompiled by Update(), so it must be
+// called whenever filter rules change. FilterService does this when it is
+// given an EarlyFilter.
+class EarlyFilter {
+ public:
+  // A filter rule reduced to what is needed to check a log.
+  struct CompiledRule {
+    // True for the first rule of each filter.
+    bool starts_filter = false;
+    // True if logs that meet this rule are dropped, false if they are kept.
+    bool drop = false;
+    uint32_t level_greater_than_or_equal = 0;
+    uint32_t any_flags_set = 0;
+    Vector<std::byte, cfg::kMaxModuleNameBytes> module_equals{};
+    Vector<std::byte, cfg::kMaxThreadNameBytes> thread_equals{};
+  };
+
+  // The rule buffer holds two snapshots, so each snapshot holds up to half of
+  // its rules. Until Update() is called, no logs are dropped.
+  EarlyFilter(const FilterMap& filter_map, span<CompiledRule> rule_buffer)
+      : filter_map_(filter_map),
+        rule_buffer_(rule_buffer),
+        rule_counts_{0, 0},
+        active_(0),
+        readers_{} {}
+
+  // Not copyable nor movable.
+  EarlyFilter(const EarlyFilter&) = delete;
+  EarlyFilter& operator=(const EarlyFilter&) = delete;
+
+  // Compiles the filter map's current rules into a new snapshot, then makes it
+  // the active snapshot. Inactive rules, and rules after one that meets every
+  // log, are left out. Waits for any checks still using the snapshot being
+  // replaced to finish. Calls to Update() must not run concurrently.
+  //
+  // Return values:
+  // OK - The snapshot was updated.
+  // RESOURCE_EXHAUSTED - The rules don't fit in a snapshot. No logs are dropped
+  // early until Update() succeeds.
+  Status Update();
+
+  // Returns true if every filter would drop a log with the provided level,
+  // flags, module, and thread, as they are encoded in a log::LogEntry.
+  bool ShouldDropLog(uint32_t level,
+                     uint32_t flags,
+                     ConstByteSpan module,
+                     ConstByteSpan thread = {}) const;
+
+  // Returns true if every filter would drop a tokenized log with the provided
+  // metadata. The module is matched as log::EncodeTokenizedLog() encodes it.
+  bool ShouldDropLog(log_tokenized::Metadata metadata,
+                     ConstByteSpan thread = {}) const;
+
+ private:
+  span<CompiledRule> Snapshot(uint32_t index) const {
+    const size_t size = rule_buffer_.size() / 2;
+    return rule_buffer_.subspan(index * size, size);
+  }
+
+  const FilterMap& filter_map_;
+  const span<CompiledRule> rule_buffer_;
+  // Rules in each snapshot. A snapshot with no rules drops nothing.
+  std::array<size_t, 2> rule_counts_;
+  // The snapshot that checks use.
+  std::atomic<uint32_t> active_;
+  // The number of checks using each snapshot.
+  mutable std::array<std::atomic<uint32_t>, 2> readers_;
+};
+
+// An EarlyFilter that holds snapshots of up to kMaxRules compiled rules.
+template <size_t kMaxRules>
+class EarlyFilterWithBuffer final : public EarlyFilter {
+ public:
+  explicit EarlyFilterWithBuffer(const FilterMap& filter_map)
+      : EarlyFilter(filter_map, rule_buffer_array_) {}
+
+ private:
+  std::array<CompiledRule, 2 * kMaxRules> rule_buffer_array_;
+};
+
+}  // namespace pw::log_rpc
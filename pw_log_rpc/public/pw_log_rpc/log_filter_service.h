@@ -15,6 +15,7 @@
 #pragma once
 
 #include "pw_log/proto/log.raw_rpc.pb.h"
+#include "pw_log_rpc/early_filter.h"
 #include "pw_log_rpc/log_filter_map.h"
 #include "pw_status/status_with_size.h"
 
@@ -24,7 +25,10 @@ namespace pw::log_rpc {
 class FilterService final
     : public log::pw_rpc::raw::Filters::Service<FilterService> {
  public:
-  FilterService(FilterMap& filter_map) : filter_map_(filter_map) {}
+  // If an EarlyFilter for the filter map is provided, it is updated whenever a
+  // filter is modified.
+  FilterService(FilterMap& filter_map, EarlyFilter* early_filter = nullptr)
+      : filter_map_(filter_map), early_filter_(early_filter) {}
 
   //  Modifies a log filter and its rules. The filter must be registered in the
   //  provided filter map.
@@ -78,6 +82,7 @@ class FilterService final
   StatusWithSize ListFilterIdsImpl(ByteSpan response);
 
   FilterMap& filter_map_;
+  EarlyFilter* early_filter_;
 };
 
 }  // namespace pw::log_rpc
@@ -28,6 +28,7 @@
 #include "pw_log/proto/log.pwpb.h"
 #include "pw_log_rpc/internal/config.h"
 #include "pw_log_rpc/log_filter.h"
+#include "pw_metric/metric.h"
 #include "pw_multisink/multisink.h"
 #include "pw_protobuf/serialized_size.h"
 #include "pw_result/result.h"
@@ -164,10 +165,17 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
   // OK - all entries were consumed.
   // ABORTED - there was an error writing the packet, and error_handling equals
   // `kCloseStreamOnWriterError`.
+  // UNAVAILABLE - there was an error writing the packet and the writer backoff
+  // is enabled. The remaining entries were left in the MultiSink.
   Status Flush(ByteSpan encoding_buffer) PW_LOCKS_EXCLUDED(mutex_);
 
   // Writes entries as dictated by this drain's rate limiting configuration.
   //
+  // If flush_full_packets() is set, the trickle delay is skipped once there are
+  // enough entries pending to fill `encoding_buffer`, so full packets are sent
+  // without waiting. If a writer backoff is set, a write error holds off
+  // further writes for an exponentially increasing delay, up to the maximum.
+  //
   // Returns:
   //   A minimum wait duration before Trickle() will be ready to write more logs
   // If no duration is returned, this drain is caught up.
@@ -194,6 +202,35 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
     trickle_delay_ = trickle_delay;
   }
 
+  // Whether Trickle() sends a full packet of pending entries without waiting
+  // for the trickle delay. Off by default.
+  bool flush_full_packets() const { return flush_full_packets_; }
+  void set_flush_full_packets(bool flush_full_packets) {
+    flush_full_packets_ = flush_full_packets;
+  }
+
+  // The longest that Trickle() waits after a writer error before writing
+  // again. The wait starts at the trickle delay, or 1 ms if that is shorter,
+  // and doubles on each consecutive error. Zero, the default, disables the
+  // backoff.
+  chrono::SystemClock::duration max_writer_backoff() const {
+    return max_writer_backoff_;
+  }
+  void set_max_writer_backoff(chrono::SystemClock::duration max_backoff) {
+    max_writer_backoff_ = max_backoff;
+  }
+
+  // Metrics for this drain's log stream:
+  //
+  //   bundles_sent - LogEntries packets written successfully.
+  //   entries_sent - Log entries in the packets written successfully.
+  //   entries_dropped - Drops reported to the log listener in drop messages.
+  //   writer_errors - Packets that the writer failed to write.
+  //   max_latency_ms - The longest that pending entries were held back by the
+  //     trickle delay or writer backoff before being sent.
+  //
+  const metric::Group& metrics() const { return metrics_; }
+
   // Stores a function that is called when Open() is successful. Pass nulltpr to
   // clear it. This is useful in cases where the owner of the drain needs to be
   // notified that the drain was opened.
@@ -231,7 +268,21 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
   size_t max_bundles_per_trickle_;
   pw::chrono::SystemClock::duration trickle_delay_;
   pw::chrono::SystemClock::time_point no_writes_until_;
+  bool flush_full_packets_ = false;
+  pw::chrono::SystemClock::duration max_writer_backoff_ =
+      chrono::SystemClock::duration::zero();
+  pw::chrono::SystemClock::duration writer_backoff_ =
+      chrono::SystemClock::duration::zero();
+  // When Trickle() first held back pending entries, if it is holding them.
+  std::optional<pw::chrono::SystemClock::time_point> pending_since_;
   pw::Function<void()> on_open_callback_;
+
+  PW_METRIC_GROUP(metrics_, "rpc_log_drain");
+  PW_METRIC(metrics_, bundles_sent_, "bundles_sent", 0u);
+  PW_METRIC(metrics_, entries_sent_, "entries_sent", 0u);
+  PW_METRIC(metrics_, entries_dropped_, "entries_dropped", 0u);
+  PW_METRIC(metrics_, writer_errors_, "writer_errors", 0u);
+  PW_METRIC(metrics_, max_latency_ms_, "max_latency_ms", 0u);
 };
 
 }  // namespace pw::log_rpc
@@ -41,7 +41,8 @@ class RpcLogDrainThread : public thread::ThreadCore,
   RpcLogDrainThread(multisink::MultiSink& multisink,
                     RpcLogDrainMap& drain_map,
                     span<std::byte> encoding_buffer)
-      : drain_map_(drain_map),
+      : multisink::MultiSink::Listener(/*coalesce_notifications=*/true),
+        drain_map_(drain_map),
         multisink_(multisink),
         encoding_buffer_(encoding_buffer) {}
 
@@ -67,6 +68,9 @@ class RpcLogDrainThread : public thread::ThreadCore,
       } else {
         ready_to_flush_notification_.acquire();
       }
+      // Entries added from here on wake the thread again, so that none are
+      // missed by the drain pass below.
+      multisink_.ResumeNotifications(*this);
       drains_pending = false;
       min_delay = std::nullopt;
       for (auto& drain : drain_map_.drains()) {
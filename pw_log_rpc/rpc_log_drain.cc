@@ -14,6 +14,8 @@
 
 #include "pw_log_rpc/rpc_log_drain.h"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
 #include <mutex>
 #include <optional>
@@ -31,9 +33,14 @@
 namespace pw::log_rpc {
 namespace {
 
+// The shortest wait after a writer error when the writer backoff is enabled.
+constexpr chrono::SystemClock::duration kMinWriterBackoff =
+    chrono::SystemClock::for_at_least(std::chrono::milliseconds(1));
+
 // Creates an encoded drop message on the provided buffer and adds it to the
-// bulk log entries. Resets the drop count when successfull.
-void TryEncodeDropMessage(
+// bulk log entries. Resets the drop count when successfull, and returns the
+// number of drops reported.
+uint32_t TryEncodeDropMessage(
     ByteSpan encoded_drop_message_buffer,
     std::string_view reason,
     uint32_t& drop_count,
@@ -45,7 +52,7 @@ void TryEncodeDropMessage(
   }
   encoder.WriteDropped(drop_count).IgnoreError();
   if (!encoder.status().ok()) {
-    return;
+    return 0;
   }
   // Add encoded drop messsage if fits in buffer.
   ConstByteSpan drop_message(encoder);
@@ -54,8 +61,11 @@ void TryEncodeDropMessage(
     PW_CHECK_OK(entries_encoder.WriteBytes(
         static_cast<uint32_t>(log::pwpb::LogEntries::Fields::kEntries),
         drop_message));
+    const uint32_t reported_drop_count = drop_count;
     drop_count = 0;
+    return reported_drop_count;
   }
+  return 0;
 }
 
 }  // namespace
@@ -96,12 +106,42 @@ std::optional<chrono::SystemClock::duration> RpcLogDrain::Trickle(
   // Called before drain is ready to send more logs. Ignore this request and
   // remind the caller how much longer they'll need to wait.
   if (no_writes_until_ > now) {
-    return no_writes_until_ - now;
+    const size_t unread_bytes = UnreadSizeBytes();
+    // Don't hold back a full packet for the trickle delay, unless the writer
+    // is backing off.
+    const bool send_full_packet = flush_full_packets_ &&
+                                  writer_backoff_.count() == 0 &&
+                                  unread_bytes >= encoding_buffer.size();
+    if (!send_full_packet) {
+      if (unread_bytes != 0 && !pending_since_.has_value()) {
+        pending_since_ = now;
+      }
+      return no_writes_until_ - now;
+    }
   }
 
   Status encoding_status;
-  if (SendLogs(max_bundles_per_trickle_, encoding_buffer, encoding_status) ==
-      LogDrainState::kCaughtUp) {
+  const LogDrainState state =
+      SendLogs(max_bundles_per_trickle_, encoding_buffer, encoding_status);
+  if (pending_since_.has_value()) {
+    const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        chrono::SystemClock::now() - pending_since_.value());
+    const uint32_t latency_ms = static_cast<uint32_t>(std::min<int64_t>(
+        latency.count(), std::numeric_limits<uint32_t>::max()));
+    if (latency_ms > max_latency_ms_.value()) {
+      max_latency_ms_.Set(latency_ms);
+    }
+    pending_since_.reset();
+  }
+
+  if (state == LogDrainState::kMoreEntriesRemaining &&
+      encoding_status.IsUnavailable()) {
+    // The writer failed and is backing off.
+    no_writes_until_ =
+        chrono::SystemClock::TimePointAfterAtLeast(writer_backoff_);
+    return writer_backoff_;
+  }
+  if (state == LogDrainState::kCaughtUp) {
     return std::nullopt;
   }
 
@@ -139,14 +179,31 @@ RpcLogDrain::LogDrainState RpcLogDrain::SendLogs(size_t max_num_bundles,
     const Status status = server_writer_.Write(encoder);
     sent_bundle_count++;
 
-    if (!status.ok() &&
-        error_handling_ == LogDrainErrorHandling::kCloseStreamOnWriterError) {
+    if (status.ok()) {
+      bundles_sent_.Increment();
+      entries_sent_.Increment(packed_entry_count);
+      writer_backoff_ = chrono::SystemClock::duration::zero();
+      continue;
+    }
+
+    writer_errors_.Increment();
+    if (error_handling_ == LogDrainErrorHandling::kCloseStreamOnWriterError) {
       // Only update this drop count when writer errors are not ignored.
       drop_count_writer_error_ += packed_entry_count;
       server_writer_.Finish().IgnoreError();
       encoding_status_out = Status::Aborted();
       return log_sink_state;
     }
+    if (max_writer_backoff_.count() > 0) {
+      // Give the writer time to recover before sending more logs.
+      writer_backoff_ =
+          std::min(max_writer_backoff_,
+                   std::max({writer_backoff_ * 2,
+                             trickle_delay_,
+                             kMinWriterBackoff}));
+      encoding_status_out = Status::Unavailable();
+      return LogDrainState::kMoreEntriesRemaining;
+    }
   }
   return log_sink_state;
 }
@@ -210,38 +267,43 @@ RpcLogDrain::LogDrainState RpcLogDrain::EncodeOutgoingPacket(
     drop_count_slow_drain_ -= drop_count_small_stack_buffer_;
     bool log_entry_buffer_has_valid_entry = possible_entry.ok();
     if (drop_count_slow_drain_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSlowDrainErrorMessage),
-                           drop_count_slow_drain_,
-                           encoder);
+      entries_dropped_.Increment(
+          TryEncodeDropMessage(log_entry_buffer_,
+                               std::string_view(kSlowDrainErrorMessage),
+                               drop_count_slow_drain_,
+                               encoder));
       log_entry_buffer_has_valid_entry = false;
     }
     if (drop_count_ingress_error_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kIngressErrorMessage),
-                           drop_count_ingress_error_,
-                           encoder);
+      entries_dropped_.Increment(
+          TryEncodeDropMessage(log_entry_buffer_,
+                               std::string_view(kIngressErrorMessage),
+                               drop_count_ingress_error_,
+                               encoder));
       log_entry_buffer_has_valid_entry = false;
     }
     if (drop_count_small_stack_buffer_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSmallStackBufferErrorMessage),
-                           drop_count_small_stack_buffer_,
-                           encoder);
+      entries_dropped_.Increment(
+          TryEncodeDropMessage(log_entry_buffer_,
+                               std::string_view(kSmallStackBufferErrorMessage),
+                               drop_count_small_stack_buffer_,
+                               encoder));
       log_entry_buffer_has_valid_entry = false;
     }
     if (drop_count_small_outbound_buffer_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSmallOutboundBufferErrorMessage),
-                           drop_count_small_outbound_buffer_,
-                           encoder);
+      entries_dropped_.Increment(TryEncodeDropMessage(
+          log_entry_buffer_,
+          std::string_view(kSmallOutboundBufferErrorMessage),
+          drop_count_small_outbound_buffer_,
+          encoder));
       log_entry_buffer_has_valid_entry = false;
     }
     if (drop_count_writer_error_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kWriterErrorMessage),
-                           drop_count_writer_error_,
-                           encoder);
+      entries_dropped_.Increment(
+          TryEncodeDropMessage(log_entry_buffer_,
+                               std::string_view(kWriterErrorMessage),
+                               drop_count_writer_error_,
+                               encoder));
       log_entry_buffer_has_valid_entry = false;
     }
     if (possible_entry.ok() && !log_entry_buffer_has_valid_entry) {
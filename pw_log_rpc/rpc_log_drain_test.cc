@@ -15,6 +15,7 @@
 #include "pw_log_rpc/rpc_log_drain.h"
 
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <string_view>
 
@@ -412,6 +413,52 @@ TEST_F(TrickleTest, LimitedFlushOverflowsToNextPayload) {
   EXPECT_EQ(entries_count, 3u);
 }
 
+TEST_F(TrickleTest, FullPacketSkipsTrickleDelay) {
+  AttachDrain();
+  OpenWriter();
+
+  Vector<TestLogEntry, 3> kLongLogs{BasicLog("Use longer logs in this test"),
+                                    BasicLog("My feet are cold"),
+                                    BasicLog("I'm hungry, what's for dinner?")};
+  // Queue enough logs for three payloads.
+  AddLogEntries(kLongLogs);
+  AddLogEntries(kLongLogs);
+  AddLogEntries(kLongLogs);
+
+  ASSERT_TRUE(writer_.active());
+  EXPECT_EQ(drains_[0].Open(writer_), OkStatus());
+  const chrono::SystemClock::duration kTrickleDelay =
+      chrono::SystemClock::for_at_least(std::chrono::seconds(10));
+  drains_[0].set_max_bundles_per_trickle(1);
+  drains_[0].set_trickle_delay(kTrickleDelay);
+  drains_[0].set_flush_full_packets(true);
+
+  std::optional<chrono::SystemClock::duration> min_delay =
+      drains_[0].Trickle(channel_encode_buffer_);
+  ASSERT_TRUE(min_delay.has_value());
+  EXPECT_EQ(min_delay.value(), kTrickleDelay);
+  EXPECT_EQ(
+      output_.payloads<log::pw_rpc::raw::Logs::Listen>(kDrainChannelId).size(),
+      1u);
+
+  // More than a full packet is pending, so it is sent without waiting for the
+  // trickle delay.
+  min_delay = drains_[0].Trickle(channel_encode_buffer_);
+  ASSERT_TRUE(min_delay.has_value());
+  EXPECT_EQ(
+      output_.payloads<log::pw_rpc::raw::Logs::Listen>(kDrainChannelId).size(),
+      2u);
+
+  // Without adaptive flushing, the drain waits for the trickle delay.
+  drains_[0].set_flush_full_packets(false);
+  min_delay = drains_[0].Trickle(channel_encode_buffer_);
+  ASSERT_TRUE(min_delay.has_value());
+  EXPECT_GT(min_delay.value(), chrono::SystemClock::duration::zero());
+  EXPECT_EQ(
+      output_.payloads<log::pw_rpc::raw::Logs::Listen>(kDrainChannelId).size(),
+      2u);
+}
+
 TEST(RpcLogDrain, OnOpenCallbackCalled) {
   // Create drain and log components.
   const uint32_t drain_id = 1;
@@ -0,0 +1,186 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_metric/histogram.h"
+
+#include "pw_assert/check.h"
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::metric::internal {
+namespace {
+
+#define PW_METRIC_BUCKET_TOKEN(name) \
+  PW_TOKENIZE_STRING_MASK_EXPR("metrics", _PW_METRIC_TOKEN_MASK, name)
+
+// Returns the name of a bucket that counts values less than 2^index.
+Token GetUpperBoundToken(size_t index) {
+  switch (index) {
+    case 0:
+      return PW_METRIC_BUCKET_TOKEN("eq_0");
+    case 1:
+      return PW_METRIC_BUCKET_TOKEN("lt_2");
+    case 2:
+      return PW_METRIC_BUCKET_TOKEN("lt_4");
+    case 3:
+      return PW_METRIC_BUCKET_TOKEN("lt_8");
+    case 4:
+      return PW_METRIC_BUCKET_TOKEN("lt_16");
+    case 5:
+      return PW_METRIC_BUCKET_TOKEN("lt_32");
+    case 6:
+      return PW_METRIC_BUCKET_TOKEN("lt_64");
+    case 7:
+      return PW_METRIC_BUCKET_TOKEN("lt_128");
+    case 8:
+      return PW_METRIC_BUCKET_TOKEN("lt_256");
+    case 9:
+      return PW_METRIC_BUCKET_TOKEN("lt_512");
+    case 10:
+      return PW_METRIC_BUCKET_TOKEN("lt_1024");
+    case 11:
+      return PW_METRIC_BUCKET_TOKEN("lt_2048");
+    case 12:
+      return PW_METRIC_BUCKET_TOKEN("lt_4096");
+    case 13:
+      return PW_METRIC_BUCKET_TOKEN("lt_8192");
+    case 14:
+      return PW_METRIC_BUCKET_TOKEN("lt_16384");
+    case 15:
+      return PW_METRIC_BUCKET_TOKEN("lt_32768");
+    case 16:
+      return PW_METRIC_BUCKET_TOKEN("lt_65536");
+    case 17:
+      return PW_METRIC_BUCKET_TOKEN("lt_131072");
+    case 18:
+      return PW_METRIC_BUCKET_TOKEN("lt_262144");
+    case 19:
+      return PW_METRIC_BUCKET_TOKEN("lt_524288");
+    case 20:
+      return PW_METRIC_BUCKET_TOKEN("lt_1048576");
+    case 21:
+      return PW_METRIC_BUCKET_TOKEN("lt_2097152");
+    case 22:
+      return PW_METRIC_BUCKET_TOKEN("lt_4194304");
+    case 23:
+      return PW_METRIC_BUCKET_TOKEN("lt_8388608");
+    case 24:
+      return PW_METRIC_BUCKET_TOKEN("lt_16777216");
+    case 25:
+      return PW_METRIC_BUCKET_TOKEN("lt_33554432");
+    case 26:
+      return PW_METRIC_BUCKET_TOKEN("lt_67108864");
+    case 27:
+      return PW_METRIC_BUCKET_TOKEN("lt_134217728");
+    case 28:
+      return PW_METRIC_BUCKET_TOKEN("lt_268435456");
+    case 29:
+      return PW_METRIC_BUCKET_TOKEN("lt_536870912");
+    case 30:
+      return PW_METRIC_BUCKET_TOKEN("lt_1073741824");
+    case 31:
+      return PW_METRIC_BUCKET_TOKEN("lt_2147483648");
+    case 32:
+      return PW_METRIC_BUCKET_TOKEN("lt_4294967296");
+    default:
+      PW_CRASH("Invalid histogram bucket %u", static_cast<unsigned>(index));
+  }
+}
+
+// Returns the name of a last bucket that counts values of at least
+// 2^(index - 1).
+Token GetLowerBoundToken(size_t index) {
+  switch (index) {
+    case 1:
+      return PW_METRIC_BUCKET_TOKEN("ge_1");
+    case 2:
+      return PW_METRIC_BUCKET_TOKEN("ge_2");
+    case 3:
+      return PW_METRIC_BUCKET_TOKEN("ge_4");
+    case 4:
+      return PW_METRIC_BUCKET_TOKEN("ge_8");
+    case 5:
+      return PW_METRIC_BUCKET_TOKEN("ge_16");
+    case 6:
+      return PW_METRIC_BUCKET_TOKEN("ge_32");
+    case 7:
+      return PW_METRIC_BUCKET_TOKEN("ge_64");
+    case 8:
+      return PW_METRIC_BUCKET_TOKEN("ge_128");
+    case 9:
+      return PW_METRIC_BUCKET_TOKEN("ge_256");
+    case 10:
+      return PW_METRIC_BUCKET_TOKEN("ge_512");
+    case 11:
+      return PW_METRIC_BUCKET_TOKEN("ge_1024");
+    case 12:
+      return PW_METRIC_BUCKET_TOKEN("ge_2048");
+    case 13:
+      return PW_METRIC_BUCKET_TOKEN("ge_4096");
+    case 14:
+      return PW_METRIC_BUCKET_TOKEN("ge_8192");
+    case 15:
+      return PW_METRIC_BUCKET_TOKEN("ge_16384");
+    case 16:
+      return PW_METRIC_BUCKET_TOKEN("ge_32768");
+    case 17:
+      return PW_METRIC_BUCKET_TOKEN("ge_65536");
+    case 18:
+      return PW_METRIC_BUCKET_TOKEN("ge_131072");
+    case 19:
+      return PW_METRIC_BUCKET_TOKEN("ge_262144");
+    case 20:
+      return PW_METRIC_BUCKET_TOKEN("ge_524288");
+    case 21:
+      return PW_METRIC_BUCKET_TOKEN("ge_1048576");
+    case 22:
+      return PW_METRIC_BUCKET_TOKEN("ge_2097152");
+    case 23:
+      return PW_METRIC_BUCKET_TOKEN("ge_4194304");
+    case 24:
+      return PW_METRIC_BUCKET_TOKEN("ge_8388608");
+    case 25:
+      return PW_METRIC_BUCKET_TOKEN("ge_16777216");
+    case 26:
+      return PW_METRIC_BUCKET_TOKEN("ge_33554432");
+    case 27:
+      return PW_METRIC_BUCKET_TOKEN("ge_67108864");
+    case 28:
+      return PW_METRIC_BUCKET_TOKEN("ge_134217728");
+    case 29:
+      return PW_METRIC_BUCKET_TOKEN("ge_268435456");
+    case 30:
+      return PW_METRIC_BUCKET_TOKEN("ge_536870912");
+    case 31:
+      return PW_METRIC_BUCKET_TOKEN("ge_1073741824");
+    case 32:
+      return PW_METRIC_BUCKET_TOKEN("ge_2147483648");
+    default:
+      PW_CRASH("Invalid histogram bucket %u", static_cast<unsigned>(index));
+  }
+}
+
+#undef PW_METRIC_BUCKET_TOKEN
+
+}  // namespace
+
+Token GetLog2BucketToken(size_t index, size_t num_buckets) {
+  PW_CHECK_UINT_LT(index, num_buckets);
+  if (index == num_buckets - 1) {
+    return GetLowerBoundToken(index);
+  }
+  return GetUpperBoundToken(index);
+}
+
+}  // namespace pw::metric::internal
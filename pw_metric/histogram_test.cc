@@ -0,0 +1,114 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_metric/histogram.h"
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::metric {
+namespace {
+
+TEST(Log2Histogram, BucketFor) {
+  using Histogram = Log2Histogram<16>;
+  EXPECT_EQ(Histogram::BucketFor(0), 0u);
+  EXPECT_EQ(Histogram::BucketFor(1), 1u);
+  EXPECT_EQ(Histogram::BucketFor(2), 2u);
+  EXPECT_EQ(Histogram::BucketFor(3), 2u);
+  EXPECT_EQ(Histogram::BucketFor(4), 3u);
+  EXPECT_EQ(Histogram::BucketFor(16383), 14u);
+  EXPECT_EQ(Histogram::BucketFor(16384), 15u);
+  EXPECT_EQ(Histogram::BucketFor(0xffffffffu), 15u);
+}
+
+TEST(Log2Histogram, BucketForFullRange) {
+  using Histogram = Log2Histogram<33>;
+  EXPECT_EQ(Histogram::BucketFor(0x7fffffffu), 31u);
+  EXPECT_EQ(Histogram::BucketFor(0x80000000u), 32u);
+  EXPECT_EQ(Histogram::BucketFor(0xffffffffu), 32u);
+}
+
+TEST(Log2Histogram, RecordAndClear) {
+  Log2Histogram<8> histogram(0x1234);
+  histogram.Record(0);
+  histogram.Record(5);
+  histogram.Record(7);
+  histogram.Record(100000);
+  EXPECT_EQ(histogram.count(0), 1u);
+  EXPECT_EQ(histogram.count(3), 2u);
+  EXPECT_EQ(histogram.count(7), 1u);
+
+  histogram.Clear();
+  for (size_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(histogram.count(i), 0u);
+  }
+}
+
+TEST(Log2Histogram, BucketsAreMetricsInOrder) {
+  constexpr Token kEq0 =
+      PW_TOKENIZE_STRING_MASK("metrics", _PW_METRIC_TOKEN_MASK, "eq_0");
+  constexpr Token kLt2 =
+      PW_TOKENIZE_STRING_MASK("metrics", _PW_METRIC_TOKEN_MASK, "lt_2");
+  constexpr Token kLt4 =
+      PW_TOKENIZE_STRING_MASK("metrics", _PW_METRIC_TOKEN_MASK, "lt_4");
+  constexpr Token kGe4 =
+      PW_TOKENIZE_STRING_MASK("metrics", _PW_METRIC_TOKEN_MASK, "ge_4");
+
+  Log2Histogram<4> histogram(0x1234);
+  histogram.Record(2);
+  EXPECT_EQ(histogram.group().name(), 0x1234u);
+  ASSERT_EQ(histogram.group().metrics().size(), 4u);
+
+  auto it = histogram.group().metrics().begin();
+  EXPECT_EQ(it->name(), kEq0);
+  ++it;
+  EXPECT_EQ(it->name(), kLt2);
+  ++it;
+  EXPECT_EQ(it->name(), kLt4);
+  EXPECT_EQ(it->as_int(), 1u);
+  ++it;
+  EXPECT_EQ(it->name(), kGe4);
+}
+
+class HistogramOwner {
+ public:
+  void Record(uint32_t value) { sizes_.Record(value); }
+  Group& metrics() { return metrics_; }
+
+ private:
+  PW_METRIC_GROUP(metrics_, "owner");
+  PW_METRIC_LOG2_HISTOGRAM(metrics_, sizes_, "sizes", 12);
+};
+
+TEST(Log2Histogram, MacroAddsHistogramToParent) {
+  HistogramOwner owner;
+  owner.Record(1000);
+
+  ASSERT_EQ(owner.metrics().children().size(), 1u);
+  const Group& histogram = owner.metrics().children().front();
+  EXPECT_EQ(histogram.name(),
+            PW_TOKENIZE_STRING_DOMAIN_EXPR("metrics", "sizes"));
+  EXPECT_EQ(histogram.metrics().size(), 12u);
+}
+
+TEST(Log2Histogram, MacroWithoutParent) {
+  PW_METRIC_LOG2_HISTOGRAM(histogram, "histogram", 2);
+  histogram.Record(0);
+  histogram.Record(1);
+  histogram.Record(2);
+  EXPECT_EQ(histogram.count(0), 1u);
+  EXPECT_EQ(histogram.count(1), 2u);
+}
+
+}  // namespace
+}  // namespace pw::metric
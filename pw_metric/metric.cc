@@ -68,26 +68,62 @@ float Metric::as_float() const {
 
 uint32_t Metric::as_int() const {
   PW_DCHECK(is_int());
-  return uint_;
+  return __atomic_load_n(&uint_, __ATOMIC_RELAXED);
 }
 
 void Metric::Increment(uint32_t amount) {
   PW_DCHECK(is_int());
-  if (PW_ADD_OVERFLOW(uint_, amount, &uint_)) {
-    uint_ = std::numeric_limits<uint32_t>::max();
+  uint32_t value = __atomic_load_n(&uint_, __ATOMIC_RELAXED);
+  if (PW_ADD_OVERFLOW(value, amount, &value)) {
+    value = std::numeric_limits<uint32_t>::max();
   }
+  __atomic_store_n(&uint_, value, __ATOMIC_RELAXED);
 }
 
 void Metric::Decrement(uint32_t amount) {
   PW_DCHECK(is_int());
-  if (PW_SUB_OVERFLOW(uint_, amount, &uint_)) {
-    uint_ = 0;
+  uint32_t value = __atomic_load_n(&uint_, __ATOMIC_RELAXED);
+  if (PW_SUB_OVERFLOW(value, amount, &value)) {
+    value = 0;
   }
+  __atomic_store_n(&uint_, value, __ATOMIC_RELAXED);
+}
+
+void Metric::IncrementAtomic(uint32_t amount) {
+  PW_DCHECK(is_int());
+  uint32_t expected = __atomic_load_n(&uint_, __ATOMIC_RELAXED);
+  uint32_t desired;
+  do {
+    if (PW_ADD_OVERFLOW(expected, amount, &desired)) {
+      desired = std::numeric_limits<uint32_t>::max();
+    }
+  } while (!__atomic_compare_exchange_n(&uint_,
+                                        &expected,
+                                        desired,
+                                        /*weak=*/true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED));
+}
+
+void Metric::DecrementAtomic(uint32_t amount) {
+  PW_DCHECK(is_int());
+  uint32_t expected = __atomic_load_n(&uint_, __ATOMIC_RELAXED);
+  uint32_t desired;
+  do {
+    if (PW_SUB_OVERFLOW(expected, amount, &desired)) {
+      desired = 0;
+    }
+  } while (!__atomic_compare_exchange_n(&uint_,
+                                        &expected,
+                                        desired,
+                                        /*weak=*/true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED));
 }
 
 void Metric::SetInt(uint32_t value) {
   PW_DCHECK(is_int());
-  uint_ = value;
+  __atomic_store_n(&uint_, value, __ATOMIC_RELAXED);
 }
 
 void Metric::SetFloat(float value) {
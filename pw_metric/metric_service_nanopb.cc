@@ -19,6 +19,7 @@
 #include "pw_assert/check.h"
 #include "pw_containers/vector.h"
 #include "pw_metric/metric.h"
+#include "pw_metric/sharded_counter.h"
 #include "pw_metric_private/metric_walker.h"
 #include "pw_preprocessor/util.h"
 #include "pw_span/span.h"
@@ -104,9 +105,18 @@ void MetricService::Get(
   //
   // In the future, this should be replaced with an optional async solution
   // that puts the application in control of when the response batches are sent.
+
+  // Sum the shards of sharded counters into their metrics.
+  PublishShardedCounters();
   walker.Walk(metrics_).IgnoreError();
   walker.Walk(groups_).IgnoreError();
   writer.Flush();
 }
 
+void MetricService::Stream(
+    const pw_metric_proto_MetricStreamRequest& /* request */,
+    ServerWriter<pw_metric_proto_MetricResponse>& response) {
+  response.Finish(Status::Unimplemented()).IgnoreError();
+}
+
 }  // namespace pw::metric
@@ -15,13 +15,16 @@
 #include "pw_metric/metric_service_pwpb.h"
 
 #include <cstring>
+#include <mutex>
 
 #include "pw_assert/check.h"
 #include "pw_containers/vector.h"
 #include "pw_metric/metric.h"
+#include "pw_metric/sharded_counter.h"
 #include "pw_metric_private/metric_walker.h"
 #include "pw_metric_proto/metric_service.pwpb.h"
 #include "pw_preprocessor/util.h"
+#include "pw_protobuf/decoder.h"
 #include "pw_rpc/raw/server_reader_writer.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
@@ -32,20 +35,31 @@ namespace pw::metric {
 // TODO(amontanez): Make this follow the metric_service.options configuration.
 constexpr size_t kMaxNumPackedEntries = 3;
 
+constexpr size_t kSizeOfOneMetric =
+    pw::metric::proto::pwpb::MetricResponse::kMaxEncodedSizeBytes +
+    pw::metric::proto::pwpb::Metric::kMaxEncodedSizeBytes;
+constexpr size_t kEncodeBufferSize = kMaxNumPackedEntries * kSizeOfOneMetric;
+
 namespace {
 
 class PwpbMetricWriter : public virtual internal::MetricWriter {
  public:
   PwpbMetricWriter(span<std::byte> response,
-                   rpc::RawServerWriter& response_writer)
+                   rpc::RawServerWriter& response_writer,
+                   bool full_snapshot = false)
       : response_(response),
         response_writer_(response_writer),
-        encoder_(response) {}
+        encoder_(response),
+        full_snapshot_(full_snapshot) {}
 
   // TODO(keir): Figure out a pw_rpc mechanism to fill a streaming packet based
   // on transport MTU, rather than having this as a static knob. For example,
   // some transports may be able to fit 30 metrics; others, only 5.
   Status Write(const Metric& metric, const Vector<Token>& path) override {
+    if (full_snapshot_ && metrics_count == 0) {
+      PW_TRY(encoder_.WriteFullSnapshot(true));
+    }
+
     {  // Scope to control proto_encoder lifetime.
 
       // Grab the next available Metric slot to write to in the response.
@@ -75,7 +89,7 @@ class PwpbMetricWriter : public virtual internal::MetricWriter {
       // Different way to clear MemoryEncoder. Copy constructor is disabled
       // for memory encoder, and there is no "clear()" method.
       encoder_.~MemoryEncoder();
-      new (&encoder_) proto::pwpb::MetricRequest::MemoryEncoder(response_);
+      new (&encoder_) proto::pwpb::MetricResponse::MemoryEncoder(response_);
       metrics_count = 0;
     }
     return status;
@@ -86,20 +100,56 @@ class PwpbMetricWriter : public virtual internal::MetricWriter {
   // This RPC stream writer handle must be valid for the metric writer
   // lifetime.
   rpc::RawServerWriter& response_writer_;
-  proto::pwpb::MetricRequest::MemoryEncoder encoder_;
+  proto::pwpb::MetricResponse::MemoryEncoder encoder_;
   size_t metrics_count = 0;
+  const bool full_snapshot_;
 };
+
+// Passes metrics to another writer only if they changed since they were last
+// reported, or if the report is a full snapshot, and records the reported
+// values.
+class ChangedMetricWriter : public virtual internal::MetricWriter {
+ public:
+  ChangedMetricWriter(internal::MetricWriter& writer,
+                      span<MetricService::ReportedMetric> reported,
+                      bool full_snapshot)
+      : writer_(writer), reported_(reported), full_snapshot_(full_snapshot) {}
+
+  Status Write(const Metric& metric, const Vector<Token>& path) override {
+    if (index_ < reported_.size()) {
+      MetricService::ReportedMetric& last = reported_[index_++];
+      const uint32_t value = RawValue(metric);
+      const bool changed = last.metric != &metric || last.value != value;
+      last = {&metric, value};
+      if (!changed && !full_snapshot_) {
+        return OkStatus();
+      }
+    }
+    return writer_.Write(metric, path);
+  }
+
+ private:
+  static uint32_t RawValue(const Metric& metric) {
+    if (!metric.is_float()) {
+      return metric.as_int();
+    }
+    const float value = metric.as_float();
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  internal::MetricWriter& writer_;
+  span<MetricService::ReportedMetric> reported_;
+  const bool full_snapshot_;
+  size_t index_ = 0;
+};
+
 }  // namespace
 
 void MetricService::Get(ConstByteSpan /*request*/,
                         rpc::RawServerWriter& raw_response) {
   // For now, ignore the request and just stream all the metrics back.
-  // TODO(amontanez): Make this follow the metric_service.options configuration.
-  constexpr size_t kSizeOfOneMetric =
-      pw::metric::proto::pwpb::MetricResponse::kMaxEncodedSizeBytes +
-      pw::metric::proto::pwpb::Metric::kMaxEncodedSizeBytes;
-  constexpr size_t kEncodeBufferSize = kMaxNumPackedEntries * kSizeOfOneMetric;
-
   std::array<std::byte, kEncodeBufferSize> encode_buffer;
 
   PwpbMetricWriter writer(encode_buffer, raw_response);
@@ -113,6 +163,9 @@ void MetricService::Get(ConstByteSpan /*request*/,
   // In the future, this should be replaced with an optional async solution
   // that puts the application in control of when the response batches are sent.
 
+  // Sum the shards of sharded counters into their metrics.
+  PublishShardedCounters();
+
   // Propagate status through walker.
   Status status;
   status.Update(walker.Walk(metrics_));
@@ -120,4 +173,52 @@ void MetricService::Get(ConstByteSpan /*request*/,
   status.Update(writer.Flush());
   raw_response.Finish(status).IgnoreError();
 }
+
+void MetricService::Stream(ConstByteSpan request,
+                           rpc::RawServerWriter& response) {
+  uint32_t full_snapshot_interval = 0;
+  protobuf::Decoder decoder(request);
+  while (decoder.Next().ok()) {
+    if (decoder.FieldNumber() ==
+        static_cast<uint32_t>(proto::pwpb::MetricStreamRequest::Fields::
+                                  kFullSnapshotInterval)) {
+      decoder.ReadUint32(&full_snapshot_interval).IgnoreError();
+    }
+  }
+
+  std::lock_guard lock(stream_mutex_);
+  // Replacing the writer closes any previously open stream.
+  stream_ = std::move(response);
+  full_snapshot_interval_ = full_snapshot_interval;
+  report_count_ = 0;
+}
+
+Status MetricService::Report() {
+  std::lock_guard lock(stream_mutex_);
+  if (!stream_.active()) {
+    return Status::FailedPrecondition();
+  }
+
+  const bool full_snapshot =
+      report_count_ == 0 || (full_snapshot_interval_ != 0 &&
+                             report_count_ % full_snapshot_interval_ == 0);
+  report_count_ += 1;
+
+  PublishShardedCounters();
+
+  std::array<std::byte, kEncodeBufferSize> encode_buffer;
+  PwpbMetricWriter writer(encode_buffer, stream_, full_snapshot);
+  ChangedMetricWriter changed_writer(writer, reported_, full_snapshot);
+  internal::MetricWalker walker(changed_writer);
+
+  Status status;
+  status.Update(walker.Walk(metrics_));
+  status.Update(walker.Walk(groups_));
+  status.Update(writer.Flush());
+  if (!status.ok()) {
+    // The client may have missed changes, so resend everything next time.
+    report_count_ = 0;
+  }
+  return status;
+}
 }  // namespace pw::metric
@@ -14,7 +14,10 @@
 
 #include "pw_metric/metric_service_pwpb.h"
 
+#include <array>
+
 #include "pw_log/log.h"
+#include "pw_metric/sharded_counter.h"
 #include "pw_metric_proto/metric_service.pwpb.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_rpc/pwpb/test_method_context.h"
@@ -74,6 +77,19 @@ size_t GetMetricsSum(ConstByteSpan serialized_metric_buffer) {
   return metrics_sum;
 }
 
+bool IsFullSnapshot(ConstByteSpan serialized_metric_buffer) {
+  protobuf::Decoder decoder(serialized_metric_buffer);
+  bool full_snapshot = false;
+  while (decoder.Next().ok()) {
+    if (decoder.FieldNumber() ==
+        static_cast<uint32_t>(
+            pw::metric::proto::pwpb::MetricResponse::Fields::kFullSnapshot)) {
+      EXPECT_EQ(OkStatus(), decoder.ReadBool(&full_snapshot));
+    }
+  }
+  return full_snapshot;
+}
+
 TEST(MetricService, EmptyGroupAndNoMetrics) {
   // Empty root group.
   PW_METRIC_GROUP(root, "/");
@@ -110,6 +126,23 @@ TEST(MetricService, OneGroupOneMetric) {
   EXPECT_EQ(3u, GetMetricsSum(ctx.responses()[0]));
 }
 
+TEST(MetricService, ShardedCounterIsSummed) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC_SHARDED_COUNTER(root, counter, "counter", 4);
+  counter.Increment(0, 2);
+  counter.Increment(3, 5);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Get)
+  ctx{root.metrics(), root.children()};
+  ctx.call({});
+  EXPECT_TRUE(ctx.done());
+  EXPECT_EQ(OkStatus(), ctx.status());
+
+  // The shards are exported as one metric with their sum.
+  EXPECT_EQ(1u, ctx.responses().size());
+  EXPECT_EQ(7u, GetMetricsSum(ctx.responses()[0]));
+}
+
 TEST(MetricService, OneGroupFiveMetrics) {
   // One root group with five metrics.
   PW_METRIC_GROUP(root, "/");
@@ -214,5 +247,87 @@ TEST(MetricService, NestedGroupsWithBatches) {
                 GetMetricsSum(ctx.responses()[3]));
 }
 
+TEST(MetricService, ReportWithoutStream) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Stream)
+  ctx{root.metrics(), root.children()};
+  EXPECT_EQ(Status::FailedPrecondition(), ctx.service().Report());
+}
+
+TEST(MetricService, StreamReportsOnlyChangedMetrics) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+  PW_METRIC(root, c, "c", 3u);
+  std::array<MetricService::ReportedMetric, 3> reported;
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Stream)
+  ctx{root.metrics(), root.children(), reported};
+  ctx.call({});
+
+  // The first report is a full snapshot.
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+  ASSERT_EQ(1u, ctx.responses().size());
+  EXPECT_EQ(3u, CountEncodedMetrics(ctx.responses()[0]));
+  EXPECT_TRUE(IsFullSnapshot(ctx.responses()[0]));
+
+  // Nothing changed, so nothing is sent.
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+  EXPECT_EQ(1u, ctx.responses().size());
+
+  b.Increment(5);
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+  ASSERT_EQ(2u, ctx.responses().size());
+  EXPECT_EQ(1u, CountEncodedMetrics(ctx.responses()[1]));
+  EXPECT_EQ(7u, GetMetricsSum(ctx.responses()[1]));
+  EXPECT_FALSE(IsFullSnapshot(ctx.responses()[1]));
+  EXPECT_FALSE(ctx.done());
+}
+
+TEST(MetricService, StreamSendsPeriodicFullSnapshots) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+  std::array<MetricService::ReportedMetric, 2> reported;
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Stream)
+  ctx{root.metrics(), root.children(), reported};
+  // full_snapshot_interval: 2
+  constexpr std::array<std::byte, 2> kRequest = {std::byte{0x08},
+                                                 std::byte{0x02}};
+  ctx.call(kRequest);
+
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+
+  // Reports 0 and 2 are full snapshots; report 1 had no changes.
+  ASSERT_EQ(2u, ctx.responses().size());
+  EXPECT_TRUE(IsFullSnapshot(ctx.responses()[0]));
+  EXPECT_TRUE(IsFullSnapshot(ctx.responses()[1]));
+  EXPECT_EQ(3u, GetMetricsSum(ctx.responses()[1]));
+}
+
+TEST(MetricService, StreamReportsUntrackedMetricsEveryTime) {
+  PW_METRIC_GROUP(root, "/");
+  PW_METRIC(root, a, "a", 1u);
+  PW_METRIC(root, b, "b", 2u);
+  std::array<MetricService::ReportedMetric, 1> reported;
+
+  PW_RAW_TEST_METHOD_CONTEXT(MetricService, Stream)
+  ctx{root.metrics(), root.children(), reported};
+  ctx.call({});
+
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+  ASSERT_EQ(OkStatus(), ctx.service().Report());
+
+  // Only one metric is tracked, so the other is sent in every report.
+  ASSERT_EQ(2u, ctx.responses().size());
+  EXPECT_EQ(2u, CountEncodedMetrics(ctx.responses()[0]));
+  EXPECT_EQ(1u, CountEncodedMetrics(ctx.responses()[1]));
+}
+
 }  // namespace
 }  // namespace pw::metric
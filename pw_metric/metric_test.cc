@@ -14,6 +14,8 @@
 
 #include "pw_metric/metric.h"
 
+#include <limits>
+
 #include "pw_log/log.h"
 #include "pw_unit_test/framework.h"
 
@@ -55,6 +57,26 @@ TEST(Metric, IntFromObject) {
   EXPECT_EQ(m.value(), 426u);
 }
 
+TEST(Metric, AtomicIncrementSaturates) {
+  TypedMetric<uint32_t> m(0x1234, 0u);
+  m.IncrementAtomic();
+  m.IncrementAtomic(4);
+  EXPECT_EQ(m.value(), 5u);
+
+  m.IncrementAtomic(std::numeric_limits<uint32_t>::max());
+  EXPECT_EQ(m.value(), std::numeric_limits<uint32_t>::max());
+}
+
+TEST(Metric, AtomicDecrementSaturates) {
+  TypedMetric<uint32_t> m(0x1234, 5u);
+  m.DecrementAtomic();
+  m.DecrementAtomic(2);
+  EXPECT_EQ(m.value(), 2u);
+
+  m.DecrementAtomic(3);
+  EXPECT_EQ(m.value(), 0u);
+}
+
 TEST(m, IntFromMacroLocal) {
   PW_METRIC(m, "some_metric", 14u);
   EXPECT_TRUE(m.is_int());
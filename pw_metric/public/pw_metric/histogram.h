@@ -0,0 +1,155 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_assert/assert.h"
+#include "pw_metric/metric.h"
+
+namespace pw::metric {
+namespace internal {
+
+// Returns the token for the name of a Log2Histogram bucket. Buckets are named
+// by their bounds, so the name of the last bucket depends on the number of
+// buckets.
+Token GetLog2BucketToken(size_t index, size_t num_buckets);
+
+}  // namespace internal
+
+// Counts values using buckets whose bounds are powers of two. This gives a
+// coarse distribution over the whole uint32_t range for a few words of RAM,
+// and recording a value is a bit scan and an increment.
+//
+// The first bucket, named "eq_0", counts values of zero. Each following
+// bucket, named "lt_<2^i>", counts values less than 2^i and not counted by a
+// previous bucket. The last bucket, named "ge_<2^(kNumBuckets-2)>", counts all
+// remaining values. A histogram with 33 buckets has an exact bucket for every
+// bit width of a uint32_t.
+//
+// The buckets are uint32_t metrics in the histogram's group, so histograms are
+// dumped and exported like any other metrics, e.g. by the MetricService.
+//
+// Like other metrics, histograms are not synchronized. Record() does no
+// locking, so concurrent callers must synchronize externally if exact counts
+// are required.
+//
+// Size: 16 bytes for the group plus 12 bytes per bucket.
+template <size_t kBuckets>
+class Log2Histogram {
+ public:
+  static_assert(kBuckets >= 2, "A histogram needs at least two buckets");
+  static_assert(kBuckets <= 33, "A uint32_t has at most 33 bit widths");
+
+  static constexpr size_t kNumBuckets = kBuckets;
+
+  // Constructs a histogram, optionally adding it to a parent group's children.
+  explicit Log2Histogram(Token name)
+      : Log2Histogram(name, std::make_index_sequence<kNumBuckets>()) {}
+  Log2Histogram(Token name, IntrusiveList<Group>& groups)
+      : Log2Histogram(name, std::make_index_sequence<kNumBuckets>()) {
+    groups.push_front(group_);
+  }
+
+  const Group& group() const { return group_; }
+  Group& group() { return group_; }
+
+  // Returns the index of the bucket that counts the given value.
+  static constexpr size_t BucketFor(uint32_t value) {
+    return std::min(static_cast<size_t>(cpp20::bit_width(value)),
+                    kNumBuckets - 1);
+  }
+
+  // Returns the number of values counted by the given bucket.
+  uint32_t count(size_t bucket) const {
+    PW_ASSERT(bucket < kNumBuckets);
+    return buckets_[bucket].value();
+  }
+
+  // Counts a value. Saturates at the max value of a bucket.
+  void Record(uint32_t value) { buckets_[BucketFor(value)].Increment(); }
+
+  // Sets all buckets to zero.
+  void Clear() {
+    for (auto& bucket : buckets_) {
+      bucket.Set(0);
+    }
+  }
+
+  // Disallow copy and assign.
+  Log2Histogram(const Log2Histogram&) = delete;
+  Log2Histogram& operator=(const Log2Histogram&) = delete;
+
+ private:
+  template <size_t... kIndices>
+  Log2Histogram(Token name, std::index_sequence<kIndices...>)
+      : group_(name),
+        buckets_{TypedMetric<uint32_t>(
+            internal::GetLog2BucketToken(kIndices, kNumBuckets), 0u)...} {
+    // Groups list metrics in the reverse order they are added.
+    for (size_t i = kNumBuckets; i != 0; --i) {
+      group_.Add(buckets_[i - 1]);
+    }
+  }
+
+  Group group_;
+  std::array<TypedMetric<uint32_t>, kNumBuckets> buckets_;
+};
+
+// Declare a Log2Histogram, optionally adding it to a parent group. Works like
+// PW_METRIC_GROUP, and works in the same contexts. Use:
+//
+//   PW_METRIC_LOG2_HISTOGRAM(variable_name, histogram_name, num_buckets)
+//   PW_METRIC_LOG2_HISTOGRAM(parent, variable_name, histogram_name,
+//                            num_buckets)
+//
+// Example:
+//
+//   class MyDriver {
+//    public:
+//     void OnTransfer(uint32_t bytes) { sizes_.Record(bytes); }
+//
+//    private:
+//     PW_METRIC_GROUP(metrics_, "my_driver");
+//     PW_METRIC_LOG2_HISTOGRAM(metrics_, sizes_, "transfer_sizes", 12);
+//   };
+//
+#define PW_METRIC_LOG2_HISTOGRAM(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_LOG2_HISTOGRAM_, , __VA_ARGS__)
+#define PW_METRIC_LOG2_HISTOGRAM_STATIC(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_LOG2_HISTOGRAM_, static, __VA_ARGS__)
+
+#define _PW_METRIC_LOG2_HISTOGRAM_4(                                  \
+    static_def, variable_name, histogram_name, num_buckets)           \
+  static constexpr uint32_t variable_name##_token =                   \
+      PW_TOKENIZE_STRING_DOMAIN("metrics", histogram_name);           \
+  static_def ::pw::metric::Log2Histogram<num_buckets> variable_name { \
+    variable_name##_token                                             \
+  }
+
+#define _PW_METRIC_LOG2_HISTOGRAM_5(                                  \
+    static_def, parent, variable_name, histogram_name, num_buckets)   \
+  static constexpr uint32_t variable_name##_token =                   \
+      PW_TOKENIZE_STRING_DOMAIN("metrics", histogram_name);           \
+  static_def ::pw::metric::Log2Histogram<num_buckets> variable_name { \
+    variable_name##_token, parent.children()                          \
+  }
+
+}  // namespace pw::metric
@@ -35,7 +35,12 @@ using tokenizer::Token;
 //
 // Size: 12 bytes / 96 bits - next, name, value.
 //
-// TODO(keir): Implement Set() and Increment() using atomics.
+// Integer metrics are read and set with relaxed atomic loads and stores, which
+// cost the same as plain loads and stores. Increment() and Decrement() are
+// plain read-modify-writes; IncrementAtomic() and DecrementAtomic() are
+// lock-free alternatives for metrics that are updated from multiple threads or
+// cores. See also ShardedCounter in pw_metric/sharded_counter.h.
+//
 // TODO(keir): Consider an alternative structure where metrics have pointers to
 // parent groups, which would enable (1) safe destruction and (2) safe static
 // initialization, but at the cost of an additional 4 bytes per metric and 4
@@ -84,6 +89,12 @@ class Metric : public IntrusiveList<Metric>::Item {
   // Saturating subtract. Results in 0 if the subtraction would overflow.
   void Decrement(uint32_t amount = 1);
 
+  // Atomic versions of Increment() and Decrement(), using relaxed memory
+  // ordering. These need atomic read-modify-write instructions, so on targets
+  // without them, such as ARMv6-M, they require libatomic.
+  void IncrementAtomic(uint32_t amount = 1);
+  void DecrementAtomic(uint32_t amount = 1);
+
   void SetInt(uint32_t value);
 
   void SetFloat(float value);
@@ -130,7 +141,8 @@ class TypedMetric<float> : public Metric {
   uint32_t as_int() const { return 0; }
 };
 
-// A metric for uint32_ts. Offers both Set() and Increment().
+// A metric for uint32_ts. Offers Set(), Increment(), and atomic variants of
+// Increment() for metrics shared between threads or cores.
 template <>
 class TypedMetric<uint32_t> : public Metric {
  public:
@@ -140,6 +152,12 @@ class TypedMetric<uint32_t> : public Metric {
 
   void Increment(uint32_t amount = 1u) { Metric::Increment(amount); }
   void Decrement(uint32_t amount = 1u) { Metric::Decrement(amount); }
+  void IncrementAtomic(uint32_t amount = 1u) {
+    Metric::IncrementAtomic(amount);
+  }
+  void DecrementAtomic(uint32_t amount = 1u) {
+    Metric::DecrementAtomic(amount);
+  }
   void Set(uint32_t value) { SetInt(value); }
   uint32_t value() const { return Metric::as_int(); }
 
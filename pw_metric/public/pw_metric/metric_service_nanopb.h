@@ -41,6 +41,11 @@ class MetricService final
   void Get(const pw_metric_proto_MetricRequest& request,
            ServerWriter<pw_metric_proto_MetricResponse>& response);
 
+  // Streaming changed metrics is only supported by the pwpb MetricService;
+  // this finishes the call with UNIMPLEMENTED.
+  void Stream(const pw_metric_proto_MetricStreamRequest& request,
+              ServerWriter<pw_metric_proto_MetricResponse>& response);
+
  private:
   const IntrusiveList<Metric>& metrics_;
   const IntrusiveList<Group>& groups_;
@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 
 #include "pw_bytes/span.h"
@@ -21,6 +22,9 @@
 #include "pw_metric_proto/metric_service.raw_rpc.pb.h"
 #include "pw_rpc/raw/server_reader_writer.h"
 #include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
 
 namespace pw::metric {
 
@@ -33,18 +37,57 @@ namespace pw::metric {
 // method is blocking, and sends all metrics at once (though batched). In the
 // future, we may switch to offering an async version where the Get() method
 // returns immediately, and someone else is responsible for pumping the queue.
+//
+// The service also supports streaming, for clients that poll metrics
+// frequently. A client opens a stream with Stream(), and the application then
+// calls Report() periodically. Each report sends only the metrics whose values
+// changed since the previous report, with periodic full snapshots that the
+// client requests. Changes are found by comparing each metric to the value it
+// last reported, which the service keeps in storage provided at construction.
 class MetricService final
     : public proto::pw_rpc::raw::MetricService::Service<MetricService> {
  public:
+  // The last reported value of a metric. Metrics are tracked in the order they
+  // are reported; if the metric tree changes, the affected metrics are
+  // reported again.
+  struct ReportedMetric {
+    const Metric* metric = nullptr;
+    uint32_t value = 0;
+  };
+
   MetricService(const IntrusiveList<Metric>& metrics,
                 const IntrusiveList<Group>& groups)
-      : metrics_(metrics), groups_(groups) {}
+      : MetricService(metrics, groups, span<ReportedMetric>()) {}
+
+  // Constructs a service that tracks up to reported.size() metrics for
+  // Stream(). Metrics that don't fit are included in every report.
+  MetricService(const IntrusiveList<Metric>& metrics,
+                const IntrusiveList<Group>& groups,
+                span<ReportedMetric> reported)
+      : metrics_(metrics), groups_(groups), reported_(reported) {}
 
   void Get(ConstByteSpan request, rpc::RawServerWriter& response);
 
+  void Stream(ConstByteSpan request, rpc::RawServerWriter& response)
+      PW_LOCKS_EXCLUDED(stream_mutex_);
+
+  // Sends the metrics that changed since the previous report, or all metrics
+  // if this report is a full snapshot, to the open stream. Returns one of:
+  //
+  //   OK - The report was sent. Reports with no changes send nothing.
+  //   FAILED_PRECONDITION - No client has an open stream.
+  //   Other - Sending failed. The next report is a full snapshot.
+  //
+  Status Report() PW_LOCKS_EXCLUDED(stream_mutex_);
+
  private:
   const IntrusiveList<Metric>& metrics_;
   const IntrusiveList<Group>& groups_;
+  sync::Mutex stream_mutex_;
+  const span<ReportedMetric> reported_ PW_GUARDED_BY(stream_mutex_);
+  rpc::RawServerWriter stream_ PW_GUARDED_BY(stream_mutex_);
+  uint32_t full_snapshot_interval_ PW_GUARDED_BY(stream_mutex_) = 0;
+  uint32_t report_count_ PW_GUARDED_BY(stream_mutex_) = 0;
 };
 
 }  // namespace pw::metric
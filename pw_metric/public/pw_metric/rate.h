@@ -0,0 +1,110 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "pw_metric/metric.h"
+
+namespace pw::metric {
+
+// Counts events per window of time, such as packets per second. The
+// application ends each window by calling EndWindow() at a fixed period, e.g.
+// from a periodic timer or work queue, so the rate does not depend on a clock
+// and incrementing it costs the same as incrementing a plain counter.
+//
+// A rate is a group of three uint32_t metrics, so it is dumped and exported
+// like any other metrics, e.g. by the MetricService:
+//
+//   "current" - Events counted in the window that is in progress.
+//   "last"    - Events counted in the last completed window.
+//   "peak"    - The most events counted in any completed window.
+//
+// Like other metrics, rates are not synchronized. Increment() does no locking,
+// so an increment that races with EndWindow() may be counted in either window
+// or lost.
+//
+// Size: 16 bytes for the group plus 36 bytes for the metrics.
+class Rate {
+ public:
+  // Constructs a rate, optionally adding it to a parent group's children.
+  explicit Rate(Token name) : group_(name) {}
+  Rate(Token name, IntrusiveList<Group>& groups) : group_(name, groups) {}
+
+  const Group& group() const { return group_; }
+  Group& group() { return group_; }
+
+  // Counts events in the current window.
+  void Increment(uint32_t amount = 1u) { current_.Increment(amount); }
+
+  // Completes the current window and starts a new one.
+  void EndWindow();
+
+  // Sets all counts to zero.
+  void Clear();
+
+  uint32_t current() const { return current_.value(); }
+  uint32_t last() const { return last_.value(); }
+  uint32_t peak() const { return peak_.value(); }
+
+  // Disallow copy and assign.
+  Rate(const Rate&) = delete;
+  Rate& operator=(const Rate&) = delete;
+
+ private:
+  Group group_;
+  PW_METRIC(group_, current_, "current", 0u);
+  PW_METRIC(group_, last_, "last", 0u);
+  PW_METRIC(group_, peak_, "peak", 0u);
+};
+
+// Declare a Rate, optionally adding it to a parent group. Works like
+// PW_METRIC_GROUP, and works in the same contexts. Use:
+//
+//   PW_METRIC_RATE(variable_name, rate_name)
+//   PW_METRIC_RATE(parent, variable_name, rate_name)
+//
+// Example:
+//
+//   class MyLink {
+//    public:
+//     void OnPacket() { packets_.Increment(); }
+//
+//     // Called once per second.
+//     void OnTick() { packets_.EndWindow(); }
+//
+//    private:
+//     PW_METRIC_GROUP(metrics_, "my_link");
+//     PW_METRIC_RATE(metrics_, packets_, "packets_per_second");
+//   };
+//
+#define PW_METRIC_RATE(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_RATE_, , __VA_ARGS__)
+#define PW_METRIC_RATE_STATIC(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_RATE_, static, __VA_ARGS__)
+
+#define _PW_METRIC_RATE_3(static_def, variable_name, rate_name) \
+  static constexpr uint32_t variable_name##_token =             \
+      PW_TOKENIZE_STRING_DOMAIN("metrics", rate_name);          \
+  static_def ::pw::metric::Rate variable_name { variable_name##_token }
+
+#define _PW_METRIC_RATE_4(static_def, parent, variable_name, rate_name) \
+  static constexpr uint32_t variable_name##_token =                     \
+      PW_TOKENIZE_STRING_DOMAIN("metrics", rate_name);                  \
+  static_def ::pw::metric::Rate variable_name {                         \
+    variable_name##_token, parent.children()                            \
+  }
+
+}  // namespace pw::metric
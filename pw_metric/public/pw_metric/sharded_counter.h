@@ -0,0 +1,159 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/intrusive_list.h"
+#include "pw_metric/metric.h"
+#include "pw_span/span.h"
+
+// The alignment of each shard of a ShardedCounter. Shards that share a cache
+// line are written by different cores, so by default shards are padded to a
+// typical cache line size. Targets without data caches may set this to 4 to
+// save RAM.
+#ifndef PW_METRIC_SHARD_ALIGNMENT
+#define PW_METRIC_SHARD_ALIGNMENT 64
+#endif  // PW_METRIC_SHARD_ALIGNMENT
+
+namespace pw::metric {
+namespace internal {
+
+// The part of a ShardedCounter that does not depend on the number of shards.
+class BasicShardedCounter : public IntrusiveList<BasicShardedCounter>::Item {
+ public:
+  // Returns the sum of all shards. Saturates at the max uint32_t value.
+  uint32_t value() const;
+
+  // Sets the counter's metric to the sum of all shards.
+  void Publish() { metric_.Set(value()); }
+
+  // Sets all shards to zero.
+  void Clear();
+
+  const TypedMetric<uint32_t>& metric() const { return metric_; }
+  TypedMetric<uint32_t>& metric() { return metric_; }
+
+  static void PublishAll();
+
+  // Disallow copy and assign.
+  BasicShardedCounter(const BasicShardedCounter&) = delete;
+  BasicShardedCounter& operator=(const BasicShardedCounter&) = delete;
+
+ protected:
+  struct alignas(PW_METRIC_SHARD_ALIGNMENT) Shard {
+    std::atomic<uint32_t> value{0};
+  };
+
+  BasicShardedCounter(Token name, span<Shard> shards);
+  BasicShardedCounter(Token name,
+                      IntrusiveList<Metric>& metrics,
+                      span<Shard> shards);
+  ~BasicShardedCounter();
+
+  void IncrementShard(size_t shard, uint32_t amount);
+
+ private:
+  void Register();
+
+  TypedMetric<uint32_t> metric_;
+  span<Shard> shards_;
+};
+
+}  // namespace internal
+
+// Publishes every ShardedCounter. The MetricService calls this before it reads
+// metrics, so sharded counters are exported with their current sums.
+inline void PublishShardedCounters() {
+  internal::BasicShardedCounter::PublishAll();
+}
+
+// A uint32_t counter that is split into shards, such as one per core, so that
+// cores incrementing the counter at the same time never write the same memory.
+// Each shard is incremented with a relaxed atomic operation that is never
+// contended as long as each shard has a single writer, and shards are summed
+// when the counter is read.
+//
+// The counter is exported as a single uint32_t metric. Its value is the sum of
+// the shards as of the last Publish(); the MetricService publishes every
+// sharded counter when metrics are requested. Call PublishShardedCounters()
+// before dumping metrics to logs.
+//
+// Sharded counters are registered in a global list when constructed. Like
+// PW_METRIC_GLOBAL, construct them at init time or in a static context; they
+// must not be constructed or destroyed while metrics are being exported.
+//
+// Size: 24 bytes plus kNumShards * PW_METRIC_SHARD_ALIGNMENT bytes.
+template <size_t kNumShards>
+class ShardedCounter : public internal::BasicShardedCounter {
+ public:
+  static_assert(kNumShards > 0, "A sharded counter needs at least one shard");
+
+  explicit ShardedCounter(Token name) : BasicShardedCounter(name, shards_) {}
+  ShardedCounter(Token name, IntrusiveList<Metric>& metrics)
+      : BasicShardedCounter(name, metrics, shards_) {}
+
+  // Adds to the given shard, typically the index of the calling core. Each
+  // shard saturates at the max uint32_t value.
+  void Increment(size_t shard, uint32_t amount = 1u) {
+    IncrementShard(shard, amount);
+  }
+
+ private:
+  std::array<Shard, kNumShards> shards_;
+};
+
+// Declare a ShardedCounter, optionally adding its metric to a group. Works
+// like PW_METRIC, and works in the same contexts. Use:
+//
+//   PW_METRIC_SHARDED_COUNTER(variable_name, metric_name, num_shards)
+//   PW_METRIC_SHARDED_COUNTER(group, variable_name, metric_name, num_shards)
+//
+// Example:
+//
+//   class Scheduler {
+//    public:
+//     void OnContextSwitch() { switches_.Increment(CurrentCoreIndex()); }
+//
+//    private:
+//     PW_METRIC_GROUP(metrics_, "scheduler");
+//     PW_METRIC_SHARDED_COUNTER(metrics_, switches_, "switches", kNumCores);
+//   };
+//
+#define PW_METRIC_SHARDED_COUNTER(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_SHARDED_COUNTER_, , __VA_ARGS__)
+#define PW_METRIC_SHARDED_COUNTER_STATIC(...) \
+  PW_DELEGATE_BY_ARG_COUNT(_PW_METRIC_SHARDED_COUNTER_, static, __VA_ARGS__)
+
+#define _PW_METRIC_SHARDED_COUNTER_4(                                         \
+    static_def, variable_name, metric_name, num_shards)                       \
+  static constexpr uint32_t variable_name##_token =                           \
+      PW_TOKENIZE_STRING_MASK("metrics", _PW_METRIC_TOKEN_MASK, metric_name); \
+  static_def ::pw::metric::ShardedCounter<num_shards> variable_name {         \
+    variable_name##_token                                                     \
+  }
+
+#define _PW_METRIC_SHARDED_COUNTER_5(                                         \
+    static_def, group, variable_name, metric_name, num_shards)                \
+  static constexpr uint32_t variable_name##_token =                           \
+      PW_TOKENIZE_STRING_MASK("metrics", _PW_METRIC_TOKEN_MASK, metric_name); \
+  static_def ::pw::metric::ShardedCounter<num_shards> variable_name {         \
+    variable_name##_token, group.metrics()                                    \
+  }
+
+}  // namespace pw::metric
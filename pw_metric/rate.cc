@@ -0,0 +1,34 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_metric/rate.h"
+
+namespace pw::metric {
+
+void Rate::EndWindow() {
+  const uint32_t count = current_.value();
+  current_.Set(0);
+  last_.Set(count);
+  if (count > peak_.value()) {
+    peak_.Set(count);
+  }
+}
+
+void Rate::Clear() {
+  current_.Set(0);
+  last_.Set(0);
+  peak_.Set(0);
+}
+
+}  // namespace pw::metric
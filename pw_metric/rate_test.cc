@@ -0,0 +1,91 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_metric/rate.h"
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::metric {
+namespace {
+
+TEST(Rate, EndWindow) {
+  Rate rate(0x1234);
+  rate.Increment();
+  rate.Increment(4);
+  EXPECT_EQ(rate.current(), 5u);
+  EXPECT_EQ(rate.last(), 0u);
+  EXPECT_EQ(rate.peak(), 0u);
+
+  rate.EndWindow();
+  EXPECT_EQ(rate.current(), 0u);
+  EXPECT_EQ(rate.last(), 5u);
+  EXPECT_EQ(rate.peak(), 5u);
+
+  rate.Increment(2);
+  rate.EndWindow();
+  EXPECT_EQ(rate.last(), 2u);
+  EXPECT_EQ(rate.peak(), 5u);
+
+  rate.Increment(9);
+  rate.EndWindow();
+  EXPECT_EQ(rate.last(), 9u);
+  EXPECT_EQ(rate.peak(), 9u);
+}
+
+TEST(Rate, Clear) {
+  Rate rate(0x1234);
+  rate.Increment(3);
+  rate.EndWindow();
+  rate.Increment();
+
+  rate.Clear();
+  EXPECT_EQ(rate.current(), 0u);
+  EXPECT_EQ(rate.last(), 0u);
+  EXPECT_EQ(rate.peak(), 0u);
+}
+
+TEST(Rate, MetricsInGroup) {
+  Rate rate(0x1234);
+  EXPECT_EQ(rate.group().name(), 0x1234u);
+  EXPECT_EQ(rate.group().metrics().size(), 3u);
+}
+
+class RateOwner {
+ public:
+  void Tick() { packets_.EndWindow(); }
+  Group& metrics() { return metrics_; }
+
+ private:
+  PW_METRIC_GROUP(metrics_, "owner");
+  PW_METRIC_RATE(metrics_, packets_, "packets");
+};
+
+TEST(Rate, MacroAddsRateToParent) {
+  RateOwner owner;
+  owner.Tick();
+
+  ASSERT_EQ(owner.metrics().children().size(), 1u);
+  EXPECT_EQ(owner.metrics().children().front().name(),
+            PW_TOKENIZE_STRING_DOMAIN_EXPR("metrics", "packets"));
+}
+
+TEST(Rate, MacroWithoutParent) {
+  PW_METRIC_RATE(rate, "rate");
+  rate.Increment();
+  rate.EndWindow();
+  EXPECT_EQ(rate.last(), 1u);
+}
+
+}  // namespace
+}  // namespace pw::metric
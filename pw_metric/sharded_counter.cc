@@ -0,0 +1,87 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_metric/sharded_counter.h"
+
+#include <limits>
+
+#include "pw_assert/check.h"
+#include "pw_preprocessor/compiler.h"
+
+namespace pw::metric::internal {
+namespace {
+
+IntrusiveList<BasicShardedCounter>& sharded_counters() {
+  static IntrusiveList<BasicShardedCounter> counters;
+  return counters;
+}
+
+}  // namespace
+
+BasicShardedCounter::BasicShardedCounter(Token name, span<Shard> shards)
+    : metric_(name, 0u), shards_(shards) {
+  Register();
+}
+
+BasicShardedCounter::BasicShardedCounter(Token name,
+                                         IntrusiveList<Metric>& metrics,
+                                         span<Shard> shards)
+    : metric_(name, 0u, metrics), shards_(shards) {
+  Register();
+}
+
+BasicShardedCounter::~BasicShardedCounter() {
+  sharded_counters().remove(*this);
+}
+
+void BasicShardedCounter::Register() { sharded_counters().push_front(*this); }
+
+uint32_t BasicShardedCounter::value() const {
+  uint32_t sum = 0;
+  for (const Shard& shard : shards_) {
+    if (PW_ADD_OVERFLOW(
+            sum, shard.value.load(std::memory_order_relaxed), &sum)) {
+      return std::numeric_limits<uint32_t>::max();
+    }
+  }
+  return sum;
+}
+
+void BasicShardedCounter::Clear() {
+  for (Shard& shard : shards_) {
+    shard.value.store(0, std::memory_order_relaxed);
+  }
+  metric_.Set(0);
+}
+
+void BasicShardedCounter::IncrementShard(size_t shard, uint32_t amount) {
+  PW_DCHECK_UINT_LT(shard, shards_.size());
+  std::atomic<uint32_t>& value = shards_[shard].value;
+  uint32_t expected = value.load(std::memory_order_relaxed);
+  uint32_t desired;
+  do {
+    if (PW_ADD_OVERFLOW(expected, amount, &desired)) {
+      desired = std::numeric_limits<uint32_t>::max();
+    }
+  } while (!value.compare_exchange_weak(
+      expected, desired, std::memory_order_relaxed));
+}
+
+void BasicShardedCounter::PublishAll() {
+  for (BasicShardedCounter& counter : sharded_counters()) {
+    counter.Publish();
+  }
+}
+
+}  // namespace pw::metric::internal
@@ -0,0 +1,86 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_metric/sharded_counter.h"
+
+#include <limits>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::metric {
+namespace {
+
+TEST(ShardedCounter, SumsShards) {
+  ShardedCounter<4> counter(0x1234);
+  counter.Increment(0);
+  counter.Increment(1, 2);
+  counter.Increment(3, 3);
+  EXPECT_EQ(counter.value(), 6u);
+
+  // The metric is only updated when published.
+  EXPECT_EQ(counter.metric().value(), 0u);
+  counter.Publish();
+  EXPECT_EQ(counter.metric().value(), 6u);
+}
+
+TEST(ShardedCounter, ShardsSaturate) {
+  ShardedCounter<2> counter(0x1234);
+  counter.Increment(0, std::numeric_limits<uint32_t>::max());
+  counter.Increment(0);
+  EXPECT_EQ(counter.value(), std::numeric_limits<uint32_t>::max());
+
+  // The sum saturates too.
+  counter.Increment(1);
+  EXPECT_EQ(counter.value(), std::numeric_limits<uint32_t>::max());
+}
+
+TEST(ShardedCounter, Clear) {
+  ShardedCounter<2> counter(0x1234);
+  counter.Increment(0, 2);
+  counter.Increment(1, 2);
+  counter.Publish();
+
+  counter.Clear();
+  EXPECT_EQ(counter.value(), 0u);
+  EXPECT_EQ(counter.metric().value(), 0u);
+}
+
+TEST(ShardedCounter, PublishShardedCounters) {
+  ShardedCounter<2> a(0x1234);
+  ShardedCounter<3> b(0x5678);
+  a.Increment(1, 10);
+  b.Increment(2, 20);
+
+  PublishShardedCounters();
+  EXPECT_EQ(a.metric().value(), 10u);
+  EXPECT_EQ(b.metric().value(), 20u);
+}
+
+TEST(ShardedCounter, MacroAddsMetricToGroup) {
+  PW_METRIC_GROUP(group, "group");
+  PW_METRIC_SHARDED_COUNTER(group, counter, "counter", 2);
+  counter.Increment(1);
+
+  ASSERT_EQ(group.metrics().size(), 1u);
+  EXPECT_EQ(&group.metrics().front(), &counter.metric());
+  EXPECT_EQ(group.metrics().front().name(), counter_token);
+}
+
+TEST(ShardedCounter, ShardsAreAligned) {
+  ShardedCounter<2> counter(0x1234);
+  EXPECT_GE(sizeof(counter), 2u * PW_METRIC_SHARD_ALIGNMENT);
+}
+
+}  // namespace
+}  // namespace pw::metric
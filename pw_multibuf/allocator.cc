@@ -18,46 +18,54 @@
 
 namespace pw::multibuf {
 
-std::optional<MultiBuf> MultiBufAllocator::Allocate(size_t size) {
-  return Allocate(size, size);
+std::optional<MultiBuf> MultiBufAllocator::Allocate(size_t size,
+                                                    Reservation reservation) {
+  return Allocate(size, size, reservation);
 }
 
 std::optional<MultiBuf> MultiBufAllocator::Allocate(size_t min_size,
-                                                    size_t desired_size) {
-  pw::Result<MultiBuf> result = DoAllocate(min_size, desired_size, false);
+                                                    size_t desired_size,
+                                                    Reservation reservation) {
+  pw::Result<MultiBuf> result =
+      DoAllocate(min_size, desired_size, false, reservation);
   if (result.ok()) {
     return std::move(*result);
   }
   return std::nullopt;
 }
 
-std::optional<MultiBuf> MultiBufAllocator::AllocateContiguous(size_t size) {
-  return AllocateContiguous(size, size);
+std::optional<MultiBuf> MultiBufAllocator::AllocateContiguous(
+    size_t size, Reservation reservation) {
+  return AllocateContiguous(size, size, reservation);
 }
 
 std::optional<MultiBuf> MultiBufAllocator::AllocateContiguous(
-    size_t min_size, size_t desired_size) {
-  pw::Result<MultiBuf> result = DoAllocate(min_size, desired_size, true);
+    size_t min_size, size_t desired_size, Reservation reservation) {
+  pw::Result<MultiBuf> result =
+      DoAllocate(min_size, desired_size, true, reservation);
   if (result.ok()) {
     return std::move(*result);
   }
   return std::nullopt;
 }
 
-MultiBufAllocationFuture MultiBufAllocator::AllocateAsync(size_t size) {
-  return MultiBufAllocationFuture(*this, size, size, false);
+MultiBufAllocationFuture MultiBufAllocator::AllocateAsync(
+    size_t size, Reservation reservation) {
+  return MultiBufAllocationFuture(*this, size, size, false, reservation);
 }
-MultiBufAllocationFuture MultiBufAllocator::AllocateAsync(size_t min_size,
-                                                          size_t desired_size) {
-  return MultiBufAllocationFuture(*this, min_size, desired_size, false);
+MultiBufAllocationFuture MultiBufAllocator::AllocateAsync(
+    size_t min_size, size_t desired_size, Reservation reservation) {
+  return MultiBufAllocationFuture(
+      *this, min_size, desired_size, false, reservation);
 }
 MultiBufAllocationFuture MultiBufAllocator::AllocateContiguousAsync(
-    size_t size) {
-  return MultiBufAllocationFuture(*this, size, size, true);
+    size_t size, Reservation reservation) {
+  return MultiBufAllocationFuture(*this, size, size, true, reservation);
 }
 MultiBufAllocationFuture MultiBufAllocator::AllocateContiguousAsync(
-    size_t min_size, size_t desired_size) {
-  return MultiBufAllocationFuture(*this, min_size, desired_size, true);
+    size_t min_size, size_t desired_size, Reservation reservation) {
+  return MultiBufAllocationFuture(
+      *this, min_size, desired_size, true, reservation);
 }
 
 void MultiBufAllocator::MoreMemoryAvailable(size_t size_available,
@@ -70,8 +78,9 @@ void MultiBufAllocator::MoreMemoryAvailable(size_t size_available,
   internal::AllocationWaiter* current = first_waiter_;
   while (current != nullptr) {
     PW_DCHECK(current->allocator_ == this);
-    if ((current->min_size_ <= contiguous_size_available) ||
-        (!current->needs_contiguous_ && current->min_size_ <= size_available)) {
+    size_t min_size = current->min_size_ + current->reservation_.size();
+    if ((min_size <= contiguous_size_available) ||
+        (!current->needs_contiguous_ && min_size <= size_available)) {
       std::move(current->waker_).Wake();
     }
     current = current->next_;
@@ -90,9 +99,13 @@ void MultiBufAllocator::AddWaiterLocked(internal::AllocationWaiter* waiter)
     PW_NO_LOCK_SAFETY_ANALYSIS {
   PW_DCHECK(waiter->allocator_ == this);
   PW_DCHECK(waiter->next_ == nullptr);
-  auto old_first = first_waiter_;
-  first_waiter_ = waiter;
-  waiter->next_ = old_first;
+  // Append the waiter so that waiters are awoken in FIFO order.
+  if (last_waiter_ == nullptr) {
+    first_waiter_ = waiter;
+  } else {
+    last_waiter_->next_ = waiter;
+  }
+  last_waiter_ = waiter;
 }
 
 void MultiBufAllocator::RemoveWaiter(internal::AllocationWaiter* waiter)
@@ -113,6 +126,9 @@ void MultiBufAllocator::RemoveWaiterLocked(internal::AllocationWaiter* waiter)
   PW_DCHECK(waiter->allocator_ == this);
   if (waiter == first_waiter_) {
     first_waiter_ = first_waiter_->next_;
+    if (last_waiter_ == waiter) {
+      last_waiter_ = nullptr;
+    }
     waiter->next_ = nullptr;
     return;
   }
@@ -120,6 +136,9 @@ void MultiBufAllocator::RemoveWaiterLocked(internal::AllocationWaiter* waiter)
   while (current != nullptr) {
     if (current->next_ == waiter) {
       current->next_ = waiter->next_;
+      if (last_waiter_ == waiter) {
+        last_waiter_ = current;
+      }
       waiter->next_ = nullptr;
       return;
     }
@@ -135,7 +154,8 @@ AllocationWaiter::AllocationWaiter(AllocationWaiter&& other)
       next_(nullptr),
       min_size_(other.min_size_),
       desired_size_(other.desired_size_),
-      needs_contiguous_(other.needs_contiguous_) {
+      needs_contiguous_(other.needs_contiguous_),
+      reservation_(other.reservation_) {
   std::lock_guard lock(allocator_->lock_);
   allocator_->RemoveWaiterLocked(&other);
   allocator_->AddWaiterLocked(this);
@@ -152,6 +172,7 @@ AllocationWaiter& AllocationWaiter::operator=(AllocationWaiter&& other) {
   min_size_ = other.min_size_;
   desired_size_ = other.desired_size_;
   needs_contiguous_ = other.needs_contiguous_;
+  reservation_ = other.reservation_;
 
   std::lock_guard lock(allocator_->lock_);
   allocator_->RemoveWaiterLocked(&other);
@@ -188,8 +209,11 @@ async2::Poll<std::optional<MultiBuf>> MultiBufAllocationFuture::Pend(
 }
 
 async2::Poll<std::optional<MultiBuf>> MultiBufAllocationFuture::TryAllocate() {
-  pw::Result<MultiBuf> buf_opt = waiter_.allocator().DoAllocate(
-      waiter_.min_size(), waiter_.desired_size(), waiter_.needs_contiguous());
+  pw::Result<MultiBuf> buf_opt =
+      waiter_.allocator().DoAllocate(waiter_.min_size(),
+                                     waiter_.desired_size(),
+                                     waiter_.needs_contiguous(),
+                                     waiter_.reservation());
   if (buf_opt.ok()) {
     return async2::Ready<std::optional<MultiBuf>>(std::move(*buf_opt));
   }
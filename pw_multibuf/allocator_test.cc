@@ -32,6 +32,7 @@ struct AllocateExpectation {
   size_t min_size;
   size_t desired_size;
   bool contiguous;
+  Reservation reservation;
   pw::Result<MultiBuf> result;
 };
 
@@ -45,11 +46,12 @@ class MockMultiBufAllocator : public MultiBufAllocator {
   void ExpectAllocateAndReturn(size_t min_size,
                                size_t desired_size,
                                bool contiguous,
-                               pw::Result<MultiBuf> result) {
+                               pw::Result<MultiBuf> result,
+                               Reservation reservation = {}) {
     // Multiple simultaneous expectations are not supported.
     ASSERT_FALSE(expected_allocate_.has_value());
     expected_allocate_ = {
-        min_size, desired_size, contiguous, std::move(result)};
+        min_size, desired_size, contiguous, reservation, std::move(result)};
   }
 
   using MultiBufAllocator::MoreMemoryAvailable;
@@ -57,7 +59,8 @@ class MockMultiBufAllocator : public MultiBufAllocator {
  private:
   pw::Result<MultiBuf> DoAllocate(size_t min_size,
                                   size_t desired_size,
-                                  bool contiguous) final {
+                                  bool contiguous,
+                                  Reservation reservation) final {
     EXPECT_NE(expected_allocate_, std::nullopt);
     if (!expected_allocate_.has_value()) {
       return Status::FailedPrecondition();
@@ -67,6 +70,8 @@ class MockMultiBufAllocator : public MultiBufAllocator {
     EXPECT_EQ(min_size, expected.min_size);
     EXPECT_EQ(desired_size, expected.desired_size);
     EXPECT_EQ(contiguous, expected.contiguous);
+    EXPECT_EQ(reservation.headroom, expected.reservation.headroom);
+    EXPECT_EQ(reservation.tailroom, expected.reservation.tailroom);
     return std::move(expected.result);
   }
 
@@ -129,5 +134,28 @@ TEST(MultiBufAllocator, AllocateAsyncWillNotPollUntilMoreMemoryAvailable) {
   EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
 }
 
+TEST(MultiBufAllocator, AllocateAsyncWithReservationWaitsForReservedSize) {
+  MockMultiBufAllocator alloc;
+  AllocateTask task(alloc.AllocateAsync(44, 33, Reservation{4, 2}));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+
+  // The reservation is passed through to the allocator.
+  alloc.ExpectAllocateAndReturn(
+      44, 33, false, Status::ResourceExhausted(), Reservation{4, 2});
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  // Memory for the payload alone should not awaken the task.
+  alloc.MoreMemoryAvailable(45, 45);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  alloc.MoreMemoryAvailable(50, 50);
+  alloc.ExpectAllocateAndReturn(
+      44, 33, false, Status::OutOfRange(), Reservation{4, 2});
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  ASSERT_TRUE(task.last_result_.IsReady());
+  EXPECT_FALSE(task.last_result_->has_value());
+}
+
 }  // namespace
 }  // namespace pw::multibuf
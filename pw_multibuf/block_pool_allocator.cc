@@ -0,0 +1,185 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multibuf/block_pool_allocator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "pw_assert/check.h"
+
+namespace pw::multibuf {
+namespace {
+
+// Free blocks form a singly-linked list, with the pointer to the next free
+// block stored in the first bytes of each block. The data area has no
+// alignment requirements, so the pointer is copied rather than dereferenced.
+
+std::byte* GetNextFree(const std::byte* block) {
+  std::byte* next;
+  std::memcpy(&next, block, sizeof(next));
+  return next;
+}
+
+void SetNextFree(std::byte* block, std::byte* next) {
+  std::memcpy(block, &next, sizeof(next));
+}
+
+}  // namespace
+
+namespace internal {
+
+void PoolBlockTracker::Destroy() {
+  size_t num_free_blocks;
+  {
+    // N.B.: this lock *must* go out of scope before the call to
+    // ``Delete(this)`` below in order to prevent referencing the ``parent_``
+    // field after this tracker has been destroyed.
+    std::lock_guard lock(parent_.lock_);
+    parent_.FreeBlock(region_.data());
+    num_free_blocks = parent_.num_free_blocks_;
+  }
+  parent_.MoreMemoryAvailable(num_free_blocks * parent_.block_size_,
+                              parent_.block_size_);
+  parent_.metadata_alloc_.Delete(this);
+}
+
+void* PoolBlockTracker::AllocateChunkClass() {
+  return parent_.metadata_alloc_.Allocate(allocator::Layout::Of<Chunk>());
+}
+
+void PoolBlockTracker::DeallocateChunkClass(void* ptr) {
+  return parent_.metadata_alloc_.Deallocate(ptr,
+                                            allocator::Layout::Of<Chunk>());
+}
+
+}  // namespace internal
+
+BlockPoolAllocator::BlockPoolAllocator(ByteSpan data_area,
+                                       size_t block_size,
+                                       pw::allocator::Allocator& metadata_alloc)
+    : metadata_alloc_(metadata_alloc),
+      block_size_(block_size),
+      num_blocks_(block_size == 0 ? 0 : data_area.size() / block_size) {
+  PW_CHECK_UINT_GE(block_size, sizeof(std::byte*));
+  std::lock_guard lock(lock_);
+  for (size_t i = num_blocks_; i != 0; --i) {
+    FreeBlock(data_area.data() + ((i - 1) * block_size_));
+  }
+}
+
+size_t BlockPoolAllocator::num_free_blocks() {
+  std::lock_guard lock(lock_);
+  return num_free_blocks_;
+}
+
+pw::Result<MultiBuf> BlockPoolAllocator::DoAllocate(size_t min_size,
+                                                    size_t desired_size,
+                                                    bool needs_contiguous,
+                                                    Reservation reservation) {
+  size_t max_blocks =
+      needs_contiguous ? std::min<size_t>(num_blocks_, 1) : num_blocks_;
+  // The headroom must fit in the first block and the tailroom in the last.
+  if (reservation.headroom > block_size_ ||
+      reservation.tailroom > block_size_ ||
+      NumBlocksFor(min_size, reservation) > max_blocks) {
+    return Status::OutOfRange();
+  }
+
+  size_t goal_size;
+  size_t num_blocks;
+  {
+    std::lock_guard lock(lock_);
+    size_t free_blocks = std::min(num_free_blocks_, max_blocks);
+    if (NumBlocksFor(min_size, reservation) > free_blocks) {
+      return Status::ResourceExhausted();
+    }
+    goal_size = std::min(desired_size,
+                         (free_blocks * block_size_) - reservation.size());
+    num_blocks = NumBlocksFor(goal_size, reservation);
+    num_free_blocks_ -= num_blocks;
+  }
+  if (num_blocks == 0) {
+    return MultiBuf();
+  }
+
+  // Wrap each reserved block in a chunk. The lock is not held while doing so,
+  // since releasing a chunk on failure returns its block to the pool.
+  //
+  // Blocks are filled from the back, so the first chunk holds whatever is left
+  // of the payload. The headroom is discarded from the start of the first block
+  // and the tailroom is left unused at the end of the last block, where
+  // ``ClaimPrefix`` and ``ClaimSuffix`` can reach them.
+  MultiBuf buf;
+  size_t remaining = goal_size;
+  for (size_t i = 0; i < num_blocks; ++i) {
+    pw::Result<OwnedChunk> chunk = AllocateBlock();
+    if (!chunk.ok()) {
+      // Return the remaining reserved blocks along with any already wrapped.
+      {
+        std::lock_guard lock(lock_);
+        num_free_blocks_ += num_blocks - i;
+      }
+      return chunk.status();
+    }
+    size_t headroom = i == num_blocks - 1 ? reservation.headroom : 0;
+    size_t tailroom = i == 0 ? reservation.tailroom : 0;
+    size_t chunk_size =
+        std::min(block_size_ - headroom - tailroom, remaining);
+    (*chunk)->DiscardPrefix(headroom);
+    (*chunk)->Truncate(chunk_size);
+    remaining -= chunk_size;
+    buf.PushFrontChunk(std::move(*chunk));
+  }
+  return buf;
+}
+
+size_t BlockPoolAllocator::NumBlocksFor(size_t size,
+                                        Reservation reservation) const {
+  return (size + reservation.size() + block_size_ - 1) / block_size_;
+}
+
+pw::Result<OwnedChunk> BlockPoolAllocator::AllocateBlock() {
+  std::byte* block;
+  {
+    std::lock_guard lock(lock_);
+    PW_DCHECK_NOTNULL(free_list_);
+    block = free_list_;
+    free_list_ = GetNextFree(block);
+  }
+  internal::PoolBlockTracker* tracker =
+      metadata_alloc_.New<internal::PoolBlockTracker>(
+          *this, ByteSpan(block, block_size_));
+  if (tracker != nullptr) {
+    std::optional<OwnedChunk> chunk = tracker->CreateFirstChunk();
+    if (chunk.has_value()) {
+      return std::move(*chunk);
+    }
+    metadata_alloc_.Delete(tracker);
+  }
+  // Put the block back without counting it as free; the caller does so.
+  std::lock_guard lock(lock_);
+  SetNextFree(block, free_list_);
+  free_list_ = block;
+  return Status::OutOfRange();
+}
+
+void BlockPoolAllocator::FreeBlock(std::byte* block) {
+  SetNextFree(block, free_list_);
+  free_list_ = block;
+  ++num_free_blocks_;
+}
+
+}  // namespace pw::multibuf
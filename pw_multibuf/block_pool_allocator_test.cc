@@ -0,0 +1,224 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multibuf/block_pool_allocator.h"
+
+#include <array>
+
+#include "gtest/gtest.h"
+#include "pw_allocator/null_allocator.h"
+#include "pw_allocator/testing.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/poll.h"
+
+namespace pw::multibuf {
+namespace {
+
+using ::pw::allocator::test::AllocatorForTest;
+using ::pw::async2::Context;
+using ::pw::async2::Dispatcher;
+using ::pw::async2::Pending;
+using ::pw::async2::Poll;
+using ::pw::async2::Ready;
+using ::pw::async2::Task;
+
+constexpr size_t kBlockSize = 256;
+constexpr size_t kNumBlocks = 4;
+constexpr size_t kArbitraryMetaSize = 2048;
+
+class BlockPoolAllocatorTest : public ::testing::Test {
+ protected:
+  BlockPoolAllocatorTest() : allocator_(data_area_, kBlockSize, meta_alloc_) {}
+
+  std::array<std::byte, kBlockSize * kNumBlocks> data_area_;
+  AllocatorForTest<kArbitraryMetaSize> meta_alloc_;
+  BlockPoolAllocator allocator_;
+};
+
+class AllocateTask : public Task {
+ public:
+  AllocateTask(MultiBufAllocationFuture&& future)
+      : future_(std::move(future)), last_result_(Pending()) {}
+
+  MultiBufAllocationFuture future_;
+  Poll<std::optional<MultiBuf>> last_result_;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    last_result_ = future_.Pend(cx);
+    if (last_result_.IsReady()) {
+      return Ready();
+    }
+    return Pending();
+  }
+};
+
+TEST_F(BlockPoolAllocatorTest, AllocateUsesOneChunkPerBlock) {
+  std::optional<MultiBuf> buf = allocator_.Allocate(kBlockSize * 2 + 1);
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->size(), kBlockSize * 2 + 1);
+  EXPECT_EQ(buf->Chunks().size(), 3U);
+  EXPECT_EQ(allocator_.num_free_blocks(), kNumBlocks - 3);
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateWholeDataAreaSucceeds) {
+  std::optional<MultiBuf> buf = allocator_.Allocate(kBlockSize * kNumBlocks);
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->size(), kBlockSize * kNumBlocks);
+  EXPECT_EQ(allocator_.num_free_blocks(), 0U);
+  EXPECT_FALSE(allocator_.Allocate(1).has_value());
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateRangeUsesAvailableBlocks) {
+  std::optional<MultiBuf> buf1 = allocator_.Allocate(kBlockSize);
+  ASSERT_TRUE(buf1.has_value());
+  std::optional<MultiBuf> buf2 =
+      allocator_.Allocate(kBlockSize, kBlockSize * kNumBlocks);
+  ASSERT_TRUE(buf2.has_value());
+  EXPECT_EQ(buf2->size(), kBlockSize * (kNumBlocks - 1));
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateContiguousIsLimitedToOneBlock) {
+  EXPECT_FALSE(allocator_.AllocateContiguous(kBlockSize + 1).has_value());
+  std::optional<MultiBuf> buf =
+      allocator_.AllocateContiguous(kBlockSize / 2, kBlockSize * 2);
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->Chunks().size(), 1U);
+  EXPECT_EQ(buf->size(), kBlockSize);
+}
+
+TEST_F(BlockPoolAllocatorTest, ReleasingBufferReturnsBlocks) {
+  std::optional<MultiBuf> buf = allocator_.Allocate(kBlockSize * kNumBlocks);
+  ASSERT_TRUE(buf.has_value());
+  buf->Release();
+  EXPECT_EQ(allocator_.num_free_blocks(), kNumBlocks);
+  buf = allocator_.Allocate(kBlockSize * kNumBlocks);
+  EXPECT_TRUE(buf.has_value());
+}
+
+TEST_F(BlockPoolAllocatorTest, ChunksInBlockShareRegion) {
+  std::optional<MultiBuf> buf = allocator_.AllocateContiguous(kBlockSize);
+  ASSERT_TRUE(buf.has_value());
+  std::optional<MultiBuf> front = buf->TakePrefix(kBlockSize / 2);
+  ASSERT_TRUE(front.has_value());
+
+  // The block is only returned once both chunks are released.
+  buf->Release();
+  EXPECT_EQ(allocator_.num_free_blocks(), kNumBlocks - 1);
+  front->Release();
+  EXPECT_EQ(allocator_.num_free_blocks(), kNumBlocks);
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateWithReservationSpansBlocks) {
+  constexpr Reservation kReservation{16, 8};
+  std::optional<MultiBuf> buf = allocator_.Allocate(kBlockSize, kReservation);
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->size(), kBlockSize);
+  EXPECT_EQ(buf->Chunks().size(), 2U);
+
+  // The headroom is in the first block and the tailroom is in the last.
+  EXPECT_TRUE(buf->ClaimPrefix(kReservation.headroom));
+  EXPECT_TRUE(buf->ClaimSuffix(kReservation.tailroom));
+  EXPECT_EQ(buf->size(), kBlockSize + kReservation.size());
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateWithTailroomLargerThanLastBlockFill) {
+  // The payload alone would leave only 4 bytes in its last block, so the
+  // tailroom is reserved in a block of its own.
+  constexpr Reservation kReservation{0, 8};
+  std::optional<MultiBuf> buf =
+      allocator_.Allocate(kBlockSize - 4, kReservation);
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->size(), kBlockSize - 4);
+  EXPECT_EQ(allocator_.num_free_blocks(), kNumBlocks - 2);
+  EXPECT_TRUE(buf->ClaimSuffix(kReservation.tailroom));
+  EXPECT_FALSE(buf->ClaimSuffix(1));
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateWithHeadroomLargerThanFirstBlockFill) {
+  constexpr Reservation kReservation{kBlockSize, 0};
+  std::optional<MultiBuf> buf = allocator_.Allocate(1, kReservation);
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->size(), 1U);
+  EXPECT_TRUE(buf->ClaimPrefix(kReservation.headroom));
+  EXPECT_FALSE(buf->ClaimPrefix(1));
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateWithReservationLargerThanBlockFails) {
+  EXPECT_FALSE(
+      allocator_.Allocate(1, Reservation{kBlockSize + 1, 0}).has_value());
+  EXPECT_FALSE(
+      allocator_.Allocate(1, Reservation{0, kBlockSize + 1}).has_value());
+  EXPECT_FALSE(
+      allocator_.AllocateContiguous(kBlockSize, Reservation{0, 1}).has_value());
+  EXPECT_EQ(allocator_.num_free_blocks(), kNumBlocks);
+}
+
+TEST(BlockPoolAllocator, AllocateFailsWithoutMetadata) {
+  std::array<std::byte, kBlockSize * kNumBlocks> data_area;
+  pw::allocator::NullAllocator meta_alloc;
+  BlockPoolAllocator allocator(data_area, kBlockSize, meta_alloc);
+  EXPECT_FALSE(allocator.Allocate(kBlockSize * 2).has_value());
+  EXPECT_EQ(allocator.num_free_blocks(), kNumBlocks);
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateAsyncWakesWaitersInOrder) {
+  std::optional<MultiBuf> buf = allocator_.Allocate(kBlockSize * kNumBlocks);
+  ASSERT_TRUE(buf.has_value());
+
+  AllocateTask task1(allocator_.AllocateAsync(kBlockSize));
+  AllocateTask task2(allocator_.AllocateAsync(kBlockSize));
+  Dispatcher dispatcher;
+  dispatcher.Post(task1);
+  dispatcher.Post(task2);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  // Returning a block wakes both tasks, but the first to wait allocates it.
+  buf->TakeFrontChunk().Release();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  ASSERT_TRUE(task1.last_result_.IsReady());
+  EXPECT_TRUE(task1.last_result_->has_value());
+  EXPECT_TRUE(task2.last_result_.IsPending());
+
+  buf->TakeFrontChunk().Release();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  ASSERT_TRUE(task2.last_result_.IsReady());
+  EXPECT_TRUE(task2.last_result_->has_value());
+}
+
+TEST_F(BlockPoolAllocatorTest, AllocateAsyncWithTailroomCompletes) {
+  std::optional<MultiBuf> buf = allocator_.Allocate(kBlockSize * kNumBlocks);
+  ASSERT_TRUE(buf.has_value());
+
+  AllocateTask task(
+      allocator_.AllocateAsync(kBlockSize * 2 - 4, Reservation{0, 8}));
+  Dispatcher dispatcher;
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  // Two free blocks are not enough once the tailroom is included.
+  buf->TakeFrontChunk().Release();
+  buf->TakeFrontChunk().Release();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+
+  buf->TakeFrontChunk().Release();
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  ASSERT_TRUE(task.last_result_.IsReady());
+  ASSERT_TRUE(task.last_result_->has_value());
+  EXPECT_EQ((*task.last_result_)->size(), kBlockSize * 2 - 4);
+  EXPECT_TRUE((*task.last_result_)->ClaimSuffix(8));
+}
+
+}  // namespace
+}  // namespace pw::multibuf
@@ -14,6 +14,8 @@
 
 #include "pw_multibuf/multibuf.h"
 
+#include <utility>
+
 #include "pw_assert/check.h"
 
 namespace pw::multibuf {
@@ -34,6 +36,24 @@ size_t MultiBuf::size() const {
   return len;
 }
 
+MultiBuf::iterator MultiBuf::Seek(size_t offset) {
+  const_iterator iter = std::as_const(*this).Seek(offset);
+  return iterator(const_cast<Chunk*>(iter.chunk()), iter.byte_index());
+}
+
+MultiBuf::const_iterator MultiBuf::Seek(size_t offset) const {
+  PW_DCHECK(offset <= size());
+  const Chunk* chunk = first_;
+  while (chunk != nullptr && offset >= chunk->size()) {
+    offset -= chunk->size();
+    chunk = chunk->next_in_buf_;
+  }
+  if (chunk == nullptr) {
+    return const_iterator::end();
+  }
+  return const_iterator(chunk, offset);
+}
+
 bool MultiBuf::ClaimPrefix(size_t bytes_to_claim) {
   if (first_ == nullptr) {
     return false;
@@ -51,8 +71,8 @@ bool MultiBuf::ClaimSuffix(size_t bytes_to_claim) {
 void MultiBuf::DiscardPrefix(size_t bytes_to_discard) {
   PW_DCHECK(bytes_to_discard <= size());
   while (bytes_to_discard != 0) {
-    if (ChunkBegin()->size() > bytes_to_discard) {
-      ChunkBegin()->DiscardPrefix(bytes_to_discard);
+    if (first_->size() > bytes_to_discard) {
+      first_->DiscardPrefix(bytes_to_discard);
       return;
     }
     OwnedChunk front_chunk = TakeFrontChunk();
@@ -70,6 +90,7 @@ void MultiBuf::Truncate(size_t len) {
   PW_DCHECK(len <= size());
   if (len == 0) {
     Release();
+    return;
   }
   Chunk* new_last_chunk = first_;
   size_t len_from_chunk_start = len;
@@ -91,11 +112,10 @@ void MultiBuf::PushPrefix(MultiBuf&& front) {
 
 void MultiBuf::PushSuffix(MultiBuf&& tail) {
   if (first_ == nullptr) {
-    first_ = tail.first_;
-    tail.first_ = nullptr;
+    *this = std::move(tail);
     return;
   }
-  Chunks().back().next_in_buf_ = tail.first_;
+  ChunkIterable(first_).back().next_in_buf_ = tail.first_;
   tail.first_ = nullptr;
 }
 
@@ -107,7 +127,7 @@ std::optional<MultiBuf> MultiBuf::TakePrefix(size_t bytes_to_take) {
   }
   // Pointer to the last element of `front`, allowing constant-time appending.
   Chunk* last_front_chunk = nullptr;
-  while (bytes_to_take > ChunkBegin()->size()) {
+  while (bytes_to_take > first_->size()) {
     OwnedChunk new_chunk = TakeFrontChunk().Take();
     Chunk* new_chunk_ptr = &*new_chunk;
     bytes_to_take -= new_chunk.size();
@@ -173,7 +193,7 @@ MultiBuf::ChunkIterator MultiBuf::InsertChunk(ChunkIterator position,
                                               OwnedChunk&& chunk) {
   // Note: this also catches the cases where ``first_ == nullptr``
   PW_DCHECK(chunk->next_in_buf_ == nullptr);
-  if (position == ChunkBegin()) {
+  if (position.chunk_ == first_) {
     PushFrontChunk(std::move(chunk));
     return ChunkIterator(first_);
   }
@@ -195,7 +215,7 @@ OwnedChunk MultiBuf::TakeFrontChunk() {
 std::tuple<MultiBuf::ChunkIterator, OwnedChunk> MultiBuf::TakeChunk(
     ChunkIterator position) {
   Chunk* chunk = position.chunk_;
-  if (position == ChunkBegin()) {
+  if (chunk == first_) {
     OwnedChunk old_first = TakeFrontChunk();
     return std::make_tuple(ChunkIterator(first_), std::move(old_first));
   }
@@ -206,6 +226,28 @@ std::tuple<MultiBuf::ChunkIterator, OwnedChunk> MultiBuf::TakeChunk(
                          OwnedChunk(chunk));
 }
 
+size_t MultiBuf::GetChunkSpans(span<ConstByteSpan> spans) const {
+  size_t count = 0;
+  for (Chunk* chunk = first_; chunk != nullptr && count < spans.size();
+       chunk = chunk->next_in_buf_) {
+    if (chunk->size() != 0) {
+      spans[count++] = ConstByteSpan(chunk->data(), chunk->size());
+    }
+  }
+  return count;
+}
+
+size_t MultiBuf::GetChunkSpans(span<ByteSpan> spans) {
+  size_t count = 0;
+  for (Chunk* chunk = first_; chunk != nullptr && count < spans.size();
+       chunk = chunk->next_in_buf_) {
+    if (chunk->size() != 0) {
+      spans[count++] = ByteSpan(chunk->data(), chunk->size());
+    }
+  }
+  return count;
+}
+
 Chunk* MultiBuf::Previous(Chunk* chunk) const {
   Chunk* previous = first_;
   while (previous != nullptr && previous->next_in_buf_ != chunk) {
@@ -14,6 +14,9 @@
 
 #include "pw_multibuf/multibuf.h"
 
+#include <array>
+#include <utility>
+
 #include "pw_allocator/testing.h"
 #include "pw_assert/check.h"
 #include "pw_bytes/suffix.h"
@@ -131,6 +134,52 @@ TEST(MultiBuf, SizeReturnsNumberOfBytes) {
   EXPECT_EQ(buf.size(), kArbitraryChunkSize * 2);
 }
 
+TEST(MultiBuf, SizeTracksChunksResizedInPlace) {
+  AllocatorForTest<kArbitraryAllocatorSize> allocator;
+  MultiBuf buf;
+  buf.PushBackChunk(MakeChunk(&allocator, {1_b, 2_b, 3_b}));
+  buf.PushBackChunk(MakeChunk(&allocator, {4_b, 5_b, 6_b}));
+  EXPECT_EQ(buf.size(), 6U);
+  for (Chunk& chunk : buf.Chunks()) {
+    chunk.Truncate(1);
+  }
+  EXPECT_EQ(buf.size(), 2U);
+  buf.DiscardPrefix(1);
+  EXPECT_EQ(buf.size(), 1U);
+}
+
+TEST(MultiBuf, SizeTracksChunksResizedThroughEarlierReferences) {
+  AllocatorForTest<kArbitraryAllocatorSize> allocator;
+  MultiBuf buf;
+  buf.PushBackChunk(MakeChunk(&allocator, {1_b, 2_b, 3_b}));
+  buf.PushBackChunk(MakeChunk(&allocator, {4_b, 5_b, 6_b}));
+  Chunk& first = *buf.ChunkBegin();
+  Chunk& last = buf.Chunks().back();
+  EXPECT_EQ(buf.size(), 6U);
+
+  first.DiscardPrefix(1);
+  EXPECT_EQ(buf.size(), 5U);
+  last.Truncate(1);
+  EXPECT_EQ(buf.size(), 3U);
+  EXPECT_TRUE(first.ClaimPrefix(1));
+  EXPECT_EQ(buf.size(), 4U);
+  first.Slice(1, 2);
+  EXPECT_EQ(buf.size(), 2U);
+}
+
+TEST(MultiBuf, SeekReturnsIteratorAtOffset) {
+  AllocatorForTest<kArbitraryAllocatorSize> allocator;
+  MultiBuf buf;
+  buf.PushBackChunk(MakeChunk(&allocator, {1_b, 2_b, 3_b}));
+  buf.PushBackChunk(MakeChunk(&allocator, 0));
+  buf.PushBackChunk(MakeChunk(&allocator, {4_b, 5_b, 6_b}));
+  EXPECT_EQ(*buf.Seek(0), 1_b);
+  EXPECT_EQ(*buf.Seek(3), 4_b);
+  EXPECT_EQ(*std::as_const(buf).Seek(5), 6_b);
+  EXPECT_EQ(buf.Seek(6), buf.end());
+  EXPECT_EQ(buf.Seek(2) + 1, buf.Seek(3));
+}
+
 TEST(MultiBuf, ClaimPrefixReclaimsFirstChunkPrefix) {
   AllocatorForTest<kArbitraryAllocatorSize> allocator;
   MultiBuf buf;
@@ -244,6 +293,15 @@ TEST(MultiBuf, SliceDoesNotModifyChunkMemory) {
   ExpectElementsEqual(span, kBytes);
 }
 
+TEST(MultiBuf, TruncateToZeroReleasesChunks) {
+  AllocatorForTest<kArbitraryAllocatorSize> allocator;
+  MultiBuf buf;
+  buf.PushBackChunk(MakeChunk(&allocator, {1_b, 2_b, 3_b}));
+  buf.Truncate(0);
+  EXPECT_EQ(buf.size(), 0U);
+  EXPECT_EQ(buf.Chunks().size(), 0U);
+}
+
 TEST(MultiBuf, TruncateRemovesWholeAndPartialChunks) {
   AllocatorForTest<kArbitraryAllocatorSize> allocator;
   MultiBuf buf;
@@ -410,6 +468,31 @@ TEST(MultiBuf, RangeBasedForLoopsCompile) {
   }
 }
 
+TEST(MultiBuf, GetChunkSpansSkipsEmptyChunks) {
+  AllocatorForTest<kArbitraryAllocatorSize> allocator;
+  MultiBuf buf;
+  buf.PushBackChunk(MakeChunk(&allocator, {1_b, 2_b, 3_b}));
+  buf.PushBackChunk(MakeChunk(&allocator, 0));
+  buf.PushBackChunk(MakeChunk(&allocator, {4_b, 5_b}));
+
+  std::array<ConstByteSpan, 4> spans;
+  ASSERT_EQ(std::as_const(buf).GetChunkSpans(spans), 2U);
+  ExpectElementsEqual(spans[0], {1_b, 2_b, 3_b});
+  ExpectElementsEqual(spans[1], {4_b, 5_b});
+}
+
+TEST(MultiBuf, GetChunkSpansStopsWhenFull) {
+  AllocatorForTest<kArbitraryAllocatorSize> allocator;
+  MultiBuf buf;
+  buf.PushBackChunk(MakeChunk(&allocator, {1_b, 2_b, 3_b}));
+  buf.PushBackChunk(MakeChunk(&allocator, {4_b, 5_b}));
+
+  std::array<ByteSpan, 1> spans;
+  ASSERT_EQ(buf.GetChunkSpans(spans), 1U);
+  spans[0][0] = 7_b;
+  ExpectElementsEqual(buf, {7_b, 2_b, 3_b, 4_b, 5_b});
+}
+
 TEST(MultiBuf, IteratorAdvancesNAcrossChunks) {
   AllocatorForTest<kArbitraryAllocatorSize> allocator;
   MultiBuf buf;
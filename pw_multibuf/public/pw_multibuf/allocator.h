@@ -27,6 +27,28 @@ class AllocationWaiter;
 
 class MultiBufAllocationFuture;
 
+/// Space to leave unused around the payload of an allocated ``MultiBuf``.
+///
+/// Protocol layers that add headers or trailers can later grow the buffer into
+/// this space with ``MultiBuf::ClaimPrefix`` and ``MultiBuf::ClaimSuffix``,
+/// without allocating new chunks or copying the payload.
+struct Reservation {
+  /// Number of bytes to reserve before the payload, in the first ``Chunk``.
+  size_t headroom = 0;
+
+  /// Number of bytes to reserve after the payload, in the last ``Chunk``.
+  size_t tailroom = 0;
+
+  /// Returns the total number of reserved bytes.
+  constexpr size_t size() const { return headroom + tailroom; }
+};
+
+/// Combines the reservations of two layers.
+constexpr Reservation operator+(const Reservation& lhs,
+                                const Reservation& rhs) {
+  return Reservation{lhs.headroom + rhs.headroom, lhs.tailroom + rhs.tailroom};
+}
+
 /// Interface for allocating ``MultiBuf`` objects.
 ///
 /// A ``MultiBufAllocator`` differs from a regular ``pw::allocator::Allocator``
@@ -39,6 +61,10 @@ class MultiBufAllocationFuture;
 /// In order to accomplish this, they return ``MultiBuf`` objects rather than
 /// arbitrary pieces of memory.
 ///
+/// Every allocation method accepts an optional ``Reservation``. The reserved
+/// bytes are allocated in addition to the requested size, but are excluded
+/// from the returned ``MultiBuf`` until claimed.
+///
 /// Additionally, ``MultiBufAllocator`` implementations may choose to store
 /// their allocation metadata separately from the data itself. This allows for
 /// things like allocation headers to be kept out of restricted DMA-capable or
@@ -70,7 +96,7 @@ class MultiBufAllocator {
   ///
   /// @retval ``MultiBuf`` if the allocation was successful.
   /// @retval ``nullopt_t`` if the memory is not currently available.
-  std::optional<MultiBuf> Allocate(size_t size);
+  std::optional<MultiBuf> Allocate(size_t size, Reservation reservation = {});
 
   /// Attempts to allocate a ``MultiBuf`` of at least ``min_size`` bytes and at
   /// most ``desired_size`` bytes.
@@ -82,7 +108,9 @@ class MultiBufAllocator {
   ///
   /// @retval ``MultiBuf`` if the allocation was successful.
   /// @retval ``nullopt_t`` if the memory is not currently available.
-  std::optional<MultiBuf> Allocate(size_t min_size, size_t desired_size);
+  std::optional<MultiBuf> Allocate(size_t min_size,
+                                   size_t desired_size,
+                                   Reservation reservation = {});
 
   /// Attempts to allocate a contiguous ``MultiBuf`` of exactly ``size``
   /// bytes.
@@ -95,7 +123,8 @@ class MultiBufAllocator {
   /// @retval ``MultiBuf`` with a single ``Chunk`` if the allocation was
   /// successful.
   /// @retval ``nullopt_t`` if the memory is not currently available.
-  std::optional<MultiBuf> AllocateContiguous(size_t size);
+  std::optional<MultiBuf> AllocateContiguous(size_t size,
+                                             Reservation reservation = {});
 
   /// Attempts to allocate a contiguous ``MultiBuf`` of at least ``min_size``
   /// bytes and at most ``desired_size`` bytes.
@@ -109,7 +138,8 @@ class MultiBufAllocator {
   /// successful.
   /// @retval ``nullopt_t`` if the memory is not currently available.
   std::optional<MultiBuf> AllocateContiguous(size_t min_size,
-                                             size_t desired_size);
+                                             size_t desired_size,
+                                             Reservation reservation = {});
 
   /////////////////
   // -- Async -- //
@@ -124,7 +154,8 @@ class MultiBufAllocator {
   ///
   /// @retval A ``MultiBufAllocationFuture`` which will yield a ``MultiBuf``
   /// when one is available.
-  MultiBufAllocationFuture AllocateAsync(size_t size);
+  MultiBufAllocationFuture AllocateAsync(size_t size,
+                                         Reservation reservation = {});
 
   /// Asynchronously allocates a ``MultiBuf`` of at least
   /// ``min_size`` bytes and at most ``desired_size` bytes.
@@ -136,7 +167,9 @@ class MultiBufAllocator {
   ///
   /// @retval A ``MultiBufAllocationFuture`` which will yield a ``MultiBuf``
   /// when one is available.
-  MultiBufAllocationFuture AllocateAsync(size_t min_size, size_t desired_size);
+  MultiBufAllocationFuture AllocateAsync(size_t min_size,
+                                         size_t desired_size,
+                                         Reservation reservation = {});
 
   /// Asynchronously allocates a contiguous ``MultiBuf`` of exactly ``size``
   /// bytes.
@@ -148,15 +181,16 @@ class MultiBufAllocator {
   ///
   /// @retval A ``MultiBufAllocationFuture`` which will yield an ``MultiBuf``
   /// consisting of a single ``Chunk`` when one is available.
-  MultiBufAllocationFuture AllocateContiguousAsync(size_t size);
+  MultiBufAllocationFuture AllocateContiguousAsync(
+      size_t size, Reservation reservation = {});
 
   /// Asynchronously allocates an ``OwnedChunk`` of at least
   /// ``min_size`` bytes and at most ``desired_size`` bytes.
   ///
   /// @retval A ``MultiBufAllocationFuture`` which will yield an ``MultiBuf``
   /// consisting of a single ``Chunk`` when one is available.
-  MultiBufAllocationFuture AllocateContiguousAsync(size_t min_size,
-                                                   size_t desired_size);
+  MultiBufAllocationFuture AllocateContiguousAsync(
+      size_t min_size, size_t desired_size, Reservation reservation = {});
 
  protected:
   /// Awakens callers asynchronously waiting for allocations of at most
@@ -165,6 +199,10 @@ class MultiBufAllocator {
   ///
   /// This function should be invoked by implementations of
   /// ``MultiBufAllocator`` when more memory becomes available to allocate.
+  ///
+  /// Waiters are awoken in the order in which they started waiting. Since
+  /// ``pw::async2`` dispatchers run woken tasks in the order they were woken,
+  /// the longest-waiting task gets the first chance to allocate.
   void MoreMemoryAvailable(size_t size_available,
                            size_t contiguous_size_available);
 
@@ -175,6 +213,12 @@ class MultiBufAllocator {
   /// Attempts to allocate a ``MultiBuf`` of at least ``min_size`` bytes and at
   /// most ``desired_size`` bytes.
   ///
+  /// The returned ``MultiBuf`` holds only the payload. Its first ``Chunk``
+  /// must have room for ``reservation.headroom`` bytes before its data, and
+  /// its last ``Chunk`` must have room for ``reservation.tailroom`` bytes after
+  /// its data, so that they can be claimed with ``ClaimPrefix`` and
+  /// ``ClaimSuffix``.
+  ///
   /// @retval Ok(buffer) if the allocation was successful.
   /// @retval @pw_status{RESOURCE_EXHAUSTED} if insufficient memory is available
   /// currently.
@@ -185,7 +229,8 @@ class MultiBufAllocator {
   ///     failing immediately on OOM).
   virtual pw::Result<MultiBuf> DoAllocate(size_t min_size,
                                           size_t desired_size,
-                                          bool needs_contiguous) = 0;
+                                          bool needs_contiguous,
+                                          Reservation reservation) = 0;
 
   void AddWaiter(internal::AllocationWaiter*) PW_LOCKS_EXCLUDED(lock_);
   void AddWaiterLocked(internal::AllocationWaiter*)
@@ -196,6 +241,7 @@ class MultiBufAllocator {
 
   sync::Mutex lock_;
   internal::AllocationWaiter* first_waiter_ PW_GUARDED_BY(lock_) = nullptr;
+  internal::AllocationWaiter* last_waiter_ PW_GUARDED_BY(lock_) = nullptr;
 };
 
 namespace internal {
@@ -220,13 +266,15 @@ class AllocationWaiter {
   AllocationWaiter(MultiBufAllocator& allocator,
                    size_t min_size,
                    size_t desired_size,
-                   bool needs_contiguous)
+                   bool needs_contiguous,
+                   Reservation reservation = {})
       : allocator_(&allocator),
         waker_(),
         next_(nullptr),
         min_size_(min_size),
         desired_size_(desired_size),
-        needs_contiguous_(needs_contiguous) {}
+        needs_contiguous_(needs_contiguous),
+        reservation_(reservation) {}
 
   AllocationWaiter(AllocationWaiter&&);
   AllocationWaiter& operator=(AllocationWaiter&&);
@@ -259,6 +307,9 @@ class AllocationWaiter {
   /// sections of memory only.
   size_t needs_contiguous() const { return needs_contiguous_; }
 
+  /// Returns the space to reserve around the allocated payload.
+  Reservation reservation() const { return reservation_; }
+
  private:
   friend class ::pw::multibuf::MultiBufAllocator;
 
@@ -288,6 +339,7 @@ class AllocationWaiter {
   size_t min_size_;
   size_t desired_size_;
   bool needs_contiguous_;
+  Reservation reservation_;
 };
 
 }  // namespace internal
@@ -301,8 +353,13 @@ class MultiBufAllocationFuture {
   MultiBufAllocationFuture(MultiBufAllocator& allocator,
                            size_t min_size,
                            size_t desired_size,
-                           bool needs_contiguous)
-      : waiter_(allocator, min_size, desired_size, needs_contiguous) {}
+                           bool needs_contiguous,
+                           Reservation reservation = {})
+      : waiter_(allocator,
+                min_size,
+                desired_size,
+                needs_contiguous,
+                reservation) {}
   async2::Poll<std::optional<MultiBuf>> Pend(async2::Context& cx);
 
  private:
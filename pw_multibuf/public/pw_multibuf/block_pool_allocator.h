@@ -0,0 +1,123 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_allocator/allocator.h"
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::multibuf {
+
+class BlockPoolAllocator;
+
+namespace internal {
+
+/// A ``ChunkRegionTracker`` for a single block of a ``BlockPoolAllocator``.
+class PoolBlockTracker final : public ChunkRegionTracker {
+ public:
+  PoolBlockTracker(BlockPoolAllocator& parent, ByteSpan region)
+      : parent_(parent), region_(region) {}
+  ~PoolBlockTracker() final = default;
+
+  // PoolBlockTracker is not copyable nor movable.
+  PoolBlockTracker(const PoolBlockTracker&) = delete;
+  PoolBlockTracker& operator=(const PoolBlockTracker&) = delete;
+  PoolBlockTracker(PoolBlockTracker&&) = delete;
+  PoolBlockTracker& operator=(PoolBlockTracker&&) = delete;
+
+ protected:
+  void Destroy() final;
+  ByteSpan Region() const final { return region_; }
+  void* AllocateChunkClass() final;
+  void DeallocateChunkClass(void*) final;
+
+ private:
+  BlockPoolAllocator& parent_;
+  const ByteSpan region_;
+};
+
+}  // namespace internal
+
+/// A ``MultiBufAllocator`` that divides its data area into fixed-size blocks.
+///
+/// Each allocation is made up of one ``Chunk`` per block, so allocating is
+/// ``O(Chunks().size())`` and never has to search for space. Since every block
+/// is interchangeable, the data area never fragments: any request for at most
+/// ``num_free_blocks() * block_size()`` bytes succeeds.
+///
+/// Contiguous allocations are limited to a single block.
+///
+/// Blocks are returned to the pool when all of the ``Chunk`` s referencing
+/// them are released. Each return wakes any ``MultiBufAllocationFuture`` s
+/// that may now succeed, in the order in which they started waiting.
+class BlockPoolAllocator final : public MultiBufAllocator {
+ public:
+  /// Creates a new ``BlockPoolAllocator``.
+  ///
+  /// @param[in] data_area         The region to use for storing chunk memory.
+  ///  Any trailing bytes that do not fill a whole block are unused.
+  ///
+  /// @param[in] block_size        The size of each block. This must be at
+  ///  least ``sizeof(void*)``, since free blocks store a pointer to the next
+  ///  free block.
+  ///
+  /// @param[in] metadata_alloc    The allocator to use for the block trackers
+  ///  and ``Chunk`` objects. As with ``SimpleAllocator``, this allocator
+  ///  *must* be thread-safe if the resulting buffers may travel to another
+  ///  thread. Since all of its allocations have one of two fixed sizes,
+  ///  allocators such as ``pw::allocator::ChunkPool`` are a good fit.
+  BlockPoolAllocator(ByteSpan data_area,
+                     size_t block_size,
+                     pw::allocator::Allocator& metadata_alloc);
+  ~BlockPoolAllocator() final = default;
+
+  /// Returns the size of each block.
+  size_t block_size() const { return block_size_; }
+
+  /// Returns the total number of blocks.
+  size_t num_blocks() const { return num_blocks_; }
+
+  /// Returns the number of blocks not referenced by any ``Chunk``.
+  size_t num_free_blocks() PW_LOCKS_EXCLUDED(lock_);
+
+ private:
+  pw::Result<MultiBuf> DoAllocate(size_t min_size,
+                                  size_t desired_size,
+                                  bool needs_contiguous,
+                                  Reservation reservation) final;
+
+  /// Returns the number of blocks needed to hold ``size`` bytes of payload and
+  /// ``reservation``, assuming each of its parts fits in a single block.
+  size_t NumBlocksFor(size_t size, Reservation reservation) const;
+
+  /// Removes a block from the free list and wraps it in a ``Chunk``.
+  pw::Result<OwnedChunk> AllocateBlock() PW_LOCKS_EXCLUDED(lock_);
+
+  /// Returns a block to the free list.
+  void FreeBlock(std::byte* block) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  pw::sync::Mutex lock_;
+  std::byte* free_list_ PW_GUARDED_BY(lock_) = nullptr;
+  size_t num_free_blocks_ PW_GUARDED_BY(lock_) = 0;
+  pw::allocator::Allocator& metadata_alloc_;
+  const size_t block_size_;
+  const size_t num_blocks_;
+
+  friend class internal::PoolBlockTracker;
+};
+
+}  // namespace pw::multibuf
@@ -74,6 +74,17 @@ class MultiBuf {
   /// This method's complexity is ``O(Chunks().size())``.
   [[nodiscard]] size_t size() const;
 
+  /// Returns an iterator pointing to the byte at ``offset``, or ``end()`` if
+  /// ``offset`` equals ``size()``.
+  ///
+  /// Unlike advancing an iterator byte by byte, this skips over whole
+  /// ``Chunk`` s and is ``O(Chunks().size())``.
+  iterator Seek(size_t offset);
+
+  /// Returns a const iterator pointing to the byte at ``offset``, or ``end()``
+  /// if ``offset`` equals ``size()``.
+  const_iterator Seek(size_t offset) const;
+
   /// Returns an iterator pointing to the first byte of this ``MultiBuf`.
   iterator begin() { return iterator(first_, 0); }
   /// Returns a const iterator pointing to the first byte of this ``MultiBuf`.
@@ -213,6 +224,21 @@ class MultiBuf {
   /// this ``MultiBuf``.
   constexpr const ChunkIterable Chunks() const { return ChunkIterable(first_); }
 
+  /// Fills ``spans`` with views of the non-empty ``Chunk`` s in this
+  /// ``MultiBuf``, in order, and returns the number of spans filled.
+  ///
+  /// This allows the contents of a ``MultiBuf`` to be passed to vectored I/O,
+  /// e.g. ``pw::stream::SocketStream::WriteV``, without first copying them
+  /// into a contiguous buffer. If there are more non-empty ``Chunk`` s than
+  /// ``spans`` can hold, only the first ``spans.size()`` are returned.
+  size_t GetChunkSpans(span<ConstByteSpan> spans) const;
+
+  /// Fills ``spans`` with writable views of the non-empty ``Chunk`` s in this
+  /// ``MultiBuf``, e.g. for ``pw::stream::SocketStream::ReadV``.
+  ///
+  /// See ``GetChunkSpans(span<ConstByteSpan>)``.
+  size_t GetChunkSpans(span<ByteSpan> spans);
+
   /// Returns an iterator pointing to the first ``Chunk`` in this ``MultiBuf``.
   constexpr ChunkIterator ChunkBegin() { return ChunkIterator(first_); }
   /// Returns an iterator pointing to the end of the ``Chunk``s in this
@@ -73,7 +73,12 @@ class SimpleAllocator final : public MultiBufAllocator {
  private:
   pw::Result<MultiBuf> DoAllocate(size_t min_size,
                                   size_t desired_size,
-                                  bool needs_contiguous) final;
+                                  bool needs_contiguous,
+                                  Reservation reservation) final;
+
+  /// Shrinks the first and last chunks of a freshly allocated ``buf`` so that
+  /// the bytes of ``reservation`` lie outside of them, within their regions.
+  static void SetAsideReservation(MultiBuf& buf, Reservation reservation);
 
   /// Allocates a contiguous buffer of exactly ``size`` bytes.
   pw::Result<MultiBuf> InternalAllocateContiguous(size_t size)
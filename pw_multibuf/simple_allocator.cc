@@ -58,8 +58,9 @@ void LinkedRegionTracker::DeallocateChunkClass(void* ptr) {
 
 pw::Result<MultiBuf> SimpleAllocator::DoAllocate(size_t min_size,
                                                  size_t desired_size,
-                                                 bool needs_contiguous) {
-  if (min_size > data_area_.size()) {
+                                                 bool needs_contiguous,
+                                                 Reservation reservation) {
+  if (min_size + reservation.size() > data_area_.size()) {
     return Status::OutOfRange();
   }
   // NB: std::lock_guard is not used here in order to release the lock
@@ -68,37 +69,61 @@ pw::Result<MultiBuf> SimpleAllocator::DoAllocate(size_t min_size,
   auto available_memory_size = GetAvailableMemorySize();
   size_t available = needs_contiguous ? available_memory_size.contiguous
                                       : available_memory_size.total;
-  if (available < min_size) {
+  if (available < min_size + reservation.size()) {
     lock_.unlock();
     return Status::ResourceExhausted();
   }
-  size_t goal_size = std::min(desired_size, available);
+  size_t goal_size = std::min(desired_size, available - reservation.size());
   if (needs_contiguous) {
-    auto out = InternalAllocateContiguous(goal_size);
+    auto out = InternalAllocateContiguous(goal_size + reservation.size());
     lock_.unlock();
+    if (out.ok()) {
+      SetAsideReservation(*out, reservation);
+    }
     return out;
   }
 
+  // Free blocks are visited front to back and each new chunk is pushed to the
+  // front, so the first block used holds the tailroom and the last block used
+  // holds the headroom. Blocks too small to hold what is left of the
+  // reservation are skipped rather than splitting it across chunks.
   MultiBuf buf;
   Status status;
-  size_t remaining_goal = goal_size;
-  ForEachFreeBlock(
-      [this, &buf, &status, remaining_goal](const FreeBlock& block)
-          PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) mutable {
-            if (remaining_goal == 0) {
-              return ControlFlow::Break;
-            }
-            size_t chunk_size = std::min(block.span.size(), remaining_goal);
-            pw::Result<OwnedChunk> chunk = InsertRegion(
-                {block.iter, ByteSpan(block.span.data(), chunk_size)});
-            if (!chunk.ok()) {
-              status = chunk.status();
-              return ControlFlow::Break;
-            }
-            remaining_goal -= chunk->size();
-            buf.PushFrontChunk(std::move(*chunk));
-            return ControlFlow::Continue;
-          });
+  size_t remaining = goal_size + reservation.headroom;
+  size_t tailroom = reservation.tailroom;
+  size_t headroom = reservation.headroom;
+  ForEachFreeBlock([this, &buf, &status, &remaining, &tailroom, headroom](
+                       const FreeBlock& block)
+                       PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+                         if (remaining == 0 && tailroom == 0) {
+                           return ControlFlow::Break;
+                         }
+                         size_t chunk_size;
+                         if (block.span.size() >= remaining + tailroom) {
+                           chunk_size = remaining + tailroom;
+                         } else if (remaining > headroom &&
+                                    block.span.size() > tailroom) {
+                           chunk_size = std::min(block.span.size(),
+                                                 remaining - headroom +
+                                                     tailroom);
+                         } else {
+                           return ControlFlow::Continue;
+                         }
+                         pw::Result<OwnedChunk> chunk = InsertRegion(
+                             {block.iter,
+                              ByteSpan(block.span.data(), chunk_size)});
+                         if (!chunk.ok()) {
+                           status = chunk.status();
+                           return ControlFlow::Break;
+                         }
+                         remaining -= chunk_size - tailroom;
+                         tailroom = 0;
+                         buf.PushFrontChunk(std::move(*chunk));
+                         return ControlFlow::Continue;
+                       });
+  if (status.ok() && (remaining != 0 || tailroom != 0)) {
+    status = Status::ResourceExhausted();
+  }
   // Lock must be released prior to possibly free'ing the `buf` in the case
   // where `!status.ok()`. This is necessary so that the destructing chunks
   // can free their regions.
@@ -106,9 +131,21 @@ pw::Result<MultiBuf> SimpleAllocator::DoAllocate(size_t min_size,
   if (!status.ok()) {
     return status;
   }
+  SetAsideReservation(buf, reservation);
   return buf;
 }
 
+void SimpleAllocator::SetAsideReservation(MultiBuf& buf,
+                                         Reservation reservation) {
+  if (reservation.size() == 0) {
+    return;
+  }
+  MultiBuf::ChunkIterable chunks = buf.Chunks();
+  chunks.front().DiscardPrefix(reservation.headroom);
+  Chunk& last = chunks.back();
+  last.Truncate(last.size() - reservation.tailroom);
+}
+
 pw::Result<MultiBuf> SimpleAllocator::InternalAllocateContiguous(size_t size) {
   pw::Result<MultiBuf> buf = Status::ResourceExhausted();
   ForEachFreeBlock([this, &buf, size](const FreeBlock& block)
@@ -126,6 +126,55 @@ TEST(SimpleAllocator, AllocateSkipsMiddleAllocations) {
   EXPECT_EQ(split->Chunks().size(), 2U);
 }
 
+TEST(SimpleAllocator, AllocateContiguousWithReservationCanClaimIt) {
+  std::array<std::byte, kArbitraryBufferSize> data_area;
+  AllocatorForTest<kArbitraryMetaSize> meta_alloc;
+  SimpleAllocator simple_allocator(data_area, meta_alloc);
+  std::optional<MultiBuf> buf =
+      simple_allocator.AllocateContiguous(32, Reservation{8, 4});
+  ASSERT_TRUE(buf.has_value());
+  EXPECT_EQ(buf->size(), 32U);
+  EXPECT_TRUE(buf->ClaimPrefix(8));
+  EXPECT_FALSE(buf->ClaimPrefix(1));
+  EXPECT_TRUE(buf->ClaimSuffix(4));
+  EXPECT_FALSE(buf->ClaimSuffix(1));
+  EXPECT_EQ(buf->size(), 44U);
+}
+
+TEST(SimpleAllocator, AllocateWithReservationTooLargeFails) {
+  std::array<std::byte, kArbitraryBufferSize> data_area;
+  AllocatorForTest<kArbitraryMetaSize> meta_alloc;
+  SimpleAllocator simple_allocator(data_area, meta_alloc);
+  EXPECT_FALSE(simple_allocator
+                   .Allocate(kArbitraryBufferSize, Reservation{1, 0})
+                   .has_value());
+}
+
+TEST(SimpleAllocator, AllocateWithReservationAcrossFreeBlocksCanClaimIt) {
+  std::array<std::byte, kArbitraryBufferSize> data_area;
+  AllocatorForTest<kArbitraryMetaSize> meta_alloc;
+  SimpleAllocator simple_allocator(data_area, meta_alloc);
+  const size_t alloc_size = kArbitraryBufferSize / 4;
+  std::optional<MultiBuf> buf1 = simple_allocator.Allocate(alloc_size);
+  std::optional<MultiBuf> buf2 = simple_allocator.Allocate(alloc_size);
+  std::optional<MultiBuf> buf3 = simple_allocator.Allocate(alloc_size);
+  ASSERT_TRUE(buf1.has_value());
+  ASSERT_TRUE(buf2.has_value());
+  ASSERT_TRUE(buf3.has_value());
+  buf1 = std::nullopt;
+  buf3 = std::nullopt;
+
+  // The free space is split in two, and the reservation spans both halves.
+  constexpr Reservation kReservation{8, 4};
+  std::optional<MultiBuf> split = simple_allocator.Allocate(
+      alloc_size * 3 - kReservation.size(), kReservation);
+  ASSERT_TRUE(split.has_value());
+  EXPECT_EQ(split->Chunks().size(), 2U);
+  EXPECT_EQ(split->size(), alloc_size * 3 - kReservation.size());
+  EXPECT_TRUE(split->ClaimPrefix(kReservation.headroom));
+  EXPECT_TRUE(split->ClaimSuffix(kReservation.tailroom));
+}
+
 TEST(SimpleAllocator, FailedAllocationDoesNotHoldOntoChunks) {
   std::array<std::byte, kArbitraryBufferSize> data_area;
   AllocatorForTest<kArbitraryMetaSize> meta_alloc;
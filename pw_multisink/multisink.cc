@@ -13,6 +13,8 @@
 // the License.
 #include "pw_multisink/multisink.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 
 #include "pw_assert/check.h"
@@ -26,20 +28,31 @@
 
 namespace pw {
 namespace multisink {
+namespace {
+
+// The number of entries peeked at a time by PopEntries().
+constexpr size_t kMaxEntriesPerPeek = 8;
+
+}  // namespace
 
 void MultiSink::HandleEntry(ConstByteSpan entry) {
-  std::lock_guard lock(lock_);
-  const Status push_back_status = ring_buffer_.PushBack(entry, sequence_id_++);
-  PW_DCHECK_OK(push_back_status);
+  {
+    std::lock_guard lock(lock_);
+    const Status push_back_status =
+        ring_buffer_.PushBack(entry, sequence_id_++);
+    PW_DCHECK_OK(push_back_status);
+  }  // Release the lock before notifying, so listeners may read the entry.
   NotifyListeners();
 }
 
 void MultiSink::HandleDropped(uint32_t drop_count) {
-  std::lock_guard lock(lock_);
-  // Updating the sequence ID helps identify where the ingress drop happend when
-  // a drain peeks or pops.
-  sequence_id_ += drop_count;
-  total_ingress_drops_ += drop_count;
+  {
+    std::lock_guard lock(lock_);
+    // Updating the sequence ID helps identify where the ingress drop happend
+    // when a drain peeks or pops.
+    sequence_id_ += drop_count;
+    total_ingress_drops_ += drop_count;
+  }
   NotifyListeners();
 }
 
@@ -105,16 +118,120 @@ Result<ConstByteSpan> MultiSink::PeekOrPopEntry(
     return peek_status;
   }
 
+  ComputeDropCounts(drain,
+                    entry_sequence_id_out,
+                    peek_status.ok(),
+                    drain_drop_count_out,
+                    ingress_drop_count_out);
+
+  // The Peek above may have failed due to OutOfRange, now that we've set the
+  // drop count see if we should return before attempting to pop.
+  if (peek_status.IsOutOfRange()) {
+    // No more entries, update the drain.
+    drain.last_handled_sequence_id_ = entry_sequence_id_out;
+    return peek_status;
+  }
+  if (request == Request::kPop) {
+    PW_CHECK(drain.reader_.PopFront().ok());
+    drain.last_handled_sequence_id_ = entry_sequence_id_out;
+  }
+  return as_bytes(buffer.first(bytes_read));
+}
+
+StatusWithSize MultiSink::PopEntries(Drain& drain,
+                                    const Drain::EntryHandler& handler,
+                                    uint32_t& drain_drop_count_out,
+                                    uint32_t& ingress_drop_count_out,
+                                    size_t max_entries) {
+  drain_drop_count_out = 0;
+  ingress_drop_count_out = 0;
+  if (max_entries == 0) {
+    return StatusWithSize(0);
+  }
+
+  std::lock_guard lock(lock_);
+  PW_DCHECK_PTR_EQ(drain.multisink_, this);
+
+  // Entries are peeked in chunks so that the views fit on the stack.
+  std::array<Drain::EntryView, kMaxEntriesPerPeek> views;
+  size_t peeked = 0;
+  Status peek_status = drain.reader_.PeekFrontEntries(
+      span(views).first(std::min(views.size(), max_entries)), peeked);
+  if (peek_status.IsOutOfRange()) {
+    // Report any dropped entries even though the drain has caught up.
+    ComputeDropCounts(drain,
+                      sequence_id_ - 1,
+                      /*entry_available=*/false,
+                      drain_drop_count_out,
+                      ingress_drop_count_out);
+    drain.last_handled_sequence_id_ = sequence_id_ - 1;
+    return StatusWithSize::OutOfRange();
+  }
+  if (!peek_status.ok()) {
+    return StatusWithSize(peek_status, 0);
+  }
+
+  ComputeDropCounts(drain,
+                    views[0].preamble,
+                    /*entry_available=*/true,
+                    drain_drop_count_out,
+                    ingress_drop_count_out);
+
+  size_t popped = 0;
+  uint32_t next_sequence_id = views[0].preamble;
+  while (true) {
+    size_t handled = 0;
+    // Stop at a gap in sequence IDs so that the reported drop counts only
+    // apply to before the first entry.
+    while (handled < peeked && views[handled].preamble == next_sequence_id &&
+           handler(views[handled])) {
+      ++handled;
+      ++next_sequence_id;
+    }
+    if (handled == 0) {
+      break;
+    }
+
+    // The lock is still held, so the peeked entries are still at the front.
+    PW_CHECK_OK(drain.reader_.PopFrontEntries(handled));
+    drain.last_handled_sequence_id_ = next_sequence_id - 1;
+    popped += handled;
+
+    if (handled < peeked || popped == max_entries) {
+      break;
+    }
+    const size_t remaining = max_entries - popped;
+    if (!drain.reader_
+             .PeekFrontEntries(
+                 span(views).first(std::min(views.size(), remaining)), peeked)
+             .ok()) {
+      break;
+    }
+  }
+  return StatusWithSize(popped);
+}
+
+size_t MultiSink::UnreadSizeBytes(Drain& drain) {
+  std::lock_guard lock(lock_);
+  PW_DCHECK_PTR_EQ(drain.multisink_, this);
+  return drain.reader_.UnreadSizeBytes();
+}
+
+void MultiSink::ComputeDropCounts(Drain& drain,
+                                  uint32_t entry_sequence_id,
+                                  bool entry_available,
+                                  uint32_t& drain_drop_count_out,
+                                  uint32_t& ingress_drop_count_out) {
   // Compute the drop count delta by comparing this entry's sequence ID with the
   // last sequence ID this drain successfully read.
   //
   // The drop count calculation simply computes the difference between the
   // current and last sequence IDs. Consecutive successful reads will always
-  // differ by one at least, so it is subtracted out. If the read was not
-  // successful, the difference is not adjusted.
-  drain_drop_count_out = entry_sequence_id_out -
+  // differ by one at least, so it is subtracted out. If there is no entry, the
+  // difference is not adjusted.
+  drain_drop_count_out = entry_sequence_id -
                          drain.last_handled_sequence_id_ -
-                         (peek_status.ok() ? 1 : 0);
+                         (entry_available ? 1 : 0);
 
   // Only report the ingress drop count when the drain catches up to where the
   // drop happened, accounting only for the drops found and no more, as
@@ -131,19 +248,6 @@ Result<ConstByteSpan> MultiSink::PeekOrPopEntry(
             ? total_ingress_drops_ - ingress_drop_count_out
             : total_ingress_drops_;
   }
-
-  // The Peek above may have failed due to OutOfRange, now that we've set the
-  // drop count see if we should return before attempting to pop.
-  if (peek_status.IsOutOfRange()) {
-    // No more entries, update the drain.
-    drain.last_handled_sequence_id_ = entry_sequence_id_out;
-    return peek_status;
-  }
-  if (request == Request::kPop) {
-    PW_CHECK(drain.reader_.PopFront().ok());
-    drain.last_handled_sequence_id_ = entry_sequence_id_out;
-  }
-  return as_bytes(buffer.first(bytes_read));
 }
 
 void MultiSink::AttachDrain(Drain& drain) {
@@ -171,25 +275,36 @@ void MultiSink::DetachDrain(Drain& drain) {
 }
 
 void MultiSink::AttachListener(Listener& listener) {
-  std::lock_guard lock(lock_);
+  std::lock_guard lock(listener_lock_);
   listeners_.push_back(listener);
   // Notify the newly added entry, in case there are items in the sink.
+  listener.notified_ = listener.coalesce_notifications_;
   listener.OnNewEntryAvailable();
 }
 
 void MultiSink::DetachListener(Listener& listener) {
-  std::lock_guard lock(lock_);
+  std::lock_guard lock(listener_lock_);
   [[maybe_unused]] bool was_detached = listeners_.remove(listener);
   PW_DCHECK(was_detached, "The listener was already attached.");
 }
 
+void MultiSink::ResumeNotifications(Listener& listener) {
+  std::lock_guard lock(listener_lock_);
+  listener.notified_ = false;
+}
+
 void MultiSink::Clear() {
   std::lock_guard lock(lock_);
   ring_buffer_.Clear();
 }
 
 void MultiSink::NotifyListeners() {
+  std::lock_guard lock(listener_lock_);
   for (auto& listener : listeners_) {
+    if (listener.notified_) {
+      continue;  // Coalesce until the listener resumes notifications.
+    }
+    listener.notified_ = listener.coalesce_notifications_;
     listener.OnNewEntryAvailable();
   }
 }
@@ -228,6 +343,23 @@ Status MultiSink::Drain::PopEntry(const PeekedEntry& entry) {
   return multisink_->PopEntry(*this, entry);
 }
 
+StatusWithSize MultiSink::Drain::PopEntries(const EntryHandler& handler,
+                                           uint32_t& drain_drop_count_out,
+                                           uint32_t& ingress_drop_count_out,
+                                           size_t max_entries) {
+  PW_DCHECK_NOTNULL(multisink_);
+  return multisink_->PopEntries(*this,
+                                handler,
+                                drain_drop_count_out,
+                                ingress_drop_count_out,
+                                max_entries);
+}
+
+size_t MultiSink::Drain::UnreadSizeBytes() {
+  PW_DCHECK_NOTNULL(multisink_);
+  return multisink_->UnreadSizeBytes(*this);
+}
+
 Result<MultiSink::Drain::PeekedEntry> MultiSink::Drain::PeekEntry(
     ByteSpan buffer,
     uint32_t& drain_drop_count_out,
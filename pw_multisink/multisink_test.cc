@@ -23,6 +23,7 @@
 #include "pw_function/function.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::multisink {
@@ -31,6 +32,10 @@ using Listener = MultiSink::Listener;
 
 class CountingListener : public Listener {
  public:
+  CountingListener() = default;
+  explicit CountingListener(bool coalesce_notifications)
+      : Listener(coalesce_notifications) {}
+
   void OnNewEntryAvailable() override { notification_count_++; }
 
   size_t GetNotificationCount() { return notification_count_; }
@@ -41,6 +46,11 @@ class CountingListener : public Listener {
   size_t notification_count_ = 0;
 };
 
+class CoalescingListener : public CountingListener {
+ public:
+  CoalescingListener() : CountingListener(/*coalesce_notifications=*/true) {}
+};
+
 class MultiSinkTest : public ::testing::Test {
  protected:
   static constexpr std::byte kMessage[] = {
@@ -248,6 +258,50 @@ TEST_F(MultiSinkTest, DynamicDrainRegistration) {
   VerifyPopEntry(drains_[0], std::nullopt, 0u, 0u);
 }
 
+TEST_F(MultiSinkTest, CoalescedNotifications) {
+  CoalescingListener listener;
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.AttachListener(listener);
+  multisink_.AttachListener(listeners_[0]);
+  ExpectNotificationCount(listener, 1u);
+  ExpectNotificationCount(listeners_[0], 1u);
+
+  // Entries are not notified until the listener resumes notifications.
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleDropped();
+  ExpectNotificationCount(listener, 0u);
+  ExpectNotificationCount(listeners_[0], 2u);
+
+  multisink_.ResumeNotifications(listener);
+  ExpectNotificationCount(listener, 0u);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleDropped();
+  ExpectNotificationCount(listener, 1u);
+  ExpectNotificationCount(listeners_[0], 3u);
+
+  VerifyPopEntry(drains_[0], kMessage, 0u, 0u);
+  VerifyPopEntry(drains_[0], kMessage, 0u, 1u);
+  VerifyPopEntry(drains_[0], kMessage, 0u, 0u);
+  VerifyPopEntry(drains_[0], std::nullopt, 0u, 1u);
+  multisink_.DetachListener(listener);
+  multisink_.DetachListener(listeners_[0]);
+}
+
+TEST_F(MultiSinkTest, CoalescedNotificationsAfterReattach) {
+  CoalescingListener listener;
+  multisink_.AttachListener(listener);
+  ExpectNotificationCount(listener, 1u);
+  multisink_.DetachListener(listener);
+
+  // Attaching notifies immediately, even if the listener had not resumed.
+  multisink_.AttachListener(listener);
+  ExpectNotificationCount(listener, 1u);
+  multisink_.HandleEntry(kMessage);
+  ExpectNotificationCount(listener, 0u);
+  multisink_.DetachListener(listener);
+}
+
 TEST_F(MultiSinkTest, TooSmallBuffer) {
   multisink_.AttachDrain(drains_[0]);
 
@@ -532,6 +586,122 @@ TEST_F(MultiSinkTest, DetachedDrainReportsDropCount) {
   VerifyPopEntry(drains_[0], kMessage, 0, ingress_drops);
 }
 
+TEST_F(MultiSinkTest, PopEntries) {
+  multisink_.AttachDrain(drains_[0]);
+
+  // Push more entries than are peeked at a time internally.
+  constexpr uint8_t kNumEntries = 20;
+  for (uint8_t i = 0; i < kNumEntries; ++i) {
+    const std::byte entry[] = {std::byte{i}, std::byte{i}};
+    multisink_.HandleEntry(entry);
+  }
+
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  uint8_t next_entry = 0;
+  StatusWithSize result = drains_[0].PopEntries(
+      [&next_entry](const Drain::EntryView& entry) {
+        EXPECT_EQ(entry.size(), 2u);
+        EXPECT_EQ(entry.first[0], std::byte{next_entry});
+        ++next_entry;
+        return true;
+      },
+      drop_count,
+      ingress_drop_count);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), kNumEntries);
+  EXPECT_EQ(next_entry, kNumEntries);
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 0u);
+
+  result = drains_[0].PopEntries(
+      [](const Drain::EntryView&) { return true; },
+      drop_count,
+      ingress_drop_count);
+  EXPECT_EQ(result.status(), Status::OutOfRange());
+  EXPECT_EQ(result.size(), 0u);
+}
+
+TEST_F(MultiSinkTest, PopEntriesStopsAtMaxEntriesAndHandler) {
+  multisink_.AttachDrain(drains_[0]);
+  for (size_t i = 0; i < 5; ++i) {
+    multisink_.HandleEntry(kMessage);
+  }
+
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  auto accept_all = [](const Drain::EntryView&) { return true; };
+  StatusWithSize result =
+      drains_[0].PopEntries(accept_all, drop_count, ingress_drop_count, 3);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), 3u);
+
+  // Entries that the handler rejects stay in the multisink.
+  result = drains_[0].PopEntries([](const Drain::EntryView&) { return false; },
+                                 drop_count,
+                                 ingress_drop_count);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), 0u);
+
+  VerifyPopEntry(drains_[0], kMessage, 0, 0);
+  VerifyPopEntry(drains_[0], kMessage, 0, 0);
+  VerifyPopEntry(drains_[0], std::nullopt, 0, 0);
+}
+
+TEST_F(MultiSinkTest, PopEntriesStopsAtDrops) {
+  multisink_.AttachDrain(drains_[0]);
+  const uint32_t ingress_drops = 10;
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleDropped(ingress_drops);
+  multisink_.HandleEntry(kMessageOther);
+
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  size_t handled = 0;
+  auto count = [&handled](const Drain::EntryView&) {
+    ++handled;
+    return true;
+  };
+
+  // The run stops at the gap in sequence IDs, so the drops are reported with
+  // the entries that follow them.
+  StatusWithSize result =
+      drains_[0].PopEntries(count, drop_count, ingress_drop_count);
+  EXPECT_EQ(result.size(), 2u);
+  EXPECT_EQ(handled, 2u);
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 0u);
+
+  result = drains_[0].PopEntries(count, drop_count, ingress_drop_count);
+  EXPECT_EQ(result.size(), 1u);
+  EXPECT_EQ(handled, 3u);
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, ingress_drops);
+
+  // Drops are reported even when no entries remain.
+  multisink_.HandleDropped(ingress_drops);
+  result = drains_[0].PopEntries(count, drop_count, ingress_drop_count);
+  EXPECT_EQ(result.status(), Status::OutOfRange());
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, ingress_drops);
+}
+
+TEST_F(MultiSinkTest, UnreadSizeBytes) {
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.AttachDrain(drains_[1]);
+  EXPECT_EQ(drains_[0].UnreadSizeBytes(), 0u);
+
+  // Each entry has a 1-byte sequence ID and a 1-byte size prefix.
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessageOther);
+  EXPECT_EQ(drains_[0].UnreadSizeBytes(), 2 * (sizeof(kMessage) + 2));
+
+  VerifyPopEntry(drains_[0], kMessage, 0, 0);
+  EXPECT_EQ(drains_[0].UnreadSizeBytes(), sizeof(kMessageOther) + 2);
+  EXPECT_EQ(drains_[1].UnreadSizeBytes(), 2 * (sizeof(kMessage) + 2));
+}
+
 TEST(UnsafeIteration, NoLimit) {
   constexpr std::array<std::string_view, 5> kExpectedEntries{
       "one", "two", "three", "four", "five"};
@@ -0,0 +1,117 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multisink/priority_multisink.h"
+
+#include <mutex>
+
+#include "pw_assert/check.h"
+#include "pw_status/status.h"
+#include "pw_varint/varint.h"
+
+namespace pw {
+namespace multisink {
+
+void PriorityMultiSink::HandleEntry(size_t lane_index, ConstByteSpan entry) {
+  PW_DCHECK_UINT_LT(lane_index, lanes_.size());
+  Lane& lane = lanes_[lane_index];
+  if (lane.drop_policy_ == DropPolicy::kDropOldest) {
+    lane.multisink_.HandleEntry(entry);
+    return;
+  }
+
+  std::lock_guard lock(lock_);
+  if (WouldEvictUnread(lane_index, entry.size())) {
+    lane.multisink_.HandleDropped();
+    return;
+  }
+  lane.multisink_.HandleEntry(entry);
+}
+
+bool PriorityMultiSink::WouldEvictUnread(size_t lane_index,
+                                         size_t entry_size_bytes) {
+  const Lane& lane = lanes_[lane_index];
+  // Each entry is prefixed by its sequence ID and size as varints. Assume the
+  // largest sequence ID, since it is not known outside the lane's lock.
+  const size_t encoded_size_bytes = varint::kMaxVarint32SizeBytes +
+                                    varint::EncodedSize(entry_size_bytes) +
+                                    entry_size_bytes;
+  for (Drain& drain : drains_) {
+    const size_t unread_bytes =
+        drain.lane_drains_[lane_index].UnreadSizeBytes();
+    if (unread_bytes + encoded_size_bytes > lane.size_bytes_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PriorityMultiSink::AttachDrain(Drain& drain) {
+  PW_DCHECK(drain.sink_ == nullptr);
+  PW_CHECK_UINT_EQ(drain.lane_drains_.size(),
+                   lanes_.size(),
+                   "A PriorityMultiSink drain needs one reader per lane");
+  std::lock_guard lock(lock_);
+  for (size_t i = 0; i < lanes_.size(); ++i) {
+    lanes_[i].multisink_.AttachDrain(drain.lane_drains_[i]);
+  }
+  drain.sink_ = this;
+  drains_.push_back(drain);
+}
+
+void PriorityMultiSink::DetachDrain(Drain& drain) {
+  PW_DCHECK(drain.sink_ == this);
+  std::lock_guard lock(lock_);
+  drains_.remove(drain);
+  for (size_t i = 0; i < lanes_.size(); ++i) {
+    lanes_[i].multisink_.DetachDrain(drain.lane_drains_[i]);
+  }
+  drain.sink_ = nullptr;
+}
+
+Result<ConstByteSpan> PriorityMultiSink::Drain::PopEntry(
+    ByteSpan buffer,
+    uint32_t& drain_drop_count_out,
+    uint32_t& ingress_drop_count_out) {
+  drain_drop_count_out = 0;
+  ingress_drop_count_out = 0;
+  if (sink_ == nullptr) {
+    return Status::FailedPrecondition();
+  }
+
+  for (MultiSink::Drain& lane_drain : lane_drains_) {
+    uint32_t drain_drop_count = 0;
+    uint32_t ingress_drop_count = 0;
+    Result<ConstByteSpan> result =
+        lane_drain.PopEntry(buffer, drain_drop_count, ingress_drop_count);
+    drain_drop_count_out += drain_drop_count;
+    ingress_drop_count_out += ingress_drop_count;
+    if (!result.status().IsOutOfRange()) {
+      return result;
+    }
+  }
+  return Status::OutOfRange();
+}
+
+size_t PriorityMultiSink::Drain::UnreadSizeBytes() {
+  PW_DCHECK_NOTNULL(sink_);
+  size_t unread_bytes = 0;
+  for (MultiSink::Drain& lane_drain : lane_drains_) {
+    unread_bytes += lane_drain.UnreadSizeBytes();
+  }
+  return unread_bytes;
+}
+
+}  // namespace multisink
+}  // namespace pw
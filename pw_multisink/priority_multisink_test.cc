@@ -0,0 +1,167 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_multisink/priority_multisink.h"
+
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::multisink {
+namespace {
+
+using DropPolicy = PriorityMultiSink::DropPolicy;
+
+ConstByteSpan AsBytes(std::string_view text) { return as_bytes(span(text)); }
+
+class PriorityMultiSinkTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kLaneSize = 64;
+
+  PriorityMultiSinkTest()
+      : error_buffer_{},
+        debug_buffer_{},
+        lanes_{{error_buffer_, DropPolicy::kDropNewest}, {debug_buffer_}},
+        sink_(lanes_) {}
+
+  // Pops an entry and expects it to equal `expected`, or expects no entry if
+  // `expected` is empty. Returns the total drop count.
+  uint32_t ExpectPop(std::string_view expected) {
+    uint32_t drain_drop_count = 0;
+    uint32_t ingress_drop_count = 0;
+    Result<ConstByteSpan> result =
+        drain_.PopEntry(entry_buffer_, drain_drop_count, ingress_drop_count);
+    if (expected.empty()) {
+      EXPECT_EQ(result.status(), Status::OutOfRange());
+    } else {
+      EXPECT_EQ(result.status(), OkStatus());
+      if (result.ok()) {
+        EXPECT_EQ(std::string_view(
+                      reinterpret_cast<const char*>(result.value().data()),
+                      result.value().size()),
+                  expected);
+      }
+    }
+    return drain_drop_count + ingress_drop_count;
+  }
+
+  std::array<std::byte, kLaneSize> error_buffer_;
+  std::array<std::byte, kLaneSize> debug_buffer_;
+  std::array<std::byte, kLaneSize> entry_buffer_;
+  PriorityMultiSink::Lane lanes_[2];
+  PriorityMultiSink sink_;
+  PriorityMultiSink::DrainWithLanes<2> drain_;
+};
+
+TEST_F(PriorityMultiSinkTest, PopsHigherPriorityLaneFirst) {
+  sink_.AttachDrain(drain_);
+  sink_.HandleEntry(1, AsBytes("debug 1"));
+  sink_.HandleEntry(0, AsBytes("error 1"));
+  sink_.HandleEntry(1, AsBytes("debug 2"));
+  sink_.HandleEntry(0, AsBytes("error 2"));
+  EXPECT_GT(drain_.UnreadSizeBytes(), 0u);
+
+  EXPECT_EQ(ExpectPop("error 1"), 0u);
+  EXPECT_EQ(ExpectPop("error 2"), 0u);
+  EXPECT_EQ(ExpectPop("debug 1"), 0u);
+  EXPECT_EQ(ExpectPop("debug 2"), 0u);
+  EXPECT_EQ(ExpectPop(""), 0u);
+  EXPECT_EQ(drain_.UnreadSizeBytes(), 0u);
+  sink_.DetachDrain(drain_);
+}
+
+TEST_F(PriorityMultiSinkTest, BurstInLowerLaneKeepsHigherLaneEntries) {
+  sink_.AttachDrain(drain_);
+  sink_.HandleEntry(0, AsBytes("error"));
+  for (int i = 0; i < 20; ++i) {
+    sink_.HandleEntry(1, AsBytes("debug burst"));
+  }
+
+  EXPECT_EQ(ExpectPop("error"), 0u);
+  // The burst evicted the oldest debug entries.
+  EXPECT_GT(ExpectPop("debug burst"), 0u);
+  sink_.DetachDrain(drain_);
+}
+
+TEST_F(PriorityMultiSinkTest, DropNewestKeepsUnreadEntries) {
+  sink_.AttachDrain(drain_);
+  sink_.HandleEntry(0, AsBytes("first error"));
+  size_t written = 1;
+  for (int i = 0; i < 20; ++i) {
+    sink_.HandleEntry(0, AsBytes("later error"));
+  }
+
+  // The first entries written are all kept, and the rejected entries are
+  // reported as drops after them.
+  EXPECT_EQ(ExpectPop("first error"), 0u);
+  uint32_t drain_drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  Result<ConstByteSpan> result = Status::OutOfRange();
+  while ((result = drain_.PopEntry(
+              entry_buffer_, drain_drop_count, ingress_drop_count))
+             .ok()) {
+    EXPECT_EQ(drain_drop_count, 0u);
+    EXPECT_EQ(ingress_drop_count, 0u);
+    ++written;
+  }
+  EXPECT_EQ(result.status(), Status::OutOfRange());
+  EXPECT_EQ(drain_drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 21u - written);
+  EXPECT_GT(written, 1u);
+  EXPECT_LT(written, 21u);
+
+  // Once the drain catches up, new entries are accepted again.
+  sink_.HandleEntry(0, AsBytes("new error"));
+  EXPECT_EQ(ExpectPop("new error"), 0u);
+  sink_.DetachDrain(drain_);
+}
+
+TEST_F(PriorityMultiSinkTest, DropCountsFromSkippedLanesAreReported) {
+  sink_.AttachDrain(drain_);
+  sink_.HandleDropped(0, 2);
+  sink_.HandleEntry(1, AsBytes("debug"));
+
+  uint32_t drain_drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  Result<ConstByteSpan> result =
+      drain_.PopEntry(entry_buffer_, drain_drop_count, ingress_drop_count);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(drain_drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 2u);
+  sink_.DetachDrain(drain_);
+}
+
+TEST_F(PriorityMultiSinkTest, DetachedDrainFails) {
+  uint32_t drain_drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  EXPECT_EQ(
+      drain_.PopEntry(entry_buffer_, drain_drop_count, ingress_drop_count)
+          .status(),
+      Status::FailedPrecondition());
+
+  sink_.AttachDrain(drain_);
+  sink_.HandleEntry(0, AsBytes("error"));
+  sink_.DetachDrain(drain_);
+  EXPECT_EQ(
+      drain_.PopEntry(entry_buffer_, drain_drop_count, ingress_drop_count)
+          .status(),
+      Status::FailedPrecondition());
+}
+
+}  // namespace
+}  // namespace pw::multisink
@@ -17,11 +17,13 @@
 #include <mutex>
 
 #include "pw_bytes/span.h"
+#include "pw_containers/intrusive_dlist.h"
 #include "pw_function/function.h"
 #include "pw_multisink/config.h"
 #include "pw_result/result.h"
 #include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
 #include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
 #include "pw_sync/lock_annotations.h"
 
 namespace pw {
@@ -197,6 +199,53 @@ class MultiSink {
                                   uint32_t& ingress_drop_count_out)
         PW_LOCKS_EXCLUDED(multisink_->lock_);
 
+    // A view of an entry's data in place in the multisink's buffer. The data is
+    // split across `first` and `second` if the entry wraps around the end of
+    // the buffer. Views are only valid within a PopEntries() handler.
+    using EntryView = ring_buffer::PrefixedEntryRingBufferMulti::EntryView;
+
+    // Handles an entry from PopEntries(). Returns true if the entry was handled
+    // and should be popped, or false to stop before it.
+    using EntryHandler = Function<bool(const EntryView& entry)>;
+
+    // Pops a run of entries with a single acquisition of the multisink's lock,
+    // passing each one to `handler` in place, without copying it. This lets
+    // drains such as log encoders process many entries per lock acquisition.
+    //
+    // Entries are passed to `handler` in order until it returns false, until
+    // `max_entries` entries are popped, until there are no more entries, or
+    // until there is a gap in the entries' sequence IDs, i.e. when entries
+    // were dropped. So, the drop counts, which follow the same logic as
+    // `PopEntry`, all apply to before the first popped entry, and any later
+    // drops are reported by the next call.
+    //
+    // The multisink's lock is held while `handler` runs, so the handler must
+    // not use the multisink or its drains, and should be quick if
+    // PW_MULTISINK_LOCK_INTERRUPT_SAFE is enabled.
+    //
+    // Precondition: the buffer data must not be corrupt, otherwise there will
+    // be a crash.
+    //
+    // Return values:
+    // OK - The size is the number of entries that were popped, which may be
+    // zero if `handler` rejected the first entry.
+    // OUT_OF_RANGE - No entries were available.
+    // FAILED_PRECONDITION - The drain must be attached to a sink.
+    StatusWithSize PopEntries(
+        const EntryHandler& handler,
+        uint32_t& drain_drop_count_out,
+        uint32_t& ingress_drop_count_out,
+        size_t max_entries = std::numeric_limits<size_t>::max())
+        PW_LOCKS_EXCLUDED(multisink_->lock_);
+
+    // Returns the number of bytes used in the multisink by the entries that
+    // this drain has yet to read, including a few bytes of overhead per entry.
+    // This can be used to decide whether there is enough data to fill a
+    // packet.
+    //
+    // Precondition: The drain must be attached to a sink.
+    size_t UnreadSizeBytes() PW_LOCKS_EXCLUDED(multisink_->lock_);
+
     // Drains are not copyable or movable.
     Drain(const Drain&) = delete;
     Drain& operator=(const Drain&) = delete;
@@ -218,9 +267,17 @@ class MultiSink {
   // A pure-virtual listener of a MultiSink, attached via AttachListener.
   // MultiSink's invoke listeners when new data arrives, allowing them to
   // schedule the draining of messages out of the MultiSink.
-  class Listener : public IntrusiveList<Listener>::Item {
+  //
+  // By default, a listener is notified of every new entry and drop. A listener
+  // constructed with `coalesce_notifications` set is notified once, and then
+  // not again until it calls MultiSink::ResumeNotifications(). Call it before
+  // draining, so that entries added during or after the drain notify again.
+  // This avoids waking the drain for every entry under heavy logging.
+  class Listener : public IntrusiveDList<Listener>::Item {
    public:
     constexpr Listener() {}
+    constexpr explicit Listener(bool coalesce_notifications)
+        : coalesce_notifications_(coalesce_notifications) {}
     virtual ~Listener() = default;
 
     // Listeners are not copyable or movable.
@@ -233,9 +290,17 @@ class MultiSink {
     friend MultiSink;
 
     // Invoked by the attached multisink when a new entry or drop count is
-    // available. The multisink lock is held during this call, so neither the
-    // multisink nor it's drains can be used during this callback.
+    // available. The multisink's listener lock is held during this call, so
+    // listeners cannot be attached, detached, or resumed during this callback.
+    // The multisink's entries are not locked, so drains may be read.
     virtual void OnNewEntryAvailable() = 0;
+
+   private:
+    const bool coalesce_notifications_ = false;
+
+    // Set when a coalescing listener is notified, and cleared when it resumes
+    // notifications. Guarded by the multisink's listener lock.
+    bool notified_ = false;
   };
 
   class iterator {
@@ -326,14 +391,16 @@ class MultiSink {
   // Precondition: If PW_MULTISINK_LOCK_INTERRUPT_SAFE is disabled, this
   // function must not be called from an interrupt context.
   // Precondition: entry.size() <= `ring_buffer_` size
-  void HandleEntry(ConstByteSpan entry) PW_LOCKS_EXCLUDED(lock_);
+  void HandleEntry(ConstByteSpan entry)
+      PW_LOCKS_EXCLUDED(lock_, listener_lock_);
 
   // Notifies the multisink of messages dropped before ingress. The writer
   // may use this to signal to readers that an entry (or entries) failed
   // before being sent to the multisink (e.g. the writer failed to encode
   // the message). This API increments the sequence ID of the multisink by
   // the provided `drop_count`.
-  void HandleDropped(uint32_t drop_count = 1) PW_LOCKS_EXCLUDED(lock_);
+  void HandleDropped(uint32_t drop_count = 1)
+      PW_LOCKS_EXCLUDED(lock_, listener_lock_);
 
   // Attach a drain to the multisink. Drains may not be associated with more
   // than one multisink at a time. Drains can consume entries pushed before
@@ -357,12 +424,21 @@ class MultiSink {
   // messages.
   //
   // Precondition: The listener must not be attached to a multisink.
-  void AttachListener(Listener& listener) PW_LOCKS_EXCLUDED(lock_);
+  void AttachListener(Listener& listener) PW_LOCKS_EXCLUDED(listener_lock_);
 
   // Detaches a listener from the multisink.
   //
   // Precondition: The listener must be attached to this multisink.
-  void DetachListener(Listener& listener) PW_LOCKS_EXCLUDED(lock_);
+  void DetachListener(Listener& listener) PW_LOCKS_EXCLUDED(listener_lock_);
+
+  // Lets a listener that coalesces notifications be notified of the next new
+  // entry or drop. Entries that arrived since the last notification do not
+  // notify again, so call this before draining them. Has no effect on
+  // listeners that do not coalesce notifications.
+  //
+  // Precondition: The listener must be attached to this multisink.
+  void ResumeNotifications(Listener& listener)
+      PW_LOCKS_EXCLUDED(listener_lock_);
 
   // Removes all data from the internal buffer. The multisink's sequence ID is
   // not modified, so readers may interpret this event as droppping entries.
@@ -411,16 +487,42 @@ class MultiSink {
                                        uint32_t& entry_sequence_id_out)
       PW_LOCKS_EXCLUDED(lock_);
 
+  // Returns the size of the drain's unread entries.
+  size_t UnreadSizeBytes(Drain& drain) PW_LOCKS_EXCLUDED(lock_);
+
+  // Passes a run of entries from the drain to `handler` and pops the entries
+  // it handles. See Drain::PopEntries.
+  StatusWithSize PopEntries(Drain& drain,
+                            const Drain::EntryHandler& handler,
+                            uint32_t& drain_drop_count_out,
+                            uint32_t& ingress_drop_count_out,
+                            size_t max_entries) PW_LOCKS_EXCLUDED(lock_);
+
  private:
+  // Computes the drain and ingress drop counts for a drain that is about to
+  // handle the entry with `entry_sequence_id`. If `entry_available` is false,
+  // the drain has caught up and `entry_sequence_id` is the last handled ID.
+  void ComputeDropCounts(Drain& drain,
+                         uint32_t entry_sequence_id,
+                         bool entry_available,
+                         uint32_t& drain_drop_count_out,
+                         uint32_t& ingress_drop_count_out)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Notifies attached listeners of new entries or an updated drop count.
-  void NotifyListeners() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Listeners that coalesce notifications are skipped if already notified.
+  void NotifyListeners() PW_LOCKS_EXCLUDED(lock_, listener_lock_);
 
-  IntrusiveList<Listener> listeners_ PW_GUARDED_BY(lock_);
+  IntrusiveDList<Listener> listeners_ PW_GUARDED_BY(listener_lock_);
   ring_buffer::PrefixedEntryRingBufferMulti ring_buffer_ PW_GUARDED_BY(lock_);
   Drain oldest_entry_drain_ PW_GUARDED_BY(lock_);
   uint32_t sequence_id_ PW_GUARDED_BY(lock_);
   uint32_t total_ingress_drops_ PW_GUARDED_BY(lock_);
   LockType lock_;
+
+  // Guards the listeners separately, so that they are not notified while the
+  // entries are locked. The two locks are never held at the same time.
+  LockType listener_lock_;
 };
 
 }  // namespace multisink
@@ -0,0 +1,186 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_containers/intrusive_list.h"
+#include "pw_multisink/config.h"
+#include "pw_multisink/multisink.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw {
+namespace multisink {
+
+// A set of MultiSinks, or lanes, that are drained in priority order through a
+// single drain API. Each lane has its own ring buffer, so a burst of entries
+// in one lane, such as debug logs, cannot evict entries from another, such as
+// error logs. Lanes are ordered from highest to lowest priority.
+//
+// Entries are only ordered within a lane. A drain returns every available
+// entry from a lane before any entry from a lower-priority lane.
+//
+// This class is thread-safe but NOT IRQ-safe when
+// PW_MULTISINK_LOCK_INTERRUPT_SAFE is disabled.
+class PriorityMultiSink {
+ public:
+  // What a lane does when a new entry does not fit alongside the entries that
+  // its drains have yet to read.
+  enum class DropPolicy {
+    // Evict the oldest entries to make space, as a MultiSink does.
+    kDropOldest,
+
+    // Keep the unread entries and drop the new entry, which drains report as
+    // an ingress drop. Whether the entry fits is predicted from the unread
+    // size of each drain attached to the PriorityMultiSink before the entry
+    // is written, so no unread entry is evicted.
+    kDropNewest,
+  };
+
+  // A lane's ring buffer and drop policy.
+  class Lane {
+   public:
+    Lane(ByteSpan buffer, DropPolicy drop_policy = DropPolicy::kDropOldest)
+        : multisink_(buffer),
+          size_bytes_(buffer.size()),
+          drop_policy_(drop_policy) {}
+
+    Lane(const Lane&) = delete;
+    Lane& operator=(const Lane&) = delete;
+
+   private:
+    friend PriorityMultiSink;
+
+    MultiSink multisink_;
+    const size_t size_bytes_;
+    const DropPolicy drop_policy_;
+  };
+
+  // A reader of every lane of a PriorityMultiSink, attached via AttachDrain.
+  // Declare drains as DrainWithLanes.
+  class Drain : public IntrusiveList<Drain>::Item {
+   public:
+    Drain(const Drain&) = delete;
+    Drain& operator=(const Drain&) = delete;
+
+    // Returns the next available entry from the highest-priority lane that
+    // has one, following the same logic as MultiSink::Drain::PopEntry. The
+    // drop counts are the totals of the lanes up to and including the lane
+    // the entry was read from; drops in lower-priority lanes are reported by
+    // later calls.
+    //
+    // Return values:
+    // OK - An entry was successfully read from a lane.
+    // OUT_OF_RANGE - No entries were available in any lane.
+    // FAILED_PRECONDITION - The drain must be attached to a sink.
+    // RESOURCE_EXHAUSTED - The provided buffer was not large enough to store
+    // the next available entry, which was discarded.
+    Result<ConstByteSpan> PopEntry(ByteSpan buffer,
+                                   uint32_t& drain_drop_count_out,
+                                   uint32_t& ingress_drop_count_out);
+
+    // Returns the number of bytes used in all lanes by the entries that this
+    // drain has yet to read.
+    //
+    // Precondition: The drain must be attached to a sink.
+    size_t UnreadSizeBytes();
+
+   protected:
+    constexpr Drain(span<MultiSink::Drain> lane_drains)
+        : lane_drains_(lane_drains) {}
+
+    ~Drain() = default;
+
+   private:
+    friend PriorityMultiSink;
+
+    span<MultiSink::Drain> lane_drains_;
+    PriorityMultiSink* sink_ = nullptr;
+  };
+
+  // A Drain with a reader for each of kNumLanes lanes.
+  template <size_t kNumLanes>
+  class DrainWithLanes final : public Drain {
+   public:
+    static_assert(kNumLanes > 0u);
+
+    constexpr DrainWithLanes() : Drain(lane_drains_) {}
+
+   private:
+    std::array<MultiSink::Drain, kNumLanes> lane_drains_;
+  };
+
+  // Constructs a PriorityMultiSink from lanes ordered from highest to lowest
+  // priority. The lanes must outlive the PriorityMultiSink.
+  constexpr PriorityMultiSink(span<Lane> lanes) : lanes_(lanes) {}
+
+  PriorityMultiSink(const PriorityMultiSink&) = delete;
+  PriorityMultiSink& operator=(const PriorityMultiSink&) = delete;
+
+  size_t num_lanes() const { return lanes_.size(); }
+
+  // Returns a lane's MultiSink, e.g. to attach a listener or to iterate over
+  // its entries. Entries must be written through the PriorityMultiSink for
+  // the lane's drop policy to apply.
+  MultiSink& lane(size_t lane_index) { return lanes_[lane_index].multisink_; }
+
+  // Writes an entry to a lane, applying the lane's drop policy if the entry
+  // does not fit.
+  //
+  // Precondition: lane_index < num_lanes()
+  // Precondition: If PW_MULTISINK_LOCK_INTERRUPT_SAFE is disabled, this
+  // function must not be called from an interrupt context.
+  void HandleEntry(size_t lane_index, ConstByteSpan entry)
+      PW_LOCKS_EXCLUDED(lock_);
+
+  // Notifies a lane of messages dropped before ingress. See
+  // MultiSink::HandleDropped.
+  //
+  // Precondition: lane_index < num_lanes()
+  void HandleDropped(size_t lane_index, uint32_t drop_count = 1) {
+    lane(lane_index).HandleDropped(drop_count);
+  }
+
+  // Attaches a drain to every lane.
+  //
+  // Precondition: The drain must not be attached to a sink, and must have one
+  // reader per lane.
+  void AttachDrain(Drain& drain) PW_LOCKS_EXCLUDED(lock_);
+
+  // Detaches a drain from every lane.
+  //
+  // Precondition: The drain must be attached to this sink.
+  void DetachDrain(Drain& drain) PW_LOCKS_EXCLUDED(lock_);
+
+ private:
+  // Returns true if writing an entry of `entry_size_bytes` to the lane would
+  // evict an entry that an attached drain has not read.
+  bool WouldEvictUnread(size_t lane_index, size_t entry_size_bytes)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const span<Lane> lanes_;
+  IntrusiveList<Drain> drains_ PW_GUARDED_BY(lock_);
+
+  // Serializes HandleEntry() calls for lanes that drop new entries, so that
+  // the space checked for an entry is still free when it is written.
+  LockType lock_;
+};
+
+}  // namespace multisink
+}  // namespace pw
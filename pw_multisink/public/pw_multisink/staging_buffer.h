@@ -0,0 +1,163 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "pw_bytes/span.h"
+#include "pw_multisink/multisink.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw {
+namespace multisink {
+namespace internal {
+
+// A lock-free single-producer, single-consumer ring of timestamped entries.
+// Each entry is stored contiguously, so it can be passed to a MultiSink
+// without copying it out of the ring first.
+class StagingRing {
+ public:
+  // Each entry is prefixed with its size and timestamp.
+  static constexpr size_t kEntryHeaderSizeBytes =
+      sizeof(uint16_t) + sizeof(int64_t);
+
+  constexpr StagingRing() = default;
+
+  StagingRing(const StagingRing&) = delete;
+  StagingRing& operator=(const StagingRing&) = delete;
+
+  // Sets the ring's storage, whose size must be a power of 2. Must be called
+  // before the ring is used.
+  void SetBuffer(ByteSpan buffer);
+
+  // Producer: Copies an entry into the ring. Returns INVALID_ARGUMENT if the
+  // entry is too large, or RESOURCE_EXHAUSTED if there is not enough space,
+  // and counts a drop.
+  Status Push(int64_t timestamp, ConstByteSpan entry);
+
+  // Consumer: Finds the oldest staged entry. Returns false if the ring is
+  // empty. The entry remains valid until Pop() is called.
+  bool Peek(int64_t& timestamp, ConstByteSpan& entry);
+
+  // Consumer: Removes the entry returned by the last successful Peek().
+  void Pop();
+
+  // Consumer: Returns the number of entries dropped since the last call.
+  uint32_t TakeDropCount() {
+    return drop_count_.exchange(0, std::memory_order_relaxed);
+  }
+
+  size_t max_entry_size() const;
+
+ private:
+  // Marks the unused space at the end of the ring's storage when an entry
+  // doesn't fit before the end.
+  static constexpr uint16_t kPaddingMarker =
+      std::numeric_limits<uint16_t>::max();
+
+  size_t Offset(uint32_t index) const { return index & (buffer_.size() - 1); }
+
+  ByteSpan buffer_;
+
+  // Free-running indices into the buffer. write_ is only modified by the
+  // producer and read_ by the consumer.
+  std::atomic<uint32_t> write_ = 0;
+  std::atomic<uint32_t> read_ = 0;
+
+  std::atomic<uint32_t> drop_count_ = 0;
+
+  // The size of the entry found by Peek(), including its header and padding.
+  uint32_t peeked_size_ = 0;
+};
+
+// The StagingBuffer logic, independent of the number and size of rings.
+class BasicStagingBuffer {
+ public:
+  BasicStagingBuffer(const BasicStagingBuffer&) = delete;
+  BasicStagingBuffer& operator=(const BasicStagingBuffer&) = delete;
+
+  // Stages an entry in a producer's ring. Each producer's ring must only be
+  // written by one context at a time: for example, one ring per CPU core,
+  // written with interrupts or preemption disabled, or one ring per thread.
+  //
+  // This does not block or take locks. Returns one of:
+  //
+  //   OK - The entry was staged.
+  //   INVALID_ARGUMENT - The entry is too large for the ring.
+  //   RESOURCE_EXHAUSTED - The ring is full.
+  //
+  // Entries that aren't staged are reported to the MultiSink as drops by the
+  // next Flush().
+  //
+  Status Push(size_t producer, int64_t timestamp, ConstByteSpan entry);
+
+  // Moves up to max_entries staged entries from all rings into the MultiSink,
+  // oldest timestamp first, and reports any dropped entries with
+  // MultiSink::HandleDropped. Returns the number of entries moved.
+  //
+  // Entries are ordered by timestamp among those staged when Flush() runs; an
+  // entry staged after a flush with an older timestamp than an entry that was
+  // already flushed is delivered after it.
+  //
+  // Flush() must not be called concurrently with itself, but may run while
+  // producers push entries.
+  size_t Flush(MultiSink& sink,
+               size_t max_entries = std::numeric_limits<size_t>::max());
+
+  // The largest entry that fits in a producer's ring.
+  size_t max_entry_size() const { return rings_[0].max_entry_size(); }
+
+ protected:
+  constexpr BasicStagingBuffer(span<StagingRing> rings) : rings_(rings) {}
+
+ private:
+  span<StagingRing> rings_;
+};
+
+}  // namespace internal
+
+// Stages MultiSink entries in per-producer lock-free rings, so that producers
+// such as log handlers on different CPU cores don't contend on the MultiSink's
+// lock. Entries are moved into the MultiSink in batches by Flush(), which
+// merges the rings in timestamp order.
+//
+// Each ring holds kRingSizeBytes bytes, which must be a power of 2. Each entry
+// uses 10 bytes in addition to its data.
+template <size_t kNumProducers, size_t kRingSizeBytes>
+class StagingBuffer : public internal::BasicStagingBuffer {
+ public:
+  static_assert(kNumProducers > 0u);
+  static_assert(kRingSizeBytes > internal::StagingRing::kEntryHeaderSizeBytes &&
+                    (kRingSizeBytes & (kRingSizeBytes - 1)) == 0u,
+                "The ring size must be a power of 2");
+
+  StagingBuffer() : BasicStagingBuffer(rings_) {
+    for (size_t i = 0; i < kNumProducers; ++i) {
+      rings_[i].SetBuffer(buffers_[i]);
+    }
+  }
+
+ private:
+  std::array<internal::StagingRing, kNumProducers> rings_;
+  std::array<std::array<std::byte, kRingSizeBytes>, kNumProducers> buffers_;
+};
+
+}  // namespace multisink
+}  // namespace pw
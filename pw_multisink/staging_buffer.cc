@@ -0,0 +1,153 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_multisink/staging_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_assert/check.h"
+
+namespace pw {
+namespace multisink {
+namespace internal {
+
+void StagingRing::SetBuffer(ByteSpan buffer) {
+  PW_CHECK(!buffer.empty() && (buffer.size() & (buffer.size() - 1)) == 0u,
+           "StagingRing size must be a power of 2");
+  buffer_ = buffer;
+}
+
+size_t StagingRing::max_entry_size() const {
+  return std::min(buffer_.size() - kEntryHeaderSizeBytes,
+                  static_cast<size_t>(kPaddingMarker - 1));
+}
+
+Status StagingRing::Push(int64_t timestamp, ConstByteSpan entry) {
+  if (entry.size() > max_entry_size()) {
+    drop_count_.fetch_add(1, std::memory_order_relaxed);
+    return Status::InvalidArgument();
+  }
+
+  const uint32_t write = write_.load(std::memory_order_relaxed);
+  const uint32_t read = read_.load(std::memory_order_acquire);
+
+  // Entries are contiguous, so skip the end of the buffer if it is too small.
+  const size_t offset = Offset(write);
+  const size_t until_end = buffer_.size() - offset;
+  const size_t entry_size = kEntryHeaderSizeBytes + entry.size();
+  const size_t padding = entry_size > until_end ? until_end : 0;
+
+  if (static_cast<uint32_t>(write - read) + padding + entry_size >
+      buffer_.size()) {
+    drop_count_.fetch_add(1, std::memory_order_relaxed);
+    return Status::ResourceExhausted();
+  }
+
+  // The consumer skips space that is too small for a header without a marker.
+  if (padding >= sizeof(kPaddingMarker)) {
+    std::memcpy(&buffer_[offset], &kPaddingMarker, sizeof(kPaddingMarker));
+  }
+
+  std::byte* header = &buffer_[Offset(write + padding)];
+  const uint16_t size = static_cast<uint16_t>(entry.size());
+  std::memcpy(header, &size, sizeof(size));
+  std::memcpy(header + sizeof(size), &timestamp, sizeof(timestamp));
+  std::memcpy(header + kEntryHeaderSizeBytes, entry.data(), entry.size());
+
+  write_.store(write + padding + entry_size, std::memory_order_release);
+  return OkStatus();
+}
+
+bool StagingRing::Peek(int64_t& timestamp, ConstByteSpan& entry) {
+  const uint32_t read = read_.load(std::memory_order_relaxed);
+  const uint32_t write = write_.load(std::memory_order_acquire);
+  if (read == write) {
+    return false;
+  }
+
+  size_t offset = Offset(read);
+  size_t padding = 0;
+  uint16_t size = kPaddingMarker;
+  const size_t until_end = buffer_.size() - offset;
+  if (until_end >= kEntryHeaderSizeBytes) {
+    std::memcpy(&size, &buffer_[offset], sizeof(size));
+  }
+  if (size == kPaddingMarker) {  // The entry starts at the beginning.
+    padding = until_end;
+    offset = 0;
+    std::memcpy(&size, &buffer_[offset], sizeof(size));
+  }
+
+  std::memcpy(&timestamp, &buffer_[offset + sizeof(size)], sizeof(timestamp));
+  entry = ConstByteSpan(&buffer_[offset + kEntryHeaderSizeBytes], size);
+  peeked_size_ = static_cast<uint32_t>(padding + kEntryHeaderSizeBytes + size);
+  return true;
+}
+
+void StagingRing::Pop() {
+  read_.store(read_.load(std::memory_order_relaxed) + peeked_size_,
+              std::memory_order_release);
+  peeked_size_ = 0;
+}
+
+Status BasicStagingBuffer::Push(size_t producer,
+                                int64_t timestamp,
+                                ConstByteSpan entry) {
+  PW_DCHECK_UINT_LT(producer, rings_.size());
+  return rings_[producer].Push(timestamp, entry);
+}
+
+size_t BasicStagingBuffer::Flush(MultiSink& sink, size_t max_entries) {
+  uint32_t drop_count = 0;
+  for (StagingRing& ring : rings_) {
+    drop_count += ring.TakeDropCount();
+  }
+  if (drop_count != 0u) {
+    sink.HandleDropped(drop_count);
+  }
+
+  size_t flushed = 0;
+  while (flushed < max_entries) {
+    // Find the ring whose next entry is the oldest.
+    StagingRing* oldest = nullptr;
+    int64_t oldest_timestamp = 0;
+    ConstByteSpan oldest_entry;
+
+    for (StagingRing& ring : rings_) {
+      int64_t timestamp;
+      ConstByteSpan entry;
+      if (ring.Peek(timestamp, entry) &&
+          (oldest == nullptr || timestamp < oldest_timestamp)) {
+        oldest = &ring;
+        oldest_timestamp = timestamp;
+        oldest_entry = entry;
+      }
+    }
+
+    if (oldest == nullptr) {
+      break;
+    }
+
+    sink.HandleEntry(oldest_entry);
+    oldest->Pop();
+    flushed += 1;
+  }
+  return flushed;
+}
+
+}  // namespace internal
+}  // namespace multisink
+}  // namespace pw
@@ -0,0 +1,146 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_multisink/staging_buffer.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_multisink/multisink.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::multisink {
+namespace {
+
+using namespace std::literals::string_view_literals;
+
+ConstByteSpan AsBytes(std::string_view text) { return as_bytes(span(text)); }
+
+class StagingBufferTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kRingSize = 64;
+
+  StagingBufferTest() : multisink_buffer_{}, multisink_(multisink_buffer_) {
+    multisink_.AttachDrain(drain_);
+  }
+
+  // Pops the next entry from the MultiSink and returns it as a string.
+  std::string_view Pop() {
+    uint32_t drop_count = 0;
+    uint32_t ingress_drop_count = 0;
+    Result<ConstByteSpan> result =
+        drain_.PopEntry(entry_buffer_, drop_count, ingress_drop_count);
+    last_ingress_drop_count_ = ingress_drop_count;
+    if (!result.ok()) {
+      return "";
+    }
+    return std::string_view(reinterpret_cast<const char*>(result->data()),
+                            result->size());
+  }
+
+  std::array<std::byte, 512> multisink_buffer_;
+  std::array<std::byte, 64> entry_buffer_;
+  MultiSink multisink_;
+  MultiSink::Drain drain_;
+  uint32_t last_ingress_drop_count_ = 0;
+  StagingBuffer<3, kRingSize> staging_;
+};
+
+TEST_F(StagingBufferTest, FlushEmpty) {
+  EXPECT_EQ(staging_.Flush(multisink_), 0u);
+  EXPECT_EQ(Pop(), "");
+}
+
+TEST_F(StagingBufferTest, FlushMergesRingsByTimestamp) {
+  ASSERT_EQ(staging_.Push(0, 10, AsBytes("a10")), OkStatus());
+  ASSERT_EQ(staging_.Push(0, 40, AsBytes("a40")), OkStatus());
+  ASSERT_EQ(staging_.Push(1, 20, AsBytes("b20")), OkStatus());
+  ASSERT_EQ(staging_.Push(2, 5, AsBytes("c5")), OkStatus());
+  ASSERT_EQ(staging_.Push(2, 30, AsBytes("c30")), OkStatus());
+
+  EXPECT_EQ(staging_.Flush(multisink_), 5u);
+  EXPECT_EQ(Pop(), "c5");
+  EXPECT_EQ(Pop(), "a10");
+  EXPECT_EQ(Pop(), "b20");
+  EXPECT_EQ(Pop(), "c30");
+  EXPECT_EQ(Pop(), "a40");
+  EXPECT_EQ(Pop(), "");
+}
+
+TEST_F(StagingBufferTest, FlushLimitsEntries) {
+  ASSERT_EQ(staging_.Push(0, 1, AsBytes("1")), OkStatus());
+  ASSERT_EQ(staging_.Push(1, 2, AsBytes("2")), OkStatus());
+  ASSERT_EQ(staging_.Push(0, 3, AsBytes("3")), OkStatus());
+
+  EXPECT_EQ(staging_.Flush(multisink_, 2), 2u);
+  EXPECT_EQ(Pop(), "1");
+  EXPECT_EQ(Pop(), "2");
+  EXPECT_EQ(Pop(), "");
+
+  EXPECT_EQ(staging_.Flush(multisink_), 1u);
+  EXPECT_EQ(Pop(), "3");
+}
+
+TEST_F(StagingBufferTest, FullRingDropsEntries) {
+  // Each entry uses 10 header bytes + 6 data bytes, so 4 fill the ring.
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(staging_.Push(0, i, AsBytes("entry!")), OkStatus());
+  }
+  EXPECT_EQ(staging_.Push(0, 4, AsBytes("entry!")),
+            Status::ResourceExhausted());
+  EXPECT_EQ(staging_.Push(0, 5, AsBytes("entry!")),
+            Status::ResourceExhausted());
+
+  // Other rings are unaffected.
+  EXPECT_EQ(staging_.Push(1, 6, AsBytes("other")), OkStatus());
+
+  // Drops are reported before the flushed entries.
+  EXPECT_EQ(staging_.Flush(multisink_), 5u);
+  EXPECT_EQ(Pop(), "entry!");
+  EXPECT_EQ(last_ingress_drop_count_, 2u);
+  for (int i = 1; i < 4; ++i) {
+    EXPECT_EQ(Pop(), "entry!");
+  }
+  EXPECT_EQ(Pop(), "other");
+}
+
+TEST_F(StagingBufferTest, TooLargeEntryIsDropped) {
+  std::array<std::byte, kRingSize> entry{};
+  EXPECT_EQ(staging_.max_entry_size(),
+            kRingSize - internal::StagingRing::kEntryHeaderSizeBytes);
+  EXPECT_EQ(staging_.Push(0, 0, entry), Status::InvalidArgument());
+  EXPECT_EQ(staging_.Push(0, 0, span(entry).first(staging_.max_entry_size())),
+            OkStatus());
+  EXPECT_EQ(staging_.Flush(multisink_), 1u);
+}
+
+TEST_F(StagingBufferTest, EntriesWrapAroundRing) {
+  // Push and flush entries of sizes that don't divide the ring size, so that
+  // entries are placed after padding at the end of the ring.
+  for (int i = 0; i < 50; ++i) {
+    const std::string_view entry = "0123456789abcdefghij"sv.substr(0, i % 21);
+    ASSERT_EQ(staging_.Push(0, i, AsBytes(entry)), OkStatus());
+    ASSERT_EQ(staging_.Push(1, i, AsBytes(entry)), OkStatus());
+    ASSERT_EQ(staging_.Flush(multisink_), 2u);
+    ASSERT_EQ(Pop(), entry);
+    ASSERT_EQ(Pop(), entry);
+  }
+}
+
+}  // namespace
+}  // namespace pw::multisink
@@ -16,3 +16,7 @@ include_guard(GLOBAL)
 include($ENV{PW_ROOT}/pw_build/pigweed.cmake)
 
 pw_add_backend_variable(pw_perf_test.TIMER_INTERFACE_BACKEND)
+pw_add_backend_variable(pw_perf_test.COUNTERS_BACKEND
+  DEFAULT_BACKEND
+    pw_perf_test.no_counters
+)
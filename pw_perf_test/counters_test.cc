@@ -0,0 +1,56 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_perf_test/internal/counters.h"
+
+#include <cstring>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::perf_test::internal {
+namespace {
+
+TEST(CountersTest, NotPrepared_NoCounters) {
+  EXPECT_EQ(NumCounters(), 0u);
+}
+
+TEST(CountersTest, Prepare_CountsIncrease) {
+  const size_t num_counters = CountersPrepare();
+  if (num_counters == 0) {
+    GTEST_SKIP() << "No hardware event counters are available";
+  }
+  ASSERT_LE(num_counters, kMaxCounters);
+  EXPECT_EQ(NumCounters(), num_counters);
+
+  CounterValues begin = {};
+  CounterValues end = {};
+  ReadCounters(begin);
+  for (volatile int i = 0; i < 1000; i = i + 1) {
+  }
+  ReadCounters(end);
+
+  uint64_t total = 0;
+  for (size_t i = 0; i < num_counters; ++i) {
+    EXPECT_NE(CounterName(i), nullptr);
+    EXPECT_GT(std::strlen(CounterName(i)), 0u);
+    total += GetCounterDelta(begin[i], end[i]);
+  }
+  EXPECT_GT(total, 0u);
+
+  CountersCleanup();
+  EXPECT_EQ(NumCounters(), 0u);
+}
+
+}  // namespace
+}  // namespace pw::perf_test::internal
@@ -14,6 +14,7 @@
 
 #include "pw_perf_test/internal/framework.h"
 
+#include "pw_perf_test/internal/counters.h"
 #include "pw_perf_test/internal/test_info.h"
 #include "pw_perf_test/internal/timer.h"
 
@@ -25,14 +26,18 @@ int Framework::RunAllTests() {
   if (!internal::TimerPrepare()) {
     return false;
   }
+  // Hardware event counters are optional, so run the tests without them if
+  // none are available.
+  static_cast<void>(internal::CountersPrepare());
 
   event_handler_->RunAllTestsStart(run_info_);
 
   for (const TestInfo* test = tests_; test != nullptr; test = test->next()) {
     State test_state = internal::CreateState(
-        kDefaultIterations, *event_handler_, test->test_name());
+        run_options_, *event_handler_, test->test_name());
     test->Run(test_state);
   }
+  internal::CountersCleanup();
   internal::TimerCleanup();
   event_handler_->RunAllTestsEnd();
   return true;
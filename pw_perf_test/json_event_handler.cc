@@ -0,0 +1,95 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#define PW_LOG_LEVEL PW_LOG_LEVEL_INFO
+
+#include "pw_perf_test/json_event_handler.h"
+
+#include "pw_log/log.h"
+#include "pw_perf_test/internal/timer.h"
+#include "pw_string/string_builder.h"
+
+namespace pw::perf_test {
+namespace {
+
+// Enough for the names and totals of several counters, and for the byte count
+// and several metrics.
+constexpr size_t kMaxCountersJsonSize = 256;
+constexpr size_t kMaxMetricsJsonSize = 192;
+
+}  // namespace
+
+void JsonEventHandler::RunAllTestsStart(const TestRunInfo&) {}
+
+void JsonEventHandler::RunAllTestsEnd() {}
+
+void JsonEventHandler::TestCaseStart(const TestCase& info) {
+  test_name_ = info.name;
+}
+
+void JsonEventHandler::TestCaseIteration(const TestIteration&) {}
+
+void JsonEventHandler::TestCaseMeasure(const TestMeasurement& measurement) {
+  // Counters are optional, so add them to the line as a nested object.
+  StringBuffer<kMaxCountersJsonSize> counters;
+  if (!measurement.counters.empty()) {
+    counters << ",\"counters\":{";
+    for (const TestCounter& counter : measurement.counters) {
+      if (&counter != measurement.counters.data()) {
+        counters << ',';
+      }
+      counters.Format("\"%s\":%llu",
+                      counter.name,
+                      static_cast<unsigned long long>(counter.total));
+    }
+    counters << '}';
+  }
+  // So are the byte count and the metrics, which the test sets itself.
+  StringBuffer<kMaxMetricsJsonSize> metrics;
+  if (measurement.bytes_per_iteration != 0) {
+    metrics.Format(
+        ",\"bytes\":%llu",
+        static_cast<unsigned long long>(measurement.bytes_per_iteration));
+  }
+  if (!measurement.metrics.empty()) {
+    metrics << ",\"metrics\":{";
+    for (const TestMetric& metric : measurement.metrics) {
+      if (&metric != measurement.metrics.data()) {
+        metrics << ',';
+      }
+      metrics.Format("\"%s\":%llu",
+                     metric.name,
+                     static_cast<unsigned long long>(metric.value));
+    }
+    metrics << '}';
+  }
+  PW_LOG_INFO(
+      "{\"name\":\"%s\",\"unit\":\"%s\",\"iterations\":%u,\"mean\":%lu,"
+      "\"min\":%lu,\"max\":%lu,\"p50\":%lu,\"p90\":%lu,\"p99\":%lu%s%s}",
+      test_name_,
+      internal::GetDurationUnitStr(),
+      static_cast<unsigned>(measurement.iterations),
+      static_cast<unsigned long>(measurement.mean),
+      static_cast<unsigned long>(measurement.min),
+      static_cast<unsigned long>(measurement.max),
+      static_cast<unsigned long>(measurement.p50),
+      static_cast<unsigned long>(measurement.p90),
+      static_cast<unsigned long>(measurement.p99),
+      counters.c_str(),
+      metrics.c_str());
+}
+
+void JsonEventHandler::TestCaseEnd(const TestCase&) { test_name_ = ""; }
+
+}  // namespace pw::perf_test
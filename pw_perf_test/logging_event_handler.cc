@@ -15,6 +15,8 @@
 
 #include "pw_perf_test/logging_event_handler.h"
 
+#include <algorithm>
+
 #include "pw_log/log.h"
 #include "pw_perf_test/event_handler.h"
 #include "pw_perf_test/googletest_style_event_handler.h"
@@ -52,6 +54,32 @@ void LoggingEventHandler::TestCaseMeasure(const TestMeasurement& measurement) {
               internal::GetDurationUnitStr(),
               static_cast<unsigned long>(measurement.max),
               internal::GetDurationUnitStr());
+  PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_PERCENTILES,
+              static_cast<unsigned>(measurement.iterations),
+              static_cast<unsigned long>(measurement.p50),
+              internal::GetDurationUnitStr(),
+              static_cast<unsigned long>(measurement.p90),
+              internal::GetDurationUnitStr(),
+              static_cast<unsigned long>(measurement.p99),
+              internal::GetDurationUnitStr());
+  for (const TestCounter& counter : measurement.counters) {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_COUNTER,
+                counter.name,
+                static_cast<unsigned long>(counter.total /
+                                           std::max(measurement.iterations,
+                                                    uint32_t{1})),
+                static_cast<unsigned long long>(counter.total));
+  }
+  if (measurement.bytes_per_iteration != 0) {
+    PW_LOG_INFO(
+        PW_PERF_TEST_GOOGLETEST_CASE_BYTES,
+        static_cast<unsigned long long>(measurement.bytes_per_iteration));
+  }
+  for (const TestMetric& metric : measurement.metrics) {
+    PW_LOG_INFO(PW_PERF_TEST_GOOGLETEST_CASE_METRIC,
+                metric.name,
+                static_cast<unsigned long long>(metric.value));
+  }
 }
 
 void LoggingEventHandler::TestCaseEnd(const TestCase& info) {
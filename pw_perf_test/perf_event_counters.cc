@@ -0,0 +1,116 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#define PW_LOG_MODULE_NAME "pw_perf_test"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "pw_log/log.h"
+#include "pw_perf_test/internal/perf_event_counters_interface.h"
+
+namespace pw::perf_test::internal::counters_backend {
+namespace {
+
+struct Counter {
+  const char* name;
+  uint64_t config;
+};
+
+constexpr std::array<Counter, kMaxCounters> kCounters = {{
+    {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+// The counters are opened as one group so they are scheduled on the PMU
+// together and can be read with a single read() of the group leader.
+std::array<int, kMaxCounters> fds;
+std::array<const char*, kMaxCounters> names;
+size_t num_counters = 0;
+
+int OpenCounter(uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(syscall(SYS_perf_event_open,
+                                  &attr,
+                                  0,   // This thread.
+                                  -1,  // Any CPU.
+                                  group_fd,
+                                  0));
+}
+
+}  // namespace
+
+size_t CountersPrepare() {
+  CountersCleanup();
+  for (const Counter& counter : kCounters) {
+    const int group_fd = num_counters == 0 ? -1 : fds[0];
+    const int fd = OpenCounter(counter.config, group_fd);
+    if (fd == -1) {
+      PW_LOG_WARN("Unable to count %s: %s", counter.name, std::strerror(errno));
+      continue;
+    }
+    fds[num_counters] = fd;
+    names[num_counters] = counter.name;
+    ++num_counters;
+  }
+  if (num_counters != 0) {
+    ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+  return num_counters;
+}
+
+void CountersCleanup() {
+  for (size_t i = 0; i < num_counters; ++i) {
+    close(fds[i]);
+  }
+  num_counters = 0;
+}
+
+size_t NumCounters() { return num_counters; }
+
+const char* CounterName(size_t index) { return names[index]; }
+
+void ReadCounters(std::array<uint64_t, kMaxCounters>& values) {
+  if (num_counters == 0) {
+    return;
+  }
+  // With PERF_FORMAT_GROUP, the leader reads as the number of counters
+  // followed by their values in the order they were opened.
+  std::array<uint64_t, kMaxCounters + 1> buffer;
+  if (read(fds[0], buffer.data(), sizeof(buffer)) <= 0) {
+    return;
+  }
+  for (size_t i = 0; i < num_counters; ++i) {
+    values[i] = buffer[i + 1];
+  }
+}
+
+}  // namespace pw::perf_test::internal::counters_backend
@@ -27,4 +27,9 @@ void RunAllTests(EventHandler& handler) {
   internal::Framework::Get().RunAllTests();
 }
 
+void RunAllTests(EventHandler& handler, const RunOptions& options) {
+  internal::Framework::Get().SetRunOptions(options);
+  RunAllTests(handler);
+}
+
 }  // namespace pw::perf_test
@@ -0,0 +1,32 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+// The maximum number of iteration durations a perf test retains to estimate
+// percentiles. When a test runs more iterations, the percentiles are estimated
+// from a uniform random sample of this many iterations. Each sample takes 8
+// bytes in the `pw::perf_test::State`, which lives on the stack of the thread
+// running the perf tests.
+#ifndef PW_PERF_TEST_CONFIG_MAX_SAMPLES
+#define PW_PERF_TEST_CONFIG_MAX_SAMPLES 64
+#endif  // PW_PERF_TEST_CONFIG_MAX_SAMPLES
+
+static_assert(PW_PERF_TEST_CONFIG_MAX_SAMPLES > 0,
+              "PW_PERF_TEST_CONFIG_MAX_SAMPLES must be positive");
+
+// The maximum number of metrics, such as peak memory use, that a perf test can
+// report with `pw::perf_test::State::SetMetric()`.
+#ifndef PW_PERF_TEST_CONFIG_MAX_METRICS
+#define PW_PERF_TEST_CONFIG_MAX_METRICS 4
+#endif  // PW_PERF_TEST_CONFIG_MAX_METRICS
@@ -15,6 +15,8 @@
 
 #include <cstdint>
 
+#include "pw_span/span.h"
+
 namespace pw::perf_test {
 
 /// Data reported on completion of an iteration.
@@ -23,11 +25,56 @@ struct TestIteration {
   float result = 0;
 };
 
+/// A hardware event, such as instructions retired or cache misses, counted
+/// over a performance test's measured iterations.
+struct TestCounter {
+  /// The counter's name, e.g. "instructions".
+  const char* name = nullptr;
+
+  /// Number of events counted over all measured iterations.
+  uint64_t total = 0;
+};
+
+/// A value measured by a performance test itself, such as the peak memory used
+/// by the code under test.
+struct TestMetric {
+  /// The metric's name, e.g. "peak_bytes".
+  const char* name = nullptr;
+
+  /// The last value the test set for the metric.
+  uint64_t value = 0;
+};
+
 /// Data reported for each `Measurement` upon completion of a performance test.
+///
+/// Durations are in the units of the timer backend. Warmup iterations are not
+/// included.
 struct TestMeasurement {
   float mean = 0;
   float max = 0;
   float min = 0;
+
+  /// Number of measured iterations.
+  uint32_t iterations = 0;
+
+  /// Percentiles of the iteration durations. These are estimated from a
+  /// sample of the iterations if there are more than
+  /// `PW_PERF_TEST_CONFIG_MAX_SAMPLES`.
+  float p50 = 0;
+  float p90 = 0;
+  float p99 = 0;
+
+  /// Hardware events counted during the measured iterations, if the counters
+  /// backend provides any.
+  span<const TestCounter> counters;
+
+  /// Bytes processed by each iteration, as set with
+  /// `State::SetBytesPerIteration()`, or 0 if the test did not set it. The
+  /// throughput is this divided by the mean duration.
+  uint64_t bytes_per_iteration = 0;
+
+  /// Metrics set by the test with `State::SetMetric()`.
+  span<const TestMetric> metrics;
 };
 
 /// Stores information on the upcoming collection of tests.
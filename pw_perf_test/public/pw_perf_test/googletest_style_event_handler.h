@@ -24,4 +24,11 @@
 #define PW_PERF_TEST_GOOGLETEST_CASE_ITERATION "[ Iteration ] #%u: %lu %s"
 #define PW_PERF_TEST_GOOGLETEST_CASE_MEASUREMENT \
   "[  RESULT  ] MEAN: %lu %s, MIN: %lu %s, MAX: %lu %s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_PERCENTILES \
+  "[  RESULT  ] ITERATIONS: %u, P50: %lu %s, P90: %lu %s, P99: %lu %s"
+#define PW_PERF_TEST_GOOGLETEST_CASE_COUNTER \
+  "[  RESULT  ] %s: %lu per iteration, %llu total"
+#define PW_PERF_TEST_GOOGLETEST_CASE_BYTES \
+  "[  RESULT  ] BYTES: %llu per iteration"
+#define PW_PERF_TEST_GOOGLETEST_CASE_METRIC "[  RESULT  ] %s: %llu"
 #define PW_PERF_TEST_GOOGLETEST_CASE_END "[     DONE ] %s"
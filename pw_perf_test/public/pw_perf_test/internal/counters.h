@@ -0,0 +1,58 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_perf_test_counters_backend/counters.h"
+
+namespace pw::perf_test::internal {
+
+// The most hardware event counters the backend can provide.
+inline constexpr size_t kMaxCounters = counters_backend::kMaxCounters;
+
+// Raw counter values, indexed like `CounterName()`.
+using CounterValues = std::array<uint64_t, kMaxCounters>;
+
+// Starts counting events on the current thread. Returns how many counters are
+// available, which may be fewer than `kMaxCounters` if the hardware or OS does
+// not support some of them.
+[[nodiscard]] inline size_t CountersPrepare() {
+  return counters_backend::CountersPrepare();
+}
+
+inline void CountersCleanup() { counters_backend::CountersCleanup(); }
+
+// Returns the number of counters available since `CountersPrepare()`, or 0 if
+// counters are not prepared.
+inline size_t NumCounters() { return counters_backend::NumCounters(); }
+
+// Returns the name of an available counter, e.g. "instructions".
+inline const char* CounterName(size_t index) {
+  return counters_backend::CounterName(index);
+}
+
+// Reads the current values of the available counters.
+inline void ReadCounters(CounterValues& values) {
+  counters_backend::ReadCounters(values);
+}
+
+// Returns the number of events counted between two readings of a counter.
+inline uint64_t GetCounterDelta(uint64_t begin, uint64_t end) {
+  return counters_backend::GetCounterDelta(begin, end);
+}
+
+}  // namespace pw::perf_test::internal
@@ -0,0 +1,93 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace pw::perf_test::internal::counters_backend {
+
+// The DWT profiling counters. Each is 8 bits wide and wraps around, so deltas
+// are only accurate when fewer than 256 events occur between two readings.
+inline volatile uint32_t& kDwtCtrl =
+    *reinterpret_cast<volatile uint32_t*>(0xE0001000);
+inline volatile uint32_t& kDwtCpiCnt =
+    *reinterpret_cast<volatile uint32_t*>(0xE0001008);
+inline volatile uint32_t& kDwtExcCnt =
+    *reinterpret_cast<volatile uint32_t*>(0xE000100C);
+inline volatile uint32_t& kDwtSleepCnt =
+    *reinterpret_cast<volatile uint32_t*>(0xE0001010);
+inline volatile uint32_t& kDwtLsuCnt =
+    *reinterpret_cast<volatile uint32_t*>(0xE0001014);
+inline volatile uint32_t& kDwtFoldCnt =
+    *reinterpret_cast<volatile uint32_t*>(0xE0001018);
+inline volatile uint32_t& kDemcr =
+    *reinterpret_cast<volatile uint32_t*>(0xE000EDFC);
+
+inline constexpr uint32_t kDemcrTrcena = 1u << 24;
+inline constexpr uint32_t kDwtCtrlNoPrfCnt = 1u << 24;
+inline constexpr uint32_t kDwtCtrlEventEnables = (1u << 17) |  // CPIEVTENA
+                                                 (1u << 18) |  // EXCEVTENA
+                                                 (1u << 19) |  // SLEEPEVTENA
+                                                 (1u << 20) |  // LSUEVTENA
+                                                 (1u << 21);   // FOLDEVTENA
+
+inline constexpr size_t kMaxCounters = 5;
+
+inline bool counters_enabled = false;
+
+[[nodiscard]] inline size_t CountersPrepare() {
+  kDemcr |= kDemcrTrcena;
+  if ((kDwtCtrl & kDwtCtrlNoPrfCnt) != 0) {
+    return 0;  // This core does not implement the profiling counters.
+  }
+  kDwtCpiCnt = 0;
+  kDwtExcCnt = 0;
+  kDwtSleepCnt = 0;
+  kDwtLsuCnt = 0;
+  kDwtFoldCnt = 0;
+  kDwtCtrl |= kDwtCtrlEventEnables;
+  counters_enabled = true;
+  return kMaxCounters;
+}
+
+inline void CountersCleanup() {
+  if (counters_enabled) {
+    kDwtCtrl &= ~kDwtCtrlEventEnables;
+    counters_enabled = false;
+  }
+}
+
+inline size_t NumCounters() { return counters_enabled ? kMaxCounters : 0; }
+
+inline const char* CounterName(size_t index) {
+  constexpr std::array<const char*, kMaxCounters> kNames = {
+      "cpi_cycles", "exception_cycles", "sleep_cycles", "lsu_cycles", "folded"};
+  return kNames[index];
+}
+
+inline void ReadCounters(std::array<uint64_t, kMaxCounters>& values) {
+  values[0] = kDwtCpiCnt;
+  values[1] = kDwtExcCnt;
+  values[2] = kDwtSleepCnt;
+  values[3] = kDwtLsuCnt;
+  values[4] = kDwtFoldCnt;
+}
+
+inline uint64_t GetCounterDelta(uint64_t begin, uint64_t end) {
+  return (end - begin) & 0xFFu;
+}
+
+}  // namespace pw::perf_test::internal::counters_backend
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "pw_perf_test/event_handler.h"
+#include "pw_perf_test/state.h"
 
 namespace pw::perf_test::internal {
 
@@ -28,7 +29,8 @@ class Framework {
   constexpr Framework()
       : event_handler_(nullptr),
         tests_(nullptr),
-        run_info_{.total_tests = 0, .default_iterations = kDefaultIterations} {}
+        run_info_{.total_tests = 0,
+                  .default_iterations = RunOptions().iterations} {}
 
   static Framework& Get() { return framework_; }
 
@@ -36,13 +38,16 @@ class Framework {
     event_handler_ = &event_handler;
   }
 
+  void SetRunOptions(const RunOptions& options) {
+    run_options_ = options;
+    run_info_.default_iterations = options.iterations;
+  }
+
   void RegisterTest(TestInfo&);
 
   int RunAllTests();
 
  private:
-  static constexpr int kDefaultIterations = 10;
-
   EventHandler* event_handler_;
 
   // Pointer to the list of tests
@@ -50,6 +55,8 @@ class Framework {
 
   TestRunInfo run_info_;
 
+  RunOptions run_options_;
+
   // Singleton
   static Framework framework_;
 };
@@ -0,0 +1,42 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace pw::perf_test::internal::counters_backend {
+
+// Counts CPU cycles, instructions, cache misses, and branch misses in user
+// space on the current thread with Linux's `perf_event_open`.
+inline constexpr size_t kMaxCounters = 4;
+
+// Opens the counters that the kernel and CPU support. Returns 0 if none could
+// be opened, e.g. because `/proc/sys/kernel/perf_event_paranoid` forbids it.
+[[nodiscard]] size_t CountersPrepare();
+
+void CountersCleanup();
+
+size_t NumCounters();
+
+const char* CounterName(size_t index);
+
+void ReadCounters(std::array<uint64_t, kMaxCounters>& values);
+
+inline uint64_t GetCounterDelta(uint64_t begin, uint64_t end) {
+  return end - begin;
+}
+
+}  // namespace pw::perf_test::internal::counters_backend
@@ -0,0 +1,42 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_perf_test/event_handler.h"
+
+namespace pw::perf_test {
+
+/// An event handler that logs each test case's results as a single line of
+/// JSON, for processing by tools such as `pw_perf_test.compare`.
+///
+/// Each line is an object with the test's `name`, the timer's `unit`, the
+/// number of measured `iterations`, and the `mean`, `min`, `max`, `p50`,
+/// `p90`, and `p99` durations. If hardware event counters are available, a
+/// `counters` object maps each counter's name to its total over the measured
+/// iterations. Other log output, including any prefix the `pw_log` backend
+/// adds to the line, is ignored by the tools. `pw_log` must not be tokenized.
+class JsonEventHandler : public EventHandler {
+ public:
+  void RunAllTestsStart(const TestRunInfo& summary) override;
+  void RunAllTestsEnd() override;
+  void TestCaseStart(const TestCase& info) override;
+  void TestCaseIteration(const TestIteration& iteration) override;
+  void TestCaseMeasure(const TestMeasurement& measurement) override;
+  void TestCaseEnd(const TestCase& info) override;
+
+ private:
+  const char* test_name_ = "";
+};
+
+}  // namespace pw::perf_test
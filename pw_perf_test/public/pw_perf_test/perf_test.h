@@ -74,4 +74,19 @@ namespace pw::perf_test {
 /// `handler` to report results.
 void RunAllTests(EventHandler& handler);
 
+/// Runs all registered tests with the given warmup and iteration `options`.
+///
+/// Example:
+/// @code{.cpp}
+///   int main() {
+///     pw::perf_test::JsonEventHandler handler;
+///     pw::perf_test::RunOptions options;
+///     options.warmup_iterations = 5;
+///     options.target_duration = 10'000'000;  // 10 ms with the chrono timer.
+///     pw::perf_test::RunAllTests(handler, options);
+///     return 0;
+///   }
+/// @endcode
+void RunAllTests(EventHandler& handler, const RunOptions& options);
+
 }  // namespace pw::perf_test
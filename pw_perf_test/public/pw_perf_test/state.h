@@ -13,15 +13,37 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <limits>
 
 #include "pw_assert/assert.h"
+#include "pw_perf_test/config.h"
 #include "pw_perf_test/event_handler.h"
+#include "pw_perf_test/internal/counters.h"
 #include "pw_perf_test/internal/timer.h"
 
 namespace pw::perf_test {
 
+/// Controls how many iterations each performance test runs.
+struct RunOptions {
+  /// Iterations to run before measuring, e.g. to warm up caches. These are
+  /// timed to calibrate `target_duration`, but are otherwise discarded.
+  int warmup_iterations = 0;
+
+  /// Number of measured iterations. When calibrating to `target_duration`,
+  /// this is the minimum number of measured iterations.
+  int iterations = 10;
+
+  /// If positive, the number of measured iterations is calibrated from the
+  /// mean warmup duration so that they take about this long in total, in the
+  /// units of the timer backend. At least one warmup iteration is run.
+  int64_t target_duration = 0;
+
+  /// The maximum number of measured iterations when calibrating.
+  int max_iterations = 10000;
+};
+
 // Forward declaration.
 class State;
 
@@ -32,6 +54,10 @@ State CreateState(int durations,
                   EventHandler& event_handler,
                   const char* test_name);
 
+State CreateState(const RunOptions& options,
+                  EventHandler& event_handler,
+                  const char* test_name);
+
 }  // namespace internal
 
 /// Records the performance of a test case over many iterations.
@@ -41,29 +67,79 @@ class State {
   // iterations and timestamps.
   bool KeepRunning();
 
+  /// Sets the number of bytes each iteration processes, e.g. the payload size
+  /// of a message sent through a pipeline, so that the results include the
+  /// throughput.
+  void SetBytesPerIteration(uint64_t bytes) { bytes_per_iteration_ = bytes; }
+
+  /// Reports a value measured by the test, such as the peak memory used, with
+  /// the results. Setting a metric again replaces its value, so it may be
+  /// updated during each iteration. `name` must outlive the test.
+  ///
+  /// At most `PW_PERF_TEST_CONFIG_MAX_METRICS` metrics may be set.
+  void SetMetric(const char* name, uint64_t value);
+
  private:
   // Allows the framework to create state objects and unit tests for the state
   // class
-  friend State internal::CreateState(int durations,
+  friend State internal::CreateState(const RunOptions& options,
                                      EventHandler& event_handler,
                                      const char* test_name);
 
+  static constexpr size_t kMaxSamples = PW_PERF_TEST_CONFIG_MAX_SAMPLES;
+  static constexpr size_t kMaxMetrics = PW_PERF_TEST_CONFIG_MAX_METRICS;
+
   // Privated constructor to prevent unauthorized instances of the state class.
-  constexpr State(int iterations,
+  constexpr State(const RunOptions& options,
                   EventHandler& event_handler,
                   const char* test_name)
-      : test_iterations_(iterations),
+      : test_iterations_(options.iterations),
+        warmup_iterations_(options.target_duration > 0 &&
+                                   options.warmup_iterations < 1
+                               ? 1
+                               : options.warmup_iterations),
+        warmup_remaining_(warmup_iterations_),
+        target_duration_(options.target_duration),
+        max_iterations_(options.max_iterations),
         iteration_start_(),
         event_handler_(&event_handler),
         test_info{.name = test_name} {
     PW_ASSERT(test_iterations_ > 0);
+    PW_ASSERT(warmup_iterations_ >= 0);
+    PW_ASSERT(target_duration_ <= 0 || max_iterations_ >= test_iterations_);
   }
 
+  // Sets the number of measured iterations from the warmup iterations.
+  void Calibrate();
+
+  // Keeps a uniform random sample of the measured iteration durations.
+  void RecordSample(int64_t duration);
+
+  // Returns the p-th percentile of the recorded samples, which must be sorted.
+  int64_t Percentile(int p) const;
+
+  // Reads the counters and timer at the start of an iteration.
+  void StartIteration();
+
+  // Reports the measurements once all iterations have run.
+  void ReportMeasurement();
+
   int64_t mean_ = -1;
 
   // Stores the total number of iterations wanted
   int test_iterations_;
 
+  // The number of warmup iterations in total and still to run.
+  int warmup_iterations_;
+  int warmup_remaining_;
+
+  // Stores the total duration of the warmup iterations.
+  int64_t warmup_duration_ = 0;
+
+  // The calibration target and limit, see RunOptions.
+  int64_t target_duration_;
+  int max_iterations_;
+
   // Stores the total duration of the tests.
   int64_t total_duration_ = 0;
 
@@ -73,9 +149,25 @@ class State {
   // Largest value of the iterations
   int64_t max_ = std::numeric_limits<int64_t>::min();
 
+  // Sampled iteration durations, used to estimate percentiles.
+  std::array<int64_t, kMaxSamples> samples_ = {};
+  size_t num_samples_ = 0;
+  uint32_t sample_random_ = 1;
+
   // Time at the start of the iteration
   internal::Timestamp iteration_start_;
 
+  // Hardware event counts at the start of the iteration, and in total over
+  // the measured iterations.
+  size_t num_counters_ = 0;
+  internal::CounterValues counters_start_ = {};
+  internal::CounterValues counter_totals_ = {};
+
+  // Values reported by the test itself.
+  uint64_t bytes_per_iteration_ = 0;
+  std::array<TestMetric, kMaxMetrics> metrics_ = {};
+  size_t num_metrics_ = 0;
+
   // The current iteration.
   int current_iteration_ = -1;
 
@@ -0,0 +1,129 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Tests for pw_perf_test.compare."""
+
+from pathlib import Path
+import tempfile
+import unittest
+
+from pw_perf_test import compare
+
+
+def _line(name: str, p50: int, unit: str = 'ns', counters: str = '') -> str:
+    return (
+        f'INF  pw_perf_test  {{"name":"{name}","unit":"{unit}",'
+        f'"iterations":10,"mean":{p50},"min":{p50},"max":{p50},'
+        f'"p50":{p50},"p90":{p50},"p99":{p50}{counters}}}\n'
+    )
+
+
+class ParseResultsTest(unittest.TestCase):
+    """Tests parsing results from logs."""
+
+    def test_ignores_other_output(self) -> None:
+        results = compare.parse_results(
+            [
+                '[ RUN      ] Foo\n',
+                'INF  {"not": "a result"}\n',
+                'INF  {"name": "truncated", "mean": \n',
+                _line('Foo', 100),
+            ]
+        )
+        self.assertEqual(list(results), ['Foo'])
+        self.assertEqual(results['Foo'].unit, 'ns')
+        self.assertEqual(results['Foo'].iterations, 10)
+        self.assertEqual(results['Foo'].metrics['p50'], 100.0)
+
+    def test_counters_per_iteration(self) -> None:
+        results = compare.parse_results(
+            [_line('Foo', 1, counters=',"counters":{"instructions":250}')]
+        )
+        self.assertEqual(results['Foo'].metrics['instructions'], 25.0)
+
+    def test_test_metrics(self) -> None:
+        results = compare.parse_results(
+            [_line('Foo', 1, counters=',"bytes":64,"metrics":{"peak":300}')]
+        )
+        self.assertEqual(results['Foo'].metrics['peak'], 300.0)
+        self.assertNotIn('bytes', results['Foo'].metrics)
+
+    def test_last_result_wins(self) -> None:
+        results = compare.parse_results([_line('Foo', 1), _line('Foo', 2)])
+        self.assertEqual(results['Foo'].metrics['p50'], 2.0)
+
+
+class CompareTest(unittest.TestCase):
+    """Tests comparing results."""
+
+    def test_change_percent(self) -> None:
+        baseline = compare.parse_results([_line('A', 100), _line('B', 100)])
+        candidate = compare.parse_results([_line('A', 110), _line('B', 90)])
+        comparisons = compare.compare(baseline, candidate)
+        self.assertEqual([c.name for c in comparisons], ['A', 'B'])
+        self.assertAlmostEqual(comparisons[0].change_percent, 10.0)
+        self.assertAlmostEqual(comparisons[1].change_percent, -10.0)
+        self.assertTrue(comparisons[0].is_regression(5))
+        self.assertFalse(comparisons[0].is_regression(15))
+        self.assertFalse(comparisons[1].is_regression(5))
+
+    def test_only_common_tests(self) -> None:
+        baseline = compare.parse_results([_line('A', 1), _line('B', 1)])
+        candidate = compare.parse_results([_line('B', 1), _line('C', 1)])
+        self.assertEqual(
+            [c.name for c in compare.compare(baseline, candidate)], ['B']
+        )
+
+    def test_missing_counter_skipped(self) -> None:
+        counters = ',"counters":{"instructions":100}'
+        baseline = compare.parse_results(
+            [_line('A', 1, counters=counters), _line('B', 1, counters=counters)]
+        )
+        candidate = compare.parse_results(
+            [_line('A', 1, counters=counters), _line('B', 1)]
+        )
+        comparisons = compare.compare(baseline, candidate, 'instructions')
+        self.assertEqual([c.name for c in comparisons], ['A'])
+
+    def test_unit_mismatch_raises(self) -> None:
+        baseline = compare.parse_results([_line('A', 1, 'ns')])
+        candidate = compare.parse_results([_line('A', 1, 'clock cycles')])
+        with self.assertRaises(ValueError):
+            compare.compare(baseline, candidate)
+
+
+class MainTest(unittest.TestCase):
+    """Tests the command line interface."""
+
+    def _run(self, baseline: str, candidate: str, *args: str) -> int:
+        with tempfile.TemporaryDirectory() as directory:
+            baseline_path = Path(directory) / 'baseline.log'
+            candidate_path = Path(directory) / 'candidate.log'
+            baseline_path.write_text(baseline)
+            candidate_path.write_text(candidate)
+            return compare.main(
+                [str(baseline_path), str(candidate_path), *args]
+            )
+
+    def test_regression_fails(self) -> None:
+        self.assertEqual(self._run(_line('A', 100), _line('A', 120)), 1)
+
+    def test_within_threshold_passes(self) -> None:
+        self.assertEqual(
+            self._run(_line('A', 100), _line('A', 120), '--threshold', '25'),
+            0,
+        )
+
+
+if __name__ == '__main__':
+    unittest.main()
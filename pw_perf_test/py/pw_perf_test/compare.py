@@ -0,0 +1,210 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Compares pw_perf_test results from two runs to find regressions.
+
+The results are the JSON lines logged by ``pw::perf_test::JsonEventHandler``.
+Any other log output is ignored.
+
+Example:
+
+  python -m pw_perf_test.compare baseline.log candidate.log --threshold 5
+"""
+
+import argparse
+from dataclasses import dataclass
+import json
+import logging
+from pathlib import Path
+import sys
+from typing import Dict, Iterable, List, Optional
+
+_LOG = logging.getLogger(__name__)
+
+METRICS = ('mean', 'min', 'max', 'p50', 'p90', 'p99')
+
+
+@dataclass(frozen=True)
+class Result:
+    """The measurements from one perf test case.
+
+    ``metrics`` holds the durations, the hardware event counts per iteration
+    by counter name, and the metrics the test set itself, such as a peak
+    memory use, by name.
+    """
+
+    name: str
+    unit: str
+    iterations: int
+    metrics: Dict[str, float]
+
+
+def parse_results(lines: Iterable[str]) -> Dict[str, Result]:
+    """Returns the results found in the log lines, by test name.
+
+    If a test appears more than once, the last result is used.
+    """
+    decoder = json.JSONDecoder()
+    results: Dict[str, Result] = {}
+    for line in lines:
+        start = line.find('{')
+        if start == -1:
+            continue
+        try:
+            entry, _ = decoder.raw_decode(line, start)
+        except json.JSONDecodeError:
+            continue
+        if not isinstance(entry, dict) or 'name' not in entry:
+            continue
+        if not all(metric in entry for metric in METRICS):
+            continue
+        iterations = int(entry.get('iterations', 0))
+        metrics = {metric: float(entry[metric]) for metric in METRICS}
+        for counter, total in entry.get('counters', {}).items():
+            metrics[counter] = float(total) / max(iterations, 1)
+        for name, value in entry.get('metrics', {}).items():
+            metrics[name] = float(value)
+        results[entry['name']] = Result(
+            name=entry['name'],
+            unit=entry.get('unit', ''),
+            iterations=iterations,
+            metrics=metrics,
+        )
+    return results
+
+
+@dataclass(frozen=True)
+class Comparison:
+    """A metric of one test case in the baseline and candidate runs."""
+
+    name: str
+    unit: str
+    baseline: float
+    candidate: float
+
+    @property
+    def change_percent(self) -> float:
+        """The relative change from the baseline, in percent."""
+        if self.baseline == 0:
+            return 0.0 if self.candidate == 0 else float('inf')
+        return (self.candidate - self.baseline) / self.baseline * 100
+
+    def is_regression(self, threshold_percent: float) -> bool:
+        """True if the candidate is slower by more than the threshold."""
+        return self.change_percent > threshold_percent
+
+
+def compare(
+    baseline: Dict[str, Result],
+    candidate: Dict[str, Result],
+    metric: str = 'p50',
+) -> List[Comparison]:
+    """Compares a metric for the tests present in both runs.
+
+    Tests that did not report the metric in both runs, e.g. a hardware counter
+    that was unavailable, are skipped.
+
+    Raises:
+      ValueError: A test was measured in different units in the two runs.
+    """
+    comparisons = []
+    for name in sorted(baseline.keys() & candidate.keys()):
+        before = baseline[name]
+        after = candidate[name]
+        if metric not in before.metrics or metric not in after.metrics:
+            _LOG.warning('%s did not report %s in both runs', name, metric)
+            continue
+        if before.unit != after.unit:
+            raise ValueError(
+                f'{name} was measured in {before.unit!r} and {after.unit!r}'
+            )
+        comparisons.append(
+            Comparison(
+                name=name,
+                unit=before.unit,
+                baseline=before.metrics[metric],
+                candidate=after.metrics[metric],
+            )
+        )
+    return comparisons
+
+
+def _parse_args(argv: Optional[List[str]]) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        'baseline', type=Path, help='Log with the baseline results'
+    )
+    parser.add_argument(
+        'candidate', type=Path, help='Log with the results to check'
+    )
+    parser.add_argument(
+        '--metric',
+        default='p50',
+        help=(
+            f'Measurement to compare: one of {", ".join(METRICS)}, or a '
+            'hardware counter such as "instructions", or a metric set by the '
+            'test (default: %(default)s)'
+        ),
+    )
+    parser.add_argument(
+        '--threshold',
+        type=float,
+        default=5.0,
+        help=(
+            'Slowdown, in percent, above which a test is reported as a '
+            'regression (default: %(default)s)'
+        ),
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    """Prints a comparison and returns 1 if any test regressed."""
+    args = _parse_args(argv)
+    with args.baseline.open() as file:
+        baseline = parse_results(file)
+    with args.candidate.open() as file:
+        candidate = parse_results(file)
+
+    for name in sorted(baseline.keys() - candidate.keys()):
+        _LOG.warning('%s is missing from the candidate results', name)
+    for name in sorted(candidate.keys() - baseline.keys()):
+        _LOG.warning('%s is missing from the baseline results', name)
+
+    try:
+        comparisons = compare(baseline, candidate, args.metric)
+    except ValueError as error:
+        _LOG.error('%s', error)
+        return 1
+
+    regressions = 0
+    for comparison in comparisons:
+        regressed = comparison.is_regression(args.threshold)
+        regressions += regressed
+        unit = comparison.unit if args.metric in METRICS else 'per iteration'
+        print(
+            f'{"REGRESSED" if regressed else "ok":<9} {comparison.name}: '
+            f'{comparison.baseline:g} -> {comparison.candidate:g} '
+            f'{unit} ({comparison.change_percent:+.1f}%)'
+        )
+
+    print(
+        f'{regressions} of {len(comparisons)} test(s) regressed by more '
+        f'than {args.threshold:g}% in {args.metric}'
+    )
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    logging.basicConfig(level=logging.INFO)
+    sys.exit(main())
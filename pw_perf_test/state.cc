@@ -14,6 +14,9 @@
 
 #include "pw_perf_test/state.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "pw_log/log.h"
 
 namespace pw::perf_test {
@@ -22,19 +25,48 @@ namespace internal {
 State CreateState(int durations,
                   EventHandler& event_handler,
                   const char* test_name) {
-  return State(durations, event_handler, test_name);
+  RunOptions options;
+  options.iterations = durations;
+  return CreateState(options, event_handler, test_name);
+}
+
+State CreateState(const RunOptions& options,
+                  EventHandler& event_handler,
+                  const char* test_name) {
+  return State(options, event_handler, test_name);
 }
+
 }  // namespace internal
 
 bool State::KeepRunning() {
   internal::Timestamp iteration_end = internal::GetCurrentTimestamp();
+  internal::CounterValues counters_end = {};
+  if (num_counters_ != 0) {
+    internal::ReadCounters(counters_end);
+  }
   if (current_iteration_ < 0) {
     current_iteration_ = 0;
+    num_counters_ = internal::NumCounters();
     event_handler_->TestCaseStart(test_info);
-    iteration_start_ = internal::GetCurrentTimestamp();
+    StartIteration();
     return true;
   }
   int64_t duration = internal::GetDuration(iteration_start_, iteration_end);
+  if (warmup_remaining_ > 0) {
+    warmup_duration_ += duration;
+    --warmup_remaining_;
+    PW_LOG_DEBUG("Warmup iteration - Duration: %ld",
+                 static_cast<long>(duration));
+    if (warmup_remaining_ == 0) {
+      Calibrate();
+    }
+    StartIteration();
+    return true;
+  }
+  for (size_t i = 0; i < num_counters_; ++i) {
+    counter_totals_[i] +=
+        internal::GetCounterDelta(counters_start_[i], counters_end[i]);
+  }
   if (duration > max_) {
     max_ = duration;
   }
@@ -42,6 +74,7 @@ bool State::KeepRunning() {
     min_ = duration;
   }
   total_duration_ += duration;
+  RecordSample(duration);
   ++current_iteration_;
   PW_LOG_DEBUG("Iteration number: %d - Duration: %ld",
                current_iteration_,
@@ -56,17 +89,91 @@ bool State::KeepRunning() {
     PW_LOG_DEBUG("Mean: %ld: ", static_cast<long>(mean_));
     PW_LOG_DEBUG("Minimum: %ld", static_cast<long>(min_));
     PW_LOG_DEBUG("Maxmimum: %ld", static_cast<long>(max_));
-    TestMeasurement test_measurement = {
-        .mean = static_cast<float>(mean_),
-        .max = static_cast<float>(max_),
-        .min = static_cast<float>(min_),
-    };
-    event_handler_->TestCaseMeasure(test_measurement);
+    ReportMeasurement();
     event_handler_->TestCaseEnd(test_info);
     return false;
   }
-  iteration_start_ = internal::GetCurrentTimestamp();
+  StartIteration();
   return true;
 }
 
+void State::SetMetric(const char* name, uint64_t value) {
+  for (size_t i = 0; i < num_metrics_; ++i) {
+    if (std::strcmp(metrics_[i].name, name) == 0) {
+      metrics_[i].value = value;
+      return;
+    }
+  }
+  PW_ASSERT(num_metrics_ < kMaxMetrics);
+  metrics_[num_metrics_++] = {name, value};
+}
+
+void State::StartIteration() {
+  // Read the counters first so that reading them is not timed.
+  if (num_counters_ != 0) {
+    internal::ReadCounters(counters_start_);
+  }
+  iteration_start_ = internal::GetCurrentTimestamp();
+}
+
+void State::ReportMeasurement() {
+  std::sort(samples_.begin(), samples_.begin() + num_samples_);
+  std::array<TestCounter, internal::kMaxCounters> counters;
+  for (size_t i = 0; i < num_counters_; ++i) {
+    counters[i] = {internal::CounterName(i), counter_totals_[i]};
+  }
+  TestMeasurement test_measurement = {
+      .mean = static_cast<float>(mean_),
+      .max = static_cast<float>(max_),
+      .min = static_cast<float>(min_),
+      .iterations = static_cast<uint32_t>(test_iterations_),
+      .p50 = static_cast<float>(Percentile(50)),
+      .p90 = static_cast<float>(Percentile(90)),
+      .p99 = static_cast<float>(Percentile(99)),
+      .counters = span(counters).first(num_counters_),
+      .bytes_per_iteration = bytes_per_iteration_,
+      .metrics = span(metrics_).first(num_metrics_),
+  };
+  event_handler_->TestCaseMeasure(test_measurement);
+}
+
+void State::Calibrate() {
+  if (target_duration_ <= 0) {
+    return;
+  }
+  const int64_t mean_warmup =
+      std::max(warmup_duration_ / warmup_iterations_, int64_t{1});
+  test_iterations_ = static_cast<int>(
+      std::clamp(target_duration_ / mean_warmup,
+                 static_cast<int64_t>(test_iterations_),
+                 static_cast<int64_t>(max_iterations_)));
+  PW_LOG_DEBUG("Calibrated to %d iterations", test_iterations_);
+}
+
+void State::RecordSample(int64_t duration) {
+  // Reservoir sampling: the n-th duration replaces a random sample with
+  // probability kMaxSamples / n.
+  const auto index = static_cast<uint32_t>(current_iteration_);
+  if (index < kMaxSamples) {
+    samples_[index] = duration;
+    num_samples_ = index + 1;
+    return;
+  }
+  sample_random_ = sample_random_ * 1664525u + 1013904223u;
+  const uint32_t replace = sample_random_ % (index + 1);
+  if (replace < kMaxSamples) {
+    samples_[replace] = duration;
+  }
+}
+
+int64_t State::Percentile(int p) const {
+  if (num_samples_ == 0) {
+    return 0;
+  }
+  // Nearest-rank method: the smallest sample with at least p% of the samples
+  // at or below it.
+  const size_t rank = (static_cast<size_t>(p) * num_samples_ + 99) / 100;
+  return samples_[std::max(rank, size_t{1}) - 1];
+}
+
 }  // namespace pw::perf_test
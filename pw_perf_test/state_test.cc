@@ -14,12 +14,45 @@
 
 #include "pw_perf_test/state.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
 #include "pw_perf_test/event_handler.h"
+#include "pw_perf_test/internal/counters.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::perf_test {
 namespace {
 
+class MeasurementEventHandler : public EventHandler {
+ public:
+  void RunAllTestsStart(const TestRunInfo&) override {}
+  void RunAllTestsEnd() override {}
+  void TestCaseStart(const TestCase&) override {}
+  void TestCaseIteration(const TestIteration&) override { ++iterations; }
+  void TestCaseMeasure(const TestMeasurement& measurement) override {
+    last_measurement = measurement;
+    // The counters are only valid during this call.
+    last_measurement.counters = {};
+    num_counters = measurement.counters.size();
+    // Neither are the metrics, so copy them.
+    last_measurement.metrics = {};
+    num_metrics = measurement.metrics.size();
+    std::copy(measurement.metrics.begin(),
+              measurement.metrics.end(),
+              metrics.begin());
+  }
+  void TestCaseEnd(const TestCase&) override {}
+
+  int iterations = 0;
+  TestMeasurement last_measurement;
+  size_t num_counters = 0;
+  size_t num_metrics = 0;
+  std::array<TestMetric, PW_PERF_TEST_CONFIG_MAX_METRICS> metrics;
+};
+
 class EmptyEventHandler : public EventHandler {
  public:
   void RunAllTestsStart(const TestRunInfo&) override {}
@@ -59,5 +92,120 @@ TEST(StateTest, SingleTest) {
   EXPECT_EQ(total_iterations, test_iterations);
 }
 
+TEST(StateTest, Warmup_NotMeasured) {
+  MeasurementEventHandler measurements;
+  RunOptions options;
+  options.warmup_iterations = 3;
+  options.iterations = 5;
+  State state_obj = internal::CreateState(options, measurements, "");
+  int total_iterations = 0;
+  while (state_obj.KeepRunning()) {
+    ++total_iterations;
+    TestFunction();
+  }
+  EXPECT_EQ(total_iterations, 8);
+  EXPECT_EQ(measurements.iterations, 5);
+  EXPECT_EQ(measurements.last_measurement.iterations, 5u);
+}
+
+TEST(StateTest, Calibrate_ShortTarget_RunsMinimumIterations) {
+  MeasurementEventHandler measurements;
+  RunOptions options;
+  options.iterations = 4;
+  options.target_duration = 1;
+  State state_obj = internal::CreateState(options, measurements, "");
+  int total_iterations = 0;
+  while (state_obj.KeepRunning()) {
+    ++total_iterations;
+    TestFunction();
+  }
+  // One warmup iteration is added to calibrate.
+  EXPECT_EQ(total_iterations, 5);
+  EXPECT_EQ(measurements.last_measurement.iterations, 4u);
+}
+
+TEST(StateTest, Calibrate_LongTarget_RunsMaximumIterations) {
+  MeasurementEventHandler measurements;
+  RunOptions options;
+  options.warmup_iterations = 2;
+  options.iterations = 1;
+  options.target_duration = std::numeric_limits<int64_t>::max();
+  options.max_iterations = 20;
+  State state_obj = internal::CreateState(options, measurements, "");
+  while (state_obj.KeepRunning()) {
+    TestFunction();
+  }
+  EXPECT_EQ(measurements.last_measurement.iterations, 20u);
+}
+
+TEST(StateTest, Percentiles_Ordered) {
+  MeasurementEventHandler measurements;
+  // Run more iterations than are sampled.
+  RunOptions options;
+  options.iterations = PW_PERF_TEST_CONFIG_MAX_SAMPLES * 2;
+  State state_obj = internal::CreateState(options, measurements, "");
+  int i = 0;
+  while (state_obj.KeepRunning()) {
+    // Make occasional iterations much slower.
+    for (int j = (++i % 10 == 0) ? 10 : 1; j > 0; --j) {
+      TestFunction();
+    }
+  }
+  const TestMeasurement& result = measurements.last_measurement;
+  EXPECT_LE(result.min, result.p50);
+  EXPECT_LE(result.p50, result.p90);
+  EXPECT_LE(result.p90, result.p99);
+  EXPECT_LE(result.p99, result.max);
+  EXPECT_GT(result.p99, result.p50);
+}
+
+TEST(StateTest, Counters_ReportedWhenPrepared) {
+  MeasurementEventHandler measurements;
+  const size_t num_counters = internal::CountersPrepare();
+  State state_obj = internal::CreateState(5, measurements, "");
+  while (state_obj.KeepRunning()) {
+    TestFunction();
+  }
+  internal::CountersCleanup();
+  EXPECT_EQ(measurements.num_counters, num_counters);
+}
+
+TEST(StateTest, BytesPerIteration_Reported) {
+  MeasurementEventHandler measurements;
+  State state_obj = internal::CreateState(3, measurements, "");
+  state_obj.SetBytesPerIteration(256);
+  while (state_obj.KeepRunning()) {
+    TestFunction();
+  }
+  EXPECT_EQ(measurements.last_measurement.bytes_per_iteration, 256u);
+}
+
+TEST(StateTest, BytesPerIteration_ZeroIfNotSet) {
+  MeasurementEventHandler measurements;
+  State state_obj = internal::CreateState(3, measurements, "");
+  while (state_obj.KeepRunning()) {
+    TestFunction();
+  }
+  EXPECT_EQ(measurements.last_measurement.bytes_per_iteration, 0u);
+  EXPECT_EQ(measurements.num_metrics, 0u);
+}
+
+TEST(StateTest, SetMetric_LastValueReported) {
+  MeasurementEventHandler measurements;
+  State state_obj = internal::CreateState(3, measurements, "");
+  uint64_t peak = 0;
+  while (state_obj.KeepRunning()) {
+    TestFunction();
+    peak += 10;
+    state_obj.SetMetric("peak_bytes", peak);
+    state_obj.SetMetric("frames", 2);
+  }
+  ASSERT_EQ(measurements.num_metrics, 2u);
+  EXPECT_STREQ(measurements.metrics[0].name, "peak_bytes");
+  EXPECT_EQ(measurements.metrics[0].value, 30u);
+  EXPECT_STREQ(measurements.metrics[1].name, "frames");
+  EXPECT_EQ(measurements.metrics[1].value, 2u);
+}
+
 }  // namespace
 }  // namespace pw::perf_test
@@ -0,0 +1,75 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_persistent_ram/persistent_record_buffer.h"
+
+#include <array>
+#include <cstring>
+
+#include "pw_checksum/crc16_ccitt.h"
+
+namespace pw::persistent_ram::internal {
+namespace {
+
+uint16_t RecordChecksum(uint32_t generation,
+                        uint16_t size,
+                        ConstByteSpan data) {
+  const auto generation_bytes = bytes::CopyInOrder(endian::little, generation);
+  const auto size_bytes = bytes::CopyInOrder(endian::little, size);
+  uint16_t crc = checksum::Crc16Ccitt::Calculate(generation_bytes);
+  crc = checksum::Crc16Ccitt::Calculate(size_bytes, crc);
+  return checksum::Crc16Ccitt::Calculate(data, crc);
+}
+
+}  // namespace
+
+size_t IntactRecordsSizeBytes(ConstByteSpan records, uint32_t generation) {
+  size_t offset = 0;
+  while (records.size() - offset >= kRecordHeaderSizeBytes) {
+    const std::byte* header = records.data() + offset;
+    const uint16_t size = bytes::ReadInOrder<uint16_t>(endian::little, header);
+    if (size > records.size() - offset - kRecordHeaderSizeBytes) {
+      break;
+    }
+    const ConstByteSpan data =
+        records.subspan(offset + kRecordHeaderSizeBytes, size);
+    if (RecordChecksum(generation, size, data) !=
+        bytes::ReadInOrder<uint16_t>(endian::little, header + 2)) {
+      break;
+    }
+    offset += kRecordHeaderSizeBytes + size;
+  }
+  return offset;
+}
+
+void WriteRecord(ByteSpan records,
+                 size_t offset,
+                 uint32_t generation,
+                 ConstByteSpan data) {
+  const uint16_t size = static_cast<uint16_t>(data.size());
+  std::memcpy(records.data() + offset + kRecordHeaderSizeBytes,
+              data.data(),
+              data.size());
+
+  const auto size_bytes = bytes::CopyInOrder(endian::little, size);
+  const auto checksum_bytes = bytes::CopyInOrder(
+      endian::little, RecordChecksum(generation, size, data));
+  std::array<std::byte, kRecordHeaderSizeBytes> header;
+  std::memcpy(header.data(), size_bytes.data(), size_bytes.size());
+  std::memcpy(header.data() + 2, checksum_bytes.data(), checksum_bytes.size());
+  std::memcpy(records.data() + offset, header.data(), header.size());
+}
+
+}  // namespace pw::persistent_ram::internal
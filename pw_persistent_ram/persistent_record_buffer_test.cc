@@ -0,0 +1,183 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_persistent_ram/persistent_record_buffer.h"
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_random/xor_shift.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::persistent_ram {
+namespace {
+
+constexpr std::string_view kFirst = "first record";
+constexpr std::string_view kSecond = "second";
+constexpr std::string_view kThird = "the third record";
+
+ConstByteSpan AsBytes(std::string_view data) { return as_bytes(span(data)); }
+
+std::string_view AsString(ConstByteSpan data) {
+  return std::string_view(reinterpret_cast<const char*>(data.data()),
+                          data.size());
+}
+
+class PersistentRecordBufferTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kBufferSize = 64;
+  using Buffer = PersistentRecordBuffer<kBufferSize>;
+
+  PersistentRecordBufferTest() { ZeroPersistentMemory(); }
+
+  // Emulate invalidation of persistent section(s).
+  void ZeroPersistentMemory() { std::memset(buffer_, 0, sizeof(buffer_)); }
+  void RandomFillMemory() {
+    random::XorShiftStarRng64 rng(0x9ad75);
+    rng.Get(buffer_);
+  }
+
+  // Emulates a boot by constructing the buffer over the persistent memory.
+  Buffer& GetPersistentRecordBuffer() { return *(new (buffer_) Buffer()); }
+
+  // Returns the persistent memory holding the buffer's records, which are the
+  // buffer's last member. kBufferSize is a multiple of its alignment.
+  ByteSpan records() {
+    return span(buffer_ + sizeof(buffer_) - kBufferSize, kBufferSize);
+  }
+
+  // Allocate a chunk of aligned storage that can be independently controlled.
+  alignas(Buffer) std::byte buffer_[sizeof(Buffer)];
+};
+
+TEST_F(PersistentRecordBufferTest, ZeroedMemoryIsEmpty) {
+  auto& persistent = GetPersistentRecordBuffer();
+  EXPECT_TRUE(persistent.empty());
+  EXPECT_EQ(persistent.Recover(), 0u);
+  EXPECT_EQ(persistent.begin(), persistent.end());
+}
+
+TEST_F(PersistentRecordBufferTest, RandomMemoryIsEmpty) {
+  RandomFillMemory();
+  auto& persistent = GetPersistentRecordBuffer();
+  EXPECT_EQ(persistent.Recover(), 0u);
+  EXPECT_TRUE(persistent.empty());
+  EXPECT_EQ(persistent.begin(), persistent.end());
+}
+
+TEST_F(PersistentRecordBufferTest, AppendAndReadBack) {
+  auto& persistent = GetPersistentRecordBuffer();
+  persistent.clear();
+  ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kFirst)));
+  ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kSecond)));
+  EXPECT_EQ(persistent.size_bytes(),
+            kFirst.size() + kSecond.size() +
+                2 * internal::kRecordHeaderSizeBytes);
+
+  auto record = persistent.begin();
+  ASSERT_NE(record, persistent.end());
+  EXPECT_EQ(AsString(*record), kFirst);
+  ++record;
+  ASSERT_NE(record, persistent.end());
+  EXPECT_EQ(AsString(*record), kSecond);
+  ++record;
+  EXPECT_EQ(record, persistent.end());
+}
+
+TEST_F(PersistentRecordBufferTest, RecordsSurviveReboot) {
+  {
+    auto& persistent = GetPersistentRecordBuffer();
+    persistent.clear();
+    ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kFirst)));
+    ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kSecond)));
+    persistent.~PersistentRecordBuffer();  // Emulate shutdown.
+  }
+
+  {  // Emulate a boot where persistent memory was kept as is.
+    auto& persistent = GetPersistentRecordBuffer();
+    ASSERT_EQ(persistent.Recover(), 2u);
+    auto record = persistent.begin();
+    EXPECT_EQ(AsString(*record++), kFirst);
+    EXPECT_EQ(AsString(*record++), kSecond);
+    EXPECT_EQ(record, persistent.end());
+
+    // Appending after recovery continues after the recovered records.
+    ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kThird)));
+    EXPECT_EQ(std::distance(persistent.begin(), persistent.end()), 3);
+  }
+}
+
+TEST_F(PersistentRecordBufferTest, TornRecordIsDropped) {
+  size_t intact_size_bytes;
+  {
+    auto& persistent = GetPersistentRecordBuffer();
+    persistent.clear();
+    ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kFirst)));
+    intact_size_bytes = persistent.size_bytes();
+    ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kThird)));
+  }
+
+  // Emulate a reset part way through writing the last record's data.
+  records()[intact_size_bytes + internal::kRecordHeaderSizeBytes + 1] ^=
+      std::byte{0xff};
+
+  {
+    auto& persistent = GetPersistentRecordBuffer();
+    ASSERT_EQ(persistent.Recover(), 1u);
+    EXPECT_EQ(persistent.size_bytes(), intact_size_bytes);
+    EXPECT_EQ(AsString(*persistent.begin()), kFirst);
+
+    // The torn record's space is reused.
+    ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kSecond)));
+    EXPECT_EQ(persistent.Recover(), 2u);
+  }
+}
+
+TEST_F(PersistentRecordBufferTest, ClearDoesNotResurrectStaleRecords) {
+  auto& persistent = GetPersistentRecordBuffer();
+  persistent.clear();
+  ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kFirst)));
+  ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kSecond)));
+
+  persistent.clear();
+  EXPECT_TRUE(persistent.empty());
+
+  // Records written before the clear() are not recovered, even though they are
+  // still in memory.
+  EXPECT_EQ(persistent.Recover(), 0u);
+
+  ASSERT_EQ(OkStatus(), persistent.Append(AsBytes(kFirst)));
+  EXPECT_EQ(persistent.Recover(), 1u);
+}
+
+TEST_F(PersistentRecordBufferTest, AppendFailsWhenFull) {
+  auto& persistent = GetPersistentRecordBuffer();
+  persistent.clear();
+
+  std::byte record[Buffer::max_record_size_bytes() + 1] = {};
+  EXPECT_EQ(Status::ResourceExhausted(), persistent.Append(record));
+  EXPECT_TRUE(persistent.empty());
+
+  ASSERT_EQ(OkStatus(), persistent.Append(span(record).first(kBufferSize / 2)));
+  EXPECT_EQ(Status::ResourceExhausted(),
+            persistent.Append(span(record).first(kBufferSize / 2)));
+  EXPECT_EQ(persistent.Recover(), 1u);
+}
+
+}  // namespace
+}  // namespace pw::persistent_ram
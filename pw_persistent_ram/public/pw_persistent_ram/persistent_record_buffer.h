@@ -0,0 +1,219 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "pw_bytes/endian.h"
+#include "pw_bytes/span.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_status/status.h"
+
+namespace pw::persistent_ram {
+namespace internal {
+
+// Each record is stored as a 2-byte little-endian data size and a 2-byte
+// little-endian CRC16 of the buffer's generation, the data size, and the data,
+// followed by the data.
+inline constexpr size_t kRecordHeaderSizeBytes = 4;
+inline constexpr size_t kMaxRecordSizeBytes = 0xffff;
+
+// Returns the number of bytes at the start of records that hold intact records
+// from the given generation.
+size_t IntactRecordsSizeBytes(ConstByteSpan records, uint32_t generation);
+
+// Writes a record at offset, which must leave room for the record's header and
+// data. The header is written last, so its checksum only matches once the
+// whole record is written.
+void WriteRecord(ByteSpan records,
+                 size_t offset,
+                 uint32_t generation,
+                 ConstByteSpan data);
+
+}  // namespace internal
+
+// Iterates over the data of each record in a PersistentRecordBuffer.
+class PersistentRecordIterator {
+ public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = ConstByteSpan;
+  using pointer = const ConstByteSpan*;
+  using reference = const ConstByteSpan&;
+  using iterator_category = std::forward_iterator_tag;
+
+  constexpr PersistentRecordIterator() = default;
+
+  reference operator*() const { return record_; }
+  pointer operator->() const { return &record_; }
+
+  PersistentRecordIterator& operator++() {
+    remaining_ = remaining_.subspan(internal::kRecordHeaderSizeBytes +
+                                    record_.size());
+    ReadRecord();
+    return *this;
+  }
+
+  PersistentRecordIterator operator++(int) {
+    PersistentRecordIterator previous = *this;
+    ++*this;
+    return previous;
+  }
+
+  bool operator==(const PersistentRecordIterator& rhs) const {
+    return remaining_.data() == rhs.remaining_.data();
+  }
+  bool operator!=(const PersistentRecordIterator& rhs) const {
+    return !(*this == rhs);
+  }
+
+ private:
+  template <size_t>
+  friend class PersistentRecordBuffer;
+
+  // Iterates over the intact records found by
+  // internal::IntactRecordsSizeBytes().
+  explicit PersistentRecordIterator(ConstByteSpan records)
+      : remaining_(records) {
+    ReadRecord();
+  }
+
+  void ReadRecord() {
+    if (remaining_.size() < internal::kRecordHeaderSizeBytes) {
+      record_ = ConstByteSpan();
+      return;
+    }
+    record_ = remaining_.subspan(
+        internal::kRecordHeaderSizeBytes,
+        bytes::ReadInOrder<uint16_t>(endian::little, remaining_.data()));
+  }
+
+  ConstByteSpan remaining_;
+  ConstByteSpan record_;
+};
+
+// The PersistentRecordBuffer class intentionally uses uninitialized memory,
+// which triggers compiler warnings. Disable those warnings for this file.
+PW_MODIFY_DIAGNOSTICS_PUSH();
+PW_MODIFY_DIAGNOSTIC(ignored, "-Wuninitialized");
+PW_MODIFY_DIAGNOSTIC_GCC(ignored, "-Wmaybe-uninitialized");
+
+// A persistent buffer of variable-length records, each with its own checksum.
+// Like a PersistentBuffer, it is safe to use before static constructors run
+// and keeps its contents across soft resets.
+//
+// Unlike a PersistentBuffer, whose single checksum covers all of its data,
+// appending a record only checksums that record. This makes Append() cheap
+// enough for fault handlers. If a reset interrupts an Append(), only the
+// record being appended is lost: Recover() keeps every record before it.
+//
+// Each call to clear() starts a new generation, which is mixed into the
+// records' checksums, so stale records from before the clear() are never
+// recovered.
+template <size_t kMaxSizeBytes>
+class PersistentRecordBuffer {
+ public:
+  static_assert(kMaxSizeBytes > internal::kRecordHeaderSizeBytes);
+
+  using iterator = PersistentRecordIterator;
+  using const_iterator = PersistentRecordIterator;
+
+  // The largest record that can be stored.
+  static constexpr size_t max_record_size_bytes() {
+    return std::min(kMaxSizeBytes - internal::kRecordHeaderSizeBytes,
+                    internal::kMaxRecordSizeBytes);
+  }
+
+  // The default constructor intentionally does not initialize anything, so
+  // that a buffer statically allocated in persistent RAM keeps its records.
+  // See PersistentBuffer.
+  PersistentRecordBuffer() {}
+  // Disable copy and move constructors.
+  PersistentRecordBuffer(const PersistentRecordBuffer&) = delete;
+  PersistentRecordBuffer(PersistentRecordBuffer&&) = delete;
+  // Explicit no-op destructor.
+  ~PersistentRecordBuffer() {}
+
+  // Appends a record. Takes time proportional to the record's size once the
+  // buffer's state is known, i.e. after Recover(), clear(), or a previous
+  // Append() since boot. Returns:
+  //
+  //   OK - The record was appended.
+  //   RESOURCE_EXHAUSTED - There is not enough room for the record.
+  //
+  Status Append(ConstByteSpan record) {
+    const size_t offset = size_bytes();
+    if (record.size() > max_record_size_bytes() ||
+        record.size() + internal::kRecordHeaderSizeBytes >
+            kMaxSizeBytes - offset) {
+      return Status::ResourceExhausted();
+    }
+    internal::WriteRecord(records(), offset, generation_, record);
+    set_size_bytes(offset + internal::kRecordHeaderSizeBytes + record.size());
+    return OkStatus();
+  }
+
+  // Checks the checksum of every record, and drops the first torn or corrupt
+  // record along with any records after it. Returns the number of records
+  // kept. Call this on boot, before reading or appending records.
+  size_t Recover() {
+    set_size_bytes(internal::IntactRecordsSizeBytes(records(), generation_));
+    return static_cast<size_t>(std::distance(begin(), end()));
+  }
+
+  // The number of bytes used by records, including their headers.
+  size_t size_bytes() const {
+    if (size_bytes_check_ == ~size_bytes_ && size_bytes_ <= kMaxSizeBytes) {
+      return size_bytes_;
+    }
+    return internal::IntactRecordsSizeBytes(records(), generation_);
+  }
+
+  bool empty() const { return size_bytes() == 0; }
+
+  const_iterator begin() const {
+    return PersistentRecordIterator(records().first(size_bytes()));
+  }
+  const_iterator end() const {
+    return PersistentRecordIterator(records().subspan(size_bytes()));
+  }
+
+  void clear() {
+    generation_ = generation_ + 1;  // ++ on a volatile is deprecated in C++20
+    set_size_bytes(0);
+  }
+
+ private:
+  ByteSpan records() const {
+    return ByteSpan(const_cast<std::byte*>(buffer_), kMaxSizeBytes);
+  }
+
+  void set_size_bytes(size_t size_bytes) {
+    size_bytes_ = size_bytes;
+    size_bytes_check_ = ~size_bytes;
+  }
+
+  // None of these members are initialized by the constructor by design.
+  volatile uint32_t generation_;
+  volatile size_t size_bytes_;
+  volatile size_t size_bytes_check_;
+  volatile std::byte buffer_[kMaxSizeBytes];
+};
+
+PW_MODIFY_DIAGNOSTICS_POP();
+
+}  // namespace pw::persistent_ram
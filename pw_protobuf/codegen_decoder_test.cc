@@ -1271,5 +1271,49 @@ TEST(Codegen, FindStream) {
   EXPECT_EQ(Pigweed::FindMagicNumber(reader).status(), Status::NotFound());
 }
 
+TEST(Codegen, View) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+    // pigweed.error_message
+    0x2a, 0x10, 'n', 'o', 't', ' ', 'a', ' ',
+    't', 'y', 'p', 'e', 'w', 'r', 'i', 't', 'e', 'r',
+    // pigweed.bin
+    0x40, 0x01,
+    // pigweed.pigweed
+    0x3a, 0x02,
+    // pigweed.pigweed.status
+    0x08, 0x02,
+  };
+  // clang-format on
+
+  const Pigweed::View view(as_bytes(span(proto_data)));
+  EXPECT_EQ(view.magic_number().value(), 0x49u);
+  EXPECT_EQ(view.ziggy().value(), -111);
+  EXPECT_EQ(view.bin().value(), Pigweed::Protobuf::Binary::ZERO);
+
+  // Strings and submessages refer to the original buffer.
+  Result<std::string_view> error_message = view.error_message();
+  ASSERT_EQ(error_message.status(), OkStatus());
+  EXPECT_EQ(*error_message, "not a typewriter");
+  EXPECT_EQ(static_cast<const void*>(error_message->data()),
+            static_cast<const void*>(&proto_data[7]));
+
+  Result<ConstByteSpan> pigweed = view.pigweed();
+  ASSERT_EQ(pigweed.status(), OkStatus());
+  EXPECT_EQ(static_cast<const void*>(pigweed->data()),
+            static_cast<const void*>(&proto_data[27]));
+
+  const Pigweed::Pigweed::View nested_view(*pigweed);
+  EXPECT_EQ(nested_view.status().value(), Bool::FILE_NOT_FOUND);
+
+  // Nonexisting fields.
+  EXPECT_EQ(view.data().status(), Status::NotFound());
+  EXPECT_EQ(view.description().status(), Status::NotFound());
+}
+
 }  // namespace
 }  // namespace pw::protobuf
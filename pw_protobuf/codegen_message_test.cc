@@ -393,6 +393,38 @@ TEST(CodegenMessage, Read) {
   EXPECT_EQ(message.bungle, -111);
 }
 
+TEST(CodegenMessage, ReadOutOfOrder) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.bungle
+    0x70, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+    // pigweed.ratio
+    0x25, 0x8f, 0xc2, 0xb5, 0xbf,
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.bin
+    0x40, 0x01,
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+    // pigweed.magic_number, again; the last value wins.
+    0x08, 0x4a,
+  };
+  // clang-format on
+
+  stream::MemoryReader reader(as_bytes(span(proto_data)));
+  Pigweed::StreamDecoder pigweed(reader);
+
+  Pigweed::Message message{};
+  const auto status = pigweed.Read(message);
+  ASSERT_EQ(status, OkStatus());
+
+  EXPECT_EQ(message.magic_number, 0x4au);
+  EXPECT_EQ(message.ziggy, -111);
+  EXPECT_EQ(message.ratio, -1.42f);
+  EXPECT_EQ(message.bin, Pigweed::Protobuf::Binary::ZERO);
+  EXPECT_EQ(message.bungle, -111);
+}
+
 TEST(CodegenMessage, ReadNonPackedScalar) {
   // clang-format off
   constexpr uint8_t proto_data[] = {
@@ -1646,6 +1678,64 @@ TEST(CodegenMessage, WriteNestedImported) {
             0);
 }
 
+TEST(CodegenMessage, WriteNestedWithoutScratchBuffer) {
+  Period::Message message{};
+  message.start.seconds = 1517949900u;
+  message.end.seconds = 1517950378u;
+
+  // Submessages without callbacks are sized up front and written directly to
+  // the stream, so no scratch buffer is needed.
+  std::byte encode_buffer[Period::kMaxEncodedSizeBytes];
+  stream::MemoryWriter writer(encode_buffer);
+  Period::StreamEncoder period(writer, ByteSpan());
+
+  const auto status = period.Write(message);
+  ASSERT_EQ(status, OkStatus());
+
+  // clang-format off
+  constexpr uint8_t expected_proto[] = {
+    // period.start
+    0x0a, 0x06,
+    // period.start.seconds v=1517949900
+    0x08, 0xcc, 0xa7, 0xe8, 0xd3, 0x05,
+    // period.end
+    0x12, 0x06,
+    // period.end.seconds, v=1517950378
+    0x08, 0xaa, 0xab, 0xe8, 0xd3, 0x05,
+  };
+  // clang-format on
+
+  ConstByteSpan result = writer.WrittenData();
+  EXPECT_EQ(result.size(), sizeof(expected_proto));
+  EXPECT_EQ(std::memcmp(result.data(), expected_proto, sizeof(expected_proto)),
+            0);
+}
+
+TEST(CodegenMessage, SerializedSize) {
+  Period::Message message{};
+  EXPECT_EQ(Period::StreamEncoder::SerializedSize(message).status(),
+            OkStatus());
+  EXPECT_EQ(Period::StreamEncoder::SerializedSize(message).size(), 0u);
+
+  message.start.seconds = 1517949900u;
+  message.end.seconds = 1517950378u;
+  EXPECT_EQ(Period::StreamEncoder::SerializedSize(message).size(), 16u);
+  EXPECT_EQ(Period::MemoryEncoder::SerializedSize(message).size(), 16u);
+
+  std::byte encode_buffer[Period::kMaxEncodedSizeBytes];
+  Period::MemoryEncoder period(encode_buffer);
+  ASSERT_EQ(period.Write(message), OkStatus());
+  EXPECT_EQ(period.size(), 16u);
+}
+
+TEST(CodegenMessage, SerializedSizeCallback) {
+  // pigweed.device_info has use_callback=true, so the message's size cannot be
+  // calculated without running the callback.
+  Pigweed::Message message{};
+  EXPECT_EQ(Pigweed::StreamEncoder::SerializedSize(message).status(),
+            Status::Unimplemented());
+}
+
 TEST(CodegenMessage, WriteNestedRepeated) {
   RepeatedTest::Message message{};
   // Repeated nested messages require a callback since there would otherwise be
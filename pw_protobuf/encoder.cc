@@ -37,6 +37,116 @@ namespace pw::protobuf {
 
 using internal::VarintType;
 
+namespace {
+
+// Returns the payload size of a packed varint field, matching the encoding of
+// StreamEncoder::WritePackedVarints().
+template <typename T>
+size_t SizeOfPackedVarints(span<T> values, VarintType encode_type) {
+  size_t payload_size = 0;
+  for (T val : values) {
+    if (encode_type == VarintType::kZigZag) {
+      int64_t integer =
+          static_cast<int64_t>(static_cast<std::make_signed_t<T>>(val));
+      payload_size += varint::EncodedSize(varint::ZigZagEncode(integer));
+    } else {
+      payload_size += varint::EncodedSize(static_cast<uint64_t>(val));
+    }
+  }
+  return payload_size;
+}
+
+// Returns the size of a repeated varint field stored in a vector.
+template <typename T>
+size_t SizeOfPackedVarintVector(uint32_t field_number,
+                                const std::byte* raw_vector,
+                                VarintType encode_type) {
+  const auto& vector = *reinterpret_cast<const pw::Vector<T>*>(raw_vector);
+  if (vector.empty()) {
+    return 0;
+  }
+  const size_t payload_size =
+      SizeOfPackedVarints(span(vector.data(), vector.size()), encode_type);
+  return SizeOfField(field_number, WireType::kDelimited, payload_size);
+}
+
+// Returns the size of a length-delimited field, which is omitted when empty.
+size_t SizeOfNonEmptyDelimitedField(uint32_t field_number, size_t size) {
+  return size == 0 ? 0
+                   : SizeOfField(field_number, WireType::kDelimited, size);
+}
+
+// Returns true if all bytes of a struct member are zero, in which case
+// StreamEncoder::Write() omits it.
+bool IsZero(span<const std::byte> values) {
+  return static_cast<size_t>(
+             std::count(values.begin(), values.end(), std::byte{0})) ==
+         values.size();
+}
+
+// Returns the value of a singular or optional varint struct member, or
+// std::nullopt if the field is omitted, matching StreamEncoder::Write().
+std::optional<uint64_t> VarintValue(const internal::MessageField& field,
+                                    span<const std::byte> values) {
+  const std::byte* data = values.data();
+  if (field.is_optional()) {
+    if (field.elem_size() == sizeof(uint64_t)) {
+      if (field.varint_type() == VarintType::kUnsigned) {
+        return *reinterpret_cast<const std::optional<uint64_t>*>(data);
+      }
+      const auto& optional =
+          *reinterpret_cast<const std::optional<int64_t>*>(data);
+      if (!optional.has_value()) {
+        return std::nullopt;
+      }
+      return field.varint_type() == VarintType::kZigZag
+                 ? varint::ZigZagEncode(optional.value())
+                 : static_cast<uint64_t>(optional.value());
+    }
+    if (field.elem_size() == sizeof(uint32_t)) {
+      if (field.varint_type() == VarintType::kUnsigned) {
+        return *reinterpret_cast<const std::optional<uint32_t>*>(data);
+      }
+      const auto& optional =
+          *reinterpret_cast<const std::optional<int32_t>*>(data);
+      if (!optional.has_value()) {
+        return std::nullopt;
+      }
+      return field.varint_type() == VarintType::kZigZag
+                 ? varint::ZigZagEncode(optional.value())
+                 : static_cast<uint64_t>(optional.value());
+    }
+    return *reinterpret_cast<const std::optional<bool>*>(data);
+  }
+
+  uint64_t value = 0;
+  if (field.elem_size() == sizeof(uint64_t)) {
+    if (field.varint_type() == VarintType::kZigZag) {
+      value = varint::ZigZagEncode(*reinterpret_cast<const int64_t*>(data));
+    } else if (field.varint_type() == VarintType::kNormal) {
+      value = static_cast<uint64_t>(*reinterpret_cast<const int64_t*>(data));
+    } else {
+      value = *reinterpret_cast<const uint64_t*>(data);
+    }
+  } else if (field.elem_size() == sizeof(uint32_t)) {
+    if (field.varint_type() == VarintType::kZigZag) {
+      value = varint::ZigZagEncode(*reinterpret_cast<const int32_t*>(data));
+    } else if (field.varint_type() == VarintType::kNormal) {
+      value = static_cast<uint64_t>(*reinterpret_cast<const int32_t*>(data));
+    } else {
+      value = *reinterpret_cast<const uint32_t*>(data);
+    }
+  } else if (field.elem_size() == sizeof(bool)) {
+    value = *reinterpret_cast<const bool*>(data);
+  }
+  if (value == 0) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+}  // namespace
+
 StreamEncoder StreamEncoder::GetNestedEncoder(uint32_t field_number,
                                               bool write_when_empty) {
   PW_CHECK(!nested_encoder_open());
@@ -244,6 +354,151 @@ Status StreamEncoder::UpdateStatusForWrite(uint32_t field_number,
   return status_;
 }
 
+StatusWithSize StreamEncoder::SizeOfMessage(
+    span<const std::byte> message, span<const internal::MessageField> table) {
+  size_t size = 0;
+
+  // Each case mirrors the corresponding case of Write() below.
+  for (const auto& field : table) {
+    const auto values =
+        message.subspan(field.field_offset(), field.field_size());
+    PW_CHECK(values.begin() >= message.begin() &&
+             values.end() <= message.end());
+    const uint32_t field_number = field.field_number();
+
+    if (field.use_callback()) {
+      return StatusWithSize::Unimplemented();
+    }
+
+    switch (field.wire_type()) {
+      case WireType::kFixed64:
+      case WireType::kFixed32: {
+        if (field.is_fixed_size()) {
+          if (!IsZero(values)) {
+            size += SizeOfField(
+                field_number, WireType::kDelimited, values.size());
+          }
+        } else if (field.is_repeated()) {
+          const size_t count =
+              field.elem_size() == sizeof(uint64_t)
+                  ? reinterpret_cast<const pw::Vector<const uint64_t>*>(
+                        values.data())
+                        ->size()
+                  : reinterpret_cast<const pw::Vector<const uint32_t>*>(
+                        values.data())
+                        ->size();
+          size += SizeOfNonEmptyDelimitedField(field_number,
+                                               count * field.elem_size());
+        } else if (field.is_optional()) {
+          const bool has_value =
+              field.elem_size() == sizeof(uint64_t)
+                  ? reinterpret_cast<const std::optional<uint64_t>*>(
+                        values.data())
+                        ->has_value()
+                  : reinterpret_cast<const std::optional<uint32_t>*>(
+                        values.data())
+                        ->has_value();
+          if (has_value) {
+            size += SizeOfField(
+                field_number, field.wire_type(), field.elem_size());
+          }
+        } else if (!IsZero(values)) {
+          size += SizeOfField(field_number, field.wire_type(), values.size());
+        }
+        break;
+      }
+      case WireType::kVarint: {
+        if (field.is_fixed_size()) {
+          if (IsZero(values)) {
+            continue;
+          }
+          size_t payload_size = 0;
+          const size_t count = values.size() / field.elem_size();
+          if (field.elem_size() == sizeof(uint64_t)) {
+            payload_size = SizeOfPackedVarints(
+                span(reinterpret_cast<const uint64_t*>(values.data()), count),
+                field.varint_type());
+          } else if (field.elem_size() == sizeof(uint32_t)) {
+            payload_size = SizeOfPackedVarints(
+                span(reinterpret_cast<const uint32_t*>(values.data()), count),
+                field.varint_type());
+          } else if (field.elem_size() == sizeof(bool)) {
+            payload_size = SizeOfPackedVarints(
+                span(reinterpret_cast<const uint8_t*>(values.data()), count),
+                field.varint_type());
+          }
+          size += SizeOfField(field_number, WireType::kDelimited, payload_size);
+        } else if (field.is_repeated()) {
+          if (field.elem_size() == sizeof(uint64_t)) {
+            size += SizeOfPackedVarintVector<const uint64_t>(
+                field_number, values.data(), field.varint_type());
+          } else if (field.elem_size() == sizeof(uint32_t)) {
+            size += SizeOfPackedVarintVector<const uint32_t>(
+                field_number, values.data(), field.varint_type());
+          } else if (field.elem_size() == sizeof(bool)) {
+            size += SizeOfPackedVarintVector<const uint8_t>(
+                field_number, values.data(), field.varint_type());
+          }
+        } else if (const std::optional<uint64_t> value =
+                       VarintValue(field, values);
+                   value.has_value()) {
+          size += SizeOfVarintField(field_number, *value);
+        }
+        break;
+      }
+      case WireType::kDelimited: {
+        if (field.nested_message_fields()) {
+          const StatusWithSize nested_size =
+              SizeOfMessage(values, *field.nested_message_fields());
+          PW_TRY_WITH_SIZE(nested_size);
+          size +=
+              SizeOfNonEmptyDelimitedField(field_number, nested_size.size());
+        } else if (field.is_fixed_size()) {
+          if (!IsZero(values)) {
+            size += SizeOfField(
+                field_number, WireType::kDelimited, values.size());
+          }
+        } else if (field.is_string()) {
+          size += SizeOfNonEmptyDelimitedField(
+              field_number,
+              reinterpret_cast<const InlineString<>*>(values.data())->size());
+        } else {
+          size += SizeOfNonEmptyDelimitedField(
+              field_number,
+              reinterpret_cast<const Vector<const std::byte>*>(values.data())
+                  ->size());
+        }
+        break;
+      }
+    }
+  }
+
+  return StatusWithSize(size);
+}
+
+Status StreamEncoder::WriteNestedMessage(
+    uint32_t field_number,
+    span<const std::byte> message,
+    span<const internal::MessageField> table,
+    size_t size) {
+  // Submessages are only written when they contain data, as when they are
+  // encoded with a nested encoder.
+  if (size == 0) {
+    return status_;
+  }
+
+  if (varint::EncodedSize(size) > config::kMaxVarintSize) {
+    status_ = Status::OutOfRange();
+    return status_;
+  }
+
+  PW_TRY(UpdateStatusForWrite(field_number, WireType::kDelimited, size));
+  status_.Update(
+      WriteLengthDelimitedKeyAndLengthPrefix(field_number, size, writer_));
+  PW_TRY(status_);
+  return Write(message, table);
+}
+
 Status StreamEncoder::Write(span<const std::byte> message,
                             span<const internal::MessageField> table) {
   PW_CHECK(!nested_encoder_open());
@@ -525,8 +780,20 @@ Status StreamEncoder::Write(span<const std::byte> message,
                  "Repeated delimited messages always require a callback");
         if (field.nested_message_fields()) {
           // Nested Message. Struct member is an embedded struct for the
-          // nested field. Obtain a nested encoder and recursively call Write()
-          // using the fields table pointer from this field.
+          // nested field. If its size can be calculated up front, write the
+          // length prefix and recursively call Write() on this encoder, so the
+          // submessage goes straight to the stream. Otherwise obtain a nested
+          // encoder, which buffers the submessage in the scratch buffer, and
+          // recursively call Write() on that.
+          const StatusWithSize nested_size =
+              SizeOfMessage(values, *field.nested_message_fields());
+          if (nested_size.ok()) {
+            PW_TRY(WriteNestedMessage(field.field_number(),
+                                      values,
+                                      *field.nested_message_fields(),
+                                      nested_size.size()));
+            continue;
+          }
           auto nested_encoder = GetNestedEncoder(field.field_number(),
                                                  /*write_when_empty=*/false);
           PW_TRY(nested_encoder.Write(values, *field.nested_message_fields()));
@@ -125,6 +125,129 @@ TEST(FindStream, WrongWireType) {
   EXPECT_EQ(FindUint32(reader, 5).status(), Status::FailedPrecondition());
 }
 
+TEST(FindFields, PresentFields) {
+  Result<int32_t> field1;
+  Result<int32_t> field2;
+  Result<double> field4;
+  Result<std::string_view> field6;
+  Result<ConstByteSpan> field7;
+  ASSERT_EQ(FindFields(encoded_proto,
+                       Int32Target(1, field1),
+                       Sint32Target(2, field2),
+                       DoubleTarget(4, field4),
+                       StringTarget(6, field6),
+                       SubmessageTarget(7, field7)),
+            OkStatus());
+
+  EXPECT_EQ(field1.value(), 42);
+  EXPECT_EQ(field2.value(), -13);
+  EXPECT_EQ(field4.value(), 3.14159);
+  ASSERT_EQ(field6.status(), OkStatus());
+  InlineString<32> str(*field6);
+  EXPECT_STREQ(str.c_str(), "Hello world");
+  ASSERT_EQ(field7.status(), OkStatus());
+  EXPECT_EQ(FindUint32(*field7, 1).value(), 3u);
+}
+
+TEST(FindFields, MissingAndWrongTypeFields) {
+  Result<uint32_t> field5;
+  Result<uint32_t> field8;
+  Result<bool> field3;
+  ASSERT_EQ(FindFields(encoded_proto,
+                       Uint32Target(5, field5),
+                       Uint32Target(8, field8),
+                       BoolTarget(3, field3)),
+            OkStatus());
+
+  EXPECT_EQ(field5.status(), Status::FailedPrecondition());
+  EXPECT_EQ(field8.status(), Status::NotFound());
+  EXPECT_EQ(field3.value(), false);
+}
+
+TEST(FindFields, InvalidFieldNumber) {
+  Result<uint32_t> field1;
+  Result<uint32_t> field0;
+  EXPECT_EQ(FindFields(encoded_proto,
+                       Uint32Target(1, field1),
+                       Uint32Target(0, field0)),
+            Status::InvalidArgument());
+  EXPECT_EQ(field1.status(), Status::NotFound());
+}
+
+TEST(FindFields, StringBufferTooSmall) {
+  char buffer[4];
+  Result<std::string_view> field6;
+  Result<uint32_t> field5;
+  ASSERT_EQ(FindFields(encoded_proto,
+                       StringTarget(6, buffer, field6),
+                       Fixed32Target(5, field5)),
+            OkStatus());
+  EXPECT_EQ(field6.status(), Status::ResourceExhausted());
+  EXPECT_EQ(field5.value(), 0xdeadbeef);
+}
+
+TEST(FindFieldsStream, PresentFields) {
+  stream::MemoryReader reader(encoded_proto);
+
+  char str[32];
+  Result<int32_t> field1;
+  Result<bool> field3;
+  Result<uint32_t> field5;
+  Result<std::string_view> field6;
+  ASSERT_EQ(FindFields(reader,
+                       StringTarget(6, str, field6),
+                       Int32Target(1, field1),
+                       BoolTarget(3, field3),
+                       Fixed32Target(5, field5)),
+            OkStatus());
+
+  EXPECT_EQ(field1.value(), 42);
+  EXPECT_EQ(field3.value(), false);
+  EXPECT_EQ(field5.value(), 0xdeadbeef);
+  ASSERT_EQ(field6.status(), OkStatus());
+  EXPECT_EQ(*field6, "Hello world");
+}
+
+TEST(FindFieldsStream, MissingField) {
+  stream::MemoryReader reader(encoded_proto);
+
+  std::byte buffer[8];
+  Result<ConstByteSpan> field7;
+  Result<uint64_t> field9;
+  ASSERT_EQ(FindFields(reader,
+                       BytesTarget(7, buffer, field7),
+                       Uint64Target(9, field9)),
+            OkStatus());
+
+  ASSERT_EQ(field7.status(), OkStatus());
+  EXPECT_EQ(field7->size(), 2u);
+  EXPECT_EQ(field9.status(), Status::NotFound());
+}
+
+TEST(FindFieldsStream, WrongWireTypeStopsSearch) {
+  stream::MemoryReader reader(encoded_proto);
+
+  Result<uint32_t> field5;
+  Result<uint32_t> field7;
+  EXPECT_EQ(
+      FindFields(reader, Uint32Target(5, field5), Uint32Target(7, field7)),
+      Status::FailedPrecondition());
+  EXPECT_EQ(field5.status(), Status::FailedPrecondition());
+  EXPECT_EQ(field7.status(), Status::NotFound());
+}
+
+TEST(FindFieldsStream, StopsAfterLastField) {
+  stream::MemoryReader reader(encoded_proto);
+
+  Result<int32_t> field1;
+  Result<int32_t> field2;
+  ASSERT_EQ(FindFields(reader, Int32Target(1, field1), Sint32Target(2, field2)),
+            OkStatus());
+  EXPECT_EQ(field1.value(), 42);
+  EXPECT_EQ(field2.value(), -13);
+  EXPECT_EQ(reader.bytes_read(), 4u);
+}
+
 enum class Fields : uint32_t {
   kField1 = 1,
   kField2 = 2,
@@ -149,5 +272,16 @@ TEST(FindEnum, PresentField) {
   EXPECT_STREQ(str.c_str(), "Hello world");
 }
 
+TEST(FindEnum, FindFields) {
+  Result<int32_t> field1;
+  Result<uint32_t> field5;
+  ASSERT_EQ(FindFields(encoded_proto,
+                       Int32Target(Fields::kField1, field1),
+                       Fixed32Target(Fields::kField5, field5)),
+            OkStatus());
+  EXPECT_EQ(field1.value(), 42);
+  EXPECT_EQ(field5.value(), 0xdeadbeef);
+}
+
 }  // namespace
 }  // namespace pw::protobuf
@@ -0,0 +1,48 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_protobuf/internal/message_view.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace pw::protobuf::internal {
+
+Status BasicMessageView::Index(ConstByteSpan message,
+                               span<const uint32_t> field_numbers,
+                               span<uint32_t> offsets) {
+  std::fill(offsets.begin(), offsets.end(), kNotPresent);
+
+  Decoder decoder(message);
+  Status status;
+  size_t remaining = field_numbers.size();
+  while (remaining > 0 && (status = decoder.Next()).ok()) {
+    const auto field = std::find(
+        field_numbers.begin(), field_numbers.end(), decoder.FieldNumber());
+    if (field == field_numbers.end()) {
+      continue;
+    }
+
+    uint32_t& offset = offsets[static_cast<size_t>(
+        std::distance(field_numbers.begin(), field))];
+    if (offset == kNotPresent) {
+      offset = static_cast<uint32_t>(decoder.proto_.data() - message.data());
+      remaining -= 1;
+    }
+  }
+
+  return status.IsOutOfRange() ? OkStatus() : status;
+}
+
+}  // namespace pw::protobuf::internal
@@ -0,0 +1,126 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_protobuf/internal/message_view.h"
+
+#include <array>
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::protobuf {
+namespace {
+
+// clang-format off
+constexpr uint8_t _encoded_proto[] = {
+  // type=int32, k=1, v=42
+  0x08, 0x2a,
+  // type=sint32, k=2, v=-13
+  0x10, 0x19,
+  // type=double, k=4, v=3.14159
+  0x21, 0x6e, 0x86, 0x1b, 0xf0, 0xf9, 0x21, 0x09, 0x40,
+  // type=fixed32, k=5, v=0xdeadbeef
+  0x2d, 0xef, 0xbe, 0xad, 0xde,
+  // type=string, k=6, v="Hello world"
+  0x32, 0x0b, 'H', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd',
+  // type=message, k=7, len=2
+  0x3a, 0x02,
+  // (nested) type=uint32, k=1, v=3
+  0x08, 0x03,
+  // type=int32, k=1, v=7
+  0x08, 0x07,
+};
+// clang-format on
+ConstByteSpan encoded_proto(as_bytes(span(_encoded_proto)));
+
+// A view like those generated for pw_protobuf messages.
+class TestView : public internal::MessageView<7> {
+ public:
+  constexpr explicit TestView(ConstByteSpan message)
+      : MessageView(message, kViewFields) {}
+
+  Result<int32_t> int_field() const { return ReadInt32(0); }
+  Result<int32_t> sint_field() const { return ReadSint32(1); }
+  Result<double> double_field() const { return ReadDouble(2); }
+  Result<uint32_t> fixed_field() const { return ReadFixed32(3); }
+  Result<std::string_view> string_field() const { return ReadString(4); }
+  Result<ConstByteSpan> nested() const { return ReadBytes(5); }
+  Result<uint32_t> missing() const { return ReadUint32(6); }
+
+  // Reads field 5, a fixed32, as the wrong type.
+  Result<uint32_t> fixed_field_as_varint() const { return ReadUint32(3); }
+
+ private:
+  static constexpr std::array<uint32_t, 7> kViewFields = {1, 2, 4, 5, 6, 7, 8};
+};
+
+TEST(MessageView, PresentFields) {
+  const TestView view(encoded_proto);
+  EXPECT_EQ(view.int_field().value(), 42);
+  EXPECT_EQ(view.sint_field().value(), -13);
+  EXPECT_EQ(view.double_field().value(), 3.14159);
+  EXPECT_EQ(view.fixed_field().value(), 0xdeadbeefu);
+  EXPECT_EQ(view.string_field().value(), "Hello world");
+}
+
+TEST(MessageView, FieldsReferToMessage) {
+  const TestView view(encoded_proto);
+
+  Result<std::string_view> str = view.string_field();
+  ASSERT_EQ(str.status(), OkStatus());
+  EXPECT_EQ(static_cast<const void*>(str->data()),
+            static_cast<const void*>(&_encoded_proto[20]));
+
+  Result<ConstByteSpan> nested = view.nested();
+  ASSERT_EQ(nested.status(), OkStatus());
+  EXPECT_EQ(nested->data(), &encoded_proto[33]);
+  EXPECT_EQ(nested->size(), 2u);
+}
+
+TEST(MessageView, MissingField) {
+  const TestView view(encoded_proto);
+  EXPECT_EQ(view.missing().status(), Status::NotFound());
+}
+
+TEST(MessageView, WrongWireType) {
+  const TestView view(encoded_proto);
+  EXPECT_EQ(view.fixed_field_as_varint().status(),
+            Status::FailedPrecondition());
+  EXPECT_EQ(view.fixed_field().value(), 0xdeadbeefu);
+}
+
+TEST(MessageView, FirstOccurrence) {
+  const TestView view(encoded_proto);
+  EXPECT_EQ(view.int_field().value(), 42);
+}
+
+TEST(MessageView, Empty) {
+  const TestView view(ConstByteSpan{});
+  EXPECT_EQ(view.int_field().status(), Status::NotFound());
+  EXPECT_EQ(view.string_field().status(), Status::NotFound());
+}
+
+TEST(MessageView, CorruptMessage) {
+  // Field 6 claims to be longer than the rest of the message.
+  constexpr uint8_t kCorrupt[] = {0x08, 0x2a, 0x32, 0x7f, 'H', 'i'};
+  const TestView view(as_bytes(span(kCorrupt)));
+
+  // Fields before the corruption can be read.
+  EXPECT_EQ(view.int_field().value(), 42);
+  EXPECT_EQ(view.string_field().status(), Status::DataLoss());
+  EXPECT_EQ(view.missing().status(), Status::DataLoss());
+}
+
+}  // namespace
+}  // namespace pw::protobuf
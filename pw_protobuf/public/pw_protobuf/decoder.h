@@ -41,6 +41,11 @@
 //   }
 //
 namespace pw::protobuf {
+namespace internal {
+
+class BasicMessageView;
+
+}  // namespace internal
 
 // TODO(frolv): Rename this to MemoryDecoder to match the encoder naming.
 class Decoder {
@@ -145,6 +150,9 @@ class Decoder {
   }
 
  private:
+  // Generated message views record the locations of fields in a message.
+  friend class internal::BasicMessageView;
+
   // Advances the cursor to the next field in the proto.
   Status SkipField();
 
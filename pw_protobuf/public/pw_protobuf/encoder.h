@@ -29,6 +29,7 @@
 #include "pw_protobuf/wire_format.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
 #include "pw_status/try.h"
 #include "pw_stream/memory_stream.h"
 #include "pw_stream/stream.h"
@@ -116,7 +117,10 @@ class StreamEncoder {
   // must exist for the lifetime of the StreamEncoder object.
   //
   // StreamEncoder objects that do not write nested proto messages can
-  // provide a zero-length scratch buffer.
+  // provide a zero-length scratch buffer. Messages written with a generated
+  // Write() method only use the scratch buffer for submessages that contain
+  // fields with callbacks; other submessages are sized in advance and encoded
+  // directly to the stream.
   constexpr StreamEncoder(stream::Writer& writer, ByteSpan scratch_buffer)
       : status_(OkStatus()),
         write_when_empty_(true),
@@ -648,6 +652,16 @@ class StreamEncoder {
   Status Write(span<const std::byte> message,
                span<const internal::MessageField> table);
 
+  // Calculates the number of bytes Write() produces for the structure
+  // contained within message, without encoding it. Returns UNIMPLEMENTED if the
+  // message or any of its submessages has a field that uses a callback, since
+  // the size of a callback's output cannot be known in advance.
+  //
+  // Write() uses this to encode submessages directly to the stream, rather
+  // than buffering each one in the scratch buffer until its length is known.
+  static StatusWithSize SizeOfMessage(span<const std::byte> message,
+                                      span<const internal::MessageField> table);
+
   // Protected method to create a nested encoder, specifying whether the field
   // should be written when no fields were added to the nested encoder. Exposed
   // using an enum in the public API, for better readability.
@@ -687,6 +701,12 @@ class StreamEncoder {
   // Implementation for encoding all length-delimited field types.
   Status WriteLengthDelimitedField(uint32_t field_number, ConstByteSpan data);
 
+  // Encodes a submessage of a known, nonzero size directly to the stream.
+  Status WriteNestedMessage(uint32_t field_number,
+                            span<const std::byte> message,
+                            span<const internal::MessageField> table,
+                            size_t size);
+
   // Encoding of length-delimited field where payload comes from `bytes_reader`.
   Status WriteLengthDelimitedFieldFromStream(uint32_t field_number,
                                              stream::Reader& bytes_reader,
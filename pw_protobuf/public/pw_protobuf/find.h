@@ -21,8 +21,9 @@
 /// functions which handle this for you.
 ///
 /// @note Each call to ``Find*()`` linearly scans through the message. If you
-/// have to read multiple fields, it is more efficient to instantiate your own
-/// decoder as described above.
+/// have to read multiple fields, use ``FindFields()``, which reads several
+/// fields in a single pass, or instantiate your own decoder as described
+/// above.
 ///
 /// @code{.cpp}
 ///
@@ -39,9 +40,15 @@
 ///
 /// @endcode
 
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
 #include "pw_bytes/span.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_protobuf/stream_decoder.h"
+#include "pw_protobuf/wire_format.h"
 #include "pw_result/result.h"
 #include "pw_status/try.h"
 #include "pw_string/string.h"
@@ -745,4 +752,328 @@ inline Result<ConstByteSpan> FindSubmessage(ConstByteSpan message, T field) {
   return FindSubmessage(message, static_cast<uint32_t>(field));
 }
 
+namespace internal {
+
+template <typename T>
+constexpr uint32_t ToFieldNumber(T field) {
+  static_assert(std::is_integral_v<T> || std::is_enum_v<T>,
+                "Fields must be field numbers or generated Fields enums");
+  return static_cast<uint32_t>(field);
+}
+
+// Base of the targets read by FindFields(): a field number, and whether the
+// field has been found.
+class FieldTarget {
+ public:
+  constexpr uint32_t field_number() const { return field_number_; }
+
+  // Returns true and marks the target found if the decoder's current field
+  // is the first occurrence of this target's field.
+  constexpr bool Match(uint32_t field_number) {
+    if (found_ || field_number != field_number_) {
+      return false;
+    }
+    found_ = true;
+    return true;
+  }
+
+ protected:
+  constexpr explicit FieldTarget(uint32_t field_number)
+      : field_number_(field_number) {}
+
+  // The StreamDecoder returns a NOT_FOUND if trying to read the wrong type for
+  // a field. Remap this to FAILED_PRECONDITION for consistency with the
+  // non-stream decoder.
+  static constexpr Status RemapStreamStatus(Status status) {
+    return status.IsNotFound() ? Status::FailedPrecondition() : status;
+  }
+
+ private:
+  uint32_t field_number_;
+  bool found_ = false;
+};
+
+// A scalar field, read with kDecoderRead or kStreamRead.
+template <typename T, auto kDecoderRead, auto kStreamRead>
+class ScalarFieldTarget : public FieldTarget {
+ public:
+  constexpr ScalarFieldTarget(uint32_t field_number, Result<T>& out)
+      : FieldTarget(field_number), out_(out) {}
+
+  void Reset() { out_ = Status::NotFound(); }
+
+  Status Read(Decoder& decoder) {
+    T value;
+    const Status status = (decoder.*kDecoderRead)(&value);
+    out_ = status.ok() ? Result<T>(value) : Result<T>(status);
+    return status;
+  }
+
+  Status Read(StreamDecoder& decoder) {
+    Result<T> result = (decoder.*kStreamRead)();
+    out_ = result.ok() ? result : Result<T>(RemapStreamStatus(result.status()));
+    return out_.status();
+  }
+
+ private:
+  Result<T>& out_;
+};
+
+// A string, bytes, or submessage field that is returned as a view into the
+// message. Only available when searching a ConstByteSpan.
+template <typename T, auto kDecoderRead>
+class ViewFieldTarget : public FieldTarget {
+ public:
+  constexpr ViewFieldTarget(uint32_t field_number, Result<T>& out)
+      : FieldTarget(field_number), out_(out) {}
+
+  void Reset() { out_ = Status::NotFound(); }
+
+  Status Read(Decoder& decoder) {
+    T value;
+    const Status status = (decoder.*kDecoderRead)(&value);
+    out_ = status.ok() ? Result<T>(value) : Result<T>(status);
+    return status;
+  }
+
+  template <typename StreamDecoderType>
+  Status Read(StreamDecoderType&) {
+    static_assert(!std::is_same_v<StreamDecoderType, StreamDecoder>,
+                  "Fields can only be returned as views when searching a "
+                  "ConstByteSpan; provide a buffer to copy the field into "
+                  "when searching a stream::Reader");
+    return Status::Unimplemented();
+  }
+
+ private:
+  Result<T>& out_;
+};
+
+// A string or bytes field that is copied into a buffer. T is std::string_view
+// or ConstByteSpan.
+template <typename T>
+class BufferFieldTarget : public FieldTarget {
+ public:
+  constexpr BufferFieldTarget(uint32_t field_number,
+                              ByteSpan buffer,
+                              Result<T>& out)
+      : FieldTarget(field_number), buffer_(buffer), out_(out) {}
+
+  void Reset() { out_ = Status::NotFound(); }
+
+  Status Read(Decoder& decoder) {
+    ConstByteSpan bytes;
+    PW_TRY(Store(decoder.ReadBytes(&bytes)));
+    if (bytes.size() > buffer_.size()) {
+      return Store(Status::ResourceExhausted());
+    }
+    std::copy(bytes.begin(), bytes.end(), buffer_.begin());
+    return Store(OkStatus(), bytes.size());
+  }
+
+  Status Read(StreamDecoder& decoder) {
+    const StatusWithSize sws = decoder.ReadBytes(buffer_);
+    return Store(RemapStreamStatus(sws.status()), sws.size());
+  }
+
+ private:
+  Status Store(Status status, size_t size = 0) {
+    if (!status.ok()) {
+      out_ = status;
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+      out_ = std::string_view(reinterpret_cast<const char*>(buffer_.data()),
+                              size);
+    } else {
+      out_ = ConstByteSpan(buffer_.first(size));
+    }
+    return status;
+  }
+
+  ByteSpan buffer_;
+  Result<T>& out_;
+};
+
+// Reads the decoder's current field into the first target that matches it.
+template <typename DecoderType, typename... Targets>
+Status ReadFieldIntoTarget(DecoderType& decoder,
+                           uint32_t field_number,
+                           size_t& remaining,
+                           Targets&... targets) {
+  Status status;
+  const bool matched = ((targets.Match(field_number) &&
+                         (status = targets.Read(decoder), true)) ||
+                        ...);
+  if (matched) {
+    remaining -= 1;
+  }
+  // Only a corrupt message stops the search. Other errors, such as the wrong
+  // wire type, are reported through the target. A StreamDecoder cannot
+  // continue after reading a field as the wrong type, so that also stops the
+  // search of a stream.
+  if (status.IsDataLoss()) {
+    return status;
+  }
+  if constexpr (std::is_same_v<DecoderType, StreamDecoder>) {
+    if (status.IsFailedPrecondition()) {
+      return status;
+    }
+  }
+  return OkStatus();
+}
+
+template <typename DecoderType, typename... Targets>
+Status FindFields(DecoderType& decoder, Targets&... targets) {
+  (targets.Reset(), ...);
+  if (!(ValidFieldNumber(targets.field_number()) && ...)) {
+    return Status::InvalidArgument();
+  }
+
+  size_t remaining = sizeof...(targets);
+  Status status;
+  while (remaining > 0 && (status = decoder.Next()).ok()) {
+    uint32_t field_number;
+    if constexpr (std::is_same_v<DecoderType, StreamDecoder>) {
+      PW_TRY_ASSIGN(field_number, decoder.FieldNumber());
+    } else {
+      field_number = decoder.FieldNumber();
+    }
+    PW_TRY(ReadFieldIntoTarget(decoder, field_number, remaining, targets...));
+  }
+
+  // Reaching the end of the message is expected; missing fields are reported
+  // through their targets.
+  return status.IsOutOfRange() ? OkStatus() : status;
+}
+
+}  // namespace internal
+
+/// @defgroup pw_protobuf_find_fields Targets for FindFields()
+///
+/// Each target pairs a field number, or a generated `Fields` enum value, with
+/// a `Result` that `FindFields()` sets to the field's value or to a status:
+/// * `NOT_FOUND` - The field is not present.
+/// * `FAILED_PRECONDITION` - The field exists, but is not the correct type.
+/// * `RESOURCE_EXHAUSTED` - The field does not fit in the target's buffer.
+/// @{
+
+#define _PW_PROTOBUF_SCALAR_TARGET(name, type)                      \
+  template <typename Field>                                         \
+  constexpr auto name##Target(Field field, Result<type>& out) {     \
+    return internal::ScalarFieldTarget<type,                        \
+                                       &Decoder::Read##name,        \
+                                       &StreamDecoder::Read##name>( \
+        internal::ToFieldNumber(field), out);                       \
+  }                                                                 \
+  static_assert(true)
+
+_PW_PROTOBUF_SCALAR_TARGET(Uint32, uint32_t);
+_PW_PROTOBUF_SCALAR_TARGET(Int32, int32_t);
+_PW_PROTOBUF_SCALAR_TARGET(Sint32, int32_t);
+_PW_PROTOBUF_SCALAR_TARGET(Uint64, uint64_t);
+_PW_PROTOBUF_SCALAR_TARGET(Int64, int64_t);
+_PW_PROTOBUF_SCALAR_TARGET(Sint64, int64_t);
+_PW_PROTOBUF_SCALAR_TARGET(Bool, bool);
+_PW_PROTOBUF_SCALAR_TARGET(Fixed32, uint32_t);
+_PW_PROTOBUF_SCALAR_TARGET(Fixed64, uint64_t);
+_PW_PROTOBUF_SCALAR_TARGET(Sfixed32, int32_t);
+_PW_PROTOBUF_SCALAR_TARGET(Sfixed64, int64_t);
+_PW_PROTOBUF_SCALAR_TARGET(Float, float);
+_PW_PROTOBUF_SCALAR_TARGET(Double, double);
+
+#undef _PW_PROTOBUF_SCALAR_TARGET
+
+/// Finds a `string` field as a view into the message. Only for messages in a
+/// `ConstByteSpan`.
+template <typename Field>
+constexpr auto StringTarget(Field field, Result<std::string_view>& out) {
+  return internal::ViewFieldTarget<std::string_view, &Decoder::ReadString>(
+      internal::ToFieldNumber(field), out);
+}
+
+/// Finds a `string` field, copying it into a buffer. The string is NOT
+/// null-terminated.
+template <typename Field>
+constexpr auto StringTarget(Field field,
+                            span<char> buffer,
+                            Result<std::string_view>& out) {
+  return internal::BufferFieldTarget<std::string_view>(
+      internal::ToFieldNumber(field), as_writable_bytes(buffer), out);
+}
+
+/// Finds a `bytes` field as a view into the message. Only for messages in a
+/// `ConstByteSpan`.
+template <typename Field>
+constexpr auto BytesTarget(Field field, Result<ConstByteSpan>& out) {
+  return internal::ViewFieldTarget<ConstByteSpan, &Decoder::ReadBytes>(
+      internal::ToFieldNumber(field), out);
+}
+
+/// Finds a `bytes` field, copying it into a buffer.
+template <typename Field>
+constexpr auto BytesTarget(Field field,
+                           ByteSpan buffer,
+                           Result<ConstByteSpan>& out) {
+  return internal::BufferFieldTarget<ConstByteSpan>(
+      internal::ToFieldNumber(field), buffer, out);
+}
+
+/// Finds a submessage as a view into the message. Only for messages in a
+/// `ConstByteSpan`.
+template <typename Field>
+constexpr auto SubmessageTarget(Field field, Result<ConstByteSpan>& out) {
+  return BytesTarget(field, out);
+}
+
+/// @}
+
+/// @brief Scans a serialized protobuf message once for several fields.
+///
+/// Each target receives the value of the first occurrence of its field. The
+/// scan stops as soon as every field has been found.
+///
+/// @code{.cpp}
+///
+///   pw::Result<uint32_t> address;
+///   pw::Result<pw::ConstByteSpan> payload;
+///   PW_TRY(pw::protobuf::FindFields(
+///       packet,
+///       pw::protobuf::Uint32Target(Packet::Fields::kAddress, address),
+///       pw::protobuf::BytesTarget(Packet::Fields::kPayload, payload)));
+///
+/// @endcode
+///
+/// @param message The serialized message to search.
+/// @param targets The fields to find, and where to store them. Each field
+/// number may only be requested once.
+///
+/// @returns
+/// * `OK` - The message was scanned. Each target holds its field's value or a
+///   status indicating why it could not be read.
+/// * `DATA_LOSS` - The serialized message is not a valid protobuf.
+/// * `INVALID_ARGUMENT` - A target has an invalid field number.
+template <typename... Targets>
+Status FindFields(ConstByteSpan message, Targets... targets) {
+  Decoder decoder(message);
+  return internal::FindFields(decoder, targets...);
+}
+
+/// @brief Scans a serialized protobuf message once for several fields.
+///
+/// Works like `FindFields()` for a `ConstByteSpan`, but string and bytes
+/// fields must be copied into buffers. The reader is left after the last
+/// field found.
+///
+/// @returns
+/// * `OK` - The message was scanned. Each target holds its field's value or a
+///   status indicating why it could not be read.
+/// * `DATA_LOSS` - The serialized message is not a valid protobuf.
+/// * `FAILED_PRECONDITION` - A field was not the type of its target. The
+///   decoder cannot continue past it, so later fields may be `NOT_FOUND`.
+/// * `INVALID_ARGUMENT` - A target has an invalid field number.
+template <typename... Targets>
+Status FindFields(stream::Reader& message_stream, Targets... targets) {
+  StreamDecoder decoder(message_stream);
+  return internal::FindFields(decoder, targets...);
+}
+
 }  // namespace pw::protobuf
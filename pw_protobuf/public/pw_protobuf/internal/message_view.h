@@ -0,0 +1,142 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/try.h"
+
+namespace pw::protobuf::internal {
+
+// Non-templated parts of MessageView.
+class BasicMessageView {
+ protected:
+  // Offset of a field that is not in the message.
+  static constexpr uint32_t kNotPresent = std::numeric_limits<uint32_t>::max();
+
+  // Records the offset of the first occurrence of each of the fields in a
+  // message. Fields that do not occur are set to kNotPresent. Returns DATA_LOSS
+  // if the message is corrupt; fields found before the corruption are still
+  // recorded.
+  static Status Index(ConstByteSpan message,
+                      span<const uint32_t> field_numbers,
+                      span<uint32_t> offsets);
+
+  // Reads the field at an offset found by Index().
+  template <typename T>
+  static Result<T> ReadAt(ConstByteSpan message,
+                          uint32_t offset,
+                          Status (Decoder::*read)(T*)) {
+    Decoder decoder(message.subspan(offset));
+    PW_TRY(decoder.Next());
+    T value;
+    PW_TRY((decoder.*read)(&value));
+    return value;
+  }
+};
+
+// Base of the generated View classes, which read fields directly from a
+// serialized message without decoding it into a struct. Strings, bytes, and
+// submessages are returned as views into the message.
+//
+// The first read scans the message once to find where each of the view's
+// fields is, so that later reads go directly to their field. Since this caches
+// state within the view, a view must not be read from multiple threads at
+// once.
+template <size_t kNumFields>
+class MessageView : public BasicMessageView {
+ protected:
+  constexpr MessageView(ConstByteSpan message,
+                        const std::array<uint32_t, kNumFields>& field_numbers)
+      : message_(message), field_numbers_(&field_numbers) {}
+
+  Result<int32_t> ReadInt32(size_t index) const {
+    return Read(index, &Decoder::ReadInt32);
+  }
+  Result<uint32_t> ReadUint32(size_t index) const {
+    return Read(index, &Decoder::ReadUint32);
+  }
+  Result<int64_t> ReadInt64(size_t index) const {
+    return Read(index, &Decoder::ReadInt64);
+  }
+  Result<uint64_t> ReadUint64(size_t index) const {
+    return Read(index, &Decoder::ReadUint64);
+  }
+  Result<int32_t> ReadSint32(size_t index) const {
+    return Read(index, &Decoder::ReadSint32);
+  }
+  Result<int64_t> ReadSint64(size_t index) const {
+    return Read(index, &Decoder::ReadSint64);
+  }
+  Result<bool> ReadBool(size_t index) const {
+    return Read(index, &Decoder::ReadBool);
+  }
+  Result<uint32_t> ReadFixed32(size_t index) const {
+    return Read(index, &Decoder::ReadFixed32);
+  }
+  Result<uint64_t> ReadFixed64(size_t index) const {
+    return Read(index, &Decoder::ReadFixed64);
+  }
+  Result<int32_t> ReadSfixed32(size_t index) const {
+    return Read(index, &Decoder::ReadSfixed32);
+  }
+  Result<int64_t> ReadSfixed64(size_t index) const {
+    return Read(index, &Decoder::ReadSfixed64);
+  }
+  Result<float> ReadFloat(size_t index) const {
+    return Read(index, &Decoder::ReadFloat);
+  }
+  Result<double> ReadDouble(size_t index) const {
+    return Read(index, &Decoder::ReadDouble);
+  }
+  Result<std::string_view> ReadString(size_t index) const {
+    return Read(index, &Decoder::ReadString);
+  }
+  Result<ConstByteSpan> ReadBytes(size_t index) const {
+    return Read(index, &Decoder::ReadBytes);
+  }
+
+ private:
+  template <typename T>
+  Result<T> Read(size_t index, Status (Decoder::*read)(T*)) const {
+    if (!indexed_) {
+      index_status_ = Index(message_, *field_numbers_, offsets_);
+      indexed_ = true;
+    }
+    if (offsets_[index] == kNotPresent) {
+      // A field that was not found may be past the point where the message
+      // is corrupt.
+      return index_status_.ok() ? Status::NotFound() : index_status_;
+    }
+    return ReadAt(message_, offsets_[index], read);
+  }
+
+  ConstByteSpan message_;
+  const std::array<uint32_t, kNumFields>* field_numbers_;
+  mutable std::array<uint32_t, kNumFields> offsets_{};
+  mutable Status index_status_;
+  mutable bool indexed_ = false;
+};
+
+}  // namespace pw::protobuf::internal
@@ -370,6 +370,14 @@ class FindMethod(ReadMethod):
         """
         raise NotImplementedError()
 
+    def view_body(self, index: int) -> List[str]:
+        """Returns the body of the field's accessor in the message's View."""
+        return [f'return {self._view_read_fn()}({index});']
+
+    def _view_read_fn(self) -> str:
+        """The MessageView read function matching the find function."""
+        return 'Read' + self._find_fn()[len('Find') :]
+
 
 class FindStreamMethod(FindMethod):
     def name(self) -> str:
@@ -2279,6 +2287,16 @@ class EnumFindMethod(FindMethod):
         ]
         return lines
 
+    def view_body(self, index: int) -> List[str]:
+        return [
+            '::pw::Result<uint32_t> result = '
+            f'{self._view_read_fn()}({index});',
+            'if (!result.ok()) {',
+            '  return result.status();',
+            '}',
+            f'return static_cast<{self._result_type()}>(result.value());',
+        ]
+
     def _find_fn(self) -> str:
         return 'FindUint32'
 
@@ -2688,6 +2706,18 @@ def generate_class_for_message(
                 )
             output.write_line('}')
 
+            output.write_line()
+            output.write_line(
+                'static ::pw::StatusWithSize SerializedSize('
+                'const Message& message) {'
+            )
+            with output.indent():
+                output.write_line(
+                    f'return {base_class}::SizeOfMessage('
+                    'pw::as_bytes(pw::span(&message, 1)), kMessageFields);'
+                )
+            output.write_line('}')
+
         # Generate methods for each of the message's fields.
         for field in message.fields():
             for method_class in proto_field_methods(class_type, field.type()):
@@ -3112,6 +3142,77 @@ def generate_find_functions_for_message(
     output.write_line(f'}}  // namespace {namespace}')
 
 
+def generate_view_for_message(
+    message: ProtoMessage, root: ProtoNode, output: OutputFile
+) -> None:
+    """Creates a View class which reads fields from a serialized message."""
+    assert message.type() == ProtoNode.Type.MESSAGE
+
+    methods = []
+    for field in message.fields():
+        if field.is_repeated():
+            # As with the Find methods, a single accessor can't represent a
+            # repeated field, so they are left out of the view.
+            continue
+
+        try:
+            cls = PROTO_FIELD_FIND_METHODS[field.type()][0]
+        except KeyError:
+            continue
+
+        methods.append((field, cls(field, message, root, '')))
+
+    namespace = message.cpp_namespace(root=root)
+    output.write_line(f'namespace {namespace} {{')
+    output.write_line()
+    output.write_line(
+        '// Reads fields directly from a serialized message. Strings, bytes, '
+        'and'
+    )
+    output.write_line(
+        '// submessages are returned as spans into the message, which must '
+        'outlive'
+    )
+    output.write_line('// the view.')
+    output.write_line(
+        'class View : public ::pw::protobuf::internal::MessageView'
+        f'<{len(methods)}> {{'
+    )
+    output.write_line(' public:')
+
+    with output.indent():
+        output.write_line(
+            'constexpr explicit View(::pw::ConstByteSpan message)'
+        )
+        output.write_line('    : MessageView(message, kViewFields) {}')
+
+        for index, (field, method) in enumerate(methods):
+            output.write_line()
+            output.write_line(
+                f'{method.return_type()} {field.field_name()}() const {{'
+            )
+            with output.indent():
+                for line in method.view_body(index):
+                    output.write_line(line)
+            output.write_line('}')
+
+    output.write_line()
+    output.write_line(' private:')
+    with output.indent():
+        output.write_line(
+            f'static constexpr std::array<uint32_t, {len(methods)}> '
+            'kViewFields = {'
+        )
+        with output.indent():
+            for _, method in methods:
+                output.write_line(f'{method.field_cast()},')
+        output.write_line('};')
+
+    output.write_line('};')
+    output.write_line()
+    output.write_line(f'}}  // namespace {namespace}')
+
+
 def generate_is_trivially_comparable_specialization(
     message: ProtoMessage, root: ProtoNode, output: OutputFile
 ) -> None:
@@ -3195,6 +3296,7 @@ def generate_code_for_package(
     output.write_line('#include "pw_protobuf/encoder.h"')
     output.write_line('#include "pw_protobuf/find.h"')
     output.write_line('#include "pw_protobuf/internal/codegen.h"')
+    output.write_line('#include "pw_protobuf/internal/message_view.h"')
     output.write_line('#include "pw_protobuf/serialized_size.h"')
     output.write_line('#include "pw_protobuf/stream_decoder.h"')
     output.write_line('#include "pw_result/result.h"')
@@ -3245,6 +3347,8 @@ def generate_code_for_package(
         output.write_line()
         generate_find_functions_for_message(message, package, output)
         output.write_line()
+        generate_view_for_message(message, package, output)
+        output.write_line()
         generate_class_for_message(
             message, package, output, ClassType.STREAMING_ENCODER
         )
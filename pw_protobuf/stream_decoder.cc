@@ -14,7 +14,6 @@
 
 #include "pw_protobuf/stream_decoder.h"
 
-#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <limits>
@@ -519,16 +518,42 @@ Status StreamDecoder::CheckOkToRead(WireType type) {
   return status_;
 }
 
+namespace {
+
+// Finds a field in a message table, searching forward from the index of the
+// previous field found and wrapping around. Encoders write fields in order, so
+// for typical input the search only moves forward, and decoding a message
+// visits each table entry about once instead of once per field decoded.
+const internal::MessageField* FindField(
+    span<const internal::MessageField> table,
+    uint32_t field_number,
+    size_t& hint) {
+  for (size_t i = 0; i < table.size(); ++i) {
+    size_t index = hint + i;
+    if (index >= table.size()) {
+      index -= table.size();
+    }
+    if (table[index] == field_number) {
+      // Stay on this field, since repeated fields are often consecutive.
+      hint = index;
+      return &table[index];
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 Status StreamDecoder::Read(span<std::byte> message,
                            span<const internal::MessageField> table) {
   PW_TRY(status_);
 
+  size_t hint = 0;
   while (Next().ok()) {
-    // Find the field in the table,
-    // TODO: b/234876102 - Finding the field can be made more efficient.
-    const auto field =
-        std::find(table.begin(), table.end(), current_field_.field_number());
-    if (field == table.end()) {
+    // Find the field in the table.
+    const internal::MessageField* field =
+        FindField(table, current_field_.field_number(), hint);
+    if (field == nullptr) {
       // If the field is not found, skip to the next one.
       // TODO: b/234873295 - Provide a way to allow the caller to inspect
       // unknown fields, and serialize them back out later.
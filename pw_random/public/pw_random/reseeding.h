@@ -0,0 +1,94 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_random/random.h"
+
+namespace pw::random {
+
+/// A fast pseudo-random generator that is seeded, and periodically reseeded,
+/// from another generator.
+///
+/// Hardware true random number generators (TRNGs) are often slow, and can
+/// stall while they collect entropy. `ReseedingRng` uses a TRNG driver, in
+/// the form of a `RandomGenerator`, only to seed a fast PRNG such as
+/// `Xoshiro256PlusPlusRng`, and then reseeds the PRNG from the TRNG after
+/// every `kReseedIntervalBytes` bytes of output. This gives hot paths, such as
+/// randomized backoff, the speed of the PRNG while regularly mixing in true
+/// entropy.
+///
+/// @tparam Prng A `RandomGenerator` that is constructible from a `uint64_t`
+/// seed, such as `Xoshiro256PlusPlusRng` or `XorShiftStarRng64`.
+///
+/// @tparam kReseedIntervalBytes The number of bytes to generate between
+/// reseeds.
+///
+/// @warning This is only as strong as `Prng`, and is **NOT**
+/// cryptographically secure unless `Prng` is.
+template <typename Prng, size_t kReseedIntervalBytes = 4096>
+class ReseedingRng : public RandomGenerator {
+ public:
+  static_assert(kReseedIntervalBytes > 0,
+                "The reseed interval must be at least one byte");
+
+  /// @param[in] entropy_source The generator, typically a TRNG driver, to seed
+  /// the PRNG from. Must outlive this object.
+  explicit ReseedingRng(RandomGenerator& entropy_source)
+      : entropy_source_(entropy_source), prng_(ReadSeed(entropy_source)) {}
+
+  /// Populates the destination buffer from the PRNG, reseeding it from the
+  /// entropy source whenever the reseed interval is reached.
+  void Get(ByteSpan dest) final {
+    while (!dest.empty()) {
+      if (bytes_until_reseed_ == 0) {
+        Reseed();
+      }
+      const size_t chunk_size = std::min(dest.size(), bytes_until_reseed_);
+      prng_.Get(dest.first(chunk_size));
+      bytes_until_reseed_ -= chunk_size;
+      dest = dest.subspan(chunk_size);
+    }
+  }
+
+  /// Injects entropy into the PRNG.
+  void InjectEntropyBits(uint32_t data, uint_fast8_t num_bits) final {
+    prng_.InjectEntropyBits(data, num_bits);
+  }
+
+  /// Immediately mixes 64 bits from the entropy source into the PRNG.
+  void Reseed() {
+    const uint64_t seed = ReadSeed(entropy_source_);
+    prng_.InjectEntropyBits(static_cast<uint32_t>(seed), 32);
+    prng_.InjectEntropyBits(static_cast<uint32_t>(seed >> 32), 32);
+    bytes_until_reseed_ = kReseedIntervalBytes;
+  }
+
+ private:
+  static uint64_t ReadSeed(RandomGenerator& entropy_source) {
+    uint64_t seed = 0;
+    entropy_source.GetInt(seed);
+    return seed;
+  }
+
+  RandomGenerator& entropy_source_;
+  Prng prng_;
+  size_t bytes_until_reseed_ = kReseedIntervalBytes;
+};
+
+}  // namespace pw::random
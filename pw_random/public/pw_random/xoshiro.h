@@ -0,0 +1,118 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_bytes/span.h"
+#include "pw_random/random.h"
+
+namespace pw::random {
+
+/// A random generator based off the
+/// [xoshiro256++](https://prng.di.unimi.it/) algorithm.
+///
+/// xoshiro256++ keeps 256 bits of state and produces 64 bits per step using
+/// only shifts, rotations, XORs, and additions, so it is both faster and
+/// better distributed than `XorShiftStarRng64`. It passes the BigCrush and
+/// PractRand statistical test suites.
+///
+/// The 64-bit seed is expanded into the full state with
+/// [SplitMix64](https://prng.di.unimi.it/splitmix64.c), as recommended by the
+/// algorithm's authors. As with `XorShiftStarRng64`, entropy may be injected
+/// at any time, after which the results are no longer determined by the seed.
+///
+/// See also [Scrambled Linear Pseudorandom Number
+/// Generators](https://vigna.di.unimi.it/ftp/papers/ScrambledLinear.pdf).
+///
+/// @warning This random generator is **NOT** cryptographically secure.
+class Xoshiro256PlusPlusRng : public RandomGenerator {
+ public:
+  Xoshiro256PlusPlusRng(uint64_t initial_seed) {
+    for (uint64_t& word : state_) {
+      word = SplitMix64(initial_seed);
+    }
+  }
+
+  /// Populates the destination buffer with randomly generated values, 64 bits
+  /// at a time.
+  void Get(ByteSpan dest) final {
+    std::byte* out = dest.data();
+    size_t remaining = dest.size();
+    for (; remaining >= sizeof(uint64_t); remaining -= sizeof(uint64_t)) {
+      const uint64_t random = Next();
+      std::memcpy(out, &random, sizeof(random));
+      out += sizeof(random);
+    }
+    if (remaining != 0) {
+      const uint64_t random = Next();
+      std::memcpy(out, &random, remaining);
+    }
+  }
+
+  /// Injects entropy by XORing it, along with the number of bits, into the
+  /// state and then advancing the generator to mix it into the whole state.
+  void InjectEntropyBits(uint32_t data, uint_fast8_t num_bits) final {
+    if (num_bits == 0) {
+      return;
+    } else if (num_bits > 32) {
+      num_bits = 32;
+    }
+
+    const uint32_t mask =
+        static_cast<uint32_t>((static_cast<uint64_t>(1) << num_bits) - 1);
+    state_[0] ^= (static_cast<uint64_t>(num_bits) << 32) | (data & mask);
+    Next();
+
+    // The state must never be all zeros, or the generator only returns zero.
+    if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+      state_[0] = kGoldenGamma;
+    }
+  }
+
+ private:
+  static constexpr uint64_t kGoldenGamma = 0x9E3779B97F4A7C15;
+
+  static constexpr uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  // Advances `seed` and returns the next SplitMix64 output.
+  static constexpr uint64_t SplitMix64(uint64_t& seed) {
+    uint64_t z = (seed += kGoldenGamma);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+  }
+
+  // Calculates and returns the next value based on the "xoshiro256++"
+  // algorithm.
+  uint64_t Next() {
+    const uint64_t result = RotateLeft(state_[0] + state_[3], 23) + state_[0];
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45);
+    return result;
+  }
+
+  uint64_t state_[4];
+};
+
+}  // namespace pw::random
@@ -0,0 +1,173 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_random/xoshiro.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_random/reseeding.h"
+#include "pw_random/xor_shift.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::random {
+namespace {
+
+// Expected values are from the xoshiro256++ and SplitMix64 reference
+// implementations at https://prng.di.unimi.it/.
+constexpr uint64_t kSeed1 = 5;
+constexpr uint64_t kResult1[] = {
+    0x4ac202caf347fc1eu,
+    0x9c874b1ef6a1c5e6u,
+    0x19141eb775a6f43fu,
+    0x0f0124ccd0060d9eu,
+};
+
+constexpr uint64_t kSeed2 = 0x21feabcd5fb37474u;
+constexpr uint64_t kResult2[] = {
+    0xf7ecbe621c855771u,
+    0x17a244b0825ffc98u,
+    0x60907cb50cbb63ecu,
+    0xa19ea6a103e97ff8u,
+};
+
+TEST(Xoshiro256PlusPlusRng, ValidateSeries1) {
+  Xoshiro256PlusPlusRng rng(kSeed1);
+  for (uint64_t expected : kResult1) {
+    uint64_t val = 0;
+    rng.GetInt(val);
+    EXPECT_EQ(val, expected);
+  }
+}
+
+TEST(Xoshiro256PlusPlusRng, ValidateSeries2) {
+  Xoshiro256PlusPlusRng rng(kSeed2);
+  for (uint64_t expected : kResult2) {
+    uint64_t val = 0;
+    rng.GetInt(val);
+    EXPECT_EQ(val, expected);
+  }
+}
+
+TEST(Xoshiro256PlusPlusRng, BulkGetMatchesSeries) {
+  Xoshiro256PlusPlusRng rng(kSeed1);
+  std::array<std::byte, sizeof(kResult1)> buffer;
+  rng.Get(buffer);
+  EXPECT_EQ(std::memcmp(buffer.data(), kResult1, sizeof(kResult1)), 0);
+}
+
+TEST(Xoshiro256PlusPlusRng, PartialWordUsesNextValue) {
+  Xoshiro256PlusPlusRng rng(kSeed1);
+  std::array<std::byte, sizeof(uint64_t) + 3> buffer;
+  rng.Get(buffer);
+  EXPECT_EQ(std::memcmp(buffer.data(), kResult1, buffer.size()), 0);
+
+  uint64_t val = 0;
+  rng.GetInt(val);
+  EXPECT_EQ(val, kResult1[2]);
+}
+
+TEST(Xoshiro256PlusPlusRng, InjectEntropyBits) {
+  Xoshiro256PlusPlusRng rng(kSeed1);
+  uint64_t val = 0;
+  rng.InjectEntropyBits(0x1, 1);
+  rng.GetInt(val);
+  EXPECT_NE(val, kResult1[0]);
+}
+
+// Ensure injecting the same entropy integer, but different bit counts causes
+// the randomly generated number to differ.
+TEST(Xoshiro256PlusPlusRng, EntropyBitCountMatters) {
+  Xoshiro256PlusPlusRng rng_1(kSeed1);
+  Xoshiro256PlusPlusRng rng_2(kSeed1);
+  uint64_t first_val = 0;
+  uint64_t second_val = 0;
+  rng_1.InjectEntropyBits(0x1, 1);
+  rng_2.InjectEntropyBits(0x1, 2);
+  rng_1.GetInt(first_val);
+  rng_2.GetInt(second_val);
+  EXPECT_NE(first_val, second_val);
+}
+
+TEST(Xoshiro256PlusPlusRng, IgnoresZeroBitsOfEntropy) {
+  Xoshiro256PlusPlusRng rng(kSeed1);
+  uint64_t val = 0;
+  rng.InjectEntropyBits(0xFFFFFFFF, 0);
+  rng.GetInt(val);
+  EXPECT_EQ(val, kResult1[0]);
+}
+
+// A fake entropy source that counts how many times it is read.
+class CountingSource : public RandomGenerator {
+ public:
+  void Get(ByteSpan dest) override {
+    ++reads;
+    XorShiftStarRng64(reads).Get(dest);
+  }
+  void InjectEntropyBits(uint32_t, uint_fast8_t) override {}
+
+  uint64_t reads = 0;
+};
+
+TEST(ReseedingRng, SeedsFromSource) {
+  CountingSource source;
+  ReseedingRng<Xoshiro256PlusPlusRng> rng(source);
+  EXPECT_EQ(source.reads, 1u);
+
+  CountingSource other_source;
+  other_source.reads = 1;
+  ReseedingRng<Xoshiro256PlusPlusRng> other_rng(other_source);
+
+  uint64_t val = 0;
+  uint64_t other_val = 0;
+  rng.GetInt(val);
+  other_rng.GetInt(other_val);
+  EXPECT_NE(val, other_val);
+}
+
+TEST(ReseedingRng, ReseedsAfterInterval) {
+  CountingSource source;
+  ReseedingRng<Xoshiro256PlusPlusRng, 16> rng(source);
+
+  std::array<std::byte, 16> buffer;
+  rng.Get(buffer);
+  EXPECT_EQ(source.reads, 1u);
+
+  rng.Get(span(buffer).first(1));
+  EXPECT_EQ(source.reads, 2u);
+
+  // A single large request reseeds at each interval.
+  std::array<std::byte, 40> large_buffer;
+  rng.Get(large_buffer);
+  EXPECT_EQ(source.reads, 4u);
+}
+
+TEST(ReseedingRng, ExplicitReseedChangesOutput) {
+  CountingSource source;
+  ReseedingRng<Xoshiro256PlusPlusRng> rng(source);
+  CountingSource same_source;
+  ReseedingRng<Xoshiro256PlusPlusRng> same_rng(same_source);
+
+  rng.Reseed();
+  uint64_t val = 0;
+  uint64_t same_val = 0;
+  rng.GetInt(val);
+  same_rng.GetInt(same_val);
+  EXPECT_NE(val, same_val);
+}
+
+}  // namespace
+}  // namespace pw::random
@@ -32,6 +32,7 @@ using iterator = PrefixedEntryRingBufferMulti::iterator;
 
 void PrefixedEntryRingBufferMulti::Clear() {
   write_idx_ = 0;
+  reservation_pending_ = false;
   for (Reader& reader : readers_) {
     reader.read_idx_ = 0;
     reader.entry_count_ = 0;
@@ -86,7 +87,7 @@ Status PrefixedEntryRingBufferMulti::InternalPushBack(
     span<const byte> data,
     uint32_t user_preamble_data,
     bool pop_front_if_needed) {
-  if (buffer_ == nullptr) {
+  if (buffer_ == nullptr || reservation_pending_) {
     return Status::FailedPrecondition();
   }
 
@@ -103,6 +104,21 @@ Status PrefixedEntryRingBufferMulti::InternalPushBack(
                                span(preamble_buf).subspan(user_preamble_bytes));
   size_t total_write_bytes =
       user_preamble_bytes + length_bytes + data.size_bytes();
+  PW_TRY(InternalMakeSpace(total_write_bytes, pop_front_if_needed));
+
+  // Write the new entry into the ring buffer.
+  RawWrite(span(preamble_buf, user_preamble_bytes + length_bytes));
+  RawWrite(data);
+
+  // Update all readers of the new count.
+  for (Reader& reader : readers_) {
+    reader.entry_count_++;
+  }
+  return OkStatus();
+}
+
+Status PrefixedEntryRingBufferMulti::InternalMakeSpace(
+    size_t total_write_bytes, bool pop_front_if_needed) {
   if (buffer_bytes_ < total_write_bytes) {
     return Status::OutOfRange();
   }
@@ -117,10 +133,77 @@ Status PrefixedEntryRingBufferMulti::InternalPushBack(
     // TryPushBack() case: don't evict items.
     return Status::ResourceExhausted();
   }
+  return OkStatus();
+}
+
+Status PrefixedEntryRingBufferMulti::InternalReserve(
+    size_t max_size_bytes,
+    uint32_t user_preamble_data,
+    bool pop_front_if_needed,
+    Reservation& reservation_out) {
+  if (buffer_ == nullptr || reservation_pending_) {
+    return Status::FailedPrecondition();
+  }
+  if (max_size_bytes > std::numeric_limits<uint32_t>::max()) {
+    return Status::OutOfRange();
+  }
+
+  // The preamble is written by Commit(), once the entry's size is known, so
+  // only reserve room for it here.
+  const size_t preamble_bytes =
+      (user_preamble_ ? varint::EncodedSize(user_preamble_data) : 0) +
+      varint::EncodedSize(max_size_bytes);
+  PW_TRY(InternalMakeSpace(preamble_bytes + max_size_bytes,
+                           pop_front_if_needed));
+
+  size_t data_idx = IncrementIndex(write_idx_, preamble_bytes);
+  if (data_idx == buffer_bytes_) {
+    data_idx = 0;
+  }
+  const size_t first_bytes =
+      std::min(max_size_bytes, buffer_bytes_ - data_idx);
+  reservation_out = Reservation{
+      .first = span<byte>(buffer_ + data_idx, first_bytes),
+      .second = span<byte>(buffer_, max_size_bytes - first_bytes),
+  };
+
+  reservation_pending_ = true;
+  reserved_user_preamble_ = user_preamble_data;
+  reserved_data_bytes_ = max_size_bytes;
+  return OkStatus();
+}
+
+Status PrefixedEntryRingBufferMulti::Commit(size_t size_bytes) {
+  if (!reservation_pending_) {
+    return Status::FailedPrecondition();
+  }
+  if (size_bytes > reserved_data_bytes_) {
+    return Status::InvalidArgument();
+  }
+
+  byte preamble_buf[varint::kMaxVarint32SizeBytes * 2];
+  size_t user_preamble_bytes = 0;
+  if (user_preamble_) {
+    user_preamble_bytes =
+        varint::Encode<uint32_t>(reserved_user_preamble_, preamble_buf);
+  }
+
+  // The data was written after room for the length of a full reservation, so
+  // encode the length into all of that room. Varints may be padded with
+  // continuation bytes, which decode to the same value.
+  const size_t length_bytes = varint::EncodedSize(reserved_data_bytes_);
+  uint32_t length = static_cast<uint32_t>(size_bytes);
+  for (size_t i = 0; i < length_bytes - 1; ++i) {
+    preamble_buf[user_preamble_bytes + i] =
+        static_cast<byte>((length & 0x7f) | 0x80);
+    length >>= 7;
+  }
+  preamble_buf[user_preamble_bytes + length_bytes - 1] =
+      static_cast<byte>(length);
 
-  // Write the new entry into the ring buffer.
   RawWrite(span(preamble_buf, user_preamble_bytes + length_bytes));
-  RawWrite(data);
+  write_idx_ = IncrementIndex(write_idx_, size_bytes);
+  reservation_pending_ = false;
 
   // Update all readers of the new count.
   for (Reader& reader : readers_) {
@@ -308,6 +391,73 @@ Status PrefixedEntryRingBufferMulti::InternalPopFront(Reader& reader) {
   return OkStatus();
 }
 
+Status PrefixedEntryRingBufferMulti::InternalPeekFrontEntries(
+    const Reader& reader,
+    span<EntryView> entries_out,
+    size_t& entries_peeked_out) const {
+  entries_peeked_out = 0;
+  if (buffer_ == nullptr) {
+    return Status::FailedPrecondition();
+  }
+  if (reader.entry_count_ == 0) {
+    return Status::OutOfRange();
+  }
+
+  size_t read_idx = reader.read_idx_;
+  const size_t count = std::min(entries_out.size(), reader.entry_count_);
+  for (size_t i = 0; i < count; ++i) {
+    Result<EntryInfo> info = RawFrontEntryInfo(read_idx);
+    PW_CHECK_OK(info.status());
+
+    // Point at the data in place, splitting it if the entry wraps.
+    size_t data_idx = IncrementIndex(read_idx, info->preamble_bytes);
+    if (data_idx == buffer_bytes_) {
+      data_idx = 0;
+    }
+    const size_t bytes_until_wrap = buffer_bytes_ - data_idx;
+    const size_t first_bytes = std::min(info->data_bytes, bytes_until_wrap);
+    entries_out[i] = EntryView{
+        .first = span<const byte>(buffer_ + data_idx, first_bytes),
+        .second = span<const byte>(buffer_, info->data_bytes - first_bytes),
+        .preamble = info->user_preamble,
+    };
+    read_idx = IncrementIndex(data_idx, info->data_bytes);
+  }
+  entries_peeked_out = count;
+  return OkStatus();
+}
+
+Status PrefixedEntryRingBufferMulti::InternalPopFrontEntries(Reader& reader,
+                                                             size_t count) {
+  if (buffer_ == nullptr) {
+    return Status::FailedPrecondition();
+  }
+  if (reader.entry_count_ < count) {
+    return Status::OutOfRange();
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    EntryInfo info = FrontEntryInfo(reader);
+    reader.read_idx_ =
+        IncrementIndex(reader.read_idx_, info.preamble_bytes + info.data_bytes);
+  }
+  reader.entry_count_ -= count;
+  return OkStatus();
+}
+
+size_t PrefixedEntryRingBufferMulti::InternalUnreadSizeBytes(
+    const Reader& reader) const {
+  if (reader.entry_count_ == 0) {
+    return 0;
+  }
+  // The reader's entries span from its read index up to the write index. If
+  // the indices match, the reader's entries fill the whole buffer.
+  if (reader.read_idx_ < write_idx_) {
+    return write_idx_ - reader.read_idx_;
+  }
+  return buffer_bytes_ - reader.read_idx_ + write_idx_;
+}
+
 size_t PrefixedEntryRingBufferMulti::InternalFrontEntryDataSizeBytes(
     const Reader& reader) const {
   if (reader.entry_count_ == 0) {
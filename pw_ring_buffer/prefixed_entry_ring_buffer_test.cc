@@ -14,6 +14,7 @@
 
 #include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -703,6 +704,221 @@ TEST(PrefixedEntryRingBufferMulti, SingleBufferPerReader) {
   EXPECT_EQ(ring_one.AttachReader(reader), Status::InvalidArgument());
 }
 
+TEST(PrefixedEntryRingBufferMulti, PeekAndPopFrontEntries) {
+  PrefixedEntryRingBufferMulti ring(/*user_preamble=*/true);
+  byte test_buffer[kTestBufferSize];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  PrefixedEntryRingBufferMulti::Reader reader;
+  EXPECT_EQ(ring.AttachReader(reader), OkStatus());
+
+  std::array<PrefixedEntryRingBufferMulti::EntryView, 2> views;
+  size_t peeked = 1;
+  EXPECT_EQ(reader.PeekFrontEntries(views, peeked), Status::OutOfRange());
+  EXPECT_EQ(peeked, 0u);
+
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(PushBack<uint32_t>(ring, i, i + 10), OkStatus());
+  }
+
+  // Only as many entries as there are views are peeked.
+  EXPECT_EQ(reader.PeekFrontEntries(views, peeked), OkStatus());
+  ASSERT_EQ(peeked, 2u);
+  for (uint32_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(views[i].preamble, i + 10);
+    ASSERT_EQ(views[i].size(), sizeof(uint32_t));
+    EXPECT_TRUE(views[i].second.empty());
+    uint32_t value;
+    std::memcpy(&value, views[i].first.data(), sizeof(value));
+    EXPECT_EQ(value, i);
+  }
+  // Peeking doesn't move the reader.
+  EXPECT_EQ(reader.EntryCount(), 3u);
+
+  EXPECT_EQ(reader.PopFrontEntries(2), OkStatus());
+  EXPECT_EQ(reader.EntryCount(), 1u);
+  EXPECT_EQ(PeekFront<uint32_t>(reader), 2u);
+
+  EXPECT_EQ(reader.PopFrontEntries(2), Status::OutOfRange());
+  EXPECT_EQ(reader.EntryCount(), 1u);
+  EXPECT_EQ(reader.PopFrontEntries(1), OkStatus());
+  EXPECT_EQ(ring.TotalUsedBytes(), 0u);
+}
+
+TEST(PrefixedEntryRingBufferMulti, PeekFrontEntriesSplitsWrappedEntries) {
+  PrefixedEntryRingBufferMulti ring;
+  // Each 5-byte entry takes 6 bytes including its size prefix.
+  byte test_buffer[16];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  PrefixedEntryRingBufferMulti::Reader reader;
+  EXPECT_EQ(ring.AttachReader(reader), OkStatus());
+
+  constexpr std::array<byte, 5> kFirst = {
+      byte{1}, byte{2}, byte{3}, byte{4}, byte{5}};
+  constexpr std::array<byte, 5> kSecond = {
+      byte{6}, byte{7}, byte{8}, byte{9}, byte{10}};
+  constexpr std::array<byte, 5> kWrapped = {
+      byte{11}, byte{12}, byte{13}, byte{14}, byte{15}};
+  EXPECT_EQ(ring.PushBack(kFirst), OkStatus());
+  EXPECT_EQ(ring.PushBack(kSecond), OkStatus());
+  EXPECT_EQ(reader.PopFront(), OkStatus());
+  // This entry starts at byte 12 and wraps around to the start of the buffer.
+  EXPECT_EQ(ring.PushBack(kWrapped), OkStatus());
+
+  std::array<PrefixedEntryRingBufferMulti::EntryView, 4> views;
+  size_t peeked = 0;
+  EXPECT_EQ(reader.PeekFrontEntries(views, peeked), OkStatus());
+  ASSERT_EQ(peeked, 2u);
+
+  EXPECT_TRUE(views[0].second.empty());
+  ASSERT_EQ(views[0].first.size(), kSecond.size());
+  EXPECT_EQ(std::memcmp(views[0].first.data(), kSecond.data(), kSecond.size()),
+            0);
+
+  ASSERT_EQ(views[1].first.size(), 3u);
+  ASSERT_EQ(views[1].second.size(), 2u);
+  EXPECT_EQ(views[1].second.data(), test_buffer);
+  EXPECT_EQ(std::memcmp(views[1].first.data(), kWrapped.data(), 3), 0);
+  EXPECT_EQ(std::memcmp(views[1].second.data(), kWrapped.data() + 3, 2), 0);
+
+  EXPECT_EQ(reader.PopFrontEntries(peeked), OkStatus());
+  EXPECT_EQ(reader.EntryCount(), 0u);
+  EXPECT_EQ(ring.TotalUsedBytes(), 0u);
+}
+
+TEST(PrefixedEntryRingBufferMulti, ReaderUnreadSizeBytes) {
+  PrefixedEntryRingBufferMulti ring;
+  // Each 5-byte entry takes 6 bytes including its size prefix.
+  byte test_buffer[12];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  PrefixedEntryRingBufferMulti::Reader fast_reader;
+  PrefixedEntryRingBufferMulti::Reader slow_reader;
+  EXPECT_EQ(ring.AttachReader(fast_reader), OkStatus());
+  EXPECT_EQ(ring.AttachReader(slow_reader), OkStatus());
+  EXPECT_EQ(slow_reader.UnreadSizeBytes(), 0u);
+
+  constexpr std::array<byte, 5> kEntry = {};
+  EXPECT_EQ(ring.PushBack(kEntry), OkStatus());
+  EXPECT_EQ(ring.PushBack(kEntry), OkStatus());
+  EXPECT_EQ(slow_reader.UnreadSizeBytes(), 12u);
+
+  EXPECT_EQ(fast_reader.PopFront(), OkStatus());
+  EXPECT_EQ(fast_reader.UnreadSizeBytes(), 6u);
+  EXPECT_EQ(slow_reader.UnreadSizeBytes(), 12u);
+
+  // Evicting the slow reader's front entry wraps the write index.
+  EXPECT_EQ(ring.PushBack(kEntry), OkStatus());
+  EXPECT_EQ(fast_reader.UnreadSizeBytes(), 12u);
+  EXPECT_EQ(slow_reader.UnreadSizeBytes(), 12u);
+  EXPECT_EQ(fast_reader.PopFront(), OkStatus());
+  EXPECT_EQ(fast_reader.UnreadSizeBytes(), 6u);
+  EXPECT_EQ(fast_reader.PopFront(), OkStatus());
+  EXPECT_EQ(fast_reader.UnreadSizeBytes(), 0u);
+}
+
+TEST(PrefixedEntryRingBufferMulti, ReserveAndCommit) {
+  PrefixedEntryRingBufferMulti ring(/*user_preamble=*/true);
+  byte test_buffer[256];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  PrefixedEntryRingBufferMulti::Reader reader;
+  EXPECT_EQ(ring.AttachReader(reader), OkStatus());
+
+  PrefixedEntryRingBufferMulti::Reservation reservation;
+  EXPECT_EQ(ring.Reserve(sizeof(test_buffer), reservation),
+            Status::OutOfRange());
+  EXPECT_EQ(ring.Commit(0), Status::FailedPrecondition());
+
+  // Reserve more than fits in a one-byte size prefix, then use less of it.
+  EXPECT_EQ(ring.Reserve(200, reservation, /*user_preamble_data=*/7),
+            OkStatus());
+  ASSERT_EQ(reservation.size(), 200u);
+  EXPECT_TRUE(reservation.second.empty());
+  EXPECT_EQ(reservation.first.data(), test_buffer + 3);
+
+  // The entry isn't visible, and nothing else can be pushed, until it is
+  // committed.
+  EXPECT_EQ(reader.EntryCount(), 0u);
+  EXPECT_EQ(ring.PushBack(span(test_buffer, 1)), Status::FailedPrecondition());
+  EXPECT_EQ(ring.TryReserve(1, reservation), Status::FailedPrecondition());
+
+  constexpr std::array<byte, 3> kData = {byte{1}, byte{2}, byte{3}};
+  std::memcpy(reservation.first.data(), kData.data(), kData.size());
+  EXPECT_EQ(ring.Commit(201), Status::InvalidArgument());
+  EXPECT_EQ(ring.Commit(kData.size()), OkStatus());
+  EXPECT_EQ(ring.Commit(0), Status::FailedPrecondition());
+
+  ASSERT_EQ(reader.EntryCount(), 1u);
+  // The size prefix keeps the two bytes that were reserved for it.
+  EXPECT_EQ(reader.FrontEntryDataSizeBytes(), kData.size());
+  EXPECT_EQ(reader.FrontEntryTotalSizeBytes(), 1u + 2u + kData.size());
+
+  std::array<byte, 8> entry_buffer;
+  uint32_t preamble = 0;
+  size_t bytes_read = 0;
+  EXPECT_EQ(reader.PeekFrontWithPreamble(entry_buffer, preamble, bytes_read),
+            OkStatus());
+  EXPECT_EQ(preamble, 7u);
+  ASSERT_EQ(bytes_read, kData.size());
+  EXPECT_EQ(std::memcmp(entry_buffer.data(), kData.data(), kData.size()), 0);
+  EXPECT_EQ(ring.CheckForCorruption(), OkStatus());
+
+  // Entries pushed after the committed one follow it.
+  EXPECT_EQ(PushBack<uint32_t>(ring, 42, 1), OkStatus());
+  EXPECT_EQ(reader.PopFront(), OkStatus());
+  EXPECT_EQ(PeekFront<uint32_t>(reader), 42u);
+}
+
+TEST(PrefixedEntryRingBufferMulti, ReserveSplitsWrappedSpace) {
+  PrefixedEntryRingBufferMulti ring;
+  // Each 5-byte entry takes 6 bytes including its size prefix.
+  byte test_buffer[16];
+  EXPECT_EQ(ring.SetBuffer(test_buffer), OkStatus());
+
+  PrefixedEntryRingBufferMulti::Reader reader;
+  EXPECT_EQ(ring.AttachReader(reader), OkStatus());
+
+  constexpr std::array<byte, 5> kEntry = {};
+  EXPECT_EQ(ring.PushBack(kEntry), OkStatus());
+  EXPECT_EQ(ring.PushBack(kEntry), OkStatus());
+  EXPECT_EQ(reader.PopFront(), OkStatus());
+
+  // The entry starts at byte 12, so its data wraps around to the start of the
+  // buffer.
+  PrefixedEntryRingBufferMulti::Reservation reservation;
+  EXPECT_EQ(ring.TryReserve(5, reservation), OkStatus());
+  ASSERT_EQ(reservation.first.size(), 3u);
+  ASSERT_EQ(reservation.second.size(), 2u);
+  EXPECT_EQ(reservation.first.data(), test_buffer + 13);
+  EXPECT_EQ(reservation.second.data(), test_buffer);
+
+  constexpr std::array<byte, 5> kWrapped = {
+      byte{11}, byte{12}, byte{13}, byte{14}, byte{15}};
+  std::memcpy(reservation.first.data(), kWrapped.data(), 3);
+  std::memcpy(reservation.second.data(), kWrapped.data() + 3, 2);
+  EXPECT_EQ(ring.Commit(kWrapped.size()), OkStatus());
+
+  EXPECT_EQ(reader.PopFront(), OkStatus());
+  std::array<byte, 5> entry_buffer;
+  size_t bytes_read = 0;
+  EXPECT_EQ(reader.PeekFront(entry_buffer, &bytes_read), OkStatus());
+  ASSERT_EQ(bytes_read, kWrapped.size());
+  EXPECT_EQ(entry_buffer, kWrapped);
+
+  // There is no room for another entry without evicting the front one.
+  EXPECT_EQ(ring.TryReserve(11, reservation), Status::ResourceExhausted());
+  EXPECT_EQ(ring.Reserve(11, reservation), OkStatus());
+  EXPECT_EQ(reader.EntryCount(), 0u);
+  ring.CancelReservation();
+
+  // Canceling the reservation leaves the ring buffer as it was.
+  EXPECT_EQ(ring.PushBack(kEntry), OkStatus());
+  EXPECT_EQ(reader.EntryCount(), 1u);
+  EXPECT_EQ(ring.CheckForCorruption(), OkStatus());
+}
+
 TEST(PrefixedEntryRingBufferMulti, IteratorEmptyBuffer) {
   PrefixedEntryRingBufferMulti ring;
   // Pick a buffer that can't contain any valid sections.
@@ -44,6 +44,20 @@ class PrefixedEntryRingBufferMulti {
  public:
   typedef Status (*ReadOutput)(span<const std::byte>);
 
+  // A view of an entry's data in place in the ring buffer, used to read
+  // entries without copying them. If the entry wraps around the end of the
+  // buffer, its data is split across `first` and `second`; otherwise `second`
+  // is empty. Views are invalidated by any operation that writes to the ring
+  // buffer.
+  struct EntryView {
+    span<const std::byte> first;
+    span<const std::byte> second;
+    uint32_t preamble;
+
+    // The total size of the entry's data.
+    size_t size() const { return first.size() + second.size(); }
+  };
+
   // A reader that provides a single-reader interface into the multi-reader ring
   // buffer it has been attached to via AttachReader(). Readers maintain their
   // read position in the ring buffer as well as the remaining count of entries
@@ -132,6 +146,39 @@ class PrefixedEntryRingBufferMulti {
     // OUT_OF_RANGE - No entries in ring buffer to pop.
     Status PopFront() { return buffer_->InternalPopFront(*this); }
 
+    // Peeks a run of entries from the front of the ring buffer without copying
+    // them. Fills `entries_out` with views of up to `entries_out.size()`
+    // entries, in order, and sets `entries_peeked_out` to the number of views
+    // filled in.
+    //
+    // Precondition: the buffer data must not be corrupt, otherwise there will
+    // be a crash.
+    //
+    // Return values:
+    // OK - At least one entry was peeked.
+    // FAILED_PRECONDITION - Buffer not initialized.
+    // OUT_OF_RANGE - No entries in ring buffer to read.
+    Status PeekFrontEntries(span<EntryView> entries_out,
+                            size_t& entries_peeked_out) const {
+      return buffer_->InternalPeekFrontEntries(
+          *this, entries_out, entries_peeked_out);
+    }
+
+    // Pops and discards the `count` oldest entries from the ring buffer, e.g.
+    // after handling entries from PeekFrontEntries().
+    //
+    // Precondition: the buffer data must not be corrupt, otherwise there will
+    // be a crash.
+    //
+    // Return values:
+    // OK - The entries were popped.
+    // FAILED_PRECONDITION - Buffer not initialized.
+    // OUT_OF_RANGE - Fewer than `count` entries in the ring buffer. No entries
+    // were popped.
+    Status PopFrontEntries(size_t count) {
+      return buffer_->InternalPopFrontEntries(*this, count);
+    }
+
     // Get the size in bytes of the next chunk, not including preamble, to be
     // read.
     //
@@ -156,6 +203,12 @@ class PrefixedEntryRingBufferMulti {
     // Entry count.
     size_t EntryCount() const { return entry_count_; }
 
+    // Get the number of bytes, including preambles, used by the entries that
+    // this reader has yet to read.
+    size_t UnreadSizeBytes() const {
+      return buffer_->InternalUnreadSizeBytes(*this);
+    }
+
    private:
     friend PrefixedEntryRingBufferMulti;
 
@@ -257,7 +310,10 @@ class PrefixedEntryRingBufferMulti {
       : buffer_(nullptr),
         buffer_bytes_(0),
         write_idx_(0),
-        user_preamble_(user_preamble) {}
+        user_preamble_(user_preamble),
+        reservation_pending_(false),
+        reserved_user_preamble_(0),
+        reserved_data_bytes_(0) {}
 
   // Set the raw buffer to be used by the ring buffer.
   //
@@ -309,7 +365,7 @@ class PrefixedEntryRingBufferMulti {
   //
   // Return values:
   // OK - Data successfully written to the ring buffer.
-  // FAILED_PRECONDITION - Buffer not initialized.
+  // FAILED_PRECONDITION - Buffer not initialized, or a reservation is pending.
   // OUT_OF_RANGE - Size of data is greater than buffer size.
   Status PushBack(span<const std::byte> data, uint32_t user_preamble_data = 0) {
     return InternalPushBack(data, user_preamble_data, true);
@@ -333,7 +389,7 @@ class PrefixedEntryRingBufferMulti {
   // Return values:
   // OK - Data successfully written to the ring buffer.
   // INVALID_ARGUMENT - Size of data to write is zero bytes
-  // FAILED_PRECONDITION - Buffer not initialized.
+  // FAILED_PRECONDITION - Buffer not initialized, or a reservation is pending.
   // OUT_OF_RANGE - Size of data is greater than buffer size.
   // RESOURCE_EXHAUSTED - The ring buffer doesn't have space for the data
   // without popping off existing elements.
@@ -348,6 +404,73 @@ class PrefixedEntryRingBufferMulti {
     return TryPushBack(data, static_cast<uint32_t>(user_preamble_data));
   }
 
+  // Space in the ring buffer reserved for a new entry's data by Reserve(), so
+  // that producers can encode the entry in place instead of copying it from a
+  // temporary buffer. If the space wraps around the end of the buffer, it is
+  // split across `first` and `second`; otherwise `second` is empty.
+  struct Reservation {
+    span<std::byte> first;
+    span<std::byte> second;
+
+    // The total size of the reserved space.
+    size_t size() const { return first.size() + second.size(); }
+  };
+
+  // Reserves space for an entry with up to `max_size_bytes` bytes of data. If
+  // available space is less than needed, silently pop and discard oldest
+  // stored data chunks until space is available, as PushBack() does. The data
+  // is written directly into `reservation_out`, and the entry is added by
+  // Commit().
+  //
+  // Only one reservation may be pending at a time. Until it is committed or
+  // canceled, no other entries may be pushed. Readers may keep reading and
+  // popping entries. Dering() keeps the reservation and the data written to
+  // it, but moves the reserved space, so the spans must not be written after
+  // deringing.
+  //
+  // Return values:
+  // OK - Space was reserved.
+  // FAILED_PRECONDITION - Buffer not initialized, or a reservation is already
+  // pending.
+  // OUT_OF_RANGE - Size of the entry is greater than buffer size.
+  Status Reserve(size_t max_size_bytes,
+                 Reservation& reservation_out,
+                 uint32_t user_preamble_data = 0) {
+    return InternalReserve(
+        max_size_bytes, user_preamble_data, true, reservation_out);
+  }
+
+  // Reserves space for an entry, as Reserve() does, only if there is space
+  // available without popping off existing elements.
+  //
+  // Return values:
+  // OK - Space was reserved.
+  // FAILED_PRECONDITION - Buffer not initialized, or a reservation is already
+  // pending.
+  // OUT_OF_RANGE - Size of the entry is greater than buffer size.
+  // RESOURCE_EXHAUSTED - The ring buffer doesn't have space for the entry
+  // without popping off existing elements.
+  Status TryReserve(size_t max_size_bytes,
+                    Reservation& reservation_out,
+                    uint32_t user_preamble_data = 0) {
+    return InternalReserve(
+        max_size_bytes, user_preamble_data, false, reservation_out);
+  }
+
+  // Adds the pending reservation's entry to the ring buffer, with the first
+  // `size_bytes` bytes written to the reservation as its data. Unused reserved
+  // space is returned to the ring buffer.
+  //
+  // Return values:
+  // OK - The entry was added to the ring buffer.
+  // FAILED_PRECONDITION - No reservation is pending.
+  // INVALID_ARGUMENT - `size_bytes` is larger than the reservation. The
+  // reservation is still pending.
+  Status Commit(size_t size_bytes);
+
+  // Releases the pending reservation, if any, without adding an entry.
+  void CancelReservation() { reservation_pending_ = false; }
+
   // Get the size in bytes of all the current entries in the ring buffer,
   // including preamble and data chunk.
   size_t TotalUsedBytes() const { return buffer_bytes_ - RawAvailableBytes(); }
@@ -406,6 +529,17 @@ class PrefixedEntryRingBufferMulti {
   // OUT_OF_RANGE - No entries in ring buffer to pop.
   Status InternalPopFront(Reader& reader);
 
+  // Fills `entries_out` with views of the entries at the front of the reader.
+  Status InternalPeekFrontEntries(const Reader& reader,
+                                  span<EntryView> entries_out,
+                                  size_t& entries_peeked_out) const;
+
+  // Pops `count` entries from the front of the reader.
+  Status InternalPopFrontEntries(Reader& reader, size_t count);
+
+  // Get the number of bytes used by the reader's unread entries.
+  size_t InternalUnreadSizeBytes(const Reader& reader) const;
+
   // Get the size in bytes of the next chunk, not including preamble, to be
   // read.
   size_t InternalFrontEntryDataSizeBytes(const Reader& reader) const;
@@ -444,6 +578,23 @@ class PrefixedEntryRingBufferMulti {
                           uint32_t user_preamble_data,
                           bool pop_front_if_needed);
 
+  // Reserve implementation, which optionally discards front elements to fit
+  // the reserved entry.
+  Status InternalReserve(size_t max_size_bytes,
+                         uint32_t user_preamble_data,
+                         bool pop_front_if_needed,
+                         Reservation& reservation_out);
+
+  // Makes `total_write_bytes` bytes available at the write index, optionally
+  // discarding front elements.
+  //
+  // Return values:
+  // OK - The space is available.
+  // OUT_OF_RANGE - The size is greater than buffer size.
+  // RESOURCE_EXHAUSTED - Front elements would need to be discarded, but
+  // `pop_front_if_needed` is false.
+  Status InternalMakeSpace(size_t total_write_bytes, bool pop_front_if_needed);
+
   // Internal function to pop all of the slowest readers. This function may pop
   // multiple readers if multiple are slow.
   //
@@ -500,6 +651,12 @@ class PrefixedEntryRingBufferMulti {
   size_t write_idx_;
   const bool user_preamble_;
 
+  // The pending reservation's entry starts at the write index, and its data
+  // follows a preamble sized for `reserved_data_bytes_` bytes.
+  bool reservation_pending_;
+  uint32_t reserved_user_preamble_;
+  size_t reserved_data_bytes_;
+
   // List of attached readers.
   IntrusiveList<Reader> readers_;
 
@@ -0,0 +1,87 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_router/dynamic_router.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace pw::router::internal {
+
+Status BasicDynamicRouter::AddRoute(uint32_t address, Egress& egress) {
+  std::lock_guard lock(mutex_);
+  auto route = LowerBound(address);
+  if (route != routes_.end() && route->address == address) {
+    return Status::AlreadyExists();
+  }
+  if (routes_.full()) {
+    return Status::ResourceExhausted();
+  }
+  routes_.insert(route, Route{address, &egress});
+  return OkStatus();
+}
+
+Status BasicDynamicRouter::RemoveRoute(uint32_t address) {
+  std::lock_guard lock(mutex_);
+  auto route = LowerBound(address);
+  if (route == routes_.end() || route->address != address) {
+    return Status::NotFound();
+  }
+  routes_.erase(route);
+  return OkStatus();
+}
+
+size_t BasicDynamicRouter::size() const {
+  std::lock_guard lock(mutex_);
+  return routes_.size();
+}
+
+Status BasicDynamicRouter::RoutePacket(ConstByteSpan packet,
+                                       PacketParser& parser) {
+  // Dynamic routes do not opt out of verification, so verify every packet.
+  if (!parser.Parse(packet) || !parser.VerifyPacket()) {
+    parser_errors_.Increment();
+    return Status::DataLoss();
+  }
+
+  std::optional<uint32_t> maybe_address = parser.GetDestinationAddress();
+  if (!maybe_address.has_value()) {
+    parser_errors_.Increment();
+    return Status::DataLoss();
+  }
+
+  std::lock_guard lock(mutex_);
+  auto route = LowerBound(*maybe_address);
+  if (route == routes_.end() || route->address != *maybe_address) {
+    route_errors_.Increment();
+    return Status::NotFound();
+  }
+
+  if (Status status = route->egress->SendPacket(packet, parser); !status.ok()) {
+    egress_errors_.Increment();
+    return Status::Unavailable();
+  }
+
+  return OkStatus();
+}
+
+Vector<BasicDynamicRouter::Route>::iterator BasicDynamicRouter::LowerBound(
+    uint32_t address) {
+  return std::lower_bound(
+      routes_.begin(), routes_.end(), address, [](const Route& r, uint32_t a) {
+        return r.address < a;
+      });
+}
+
+}  // namespace pw::router::internal
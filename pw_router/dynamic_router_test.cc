@@ -0,0 +1,173 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_router/dynamic_router.h"
+
+#include "pw_assert/check.h"
+#include "pw_router/egress_function.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::router {
+namespace {
+
+struct BasicPacket {
+  static constexpr uint32_t kMagic = 0x8badf00d;
+
+  constexpr BasicPacket(uint32_t addr, uint64_t data)
+      : magic(kMagic), address(addr), priority(0), payload(data) {}
+
+  constexpr BasicPacket(uint32_t addr, uint32_t prio, uint64_t data)
+      : magic(kMagic), address(addr), priority(prio), payload(data) {}
+
+  ConstByteSpan data() const { return as_bytes(span(this, 1)); }
+
+  uint32_t magic;
+  uint32_t address;
+  uint32_t priority;
+  uint64_t payload;
+};
+
+class BasicPacketParser : public PacketParser {
+ public:
+  constexpr BasicPacketParser() : packet_(nullptr) {}
+
+  bool Parse(pw::ConstByteSpan packet) final {
+    packet_ = reinterpret_cast<const BasicPacket*>(packet.data());
+    return packet_->magic == BasicPacket::kMagic;
+  }
+
+  std::optional<uint32_t> GetDestinationAddress() const final {
+    PW_DCHECK_NOTNULL(packet_);
+    return packet_->address;
+  }
+
+  uint32_t priority() const {
+    PW_DCHECK_NOTNULL(packet_);
+    return packet_->priority;
+  }
+
+ private:
+  const BasicPacket* packet_;
+};
+
+EgressFunction GoodEgress(+[](ConstByteSpan, const PacketParser&) {
+  return OkStatus();
+});
+EgressFunction BadEgress(+[](ConstByteSpan, const PacketParser&) {
+  return Status::ResourceExhausted();
+});
+
+TEST(DynamicRouter, RoutePacket_NoRoutes) {
+  BasicPacketParser parser;
+  DynamicRouter<4> router;
+  EXPECT_EQ(router.RoutePacket(BasicPacket(1, 0xdddd).data(), parser),
+            Status::NotFound());
+}
+
+TEST(DynamicRouter, RoutePacket_RoutesToAddedRoutes) {
+  BasicPacketParser parser;
+  DynamicRouter<4> router;
+  ASSERT_EQ(router.AddRoute(8, GoodEgress), OkStatus());
+  ASSERT_EQ(router.AddRoute(3, BadEgress), OkStatus());
+  ASSERT_EQ(router.AddRoute(5, GoodEgress), OkStatus());
+  EXPECT_EQ(router.size(), 3u);
+
+  EXPECT_EQ(router.RoutePacket(BasicPacket(8, 0xdddd).data(), parser),
+            OkStatus());
+  EXPECT_EQ(router.RoutePacket(BasicPacket(5, 0xdddd).data(), parser),
+            OkStatus());
+  EXPECT_EQ(router.RoutePacket(BasicPacket(3, 0xdddd).data(), parser),
+            Status::Unavailable());
+  EXPECT_EQ(router.RoutePacket(BasicPacket(4, 0xdddd).data(), parser),
+            Status::NotFound());
+}
+
+TEST(DynamicRouter, AddRoute_RejectsDuplicateAddress) {
+  DynamicRouter<4> router;
+  ASSERT_EQ(router.AddRoute(1, GoodEgress), OkStatus());
+  EXPECT_EQ(router.AddRoute(1, BadEgress), Status::AlreadyExists());
+  EXPECT_EQ(router.size(), 1u);
+
+  BasicPacketParser parser;
+  EXPECT_EQ(router.RoutePacket(BasicPacket(1, 0xdddd).data(), parser),
+            OkStatus());
+}
+
+TEST(DynamicRouter, AddRoute_FullTable) {
+  DynamicRouter<2> router;
+  ASSERT_EQ(router.AddRoute(1, GoodEgress), OkStatus());
+  ASSERT_EQ(router.AddRoute(2, GoodEgress), OkStatus());
+  EXPECT_EQ(router.AddRoute(3, GoodEgress), Status::ResourceExhausted());
+
+  ASSERT_EQ(router.RemoveRoute(1), OkStatus());
+  EXPECT_EQ(router.AddRoute(3, GoodEgress), OkStatus());
+}
+
+TEST(DynamicRouter, RemoveRoute_StopsRoutingToEgress) {
+  BasicPacketParser parser;
+  DynamicRouter<4> router;
+  ASSERT_EQ(router.AddRoute(1, GoodEgress), OkStatus());
+  ASSERT_EQ(router.AddRoute(2, GoodEgress), OkStatus());
+
+  ASSERT_EQ(router.RemoveRoute(1), OkStatus());
+  EXPECT_EQ(router.RemoveRoute(1), Status::NotFound());
+  EXPECT_EQ(router.RoutePacket(BasicPacket(1, 0xdddd).data(), parser),
+            Status::NotFound());
+  EXPECT_EQ(router.RoutePacket(BasicPacket(2, 0xdddd).data(), parser),
+            OkStatus());
+}
+
+TEST(DynamicRouter, RoutePacket_ForwardsPacketParser) {
+  uint32_t parser_priority = 0xffffffff;
+
+  EgressFunction parser_egress(
+      [&parser_priority](ConstByteSpan, const PacketParser& parser) {
+        const BasicPacketParser& basic_parser =
+            static_cast<const BasicPacketParser&>(parser);
+        parser_priority = basic_parser.priority();
+        return OkStatus();
+      });
+
+  DynamicRouter<1> router;
+  ASSERT_EQ(router.AddRoute(1, parser_egress), OkStatus());
+  BasicPacketParser parser;
+
+  EXPECT_EQ(router.RoutePacket(BasicPacket(1, 71, 0xdddd).data(), parser),
+            OkStatus());
+  EXPECT_EQ(parser_priority, 71u);
+}
+
+TEST(DynamicRouter, RoutePacket_TracksNumberOfDrops) {
+  BasicPacketParser parser;
+  DynamicRouter<2> router;
+  ASSERT_EQ(router.AddRoute(1, GoodEgress), OkStatus());
+  ASSERT_EQ(router.AddRoute(2, BadEgress), OkStatus());
+
+  EXPECT_EQ(router.RoutePacket(BasicPacket(1, 0xdddd).data(), parser),
+            OkStatus());
+  EXPECT_EQ(router.RoutePacket(BasicPacket(2, 0xdddd).data(), parser),
+            Status::Unavailable());
+
+  BasicPacket bad_magic(1, 0xdddd);
+  bad_magic.magic = 0x1badda7a;
+  EXPECT_EQ(router.RoutePacket(bad_magic.data(), parser), Status::DataLoss());
+
+  EXPECT_EQ(router.RoutePacket(BasicPacket(42, 0xdddd).data(), parser),
+            Status::NotFound());
+
+  EXPECT_EQ(router.dropped_packets(), 3u);
+}
+
+}  // namespace
+}  // namespace pw::router
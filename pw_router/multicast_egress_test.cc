@@ -0,0 +1,84 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_router/multicast_egress.h"
+
+#include <array>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::router {
+namespace {
+
+class BroadcastPacketParser : public PacketParser {
+ public:
+  bool Parse(ConstByteSpan) final { return true; }
+  std::optional<uint32_t> GetDestinationAddress() const final {
+    return 0xffffffff;
+  }
+};
+
+// Counts the packets sent to it, and fails them if it is not ready.
+class CountingEgress : public Egress {
+ public:
+  Status SendPacket(ConstByteSpan, const PacketParser&) final {
+    ++packets;
+    return ready ? OkStatus() : Status::Unavailable();
+  }
+
+  bool ready = true;
+  int packets = 0;
+};
+
+constexpr std::array<std::byte, 4> kPacket = {};
+
+TEST(MulticastEgress, SendsToAllEgresses) {
+  BroadcastPacketParser parser;
+  CountingEgress a, b, c;
+  const std::array<Egress*, 3> egresses = {&a, &b, &c};
+  MulticastEgress multicast(egresses);
+
+  EXPECT_EQ(multicast.SendPacket(kPacket, parser), OkStatus());
+  EXPECT_EQ(multicast.SendPacket(kPacket, parser), OkStatus());
+
+  EXPECT_EQ(a.packets, 2);
+  EXPECT_EQ(b.packets, 2);
+  EXPECT_EQ(c.packets, 2);
+  EXPECT_EQ(multicast.egress_errors(), 0u);
+}
+
+TEST(MulticastEgress, FailingEgressDoesNotBlockOthers) {
+  BroadcastPacketParser parser;
+  CountingEgress a, b, c;
+  b.ready = false;
+  const std::array<Egress*, 3> egresses = {&a, &b, &c};
+  MulticastEgress multicast(egresses);
+
+  EXPECT_EQ(multicast.SendPacket(kPacket, parser), Status::Unavailable());
+
+  EXPECT_EQ(a.packets, 1);
+  EXPECT_EQ(b.packets, 1);
+  EXPECT_EQ(c.packets, 1);
+  EXPECT_EQ(multicast.egress_errors(), 1u);
+}
+
+TEST(MulticastEgress, NoEgresses) {
+  BroadcastPacketParser parser;
+  MulticastEgress multicast(span<Egress* const>{});
+  EXPECT_EQ(multicast.SendPacket(kPacket, parser), OkStatus());
+}
+
+}  // namespace
+}  // namespace pw::router
@@ -0,0 +1,118 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_containers/vector.h"
+#include "pw_metric/metric.h"
+#include "pw_router/egress.h"
+#include "pw_router/packet_parser.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::router {
+namespace internal {
+
+// The routing logic of a DynamicRouter, independent of its capacity.
+class BasicDynamicRouter {
+ public:
+  BasicDynamicRouter(const BasicDynamicRouter&) = delete;
+  BasicDynamicRouter(BasicDynamicRouter&&) = delete;
+  BasicDynamicRouter& operator=(const BasicDynamicRouter&) = delete;
+  BasicDynamicRouter& operator=(BasicDynamicRouter&&) = delete;
+
+  uint32_t dropped_packets() const {
+    return parser_errors_.value() + route_errors_.value() +
+           egress_errors_.value();
+  }
+
+  const metric::Group& metrics() { return metrics_; }
+
+  // Adds a route to an egress for packets to an address. Returns one of:
+  //
+  //   OK - The route was added.
+  //   ALREADY_EXISTS - There is already a route for the address.
+  //   RESOURCE_EXHAUSTED - The routing table is full.
+  //
+  Status AddRoute(uint32_t address, Egress& egress) PW_LOCKS_EXCLUDED(mutex_);
+
+  // Removes the route for an address. Once this returns, no more packets are
+  // sent to the route's egress. Returns NOT_FOUND if there is no route for the
+  // address.
+  Status RemoveRoute(uint32_t address) PW_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of routes in the routing table.
+  size_t size() const PW_LOCKS_EXCLUDED(mutex_);
+
+  // Routes a single packet through the appropriate egress.
+  // Returns one of the following to indicate a router-side error:
+  //
+  //   OK - Packet sent successfully.
+  //   DATA_LOSS - Packet corrupt or incomplete.
+  //   NOT_FOUND - No registered route for the packet.
+  //   UNAVAILABLE - Route egress did not accept packet.
+  //
+  Status RoutePacket(ConstByteSpan packet, PacketParser& parser)
+      PW_LOCKS_EXCLUDED(mutex_);
+
+ protected:
+  struct Route {
+    uint32_t address;
+    Egress* egress;
+  };
+
+  BasicDynamicRouter(Vector<Route>& routes) : routes_(routes) {}
+
+ private:
+  // Returns the first route with an address of at least `address`.
+  Vector<Route>::iterator LowerBound(uint32_t address)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable sync::Mutex mutex_;
+
+  // Sorted by address.
+  Vector<Route>& routes_ PW_GUARDED_BY(mutex_);
+
+  PW_METRIC_GROUP(metrics_, "dynamic_router");
+  PW_METRIC(metrics_, parser_errors_, "parser_errors", 0u);
+  PW_METRIC(metrics_, route_errors_, "route_errors", 0u);
+  PW_METRIC(metrics_, egress_errors_, "egress_errors", 0u);
+};
+
+}  // namespace internal
+
+// A packet router whose routes can be added and removed at runtime, such as
+// for devices that are connected after startup. Holds up to kMaxRoutes
+// routes, which are kept sorted by address so that each packet's route is
+// found with a binary search.
+//
+// Thread-safety:
+//   Routes may be added and removed while packets are being routed. Packets
+//   are routed one at a time, and the router's lock is held while a packet is
+//   sent to its egress, so egresses must not call back into the router.
+//
+template <size_t kMaxRoutes>
+class DynamicRouter : public internal::BasicDynamicRouter {
+ public:
+  DynamicRouter() : BasicDynamicRouter(routes_) {}
+
+ private:
+  Vector<Route, kMaxRoutes> routes_;
+};
+
+}  // namespace pw::router
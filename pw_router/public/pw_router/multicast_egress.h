@@ -0,0 +1,55 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_metric/metric.h"
+#include "pw_router/egress.h"
+#include "pw_router/packet_parser.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::router {
+
+// Router egress that sends each packet to several egresses, for routing
+// packets to broadcast or multicast addresses. Register it as the egress of
+// the route for the broadcast address.
+//
+// Packets are sent to every egress, in order, even if some of them fail. To
+// keep one stalled egress from holding up or dropping packets for the others,
+// wrap each one in a QueuedEgress.
+class MulticastEgress final : public Egress {
+ public:
+  MulticastEgress(span<Egress* const> egresses)
+      : egresses_(egresses) {}
+
+  // Sends a packet to all egresses. Returns OK if every egress accepted the
+  // packet, or UNAVAILABLE if any of them did not.
+  Status SendPacket(ConstByteSpan packet, const PacketParser& parser) final;
+
+  uint32_t egress_errors() const { return egress_errors_.value(); }
+
+  const metric::Group& metrics() { return metrics_; }
+
+ private:
+  const span<Egress* const> egresses_;
+
+  PW_METRIC_GROUP(metrics_, "multicast_egress");
+  PW_METRIC(metrics_, egress_errors_, "egress_errors", 0u);
+};
+
+}  // namespace pw::router
@@ -42,6 +42,15 @@ class PacketParser {
   // Guaranteed to only be called if Parse() succeeded and while the data passed
   // to Parse() is valid.
   virtual std::optional<uint32_t> GetDestinationAddress() const = 0;
+
+  // Verifies the integrity of the last parsed packet. Parsers that check the
+  // whole packet in Parse() do not need to override this. Parsers that defer
+  // checks in Parse() to route packets faster perform them here, and routers
+  // call this for routes that require verified packets.
+  //
+  // Guaranteed to only be called if Parse() succeeded and while the data passed
+  // to Parse() is valid.
+  virtual bool VerifyPacket() { return true; }
 };
 
 }  // namespace pw::router
@@ -0,0 +1,137 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_containers/inline_var_len_entry_queue.h"
+#include "pw_metric/metric.h"
+#include "pw_router/egress.h"
+#include "pw_router/packet_parser.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::router {
+namespace internal {
+
+// The queueing logic of a QueuedEgress, independent of its buffer sizes.
+class BasicQueuedEgress : public Egress {
+ public:
+  BasicQueuedEgress(const BasicQueuedEgress&) = delete;
+  BasicQueuedEgress(BasicQueuedEgress&&) = delete;
+  BasicQueuedEgress& operator=(const BasicQueuedEgress&) = delete;
+  BasicQueuedEgress& operator=(BasicQueuedEgress&&) = delete;
+
+  // Sends a packet to the wrapped egress, or queues it if the egress does not
+  // accept it. Packets are always sent in the order they are received, so
+  // while any packets are queued, new packets are queued behind them. Returns
+  // one of:
+  //
+  //   OK - The packet was sent or queued.
+  //   RESOURCE_EXHAUSTED - The packet could not be sent and did not fit in the
+  //       queue, so it was dropped.
+  //
+  Status SendPacket(ConstByteSpan packet, const PacketParser& parser) final
+      PW_LOCKS_EXCLUDED(mutex_);
+
+  // Sends queued packets to the wrapped egress, in order, until the queue is
+  // empty or the egress stops accepting them. Call this when the egress may be
+  // able to accept packets again, e.g. when its transport finishes a write.
+  // Returns OK if the queue was emptied, or UNAVAILABLE if packets remain.
+  Status SendQueuedPackets() PW_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of packets waiting to be sent.
+  size_t queue_depth_packets() const PW_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of bytes of packets waiting to be sent.
+  size_t queue_depth_bytes() const PW_LOCKS_EXCLUDED(mutex_);
+
+  uint32_t queued_packets() const { return queued_packets_.value(); }
+  uint32_t dropped_packets() const { return dropped_packets_.value(); }
+  uint32_t max_queue_depth_bytes() const {
+    return max_queue_depth_bytes_.value();
+  }
+
+  const metric::Group& metrics() { return metrics_; }
+
+ protected:
+  BasicQueuedEgress(Egress& egress,
+                    PacketParser& parser,
+                    InlineVarLenEntryQueue<>& queue,
+                    ByteSpan packet_buffer)
+      : egress_(egress),
+        parser_(parser),
+        queue_(queue),
+        packet_buffer_(packet_buffer) {}
+
+ private:
+  // Sends queued packets until the queue is empty or the egress rejects one.
+  // Returns true if the queue is empty.
+  bool DrainQueue() PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  Egress& egress_;
+
+  mutable sync::Mutex mutex_;
+  PacketParser& parser_ PW_GUARDED_BY(mutex_);
+  InlineVarLenEntryQueue<>& queue_ PW_GUARDED_BY(mutex_);
+  ByteSpan packet_buffer_ PW_GUARDED_BY(mutex_);
+
+  PW_METRIC_GROUP(metrics_, "queued_egress");
+  PW_METRIC(metrics_, queued_packets_, "queued_packets", 0u);
+  PW_METRIC(metrics_, dropped_packets_, "dropped_packets", 0u);
+  PW_METRIC(metrics_, max_queue_depth_bytes_, "max_queue_depth_bytes", 0u);
+};
+
+}  // namespace internal
+
+// Router egress that buffers packets which another egress is not ready to
+// accept, so that a transient stall on a transport doesn't drop packets.
+//
+// Packets are sent straight through to the wrapped egress while it accepts
+// them. When the egress returns an error, the packet is copied into a queue
+// of kQueueSizeBytes bytes, and it and any later packets are re-sent in order
+// by the next SendPacket() or SendQueuedPackets() call. Packets are only
+// dropped once the queue is full.
+//
+// Queued packets are copied to an internal buffer of kMaxPacketSizeBytes bytes
+// and re-parsed with the parser passed to the constructor before they are
+// sent. This parser must not be shared with a router, since the QueuedEgress
+// uses it from within the router's SendPacket() call. Packets larger than
+// kMaxPacketSizeBytes are never queued.
+//
+// Thread-safety:
+//   SendPacket() and SendQueuedPackets() may be called from different
+//   threads. The wrapped egress is called with the QueuedEgress's lock held.
+//
+template <size_t kQueueSizeBytes, size_t kMaxPacketSizeBytes>
+class QueuedEgress : public internal::BasicQueuedEgress {
+ public:
+  static_assert(kMaxPacketSizeBytes <= kQueueSizeBytes,
+                "The queue must be able to hold a packet of the maximum size");
+
+  QueuedEgress(Egress& egress, PacketParser& parser)
+      : BasicQueuedEgress(egress, parser, queue_, packet_buffer_) {}
+
+ private:
+  InlineVarLenEntryQueue<kQueueSizeBytes> queue_;
+  alignas(std::max_align_t) std::array<std::byte, kMaxPacketSizeBytes>
+      packet_buffer_;
+};
+
+}  // namespace pw::router
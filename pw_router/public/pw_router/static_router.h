@@ -24,6 +24,10 @@ namespace pw::router {
 
 // A packet router with a static routing table.
 //
+// If the routes are sorted by address, they are found with a binary search.
+// Otherwise, each packet's route is found with a linear search of the table.
+// Sort large routing tables to keep lookups fast.
+//
 // Thread-safety:
 //   Internal packet parsing and calls to the provided PacketParser are
 //   synchronized. Synchronization at the egress level must be implemented by
@@ -35,9 +39,15 @@ class StaticRouter {
     // TODO(frolv): Consider making address size configurable.
     uint32_t address;
     Egress& egress;
+
+    // Whether packets must pass the parser's VerifyPacket() check before they
+    // are sent through this route. Disabling this lets parsers that defer
+    // verification forward packets without checking them in full, e.g. when
+    // the egress leads to a decoder that verifies packets itself.
+    bool verify_packet = true;
   };
 
-  StaticRouter(span<const Route> routes) : routes_(routes) {}
+  StaticRouter(span<const Route> routes);
 
   StaticRouter(const StaticRouter&) = delete;
   StaticRouter(StaticRouter&&) = delete;
@@ -55,14 +65,19 @@ class StaticRouter {
   // Returns one of the following to indicate a router-side error:
   //
   //   OK - Packet sent successfully.
-  //   DATA_LOSS - Packet corrupt or incomplete.
+  //   DATA_LOSS - Packet corrupt or incomplete, or failed verification for a
+  //               route that requires it.
   //   NOT_FOUND - No registered route for the packet.
   //   UNAVAILABLE - Route egress did not accept packet.
   //
   Status RoutePacket(ConstByteSpan packet, PacketParser& parser);
 
  private:
+  // Returns the route for an address, or nullptr if there is none.
+  const Route* FindRoute(uint32_t address) const;
+
   const span<const Route> routes_;
+  const bool sorted_;
   PW_METRIC_GROUP(metrics_, "static_router");
   PW_METRIC(metrics_, parser_errors_, "parser_errors", 0u);
   PW_METRIC(metrics_, route_errors_, "route_errors", 0u);
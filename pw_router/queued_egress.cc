@@ -0,0 +1,73 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_router/queued_egress.h"
+
+#include <mutex>
+
+namespace pw::router::internal {
+
+Status BasicQueuedEgress::SendPacket(ConstByteSpan packet,
+                                     const PacketParser& parser) {
+  std::lock_guard lock(mutex_);
+  if (DrainQueue() && egress_.SendPacket(packet, parser).ok()) {
+    return OkStatus();
+  }
+
+  if (packet.size() > packet_buffer_.size() || !queue_.try_push(packet)) {
+    dropped_packets_.Increment();
+    return Status::ResourceExhausted();
+  }
+
+  queued_packets_.Increment();
+  if (queue_.size_bytes() > max_queue_depth_bytes_.value()) {
+    max_queue_depth_bytes_.Set(queue_.size_bytes());
+  }
+  return OkStatus();
+}
+
+Status BasicQueuedEgress::SendQueuedPackets() {
+  std::lock_guard lock(mutex_);
+  return DrainQueue() ? OkStatus() : Status::Unavailable();
+}
+
+size_t BasicQueuedEgress::queue_depth_packets() const {
+  std::lock_guard lock(mutex_);
+  return queue_.size();
+}
+
+size_t BasicQueuedEgress::queue_depth_bytes() const {
+  std::lock_guard lock(mutex_);
+  return queue_.size_bytes();
+}
+
+bool BasicQueuedEgress::DrainQueue() {
+  while (!queue_.empty()) {
+    const ConstByteSpan packet = packet_buffer_.first(queue_.front().copy(
+        packet_buffer_.data(), packet_buffer_.size()));
+
+    if (!parser_.Parse(packet)) {
+      // A packet that doesn't parse can never be sent, so drop it rather than
+      // blocking the queue.
+      dropped_packets_.Increment();
+    } else if (!egress_.SendPacket(packet, parser_).ok()) {
+      return false;
+    }
+    queue_.pop();
+  }
+  return true;
+}
+
+}  // namespace pw::router::internal
@@ -0,0 +1,202 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_router/queued_egress.h"
+
+#include <cstring>
+
+#include "pw_assert/check.h"
+#include "pw_containers/vector.h"
+#include "pw_router/dynamic_router.h"
+#include "pw_router/egress_function.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::router {
+namespace {
+
+struct BasicPacket {
+  static constexpr uint32_t kMagic = 0x8badf00d;
+
+  constexpr BasicPacket(uint32_t addr, uint64_t data)
+      : magic(kMagic), address(addr), payload(data) {}
+
+  ConstByteSpan data() const { return as_bytes(span(this, 1)); }
+
+  uint32_t magic;
+  uint32_t address;
+  uint64_t payload;
+};
+
+class BasicPacketParser : public PacketParser {
+ public:
+  constexpr BasicPacketParser() : packet_(nullptr) {}
+
+  bool Parse(pw::ConstByteSpan packet) final {
+    packet_ = reinterpret_cast<const BasicPacket*>(packet.data());
+    return packet_->magic == BasicPacket::kMagic;
+  }
+
+  std::optional<uint32_t> GetDestinationAddress() const final {
+    PW_DCHECK_NOTNULL(packet_);
+    return packet_->address;
+  }
+
+ private:
+  const BasicPacket* packet_;
+};
+
+// Records the payloads of the packets it accepts while it is ready.
+class StallingEgress : public Egress {
+ public:
+  Status SendPacket(ConstByteSpan packet, const PacketParser& parser) final {
+    PW_CHECK_UINT_EQ(packet.size(), sizeof(BasicPacket));
+    BasicPacket received(0, 0);
+    std::memcpy(&received, packet.data(), sizeof(received));
+    PW_CHECK_UINT_EQ(parser.GetDestinationAddress().value(), received.address);
+    if (!ready || payloads.full()) {
+      return Status::Unavailable();
+    }
+    payloads.push_back(received.payload);
+    return OkStatus();
+  }
+
+  bool ready = true;
+  Vector<uint64_t, 8> payloads;
+};
+
+constexpr size_t kPacketSize = sizeof(BasicPacket);
+
+TEST(QueuedEgress, SendsDirectlyWhenEgressIsReady) {
+  BasicPacketParser route_parser, queue_parser;
+  StallingEgress egress;
+  QueuedEgress<64, kPacketSize> queued(egress, queue_parser);
+
+  const BasicPacket packet(1, 0xaa);
+  ASSERT_TRUE(route_parser.Parse(packet.data()));
+  EXPECT_EQ(queued.SendPacket(packet.data(), route_parser), OkStatus());
+
+  ASSERT_EQ(egress.payloads.size(), 1u);
+  EXPECT_EQ(egress.payloads[0], 0xaau);
+  EXPECT_EQ(queued.queue_depth_packets(), 0u);
+  EXPECT_EQ(queued.queued_packets(), 0u);
+}
+
+TEST(QueuedEgress, QueuesPacketsWhileEgressIsStalled) {
+  BasicPacketParser route_parser, queue_parser;
+  StallingEgress egress;
+  QueuedEgress<64, kPacketSize> queued(egress, queue_parser);
+
+  egress.ready = false;
+  for (uint64_t payload = 1; payload <= 3; ++payload) {
+    const BasicPacket packet(1, payload);
+    ASSERT_TRUE(route_parser.Parse(packet.data()));
+    EXPECT_EQ(queued.SendPacket(packet.data(), route_parser), OkStatus());
+  }
+  EXPECT_EQ(queued.queue_depth_packets(), 3u);
+  EXPECT_EQ(queued.queue_depth_bytes(), 3 * kPacketSize);
+  EXPECT_EQ(queued.SendQueuedPackets(), Status::Unavailable());
+  EXPECT_TRUE(egress.payloads.empty());
+
+  egress.ready = true;
+  EXPECT_EQ(queued.SendQueuedPackets(), OkStatus());
+  EXPECT_EQ(queued.queue_depth_packets(), 0u);
+  ASSERT_EQ(egress.payloads.size(), 3u);
+  EXPECT_EQ(egress.payloads[0], 1u);
+  EXPECT_EQ(egress.payloads[1], 2u);
+  EXPECT_EQ(egress.payloads[2], 3u);
+
+  EXPECT_EQ(queued.queued_packets(), 3u);
+  EXPECT_EQ(queued.dropped_packets(), 0u);
+  EXPECT_EQ(queued.max_queue_depth_bytes(), 3 * kPacketSize);
+}
+
+TEST(QueuedEgress, NewPacketsAreSentAfterQueuedPackets) {
+  BasicPacketParser route_parser, queue_parser;
+  StallingEgress egress;
+  QueuedEgress<64, kPacketSize> queued(egress, queue_parser);
+
+  egress.ready = false;
+  const BasicPacket first(1, 1);
+  ASSERT_TRUE(route_parser.Parse(first.data()));
+  EXPECT_EQ(queued.SendPacket(first.data(), route_parser), OkStatus());
+
+  egress.ready = true;
+  const BasicPacket second(1, 2);
+  ASSERT_TRUE(route_parser.Parse(second.data()));
+  EXPECT_EQ(queued.SendPacket(second.data(), route_parser), OkStatus());
+
+  ASSERT_EQ(egress.payloads.size(), 2u);
+  EXPECT_EQ(egress.payloads[0], 1u);
+  EXPECT_EQ(egress.payloads[1], 2u);
+}
+
+TEST(QueuedEgress, DropsPacketsWhenQueueIsFull) {
+  BasicPacketParser route_parser, queue_parser;
+  StallingEgress egress;
+  // Room for two packets, including their size prefixes.
+  QueuedEgress<2 * kPacketSize + 1, kPacketSize> queued(egress, queue_parser);
+
+  egress.ready = false;
+  for (uint64_t payload = 1; payload <= 3; ++payload) {
+    const BasicPacket packet(1, payload);
+    ASSERT_TRUE(route_parser.Parse(packet.data()));
+    EXPECT_EQ(queued.SendPacket(packet.data(), route_parser),
+              payload <= 2 ? OkStatus() : Status::ResourceExhausted());
+  }
+  EXPECT_EQ(queued.queue_depth_packets(), 2u);
+  EXPECT_EQ(queued.queued_packets(), 2u);
+  EXPECT_EQ(queued.dropped_packets(), 1u);
+
+  egress.ready = true;
+  EXPECT_EQ(queued.SendQueuedPackets(), OkStatus());
+  ASSERT_EQ(egress.payloads.size(), 2u);
+  EXPECT_EQ(egress.payloads[0], 1u);
+  EXPECT_EQ(egress.payloads[1], 2u);
+}
+
+TEST(QueuedEgress, DropsPacketsLargerThanMaxPacketSize) {
+  BasicPacketParser route_parser, queue_parser;
+  EgressFunction egress(
+      +[](ConstByteSpan, const PacketParser&) { return Status::Unavailable(); });
+  QueuedEgress<64, kPacketSize - 1> queued(egress, queue_parser);
+
+  const BasicPacket packet(1, 1);
+  ASSERT_TRUE(route_parser.Parse(packet.data()));
+  EXPECT_EQ(queued.SendPacket(packet.data(), route_parser),
+            Status::ResourceExhausted());
+  EXPECT_EQ(queued.queue_depth_packets(), 0u);
+  EXPECT_EQ(queued.dropped_packets(), 1u);
+}
+
+TEST(QueuedEgress, RouterQueuesForStalledRoute) {
+  BasicPacketParser route_parser, queue_parser;
+  StallingEgress egress;
+  QueuedEgress<64, kPacketSize> queued(egress, queue_parser);
+  DynamicRouter<1> router;
+  ASSERT_EQ(router.AddRoute(1, queued), OkStatus());
+
+  egress.ready = false;
+  EXPECT_EQ(router.RoutePacket(BasicPacket(1, 1).data(), route_parser),
+            OkStatus());
+  EXPECT_EQ(router.dropped_packets(), 0u);
+
+  egress.ready = true;
+  EXPECT_EQ(queued.SendQueuedPackets(), OkStatus());
+  ASSERT_EQ(egress.payloads.size(), 1u);
+  EXPECT_EQ(egress.payloads[0], 1u);
+}
+
+}  // namespace
+}  // namespace pw::router
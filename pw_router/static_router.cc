@@ -18,6 +18,29 @@
 
 namespace pw::router {
 
+StaticRouter::StaticRouter(span<const Route> routes)
+    : routes_(routes),
+      sorted_(std::is_sorted(
+          routes.begin(), routes.end(), [](const Route& a, const Route& b) {
+            return a.address < b.address;
+          })) {}
+
+const StaticRouter::Route* StaticRouter::FindRoute(uint32_t address) const {
+  if (sorted_) {
+    auto route = std::lower_bound(
+        routes_.begin(), routes_.end(), address, [](const Route& r, uint32_t a) {
+          return r.address < a;
+        });
+    return route != routes_.end() && route->address == address ? &*route
+                                                               : nullptr;
+  }
+
+  auto route = std::find_if(routes_.begin(), routes_.end(), [&](auto r) {
+    return r.address == address;
+  });
+  return route != routes_.end() ? &*route : nullptr;
+}
+
 Status StaticRouter::RoutePacket(ConstByteSpan packet, PacketParser& parser) {
   if (!parser.Parse(packet)) {
     parser_errors_.Increment();
@@ -30,14 +53,17 @@ Status StaticRouter::RoutePacket(ConstByteSpan packet, PacketParser& parser) {
     return Status::DataLoss();
   }
 
-  auto route = std::find_if(routes_.begin(), routes_.end(), [&](auto r) {
-    return r.address == *maybe_address;
-  });
-  if (route == routes_.end()) {
+  const Route* route = FindRoute(*maybe_address);
+  if (route == nullptr) {
     route_errors_.Increment();
     return Status::NotFound();
   }
 
+  if (route->verify_packet && !parser.VerifyPacket()) {
+    parser_errors_.Increment();
+    return Status::DataLoss();
+  }
+
   if (Status status = route->egress.SendPacket(packet, parser); !status.ok()) {
     egress_errors_.Increment();
     return Status::Unavailable();
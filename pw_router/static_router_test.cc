@@ -147,5 +147,67 @@ TEST(StaticRouter, RoutePacket_TracksNumberOfDrops) {
   EXPECT_EQ(router.dropped_packets(), 3u);
 }
 
+TEST(StaticRouter, RoutePacket_SortedRoutes) {
+  BasicPacketParser parser;
+  constexpr StaticRouter::Route routes[] = {
+      {1, GoodEgress}, {3, BadEgress}, {5, GoodEgress}, {8, GoodEgress}};
+  StaticRouter router(routes);
+
+  for (uint32_t address : {1u, 5u, 8u}) {
+    EXPECT_EQ(router.RoutePacket(BasicPacket(address, 0xdddd).data(), parser),
+              OkStatus());
+  }
+  EXPECT_EQ(router.RoutePacket(BasicPacket(3, 0xdddd).data(), parser),
+            Status::Unavailable());
+  for (uint32_t address : {0u, 2u, 4u, 9u}) {
+    EXPECT_EQ(router.RoutePacket(BasicPacket(address, 0xdddd).data(), parser),
+              Status::NotFound());
+  }
+}
+
+TEST(StaticRouter, RoutePacket_UnsortedRoutes) {
+  BasicPacketParser parser;
+  constexpr StaticRouter::Route routes[] = {
+      {8, GoodEgress}, {3, BadEgress}, {5, GoodEgress}, {1, GoodEgress}};
+  StaticRouter router(routes);
+
+  for (uint32_t address : {1u, 5u, 8u}) {
+    EXPECT_EQ(router.RoutePacket(BasicPacket(address, 0xdddd).data(), parser),
+              OkStatus());
+  }
+  EXPECT_EQ(router.RoutePacket(BasicPacket(3, 0xdddd).data(), parser),
+            Status::Unavailable());
+  for (uint32_t address : {0u, 2u, 4u, 9u}) {
+    EXPECT_EQ(router.RoutePacket(BasicPacket(address, 0xdddd).data(), parser),
+              Status::NotFound());
+  }
+}
+
+class FailingVerificationParser : public BasicPacketParser {
+ public:
+  bool VerifyPacket() override {
+    verify_calls += 1;
+    return false;
+  }
+
+  int verify_calls = 0;
+};
+
+TEST(StaticRouter, RoutePacket_VerifiesPacketsForRoutesThatRequireIt) {
+  FailingVerificationParser parser;
+  constexpr StaticRouter::Route routes[] = {
+      {1, GoodEgress}, {2, GoodEgress, /*verify_packet=*/false}};
+  StaticRouter router(routes);
+
+  EXPECT_EQ(router.RoutePacket(BasicPacket(1, 0xdddd).data(), parser),
+            Status::DataLoss());
+  EXPECT_EQ(parser.verify_calls, 1);
+
+  EXPECT_EQ(router.RoutePacket(BasicPacket(2, 0xdddd).data(), parser),
+            OkStatus());
+  EXPECT_EQ(parser.verify_calls, 1);
+  EXPECT_EQ(router.dropped_packets(), 1u);
+}
+
 }  // namespace
 }  // namespace pw::router
@@ -15,12 +15,87 @@
 #include "pw_rpc/benchmark.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 
+#include "pw_chrono/system_clock.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_protobuf/serialized_size.h"
+#include "pw_result/result.h"
+#include "pw_rpc/benchmark.pwpb.h"
 #include "pw_rpc/internal/config.h"
 
 namespace pw::rpc {
 namespace {
 
+namespace PayloadRequest = pwpb::PayloadRequest;
+namespace TimedPayload = pwpb::TimedPayload;
+
+// Largest possible encoded TimedPayload message.
+constexpr size_t kMaxTimedPayloadMessageSizeBytes =
+    protobuf::SizeOfFieldBytes(
+        TimedPayload::Fields::kPayload,
+        BenchmarkService::kMaxTimedPayloadSizeBytes) +
+    protobuf::SizeOfFieldInt64(TimedPayload::Fields::kServerTimestampNs) +
+    protobuf::SizeOfFieldUint32(TimedPayload::Fields::kSequence);
+
+// The contents of TimedPayload payloads. The contents are not significant.
+constexpr std::array<std::byte, BenchmarkService::kMaxTimedPayloadSizeBytes>
+    kPayloadData{};
+
+struct TimedRequest {
+  uint32_t payload_size = 0;
+  uint32_t count = 0;
+};
+
+Result<TimedRequest> DecodeTimedRequest(ConstByteSpan request) {
+  TimedRequest decoded;
+  Status status;
+  protobuf::Decoder decoder(request);
+
+  while ((status = decoder.Next()).ok()) {
+    switch (static_cast<PayloadRequest::Fields>(decoder.FieldNumber())) {
+      case PayloadRequest::Fields::kPayloadSize:
+        // A decode error will propagate from Next() and terminate the loop.
+        decoder.ReadUint32(&decoded.payload_size).IgnoreError();
+        break;
+      case PayloadRequest::Fields::kCount:
+        // A decode error will propagate from Next() and terminate the loop.
+        decoder.ReadUint32(&decoded.count).IgnoreError();
+        break;
+      case PayloadRequest::Fields::kPadding:
+        break;
+    }
+  }
+
+  if (status.IsDataLoss()) {
+    return status;
+  }
+  if (decoded.payload_size > BenchmarkService::kMaxTimedPayloadSizeBytes) {
+    return Status::ResourceExhausted();
+  }
+  return decoded;
+}
+
+// Encodes a TimedPayload stamped with the current time into buffer.
+Result<ConstByteSpan> EncodeTimedPayload(uint32_t payload_size,
+                                         uint32_t sequence,
+                                         ByteSpan buffer) {
+  const int64_t timestamp_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          chrono::SystemClock::now().time_since_epoch())
+          .count();
+
+  TimedPayload::MemoryEncoder encoder(buffer);
+  encoder.WritePayload(span(kPayloadData).first(payload_size)).IgnoreError();
+  encoder.WriteServerTimestampNs(timestamp_ns).IgnoreError();
+  encoder.WriteSequence(sequence).IgnoreError();
+  if (!encoder.status().ok()) {
+    return encoder.status();
+  }
+  return ConstByteSpan(encoder);
+}
+
 StatusWithSize CopyBuffer(ConstByteSpan input, ByteSpan output) {
   if (input.size() > output.size()) {
     return pw::StatusWithSize::ResourceExhausted();
@@ -71,4 +146,46 @@ void BenchmarkService::BidirectionalEcho(
   reader_writers_.insert({id, std::move(new_reader_writer)});
 }
 
+void BenchmarkService::TimedUnary(ConstByteSpan request,
+                                  RawUnaryResponder& responder) {
+  Result<TimedRequest> decoded = DecodeTimedRequest(request);
+  if (!decoded.ok()) {
+    responder.Finish({}, decoded.status()).IgnoreError();
+    return;
+  }
+
+  std::array<std::byte, kMaxTimedPayloadMessageSizeBytes> buffer;
+  Result<ConstByteSpan> response =
+      EncodeTimedPayload(decoded->payload_size, 0, buffer);
+  if (!response.ok()) {
+    responder.Finish({}, response.status()).IgnoreError();
+    return;
+  }
+  responder.Finish(*response).IgnoreError();
+}
+
+void BenchmarkService::TimedServerStream(ConstByteSpan request,
+                                         RawServerWriter& writer) {
+  Result<TimedRequest> decoded = DecodeTimedRequest(request);
+  if (!decoded.ok()) {
+    writer.Finish(decoded.status()).IgnoreError();
+    return;
+  }
+
+  std::array<std::byte, kMaxTimedPayloadMessageSizeBytes> buffer;
+  for (uint32_t sequence = 0; sequence < decoded->count; ++sequence) {
+    Result<ConstByteSpan> payload =
+        EncodeTimedPayload(decoded->payload_size, sequence, buffer);
+    Status status = payload.status();
+    if (status.ok()) {
+      status = writer.Write(*payload);
+    }
+    if (!status.ok()) {
+      writer.Finish(status).IgnoreError();
+      return;
+    }
+  }
+  writer.Finish().IgnoreError();
+}
+
 }  // namespace pw::rpc
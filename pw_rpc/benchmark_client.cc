@@ -0,0 +1,110 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the latency and throughput of a pw.rpc.Benchmark service running in
+// the test_rpc_server, or any other server reachable over a socket.
+//
+//   benchmark_client PORT [PAYLOAD_SIZE] [CONCURRENT_CALLS] [TOTAL_CALLS]
+
+// clang-format off
+#include "pw_rpc/internal/log_config.h"  // PW_LOG_* macros must be first.
+// clang-format on
+
+#include <chrono>
+#include <cstdlib>
+
+#include "pw_log/log.h"
+#include "pw_rpc/benchmark_load_generator.h"
+#include "pw_rpc/integration_testing.h"
+
+namespace pw::rpc {
+namespace {
+
+constexpr size_t kMaxConcurrentCalls = 32;
+constexpr size_t kMaxSamples = 100000;
+
+// Too large for the stack.
+BenchmarkLoadGenerator<kMaxConcurrentCalls, kMaxSamples> load_generator(
+    integration_test::client(), integration_test::kChannelId);
+
+int64_t Microseconds(chrono::SystemClock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+void LogResults(const char* name, const BenchmarkResults& results) {
+  PW_LOG_INFO("%s: %u messages, %u failed calls, %.1f messages/s",
+              name,
+              static_cast<unsigned>(results.messages),
+              static_cast<unsigned>(results.failed_calls),
+              static_cast<double>(results.MessagesPerSecond()));
+  PW_LOG_INFO("%s: p50 %lld us, p99 %lld us, p999 %lld us",
+              name,
+              static_cast<long long>(Microseconds(results.p50)),
+              static_cast<long long>(Microseconds(results.p99)),
+              static_cast<long long>(Microseconds(results.p999)));
+}
+
+int RunBenchmarks(int argc, char** argv) {
+  if (argc < 2 || argc > 5) {
+    PW_LOG_ERROR("Usage: %s PORT [PAYLOAD_SIZE] [CONCURRENT_CALLS] "
+                 "[TOTAL_CALLS]",
+                 argv[0]);
+    return 1;
+  }
+
+  BenchmarkOptions options;
+  if (argc > 2) {
+    options.payload_size = static_cast<uint32_t>(std::atoi(argv[2]));
+  }
+  if (argc > 3) {
+    options.concurrent_calls = static_cast<size_t>(std::atoi(argv[3]));
+  }
+  if (argc > 4) {
+    options.total_calls = static_cast<size_t>(std::atoi(argv[4]));
+  }
+
+  if (Status status = integration_test::InitializeClient(std::atoi(argv[1]));
+      !status.ok()) {
+    PW_LOG_ERROR("Failed to initialize client: %s", status.str());
+    return 1;
+  }
+
+  int result = 0;
+  Result<BenchmarkResults> unary = load_generator.RunUnary(options);
+  if (unary.ok()) {
+    LogResults("TimedUnary", *unary);
+  } else {
+    PW_LOG_ERROR("Unary benchmark failed: %s", unary.status().str());
+    result = 1;
+  }
+
+  Result<BenchmarkResults> stream = load_generator.RunServerStream(options);
+  if (stream.ok()) {
+    LogResults("TimedServerStream", *stream);
+    PW_LOG_INFO("TimedServerStream: server sent messages over %lld us",
+                static_cast<long long>(Microseconds(stream->server_elapsed)));
+  } else {
+    PW_LOG_ERROR("Stream benchmark failed: %s", stream.status().str());
+    result = 1;
+  }
+
+  integration_test::TerminateClient();
+  return result;
+}
+
+}  // namespace
+}  // namespace pw::rpc
+
+int main(int argc, char** argv) { return pw::rpc::RunBenchmarks(argc, argv); }
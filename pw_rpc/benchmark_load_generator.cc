@@ -0,0 +1,300 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/benchmark_load_generator.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "pw_protobuf/decoder.h"
+#include "pw_rpc/benchmark.pwpb.h"
+#include "pw_rpc/benchmark.raw_rpc.pb.h"
+
+namespace pw::rpc {
+namespace {
+
+using chrono::SystemClock;
+
+namespace PayloadRequest = pwpb::PayloadRequest;
+namespace TimedPayload = pwpb::TimedPayload;
+
+// The contents of request padding. The contents are not significant.
+constexpr std::array<std::byte,
+                     internal::BenchmarkLoadGeneratorBase::
+                         kMaxRequestPaddingBytes>
+    kPaddingData{};
+
+// Returns the sample at the given per-mille rank from sorted samples.
+SystemClock::duration Percentile(span<const SystemClock::duration> sorted,
+                                 size_t per_mille) {
+  if (sorted.empty()) {
+    return SystemClock::duration(0);
+  }
+  // Use the nearest-rank method: the smallest sample that is greater than or
+  // equal to per_mille / 1000 of the samples.
+  size_t rank = (sorted.size() * per_mille + 999) / 1000;
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+bool ReadServerTimestamp(ConstByteSpan message, int64_t& timestamp_ns) {
+  protobuf::Decoder decoder(message);
+  while (decoder.Next().ok()) {
+    if (static_cast<TimedPayload::Fields>(decoder.FieldNumber()) ==
+        TimedPayload::Fields::kServerTimestampNs) {
+      return decoder.ReadInt64(&timestamp_ns).ok();
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+float BenchmarkResults::MessagesPerSecond() const {
+  const float seconds =
+      std::chrono::duration<float>(elapsed).count();
+  return seconds > 0.f ? static_cast<float>(messages) / seconds : 0.f;
+}
+
+namespace internal {
+
+BenchmarkLoadGeneratorBase::BenchmarkLoadGeneratorBase(
+    Client& client,
+    uint32_t channel_id,
+    span<CallSlot> slots,
+    span<SystemClock::duration> samples)
+    : client_(client),
+      channel_id_(channel_id),
+      slots_(slots),
+      samples_(samples) {}
+
+Result<BenchmarkResults> BenchmarkLoadGeneratorBase::RunUnary(
+    const BenchmarkOptions& options) {
+  if (options.total_calls > samples_.size()) {
+    return Status::InvalidArgument();
+  }
+  return Run(Mode::kUnary, options);
+}
+
+Result<BenchmarkResults> BenchmarkLoadGeneratorBase::RunServerStream(
+    const BenchmarkOptions& options) {
+  const size_t intervals_per_stream =
+      options.messages_per_stream == 0 ? 0 : options.messages_per_stream - 1;
+  if (intervals_per_stream != 0 &&
+      options.total_calls > samples_.size() / intervals_per_stream) {
+    return Status::InvalidArgument();
+  }
+  return Run(Mode::kServerStream, options);
+}
+
+Result<BenchmarkResults> BenchmarkLoadGeneratorBase::Run(
+    Mode mode, const BenchmarkOptions& options) {
+  if (options.concurrent_calls == 0 ||
+      options.concurrent_calls > slots_.size() ||
+      options.request_padding > kMaxRequestPaddingBytes ||
+      options.payload_size > BenchmarkService::kMaxTimedPayloadSizeBytes) {
+    return Status::InvalidArgument();
+  }
+
+  PayloadRequest::MemoryEncoder encoder(request_buffer_);
+  encoder.WritePayloadSize(options.payload_size).IgnoreError();
+  if (mode == Mode::kServerStream) {
+    encoder.WriteCount(options.messages_per_stream).IgnoreError();
+  }
+  if (options.request_padding != 0) {
+    encoder.WritePadding(span(kPaddingData).first(options.request_padding))
+        .IgnoreError();
+  }
+  PW_TRY(encoder.status());
+  request_ = encoder;
+  mode_ = mode;
+
+  {
+    std::lock_guard lock(mutex_);
+    in_flight_ = 0;
+    finished_calls_ = 0;
+    sample_count_ = 0;
+    has_server_timestamps_ = false;
+    results_ = BenchmarkResults();
+  }
+  for (CallSlot& slot : slots_) {
+    slot.generator = this;
+  }
+
+  const SystemClock::time_point start = SystemClock::now();
+  const SystemClock::time_point deadline = start + options.timeout;
+  size_t started_calls = 0;
+
+  while (true) {
+    // Claim free slots under the lock, but start the calls without it, since
+    // responses may be delivered synchronously from within the invocation.
+    std::array<CallSlot*, 8> to_start;
+    size_t starting = 0;
+    {
+      std::lock_guard lock(mutex_);
+      if (finished_calls_ == options.total_calls) {
+        break;
+      }
+      for (CallSlot& slot : slots_.first(options.concurrent_calls)) {
+        if (starting == to_start.size() ||
+            started_calls == options.total_calls) {
+          break;
+        }
+        if (!slot.in_use) {
+          slot.in_use = true;
+          in_flight_ += 1;
+          started_calls += 1;
+          to_start[starting++] = &slot;
+        }
+      }
+    }
+
+    for (size_t i = 0; i < starting; ++i) {
+      StartCall(*to_start[i]);
+    }
+
+    if (starting == 0 && !call_finished_.try_acquire_until(deadline)) {
+      break;  // Timed out waiting for calls to finish.
+    }
+  }
+
+  // Cancel any calls that are still in flight and count them as failed.
+  for (CallSlot& slot : slots_.first(options.concurrent_calls)) {
+    slot.unary.Cancel().IgnoreError();
+    slot.stream.Cancel().IgnoreError();
+  }
+
+  std::lock_guard lock(mutex_);
+  results_.elapsed = SystemClock::now() - start;
+  results_.failed_calls += options.total_calls - finished_calls_;
+  if (has_server_timestamps_) {
+    results_.server_elapsed = std::chrono::duration_cast<SystemClock::duration>(
+        std::chrono::nanoseconds(last_server_timestamp_ns_ -
+                                 first_server_timestamp_ns_));
+  }
+
+  span<SystemClock::duration> samples = samples_.first(sample_count_);
+  std::sort(samples.begin(), samples.end());
+  results_.p50 = Percentile(samples, 500);
+  results_.p99 = Percentile(samples, 990);
+  results_.p999 = Percentile(samples, 999);
+
+  for (CallSlot& slot : slots_) {
+    slot.in_use = false;
+  }
+  return results_;
+}
+
+void BenchmarkLoadGeneratorBase::StartCall(CallSlot& slot) {
+  pw_rpc::raw::Benchmark::Client benchmark(client_, channel_id_);
+  slot.received_message = false;
+  slot.last_event = SystemClock::now();
+  CallSlot* const slot_ptr = &slot;
+
+  if (mode_ == Mode::kUnary) {
+    slot.unary = benchmark.TimedUnary(
+        request_,
+        [slot_ptr](ConstByteSpan response, Status status) {
+          slot_ptr->generator->OnUnaryCompleted(*slot_ptr, response, status);
+        },
+        [slot_ptr](Status error) {
+          slot_ptr->generator->OnCallDone(*slot_ptr, error);
+        });
+  } else {
+    slot.stream = benchmark.TimedServerStream(
+        request_,
+        [slot_ptr](ConstByteSpan message) {
+          slot_ptr->generator->OnStreamMessage(*slot_ptr, message);
+        },
+        [slot_ptr](Status status) {
+          slot_ptr->generator->OnCallDone(*slot_ptr, status);
+        },
+        [slot_ptr](Status error) {
+          slot_ptr->generator->OnCallDone(*slot_ptr, error);
+        });
+  }
+}
+
+void BenchmarkLoadGeneratorBase::OnUnaryCompleted(CallSlot& slot,
+                                                  ConstByteSpan response,
+                                                  Status status) {
+  const SystemClock::time_point now = SystemClock::now();
+  {
+    std::lock_guard lock(mutex_);
+    if (status.ok()) {
+      results_.messages += 1;
+      results_.response_bytes += response.size();
+      AddSampleLocked(now - slot.last_event);
+    }
+    FinishCallLocked(slot, status);
+  }
+  call_finished_.release();
+}
+
+void BenchmarkLoadGeneratorBase::OnStreamMessage(CallSlot& slot,
+                                                 ConstByteSpan message) {
+  const SystemClock::time_point now = SystemClock::now();
+  int64_t timestamp_ns;
+  const bool has_timestamp = ReadServerTimestamp(message, timestamp_ns);
+
+  std::lock_guard lock(mutex_);
+  // The first message's latency includes the request, so only the intervals
+  // between messages are sampled.
+  if (slot.received_message) {
+    AddSampleLocked(now - slot.last_event);
+  }
+  slot.received_message = true;
+  slot.last_event = now;
+  results_.messages += 1;
+  results_.response_bytes += message.size();
+
+  if (has_timestamp) {
+    if (!has_server_timestamps_) {
+      has_server_timestamps_ = true;
+      first_server_timestamp_ns_ = timestamp_ns;
+      last_server_timestamp_ns_ = timestamp_ns;
+    }
+    first_server_timestamp_ns_ =
+        std::min(first_server_timestamp_ns_, timestamp_ns);
+    last_server_timestamp_ns_ =
+        std::max(last_server_timestamp_ns_, timestamp_ns);
+  }
+}
+
+void BenchmarkLoadGeneratorBase::OnCallDone(CallSlot& slot, Status status) {
+  {
+    std::lock_guard lock(mutex_);
+    FinishCallLocked(slot, status);
+  }
+  call_finished_.release();
+}
+
+void BenchmarkLoadGeneratorBase::FinishCallLocked(CallSlot& slot,
+                                                  Status status) {
+  if (!status.ok()) {
+    results_.failed_calls += 1;
+  }
+  finished_calls_ += 1;
+  in_flight_ -= 1;
+  slot.in_use = false;
+}
+
+void BenchmarkLoadGeneratorBase::AddSampleLocked(
+    SystemClock::duration sample) {
+  if (sample_count_ < samples_.size()) {
+    samples_[sample_count_++] = sample;
+  }
+}
+
+}  // namespace internal
+}  // namespace pw::rpc
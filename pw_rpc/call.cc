@@ -14,6 +14,8 @@
 
 #include "pw_rpc/internal/call.h"
 
+#include <algorithm>
+
 #include "pw_assert/check.h"
 #include "pw_log/log.h"
 #include "pw_preprocessor/util.h"
@@ -57,7 +59,17 @@ Call::Call(const LockedCallContext& context, CallProperties properties)
            context.channel_id(),
            UnwrapServiceId(context.service().service_id()),
            context.method().id(),
-           properties) {}
+           properties) {
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  // Server streams are flow controlled only if the client sent credits.
+  if (context.credits() == 0) {
+    stream_credits_ = kUnlimitedStreamCredits;
+  } else {
+    stream_credits_ = static_cast<uint16_t>(std::min<uint32_t>(
+        context.credits(), kUnlimitedStreamCredits - 1));
+  }
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+}
 
 // Creates an active client-side call, assigning it a new ID.
 Call::Call(LockedEndpoint& client,
@@ -88,6 +100,7 @@ Call::Call(LockedEndpoint& endpoint_ref,
       awaiting_cleanup_(OkStatus().code()),
       callbacks_executing_(0),
       properties_(properties) {
+  set_lock_shard(endpoint_ref.lock_shard());
   PW_CHECK_UINT_NE(channel_id,
                    Channel::kUnassignedChannelId,
                    "Calls cannot be created with channel ID 0 "
@@ -96,7 +109,7 @@ Call::Call(LockedEndpoint& endpoint_ref,
 }
 
 void Call::DestroyServerCall() {
-  RpcLockGuard lock;
+  RpcLockGuard lock(*this);
   // Any errors are logged in Channel::Send.
   CloseAndSendResponseLocked(OkStatus()).IgnoreError();
   WaitForCallbacksToComplete();
@@ -104,21 +117,22 @@ void Call::DestroyServerCall() {
 }
 
 void Call::DestroyClientCall() {
-  RpcLockGuard lock;
+  RpcLockGuard lock(*this);
   CloseClientCall();
   WaitForCallbacksToComplete();
   state_ |= kHasBeenDestroyed;
 }
 
 void Call::WaitForCallbacksToComplete() {
+  const uint8_t shard = lock_shard();
   do {
     int iterations = 0;
     while (CallbacksAreRunning()) {
       PW_RPC_CHECK_FOR_DEADLOCK("destroy", *this);
-      YieldRpcLock();
+      YieldRpcLock(shard, shard);
     }
 
-  } while (CleanUpIfRequired());
+  } while (CleanUpIfRequired(shard));
 }
 
 void Call::MoveFrom(Call& other) {
@@ -133,7 +147,9 @@ void Call::MoveFrom(Call& other) {
   // classes must wait for callbacks to finish before calling MoveFrom.
   PW_DCHECK(!other.CallbacksAreRunning());
 
-  // Copy all members from the other call.
+  // Copy all members from the other call. The locks for both calls are held,
+  // so this call may switch to the other call's lock shard.
+  set_lock_shard(other.lock_shard());
   endpoint_ = other.endpoint_;
   channel_id_ = other.channel_id_;
   id_ = other.id_;
@@ -146,32 +162,41 @@ void Call::MoveFrom(Call& other) {
 
   properties_ = other.properties_;
 
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  stream_credits_ = other.stream_credits_;
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+
   // callbacks_executing_ is not moved since it is associated with the object in
   // memory, not the call.
 
   on_error_ = std::move(other.on_error_);
   on_next_ = std::move(other.on_next_);
 
-  // Mark the other call inactive, unregister it, and register this one.
+  // Unregister the other call, mark it inactive, and register this one. The
+  // other call is unregistered first so that it can be found by its IDs.
+  endpoint().UnregisterCall(other);
   other.MarkClosed();
 
-  endpoint().UnregisterCall(other);
   endpoint().RegisterUniqueCall(*this);
 }
 
 void Call::WaitUntilReadyForMove(Call& destination, Call& source) {
+  // The locks for both calls are held.
+  const uint8_t destination_shard = destination.lock_shard();
+  const uint8_t source_shard = source.lock_shard();
   do {
     // Wait for the source's callbacks to finish if it is active.
     int iterations = 0;
     while (source.active_locked() && source.CallbacksAreRunning()) {
       PW_RPC_CHECK_FOR_DEADLOCK("move", source);
-      YieldRpcLock();
+      YieldRpcLock(destination_shard, source_shard);
     }
 
     // At this point, no callbacks are running in the source call. If cleanup
     // is required for the destination call, perform it and retry since
     // cleanup releases and reacquires the RPC lock.
-  } while (source.CleanUpIfRequired() || destination.CleanUpIfRequired());
+  } while (source.CleanUpIfRequired(destination_shard) ||
+           destination.CleanUpIfRequired(source_shard));
 }
 
 void Call::CallOnError(Status error) {
@@ -179,37 +204,60 @@ void Call::CallOnError(Status error) {
 
   CallbackStarted();
 
-  rpc_lock().unlock();
+  UnlockRpc();
   if (on_error_local) {
     on_error_local(error);
   }
 
   // This mutex lock could be avoided by making callbacks_executing_ atomic.
-  RpcLockGuard lock;
+  RpcLockGuard lock(*this);
   CallbackFinished();
 }
 
-bool Call::CleanUpIfRequired() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+bool Call::CleanUpIfRequired(uint8_t other_shard)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
   if (!awaiting_cleanup()) {
     return false;
   }
+  // Release both locks while the on_error callback runs. A callback must not
+  // be invoked while another shard's lock is held.
+  const uint8_t shard = lock_shard();
+  if (other_shard != shard) {
+    rpc_lock_shard(other_shard).unlock();
+  }
   endpoint_->CleanUpCall(*this);
-  rpc_lock().lock();
+  LockRpcShards(shard, other_shard);
   return true;
 }
 
-Status Call::SendPacket(PacketType type, ConstByteSpan payload, Status status) {
+Status Call::SendPacket(PacketType type,
+                        ConstByteSpan payload,
+                        Status status,
+                        ByteSpan packet_buffer) {
   if (!active_locked()) {
-    encoding_buffer.ReleaseIfAllocated();
+    GetEncodingBuffer(lock_shard()).ReleaseIfAllocated();
     return Status::FailedPrecondition();
   }
 
   Channel* channel = endpoint_->GetInternalChannel(channel_id_);
   if (channel == nullptr) {
-    encoding_buffer.ReleaseIfAllocated();
+    GetEncodingBuffer(lock_shard()).ReleaseIfAllocated();
     return Status::Unavailable();
   }
-  return channel->Send(MakePacket(type, payload, status));
+
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  Packet packet = MakePacket(type, payload, status);
+  // Clients request flow control for every server stream.
+  if (type == PacketType::REQUEST && has_server_stream()) {
+    packet.set_credits(cfg::kServerStreamCredits);
+  }
+#else
+  const Packet packet = MakePacket(type, payload, status);
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+  if (!packet_buffer.empty()) {
+    return channel->Send(packet_buffer, packet);
+  }
+  return channel->Send(lock_shard(), packet);
 }
 
 Status Call::CloseAndSendFinalPacketLocked(PacketType type,
@@ -231,13 +279,65 @@ Status Call::TryCloseAndSendFinalPacketLocked(PacketType type,
   return send_status;
 }
 
-Status Call::WriteLocked(ConstByteSpan payload) {
-  return SendPacket(properties_.call_type() == kServerCall
-                        ? PacketType::SERVER_STREAM
-                        : PacketType::CLIENT_STREAM,
-                    payload);
+Status Call::WriteLocked(ConstByteSpan payload, ByteSpan packet_buffer) {
+  if (active_locked() && !HasStreamCredit()) {
+    GetEncodingBuffer(lock_shard()).ReleaseIfAllocated();
+    return Status::Unavailable();
+  }
+
+  const Status status = SendPacket(properties_.call_type() == kServerCall
+                                       ? PacketType::SERVER_STREAM
+                                       : PacketType::CLIENT_STREAM,
+                                   payload,
+                                   OkStatus(),
+                                   packet_buffer);
+  if (status.ok()) {
+    ConsumeStreamCredit();
+  }
+  return status;
+}
+
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+
+bool Call::AddStreamCredits(uint32_t credits) {
+  if (stream_credits_ == kUnlimitedStreamCredits) {
+    return false;  // The call is not flow controlled.
+  }
+  const bool had_no_credits = stream_credits_ == 0;
+  const uint32_t max_credits = kUnlimitedStreamCredits - 1;
+  stream_credits_ = static_cast<uint16_t>(
+      credits > max_credits - stream_credits_ ? max_credits
+                                              : stream_credits_ + credits);
+  return had_no_credits && stream_credits_ != 0;
+}
+
+void Call::ReturnStreamCredit() {
+  // Grant credits in batches to limit the number of CLIENT_CREDIT packets.
+  constexpr uint32_t kGrantThreshold =
+      cfg::kServerStreamCredits > 1 ? cfg::kServerStreamCredits / 2 : 1;
+
+  if (stream_credits_ < kUnlimitedStreamCredits) {
+    stream_credits_ += 1;
+  }
+  if (stream_credits_ < kGrantThreshold) {
+    return;
+  }
+
+  Channel* channel = endpoint_->GetInternalChannel(channel_id_);
+  if (channel == nullptr) {
+    return;
+  }
+  Packet packet = MakePacket(PacketType::CLIENT_CREDIT, {});
+  packet.set_credits(stream_credits_);
+  // If sending fails, the credits are granted with the next message. Errors
+  // are logged in Channel::Send.
+  if (channel->Send(lock_shard(), packet).ok()) {
+    stream_credits_ = 0;
+  }
 }
 
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+
 // This definition is in the .cc file because the Endpoint class is not defined
 // in the Call header, due to circular dependencies between the two.
 void Call::CloseAndMarkForCleanup(Status error) {
@@ -245,6 +345,13 @@ void Call::CloseAndMarkForCleanup(Status error) {
 }
 
 void Call::HandlePayload(ConstByteSpan payload) {
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  // Every server stream message uses a credit, even if it is dropped.
+  if (properties_.call_type() == kClientCall) {
+    ReturnStreamCredit();
+  }
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+
   // pw_rpc only supports handling packets for a particular RPC one at a time.
   // Check if any callbacks are running and drop the packet if they are.
   //
@@ -259,12 +366,12 @@ void Call::HandlePayload(ConstByteSpan payload) {
         static_cast<unsigned>(channel_id_),
         static_cast<unsigned>(service_id_),
         static_cast<unsigned>(method_id_));
-    rpc_lock().unlock();
+    UnlockRpc();
     return;
   }
 
   if (on_next_ == nullptr) {
-    rpc_lock().unlock();
+    UnlockRpc();
     return;
   }
 
@@ -275,9 +382,9 @@ void Call::HandlePayload(ConstByteSpan payload) {
   if (hold_lock_while_invoking_callback_with_payload()) {
     on_next_local(payload);
   } else {
-    rpc_lock().unlock();
+    UnlockRpc();
     on_next_local(payload);
-    rpc_lock().lock();
+    LockRpc();
   }
 
   CallbackFinished();
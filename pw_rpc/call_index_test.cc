@@ -0,0 +1,169 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/internal/call_index.h"
+
+#include <array>
+#include <cstdint>
+
+#include "pw_rpc/internal/test_utils.h"
+#include "pw_rpc/service.h"
+#include "pw_rpc_private/fake_server_reader_writer.h"
+#include "pw_rpc_private/test_method.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+
+class TestService : public Service {
+ public:
+  constexpr TestService(uint32_t id) : Service(id, method) {}
+
+  static constexpr internal::TestMethodUnion method = internal::TestMethod(8);
+};
+
+namespace internal {
+namespace {
+
+constexpr uint32_t kChannelId = 99;
+constexpr uint32_t kServiceId = 16;
+constexpr uint32_t kMethodId = 8;
+
+using ::pw::rpc::internal::test::FakeServerReaderWriter;
+using ::testing::Test;
+
+class CallIndexTest : public Test {
+ public:
+  CallIndexTest() : context_(TestService::method.method()) {
+    for (size_t i = 0; i < calls_.size(); ++i) {
+      rpc_lock().lock();
+      FakeServerReaderWriter call(
+          context_.get(static_cast<uint32_t>(i + 1)).ClaimLocked());
+      rpc_lock().unlock();
+      calls_[i] = std::move(call);
+    }
+  }
+
+  ~CallIndexTest() override {
+    // Finish the calls one at a time so their responses fit in the output.
+    for (FakeServerReaderWriter& call : calls_) {
+      EXPECT_EQ(OkStatus(), call.Finish());
+      context_.output().clear();
+    }
+  }
+
+ protected:
+  Call& call(size_t index) { return calls_[index].as_server_call(); }
+
+  static Call* Find(const CallIndex<8>& index, uint32_t call_id)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    return index.Find(kChannelId, kServiceId, kMethodId, call_id);
+  }
+
+  ServerContextForTest<TestService, kChannelId, kServiceId> context_;
+  std::array<FakeServerReaderWriter, 8> calls_;
+};
+
+TEST_F(CallIndexTest, FindsInsertedCalls) {
+  CallIndex<8> index;
+  RpcLockGuard lock;
+  EXPECT_TRUE(index.empty());
+
+  ASSERT_TRUE(index.Insert(call(0)));
+  ASSERT_TRUE(index.Insert(call(1)));
+  EXPECT_EQ(index.size(), 2u);
+
+  EXPECT_EQ(Find(index, 1), &call(0));
+  EXPECT_EQ(Find(index, 2), &call(1));
+  EXPECT_EQ(Find(index, 3), nullptr);
+  EXPECT_EQ(index.Find(kChannelId + 1, kServiceId, kMethodId, 1), nullptr);
+  EXPECT_EQ(index.Find(kChannelId, kServiceId, kMethodId + 1, 1), nullptr);
+}
+
+TEST_F(CallIndexTest, DoesNotInsertOpenCallIds) {
+  CallIndex<8> index;
+  RpcLockGuard lock;
+  calls_[0].set_id(kOpenCallId);
+  calls_[1].set_id(kLegacyOpenCallId);
+
+  EXPECT_FALSE(index.Insert(call(0)));
+  EXPECT_FALSE(index.Insert(call(1)));
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(Find(index, kOpenCallId), nullptr);
+}
+
+TEST_F(CallIndexTest, UsesAtMostThreeQuartersOfSlots) {
+  CallIndex<8> index;
+  RpcLockGuard lock;
+  static_assert(CallIndex<8>::kMaxSize == 6u);
+
+  for (size_t i = 0; i < CallIndex<8>::kMaxSize; ++i) {
+    ASSERT_TRUE(index.Insert(call(i)));
+  }
+  EXPECT_FALSE(index.Insert(call(6)));
+  EXPECT_EQ(index.size(), 6u);
+  EXPECT_EQ(Find(index, 7), nullptr);
+}
+
+TEST_F(CallIndexTest, RemovingCallsKeepsOthersFindable) {
+  CallIndex<8> index;
+  RpcLockGuard lock;
+  for (size_t i = 0; i < CallIndex<8>::kMaxSize; ++i) {
+    ASSERT_TRUE(index.Insert(call(i)));
+  }
+
+  // Remove calls in an order unrelated to their slots and check that every
+  // remaining call is still found.
+  constexpr std::array<size_t, 6> kRemovalOrder = {3, 0, 5, 1, 4, 2};
+  for (size_t removed = 0; removed < kRemovalOrder.size(); ++removed) {
+    ASSERT_TRUE(index.Remove(call(kRemovalOrder[removed])));
+    EXPECT_FALSE(index.Remove(call(kRemovalOrder[removed])));
+
+    for (size_t i = 0; i < kRemovalOrder.size(); ++i) {
+      const size_t call_index = kRemovalOrder[i];
+      const uint32_t call_id = static_cast<uint32_t>(call_index + 1);
+      if (i <= removed) {
+        EXPECT_EQ(Find(index, call_id), nullptr);
+      } else {
+        EXPECT_EQ(Find(index, call_id), &call(call_index));
+      }
+    }
+  }
+  EXPECT_TRUE(index.empty());
+}
+
+TEST_F(CallIndexTest, RemovesCallWithChangedId) {
+  CallIndex<8> index;
+  RpcLockGuard lock;
+  ASSERT_TRUE(index.Insert(call(0)));
+  calls_[0].set_id(100);
+
+  EXPECT_TRUE(index.Remove(call(0)));
+  EXPECT_TRUE(index.empty());
+}
+
+TEST_F(CallIndexTest, Clear) {
+  CallIndex<8> index;
+  RpcLockGuard lock;
+  ASSERT_TRUE(index.Insert(call(0)));
+  ASSERT_TRUE(index.Insert(call(1)));
+
+  index.Clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(Find(index, 1), nullptr);
+  EXPECT_TRUE(index.Insert(call(0)));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace pw::rpc
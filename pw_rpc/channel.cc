@@ -23,6 +23,7 @@
 #include "pw_protobuf/decoder.h"
 #include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/encoding_buffer.h"
+#include "pw_rpc/internal/trace.h"
 
 namespace pw::rpc {
 
@@ -44,12 +45,22 @@ Result<uint32_t> ExtractChannelId(ConstByteSpan packet) {
 
 namespace internal {
 
-Status Channel::Send(const Packet& packet) {
-  ByteSpan buffer = encoding_buffer.GetPacketBuffer(packet.payload().size());
-  Result encoded = packet.Encode(buffer);
+Status Channel::Send(uint8_t lock_shard, const Packet& packet) {
+  EncodingBuffer& encoding_buffer = GetEncodingBuffer(lock_shard);
+  const Status status =
+      Send(encoding_buffer.GetPacketBuffer(packet.payload().size()), packet);
+  encoding_buffer.Release();
+  return status;
+}
+
+Status Channel::Send(ByteSpan buffer, const Packet& packet) {
+  PW_RPC_TRACE_SCOPE("Send", packet.call_id());
+
+  // Payloads are usually encoded into the buffer already. Encode the packet
+  // around them, rather than copying them to make room for the header.
+  Result encoded = packet.EncodeInPlace(buffer);
 
   if (!encoded.ok()) {
-    encoding_buffer.Release();
     PW_LOG_ERROR(
         "Failed to encode RPC packet type %u to channel %u buffer, status %u",
         static_cast<unsigned>(packet.type()),
@@ -59,7 +70,6 @@ Status Channel::Send(const Packet& packet) {
   }
 
   Status sent = output().Send(encoded.value());
-  encoding_buffer.Release();
 
   if (!sent.ok()) {
     PW_LOG_DEBUG("Channel %u failed to send packet with status %u",
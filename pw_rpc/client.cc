@@ -21,6 +21,7 @@
 #include "pw_log/log.h"
 #include "pw_rpc/internal/client_call.h"
 #include "pw_rpc/internal/packet.h"
+#include "pw_rpc/internal/trace.h"
 #include "pw_status/try.h"
 
 namespace pw::rpc {
@@ -34,29 +35,33 @@ using internal::pwpb::PacketType;
 Status Client::ProcessPacket(ConstByteSpan data) {
   PW_TRY_ASSIGN(Packet packet, Endpoint::ProcessPacket(data, Packet::kClient));
 
+  PW_RPC_TRACE_SCOPE("ClientProcessPacket", packet.call_id());
+
   // Find an existing call for this RPC, if any.
-  internal::rpc_lock().lock();
-  IntrusiveList<internal::Call>::iterator call = FindCall(packet);
+  LockRpc();
+  internal::Call* call = FindCall(packet);
 
   internal::Channel* channel = GetInternalChannel(packet.channel_id());
 
   if (channel == nullptr) {
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_WARN("RPC client received a packet for an unregistered channel: %lu",
                 static_cast<unsigned long>(packet.channel_id()));
     return Status::Unavailable();
   }
 
-  if (call == calls_end()) {
+  if (call == nullptr) {
     // The call for the packet does not exist. If the packet is a server stream
     // message, notify the server so that it can kill the stream. Otherwise,
     // silently drop the packet (as it would terminate the RPC anyway).
     if (packet.type() == PacketType::SERVER_STREAM) {
-      channel->Send(Packet::ClientError(packet, Status::FailedPrecondition()))
+      channel
+          ->Send(lock_shard(),
+                 Packet::ClientError(packet, Status::FailedPrecondition()))
           .IgnoreError();
       PW_LOG_WARN("RPC client received stream message for an unknown call");
     }
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     return OkStatus();  // OK since the packet was handled
   }
 
@@ -79,7 +84,9 @@ Status Client::ProcessPacket(ConstByteSpan data) {
         call->HandlePayload(packet.payload());
       } else {
         // Report the error to the server so it can abort the RPC.
-        channel->Send(Packet::ClientError(packet, Status::InvalidArgument()))
+        channel
+            ->Send(lock_shard(),
+                   Packet::ClientError(packet, Status::InvalidArgument()))
             .IgnoreError();  // Errors are logged in Channel::Send.
         call->HandleError(Status::InvalidArgument());
         PW_LOG_DEBUG("Received SERVER_STREAM for RPC without a server stream");
@@ -91,7 +98,7 @@ Status Client::ProcessPacket(ConstByteSpan data) {
     case PacketType::CLIENT_ERROR:
     case PacketType::CLIENT_REQUEST_COMPLETION:
     default:
-      internal::rpc_lock().unlock();
+      UnlockRpc();
       PW_LOG_WARN("pw_rpc client unable to handle packet of type %u",
                   static_cast<unsigned>(packet.type()));
   }
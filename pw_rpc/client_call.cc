@@ -34,7 +34,7 @@ void UnaryResponseClientCall::HandleCompleted(
   // wrapped, this on_completed is an internal function that expects the lock to
   // be held, and releases it before invoking user code.
   if (!hold_lock_while_invoking_callback_with_payload()) {
-    rpc_lock().unlock();
+    UnlockRpc();
   }
 
   if (on_completed_local) {
@@ -42,7 +42,7 @@ void UnaryResponseClientCall::HandleCompleted(
   }
 
   // This mutex lock could be avoided by making callbacks_executing_ atomic.
-  RpcLockGuard lock;
+  RpcLockGuard lock(*this);
   CallbackFinished();
 }
 
@@ -50,14 +50,14 @@ void StreamResponseClientCall::HandleCompleted(Status status) {
   UnregisterAndMarkClosed();
   auto on_completed_local = std::move(on_completed_);
   CallbackStarted();
-  rpc_lock().unlock();
+  UnlockRpc();
 
   if (on_completed_local) {
     on_completed_local(status);
   }
 
   // This mutex lock could be avoided by making callbacks_executing_ atomic.
-  RpcLockGuard lock;
+  RpcLockGuard lock(*this);
   CallbackFinished();
 }
 
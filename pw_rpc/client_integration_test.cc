@@ -18,7 +18,10 @@
 
 #include "pw_assert/check.h"
 #include "pw_log/log.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_rpc/benchmark.pwpb.h"
 #include "pw_rpc/benchmark.raw_rpc.pb.h"
+#include "pw_rpc/benchmark_load_generator.h"
 #include "pw_rpc/integration_testing.h"
 #include "pw_sync/binary_semaphore.h"
 #include "pw_unit_test/framework.h"
@@ -99,6 +102,68 @@ TEST(RawRpcIntegrationTest, BidirectionalStreaming) {
   }
 }
 
+TEST(RawRpcIntegrationTest, TimedUnary) {
+  std::array<std::byte, 16> request_buffer;
+  pw::rpc::pwpb::PayloadRequest::MemoryEncoder request(request_buffer);
+  ASSERT_EQ(OkStatus(), request.WritePayloadSize(20));
+
+  struct {
+    pw::sync::BinarySemaphore done;
+    size_t payload_size = 0;
+    Status status = Status::Unknown();
+  } ctx;
+  pw::rpc::RawUnaryReceiver call = kServiceClient.TimedUnary(
+      request, [&ctx](ConstByteSpan response, Status status) {
+        pw::protobuf::Decoder decoder(response);
+        while (decoder.Next().ok()) {
+          if (decoder.FieldNumber() ==
+              static_cast<uint32_t>(
+                  pw::rpc::pwpb::TimedPayload::Fields::kPayload)) {
+            ConstByteSpan payload;
+            PW_CHECK_OK(decoder.ReadBytes(&payload));
+            ctx.payload_size = payload.size();
+          }
+        }
+        ctx.status = status;
+        ctx.done.release();
+      });
+  ASSERT_TRUE(ctx.done.try_acquire_for(10s));
+  EXPECT_EQ(OkStatus(), ctx.status);
+  EXPECT_EQ(ctx.payload_size, 20u);
+}
+
+TEST(RawRpcIntegrationTest, BenchmarkLoadGenerator) {
+  static pw::rpc::BenchmarkLoadGenerator<4, 64> load_generator(
+      pw::rpc::integration_test::client(),
+      pw::rpc::integration_test::kChannelId);
+
+  pw::rpc::BenchmarkOptions options;
+  options.payload_size = 48;
+  options.concurrent_calls = 4;
+  options.total_calls = 16;
+  options.messages_per_stream = 4;
+
+  pw::Result<pw::rpc::BenchmarkResults> unary =
+      load_generator.RunUnary(options);
+  ASSERT_EQ(OkStatus(), unary.status());
+  EXPECT_EQ(unary->messages, 16u);
+  EXPECT_EQ(unary->failed_calls, 0u);
+  EXPECT_LE(unary->p50, unary->p99);
+  EXPECT_LE(unary->p99, unary->p999);
+  EXPECT_GT(unary->MessagesPerSecond(), 0.f);
+
+  pw::Result<pw::rpc::BenchmarkResults> stream =
+      load_generator.RunServerStream(options);
+  ASSERT_EQ(OkStatus(), stream.status());
+  EXPECT_EQ(stream->messages, 64u);
+  EXPECT_EQ(stream->failed_calls, 0u);
+  EXPECT_GE(stream->server_elapsed.count(), 0);
+
+  options.total_calls = 25;  // 75 stream intervals exceed the 64 samples.
+  EXPECT_EQ(Status::InvalidArgument(),
+            load_generator.RunServerStream(options).status());
+}
+
 // This test sometimes fails due to a server stream packet being dropped.
 // TODO: b/290048137 - Enable this test after the flakiness is fixed.
 TEST(RawRpcIntegrationTest, DISABLED_OnNextOverwritesItsOwnCall) {
@@ -0,0 +1,161 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/internal/encoding_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "pw_bytes/array.h"
+#include "pw_function/function.h"
+#include "pw_rpc/internal/test_utils.h"
+#include "pw_rpc/service.h"
+#include "pw_rpc_private/fake_server_reader_writer.h"
+#include "pw_rpc_private/test_method.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+
+class TestService : public Service {
+ public:
+  constexpr TestService(uint32_t id) : Service(id, method) {}
+
+  static constexpr internal::TestMethodUnion method = internal::TestMethod(8);
+};
+
+namespace internal {
+namespace {
+
+using ::pw::rpc::internal::test::FakeServerReaderWriter;
+
+constexpr auto kPayload = bytes::Array<0x08, 0x01, 0x10, 0x02>();
+
+// Encodes a byte span by copying it.
+class CopyEncoder {
+ public:
+  StatusWithSize Encode(ConstByteSpan payload, ByteSpan buffer) const {
+    if (on_encode != nullptr) {
+      on_encode();
+    }
+    if (payload.size() > buffer.size()) {
+      return StatusWithSize::ResourceExhausted();
+    }
+    std::copy(payload.begin(), payload.end(), buffer.begin());
+    return StatusWithSize(payload.size());
+  }
+
+  Function<void()> on_encode;
+};
+
+class EncodeAndWriteTest : public ::testing::Test {
+ public:
+  EncodeAndWriteTest() : context_(TestService::method.method()) {
+    rpc_lock().lock();
+    FakeServerReaderWriter call(context_.get().ClaimLocked());
+    rpc_lock().unlock();
+    call_ = std::move(call);
+  }
+
+ protected:
+  Status EncodeAndWrite(ConstByteSpan payload) {
+    RpcLockGuard lock;
+    return EncodeAndWriteLocked(call_.as_server_call(), payload, encoder_);
+  }
+
+  ServerContextForTest<TestService> context_;
+  FakeServerReaderWriter call_;
+  CopyEncoder encoder_;
+  bool encoded_ = false;
+};
+
+TEST_F(EncodeAndWriteTest, SendsStreamPacket) {
+  ConstByteSpan payload(kPayload);
+  ASSERT_EQ(OkStatus(), EncodeAndWrite(payload));
+
+  ASSERT_EQ(context_.output().total_packets(), 1u);
+  const Packet& packet = context_.output().last_packet();
+  EXPECT_EQ(packet.type(), pwpb::PacketType::SERVER_STREAM);
+  ASSERT_EQ(packet.payload().size(), kPayload.size());
+  EXPECT_TRUE(
+      std::equal(kPayload.begin(), kPayload.end(), packet.payload().begin()));
+}
+
+TEST_F(EncodeAndWriteTest, EncodingError_NotSent) {
+  std::array<std::byte, cfg::kEncodingBufferSizeBytes> too_large{};
+  ConstByteSpan payload(too_large);
+  EXPECT_EQ(Status::ResourceExhausted(), EncodeAndWrite(payload));
+  EXPECT_EQ(context_.output().total_packets(), 0u);
+}
+
+TEST_F(EncodeAndWriteTest, ClosedCall_FailsPrecondition) {
+  ASSERT_EQ(OkStatus(), call_.Finish());
+  ConstByteSpan payload(kPayload);
+  EXPECT_EQ(Status::FailedPrecondition(), EncodeAndWrite(payload));
+  EXPECT_EQ(context_.output().total_packets(), 1u);
+}
+
+#if PW_RPC_ENCODING_BUFFER_POOL_SIZE > 0
+
+TEST_F(EncodeAndWriteTest, Pool_EncodesWithoutLock) {
+  encoder_.on_encode = [this] {
+    // The call's lock is released, so other RPC functions may be called.
+    EXPECT_TRUE(call_.active());
+    encoded_ = true;
+  };
+
+  ConstByteSpan payload(kPayload);
+  ASSERT_EQ(OkStatus(), EncodeAndWrite(payload));
+  EXPECT_TRUE(encoded_);
+  ASSERT_EQ(context_.output().total_packets(), 1u);
+  EXPECT_EQ(context_.output().last_packet().payload().size(),
+            kPayload.size());
+}
+
+TEST_F(EncodeAndWriteTest, Pool_CallClosedWhileEncoding_FailsPrecondition) {
+  encoder_.on_encode = [this] { EXPECT_EQ(OkStatus(), call_.Finish()); };
+
+  ConstByteSpan payload(kPayload);
+  EXPECT_EQ(Status::FailedPrecondition(), EncodeAndWrite(payload));
+  ASSERT_EQ(context_.output().total_packets(), 1u);
+  EXPECT_EQ(context_.output().last_packet().type(),
+            pwpb::PacketType::RESPONSE);
+}
+
+TEST_F(EncodeAndWriteTest, Pool_Exhausted_UsesSharedBuffer) {
+  std::array<StaticEncodingBuffer*, cfg::kEncodingBufferPoolSize> pooled;
+  {
+    RpcLockGuard lock;
+    for (StaticEncodingBuffer*& buffer : pooled) {
+      buffer = GetEncodingBufferPool(0).Acquire();
+      ASSERT_NE(buffer, nullptr);
+    }
+    EXPECT_EQ(GetEncodingBufferPool(0).Acquire(), nullptr);
+  }
+
+  ConstByteSpan payload(kPayload);
+  EXPECT_EQ(OkStatus(), EncodeAndWrite(payload));
+  EXPECT_EQ(context_.output().total_packets(), 1u);
+
+  RpcLockGuard lock;
+  for (StaticEncodingBuffer* buffer : pooled) {
+    GetEncodingBufferPool(0).Release(*buffer);
+  }
+}
+
+#endif  // PW_RPC_ENCODING_BUFFER_POOL_SIZE > 0
+
+}  // namespace
+}  // namespace internal
+}  // namespace pw::rpc
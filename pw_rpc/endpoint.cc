@@ -73,8 +73,8 @@ static_assert(
 
 namespace pw::rpc::internal {
 
-void YieldRpcLock() {
-  rpc_lock().unlock();
+void YieldRpcLock(uint8_t first, uint8_t second) {
+  UnlockRpcShards(first, second);
 #if PW_RPC_YIELD_MODE == PW_RPC_YIELD_MODE_SLEEP
   static constexpr chrono::SystemClock::duration kSleepDuration =
       PW_RPC_YIELD_SLEEP_DURATION;
@@ -82,7 +82,7 @@ void YieldRpcLock() {
 #elif PW_RPC_YIELD_MODE == PW_RPC_YIELD_MODE_YIELD
   this_thread::yield();
 #endif  // PW_RPC_YIELD_MODE
-  rpc_lock().lock();
+  LockRpcShards(first, second);
 }
 
 Result<Packet> Endpoint::ProcessPacket(span<const std::byte> data,
@@ -111,21 +111,52 @@ Result<Packet> Endpoint::ProcessPacket(span<const std::byte> data,
 
 void Endpoint::RegisterCall(Call& new_call) {
   // Mark any exisitng duplicate calls as cancelled.
-  auto [before_call, call] = FindIteratorsForCall(new_call);
+#if PW_RPC_CALL_INDEX_SIZE > 0
+  Call* existing = FindActiveCall(new_call.channel_id_locked(),
+                                  new_call.service_id(),
+                                  new_call.method_id(),
+                                  new_call.id());
+  if (existing != nullptr) {
+    CloseCallAndMarkForCleanup(*existing, Status::Cancelled());
+  }
+#else
+  auto call = FindIteratorForCall(new_call);
   if (call != calls_.end()) {
-    CloseCallAndMarkForCleanup(before_call, call, Status::Cancelled());
+    CloseCallAndMarkForCleanup(call, Status::Cancelled());
   }
+#endif  // PW_RPC_CALL_INDEX_SIZE > 0
 
   // Register the new call.
   calls_.push_front(new_call);
+  AddToCallIndex(new_call);
 }
 
-std::tuple<IntrusiveList<Call>::iterator, IntrusiveList<Call>::iterator>
-Endpoint::FindIteratorsForCall(uint32_t channel_id,
+Call* Endpoint::FindActiveCall(uint32_t channel_id,
                                uint32_t service_id,
                                uint32_t method_id,
                                uint32_t call_id) {
-  auto previous = calls_.before_begin();
+#if PW_RPC_CALL_INDEX_SIZE > 0
+  // Open call IDs match any call for the method, so they cannot be looked up in
+  // the index. Otherwise, the calls list only needs to be searched if it has
+  // calls that are not in the index.
+  if (call_id != kOpenCallId && call_id != kLegacyOpenCallId) {
+    Call* call =
+        call_index_.Find(channel_id, service_id, method_id, call_id);
+    if (call != nullptr || unindexed_calls_ == 0u) {
+      return call;
+    }
+  }
+#endif  // PW_RPC_CALL_INDEX_SIZE > 0
+
+  auto call = FindIteratorForCall(channel_id, service_id, method_id, call_id);
+  return call == calls_.end() ? nullptr : &(*call);
+}
+
+IntrusiveDList<Call>::iterator Endpoint::FindIteratorForCall(
+    uint32_t channel_id,
+    uint32_t service_id,
+    uint32_t method_id,
+    uint32_t call_id) {
   auto call = calls_.begin();
 
   while (call != calls_.end()) {
@@ -143,22 +174,27 @@ Endpoint::FindIteratorsForCall(uint32_t channel_id,
         // which do not specify a Call ID but expect to be able to send
         // unrequested responses.
         call->set_id(call_id);
+#if PW_RPC_CALL_INDEX_SIZE > 0
+        // The call has a known ID now, so it may be indexed.
+        if (call_index_.Insert(*call)) {
+          unindexed_calls_ -= 1;
+        }
+#endif  // PW_RPC_CALL_INDEX_SIZE > 0
         break;
       }
     }
-    previous = call;
     ++call;
   }
 
-  return {previous, call};
+  return call;
 }
 
 Status Endpoint::CloseChannel(uint32_t channel_id) {
-  rpc_lock().lock();
+  LockRpc();
 
   Channel* channel = channels_.Get(channel_id);
   if (channel == nullptr) {
-    rpc_lock().unlock();
+    UnlockRpc();
     return Status::NotFound();
   }
   channel->Close();
@@ -172,16 +208,13 @@ Status Endpoint::CloseChannel(uint32_t channel_id) {
 }
 
 void Endpoint::AbortCalls(AbortIdType type, uint32_t id) {
-  auto previous = calls_.before_begin();
   auto current = calls_.begin();
 
   while (current != calls_.end()) {
     if (id == (type == AbortIdType::kChannel ? current->channel_id_locked()
                                              : current->service_id())) {
-      current =
-          CloseCallAndMarkForCleanup(previous, current, Status::Aborted());
+      current = CloseCallAndMarkForCleanup(current, Status::Aborted());
     } else {
-      previous = current;
       ++current;
     }
   }
@@ -189,7 +222,7 @@ void Endpoint::AbortCalls(AbortIdType type, uint32_t id) {
 
 void Endpoint::CleanUpCalls() {
   if (to_cleanup_.empty()) {
-    rpc_lock().unlock();
+    UnlockRpc();
     return;
   }
 
@@ -207,15 +240,19 @@ void Endpoint::CleanUpCalls() {
       return;
     }
 
-    rpc_lock().lock();
+    LockRpc();
   }
 }
 
 void Endpoint::RemoveAllCalls() {
-  RpcLockGuard lock;
+  RpcLockGuard lock(*this);
 
   // Close all calls without invoking on_error callbacks, since the calls should
   // have been closed before the Endpoint was deleted.
+#if PW_RPC_CALL_INDEX_SIZE > 0
+  call_index_.Clear();
+  unindexed_calls_ = 0;
+#endif  // PW_RPC_CALL_INDEX_SIZE > 0
   while (!calls_.empty()) {
     calls_.front().CloseFromDeletedEndpoint();
     calls_.pop_front();
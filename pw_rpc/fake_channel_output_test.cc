@@ -57,7 +57,7 @@ TEST(FakeChannelOutput, SendAndClear) {
                                               kCallId,
                                               kPayload);
   RpcLockGuard lock;
-  ASSERT_EQ(channel.Send(server_stream_packet), OkStatus());
+  ASSERT_EQ(channel.Send(0, server_stream_packet), OkStatus());
   ASSERT_EQ(output.last_response(type).size(), kPayload.size());
   EXPECT_EQ(
       std::memcmp(
@@ -84,22 +84,22 @@ TEST(FakeChannelOutput, SendAndFakeFutureResults) {
                                          kCallId,
                                          kPayload);
   RpcLockGuard lock;
-  EXPECT_EQ(channel.Send(response_packet), OkStatus());
+  EXPECT_EQ(channel.Send(0, response_packet), OkStatus());
   EXPECT_EQ(output.total_payloads(type), 1u);
   EXPECT_EQ(output.total_packets(), 1u);
   EXPECT_TRUE(output.done());
 
   // Multiple calls will return the same error status.
   output.set_send_status(Status::Unknown());
-  EXPECT_EQ(channel.Send(response_packet), Status::Unknown());
-  EXPECT_EQ(channel.Send(response_packet), Status::Unknown());
-  EXPECT_EQ(channel.Send(response_packet), Status::Unknown());
+  EXPECT_EQ(channel.Send(0, response_packet), Status::Unknown());
+  EXPECT_EQ(channel.Send(0, response_packet), Status::Unknown());
+  EXPECT_EQ(channel.Send(0, response_packet), Status::Unknown());
   EXPECT_EQ(output.total_payloads(type), 1u);
   EXPECT_EQ(output.total_packets(), 1u);
 
   // Turn off error status behavior.
   output.set_send_status(OkStatus());
-  EXPECT_EQ(channel.Send(response_packet), OkStatus());
+  EXPECT_EQ(channel.Send(0, response_packet), OkStatus());
   EXPECT_EQ(output.total_payloads(type), 2u);
   EXPECT_EQ(output.total_packets(), 2u);
 
@@ -109,7 +109,7 @@ TEST(FakeChannelOutput, SendAndFakeFutureResults) {
                                               kMethodId,
                                               kCallId,
                                               kPayload);
-  EXPECT_EQ(channel.Send(server_stream_packet), OkStatus());
+  EXPECT_EQ(channel.Send(0, server_stream_packet), OkStatus());
   ASSERT_EQ(output.last_response(type).size(), kPayload.size());
   EXPECT_EQ(
       std::memcmp(
@@ -136,11 +136,11 @@ TEST(FakeChannelOutput, SendAndFakeSingleResult) {
   RpcLockGuard lock;
 
   for (int i = 0; i < packet_count_fail; ++i) {
-    EXPECT_EQ(channel.Send(response_packet), OkStatus());
+    EXPECT_EQ(channel.Send(0, response_packet), OkStatus());
   }
-  EXPECT_EQ(channel.Send(response_packet), Status::Unknown());
+  EXPECT_EQ(channel.Send(0, response_packet), Status::Unknown());
   for (int i = 0; i < packet_count_fail; ++i) {
-    EXPECT_EQ(channel.Send(response_packet), OkStatus());
+    EXPECT_EQ(channel.Send(0, response_packet), OkStatus());
   }
 
   const size_t total_response_packets =
@@ -150,7 +150,7 @@ TEST(FakeChannelOutput, SendAndFakeSingleResult) {
 
   // Turn off error status behavior.
   output.set_send_status(OkStatus());
-  EXPECT_EQ(channel.Send(response_packet), OkStatus());
+  EXPECT_EQ(channel.Send(0, response_packet), OkStatus());
   EXPECT_EQ(output.total_payloads(type), total_response_packets + 1);
   EXPECT_EQ(output.total_packets(), total_response_packets + 1);
 }
@@ -165,7 +165,7 @@ TEST(FakeChannelOutput, SendResponseUpdated) {
                                          kCallId,
                                          kPayload);
   RpcLockGuard lock;
-  ASSERT_EQ(channel.Send(response_packet), OkStatus());
+  ASSERT_EQ(channel.Send(0, response_packet), OkStatus());
   ASSERT_EQ(output.last_response(MethodType::kUnary).size(), kPayload.size());
   EXPECT_EQ(std::memcmp(output.last_response(MethodType::kUnary).data(),
                         kPayload.data(),
@@ -182,7 +182,7 @@ TEST(FakeChannelOutput, SendResponseUpdated) {
                                               kMethodId,
                                               kCallId,
                                               {});
-  EXPECT_EQ(channel.Send(packet_empty_payload), OkStatus());
+  EXPECT_EQ(channel.Send(0, packet_empty_payload), OkStatus());
   EXPECT_EQ(output.last_response(MethodType::kUnary).size(), 0u);
   EXPECT_EQ(output.total_payloads(MethodType::kUnary), 1u);
   EXPECT_EQ(output.total_packets(), 1u);
@@ -194,7 +194,7 @@ TEST(FakeChannelOutput, SendResponseUpdated) {
                                               kMethodId,
                                               kCallId,
                                               kPayload);
-  ASSERT_EQ(channel.Send(server_stream_packet), OkStatus());
+  ASSERT_EQ(channel.Send(0, server_stream_packet), OkStatus());
   ASSERT_EQ(output.total_payloads(MethodType::kServerStreaming), 1u);
   ASSERT_EQ(output.last_response(MethodType::kServerStreaming).size(),
             kPayload.size());
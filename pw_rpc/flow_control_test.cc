@@ -0,0 +1,275 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstdint>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_rpc/internal/client_call.h"
+#include "pw_rpc/internal/config.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/raw/client_reader_writer.h"
+#include "pw_rpc/raw/client_testing.h"
+#include "pw_rpc/raw/fake_channel_output.h"
+#include "pw_rpc/raw/internal/method_union.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc/service.h"
+#include "pw_rpc/write_readiness.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+
+void ServerStream(ConstByteSpan, RawServerWriter& writer);
+
+template <>
+struct internal::MethodInfo<ServerStream> {
+  static constexpr uint32_t kServiceId = 16;
+  static constexpr uint32_t kMethodId = 111;
+  static constexpr MethodType kType = MethodType::kServerStreaming;
+};
+
+namespace {
+
+using internal::Packet;
+using internal::pwpb::PacketType;
+
+constexpr uint32_t kChannelId = 1;
+constexpr uint32_t kCallId = 42;
+constexpr uint32_t kServiceId = internal::MethodInfo<ServerStream>::kServiceId;
+constexpr uint32_t kMethodId = internal::MethodInfo<ServerStream>::kMethodId;
+
+constexpr std::array<std::byte, 2> kPayload = {std::byte{1}, std::byte{2}};
+
+RawServerWriter* stream_writer = nullptr;
+
+class FlowControlService : public Service {
+ public:
+  FlowControlService() : Service(kServiceId, kMethods) {}
+
+  static constexpr std::array<internal::RawMethodUnion, 1> kMethods = {
+      internal::RawMethod::ServerStreaming<ServerStream>(kMethodId),
+  };
+};
+
+class ServerStreamFlowControl : public ::testing::Test {
+ protected:
+  ServerStreamFlowControl()
+      : channels_{Channel::Create<kChannelId>(&output_)}, server_(channels_) {
+    server_.RegisterService(service_);
+    stream_writer = &writer_;
+  }
+
+  ~ServerStreamFlowControl() override { stream_writer = nullptr; }
+
+  Status SendPacket(PacketType type, uint32_t credits) {
+    Packet packet(type, kChannelId, kServiceId, kMethodId, kCallId);
+    packet.set_credits(credits);
+    std::array<std::byte, 64> buffer;
+    return server_.ProcessPacket(packet.Encode(buffer).value());
+  }
+
+  RawFakeChannelOutput<16> output_;
+  std::array<Channel, 1> channels_;
+  Server server_;
+  FlowControlService service_;
+  RawServerWriter writer_;
+  int ready_callbacks_ = 0;
+};
+
+TEST_F(ServerStreamFlowControl, RequestWithoutCreditsIsNotFlowControlled) {
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::REQUEST, 0));
+  ASSERT_TRUE(writer_.active());
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(writer_.ready_to_write());
+    EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  }
+  EXPECT_EQ(output_.total_packets(), 10u);
+}
+
+TEST_F(ServerStreamFlowControl, ClosedWriterIsReadyToWrite) {
+  EXPECT_TRUE(writer_.ready_to_write());
+  EXPECT_EQ(Status::FailedPrecondition(), writer_.Write(kPayload));
+}
+
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+
+TEST_F(ServerStreamFlowControl, WritesFailWithoutCredits) {
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::REQUEST, 2));
+
+  EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  EXPECT_TRUE(writer_.ready_to_write());
+  EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  EXPECT_FALSE(writer_.ready_to_write());
+  EXPECT_EQ(Status::Unavailable(), writer_.Write(kPayload));
+  EXPECT_EQ(output_.total_packets(), 2u);
+
+  // The call can still finish without credits.
+  EXPECT_EQ(OkStatus(), writer_.Finish());
+}
+
+TEST_F(ServerStreamFlowControl, FailedSendDoesNotUseCredit) {
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::REQUEST, 1));
+
+  output_.set_send_status(Status::Unknown());
+  EXPECT_EQ(Status::Unknown(), writer_.Write(kPayload));
+  output_.set_send_status(OkStatus());
+  EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  EXPECT_EQ(Status::Unavailable(), writer_.Write(kPayload));
+}
+
+TEST_F(ServerStreamFlowControl, CreditsResumeWrites) {
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::REQUEST, 1));
+  writer_.set_on_ready_to_write([this]() { ready_callbacks_ += 1; });
+
+  EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  EXPECT_EQ(Status::Unavailable(), writer_.Write(kPayload));
+
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::CLIENT_CREDIT, 3));
+  EXPECT_EQ(ready_callbacks_, 1);
+  EXPECT_TRUE(writer_.ready_to_write());
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  }
+  EXPECT_EQ(Status::Unavailable(), writer_.Write(kPayload));
+}
+
+TEST_F(ServerStreamFlowControl, CreditsBeforeRunningOutDoNotInvokeCallback) {
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::REQUEST, 1));
+  writer_.set_on_ready_to_write([this]() { ready_callbacks_ += 1; });
+
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::CLIENT_CREDIT, 1));
+  EXPECT_EQ(ready_callbacks_, 0);
+
+  EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+  EXPECT_EQ(Status::Unavailable(), writer_.Write(kPayload));
+}
+
+TEST_F(ServerStreamFlowControl, CreditsForUnlimitedCallAreIgnored) {
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::REQUEST, 0));
+  writer_.set_on_ready_to_write([this]() { ready_callbacks_ += 1; });
+
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::CLIENT_CREDIT, 1));
+  EXPECT_EQ(ready_callbacks_, 0);
+  EXPECT_TRUE(writer_.ready_to_write());
+}
+
+class WriteTask : public async2::Task {
+ public:
+  WriteTask(RawServerWriter& writer, int messages)
+      : writer_(writer), readiness_(writer), messages_(messages) {}
+
+  int written() const { return written_; }
+
+ private:
+  async2::Poll<> DoPend(async2::Context& cx) override {
+    while (written_ < messages_) {
+      if (readiness_.PollReadyToWrite(cx).IsPending()) {
+        return async2::Pending();
+      }
+      EXPECT_EQ(OkStatus(), writer_.Write(kPayload));
+      written_ += 1;
+    }
+    return async2::Ready();
+  }
+
+  RawServerWriter& writer_;
+  WriteReadiness<RawServerWriter> readiness_;
+  int messages_;
+  int written_ = 0;
+};
+
+TEST_F(ServerStreamFlowControl, PollReadyToWriteWakesTaskOnCredits) {
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::REQUEST, 1));
+
+  WriteTask task(writer_, 3);
+  async2::Dispatcher dispatcher;
+  dispatcher.Post(task);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsPending());
+  EXPECT_EQ(task.written(), 1);
+
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::CLIENT_CREDIT, 1));
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsPending());
+  EXPECT_EQ(task.written(), 2);
+
+  ASSERT_EQ(OkStatus(), SendPacket(PacketType::CLIENT_CREDIT, 4));
+  EXPECT_TRUE(dispatcher.RunUntilStalled(task).IsReady());
+  EXPECT_EQ(task.written(), 3);
+}
+
+// RawFakeChannelOutput hides last_packet(), since it returns an internal class.
+const Packet& LastPacket(RawClientTestContext<>& context) {
+  return static_cast<const internal::test::FakeChannelOutput&>(
+             context.output())
+      .last_packet();
+}
+
+RawClientReader StartServerStream(RawClientTestContext<>& context,
+                                  int& messages) {
+  return internal::StreamResponseClientCall::Start<RawClientReader>(
+      context.client(),
+      context.channel().id(),
+      kServiceId,
+      kMethodId,
+      [&messages](ConstByteSpan) { messages += 1; },
+      nullptr,
+      nullptr,
+      {});
+}
+
+TEST(ServerStreamFlowControlClient, RequestIncludesCredits) {
+  RawClientTestContext context;
+  int messages = 0;
+  RawClientReader call = StartServerStream(context, messages);
+
+  ASSERT_EQ(context.output().total_packets(), 1u);
+  const Packet& request = LastPacket(context);
+  EXPECT_EQ(request.type(), PacketType::REQUEST);
+  EXPECT_EQ(request.credits(), cfg::kServerStreamCredits);
+}
+
+TEST(ServerStreamFlowControlClient, GrantsCreditsAsMessagesArrive) {
+  constexpr uint32_t kGrant =
+      cfg::kServerStreamCredits > 1 ? cfg::kServerStreamCredits / 2 : 1;
+
+  RawClientTestContext context;
+  int messages = 0;
+  RawClientReader call = StartServerStream(context, messages);
+
+  for (uint32_t i = 0; i < kGrant - 1; ++i) {
+    context.server().SendServerStream<ServerStream>(kPayload);
+  }
+  EXPECT_EQ(context.output().total_packets(), 1u);
+
+  context.server().SendServerStream<ServerStream>(kPayload);
+  ASSERT_EQ(context.output().total_packets(), 2u);
+  const Packet& grant = LastPacket(context);
+  EXPECT_EQ(grant.type(), PacketType::CLIENT_CREDIT);
+  EXPECT_EQ(grant.credits(), kGrant);
+  EXPECT_EQ(messages, static_cast<int>(kGrant));
+}
+
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+
+}  // namespace
+
+void ServerStream(ConstByteSpan, RawServerWriter& writer) {
+  *stream_writer = std::move(writer);
+}
+
+}  // namespace pw::rpc
@@ -0,0 +1,142 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// clang-format off
+#include "pw_rpc/internal/log_config.h"  // PW_LOG_* macros must be first.
+
+#include "pw_rpc/multibuf.h"
+// clang-format on
+
+#include <algorithm>
+#include <array>
+
+#include "pw_log/log.h"
+#include "pw_rpc/internal/call.h"
+#include "pw_rpc/internal/config.h"
+#include "pw_rpc/internal/encoding_buffer.h"
+#include "pw_rpc/internal/endpoint.h"
+
+namespace pw::rpc {
+
+Status MultiBufChannelOutput::Send(span<const std::byte> buffer) {
+  std::optional<multibuf::MultiBuf> packet =
+      allocator_.Allocate(buffer.size(), reservation_);
+  if (!packet.has_value()) {
+    return Status::ResourceExhausted();
+  }
+  std::copy(buffer.begin(), buffer.end(), packet->begin());
+  return SendMultiBuf(std::move(*packet));
+}
+
+Status WriteMultiBuf(Writer& writer, multibuf::MultiBuf&& payload) {
+  return internal::MultiBufWriter::Write(writer, std::move(payload));
+}
+
+namespace internal {
+namespace {
+
+using pwpb::PacketType;
+
+// Sends a MultiBuf payload through the RPC encoding buffer, for channels that
+// do not use a MultiBufChannelOutput.
+Status WriteCopyLocked(Call& call, const multibuf::MultiBuf& payload)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+  // A payload in a single chunk is encoded directly from that chunk.
+  ConstByteSpan first_chunk;
+  payload.GetChunkSpans(span(&first_chunk, 1));
+  if (first_chunk.size() == payload.size()) {
+    return call.WriteLocked(first_chunk);
+  }
+
+  EncodingBuffer& encoding_buffer = GetEncodingBuffer(call.lock_shard());
+#if PW_RPC_DYNAMIC_ALLOCATION
+  ByteSpan buffer = encoding_buffer.AllocatePayloadBuffer(payload.size());
+#else
+  ByteSpan buffer = encoding_buffer.AllocatePayloadBuffer();
+#endif  // PW_RPC_DYNAMIC_ALLOCATION
+  if (buffer.size() < payload.size()) {
+    encoding_buffer.ReleaseIfAllocated();
+    return Status::ResourceExhausted();
+  }
+  std::copy(payload.begin(), payload.end(), buffer.begin());
+  return call.WriteLocked(buffer.first(payload.size()));
+}
+
+}  // namespace
+
+Status MultiBufWriter::Write(Writer& writer, multibuf::MultiBuf&& payload) {
+  Call& call = static_cast<Call&>(writer);
+  RpcLockGuard lock(call);
+
+  if (!call.active_locked()) {
+    return Status::FailedPrecondition();
+  }
+
+  if (!call.HasStreamCredit()) {
+    return Status::Unavailable();
+  }
+
+  Channel* channel = call.endpoint_->GetInternalChannel(call.channel_id_);
+  if (channel == nullptr) {
+    return Status::Unavailable();
+  }
+
+  MultiBufChannelOutput* output = channel->output().AsMultiBufChannelOutput();
+  if (output == nullptr) {
+    return WriteCopyLocked(call, payload);
+  }
+
+  const Packet packet =
+      call.MakePacket(call.properties_.call_type() == kServerCall
+                          ? PacketType::SERVER_STREAM
+                          : PacketType::CLIENT_STREAM,
+                      {});
+  std::array<std::byte, Packet::kMinEncodedSizeWithoutPayload> buffer;
+  const Result<ConstByteSpan> header =
+      packet.EncodeHeader(buffer, payload.size());
+  if (!header.ok()) {
+    PW_LOG_ERROR("Failed to encode RPC packet header for channel %u, status %u",
+                 static_cast<unsigned>(channel->id()),
+                 header.status().code());
+    return Status::Internal();
+  }
+
+  // Encode the header in the payload's headroom if there is enough of it.
+  // Otherwise, prepend a chunk for the header, leaving headroom in it for the
+  // output's framing.
+  if (!payload.ClaimPrefix(header->size())) {
+    std::optional<multibuf::MultiBuf> prefix =
+        output->allocator().AllocateContiguous(
+            header->size(),
+            multibuf::Reservation{output->reservation().headroom, 0});
+    if (!prefix.has_value()) {
+      return Status::ResourceExhausted();
+    }
+    payload.PushPrefix(std::move(*prefix));
+  }
+  std::copy(header->begin(), header->end(), payload.begin());
+
+  const Status sent = output->SendMultiBuf(std::move(payload));
+  if (!sent.ok()) {
+    PW_LOG_DEBUG("Channel %u failed to send packet with status %u",
+                 static_cast<unsigned>(channel->id()),
+                 sent.code());
+    return Status::Unknown();
+  }
+  call.ConsumeStreamCredit();
+  return OkStatus();
+}
+
+}  // namespace internal
+}  // namespace pw::rpc
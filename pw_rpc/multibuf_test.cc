@@ -0,0 +1,214 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/multibuf.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_allocator/testing.h"
+#include "pw_bytes/array.h"
+#include "pw_multibuf/simple_allocator.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/internal/test_utils.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc/service.h"
+#include "pw_rpc_private/fake_server_reader_writer.h"
+#include "pw_rpc_private/test_method.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+
+class TestService : public Service {
+ public:
+  constexpr TestService(uint32_t id) : Service(id, method) {}
+
+  static constexpr internal::TestMethodUnion method = internal::TestMethod(8);
+};
+
+namespace {
+
+using ::pw::allocator::test::AllocatorForTest;
+using ::pw::rpc::internal::Packet;
+using ::pw::rpc::internal::pwpb::PacketType;
+using ::pw::rpc::internal::test::FakeServerReaderWriter;
+
+constexpr uint32_t kChannelId = 2;
+constexpr uint32_t kServiceId = 16;
+constexpr uint32_t kCallId = 5;
+constexpr multibuf::Reservation kFraming{2, 1};
+
+constexpr auto kPayload = bytes::Array<0x01, 0x02, 0x03, 0x04>();
+
+class TestMultiBufOutput : public MultiBufChannelOutput {
+ public:
+  TestMultiBufOutput(multibuf::MultiBufAllocator& allocator)
+      : MultiBufChannelOutput("TestMultiBufOutput", allocator, kFraming) {}
+
+  // Decodes the most recently sent packet.
+  Packet last_packet() {
+    PW_ASSERT(packet.has_value() && packet->size() <= buffer_.size());
+    std::copy(packet->begin(), packet->end(), buffer_.begin());
+    return Packet::FromBuffer(span(buffer_).first(packet->size())).value();
+  }
+
+  std::optional<multibuf::MultiBuf> packet;
+  size_t packets_sent = 0;
+
+ private:
+  Status SendMultiBuf(multibuf::MultiBuf&& multibuf) override {
+    packet = std::move(multibuf);
+    packets_sent += 1;
+    return OkStatus();
+  }
+
+  std::array<std::byte, 64> buffer_;
+};
+
+class MultiBufTest : public ::testing::Test {
+ protected:
+  MultiBufTest()
+      : allocator_(data_area_, meta_alloc_),
+        output_(allocator_),
+        channels_{Channel::Create<kChannelId>(&output_)},
+        server_(channels_),
+        service_(kServiceId),
+        context_(server_,
+                 kChannelId,
+                 service_,
+                 TestService::method.method(),
+                 kCallId) {
+    server_.RegisterService(service_);
+    internal::rpc_lock().lock();
+    FakeServerReaderWriter call(context_.ClaimLocked());
+    internal::rpc_lock().unlock();
+    call_ = std::move(call);
+  }
+
+  multibuf::MultiBuf PayloadWithoutHeadroom() {
+    std::optional<multibuf::MultiBuf> payload =
+        allocator_.Allocate(kPayload.size());
+    PW_ASSERT(payload.has_value());
+    std::copy(kPayload.begin(), kPayload.end(), payload->begin());
+    return std::move(*payload);
+  }
+
+  // Returns the address of the payload within the last packet.
+  const std::byte* SentPayloadAddress() {
+    return &*output_.packet->Seek(output_.packet->size() - kPayload.size());
+  }
+
+  std::array<std::byte, 256> data_area_;
+  AllocatorForTest<1024> meta_alloc_;
+  multibuf::SimpleAllocator allocator_;
+  TestMultiBufOutput output_;
+  std::array<Channel, 1> channels_;
+  Server server_;
+  TestService service_;
+  internal::CallContext context_;
+  FakeServerReaderWriter call_;
+};
+
+TEST_F(MultiBufTest, WriteMultiBuf_EncodesHeaderInHeadroom) {
+  std::optional<multibuf::MultiBuf> payload =
+      output_.AllocatePayload(kPayload.size());
+  ASSERT_TRUE(payload.has_value());
+  std::copy(kPayload.begin(), kPayload.end(), payload->begin());
+  const std::byte* payload_address = &*payload->begin();
+
+  ASSERT_EQ(OkStatus(), WriteMultiBuf(call_.as_writer(), std::move(*payload)));
+  ASSERT_EQ(output_.packets_sent, 1u);
+  EXPECT_EQ(output_.packet->Chunks().size(), 1u);
+  EXPECT_EQ(SentPayloadAddress(), payload_address);
+
+  Packet packet = output_.last_packet();
+  EXPECT_EQ(packet.type(), PacketType::SERVER_STREAM);
+  EXPECT_EQ(packet.channel_id(), kChannelId);
+  EXPECT_EQ(packet.service_id(), kServiceId);
+  EXPECT_EQ(packet.call_id(), kCallId);
+  ASSERT_EQ(packet.payload().size(), kPayload.size());
+  EXPECT_TRUE(std::equal(
+      kPayload.begin(), kPayload.end(), packet.payload().begin()));
+
+  // The framing reservation is still available to the output.
+  EXPECT_TRUE(output_.packet->ClaimPrefix(kFraming.headroom));
+  EXPECT_TRUE(output_.packet->ClaimSuffix(kFraming.tailroom));
+}
+
+TEST_F(MultiBufTest, WriteMultiBuf_WithoutHeadroom_PrependsHeaderChunk) {
+  multibuf::MultiBuf payload = PayloadWithoutHeadroom();
+  const std::byte* payload_address = &*payload.begin();
+
+  ASSERT_EQ(OkStatus(), WriteMultiBuf(call_.as_writer(), std::move(payload)));
+  ASSERT_EQ(output_.packets_sent, 1u);
+  EXPECT_EQ(output_.packet->Chunks().size(), 2u);
+  EXPECT_EQ(SentPayloadAddress(), payload_address);
+
+  Packet packet = output_.last_packet();
+  EXPECT_EQ(packet.type(), PacketType::SERVER_STREAM);
+  ASSERT_EQ(packet.payload().size(), kPayload.size());
+  EXPECT_TRUE(std::equal(
+      kPayload.begin(), kPayload.end(), packet.payload().begin()));
+  EXPECT_TRUE(output_.packet->ClaimPrefix(kFraming.headroom));
+}
+
+TEST_F(MultiBufTest, WriteMultiBuf_ClosedCall_FailsPrecondition) {
+  ASSERT_EQ(OkStatus(), call_.Finish());
+  output_.packets_sent = 0;
+
+  EXPECT_EQ(Status::FailedPrecondition(),
+            WriteMultiBuf(call_.as_writer(), PayloadWithoutHeadroom()));
+  EXPECT_EQ(output_.packets_sent, 0u);
+}
+
+TEST_F(MultiBufTest, Write_CopiesPacketIntoMultiBuf) {
+  ASSERT_EQ(OkStatus(), call_.Write(kPayload));
+  ASSERT_EQ(output_.packets_sent, 1u);
+
+  Packet packet = output_.last_packet();
+  EXPECT_EQ(packet.type(), PacketType::SERVER_STREAM);
+  ASSERT_EQ(packet.payload().size(), kPayload.size());
+  EXPECT_TRUE(std::equal(
+      kPayload.begin(), kPayload.end(), packet.payload().begin()));
+  EXPECT_TRUE(output_.packet->ClaimPrefix(kFraming.headroom));
+  EXPECT_TRUE(output_.packet->ClaimSuffix(kFraming.tailroom));
+}
+
+TEST_F(MultiBufTest, WriteMultiBuf_OtherOutput_CopiesPayload) {
+  internal::ServerContextForTest<TestService, kChannelId, kServiceId>
+      context(TestService::method.method());
+  internal::rpc_lock().lock();
+  FakeServerReaderWriter call(context.get().ClaimLocked());
+  internal::rpc_lock().unlock();
+
+  // Split the payload across two chunks.
+  multibuf::MultiBuf payload = PayloadWithoutHeadroom();
+  std::optional<multibuf::MultiBuf> tail = payload.TakeSuffix(2);
+  ASSERT_TRUE(tail.has_value());
+  payload.PushSuffix(std::move(*tail));
+  ASSERT_EQ(payload.Chunks().size(), 2u);
+
+  ASSERT_EQ(OkStatus(), WriteMultiBuf(call.as_writer(), std::move(payload)));
+  ASSERT_EQ(context.output().total_packets(), 1u);
+  const Packet& packet = context.output().last_packet();
+  EXPECT_EQ(packet.type(), PacketType::SERVER_STREAM);
+  ASSERT_EQ(packet.payload().size(), kPayload.size());
+  EXPECT_TRUE(std::equal(
+      kPayload.begin(), kPayload.end(), packet.payload().begin()));
+}
+
+}  // namespace
+}  // namespace pw::rpc
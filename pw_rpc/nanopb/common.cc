@@ -26,7 +26,6 @@
 #include "pw_rpc/internal/client_call.h"
 #include "pw_rpc/internal/encoding_buffer.h"
 #include "pw_rpc/nanopb/server_reader_writer.h"
-#include "pw_status/try.h"
 
 namespace pw::rpc::internal {
 namespace {
@@ -96,7 +95,8 @@ void NanopbSendInitialRequest(ClientCall& call,
                               const void* payload) {
   PW_DCHECK(call.active_locked());
 
-  Result<ByteSpan> result = EncodeToPayloadBuffer(payload, serde);
+  Result<ByteSpan> result =
+      EncodeToPayloadBuffer(call.lock_shard(), payload, serde);
 
   if (result.ok()) {
     call.SendInitialClientRequest(*result);
@@ -112,24 +112,22 @@ Status NanopbSendStream(Call& call,
     return Status::FailedPrecondition();
   }
 
-  Result<ByteSpan> result = EncodeToPayloadBuffer(
+  return EncodeAndWriteLocked(
+      call,
       payload,
       call.type() == kClientCall ? serde->request() : serde->response());
-
-  PW_TRY(result.status());
-  return call.WriteLocked(*result);
 }
 
 Status SendFinalResponse(NanopbServerCall& call,
                          const void* payload,
                          const Status status) {
-  RpcLockGuard lock;
+  RpcLockGuard lock(call);
   if (!call.active_locked()) {
     return Status::FailedPrecondition();
   }
 
-  Result<ByteSpan> result =
-      EncodeToPayloadBuffer(payload, call.serde().response());
+  Result<ByteSpan> result = EncodeToPayloadBuffer(
+      call.lock_shard(), payload, call.serde().response());
   if (!result.ok()) {
     return call.CloseAndSendServerErrorLocked(Status::Internal());
   }
@@ -139,13 +137,13 @@ Status SendFinalResponse(NanopbServerCall& call,
 Status TrySendFinalResponse(NanopbServerCall& call,
                             const void* payload,
                             const Status status) {
-  RpcLockGuard lock;
+  RpcLockGuard lock(call);
   if (!call.active_locked()) {
     return Status::FailedPrecondition();
   }
 
-  Result<ByteSpan> result =
-      EncodeToPayloadBuffer(payload, call.serde().response());
+  Result<ByteSpan> result = EncodeToPayloadBuffer(
+      call.lock_shard(), payload, call.serde().response());
   if (!result.ok()) {
     return call.TryCloseAndSendServerErrorLocked(Status::Internal());
   }
@@ -32,12 +32,12 @@ void NanopbMethod::CallSynchronousUnary(const CallContext& context,
                                         void* request_struct,
                                         void* response_struct) const {
   if (!DecodeRequest(context, request, request_struct)) {
-    rpc_lock().unlock();
+    context.server().UnlockRpc();
     return;
   }
 
   NanopbServerCall responder(context.ClaimLocked(), MethodType::kUnary);
-  rpc_lock().unlock();
+  context.server().UnlockRpc();
   const Status status = function_.synchronous_unary(
       context.service(), request_struct, response_struct);
   responder.SendUnaryResponse(response_struct, status).IgnoreError();
@@ -48,12 +48,12 @@ void NanopbMethod::CallUnaryRequest(const CallContext& context,
                                     const Packet& request,
                                     void* request_struct) const {
   if (!DecodeRequest(context, request, request_struct)) {
-    rpc_lock().unlock();
+    context.server().UnlockRpc();
     return;
   }
 
   NanopbServerCall server_writer(context.ClaimLocked(), type);
-  rpc_lock().unlock();
+  context.server().UnlockRpc();
   function_.unary_request(context.service(), request_struct, server_writer);
 }
 
@@ -68,7 +68,8 @@ bool NanopbMethod::DecodeRequest(const CallContext& context,
   // and the lock has been held since, so GetInternalChannel cannot fail.
   static_cast<internal::Channel*>(
       context.server().GetInternalChannel(context.channel_id()))
-      ->Send(Packet::ServerError(request, Status::DataLoss()))
+      ->Send(context.server().lock_shard(),
+             Packet::ServerError(request, Status::DataLoss()))
       .IgnoreError();
   PW_LOG_WARN("Nanopb failed to decode request payload from channel %u",
               unsigned(context.channel_id()));
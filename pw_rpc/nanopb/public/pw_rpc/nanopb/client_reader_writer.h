@@ -39,7 +39,7 @@ class NanopbUnaryResponseClientCall : public UnaryResponseClientCall {
                         Function<void(Status)>&& on_error,
                         const Request&... request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     CallType call(
         client.ClaimLocked(), channel_id, service_id, method_id, serde);
 
@@ -78,7 +78,7 @@ class NanopbUnaryResponseClientCall : public UnaryResponseClientCall {
 
   NanopbUnaryResponseClientCall& operator=(
       NanopbUnaryResponseClientCall&& other) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveUnaryResponseClientCallFrom(other);
     serde_ = other.serde_;
     set_nanopb_on_completed_locked(std::move(other.nanopb_on_completed_));
@@ -88,12 +88,12 @@ class NanopbUnaryResponseClientCall : public UnaryResponseClientCall {
   void set_on_completed(
       Function<void(const Response& response, Status)>&& on_completed)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_nanopb_on_completed_locked(std::move(on_completed));
   }
 
   Status SendClientStream(const void* payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return NanopbSendStream(*this, payload, serde_);
   }
 
@@ -131,7 +131,7 @@ class NanopbStreamResponseClientCall : public StreamResponseClientCall {
                         Function<void(Status)>&& on_error,
                         const Request&... request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     CallType call(
         client.ClaimLocked(), channel_id, service_id, method_id, serde);
 
@@ -160,7 +160,7 @@ class NanopbStreamResponseClientCall : public StreamResponseClientCall {
 
   NanopbStreamResponseClientCall& operator=(
       NanopbStreamResponseClientCall&& other) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveStreamResponseClientCallFrom(other);
     serde_ = other.serde_;
     set_nanopb_on_next_locked(std::move(other.nanopb_on_next_));
@@ -179,13 +179,13 @@ class NanopbStreamResponseClientCall : public StreamResponseClientCall {
         serde_(&serde) {}
 
   Status SendClientStream(const void* payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return NanopbSendStream(*this, payload, serde_);
   }
 
   void set_on_next(Function<void(const Response& response)>&& on_next)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_nanopb_on_next_locked(std::move(on_next));
   }
 
@@ -396,7 +396,7 @@ class NanopbMethod : public Method {
       PW_UNLOCK_FUNCTION(rpc_lock()) {
     BaseNanopbServerReader<Request> reader(context.ClaimLocked(),
                                            MethodType::kClientStreaming);
-    rpc_lock().unlock();
+    context.server().UnlockRpc();
     static_cast<const NanopbMethod&>(context.method())
         .function_.stream_request(context.service(), reader);
   }
@@ -408,7 +408,7 @@ class NanopbMethod : public Method {
       PW_UNLOCK_FUNCTION(rpc_lock()) {
     BaseNanopbServerReader<Request> reader_writer(
         context.ClaimLocked(), MethodType::kBidirectionalStreaming);
-    rpc_lock().unlock();
+    context.server().UnlockRpc();
     static_cast<const NanopbMethod&>(context.method())
         .function_.stream_request(context.service(), reader_writer);
   }
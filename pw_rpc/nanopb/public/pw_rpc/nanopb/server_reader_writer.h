@@ -70,7 +70,7 @@ class NanopbServerCall : public ServerCall {
 
   NanopbServerCall& operator=(NanopbServerCall&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveNanopbServerCallFrom(other);
     return *this;
   }
@@ -82,7 +82,7 @@ class NanopbServerCall : public ServerCall {
   }
 
   Status SendServerStream(const void* payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return NanopbSendStream(*this, payload, serde_);
   }
 
@@ -112,7 +112,7 @@ class BaseNanopbServerReader : public NanopbServerCall {
 
   BaseNanopbServerReader& operator=(BaseNanopbServerReader&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveNanopbServerCallFrom(other);
     set_nanopb_on_next_locked(std::move(other.nanopb_on_next_));
     return *this;
@@ -120,7 +120,7 @@ class BaseNanopbServerReader : public NanopbServerCall {
 
   void set_on_next(Function<void(const Request& request)>&& on_next)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_nanopb_on_next_locked(std::move(on_next));
   }
 
@@ -183,10 +183,15 @@ class NanopbServerReaderWriter
   using internal::Call::active;
   using internal::Call::channel_id;
 
+  // Server stream flow control.
+  using internal::ServerCall::ready_to_write;
+  using internal::ServerCall::set_on_ready_to_write;
+
   // Writes a response struct. Returns the following Status codes:
   //
   //   OK - the response was successfully sent
   //   FAILED_PRECONDITION - the writer is closed
+  //   UNAVAILABLE - the call is flow controlled and has no credits
   //   INTERNAL - pw_rpc was unable to encode the Nanopb protobuf
   //   other errors - the ChannelOutput failed to send the packet; the error
   //       codes are determined by the ChannelOutput implementation
@@ -324,10 +329,15 @@ class NanopbServerWriter : private internal::NanopbServerCall {
   using internal::Call::active;
   using internal::Call::channel_id;
 
+  // Server stream flow control.
+  using internal::ServerCall::ready_to_write;
+  using internal::ServerCall::set_on_ready_to_write;
+
   // Writes a response struct. Returns the following Status codes:
   //
   //   OK - the response was successfully sent
   //   FAILED_PRECONDITION - the writer is closed
+  //   UNAVAILABLE - the call is flow controlled and has no credits
   //   INTERNAL - pw_rpc was unable to encode the Nanopb protobuf
   //   other errors - the ChannelOutput failed to send the packet; the error
   //       codes are determined by the ChannelOutput implementation
@@ -14,8 +14,12 @@
 
 #include "pw_rpc/internal/packet.h"
 
+#include <cstring>
+
 #include "pw_log/log.h"
 #include "pw_protobuf/decoder.h"
+#include "pw_protobuf/wire_format.h"
+#include "pw_varint/varint.h"
 
 namespace pw::rpc::internal {
 
@@ -73,6 +77,11 @@ Result<Packet> Packet::FromBuffer(ConstByteSpan data) {
         // A decode error will propagate from Next() and terminate the loop.
         decoder.ReadUint32(&packet.call_id_).IgnoreError();
         break;
+
+      case RpcPacket::Fields::kCredits:
+        // A decode error will propagate from Next() and terminate the loop.
+        decoder.ReadUint32(&packet.credits_).IgnoreError();
+        break;
     }
   }
 
@@ -106,12 +115,68 @@ Result<ConstByteSpan> Packet::Encode(ByteSpan buffer) const {
     rpc_packet.WriteCallId(call_id_).IgnoreError();
   }
 
+  if (credits_ != 0) {
+    rpc_packet.WriteCredits(credits_).IgnoreError();
+  }
+
   if (rpc_packet.status().ok()) {
     return ConstByteSpan(rpc_packet);
   }
   return rpc_packet.status();
 }
 
+Result<ConstByteSpan> Packet::EncodeHeader(ByteSpan buffer,
+                                           size_t payload_size) const {
+  Packet header = *this;
+  header.payload_ = {};
+  Result<ConstByteSpan> encoded = header.Encode(buffer);
+  if (!encoded.ok()) {
+    return encoded.status();
+  }
+
+  // Encode the payload's key and length last, so that the payload can directly
+  // follow the header.
+  size_t size = encoded->size();
+  const size_t key_size = varint::Encode(
+      static_cast<uint32_t>(protobuf::FieldKey(
+          static_cast<uint32_t>(RpcPacket::Fields::kPayload),
+          protobuf::WireType::kDelimited)),
+      buffer.subspan(size));
+  if (key_size == 0) {
+    return Status::ResourceExhausted();
+  }
+  size += key_size;
+
+  const size_t length_size = varint::Encode(payload_size, buffer.subspan(size));
+  if (length_size == 0) {
+    return Status::ResourceExhausted();
+  }
+  return ConstByteSpan(buffer.first(size + length_size));
+}
+
+Result<ConstByteSpan> Packet::EncodeInPlace(ByteSpan buffer) const {
+  constexpr size_t kPayloadOffset = kMinEncodedSizeWithoutPayload;
+  if (buffer.size() < kPayloadOffset ||
+      payload_.data() != buffer.data() + kPayloadOffset ||
+      payload_.size() > buffer.size() - kPayloadOffset) {
+    return Encode(buffer);
+  }
+
+  // Only the space in front of the payload is written, so the payload is
+  // intact if this fails, e.g. because a credits field does not fit.
+  const Result<ConstByteSpan> header =
+      EncodeHeader(buffer.first(kPayloadOffset), payload_.size());
+  if (!header.ok()) {
+    return Encode(buffer);
+  }
+
+  // Move the header from the start of the buffer up against the payload.
+  const size_t packet_offset = kPayloadOffset - header->size();
+  std::memmove(buffer.data() + packet_offset, header->data(), header->size());
+  return ConstByteSpan(
+      buffer.subspan(packet_offset, header->size() + payload_.size()));
+}
+
 size_t Packet::MinEncodedSizeBytes() const {
   size_t reserved_size = 0;
 
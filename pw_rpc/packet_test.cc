@@ -97,6 +97,83 @@ TEST(Packet, Encode_BufferTooSmall) {
   EXPECT_EQ(Status::ResourceExhausted(), result.status());
 }
 
+TEST(Packet, EncodeHeader_PayloadFollowsHeader) {
+  byte buffer[64];
+
+  Packet packet(PacketType::RESPONSE, 1, 42, 100, 7);
+
+  auto header = packet.EncodeHeader(buffer, kPayload.size());
+  ASSERT_EQ(OkStatus(), header.status());
+  ASSERT_LE(header->size() + kPayload.size(), sizeof(buffer));
+  std::memcpy(buffer + header->size(), kPayload.data(), kPayload.size());
+
+  auto result = Packet::FromBuffer(span(buffer).first(header->size() +
+                                                      kPayload.size()));
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(PacketType::RESPONSE, result->type());
+  EXPECT_EQ(1u, result->channel_id());
+  EXPECT_EQ(42u, result->service_id());
+  EXPECT_EQ(100u, result->method_id());
+  EXPECT_EQ(7u, result->call_id());
+  ASSERT_EQ(kPayload.size(), result->payload().size());
+  EXPECT_EQ(0,
+            std::memcmp(
+                result->payload().data(), kPayload.data(), kPayload.size()));
+}
+
+TEST(Packet, EncodeHeader_BufferTooSmall) {
+  byte buffer[16];
+
+  Packet packet(PacketType::RESPONSE, 1, 42, 100, 7);
+
+  // The fields take all 16 bytes, leaving no room for the payload key.
+  EXPECT_EQ(Status::ResourceExhausted(),
+            packet.EncodeHeader(buffer, kPayload.size()).status());
+}
+
+TEST(Packet, EncodeInPlace_PayloadIsNotMoved) {
+  byte buffer[64] = {};
+  constexpr size_t kOffset = Packet::kMinEncodedSizeWithoutPayload;
+  std::memcpy(buffer + kOffset, kPayload.data(), kPayload.size());
+
+  Packet packet(PacketType::RESPONSE,
+                1,
+                42,
+                100,
+                7,
+                span(buffer).subspan(kOffset, kPayload.size()));
+
+  auto encoded = packet.EncodeInPlace(buffer);
+  ASSERT_EQ(OkStatus(), encoded.status());
+  EXPECT_EQ(buffer + kOffset + kPayload.size(),
+            encoded->data() + encoded->size());
+
+  auto result = Packet::FromBuffer(*encoded);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(PacketType::RESPONSE, result->type());
+  EXPECT_EQ(1u, result->channel_id());
+  EXPECT_EQ(42u, result->service_id());
+  EXPECT_EQ(100u, result->method_id());
+  EXPECT_EQ(7u, result->call_id());
+  EXPECT_EQ(buffer + kOffset, result->payload().data());
+  ASSERT_EQ(kPayload.size(), result->payload().size());
+  EXPECT_EQ(0,
+            std::memcmp(
+                result->payload().data(), kPayload.data(), kPayload.size()));
+}
+
+TEST(Packet, EncodeInPlace_PayloadElsewhere_SameAsEncode) {
+  byte buffer[64];
+
+  Packet packet(PacketType::RESPONSE, 1, 42, 100, 7, kPayload);
+
+  auto result = packet.EncodeInPlace(buffer);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(buffer, result->data());
+  ASSERT_EQ(kEncoded.size(), result->size());
+  EXPECT_EQ(std::memcmp(kEncoded.data(), buffer, kEncoded.size()), 0);
+}
+
 TEST(Packet, Decode_ValidPacket) {
   auto result = Packet::FromBuffer(kEncoded);
   ASSERT_TRUE(result.ok());
@@ -159,6 +236,21 @@ TEST(Packet, EncodeDecodeFixed) {
   EncodeDecode(12, 0xdeadbeef, 0x03a82921, 33, payload, Status::Unavailable());
 }
 
+TEST(Packet, EncodeDecodeCredits) {
+  Packet packet(PacketType::CLIENT_CREDIT, 1, 42, 100, 28282);
+  packet.set_credits(64);
+
+  byte buffer[64];
+  Result result = packet.Encode(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+
+  Result<Packet> decoded = Packet::FromBuffer(result.value());
+  ASSERT_EQ(decoded.status(), OkStatus());
+  EXPECT_EQ(decoded->type(), PacketType::CLIENT_CREDIT);
+  EXPECT_EQ(decoded->call_id(), 28282u);
+  EXPECT_EQ(decoded->credits(), 64u);
+}
+
 FUZZ_TEST(Packet, EncodeDecode)
     .WithDomains(NonZero<uint32_t>(),
                  NonZero<uint32_t>(),
@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <unordered_map>
 
@@ -27,10 +28,19 @@ namespace pw::rpc {
 class BenchmarkService
     : public pw_rpc::raw::Benchmark::Service<BenchmarkService> {
  public:
+  // The largest payload `TimedUnary` and `TimedServerStream` respond with.
+  static constexpr size_t kMaxTimedPayloadSizeBytes = 256;
+
   static void UnaryEcho(ConstByteSpan request, RawUnaryResponder& responder);
 
   void BidirectionalEcho(RawServerReaderWriter& reader_writer);
 
+  static void TimedUnary(ConstByteSpan request, RawUnaryResponder& responder);
+
+  // Sends every payload before returning, so streams to multiple clients are
+  // not interleaved.
+  static void TimedServerStream(ConstByteSpan request, RawServerWriter& writer);
+
  private:
   using ReaderWriterId = uint64_t;
   ReaderWriterId AllocateReaderWriterId();
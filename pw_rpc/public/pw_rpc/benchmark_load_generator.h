@@ -0,0 +1,198 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_rpc/benchmark.h"
+#include "pw_rpc/client.h"
+#include "pw_rpc/raw/client_reader_writer.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/timed_thread_notification.h"
+
+namespace pw::rpc {
+
+// Parameters for a BenchmarkLoadGenerator run.
+struct BenchmarkOptions {
+  // Bytes of padding added to each request.
+  uint32_t request_padding = 0;
+
+  // Size of the payload the server sends in each response.
+  uint32_t payload_size = 32;
+
+  // Number of RPCs to keep in flight at once.
+  size_t concurrent_calls = 1;
+
+  // Total number of RPCs to make.
+  size_t total_calls = 100;
+
+  // Number of messages the server sends on each stream. Ignored by unary runs.
+  uint32_t messages_per_stream = 100;
+
+  // How long to wait for all RPCs to complete. RPCs still in flight when the
+  // timeout expires are cancelled and count as failed.
+  chrono::SystemClock::duration timeout = std::chrono::seconds(10);
+};
+
+// Latency and throughput measured by a BenchmarkLoadGenerator run.
+struct BenchmarkResults {
+  // Responses (unary runs) or stream messages (stream runs) received.
+  size_t messages = 0;
+
+  // Encoded response bytes received.
+  size_t response_bytes = 0;
+
+  // RPCs that failed or did not complete before the timeout.
+  size_t failed_calls = 0;
+
+  // Time from starting the first RPC to completing the last, as measured by
+  // the client.
+  chrono::SystemClock::duration elapsed{};
+
+  // For stream runs, time between the earliest and latest server timestamps.
+  // Excludes the transport latency of the first and last messages.
+  chrono::SystemClock::duration server_elapsed{};
+
+  // Percentiles of the round trip latency of unary RPCs, or of the time
+  // between consecutive messages on a stream.
+  chrono::SystemClock::duration p50{};
+  chrono::SystemClock::duration p99{};
+  chrono::SystemClock::duration p999{};
+
+  // Messages received per second of elapsed time.
+  float MessagesPerSecond() const;
+};
+
+namespace internal {
+
+// Non-templated base for BenchmarkLoadGenerator.
+class BenchmarkLoadGeneratorBase {
+ public:
+  // The largest supported BenchmarkOptions::request_padding.
+  static constexpr size_t kMaxRequestPaddingBytes = 256;
+
+  BenchmarkLoadGeneratorBase(const BenchmarkLoadGeneratorBase&) = delete;
+  BenchmarkLoadGeneratorBase& operator=(const BenchmarkLoadGeneratorBase&) =
+      delete;
+
+  // Makes TimedUnary RPCs and measures their round trip latency. Returns
+  // INVALID_ARGUMENT if the options exceed the generator's capacity.
+  Result<BenchmarkResults> RunUnary(const BenchmarkOptions& options)
+      PW_LOCKS_EXCLUDED(mutex_);
+
+  // Makes TimedServerStream RPCs and measures the rate and spacing of their
+  // messages. Returns INVALID_ARGUMENT if the options exceed the generator's
+  // capacity.
+  Result<BenchmarkResults> RunServerStream(const BenchmarkOptions& options)
+      PW_LOCKS_EXCLUDED(mutex_);
+
+ protected:
+  class CallSlot {
+   private:
+    friend class BenchmarkLoadGeneratorBase;
+
+    BenchmarkLoadGeneratorBase* generator = nullptr;
+    bool in_use = false;
+    bool received_message = false;
+
+    // When the call started, or when its latest stream message arrived.
+    chrono::SystemClock::time_point last_event;
+    RawUnaryReceiver unary;
+    RawClientReader stream;
+  };
+
+  BenchmarkLoadGeneratorBase(Client& client,
+                             uint32_t channel_id,
+                             span<CallSlot> slots,
+                             span<chrono::SystemClock::duration> samples);
+
+  ~BenchmarkLoadGeneratorBase() = default;
+
+ private:
+  enum class Mode : bool { kUnary, kServerStream };
+
+  Result<BenchmarkResults> Run(Mode mode, const BenchmarkOptions& options)
+      PW_LOCKS_EXCLUDED(mutex_);
+
+  void StartCall(CallSlot& slot) PW_LOCKS_EXCLUDED(mutex_);
+
+  void OnUnaryCompleted(CallSlot& slot, ConstByteSpan response, Status status)
+      PW_LOCKS_EXCLUDED(mutex_);
+  void OnStreamMessage(CallSlot& slot, ConstByteSpan message)
+      PW_LOCKS_EXCLUDED(mutex_);
+  void OnCallDone(CallSlot& slot, Status status) PW_LOCKS_EXCLUDED(mutex_);
+
+  void FinishCallLocked(CallSlot& slot, Status status)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void AddSampleLocked(chrono::SystemClock::duration sample)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  Client& client_;
+  const uint32_t channel_id_;
+  const span<CallSlot> slots_;
+  const span<chrono::SystemClock::duration> samples_;
+
+  // Set at the start of each run.
+  Mode mode_ = Mode::kUnary;
+  ConstByteSpan request_;
+  // Large enough for a PayloadRequest with the maximum padding.
+  std::array<std::byte, kMaxRequestPaddingBytes + 24> request_buffer_;
+
+  sync::TimedThreadNotification call_finished_;
+
+  sync::Mutex mutex_;
+  size_t in_flight_ PW_GUARDED_BY(mutex_) = 0;
+  size_t finished_calls_ PW_GUARDED_BY(mutex_) = 0;
+  size_t sample_count_ PW_GUARDED_BY(mutex_) = 0;
+  bool has_server_timestamps_ PW_GUARDED_BY(mutex_) = false;
+  int64_t first_server_timestamp_ns_ PW_GUARDED_BY(mutex_) = 0;
+  int64_t last_server_timestamp_ns_ PW_GUARDED_BY(mutex_) = 0;
+  BenchmarkResults results_ PW_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal
+
+// Generates load on a server's pw.rpc.Benchmark service and reports latency
+// percentiles and throughput.
+//
+// The load generator works with any transport: it only needs a Client and the
+// ID of a channel to the server. Incoming packets must be processed on a
+// different thread than the one that runs the benchmark, unless the
+// transport delivers responses synchronously, such as a local egress that
+// passes packets directly to an in-process server.
+//
+// kMaxConcurrentCalls is the largest supported
+// BenchmarkOptions::concurrent_calls. kMaxSamples limits the number of latency
+// samples a run may record: one per unary RPC, or one per stream message after
+// the first on each stream.
+template <size_t kMaxConcurrentCalls, size_t kMaxSamples>
+class BenchmarkLoadGenerator : public internal::BenchmarkLoadGeneratorBase {
+ public:
+  BenchmarkLoadGenerator(Client& client, uint32_t channel_id)
+      : BenchmarkLoadGeneratorBase(client, channel_id, slots_, samples_) {}
+
+ private:
+  std::array<CallSlot, kMaxConcurrentCalls> slots_;
+  std::array<chrono::SystemClock::duration, kMaxSamples> samples_;
+};
+
+}  // namespace pw::rpc
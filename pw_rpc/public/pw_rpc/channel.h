@@ -27,6 +27,8 @@
 
 namespace pw::rpc {
 
+class MultiBufChannelOutput;
+
 // Extracts the channel ID from a pw_rpc packet. Returns DATA_LOSS if the
 // packet is corrupt and the channel ID could not be found.
 Result<uint32_t> ExtractChannelId(ConstByteSpan packet);
@@ -84,6 +86,11 @@ class ChannelOutput {
   virtual Status Send(span<const std::byte> buffer)
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) = 0;
 
+  // Returns this output as a MultiBufChannelOutput, or nullptr if it is not
+  // one. MultiBuf payloads written to a MultiBufChannelOutput are sent without
+  // being copied into the RPC encoding buffer.
+  virtual MultiBufChannelOutput* AsMultiBufChannelOutput() { return nullptr; }
+
  private:
   const char* name_;
 };
@@ -20,9 +20,16 @@
 #include "pw_rpc/internal/channel.h"
 #include "pw_rpc/internal/endpoint.h"
 #include "pw_rpc/internal/lock.h"
+#include "pw_rpc/internal/synchronous_call_pool.h"
 #include "pw_span/span.h"
 
 namespace pw::rpc {
+namespace internal {
+
+template <typename>
+class SynchronousCallStateHolder;
+
+}  // namespace internal
 
 class Client : public internal::Endpoint {
  public:
@@ -49,11 +56,25 @@ class Client : public internal::Endpoint {
       PW_LOCKS_EXCLUDED(internal::rpc_lock());
 
  private:
+#if PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
+  // Synchronous calls check blocks for their state out of the client's pool.
+  template <typename>
+  friend class internal::SynchronousCallStateHolder;
+#endif  // PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
+
   // Remove these internal::Endpoint functions from the public interface.
   using Endpoint::active_call_count;
   using Endpoint::ClaimLocked;
   using Endpoint::CleanUpCalls;
   using Endpoint::GetInternalChannel;
+  using Endpoint::LockRpc;
+  using Endpoint::UnlockRpc;
+
+#if PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
+  internal::SynchronousCallPool<cfg::kSynchronousCallPoolSize,
+                                cfg::kSynchronousCallPoolBlockSizeBytes>
+      synchronous_call_pool_ PW_GUARDED_BY(internal::rpc_lock());
+#endif  // PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
 };
 
 }  // namespace pw::rpc
@@ -34,6 +34,14 @@ class ClientServer {
   // Sends a packet to either the client or the server, depending on its type.
   Status ProcessPacket(ConstByteSpan packet);
 
+  // Assigns the client and server to one of the PW_RPC_LOCK_SHARDS RPC locks.
+  // The client and server share channels, so they always use the same lock
+  // shard. This must be called before the client or server is used.
+  void set_lock_shard(uint8_t shard) {
+    client_.set_lock_shard(shard);
+    server_.set_lock_shard(shard);
+  }
+
   constexpr Client& client() { return client_; }
   constexpr Server& server() { return server_; }
 
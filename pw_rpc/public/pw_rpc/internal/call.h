@@ -13,12 +13,14 @@
 // the License.
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <utility>
 
-#include "pw_containers/intrusive_list.h"
+#include "pw_containers/intrusive_dlist.h"
 #include "pw_function/function.h"
 #include "pw_rpc/internal/call_context.h"
 #include "pw_rpc/internal/channel.h"
@@ -37,6 +39,7 @@ namespace internal {
 
 class Endpoint;
 class LockedEndpoint;
+class MultiBufWriter;
 class Packet;
 
 // Whether a call object is associated with a server or a client.
@@ -103,7 +106,7 @@ inline constexpr uint32_t kLegacyOpenCallId = 0;
 //
 // Private inheritance is used in place of composition or more complex
 // inheritance hierarchy so that these objects all inherit from a common
-// IntrusiveList::Item object. Private inheritance also gives the derived class
+// IntrusiveDList::Item object. Private inheritance also gives the derived class
 // full control over their interfaces.
 //
 // IMPLEMENTATION NOTE:
@@ -117,7 +120,7 @@ inline constexpr uint32_t kLegacyOpenCallId = 0;
 // At the top level, `ServerCall` and `ClientCall` invoke `DestroyServerCall`
 // `DestroyClientCall` respectively to perform cleanup in the case where no
 // subclass carries additional state.
-class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
+class Call : public IntrusiveDList<Call>::Item, private rpc::Writer {
  public:
   Call(const Call&) = delete;
 
@@ -136,7 +139,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
 
   // True if the Call is active and ready to send responses.
   [[nodiscard]] bool active() const PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return active_locked();
   }
 
@@ -157,7 +160,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   // Public function for accessing the channel ID of this call. Set to 0 when
   // the call is closed.
   uint32_t channel_id() const PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return channel_id_locked();
   }
 
@@ -178,12 +181,45 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
     return properties_.call_type();
   }
 
+  // Returns the lock shard that guards this call. Active calls use the lock
+  // shard of their endpoint. Calls that were never active use lock shard 0.
+  uint8_t lock_shard() const {
+#if PW_RPC_LOCK_SHARDS > 1
+    return lock_shard_.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif  // PW_RPC_LOCK_SHARDS > 1
+  }
+
+  // Acquires the RPC lock that guards this call. Returns the lock shard.
+  uint8_t LockRpc() const PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock())
+      PW_NO_LOCK_SAFETY_ANALYSIS {
+    uint8_t shard = lock_shard();
+    rpc_lock_shard(shard).lock();
+#if PW_RPC_LOCK_SHARDS > 1
+    // A call only changes lock shards while its current lock is held, so
+    // retry if the call was moved to a different shard in the meantime.
+    while (shard != lock_shard()) {
+      rpc_lock_shard(shard).unlock();
+      shard = lock_shard();
+      rpc_lock_shard(shard).lock();
+    }
+#endif  // PW_RPC_LOCK_SHARDS > 1
+    return shard;
+  }
+
+  // Releases the RPC lock that guards this call.
+  void UnlockRpc() const PW_UNLOCK_FUNCTION(rpc_lock())
+      PW_NO_LOCK_SAFETY_ANALYSIS {
+    rpc_lock_shard(lock_shard()).unlock();
+  }
+
   // Closes the Call and sends a RESPONSE packet, if it is active. Returns the
   // status from sending the packet, or FAILED_PRECONDITION if the Call is not
   // active.
   Status CloseAndSendResponse(ConstByteSpan response, Status status)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return CloseAndSendResponseLocked(response, status);
   }
 
@@ -208,7 +244,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   // resend RESPONSE packet when transmission failed.
   Status TryCloseAndSendResponse(ConstByteSpan response, Status status)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return TryCloseAndSendResponseLocked(response, status);
   }
 
@@ -237,7 +273,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   // on the server side. The server may then take an appropriate action to
   // cleanup and stop server streaming.
   Status RequestCompletion() PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return RequestCompletionLocked();
   }
 
@@ -250,11 +286,14 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
 
   // Sends a payload in either a server or client stream packet.
   Status Write(ConstByteSpan payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return WriteLocked(payload);
   }
 
-  Status WriteLocked(ConstByteSpan payload)
+  // Sends a stream packet. If `packet_buffer` is provided, the packet is
+  // encoded into it instead of into the shared encoding buffer. This is used
+  // for payloads encoded into a buffer from the encoding buffer pool.
+  Status WriteLocked(ConstByteSpan payload, ByteSpan packet_buffer = {})
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
   // Sends the initial request for a client call. If the request fails, the call
@@ -371,7 +410,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   // Public function that sets the on_next function in the raw API.
   void set_on_next(Function<void(ConstByteSpan)>&& on_next)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_on_next_locked(std::move(on_next));
   }
 
@@ -384,7 +423,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   // Public function that sets the on_error callback.
   void set_on_error(Function<void(Status)>&& on_error)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_on_error_locked(std::move(on_error));
   }
 
@@ -411,7 +450,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
 
   // Cancels an RPC. Public function for client calls only.
   Status Cancel() PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return CloseAndSendFinalPacketLocked(
         pwpb::PacketType::CLIENT_ERROR, {}, Status::Cancelled());
   }
@@ -458,9 +497,9 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
     const uint32_t original_id = id();
     auto proto_on_next_local = std::move(proto_on_next);
 
-    rpc_lock().unlock();
+    UnlockRpc();
     proto_on_next_local(proto_struct);
-    rpc_lock().lock();
+    LockRpc();
 
     // Restore the original callback if the original call is still active and
     // the callback has not been replaced.
@@ -484,7 +523,7 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
     auto on_error_local = std::move(on_error_);
 
     // Release the lock before decoding, since decoder is a global.
-    rpc_lock().unlock();
+    UnlockRpc();
 
     if (proto_on_completed_local == nullptr) {
       return;
@@ -503,8 +542,30 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   static void WaitUntilReadyForMove(Call& destination, Call& source)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
+  // Returns false if this is a flow-controlled server call that has used all of
+  // its server stream credits.
+  bool HasStreamCredit() const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+    return properties_.call_type() != kServerCall || stream_credits_ != 0;
+#else
+    return true;
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+  }
+
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  // Adds server stream credits granted by the client to a flow-controlled
+  // server call. Returns true if the call had no credits before.
+  bool AddStreamCredits(uint32_t credits)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+
  private:
   friend class rpc::Writer;
+  friend class MultiBufWriter;
+
+  // Server calls have this many credits if they are not flow controlled.
+  static constexpr uint16_t kUnlimitedStreamCredits =
+      std::numeric_limits<uint16_t>::max();
 
   enum State : uint8_t {
     kActive = 0b001,
@@ -547,16 +608,21 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
 
   // If required, removes this call from the endpoint's to_cleanup_ list and
   // calls CleanUp(). Returns true if cleanup was required, which means the lock
-  // was released.
-  bool CleanUpIfRequired() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+  // was released. `other_shard` is the shard of another lock that is held
+  // along with this call's lock (e.g. while moving a call), which is also
+  // released while cleaning up.
+  bool CleanUpIfRequired(uint8_t other_shard)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
   // Sends a payload with the specified type. The payload may either be in a
-  // previously acquired buffer or in a standalone buffer.
+  // previously acquired buffer or in a standalone buffer. The packet is
+  // encoded into `packet_buffer`, or into the encoding buffer if it is empty.
   //
   // Returns FAILED_PRECONDITION if the call is not active().
   Status SendPacket(pwpb::PacketType type,
                     ConstByteSpan payload,
-                    Status status = OkStatus())
+                    Status status = OkStatus(),
+                    ByteSpan packet_buffer = {})
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
   Status CloseAndSendFinalPacketLocked(pwpb::PacketType type,
@@ -573,9 +639,34 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
     return callbacks_executing_ != 0u;
   }
 
+  // Uses one server stream credit after a stream message is sent.
+  void ConsumeStreamCredit() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+    if (properties_.call_type() == kServerCall &&
+        stream_credits_ != kUnlimitedStreamCredits) {
+      stream_credits_ -= 1;
+    }
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+  }
+
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  // Counts a server stream message received by a client call, and grants the
+  // server more credits once enough messages have been received.
+  void ReturnStreamCredit() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+
   // Waits for callbacks to complete so that a call object can be destroyed.
   void WaitForCallbacksToComplete() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
+  // Sets the lock shard. Must be called with the locks for both the current
+  // and the new lock shard held.
+  void set_lock_shard([[maybe_unused]] uint8_t shard)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+#if PW_RPC_LOCK_SHARDS > 1
+    lock_shard_.store(shard, std::memory_order_relaxed);
+#endif  // PW_RPC_LOCK_SHARDS > 1
+  }
+
   Endpoint* endpoint_ PW_GUARDED_BY(rpc_lock());
   uint32_t channel_id_ PW_GUARDED_BY(rpc_lock());
   uint32_t id_ PW_GUARDED_BY(rpc_lock());
@@ -599,6 +690,21 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
 
   CallProperties properties_ PW_GUARDED_BY(rpc_lock());
 
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  // For server calls, the number of server stream messages the call may send,
+  // or kUnlimitedStreamCredits if the call is not flow controlled. For client
+  // calls, the number of server stream messages received since the client last
+  // granted credits. Uses a uint16_t so that it packs with the fields above.
+  uint16_t stream_credits_ PW_GUARDED_BY(rpc_lock()) = 0;
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+
+#if PW_RPC_LOCK_SHARDS > 1
+  // The lock shard of the RPC lock that guards this call. Only changes while
+  // the locks for both the old and new lock shards are held, but may be read
+  // without a lock to find which lock to acquire.
+  std::atomic<uint8_t> lock_shard_{0};
+#endif  // PW_RPC_LOCK_SHARDS > 1
+
   // Called when the RPC is terminated due to an error.
   Function<void(Status error)> on_error_ PW_GUARDED_BY(rpc_lock());
 
@@ -607,6 +713,22 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   Function<void(ConstByteSpan payload)> on_next_ PW_GUARDED_BY(rpc_lock());
 };
 
+inline RpcLockGuard::RpcLockGuard(const Call& call)
+    : first_(call.LockRpc()), second_(first_) {}
+
+inline RpcLockGuard::RpcLockGuard(const Call& first, const Call& second)
+    : first_(first.lock_shard()), second_(second.lock_shard()) {
+  LockRpcShards(first_, second_);
+#if PW_RPC_LOCK_SHARDS > 1
+  while (first_ != first.lock_shard() || second_ != second.lock_shard()) {
+    UnlockRpcShards(first_, second_);
+    first_ = first.lock_shard();
+    second_ = second.lock_shard();
+    LockRpcShards(first_, second_);
+  }
+#endif  // PW_RPC_LOCK_SHARDS > 1
+}
+
 }  // namespace internal
 
 inline bool Writer::active() const {
@@ -38,12 +38,14 @@ class CallContext {
                         uint32_t channel_id,
                         Service& service,
                         const internal::Method& method,
-                        uint32_t call_id)
+                        uint32_t call_id,
+                        uint32_t credits = 0)
       : server_(server),
         channel_id_(channel_id),
         service_(service),
         method_(method),
-        call_id_(call_id) {}
+        call_id_(call_id),
+        credits_(credits) {}
 
   // Claims that `rpc_lock()` is held, returning a wrapped context.
   //
@@ -66,6 +68,10 @@ class CallContext {
 
   constexpr const uint32_t& call_id() const { return call_id_; }
 
+  // Server stream credits from the request, or 0 if the client did not request
+  // flow control.
+  constexpr uint32_t credits() const { return credits_; }
+
   // For testing use only
   void set_channel_id(uint32_t channel_id) { channel_id_ = channel_id; }
 
@@ -75,6 +81,7 @@ class CallContext {
   Service& service_;
   const internal::Method& method_;
   uint32_t call_id_;
+  uint32_t credits_;
 };
 
 // A `CallContext` indicating that `rpc_lock()` is held.
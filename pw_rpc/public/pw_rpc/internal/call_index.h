@@ -0,0 +1,173 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_rpc/internal/call.h"
+#include "pw_rpc/internal/lock.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::rpc::internal {
+
+// A fixed-capacity, open-addressed hash table of active calls, keyed on their
+// channel, service, method, and call IDs. Endpoints use a CallIndex to find the
+// call for a packet without searching their list of every active call.
+//
+// The index does not own the calls. It only stores calls with a known call ID,
+// and only fills up to three quarters of its slots to keep probe sequences
+// short. Endpoints fall back to searching their calls list for calls that
+// could not be indexed.
+template <size_t kCapacity>
+class CallIndex {
+ public:
+  static_assert(kCapacity >= 4 && (kCapacity & (kCapacity - 1)) == 0,
+                "The CallIndex capacity must be a power of two");
+
+  // The maximum number of calls the index stores.
+  static constexpr size_t kMaxSize = kCapacity - kCapacity / 4;
+
+  constexpr CallIndex() = default;
+
+  CallIndex(const CallIndex&) = delete;
+  CallIndex& operator=(const CallIndex&) = delete;
+
+  size_t size() const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) { return size_; }
+
+  bool empty() const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    return size_ == 0u;
+  }
+
+  // Adds a call to the index. Returns false if the call was not added because
+  // the index is full or the call has an open call ID. The index must not
+  // already contain a call with the same IDs.
+  bool Insert(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    if (size_ >= kMaxSize || call.id() == kOpenCallId ||
+        call.id() == kLegacyOpenCallId) {
+      return false;
+    }
+    size_t slot = HomeSlot(call);
+    while (slots_[slot] != nullptr) {
+      slot = NextSlot(slot);
+    }
+    slots_[slot] = &call;
+    size_ += 1;
+    return true;
+  }
+
+  // Finds the call with exactly these IDs, or returns nullptr if the index does
+  // not contain it. Open call IDs are not matched.
+  Call* Find(uint32_t channel_id,
+             uint32_t service_id,
+             uint32_t method_id,
+             uint32_t call_id) const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    for (size_t slot = HomeSlot(channel_id, service_id, method_id, call_id);
+         slots_[slot] != nullptr;
+         slot = NextSlot(slot)) {
+      Call& call = *slots_[slot];
+      if (call.id() == call_id && call.method_id() == method_id &&
+          call.service_id() == service_id &&
+          call.channel_id_locked() == channel_id) {
+        return &call;
+      }
+    }
+    return nullptr;
+  }
+
+  // Removes a call from the index. Returns false if the index did not contain
+  // the call.
+  bool Remove(const Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    const size_t slot = FindSlot(call);
+    if (slot == kCapacity) {
+      return false;
+    }
+
+    // Shift later entries in the probe sequence back into the freed slot so
+    // that lookups never stop early at an empty slot.
+    size_t empty = slot;
+    for (size_t next = NextSlot(slot); slots_[next] != nullptr;
+         next = NextSlot(next)) {
+      const size_t home = HomeSlot(*slots_[next]);
+      // The entry may move if its home slot is not cyclically within
+      // (empty, next].
+      if (((next - home) & kMask) >= ((next - empty) & kMask)) {
+        slots_[empty] = slots_[next];
+        empty = next;
+      }
+    }
+    slots_[empty] = nullptr;
+    size_ -= 1;
+    return true;
+  }
+
+  // Removes all calls from the index.
+  void Clear() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    slots_.fill(nullptr);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kMask = kCapacity - 1;
+
+  static constexpr size_t NextSlot(size_t slot) { return (slot + 1) & kMask; }
+
+  static constexpr size_t HomeSlot(uint32_t channel_id,
+                                   uint32_t service_id,
+                                   uint32_t method_id,
+                                   uint32_t call_id) {
+    // Service and method IDs are already hashes, so a cheap mix suffices.
+    uint32_t hash = service_id ^ (method_id * 0x9E3779B1u);
+    hash ^= (call_id * 0x85EBCA77u) ^ (channel_id * 0xC2B2AE3Du);
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash & kMask;
+  }
+
+  // Returns the slot that holds the call, or kCapacity if there is none.
+  size_t FindSlot(const Call& call) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    for (size_t slot = HomeSlot(call); slots_[slot] != nullptr;
+         slot = NextSlot(slot)) {
+      if (slots_[slot] == &call) {
+        return slot;
+      }
+    }
+    // A call is normally in the probe sequence for its IDs, but its IDs may
+    // have been changed while it was indexed. Since calls that are not indexed
+    // also end up here, check every slot; this is only reached for calls that
+    // must be found by searching the calls list anyway.
+    for (size_t slot = 0; slot < kCapacity; ++slot) {
+      if (slots_[slot] == &call) {
+        return slot;
+      }
+    }
+    return kCapacity;
+  }
+
+  static size_t HomeSlot(const Call& call)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    return HomeSlot(call.channel_id_locked(),
+                    call.service_id(),
+                    call.method_id(),
+                    call.id());
+  }
+
+  std::array<Call*, kCapacity> slots_{};
+  size_t size_ = 0;
+};
+
+}  // namespace pw::rpc::internal
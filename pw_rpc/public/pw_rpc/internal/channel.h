@@ -33,7 +33,18 @@ class Channel : public rpc::Channel {
   // Allow setting the channel ID for tests.
   using rpc::Channel::set_channel_id;
 
-  Status Send(const Packet& packet) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+  // Allow sending packets directly to the output, e.g. as MultiBufs.
+  using rpc::Channel::output;
+
+  // Encodes and sends a packet. The packet is encoded into the encoding buffer
+  // for the lock shard of the endpoint or call that is sending it.
+  Status Send(uint8_t lock_shard, const Packet& packet)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Encodes a packet into `buffer` and sends it. The packet's payload may be
+  // stored in `buffer`, as with the encoding buffer.
+  Status Send(ByteSpan buffer, const Packet& packet)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 };
 
 }  // namespace pw::rpc::internal
@@ -27,7 +27,7 @@ namespace pw::rpc::internal {
 class ClientCall : public Call {
  public:
   uint32_t id() const PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return Call::id();
   }
 
@@ -56,7 +56,7 @@ class ClientCall : public Call {
   // Public function that closes a call client-side without cancelling it on the
   // server.
   void Abandon() PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     CloseClientCall();
   }
 
@@ -81,7 +81,7 @@ class UnaryResponseClientCall : public ClientCall {
                         Function<void(ConstByteSpan, Status)>&& on_completed,
                         Function<void(Status)>&& on_error,
                         ConstByteSpan request) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     CallType call(client.ClaimLocked(), channel_id, service_id, method_id);
     call.set_on_completed_locked(std::move(on_completed));
     call.set_on_error_locked(std::move(on_error));
@@ -111,7 +111,7 @@ class UnaryResponseClientCall : public ClientCall {
 
   UnaryResponseClientCall& operator=(UnaryResponseClientCall&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveUnaryResponseClientCallFrom(other);
     return *this;
   }
@@ -124,7 +124,7 @@ class UnaryResponseClientCall : public ClientCall {
 
   void set_on_completed(Function<void(ConstByteSpan, Status)>&& on_completed)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_on_completed_locked(std::move(on_completed));
   }
 
@@ -156,7 +156,7 @@ class StreamResponseClientCall : public ClientCall {
                         Function<void(Status)>&& on_completed,
                         Function<void(Status)>&& on_error,
                         ConstByteSpan request) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     CallType call(client.ClaimLocked(), channel_id, service_id, method_id);
 
     call.set_on_next_locked(std::move(on_next));
@@ -187,7 +187,7 @@ class StreamResponseClientCall : public ClientCall {
 
   StreamResponseClientCall& operator=(StreamResponseClientCall&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveStreamResponseClientCallFrom(other);
     return *this;
   }
@@ -200,7 +200,7 @@ class StreamResponseClientCall : public ClientCall {
 
   void set_on_completed(Function<void(Status)>&& on_completed)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_on_completed_locked(std::move(on_completed));
   }
 
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #if defined(PW_RPC_CLIENT_STREAM_END_CALLBACK) && \
@@ -75,6 +76,70 @@
 #define PW_RPC_USE_GLOBAL_MUTEX 1
 #endif  // PW_RPC_USE_GLOBAL_MUTEX
 
+/// The number of independent RPC locks. By default, every pw_rpc endpoint and
+/// call object shares one lock, so packets for unrelated endpoints (e.g. a
+/// server per device link) are processed one at a time.
+///
+/// If `PW_RPC_LOCK_SHARDS` is greater than 1, each endpoint may be assigned one
+/// of the locks with `set_lock_shard()`. Calls use the lock of the endpoint
+/// they belong to, so endpoints with different lock shards process packets in
+/// parallel. Endpoints that share channels or channel outputs must use the same
+/// lock shard. Each lock shard has its own encoding buffer.
+///
+/// @c_macro{PW_RPC_USE_GLOBAL_MUTEX} must be enabled to use more than one lock
+/// shard.
+///
+/// This defaults to 1.
+#ifndef PW_RPC_LOCK_SHARDS
+#define PW_RPC_LOCK_SHARDS 1
+#endif  // PW_RPC_LOCK_SHARDS
+
+static_assert(PW_RPC_LOCK_SHARDS >= 1 && PW_RPC_LOCK_SHARDS <= 255,
+              "PW_RPC_LOCK_SHARDS must be between 1 and 255");
+static_assert(PW_RPC_LOCK_SHARDS == 1 || PW_RPC_USE_GLOBAL_MUTEX,
+              "PW_RPC_USE_GLOBAL_MUTEX must be enabled to use more than one "
+              "pw_rpc lock shard");
+
+/// The number of slots in each endpoint's call index, which is used to find the
+/// call for an incoming packet without searching the list of every active call.
+/// The call index is disabled if this is 0.
+///
+/// The call index is an open-addressed hash table of call pointers, keyed on
+/// the channel, service, method, and call IDs. Each `Server` and `Client`
+/// stores its own index, which takes `PW_RPC_CALL_INDEX_SIZE` pointers. At most
+/// three quarters of the slots are used; calls beyond that, and calls with an
+/// open call ID, are found by searching the calls list. This value must be 0 or
+/// a power of two of at least 4.
+///
+/// Enabling the call index is only useful for endpoints with many concurrent
+/// calls, such as servers with hundreds of open streams.
+///
+/// This defaults to 0.
+#ifndef PW_RPC_CALL_INDEX_SIZE
+#define PW_RPC_CALL_INDEX_SIZE 0
+#endif  // PW_RPC_CALL_INDEX_SIZE
+
+static_assert(
+    PW_RPC_CALL_INDEX_SIZE == 0 ||
+        (PW_RPC_CALL_INDEX_SIZE >= 4 &&
+         (PW_RPC_CALL_INDEX_SIZE & (PW_RPC_CALL_INDEX_SIZE - 1)) == 0),
+    "PW_RPC_CALL_INDEX_SIZE must be 0 or a power of two of at least 4");
+
+/// The number of services each `Server` can store in its service index, which
+/// is a table of registered services sorted by service ID. The service for a
+/// packet is found with a binary search of the index instead of a search of
+/// the list of every registered service. The service index is disabled if this
+/// is 0.
+///
+/// Each `Server` stores its own index, which takes `PW_RPC_SERVICE_INDEX_SIZE`
+/// pointers. Services registered when the index is full are found by searching
+/// the list of services.
+///
+/// This defaults to 0.
+#ifndef PW_RPC_SERVICE_INDEX_SIZE
+#define PW_RPC_SERVICE_INDEX_SIZE 0
+#endif  // PW_RPC_SERVICE_INDEX_SIZE
+
 /// pw_rpc must yield the current thread when waiting for a callback to complete
 /// in a different thread. PW_RPC_YIELD_MODE determines how to yield. There are
 /// three supported settings:
@@ -230,6 +295,91 @@ static_assert(
 #define PW_RPC_ENCODING_BUFFER_SIZE_BYTES 512
 #endif  // PW_RPC_ENCODING_BUFFER_SIZE_BYTES
 
+/// The number of additional encoding buffers in each lock shard's encoding
+/// buffer pool. The pool is disabled if this is 0.
+///
+/// Streaming writes from pw_protobuf and Nanopb calls encode their payloads
+/// into a buffer checked out of the pool, and release the RPC lock while
+/// encoding. This allows several threads to encode stream messages in
+/// parallel; they only contend on the lock to check out a buffer and to send
+/// the encoded packet. When every pooled buffer is in use, writes encode into
+/// the shared encoding buffer with the lock held, as they do without the pool.
+///
+/// Each pooled buffer is @c_macro{PW_RPC_ENCODING_BUFFER_SIZE_BYTES} bytes. The
+/// pool may not be used with @c_macro{PW_RPC_DYNAMIC_ALLOCATION}.
+///
+/// This defaults to 0.
+#ifndef PW_RPC_ENCODING_BUFFER_POOL_SIZE
+#define PW_RPC_ENCODING_BUFFER_POOL_SIZE 0
+#endif  // PW_RPC_ENCODING_BUFFER_POOL_SIZE
+
+static_assert(PW_RPC_ENCODING_BUFFER_POOL_SIZE == 0 ||
+                  !PW_RPC_DYNAMIC_ALLOCATION,
+              "PW_RPC_ENCODING_BUFFER_POOL_SIZE may not be used with "
+              "PW_RPC_DYNAMIC_ALLOCATION");
+
+/// The number of blocks in each client's synchronous call pool. The pool is
+/// disabled if this is 0.
+///
+/// With @c_macro{PW_RPC_DYNAMIC_ALLOCATION}, each synchronous call from the
+/// helpers in `pw_rpc/synchronous_call.h` heap-allocates the state that
+/// receives its response. When the pool is enabled, each `Client` reserves this
+/// many blocks for that state instead, so frequent synchronous calls do not
+/// allocate. Calls fall back to heap allocation when every block is in use or
+/// when the state does not fit in a block.
+///
+/// The pool requires @c_macro{PW_RPC_DYNAMIC_ALLOCATION}, since synchronous
+/// call state is otherwise placed on the stack. This defaults to 0.
+#ifndef PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE
+#define PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE 0
+#endif  // PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE
+
+static_assert(PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE == 0 ||
+                  PW_RPC_DYNAMIC_ALLOCATION,
+              "PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE requires "
+              "PW_RPC_DYNAMIC_ALLOCATION");
+
+/// Size of each block in a client's synchronous call pool, in bytes. A block
+/// holds a call's response struct and its completion notification. Calls
+/// whose state is larger than this are heap-allocated. This defaults to 256.
+#ifndef PW_RPC_SYNCHRONOUS_CALL_POOL_BLOCK_SIZE_BYTES
+#define PW_RPC_SYNCHRONOUS_CALL_POOL_BLOCK_SIZE_BYTES 256
+#endif  // PW_RPC_SYNCHRONOUS_CALL_POOL_BLOCK_SIZE_BYTES
+
+/// The number of server stream messages a client permits the server to send
+/// ahead of the messages it has processed. Credit-based flow control for
+/// server streams is disabled if this is 0.
+///
+/// When enabled, clients send this number of credits in the request for each
+/// server streaming or bidirectional streaming RPC, and grant the credits back
+/// in CLIENT_CREDIT packets as they process stream messages. Servers enforce
+/// the credits for calls that requested them: each server stream message uses
+/// one credit, and writes fail with UNAVAILABLE while the call has none. Server
+/// writers report whether they have credits with ``ready_to_write()`` and can
+/// invoke a callback when credits arrive. Calls from clients that do not send
+/// credits are not flow controlled.
+///
+/// This must be no more than 127. This defaults to 0.
+#ifndef PW_RPC_SERVER_STREAM_CREDITS
+#define PW_RPC_SERVER_STREAM_CREDITS 0
+#endif  // PW_RPC_SERVER_STREAM_CREDITS
+
+// Requests never include a status, so limiting the credits to a one-byte
+// varint lets them use the space reserved for a status in each packet.
+static_assert(PW_RPC_SERVER_STREAM_CREDITS >= 0 &&
+                  PW_RPC_SERVER_STREAM_CREDITS <= 127,
+              "PW_RPC_SERVER_STREAM_CREDITS must be between 0 and 127");
+
+/// Whether pw_rpc emits pw_trace events as it processes packets, invokes
+/// methods, and sends packets. Events are grouped by call ID, so the time
+/// spent in each stage of a call can be read from the trace.
+///
+/// Tracing is disabled by default, in which case the trace points compile to
+/// nothing. Enabling it requires a pw_trace backend.
+#ifndef PW_RPC_ENABLE_TRACING
+#define PW_RPC_ENABLE_TRACING 0
+#endif  // PW_RPC_ENABLE_TRACING
+
 /// The log level to use for this module. Logs below this level are omitted.
 #ifndef PW_RPC_CONFIG_LOG_LEVEL
 #define PW_RPC_CONFIG_LOG_LEVEL PW_LOG_LEVEL_INFO
@@ -249,6 +399,10 @@ constexpr std::bool_constant<PW_RPC_COMPLETION_REQUEST_CALLBACK>
 template <typename...>
 constexpr std::bool_constant<PW_RPC_METHOD_STORES_TYPE> kMethodStoresType;
 
+template <typename...>
+constexpr std::bool_constant<(PW_RPC_SERVER_STREAM_CREDITS > 0)>
+    kServerStreamCreditsEnabled;
+
 template <typename...>
 constexpr std::bool_constant<PW_RPC_DYNAMIC_ALLOCATION>
     kDynamicAllocationEnabled;
@@ -259,6 +413,23 @@ inline constexpr size_t kNanopbStructMinBufferSize =
 inline constexpr size_t kEncodingBufferSizeBytes =
     PW_RPC_ENCODING_BUFFER_SIZE_BYTES;
 
+inline constexpr size_t kEncodingBufferPoolSize =
+    PW_RPC_ENCODING_BUFFER_POOL_SIZE;
+
+inline constexpr size_t kSynchronousCallPoolSize =
+    PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE;
+
+inline constexpr size_t kSynchronousCallPoolBlockSizeBytes =
+    PW_RPC_SYNCHRONOUS_CALL_POOL_BLOCK_SIZE_BYTES;
+
+inline constexpr size_t kLockShards = PW_RPC_LOCK_SHARDS;
+
+inline constexpr uint32_t kServerStreamCredits = PW_RPC_SERVER_STREAM_CREDITS;
+
+inline constexpr size_t kCallIndexSize = PW_RPC_CALL_INDEX_SIZE;
+
+inline constexpr size_t kServiceIndexSize = PW_RPC_SERVICE_INDEX_SIZE;
+
 #undef PW_RPC_NANOPB_STRUCT_MIN_BUFFER_SIZE
 #undef PW_RPC_ENCODING_BUFFER_SIZE_BYTES
 
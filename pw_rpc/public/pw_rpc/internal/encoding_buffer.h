@@ -18,13 +18,16 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 
 #include "pw_assert/assert.h"
 #include "pw_bytes/span.h"
+#include "pw_rpc/internal/call.h"
 #include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/lock.h"
 #include "pw_rpc/internal/packet.h"
 #include "pw_status/status_with_size.h"
+#include "pw_status/try.h"
 
 #if PW_RPC_DYNAMIC_ALLOCATION
 
@@ -112,16 +115,72 @@ using EncodingBuffer = StaticEncodingBuffer;
 
 #endif  // PW_RPC_DYNAMIC_ALLOCATION
 
-// Instantiate the global encoding buffer variable, depending on whether dynamic
-// allocation is enabled or not.
-inline EncodingBuffer encoding_buffer PW_GUARDED_BY(rpc_lock());
+// Instantiate the global encoding buffers, depending on whether dynamic
+// allocation is enabled or not. Each lock shard has its own encoding buffer,
+// which is guarded by that shard's lock.
+inline std::array<EncodingBuffer, cfg::kLockShards> encoding_buffers
+    PW_GUARDED_BY(rpc_lock());
+
+// Returns the encoding buffer for a lock shard. The lock for that shard must be
+// held while the buffer is in use.
+inline EncodingBuffer& GetEncodingBuffer(uint8_t lock_shard)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+  return encoding_buffers[lock_shard];
+}
+
+#if PW_RPC_ENCODING_BUFFER_POOL_SIZE > 0
+
+// A pool of encoding buffers for one lock shard. Payloads encoded into a pooled
+// buffer do not need the shard's lock held while they are encoded, only while
+// the buffer is checked out, sent, and returned.
+class EncodingBufferPool {
+ public:
+  constexpr EncodingBufferPool() = default;
+
+  // Checks out an unused buffer. Returns nullptr if every buffer is in use.
+  StaticEncodingBuffer* Acquire() {
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+      if (!in_use_[i]) {
+        in_use_[i] = true;
+        return &buffers_[i];
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns a buffer obtained from Acquire() to the pool.
+  void Release(StaticEncodingBuffer& buffer) {
+    const size_t index = static_cast<size_t>(&buffer - buffers_.data());
+    PW_DASSERT(index < buffers_.size() && in_use_[index]);
+    in_use_[index] = false;
+  }
+
+ private:
+  std::array<StaticEncodingBuffer, cfg::kEncodingBufferPoolSize> buffers_;
+  std::array<bool, cfg::kEncodingBufferPoolSize> in_use_{};
+};
+
+inline std::array<EncodingBufferPool, cfg::kLockShards> encoding_buffer_pools
+    PW_GUARDED_BY(rpc_lock());
+
+// Returns the encoding buffer pool for a lock shard. The lock for that shard
+// must be held while checking buffers out of or into the pool.
+inline EncodingBufferPool& GetEncodingBufferPool(uint8_t lock_shard)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+  return encoding_buffer_pools[lock_shard];
+}
+
+#endif  // PW_RPC_ENCODING_BUFFER_POOL_SIZE > 0
 
 // Successful calls to EncodeToPayloadBuffer MUST send the returned buffer,
 // without releasing the RPC lock.
 template <typename Proto, typename Encoder>
-static Result<ByteSpan> EncodeToPayloadBuffer(Proto& payload,
+static Result<ByteSpan> EncodeToPayloadBuffer(uint8_t lock_shard,
+                                              Proto& payload,
                                               const Encoder& encoder)
     PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+  EncodingBuffer& encoding_buffer = GetEncodingBuffer(lock_shard);
+
   // If dynamic allocation is enabled, calculate the size of the encoded
   // protobuf and allocate a buffer for it.
 #if PW_RPC_DYNAMIC_ALLOCATION
@@ -143,4 +202,41 @@ static Result<ByteSpan> EncodeToPayloadBuffer(Proto& payload,
   return buffer.first(result.size());
 }
 
+// Encodes a payload and sends it in a client or server stream packet for the
+// call. The call must be active.
+//
+// If the encoding buffer pool is enabled and has a free buffer, the payload is
+// encoded into it with the call's lock released, so that other threads can
+// encode or send packets in the meantime. The call may be closed while the
+// lock is released, in which case this returns FAILED_PRECONDITION. Otherwise,
+// the payload is encoded into the shared encoding buffer with the lock held.
+template <typename Proto, typename Encoder>
+Status EncodeAndWriteLocked(Call& call, Proto& payload, const Encoder& encoder)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+#if PW_RPC_ENCODING_BUFFER_POOL_SIZE > 0
+  const uint8_t lock_shard = call.lock_shard();
+  EncodingBufferPool& pool = GetEncodingBufferPool(lock_shard);
+  if (StaticEncodingBuffer* pooled = pool.Acquire(); pooled != nullptr) {
+    ByteSpan buffer = pooled->GetPacketBuffer(0);
+
+    UnlockRpcShards(lock_shard, lock_shard);
+    StatusWithSize encoded = encoder.Encode(payload, ResizeForPayload(buffer));
+    LockRpcShards(lock_shard, lock_shard);
+
+    Status status = encoded.status();
+    if (status.ok()) {
+      status = call.WriteLocked(
+          ResizeForPayload(buffer).first(encoded.size()), buffer);
+    }
+    pool.Release(*pooled);
+    return status;
+  }
+#endif  // PW_RPC_ENCODING_BUFFER_POOL_SIZE > 0
+
+  Result<ByteSpan> buffer =
+      EncodeToPayloadBuffer(call.lock_shard(), payload, encoder);
+  PW_TRY(buffer.status());
+  return call.WriteLocked(*buffer);
+}
+
 }  // namespace pw::rpc::internal
@@ -13,12 +13,11 @@
 // the License.
 #pragma once
 
-#include <tuple>
-
 #include "pw_assert/assert.h"
-#include "pw_containers/intrusive_list.h"
+#include "pw_containers/intrusive_dlist.h"
 #include "pw_result/result.h"
 #include "pw_rpc/internal/call.h"
+#include "pw_rpc/internal/call_index.h"
 #include "pw_rpc/internal/channel.h"
 #include "pw_rpc/internal/channel_list.h"
 #include "pw_rpc/internal/lock.h"
@@ -58,7 +57,7 @@ class Endpoint {
   //
   Status OpenChannel(uint32_t id, ChannelOutput& interface)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return channels_.Add(id, interface);
   }
 
@@ -67,11 +66,34 @@ class Endpoint {
   // called with the ABORTED status.
   Status CloseChannel(uint32_t channel_id) PW_LOCKS_EXCLUDED(rpc_lock());
 
+  // Assigns this endpoint to one of the PW_RPC_LOCK_SHARDS RPC locks. By
+  // default, endpoints use lock shard 0. Endpoints with different lock shards
+  // process packets in parallel. Endpoints that share channels or channel
+  // outputs must use the same lock shard.
+  //
+  // This must be called before the endpoint is used, since calls and channels
+  // are guarded by the endpoint's lock.
+  void set_lock_shard(uint8_t shard) {
+    PW_ASSERT(shard < cfg::kLockShards);
+#if PW_RPC_LOCK_SHARDS > 1
+    lock_shard_ = shard;
+#endif  // PW_RPC_LOCK_SHARDS > 1
+  }
+
+  // Returns the lock shard of the RPC lock that guards this endpoint.
+  uint8_t lock_shard() const {
+#if PW_RPC_LOCK_SHARDS > 1
+    return lock_shard_;
+#else
+    return 0;
+#endif  // PW_RPC_LOCK_SHARDS > 1
+  }
+
   // Internal functions, hidden by the Client and Server classes
 
   // Returns the number calls in the RPC calls list.
   size_t active_call_count() const PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return calls_.size();
   }
 
@@ -103,6 +125,17 @@ class Endpoint {
   //
   void CleanUpCalls() PW_UNLOCK_FUNCTION(rpc_lock());
 
+  // Acquires and releases the RPC lock that guards this endpoint.
+  void LockRpc() const PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock())
+      PW_NO_LOCK_SAFETY_ANALYSIS {
+    rpc_lock_shard(lock_shard()).lock();
+  }
+
+  void UnlockRpc() const PW_UNLOCK_FUNCTION(rpc_lock())
+      PW_NO_LOCK_SAFETY_ANALYSIS {
+    rpc_lock_shard(lock_shard()).unlock();
+  }
+
  protected:
   _PW_RPC_CONSTEXPR Endpoint() = default;
 
@@ -118,19 +151,12 @@ class Endpoint {
       PW_LOCKS_EXCLUDED(rpc_lock());
 
   // Finds a call object for an ongoing call associated with this packet, if
-  // any. The iterator will be calls_end() if no match was found.
-  IntrusiveList<Call>::iterator FindCall(const Packet& packet)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return std::get<1>(FindIteratorsForCall(packet.channel_id(),
-                                            packet.service_id(),
-                                            packet.method_id(),
-                                            packet.call_id()));
-  }
-
-  // Used to check if a call iterator is valid or not.
-  IntrusiveList<Call>::const_iterator calls_end() const
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return calls_.end();
+  // any. Returns nullptr if no match was found.
+  Call* FindCall(const Packet& packet) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    return FindActiveCall(packet.channel_id(),
+                          packet.service_id(),
+                          packet.method_id(),
+                          packet.call_id());
   }
 
   // Aborts calls associated with a particular service. Calls to
@@ -146,6 +172,7 @@ class Endpoint {
   // This method is protected so it can be exposed in tests.
   void CloseCallAndMarkForCleanup(Call& call, Status error)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    RemoveFromCallIndex(call);
     call.CloseAndMarkForCleanupFromEndpoint(error);
     calls_.remove(call);
     to_cleanup_.push_front(call);
@@ -153,13 +180,13 @@ class Endpoint {
 
   // Iterator version of CloseCallAndMarkForCleanup. Returns the iterator to the
   // item after the closed call.
-  IntrusiveList<Call>::iterator CloseCallAndMarkForCleanup(
-      IntrusiveList<Call>::iterator before_call,
-      IntrusiveList<Call>::iterator call_iterator,
-      Status error) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+  IntrusiveDList<Call>::iterator CloseCallAndMarkForCleanup(
+      IntrusiveDList<Call>::iterator call_iterator, Status error)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
     Call& call = *call_iterator;
+    RemoveFromCallIndex(call);
     call.CloseAndMarkForCleanupFromEndpoint(error);
-    auto next = calls_.erase_after(before_call);
+    auto next = calls_.erase(call_iterator);
     to_cleanup_.push_front(call);
     return next;
   }
@@ -200,6 +227,7 @@ class Endpoint {
   // for existing calls.
   void RegisterUniqueCall(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
     calls_.push_front(call);
+    AddToCallIndex(call);
   }
 
   void CleanUpCall(Call& call) PW_UNLOCK_FUNCTION(rpc_lock()) {
@@ -209,26 +237,56 @@ class Endpoint {
   }
 
   // Removes the provided call from the call registry.
-  void UnregisterCall(const Call& call)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+  void UnregisterCall(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    RemoveFromCallIndex(call);
     bool closed_call_was_in_list = calls_.remove(call);
     PW_DASSERT(closed_call_was_in_list);
   }
 
-  std::tuple<IntrusiveList<Call>::iterator, IntrusiveList<Call>::iterator>
-  FindIteratorsForCall(uint32_t channel_id,
+  // Adds a call in the calls list to the call index, if it is enabled.
+  void AddToCallIndex(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+#if PW_RPC_CALL_INDEX_SIZE > 0
+    if (!call_index_.Insert(call)) {
+      unindexed_calls_ += 1;
+    }
+#else
+    static_cast<void>(call);
+#endif  // PW_RPC_CALL_INDEX_SIZE > 0
+  }
+
+  // Removes a call from the call index. Must be called before the call's IDs
+  // are cleared.
+  void RemoveFromCallIndex(const Call& call)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+#if PW_RPC_CALL_INDEX_SIZE > 0
+    if (!call_index_.Remove(call)) {
+      PW_DASSERT(unindexed_calls_ > 0u);
+      unindexed_calls_ -= 1;
+    }
+#else
+    static_cast<void>(call);
+#endif  // PW_RPC_CALL_INDEX_SIZE > 0
+  }
+
+  // Finds the active call with these IDs, using the call index if possible.
+  Call* FindActiveCall(uint32_t channel_id,
                        uint32_t service_id,
                        uint32_t method_id,
                        uint32_t call_id)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
-  std::tuple<IntrusiveList<Call>::iterator, IntrusiveList<Call>::iterator>
-  FindIteratorsForCall(const Call& call)
+  IntrusiveDList<Call>::iterator FindIteratorForCall(uint32_t channel_id,
+                                                    uint32_t service_id,
+                                                    uint32_t method_id,
+                                                    uint32_t call_id)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  IntrusiveDList<Call>::iterator FindIteratorForCall(const Call& call)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return FindIteratorsForCall(call.channel_id_locked(),
-                                call.service_id(),
-                                call.method_id(),
-                                call.id());
+    return FindIteratorForCall(call.channel_id_locked(),
+                               call.service_id(),
+                               call.method_id(),
+                               call.id());
   }
 
   // Silently closes all calls. Called by the destructor. This is a
@@ -246,17 +304,29 @@ class Endpoint {
 
   // List of all active calls associated with this endpoint. Calls are added to
   // this list when they start and removed from it when they finish.
-  IntrusiveList<Call> calls_ PW_GUARDED_BY(rpc_lock());
+  IntrusiveDList<Call> calls_ PW_GUARDED_BY(rpc_lock());
+
+#if PW_RPC_CALL_INDEX_SIZE > 0
+  // Index of the calls in calls_ with known call IDs, for finding the call for
+  // a packet without searching calls_. Counts the calls that are only in
+  // calls_, which must be searched if the index does not have a match.
+  CallIndex<cfg::kCallIndexSize> call_index_ PW_GUARDED_BY(rpc_lock());
+  size_t unindexed_calls_ PW_GUARDED_BY(rpc_lock()) = 0;
+#endif  // PW_RPC_CALL_INDEX_SIZE > 0
 
   // List of all inactive calls that need to have their on_error callbacks
   // called. Calling on_error requires releasing the RPC lock, so calls are
   // added to this list in situations where releasing the mutex could be
   // problematic.
-  IntrusiveList<Call> to_cleanup_ PW_GUARDED_BY(rpc_lock());
+  IntrusiveDList<Call> to_cleanup_ PW_GUARDED_BY(rpc_lock());
 
   // Skip call_id `0` to avoid confusion with legacy servers which use
   // call_id `0` as `kOpenCallId` or which do not provide call_id at all.
   uint32_t next_call_id_ PW_GUARDED_BY(rpc_lock()) = 1;
+
+#if PW_RPC_LOCK_SHARDS > 1
+  uint8_t lock_shard_ = 0;
+#endif  // PW_RPC_LOCK_SHARDS > 1
 };
 
 // An `Endpoint` indicating that `rpc_lock()` is held.
@@ -277,4 +347,9 @@ inline LockedEndpoint& Endpoint::ClaimLocked() {
   return *static_cast<LockedEndpoint*>(this);
 }
 
+inline RpcLockGuard::RpcLockGuard(const Endpoint& endpoint)
+    : first_(endpoint.lock_shard()), second_(first_) {
+  endpoint.LockRpc();
+}
+
 }  // namespace pw::rpc::internal
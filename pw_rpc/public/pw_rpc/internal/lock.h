@@ -13,6 +13,10 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <utility>
+
 #include "pw_rpc/internal/config.h"
 #include "pw_sync/lock_annotations.h"
 #include "pw_toolchain/no_destructor.h"
@@ -25,6 +29,9 @@
 
 namespace pw::rpc::internal {
 
+class Call;
+class Endpoint;
+
 #if PW_RPC_USE_GLOBAL_MUTEX
 
 using RpcLock = sync::Mutex;
@@ -39,19 +46,79 @@ class PW_LOCKABLE("pw::rpc::internal::RpcLock") RpcLock {
 
 #endif  // PW_RPC_USE_GLOBAL_MUTEX
 
-inline RpcLock& rpc_lock() {
-  static NoDestructor<RpcLock> lock;
-  return *lock;
+// Returns the RPC lock for a lock shard. There are PW_RPC_LOCK_SHARDS locks.
+inline RpcLock& rpc_lock_shard(uint8_t shard) {
+  static NoDestructor<std::array<RpcLock, cfg::kLockShards>> locks;
+  return (*locks)[shard];
 }
 
+// Returns the lock for lock shard 0, which endpoints use by default.
+//
+// `rpc_lock()` also names the RPC lock in thread safety annotations. Endpoints
+// and calls assigned to other lock shards are guarded by their own shard's
+// lock, but are annotated with `rpc_lock()`, since the analysis cannot track
+// which shard an object uses.
+inline RpcLock& rpc_lock() { return rpc_lock_shard(0); }
+
+// Acquires the locks for two lock shards. The locks are always acquired in
+// the same order to avoid deadlocks. If the shards are the same, the lock is
+// only acquired once.
+inline void LockRpcShards(uint8_t first, uint8_t second)
+    PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock()) PW_NO_LOCK_SAFETY_ANALYSIS {
+  if (second < first) {
+    std::swap(first, second);
+  }
+  rpc_lock_shard(first).lock();
+  if (first != second) {
+    rpc_lock_shard(second).lock();
+  }
+}
+
+// Releases the locks acquired with LockRpcShards().
+inline void UnlockRpcShards(uint8_t first, uint8_t second)
+    PW_UNLOCK_FUNCTION(rpc_lock()) PW_NO_LOCK_SAFETY_ANALYSIS {
+  rpc_lock_shard(first).unlock();
+  if (first != second) {
+    rpc_lock_shard(second).unlock();
+  }
+}
+
+// Holds the RPC lock for an endpoint or call for the lifetime of the guard.
 class PW_SCOPED_LOCKABLE RpcLockGuard {
  public:
-  RpcLockGuard() PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock()) { rpc_lock().lock(); }
+  // Acquires rpc_lock(), the lock for lock shard 0.
+  RpcLockGuard() PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock())
+      : first_(0), second_(0) {
+    LockRpcShards(first_, second_);
+  }
+
+  // Acquires the lock for the endpoint's lock shard. Defined in endpoint.h.
+  explicit RpcLockGuard(const Endpoint& endpoint)
+      PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock());
+
+  // Acquires the lock for the call's lock shard. Defined in call.h.
+  explicit RpcLockGuard(const Call& call)
+      PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock());
+
+  // Acquires the locks for two calls, which is needed to move one call into
+  // the other. Defined in call.h.
+  RpcLockGuard(const Call& first, const Call& second)
+      PW_EXCLUSIVE_LOCK_FUNCTION(rpc_lock());
+
+  RpcLockGuard(const RpcLockGuard&) = delete;
+  RpcLockGuard& operator=(const RpcLockGuard&) = delete;
+
+  ~RpcLockGuard() PW_UNLOCK_FUNCTION(rpc_lock()) {
+    UnlockRpcShards(first_, second_);
+  }
 
-  ~RpcLockGuard() PW_UNLOCK_FUNCTION(rpc_lock()) { rpc_lock().unlock(); }
+ private:
+  uint8_t first_;
+  uint8_t second_;
 };
 
-// Releases the RPC lock, yields, and reacquires it.
-void YieldRpcLock() PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+// Releases the locks for two lock shards, yields, and reacquires them.
+void YieldRpcLock(uint8_t first, uint8_t second)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
 }  // namespace pw::rpc::internal
@@ -110,6 +110,23 @@ class Packet {
   // Encodes the packet into its wire format. Returns the encoded size.
   Result<ConstByteSpan> Encode(ByteSpan buffer) const;
 
+  // Encodes every field of the packet except the payload, followed by the key
+  // and length of a payload of payload_size bytes. Appending the payload to
+  // the result produces a complete packet. The packet's own payload is
+  // ignored. The buffer must be at least kMinEncodedSizeWithoutPayload bytes.
+  Result<ConstByteSpan> EncodeHeader(ByteSpan buffer,
+                                     size_t payload_size) const;
+
+  // Encodes the packet into a buffer that already holds its payload,
+  // kMinEncodedSizeWithoutPayload bytes from the start, as payloads encoded
+  // into the RPC encoding buffer are. The header is encoded directly in front
+  // of the payload, so unlike Encode(), this does not move the payload. The
+  // returned packet may start partway into the buffer.
+  //
+  // Falls back to Encode() if the payload is elsewhere or the header does not
+  // fit in front of it.
+  Result<ConstByteSpan> EncodeInPlace(ByteSpan buffer) const;
+
   // Determines the space required to encode the packet proto fields for a
   // response, excluding the payload. This may be used to split the buffer into
   // reserved space and available space for the payload.
@@ -131,6 +148,7 @@ class Packet {
   constexpr uint32_t call_id() const { return call_id_; }
   constexpr const ConstByteSpan& payload() const { return payload_; }
   constexpr const Status& status() const { return status_; }
+  constexpr uint32_t credits() const { return credits_; }
 
   constexpr void set_type(pwpb::PacketType type) { type_ = type; }
   constexpr void set_channel_id(uint32_t channel_id) {
@@ -143,6 +161,7 @@ class Packet {
   constexpr void set_call_id(uint32_t call_id) { call_id_ = call_id; }
   constexpr void set_payload(ConstByteSpan payload) { payload_ = payload; }
   constexpr void set_status(Status status) { status_ = status; }
+  constexpr void set_credits(uint32_t credits) { credits_ = credits; }
 
   // Logs detailed info about this packet at INFO level. NOT for production use!
   void DebugLog() const;
@@ -155,6 +174,7 @@ class Packet {
   uint32_t call_id_;
   ConstByteSpan payload_;
   Status status_;
+  uint32_t credits_ = 0;
 };
 
 }  // namespace pw::rpc::internal
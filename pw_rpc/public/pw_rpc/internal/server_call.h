@@ -30,18 +30,22 @@ class ServerCall : public Call {
     auto on_client_requested_completion_local =
         std::move(on_client_requested_completion_);
     CallbackStarted();
-    rpc_lock().unlock();
+    UnlockRpc();
 
     if (on_client_requested_completion_local) {
       on_client_requested_completion_local();
     }
 
-    rpc_lock().lock();
+    LockRpc();
     CallbackFinished();
 #endif  // PW_RPC_COMPLETION_REQUEST_CALLBACK
-    rpc_lock().unlock();
+    UnlockRpc();
   }
 
+  // Adds server stream credits granted by the client. Invokes the
+  // on_ready_to_write callback if the call had run out of credits.
+  void HandleStreamCredits(uint32_t credits) PW_UNLOCK_FUNCTION(rpc_lock());
+
  protected:
   constexpr ServerCall() = default;
 
@@ -51,7 +55,7 @@ class ServerCall : public Call {
 
   // Version of operator= used by the raw call classes.
   ServerCall& operator=(ServerCall&& other) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveServerCallFrom(other);
     return *this;
   }
@@ -75,7 +79,7 @@ class ServerCall : public Call {
                   "enable the client end "
                   "callback, set PW_RPC_REQUEST_COMPLETION_CALLBACK to 1.");
 #if PW_RPC_COMPLETION_REQUEST_CALLBACK
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     on_client_requested_completion_ = std::move(on_client_requested_completion);
 #endif  // PW_RPC_COMPLETION_REQUEST_CALLBACK
   }
@@ -88,18 +92,49 @@ class ServerCall : public Call {
       Function<void()>&& on_client_requested_completion)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
 #if PW_RPC_COMPLETION_REQUEST_CALLBACK
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     on_client_requested_completion_ = std::move(on_client_requested_completion);
 #else
     on_client_requested_completion = nullptr;
 #endif  // PW_RPC_COMPLETION_REQUEST_CALLBACK
   }
 
+  // Returns false if the call is flow controlled and must wait for the client
+  // to grant credits before writing another server stream message. Writes
+  // return UNAVAILABLE while this is false.
+  bool ready_to_write() const PW_LOCKS_EXCLUDED(rpc_lock()) {
+    RpcLockGuard lock(*this);
+    return !active_locked() || HasStreamCredit();
+  }
+
+  // Sets a callback that is invoked when a flow-controlled call that had run
+  // out of credits receives more. set_on_ready_to_write is templated so that
+  // it can be conditionally disabled with a helpful static_assert message.
+  template <typename UnusedType = void>
+  void set_on_ready_to_write(
+      [[maybe_unused]] Function<void()>&& on_ready_to_write)
+      PW_LOCKS_EXCLUDED(rpc_lock()) {
+    static_assert(cfg::kServerStreamCreditsEnabled<UnusedType>,
+                  "Server stream flow control is disabled, so "
+                  "set_on_ready_to_write cannot be called. To enable flow "
+                  "control, set PW_RPC_SERVER_STREAM_CREDITS to a nonzero "
+                  "value.");
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+    RpcLockGuard lock(*this);
+    on_ready_to_write_ = std::move(on_ready_to_write);
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+  }
+
  private:
 #if PW_RPC_COMPLETION_REQUEST_CALLBACK
   // Called when a client stream completes.
   Function<void()> on_client_requested_completion_ PW_GUARDED_BY(rpc_lock());
 #endif  // PW_RPC_COMPLETION_REQUEST_CALLBACK
+
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  // Called when a flow-controlled call that had no credits receives more.
+  Function<void()> on_ready_to_write_ PW_GUARDED_BY(rpc_lock());
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
 };
 
 }  // namespace pw::rpc::internal
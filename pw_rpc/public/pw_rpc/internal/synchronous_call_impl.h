@@ -13,8 +13,10 @@
 // the License.
 #pragma once
 
+#include <new>
 #include <utility>
 
+#include "pw_rpc/client.h"
 #include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/method_info.h"
 #include "pw_rpc/synchronous_call_result.h"
@@ -74,6 +76,52 @@ class RawSynchronousCallState {
   Function<void(ConstByteSpan, Status)> on_completed_;
 };
 
+#if PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
+
+// Holds the state of a synchronous call. The state is placed in a block from
+// the client's synchronous call pool, or heap-allocated if no block is free.
+template <typename State>
+class SynchronousCallStateHolder {
+ public:
+  explicit SynchronousCallStateHolder(Client& client) : client_(client) {
+    void* block;
+    {
+      RpcLockGuard lock(client_);
+      block = client_.synchronous_call_pool_.Acquire(sizeof(State),
+                                                     alignof(State));
+    }
+    if (block != nullptr) {
+      state_ = new (block) State();
+    } else {
+      allocated_ = PW_RPC_MAKE_UNIQUE_PTR(State);
+      state_ = &*allocated_;
+    }
+    pooled_ = block != nullptr;
+  }
+
+  SynchronousCallStateHolder(const SynchronousCallStateHolder&) = delete;
+  SynchronousCallStateHolder& operator=(const SynchronousCallStateHolder&) =
+      delete;
+
+  ~SynchronousCallStateHolder() {
+    if (pooled_) {
+      state_->~State();
+      RpcLockGuard lock(client_);
+      client_.synchronous_call_pool_.Release(state_);
+    }
+  }
+
+  State& operator*() { return *state_; }
+
+ private:
+  Client& client_;
+  State* state_;
+  bool pooled_;
+  decltype(PW_RPC_MAKE_UNIQUE_PTR(State)) allocated_;
+};
+
+#endif  // PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
+
 // Overloaded function to choose detween timeout and deadline APIs.
 inline bool AcquireNotification(sync::TimedThreadNotification& notification,
                                 chrono::SystemClock::duration timeout) {
@@ -90,17 +138,24 @@ template <auto kRpcMethod,
           typename DoCall,
           typename... TimeoutArg>
 SynchronousCallResult<Response> StructSynchronousCall(
-    DoCall&& do_call, TimeoutArg... timeout_arg) {
+    Client& client, DoCall&& do_call, TimeoutArg... timeout_arg) {
   static_assert(MethodInfo<kRpcMethod>::kType == MethodType::kUnary,
                 "Only unary methods can be used with synchronous calls");
 
-  // If dynamic allocation is enabled, heap-allocate the call_state.
-#if PW_RPC_DYNAMIC_ALLOCATION
+  // If dynamic allocation is enabled, take the call_state from the client's
+  // pool or heap-allocate it.
+#if PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
+  SynchronousCallStateHolder<SynchronousCallState<Response>> call_state_holder(
+      client);
+  SynchronousCallState<Response>& call_state(*call_state_holder);
+#elif PW_RPC_DYNAMIC_ALLOCATION
+  static_cast<void>(client);
   auto call_state_ptr = PW_RPC_MAKE_UNIQUE_PTR(SynchronousCallState<Response>);
   SynchronousCallState<Response>& call_state(*call_state_ptr);
 #else
+  static_cast<void>(client);
   SynchronousCallState<Response> call_state;
-#endif  // PW_RPC_DYNAMIC_ALLOCATION
+#endif  // PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE > 0
 
   auto call = std::forward<DoCall>(do_call)(call_state);
 
@@ -0,0 +1,79 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "pw_assert/assert.h"
+
+namespace pw::rpc::internal {
+
+// A fixed pool of blocks for the state of synchronous calls. Each Client has a
+// pool if PW_RPC_SYNCHRONOUS_CALL_POOL_SIZE is set. The pool is not
+// synchronized; the client's RPC lock must be held while checking blocks out
+// of or into it.
+template <size_t kBlocks, size_t kBlockSizeBytes>
+class SynchronousCallPool {
+ public:
+  static_assert(kBlocks > 0u);
+
+  constexpr SynchronousCallPool() = default;
+
+  SynchronousCallPool(const SynchronousCallPool&) = delete;
+  SynchronousCallPool& operator=(const SynchronousCallPool&) = delete;
+
+  // Checks out an unused block for an object of the given size and alignment.
+  // Returns nullptr if the object does not fit in a block or every block is in
+  // use.
+  void* Acquire(size_t size, size_t alignment) {
+    if (size > kBlockSizeBytes || alignment > alignof(Block)) {
+      return nullptr;
+    }
+    for (size_t i = 0; i < kBlocks; ++i) {
+      if (!in_use_[i]) {
+        in_use_[i] = true;
+        return blocks_[i].data;
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns a block obtained from Acquire() to the pool.
+  void Release(void* block) {
+    const size_t index = static_cast<size_t>(static_cast<Block*>(block) -
+                                             blocks_.data());
+    PW_DASSERT(index < kBlocks && in_use_[index]);
+    in_use_[index] = false;
+  }
+
+  // Returns the number of blocks currently checked out.
+  size_t blocks_in_use() const {
+    size_t count = 0;
+    for (bool in_use : in_use_) {
+      count += in_use ? 1 : 0;
+    }
+    return count;
+  }
+
+ private:
+  struct alignas(std::max_align_t) Block {
+    std::byte data[kBlockSizeBytes];
+  };
+
+  std::array<Block, kBlocks> blocks_{};
+  std::array<bool, kBlocks> in_use_{};
+};
+
+}  // namespace pw::rpc::internal
@@ -156,7 +156,7 @@ class InvocationContext {
 
   template <typename T>
   T GetResponder() PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(call_context().server());
     return T(call_context().ClaimLocked());
   }
 
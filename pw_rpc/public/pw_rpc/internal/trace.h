@@ -0,0 +1,38 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Trace points for the pw_rpc module, which are compiled out unless
+// PW_RPC_ENABLE_TRACING is set. Events are in the "pw_rpc" group and use the
+// call ID as the trace ID, so that the events for each call can be found.
+#pragma once
+
+#include "pw_rpc/internal/config.h"
+
+#if PW_RPC_ENABLE_TRACING
+
+#include "pw_trace/trace.h"
+
+#define PW_RPC_TRACE_START(label, call_id) \
+  PW_TRACE_START(label, "pw_rpc", call_id)
+#define PW_RPC_TRACE_END(label, call_id) PW_TRACE_END(label, "pw_rpc", call_id)
+#define PW_RPC_TRACE_SCOPE(label, call_id) \
+  PW_TRACE_SCOPE(label, "pw_rpc", call_id)
+
+#else
+
+#define PW_RPC_TRACE_START(label, call_id)
+#define PW_RPC_TRACE_END(label, call_id)
+#define PW_RPC_TRACE_SCOPE(label, call_id)
+
+#endif  // PW_RPC_ENABLE_TRACING
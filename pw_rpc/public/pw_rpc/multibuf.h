@@ -0,0 +1,113 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/internal/lock.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/writer.h"
+#include "pw_status/status.h"
+
+namespace pw::rpc {
+
+// Bytes of headroom a MultiBuf payload needs for pw_rpc to encode its packet
+// header in place.
+inline constexpr size_t kMultiBufPacketHeadroom =
+    internal::Packet::kMinEncodedSizeWithoutPayload;
+
+// A ChannelOutput that sends packets as MultiBufs.
+//
+// Payloads written with WriteMultiBuf() are sent to a MultiBufChannelOutput
+// without being copied. pw_rpc encodes the packet header into the payload's
+// headroom, or into a separate chunk if there is not enough headroom, and
+// passes the resulting MultiBuf to SendMultiBuf(). Packets encoded into the
+// RPC encoding buffer, such as responses and errors, are copied into a
+// MultiBuf allocated from the output's allocator.
+class MultiBufChannelOutput : public ChannelOutput {
+ public:
+  // Creates a MultiBufChannelOutput that allocates from `allocator`. The
+  // output's framing may claim up to `reservation` bytes around each packet
+  // passed to SendMultiBuf().
+  constexpr MultiBufChannelOutput(const char* name,
+                                  multibuf::MultiBufAllocator& allocator,
+                                  multibuf::Reservation reservation = {})
+      : ChannelOutput(name), allocator_(allocator), reservation_(reservation) {}
+
+  multibuf::MultiBufAllocator& allocator() const { return allocator_; }
+
+  // Space the output's framing reserves around each packet.
+  constexpr multibuf::Reservation reservation() const { return reservation_; }
+
+  // Space to reserve around a payload so that neither pw_rpc nor the output's
+  // framing need to allocate when sending it.
+  constexpr multibuf::Reservation payload_reservation() const {
+    return multibuf::Reservation{kMultiBufPacketHeadroom, 0} + reservation_;
+  }
+
+  // Allocates a MultiBuf for a payload of `size` bytes with
+  // payload_reservation() around it.
+  std::optional<multibuf::MultiBuf> AllocatePayload(size_t size) {
+    return allocator_.Allocate(size, payload_reservation());
+  }
+
+  // Sends an encoded RPC packet. The same requirements apply as for
+  // ChannelOutput::Send(): the RPC lock is held, and no pw_rpc APIs may be
+  // called from this function. Unlike with Send(), the implementation takes
+  // ownership of the packet and may keep it after returning.
+  virtual Status SendMultiBuf(multibuf::MultiBuf&& packet)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) = 0;
+
+ private:
+  // Copies a packet from the RPC encoding buffer into a MultiBuf and passes it
+  // to SendMultiBuf().
+  Status Send(span<const std::byte> buffer) final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock());
+
+  MultiBufChannelOutput* AsMultiBufChannelOutput() final { return this; }
+
+  multibuf::MultiBufAllocator& allocator_;
+  multibuf::Reservation reservation_;
+};
+
+// Writes a MultiBuf payload to a streaming call. Works with any call that can
+// be used as a Writer, such as a RawServerWriter or RawClientReaderWriter
+// (obtained with as_writer()).
+//
+// If the call's channel uses a MultiBufChannelOutput, the payload is sent
+// without being copied. Allocating it with
+// MultiBufChannelOutput::AllocatePayload() avoids allocating a separate chunk
+// for the packet header. Otherwise, the payload is copied into the RPC
+// encoding buffer and sent like a payload passed to Writer::Write().
+//
+// Returns the same statuses as Writer::Write(), or RESOURCE_EXHAUSTED if the
+// packet header or copied payload could not be allocated.
+Status WriteMultiBuf(Writer& writer, multibuf::MultiBuf&& payload)
+    PW_LOCKS_EXCLUDED(internal::rpc_lock());
+
+namespace internal {
+
+// Accesses the private call members needed by WriteMultiBuf().
+class MultiBufWriter {
+ public:
+  static Status Write(Writer& writer, multibuf::MultiBuf&& payload)
+      PW_LOCKS_EXCLUDED(rpc_lock());
+};
+
+}  // namespace internal
+}  // namespace pw::rpc
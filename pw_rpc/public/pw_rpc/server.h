@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <tuple>
 
@@ -54,12 +55,12 @@ class Server : public internal::Endpoint {
   template <typename... OtherServices>
   void RegisterService(Service& service, OtherServices&... services)
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
-    internal::RpcLockGuard lock;
-    services_.push_front(service);  // Register the first service
+    internal::RpcLockGuard lock(*this);
+    AddService(service);  // Register the first service
 
     // Register any additional services by expanding the parameter pack. This
     // is a fold expression of the comma operator.
-    (services_.push_front(services), ...);
+    (AddService(services), ...);
   }
 
   // Returns whether a service is registered.
@@ -68,7 +69,7 @@ class Server : public internal::Endpoint {
   // on your logic you might want to check if a service is currently registered.
   bool IsServiceRegistered(const Service& service) const
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
-    internal::RpcLockGuard lock;
+    internal::RpcLockGuard lock(*this);
 
     for (const Service& svc : services_) {
       if (&svc == &service) {
@@ -82,7 +83,7 @@ class Server : public internal::Endpoint {
   template <typename... OtherServices>
   void UnregisterService(Service& service, OtherServices&... services)
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
-    internal::rpc_lock().lock();
+    LockRpc();
     UnregisterServiceLocked(service, static_cast<Service&>(services)...);
     CleanUpCalls();
   }
@@ -144,7 +145,7 @@ class Server : public internal::Endpoint {
                                   ServiceImpl& service,
                                   const MethodImpl& method)
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
-    internal::rpc_lock().lock();
+    LockRpc();
 
     using Info = internal::MethodInfo<kMethod>;
     if constexpr (kExpected == MethodType::kUnary) {
@@ -180,6 +181,38 @@ class Server : public internal::Endpoint {
       uint32_t service_id, uint32_t method_id)
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock());
 
+  // Finds the registered service with this ID, or returns nullptr.
+  Service* FindServiceLocked(uint32_t service_id)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock());
+
+  // Adds a service to the services list and, if enabled, the service index.
+  void AddService(Service& service)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
+    services_.push_front(service);
+#if PW_RPC_SERVICE_INDEX_SIZE > 0
+    AddToServiceIndex(service);
+#endif  // PW_RPC_SERVICE_INDEX_SIZE > 0
+  }
+
+  // Removes a service from the services list and, if enabled, the service
+  // index. Does nothing if the service is not registered.
+  void RemoveService(Service& service)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
+    if (services_.remove(service)) {
+#if PW_RPC_SERVICE_INDEX_SIZE > 0
+      RemoveFromServiceIndex(service);
+#endif  // PW_RPC_SERVICE_INDEX_SIZE > 0
+    }
+  }
+
+#if PW_RPC_SERVICE_INDEX_SIZE > 0
+  void AddToServiceIndex(Service& service)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock());
+
+  void RemoveFromServiceIndex(const Service& service)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock());
+#endif  // PW_RPC_SERVICE_INDEX_SIZE > 0
+
   std::tuple<Service*, const internal::Method*> FindMethodLocked(
       const internal::Packet& packet)
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
@@ -189,18 +222,18 @@ class Server : public internal::Endpoint {
 
   void HandleCompletionRequest(const internal::Packet& packet,
                                internal::Channel& channel,
-                               IntrusiveList<internal::Call>::iterator call)
+                               internal::Call* call)
       const PW_UNLOCK_FUNCTION(internal::rpc_lock());
 
   void HandleClientStreamPacket(const internal::Packet& packet,
                                 internal::Channel& channel,
-                                IntrusiveList<internal::Call>::iterator call)
+                                internal::Call* call)
       const PW_UNLOCK_FUNCTION(internal::rpc_lock());
 
   template <typename... OtherServices>
   void UnregisterServiceLocked(Service& service, OtherServices&... services)
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
-    services_.remove(service);
+    RemoveService(service);
     UnregisterServiceLocked(services...);
     AbortCallsForService(service);
   }
@@ -212,8 +245,20 @@ class Server : public internal::Endpoint {
   using Endpoint::ClaimLocked;
   using Endpoint::CleanUpCalls;
   using Endpoint::GetInternalChannel;
+  using Endpoint::LockRpc;
+  using Endpoint::UnlockRpc;
 
   IntrusiveList<Service> services_ PW_GUARDED_BY(internal::rpc_lock());
+
+#if PW_RPC_SERVICE_INDEX_SIZE > 0
+  // The first indexed_services_ entries are registered services sorted by ID.
+  // Services registered while the index is full are only in services_, which
+  // is searched if there are any.
+  std::array<Service*, cfg::kServiceIndexSize> service_index_
+      PW_GUARDED_BY(internal::rpc_lock()) = {};
+  size_t indexed_services_ PW_GUARDED_BY(internal::rpc_lock()) = 0;
+  size_t unindexed_services_ PW_GUARDED_BY(internal::rpc_lock()) = 0;
+#endif  // PW_RPC_SERVICE_INDEX_SIZE > 0
 };
 
 }  // namespace pw::rpc
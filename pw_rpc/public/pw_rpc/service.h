@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <limits>
 
@@ -48,16 +49,20 @@ class Service : public IntrusiveList<Service>::Item {
   // a `const internal::MethodUnion*`.
   template <typename T, size_t kMethodCount>
   constexpr Service(uint32_t id, const std::array<T, kMethodCount>& methods)
-      : id_(id),
-        methods_(methods.data()),
-        method_size_(sizeof(T)),
-        method_count_(static_cast<uint16_t>(kMethodCount)) {
-    PW_MODIFY_DIAGNOSTICS_PUSH();
-    // GCC 10 emits spurious -Wtype-limits warnings for the static_assert.
-    PW_MODIFY_DIAGNOSTIC_GCC(ignored, "-Wtype-limits");
-    static_assert(kMethodCount <= std::numeric_limits<uint16_t>::max());
-    PW_MODIFY_DIAGNOSTICS_POP();
-  }
+      : Service(id, methods, nullptr) {}
+
+  // Creates a service with a table of the IDs of its methods, in the same order
+  // as the methods. The method IDs must be sorted in ascending order, which
+  // allows methods to be found with a binary search. Generated services sort
+  // their methods by ID and use this constructor.
+  //
+  // Note: This constructor is not for direct use outside of pigweed, and
+  // is not considered part of the public API.
+  template <typename T, size_t kMethodCount>
+  constexpr Service(uint32_t id,
+                    const std::array<T, kMethodCount>& methods,
+                    const std::array<uint32_t, kMethodCount>& sorted_method_ids)
+      : Service(id, methods, sorted_method_ids.data()) {}
 
   // For use by tests with only one method.
   //
@@ -65,17 +70,44 @@ class Service : public IntrusiveList<Service>::Item {
   // is not considered part of the public API.
   template <typename T>
   constexpr Service(uint32_t id, const T& method)
-      : id_(id), methods_(&method), method_size_(sizeof(T)), method_count_(1) {}
+      : id_(id),
+        methods_(&method),
+        method_ids_(nullptr),
+        method_size_(sizeof(T)),
+        method_count_(1) {}
 
  private:
   friend class Server;
   friend class ServiceTestHelper;
 
+  template <typename T, size_t kMethodCount>
+  constexpr Service(uint32_t id,
+                    const std::array<T, kMethodCount>& methods,
+                    const uint32_t* sorted_method_ids)
+      : id_(id),
+        methods_(methods.data()),
+        method_ids_(sorted_method_ids),
+        method_size_(sizeof(T)),
+        method_count_(static_cast<uint16_t>(kMethodCount)) {
+    PW_MODIFY_DIAGNOSTICS_PUSH();
+    // GCC 10 emits spurious -Wtype-limits warnings for the static_assert.
+    PW_MODIFY_DIAGNOSTIC_GCC(ignored, "-Wtype-limits");
+    static_assert(kMethodCount <= std::numeric_limits<uint16_t>::max());
+    PW_MODIFY_DIAGNOSTICS_POP();
+  }
+
   // Finds the method with the provided method_id. Returns nullptr if no match.
   const internal::Method* FindMethod(uint32_t method_id) const;
 
+  // Returns the method at the provided index in the methods table.
+  const internal::Method& MethodAt(size_t index) const;
+
   const uint32_t id_;
   const internal::MethodUnion* const methods_;
+
+  // Sorted IDs of the methods in methods_, or nullptr if they were not
+  // provided, in which case methods are found with a linear search.
+  const uint32_t* const method_ids_;
   const uint16_t method_size_;
   const uint16_t method_count_;
 };
@@ -134,6 +134,7 @@ SynchronousCallResult<Response> SynchronousCall(
     uint32_t channel_id,
     const typename internal::MethodInfo<kRpcMethod>::Request& request) {
   return internal::StructSynchronousCall<kRpcMethod, Response>(
+      client,
       internal::CallFreeFunctionWithCustomResponse<kRpcMethod, Response>(
           client, channel_id, request));
 }
@@ -149,6 +150,7 @@ SynchronousCall(
     const GeneratedClient& client,
     const typename internal::MethodInfo<kRpcMethod>::Request& request) {
   return internal::StructSynchronousCall<kRpcMethod>(
+      client.client(),
       internal::CallGeneratedClient<kRpcMethod>(client, request));
 }
 
@@ -191,6 +193,7 @@ SynchronousCallFor(
     const typename internal::MethodInfo<kRpcMethod>::Request& request,
     chrono::SystemClock::duration timeout) {
   return internal::StructSynchronousCall<kRpcMethod>(
+      client,
       internal::CallFreeFunction<kRpcMethod>(client, channel_id, request),
       timeout);
 }
@@ -208,6 +211,7 @@ SynchronousCallFor(
     const typename internal::MethodInfo<kRpcMethod>::Request& request,
     chrono::SystemClock::duration timeout) {
   return internal::StructSynchronousCall<kRpcMethod>(
+      client.client(),
       internal::CallGeneratedClient<kRpcMethod>(client, request), timeout);
 }
 
@@ -255,6 +259,7 @@ SynchronousCallUntil(
     const typename internal::MethodInfo<kRpcMethod>::Request& request,
     chrono::SystemClock::time_point deadline) {
   return internal::StructSynchronousCall<kRpcMethod>(
+      client,
       internal::CallFreeFunction<kRpcMethod>(client, channel_id, request),
       deadline);
 }
@@ -272,6 +277,7 @@ SynchronousCallUntil(
     const typename internal::MethodInfo<kRpcMethod>::Request& request,
     chrono::SystemClock::time_point deadline) {
   return internal::StructSynchronousCall<kRpcMethod>(
+      client.client(),
       internal::CallGeneratedClient<kRpcMethod>(client, request), deadline);
 }
 
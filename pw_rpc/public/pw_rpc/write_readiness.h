@@ -0,0 +1,68 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_async2/atomic_waker.h"
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/poll.h"
+
+namespace pw::rpc {
+
+/// Allows a ``pw_async2`` ``Task`` to wait for a flow-controlled server writer
+/// to receive server stream credits.
+///
+/// ``ServerWriter`` may be any server streaming or bidirectional streaming
+/// writer class, such as ``RawServerWriter`` or ``pwpb::ServerReaderWriter``.
+/// ``WriteReadiness`` sets the writer's ``on_ready_to_write`` callback, so the
+/// writer must not be moved or given a different callback while the
+/// ``WriteReadiness`` exists. The ``WriteReadiness`` must outlive the writer's
+/// call, or be destroyed after the writer is closed.
+///
+/// Requires ``PW_RPC_SERVER_STREAM_CREDITS`` to be enabled.
+template <typename ServerWriter>
+class WriteReadiness {
+ public:
+  explicit WriteReadiness(ServerWriter& writer) : writer_(writer) {
+    writer_.set_on_ready_to_write([this]() { waker_.Wake(); });
+  }
+
+  WriteReadiness(const WriteReadiness&) = delete;
+  WriteReadiness& operator=(const WriteReadiness&) = delete;
+
+  ~WriteReadiness() { writer_.set_on_ready_to_write(nullptr); }
+
+  /// Returns ``Ready`` if the writer may write a server stream message.
+  /// Otherwise, arranges for the current ``Task`` to be woken when the client
+  /// grants credits and returns ``Pending``. Closed writers are always ready,
+  /// so that ``Write`` reports the error.
+  async2::Poll<> PollReadyToWrite(async2::Context& cx) {
+    if (writer_.ready_to_write()) {
+      return async2::Ready();
+    }
+    waker_.Register(cx);
+
+    // Credits may have arrived before the waker was registered.
+    if (writer_.ready_to_write()) {
+      waker_.Clear();
+      return async2::Ready();
+    }
+    return async2::Pending();
+  }
+
+ private:
+  ServerWriter& writer_;
+  async2::AtomicWaker waker_;
+};
+
+}  // namespace pw::rpc
@@ -31,7 +31,7 @@ namespace pw::rpc::internal::test {
 // readers and writers inherit from it, but hide the unsupported functionality.
 // A ReaderWriter defines conversions to Reader and Writer, so it acts as if it
 // inherited from both. This approach is unusual but necessary to have all
-// classes use a single IntrusiveList::Item base and to avoid virtual methods or
+// classes use a single IntrusiveDList::Item base and to avoid virtual methods or
 // virtual inheritance.
 //
 // Call's public API is intended for rpc::Server, so hide the public methods
@@ -59,6 +59,8 @@ class FakeServerReaderWriter : private ServerCall {
   using Call::set_on_next;
   using ServerCall::set_on_completion_requested;
   using ServerCall::set_on_completion_requested_if_enabled;
+  using ServerCall::ready_to_write;
+  using ServerCall::set_on_ready_to_write;
 
   Status Finish(Status status = OkStatus()) {
     return CloseAndSendResponse(status);
@@ -68,6 +70,7 @@ class FakeServerReaderWriter : private ServerCall {
 
   // Expose a few additional methods for test use.
   ServerCall& as_server_call() { return *this; }
+  using Call::as_writer;
   using Call::channel_id_locked;
   using Call::DebugLog;
   using Call::id;
@@ -90,6 +93,8 @@ class FakeServerWriter : private FakeServerReaderWriter {
   using FakeServerReaderWriter::set_on_completion_requested;
   using FakeServerReaderWriter::set_on_completion_requested_if_enabled;
   using FakeServerReaderWriter::set_on_error;
+  using FakeServerReaderWriter::ready_to_write;
+  using FakeServerReaderWriter::set_on_ready_to_write;
   using FakeServerReaderWriter::Write;
 
   // Functions for test use.
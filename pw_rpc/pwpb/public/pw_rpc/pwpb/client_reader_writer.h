@@ -49,7 +49,7 @@ class PwpbUnaryResponseClientCall : public UnaryResponseClientCall {
                         Function<void(Status)>&& on_error,
                         const Request&... request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     CallType call(
         client.ClaimLocked(), channel_id, service_id, method_id, serde);
     SetCallbacksAndSendRequest(call,
@@ -71,7 +71,7 @@ class PwpbUnaryResponseClientCall : public UnaryResponseClientCall {
       Function<void(const Response&, Status)>&& on_completed,
       Function<void(Status)>&& on_error,
       const Request&... request) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     auto call = PW_RPC_MAKE_UNIQUE_PTR(CallType,
                                        client.ClaimLocked(),
                                        channel_id,
@@ -112,7 +112,7 @@ class PwpbUnaryResponseClientCall : public UnaryResponseClientCall {
   // Allow derived classes to use move assignment from another instance.
   PwpbUnaryResponseClientCall& operator=(PwpbUnaryResponseClientCall&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MovePwpbUnaryResponseClientCallFrom(other);
     return *this;
   }
@@ -130,7 +130,7 @@ class PwpbUnaryResponseClientCall : public UnaryResponseClientCall {
   void set_on_completed(
       Function<void(const Response& response, Status)>&& on_completed)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_pwpb_on_completed_locked(std::move(on_completed));
   }
 
@@ -146,7 +146,7 @@ class PwpbUnaryResponseClientCall : public UnaryResponseClientCall {
   template <typename Request>
   Status SendStreamRequest(const Request& request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return PwpbSendStream(*this, request, serde_);
   }
 
@@ -208,7 +208,7 @@ class PwpbStreamResponseClientCall : public StreamResponseClientCall {
                         Function<void(Status)>&& on_error,
                         const Request&... request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     CallType call(
         client.ClaimLocked(), channel_id, service_id, method_id, serde);
     SetCallbacksAndSendRequest(call,
@@ -232,7 +232,7 @@ class PwpbStreamResponseClientCall : public StreamResponseClientCall {
                            Function<void(Status)>&& on_error,
                            const Request&... request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    rpc_lock().lock();
+    client.LockRpc();
     auto call = PW_RPC_MAKE_UNIQUE_PTR(CallType,
                                        client.ClaimLocked(),
                                        channel_id,
@@ -274,7 +274,7 @@ class PwpbStreamResponseClientCall : public StreamResponseClientCall {
   // Allow derived classes to use move assignment from another instance.
   PwpbStreamResponseClientCall& operator=(PwpbStreamResponseClientCall&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MovePwpbStreamResponseClientCallFrom(other);
     return *this;
   }
@@ -291,7 +291,7 @@ class PwpbStreamResponseClientCall : public StreamResponseClientCall {
 
   void set_on_next(Function<void(const Response& response)>&& on_next)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_pwpb_on_next_locked(std::move(on_next));
   }
 
@@ -307,7 +307,7 @@ class PwpbStreamResponseClientCall : public StreamResponseClientCall {
   template <typename Request>
   Status SendStreamRequest(const Request& request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return PwpbSendStream(*this, request, serde_);
   }
 
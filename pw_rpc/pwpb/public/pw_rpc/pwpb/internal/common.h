@@ -44,7 +44,8 @@ void PwpbSendInitialRequest(ClientCall& call,
     PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
   PW_ASSERT(call.active_locked());
 
-  Result<ByteSpan> buffer = EncodeToPayloadBuffer(request, serde);
+  Result<ByteSpan> buffer =
+      EncodeToPayloadBuffer(call.lock_shard(), request, serde);
   if (buffer.ok()) {
     call.SendInitialClientRequest(*buffer);
   } else {
@@ -63,12 +64,10 @@ Status PwpbSendStream(Call& call,
     return Status::FailedPrecondition();
   }
 
-  Result<ByteSpan> buffer = EncodeToPayloadBuffer(
+  return EncodeAndWriteLocked(
+      call,
       payload,
       call.type() == kClientCall ? serde->request() : serde->response());
-  PW_TRY(buffer);
-
-  return call.WriteLocked(*buffer);
 }
 
 }  // namespace pw::rpc::internal
@@ -303,7 +303,8 @@ class PwpbMethod : public Method {
     // fail.
     context.server()
         .GetInternalChannel(context.channel_id())
-        ->Send(Packet::ServerError(request, Status::DataLoss()))
+        ->Send(context.server().lock_shard(),
+               Packet::ServerError(request, Status::DataLoss()))
         .IgnoreError();
     return status;
   }
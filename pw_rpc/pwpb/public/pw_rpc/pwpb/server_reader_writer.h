@@ -62,13 +62,13 @@ class PwpbServerCall : public ServerCall {
   template <typename Response>
   Status SendUnaryResponse(const Response& response, Status status = OkStatus())
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     if (!active_locked()) {
       return Status::FailedPrecondition();
     }
 
     Result<ByteSpan> buffer =
-        EncodeToPayloadBuffer(response, serde_->response());
+        EncodeToPayloadBuffer(lock_shard(), response, serde_->response());
     if (!buffer.ok()) {
       return CloseAndSendServerErrorLocked(Status::Internal());
     }
@@ -80,13 +80,13 @@ class PwpbServerCall : public ServerCall {
   Status TrySendUnaryResponse(const Response& response,
                               Status status = OkStatus())
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     if (!active_locked()) {
       return Status::FailedPrecondition();
     }
 
     Result<ByteSpan> buffer =
-        EncodeToPayloadBuffer(response, serde_->response());
+        EncodeToPayloadBuffer(lock_shard(), response, serde_->response());
     if (!buffer.ok()) {
       return TryCloseAndSendServerErrorLocked(Status::Internal());
     }
@@ -113,7 +113,7 @@ class PwpbServerCall : public ServerCall {
   // Allow derived classes to use move assignment from another instance.
   PwpbServerCall& operator=(PwpbServerCall&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MovePwpbServerCallFrom(other);
     return *this;
   }
@@ -137,7 +137,7 @@ class PwpbServerCall : public ServerCall {
   template <typename Response>
   Status SendStreamResponse(const Response& response)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     return PwpbSendStream(*this, response, serde_);
   }
 
@@ -170,7 +170,7 @@ class BasePwpbServerReader : public PwpbServerCall {
   // Allow derived classes to use move assignment from another instance.
   BasePwpbServerReader& operator=(BasePwpbServerReader&& other)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this, other);
     MoveBasePwpbServerReaderFrom(other);
     return *this;
   }
@@ -184,7 +184,7 @@ class BasePwpbServerReader : public PwpbServerCall {
 
   void set_on_next(Function<void(const Request& request)>&& on_next)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    RpcLockGuard lock(*this);
     set_pwpb_on_next_locked(std::move(on_next));
   }
 
@@ -253,10 +253,15 @@ class PwpbServerReaderWriter : private internal::BasePwpbServerReader<Request> {
   using internal::ServerCall::set_on_completion_requested;
   using internal::ServerCall::set_on_completion_requested_if_enabled;
 
+  // Server stream flow control.
+  using internal::ServerCall::ready_to_write;
+  using internal::ServerCall::set_on_ready_to_write;
+
   // Writes a response. Returns the following Status codes:
   //
   //   OK - the response was successfully sent
   //   FAILED_PRECONDITION - the writer is closed
+  //   UNAVAILABLE - the call is flow controlled and has no credits
   //   INTERNAL - pw_rpc was unable to encode the pw_protobuf message
   //   other errors - the ChannelOutput failed to send the packet; the error
   //       codes are determined by the ChannelOutput implementation
@@ -405,10 +410,15 @@ class PwpbServerWriter : private internal::PwpbServerCall {
   using internal::ServerCall::set_on_completion_requested;
   using internal::ServerCall::set_on_completion_requested_if_enabled;
 
+  // Server stream flow control.
+  using internal::ServerCall::ready_to_write;
+  using internal::ServerCall::set_on_ready_to_write;
+
   // Writes a response. Returns the following Status codes:
   //
   //   OK - the response was successfully sent
   //   FAILED_PRECONDITION - the writer is closed
+  //   UNAVAILABLE - the call is flow controlled and has no credits
   //   INTERNAL - pw_rpc was unable to encode the pw_protobuf message
   //   other errors - the ChannelOutput failed to send the packet; the error
   //       codes are determined by the ChannelOutput implementation
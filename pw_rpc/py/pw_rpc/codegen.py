@@ -16,7 +16,7 @@
 import abc
 from datetime import datetime
 import os
-from typing import cast, Any, Iterable, Union
+from typing import cast, Any, Iterable, List, Union
 
 from pw_protobuf.output_file import OutputFile
 from pw_protobuf.proto_tree import ProtoNode, ProtoService, ProtoServiceMethod
@@ -400,7 +400,7 @@ def _generate_service(gen: CodeGenerator, service: ProtoService) -> None:
     with gen.indent():
         gen.line(
             'constexpr Service() : '
-            f'{base_class}(kServiceId, kPwRpcMethods) {{}}'
+            f'{base_class}(kServiceId, kPwRpcMethods, kPwRpcMethodIds) {{}}'
         )
 
     gen.line()
@@ -410,7 +410,8 @@ def _generate_service(gen: CodeGenerator, service: ProtoService) -> None:
         gen.line('friend class ::pw::rpc::internal::MethodLookup;')
         gen.line()
 
-        # Generate the method table
+        # Generate the method table, sorted by method ID so that the server
+        # can find methods with a binary search.
         gen.line(
             'static constexpr std::array<'
             f'{RPC_NAMESPACE}::internal::{gen.method_union_name()},'
@@ -418,7 +419,7 @@ def _generate_service(gen: CodeGenerator, service: ProtoService) -> None:
         )
 
         with gen.indent(4):
-            for method in service.methods():
+            for method in _methods_by_id(service):
                 gen.method_descriptor(method)
 
         gen.line('};\n')
@@ -429,15 +430,23 @@ def _generate_service(gen: CodeGenerator, service: ProtoService) -> None:
     gen.line('};')
 
 
+def _methods_by_id(service: ProtoService) -> List[ProtoServiceMethod]:
+    """Returns the service's methods, sorted by method ID."""
+    return sorted(service.methods(), key=lambda m: ids.calculate(m.name()))
+
+
 def _method_lookup_table(gen: CodeGenerator, service: ProtoService) -> None:
-    """Generates array of method IDs for looking up methods at compile time."""
+    """Generates a sorted array of method IDs for looking up methods.
+
+    The IDs are in the same order as the kPwRpcMethods table.
+    """
     gen.line(
         'static constexpr std::array<uint32_t, '
         f'{len(service.methods())}> kPwRpcMethodIds = {{'
     )
 
     with gen.indent(4):
-        for method in service.methods():
+        for method in _methods_by_id(service):
             gen.line(f'{get_id(method)},  // Hash of "{method.name()}"')
 
     gen.line('};')
@@ -78,6 +78,10 @@ class RawServerReaderWriter : private internal::ServerCall {
   using internal::ServerCall::set_on_completion_requested;
   using internal::ServerCall::set_on_completion_requested_if_enabled;
 
+  // Server stream flow control.
+  using internal::ServerCall::ready_to_write;
+  using internal::ServerCall::set_on_ready_to_write;
+
   // Sends a response packet with the given raw payload.
   using internal::Call::Write;
 
@@ -202,6 +206,9 @@ class RawServerWriter : private RawServerReaderWriter {
   using RawServerReaderWriter::set_on_completion_requested_if_enabled;
   using RawServerReaderWriter::set_on_error;
 
+  using RawServerReaderWriter::ready_to_write;
+  using RawServerReaderWriter::set_on_ready_to_write;
+
   using RawServerReaderWriter::Finish;
   using RawServerReaderWriter::TryFinish;
 
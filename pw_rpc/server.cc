@@ -23,6 +23,7 @@
 #include "pw_log/log.h"
 #include "pw_rpc/internal/endpoint.h"
 #include "pw_rpc/internal/packet.h"
+#include "pw_rpc/internal/trace.h"
 #include "pw_rpc/service_id.h"
 
 namespace pw::rpc {
@@ -31,13 +32,23 @@ namespace {
 using internal::Packet;
 using internal::pwpb::PacketType;
 
+#if PW_RPC_SERVICE_INDEX_SIZE > 0
+
+bool ServiceIdLess(const Service* service, uint32_t service_id) {
+  return internal::UnwrapServiceId(service->service_id()) < service_id;
+}
+
+#endif  // PW_RPC_SERVICE_INDEX_SIZE > 0
+
 }  // namespace
 
 Status Server::ProcessPacket(ConstByteSpan packet_data) {
   PW_TRY_ASSIGN(Packet packet,
                 Endpoint::ProcessPacket(packet_data, Packet::kServer));
 
-  internal::rpc_lock().lock();
+  PW_RPC_TRACE_SCOPE("ServerProcessPacket", packet.call_id());
+
+  LockRpc();
 
   // Verbose log for debugging.
   // PW_LOG_DEBUG("RPC server received packet type %u for %u:%08x/%08x",
@@ -48,7 +59,7 @@ Status Server::ProcessPacket(ConstByteSpan packet_data) {
 
   internal::Channel* channel = GetInternalChannel(packet.channel_id());
   if (channel == nullptr) {
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_WARN("RPC server received packet for unknown channel %u",
                 static_cast<unsigned>(packet.channel_id()));
     return Status::Unavailable();
@@ -59,10 +70,11 @@ Status Server::ProcessPacket(ConstByteSpan packet_data) {
   if (method == nullptr) {
     // Don't send responses to errors to avoid infinite error cycles.
     if (packet.type() != PacketType::CLIENT_ERROR) {
-      channel->Send(Packet::ServerError(packet, Status::NotFound()))
+      channel
+          ->Send(lock_shard(), Packet::ServerError(packet, Status::NotFound()))
           .IgnoreError();
     }
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_DEBUG("Received packet on channel %u for unknown RPC %08x/%08x",
                  static_cast<unsigned>(packet.channel_id()),
                  static_cast<unsigned>(packet.service_id()),
@@ -73,34 +85,50 @@ Status Server::ProcessPacket(ConstByteSpan packet_data) {
   // Handle request packets separately to avoid an unnecessary call lookup. The
   // Call constructor looks up and cancels any duplicate calls.
   if (packet.type() == PacketType::REQUEST) {
-    const internal::CallContext context(
-        *this, packet.channel_id(), *service, *method, packet.call_id());
+    const internal::CallContext context(*this,
+                                        packet.channel_id(),
+                                        *service,
+                                        *method,
+                                        packet.call_id(),
+                                        packet.credits());
+    PW_RPC_TRACE_START("Invoke", packet.call_id());
     method->Invoke(context, packet);
+    PW_RPC_TRACE_END("Invoke", packet.call_id());
     return OkStatus();
   }
 
-  IntrusiveList<internal::Call>::iterator call = FindCall(packet);
+  internal::Call* call = FindCall(packet);
 
   switch (packet.type()) {
     case PacketType::CLIENT_STREAM:
       HandleClientStreamPacket(packet, *channel, call);
       break;
     case PacketType::CLIENT_ERROR:
-      if (call != calls_end()) {
+      if (call != nullptr) {
         call->HandleError(packet.status());
       } else {
-        internal::rpc_lock().unlock();
+        UnlockRpc();
       }
       break;
     case PacketType::CLIENT_REQUEST_COMPLETION:
       HandleCompletionRequest(packet, *channel, call);
       break;
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+    case PacketType::CLIENT_CREDIT:
+      if (call != nullptr) {
+        static_cast<internal::ServerCall&>(*call).HandleStreamCredits(
+            packet.credits());
+      } else {
+        UnlockRpc();
+      }
+      break;
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
     case PacketType::REQUEST:  // Handled above
     case PacketType::RESPONSE:
     case PacketType::SERVER_ERROR:
     case PacketType::SERVER_STREAM:
     default:
-      internal::rpc_lock().unlock();
+      UnlockRpc();
       PW_LOG_WARN("pw_rpc server unable to handle packet of type %u",
                   unsigned(packet.type()));
   }
@@ -110,31 +138,84 @@ Status Server::ProcessPacket(ConstByteSpan packet_data) {
 
 std::tuple<Service*, const internal::Method*> Server::FindMethod(
     uint32_t service_id, uint32_t method_id) {
-  internal::RpcLockGuard lock;
+  internal::RpcLockGuard lock(*this);
   return FindMethodLocked(service_id, method_id);
 }
 
 std::tuple<Service*, const internal::Method*> Server::FindMethodLocked(
     uint32_t service_id, uint32_t method_id) {
+  Service* service = FindServiceLocked(service_id);
+
+  if (service == nullptr) {
+    return {};
+  }
+
+  return {service, service->FindMethod(method_id)};
+}
+
+Service* Server::FindServiceLocked(uint32_t service_id) {
+#if PW_RPC_SERVICE_INDEX_SIZE > 0
+  const auto indexed_end = service_index_.begin() + indexed_services_;
+  const auto indexed = std::lower_bound(
+      service_index_.begin(), indexed_end, service_id, ServiceIdLess);
+  if (indexed != indexed_end && (*indexed)->id_ == service_id) {
+    return *indexed;
+  }
+  if (unindexed_services_ == 0u) {
+    return nullptr;
+  }
+#endif  // PW_RPC_SERVICE_INDEX_SIZE > 0
+
   auto service = std::find_if(services_.begin(), services_.end(), [&](auto& s) {
     return internal::UnwrapServiceId(s.service_id()) == service_id;
   });
+  return service == services_.end() ? nullptr : &(*service);
+}
 
-  if (service == services_.end()) {
-    return {};
+#if PW_RPC_SERVICE_INDEX_SIZE > 0
+
+void Server::AddToServiceIndex(Service& service) {
+  if (indexed_services_ == service_index_.size()) {
+    unindexed_services_ += 1;
+    return;
   }
 
-  return {&(*service), service->FindMethod(method_id)};
+  // Insert the service before any services with the same ID, so that the most
+  // recently registered service is found first, as in services_.
+  const auto indexed_end = service_index_.begin() + indexed_services_;
+  const auto position = std::lower_bound(
+      service_index_.begin(), indexed_end, service.id_, ServiceIdLess);
+  std::move_backward(position, indexed_end, indexed_end + 1);
+  *position = &service;
+  indexed_services_ += 1;
 }
 
+void Server::RemoveFromServiceIndex(const Service& service) {
+  const auto indexed_end = service_index_.begin() + indexed_services_;
+  const auto position =
+      std::find(service_index_.begin(), indexed_end, &service);
+  if (position == indexed_end) {
+    unindexed_services_ -= 1;
+    return;
+  }
+
+  std::move(position + 1, indexed_end, position);
+  indexed_services_ -= 1;
+  service_index_[indexed_services_] = nullptr;
+}
+
+#endif  // PW_RPC_SERVICE_INDEX_SIZE > 0
+
 void Server::HandleCompletionRequest(
     const internal::Packet& packet,
     internal::Channel& channel,
-    IntrusiveList<internal::Call>::iterator call) const {
-  if (call == calls_end()) {
-    channel.Send(Packet::ServerError(packet, Status::FailedPrecondition()))
+    internal::Call* call) const {
+  if (call == nullptr) {
+    channel
+        .Send(lock_shard(),
+              Packet::ServerError(packet, Status::FailedPrecondition()))
         .IgnoreError();  // Errors are logged in Channel::Send.
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_DEBUG(
         "Received a request completion packet for %u:%08x/%08x, which is not a"
         "pending call",
@@ -145,7 +226,7 @@ void Server::HandleCompletionRequest(
   }
 
   if (call->client_requested_completion()) {
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_DEBUG("Received multiple completion requests for %u:%08x/%08x",
                  static_cast<unsigned>(packet.channel_id()),
                  static_cast<unsigned>(packet.service_id()),
@@ -159,11 +240,13 @@ void Server::HandleCompletionRequest(
 void Server::HandleClientStreamPacket(
     const internal::Packet& packet,
     internal::Channel& channel,
-    IntrusiveList<internal::Call>::iterator call) const {
-  if (call == calls_end()) {
-    channel.Send(Packet::ServerError(packet, Status::FailedPrecondition()))
+    internal::Call* call) const {
+  if (call == nullptr) {
+    channel
+        .Send(lock_shard(),
+              Packet::ServerError(packet, Status::FailedPrecondition()))
         .IgnoreError();  // Errors are logged in Channel::Send.
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_DEBUG(
         "Received client stream packet for %u:%08x/%08x, which is not pending",
         static_cast<unsigned>(packet.channel_id()),
@@ -173,9 +256,11 @@ void Server::HandleClientStreamPacket(
   }
 
   if (!call->has_client_stream()) {
-    channel.Send(Packet::ServerError(packet, Status::InvalidArgument()))
+    channel
+        .Send(lock_shard(),
+              Packet::ServerError(packet, Status::InvalidArgument()))
         .IgnoreError();  // Errors are logged in Channel::Send.
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_DEBUG(
         "Received client stream packet for %u:%08x/%08x, which doesn't have a "
         "client stream",
@@ -186,9 +271,11 @@ void Server::HandleClientStreamPacket(
   }
 
   if (call->client_requested_completion()) {
-    channel.Send(Packet::ServerError(packet, Status::FailedPrecondition()))
+    channel
+        .Send(lock_shard(),
+              Packet::ServerError(packet, Status::FailedPrecondition()))
         .IgnoreError();  // Errors are logged in Channel::Send.
-    internal::rpc_lock().unlock();
+    UnlockRpc();
     PW_LOG_DEBUG(
         "Received client stream packet for %u:%08x/%08x, but its client stream "
         "is closed",
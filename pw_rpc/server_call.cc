@@ -30,6 +30,37 @@ void ServerCall::MoveServerCallFrom(ServerCall& other) {
   on_client_requested_completion_ =
       std::move(other.on_client_requested_completion_);
 #endif  // PW_RPC_COMPLETION_REQUEST_CALLBACK
+
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  on_ready_to_write_ = std::move(other.on_ready_to_write_);
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+}
+
+void ServerCall::HandleStreamCredits([[maybe_unused]] uint32_t credits) {
+#if PW_RPC_SERVER_STREAM_CREDITS > 0
+  if (!AddStreamCredits(credits) || on_ready_to_write_ == nullptr) {
+    UnlockRpc();
+    return;
+  }
+
+  const uint32_t original_id = id();
+  auto on_ready_to_write_local = std::move(on_ready_to_write_);
+  CallbackStarted();
+  UnlockRpc();
+
+  on_ready_to_write_local();
+
+  LockRpc();
+  CallbackFinished();
+
+  // Restore the original callback if the original call is still active and
+  // the callback has not been replaced.
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  if (active_locked() && id() == original_id && on_ready_to_write_ == nullptr) {
+    on_ready_to_write_ = std::move(on_ready_to_write_local);
+  }
+#endif  // PW_RPC_SERVER_STREAM_CREDITS > 0
+  UnlockRpc();
 }
 
 }  // namespace pw::rpc::internal
@@ -80,6 +80,37 @@ TEST(Service, MultipleMethods_FindMethod_NotPresent) {
   EXPECT_EQ(ServiceTestHelper::FindMethod(service, 999), nullptr);
 }
 
+class SortedTestService : public Service {
+ public:
+  constexpr SortedTestService() : Service(0xabcd, kMethods, kMethodIds) {}
+
+  static constexpr std::array<ServiceTestMethodUnion, 4> kMethods = {
+      ServiceTestMethod(12, 'a'),
+      ServiceTestMethod(345, 'b'),
+      ServiceTestMethod(6789, 'c'),
+      ServiceTestMethod(0xffffffff, 'd'),
+  };
+  static constexpr std::array<uint32_t, 4> kMethodIds = {
+      12, 345, 6789, 0xffffffff};
+};
+
+TEST(Service, SortedMethods_FindMethod_Present) {
+  SortedTestService service;
+  for (size_t i = 0; i < SortedTestService::kMethods.size(); ++i) {
+    const uint32_t id = SortedTestService::kMethodIds[i];
+    EXPECT_EQ(ServiceTestHelper::FindMethod(service, id),
+              &SortedTestService::kMethods[i].method());
+  }
+}
+
+TEST(Service, SortedMethods_FindMethod_NotPresent) {
+  SortedTestService service;
+  EXPECT_EQ(ServiceTestHelper::FindMethod(service, 0), nullptr);
+  EXPECT_EQ(ServiceTestHelper::FindMethod(service, 13), nullptr);
+  EXPECT_EQ(ServiceTestHelper::FindMethod(service, 6790), nullptr);
+  EXPECT_EQ(ServiceTestHelper::FindMethod(service, 0xfffffffe), nullptr);
+}
+
 class EmptyTestService : public Service {
  public:
   constexpr EmptyTestService() : Service(0xabcd, kMethods) {}
@@ -0,0 +1,64 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/internal/synchronous_call_pool.h"
+
+#include <cstdint>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc::internal {
+namespace {
+
+using Pool = SynchronousCallPool<2, 64>;
+
+TEST(SynchronousCallPool, AcquiresEachBlockOnce) {
+  Pool pool;
+  void* first = pool.Acquire(64, alignof(uint32_t));
+  void* second = pool.Acquire(1, 1);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(pool.blocks_in_use(), 2u);
+
+  EXPECT_EQ(pool.Acquire(1, 1), nullptr);
+}
+
+TEST(SynchronousCallPool, ReleasedBlockIsReused) {
+  Pool pool;
+  void* first = pool.Acquire(16, 1);
+  ASSERT_NE(pool.Acquire(16, 1), nullptr);
+
+  pool.Release(first);
+  EXPECT_EQ(pool.blocks_in_use(), 1u);
+  EXPECT_EQ(pool.Acquire(16, 1), first);
+}
+
+TEST(SynchronousCallPool, ObjectTooLarge_ReturnsNull) {
+  Pool pool;
+  EXPECT_EQ(pool.Acquire(65, 1), nullptr);
+  EXPECT_EQ(pool.blocks_in_use(), 0u);
+}
+
+TEST(SynchronousCallPool, BlocksAreAligned) {
+  Pool pool;
+  void* block = pool.Acquire(8, alignof(std::max_align_t));
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t),
+            0u);
+  EXPECT_EQ(pool.Acquire(8, 2 * alignof(std::max_align_t)), nullptr);
+}
+
+}  // namespace
+}  // namespace pw::rpc::internal
@@ -0,0 +1,220 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc_transport/async_frame_sender.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "pw_bytes/span.h"
+#include "pw_rpc_transport/rpc_transport.h"
+#include "pw_status/status.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+constexpr size_t kMtu = 16;
+constexpr size_t kQueueSize = 40;
+
+// A transport that records every write and notifies the test once it has
+// received an expected number of bytes.
+class RecordingTransport : public RpcFrameSender {
+ public:
+  size_t MaximumTransmissionUnit() const override { return kMtu; }
+
+  Status Send(RpcFrame frame) override {
+    std::lock_guard lock(mutex_);
+    std::vector<std::byte>& write = writes_.emplace_back();
+    write.insert(write.end(), frame.header.begin(), frame.header.end());
+    write.insert(write.end(), frame.payload.begin(), frame.payload.end());
+    received_ += write.size();
+    if (expected_ != 0 && received_ >= expected_) {
+      expected_ = 0;
+      done_.release();
+    }
+    return OkStatus();
+  }
+
+  // Blocks until at least `bytes` bytes have been received in total.
+  void WaitForBytes(size_t bytes) {
+    {
+      std::lock_guard lock(mutex_);
+      if (received_ >= bytes) {
+        return;
+      }
+      expected_ = bytes;
+    }
+    done_.acquire();
+  }
+
+  std::vector<std::vector<std::byte>> writes() {
+    std::lock_guard lock(mutex_);
+    return writes_;
+  }
+
+  std::vector<std::byte> received() {
+    std::lock_guard lock(mutex_);
+    std::vector<std::byte> data;
+    for (const std::vector<std::byte>& write : writes_) {
+      data.insert(data.end(), write.begin(), write.end());
+    }
+    return data;
+  }
+
+ private:
+  sync::Mutex mutex_;
+  std::vector<std::vector<std::byte>> writes_;
+  size_t received_ = 0;
+  size_t expected_ = 0;
+  sync::ThreadNotification done_;
+};
+
+std::array<std::byte, kMtu> MakeFrame(uint8_t value) {
+  std::array<std::byte, kMtu> frame;
+  std::fill(frame.begin(), frame.end(), std::byte{value});
+  return frame;
+}
+
+TEST(AsyncRpcFrameSender, MtuIsLimitedByQueueSize) {
+  RecordingTransport transport;
+  AsyncRpcFrameSender<kQueueSize> sender(transport);
+  EXPECT_EQ(sender.MaximumTransmissionUnit(), kMtu);
+
+  AsyncRpcFrameSender<kMtu / 2> small_sender(transport);
+  EXPECT_EQ(small_sender.MaximumTransmissionUnit(), kMtu / 2);
+}
+
+TEST(AsyncRpcFrameSender, CoalescesQueuedFramesIntoMtuSizedWrites) {
+  RecordingTransport transport;
+  AsyncRpcFrameSender<kQueueSize> sender(transport);
+
+  // Queue small frames before the transport thread starts so that they are
+  // all waiting when it runs.
+  std::vector<std::byte> expected;
+  for (uint8_t i = 0; i < 6; ++i) {
+    const std::array<std::byte, 2> header = {std::byte{0x7e}, std::byte{i}};
+    const std::array<std::byte, 3> payload = {
+        std::byte{i}, std::byte{i}, std::byte{i}};
+    ASSERT_EQ(sender.Send(RpcFrame{header, payload}), OkStatus());
+    expected.insert(expected.end(), header.begin(), header.end());
+    expected.insert(expected.end(), payload.begin(), payload.end());
+  }
+  EXPECT_EQ(sender.queued_bytes(), expected.size());
+
+  auto transport_thread = thread::Thread(thread::stl::Options(), sender);
+  transport.WaitForBytes(expected.size());
+  sender.Stop();
+  transport_thread.join();
+
+  EXPECT_EQ(transport.received(), expected);
+  const auto writes = transport.writes();
+  ASSERT_EQ(writes.size(), 2u);
+  EXPECT_EQ(writes[0].size(), kMtu);
+  EXPECT_EQ(writes[1].size(), expected.size() - kMtu);
+  EXPECT_EQ(sender.num_writes(), 2u);
+  EXPECT_EQ(sender.num_write_errors(), 0u);
+}
+
+TEST(AsyncRpcFrameSender, FullQueueBlocksUntilThereIsSpace) {
+  RecordingTransport transport;
+  AsyncRpcFrameSender<kQueueSize> sender(transport);
+
+  // Fill the queue as far as whole frames allow.
+  std::vector<std::byte> expected;
+  for (uint8_t i = 0; i < kQueueSize / kMtu; ++i) {
+    const auto frame = MakeFrame(i);
+    ASSERT_EQ(sender.Send(RpcFrame{{}, frame}), OkStatus());
+    expected.insert(expected.end(), frame.begin(), frame.end());
+  }
+
+  // Sending another frame waits for the transport thread, and wraps around
+  // the end of the queue.
+  struct Producer {
+    AsyncRpcFrameSender<kQueueSize>& sender;
+    std::array<std::byte, kMtu> frame = MakeFrame(0xaa);
+    Status status = Status::Unknown();
+  } producer{sender};
+  auto producer_thread = thread::Thread(
+      thread::stl::Options(),
+      [](void* arg) {
+        auto& p = *static_cast<Producer*>(arg);
+        p.status = p.sender.Send(RpcFrame{{}, p.frame});
+      },
+      &producer);
+  expected.insert(expected.end(), producer.frame.begin(), producer.frame.end());
+
+  auto transport_thread = thread::Thread(thread::stl::Options(), sender);
+  producer_thread.join();
+  EXPECT_EQ(producer.status, OkStatus());
+
+  transport.WaitForBytes(expected.size());
+  sender.Stop();
+  transport_thread.join();
+
+  EXPECT_EQ(transport.received(), expected);
+  for (const auto& write : transport.writes()) {
+    EXPECT_LE(write.size(), kMtu);
+  }
+}
+
+TEST(AsyncRpcFrameSender, FrameLargerThanMtuIsRejected) {
+  RecordingTransport transport;
+  AsyncRpcFrameSender<kQueueSize> sender(transport);
+  std::array<std::byte, kMtu + 1> frame{};
+  EXPECT_EQ(sender.Send(RpcFrame{{}, frame}), Status::InvalidArgument());
+  EXPECT_EQ(sender.queued_bytes(), 0u);
+}
+
+TEST(AsyncRpcFrameSender, SendFailsAfterStop) {
+  RecordingTransport transport;
+  AsyncRpcFrameSender<kQueueSize> sender(transport);
+  sender.Stop();
+  const auto frame = MakeFrame(1);
+  EXPECT_EQ(sender.Send(RpcFrame{{}, frame}), Status::FailedPrecondition());
+}
+
+TEST(AsyncRpcFrameSender, StopUnblocksWaitingSender) {
+  RecordingTransport transport;
+  AsyncRpcFrameSender<kMtu> sender(transport);
+  const auto frame = MakeFrame(1);
+  ASSERT_EQ(sender.Send(RpcFrame{{}, frame}), OkStatus());
+
+  struct Producer {
+    AsyncRpcFrameSender<kMtu>& sender;
+    std::array<std::byte, kMtu> frame = MakeFrame(2);
+    Status status = Status::Unknown();
+  } producer{sender};
+  auto producer_thread = thread::Thread(
+      thread::stl::Options(),
+      [](void* arg) {
+        auto& p = *static_cast<Producer*>(arg);
+        p.status = p.sender.Send(RpcFrame{{}, p.frame});
+      },
+      &producer);
+
+  sender.Stop();
+  producer_thread.join();
+  EXPECT_EQ(producer.status, Status::FailedPrecondition());
+}
+
+}  // namespace
+}  // namespace pw::rpc
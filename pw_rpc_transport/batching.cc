@@ -0,0 +1,33 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc_transport/batching.h"
+
+namespace pw::rpc::internal {
+
+Status ForEachBatchedPacket(ConstByteSpan batch,
+                            const OnRpcPacketDecodedCallback& callback) {
+  while (!batch.empty()) {
+    uint64_t packet_size;
+    const size_t prefix_size = varint::Decode(batch, &packet_size);
+    if (prefix_size == 0 || packet_size > batch.size() - prefix_size) {
+      return Status::DataLoss();
+    }
+    callback(batch.subspan(prefix_size, static_cast<size_t>(packet_size)));
+    batch = batch.subspan(prefix_size + static_cast<size_t>(packet_size));
+  }
+  return OkStatus();
+}
+
+}  // namespace pw::rpc::internal
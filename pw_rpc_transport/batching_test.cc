@@ -0,0 +1,207 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc_transport/batching.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "pw_bytes/span.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc_transport/rpc_transport.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+constexpr size_t kMaxBatchSize = 64;
+
+// An egress handler that stores a copy of every packet it is sent.
+class RecordingEgress : public RpcEgressHandler {
+ public:
+  Status SendRpcPacket(ConstByteSpan rpc_packet) override {
+    packets_.emplace_back(rpc_packet.begin(), rpc_packet.end());
+    return status_;
+  }
+
+  const std::vector<std::vector<std::byte>>& packets() const {
+    return packets_;
+  }
+
+  void set_status(Status status) { status_ = status; }
+
+ private:
+  std::vector<std::vector<std::byte>> packets_;
+  Status status_;
+};
+
+// A transport that stores all sent frames so that they can be passed to an
+// ingress later.
+class TestTransport : public RpcFrameSender {
+ public:
+  size_t MaximumTransmissionUnit() const override { return 256; }
+
+  Status Send(RpcFrame frame) override {
+    buffer_.insert(buffer_.end(), frame.header.begin(), frame.header.end());
+    buffer_.insert(buffer_.end(), frame.payload.begin(), frame.payload.end());
+    return OkStatus();
+  }
+
+  ConstByteSpan buffer() const { return buffer_; }
+
+ private:
+  std::vector<std::byte> buffer_;
+};
+
+ConstByteSpan Encode(const internal::Packet& packet, ByteSpan buffer) {
+  Result<ConstByteSpan> result = packet.Encode(buffer);
+  EXPECT_EQ(result.status(), OkStatus());
+  return result.value_or(ConstByteSpan());
+}
+
+TEST(BatchingRpcEgress, HoldsPacketsUntilFlushed) {
+  RecordingEgress egress;
+  BatchingRpcEgress<kMaxBatchSize> batching("batching", egress);
+
+  constexpr std::array<std::byte, 3> kPacket1 = {
+      std::byte{1}, std::byte{2}, std::byte{3}};
+  constexpr std::array<std::byte, 2> kPacket2 = {std::byte{4}, std::byte{5}};
+
+  EXPECT_EQ(batching.SendRpcPacket(kPacket1), OkStatus());
+  EXPECT_EQ(batching.SendRpcPacket(kPacket2), OkStatus());
+  EXPECT_EQ(batching.pending_packets(), 2u);
+  EXPECT_TRUE(egress.packets().empty());
+
+  EXPECT_EQ(batching.Flush(), OkStatus());
+  EXPECT_EQ(batching.pending_packets(), 0u);
+  ASSERT_EQ(egress.packets().size(), 1u);
+
+  const std::vector<std::byte> kExpected = {std::byte{3},
+                                            std::byte{1},
+                                            std::byte{2},
+                                            std::byte{3},
+                                            std::byte{2},
+                                            std::byte{4},
+                                            std::byte{5}};
+  EXPECT_EQ(egress.packets()[0], kExpected);
+
+  // Flushing an empty batch sends nothing.
+  EXPECT_EQ(batching.Flush(), OkStatus());
+  EXPECT_EQ(egress.packets().size(), 1u);
+}
+
+TEST(BatchingRpcEgress, FlushesAtThreshold) {
+  RecordingEgress egress;
+  BatchingRpcEgress<kMaxBatchSize> batching("batching", egress, 10);
+
+  constexpr std::array<std::byte, 4> kPacket = {};
+  EXPECT_EQ(batching.SendRpcPacket(kPacket), OkStatus());
+  EXPECT_TRUE(egress.packets().empty());
+  EXPECT_EQ(batching.SendRpcPacket(kPacket), OkStatus());
+  ASSERT_EQ(egress.packets().size(), 1u);
+  EXPECT_EQ(egress.packets()[0].size(), 10u);
+  EXPECT_EQ(batching.pending_packets(), 0u);
+}
+
+TEST(BatchingRpcEgress, FlushesWhenPacketDoesNotFit) {
+  RecordingEgress egress;
+  BatchingRpcEgress<kMaxBatchSize> batching("batching", egress);
+
+  constexpr std::array<std::byte, 40> kPacket = {};
+  EXPECT_EQ(batching.SendRpcPacket(kPacket), OkStatus());
+  EXPECT_TRUE(egress.packets().empty());
+  EXPECT_EQ(batching.SendRpcPacket(kPacket), OkStatus());
+  ASSERT_EQ(egress.packets().size(), 1u);
+  EXPECT_EQ(egress.packets()[0].size(), 41u);
+  EXPECT_EQ(batching.pending_packets(), 1u);
+}
+
+TEST(BatchingRpcEgress, RejectsOversizedPacket) {
+  RecordingEgress egress;
+  BatchingRpcEgress<kMaxBatchSize> batching("batching", egress);
+  EXPECT_EQ(batching.MaximumTransmissionUnit(), kMaxBatchSize - 1);
+
+  constexpr std::array<std::byte, kMaxBatchSize> kPacket = {};
+  EXPECT_EQ(batching.SendRpcPacket(kPacket), Status::ResourceExhausted());
+  EXPECT_EQ(batching.SendRpcPacket(span(kPacket).first(kMaxBatchSize - 1)),
+            OkStatus());
+  ASSERT_EQ(egress.packets().size(), 1u);
+  EXPECT_EQ(egress.packets()[0].size(), kMaxBatchSize);
+}
+
+TEST(BatchingRpcEgress, DropsBatchOnEgressError) {
+  RecordingEgress egress;
+  egress.set_status(Status::Unavailable());
+  BatchingRpcEgress<kMaxBatchSize> batching("batching", egress);
+
+  constexpr std::array<std::byte, 4> kPacket = {};
+  EXPECT_EQ(batching.SendRpcPacket(kPacket), OkStatus());
+  EXPECT_EQ(batching.Flush(), Status::Unavailable());
+  EXPECT_EQ(batching.pending_packets(), 0u);
+}
+
+TEST(ForEachBatchedPacket, MalformedBatchIsDataLoss) {
+  constexpr std::array<std::byte, 4> kBatch = {
+      std::byte{1}, std::byte{7}, std::byte{5}, std::byte{1}};
+  int packets = 0;
+  EXPECT_EQ(internal::ForEachBatchedPacket(
+                kBatch, [&packets](ConstByteSpan) { packets += 1; }),
+            Status::DataLoss());
+  EXPECT_EQ(packets, 1);
+}
+
+TEST(BatchedRpcIngress, RoutesEveryPacketInBatch) {
+  TestTransport transport;
+  SimpleRpcEgress<256> egress("egress", transport);
+  BatchingRpcEgress<128> batching("batching", egress);
+
+  std::array<std::byte, 32> buffer1;
+  std::array<std::byte, 32> buffer2;
+  const ConstByteSpan packet1 = Encode(
+      internal::Packet(
+          internal::pwpb::PacketType::REQUEST, 1, 42, 100, 0, {}, OkStatus()),
+      buffer1);
+  const ConstByteSpan packet2 = Encode(
+      internal::Packet(
+          internal::pwpb::PacketType::REQUEST, 2, 42, 100, 0, {}, OkStatus()),
+      buffer2);
+  EXPECT_EQ(batching.SendRpcPacket(packet1), OkStatus());
+  EXPECT_EQ(batching.SendRpcPacket(packet2), OkStatus());
+  EXPECT_EQ(batching.SendRpcPacket(packet1), OkStatus());
+  EXPECT_EQ(batching.Flush(), OkStatus());
+
+  RecordingEgress channel1;
+  RecordingEgress channel2;
+  std::array channels = {ChannelEgress(1, channel1),
+                         ChannelEgress(2, channel2)};
+  SimpleBatchedRpcIngress<256> ingress(channels);
+  EXPECT_EQ(ingress.ProcessIncomingData(transport.buffer()), OkStatus());
+
+  ASSERT_EQ(channel1.packets().size(), 2u);
+  ASSERT_EQ(channel2.packets().size(), 1u);
+  EXPECT_TRUE(std::equal(channel1.packets()[0].begin(),
+                         channel1.packets()[0].end(),
+                         packet1.begin(),
+                         packet1.end()));
+  EXPECT_TRUE(std::equal(channel2.packets()[0].begin(),
+                         channel2.packets()[0].end(),
+                         packet2.begin(),
+                         packet2.end()));
+  EXPECT_EQ(ingress.num_bad_packets(), 0u);
+}
+
+}  // namespace
+}  // namespace pw::rpc
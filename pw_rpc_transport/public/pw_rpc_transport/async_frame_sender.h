@@ -0,0 +1,198 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+
+#include "pw_bytes/span.h"
+#include "pw_metric/metric.h"
+#include "pw_rpc_transport/rpc_transport.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread_core.h"
+
+namespace pw::rpc {
+
+// Queues frames for a byte stream transport, such as a SocketRpcTransport, and
+// sends them from a separate thread so that threads sending RPC packets don't
+// wait on a slow transport.
+//
+// Frames are copied into a queue of kQueueSizeBytes bytes. The transport
+// thread sends queued data in writes of up to the transport's MTU, so frames
+// that are queued while a write is in progress are coalesced into the next
+// write. When the queue is full, Send() blocks until the transport thread
+// makes room, which applies backpressure to the senders.
+//
+// Because frames are concatenated and may be split across writes, this is
+// only suitable for transports that deliver a stream of bytes, with framing
+// (e.g. HDLC or simple framing) that lets the receiver find frame boundaries.
+// It must not be used with transports that need each frame in its own write.
+//
+// Run() must be called from a dedicated thread, e.g. by passing the sender to
+// a pw::thread::Thread.
+template <size_t kQueueSizeBytes>
+class AsyncRpcFrameSender : public RpcFrameSender, public thread::ThreadCore {
+ public:
+  explicit AsyncRpcFrameSender(RpcFrameSender& transport)
+      : transport_(transport) {}
+  ~AsyncRpcFrameSender() override { Stop(); }
+
+  // Frames must fit in the transport's MTU and in the queue.
+  size_t MaximumTransmissionUnit() const override {
+    return std::min(transport_.MaximumTransmissionUnit(), kQueueSizeBytes);
+  }
+
+  // Implements RpcFrameSender. Adds the frame to the queue, waiting for space
+  // if the queue is full. Returns INVALID_ARGUMENT if the frame is larger than
+  // the MTU, or FAILED_PRECONDITION if the sender is stopped.
+  Status Send(RpcFrame frame) override;
+
+  // Stops the transport thread and fails any current and future Send() calls.
+  // Frames that have not been sent are dropped.
+  void Stop() {
+    {
+      std::lock_guard lock(mutex_);
+      if (stopped_) {
+        return;
+      }
+      stopped_ = true;
+    }
+    frames_available_.release();
+    space_available_.release();
+  }
+
+  // Returns the number of bytes waiting to be sent.
+  size_t queued_bytes() {
+    std::lock_guard lock(mutex_);
+    return size_;
+  }
+
+  const metric::Group& metrics() const { return metrics_; }
+
+  uint32_t num_writes() const { return writes_.value(); }
+
+  uint32_t num_write_errors() const { return write_errors_.value(); }
+
+ private:
+  void Run() override;
+
+  // Copies data to the back of the queue, which must have room for it.
+  void PushLocked(ConstByteSpan data) PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  RpcFrameSender& transport_;
+
+  // Serializes Send() calls so that only one at a time waits for space.
+  sync::Mutex send_mutex_;
+
+  sync::Mutex mutex_;
+
+  // Queued data is the size_ bytes starting at head_, wrapping around at the
+  // end of queue_. The transport thread reads from the front of the queue
+  // without holding mutex_ while it is being sent; it is only released with
+  // head_ and size_ once the write finishes.
+  std::array<std::byte, kQueueSizeBytes> queue_;
+  size_t head_ PW_GUARDED_BY(mutex_) = 0;
+  size_t size_ PW_GUARDED_BY(mutex_) = 0;
+  bool stopped_ PW_GUARDED_BY(mutex_) = false;
+
+  sync::ThreadNotification frames_available_;
+  sync::ThreadNotification space_available_;
+
+  PW_METRIC_GROUP(metrics_, "async_rpc_frame_sender");
+  PW_METRIC(metrics_, writes_, "writes", 0u);
+  PW_METRIC(metrics_, write_errors_, "write_errors", 0u);
+};
+
+template <size_t kQueueSizeBytes>
+Status AsyncRpcFrameSender<kQueueSizeBytes>::Send(RpcFrame frame) {
+  const size_t frame_size = frame.header.size() + frame.payload.size();
+  if (frame_size > MaximumTransmissionUnit()) {
+    return Status::InvalidArgument();
+  }
+
+  std::lock_guard send_lock(send_mutex_);
+  while (true) {
+    {
+      std::lock_guard lock(mutex_);
+      if (stopped_) {
+        return Status::FailedPrecondition();
+      }
+      if (kQueueSizeBytes - size_ >= frame_size) {
+        PushLocked(frame.header);
+        PushLocked(frame.payload);
+        break;
+      }
+    }
+    // Wait for the transport thread to send some of the queued data.
+    space_available_.acquire();
+  }
+
+  frames_available_.release();
+  return OkStatus();
+}
+
+template <size_t kQueueSizeBytes>
+void AsyncRpcFrameSender<kQueueSizeBytes>::PushLocked(ConstByteSpan data) {
+  size_t tail = (head_ + size_) % kQueueSizeBytes;
+  const size_t first = std::min(data.size(), kQueueSizeBytes - tail);
+  std::memcpy(queue_.data() + tail, data.data(), first);
+  std::memcpy(queue_.data(), data.data() + first, data.size() - first);
+  size_ += data.size();
+}
+
+template <size_t kQueueSizeBytes>
+void AsyncRpcFrameSender<kQueueSizeBytes>::Run() {
+  while (true) {
+    ConstByteSpan data;
+    {
+      std::lock_guard lock(mutex_);
+      if (stopped_) {
+        return;
+      }
+      // Send as much queued data as fits in one write, up to the end of the
+      // queue's storage.
+      data = span(queue_).subspan(
+          head_,
+          std::min({size_,
+                    kQueueSizeBytes - head_,
+                    transport_.MaximumTransmissionUnit()}));
+    }
+
+    if (data.empty()) {
+      // Wait until a sender has queued a frame.
+      frames_available_.acquire();
+      continue;
+    }
+
+    writes_.Increment();
+    if (!transport_.Send(RpcFrame{ConstByteSpan(), data}).ok()) {
+      write_errors_.Increment();
+    }
+
+    {
+      std::lock_guard lock(mutex_);
+      head_ = (head_ + data.size()) % kQueueSizeBytes;
+      size_ -= data.size();
+    }
+    space_available_.release();
+  }
+}
+
+}  // namespace pw::rpc
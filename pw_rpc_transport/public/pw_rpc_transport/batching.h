@@ -0,0 +1,172 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+
+#include "pw_assert/assert.h"
+#include "pw_bytes/span.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc_transport/egress_ingress.h"
+#include "pw_rpc_transport/rpc_transport.h"
+#include "pw_status/status.h"
+#include "pw_status/try.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_varint/varint.h"
+
+namespace pw::rpc {
+
+// Packet batching combines several RPC packets into one batch, which is sent
+// as a single packet by the underlying egress and framed as a single transport
+// frame. A batch is a sequence of RPC packets, each preceded by its length
+// encoded as a varint. Both ends of a link must agree to use batching: batches
+// from a BatchingRpcEgress must be received by an ingress that uses a
+// BatchedRpcPacketDecoder.
+
+namespace internal {
+
+// Calls `callback` for each packet in a batch. Returns DATA_LOSS if the batch
+// is malformed, after calling `callback` for the packets before the error.
+Status ForEachBatchedPacket(ConstByteSpan batch,
+                            const OnRpcPacketDecodedCallback& callback);
+
+}  // namespace internal
+
+// Accumulates outgoing RPC packets into batches of up to kMaxBatchSize bytes
+// and sends each batch to another egress, such as an HdlcRpcEgress.
+//
+// A batch is sent when the next packet does not fit in it, when it reaches
+// `flush_threshold` bytes, or when Flush() is called. Packets are not sent
+// until one of these happens, so latency-sensitive users should call Flush()
+// periodically (e.g. from a timer) or after writing a burst of packets.
+template <size_t kMaxBatchSize>
+class BatchingRpcEgress : public RpcEgressHandler, public ChannelOutput {
+ public:
+  BatchingRpcEgress(std::string_view channel_name,
+                    RpcEgressHandler& egress,
+                    size_t flush_threshold = kMaxBatchSize)
+      : ChannelOutput(channel_name.data()),
+        egress_(egress),
+        flush_threshold_(flush_threshold) {
+    PW_ASSERT(flush_threshold_ <= kMaxBatchSize);
+  }
+
+  // Maximum size of a packet that fits alone in a batch.
+  static constexpr size_t kMaxPacketSize =
+      kMaxBatchSize - varint::EncodedSize(kMaxBatchSize);
+
+  // Implements ChannelOutput. RPC packets must fit in a batch.
+  size_t MaximumTransmissionUnit() override { return kMaxPacketSize; }
+
+  // Implements both rpc::ChannelOutput and RpcEgressHandler. Adds the packet to
+  // the current batch, sending the batch if it is full. Returns
+  // RESOURCE_EXHAUSTED if the packet is larger than kMaxPacketSize, or the
+  // status from the underlying egress if sending a batch failed.
+  Status SendRpcPacket(ConstByteSpan rpc_packet) override {
+    std::lock_guard lock(mutex_);
+    if (rpc_packet.size() > kMaxPacketSize) {
+      return Status::ResourceExhausted();
+    }
+
+    const size_t packet_size =
+        varint::EncodedSize(rpc_packet.size()) + rpc_packet.size();
+    if (size_ + packet_size > kMaxBatchSize) {
+      PW_TRY(FlushLocked());
+    }
+
+    size_ += varint::Encode(rpc_packet.size(), span(batch_).subspan(size_));
+    std::copy(rpc_packet.begin(), rpc_packet.end(), batch_.begin() + size_);
+    size_ += rpc_packet.size();
+    packets_ += 1;
+
+    if (size_ >= flush_threshold_) {
+      return FlushLocked();
+    }
+    return OkStatus();
+  }
+
+  // Implements ChannelOutput.
+  Status Send(ConstByteSpan buffer) override { return SendRpcPacket(buffer); }
+
+  // Sends the current batch, if it contains any packets. The batch is
+  // discarded even if sending it fails.
+  Status Flush() {
+    std::lock_guard lock(mutex_);
+    return FlushLocked();
+  }
+
+  // Returns the number of packets waiting to be sent in the current batch.
+  size_t pending_packets() {
+    std::lock_guard lock(mutex_);
+    return packets_;
+  }
+
+ private:
+  Status FlushLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (packets_ == 0) {
+      return OkStatus();
+    }
+    const Status status = egress_.SendRpcPacket(span(batch_).first(size_));
+    size_ = 0;
+    packets_ = 0;
+    return status;
+  }
+
+  sync::Mutex mutex_;
+  RpcEgressHandler& egress_;
+  const size_t flush_threshold_;
+  std::array<std::byte, kMaxBatchSize> batch_ PW_GUARDED_BY(mutex_);
+  size_t size_ PW_GUARDED_BY(mutex_) = 0;
+  size_t packets_ PW_GUARDED_BY(mutex_) = 0;
+};
+
+// Wraps an RPC packet decoder to split each packet it decodes as a batch of
+// RPC packets. Use with RpcIngress to receive packets from a
+// BatchingRpcEgress. Decode() returns DATA_LOSS if a batch was malformed; the
+// packets before the error in that batch are still processed.
+template <typename Decoder>
+class BatchedRpcPacketDecoder
+    : public RpcPacketDecoder<BatchedRpcPacketDecoder<Decoder>> {
+ public:
+  Status Decode(ConstByteSpan buffer, OnRpcPacketDecodedCallback&& callback) {
+    callback_ = std::move(callback);
+    batch_status_ = OkStatus();
+    const Status status = decoder_.Decode(buffer, [this](ConstByteSpan batch) {
+      batch_status_.Update(internal::ForEachBatchedPacket(batch, callback_));
+    });
+    callback_ = nullptr;
+    PW_TRY(status);
+    return batch_status_;
+  }
+
+ private:
+  Decoder decoder_;
+  OnRpcPacketDecodedCallback callback_;
+  Status batch_status_;
+};
+
+template <size_t kMaxBatchSize>
+using HdlcBatchedRpcIngress =
+    RpcIngress<BatchedRpcPacketDecoder<HdlcRpcPacketDecoder<kMaxBatchSize>>>;
+
+template <size_t kMaxBatchSize>
+using SimpleBatchedRpcIngress =
+    RpcIngress<BatchedRpcPacketDecoder<SimpleRpcPacketDecoder<kMaxBatchSize>>>;
+
+}  // namespace pw::rpc
@@ -0,0 +1,169 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "pw_bytes/span.h"
+#include "pw_snapshot_protos/snapshot.pwpb.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+
+namespace pw::snapshot {
+
+// Encodes a Snapshot proto directly to a sink, such as a
+// pw::blob_store::BlobStore::BlobWriter or a
+// pw::persistent_ram::PersistentBufferWriter, without first building the
+// snapshot in RAM.
+//
+// Top-level fields and large bytes fields are written straight through to the
+// sink. Only submessages (e.g. a single thread or log entry) are buffered, in
+// the caller-provided submessage buffer, since their length must be known
+// before they are written. The RAM needed is therefore bounded by the largest
+// submessage rather than the whole snapshot, which makes the writer suitable
+// for crash handlers.
+//
+//   SnapshotWriter writer(blob_writer, submessage_buffer, copy_buffer);
+//   {
+//     pwpb::Metadata::StreamEncoder metadata =
+//         writer.encoder().GetMetadataEncoder();
+//     metadata.WriteFatal(true).IgnoreError();
+//   }
+//   thread::SnapshotThreads(..., writer.encoder(), ...).IgnoreError();
+//   writer.WriteTraceData(trace_reader, trace_size_bytes).IgnoreError();
+//   return writer.Finish();
+//
+// The number of bytes written so far may be read from other threads, so the
+// snapshot can be streamed out with a SnapshotReader while it is written.
+class SnapshotWriter {
+ public:
+  // submessage_buffer must be large enough for the largest submessage that is
+  // written. copy_buffer is used to move data from readers to the sink in
+  // WriteTraceData() and WriteBytesFromStream(); larger buffers mean fewer,
+  // larger writes.
+  SnapshotWriter(stream::Writer& sink,
+                 ByteSpan submessage_buffer,
+                 ByteSpan copy_buffer)
+      : sink_(sink),
+        encoder_(sink_, submessage_buffer),
+        copy_buffer_(copy_buffer) {}
+
+  SnapshotWriter(const SnapshotWriter&) = delete;
+  SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+  // The encoder for writing fields of the Snapshot. Must not be used after
+  // Finish().
+  pwpb::Snapshot::StreamEncoder& encoder() { return encoder_; }
+
+  // Streams size_bytes of trace data from trace into the trace_data field.
+  Status WriteTraceData(stream::Reader& trace, size_t size_bytes) {
+    return WriteBytesFromStream(
+        static_cast<uint32_t>(pwpb::Snapshot::Fields::kTraceData),
+        trace,
+        size_bytes);
+  }
+
+  // Streams size_bytes from reader into the given bytes field, e.g. a field of
+  // a project-specific snapshot extension. No submessage encoder may be open.
+  Status WriteBytesFromStream(uint32_t field_number,
+                              stream::Reader& reader,
+                              size_t size_bytes);
+
+  // Marks the snapshot as complete. No further fields may be written.
+  //
+  // Returns:
+  //   OK - The snapshot was written successfully.
+  //   FAILED_PRECONDITION - Finish() was already called.
+  //   Other errors encountered while encoding or writing to the sink.
+  Status Finish();
+
+  // The overall status of the snapshot. An error means that the snapshot is
+  // incomplete or corrupt.
+  Status status() const { return encoder_.status(); }
+
+  // The number of bytes written to the sink so far. Safe to call from any
+  // thread.
+  size_t bytes_written() const { return sink_.bytes_written(); }
+
+  // Whether Finish() has been called. Safe to call from any thread.
+  bool finished() const { return finished_.load(std::memory_order_acquire); }
+
+ private:
+  // Forwards writes to the sink and counts the bytes that it accepted.
+  class CountingWriter : public stream::NonSeekableWriter {
+   public:
+    explicit CountingWriter(stream::Writer& sink) : sink_(sink) {}
+
+    size_t bytes_written() const {
+      return bytes_written_.load(std::memory_order_acquire);
+    }
+
+   private:
+    Status DoWrite(ConstByteSpan data) override;
+
+    size_t ConservativeLimit(LimitType type) const override {
+      return type == LimitType::kWrite ? sink_.ConservativeWriteLimit() : 0;
+    }
+
+    stream::Writer& sink_;
+    std::atomic<size_t> bytes_written_{0};
+  };
+
+  CountingWriter sink_;
+  pwpb::Snapshot::StreamEncoder encoder_;
+  const ByteSpan copy_buffer_;
+  std::atomic<bool> finished_{false};
+};
+
+// Reads the portion of a snapshot that a SnapshotWriter has written so far,
+// e.g. to serve it through a pw_transfer handler while it is being captured.
+//
+// storage must read back the bytes that the SnapshotWriter's sink has written,
+// starting at position 0; for example, a stream::MemoryReader over a
+// PersistentBuffer's data. The storage must support reads concurrent with
+// writes if the snapshot is read while it is written.
+//
+// Reads return the available bytes and `OUT_OF_RANGE` once all bytes written so
+// far have been read. If the writer has not finished, more data may become
+// available later, and the reader may be seeked back to Tell() and read again
+// (e.g. by resuming a transfer from its last offset).
+class SnapshotReader : public stream::SeekableReader {
+ public:
+  constexpr SnapshotReader(const SnapshotWriter& writer,
+                           stream::SeekableReader& storage)
+      : writer_(writer), storage_(storage), position_(0) {}
+
+  // True if the writer has finished and every byte has been read.
+  bool done() const {
+    return writer_.finished() && position_ == writer_.bytes_written();
+  }
+
+ private:
+  StatusWithSize DoRead(ByteSpan destination) override;
+
+  Status DoSeek(ptrdiff_t offset, Whence origin) override;
+
+  size_t DoTell() override { return position_; }
+
+  size_t ConservativeLimit(LimitType type) const override {
+    return type == LimitType::kRead ? writer_.bytes_written() - position_ : 0;
+  }
+
+  const SnapshotWriter& writer_;
+  stream::SeekableReader& storage_;
+  size_t position_;
+};
+
+}  // namespace pw::snapshot
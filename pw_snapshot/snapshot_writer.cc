@@ -0,0 +1,85 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_snapshot/snapshot_writer.h"
+
+#include <algorithm>
+
+#include "pw_status/try.h"
+
+namespace pw::snapshot {
+
+Status SnapshotWriter::CountingWriter::DoWrite(ConstByteSpan data) {
+  PW_TRY(sink_.Write(data));
+  bytes_written_.fetch_add(data.size(), std::memory_order_release);
+  return OkStatus();
+}
+
+Status SnapshotWriter::WriteBytesFromStream(uint32_t field_number,
+                                            stream::Reader& reader,
+                                            size_t size_bytes) {
+  if (finished()) {
+    return Status::FailedPrecondition();
+  }
+  return encoder_.WriteBytesFromStream(
+      field_number, reader, size_bytes, copy_buffer_);
+}
+
+Status SnapshotWriter::Finish() {
+  if (finished()) {
+    return Status::FailedPrecondition();
+  }
+  finished_.store(true, std::memory_order_release);
+  return encoder_.status();
+}
+
+StatusWithSize SnapshotReader::DoRead(ByteSpan destination) {
+  const size_t available = writer_.bytes_written() - position_;
+  if (available == 0u) {
+    return StatusWithSize::OutOfRange();
+  }
+  PW_TRY_WITH_SIZE(storage_.Seek(static_cast<ptrdiff_t>(position_)));
+
+  Result<ByteSpan> result =
+      storage_.Read(destination.first(std::min(destination.size(), available)));
+  if (!result.ok()) {
+    return StatusWithSize(result.status(), 0);
+  }
+  position_ += result->size();
+  return StatusWithSize(result->size());
+}
+
+Status SnapshotReader::DoSeek(ptrdiff_t offset, Whence origin) {
+  const size_t end = writer_.bytes_written();
+  ptrdiff_t base = 0;
+  switch (origin) {
+    case kBeginning:
+      base = 0;
+      break;
+    case kCurrent:
+      base = static_cast<ptrdiff_t>(position_);
+      break;
+    case kEnd:
+      base = static_cast<ptrdiff_t>(end);
+      break;
+  }
+  const ptrdiff_t target = base + offset;
+  if (target < 0 || static_cast<size_t>(target) > end) {
+    return Status::OutOfRange();
+  }
+  position_ = static_cast<size_t>(target);
+  return OkStatus();
+}
+
+}  // namespace pw::snapshot
@@ -0,0 +1,156 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_snapshot/snapshot_writer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_bytes/span.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_snapshot_protos/snapshot.pwpb.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::snapshot {
+namespace {
+
+constexpr uint32_t kMetadataField =
+    static_cast<uint32_t>(pwpb::Snapshot::Fields::kMetadata);
+constexpr uint32_t kTraceDataField =
+    static_cast<uint32_t>(pwpb::Snapshot::Fields::kTraceData);
+
+class SnapshotWriterTest : public ::testing::Test {
+ protected:
+  SnapshotWriterTest()
+      : sink_(storage_),
+        writer_(sink_, submessage_buffer_, copy_buffer_),
+        storage_reader_(storage_) {}
+
+  ConstByteSpan written() const { return sink_.WrittenData(); }
+
+  std::array<std::byte, 256> storage_{};
+  std::array<std::byte, 32> submessage_buffer_{};
+  std::array<std::byte, 4> copy_buffer_{};
+  stream::MemoryWriter sink_;
+  SnapshotWriter writer_;
+  stream::MemoryReader storage_reader_;
+};
+
+TEST_F(SnapshotWriterTest, WritesFieldsToSink) {
+  {
+    pwpb::Metadata::StreamEncoder metadata =
+        writer_.encoder().GetMetadataEncoder();
+    ASSERT_EQ(OkStatus(), metadata.WriteFatal(true));
+  }
+  // Nothing of the submessage is written until its encoder is destroyed.
+  EXPECT_EQ(writer_.bytes_written(), written().size());
+  EXPECT_FALSE(writer_.finished());
+
+  std::array<std::byte, 10> trace;
+  for (size_t i = 0; i < trace.size(); ++i) {
+    trace[i] = static_cast<std::byte>(i);
+  }
+  stream::MemoryReader trace_reader(trace);
+  // The trace is larger than the copy buffer, so it is written in pieces.
+  ASSERT_EQ(OkStatus(), writer_.WriteTraceData(trace_reader, trace.size()));
+
+  ASSERT_EQ(OkStatus(), writer_.Finish());
+  EXPECT_TRUE(writer_.finished());
+  EXPECT_EQ(writer_.bytes_written(), written().size());
+
+  protobuf::Decoder decoder(written());
+  ASSERT_EQ(OkStatus(), decoder.Next());
+  EXPECT_EQ(decoder.FieldNumber(), kMetadataField);
+  ASSERT_EQ(OkStatus(), decoder.Next());
+  EXPECT_EQ(decoder.FieldNumber(), kTraceDataField);
+  ConstByteSpan decoded_trace;
+  ASSERT_EQ(OkStatus(), decoder.ReadBytes(&decoded_trace));
+  ASSERT_EQ(decoded_trace.size(), trace.size());
+  EXPECT_EQ(0, std::memcmp(decoded_trace.data(), trace.data(), trace.size()));
+  EXPECT_EQ(Status::OutOfRange(), decoder.Next());
+}
+
+TEST_F(SnapshotWriterTest, FinishTwice) {
+  ASSERT_EQ(OkStatus(), writer_.Finish());
+  EXPECT_EQ(Status::FailedPrecondition(), writer_.Finish());
+
+  stream::MemoryReader empty(ConstByteSpan{});
+  EXPECT_EQ(Status::FailedPrecondition(),
+            writer_.WriteTraceData(empty, 0));
+}
+
+TEST_F(SnapshotWriterTest, TraceReaderTooShort) {
+  constexpr std::array<std::byte, 2> kTrace = {};
+  stream::MemoryReader trace_reader(kTrace);
+  EXPECT_EQ(Status::OutOfRange(), writer_.WriteTraceData(trace_reader, 3));
+}
+
+TEST_F(SnapshotWriterTest, ReaderFollowsWriter) {
+  SnapshotReader reader(writer_, storage_reader_);
+  std::array<std::byte, 64> read_buffer{};
+
+  // Nothing has been written yet.
+  EXPECT_EQ(Status::OutOfRange(), reader.Read(read_buffer).status());
+  EXPECT_FALSE(reader.done());
+
+  constexpr std::array<std::byte, 3> kTrace = {
+      std::byte{1}, std::byte{2}, std::byte{3}};
+  ASSERT_EQ(OkStatus(), writer_.encoder().WriteTraceData(kTrace));
+  const size_t first_size = writer_.bytes_written();
+  EXPECT_EQ(reader.ConservativeReadLimit(), first_size);
+
+  // Reads are limited to what has been written.
+  Result<ByteSpan> first = reader.Read(read_buffer);
+  ASSERT_EQ(OkStatus(), first.status());
+  ASSERT_EQ(first->size(), first_size);
+  EXPECT_EQ(Status::OutOfRange(), reader.Read(read_buffer).status());
+  EXPECT_FALSE(reader.done());
+
+  ASSERT_EQ(OkStatus(), writer_.encoder().WriteTraceData(kTrace));
+  ASSERT_EQ(OkStatus(), writer_.Finish());
+
+  Result<ByteSpan> second = reader.Read(read_buffer);
+  ASSERT_EQ(OkStatus(), second.status());
+  EXPECT_EQ(first_size + second->size(), written().size());
+  EXPECT_TRUE(reader.done());
+  EXPECT_EQ(0,
+            std::memcmp(read_buffer.data(),
+                        written().data() + first_size,
+                        second->size()));
+}
+
+TEST_F(SnapshotWriterTest, ReaderSeek) {
+  constexpr std::array<std::byte, 4> kTrace = {};
+  ASSERT_EQ(OkStatus(), writer_.encoder().WriteTraceData(kTrace));
+  SnapshotReader reader(writer_, storage_reader_);
+
+  // The 7 bytes written may be seeked to, but not past.
+  EXPECT_EQ(Status::OutOfRange(), reader.Seek(8));
+  ASSERT_EQ(OkStatus(), reader.Seek(2));
+  EXPECT_EQ(reader.Tell(), 2u);
+
+  std::array<std::byte, 64> read_buffer{};
+  Result<ByteSpan> result = reader.Read(read_buffer);
+  ASSERT_EQ(OkStatus(), result.status());
+  ASSERT_EQ(result->size(), written().size() - 2);
+  EXPECT_EQ(0, std::memcmp(result->data(), &written()[2], result->size()));
+
+  ASSERT_EQ(OkStatus(), reader.Seek(-1, stream::Stream::kEnd));
+  EXPECT_EQ(reader.Tell(), written().size() - 1);
+}
+
+}  // namespace
+}  // namespace pw::snapshot
@@ -0,0 +1,165 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_software_update/delta_patch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_status/try.h"
+#include "pw_varint/stream.h"
+
+namespace pw::software_update {
+namespace {
+
+enum class CommandKind : uint64_t {
+  kCopy = 0,
+  kInsert = 1,
+};
+
+// Fills all of `dest` from the patch. Running out of patch data is DATA_LOSS.
+Status ReadExact(stream::Reader& reader, ByteSpan dest) {
+  while (!dest.empty()) {
+    Result<ByteSpan> result = reader.Read(dest);
+    if (result.status().IsOutOfRange()) {
+      return Status::DataLoss();
+    }
+    PW_TRY(result.status());
+    dest = dest.subspan(result.value().size());
+  }
+  return OkStatus();
+}
+
+template <typename T>
+Status ReadVarint(stream::Reader& reader, T& value) {
+  StatusWithSize result = varint::Read(reader, &value);
+  if (result.IsOutOfRange()) {
+    return Status::DataLoss();
+  }
+  return result.status();
+}
+
+Result<size_t> ReadSize(stream::Reader& reader) {
+  uint64_t value;
+  PW_TRY(ReadVarint(reader, value));
+  if (value > SIZE_MAX) {
+    return Status::DataLoss();
+  }
+  return static_cast<size_t>(value);
+}
+
+}  // namespace
+
+Result<DeltaPatchHeader> ReadDeltaPatchHeader(stream::Reader& patch) {
+  std::array<std::byte, kDeltaPatchMagic.size()> magic;
+  PW_TRY(ReadExact(patch, magic));
+  if (magic != kDeltaPatchMagic) {
+    return Status::DataLoss();
+  }
+
+  uint64_t version;
+  PW_TRY(ReadVarint(patch, version));
+  if (version != kDeltaPatchVersion) {
+    return Status::Unimplemented();
+  }
+
+  DeltaPatchHeader header;
+  PW_TRY_ASSIGN(header.source_size, ReadSize(patch));
+  PW_TRY_ASSIGN(header.target_size, ReadSize(patch));
+  return header;
+}
+
+StatusWithSize ApplyDeltaPatch(stream::SeekableReader& source,
+                               size_t source_size,
+                               stream::Reader& patch,
+                               stream::Writer& target,
+                               ByteSpan buffer) {
+  if (buffer.empty()) {
+    return StatusWithSize::InvalidArgument();
+  }
+
+  Result<DeltaPatchHeader> header = ReadDeltaPatchHeader(patch);
+  if (!header.ok()) {
+    return StatusWithSize(header.status(), 0);
+  }
+  if (header->source_size != source_size) {
+    return StatusWithSize::FailedPrecondition();
+  }
+
+  size_t written = 0;
+  size_t source_offset = 0;
+  while (written < header->target_size) {
+    uint64_t command;
+    if (Status status = ReadVarint(patch, command); !status.ok()) {
+      return StatusWithSize(status, written);
+    }
+    const CommandKind kind = static_cast<CommandKind>(command & 1);
+    const uint64_t length = command >> 1;
+    if (length > header->target_size - written) {
+      return StatusWithSize(Status::DataLoss(), written);
+    }
+
+    if (kind == CommandKind::kCopy) {
+      int64_t relative_offset;
+      if (Status status = ReadVarint(patch, relative_offset); !status.ok()) {
+        return StatusWithSize(status, written);
+      }
+      // Check the copy's bounds without overflowing.
+      if (relative_offset < 0
+              ? static_cast<uint64_t>(-(relative_offset + 1)) >= source_offset
+              : static_cast<uint64_t>(relative_offset) >
+                    source_size - source_offset) {
+        return StatusWithSize(Status::DataLoss(), written);
+      }
+      source_offset += static_cast<size_t>(relative_offset);
+      if (length > source_size - source_offset) {
+        return StatusWithSize(Status::DataLoss(), written);
+      }
+      if (Status status = source.Seek(static_cast<ptrdiff_t>(source_offset));
+          !status.ok()) {
+        return StatusWithSize(status, written);
+      }
+    }
+
+    for (size_t remaining = static_cast<size_t>(length); remaining > 0;) {
+      const ByteSpan chunk = buffer.first(std::min(remaining, buffer.size()));
+      Status status = kind == CommandKind::kCopy ? ReadExact(source, chunk)
+                                                 : ReadExact(patch, chunk);
+      if (status.ok()) {
+        status = target.Write(chunk);
+      }
+      if (!status.ok()) {
+        return StatusWithSize(status, written);
+      }
+      written += chunk.size();
+      remaining -= chunk.size();
+    }
+
+    if (kind == CommandKind::kCopy) {
+      source_offset += static_cast<size_t>(length);
+    }
+  }
+
+  // The patch must end with the last command.
+  std::byte extra;
+  Result<ByteSpan> trailing = patch.Read(span(&extra, 1));
+  if (trailing.ok() && !trailing->empty()) {
+    return StatusWithSize(Status::DataLoss(), written);
+  }
+
+  return StatusWithSize(written);
+}
+
+}  // namespace pw::software_update
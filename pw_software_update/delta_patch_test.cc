@@ -0,0 +1,225 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_software_update/delta_patch.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "pw_bytes/span.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+#include "pw_varint/varint.h"
+
+namespace pw::software_update {
+namespace {
+
+constexpr std::string_view kSource = "The quick brown fox jumps over the dog.";
+
+// Builds a delta patch one command at a time.
+class PatchBuilder {
+ public:
+  PatchBuilder(size_t source_size,
+               size_t target_size,
+               uint64_t version = kDeltaPatchVersion) {
+    patch_.insert(
+        patch_.end(), kDeltaPatchMagic.begin(), kDeltaPatchMagic.end());
+    AddVarint(version);
+    AddVarint(source_size);
+    AddVarint(target_size);
+  }
+
+  PatchBuilder& Copy(int64_t relative_offset, size_t length) {
+    AddVarint(length << 1);
+    AddVarint(varint::ZigZagEncode(relative_offset));
+    return *this;
+  }
+
+  PatchBuilder& Insert(std::string_view data) {
+    AddVarint(data.size() << 1 | 1);
+    for (char c : data) {
+      patch_.push_back(static_cast<std::byte>(c));
+    }
+    return *this;
+  }
+
+  PatchBuilder& AddVarint(uint64_t value) {
+    std::array<std::byte, varint::kMaxVarint64SizeBytes> encoded;
+    const size_t size = varint::Encode(value, encoded);
+    patch_.insert(patch_.end(), encoded.begin(), encoded.begin() + size);
+    return *this;
+  }
+
+  ConstByteSpan data() const { return patch_; }
+
+ private:
+  std::vector<std::byte> patch_;
+};
+
+class DeltaPatchTest : public ::testing::Test {
+ protected:
+  DeltaPatchTest()
+      : source_(as_bytes(span(kSource))), target_(target_buffer_) {}
+
+  StatusWithSize Apply(const PatchBuilder& patch, size_t buffer_size = 8) {
+    stream::MemoryReader patch_reader(patch.data());
+    std::vector<std::byte> buffer(buffer_size);
+    return ApplyDeltaPatch(
+        source_, kSource.size(), patch_reader, target_, buffer);
+  }
+
+  std::string_view target() const {
+    return std::string_view(reinterpret_cast<const char*>(target_.data()),
+                            target_.bytes_written());
+  }
+
+  stream::MemoryReader source_;
+  std::array<std::byte, 64> target_buffer_ = {};
+  stream::MemoryWriter target_;
+};
+
+constexpr std::string_view kTarget =
+    "The quick red fox jumps over the lazy dog.";
+
+PatchBuilder TargetPatch() {
+  PatchBuilder patch(kSource.size(), kTarget.size());
+  patch.Copy(0, 10)     // "The quick "
+      .Insert("red")    // "red"
+      .Copy(5, 20)      // " fox jumps over the "
+      .Insert("lazy ")  // "lazy "
+      .Copy(0, 4);      // "dog."
+  return patch;
+}
+
+TEST_F(DeltaPatchTest, AppliesCopiesAndInserts) {
+  const StatusWithSize result = Apply(TargetPatch());
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), kTarget.size());
+  EXPECT_EQ(target(), kTarget);
+}
+
+TEST_F(DeltaPatchTest, SmallBufferGivesTheSameResult) {
+  const StatusWithSize result = Apply(TargetPatch(), 1);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(target(), kTarget);
+}
+
+TEST_F(DeltaPatchTest, CopiesFromEarlierInTheSource) {
+  PatchBuilder patch(kSource.size(), 8);
+  patch.Copy(4, 5).Copy(-9, 3);  // "quick" then "The"
+  ASSERT_EQ(Apply(patch).status(), OkStatus());
+  EXPECT_EQ(target(), "quickThe");
+}
+
+TEST_F(DeltaPatchTest, EmptyTarget) {
+  PatchBuilder patch(kSource.size(), 0);
+  const StatusWithSize result = Apply(patch);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), 0u);
+}
+
+TEST_F(DeltaPatchTest, ReadsHeader) {
+  const PatchBuilder patch = TargetPatch();
+  stream::MemoryReader reader(patch.data());
+  const Result<DeltaPatchHeader> header = ReadDeltaPatchHeader(reader);
+  ASSERT_EQ(header.status(), OkStatus());
+  EXPECT_EQ(header->source_size, kSource.size());
+  EXPECT_EQ(header->target_size, kTarget.size());
+}
+
+TEST_F(DeltaPatchTest, EmptyBufferIsInvalid) {
+  EXPECT_EQ(Apply(TargetPatch(), 0).status(), Status::InvalidArgument());
+}
+
+TEST_F(DeltaPatchTest, WrongSourceSizeFails) {
+  PatchBuilder patch(kSource.size() + 1, 1);
+  patch.Copy(0, 1);
+  EXPECT_EQ(Apply(patch).status(), Status::FailedPrecondition());
+  EXPECT_EQ(target_.bytes_written(), 0u);
+}
+
+TEST_F(DeltaPatchTest, BadMagicIsDataLoss) {
+  PatchBuilder patch(kSource.size(), 1);
+  patch.Insert("x");
+  std::vector<std::byte> bad(patch.data().begin(), patch.data().end());
+  bad[0] = std::byte{'X'};
+  stream::MemoryReader patch_reader(bad);
+  std::array<std::byte, 8> buffer;
+  EXPECT_EQ(
+      ApplyDeltaPatch(source_, kSource.size(), patch_reader, target_, buffer)
+          .status(),
+      Status::DataLoss());
+}
+
+TEST_F(DeltaPatchTest, UnsupportedVersionIsUnimplemented) {
+  PatchBuilder patch(kSource.size(), 1, kDeltaPatchVersion + 1);
+  patch.Insert("x");
+  EXPECT_EQ(Apply(patch).status(), Status::Unimplemented());
+}
+
+TEST_F(DeltaPatchTest, CopyPastEndOfSourceIsDataLoss) {
+  PatchBuilder patch(kSource.size(), 8);
+  patch.Copy(kSource.size() - 4, 8);
+  EXPECT_EQ(Apply(patch).status(), Status::DataLoss());
+  EXPECT_EQ(target_.bytes_written(), 0u);
+}
+
+TEST_F(DeltaPatchTest, CopyBeforeStartOfSourceIsDataLoss) {
+  PatchBuilder patch(kSource.size(), 8);
+  patch.Copy(2, 2).Copy(-5, 2);
+  const StatusWithSize result = Apply(patch);
+  EXPECT_EQ(result.status(), Status::DataLoss());
+  EXPECT_EQ(result.size(), 2u);
+}
+
+TEST_F(DeltaPatchTest, CommandLongerThanTargetIsDataLoss) {
+  PatchBuilder patch(kSource.size(), 4);
+  patch.Insert("12345");
+  EXPECT_EQ(Apply(patch).status(), Status::DataLoss());
+  EXPECT_EQ(target_.bytes_written(), 0u);
+}
+
+TEST_F(DeltaPatchTest, TruncatedPatchIsDataLoss) {
+  PatchBuilder patch(kSource.size(), 8);
+  patch.Insert("1234");
+  const StatusWithSize result = Apply(patch);
+  EXPECT_EQ(result.status(), Status::DataLoss());
+  EXPECT_EQ(result.size(), 4u);
+  EXPECT_EQ(target(), "1234");
+}
+
+TEST_F(DeltaPatchTest, TrailingDataIsDataLoss) {
+  PatchBuilder patch(kSource.size(), 4);
+  patch.Insert("1234").Insert("5");
+  EXPECT_EQ(Apply(patch).status(), Status::DataLoss());
+}
+
+TEST_F(DeltaPatchTest, TargetWriteErrorIsReturned) {
+  std::array<std::byte, 4> small_buffer;
+  stream::MemoryWriter small_target(small_buffer);
+  const PatchBuilder patch = TargetPatch();
+  stream::MemoryReader patch_reader(patch.data());
+  std::array<std::byte, 8> buffer;
+  const StatusWithSize result = ApplyDeltaPatch(
+      source_, kSource.size(), patch_reader, small_target, buffer);
+  EXPECT_EQ(result.status(), Status::ResourceExhausted());
+  EXPECT_EQ(result.size(), 0u);
+}
+
+}  // namespace
+}  // namespace pw::software_update
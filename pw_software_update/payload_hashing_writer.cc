@@ -0,0 +1,206 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_software_update/payload_hashing_writer.h"
+
+#include <algorithm>
+
+#include "pw_protobuf/wire_format.h"
+#include "pw_software_update/update_bundle.pwpb.h"
+
+namespace pw::software_update {
+namespace {
+
+constexpr uint32_t kTargetPayloadsField =
+    static_cast<uint32_t>(UpdateBundle::Fields::kTargetPayloads);
+
+// Field number of the value in a map entry message.
+constexpr uint32_t kMapValueField = 2;
+
+// A varint holds at most 64 bits, or 10 bytes of 7 bits each.
+constexpr uint8_t kMaxVarintShift = 63;
+
+}  // namespace
+
+void PayloadHashingWriter::Reset() {
+  num_digests_ = 0;
+  state_ = State::kKey;
+  offset_ = 0;
+  varint_ = 0;
+  varint_shift_ = 0;
+  field_ = 0;
+  remaining_ = 0;
+  in_payload_entry_ = false;
+  entry_end_ = 0;
+  hasher_.reset();
+}
+
+Status PayloadHashingWriter::DoWrite(ConstByteSpan data) {
+  // Only measure bytes once they have been accepted by the output.
+  if (Status status = output_.Write(data); !status.ok()) {
+    return status;
+  }
+
+  while (!data.empty()) {
+    data = data.subspan(Process(data));
+  }
+  return OkStatus();
+}
+
+size_t PayloadHashingWriter::Process(ConstByteSpan data) {
+  size_t used = 1;
+  switch (state_) {
+    case State::kKey:
+      if (in_payload_entry_ && offset_ >= entry_end_) {
+        in_payload_entry_ = false;
+        if (offset_ > entry_end_) {
+          // A field overran the map entry that contains it.
+          state_ = State::kError;
+          used = data.size();
+          break;
+        }
+      }
+      if (ReadVarintByte(data[0])) {
+        HandleKey();
+      }
+      break;
+    case State::kLength:
+      if (ReadVarintByte(data[0])) {
+        HandleLength();
+      }
+      break;
+    case State::kSkipVarint:
+      if (ReadVarintByte(data[0])) {
+        varint_ = 0;
+        state_ = State::kKey;
+      }
+      break;
+    case State::kSkipBytes:
+      used = std::min(remaining_, data.size());
+      remaining_ -= used;
+      if (remaining_ == 0) {
+        state_ = State::kKey;
+      }
+      break;
+    case State::kHashPayload:
+      used = std::min(remaining_, data.size());
+      hasher_->Update(data.first(used));
+      remaining_ -= used;
+      if (remaining_ == 0) {
+        FinishPayload();
+      }
+      break;
+    case State::kError:
+      used = data.size();
+      break;
+  }
+
+  offset_ += used;
+  return used;
+}
+
+bool PayloadHashingWriter::ReadVarintByte(std::byte b) {
+  if (varint_shift_ > kMaxVarintShift) {
+    state_ = State::kError;
+    return false;
+  }
+  varint_ |= static_cast<uint64_t>(b & std::byte{0x7f}) << varint_shift_;
+  if ((b & std::byte{0x80}) != std::byte{0}) {
+    varint_shift_ += 7;
+    return false;
+  }
+  varint_shift_ = 0;
+  return true;
+}
+
+void PayloadHashingWriter::HandleKey() {
+  const uint64_t key = varint_;
+  varint_ = 0;
+  if (!protobuf::FieldKey::IsValidKey(key)) {
+    state_ = State::kError;
+    return;
+  }
+
+  const protobuf::FieldKey field_key(static_cast<uint32_t>(key));
+  field_ = field_key.field_number();
+  switch (field_key.wire_type()) {
+    case protobuf::WireType::kVarint:
+      state_ = State::kSkipVarint;
+      break;
+    case protobuf::WireType::kFixed64:
+      remaining_ = sizeof(uint64_t);
+      state_ = State::kSkipBytes;
+      break;
+    case protobuf::WireType::kFixed32:
+      remaining_ = sizeof(uint32_t);
+      state_ = State::kSkipBytes;
+      break;
+    case protobuf::WireType::kDelimited:
+      state_ = State::kLength;
+      break;
+  }
+}
+
+void PayloadHashingWriter::HandleLength() {
+  const uint64_t length = varint_;
+  varint_ = 0;
+  if (length > SIZE_MAX - (offset_ + 1)) {
+    state_ = State::kError;
+    return;
+  }
+
+  // The current byte is the last byte of the length, so the field's contents
+  // start at the next one.
+  const size_t contents_offset = offset_ + 1;
+  remaining_ = static_cast<size_t>(length);
+
+  if (in_payload_entry_ && contents_offset + remaining_ > entry_end_) {
+    state_ = State::kError;
+    return;
+  }
+
+  if (!in_payload_entry_ && field_ == kTargetPayloadsField) {
+    // Step into the map entry rather than skipping it.
+    in_payload_entry_ = true;
+    entry_end_ = contents_offset + remaining_;
+    state_ = State::kKey;
+    return;
+  }
+
+  if (in_payload_entry_ && field_ == kMapValueField &&
+      num_digests_ < digests_.size()) {
+    current_.offset = contents_offset;
+    current_.size = remaining_;
+    hasher_.emplace();
+    state_ = State::kHashPayload;
+    if (remaining_ == 0) {
+      FinishPayload();
+    }
+    return;
+  }
+
+  state_ = remaining_ == 0 ? State::kKey : State::kSkipBytes;
+}
+
+void PayloadHashingWriter::FinishPayload() {
+  state_ = State::kKey;
+  if (hasher_->Final(current_.sha256).ok()) {
+    digests_[num_digests_] = current_;
+    num_digests_ += 1;
+  }
+  hasher_.reset();
+}
+
+}  // namespace pw::software_update
@@ -0,0 +1,228 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_software_update/payload_hashing_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_crypto/sha256.h"
+#include "pw_protobuf/encoder.h"
+#include "pw_protobuf/message.h"
+#include "pw_software_update/update_bundle.pwpb.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_stream/null_stream.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::software_update {
+namespace {
+
+constexpr uint32_t kTargetsMetadataField =
+    static_cast<uint32_t>(UpdateBundle::Fields::kTargetsMetadata);
+constexpr uint32_t kTargetPayloadsField =
+    static_cast<uint32_t>(UpdateBundle::Fields::kTargetPayloads);
+constexpr uint32_t kRootMetadataField =
+    static_cast<uint32_t>(UpdateBundle::Fields::kRootMetadata);
+
+constexpr std::string_view kPayload1 = "file 1 content";
+constexpr std::string_view kPayload2 = "the content of file 2 is a bit longer";
+
+// Encodes an UpdateBundle-shaped message with two target payloads, surrounded
+// by fields of every wire type that the writer must skip over.
+class TestBundle {
+ public:
+  TestBundle() : encoder_(buffer_) {
+    {
+      auto metadata = encoder_.GetNestedEncoder(kTargetsMetadataField);
+      metadata.WriteString(1, "targets").IgnoreError();
+      metadata.WriteBytes(2, as_bytes(span(kPayload2))).IgnoreError();
+    }
+    AddPayload("file1", kPayload1);
+    encoder_.WriteUint32(99, 123456).IgnoreError();
+    encoder_.WriteFixed32(98, 7).IgnoreError();
+    encoder_.WriteFixed64(97, 8).IgnoreError();
+    {
+      auto entry = encoder_.GetNestedEncoder(kTargetPayloadsField);
+      // Unknown fields within the map entry are skipped too.
+      entry.WriteUint32(3, 300).IgnoreError();
+      entry.WriteString(1, "file2").IgnoreError();
+      entry.WriteFixed64(4, 9).IgnoreError();
+      entry.WriteBytes(2, as_bytes(span(kPayload2))).IgnoreError();
+    }
+    encoder_.WriteBytes(kRootMetadataField, as_bytes(span(kPayload1)))
+        .IgnoreError();
+    PW_ASSERT(encoder_.status().ok());
+  }
+
+  void AddPayload(std::string_view name, std::string_view payload) {
+    auto entry = encoder_.GetNestedEncoder(kTargetPayloadsField);
+    entry.WriteString(1, name).IgnoreError();
+    entry.WriteBytes(2, as_bytes(span(payload))).IgnoreError();
+  }
+
+  ConstByteSpan data() const {
+    return ConstByteSpan(encoder_.data(), encoder_.size());
+  }
+
+ private:
+  std::array<std::byte, 256> buffer_ = {};
+  protobuf::MemoryEncoder encoder_;
+};
+
+// Writes `data` to `writer` in chunks of `chunk_size` bytes.
+void WriteInChunks(stream::Writer& writer,
+                   ConstByteSpan data,
+                   size_t chunk_size) {
+  while (!data.empty()) {
+    const size_t size = std::min(chunk_size, data.size());
+    ASSERT_EQ(writer.Write(data.first(size)), OkStatus());
+    data = data.subspan(size);
+  }
+}
+
+// Expects that `digest` measures the named payload as it is found by the
+// protobuf parser that UpdateBundleAccessor uses.
+void ExpectDigestMatchesPayload(ConstByteSpan bundle,
+                                std::string_view name,
+                                const PayloadDigest& digest) {
+  stream::MemoryReader reader(bundle);
+  protobuf::Message message(reader, bundle.size());
+  stream::IntervalReader payload =
+      message.AsStringToBytesMap(kTargetPayloadsField)[name].GetBytesReader();
+  ASSERT_EQ(payload.status(), OkStatus());
+  EXPECT_EQ(digest.offset, payload.start());
+  EXPECT_EQ(digest.size, payload.interval_size());
+
+  std::array<std::byte, crypto::sha256::kDigestSizeBytes> expected;
+  ASSERT_EQ(crypto::sha256::Hash(payload, expected), OkStatus());
+  EXPECT_EQ(digest.sha256, expected);
+}
+
+TEST(PayloadHashingWriter, HashesEachPayload) {
+  TestBundle bundle;
+  for (size_t chunk_size : {1u, 2u, 3u, 7u, 16u, 256u}) {
+    std::array<std::byte, 256> output_buffer{};
+    stream::MemoryWriter output(output_buffer);
+    std::array<PayloadDigest, 4> digests;
+    PayloadHashingWriter writer(output, digests);
+
+    WriteInChunks(writer, bundle.data(), chunk_size);
+
+    EXPECT_EQ(writer.bytes_written(), bundle.data().size());
+    ASSERT_EQ(output.bytes_written(), bundle.data().size());
+    EXPECT_EQ(std::memcmp(output_buffer.data(),
+                          bundle.data().data(),
+                          bundle.data().size()),
+              0);
+
+    ASSERT_EQ(writer.digests().size(), 2u);
+    ExpectDigestMatchesPayload(bundle.data(), "file1", writer.digests()[0]);
+    ExpectDigestMatchesPayload(bundle.data(), "file2", writer.digests()[1]);
+  }
+}
+
+TEST(PayloadHashingWriter, HashesEmptyPayload) {
+  std::array<std::byte, 64> buffer;
+  protobuf::MemoryEncoder encoder(buffer);
+  {
+    auto entry = encoder.GetNestedEncoder(kTargetPayloadsField);
+    ASSERT_EQ(entry.WriteString(1, "empty"), OkStatus());
+    ASSERT_EQ(entry.WriteBytes(2, ConstByteSpan()), OkStatus());
+  }
+  ASSERT_EQ(encoder.status(), OkStatus());
+  const ConstByteSpan bundle(encoder.data(), encoder.size());
+
+  stream::NullStream output;
+  std::array<PayloadDigest, 1> digests;
+  PayloadHashingWriter writer(output, digests);
+  ASSERT_EQ(writer.Write(bundle), OkStatus());
+
+  ASSERT_EQ(writer.digests().size(), 1u);
+  ExpectDigestMatchesPayload(bundle, "empty", digests[0]);
+}
+
+TEST(PayloadHashingWriter, StopsHashingWhenDigestsAreFull) {
+  TestBundle bundle;
+  stream::NullStream output;
+  std::array<PayloadDigest, 1> digests;
+  PayloadHashingWriter writer(output, digests);
+
+  ASSERT_EQ(writer.Write(bundle.data()), OkStatus());
+  EXPECT_EQ(writer.bytes_written(), bundle.data().size());
+  ASSERT_EQ(writer.digests().size(), 1u);
+  ExpectDigestMatchesPayload(bundle.data(), "file1", writer.digests()[0]);
+}
+
+TEST(PayloadHashingWriter, MalformedBundleIsPassedThrough) {
+  // Wire type 7 is invalid, after which nothing more is parsed.
+  constexpr auto kMalformed = bytes::Array<0x0f, 0x22, 0x02, 0x12, 0x00>();
+  std::array<std::byte, 16> output_buffer{};
+  stream::MemoryWriter output(output_buffer);
+  std::array<PayloadDigest, 1> digests;
+  PayloadHashingWriter writer(output, digests);
+
+  ASSERT_EQ(writer.Write(kMalformed), OkStatus());
+  EXPECT_EQ(output.bytes_written(), kMalformed.size());
+  EXPECT_TRUE(writer.digests().empty());
+}
+
+TEST(PayloadHashingWriter, FieldOverrunningMapEntryStopsHashing) {
+  // A map entry of 3 bytes, whose value claims to be 4 bytes long.
+  constexpr auto kOverrun =
+      bytes::Array<0x22, 0x03, 0x12, 0x04, 'a', 'b', 'c', 'd'>();
+  stream::NullStream output;
+  std::array<PayloadDigest, 1> digests;
+  PayloadHashingWriter writer(output, digests);
+
+  ASSERT_EQ(writer.Write(kOverrun), OkStatus());
+  EXPECT_TRUE(writer.digests().empty());
+}
+
+TEST(PayloadHashingWriter, OutputErrorIsReturned) {
+  TestBundle bundle;
+  std::array<std::byte, 4> output_buffer;
+  stream::MemoryWriter output(output_buffer);
+  std::array<PayloadDigest, 4> digests;
+  PayloadHashingWriter writer(output, digests);
+
+  EXPECT_EQ(writer.Write(bundle.data()), Status::ResourceExhausted());
+  EXPECT_EQ(writer.bytes_written(), 0u);
+  EXPECT_TRUE(writer.digests().empty());
+}
+
+TEST(PayloadHashingWriter, ResetStartsANewBundle) {
+  TestBundle bundle;
+  stream::NullStream output;
+  std::array<PayloadDigest, 4> digests;
+  PayloadHashingWriter writer(output, digests);
+
+  // Abandon a bundle part way through a payload.
+  ASSERT_EQ(writer.Write(bundle.data().first(bundle.data().size() / 2)),
+            OkStatus());
+  writer.Reset();
+  EXPECT_EQ(writer.bytes_written(), 0u);
+  EXPECT_TRUE(writer.digests().empty());
+
+  ASSERT_EQ(writer.Write(bundle.data()), OkStatus());
+  ASSERT_EQ(writer.digests().size(), 2u);
+  ExpectDigestMatchesPayload(bundle.data(), "file1", writer.digests()[0]);
+  ExpectDigestMatchesPayload(bundle.data(), "file2", writer.digests()[1]);
+}
+
+}  // namespace
+}  // namespace pw::software_update
@@ -29,6 +29,9 @@ class BlobStoreOpenableReader final : public OpenableReader {
   Status Close() override { return blob_reader_.Close(); }
   bool IsOpen() override { return blob_reader_.IsOpen(); }
   stream::SeekableReader& reader() override { return blob_reader_; }
+  Result<ConstByteSpan> GetMemoryMappedData() override {
+    return blob_reader_.GetMemoryMappedBlob();
+  }
 
  private:
   blob_store::BlobStore& blob_store_;
@@ -0,0 +1,88 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+
+namespace pw::software_update {
+
+// A delta patch describes a target image in terms of a source image that is
+// already on the device, such as the currently installed firmware, so that
+// only the differences have to be transferred. Patches are generated by
+// `pw_software_update.delta` on the host, and are shipped as regular target
+// payloads; a BundledUpdateBackend that recognizes a target as a patch applies
+// it with `ApplyDeltaPatch()` from `ApplyTargetFile()`.
+//
+// Patch format (all integers are varints):
+//
+//   header:
+//     magic          4 bytes, "PWDP"
+//     version        kDeltaPatchVersion
+//     source_size    size of the source image the patch was made against
+//     target_size    size of the image the patch produces
+//   commands, repeated until target_size bytes are produced:
+//     (length << 1) | kind
+//     kind 0, COPY:   zigzag source offset relative to the end of the previous
+//                     copy, then `length` bytes are copied from the source
+//     kind 1, INSERT: followed by `length` literal bytes
+inline constexpr std::array<std::byte, 4> kDeltaPatchMagic = {
+    std::byte{'P'}, std::byte{'W'}, std::byte{'D'}, std::byte{'P'}};
+inline constexpr uint32_t kDeltaPatchVersion = 1;
+
+struct DeltaPatchHeader {
+  size_t source_size;
+  size_t target_size;
+};
+
+// Reads the header from the start of a patch. Returns:
+//
+//   OK - The patch is positioned at its first command.
+//   DATA_LOSS - The patch is malformed or truncated.
+//   UNIMPLEMENTED - The patch uses an unsupported format version.
+//
+Result<DeltaPatchHeader> ReadDeltaPatchHeader(stream::Reader& patch);
+
+// Applies a delta patch to `source`, writing the resulting image to `target`.
+// Only `buffer` is used to move data, so RAM use is bounded regardless of the
+// image sizes; a larger buffer means fewer, larger reads and writes.
+//
+// The target must not overlap the source, since later commands may copy from
+// parts of the source that have already been overwritten.
+//
+// Returns the number of bytes written to `target`, with one of:
+//
+//   OK - The target image was written in full.
+//   INVALID_ARGUMENT - `buffer` is empty.
+//   FAILED_PRECONDITION - The patch was made against a source of a different
+//       size, so it does not apply to this source.
+//   DATA_LOSS - The patch is malformed, truncated, has trailing data, or
+//       refers to data outside of the source.
+//   UNIMPLEMENTED - The patch uses an unsupported format version.
+//
+// Errors from the streams are returned as is.
+StatusWithSize ApplyDeltaPatch(stream::SeekableReader& source,
+                               size_t source_size,
+                               stream::Reader& patch,
+                               stream::Writer& target,
+                               ByteSpan buffer);
+
+}  // namespace pw::software_update
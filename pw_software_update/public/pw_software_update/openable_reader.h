@@ -13,6 +13,9 @@
 // the License.
 #pragma once
 
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
 #include "pw_stream/stream.h"
 
 namespace pw::software_update {
@@ -29,6 +32,13 @@ class OpenableReader {
   // successful call to Open, before the matching call to Close.
   virtual stream::SeekableReader& reader() = 0;
 
+  // Returns the data behind reader() as a span of memory, so it can be read
+  // without copying it through a buffer. Must only be called while open.
+  // Returns UNIMPLEMENTED if the data is not memory mapped.
+  virtual Result<ConstByteSpan> GetMemoryMappedData() {
+    return Status::Unimplemented();
+  }
+
   virtual ~OpenableReader() = default;
 };
 
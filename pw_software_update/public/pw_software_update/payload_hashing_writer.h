@@ -0,0 +1,116 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_bytes/span.h"
+#include "pw_crypto/sha256.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+
+namespace pw::software_update {
+
+// The SHA256 digest of a target payload, measured while the bundle was being
+// written. `offset` and `size` locate the payload bytes within the bundle.
+struct PayloadDigest {
+  size_t offset;
+  size_t size;
+  std::array<std::byte, crypto::sha256::kDigestSizeBytes> sha256;
+};
+
+// PayloadHashingWriter sits between an incoming update bundle and the writer
+// that stages it (typically a `BlobStore::BlobWriter`). As bytes pass through,
+// it follows the wire format of the `UpdateBundle` message and hashes each
+// `target_payloads` value, so `UpdateBundleAccessor` doesn't have to read the
+// payloads back from storage to measure them. See
+// `UpdateBundleAccessor::SetPrecomputedPayloadDigests()`.
+//
+// Only the framing needed to find the payloads is parsed; everything else is
+// passed through untouched. If the bundle can't be parsed, or there are more
+// payloads than `digests` can hold, the remaining payloads are simply not
+// hashed and are measured from storage during verification instead.
+//
+// The bundle must be written from its first byte, in order.
+class PayloadHashingWriter final : public stream::NonSeekableWriter {
+ public:
+  PayloadHashingWriter(stream::Writer& output, span<PayloadDigest> digests)
+      : output_(output), digests_(digests) {}
+
+  // Returns the digests of the payloads that have been completely written.
+  span<const PayloadDigest> digests() const {
+    return digests_.first(num_digests_);
+  }
+
+  // Returns the number of bundle bytes written so far.
+  size_t bytes_written() const { return offset_; }
+
+  // Forgets all digests and starts over at the beginning of a new bundle.
+  void Reset();
+
+ private:
+  enum class State : uint8_t {
+    kKey,
+    kLength,
+    kSkipVarint,
+    kSkipBytes,
+    kHashPayload,
+    kError,
+  };
+
+  Status DoWrite(ConstByteSpan data) override;
+
+  size_t ConservativeLimit(LimitType limit_type) const override {
+    return limit_type == LimitType::kWrite ? output_.ConservativeWriteLimit()
+                                           : 0;
+  }
+
+  // Consumes bundle bytes from the front of `data`, returning the number used.
+  size_t Process(ConstByteSpan data);
+
+  // Accumulates one byte of a varint. Returns true when the varint is done.
+  bool ReadVarintByte(std::byte b);
+
+  void HandleKey();
+  void HandleLength();
+  void FinishPayload();
+
+  stream::Writer& output_;
+  span<PayloadDigest> digests_;
+  size_t num_digests_ = 0;
+
+  State state_ = State::kKey;
+  size_t offset_ = 0;
+
+  uint64_t varint_ = 0;
+  uint8_t varint_shift_ = 0;
+  uint32_t field_ = 0;
+
+  // Bytes left to skip or hash in the current field.
+  size_t remaining_ = 0;
+
+  // Set while inside a `target_payloads` map entry, which ends at entry_end_.
+  bool in_payload_entry_ = false;
+  size_t entry_end_ = 0;
+
+  std::optional<crypto::sha256::Sha256> hasher_;
+  PayloadDigest current_ = {};
+};
+
+}  // namespace pw::software_update
@@ -23,6 +23,8 @@
 #include "pw_software_update/bundled_update_backend.h"
 #include "pw_software_update/manifest_accessor.h"
 #include "pw_software_update/openable_reader.h"
+#include "pw_software_update/payload_hashing_writer.h"
+#include "pw_span/span.h"
 
 namespace pw::software_update {
 
@@ -108,6 +110,20 @@ class UpdateBundleAccessor {
   // OK - Bundle was successfully opened and verified.
   Status OpenAndVerify();
 
+  // Supplies target payload digests that were measured while the bundle was
+  // being staged, typically by a `PayloadHashingWriter`. During verification,
+  // an in-bundle payload whose location matches one of the digests is checked
+  // against that digest instead of being read back and hashed.
+  //
+  // The digests MUST have been computed over the exact bytes that are staged
+  // in the reader, so that a payload can't change between being measured and
+  // being applied. Signatures and metadata are always verified from the
+  // staged bundle. The digests must outlive verification, and are forgotten
+  // when the bundle is closed.
+  void SetPrecomputedPayloadDigests(span<const PayloadDigest> digests) {
+    precomputed_digests_ = digests;
+  }
+
   // Closes the bundle by invalidating the verification and closing
   // the reader to release the read-only lock
   //
@@ -154,6 +170,7 @@ class UpdateBundleAccessor {
   protobuf::Message trusted_root_;
   bool self_verification_;
   bool bundle_verified_ = false;
+  span<const PayloadDigest> precomputed_digests_;
 
   // Opens the bundle for read-only access and readies the parser.
   Status DoOpen();
@@ -227,7 +244,8 @@ class UpdateBundleAccessor {
                              protobuf::Bytes expected_sha256);
 
   // For a target the payload of which is included in the bundle, verify
-  // it measures up to the expected length and sha256 hash.
+  // it measures up to the expected length and sha256 hash. Uses a precomputed
+  // digest for the payload if there is one.
   Status VerifyInBundleTargetPayload(protobuf::Uint64 expected_length,
                                      protobuf::Bytes expected_sha256,
                                      stream::IntervalReader payload_reader);
@@ -0,0 +1,104 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Unit tests for pw_software_update/delta.py."""
+
+import random
+import unittest
+
+from pw_software_update import delta
+
+
+class DeltaPatchTest(unittest.TestCase):
+    """Tests generating and applying delta patches."""
+
+    def setUp(self):
+        self.rng = random.Random(1234)
+        self.source = bytes(self.rng.getrandbits(8) for _ in range(8192))
+
+    def assert_round_trip(self, source: bytes, target: bytes) -> bytes:
+        patch = delta.make_patch(source, target)
+        self.assertEqual(delta.apply_patch(source, patch), target)
+        return patch
+
+    def test_identical_images(self):
+        patch = self.assert_round_trip(self.source, self.source)
+        self.assertLess(len(patch), 16)
+
+    def test_small_edits_give_a_small_patch(self):
+        target = bytearray(self.source)
+        for offset in (100, 2000, 4096, 8000):
+            target[offset] ^= 0xFF
+        target[5000:5000] = b'inserted bytes'
+        del target[6000:6100]
+        patch = self.assert_round_trip(self.source, bytes(target))
+        self.assertLess(len(patch), len(target) // 20)
+
+    def test_moved_blocks(self):
+        target = self.source[4096:] + self.source[:4096]
+        patch = self.assert_round_trip(self.source, target)
+        self.assertLess(len(patch), 32)
+
+    def test_unrelated_images(self):
+        target = bytes(self.rng.getrandbits(8) for _ in range(1000))
+        patch = self.assert_round_trip(self.source, target)
+        self.assertLess(len(patch), len(target) + 16)
+
+    def test_empty_images(self):
+        self.assert_round_trip(b'', b'')
+        self.assert_round_trip(b'', b'new')
+        self.assert_round_trip(self.source, b'')
+
+    def test_wrong_source_is_rejected(self):
+        patch = delta.make_patch(self.source, self.source)
+        with self.assertRaises(delta.PatchError):
+            delta.apply_patch(self.source[:-1], patch)
+
+    def test_bad_magic_is_rejected(self):
+        patch = delta.make_patch(self.source, self.source)
+        with self.assertRaises(delta.PatchError):
+            delta.apply_patch(self.source, b'XXXX' + patch[4:])
+
+    def test_truncated_patch_is_rejected(self):
+        target = self.source[:100] + b'new data' + self.source[200:]
+        patch = delta.make_patch(self.source, target)
+        with self.assertRaises(delta.PatchError):
+            delta.apply_patch(self.source, patch[:-1])
+
+    def test_trailing_data_is_rejected(self):
+        patch = delta.make_patch(self.source, self.source)
+        with self.assertRaises(delta.PatchError):
+            delta.apply_patch(self.source, patch + b'\0')
+
+    def test_patch_format(self):
+        source = b'The quick brown fox jumps over the dog.'
+        target = b'The quick red fox jumps over the lazy dog.'
+        patch = delta.make_patch(source, target, min_match=4)
+        self.assertEqual(
+            patch,
+            b'PWDP\x01\x27\x2a'
+            # COPY 10 bytes from offset 0.
+            b'\x14\x00'
+            # INSERT "red".
+            b'\x07red'
+            # COPY 20 bytes, skipping "brown".
+            b'\x28\x0a'
+            # INSERT "lazy".
+            b'\x09lazy'
+            # COPY " dog.", starting 1 byte before the end of the last copy.
+            b'\x0a\x01',
+        )
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,213 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Generates and applies delta patches for target payloads.
+
+A delta patch describes a target image in terms of a source image that the
+device already has, e.g. the currently installed firmware, so incremental
+releases only have to transfer what changed. Patches are applied on-device,
+with bounded RAM, by ``pw::software_update::ApplyDeltaPatch()``. See
+``pw_software_update/delta_patch.h`` for the format.
+"""
+
+import argparse
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+MAGIC = b'PWDP'
+VERSION = 1
+
+_COPY = 0
+_INSERT = 1
+
+# Matches shorter than this are sent as literal bytes, since a copy command
+# is not much smaller and short matches are often coincidental.
+DEFAULT_MIN_MATCH = 16
+
+
+class PatchError(Exception):
+    """Raised when a patch is malformed or does not apply to a source."""
+
+
+def _encode_varint(value: int) -> bytes:
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def _zigzag(value: int) -> int:
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+def _unzigzag(value: int) -> int:
+    return (value >> 1) if not value & 1 else -((value + 1) >> 1)
+
+
+def _decode_varint(data: bytes, offset: int) -> Tuple[int, int]:
+    value = 0
+    shift = 0
+    while True:
+        if offset >= len(data) or shift > 63:
+            raise PatchError('Truncated or oversized varint')
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def _index_source(source: bytes, min_match: int) -> Dict[bytes, int]:
+    """Maps each min_match-byte sequence in source to its first offset."""
+    index: Dict[bytes, int] = {}
+    for offset in range(len(source) - min_match + 1):
+        index.setdefault(source[offset : offset + min_match], offset)
+    return index
+
+
+def make_patch(
+    source: bytes, target: bytes, min_match: int = DEFAULT_MIN_MATCH
+) -> bytes:
+    """Creates a patch that turns source into target."""
+    if min_match < 1:
+        raise ValueError('min_match must be at least 1')
+
+    index = _index_source(source, min_match)
+    commands: List[bytes] = []
+    source_offset = 0  # End of the previous copy.
+    literal_start = 0
+    pos = 0
+
+    def flush_literal(end: int) -> None:
+        if end > literal_start:
+            literal = target[literal_start:end]
+            commands.append(_encode_varint(len(literal) << 1 | _INSERT))
+            commands.append(literal)
+
+    while pos + min_match <= len(target):
+        match = index.get(target[pos : pos + min_match])
+        if match is None:
+            pos += 1
+            continue
+
+        # Extend the match forwards, then backwards into pending literals.
+        length = min_match
+        while (
+            pos + length < len(target)
+            and match + length < len(source)
+            and target[pos + length] == source[match + length]
+        ):
+            length += 1
+        while (
+            pos > literal_start
+            and match > 0
+            and target[pos - 1] == source[match - 1]
+        ):
+            pos -= 1
+            match -= 1
+            length += 1
+
+        flush_literal(pos)
+        commands.append(_encode_varint(length << 1 | _COPY))
+        commands.append(_encode_varint(_zigzag(match - source_offset)))
+        source_offset = match + length
+        pos += length
+        literal_start = pos
+
+    flush_literal(len(target))
+
+    header = (
+        MAGIC
+        + _encode_varint(VERSION)
+        + _encode_varint(len(source))
+        + _encode_varint(len(target))
+    )
+    return header + b''.join(commands)
+
+
+def apply_patch(source: bytes, patch: bytes) -> bytes:
+    """Applies a patch to source, returning the target."""
+    if patch[: len(MAGIC)] != MAGIC:
+        raise PatchError('Not a delta patch')
+    offset = len(MAGIC)
+    version, offset = _decode_varint(patch, offset)
+    if version != VERSION:
+        raise PatchError(f'Unsupported patch version {version}')
+    source_size, offset = _decode_varint(patch, offset)
+    target_size, offset = _decode_varint(patch, offset)
+    if source_size != len(source):
+        raise PatchError(
+            f'Patch is for a {source_size} B source, not {len(source)} B'
+        )
+
+    target = bytearray()
+    source_offset = 0
+    while len(target) < target_size:
+        command, offset = _decode_varint(patch, offset)
+        length = command >> 1
+        if len(target) + length > target_size:
+            raise PatchError('Command overruns the target')
+        if (command & 1) == _COPY:
+            relative, offset = _decode_varint(patch, offset)
+            source_offset += _unzigzag(relative)
+            if source_offset < 0 or source_offset + length > len(source):
+                raise PatchError('Copy is outside of the source')
+            target += source[source_offset : source_offset + length]
+            source_offset += length
+        else:
+            if offset + length > len(patch):
+                raise PatchError('Truncated insert')
+            target += patch[offset : offset + length]
+            offset += length
+
+    if offset != len(patch):
+        raise PatchError('Trailing data after the last command')
+    return bytes(target)
+
+
+def _parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        'source', type=Path, help='Image that is installed on the device'
+    )
+    parser.add_argument('target', type=Path, help='Image to update to')
+    parser.add_argument(
+        '--out', type=Path, required=True, help='Where to write the patch'
+    )
+    parser.add_argument(
+        '--min-match',
+        type=int,
+        default=DEFAULT_MIN_MATCH,
+        help='Shortest run of bytes to copy from the source',
+    )
+    return parser.parse_args()
+
+
+def main(source: Path, target: Path, out: Path, min_match: int) -> None:
+    source_data = source.read_bytes()
+    target_data = target.read_bytes()
+    patch = make_patch(source_data, target_data, min_match)
+    out.write_bytes(patch)
+    print(
+        f'Wrote {len(patch)} B patch ({len(target_data)} B target) to {out}'
+    )
+
+
+if __name__ == '__main__':
+    main(**vars(_parse_args()))
@@ -36,7 +36,11 @@
 namespace pw::software_update {
 namespace {
 
-Result<bool> VerifyEcdsaSignature(protobuf::Bytes public_key,
+// Verifies `signature` of `digest` with `public_key`. The same `verifier` is
+// reused for all signatures of a metadata, so that the backend sets up the
+// curve only once.
+Result<bool> VerifyEcdsaSignature(crypto::ecdsa::P256Verifier& verifier,
+                                  protobuf::Bytes public_key,
                                   ConstByteSpan digest,
                                   protobuf::Bytes signature) {
   // TODO: b/237580538 - Move this logic into an variant of the API in
@@ -47,9 +51,10 @@ Result<bool> VerifyEcdsaSignature(protobuf::Bytes public_key,
   stream::IntervalReader sig_reader = signature.GetBytesReader();
   PW_TRY(key_reader.Read(public_key_bytes));
   PW_TRY(sig_reader.Read(signature_bytes));
-  Status status = crypto::ecdsa::VerifyP256Signature(
-      public_key_bytes, digest, signature_bytes);
-  if (!status.ok()) {
+  if (!verifier.SetPublicKey(public_key_bytes).ok()) {
+    return false;
+  }
+  if (!verifier.Verify(digest, signature_bytes).ok()) {
     return false;
   }
 
@@ -94,6 +99,11 @@ Status VerifyMetadataSignatures(protobuf::Bytes message,
   // signatures can be verified using the allowed keys.
   size_t verified_count = 0;
   size_t total_signatures = 0;
+  crypto::ecdsa::P256Verifier verifier;
+  // The digest of `message` is computed once, when the first signature from
+  // an allowed key is checked.
+  std::byte sha256_digest[crypto::sha256::kDigestSizeBytes];
+  bool digest_computed = false;
   for (protobuf::Message signature : signatures) {
     total_signatures++;
     protobuf::Bytes key_id =
@@ -148,10 +158,13 @@ Status VerifyMetadataSignatures(protobuf::Bytes message,
     // by the fact that all trusted roots have undergone content check.
 
     // computes the sha256 hash
-    std::byte sha256_digest[32];
-    stream::IntervalReader bytes_reader = message.GetBytesReader();
-    PW_TRY(crypto::sha256::Hash(bytes_reader, sha256_digest));
-    Result<bool> res = VerifyEcdsaSignature(key_val, sha256_digest, sig);
+    if (!digest_computed) {
+      stream::IntervalReader bytes_reader = message.GetBytesReader();
+      PW_TRY(crypto::sha256::Hash(bytes_reader, sha256_digest));
+      digest_computed = true;
+    }
+    Result<bool> res =
+        VerifyEcdsaSignature(verifier, key_val, sha256_digest, sig);
     PW_TRY(res.status());
     if (res.value()) {
       verified_count++;
@@ -346,6 +359,7 @@ Status UpdateBundleAccessor::PersistManifest() {
 
 Status UpdateBundleAccessor::Close() {
   bundle_verified_ = false;
+  precomputed_digests_ = {};
   return update_reader_.IsOpen() ? update_reader_.Close() : OkStatus();
 }
 
@@ -803,8 +817,35 @@ Status UpdateBundleAccessor::VerifyInBundleTargetPayload(
     return Status::Unauthenticated();
   }
 
+  // Use the digest measured while the bundle was staged, if there is one, to
+  // avoid reading the payload back.
+  const PayloadDigest* precomputed = nullptr;
+  for (const PayloadDigest& digest : precomputed_digests_) {
+    if (digest.offset == payload_reader.start() &&
+        digest.size == payload_reader.interval_size()) {
+      precomputed = &digest;
+      break;
+    }
+  }
+
   std::byte actual_sha256[crypto::sha256::kDigestSizeBytes] = {};
-  PW_TRY(crypto::sha256::Hash(payload_reader, actual_sha256));
+  if (precomputed != nullptr) {
+    std::memcpy(
+        actual_sha256, precomputed->sha256.data(), sizeof(actual_sha256));
+  } else if (Result<ConstByteSpan> bundle_data =
+                 update_reader_.GetMemoryMappedData();
+             bundle_data.ok() &&
+             payload_reader.start() + payload_reader.interval_size() <=
+                 bundle_data->size()) {
+    // Hash the payload in place when the bundle is memory mapped, rather than
+    // copying it out through the reader in small chunks.
+    PW_TRY(crypto::sha256::Hash(
+        bundle_data->subspan(payload_reader.start(),
+                             payload_reader.interval_size()),
+        actual_sha256));
+  } else {
+    PW_TRY(crypto::sha256::Hash(payload_reader, actual_sha256));
+  }
   Result<bool> hash_equal = expected_sha256.Equal(actual_sha256);
   PW_TRY(hash_equal.status());
   if (!hash_equal.value()) {
@@ -19,6 +19,7 @@
 #include "pw_kvs/test_key_value_store.h"
 #include "pw_software_update/blob_store_openable_reader.h"
 #include "pw_software_update/bundled_update_backend.h"
+#include "pw_software_update/payload_hashing_writer.h"
 #include "pw_software_update/update_bundle_accessor.h"
 #include "pw_stream/memory_stream.h"
 #include "pw_unit_test/framework.h"
@@ -26,6 +27,7 @@
 
 #define ASSERT_OK(status) ASSERT_EQ(OkStatus(), status)
 #define ASSERT_FAIL(status) ASSERT_NE(OkStatus(), status)
+#define EXPECT_OK(status) EXPECT_EQ(OkStatus(), status)
 
 namespace pw::software_update {
 namespace {
@@ -159,6 +161,20 @@ class UpdateBundleTest : public testing::Test {
     ASSERT_OK(blob_writer.Close());
   }
 
+  // Stages a bundle through a PayloadHashingWriter, which records the digests
+  // of its payloads in `digests`. Returns the number of digests recorded.
+  size_t StageTestBundleWithDigests(ConstByteSpan bundle_data,
+                                    span<PayloadDigest> digests) {
+    EXPECT_OK(bundle_blob_.Init());
+    blob_store::BlobStore::BlobWriter blob_writer(bundle_blob(),
+                                                  metadata_buffer_);
+    EXPECT_OK(blob_writer.Open());
+    PayloadHashingWriter hashing_writer(blob_writer, digests);
+    EXPECT_OK(hashing_writer.Write(bundle_data));
+    EXPECT_OK(blob_writer.Close());
+    return hashing_writer.digests().size();
+  }
+
   // A helper to verify that all bundle operations are disallowed because
   // the bundle is not open or verified.
   void VerifyAllBundleOperationsDisallowed(
@@ -422,6 +438,48 @@ TEST_F(UpdateBundleTest, OpenAndVerifyFailsOnRootRollback) {
   CheckOpenAndVerifyFail(update_bundle, false);
 }
 
+TEST_F(UpdateBundleTest, OpenAndVerifySucceedsWithPrecomputedDigests) {
+  backend().SetTrustedRoot(kDevSignedRoot);
+  backend().SetCurrentManifest(kTestBundleManifest);
+  std::array<PayloadDigest, 4> digests;
+  const size_t num_digests =
+      StageTestBundleWithDigests(kTestProdBundle, digests);
+  ASSERT_GT(num_digests, 0u);
+  UpdateBundleAccessor update_bundle(blob_reader(), backend());
+  update_bundle.SetPrecomputedPayloadDigests(span(digests).first(num_digests));
+
+  ASSERT_OK(update_bundle.OpenAndVerify());
+  ASSERT_OK(update_bundle.Close());
+}
+
+TEST_F(UpdateBundleTest, OpenAndVerifyUsesPrecomputedDigests) {
+  backend().SetTrustedRoot(kDevSignedRoot);
+  backend().SetCurrentManifest(kTestBundleManifest);
+  std::array<PayloadDigest, 4> digests;
+  const size_t num_digests =
+      StageTestBundleWithDigests(kTestProdBundle, digests);
+  ASSERT_GT(num_digests, 0u);
+
+  // The staged payloads are intact, so verification can only fail if the
+  // (corrupted) precomputed digest is used in place of reading the payload.
+  digests[0].sha256[0] ^= std::byte{0xff};
+  UpdateBundleAccessor update_bundle(blob_reader(), backend());
+  update_bundle.SetPrecomputedPayloadDigests(span(digests).first(num_digests));
+  CheckOpenAndVerifyFail(update_bundle, true);
+}
+
+TEST_F(UpdateBundleTest,
+       OpenAndVerifyFailsOnMismatchedTargetHashWithPrecomputedDigests) {
+  backend().SetTrustedRoot(kDevSignedRoot);
+  backend().SetCurrentManifest(kTestBundleManifest);
+  std::array<PayloadDigest, 4> digests;
+  const size_t num_digests =
+      StageTestBundleWithDigests(kTestBundleMismatchedTargetHashFile0, digests);
+  UpdateBundleAccessor update_bundle(blob_reader(), backend());
+  update_bundle.SetPrecomputedPayloadDigests(span(digests).first(num_digests));
+  CheckOpenAndVerifyFail(update_bundle, true);
+}
+
 TEST_F(UpdateBundleTest, OpenAndVerifyFailsOnMismatchedTargetHashFile0) {
   backend().SetTrustedRoot(kDevSignedRoot);
   backend().SetCurrentManifest(kTestBundleManifest);
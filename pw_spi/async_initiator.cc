@@ -0,0 +1,143 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_spi/async_initiator.h"
+
+#include <mutex>
+#include <utility>
+
+#include "pw_assert/check.h"
+
+namespace pw::spi {
+
+AsyncTransaction::~AsyncTransaction() {
+  if (initiator_ != nullptr) {
+    std::lock_guard lock(initiator_->lock_);
+    PW_CHECK(state_ == State::kComplete,
+             "A SPI transaction was destroyed while queued or in progress");
+  }
+}
+
+bool AsyncTransaction::submitted() const { return initiator_ != nullptr; }
+
+async2::Poll<Status> AsyncTransaction::Pend(async2::Context& cx) {
+  if (initiator_ == nullptr) {
+    return async2::Ready(Status::FailedPrecondition());
+  }
+  std::lock_guard lock(initiator_->lock_);
+  if (state_ != State::kComplete) {
+    waker_ = cx.GetWaker(async2::WaitReason::Unspecified());
+    return async2::Pending();
+  }
+  state_ = State::kIdle;
+  initiator_ = nullptr;
+  return result_;
+}
+
+Status AsyncInitiator::Submit(AsyncTransaction& transaction) {
+  if (transaction.write_buffer().empty() && transaction.read_buffer().empty()) {
+    return Status::InvalidArgument();
+  }
+  if (transaction.submitted()) {
+    return Status::FailedPrecondition();
+  }
+
+  std::lock_guard lock(lock_);
+  transaction.initiator_ = this;
+  transaction.state_ = AsyncTransaction::State::kQueued;
+  queue_.push_back(transaction);
+  if (active_ == nullptr) {
+    StartNext();
+  }
+  return OkStatus();
+}
+
+Status AsyncInitiator::Cancel(AsyncTransaction& transaction) {
+  std::lock_guard lock(lock_);
+  if (transaction.initiator_ != this) {
+    return Status::FailedPrecondition();
+  }
+  switch (transaction.state_) {
+    case AsyncTransaction::State::kQueued:
+      queue_.remove(transaction);
+      Complete(transaction, Status::Cancelled());
+      return OkStatus();
+    case AsyncTransaction::State::kActive:
+      if (!DoAbortTransaction()) {
+        return Status::Unimplemented();
+      }
+      CompleteActive(Status::Cancelled());
+      return OkStatus();
+    case AsyncTransaction::State::kIdle:
+    case AsyncTransaction::State::kComplete:
+      break;
+  }
+  return Status::FailedPrecondition();
+}
+
+void AsyncInitiator::TransactionComplete(Status status) {
+  std::lock_guard lock(lock_);
+  CompleteActive(status);
+}
+
+void AsyncInitiator::CompleteActive(Status status) {
+  AsyncTransaction* done = active_;
+  PW_CHECK_NOTNULL(done, "No SPI transaction is in progress");
+  active_ = nullptr;
+
+  // Deselect the responder before the next transaction selects another one.
+  if (ChipSelector* chip_selector = done->chip_selector();
+      chip_selector != nullptr) {
+    const Status deactivate = chip_selector->Deactivate();
+    if (status.ok()) {
+      status = deactivate;
+    }
+  }
+  Complete(*done, status);
+  StartNext();
+}
+
+void AsyncInitiator::StartNext() {
+  while (!queue_.empty()) {
+    AsyncTransaction& next = queue_.front();
+    queue_.pop_front();
+
+    ChipSelector* chip_selector = next.chip_selector();
+    Status status =
+        chip_selector != nullptr ? chip_selector->Activate() : OkStatus();
+    if (status.ok()) {
+      next.state_ = AsyncTransaction::State::kActive;
+      status = DoStartTransaction(next);
+      if (status.ok()) {
+        active_ = &next;
+        return;
+      }
+      if (chip_selector != nullptr) {
+        chip_selector->Deactivate().IgnoreError();
+      }
+    }
+    // The transaction could not be started, so fail it and try the next one.
+    Complete(next, status);
+  }
+}
+
+void AsyncInitiator::Complete(AsyncTransaction& transaction, Status status) {
+  transaction.state_ = AsyncTransaction::State::kComplete;
+  transaction.result_ = status;
+  // The lock is held, so the transaction's task cannot destroy it until the
+  // lock is released.
+  std::move(transaction.waker_).Wake();
+}
+
+}  // namespace pw::spi
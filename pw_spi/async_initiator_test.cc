@@ -0,0 +1,305 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_spi/async_initiator.h"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_bytes/array.h"
+#include "pw_spi/chip_selector_mock.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::spi {
+namespace {
+
+using async2::Context;
+using async2::Dispatcher;
+using async2::Pending;
+using async2::Poll;
+using async2::Ready;
+
+constexpr Config kConfig = {
+    .polarity = ClockPolarity::kActiveHigh,
+    .phase = ClockPhase::kRisingEdge,
+    .bits_per_word = BitsPerWord(8),
+    .bit_order = BitOrder::kMsbFirst,
+};
+
+// Records the started transactions, and completes them when the test calls
+// Finish(), like a driver that completes transfers in an interrupt.
+class FakeAsyncInitiator : public AsyncInitiator {
+ public:
+  const AsyncTransaction* active() const { return active_; }
+
+  int starts() const { return starts_; }
+
+  void set_start_status(Status status) { start_status_ = status; }
+
+  void set_can_abort(bool can_abort) { can_abort_ = can_abort; }
+
+  void Finish(Status status) {
+    ASSERT_NE(active_, nullptr);
+    active_ = nullptr;
+    TransactionComplete(status);
+  }
+
+ private:
+  Status DoStartTransaction(const AsyncTransaction& transaction) override {
+    EXPECT_EQ(active_, nullptr);
+    starts_ += 1;
+    if (start_status_.ok()) {
+      active_ = &transaction;
+    }
+    return start_status_;
+  }
+
+  bool DoAbortTransaction() override {
+    if (!can_abort_) {
+      return false;
+    }
+    active_ = nullptr;
+    return true;
+  }
+
+  const AsyncTransaction* active_ = nullptr;
+  int starts_ = 0;
+  Status start_status_;
+  bool can_abort_ = true;
+};
+
+class FailingChipSelector : public ChipSelector {
+ private:
+  Status SetActive(bool) override { return Status::Unavailable(); }
+};
+
+// Pends a transaction until it completes, and stores the result.
+class PendTransactionTask : public async2::Task {
+ public:
+  explicit PendTransactionTask(AsyncTransaction& transaction)
+      : transaction_(transaction) {}
+
+  const std::optional<Status>& result() const { return result_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    Poll<Status> result = transaction_.Pend(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    result_ = *result;
+    return Ready();
+  }
+
+  AsyncTransaction& transaction_;
+  std::optional<Status> result_;
+};
+
+// Runs a task that pends the transaction until it completes, and returns its
+// result.
+std::optional<Status> PendUntilComplete(Dispatcher& dispatcher,
+                                        AsyncTransaction& transaction) {
+  PendTransactionTask task(transaction);
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion(task);
+  return task.result();
+}
+
+TEST(SpiAsyncInitiator, SubmitSelectsAndStartsTransaction) {
+  FakeAsyncInitiator initiator;
+  MockChipSelector chip_selector;
+  constexpr auto kWrite = bytes::Array<1, 2>();
+  std::array<std::byte, 2> read;
+  AsyncTransaction transaction(kConfig, &chip_selector, kWrite, read);
+
+  EXPECT_FALSE(transaction.submitted());
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+  EXPECT_TRUE(transaction.submitted());
+  EXPECT_TRUE(chip_selector.is_active());
+  ASSERT_EQ(initiator.active(), &transaction);
+  EXPECT_EQ(initiator.active()->config(), kConfig);
+  EXPECT_EQ(initiator.active()->write_buffer().data(), kWrite.data());
+  EXPECT_EQ(initiator.active()->read_buffer().data(), read.data());
+
+  initiator.Finish(OkStatus());
+  EXPECT_FALSE(chip_selector.is_active());
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, transaction), OkStatus());
+  EXPECT_FALSE(transaction.submitted());
+}
+
+TEST(SpiAsyncInitiator, PendReturnsResultWhenComplete) {
+  FakeAsyncInitiator initiator;
+  std::array<std::byte, 1> read;
+  AsyncTransaction transaction(kConfig, nullptr, ConstByteSpan(), read);
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+
+  Dispatcher dispatcher;
+  PendTransactionTask task(transaction);
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsPending());
+  EXPECT_FALSE(task.result().has_value());
+
+  initiator.Finish(Status::DataLoss());
+  EXPECT_TRUE(dispatcher.RunUntilStalled().IsReady());
+  EXPECT_EQ(task.result(), Status::DataLoss());
+}
+
+TEST(SpiAsyncInitiator, SequencesChipSelectors) {
+  FakeAsyncInitiator initiator;
+  MockChipSelector first_selector;
+  MockChipSelector second_selector;
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction first(kConfig, &first_selector, kWrite, ByteSpan());
+  AsyncTransaction second(kConfig, &second_selector, kWrite, ByteSpan());
+  ASSERT_EQ(initiator.Submit(first), OkStatus());
+  ASSERT_EQ(initiator.Submit(second), OkStatus());
+
+  EXPECT_EQ(initiator.active(), &first);
+  EXPECT_TRUE(first_selector.is_active());
+  EXPECT_FALSE(second_selector.is_active());
+
+  initiator.Finish(OkStatus());
+  EXPECT_EQ(initiator.active(), &second);
+  EXPECT_FALSE(first_selector.is_active());
+  EXPECT_TRUE(second_selector.is_active());
+
+  initiator.Finish(OkStatus());
+  EXPECT_FALSE(second_selector.is_active());
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, first), OkStatus());
+  EXPECT_EQ(PendUntilComplete(dispatcher, second), OkStatus());
+}
+
+TEST(SpiAsyncInitiator, StartFailureCompletesTransactionAndStartsNext) {
+  FakeAsyncInitiator initiator;
+  MockChipSelector chip_selector;
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction first(kConfig, &chip_selector, kWrite, ByteSpan());
+  AsyncTransaction second(kConfig, &chip_selector, kWrite, ByteSpan());
+
+  initiator.set_start_status(Status::ResourceExhausted());
+  ASSERT_EQ(initiator.Submit(first), OkStatus());
+  EXPECT_EQ(initiator.active(), nullptr);
+  EXPECT_FALSE(chip_selector.is_active());
+
+  initiator.set_start_status(OkStatus());
+  ASSERT_EQ(initiator.Submit(second), OkStatus());
+  EXPECT_EQ(initiator.active(), &second);
+  initiator.Finish(OkStatus());
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, first), Status::ResourceExhausted());
+  EXPECT_EQ(PendUntilComplete(dispatcher, second), OkStatus());
+}
+
+TEST(SpiAsyncInitiator, ChipSelectorFailureCompletesTransaction) {
+  FakeAsyncInitiator initiator;
+  FailingChipSelector chip_selector;
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction transaction(kConfig, &chip_selector, kWrite, ByteSpan());
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+  EXPECT_EQ(initiator.starts(), 0);
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, transaction), Status::Unavailable());
+}
+
+TEST(SpiAsyncInitiator, SubmitFailsIfAlreadySubmitted) {
+  FakeAsyncInitiator initiator;
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction transaction(kConfig, nullptr, kWrite, ByteSpan());
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+  EXPECT_EQ(initiator.Submit(transaction), Status::FailedPrecondition());
+  initiator.Finish(OkStatus());
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, transaction), OkStatus());
+}
+
+TEST(SpiAsyncInitiator, SubmitFailsWithoutBuffers) {
+  FakeAsyncInitiator initiator;
+  AsyncTransaction transaction(kConfig, nullptr, ConstByteSpan(), ByteSpan());
+  EXPECT_EQ(initiator.Submit(transaction), Status::InvalidArgument());
+  EXPECT_FALSE(transaction.submitted());
+}
+
+TEST(SpiAsyncInitiator, PendWithoutSubmitFails) {
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction transaction(kConfig, nullptr, kWrite, ByteSpan());
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, transaction),
+            Status::FailedPrecondition());
+}
+
+TEST(SpiAsyncInitiator, CancelQueuedTransaction) {
+  FakeAsyncInitiator initiator;
+  MockChipSelector chip_selector;
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction first(kConfig, nullptr, kWrite, ByteSpan());
+  AsyncTransaction second(kConfig, &chip_selector, kWrite, ByteSpan());
+  ASSERT_EQ(initiator.Submit(first), OkStatus());
+  ASSERT_EQ(initiator.Submit(second), OkStatus());
+
+  EXPECT_EQ(initiator.Cancel(second), OkStatus());
+  EXPECT_FALSE(chip_selector.is_active());
+  initiator.Finish(OkStatus());
+  EXPECT_EQ(initiator.active(), nullptr);
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, first), OkStatus());
+  EXPECT_EQ(PendUntilComplete(dispatcher, second), Status::Cancelled());
+}
+
+TEST(SpiAsyncInitiator, CancelActiveTransactionAborts) {
+  FakeAsyncInitiator initiator;
+  MockChipSelector chip_selector;
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction first(kConfig, &chip_selector, kWrite, ByteSpan());
+  AsyncTransaction second(kConfig, nullptr, kWrite, ByteSpan());
+  ASSERT_EQ(initiator.Submit(first), OkStatus());
+  ASSERT_EQ(initiator.Submit(second), OkStatus());
+
+  EXPECT_EQ(initiator.Cancel(first), OkStatus());
+  EXPECT_FALSE(chip_selector.is_active());
+  EXPECT_EQ(initiator.active(), &second);
+  EXPECT_EQ(initiator.Cancel(first), Status::FailedPrecondition());
+  initiator.Finish(OkStatus());
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, first), Status::Cancelled());
+  EXPECT_EQ(PendUntilComplete(dispatcher, second), OkStatus());
+}
+
+TEST(SpiAsyncInitiator, CancelActiveTransactionWithoutAbortRunsToCompletion) {
+  FakeAsyncInitiator initiator;
+  initiator.set_can_abort(false);
+  constexpr auto kWrite = bytes::Array<1>();
+  AsyncTransaction transaction(kConfig, nullptr, kWrite, ByteSpan());
+  ASSERT_EQ(initiator.Submit(transaction), OkStatus());
+
+  EXPECT_EQ(initiator.Cancel(transaction), Status::Unimplemented());
+  EXPECT_EQ(initiator.active(), &transaction);
+  initiator.Finish(OkStatus());
+
+  Dispatcher dispatcher;
+  EXPECT_EQ(PendUntilComplete(dispatcher, transaction), OkStatus());
+}
+
+}  // namespace
+}  // namespace pw::spi
@@ -0,0 +1,83 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_spi/double_buffered_reader.h"
+
+#include "pw_status/try.h"
+
+namespace pw::spi {
+
+Status DoubleBufferedReader::Start() {
+  if (first_.submitted() || second_.submitted() || held_) {
+    return Status::FailedPrecondition();
+  }
+  stopping_ = false;
+  next_is_first_ = true;
+  PW_TRY(initiator_.Submit(first_));
+  return initiator_.Submit(second_);
+}
+
+async2::Poll<Result<ByteSpan>> DoubleBufferedReader::PendRead(
+    async2::Context& cx) {
+  if (held_) {
+    return Status::FailedPrecondition();
+  }
+  AsyncTransaction& read = next();
+  async2::Poll<Status> status = read.Pend(cx);
+  if (status.IsPending()) {
+    return async2::Pending();
+  }
+  held_ = true;
+  if (!status->ok()) {
+    return *status;
+  }
+  return read.read_buffer();
+}
+
+Status DoubleBufferedReader::Release() {
+  if (!held_) {
+    return Status::FailedPrecondition();
+  }
+  held_ = false;
+  AsyncTransaction& read = next();
+  next_is_first_ = !next_is_first_;
+  if (stopping_) {
+    return OkStatus();
+  }
+  return initiator_.Submit(read);
+}
+
+void DoubleBufferedReader::RequestStop() {
+  stopping_ = true;
+  // Cancel the later read first, so that the bus does not start it after the
+  // earlier one is cancelled.
+  AsyncTransaction& later = next_is_first_ ? second_ : first_;
+  initiator_.Cancel(later).IgnoreError();
+  initiator_.Cancel(next()).IgnoreError();
+}
+
+async2::Poll<> DoubleBufferedReader::PendStop(async2::Context& cx) {
+  bool pending = false;
+  for (AsyncTransaction* read : {&first_, &second_}) {
+    if (read->submitted() && read->Pend(cx).IsPending()) {
+      pending = true;
+    }
+  }
+  if (pending) {
+    return async2::Pending();
+  }
+  return async2::Ready();
+}
+
+}  // namespace pw::spi
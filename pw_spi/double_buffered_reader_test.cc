@@ -0,0 +1,212 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_spi/double_buffered_reader.h"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::spi {
+namespace {
+
+using async2::Context;
+using async2::Dispatcher;
+using async2::Pending;
+using async2::Poll;
+using async2::Ready;
+
+constexpr Config kConfig = {
+    .polarity = ClockPolarity::kActiveHigh,
+    .phase = ClockPhase::kRisingEdge,
+    .bits_per_word = BitsPerWord(8),
+    .bit_order = BitOrder::kMsbFirst,
+};
+
+// Fills each read buffer with an increasing sample number when the test calls
+// Finish().
+class FakeAsyncInitiator : public AsyncInitiator {
+ public:
+  bool busy() const { return active_ != nullptr; }
+
+  void Finish() {
+    ASSERT_NE(active_, nullptr);
+    for (std::byte& b : active_->read_buffer()) {
+      b = std::byte{sample_};
+    }
+    sample_ += 1;
+    active_ = nullptr;
+    TransactionComplete(OkStatus());
+  }
+
+ private:
+  Status DoStartTransaction(const AsyncTransaction& transaction) override {
+    active_ = &transaction;
+    return OkStatus();
+  }
+
+  bool DoAbortTransaction() override {
+    active_ = nullptr;
+    return true;
+  }
+
+  const AsyncTransaction* active_ = nullptr;
+  uint8_t sample_ = 1;
+};
+
+// Reads a single buffer from the reader, and stores the result.
+class ReadTask : public async2::Task {
+ public:
+  explicit ReadTask(DoubleBufferedReader& reader) : reader_(reader) {}
+
+  const std::optional<Result<ByteSpan>>& result() const { return result_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    Poll<Result<ByteSpan>> result = reader_.PendRead(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    result_ = *result;
+    return Ready();
+  }
+
+  DoubleBufferedReader& reader_;
+  std::optional<Result<ByteSpan>> result_;
+};
+
+// Waits for the reader to stop.
+class StopTask : public async2::Task {
+ public:
+  explicit StopTask(DoubleBufferedReader& reader) : reader_(reader) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override { return reader_.PendStop(cx); }
+
+  DoubleBufferedReader& reader_;
+};
+
+class SpiDoubleBufferedReaderTest : public ::testing::Test {
+ protected:
+  SpiDoubleBufferedReaderTest()
+      : reader_(initiator_, kConfig, nullptr, first_, second_) {}
+
+  // Reads a buffer while the initiator completes a transfer.
+  std::optional<Result<ByteSpan>> ReadWithTransfer() {
+    ReadTask task(reader_);
+    dispatcher_.Post(task);
+    EXPECT_EQ(dispatcher_.RunUntilStalled(task), Pending());
+    initiator_.Finish();
+    dispatcher_.RunToCompletion(task);
+    return task.result();
+  }
+
+  void Stop() {
+    reader_.RequestStop();
+    StopTask task(reader_);
+    dispatcher_.Post(task);
+    dispatcher_.RunToCompletion(task);
+  }
+
+  Dispatcher dispatcher_;
+  FakeAsyncInitiator initiator_;
+  std::array<std::byte, 4> first_ = {};
+  std::array<std::byte, 4> second_ = {};
+  DoubleBufferedReader reader_;
+};
+
+TEST_F(SpiDoubleBufferedReaderTest, ReadsBuffersInTurn) {
+  ASSERT_EQ(reader_.Start(), OkStatus());
+
+  auto result = ReadWithTransfer();
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->status(), OkStatus());
+  EXPECT_EQ((*result)->data(), first_.data());
+  EXPECT_EQ((**result)[0], std::byte{1});
+  // The second read starts while the first buffer is held.
+  EXPECT_TRUE(initiator_.busy());
+  ASSERT_EQ(reader_.Release(), OkStatus());
+
+  result = ReadWithTransfer();
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->status(), OkStatus());
+  EXPECT_EQ((*result)->data(), second_.data());
+  EXPECT_EQ((**result)[0], std::byte{2});
+  ASSERT_EQ(reader_.Release(), OkStatus());
+
+  // The first buffer was queued again when it was released.
+  result = ReadWithTransfer();
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ((*result)->data(), first_.data());
+  EXPECT_EQ((**result)[0], std::byte{3});
+  ASSERT_EQ(reader_.Release(), OkStatus());
+
+  Stop();
+}
+
+TEST_F(SpiDoubleBufferedReaderTest, ReadWhileHoldingBufferFails) {
+  ASSERT_EQ(reader_.Start(), OkStatus());
+  auto result = ReadWithTransfer();
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->status(), OkStatus());
+
+  ReadTask task(reader_);
+  dispatcher_.Post(task);
+  dispatcher_.RunToCompletion(task);
+  ASSERT_TRUE(task.result().has_value());
+  EXPECT_EQ(task.result()->status(), Status::FailedPrecondition());
+
+  ASSERT_EQ(reader_.Release(), OkStatus());
+  EXPECT_EQ(reader_.Release(), Status::FailedPrecondition());
+  Stop();
+}
+
+TEST_F(SpiDoubleBufferedReaderTest, StartTwiceFails) {
+  ASSERT_EQ(reader_.Start(), OkStatus());
+  EXPECT_EQ(reader_.Start(), Status::FailedPrecondition());
+  Stop();
+}
+
+TEST_F(SpiDoubleBufferedReaderTest, StopCancelsReads) {
+  ASSERT_EQ(reader_.Start(), OkStatus());
+  Stop();
+  EXPECT_FALSE(initiator_.busy());
+
+  // The reader may be started again after stopping.
+  ASSERT_EQ(reader_.Start(), OkStatus());
+  auto result = ReadWithTransfer();
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ((*result)->data(), first_.data());
+  ASSERT_EQ(reader_.Release(), OkStatus());
+  Stop();
+}
+
+TEST_F(SpiDoubleBufferedReaderTest, StopWhileHoldingBuffer) {
+  ASSERT_EQ(reader_.Start(), OkStatus());
+  auto result = ReadWithTransfer();
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->status(), OkStatus());
+
+  Stop();
+  EXPECT_FALSE(initiator_.busy());
+  // Releasing after stopping does not queue another read.
+  EXPECT_EQ(reader_.Release(), OkStatus());
+  EXPECT_FALSE(initiator_.busy());
+}
+
+}  // namespace
+}  // namespace pw::spi
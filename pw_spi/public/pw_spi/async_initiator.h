@@ -0,0 +1,217 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/poll.h"
+#include "pw_bytes/span.h"
+#include "pw_containers/intrusive_list.h"
+#include "pw_spi/chip_selector.h"
+#include "pw_spi/initiator.h"
+#include "pw_status/status.h"
+#include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::spi {
+
+class AsyncInitiator;
+
+/// A SPI transfer that is queued on an `AsyncInitiator`. Data from the write
+/// buffer is written to the bus while the read buffer is filled, with the same
+/// semantics as `Initiator::WriteRead`.
+///
+/// The buffers must remain valid, and the `AsyncTransaction` must not be
+/// destroyed, from when it is submitted until it completes.
+class AsyncTransaction : public IntrusiveList<AsyncTransaction>::Item {
+ public:
+  /// @param[in] config The bus configuration for the transfer. The initiator
+  /// reconfigures the bus if it differs from the previous transfer's.
+  ///
+  /// @param[in] chip_selector The responder's chip select, which is activated
+  /// for the duration of the transfer. May be null if the backend selects the
+  /// responder itself.
+  ///
+  /// @param[in] write_buffer The data to write.
+  ///
+  /// @param[in] read_buffer The area to read data into.
+  AsyncTransaction(const Config& config,
+                   ChipSelector* chip_selector,
+                   ConstByteSpan write_buffer,
+                   ByteSpan read_buffer)
+      : config_(config),
+        chip_selector_(chip_selector),
+        write_buffer_(write_buffer),
+        read_buffer_(read_buffer) {}
+
+  AsyncTransaction(const AsyncTransaction&) = delete;
+  AsyncTransaction& operator=(const AsyncTransaction&) = delete;
+
+  ~AsyncTransaction();
+
+  /// Returns `Pending` while the transfer is queued or in progress, and
+  /// arranges for the current task to be woken when it completes. Then
+  /// returns `Ready` with its result, after which the transaction may be
+  /// submitted again.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - Success.
+  /// * @pw_status{CANCELLED} - `AsyncInitiator::Cancel` was called.
+  /// * @pw_status{FAILED_PRECONDITION} - The transaction was not submitted.
+  /// * Errors from the chip selector or the backend.
+  async2::Poll<Status> Pend(async2::Context& cx);
+
+  /// Returns true from when the transaction is submitted until `Pend` returns
+  /// its result.
+  bool submitted() const;
+
+  const Config& config() const { return config_; }
+  ChipSelector* chip_selector() const { return chip_selector_; }
+  ConstByteSpan write_buffer() const { return write_buffer_; }
+  ByteSpan read_buffer() const { return read_buffer_; }
+
+ private:
+  friend class AsyncInitiator;
+
+  enum class State : uint8_t {
+    kIdle,
+    kQueued,
+    kActive,
+    kComplete,
+  };
+
+  const Config config_;
+  ChipSelector* const chip_selector_;
+  const ConstByteSpan write_buffer_;
+  const ByteSpan read_buffer_;
+
+  // Set while the transaction is submitted. The remaining members are guarded
+  // by the initiator's lock while it is set.
+  AsyncInitiator* initiator_ = nullptr;
+  State state_ = State::kIdle;
+  Status result_;
+  async2::Waker waker_;
+};
+
+/// Driver interface for SPI buses whose transfers complete asynchronously,
+/// such as buses driven by DMA.
+///
+/// Unlike `Initiator`, which blocks for each transfer, and `Device`, which
+/// borrows the bus for the duration of a transaction, transactions are
+/// submitted to a per-bus queue and run one at a time in the order they were
+/// submitted. The queue activates each transaction's chip selector before the
+/// transfer starts, and deactivates it when the transfer completes, before the
+/// next transaction's chip selector is activated.
+///
+/// @code{.cpp}
+///   std::array<std::byte, 16> samples;
+///   pw::spi::AsyncTransaction read(kAdcConfig, &adc_cs, {}, samples);
+///
+///   // From a task:
+///   PW_TRY(initiator.Submit(read));
+///   ...
+///   Poll<Status> result = read.Pend(cx);
+/// @endcode
+///
+/// Backends implement `DoStartTransaction`, which must start a transfer and
+/// return without waiting for it, and call `TransactionComplete` when it
+/// finishes.
+///
+/// Chip selectors and the backend's `DoStartTransaction` and
+/// `DoAbortTransaction` are called with the initiator's lock held, from
+/// whichever context submits, cancels, or completes a transaction, which is
+/// often an interrupt. They must be interrupt-safe and must not block.
+///
+/// @note Locks are acquired in the order `AsyncInitiator` lock, then
+/// `async2::dispatcher_lock()`.
+class AsyncInitiator {
+ public:
+  AsyncInitiator(const AsyncInitiator&) = delete;
+  AsyncInitiator& operator=(const AsyncInitiator&) = delete;
+
+  virtual ~AsyncInitiator() = default;
+
+  /// Adds a transaction to the end of the queue, and starts it if the bus is
+  /// idle. Thread- and interrupt-safe.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The transaction was queued.
+  /// * @pw_status{FAILED_PRECONDITION} - The transaction is already submitted.
+  /// * @pw_status{INVALID_ARGUMENT} - Both buffers are empty.
+  Status Submit(AsyncTransaction& transaction) PW_LOCKS_EXCLUDED(lock_);
+
+  /// Cancels a submitted transaction. A queued transaction is removed from the
+  /// queue. A transaction in progress is aborted if the backend supports it.
+  /// `Pend` then returns @pw_status{CANCELLED}. Thread- and interrupt-safe.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The transaction was removed from the queue or
+  ///   aborted.
+  /// * @pw_status{UNIMPLEMENTED} - The transaction is in progress and the
+  ///   backend cannot abort it. It runs to completion.
+  /// * @pw_status{FAILED_PRECONDITION} - The transaction is not submitted to
+  ///   this initiator, or has already completed.
+  Status Cancel(AsyncTransaction& transaction) PW_LOCKS_EXCLUDED(lock_);
+
+ protected:
+  constexpr AsyncInitiator() = default;
+
+  /// Completes the transfer in progress with its result, deactivates its chip
+  /// selector, and starts the next queued transaction, if any. Backends call
+  /// this once the transfer started by `DoStartTransaction` is done, typically
+  /// from an interrupt.
+  void TransactionComplete(Status status) PW_LOCKS_EXCLUDED(lock_);
+
+ private:
+  /// Starts the transfer for `transaction`, whose chip selector is already
+  /// active, reconfiguring the bus first if needed. Only one transfer is in
+  /// progress at a time. Called with the lock held, so must not call
+  /// `TransactionComplete`.
+  ///
+  /// @returns @pw_status{OK} if the transfer started, or an error if it could
+  /// not be started, in which case the transaction completes with that error.
+  virtual Status DoStartTransaction(const AsyncTransaction& transaction)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) = 0;
+
+  /// Aborts the transfer in progress, if the backend can. Called with the lock
+  /// held, so must not call `TransactionComplete`.
+  ///
+  /// @returns true if the transfer was aborted, in which case the transaction
+  /// completes with @pw_status{CANCELLED}. The default implementation returns
+  /// false, and the transfer runs to completion.
+  virtual bool DoAbortTransaction() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return false;
+  }
+
+  // Deactivates the active transaction's chip selector, completes it with
+  // `status`, and starts the next queued transaction, if any.
+  void CompleteActive(Status status) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Starts queued transactions until one starts or the queue is empty.
+  void StartNext() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Completes `transaction` with `status` and wakes its task.
+  void Complete(AsyncTransaction& transaction, Status status)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  friend class AsyncTransaction;
+
+  sync::InterruptSpinLock lock_;
+  IntrusiveList<AsyncTransaction> queue_ PW_GUARDED_BY(lock_);
+  AsyncTransaction* active_ PW_GUARDED_BY(lock_) = nullptr;
+};
+
+}  // namespace pw::spi
@@ -0,0 +1,116 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_async2/poll.h"
+#include "pw_bytes/span.h"
+#include "pw_result/result.h"
+#include "pw_spi/async_initiator.h"
+#include "pw_spi/chip_selector.h"
+#include "pw_spi/initiator.h"
+#include "pw_status/status.h"
+
+namespace pw::spi {
+
+/// Continuously reads from a SPI responder, such as an ADC, into two buffers
+/// in turn. While the caller processes one buffer, the next read is already
+/// queued or in progress on the other, so the bus stays busy.
+///
+/// @code{.cpp}
+///   // From a task:
+///   Poll<Result<ByteSpan>> samples = reader.PendRead(cx);
+///   if (samples.IsPending()) {
+///     return Pending();
+///   }
+///   if (samples->ok()) {
+///     Process(**samples);
+///   }
+///   reader.Release();
+/// @endcode
+///
+/// `DoubleBufferedReader` is not thread-safe; it is meant to be used by a
+/// single task.
+class DoubleBufferedReader {
+ public:
+  /// @param[in] initiator The bus to read from.
+  ///
+  /// @param[in] config The bus configuration for the reads.
+  ///
+  /// @param[in] chip_selector The responder's chip select, or null if the
+  /// backend selects the responder itself.
+  ///
+  /// @param[in] first_buffer, second_buffer The buffers to read into, in turn.
+  /// Each read fills an entire buffer.
+  DoubleBufferedReader(AsyncInitiator& initiator,
+                       const Config& config,
+                       ChipSelector* chip_selector,
+                       ByteSpan first_buffer,
+                       ByteSpan second_buffer)
+      : initiator_(initiator),
+        first_(config, chip_selector, ConstByteSpan(), first_buffer),
+        second_(config, chip_selector, ConstByteSpan(), second_buffer) {}
+
+  /// Queues reads into both buffers.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The reads were queued.
+  /// * @pw_status{FAILED_PRECONDITION} - The reader was already started, and
+  ///   has not finished stopping.
+  /// * Other errors from `AsyncInitiator::Submit`.
+  Status Start();
+
+  /// Returns the next filled buffer, in the order the reads were queued. The
+  /// buffer belongs to the caller until `Release()` is called.
+  ///
+  /// Returns:
+  /// * The filled buffer.
+  /// * @pw_status{FAILED_PRECONDITION} - The previous buffer has not been
+  ///   released.
+  /// * Any error from the read, in which case `Release()` must still be
+  ///   called before the next read.
+  async2::Poll<Result<ByteSpan>> PendRead(async2::Context& cx);
+
+  /// Queues a read into the buffer returned by `PendRead`, unless the reader
+  /// is stopping.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The buffer was released.
+  /// * @pw_status{FAILED_PRECONDITION} - No buffer is held.
+  /// * Other errors from `AsyncInitiator::Submit`.
+  Status Release();
+
+  /// Stops queuing reads, and cancels the reads that are queued or in
+  /// progress. `PendStop()` must complete before the reader is destroyed. A
+  /// buffer held by the caller must still be released.
+  void RequestStop();
+
+  /// Returns `Ready` once no reads are queued or in progress.
+  async2::Poll<> PendStop(async2::Context& cx);
+
+ private:
+  AsyncTransaction& next() { return next_is_first_ ? first_ : second_; }
+
+  AsyncInitiator& initiator_;
+  AsyncTransaction first_;
+  AsyncTransaction second_;
+  bool next_is_first_ = true;
+  bool held_ = false;
+  bool stopping_ = false;
+};
+
+}  // namespace pw::spi
@@ -0,0 +1,155 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_spi_mcuxpresso/async_initiator.h"
+
+#include "pw_status/try.h"
+#include "spi_status.h"
+
+namespace pw::spi {
+
+using internal::ToPwStatus;
+
+McuxpressoAsyncInitiator::~McuxpressoAsyncInitiator() {
+  if (initialized_) {
+    DMA_DisableChannel(config_.dma_base, config_.tx_dma_ch);
+    DMA_DisableChannel(config_.dma_base, config_.rx_dma_ch);
+  }
+  if (current_config_.has_value()) {
+    SPI_Deinit(config_.spi_base);
+  }
+}
+
+Status McuxpressoAsyncInitiator::Init() {
+  INPUTMUX_Init(INPUTMUX);
+  // Enable DMA request.
+  INPUTMUX_EnableSignal(
+      INPUTMUX, config_.rx_input_mux_dmac_ch_request_en, true);
+  INPUTMUX_EnableSignal(
+      INPUTMUX, config_.tx_input_mux_dmac_ch_request_en, true);
+  // Turnoff clock to inputmux to save power. Clock is only needed to make
+  // changes.
+  INPUTMUX_Deinit(INPUTMUX);
+
+  DMA_EnableChannel(config_.dma_base, config_.tx_dma_ch);
+  DMA_EnableChannel(config_.dma_base, config_.rx_dma_ch);
+
+  DMA_CreateHandle(&tx_dma_handle_, config_.dma_base, config_.tx_dma_ch);
+  DMA_CreateHandle(&rx_dma_handle_, config_.dma_base, config_.rx_dma_ch);
+
+  initialized_ = true;
+  return OkStatus();
+}
+
+// inclusive-language: disable
+void McuxpressoAsyncInitiator::TransferCompleteCallback(SPI_Type*,
+                                                        spi_dma_handle_t*,
+                                                        status_t status,
+                                                        void* user_data) {
+  static_cast<McuxpressoAsyncInitiator*>(user_data)->TransactionComplete(
+      ToPwStatus(status));
+}
+
+Status McuxpressoAsyncInitiator::Reconfigure(const spi::Config& config) {
+  spi_master_config_t master_config = {};
+  SPI_MasterGetDefaultConfig(&master_config);
+
+  if (config.polarity == ClockPolarity::kActiveLow) {
+    master_config.polarity = kSPI_ClockPolarityActiveLow;
+  } else {
+    master_config.polarity = kSPI_ClockPolarityActiveHigh;
+  }
+  if (config.phase == ClockPhase::kRisingEdge) {
+    master_config.phase = kSPI_ClockPhaseFirstEdge;
+  } else {
+    master_config.phase = kSPI_ClockPhaseSecondEdge;
+  }
+
+  if (config.bit_order == BitOrder::kMsbFirst) {
+    master_config.direction = kSPI_MsbFirst;
+  } else {
+    master_config.direction = kSPI_LsbFirst;
+  }
+
+  master_config.enableMaster = true;
+  master_config.baudRate_Bps = config_.baud_rate_bps;
+
+  master_config.sselNum = static_cast<spi_ssel_t>(pin_);
+  master_config.sselPol = static_cast<spi_spol_t>(kSPI_SpolActiveAllLow);
+
+  // Data width enum value is 1 value below bits_per_word. i.e. 0 = 1;
+  constexpr uint8_t kMinBitsPerWord = 4;
+  constexpr uint8_t kMaxBitsPerWord = 16;
+  if (config.bits_per_word() < kMinBitsPerWord ||
+      config.bits_per_word() > kMaxBitsPerWord) {
+    return Status::InvalidArgument();
+  }
+  master_config.dataWidth =
+      static_cast<_spi_data_width>(config.bits_per_word() - 1);
+
+  SPI_MasterInit(config_.spi_base, &master_config, config_.max_speed_hz);
+  PW_TRY(ToPwStatus(SPI_MasterTransferCreateHandleDMA(config_.spi_base,
+                                                      &spi_dma_handle_,
+                                                      TransferCompleteCallback,
+                                                      this,
+                                                      &tx_dma_handle_,
+                                                      &rx_dma_handle_)));
+  current_config_.emplace(config);
+  current_pin_ = pin_;
+  return OkStatus();
+}
+
+Status McuxpressoAsyncInitiator::DoStartTransaction(
+    const AsyncTransaction& transaction) {
+  if (!initialized_) {
+    return Status::FailedPrecondition();
+  }
+  if (!current_config_.has_value() ||
+      !(*current_config_ == transaction.config()) || current_pin_ != pin_) {
+    PW_TRY(Reconfigure(transaction.config()));
+  }
+
+  ConstByteSpan write_buffer = transaction.write_buffer();
+  ByteSpan read_buffer = transaction.read_buffer();
+  transfer_ = {};
+  transfer_.txData =
+      reinterpret_cast<uint8_t*>(const_cast<std::byte*>(write_buffer.data()));
+  transfer_.rxData = reinterpret_cast<uint8_t*>(read_buffer.data());
+  if (write_buffer.empty()) {
+    // Read only transaction
+    transfer_.txData = nullptr;
+    transfer_.dataSize = read_buffer.size();
+  } else if (read_buffer.empty()) {
+    // Write only transaction
+    transfer_.rxData = nullptr;
+    transfer_.dataSize = write_buffer.size();
+  } else {
+    // Take the smallest as the size of transaction
+    transfer_.dataSize = write_buffer.size() < read_buffer.size()
+                             ? write_buffer.size()
+                             : read_buffer.size();
+  }
+  transfer_.configFlags = kSPI_FrameAssert;
+
+  return ToPwStatus(
+      SPI_MasterTransferDMA(config_.spi_base, &spi_dma_handle_, &transfer_));
+}
+
+bool McuxpressoAsyncInitiator::DoAbortTransaction() {
+  SPI_MasterTransferAbortDMA(config_.spi_base, &spi_dma_handle_);
+  return true;
+}
+// inclusive-language: enable
+
+}  // namespace pw::spi
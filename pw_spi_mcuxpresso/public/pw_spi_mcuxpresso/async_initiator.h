@@ -0,0 +1,115 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "fsl_dma.h"
+#include "fsl_inputmux.h"
+#include "fsl_spi.h"
+#include "fsl_spi_dma.h"
+#include "pw_spi/async_initiator.h"
+#include "pw_spi/chip_selector.h"
+#include "pw_spi/initiator.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::spi {
+
+/// Asynchronous SPI initiator for MCUXpresso Flexcomm SPI peripherals, which
+/// transfers data with DMA.
+///
+/// The peripheral drives the chip select given by `McuxpressoAsyncChipSelector`
+/// for the duration of each transaction.
+class McuxpressoAsyncInitiator final : public AsyncInitiator {
+ public:
+  struct Config {
+    SPI_Type* spi_base;      // Base of SPI control struct
+    uint32_t max_speed_hz;   // Source clock frequency
+    uint32_t baud_rate_bps;  // Desired communication speed
+    DMA_Type* dma_base;      // Base of DMA control struct
+    uint32_t rx_dma_ch;      // Receive DMA channel
+    uint32_t tx_dma_ch;      // Transmit DMA channel
+    inputmux_signal_t rx_input_mux_dmac_ch_request_en;  // Rx input mux signal
+    inputmux_signal_t tx_input_mux_dmac_ch_request_en;  // Tx input mux signal
+  };
+
+  explicit McuxpressoAsyncInitiator(const Config& config) : config_(config) {}
+
+  ~McuxpressoAsyncInitiator();
+
+  McuxpressoAsyncInitiator(const McuxpressoAsyncInitiator&) = delete;
+  McuxpressoAsyncInitiator& operator=(const McuxpressoAsyncInitiator&) =
+      delete;
+
+  /// Enables the DMA channels. Must be called before submitting transactions.
+  Status Init();
+
+ private:
+  friend class McuxpressoAsyncChipSelector;
+
+  // inclusive-language: disable
+  static void TransferCompleteCallback(SPI_Type* base,
+                                       spi_dma_handle_t* handle,
+                                       status_t status,
+                                       void* user_data);
+  // inclusive-language: enable
+
+  Status DoStartTransaction(const AsyncTransaction& transaction) override;
+  bool DoAbortTransaction() override;
+
+  // Called by McuxpressoAsyncChipSelector while the queue's lock is held, so
+  // that the peripheral selects `pin` for the transaction that is starting.
+  void SelectPin(uint32_t pin) { pin_ = pin; }
+
+  Status Reconfigure(const spi::Config& config);
+
+  const Config config_;
+  dma_handle_t rx_dma_handle_;
+  dma_handle_t tx_dma_handle_;
+  spi_dma_handle_t spi_dma_handle_;
+  spi_transfer_t transfer_;
+
+  // The configuration of the peripheral. Only accessed while a transaction is
+  // starting or completing.
+  std::optional<spi::Config> current_config_;
+  uint32_t current_pin_ = 0;
+  uint32_t pin_ = 0;
+  bool initialized_ = false;
+};
+
+/// Selects which of the peripheral's chip select pins
+/// `McuxpressoAsyncInitiator` drives for a transaction. Like
+/// `McuxpressoChipSelector`, this does not drive the pin itself.
+class McuxpressoAsyncChipSelector : public ChipSelector {
+ public:
+  McuxpressoAsyncChipSelector(McuxpressoAsyncInitiator& initiator,
+                              uint32_t pin)
+      : initiator_(initiator), pin_(pin) {}
+
+  Status SetActive(bool active) override {
+    if (active) {
+      initiator_.SelectPin(pin_);
+    }
+    return OkStatus();
+  }
+
+ private:
+  McuxpressoAsyncInitiator& initiator_;
+  uint32_t pin_;
+};
+
+}  // namespace pw::spi
@@ -23,6 +23,7 @@
 #include "pw_spi_mcuxpresso/spi.h"
 #include "pw_status/status.h"
 #include "pw_status/try.h"
+#include "spi_status.h"
 
 namespace pw::spi {
 namespace {
@@ -30,30 +31,7 @@ namespace {
 using namespace ::std::literals::chrono_literals;
 constexpr auto kMaxWait = pw::chrono::SystemClock::for_at_least(1000ms);
 
-pw::Status ToPwStatus(int32_t status) {
-  switch (status) {
-    // Intentional fall-through
-    case kStatus_Success:
-    case kStatus_SPI_Idle:
-      return pw::OkStatus();
-    case kStatus_ReadOnly:
-      return pw::Status::PermissionDenied();
-    case kStatus_OutOfRange:
-      return pw::Status::OutOfRange();
-    case kStatus_InvalidArgument:
-      return pw::Status::InvalidArgument();
-    case kStatus_Timeout:
-      return pw::Status::DeadlineExceeded();
-    case kStatus_NoTransferInProgress:
-      return pw::Status::FailedPrecondition();
-    // Intentional fall-through
-    case kStatus_Fail:
-    default:
-      PW_LOG_ERROR("Mcuxpresso SPI unknown error code: %d",
-                   static_cast<int>(status));
-      return pw::Status::Unknown();
-  }
-}
+using internal::ToPwStatus;
 
 }  // namespace
 
@@ -0,0 +1,51 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "fsl_spi.h"
+#include "pw_log/log.h"
+#include "pw_status/status.h"
+
+namespace pw::spi::internal {
+
+// Converts an MCUXpresso SDK SPI driver status to a pw::Status.
+inline Status ToPwStatus(int32_t status) {
+  switch (status) {
+    // Intentional fall-through
+    case kStatus_Success:
+    case kStatus_SPI_Idle:
+      return OkStatus();
+    case kStatus_ReadOnly:
+      return Status::PermissionDenied();
+    case kStatus_OutOfRange:
+      return Status::OutOfRange();
+    case kStatus_InvalidArgument:
+      return Status::InvalidArgument();
+    case kStatus_Timeout:
+      return Status::DeadlineExceeded();
+    case kStatus_NoTransferInProgress:
+      return Status::FailedPrecondition();
+    // Intentional fall-through
+    case kStatus_Fail:
+    default:
+      PW_LOG_ERROR("Mcuxpresso SPI unknown error code: %d",
+                   static_cast<int>(status));
+      return Status::Unknown();
+  }
+}
+
+}  // namespace pw::spi::internal
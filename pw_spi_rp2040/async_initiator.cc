@@ -0,0 +1,215 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_spi_rp2040/async_initiator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/spi.h"
+#include "pw_assert/check.h"
+
+namespace pw::spi {
+namespace {
+
+// The initiator that owns each DMA channel's interrupt, indexed by its receive
+// channel.
+std::array<Rp2040AsyncInitiator*, NUM_DMA_CHANNELS> initiators;
+
+// Sent repeatedly by read-only transfers.
+constexpr std::byte kRepeatedTxData{0};
+
+// Receives the data that write-only transfers discard.
+std::byte discarded_rx_data;
+
+constexpr spi_order_t GetBitOrder(BitOrder bit_order) {
+  switch (bit_order) {
+    case BitOrder::kLsbFirst:
+      return SPI_LSB_FIRST;
+    case BitOrder::kMsbFirst:
+      return SPI_MSB_FIRST;
+    default:
+      PW_CRASH("Unknown bit order");
+  }
+}
+
+constexpr spi_cpha_t GetPhase(ClockPhase phase) {
+  switch (phase) {
+    case ClockPhase::kRisingEdge:
+      return SPI_CPHA_0;
+    case ClockPhase::kFallingEdge:
+      return SPI_CPHA_1;
+    default:
+      PW_CRASH("Unknown phase");
+  }
+}
+
+constexpr spi_cpol_t GetPolarity(ClockPolarity polarity) {
+  switch (polarity) {
+    case ClockPolarity::kActiveHigh:
+      return SPI_CPOL_0;
+    case ClockPolarity::kActiveLow:
+      return SPI_CPOL_1;
+    default:
+      PW_CRASH("Unknown polarity");
+  }
+}
+
+}  // namespace
+
+Rp2040AsyncInitiator::~Rp2040AsyncInitiator() {
+  if (rx_channel_ < 0) {
+    return;
+  }
+  const auto rx = static_cast<uint>(rx_channel_);
+  const auto tx = static_cast<uint>(tx_channel_);
+  dma_channel_set_irq0_enabled(rx, false);
+  dma_channel_abort(tx);
+  dma_channel_abort(rx);
+  initiators[rx] = nullptr;
+  dma_channel_unclaim(tx);
+  dma_channel_unclaim(rx);
+}
+
+Status Rp2040AsyncInitiator::Init() {
+  if (rx_channel_ >= 0) {
+    return OkStatus();
+  }
+  const int tx_channel = dma_claim_unused_channel(/*required=*/false);
+  if (tx_channel < 0) {
+    return Status::ResourceExhausted();
+  }
+  const int rx_channel = dma_claim_unused_channel(/*required=*/false);
+  if (rx_channel < 0) {
+    dma_channel_unclaim(static_cast<uint>(tx_channel));
+    return Status::ResourceExhausted();
+  }
+  tx_channel_ = tx_channel;
+  rx_channel_ = rx_channel;
+
+  const auto rx = static_cast<uint>(rx_channel_);
+  initiators[rx] = this;
+  static bool handler_added = false;
+  if (!handler_added) {
+    irq_add_shared_handler(DMA_IRQ_0,
+                           DmaIrqHandler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    handler_added = true;
+  }
+  dma_channel_set_irq0_enabled(rx, true);
+  return OkStatus();
+}
+
+void Rp2040AsyncInitiator::DmaIrqHandler() {
+  for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+    Rp2040AsyncInitiator* initiator = initiators[channel];
+    if (initiator == nullptr || !dma_channel_get_irq0_status(channel)) {
+      continue;
+    }
+    dma_channel_acknowledge_irq0(channel);
+    // The receive channel finishes last, once every word has been clocked.
+    initiator->TransactionComplete(OkStatus());
+  }
+}
+
+Status Rp2040AsyncInitiator::DoStartTransaction(
+    const AsyncTransaction& transaction) {
+  if (rx_channel_ < 0) {
+    return Status::FailedPrecondition();
+  }
+  const Config& config = transaction.config();
+  if (config.bits_per_word() != 8) {
+    return Status::InvalidArgument();
+  }
+  if (!current_config_.has_value() || !(*current_config_ == config)) {
+    spi_set_format(spi_,
+                   config.bits_per_word(),
+                   GetPolarity(config.polarity),
+                   GetPhase(config.phase),
+                   GetBitOrder(config.bit_order));
+    current_config_.emplace(config);
+  }
+
+  ConstByteSpan write_buffer = transaction.write_buffer();
+  ByteSpan read_buffer = transaction.read_buffer();
+  uint transfer_size;
+  if (write_buffer.empty()) {
+    transfer_size = static_cast<uint>(read_buffer.size());
+  } else if (read_buffer.empty()) {
+    transfer_size = static_cast<uint>(write_buffer.size());
+  } else {
+    // Take the smallest as the size of transaction
+    transfer_size = static_cast<uint>(
+        std::min(write_buffer.size(), read_buffer.size()));
+  }
+
+  const auto tx = static_cast<uint>(tx_channel_);
+  const auto rx = static_cast<uint>(rx_channel_);
+  volatile void* data_register = &spi_get_hw(spi_)->dr;
+
+  dma_channel_config tx_config = dma_channel_get_default_config(tx);
+  channel_config_set_transfer_data_size(&tx_config, DMA_SIZE_8);
+  channel_config_set_dreq(&tx_config, spi_get_dreq(spi_, /*is_tx=*/true));
+  channel_config_set_read_increment(&tx_config, !write_buffer.empty());
+  channel_config_set_write_increment(&tx_config, false);
+  dma_channel_configure(
+      tx,
+      &tx_config,
+      data_register,
+      write_buffer.empty() ? &kRepeatedTxData : write_buffer.data(),
+      transfer_size,
+      /*trigger=*/false);
+
+  dma_channel_config rx_config = dma_channel_get_default_config(rx);
+  channel_config_set_transfer_data_size(&rx_config, DMA_SIZE_8);
+  channel_config_set_dreq(&rx_config, spi_get_dreq(spi_, /*is_tx=*/false));
+  channel_config_set_read_increment(&rx_config, false);
+  channel_config_set_write_increment(&rx_config, !read_buffer.empty());
+  dma_channel_configure(
+      rx,
+      &rx_config,
+      read_buffer.empty() ? &discarded_rx_data : read_buffer.data(),
+      data_register,
+      transfer_size,
+      /*trigger=*/false);
+
+  // Start both channels together, so that no received word is missed.
+  dma_start_channel_mask((1u << tx) | (1u << rx));
+  return OkStatus();
+}
+
+bool Rp2040AsyncInitiator::DoAbortTransaction() {
+  const auto tx = static_cast<uint>(tx_channel_);
+  const auto rx = static_cast<uint>(rx_channel_);
+  // Aborting can raise the completion interrupt, so mask it while aborting.
+  dma_channel_set_irq0_enabled(rx, false);
+  dma_channel_abort(tx);
+  dma_channel_abort(rx);
+  dma_channel_acknowledge_irq0(rx);
+  dma_channel_set_irq0_enabled(rx, true);
+
+  // Wait for the words already sent to finish, and discard what they received.
+  while (spi_is_busy(spi_)) {
+  }
+  while (spi_is_readable(spi_)) {
+    static_cast<void>(spi_get_hw(spi_)->dr);
+  }
+  return true;
+}
+
+}  // namespace pw::spi
@@ -0,0 +1,61 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "hardware/spi.h"
+#include "pw_spi/async_initiator.h"
+#include "pw_status/status.h"
+
+namespace pw::spi {
+
+/// Asynchronous SPI initiator for the RP2040, which transfers data with two
+/// DMA channels.
+///
+/// Completion is signalled on `DMA_IRQ_0`, which is shared with other users of
+/// the DMA controller. As with `Rp2040Initiator`, only 8 bits per word are
+/// supported, and `spi_init()` must be called before use.
+class Rp2040AsyncInitiator final : public AsyncInitiator {
+ public:
+  explicit Rp2040AsyncInitiator(spi_inst_t* spi) : spi_(spi) {}
+
+  ~Rp2040AsyncInitiator();
+
+  Rp2040AsyncInitiator(const Rp2040AsyncInitiator&) = delete;
+  Rp2040AsyncInitiator& operator=(const Rp2040AsyncInitiator&) = delete;
+
+  /// Claims the DMA channels and enables their interrupt. Must be called
+  /// before submitting transactions.
+  ///
+  /// Returns:
+  /// * @pw_status{OK} - The initiator is ready.
+  /// * @pw_status{RESOURCE_EXHAUSTED} - Two DMA channels are not available.
+  Status Init();
+
+ private:
+  static void DmaIrqHandler();
+
+  Status DoStartTransaction(const AsyncTransaction& transaction) override;
+  bool DoAbortTransaction() override;
+
+  spi_inst_t* spi_;
+  int tx_channel_ = -1;
+  int rx_channel_ = -1;
+  std::optional<Config> current_config_;
+};
+
+}  // namespace pw::spi
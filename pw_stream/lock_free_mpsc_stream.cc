@@ -0,0 +1,146 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_stream/lock_free_mpsc_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "pw_assert/check.h"
+#include "pw_thread/yield.h"
+
+namespace pw::stream {
+
+////////////////////////////////////////////////////////////////////////////////
+// LockFreeMpscWriter methods.
+
+size_t LockFreeMpscWriter::ConservativeLimit(LimitType type) const {
+  if (type != LimitType::kWrite || reader_ == nullptr) {
+    return 0;
+  }
+  const size_t reserved = reader_->reserved_.load(std::memory_order_relaxed);
+  const size_t consumed = reader_->consumed_.load(std::memory_order_relaxed);
+  return reader_->capacity() - reader_->Distance(consumed, reserved);
+}
+
+Status LockFreeMpscWriter::DoWrite(ConstByteSpan data) {
+  if (reader_ == nullptr) {
+    return Status::FailedPrecondition();
+  }
+  return reader_->WriteData(data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// LockFreeMpscReader methods.
+
+LockFreeMpscReader::LockFreeMpscReader(ByteSpan buffer) : buffer_(buffer) {
+  PW_CHECK_UINT_LE(buffer.size(), std::numeric_limits<size_t>::max() / 2);
+}
+
+size_t LockFreeMpscReader::Advance(size_t position, size_t num_bytes) const {
+  const size_t limit = 2 * buffer_.size();
+  return position < limit - num_bytes ? position + num_bytes
+                                      : position + num_bytes - limit;
+}
+
+size_t LockFreeMpscReader::Distance(size_t from, size_t to) const {
+  return to >= from ? to - from : to + 2 * buffer_.size() - from;
+}
+
+size_t LockFreeMpscReader::Index(size_t position) const {
+  return position < buffer_.size() ? position : position - buffer_.size();
+}
+
+Status LockFreeMpscReader::WriteData(ConstByteSpan data) {
+  const size_t num_bytes = data.size();
+  if (num_bytes == 0) {
+    return OkStatus();
+  }
+
+  // Reserve space by advancing the reserved position past the data.
+  size_t start = reserved_.load(std::memory_order_relaxed);
+  size_t end;
+  do {
+    const size_t consumed = consumed_.load(std::memory_order_acquire);
+    if (Distance(consumed, start) + num_bytes > buffer_.size()) {
+      return Status::ResourceExhausted();
+    }
+    end = Advance(start, num_bytes);
+  } while (!reserved_.compare_exchange_weak(
+      start, end, std::memory_order_relaxed, std::memory_order_relaxed));
+
+  // Copy the data, which may wrap around the end of the ring buffer.
+  const size_t index = Index(start);
+  const size_t first = std::min(num_bytes, buffer_.size() - index);
+  std::memcpy(&buffer_[index], data.data(), first);
+  if (first < num_bytes) {
+    std::memcpy(buffer_.data(), &data[first], num_bytes - first);
+  }
+
+  // Publish the data once all data reserved before it has been published.
+  // Acquiring the previous writer's position ensures that the reader sees its
+  // data as well as this writer's.
+  while (published_.load(std::memory_order_acquire) != start) {
+    this_thread::yield();
+  }
+  published_.store(end, std::memory_order_release);
+  return OkStatus();
+}
+
+ConstByteSpan LockFreeMpscReader::PeekContiguous() const {
+  const size_t published = published_.load(std::memory_order_acquire);
+  const size_t consumed = consumed_.load(std::memory_order_relaxed);
+  const size_t index = Index(consumed);
+  const size_t available = Distance(consumed, published);
+  return ConstByteSpan(&buffer_[index],
+                       std::min(available, buffer_.size() - index));
+}
+
+void LockFreeMpscReader::Consume(size_t num_bytes) {
+  const size_t published = published_.load(std::memory_order_acquire);
+  const size_t consumed = consumed_.load(std::memory_order_relaxed);
+  PW_DCHECK_UINT_LE(num_bytes, Distance(consumed, published));
+  consumed_.store(Advance(consumed, num_bytes), std::memory_order_release);
+}
+
+size_t LockFreeMpscReader::ConservativeLimit(LimitType type) const {
+  if (type != LimitType::kRead) {
+    return 0;
+  }
+  const size_t published = published_.load(std::memory_order_acquire);
+  const size_t consumed = consumed_.load(std::memory_order_relaxed);
+  return Distance(consumed, published);
+}
+
+StatusWithSize LockFreeMpscReader::DoRead(ByteSpan destination) {
+  size_t num_read = 0;
+  while (num_read < destination.size()) {
+    ConstByteSpan data = PeekContiguous();
+    if (data.empty()) {
+      break;
+    }
+    const size_t num_bytes =
+        std::min(data.size(), destination.size() - num_read);
+    std::memcpy(&destination[num_read], data.data(), num_bytes);
+    Consume(num_bytes);
+    num_read += num_bytes;
+  }
+  if (num_read == 0 && !destination.empty()) {
+    return StatusWithSize::ResourceExhausted();
+  }
+  return StatusWithSize(num_read);
+}
+
+}  // namespace pw::stream
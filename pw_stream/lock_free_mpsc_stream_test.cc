@@ -0,0 +1,189 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_stream/lock_free_mpsc_stream.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::stream {
+namespace {
+
+constexpr std::array<std::byte, 4> kData = {
+    std::byte{0x01}, std::byte{0x02}, std::byte{0x03}, std::byte{0x04}};
+
+TEST(LockFreeMpscStreamTest, DisconnectedWriter) {
+  LockFreeMpscWriter writer;
+  EXPECT_FALSE(writer.connected());
+  EXPECT_EQ(writer.ConservativeWriteLimit(), 0u);
+  EXPECT_EQ(writer.Write(kData), Status::FailedPrecondition());
+}
+
+TEST(LockFreeMpscStreamTest, WriteAndPeek) {
+  BufferedLockFreeMpscReader<16> reader;
+  LockFreeMpscWriter writer = reader.GetWriter();
+  EXPECT_TRUE(writer.connected());
+  EXPECT_TRUE(reader.PeekContiguous().empty());
+
+  ASSERT_EQ(writer.Write(kData), OkStatus());
+  EXPECT_EQ(reader.ConservativeReadLimit(), kData.size());
+  EXPECT_EQ(writer.ConservativeWriteLimit(), 16u - kData.size());
+
+  ConstByteSpan data = reader.PeekContiguous();
+  ASSERT_EQ(data.size(), kData.size());
+  EXPECT_EQ(std::memcmp(data.data(), kData.data(), kData.size()), 0);
+
+  reader.Consume(data.size());
+  EXPECT_TRUE(reader.PeekContiguous().empty());
+  EXPECT_EQ(writer.ConservativeWriteLimit(), 16u);
+}
+
+TEST(LockFreeMpscStreamTest, WritesFromCopiedWriters) {
+  BufferedLockFreeMpscReader<16> reader;
+  LockFreeMpscWriter writer1 = reader.GetWriter();
+  LockFreeMpscWriter writer2 = writer1;
+
+  ASSERT_EQ(writer1.Write(ConstByteSpan(kData).first(2)), OkStatus());
+  ASSERT_EQ(writer2.Write(ConstByteSpan(kData).subspan(2)), OkStatus());
+
+  std::array<std::byte, 16> buffer;
+  Result<ByteSpan> result = reader.Read(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result->size(), kData.size());
+  EXPECT_EQ(std::memcmp(result->data(), kData.data(), kData.size()), 0);
+}
+
+TEST(LockFreeMpscStreamTest, WriteFailsWhenFull) {
+  BufferedLockFreeMpscReader<6> reader;
+  LockFreeMpscWriter writer = reader.GetWriter();
+
+  ASSERT_EQ(writer.Write(kData), OkStatus());
+  EXPECT_EQ(writer.Write(kData), Status::ResourceExhausted());
+  EXPECT_EQ(reader.ConservativeReadLimit(), kData.size());
+
+  reader.Consume(kData.size());
+  EXPECT_EQ(writer.Write(kData), OkStatus());
+}
+
+TEST(LockFreeMpscStreamTest, WriteWrapsAroundEnd) {
+  BufferedLockFreeMpscReader<6> reader;
+  LockFreeMpscWriter writer = reader.GetWriter();
+
+  ASSERT_EQ(writer.Write(kData), OkStatus());
+  reader.Consume(kData.size());
+  ASSERT_EQ(writer.Write(kData), OkStatus());
+
+  // The second write wraps, so it is peeked in two parts.
+  ConstByteSpan data = reader.PeekContiguous();
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data[0], kData[0]);
+  EXPECT_EQ(data[1], kData[1]);
+  reader.Consume(data.size());
+
+  data = reader.PeekContiguous();
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data[0], kData[2]);
+  EXPECT_EQ(data[1], kData[3]);
+  reader.Consume(data.size());
+  EXPECT_TRUE(reader.PeekContiguous().empty());
+}
+
+TEST(LockFreeMpscStreamTest, ReadCopiesAcrossEnd) {
+  BufferedLockFreeMpscReader<6> reader;
+  LockFreeMpscWriter writer = reader.GetWriter();
+
+  ASSERT_EQ(writer.Write(kData), OkStatus());
+  reader.Consume(kData.size());
+  ASSERT_EQ(writer.Write(kData), OkStatus());
+
+  std::array<std::byte, 16> buffer;
+  Result<ByteSpan> result = reader.Read(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result->size(), kData.size());
+  EXPECT_EQ(std::memcmp(result->data(), kData.data(), kData.size()), 0);
+
+  EXPECT_EQ(reader.Read(buffer).status(), Status::ResourceExhausted());
+}
+
+// Each writer thread writes a sequence of records containing its ID and a
+// sequence number.
+constexpr size_t kNumWriters = 3;
+constexpr uint32_t kNumRecords = 1000;
+
+struct Record {
+  uint32_t writer_id;
+  uint32_t sequence;
+};
+
+struct WriterContext {
+  LockFreeMpscWriter writer;
+  uint32_t writer_id;
+};
+
+void WriteRecords(void* arg) {
+  auto* context = static_cast<WriterContext*>(arg);
+  for (uint32_t i = 0; i < kNumRecords; ++i) {
+    Record record = {context->writer_id, i};
+    while (!context->writer.Write(as_bytes(span(&record, 1))).ok()) {
+      this_thread::yield();
+    }
+  }
+}
+
+TEST(LockFreeMpscStreamTest, ConcurrentWriters) {
+  BufferedLockFreeMpscReader<sizeof(Record) * 16> reader;
+  std::array<WriterContext, kNumWriters> contexts;
+  std::array<thread::test::TestThreadContext, kNumWriters> thread_contexts;
+  std::array<thread::Thread, kNumWriters> threads;
+  for (uint32_t i = 0; i < kNumWriters; ++i) {
+    contexts[i] = {reader.GetWriter(), i};
+    threads[i] = thread::Thread(
+        thread_contexts[i].options(), WriteRecords, &contexts[i]);
+  }
+
+  // Records are always published whole, so reading a whole number of records
+  // never splits one.
+  std::array<uint32_t, kNumWriters> next_sequence = {};
+  std::array<Record, 4> records;
+  size_t num_records = 0;
+  while (num_records < kNumWriters * kNumRecords) {
+    Result<ByteSpan> result = reader.Read(as_writable_bytes(span(records)));
+    if (!result.ok()) {
+      EXPECT_EQ(result.status(), Status::ResourceExhausted());
+      this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(result->size() % sizeof(Record), 0u);
+    for (size_t i = 0; i < result->size() / sizeof(Record); ++i) {
+      ASSERT_LT(records[i].writer_id, kNumWriters);
+      EXPECT_EQ(records[i].sequence, next_sequence[records[i].writer_id]++);
+      ++num_records;
+    }
+  }
+
+  for (thread::Thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(next_sequence, (std::array<uint32_t, kNumWriters>{
+                               kNumRecords, kNumRecords, kNumRecords}));
+}
+
+}  // namespace
+}  // namespace pw::stream
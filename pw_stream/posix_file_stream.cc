@@ -0,0 +1,226 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_stream/posix_file_stream.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "pw_status/try.h"
+#include "pw_stream/seek.h"
+
+namespace pw::stream {
+namespace {
+
+Status ErrnoToStatus(int error) {
+  switch (error) {
+    case ENOENT:
+      return Status::NotFound();
+    case EACCES:
+    case EPERM:
+      return Status::PermissionDenied();
+    default:
+      return Status::Unknown();
+  }
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// MmapFileReader methods.
+
+MmapFileReader::MmapFileReader(MmapFileReader&& other) noexcept {
+  *this = std::move(other);
+}
+
+MmapFileReader& MmapFileReader::operator=(MmapFileReader&& other) noexcept {
+  Close();
+  data_ = std::exchange(other.data_, nullptr);
+  size_ = std::exchange(other.size_, 0);
+  position_ = std::exchange(other.position_, 0);
+  return *this;
+}
+
+Status MmapFileReader::Open(const char* path) {
+  if (data_ != nullptr) {
+    return Status::FailedPrecondition();
+  }
+
+  const int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return ErrnoToStatus(errno);
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    const int error = errno;
+    close(fd);
+    return ErrnoToStatus(error);
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+
+  // Empty files cannot be mapped, so they have no data.
+  void* mapping = nullptr;
+  if (size != 0) {
+    mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  const int error = errno;
+  // The mapping remains valid after the file is closed.
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return ErrnoToStatus(error);
+  }
+
+  if (mapping != nullptr) {
+    // Files are usually read from start to end, so let the kernel read ahead.
+    madvise(mapping, size, MADV_SEQUENTIAL);
+  }
+  data_ = static_cast<const std::byte*>(mapping);
+  size_ = size;
+  position_ = 0;
+  return OkStatus();
+}
+
+void MmapFileReader::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<std::byte*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  position_ = 0;
+}
+
+ConstByteSpan MmapFileReader::ReadInPlace(size_t max_bytes) {
+  const ConstByteSpan result =
+      data().subspan(position_, std::min(max_bytes, size_ - position_));
+  position_ += result.size();
+  return result;
+}
+
+StatusWithSize MmapFileReader::DoRead(ByteSpan dest) {
+  if (position_ == size_) {
+    return StatusWithSize::OutOfRange();
+  }
+  const ConstByteSpan data = ReadInPlace(dest.size());
+  std::memcpy(dest.data(), data.data(), data.size());
+  return StatusWithSize(data.size());
+}
+
+Status MmapFileReader::DoSeek(ptrdiff_t offset, Whence origin) {
+  return CalculateSeek(offset, origin, size_, position_);
+}
+
+size_t MmapFileReader::ConservativeLimit(LimitType limit) const {
+  return limit == LimitType::kRead ? size_ - position_ : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// FileWriter methods.
+
+Status FileWriter::Open(const char* path) {
+  if (fd_ != kInvalidFd) {
+    return Status::FailedPrecondition();
+  }
+  fd_ = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (fd_ < 0) {
+    fd_ = kInvalidFd;
+    return ErrnoToStatus(errno);
+  }
+  buffered_ = 0;
+  position_ = 0;
+  return OkStatus();
+}
+
+Status FileWriter::Flush() {
+  if (fd_ == kInvalidFd) {
+    return Status::FailedPrecondition();
+  }
+  // Buffered data always ends at the current position.
+  const size_t buffered = std::exchange(buffered_, 0);
+  return WriteAt(buffer_.first(buffered), position_ - buffered);
+}
+
+Status FileWriter::Close() {
+  if (fd_ == kInvalidFd) {
+    return OkStatus();
+  }
+  Status status = Flush();
+  if (close(fd_) != 0 && status.ok()) {
+    status = Status::Unknown();
+  }
+  fd_ = kInvalidFd;
+  return status;
+}
+
+Status FileWriter::WriteAt(ConstByteSpan data, size_t offset) {
+  while (!data.empty()) {
+    const ssize_t written =
+        pwrite(fd_, data.data(), data.size(), static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::Unknown();
+    }
+    data = data.subspan(static_cast<size_t>(written));
+    offset += static_cast<size_t>(written);
+  }
+  return OkStatus();
+}
+
+Status FileWriter::DoWrite(ConstByteSpan data) {
+  if (fd_ == kInvalidFd) {
+    return Status::FailedPrecondition();
+  }
+  if (buffered_ + data.size() > buffer_.size()) {
+    PW_TRY(Flush());
+  }
+  if (data.size() >= buffer_.size()) {
+    PW_TRY(WriteAt(data, position_));
+  } else {
+    std::memcpy(&buffer_[buffered_], data.data(), data.size());
+    buffered_ += data.size();
+  }
+  position_ += data.size();
+  return OkStatus();
+}
+
+Status FileWriter::DoSeek(ptrdiff_t offset, Whence origin) {
+  PW_TRY(Flush());
+  size_t end_position = position_;
+  if (origin == Whence::kEnd) {
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0) {
+      return Status::Unknown();
+    }
+    end_position = static_cast<size_t>(file_stat.st_size);
+  }
+  // Files may be extended by seeking past their end and writing.
+  const ptrdiff_t new_position =
+      ResolveSeekOffset(offset, origin, end_position, position_);
+  if (new_position < 0) {
+    return Status::OutOfRange();
+  }
+  position_ = static_cast<size_t>(new_position);
+  return OkStatus();
+}
+
+}  // namespace pw::stream
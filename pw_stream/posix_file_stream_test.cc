@@ -0,0 +1,205 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_stream/posix_file_stream.h"
+
+#include <unistd.h>
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "pw_bytes/array.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::stream {
+namespace {
+
+constexpr auto kData = bytes::Array<0x01, 0x02, 0x03, 0x04, 0x05, 0x06>();
+
+class PosixFileStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::string path_template =
+        (std::filesystem::temp_directory_path() / "PosixFileXXXXXX").string();
+    const int fd = mkstemp(path_template.data());
+    ASSERT_GE(fd, 0);
+    close(fd);
+    path_ = path_template;
+  }
+
+  void TearDown() override { unlink(path_.c_str()); }
+
+  void WriteFile(ConstByteSpan data) {
+    std::array<std::byte, 4> buffer;
+    FileWriter writer(buffer);
+    ASSERT_EQ(writer.Open(path()), OkStatus());
+    ASSERT_EQ(writer.Write(data), OkStatus());
+    ASSERT_EQ(writer.Close(), OkStatus());
+  }
+
+  const char* path() const { return path_.c_str(); }
+
+ private:
+  std::string path_;
+};
+
+TEST_F(PosixFileStreamTest, OpenMissingFile) {
+  MmapFileReader reader;
+  EXPECT_EQ(reader.Open("/nonexistent/file"), Status::NotFound());
+
+  std::array<std::byte, 4> buffer;
+  FileWriter writer(buffer);
+  EXPECT_EQ(writer.Open("/nonexistent/file"), Status::NotFound());
+}
+
+TEST_F(PosixFileStreamTest, ReadEmptyFile) {
+  MmapFileReader reader;
+  ASSERT_EQ(reader.Open(path()), OkStatus());
+  EXPECT_TRUE(reader.data().empty());
+  EXPECT_EQ(reader.ConservativeReadLimit(), 0u);
+
+  std::array<std::byte, 4> dest;
+  EXPECT_EQ(reader.Read(dest).status(), Status::OutOfRange());
+}
+
+TEST_F(PosixFileStreamTest, WriteThenRead) {
+  WriteFile(kData);
+
+  MmapFileReader reader;
+  ASSERT_EQ(reader.Open(path()), OkStatus());
+  EXPECT_EQ(reader.Open(path()), Status::FailedPrecondition());
+  ASSERT_EQ(reader.data().size(), kData.size());
+  EXPECT_EQ(std::memcmp(reader.data().data(), kData.data(), kData.size()), 0);
+  EXPECT_EQ(reader.ConservativeReadLimit(), kData.size());
+
+  std::array<std::byte, 4> dest;
+  Result<ByteSpan> result = reader.Read(dest);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result->size(), 4u);
+  EXPECT_EQ(std::memcmp(result->data(), kData.data(), 4), 0);
+
+  result = reader.Read(dest);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result->size(), 2u);
+  EXPECT_EQ(std::memcmp(result->data(), &kData[4], 2), 0);
+
+  EXPECT_EQ(reader.Read(dest).status(), Status::OutOfRange());
+}
+
+TEST_F(PosixFileStreamTest, ReadInPlaceAndSeek) {
+  WriteFile(kData);
+
+  MmapFileReader reader;
+  ASSERT_EQ(reader.Open(path()), OkStatus());
+
+  ConstByteSpan data = reader.ReadInPlace(2);
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data.data(), reader.data().data());
+  EXPECT_EQ(reader.Tell(), 2u);
+
+  ASSERT_EQ(reader.Seek(-1, Stream::kEnd), OkStatus());
+  data = reader.ReadInPlace(4);
+  ASSERT_EQ(data.size(), 1u);
+  EXPECT_EQ(data[0], kData[5]);
+  EXPECT_TRUE(reader.ReadInPlace(4).empty());
+
+  EXPECT_EQ(reader.Seek(1, Stream::kEnd), Status::OutOfRange());
+  EXPECT_EQ(reader.Seek(0), OkStatus());
+  EXPECT_EQ(reader.ConservativeReadLimit(), kData.size());
+}
+
+TEST_F(PosixFileStreamTest, MoveReader) {
+  WriteFile(kData);
+
+  MmapFileReader reader;
+  ASSERT_EQ(reader.Open(path()), OkStatus());
+  reader.ReadInPlace(1);
+
+  MmapFileReader moved(std::move(reader));
+  EXPECT_TRUE(reader.data().empty());  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(moved.data().size(), kData.size());
+  EXPECT_EQ(moved.Tell(), 1u);
+}
+
+TEST_F(PosixFileStreamTest, WriterBuffersSmallWrites) {
+  std::array<std::byte, 4> buffer;
+  FileWriter writer(buffer);
+  ASSERT_EQ(writer.Open(path()), OkStatus());
+  ASSERT_EQ(writer.Write(ConstByteSpan(kData).first(2)), OkStatus());
+  EXPECT_EQ(writer.Tell(), 2u);
+
+  {
+    // The data has not been written to the file yet.
+    MmapFileReader reader;
+    ASSERT_EQ(reader.Open(path()), OkStatus());
+    EXPECT_TRUE(reader.data().empty());
+  }
+
+  ASSERT_EQ(writer.Flush(), OkStatus());
+  MmapFileReader reader;
+  ASSERT_EQ(reader.Open(path()), OkStatus());
+  EXPECT_EQ(reader.data().size(), 2u);
+}
+
+TEST_F(PosixFileStreamTest, WriterMixesSmallAndLargeWrites) {
+  std::array<std::byte, 4> buffer;
+  FileWriter writer(buffer);
+  ASSERT_EQ(writer.Open(path()), OkStatus());
+  ASSERT_EQ(writer.Write(ConstByteSpan(kData).first(1)), OkStatus());
+  ASSERT_EQ(writer.Write(ConstByteSpan(kData).subspan(1, 4)), OkStatus());
+  ASSERT_EQ(writer.Write(ConstByteSpan(kData).subspan(5)), OkStatus());
+  ASSERT_EQ(writer.Close(), OkStatus());
+
+  MmapFileReader reader;
+  ASSERT_EQ(reader.Open(path()), OkStatus());
+  ASSERT_EQ(reader.data().size(), kData.size());
+  EXPECT_EQ(std::memcmp(reader.data().data(), kData.data(), kData.size()), 0);
+}
+
+TEST_F(PosixFileStreamTest, WriterSeek) {
+  std::array<std::byte, 4> buffer;
+  FileWriter writer(buffer);
+  ASSERT_EQ(writer.Open(path()), OkStatus());
+  ASSERT_EQ(writer.Write(kData), OkStatus());
+  ASSERT_EQ(writer.Seek(1), OkStatus());
+  ASSERT_EQ(writer.Write(ConstByteSpan(kData).first(1)), OkStatus());
+  ASSERT_EQ(writer.Seek(0, Stream::kEnd), OkStatus());
+  EXPECT_EQ(writer.Tell(), kData.size());
+  ASSERT_EQ(writer.Write(ConstByteSpan(kData).first(1)), OkStatus());
+  EXPECT_EQ(writer.Seek(-8, Stream::kCurrent), Status::OutOfRange());
+  ASSERT_EQ(writer.Close(), OkStatus());
+
+  MmapFileReader reader;
+  ASSERT_EQ(reader.Open(path()), OkStatus());
+  constexpr auto kExpected =
+      bytes::Array<0x01, 0x01, 0x03, 0x04, 0x05, 0x06, 0x01>();
+  ASSERT_EQ(reader.data().size(), kExpected.size());
+  EXPECT_EQ(
+      std::memcmp(reader.data().data(), kExpected.data(), kExpected.size()),
+      0);
+}
+
+TEST_F(PosixFileStreamTest, WriteWithoutFile) {
+  std::array<std::byte, 4> buffer;
+  FileWriter writer(buffer);
+  EXPECT_EQ(writer.Write(kData), Status::FailedPrecondition());
+  EXPECT_EQ(writer.Flush(), Status::FailedPrecondition());
+  EXPECT_EQ(writer.Close(), OkStatus());
+}
+
+}  // namespace
+}  // namespace pw::stream
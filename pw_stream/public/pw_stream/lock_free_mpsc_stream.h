@@ -0,0 +1,187 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+/// @file
+/// This file defines a multi-producer, single-consumer stream that writers
+/// append to without taking a lock.
+///
+/// Unlike `MpscWriter`, a `LockFreeMpscWriter` never waits for the reader. It
+/// reserves space in the reader's ring buffer with a single atomic operation,
+/// copies its data into the reserved space, and then publishes it. If there is
+/// not enough space, the write fails immediately. The reader drains contiguous
+/// runs of published data in place, using `PeekContiguous()` and `Consume()`,
+/// or copies it out using `Read()`.
+///
+/// Example:
+///
+/// @code{.cpp}
+///    BufferedLockFreeMpscReader<1024> reader;
+///
+///    void WriteThreadRoutine() {
+///      LockFreeMpscWriter writer = reader.GetWriter();
+///      writer.Write(GenerateSomeData()).IgnoreError();
+///    }
+///
+///    void ReadThreadRoutine() {
+///      while (true) {
+///        ConstByteSpan data = reader.PeekContiguous();
+///        ProcessSomeData(data);
+///        reader.Consume(data.size());
+///      }
+///    }
+/// @endcode
+///
+/// Data is published in the order it was reserved. A writer that is preempted
+/// between reserving and publishing briefly delays writers that reserved after
+/// it, which yield until it finishes copying its data. Writers that may
+/// preempt one another should therefore not run at strictly higher priorities
+/// than each other, and writes should never be made from interrupts.
+///
+/// Each `Write()` is published contiguously, but writes from different writers
+/// may be interleaved in any order. Writers that need their data to be read as
+/// a unit should write it in one call.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+
+// The alignment of the writers' and the reader's positions in the ring buffer.
+// These are updated independently, so by default each is padded to a typical
+// cache line size to avoid false sharing. Targets without data caches may set
+// this to 4 to save RAM.
+#ifndef PW_STREAM_LOCK_FREE_MPSC_ALIGNMENT
+#define PW_STREAM_LOCK_FREE_MPSC_ALIGNMENT 64
+#endif  // PW_STREAM_LOCK_FREE_MPSC_ALIGNMENT
+
+namespace pw::stream {
+
+class LockFreeMpscReader;
+
+/// Writer for a lock-free multi-producer, single-consumer stream.
+///
+/// Writers are obtained from `LockFreeMpscReader::GetWriter()` and may be
+/// freely copied. Unlike `MpscWriter`, a single writer may be used by several
+/// threads at once. A default-constructed writer is not connected, and its
+/// writes fail with @pw_status{FAILED_PRECONDITION}.
+///
+/// The reader must outlive all of its writers.
+class LockFreeMpscWriter : public NonSeekableWriter {
+ public:
+  constexpr LockFreeMpscWriter() = default;
+
+  LockFreeMpscWriter(const LockFreeMpscWriter&) = default;
+  LockFreeMpscWriter& operator=(const LockFreeMpscWriter&) = default;
+
+  /// Returns whether this object is connected to a reader.
+  bool connected() const { return reader_ != nullptr; }
+
+ private:
+  friend class LockFreeMpscReader;
+
+  explicit constexpr LockFreeMpscWriter(LockFreeMpscReader& reader)
+      : reader_(&reader) {}
+
+  /// @copydoc Stream::ConservativeLimit
+  size_t ConservativeLimit(LimitType type) const override;
+
+  /// @copydoc Stream::DoWrite
+  ///
+  /// @retval OK                  The data was published to the reader.
+  /// @retval FAILED_PRECONDITION The writer is not connected.
+  /// @retval RESOURCE_EXHAUSTED  There was not enough space for the data. No
+  ///                             data was written.
+  Status DoWrite(ConstByteSpan data) override;
+
+  LockFreeMpscReader* reader_ = nullptr;
+};
+
+/// Reader of a lock-free multi-producer, single-consumer stream.
+///
+/// The reader owns the ring buffer that writers append to. It does not block:
+/// `Read()` returns @pw_status{RESOURCE_EXHAUSTED} when no data is available,
+/// so it is typically polled, or signalled by some other means.
+///
+/// Only one thread may read from the stream at a time.
+class LockFreeMpscReader : public NonSeekableReader {
+ public:
+  /// Creates a reader that buffers written data in `buffer`. The buffer must
+  /// be no larger than half of the largest `size_t`.
+  explicit LockFreeMpscReader(ByteSpan buffer);
+
+  LockFreeMpscReader(const LockFreeMpscReader&) = delete;
+  LockFreeMpscReader& operator=(const LockFreeMpscReader&) = delete;
+
+  /// Returns a writer connected to this reader.
+  LockFreeMpscWriter GetWriter() { return LockFreeMpscWriter(*this); }
+
+  /// Returns the size of the ring buffer.
+  size_t capacity() const { return buffer_.size(); }
+
+  /// Returns the longest contiguous run of data that has been published and
+  /// not yet consumed. The data remains valid until it is consumed. Data that
+  /// wraps around the end of the ring buffer is returned by a subsequent call,
+  /// once the first run has been consumed.
+  ConstByteSpan PeekContiguous() const;
+
+  /// Releases the first `num_bytes` of published data back to the writers.
+  ///
+  /// @pre `num_bytes` is no larger than the amount of published data.
+  void Consume(size_t num_bytes);
+
+ private:
+  friend class LockFreeMpscWriter;
+
+  /// @copydoc Stream::ConservativeLimit
+  size_t ConservativeLimit(LimitType type) const override;
+
+  /// @copydoc Stream::DoRead
+  StatusWithSize DoRead(ByteSpan destination) override;
+
+  /// Reserves space for, copies, and publishes data from a writer.
+  Status WriteData(ConstByteSpan data);
+
+  // Positions in the ring buffer are kept in the range [0, 2 * capacity), so
+  // that a full ring can be distinguished from an empty one.
+  size_t Advance(size_t position, size_t num_bytes) const;
+  size_t Distance(size_t from, size_t to) const;
+  size_t Index(size_t position) const;
+
+  const ByteSpan buffer_;
+
+  // Writers reserve space by advancing `reserved_`, and then publish it by
+  // advancing `published_`, in order. The reader consumes data by advancing
+  // `consumed_`.
+  alignas(PW_STREAM_LOCK_FREE_MPSC_ALIGNMENT) std::atomic<size_t> reserved_{0};
+  std::atomic<size_t> published_{0};
+  alignas(PW_STREAM_LOCK_FREE_MPSC_ALIGNMENT) std::atomic<size_t> consumed_{0};
+};
+
+/// Reader for a lock-free multi-producer, single-consumer stream, which
+/// includes an explicitly-sized buffer.
+template <size_t kCapacity>
+class BufferedLockFreeMpscReader : public LockFreeMpscReader {
+ public:
+  BufferedLockFreeMpscReader() : LockFreeMpscReader(buffer_) {}
+
+ private:
+  std::array<std::byte, kCapacity> buffer_;
+};
+
+}  // namespace pw::stream
@@ -0,0 +1,146 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+
+namespace pw::stream {
+
+/// `SeekableReader` for a file, which maps the entire file into memory.
+///
+/// Unlike `StdFileReader`, reads do not go through an iostream, and the file's
+/// contents may be accessed in place with `data()` or `ReadInPlace()`, without
+/// copying. This suits host tools that process large files, such as
+/// tokenized log captures or snapshots.
+///
+/// The file must not be truncated while it is mapped.
+class MmapFileReader final : public SeekableReader {
+ public:
+  constexpr MmapFileReader() = default;
+
+  MmapFileReader(const MmapFileReader&) = delete;
+  MmapFileReader& operator=(const MmapFileReader&) = delete;
+
+  MmapFileReader(MmapFileReader&& other) noexcept;
+  MmapFileReader& operator=(MmapFileReader&& other) noexcept;
+
+  ~MmapFileReader() override { Close(); }
+
+  /// Maps the file at `path` into memory, and positions the reader at its
+  /// start.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - The file was mapped.
+  /// * @pw_status{FAILED_PRECONDITION} - A file is already open.
+  /// * @pw_status{NOT_FOUND} - The file does not exist.
+  /// * @pw_status{PERMISSION_DENIED} - The file could not be opened for
+  ///   reading.
+  /// * @pw_status{UNKNOWN} - Another error was returned by the operating
+  ///   system.
+  Status Open(const char* path);
+
+  /// Unmaps the file. Spans returned by `data()` and `ReadInPlace()` are no
+  /// longer valid.
+  void Close();
+
+  /// Returns the entire contents of the file.
+  ConstByteSpan data() const { return ConstByteSpan(data_, size_); }
+
+  /// Returns up to `max_bytes` of the file at the current position without
+  /// copying them, and advances the position past them. Returns an empty span
+  /// at the end of the file.
+  ConstByteSpan ReadInPlace(size_t max_bytes);
+
+ private:
+  StatusWithSize DoRead(ByteSpan dest) override;
+  Status DoSeek(ptrdiff_t offset, Whence origin) override;
+  size_t DoTell() override { return position_; }
+  size_t ConservativeLimit(LimitType limit) const override;
+
+  const std::byte* data_ = nullptr;
+  size_t size_ = 0;
+  size_t position_ = 0;
+};
+
+/// `SeekableWriter` for a file, which buffers writes and issues them to the
+/// file with `pwrite`.
+///
+/// Writes are collected in a caller-provided buffer, so that many small writes
+/// become a few large system calls. Writes at least as large as the buffer go
+/// directly to the file. Buffered data is written to the file when the buffer
+/// fills, and by `Flush()`, `Seek()`, and `Close()`.
+class FileWriter final : public SeekableWriter {
+ public:
+  /// Creates a writer that buffers data in `buffer`. The buffer must remain
+  /// valid for the lifetime of the writer.
+  explicit constexpr FileWriter(ByteSpan buffer) : buffer_(buffer) {}
+
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+
+  /// Flushes and closes the file, ignoring any errors. Call `Close()` to check
+  /// for errors.
+  ~FileWriter() override { Close().IgnoreError(); }
+
+  /// Creates or truncates the file at `path`, and positions the writer at its
+  /// start.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - The file was opened.
+  /// * @pw_status{FAILED_PRECONDITION} - A file is already open.
+  /// * @pw_status{NOT_FOUND} - The file's directory does not exist.
+  /// * @pw_status{PERMISSION_DENIED} - The file could not be opened for
+  ///   writing.
+  /// * @pw_status{UNKNOWN} - Another error was returned by the operating
+  ///   system.
+  Status Open(const char* path);
+
+  /// Writes any buffered data to the file.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - All buffered data was written.
+  /// * @pw_status{FAILED_PRECONDITION} - No file is open.
+  /// * @pw_status{UNKNOWN} - An error was returned by the operating system.
+  ///   The buffered data is dropped.
+  Status Flush();
+
+  /// Flushes any buffered data and closes the file. Does nothing if no file
+  /// is open.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - The file was closed, or none was open.
+  /// * @pw_status{UNKNOWN} - An error was returned by the operating system.
+  Status Close();
+
+ private:
+  Status DoWrite(ConstByteSpan data) override;
+  Status DoSeek(ptrdiff_t offset, Whence origin) override;
+  size_t DoTell() override { return position_; }
+
+  // Writes all of `data` to the file at `offset`.
+  Status WriteAt(ConstByteSpan data, size_t offset);
+
+  static constexpr int kInvalidFd = -1;
+
+  const ByteSpan buffer_;
+  int fd_ = kInvalidFd;
+  size_t buffered_ = 0;
+  size_t position_ = 0;
+};
+
+}  // namespace pw::stream
@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "pw_result/result.h"
@@ -58,9 +59,23 @@ class SocketStream : public NonSeekableReaderWriter {
   // Close the socket stream and release all resources
   void Close();
 
+  // Writes the contents of several buffers, in order, as if they were a
+  // single contiguous buffer. Where supported, the buffers are handed to the
+  // kernel with sendmsg() instead of being copied into one buffer first, e.g.
+  // when sending the chunks of a pw::multibuf::MultiBuf.
+  Status WriteV(span<const ConstByteSpan> buffers);
+
+  // Reads into several buffers, in order, filling each before the next. Like
+  // Read(), this blocks until data is available and may return fewer bytes
+  // than the buffers can hold.
+  StatusWithSize ReadV(span<const ByteSpan> buffers);
+
  private:
   static constexpr int kInvalidFd = -1;
 
+  // Maximum number of buffers passed to the kernel in a single call.
+  static constexpr size_t kMaxIovecs = 16;
+
   class ConnectionOwnership {
    public:
     explicit ConnectionOwnership(SocketStream* socket_stream)
@@ -27,15 +27,18 @@
 #include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif  // defined(_WIN32) && _WIN32
 
+#include <array>
 #include <cerrno>
 #include <cstring>
 
 #include "pw_assert/check.h"
 #include "pw_log/log.h"
 #include "pw_status/status.h"
+#include "pw_status/try.h"
 #include "pw_string/to_string.h"
 
 namespace pw::stream {
@@ -254,6 +257,134 @@ StatusWithSize SocketStream::DoRead(ByteSpan dest) {
   return StatusWithSize(bytes_rcvd);
 }
 
+Status SocketStream::WriteV(span<const ConstByteSpan> buffers) {
+#if defined(_WIN32) && _WIN32
+  // sendmsg() is not available; write each buffer in turn.
+  for (ConstByteSpan buffer : buffers) {
+    if (!buffer.empty()) {
+      PW_TRY(DoWrite(buffer));
+    }
+  }
+  return OkStatus();
+#else
+  int send_flags = 0;
+#if defined(__linux__)
+  send_flags |= MSG_NOSIGNAL;
+#endif  // defined(__linux__)
+
+  ConnectionOwnership ownership(this);
+  if (ownership.fd() == kInvalidFd) {
+    return Status::Unknown();
+  }
+
+  // Position of the next byte to send.
+  size_t index = 0;
+  size_t offset = 0;
+  while (index < buffers.size()) {
+    std::array<iovec, kMaxIovecs> iov;
+    size_t count = 0;
+    for (size_t i = index; i < buffers.size() && count < iov.size(); ++i) {
+      ConstByteSpan buffer = buffers[i];
+      if (i == index) {
+        buffer = buffer.subspan(offset);
+      }
+      if (buffer.empty()) {
+        continue;
+      }
+      iov[count].iov_base = const_cast<std::byte*>(buffer.data());
+      iov[count].iov_len = buffer.size();
+      ++count;
+    }
+    if (count == 0) {
+      break;
+    }
+
+    msghdr msg = {};
+    msg.msg_iov = iov.data();
+    msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(count);
+    ssize_t bytes_sent = sendmsg(ownership.fd(), &msg, send_flags);
+    if (bytes_sent < 0) {
+      return errno == EPIPE ? Status::OutOfRange() : Status::Unknown();
+    }
+
+    // The kernel may accept fewer bytes than requested; resume after the last
+    // byte it took.
+    size_t remaining = static_cast<size_t>(bytes_sent);
+    while (index < buffers.size()) {
+      size_t available = buffers[index].size() - offset;
+      if (remaining < available) {
+        offset += remaining;
+        break;
+      }
+      remaining -= available;
+      ++index;
+      offset = 0;
+    }
+  }
+  return OkStatus();
+#endif  // defined(_WIN32) && _WIN32
+}
+
+StatusWithSize SocketStream::ReadV(span<const ByteSpan> buffers) {
+#if defined(_WIN32) && _WIN32
+  // recvmsg() is not available; read into the first non-empty buffer.
+  for (ByteSpan buffer : buffers) {
+    if (!buffer.empty()) {
+      return DoRead(buffer);
+    }
+  }
+  return StatusWithSize(0);
+#else
+  std::array<iovec, kMaxIovecs> iov;
+  size_t count = 0;
+  for (ByteSpan buffer : buffers) {
+    if (count == iov.size()) {
+      break;
+    }
+    if (!buffer.empty()) {
+      iov[count].iov_base = buffer.data();
+      iov[count].iov_len = buffer.size();
+      ++count;
+    }
+  }
+  if (count == 0) {
+    return StatusWithSize(0);
+  }
+
+  ConnectionOwnership ownership(this);
+  if (ownership.fd() == kInvalidFd) {
+    return StatusWithSize::Unknown();
+  }
+
+  // Wait for data to read or a tear down notification.
+  pollfd fds_to_poll[2];
+  fds_to_poll[0].fd = ownership.fd();
+  fds_to_poll[0].events = POLLIN | POLLERR | POLLHUP;
+  fds_to_poll[1].fd = ownership.pipe_r_fd();
+  fds_to_poll[1].events = POLLIN;
+  poll(fds_to_poll, 2, -1);
+  if (!(fds_to_poll[0].revents & POLLIN)) {
+    return StatusWithSize::Unknown();
+  }
+
+  msghdr msg = {};
+  msg.msg_iov = iov.data();
+  msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(count);
+  ssize_t bytes_rcvd = recvmsg(ownership.fd(), &msg, 0);
+  if (bytes_rcvd == 0) {
+    // Remote peer has closed the connection.
+    Close();
+    return StatusWithSize::OutOfRange();
+  } else if (bytes_rcvd < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return StatusWithSize::ResourceExhausted();
+    }
+    return StatusWithSize::Unknown();
+  }
+  return StatusWithSize(bytes_rcvd);
+#endif  // defined(_WIN32) && _WIN32
+}
+
 int SocketStream::TakeConnection() {
   std::lock_guard lock(connection_mutex_);
   return TakeConnectionWithLockHeld();
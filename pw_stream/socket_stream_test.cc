@@ -14,6 +14,9 @@
 
 #include "pw_stream/socket_stream.h"
 
+#include <algorithm>
+#include <array>
+#include <string_view>
 #include <thread>
 
 #include "pw_result/result.h"
@@ -136,6 +139,63 @@ TEST(SocketStreamTest, ReadWrite) {
   server.Close();
 }
 
+TEST(SocketStreamTest, WriteVReadV) {
+  ServerSocket server;
+  EXPECT_EQ(server.Listen(), OkStatus());
+
+  Result<SocketStream> server_stream = Status::Unavailable();
+  auto accept_thread = std::thread{[&]() { server_stream = server.Accept(); }};
+
+  SocketStream client;
+  EXPECT_EQ(client.Connect("localhost", server.port()), OkStatus());
+
+  accept_thread.join();
+  ASSERT_EQ(server_stream.status(), OkStatus());
+
+  // Empty buffers are skipped.
+  constexpr std::string_view kExpected = "some data, other bytes";
+  auto kPayload1 = as_bytes(span("some data", 9));
+  auto kPayload2 = as_bytes(span(", ", 2));
+  auto kPayload3 = as_bytes(span("other bytes", 11));
+  std::array<ConstByteSpan, 4> payloads = {
+      kPayload1, ConstByteSpan(), kPayload2, kPayload3};
+  EXPECT_EQ(client.WriteV(payloads), OkStatus());
+
+  // Read the payload back and split it across several buffers.
+  std::array<char, 5> read_buffer1{};
+  std::array<char, 7> read_buffer2{};
+  std::array<char, 20> read_buffer3{};
+  std::array<ByteSpan, 3> buffers = {as_writable_bytes(span(read_buffer1)),
+                                     as_writable_bytes(span(read_buffer2)),
+                                     as_writable_bytes(span(read_buffer3))};
+  size_t total = 0;
+  while (total < kExpected.size()) {
+    std::array<ByteSpan, 3> remaining;
+    size_t skip = total;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      size_t n = std::min(skip, buffers[i].size());
+      remaining[i] = buffers[i].subspan(n);
+      skip -= n;
+    }
+    StatusWithSize result = server_stream->ReadV(remaining);
+    ASSERT_EQ(result.status(), OkStatus());
+    total += result.size();
+  }
+  EXPECT_EQ(total, kExpected.size());
+
+  std::string_view view1(read_buffer1.data(), read_buffer1.size());
+  std::string_view view2(read_buffer2.data(), read_buffer2.size());
+  std::string_view view3(read_buffer3.data(),
+                         total - view1.size() - view2.size());
+  EXPECT_EQ(view1, kExpected.substr(0, 5));
+  EXPECT_EQ(view2, kExpected.substr(5, 7));
+  EXPECT_EQ(view3, kExpected.substr(12));
+
+  client.Close();
+  server_stream->Close();
+  server.Close();
+}
+
 TEST(SocketStreamTest, MultipleClients) {
   ServerSocket server;
   EXPECT_EQ(server.Listen(), OkStatus());
@@ -13,8 +13,12 @@
 // the License.
 #pragma once
 
+#include <sys/types.h>
+
+#include <cstddef>
 #include <cstdint>
 
+#include "pw_chrono/system_clock.h"
 #include "pw_result/result.h"
 #include "pw_span/span.h"
 #include "pw_stream/stream.h"
@@ -24,15 +28,42 @@ namespace pw::stream {
 /// `pw::stream::NonSeekableReaderWriter` implementation for UARTs on Linux.
 class UartStreamLinux : public NonSeekableReaderWriter {
  public:
+  /// Configuration of the TTY device, applied by `Open`.
+  struct Config {
+    /// Baud rate to use for the device.
+    uint32_t baud_rate;
+
+    /// The minimum number of bytes a blocking read waits for (`VMIN`). Larger
+    /// values let the kernel deliver bursts of data with a single wakeup.
+    uint8_t min_read_bytes = 1;
+
+    /// Time to wait between bytes, in tenths of a second, before a blocking
+    /// read returns with fewer than `min_read_bytes` (`VTIME`). With
+    /// `min_read_bytes` of 0, this is the time to wait for the first byte.
+    uint8_t read_timeout_deciseconds = 0;
+
+    /// Asks the serial driver to push received data to readers immediately
+    /// rather than batching it (`ASYNC_LOW_LATENCY`). Drivers that do not
+    /// support this setting ignore it.
+    bool low_latency = false;
+
+    /// Opens the device with `O_NONBLOCK`. Reads return
+    /// @pw_status{RESOURCE_EXHAUSTED} when no data is available instead of
+    /// blocking. Use `fd()` or `TryReadFor` to wait for data.
+    bool non_blocking = false;
+  };
+
   constexpr UartStreamLinux() = default;
 
   // UartStream objects are moveable but not copyable.
   UartStreamLinux& operator=(UartStreamLinux&& other) {
     fd_ = other.fd_;
+    non_blocking_ = other.non_blocking_;
     other.fd_ = kInvalidFd;
     return *this;
   }
-  UartStreamLinux(UartStreamLinux&& other) noexcept : fd_(other.fd_) {
+  UartStreamLinux(UartStreamLinux&& other) noexcept
+      : fd_(other.fd_), non_blocking_(other.non_blocking_) {
     other.fd_ = kInvalidFd;
   }
   UartStreamLinux(const UartStreamLinux&) = delete;
@@ -51,15 +82,74 @@ class UartStreamLinux : public NonSeekableReaderWriter {
   /// * @pw_status{FAILED_PRECONDITION} - A device was already open.
   /// * @pw_status{UNKNOWN} - An error was returned by the operating system.
   Status Open(const char* path, uint32_t baud_rate);
+
+  /// Open a UART device using the specified configuration.
+  ///
+  /// @param[in] path Path to the TTY device.
+  /// @param[in] config Configuration to apply to the device.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - The device was successfully opened and configured.
+  /// * @pw_status{INVALID_ARGUMENT} - An unsupported baud rate was supplied.
+  /// * @pw_status{FAILED_PRECONDITION} - A device was already open.
+  /// * @pw_status{UNKNOWN} - An error was returned by the operating system.
+  Status Open(const char* path, const Config& config);
   void Close();
 
+  /// Returns the file descriptor of the open device, or -1 if none is open.
+  ///
+  /// The descriptor may be waited on for readability with `poll`, `epoll`, or
+  /// an `epoll`-based `pw::async2::Dispatcher`, so that reads only happen once
+  /// data is available. This is most useful with `Config::non_blocking`.
+  int fd() const { return fd_; }
+
+  /// Reads as many bytes as are available, up to the size of `dest`, waiting
+  /// up to `timeout` for the first byte to arrive.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - Returns the number of bytes read.
+  /// * @pw_status{DEADLINE_EXCEEDED} - No data arrived before the timeout.
+  /// * @pw_status{FAILED_PRECONDITION} - No device is open.
+  /// * @pw_status{UNKNOWN} - An error was returned by the operating system.
+  StatusWithSize TryReadFor(ByteSpan dest,
+                            chrono::SystemClock::duration timeout);
+
+  /// Writes the contents of several buffers, in order, using `writev` instead
+  /// of first copying them into a single contiguous buffer.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - All of the data was written.
+  /// * @pw_status{UNKNOWN} - An error was returned by the operating system.
+  Status WriteV(span<const ConstByteSpan> buffers);
+
+  /// Reads into several buffers, in order, using `readv`. As with `Read`, this
+  /// may return fewer bytes than the buffers can hold.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - Returns the number of bytes read.
+  /// * @pw_status{RESOURCE_EXHAUSTED} - The device was opened with
+  ///   `Config::non_blocking` and no data is available.
+  /// * @pw_status{UNKNOWN} - An error was returned by the operating system.
+  StatusWithSize ReadV(span<const ByteSpan> buffers);
+
  private:
   static constexpr int kInvalidFd = -1;
 
+  // Maximum number of buffers passed to the kernel in a single call.
+  static constexpr size_t kMaxIovecs = 16;
+
   Status DoWrite(ConstByteSpan data) override;
   StatusWithSize DoRead(ByteSpan dest) override;
 
+  // Converts the result of a read call to a status.
+  StatusWithSize ReadResult(ssize_t bytes);
+
+  // Waits for the device to accept more data after a non-blocking write would
+  // have blocked.
+  Status WaitForWritable();
+
   int fd_ = kInvalidFd;
+  bool non_blocking_ = false;
 };
 
 }  // namespace pw::stream
@@ -15,13 +15,23 @@
 #include "pw_stream_uart_linux/stream.h"
 
 #include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <termios.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
+#include <chrono>
 #include <cinttypes>
+#include <cstring>
+#include <limits>
 
 #include "pw_log/log.h"
+#include "pw_status/try.h"
 
 namespace pw::stream {
 
@@ -68,28 +78,14 @@ Result<speed_t> BaudRateToSpeed(uint32_t baud_rate) {
   }
 }
 
-Status UartStreamLinux::Open(const char* path, uint32_t baud_rate) {
-  const auto speed_result = BaudRateToSpeed(baud_rate);
-  if (!speed_result.ok()) {
-    PW_LOG_ERROR("Unsupported baud rate: %" PRIu32, baud_rate);
-    return speed_result.status();
-  }
-  speed_t speed = speed_result.value();
-
-  if (fd_ != kInvalidFd) {
-    PW_LOG_ERROR("UART device already open");
-    return Status::FailedPrecondition();
-  }
-
-  fd_ = open(path, O_RDWR);
-  if (fd_ < 0) {
-    PW_LOG_ERROR(
-        "Failed to open UART device '%s', %s", path, std::strerror(errno));
-    return Status::Unknown();
-  }
+namespace {
 
+Status ConfigureTty(int fd,
+                    const char* path,
+                    speed_t speed,
+                    const UartStreamLinux::Config& config) {
   struct termios tty;
-  int result = tcgetattr(fd_, &tty);
+  int result = tcgetattr(fd, &tty);
   if (result < 0) {
     PW_LOG_ERROR("Failed to get TTY attributes for '%s', %s",
                  path,
@@ -104,8 +100,10 @@ Status UartStreamLinux::Open(const char* path, uint32_t baud_rate) {
         "Failed to set TTY speed for '%s', %s", path, std::strerror(errno));
     return Status::Unknown();
   }
+  tty.c_cc[VMIN] = config.min_read_bytes;
+  tty.c_cc[VTIME] = config.read_timeout_deciseconds;
 
-  result = tcsetattr(fd_, TCSANOW, &tty);
+  result = tcsetattr(fd, TCSANOW, &tty);
   if (result < 0) {
     PW_LOG_ERROR("Failed to set TTY attributes for '%s', %s",
                  path,
@@ -113,9 +111,72 @@ Status UartStreamLinux::Open(const char* path, uint32_t baud_rate) {
     return Status::Unknown();
   }
 
+  if (config.low_latency) {
+    struct serial_struct serial;
+    if (ioctl(fd, TIOCGSERIAL, &serial) == 0) {
+      serial.flags |= ASYNC_LOW_LATENCY;
+      result = ioctl(fd, TIOCSSERIAL, &serial);
+    } else {
+      result = -1;
+    }
+    if (result < 0) {
+      PW_LOG_WARN("Low latency mode is not supported by '%s', %s",
+                  path,
+                  std::strerror(errno));
+    }
+  }
+
   return OkStatus();
 }
 
+// Returns the poll() timeout for waiting until `deadline`, rounded up to whole
+// milliseconds so that a short wait does not become a non-blocking check.
+int PollTimeoutMs(chrono::SystemClock::time_point deadline) {
+  const int64_t remaining_ms =
+      std::chrono::ceil<std::chrono::milliseconds>(
+          deadline - chrono::SystemClock::now())
+          .count();
+  return static_cast<int>(
+      std::clamp<int64_t>(remaining_ms, 0, std::numeric_limits<int>::max()));
+}
+
+}  // namespace
+
+Status UartStreamLinux::Open(const char* path, uint32_t baud_rate) {
+  Config config;
+  config.baud_rate = baud_rate;
+  return Open(path, config);
+}
+
+Status UartStreamLinux::Open(const char* path, const Config& config) {
+  const auto speed_result = BaudRateToSpeed(config.baud_rate);
+  if (!speed_result.ok()) {
+    PW_LOG_ERROR("Unsupported baud rate: %" PRIu32, config.baud_rate);
+    return speed_result.status();
+  }
+  speed_t speed = speed_result.value();
+
+  if (fd_ != kInvalidFd) {
+    PW_LOG_ERROR("UART device already open");
+    return Status::FailedPrecondition();
+  }
+
+  const int flags = O_RDWR | (config.non_blocking ? O_NONBLOCK : 0);
+  fd_ = open(path, flags);
+  if (fd_ < 0) {
+    PW_LOG_ERROR(
+        "Failed to open UART device '%s', %s", path, std::strerror(errno));
+    return Status::Unknown();
+  }
+  non_blocking_ = config.non_blocking;
+
+  Status status = ConfigureTty(fd_, path, speed, config);
+  if (!status.ok()) {
+    Close();
+  }
+  return status;
+}
+
 void UartStreamLinux::Close() {
   if (fd_ != kInvalidFd) {
     close(fd_);
@@ -123,27 +184,156 @@ void UartStreamLinux::Close() {
   }
 }
 
+Status UartStreamLinux::WaitForWritable() {
+  pollfd pfd = {fd_, POLLOUT, 0};
+  while (poll(&pfd, 1, -1) < 0) {
+    if (errno != EINTR) {
+      PW_LOG_ERROR("Failed to wait for UART, %s", std::strerror(errno));
+      return Status::Unknown();
+    }
+  }
+  return OkStatus();
+}
+
 Status UartStreamLinux::DoWrite(ConstByteSpan data) {
   const size_t size = data.size_bytes();
   size_t written = 0;
   while (written < size) {
-    int bytes = write(fd_, &data[written], size - written);
+    ssize_t bytes = write(fd_, &data[written], size - written);
     if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN && non_blocking_) {
+        PW_TRY(WaitForWritable());
+        continue;
+      }
       PW_LOG_ERROR("Failed to write to UART, %s", std::strerror(errno));
       return Status::Unknown();
     }
-    written += bytes;
+    written += static_cast<size_t>(bytes);
   }
   return OkStatus();
 }
 
-StatusWithSize UartStreamLinux::DoRead(ByteSpan dest) {
-  int bytes = read(fd_, &dest[0], dest.size_bytes());
+StatusWithSize UartStreamLinux::ReadResult(ssize_t bytes) {
   if (bytes < 0) {
+    if (errno == EAGAIN) {
+      return StatusWithSize::ResourceExhausted();
+    }
     PW_LOG_ERROR("Failed to read from UART, %s", std::strerror(errno));
     return StatusWithSize::Unknown();
   }
-  return StatusWithSize(bytes);
+  return StatusWithSize(static_cast<size_t>(bytes));
+}
+
+StatusWithSize UartStreamLinux::DoRead(ByteSpan dest) {
+  ssize_t bytes;
+  do {
+    bytes = read(fd_, dest.data(), dest.size_bytes());
+  } while (bytes < 0 && errno == EINTR);
+  return ReadResult(bytes);
+}
+
+StatusWithSize UartStreamLinux::TryReadFor(
+    ByteSpan dest, chrono::SystemClock::duration timeout) {
+  if (fd_ == kInvalidFd) {
+    return StatusWithSize::FailedPrecondition();
+  }
+
+  const auto deadline = chrono::SystemClock::TimePointAfterAtLeast(timeout);
+  pollfd pfd = {fd_, POLLIN, 0};
+  int result;
+  do {
+    result = poll(&pfd, 1, PollTimeoutMs(deadline));
+  } while (result < 0 && errno == EINTR);
+  if (result < 0) {
+    PW_LOG_ERROR("Failed to wait for UART, %s", std::strerror(errno));
+    return StatusWithSize::Unknown();
+  }
+  if (result == 0) {
+    return StatusWithSize::DeadlineExceeded();
+  }
+
+  // Data is available, so this read does not block, even if the device was
+  // not opened with O_NONBLOCK.
+  return DoRead(dest);
+}
+
+Status UartStreamLinux::WriteV(span<const ConstByteSpan> buffers) {
+  // Position of the next byte to write.
+  size_t index = 0;
+  size_t offset = 0;
+  while (index < buffers.size()) {
+    std::array<iovec, kMaxIovecs> iov;
+    size_t count = 0;
+    for (size_t i = index; i < buffers.size() && count < kMaxIovecs; ++i) {
+      ConstByteSpan buffer = buffers[i];
+      if (i == index) {
+        buffer = buffer.subspan(offset);
+      }
+      if (buffer.empty()) {
+        continue;
+      }
+      iov[count].iov_base = const_cast<std::byte*>(buffer.data());
+      iov[count].iov_len = buffer.size();
+      ++count;
+    }
+    if (count == 0) {
+      break;
+    }
+
+    ssize_t bytes = writev(fd_, iov.data(), static_cast<int>(count));
+    if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN && non_blocking_) {
+        PW_TRY(WaitForWritable());
+        continue;
+      }
+      PW_LOG_ERROR("Failed to write to UART, %s", std::strerror(errno));
+      return Status::Unknown();
+    }
+
+    // Resume after the last byte written.
+    size_t remaining = static_cast<size_t>(bytes);
+    while (index < buffers.size()) {
+      size_t available = buffers[index].size() - offset;
+      if (remaining < available) {
+        offset += remaining;
+        break;
+      }
+      remaining -= available;
+      ++index;
+      offset = 0;
+    }
+  }
+  return OkStatus();
+}
+
+StatusWithSize UartStreamLinux::ReadV(span<const ByteSpan> buffers) {
+  std::array<iovec, kMaxIovecs> iov;
+  size_t count = 0;
+  for (ByteSpan buffer : buffers) {
+    if (count == kMaxIovecs) {
+      break;
+    }
+    if (!buffer.empty()) {
+      iov[count].iov_base = buffer.data();
+      iov[count].iov_len = buffer.size();
+      ++count;
+    }
+  }
+  if (count == 0) {
+    return StatusWithSize(0);
+  }
+
+  ssize_t bytes;
+  do {
+    bytes = readv(fd_, iov.data(), static_cast<int>(count));
+  } while (bytes < 0 && errno == EINTR);
+  return ReadResult(bytes);
 }
 
 }  // namespace pw::stream
@@ -14,6 +14,14 @@
 
 #include "pw_stream_uart_linux/stream.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
 #include "public/pw_stream_uart_linux/stream.h"
 #include "pw_unit_test/framework.h"
 
@@ -35,5 +43,123 @@ TEST(UartStreamLinuxTest, TestOpenInvalidBaudRate) {
   EXPECT_EQ(status, Status::InvalidArgument());
 }
 
+TEST(UartStreamLinuxTest, TestOpenInvalidBaudRateWithConfig) {
+  UartStreamLinux uart;
+  UartStreamLinux::Config config;
+  config.baud_rate = 123456;
+  Status status = uart.Open(kPathNonUart, config);
+  EXPECT_EQ(status, Status::InvalidArgument());
+}
+
+TEST(UartStreamLinuxTest, TestFailedOpenClosesDevice) {
+  UartStreamLinux uart;
+  ASSERT_EQ(uart.Open(kPathNonUart, 115200), Status::Unknown());
+  EXPECT_EQ(uart.fd(), -1);
+}
+
+// Uses a pseudoterminal in place of a UART. The stream opens the subsidiary
+// side, and the test reads and writes the main side.
+class UartStreamLinuxPtyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    main_fd_ = posix_openpt(O_RDWR | O_NOCTTY);
+    ASSERT_GE(main_fd_, 0);
+    ASSERT_EQ(grantpt(main_fd_), 0);
+    ASSERT_EQ(unlockpt(main_fd_), 0);
+    path_ = ptsname(main_fd_);
+    ASSERT_NE(path_, nullptr);
+  }
+
+  void TearDown() override { close(main_fd_); }
+
+  void WriteToStream(ConstByteSpan data) {
+    ASSERT_EQ(write(main_fd_, data.data(), data.size()),
+              static_cast<ssize_t>(data.size()));
+  }
+
+  int main_fd_ = -1;
+  const char* path_ = nullptr;
+};
+
+constexpr std::array<std::byte, 4> kData = {
+    std::byte{0x7e}, std::byte{0x01}, std::byte{0x02}, std::byte{0x7e}};
+
+TEST_F(UartStreamLinuxPtyTest, TryReadForReadsAvailableData) {
+  UartStreamLinux uart;
+  UartStreamLinux::Config config;
+  config.baud_rate = 921600;
+  config.low_latency = true;  // Not supported by ptys, so this is ignored.
+  ASSERT_EQ(uart.Open(path_, config), OkStatus());
+
+  WriteToStream(kData);
+  std::array<std::byte, 16> buffer = {};
+  StatusWithSize result = uart.TryReadFor(buffer, std::chrono::seconds(5));
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.size(), kData.size());
+  EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), kData.size()), 0);
+}
+
+TEST_F(UartStreamLinuxPtyTest, TryReadForTimesOut) {
+  UartStreamLinux uart;
+  ASSERT_EQ(uart.Open(path_, 115200), OkStatus());
+
+  std::array<std::byte, 16> buffer = {};
+  StatusWithSize result =
+      uart.TryReadFor(buffer, std::chrono::milliseconds(10));
+  EXPECT_EQ(result.status(), Status::DeadlineExceeded());
+}
+
+TEST_F(UartStreamLinuxPtyTest, TryReadForWithoutDevice) {
+  UartStreamLinux uart;
+  std::array<std::byte, 16> buffer = {};
+  StatusWithSize result = uart.TryReadFor(buffer, std::chrono::seconds(0));
+  EXPECT_EQ(result.status(), Status::FailedPrecondition());
+}
+
+TEST_F(UartStreamLinuxPtyTest, NonBlockingReadWithoutData) {
+  UartStreamLinux uart;
+  UartStreamLinux::Config config;
+  config.baud_rate = 115200;
+  config.non_blocking = true;
+  ASSERT_EQ(uart.Open(path_, config), OkStatus());
+
+  std::array<std::byte, 16> buffer = {};
+  EXPECT_EQ(uart.Read(buffer).status(), Status::ResourceExhausted());
+
+  WriteToStream(kData);
+  ASSERT_EQ(uart.TryReadFor(buffer, std::chrono::seconds(5)).status(),
+            OkStatus());
+  EXPECT_EQ(uart.Read(buffer).status(), Status::ResourceExhausted());
+}
+
+TEST_F(UartStreamLinuxPtyTest, NonBlockingWrite) {
+  UartStreamLinux uart;
+  UartStreamLinux::Config config;
+  config.baud_rate = 115200;
+  config.non_blocking = true;
+  ASSERT_EQ(uart.Open(path_, config), OkStatus());
+
+  EXPECT_EQ(uart.Write(kData), OkStatus());
+  std::array<std::byte, 16> buffer = {};
+  ASSERT_EQ(read(main_fd_, buffer.data(), buffer.size()),
+            static_cast<ssize_t>(kData.size()));
+  EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), kData.size()), 0);
+}
+
+TEST_F(UartStreamLinuxPtyTest, ReadTimeoutWithoutMinReadBytes) {
+  UartStreamLinux uart;
+  UartStreamLinux::Config config;
+  config.baud_rate = 115200;
+  config.min_read_bytes = 0;
+  config.read_timeout_deciseconds = 1;
+  ASSERT_EQ(uart.Open(path_, config), OkStatus());
+
+  // With VMIN of 0, a blocking read returns once VTIME expires.
+  std::array<std::byte, 16> buffer = {};
+  Result<ByteSpan> result = uart.Read(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_TRUE(result->empty());
+}
+
 }  // namespace
 }  // namespace pw::stream
\ No newline at end of file
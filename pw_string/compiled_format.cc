@@ -0,0 +1,161 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_string/compiled_format.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_string/type_to_string.h"
+
+namespace pw::string::internal {
+
+void FormatWriter::Write(std::string_view text) {
+  // An empty string_view may have a null data(), which memcpy does not allow.
+  if (text.empty()) {
+    return;
+  }
+  if (buffer_.empty()) {
+    truncated_ = true;
+    return;
+  }
+
+  const size_t available = buffer_.size() - 1 - size_;
+  if (text.size() > available) {
+    truncated_ = true;
+    text = text.substr(0, available);
+  }
+  std::memcpy(buffer_.data() + size_, text.data(), text.size());
+  size_ += text.size();
+}
+
+void FormatWriter::Fill(char c, size_t count) {
+  if (buffer_.empty()) {
+    truncated_ = truncated_ || count != 0u;
+    return;
+  }
+
+  const size_t available = buffer_.size() - 1 - size_;
+  if (count > available) {
+    truncated_ = true;
+    count = available;
+  }
+  std::memset(buffer_.data() + size_, c, count);
+  size_ += count;
+}
+
+void FormatWriter::WritePadded(std::string_view prefix,
+                               std::string_view value,
+                               FormatSpec spec) {
+  const size_t size = prefix.size() + value.size();
+  const size_t padding = spec.width > size ? spec.width - size : 0u;
+
+  if (spec.left_align) {
+    Write(prefix);
+    Write(value);
+    Fill(' ', padding);
+  } else if (spec.zero_pad) {
+    Write(prefix);
+    Fill('0', padding);
+    Write(value);
+  } else {
+    Fill(' ', padding);
+    Write(prefix);
+    Write(value);
+  }
+}
+
+void FormatWriter::WriteSigned(int64_t value, FormatSpec spec) {
+  std::string_view sign;
+  if (value < 0) {
+    sign = "-";
+  } else if (spec.plus_sign) {
+    sign = "+";
+  }
+
+  // Negate as unsigned so that the minimum value does not overflow.
+  const uint64_t magnitude =
+      value < 0 ? 0u - static_cast<uint64_t>(value)
+                : static_cast<uint64_t>(value);
+  char digits[21];
+  const StatusWithSize result = IntToString(magnitude, digits);
+  WritePadded(sign, std::string_view(digits, result.size()), spec);
+}
+
+void FormatWriter::WriteUnsigned(uint64_t value, FormatSpec spec) {
+  char digits[21];
+  const StatusWithSize result = IntToString(value, digits);
+  WritePadded({}, std::string_view(digits, result.size()), spec);
+}
+
+void FormatWriter::WriteHex(uint64_t value, FormatSpec spec) {
+  const bool upper = spec.conversion == 'X';
+  char digits[17];
+  const StatusWithSize result = IntToHexString(value, digits);
+  if (upper) {
+    std::transform(digits, digits + result.size(), digits, [](char c) {
+      return c >= 'a' ? static_cast<char>(c - 'a' + 'A') : c;
+    });
+  }
+
+  // Like printf, the # flag does not add a 0x prefix to 0.
+  std::string_view prefix;
+  if (spec.alternate_form && value != 0u) {
+    prefix = upper ? "0X" : "0x";
+  }
+  WritePadded(prefix, std::string_view(digits, result.size()), spec);
+}
+
+void FormatWriter::WriteChar(char value, FormatSpec spec) {
+  WritePadded({}, std::string_view(&value, 1), spec);
+}
+
+void FormatWriter::WriteString(const char* value, FormatSpec spec) {
+  if (value == nullptr) {
+    WriteString(kNullPointerString, spec);
+    return;
+  }
+
+  if (spec.precision == FormatSpec::kNoPrecision) {
+    WritePadded({}, value, spec);
+    return;
+  }
+
+  // Only read up to the precision, since the string need not be null
+  // terminated.
+  size_t length = 0;
+  while (length < spec.precision && value[length] != '\0') {
+    length += 1;
+  }
+  WritePadded({}, std::string_view(value, length), spec);
+}
+
+void FormatWriter::WriteString(std::string_view value, FormatSpec spec) {
+  if (spec.precision != FormatSpec::kNoPrecision) {
+    value = value.substr(0, spec.precision);
+  }
+  WritePadded({}, value, spec);
+}
+
+StatusWithSize FormatWriter::Finish() {
+  if (buffer_.empty()) {
+    return StatusWithSize::ResourceExhausted();
+  }
+
+  buffer_[size_] = '\0';
+  return truncated_ ? StatusWithSize::ResourceExhausted(size_)
+                    : StatusWithSize(size_);
+}
+
+}  // namespace pw::string::internal
@@ -0,0 +1,240 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_string/compiled_format.h"
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "pw_compilation_testing/negative_compilation.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::string {
+namespace {
+
+using internal::CompileFormat;
+using internal::FormatError;
+
+// Compiles a format string literal, including its null terminator.
+template <size_t kSize>
+constexpr auto Compile(const char (&format)[kSize]) {
+  return CompileFormat<kSize>(std::string_view(format, kSize - 1));
+}
+
+static_assert(Compile("abc").error == FormatError::kNone);
+static_assert(Compile("abc").conversion_count == 0u);
+static_assert(Compile("a%%b").TextSize() == 3u);
+static_assert(Compile("%d and %-08lu").conversion_count == 2u);
+static_assert(Compile("%d and %-08lu").specs[1].left_align);
+static_assert(!Compile("%d and %-08lu").specs[1].zero_pad);
+static_assert(Compile("%d and %-08lu").specs[1].width == 8u);
+static_assert(Compile("%.5s").specs[0].precision == 5u);
+
+static_assert(Compile("%").error == FormatError::kIncompleteConversion);
+static_assert(Compile("%08").error == FormatError::kIncompleteConversion);
+static_assert(Compile("%f").error == FormatError::kUnsupportedConversion);
+static_assert(Compile("%n").error == FormatError::kUnsupportedConversion);
+static_assert(Compile("% d").error == FormatError::kUnsupportedFlag);
+static_assert(Compile("%+u").error == FormatError::kUnsupportedFlag);
+static_assert(Compile("%#d").error == FormatError::kUnsupportedFlag);
+static_assert(Compile("%05s").error == FormatError::kUnsupportedFlag);
+static_assert(Compile("%*d").error == FormatError::kUnsupportedWidth);
+static_assert(Compile("%256d").error == FormatError::kUnsupportedWidth);
+static_assert(Compile("%.*s").error == FormatError::kUnsupportedPrecision);
+static_assert(Compile("%.3d").error == FormatError::kUnsupportedPrecision);
+
+enum class Color : uint8_t { kRed = 1, kGreen = 2 };
+
+class CompiledFormatTest : public ::testing::Test {
+ protected:
+  CompiledFormatTest() : buffer_{} {}
+
+  std::string_view Result(StatusWithSize result) const {
+    return std::string_view(buffer_, result.size());
+  }
+
+  char buffer_[48];
+};
+
+TEST_F(CompiledFormatTest, NoArguments) {
+  auto result = PW_STRING_FORMAT(buffer_, "Hello, world!");
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("Hello, world!", Result(result));
+  EXPECT_STREQ("Hello, world!", buffer_);
+}
+
+TEST_F(CompiledFormatTest, Percent) {
+  auto result = PW_STRING_FORMAT(buffer_, "100%% of %d%%", 5);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("100% of 5%", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Integers) {
+  auto result = PW_STRING_FORMAT(
+      buffer_, "%d %i %u %lu", -12, int8_t{-128}, 42u, uint64_t{1});
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("-12 -128 42 1", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Integers_Limits) {
+  auto result = PW_STRING_FORMAT(buffer_,
+                                 "%lld %llu",
+                                 std::numeric_limits<int64_t>::min(),
+                                 std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("-9223372036854775808 18446744073709551615", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Integers_WidthAndFlags) {
+  auto result =
+      PW_STRING_FORMAT(buffer_, "[%5d|%-5d|%05d|%+d]", -42, 7, -3, 9);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("[  -42|7    |-0003|+9]", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Hex) {
+  auto result = PW_STRING_FORMAT(
+      buffer_, "%x %X %04x %#x %#x", 0xbeefu, 0xbeefu, 0xau, 0xau, 0u);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("beef BEEF 000a 0xa 0", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Hex_SignedIsWrittenAsUnsigned) {
+  auto result = PW_STRING_FORMAT(buffer_, "%x %x", int8_t{-1}, -2);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("ff fffffffe", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Enum) {
+  auto result = PW_STRING_FORMAT(buffer_, "%d", Color::kGreen);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("2", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Char) {
+  auto result = PW_STRING_FORMAT(buffer_, "%c%3c%-2c|", 'a', 'b', 'c');
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("a  bc |", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Strings) {
+  const char* c_string = "C";
+  const char array[] = "array";
+  auto result = PW_STRING_FORMAT(
+      buffer_, "%s %s %s", c_string, array, std::string_view("view"));
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("C array view", Result(result));
+}
+
+TEST_F(CompiledFormatTest, Strings_WidthAndPrecision) {
+  const char not_terminated[] = {'a', 'b', 'c'};
+  auto result = PW_STRING_FORMAT(buffer_,
+                                 "[%4s|%-4s|%.2s|%.2s]",
+                                 "ab",
+                                 "cd",
+                                 std::string_view("efg"),
+                                 static_cast<const char*>(not_terminated));
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("[  ab|cd  |ef|ab]", Result(result));
+}
+
+TEST_F(CompiledFormatTest, NullString) {
+  const char* null = nullptr;
+  auto result = PW_STRING_FORMAT(buffer_, "%s", null);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("(null)", Result(result));
+}
+
+TEST_F(CompiledFormatTest, EmptyBuffer_ReturnsResourceExhausted) {
+  auto result = PW_STRING_FORMAT(span(buffer_, 0), "%d", 1);
+  EXPECT_EQ(Status::ResourceExhausted(), result.status());
+  EXPECT_EQ(0u, result.size());
+}
+
+TEST_F(CompiledFormatTest, TextLargerThanBuffer_Truncates) {
+  auto result = PW_STRING_FORMAT(span(buffer_, 4), "abcdef");
+  EXPECT_EQ(Status::ResourceExhausted(), result.status());
+  EXPECT_EQ(3u, result.size());
+  EXPECT_STREQ("abc", buffer_);
+}
+
+TEST_F(CompiledFormatTest, ArgumentLargerThanBuffer_Truncates) {
+  auto result = PW_STRING_FORMAT(span(buffer_, 5), "x=%d", 12345);
+  EXPECT_EQ(Status::ResourceExhausted(), result.status());
+  EXPECT_EQ(4u, result.size());
+  EXPECT_STREQ("x=12", buffer_);
+}
+
+TEST_F(CompiledFormatTest, PaddingLargerThanBuffer_Truncates) {
+  auto result = PW_STRING_FORMAT(span(buffer_, 4), "%6d", 1);
+  EXPECT_EQ(Status::ResourceExhausted(), result.status());
+  EXPECT_EQ(3u, result.size());
+  EXPECT_STREQ("   ", buffer_);
+}
+
+TEST_F(CompiledFormatTest, FitsExactly) {
+  auto result = PW_STRING_FORMAT(span(buffer_, 4), "%s", "abc");
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(3u, result.size());
+  EXPECT_STREQ("abc", buffer_);
+}
+
+TEST_F(CompiledFormatTest, ArgumentsAreEvaluatedOnce) {
+  int count = 0;
+  auto result = PW_STRING_FORMAT(buffer_, "%d", ++count);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ("1", Result(result));
+  EXPECT_EQ(1, count);
+}
+
+#if PW_NC_TEST(TooFewArguments)
+PW_NC_EXPECT("number of arguments does not match");
+[[maybe_unused]] void ShouldAssert(span<char> buffer) {
+  PW_STRING_FORMAT(buffer, "%d %d", 1);
+}
+#elif PW_NC_TEST(TooManyArguments)
+PW_NC_EXPECT("number of arguments does not match");
+[[maybe_unused]] void ShouldAssert(span<char> buffer) {
+  PW_STRING_FORMAT(buffer, "%d", 1, 2);
+}
+#elif PW_NC_TEST(StringForInteger)
+PW_NC_EXPECT("type does not match its conversion");
+[[maybe_unused]] void ShouldAssert(span<char> buffer) {
+  PW_STRING_FORMAT(buffer, "%d", "1");
+}
+#elif PW_NC_TEST(IntegerForString)
+PW_NC_EXPECT("type does not match its conversion");
+[[maybe_unused]] void ShouldAssert(span<char> buffer) {
+  PW_STRING_FORMAT(buffer, "%s", 1);
+}
+#elif PW_NC_TEST(FloatConversion)
+PW_NC_EXPECT("unsupported conversion");
+[[maybe_unused]] void ShouldAssert(span<char> buffer) {
+  PW_STRING_FORMAT(buffer, "%f", 1.0f);
+}
+#elif PW_NC_TEST(IncompleteConversion)
+PW_NC_EXPECT("ends in the middle of a conversion");
+[[maybe_unused]] void ShouldAssert(span<char> buffer) {
+  PW_STRING_FORMAT(buffer, "100%");
+}
+#elif PW_NC_TEST(FormatStringIsNotConstant)
+PW_NC_EXPECT("format");
+[[maybe_unused]] void ShouldAssert(span<char> buffer, const char* format) {
+  PW_STRING_FORMAT(buffer, format);
+}
+#endif  // PW_NC_TEST
+
+}  // namespace
+}  // namespace pw::string
@@ -0,0 +1,386 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+/// @file pw_string/compiled_format.h
+///
+/// `PW_STRING_FORMAT` writes a printf-style formatted string to a buffer, like
+/// `pw::string::Format`, but the format string is parsed when the code is
+/// compiled. The format string is split into literal text and conversions, and
+/// each argument's type is checked against its conversion. At runtime, only the
+/// literal text is copied and the arguments are converted; `vsnprintf` is not
+/// used.
+///
+/// The supported conversions are a subset of printf's:
+///
+/// - `%d`, `%i`, `%u`: decimal integer.
+/// - `%x`, `%X`: hexadecimal integer. Signed values are written as the
+///   unsigned type of the same size, like printf.
+/// - `%c`: a single character.
+/// - `%s`: a `const char*` or anything that converts to `std::string_view`.
+/// - `%%`: a literal `%`.
+///
+/// Conversions may have the flags `-`, `0`, `+` (for `%d` and `%i`), and `#`
+/// (for `%x` and `%X`), and a width. `%s` may have a precision. Length
+/// modifiers such as `l` or `z` are accepted and ignored, since the argument's
+/// type determines how it is converted. Integer conversions accept any integer
+/// or enum type and always write the argument's actual value. A `*` width or
+/// precision, floating point conversions, and `%n` are not supported.
+///
+/// Malformed format strings, unsupported conversions, and arguments whose
+/// count or types do not match the format string fail to compile.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "pw_preprocessor/arguments.h"
+#include "pw_span/span.h"
+#include "pw_status/status_with_size.h"
+
+/// Writes a formatted string to a buffer. The format string must be a string
+/// literal or other constant expression.
+///
+/// @code{.cpp}
+///   char buffer[32];
+///   pw::StatusWithSize result =
+///       PW_STRING_FORMAT(buffer, "%s: %5u (0x%04x)", name, count, flags);
+/// @endcode
+///
+/// @returns The number of characters written, excluding the null terminator.
+/// The buffer is always null-terminated unless it is empty. The status is
+/// `OkStatus()` if the operation succeeded or `Status::ResourceExhausted()` if
+/// the buffer was too small to fit the output. As with
+/// `pw::string::Format`, output that does not fit is truncated.
+#define PW_STRING_FORMAT(buffer, format, ...)                           \
+  [&] {                                                                 \
+    struct PwStringFormatString {                                       \
+      static constexpr std::string_view Get() { return format; }        \
+    };                                                                  \
+    return ::pw::string::internal::FormatCompiled<PwStringFormatString>( \
+        buffer PW_COMMA_ARGS(__VA_ARGS__));                             \
+  }()
+
+namespace pw::string::internal {
+
+// A single conversion in a compiled format string.
+struct FormatSpec {
+  static constexpr uint16_t kNoPrecision = 0xffff;
+
+  char conversion = '\0';
+  bool left_align = false;
+  bool zero_pad = false;
+  bool plus_sign = false;
+  bool alternate_form = false;
+  uint8_t width = 0;
+  uint16_t precision = kNoPrecision;
+};
+
+enum class FormatError : uint8_t {
+  kNone,
+  kIncompleteConversion,
+  kUnsupportedConversion,
+  kUnsupportedFlag,
+  kUnsupportedWidth,
+  kUnsupportedPrecision,
+};
+
+// A format string split into literal text and conversions. The literal text
+// before conversion i ends at text_ends[i], and the text after the last
+// conversion ends at text_ends[conversion_count].
+template <size_t kFormatSize>
+struct CompiledFormat {
+  // Each conversion takes at least two characters.
+  static constexpr size_t kMaxConversions = kFormatSize / 2;
+
+  FormatError error = FormatError::kNone;
+  size_t conversion_count = 0;
+  std::array<char, kFormatSize + 1> text{};
+  std::array<size_t, kMaxConversions + 1> text_ends{};
+  std::array<FormatSpec, kMaxConversions + 1> specs{};
+
+  constexpr size_t TextSize() const { return text_ends[conversion_count]; }
+};
+
+constexpr bool IsDigit(char c) { return '0' <= c && c <= '9'; }
+
+template <size_t kFormatSize>
+constexpr CompiledFormat<kFormatSize> CompileFormat(std::string_view format) {
+  CompiledFormat<kFormatSize> result;
+  size_t text_size = 0;
+
+  // Returns the character at index, or '\0' past the end of the format.
+  auto at = [format](size_t index) {
+    return index < format.size() ? format[index] : '\0';
+  };
+
+  for (size_t i = 0; i < format.size(); ++i) {
+    if (format[i] != '%') {
+      result.text[text_size++] = format[i];
+      continue;
+    }
+    if (at(++i) == '%') {
+      result.text[text_size++] = '%';
+      continue;
+    }
+
+    FormatSpec spec;
+    for (;; ++i) {
+      if (at(i) == '-') {
+        spec.left_align = true;
+      } else if (at(i) == '0') {
+        spec.zero_pad = true;
+      } else if (at(i) == '+') {
+        spec.plus_sign = true;
+      } else if (at(i) == '#') {
+        spec.alternate_form = true;
+      } else if (at(i) == ' ') {
+        result.error = FormatError::kUnsupportedFlag;
+        return result;
+      } else {
+        break;
+      }
+    }
+
+    unsigned width = 0;
+    for (; IsDigit(at(i)); ++i) {
+      width = width * 10u + static_cast<unsigned>(at(i) - '0');
+      if (width > 0xffu) {
+        result.error = FormatError::kUnsupportedWidth;
+        return result;
+      }
+    }
+    if (at(i) == '*') {
+      result.error = FormatError::kUnsupportedWidth;
+      return result;
+    }
+    spec.width = static_cast<uint8_t>(width);
+
+    if (at(i) == '.') {
+      unsigned precision = 0;
+      for (++i; IsDigit(at(i)); ++i) {
+        precision = precision * 10u + static_cast<unsigned>(at(i) - '0');
+        if (precision >= FormatSpec::kNoPrecision) {
+          result.error = FormatError::kUnsupportedPrecision;
+          return result;
+        }
+      }
+      if (at(i) == '*') {
+        result.error = FormatError::kUnsupportedPrecision;
+        return result;
+      }
+      spec.precision = static_cast<uint16_t>(precision);
+    }
+
+    // Skip length modifiers, since the conversion depends on the argument type.
+    while (at(i) == 'h' || at(i) == 'l' || at(i) == 'j' || at(i) == 'z' ||
+           at(i) == 't') {
+      ++i;
+    }
+
+    spec.conversion = at(i);
+    switch (spec.conversion) {
+      case '\0':
+        result.error = FormatError::kIncompleteConversion;
+        return result;
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'c':
+      case 's':
+        break;
+      default:
+        result.error = FormatError::kUnsupportedConversion;
+        return result;
+    }
+
+    const bool is_integer = spec.conversion != 'c' && spec.conversion != 's';
+    const bool is_signed = spec.conversion == 'd' || spec.conversion == 'i';
+    const bool is_hex = spec.conversion == 'x' || spec.conversion == 'X';
+    if ((spec.zero_pad && !is_integer) || (spec.plus_sign && !is_signed) ||
+        (spec.alternate_form && !is_hex)) {
+      result.error = FormatError::kUnsupportedFlag;
+      return result;
+    }
+    if (spec.precision != FormatSpec::kNoPrecision && spec.conversion != 's') {
+      result.error = FormatError::kUnsupportedPrecision;
+      return result;
+    }
+    // printf ignores the 0 flag when the - flag is present.
+    if (spec.left_align) {
+      spec.zero_pad = false;
+    }
+
+    result.text_ends[result.conversion_count] = text_size;
+    result.specs[result.conversion_count] = spec;
+    result.conversion_count += 1;
+  }
+
+  result.text_ends[result.conversion_count] = text_size;
+  return result;
+}
+
+// Compiles the format string returned by FormatString::Get().
+template <typename FormatString>
+struct CompiledFormatString {
+  static constexpr std::string_view kFormat = FormatString::Get();
+  static constexpr CompiledFormat<kFormat.size()> kCompiled =
+      CompileFormat<kFormat.size()>(kFormat);
+
+  // The literal text is copied into its own array so that the conversion specs
+  // are not kept in the binary.
+  static constexpr auto kText = [] {
+    std::array<char, kCompiled.TextSize() + 1> text{};
+    for (size_t i = 0; i < kCompiled.TextSize(); ++i) {
+      text[i] = kCompiled.text[i];
+    }
+    return text;
+  }();
+  static constexpr std::string_view Text(size_t index) {
+    const size_t begin = index == 0u ? 0u : kCompiled.text_ends[index - 1];
+    return std::string_view(kText.data() + begin,
+                            kCompiled.text_ends[index] - begin);
+  }
+};
+
+template <typename T>
+constexpr bool kIsIntegerArg = std::is_integral_v<T> || std::is_enum_v<T>;
+
+template <typename T>
+constexpr bool kIsStringArg = std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+constexpr bool ArgMatchesConversion(char conversion) {
+  if (conversion == 's') {
+    return kIsStringArg<T>;
+  }
+  return kIsIntegerArg<T>;
+}
+
+// Writes the formatted output to a buffer, truncating it if it does not fit.
+class FormatWriter {
+ public:
+  constexpr explicit FormatWriter(span<char> buffer) : buffer_(buffer) {}
+
+  void Write(std::string_view text);
+
+  void WriteSigned(int64_t value, FormatSpec spec);
+  void WriteUnsigned(uint64_t value, FormatSpec spec);
+  void WriteHex(uint64_t value, FormatSpec spec);
+  void WriteChar(char value, FormatSpec spec);
+  void WriteString(const char* value, FormatSpec spec);
+  void WriteString(std::string_view value, FormatSpec spec);
+
+  // Null terminates the output and returns its size and status.
+  StatusWithSize Finish();
+
+ private:
+  void Fill(char c, size_t count);
+
+  // Writes the prefix and the value, padded to the spec's width.
+  void WritePadded(std::string_view prefix,
+                   std::string_view value,
+                   FormatSpec spec);
+
+  span<char> buffer_;
+  size_t size_ = 0;
+  bool truncated_ = false;
+};
+
+template <char kConversion, typename T>
+void WriteArg(FormatWriter& writer, FormatSpec spec, const T& arg) {
+  if constexpr (std::is_enum_v<T>) {
+    WriteArg<kConversion>(
+        writer, spec, static_cast<std::underlying_type_t<T>>(arg));
+  } else if constexpr (kConversion == 's') {
+    if constexpr (std::is_convertible_v<const T&, const char*>) {
+      writer.WriteString(static_cast<const char*>(arg), spec);
+    } else {
+      writer.WriteString(std::string_view(arg), spec);
+    }
+  } else if constexpr (kConversion == 'c') {
+    writer.WriteChar(static_cast<char>(arg), spec);
+  } else if constexpr (kConversion == 'x' || kConversion == 'X') {
+    if constexpr (std::is_same_v<T, bool>) {
+      writer.WriteHex(arg, spec);
+    } else {
+      writer.WriteHex(static_cast<std::make_unsigned_t<T>>(arg), spec);
+    }
+  } else if constexpr (std::is_signed_v<T>) {
+    writer.WriteSigned(arg, spec);
+  } else {
+    writer.WriteUnsigned(arg, spec);
+  }
+}
+
+template <typename Format, size_t... kIndices, typename... Args>
+StatusWithSize FormatCompiledArgs(span<char> buffer,
+                                  std::index_sequence<kIndices...>,
+                                  const Args&... args) {
+  static_assert(
+      (... && ArgMatchesConversion<Args>(
+                   Format::kCompiled.specs[kIndices].conversion)),
+      "PW_STRING_FORMAT: An argument's type does not match its conversion. "
+      "%d, %i, %u, %x, %X, and %c require an integer or enum, and %s requires "
+      "a const char* or a type that converts to std::string_view.");
+
+  FormatWriter writer(buffer);
+  ((writer.Write(Format::Text(kIndices)),
+    WriteArg<Format::kCompiled.specs[kIndices].conversion>(
+        writer, Format::kCompiled.specs[kIndices], args)),
+   ...);
+  writer.Write(Format::Text(sizeof...(Args)));
+  return writer.Finish();
+}
+
+template <typename FormatString, typename... Args>
+StatusWithSize FormatCompiled(span<char> buffer, const Args&... args) {
+  using Format = CompiledFormatString<FormatString>;
+  constexpr FormatError kError = Format::kCompiled.error;
+
+  static_assert(kError != FormatError::kIncompleteConversion,
+                "PW_STRING_FORMAT: The format string ends in the middle of a "
+                "conversion.");
+  static_assert(kError != FormatError::kUnsupportedConversion,
+                "PW_STRING_FORMAT: The format string has an unsupported "
+                "conversion. Only %d, %i, %u, %x, %X, %c, %s, and %% are "
+                "supported.");
+  static_assert(kError != FormatError::kUnsupportedFlag,
+                "PW_STRING_FORMAT: The format string has a flag that is not "
+                "supported for its conversion.");
+  static_assert(kError != FormatError::kUnsupportedWidth,
+                "PW_STRING_FORMAT: Widths must be a number up to 255.");
+  static_assert(kError != FormatError::kUnsupportedPrecision,
+                "PW_STRING_FORMAT: Precisions must be a number and are only "
+                "supported for %s.");
+  static_assert(kError != FormatError::kNone ||
+                    Format::kCompiled.conversion_count == sizeof...(Args),
+                "PW_STRING_FORMAT: The number of arguments does not match the "
+                "number of conversions in the format string.");
+
+  if constexpr (kError == FormatError::kNone &&
+                Format::kCompiled.conversion_count == sizeof...(Args)) {
+    return FormatCompiledArgs<Format>(
+        buffer, std::index_sequence_for<Args...>(), args...);
+  } else {
+    return StatusWithSize::InvalidArgument();
+  }
+}
+
+}  // namespace pw::string::internal
@@ -15,12 +15,9 @@
 
 // PW_STRING_ENABLE_DECIMAL_FLOAT_EXPANSION controls whether floating point
 // values passed to the ToString function will be expanded after a decimal
-// point, or just rounded to the nearest int. Enabling decimal expansion may
-// significantly increase code size.
-//
-// Note: This currently relies on floating point support for `snprintf`, which
-// might require extra compiler configuration, e.g. `-u_printf_float` for
-// newlib-nano.
+// point, or just rounded to the nearest int. Decimal expansion matches
+// printf's "%.3f" conversion, but is implemented without `snprintf`, so it
+// does not require floating point support in printf.
 #ifndef PW_STRING_ENABLE_DECIMAL_FLOAT_EXPANSION
 #define PW_STRING_ENABLE_DECIMAL_FLOAT_EXPANSION 0
 #endif
@@ -89,9 +89,7 @@ StatusWithSize ToString(const T& value, span<char> buffer) {
     return string::IntToString(std::underlying_type_t<T>(value), buffer);
   } else if constexpr (std::is_floating_point_v<T>) {
     if constexpr (string::internal::config::kEnableDecimalFloatExpansion) {
-      // TODO(hepler): Look into using the float overload of std::to_chars when
-      // it is available.
-      return string::Format(buffer, "%.3f", value);
+      return string::FloatToString(static_cast<double>(value), buffer);
     } else {
       return string::FloatAsIntToString(static_cast<float>(value), buffer);
     }
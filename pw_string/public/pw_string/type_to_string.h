@@ -94,6 +94,24 @@ StatusWithSize IntToHexString(uint64_t value,
 //
 StatusWithSize FloatAsIntToString(float value, span<char> buffer);
 
+// Writes a floating point number as a null-terminated string with 3 digits
+// after the decimal point. The output matches printf's "%.3f" conversion,
+// including rounding ties to even, but does not use printf. Returns the number
+// of characters written, excluding the null terminator, and the status.
+//
+// Numbers are never truncated; if the entire number does not fit, only a null
+// terminator is written and the status is RESOURCE_EXHAUSTED.
+//
+// Examples:
+//
+//   FloatToString(1.25, buffer)      -> writes "1.250" to the buffer
+//   FloatToString(-4.0005, buffer)   -> writes "-4.001" to the buffer
+//   FloatToString(3.5e20, buffer)    -> writes "350000000000000000000.000"
+//   FloatToString(-INFINITY, buffer) -> writes "-inf" to the buffer
+//   FloatToString(NAN, buffer)       -> writes "nan" to the buffer
+//
+StatusWithSize FloatToString(double value, span<char> buffer);
+
 // Writes a bool as "true" or "false". Semantics match CopyEntireString.
 StatusWithSize BoolToString(bool value, span<char> buffer);
 
@@ -183,6 +201,35 @@ inline constexpr std::array<uint64_t, 20> kPowersOf10{
     10000000000000000000ull,  // 10^19
 };
 
+// The decimal digits of 0 to 99, which are written two at a time.
+inline constexpr char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Writes the lowest digit_count decimal digits of value, with leading 0s, to
+// the characters before end.
+constexpr void WriteDecimalDigits(uint32_t value,
+                                  unsigned digit_count,
+                                  char* end) {
+  for (; digit_count >= 2u; digit_count -= 2u) {
+    const uint32_t pair = value % 100u * 2u;
+    value /= 100u;
+    *--end = kDigitPairs[pair + 1];
+    *--end = kDigitPairs[pair];
+  }
+  if (digit_count != 0u) {
+    *--end = static_cast<char>(value % 10u + '0');
+  }
+}
+
 constexpr StatusWithSize HandleExhaustedBuffer(span<char> buffer) {
   if (!buffer.empty()) {
     buffer[0] = '\0';
@@ -210,7 +257,6 @@ constexpr uint_fast8_t DecimalDigitCount(uint64_t integer) {
 // think std::to_chars will be faster, so I kept this implementation for now.
 template <>
 constexpr StatusWithSize IntToString(uint64_t value, span<char> buffer) {
-  constexpr uint32_t base = 10;
   constexpr uint32_t max_uint32_base_power = 1'000'000'000;
   constexpr uint_fast8_t max_uint32_base_power_exponent = 9;
 
@@ -238,11 +284,9 @@ constexpr StatusWithSize IntToString(uint64_t value, span<char> buffer) {
       value /= max_uint32_base_power;
     }
 
-    // Write the specified number of digits, with leading 0s.
-    for (uint_fast8_t i = 0; i < digit_count; ++i) {
-      buffer[--remaining] = static_cast<char>(lower_digits % base + '0');
-      lower_digits /= base;
-    }
+    // Write the specified number of digits, with leading 0s, two at a time.
+    internal::WriteDecimalDigits(lower_digits, digit_count, &buffer[remaining]);
+    remaining = static_cast<uint_fast8_t>(remaining - digit_count);
   }
   return StatusWithSize(total_digits);
 }
@@ -23,6 +23,66 @@
 #include "lib/stdcompat/bit.h"
 
 namespace pw::string {
+namespace {
+
+// Number of digits after the decimal point written by FloatToString.
+constexpr unsigned kFloatDecimalPlaces = 3;
+constexpr uint32_t kFloatDecimalScale = 1000;
+
+// Largest power of 10 that fits in a uint32_t.
+constexpr uint32_t kMaxUint32PowerOf10 = 1'000'000'000;
+constexpr unsigned kMaxUint32PowerOf10Digits = 9;
+
+// Writes the integer mantissa * 2^exponent, which may be up to 1024 bits.
+// Returns the number of characters that it would take, and only writes them if
+// they fit in the buffer, without a null terminator.
+size_t WriteLargeInteger(uint64_t mantissa, unsigned exponent, span<char> out) {
+  // The integer as 32-bit words, least significant first.
+  std::array<uint32_t, 1024 / 32 + 2> words{};
+  const unsigned word = exponent / 32;
+  const unsigned shift = exponent % 32;
+  const uint64_t low = mantissa << shift;
+  words[word] = static_cast<uint32_t>(low);
+  words[word + 1] = static_cast<uint32_t>(low >> 32);
+  if (shift != 0u) {
+    words[word + 2] = static_cast<uint32_t>(mantissa >> (64 - shift));
+  }
+
+  // Split the integer into 9-digit chunks by repeatedly dividing it by 10^9.
+  std::array<uint32_t, 309 / kMaxUint32PowerOf10Digits + 1> chunks;
+  size_t chunk_count = 0;
+  size_t word_count = words.size();
+  while (word_count > 0u) {
+    if (words[word_count - 1] == 0u) {
+      --word_count;
+      continue;
+    }
+
+    uint64_t remainder = 0;
+    for (size_t i = word_count; i > 0u; --i) {
+      const uint64_t current = remainder << 32 | words[i - 1];
+      words[i - 1] = static_cast<uint32_t>(current / kMaxUint32PowerOf10);
+      remainder = current % kMaxUint32PowerOf10;
+    }
+    chunks[chunk_count++] = static_cast<uint32_t>(remainder);
+  }
+
+  const size_t size = DecimalDigitCount(chunks[chunk_count - 1]) +
+                      kMaxUint32PowerOf10Digits * (chunk_count - 1);
+  if (size <= out.size()) {
+    char* end = out.data() + size;
+    for (size_t i = 0; i < chunk_count - 1; ++i) {
+      internal::WriteDecimalDigits(chunks[i], kMaxUint32PowerOf10Digits, end);
+      end -= kMaxUint32PowerOf10Digits;
+    }
+    internal::WriteDecimalDigits(chunks[chunk_count - 1],
+                                 static_cast<unsigned>(end - out.data()),
+                                 end);
+  }
+  return size;
+}
+
+}  // namespace
 
 StatusWithSize IntToHexString(uint64_t value,
                               span<char> buffer,
@@ -64,6 +124,89 @@ StatusWithSize FloatAsIntToString(float value, span<char> buffer) {
   return internal::HandleExhaustedBuffer(buffer);
 }
 
+StatusWithSize FloatToString(double value, span<char> buffer) {
+  const bool negative = std::signbit(value);
+
+  // Match printf's output for inf and NaN.
+  if (!std::isfinite(value)) {
+    if (const size_t written = 3 + negative; written < buffer.size()) {
+      char* out = buffer.data();
+      if (negative) {
+        *out++ = '-';
+      }
+      std::memcpy(out, std::isnan(value) ? "nan" : "inf", sizeof("nan"));
+      return StatusWithSize(written);
+    }
+    return internal::HandleExhaustedBuffer(buffer);
+  }
+
+  // Split the value into an integer mantissa and a power of 2, so that it can
+  // be converted to decimal exactly with integer arithmetic.
+  constexpr int kMantissaBits = std::numeric_limits<double>::digits - 1;
+  constexpr int kExponentBias =
+      std::numeric_limits<double>::max_exponent - 1 + kMantissaBits;
+  const uint64_t bits = cpp20::bit_cast<uint64_t>(value);
+  const int biased_exponent = static_cast<int>(bits >> kMantissaBits & 0x7ff);
+  uint64_t mantissa = bits & ((uint64_t{1} << kMantissaBits) - 1);
+  int exponent = 1 - kExponentBias;
+  if (biased_exponent != 0) {
+    mantissa |= uint64_t{1} << kMantissaBits;
+    exponent = biased_exponent - kExponentBias;
+  }
+
+  // The value is |mantissa| * 2^exponent. Find the value scaled by 10^3 and
+  // rounded to an integer, rounding ties to even.
+  uint64_t integer = 0;
+  uint32_t fraction = 0;
+  bool large_integer = false;
+  if (exponent < 0) {
+    const uint64_t scaled = mantissa * kFloatDecimalScale;
+    const unsigned shift = static_cast<unsigned>(-exponent);
+    // Values below 2^-64 round to 0, since scaled is less than 2^63.
+    uint64_t rounded = 0;
+    if (shift < 64u) {
+      rounded = scaled >> shift;
+      const uint64_t remainder = scaled & ((uint64_t{1} << shift) - 1);
+      const uint64_t half = uint64_t{1} << (shift - 1);
+      if (remainder > half || (remainder == half && (rounded & 1u) != 0u)) {
+        rounded += 1;
+      }
+    }
+    integer = rounded / kFloatDecimalScale;
+    fraction = static_cast<uint32_t>(rounded % kFloatDecimalScale);
+  } else if (exponent < 64 - kMantissaBits - 1) {
+    integer = mantissa << exponent;
+  } else {
+    large_integer = true;
+  }
+
+  // Write the integer part after the sign.
+  span<char> out = buffer.empty() || !negative ? buffer : buffer.subspan(1);
+  size_t integer_size = 0;
+  if (large_integer) {
+    integer_size =
+        WriteLargeInteger(mantissa, static_cast<unsigned>(exponent), out);
+  } else {
+    integer_size = DecimalDigitCount(integer);
+    if (integer_size < out.size()) {
+      IntToString(integer, out);
+    }
+  }
+
+  const size_t size = negative + integer_size + 1 + kFloatDecimalPlaces;
+  if (size >= buffer.size()) {
+    return internal::HandleExhaustedBuffer(buffer);
+  }
+
+  if (negative) {
+    buffer[0] = '-';
+  }
+  buffer[size - kFloatDecimalPlaces - 1] = '.';
+  internal::WriteDecimalDigits(fraction, kFloatDecimalPlaces, &buffer[size]);
+  buffer[size] = '\0';
+  return StatusWithSize(size);
+}
+
 StatusWithSize BoolToString(bool value, span<char> buffer) {
   return CopyEntireStringOrNull(value ? "true" : "false", buffer);
 }
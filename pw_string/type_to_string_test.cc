@@ -419,6 +419,126 @@ TEST_F(FloatAsIntToStringTest, TooSmall_NaN_NullTerminates) {
   EXPECT_STREQ("", buffer_);
 }
 
+class FloatToStringTest : public TestWithBuffer {};
+
+TEST_F(FloatToStringTest, Zero) {
+  EXPECT_EQ(5u, FloatToString(0.0, buffer_).size());
+  EXPECT_STREQ("0.000", buffer_);
+}
+
+TEST_F(FloatToStringTest, NegativeZero) {
+  EXPECT_EQ(6u, FloatToString(-0.0, buffer_).size());
+  EXPECT_STREQ("-0.000", buffer_);
+}
+
+TEST_F(FloatToStringTest, PositiveInfinity) {
+  EXPECT_EQ(3u, FloatToString(INFINITY, buffer_).size());
+  EXPECT_STREQ("inf", buffer_);
+}
+
+TEST_F(FloatToStringTest, NegativeInfinity) {
+  EXPECT_EQ(4u, FloatToString(-INFINITY, buffer_).size());
+  EXPECT_STREQ("-inf", buffer_);
+}
+
+TEST_F(FloatToStringTest, PositiveNan) {
+  EXPECT_EQ(3u, FloatToString(NAN, buffer_).size());
+  EXPECT_STREQ("nan", buffer_);
+}
+
+TEST_F(FloatToStringTest, NegativeNan) {
+  EXPECT_EQ(4u, FloatToString(-NAN, buffer_).size());
+  EXPECT_STREQ("-nan", buffer_);
+}
+
+TEST_F(FloatToStringTest, Fraction_PrintsThreeDecimalPlaces) {
+  EXPECT_EQ(5u, FloatToString(1.25, buffer_).size());
+  EXPECT_STREQ("1.250", buffer_);
+}
+
+TEST_F(FloatToStringTest, Negative_PrintsSign) {
+  EXPECT_EQ(9u, FloatToString(-1234.567, buffer_).size());
+  EXPECT_STREQ("-1234.567", buffer_);
+}
+
+TEST_F(FloatToStringTest, Rounds_AtThirdDecimalPlace) {
+  EXPECT_EQ(5u, FloatToString(0.0006, buffer_).size());
+  EXPECT_STREQ("0.001", buffer_);
+  EXPECT_EQ(5u, FloatToString(0.9996, buffer_).size());
+  EXPECT_STREQ("1.000", buffer_);
+}
+
+TEST_F(FloatToStringTest, ExactTie_RoundsToEven) {
+  // 0.0625 and 0.1875 are exactly representable, so these are true ties.
+  EXPECT_EQ(5u, FloatToString(0.0625, buffer_).size());
+  EXPECT_STREQ("0.062", buffer_);
+  EXPECT_EQ(5u, FloatToString(0.1875, buffer_).size());
+  EXPECT_STREQ("0.188", buffer_);
+}
+
+TEST_F(FloatToStringTest, Tiny_RoundsToZero) {
+  EXPECT_EQ(6u, FloatToString(-4e-300, buffer_).size());
+  EXPECT_STREQ("-0.000", buffer_);
+}
+
+TEST_F(FloatToStringTest, LargerThanUint64) {
+  char buffer[32];
+  EXPECT_EQ(25u, FloatToString(3.5e20, buffer).size());
+  EXPECT_STREQ("350000000000000000000.000", buffer);
+}
+
+TEST_F(FloatToStringTest, LargeValues_PrintsExactInteger) {
+  struct {
+    double value;
+    std::string_view expected;
+  } kTestCases[] = {
+      {9007199254740993.0, "9007199254740992.000"},
+      {1.8446744073709552e19, "18446744073709551616.000"},
+      {-6.02214076e23, "-602214075999999987023872.000"},
+      {1e100,
+       "10000000000000000159028911097599180468360808563945281389781327557747838"
+       "772170381060813469985856815104.000"},
+  };
+
+  char buffer[128];
+  for (const auto& test : kTestCases) {
+    auto result = FloatToString(test.value, buffer);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(test.expected, std::string_view(buffer, result.size()));
+  }
+}
+
+TEST_F(FloatToStringTest, Max) {
+  char buffer[320];
+  auto result = FloatToString(std::numeric_limits<double>::lowest(), buffer);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(314u, result.size());
+  EXPECT_EQ(std::string_view("-17976931348623157"),
+            std::string_view(buffer, 18));
+  EXPECT_EQ(std::string_view(".000"), std::string_view(buffer + 310, 4));
+}
+
+TEST_F(FloatToStringTest, TooSmall_NullTerminates) {
+  auto result = FloatToString(-1.5, span(buffer_, 6));
+  EXPECT_EQ(0u, result.size());
+  EXPECT_FALSE(result.ok());
+  EXPECT_STREQ("", buffer_);
+}
+
+TEST_F(FloatToStringTest, TooSmall_LargeValue_NullTerminates) {
+  auto result = FloatToString(1e100, buffer_);
+  EXPECT_EQ(0u, result.size());
+  EXPECT_FALSE(result.ok());
+  EXPECT_STREQ("", buffer_);
+}
+
+TEST_F(FloatToStringTest, TooSmall_Infinity_NullTerminates) {
+  auto result = FloatToString(-INFINITY, span(buffer_, 4));
+  EXPECT_EQ(0u, result.size());
+  EXPECT_FALSE(result.ok());
+  EXPECT_STREQ("", buffer_);
+}
+
 class CopyStringOrNullTest : public TestWithBuffer {};
 
 using namespace std::literals::string_view_literals;
@@ -0,0 +1,250 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Tests for pw_symbolizer's ELF index based symbolization."""
+
+import json
+import os
+from pathlib import Path
+import shutil
+import subprocess
+import tempfile
+import unittest
+from unittest import mock
+
+from pw_symbolizer import elf_symbolizer
+from pw_symbolizer.elf_symbolizer import AddressIndex, AddressRange, LineRow
+
+_MODULE_PY_DIR = Path(__file__).parent.resolve()
+_CPP_TEST_FILE_NAME = 'symbolizer_test.cc'
+
+_COMPILER = 'clang++'
+
+
+def _test_index() -> AddressIndex:
+    return AddressIndex(
+        ranges=(
+            AddressRange(0x1000, 0x1040, 'foo()'),
+            AddressRange(0x1040, 0x1080, 'bar()'),
+            AddressRange(0x2000, 0x2008, 'some_object'),
+        ),
+        files=('src/foo.cc', 'src/bar.cc'),
+        rows=(
+            LineRow(0x1040, 1, 7),
+            LineRow(0x1000, 0, 10),
+            LineRow(0x1010, 0, 12),
+            LineRow(0x1080, -1, 0),
+        ),
+    )
+
+
+class TestAddressIndex(unittest.TestCase):
+    """Tests looking up addresses in an AddressIndex."""
+
+    def test_function_start(self):
+        symbol = _test_index().symbolize(0x1000)
+        self.assertEqual(symbol.address, 0x1000)
+        self.assertEqual(symbol.name, 'foo()')
+        self.assertEqual(symbol.file, 'src/foo.cc')
+        self.assertEqual(symbol.line, 10)
+
+    def test_within_function(self):
+        index = _test_index()
+        self.assertEqual(index.symbolize(0x100F).line, 10)
+        self.assertEqual(index.symbolize(0x1010).line, 12)
+        self.assertEqual(index.symbolize(0x103F).line, 12)
+
+        symbol = index.symbolize(0x1040)
+        self.assertEqual(symbol.name, 'bar()')
+        self.assertEqual(symbol.file, 'src/bar.cc')
+        self.assertEqual(symbol.line, 7)
+
+    def test_object_without_lines(self):
+        symbol = _test_index().symbolize(0x2004)
+        self.assertEqual(symbol.name, 'some_object')
+        self.assertEqual(symbol.file, '')
+        self.assertEqual(symbol.line, 0)
+
+    def test_unknown_addresses(self):
+        index = _test_index()
+        for address in (0x0, 0xFFF, 0x1080, 0x2008):
+            symbol = index.symbolize(address)
+            self.assertEqual(symbol.address, address)
+            self.assertEqual(symbol.name, '')
+            self.assertEqual(symbol.file, '')
+
+    def test_nested_ranges(self):
+        index = AddressIndex(
+            ranges=(
+                AddressRange(0x100, 0x200, 'outer()'),
+                AddressRange(0x110, 0x120, 'outer()::local'),
+                AddressRange(0x130, 0x140, 'outer()::other_local'),
+                AddressRange(0x300, 0x310, 'after()'),
+            ),
+            files=(),
+            rows=(),
+        )
+        expected = {
+            0x100: 'outer()',
+            0x110: 'outer()::local',
+            0x11F: 'outer()::local',
+            0x120: 'outer()',
+            0x135: 'outer()::other_local',
+            0x140: 'outer()',
+            0x1FF: 'outer()',
+            0x200: '',
+            0x305: 'after()',
+        }
+        for address, name in expected.items():
+            self.assertEqual(index.symbolize(address).name, name, hex(address))
+
+    def test_sequence_start_overrides_end(self):
+        index = AddressIndex(
+            ranges=(),
+            files=('a.cc', 'b.cc'),
+            rows=(
+                LineRow(0x100, 1, 3),
+                LineRow(0x0, 0, 1),
+                LineRow(0x100, -1, 0),
+            ),
+        )
+        self.assertEqual(index.symbolize(0x100).file, 'b.cc')
+
+    def test_json_round_trip(self):
+        index = AddressIndex.from_json(
+            json.loads(json.dumps(_test_index().to_json()))
+        )
+        for address in (0x1000, 0x1044, 0x2000):
+            self.assertEqual(
+                index.symbolize(address), _test_index().symbolize(address)
+            )
+
+    def test_json_wrong_version(self):
+        data = _test_index().to_json()
+        data['version'] += 1
+        with self.assertRaises(ValueError):
+            AddressIndex.from_json(data)
+
+
+class TestIndexCache(unittest.TestCase):
+    """Tests caching indices on disk."""
+
+    def setUp(self):
+        self._temp_dir = tempfile.TemporaryDirectory()
+        self._dir = Path(self._temp_dir.name)
+        self._binary = self._dir / 'firmware.elf'
+        self._binary.write_bytes(b'not really an ELF')
+        self._cache_dir = self._dir / 'cache'
+
+    def tearDown(self):
+        self._temp_dir.cleanup()
+
+    @mock.patch.object(elf_symbolizer, 'build_index')
+    def test_index_built_once(self, build_index):
+        build_index.return_value = _test_index()
+
+        first = elf_symbolizer.load_index(self._binary, self._cache_dir)
+        second = elf_symbolizer.load_index(self._binary, self._cache_dir)
+
+        build_index.assert_called_once_with(self._binary)
+        self.assertEqual(len(list(self._cache_dir.iterdir())), 1)
+        self.assertEqual(first.symbolize(0x1044), second.symbolize(0x1044))
+
+    @mock.patch.object(elf_symbolizer, 'build_index')
+    def test_changed_binary_reindexed(self, build_index):
+        build_index.return_value = _test_index()
+
+        elf_symbolizer.load_index(self._binary, self._cache_dir)
+        self._binary.write_bytes(b'a different binary')
+        elf_symbolizer.load_index(self._binary, self._cache_dir)
+
+        self.assertEqual(build_index.call_count, 2)
+        self.assertEqual(len(list(self._cache_dir.iterdir())), 2)
+
+    @mock.patch.object(elf_symbolizer, 'build_index')
+    def test_corrupt_cache_rebuilt(self, build_index):
+        build_index.return_value = _test_index()
+
+        elf_symbolizer.load_index(self._binary, self._cache_dir)
+        for cache_file in self._cache_dir.iterdir():
+            cache_file.write_text('{"version": 1, "ranges": [')
+
+        index = elf_symbolizer.load_index(self._binary, self._cache_dir)
+
+        self.assertEqual(build_index.call_count, 2)
+        self.assertEqual(index.symbolize(0x1000).name, 'foo()')
+
+
+@unittest.skipUnless(
+    shutil.which(_COMPILER) and 'PW_PIGWEED_CIPD_INSTALL_DIR' in os.environ,
+    'Requires clang and the Pigweed CIPD sysroot',
+)
+class TestElfSymbolizer(unittest.TestCase):
+    """Tests symbolizing a real ELF file."""
+
+    def test_symbolization(self):
+        """Tests that the symbolizer can symbolize addresses properly."""
+        sysroot = Path(os.environ['PW_PIGWEED_CIPD_INSTALL_DIR']).joinpath(
+            "clang_sysroot"
+        )
+        with tempfile.TemporaryDirectory() as exe_dir:
+            exe_file = Path(exe_dir) / 'print_expected_symbols'
+
+            # Compiles a binary that prints symbol addresses and expected
+            # results as JSON.
+            cmd = [
+                _COMPILER,
+                _CPP_TEST_FILE_NAME,
+                '-gfull',
+                f'-ffile-prefix-map={_MODULE_PY_DIR}=',
+                '--sysroot=%s' % sysroot,
+                '-std=c++17',
+                '-fno-pic',
+                '-fno-pie',
+                '-no-pie',
+                '-o',
+                exe_file,
+            ]
+
+            process = subprocess.run(
+                cmd,
+                stdout=subprocess.PIPE,
+                stderr=subprocess.STDOUT,
+                cwd=_MODULE_PY_DIR,
+            )
+            self.assertEqual(process.returncode, 0)
+
+            process = subprocess.run(
+                [exe_file], stdout=subprocess.PIPE, stderr=subprocess.STDOUT
+            )
+            self.assertEqual(process.returncode, 0)
+
+            expected_symbols = [
+                json.loads(line)
+                for line in process.stdout.decode().splitlines()
+            ]
+
+            symbolizer = elf_symbolizer.ElfSymbolizer(exe_file)
+            results = symbolizer.symbolize_all(
+                s['Address'] for s in expected_symbols
+            )
+            for expected_symbol, result in zip(expected_symbols, results):
+                self.assertEqual(result.name, expected_symbol['Expected'])
+                self.assertEqual(result.address, expected_symbol['Address'])
+                if not expected_symbol['IsObj']:
+                    self.assertEqual(result.file, _CPP_TEST_FILE_NAME)
+                    self.assertEqual(result.line, expected_symbol['Line'])
+
+
+if __name__ == '__main__':
+    unittest.main()
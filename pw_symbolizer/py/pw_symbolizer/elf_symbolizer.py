@@ -0,0 +1,350 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""A symbolizer that indexes an ELF file's symbols and line tables."""
+
+import bisect
+import hashlib
+import itertools
+import json
+import os
+from pathlib import Path
+import posixpath
+import shutil
+import subprocess
+import tempfile
+from typing import Dict, Iterable, List, NamedTuple, Optional, Sequence
+
+from elftools.elf import elffile, sections  # type: ignore
+
+from pw_symbolizer import symbolizer
+
+# Bump this whenever the layout of cached indices changes.
+_CACHE_FORMAT_VERSION = 1
+
+# Tombstone addresses that linkers write for discarded code.
+_TOMBSTONE_ADDRESSES = frozenset((0xFFFFFFFE, 0xFFFFFFFF))
+
+
+class AddressRange(NamedTuple):
+    """A named range of addresses, such as a function or object."""
+
+    start: int
+    end: int
+    name: str
+
+
+class LineRow(NamedTuple):
+    """The source location of the addresses starting at ``address``.
+
+    A row applies until the address of the next row. Rows with a negative
+    ``file`` mark the end of a sequence of rows, after which there is no line
+    information.
+    """
+
+    address: int
+    file: int
+    line: int
+
+
+class AddressIndex:
+    """Sorted interval tables that map addresses to symbols."""
+
+    def __init__(
+        self,
+        ranges: Iterable[AddressRange],
+        files: Sequence[str],
+        rows: Iterable[LineRow],
+    ):
+        self._ranges = sorted(ranges)
+        self._range_starts = [r.start for r in self._ranges]
+
+        # The largest end address of each range and all ranges sorted before
+        # it. Ranges can nest, such as a static object inside a function, so
+        # an address past the end of one range may still be in an earlier one.
+        self._range_max_ends = list(
+            itertools.accumulate((r.end for r in self._ranges), max)
+        )
+
+        self._files = list(files)
+
+        # When rows share an address, put the end of a sequence first so a row
+        # that starts a sequence there takes priority.
+        self._rows = sorted(rows, key=lambda r: (r.address, r.file >= 0))
+        self._row_addresses = [r.address for r in self._rows]
+
+    def _find_range(self, address: int) -> Optional[AddressRange]:
+        """Finds the innermost range that contains the address.
+
+        Ranges that share a start address are sorted by end address, so the
+        widest of those is preferred.
+        """
+        i = bisect.bisect_right(self._range_starts, address) - 1
+        if i < 0 or address >= self._range_max_ends[i]:
+            return None
+
+        # Some range at or before i contains the address, so this stops there.
+        while address >= self._ranges[i].end:
+            i -= 1
+        return self._ranges[i]
+
+    def _find_row(self, address: int) -> Optional[LineRow]:
+        i = bisect.bisect_right(self._row_addresses, address) - 1
+        if i < 0 or self._rows[i].file < 0:
+            return None
+        return self._rows[i]
+
+    def symbolize(self, address: int) -> symbolizer.Symbol:
+        """Looks up the symbol and source location of an address."""
+        address_range = self._find_range(address)
+        name = address_range.name if address_range is not None else ''
+
+        row = self._find_row(address)
+        if row is None:
+            return symbolizer.Symbol(address, name)
+
+        return symbolizer.Symbol(address, name, self._files[row.file], row.line)
+
+    def to_json(self) -> dict:
+        return {
+            'version': _CACHE_FORMAT_VERSION,
+            'ranges': [list(r) for r in self._ranges],
+            'files': self._files,
+            'rows': [list(r) for r in self._rows],
+        }
+
+    @staticmethod
+    def from_json(data: dict) -> 'AddressIndex':
+        """Loads an index from the output of ``to_json``.
+
+        Raises:
+            ValueError: The data is from a different cache format version.
+        """
+        if data.get('version') != _CACHE_FORMAT_VERSION:
+            raise ValueError('Unsupported symbolizer cache version')
+
+        return AddressIndex(
+            (AddressRange(*r) for r in data['ranges']),
+            data['files'],
+            (LineRow(*r) for r in data['rows']),
+        )
+
+
+def _demangle(names: List[str]) -> List[str]:
+    """Demangles all names with a single c++filt process, if available."""
+    for tool in ('llvm-cxxfilt', 'c++filt'):
+        tool_path = shutil.which(tool)
+        if tool_path is None:
+            continue
+
+        result = subprocess.run(
+            [tool_path],
+            input='\n'.join(names).encode(),
+            stdout=subprocess.PIPE,
+            check=False,
+        )
+        demangled = result.stdout.decode().splitlines()
+        if result.returncode == 0 and len(demangled) == len(names):
+            return demangled
+
+    return names
+
+
+def _read_ranges(elf: elffile.ELFFile) -> List[AddressRange]:
+    """Reads the functions and objects from an ELF's symbol tables."""
+    # Thumb function symbols have the lowest bit set.
+    address_mask = ~1 if elf['e_machine'] == 'EM_ARM' else ~0
+
+    starts: List[int] = []
+    ends: List[int] = []
+    names: List[str] = []
+    for section in elf.iter_sections():
+        if not isinstance(section, sections.SymbolTableSection):
+            continue
+
+        for symbol in section.iter_symbols():
+            if symbol['st_info']['type'] not in ('STT_FUNC', 'STT_OBJECT'):
+                continue
+            if symbol['st_size'] == 0 or symbol['st_shndx'] == 'SHN_UNDEF':
+                continue
+
+            start = symbol['st_value'] & address_mask
+            starts.append(start)
+            ends.append(start + symbol['st_size'])
+            names.append(symbol.name)
+
+    return [
+        AddressRange(start, end, name)
+        for start, end, name in zip(starts, ends, _demangle(names))
+    ]
+
+
+def _decode(value) -> str:
+    return value.decode(errors='replace') if isinstance(value, bytes) else value
+
+
+def _is_loaded(elf: elffile.ELFFile, address: int) -> bool:
+    """Checks if an address is inside a loaded segment."""
+    for segment in elf.iter_segments():
+        if segment['p_type'] != 'PT_LOAD':
+            continue
+        start = segment['p_vaddr']
+        if start <= address < start + segment['p_memsz']:
+            return True
+    return False
+
+
+def _file_path(line_program, comp_dir: str, file_number: int) -> str:
+    """Returns the path of a file in a DWARF line program."""
+    # Before DWARF 5, file and directory numbers start at 1, and directory 0 is
+    # the compilation directory.
+    first_index = 0 if line_program['version'] >= 5 else 1
+
+    entry = line_program['file_entry'][file_number - first_index]
+    if first_index == 1 and entry.dir_index == 0:
+        directory = comp_dir
+    else:
+        include_dir = line_program['include_directory'][
+            entry.dir_index - first_index
+        ]
+        directory = posixpath.join(comp_dir, _decode(include_dir))
+
+    return posixpath.join(directory, _decode(entry.name))
+
+
+def _read_line_rows(elf: elffile.ELFFile, files: List[str]) -> List[LineRow]:
+    """Reads the rows of every line program in an ELF's DWARF info.
+
+    File names are appended to ``files`` and referred to by index.
+    """
+    if not elf.has_dwarf_info():
+        return []
+
+    file_indices: Dict[str, int] = {}
+    rows: List[LineRow] = []
+
+    # Some linkers place discarded code at address 0, so only trust sequences
+    # there if it is actually loaded.
+    zero_is_loaded = _is_loaded(elf, 0)
+
+    dwarf = elf.get_dwarf_info()
+    for cu in dwarf.iter_CUs():
+        line_program = dwarf.line_program_for_CU(cu)
+        if line_program is None:
+            continue
+
+        comp_dir_attr = cu.get_top_DIE().attributes.get('DW_AT_comp_dir')
+        comp_dir = _decode(comp_dir_attr.value) if comp_dir_attr else ''
+
+        skip_sequence = False
+        sequence_start = True
+        for entry in line_program.get_entries():
+            state = entry.state
+            if state is None:
+                continue
+
+            # Skip sequences for code that the linker discarded.
+            if sequence_start:
+                skip_sequence = state.address in _TOMBSTONE_ADDRESSES or (
+                    state.address == 0 and not zero_is_loaded
+                )
+                sequence_start = False
+
+            if state.end_sequence:
+                if not skip_sequence:
+                    rows.append(LineRow(state.address, -1, 0))
+                sequence_start = True
+                continue
+
+            if not skip_sequence:
+                path = _file_path(line_program, comp_dir, state.file)
+                file = file_indices.setdefault(path, len(file_indices))
+                rows.append(LineRow(state.address, file, state.line))
+
+    files.extend(file_indices)
+    return rows
+
+
+def build_index(binary: Path) -> AddressIndex:
+    """Reads the symbols and line tables of an ELF file into an index."""
+    with binary.open('rb') as elf_file:
+        elf = elffile.ELFFile(elf_file)
+        files: List[str] = []
+        rows = _read_line_rows(elf, files)
+        return AddressIndex(_read_ranges(elf), files, rows)
+
+
+def _hash_file(path: Path) -> str:
+    digest = hashlib.sha256()
+    with path.open('rb') as file:
+        for chunk in iter(lambda: file.read(1 << 20), b''):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+
+def load_index(binary: Path, cache_dir: Optional[Path] = None) -> AddressIndex:
+    """Loads the index of an ELF file, using an on-disk cache if provided.
+
+    Cached indices are named after a hash of the ELF file's contents, so a
+    rebuilt binary is always re-indexed.
+    """
+    if cache_dir is None:
+        return build_index(binary)
+
+    cache_file = cache_dir / f'{_hash_file(binary)}.json'
+    try:
+        with cache_file.open() as file:
+            return AddressIndex.from_json(json.load(file))
+    except (OSError, ValueError, KeyError, TypeError):
+        pass  # Missing, stale, or corrupt cache entries are rebuilt.
+
+    index = build_index(binary)
+
+    # Write to a temporary file first so that concurrent readers never see a
+    # partially written index.
+    cache_dir.mkdir(parents=True, exist_ok=True)
+    with tempfile.NamedTemporaryFile(
+        'w', dir=cache_dir, suffix='.tmp', delete=False
+    ) as file:
+        json.dump(index.to_json(), file)
+    os.replace(file.name, cache_file)
+
+    return index
+
+
+class ElfSymbolizer(symbolizer.Symbolizer):
+    """A symbolizer that reads symbols directly from an ELF file.
+
+    The ELF's symbol tables and DWARF line tables are read once into an
+    in-memory index, so each lookup is a binary search rather than a round trip
+    to a separate process. This makes it well suited to symbolizing many
+    addresses, such as every thread's stack in a batch of snapshots.
+    """
+
+    def __init__(self, binary: Path, cache_dir: Optional[Path] = None):
+        """Indexes an ELF file.
+
+        Args:
+            binary: The ELF file to symbolize addresses with.
+            cache_dir: An optional directory in which to keep indices between
+                runs. Indexing a large ELF file can take a while, so this saves
+                time when the same binary is symbolized repeatedly.
+        """
+        if not binary.exists():
+            raise FileNotFoundError(binary)
+
+        self._index = load_index(binary, cache_dir)
+
+    def symbolize(self, address: int) -> symbolizer.Symbol:
+        """Symbolizes an address using the indexed ELF file."""
+        return self._index.symbolize(address)
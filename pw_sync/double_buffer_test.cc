@@ -0,0 +1,87 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_sync/double_buffer.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::sync {
+namespace {
+
+using Table = std::array<uint16_t, 8>;
+
+constexpr Table kTableA = {1, 2, 3, 4, 5, 6, 7, 8};
+constexpr Table kTableB = {10, 20, 30, 40, 50, 60, 70, 80};
+constexpr Table kTableC = {100, 200, 300, 400, 500, 600, 700, 800};
+
+TEST(DoubleBuffer, DefaultConstructed_ValueInitialized) {
+  DoubleBuffer<Table> buffer;
+  EXPECT_EQ(*buffer.Read(), Table{});
+}
+
+TEST(DoubleBuffer, Read_ReturnsInitialValue) {
+  DoubleBuffer<Table> buffer(kTableA);
+  auto snapshot = buffer.Read();
+  EXPECT_EQ(*snapshot, kTableA);
+  EXPECT_EQ(snapshot->size(), 8u);
+}
+
+TEST(DoubleBuffer, TryPublish_NoReaders_Succeeds) {
+  DoubleBuffer<Table> buffer(kTableA);
+  EXPECT_TRUE(buffer.TryPublish(kTableB));
+  EXPECT_EQ(*buffer.Read(), kTableB);
+  EXPECT_TRUE(buffer.TryPublish(kTableC));
+  EXPECT_EQ(*buffer.Read(), kTableC);
+}
+
+TEST(DoubleBuffer, Snapshot_UnchangedByPublish) {
+  DoubleBuffer<Table> buffer(kTableA);
+  auto snapshot = buffer.Read();
+  ASSERT_TRUE(buffer.TryPublish(kTableB));
+  EXPECT_EQ(*snapshot, kTableA);
+  EXPECT_EQ(*buffer.Read(), kTableB);
+}
+
+TEST(DoubleBuffer, TryPublish_PreviousValueHeld_Fails) {
+  DoubleBuffer<Table> buffer(kTableA);
+  {
+    auto snapshot = buffer.Read();
+    ASSERT_TRUE(buffer.TryPublish(kTableB));
+    // Publishing again would overwrite the snapshot's buffer.
+    EXPECT_FALSE(buffer.TryPublish(kTableC));
+    EXPECT_EQ(*snapshot, kTableA);
+    EXPECT_EQ(*buffer.Read(), kTableB);
+  }
+  EXPECT_TRUE(buffer.TryPublish(kTableC));
+  EXPECT_EQ(*buffer.Read(), kTableC);
+}
+
+TEST(DoubleBuffer, MovedSnapshot_ReleasedOnce) {
+  DoubleBuffer<Table> buffer(kTableA);
+  {
+    auto snapshot = buffer.Read();
+    auto moved = std::move(snapshot);
+    EXPECT_EQ(*moved, kTableA);
+    ASSERT_TRUE(buffer.TryPublish(kTableB));
+    EXPECT_FALSE(buffer.TryPublish(kTableC));
+  }
+  EXPECT_TRUE(buffer.TryPublish(kTableC));
+}
+
+}  // namespace
+}  // namespace pw::sync
@@ -0,0 +1,117 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace pw::sync {
+
+/// Publishes a value that is read far more often than it is written, such as
+/// a table of calibration data.
+///
+/// The value is kept in two buffers. Readers read the current buffer in place
+/// through a `Snapshot`, while the writer fills in the other buffer and then
+/// publishes it by advancing an epoch. Readers never take a lock or wait for
+/// the writer, so snapshots may be taken from interrupt context.
+///
+/// The writer never overwrites a buffer that a reader holds a snapshot of.
+/// Instead, `TryPublish()` fails if a snapshot of the previous value is still
+/// held, and should be retried later. Keep snapshots short-lived so that
+/// publishing is not held off.
+///
+/// Only one writer may call `TryPublish()` at a time. If there are several
+/// writers, serialize them with a lock such as a `pw::sync::Mutex`.
+template <typename T>
+class DoubleBuffer {
+ public:
+  /// A reader's view of the published value. The value does not change while
+  /// the snapshot is held.
+  class Snapshot {
+   public:
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    Snapshot(Snapshot&& other)
+        : value_(other.value_), readers_(other.readers_) {
+      other.readers_ = nullptr;
+    }
+    Snapshot& operator=(Snapshot&&) = delete;
+
+    ~Snapshot() {
+      if (readers_ != nullptr) {
+        readers_->fetch_sub(1, std::memory_order_release);
+      }
+    }
+
+    const T& operator*() const { return value_; }
+    const T* operator->() const { return &value_; }
+
+   private:
+    friend class DoubleBuffer;
+
+    Snapshot(const T& value, std::atomic<uint32_t>& readers)
+        : value_(value), readers_(&readers) {}
+
+    const T& value_;
+    std::atomic<uint32_t>* readers_;
+  };
+
+  DoubleBuffer() : buffers_{} {}
+
+  explicit DoubleBuffer(const T& value) : buffers_{value, value} {}
+
+  DoubleBuffer(const DoubleBuffer&) = delete;
+  DoubleBuffer& operator=(const DoubleBuffer&) = delete;
+
+  /// Returns a snapshot of the most recently published value. Lock-free; this
+  /// only retries if a value is published while the snapshot is taken.
+  Snapshot Read() const {
+    while (true) {
+      const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+      std::atomic<uint32_t>& readers = readers_[epoch % 2];
+      readers.fetch_add(1, std::memory_order_seq_cst);
+      // Once counted as a reader, this buffer cannot be overwritten. Check
+      // that it was not replaced before the count became visible.
+      if (epoch_.load(std::memory_order_seq_cst) == epoch) {
+        return Snapshot(buffers_[epoch % 2], readers);
+      }
+      readers.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  /// Copies `value` into the unused buffer and publishes it. Only one thread
+  /// may publish at a time.
+  ///
+  /// @returns `false` without changing the published value if a snapshot of
+  /// the previous value is still held.
+  [[nodiscard]] bool TryPublish(const T& value) {
+    const uint32_t epoch = epoch_.load(std::memory_order_relaxed);
+    const uint32_t next = (epoch + 1) % 2;
+    if (readers_[next].load(std::memory_order_seq_cst) != 0) {
+      return false;
+    }
+    buffers_[next] = value;
+    epoch_.store(epoch + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+ private:
+  // The buffer at index `epoch_ % 2` holds the published value.
+  std::atomic<uint32_t> epoch_{0};
+  mutable std::atomic<uint32_t> readers_[2] = {};
+  T buffers_[2];
+};
+
+}  // namespace pw::sync
@@ -0,0 +1,132 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+namespace pw::sync {
+
+/// A sequence lock, which holds a small value that is read far more often than
+/// it is written.
+///
+/// Readers never block the writer or each other, and never take a lock, so
+/// the value may be read from interrupt context. Instead, each read copies the
+/// value and checks a sequence number to detect whether a write happened at
+/// the same time. A write never waits for readers.
+///
+/// Only one writer may call `store()` at a time. If there are several writers,
+/// serialize them with a lock such as a `pw::sync::Mutex`.
+///
+/// `T` must be trivially copyable. Since each read copies the whole value,
+/// SeqLock is best suited to values of a few words. For larger data that is
+/// read in place, see `pw::sync::DoubleBuffer`.
+template <typename T>
+class SeqLock {
+ public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SeqLock values are copied byte by byte, so they must be "
+                "trivially copyable");
+  static_assert(std::is_default_constructible_v<T>,
+                "SeqLock values must be default constructible");
+
+  SeqLock() : SeqLock(T{}) {}
+
+  explicit SeqLock(const T& value) { Write(value); }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  /// Replaces the value. Does not wait for readers. Only one thread may store
+  /// at a time.
+  void store(const T& value) {
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    // An odd sequence number marks a write in progress. The fence keeps the
+    // writes to the value from being reordered before the mark.
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Write(value);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /// Reads the value in a single attempt, without spinning.
+  ///
+  /// This is safe to call from interrupt context, including an interrupt that
+  /// preempts the writer.
+  ///
+  /// @returns The value, or `std::nullopt` if a write was in progress or
+  /// completed during the read.
+  std::optional<T> try_load() const {
+    const uint32_t before = sequence_.load(std::memory_order_acquire);
+    if (before % 2 != 0) {
+      return std::nullopt;
+    }
+    T value = Read();
+    // Keep the reads of the value from being reordered after the check.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  /// Reads the value, retrying until no write happened during the read.
+  ///
+  /// This spins while a write is in progress, so it must not be called where
+  /// it can preempt the writer, such as an interrupt on the writer's core. Use
+  /// `try_load()` there instead.
+  T load() const {
+    while (true) {
+      if (std::optional<T> value = try_load(); value.has_value()) {
+        return *value;
+      }
+    }
+  }
+
+ private:
+  using Word = uintptr_t;
+
+  static constexpr size_t kWords =
+      (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+  // The value is kept in atomic words so that a read during a write is a
+  // detectable inconsistency rather than a data race.
+  void Write(const T& value) {
+    std::array<Word, kWords> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  T Read() const {
+    std::array<Word, kWords> words;
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    T value;
+    std::memcpy(&value, words.data(), sizeof(T));
+    return value;
+  }
+
+  std::atomic<uint32_t> sequence_{0};
+  std::array<std::atomic<Word>, kWords> words_{};
+};
+
+}  // namespace pw::sync
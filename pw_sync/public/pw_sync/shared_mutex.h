@@ -0,0 +1,108 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync_backend/shared_mutex_native.h"
+
+namespace pw::sync {
+
+/// The `SharedMutex` is a synchronization primitive that can be used to
+/// protect shared data from being simultaneously accessed by multiple threads,
+/// while allowing any number of readers to hold it at once. It offers two
+/// levels of non-recursive ownership:
+///
+/// - Exclusive ownership, through `lock()`, for a single writer.
+/// - Shared ownership, through `lock_shared()`, for any number of readers.
+///
+/// This is useful for read-mostly data, where readers would otherwise
+/// serialize on a `Mutex`. It meets the C++ SharedLockable requirements, so it
+/// can be used with `std::shared_lock` as well as `std::lock_guard`. This is
+/// thread safe, but NOT IRQ safe.
+///
+/// Whether waiting writers are favored over new readers is backend-defined.
+///
+/// @rst
+/// .. warning::
+///
+///    In order to support global statically constructed SharedMutexes, the
+///    user and/or backend MUST ensure that any initialization required in your
+///    environment is done prior to the creation and/or initialization of the
+///    native synchronization primitives (e.g. kernel initialization).
+/// @endrst
+class PW_LOCKABLE("pw::sync::SharedMutex") SharedMutex {
+ public:
+  using native_handle_type = backend::NativeSharedMutexHandle;
+
+  SharedMutex();
+  ~SharedMutex();
+  SharedMutex(const SharedMutex&) = delete;
+  SharedMutex(SharedMutex&&) = delete;
+  SharedMutex& operator=(const SharedMutex&) = delete;
+  SharedMutex& operator=(SharedMutex&&) = delete;
+
+  /// Locks the mutex for exclusive ownership, blocking indefinitely. Failures
+  /// are fatal.
+  ///
+  /// @b PRECONDITION:
+  ///   The lock isn't already held by this thread. Recursive locking is
+  ///   undefined behavior.
+  void lock() PW_EXCLUSIVE_LOCK_FUNCTION();
+
+  /// Attempts to lock the mutex for exclusive ownership in a non-blocking
+  /// manner. Returns true if the mutex was successfully acquired.
+  ///
+  /// @b PRECONDITION:
+  ///   The lock isn't already held by this thread. Recursive locking is
+  ///   undefined behavior.
+  bool try_lock() PW_EXCLUSIVE_TRYLOCK_FUNCTION(true);
+
+  /// Releases exclusive ownership of the mutex. Failures are fatal.
+  ///
+  /// @b PRECONDITION:
+  ///   The mutex is exclusively held by this thread.
+  void unlock() PW_UNLOCK_FUNCTION();
+
+  /// Locks the mutex for shared ownership, blocking indefinitely. Failures are
+  /// fatal.
+  ///
+  /// @b PRECONDITION:
+  ///   The lock isn't already held by this thread. Recursive locking is
+  ///   undefined behavior.
+  void lock_shared() PW_SHARED_LOCK_FUNCTION();
+
+  /// Attempts to lock the mutex for shared ownership in a non-blocking manner.
+  /// Returns true if the mutex was successfully acquired.
+  ///
+  /// @b PRECONDITION:
+  ///   The lock isn't already held by this thread. Recursive locking is
+  ///   undefined behavior.
+  bool try_lock_shared() PW_SHARED_TRYLOCK_FUNCTION(true);
+
+  /// Releases shared ownership of the mutex. Failures are fatal.
+  ///
+  /// @b PRECONDITION:
+  ///   The mutex is held for shared ownership by this thread.
+  void unlock_shared() PW_UNLOCK_FUNCTION();
+
+  native_handle_type native_handle();
+
+ private:
+  /// This may be a wrapper around a native type with additional members.
+  backend::NativeSharedMutex native_type_;
+};
+
+}  // namespace pw::sync
+
+#include "pw_sync_backend/shared_mutex_inline.h"
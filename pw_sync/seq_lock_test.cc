@@ -0,0 +1,78 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_sync/seq_lock.h"
+
+#include <cstdint>
+#include <optional>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::sync {
+namespace {
+
+struct Calibration {
+  int32_t offset;
+  uint16_t gain;
+  uint8_t channel;
+};
+
+TEST(SeqLock, DefaultConstructed_ValueInitialized) {
+  SeqLock<uint32_t> seq_lock;
+  EXPECT_EQ(seq_lock.load(), 0u);
+}
+
+TEST(SeqLock, Constructed_LoadsInitialValue) {
+  SeqLock<Calibration> seq_lock(Calibration{-5, 300, 2});
+  const Calibration value = seq_lock.load();
+  EXPECT_EQ(value.offset, -5);
+  EXPECT_EQ(value.gain, 300u);
+  EXPECT_EQ(value.channel, 2u);
+}
+
+TEST(SeqLock, Store_LoadsLatestValue) {
+  SeqLock<Calibration> seq_lock;
+  seq_lock.store(Calibration{1, 2, 3});
+  seq_lock.store(Calibration{4, 5, 6});
+  const Calibration value = seq_lock.load();
+  EXPECT_EQ(value.offset, 4);
+  EXPECT_EQ(value.gain, 5u);
+  EXPECT_EQ(value.channel, 6u);
+}
+
+TEST(SeqLock, TryLoad_NoWriteInProgress_Succeeds) {
+  SeqLock<uint64_t> seq_lock(0x0123456789abcdef);
+  std::optional<uint64_t> value = seq_lock.try_load();
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(*value, 0x0123456789abcdefu);
+}
+
+TEST(SeqLock, LargerThanAWord) {
+  struct Table {
+    uint8_t entries[13];
+  };
+  Table table{};
+  for (uint8_t i = 0; i < sizeof(table.entries); ++i) {
+    table.entries[i] = i;
+  }
+  SeqLock<Table> seq_lock;
+  seq_lock.store(table);
+  const Table value = seq_lock.load();
+  for (uint8_t i = 0; i < sizeof(table.entries); ++i) {
+    EXPECT_EQ(value.entries[i], i);
+  }
+}
+
+}  // namespace
+}  // namespace pw::sync
@@ -0,0 +1,196 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_sync/shared_mutex.h"
+
+#include <mutex>
+#include <shared_mutex>
+
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::sync {
+namespace {
+
+TEST(SharedMutex, LockUnlock) {
+  SharedMutex mutex;
+  mutex.lock();
+  mutex.unlock();
+}
+
+TEST(SharedMutex, TryLock_Unlocked_Succeeds) {
+  SharedMutex mutex;
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(SharedMutex, TryLockShared_HeldExclusively_Fails) {
+  SharedMutex mutex;
+  mutex.lock();
+  EXPECT_FALSE(mutex.try_lock_shared());
+  mutex.unlock();
+}
+
+TEST(SharedMutex, LockSharedUnlockShared) {
+  SharedMutex mutex;
+  mutex.lock_shared();
+  mutex.unlock_shared();
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(SharedMutex, LockShared_MultipleReaders) {
+  SharedMutex mutex;
+  mutex.lock_shared();
+  ASSERT_TRUE(mutex.try_lock_shared());
+  mutex.unlock_shared();
+  mutex.unlock_shared();
+}
+
+TEST(SharedMutex, TryLock_HeldShared_Fails) {
+  SharedMutex mutex;
+  mutex.lock_shared();
+  EXPECT_FALSE(mutex.try_lock());
+  mutex.unlock_shared();
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(SharedMutex, StandardLockTypes) {
+  SharedMutex mutex;
+  {
+    std::shared_lock reader_1(mutex);
+    std::shared_lock reader_2(mutex);
+    EXPECT_FALSE(mutex.try_lock());
+  }
+  {
+    std::lock_guard writer(mutex);
+    EXPECT_FALSE(mutex.try_lock_shared());
+  }
+}
+
+// Holds a shared lock on a thread of its own until the test releases it.
+class Reader : public thread::ThreadCore {
+ public:
+  explicit Reader(SharedMutex& mutex) : mutex_(mutex) {}
+
+  // Released once the reader holds the shared lock.
+  ThreadNotification locked;
+
+  // Released by the test to make the reader drop the shared lock.
+  ThreadNotification done;
+
+ private:
+  void Run() override {
+    mutex_.lock_shared();
+    locked.release();
+    done.acquire();
+    mutex_.unlock_shared();
+  }
+
+  SharedMutex& mutex_;
+};
+
+TEST(SharedMutex, ConcurrentReaders_ExcludeWriter) {
+  SharedMutex mutex;
+  Reader reader_0(mutex);
+  Reader reader_1(mutex);
+  thread::test::TestThreadContext context_0;
+  thread::test::TestThreadContext context_1;
+  thread::Thread thread_0(context_0.options(), reader_0);
+  thread::Thread thread_1(context_1.options(), reader_1);
+
+  // Neither reader unlocks before `done` is released, so both hold the lock at
+  // the same time.
+  reader_0.locked.acquire();
+  reader_1.locked.acquire();
+  EXPECT_FALSE(mutex.try_lock());
+
+  reader_0.done.release();
+  thread_0.join();
+  EXPECT_FALSE(mutex.try_lock());
+
+  reader_1.done.release();
+  thread_1.join();
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+struct TryLockResults {
+  SharedMutex* mutex;
+  bool exclusive = true;
+  bool shared = true;
+};
+
+void TryLockBothWays(void* arg) {
+  auto& results = *static_cast<TryLockResults*>(arg);
+  results.exclusive = results.mutex->try_lock();
+  if (results.exclusive) {
+    results.mutex->unlock();
+  }
+  results.shared = results.mutex->try_lock_shared();
+  if (results.shared) {
+    results.mutex->unlock_shared();
+  }
+}
+
+TEST(SharedMutex, Writer_ExcludesOtherThreads) {
+  SharedMutex mutex;
+  TryLockResults results{&mutex};
+  thread::test::TestThreadContext context;
+
+  mutex.lock();
+  thread::Thread(context.options(), TryLockBothWays, &results).join();
+  mutex.unlock();
+
+  EXPECT_FALSE(results.exclusive);
+  EXPECT_FALSE(results.shared);
+}
+
+SharedMutex static_shared_mutex;
+
+class Guarded {
+ public:
+  int Read() const PW_LOCKS_EXCLUDED(mutex_) {
+    mutex_.lock_shared();
+    const int value = value_;
+    mutex_.unlock_shared();
+    return value;
+  }
+
+  void Write(int value) PW_LOCKS_EXCLUDED(mutex_) {
+    mutex_.lock();
+    value_ = value;
+    mutex_.unlock();
+  }
+
+ private:
+  mutable SharedMutex mutex_;
+  int value_ PW_GUARDED_BY(mutex_) = 0;
+};
+
+TEST(SharedMutex, StaticAndGuardedData) {
+  static_shared_mutex.lock_shared();
+  static_shared_mutex.unlock_shared();
+
+  Guarded guarded;
+  guarded.Write(42);
+  EXPECT_EQ(guarded.Read(), 42);
+}
+
+}  // namespace
+}  // namespace pw::sync
@@ -73,7 +73,7 @@ bool CountingSemaphore::try_acquire_for(SystemClock::duration timeout) {
       pw::chrono::freertos::kMaxTimeout - SystemClock::duration(1);
   while (timeout > kMaxTimeoutMinusOne) {
     if (xSemaphoreTake(reinterpret_cast<SemaphoreHandle_t>(&native_type_),
-                       static_cast<TickType_t>(kMaxTimeoutMinusOne.count())) ==
+                       pw::chrono::freertos::ToTicks(kMaxTimeoutMinusOne)) ==
         pdTRUE) {
       return true;
     }
@@ -82,7 +82,9 @@ bool CountingSemaphore::try_acquire_for(SystemClock::duration timeout) {
   // On a tick based kernel we cannot tell how far along we are on the current
   // tick, ergo we add one whole tick to the final duration.
   return xSemaphoreTake(reinterpret_cast<SemaphoreHandle_t>(&native_type_),
-                        static_cast<TickType_t>(timeout.count() + 1)) == pdTRUE;
+                        static_cast<TickType_t>(
+                            pw::chrono::freertos::ToTicks(timeout) + 1)) ==
+         pdTRUE;
 }
 
 }  // namespace pw::sync
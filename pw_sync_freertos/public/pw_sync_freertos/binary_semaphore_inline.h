@@ -57,7 +57,8 @@ inline void BinarySemaphore::acquire() {
   // In case we need to block for longer than the FreeRTOS delay can represent
   // repeatedly hit take until success.
   while (xSemaphoreTake(reinterpret_cast<SemaphoreHandle_t>(&native_type_),
-                        chrono::freertos::kMaxTimeout.count()) == pdFALSE) {
+                        chrono::freertos::ToTicks(
+                            chrono::freertos::kMaxTimeout)) == pdFALSE) {
   }
 #endif  // INCLUDE_vTaskSuspend
 }
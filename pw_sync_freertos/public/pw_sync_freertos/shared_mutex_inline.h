@@ -0,0 +1,54 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "FreeRTOS.h"
+#include "pw_assert/assert.h"
+#include "pw_interrupt/context.h"
+#include "pw_sync/shared_mutex.h"
+#include "semphr.h"
+
+namespace pw::sync {
+namespace backend {
+
+static_assert(configUSE_MUTEXES != 0, "FreeRTOS mutexes aren't enabled.");
+
+static_assert(configSUPPORT_STATIC_ALLOCATION != 0,
+              "FreeRTOS static allocations are required for this backend.");
+
+inline SemaphoreHandle_t SharedMutexOwner(NativeSharedMutex& native) {
+  return reinterpret_cast<SemaphoreHandle_t>(&native.owner);
+}
+
+}  // namespace backend
+
+inline bool SharedMutex::try_lock() {
+  // Enforce the pw::sync::SharedMutex IRQ contract.
+  PW_DASSERT(!interrupt::InInterruptContext());
+  return xSemaphoreTake(backend::SharedMutexOwner(native_type_), 0) == pdTRUE;
+}
+
+inline void SharedMutex::unlock() {
+  // Enforce the pw::sync::SharedMutex IRQ contract.
+  PW_DASSERT(!interrupt::InInterruptContext());
+  const BaseType_t result =
+      xSemaphoreGive(backend::SharedMutexOwner(native_type_));
+  PW_DASSERT(result == pdTRUE);
+}
+
+inline SharedMutex::native_handle_type SharedMutex::native_handle() {
+  return native_type_;
+}
+
+}  // namespace pw::sync
@@ -0,0 +1,36 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+namespace pw::sync::backend {
+
+// FreeRTOS has no reader-writer lock, so one is built from a binary semaphore
+// that is held by either the writer or by the readers as a group, and a mutex
+// that guards the count of readers. A semaphore is used for the former since
+// the last reader to unlock may not be the first reader that locked it.
+//
+// Readers are preferred: a writer waits until no readers hold the lock.
+struct NativeSharedMutex {
+  StaticSemaphore_t owner;          // Binary semaphore; held by the owner(s).
+  StaticSemaphore_t readers_mutex;  // Guards readers.
+  uint32_t readers;
+};
+using NativeSharedMutexHandle = NativeSharedMutex&;
+
+}  // namespace pw::sync::backend
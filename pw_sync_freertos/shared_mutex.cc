@@ -0,0 +1,115 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_sync/shared_mutex.h"
+
+#include "FreeRTOS.h"
+#include "pw_assert/check.h"
+#include "pw_chrono_freertos/system_clock_constants.h"
+#include "pw_interrupt/context.h"
+#include "semphr.h"
+
+namespace pw::sync {
+namespace {
+
+void TakeIndefinitely(SemaphoreHandle_t handle) {
+#if INCLUDE_vTaskSuspend == 1  // This means portMAX_DELAY is indefinite.
+  const BaseType_t result = xSemaphoreTake(handle, portMAX_DELAY);
+  PW_DCHECK_INT_EQ(result, pdTRUE);
+#else
+  // In case we need to block for longer than the FreeRTOS delay can represent
+  // repeatedly hit take until success.
+  while (xSemaphoreTake(handle,
+                        chrono::freertos::ToTicks(
+                            chrono::freertos::kMaxTimeout)) == pdFALSE) {
+  }
+#endif  // INCLUDE_vTaskSuspend
+}
+
+void Give(SemaphoreHandle_t handle) {
+  const BaseType_t result = xSemaphoreGive(handle);
+  PW_DCHECK_INT_EQ(result, pdTRUE);
+}
+
+SemaphoreHandle_t ReadersMutex(backend::NativeSharedMutex& native) {
+  return reinterpret_cast<SemaphoreHandle_t>(&native.readers_mutex);
+}
+
+}  // namespace
+
+SharedMutex::SharedMutex() : native_type_() {
+  const SemaphoreHandle_t owner =
+      xSemaphoreCreateBinaryStatic(&native_type_.owner);
+  const SemaphoreHandle_t readers_mutex =
+      xSemaphoreCreateMutexStatic(&native_type_.readers_mutex);
+  // These should never fail since the pointers provided were not null.
+  PW_DCHECK(owner == backend::SharedMutexOwner(native_type_));
+  PW_DCHECK(readers_mutex == ReadersMutex(native_type_));
+  Give(owner);  // Binary semaphores are created empty, i.e. locked.
+}
+
+SharedMutex::~SharedMutex() {
+  vSemaphoreDelete(ReadersMutex(native_type_));
+  vSemaphoreDelete(backend::SharedMutexOwner(native_type_));
+}
+
+void SharedMutex::lock() {
+  // Enforce the pw::sync::SharedMutex IRQ contract.
+  PW_DCHECK(!interrupt::InInterruptContext());
+  TakeIndefinitely(backend::SharedMutexOwner(native_type_));
+}
+
+void SharedMutex::lock_shared() {
+  // Enforce the pw::sync::SharedMutex IRQ contract.
+  PW_DCHECK(!interrupt::InInterruptContext());
+  TakeIndefinitely(ReadersMutex(native_type_));
+  // The first reader takes ownership on behalf of all readers. While it waits
+  // for a writer, later readers wait for it on the readers mutex.
+  if (native_type_.readers++ == 0) {
+    TakeIndefinitely(backend::SharedMutexOwner(native_type_));
+  }
+  Give(ReadersMutex(native_type_));
+}
+
+bool SharedMutex::try_lock_shared() {
+  // Enforce the pw::sync::SharedMutex IRQ contract.
+  PW_DCHECK(!interrupt::InInterruptContext());
+  if (xSemaphoreTake(ReadersMutex(native_type_), 0) == pdFALSE) {
+    return false;
+  }
+  bool locked = true;
+  if (native_type_.readers == 0) {
+    locked =
+        xSemaphoreTake(backend::SharedMutexOwner(native_type_), 0) == pdTRUE;
+  }
+  if (locked) {
+    ++native_type_.readers;
+  }
+  Give(ReadersMutex(native_type_));
+  return locked;
+}
+
+void SharedMutex::unlock_shared() {
+  // Enforce the pw::sync::SharedMutex IRQ contract.
+  PW_DCHECK(!interrupt::InInterruptContext());
+  TakeIndefinitely(ReadersMutex(native_type_));
+  PW_DCHECK_UINT_NE(native_type_.readers, 0, "SharedMutex is not held shared");
+  // The last reader releases ownership on behalf of all readers.
+  if (--native_type_.readers == 0) {
+    Give(backend::SharedMutexOwner(native_type_));
+  }
+  Give(ReadersMutex(native_type_));
+}
+
+}  // namespace pw::sync
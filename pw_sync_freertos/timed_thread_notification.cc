@@ -80,7 +80,7 @@ bool TimedThreadNotification::try_acquire_until(
     // Note that this must be greater than zero, due to the condition above.
     const SystemClock::duration timeout =
         std::min(deadline - now, pw::chrono::freertos::kMaxTimeout);
-    if (WaitForNotification(static_cast<TickType_t>(timeout.count())) ==
+    if (WaitForNotification(pw::chrono::freertos::ToTicks(timeout)) ==
         pdTRUE) {
       break;  // We were notified!
     }
@@ -0,0 +1,150 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_sync_linux/internal/futex.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+
+#include "pw_assert/check.h"
+#include "pw_sync/yield_core.h"
+
+namespace pw::sync::backend {
+namespace {
+
+long Futex(FutexWord& word,
+           int op,
+           uint32_t value,
+           const struct timespec* timeout,
+           uint32_t value3) {
+  return syscall(SYS_futex,
+                 reinterpret_cast<uint32_t*>(&word),
+                 op | FUTEX_PRIVATE_FLAG,
+                 value,
+                 timeout,
+                 nullptr,
+                 value3);
+}
+
+}  // namespace
+
+void FutexWait(FutexWord& word, uint32_t expected) {
+  if (Futex(word, FUTEX_WAIT, expected, nullptr, 0) != 0) {
+    // EAGAIN: the word changed before sleeping. EINTR: interrupted by a signal.
+    PW_CHECK(errno == EAGAIN || errno == EINTR, "FUTEX_WAIT failed: %d", errno);
+  }
+}
+
+bool FutexWaitUntil(FutexWord& word,
+                    uint32_t expected,
+                    chrono::SystemClock::time_point deadline) {
+  // The STL SystemClock is std::chrono::steady_clock, which is
+  // CLOCK_MONOTONIC, the clock that FUTEX_WAIT_BITSET uses for its absolute
+  // timeout.
+  const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      deadline.time_since_epoch());
+  if (since_epoch.count() < 0) {
+    return false;
+  }
+  const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+  struct timespec timeout = {};
+  timeout.tv_sec = static_cast<time_t>(seconds.count());
+  timeout.tv_nsec = static_cast<long>((since_epoch - seconds).count());
+
+  if (Futex(word,
+            FUTEX_WAIT_BITSET,
+            expected,
+            &timeout,
+            FUTEX_BITSET_MATCH_ANY) != 0) {
+    if (errno == ETIMEDOUT) {
+      return false;
+    }
+    PW_CHECK(errno == EAGAIN || errno == EINTR,
+             "FUTEX_WAIT_BITSET failed: %d",
+             errno);
+  }
+  return true;
+}
+
+void FutexWake(FutexWord& word, int count) {
+  const long result =
+      Futex(word, FUTEX_WAKE, static_cast<uint32_t>(count), nullptr, 0);
+  PW_CHECK(result >= 0, "FUTEX_WAKE failed: %d", errno);
+}
+
+bool FutexSemaphore::try_acquire() {
+  uint32_t current = count.load(std::memory_order_relaxed);
+  while (current != 0) {
+    if (count.compare_exchange_weak(current,
+                                    current - 1,
+                                    std::memory_order_acquire,
+                                    std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FutexSemaphore::acquire() {
+  if (Spin()) {
+    return;
+  }
+  while (!try_acquire()) {
+    waiters.fetch_add(1);
+    FutexWait(count, 0);
+    waiters.fetch_sub(1);
+  }
+}
+
+bool FutexSemaphore::try_acquire_until(
+    chrono::SystemClock::time_point deadline) {
+  if (Spin()) {
+    return true;
+  }
+  while (!try_acquire()) {
+    waiters.fetch_add(1);
+    const bool woken = FutexWaitUntil(count, 0, deadline);
+    waiters.fetch_sub(1);
+    if (!woken) {
+      return try_acquire();
+    }
+  }
+  return true;
+}
+
+void FutexSemaphore::WakeWaiters(int woken) {
+  // The count was increased before this load, so a thread that increments
+  // waiters afterwards sees the new count in FutexWait() and does not sleep.
+  if (waiters.load() != 0) {
+    FutexWake(count, woken);
+  }
+}
+
+bool FutexSemaphore::Spin() {
+  for (int i = 0; i < kFutexSpinCount; ++i) {
+    if (try_acquire()) {
+      return true;
+    }
+    PW_SYNC_YIELD_CORE_FOR_SMT();
+  }
+  return false;
+}
+
+}  // namespace pw::sync::backend
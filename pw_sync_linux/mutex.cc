@@ -0,0 +1,73 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_sync/mutex.h"
+
+#include "pw_assert/check.h"
+#include "pw_sync/yield_core.h"
+#include "pw_sync_linux/mutex_native.h"
+
+namespace pw::sync {
+
+Mutex::~Mutex() {
+  PW_CHECK_UINT_EQ(native_type_.state.load(),
+                   backend::NativeMutex::kUnlocked,
+                   "Mutex was locked when it went out of scope");
+}
+
+namespace backend {
+
+void NativeMutex::LockSlow() {
+  if (Spin()) {
+    return;
+  }
+  // Mark the mutex as contended so that the owner wakes a sleeping thread when
+  // it unlocks. If the mutex was unlocked, this locks it.
+  while (state.exchange(kContended, std::memory_order_acquire) != kUnlocked) {
+    FutexWait(state, kContended);
+  }
+}
+
+bool NativeMutex::LockSlowUntil(chrono::SystemClock::time_point deadline) {
+  if (Spin()) {
+    return true;
+  }
+  while (state.exchange(kContended, std::memory_order_acquire) != kUnlocked) {
+    if (!FutexWaitUntil(state, kContended, deadline)) {
+      return state.exchange(kContended, std::memory_order_acquire) ==
+             kUnlocked;
+    }
+  }
+  return true;
+}
+
+void NativeMutex::UnlockSlow(uint32_t previous_state) {
+  PW_CHECK_UINT_NE(previous_state,
+                   kUnlocked,
+                   "Called unlock(), but the mutex is already unlocked");
+  FutexWake(state, 1);
+}
+
+bool NativeMutex::Spin() {
+  for (int i = 0; i < kFutexSpinCount; ++i) {
+    if (state.load(std::memory_order_relaxed) == kUnlocked && TryLock()) {
+      return true;
+    }
+    PW_SYNC_YIELD_CORE_FOR_SMT();
+  }
+  return false;
+}
+
+}  // namespace backend
+}  // namespace pw::sync
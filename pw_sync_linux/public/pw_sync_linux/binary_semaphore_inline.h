@@ -0,0 +1,53 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_sync/binary_semaphore.h"
+
+namespace pw::sync {
+
+inline BinarySemaphore::BinarySemaphore() : native_type_() {}
+
+inline BinarySemaphore::~BinarySemaphore() {}
+
+inline void BinarySemaphore::release() {
+  if (native_type_.count.exchange(1) == 0) {
+    native_type_.WakeWaiters(1);
+  }
+}
+
+inline void BinarySemaphore::acquire() { native_type_.acquire(); }
+
+inline bool BinarySemaphore::try_acquire() noexcept {
+  return native_type_.try_acquire();
+}
+
+inline bool BinarySemaphore::try_acquire_for(
+    chrono::SystemClock::duration timeout) {
+  return try_acquire_until(chrono::SystemClock::TimePointAfterAtLeast(timeout));
+}
+
+inline bool BinarySemaphore::try_acquire_until(
+    chrono::SystemClock::time_point deadline) {
+  return native_type_.try_acquire_until(deadline);
+}
+
+inline BinarySemaphore::native_handle_type BinarySemaphore::native_handle() {
+  return native_type_;
+}
+
+}  // namespace pw::sync
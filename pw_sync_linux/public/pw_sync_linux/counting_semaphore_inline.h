@@ -0,0 +1,46 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_chrono/system_clock.h"
+#include "pw_sync/counting_semaphore.h"
+
+namespace pw::sync {
+
+inline CountingSemaphore::CountingSemaphore() : native_type_() {}
+
+inline CountingSemaphore::~CountingSemaphore() {}
+
+inline void CountingSemaphore::acquire() { native_type_.acquire(); }
+
+inline bool CountingSemaphore::try_acquire() noexcept {
+  return native_type_.try_acquire();
+}
+
+inline bool CountingSemaphore::try_acquire_for(
+    chrono::SystemClock::duration timeout) {
+  return try_acquire_until(chrono::SystemClock::TimePointAfterAtLeast(timeout));
+}
+
+inline bool CountingSemaphore::try_acquire_until(
+    chrono::SystemClock::time_point deadline) {
+  return native_type_.try_acquire_until(deadline);
+}
+
+inline CountingSemaphore::native_handle_type
+CountingSemaphore::native_handle() {
+  return native_type_;
+}
+
+}  // namespace pw::sync
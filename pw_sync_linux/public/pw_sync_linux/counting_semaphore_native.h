@@ -0,0 +1,31 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "pw_sync_linux/internal/futex.h"
+
+namespace pw::sync::backend {
+
+using NativeCountingSemaphore = FutexSemaphore;
+using NativeCountingSemaphoreHandle = NativeCountingSemaphore&;
+
+// Limited so that a release() can wake every thread it made a token for.
+inline constexpr ptrdiff_t kCountingSemaphoreMaxValue =
+    std::numeric_limits<int32_t>::max();
+
+}  // namespace pw::sync::backend
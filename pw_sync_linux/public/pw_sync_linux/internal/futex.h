@@ -0,0 +1,70 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+
+namespace pw::sync::backend {
+
+// Futex words are 32-bit integers that are operated on atomically by both the
+// kernel and userspace.
+using FutexWord = std::atomic<uint32_t>;
+
+static_assert(sizeof(FutexWord) == sizeof(uint32_t) &&
+                  FutexWord::is_always_lock_free,
+              "std::atomic<uint32_t> must be usable as a futex word");
+
+// The number of times a contended primitive polls its state before sleeping in
+// the kernel. Short critical sections and handoffs between threads that are
+// running on other cores usually complete within this window, which avoids the
+// syscalls and context switches of sleeping and waking.
+inline constexpr int kFutexSpinCount = 100;
+
+// Sleeps until woken by FutexWake() if `word` still holds `expected`. May
+// return spuriously, so callers must check their condition in a loop.
+void FutexWait(FutexWord& word, uint32_t expected);
+
+// Like FutexWait(), but gives up once `deadline` has passed.
+//
+// Returns false if the deadline passed.
+bool FutexWaitUntil(FutexWord& word,
+                    uint32_t expected,
+                    chrono::SystemClock::time_point deadline);
+
+// Wakes up to `count` threads sleeping on `word`.
+void FutexWake(FutexWord& word, int count);
+
+// Semaphore token count shared by the BinarySemaphore and CountingSemaphore
+// backends. Acquiring spins briefly before sleeping, and releasing only makes
+// a syscall if a thread is sleeping.
+struct FutexSemaphore {
+  bool try_acquire();
+  void acquire();
+  bool try_acquire_until(chrono::SystemClock::time_point deadline);
+
+  // Wakes up to `woken` sleeping threads after tokens were added to `count`.
+  void WakeWaiters(int woken);
+
+  FutexWord count{0};
+  FutexWord waiters{0};  // Threads that may be sleeping on count.
+
+ private:
+  // Polls for a token for a bounded time. Returns true if one was acquired.
+  bool Spin();
+};
+
+}  // namespace pw::sync::backend
@@ -0,0 +1,43 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+
+#include "pw_sync/mutex.h"
+
+namespace pw::sync {
+
+inline Mutex::Mutex() : native_type_() {}
+
+inline void Mutex::lock() {
+  if (!native_type_.TryLock()) {
+    native_type_.LockSlow();
+  }
+}
+
+inline bool Mutex::try_lock() { return native_type_.TryLock(); }
+
+inline void Mutex::unlock() {
+  const uint32_t previous =
+      native_type_.state.exchange(backend::NativeMutex::kUnlocked,
+                                  std::memory_order_release);
+  if (previous != backend::NativeMutex::kLocked) {
+    native_type_.UnlockSlow(previous);
+  }
+}
+
+inline Mutex::native_handle_type Mutex::native_handle() { return native_type_; }
+
+}  // namespace pw::sync
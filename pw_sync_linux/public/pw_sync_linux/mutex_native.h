@@ -0,0 +1,59 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_sync_linux/internal/futex.h"
+
+namespace pw::sync::backend {
+
+// A futex-based mutex. Uncontended locking and unlocking are a single atomic
+// operation. A contended lock spins briefly before sleeping in the kernel, and
+// unlocking only makes a syscall if another thread may be sleeping.
+struct NativeMutex {
+  enum State : uint32_t {
+    kUnlocked = 0,
+    kLocked = 1,
+    kContended = 2,  // Locked, and other threads may be sleeping.
+  };
+
+  bool TryLock() {
+    uint32_t expected = kUnlocked;
+    return state.compare_exchange_strong(expected,
+                                         kLocked,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed);
+  }
+
+  // Locks the mutex after TryLock() failed.
+  void LockSlow();
+
+  // Locks the mutex after TryLock() failed, unless `deadline` passes first.
+  bool LockSlowUntil(chrono::SystemClock::time_point deadline);
+
+  // Finishes unlocking a mutex that was not in the kLocked state.
+  void UnlockSlow(uint32_t previous_state);
+
+  FutexWord state{kUnlocked};
+
+ private:
+  // Polls for the mutex for a bounded time. Returns true if it was locked.
+  bool Spin();
+};
+
+using NativeMutexHandle = NativeMutex&;
+
+}  // namespace pw::sync::backend
@@ -0,0 +1,42 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include "pw_sync/shared_mutex.h"
+
+namespace pw::sync {
+
+inline SharedMutex::SharedMutex() : native_type_() {}
+
+inline SharedMutex::~SharedMutex() = default;
+
+inline void SharedMutex::lock() { native_type_.lock(); }
+
+inline bool SharedMutex::try_lock() { return native_type_.try_lock(); }
+
+inline void SharedMutex::unlock() { native_type_.unlock(); }
+
+inline void SharedMutex::lock_shared() { native_type_.lock_shared(); }
+
+inline bool SharedMutex::try_lock_shared() {
+  return native_type_.try_lock_shared();
+}
+
+inline void SharedMutex::unlock_shared() { native_type_.unlock_shared(); }
+
+inline SharedMutex::native_handle_type SharedMutex::native_handle() {
+  return native_type_;
+}
+
+}  // namespace pw::sync
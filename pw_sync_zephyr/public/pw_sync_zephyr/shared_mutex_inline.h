@@ -0,0 +1,50 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include "pw_assert/assert.h"
+#include "pw_interrupt/context.h"
+#include "pw_sync/shared_mutex.h"
+
+namespace pw::sync {
+
+inline SharedMutex::SharedMutex() : native_type_() {
+  k_sem_init(&native_type_.owner, 1, 1);
+  k_mutex_init(&native_type_.readers_mutex);
+}
+
+inline SharedMutex::~SharedMutex() = default;
+
+inline void SharedMutex::lock() {
+  PW_DASSERT(!interrupt::InInterruptContext());
+  PW_ASSERT(k_sem_take(&native_type_.owner, K_FOREVER) == 0);
+}
+
+inline bool SharedMutex::try_lock() {
+  PW_DASSERT(!interrupt::InInterruptContext());
+  return k_sem_take(&native_type_.owner, K_NO_WAIT) == 0;
+}
+
+inline void SharedMutex::unlock() {
+  PW_DASSERT(!interrupt::InInterruptContext());
+  k_sem_give(&native_type_.owner);
+}
+
+inline SharedMutex::native_handle_type SharedMutex::native_handle() {
+  return native_type_;
+}
+
+}  // namespace pw::sync
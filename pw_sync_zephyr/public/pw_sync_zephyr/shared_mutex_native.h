@@ -0,0 +1,33 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include <cstdint>
+
+namespace pw::sync::backend {
+
+// Zephyr has no reader-writer lock, so one is built from a semaphore that is
+// held by either the writer or by the readers as a group, and a mutex that
+// guards the count of readers. Readers are preferred: a writer waits until no
+// readers hold the lock.
+struct NativeSharedMutex {
+  struct k_sem owner;
+  struct k_mutex readers_mutex;
+  uint32_t readers;
+};
+using NativeSharedMutexHandle = NativeSharedMutex&;
+
+}  // namespace pw::sync::backend
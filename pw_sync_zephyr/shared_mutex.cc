@@ -0,0 +1,62 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_sync/shared_mutex.h"
+
+#include <zephyr/kernel.h>
+
+#include "pw_assert/check.h"
+#include "pw_interrupt/context.h"
+
+namespace pw::sync {
+
+void SharedMutex::lock_shared() {
+  PW_DCHECK(!interrupt::InInterruptContext());
+  PW_CHECK_INT_EQ(k_mutex_lock(&native_type_.readers_mutex, K_FOREVER), 0);
+  // The first reader takes ownership on behalf of all readers. While it waits
+  // for a writer, later readers wait for it on the readers mutex.
+  if (native_type_.readers++ == 0) {
+    PW_CHECK_INT_EQ(k_sem_take(&native_type_.owner, K_FOREVER), 0);
+  }
+  PW_CHECK_INT_EQ(k_mutex_unlock(&native_type_.readers_mutex), 0);
+}
+
+bool SharedMutex::try_lock_shared() {
+  PW_DCHECK(!interrupt::InInterruptContext());
+  if (k_mutex_lock(&native_type_.readers_mutex, K_NO_WAIT) != 0) {
+    return false;
+  }
+  bool locked = true;
+  if (native_type_.readers == 0) {
+    locked = k_sem_take(&native_type_.owner, K_NO_WAIT) == 0;
+  }
+  if (locked) {
+    ++native_type_.readers;
+  }
+  PW_CHECK_INT_EQ(k_mutex_unlock(&native_type_.readers_mutex), 0);
+  return locked;
+}
+
+void SharedMutex::unlock_shared() {
+  PW_DCHECK(!interrupt::InInterruptContext());
+  PW_CHECK_INT_EQ(k_mutex_lock(&native_type_.readers_mutex, K_FOREVER), 0);
+  PW_DCHECK_UINT_NE(native_type_.readers, 0, "SharedMutex is not held shared");
+  // The last reader releases ownership on behalf of all readers.
+  if (--native_type_.readers == 0) {
+    k_sem_give(&native_type_.owner);
+  }
+  PW_CHECK_INT_EQ(k_mutex_unlock(&native_type_.readers_mutex), 0);
+}
+
+}  // namespace pw::sync
@@ -36,20 +36,27 @@ void WaitForConnect() {
   }
 }
 
+// Blocks until a byte is received. Sys IO must be initialized and the host
+// connected.
+std::byte ReadByteBlocking() {
+  int c = PICO_ERROR_TIMEOUT;
+  while (c == PICO_ERROR_TIMEOUT) {
+    c = getchar_timeout_us(0);
+  }
+  return static_cast<std::byte>(c);
+}
+
 }  // namespace
 
-// This whole implementation is very inefficient because it only reads / writes
-// 1 byte at a time. It also does lazy initialization checks with every byte.
+// The Pico SDK's stdio only reads / writes 1 byte at a time, so ReadBytes and
+// WriteBytes loop over the stdio calls directly, checking initialization and
+// the host connection once per call rather than once per byte.
 namespace pw::sys_io {
 
 Status ReadByte(std::byte* dest) {
   LazyInitSysIo();
   WaitForConnect();
-  int c = PICO_ERROR_TIMEOUT;
-  while (c == PICO_ERROR_TIMEOUT) {
-    c = getchar_timeout_us(0);
-  }
-  *dest = static_cast<std::byte>(c);
+  *dest = ReadByteBlocking();
   return OkStatus();
 }
 
@@ -70,6 +77,23 @@ Status WriteByte(std::byte b) {
   return OkStatus();
 }
 
+StatusWithSize ReadBytes(ByteSpan dest) {
+  LazyInitSysIo();
+  WaitForConnect();
+  for (std::byte& b : dest) {
+    b = ReadByteBlocking();
+  }
+  return StatusWithSize(dest.size());
+}
+
+StatusWithSize WriteBytes(ConstByteSpan src) {
+  LazyInitSysIo();
+  for (std::byte b : src) {
+    putchar_raw(static_cast<int>(b));
+  }
+  return StatusWithSize(src.size());
+}
+
 // Writes a string using pw::sys_io, and add newline characters at the end.
 StatusWithSize WriteLine(const std::string_view& s) {
   size_t chars_written = 0;
@@ -57,3 +57,32 @@
 #ifndef PW_SYS_IO_STM32CUBE_USART_PREFIX
 #define PW_SYS_IO_STM32CUBE_USART_PREFIX USART
 #endif  // PW_SYS_IO_STM32CUBE_GPIO_AF
+
+// The size of the buffer that received bytes are written to by DMA, or 0 to
+// receive one byte at a time with the polling UART API.
+//
+// When this is nonzero, a DMA stream runs in circular mode, without
+// interrupts, and reads drain the buffer. Bytes are lost if more than this
+// many are received before they are read.
+#ifndef PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE
+#define PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE 0
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE
+
+// The DMA controller number that serves the USART RX request. (1 for DMA1, 2
+// for DMA2)
+#ifndef PW_SYS_IO_STM32CUBE_RX_DMA_NUM
+#define PW_SYS_IO_STM32CUBE_RX_DMA_NUM 2
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_NUM
+
+// The DMA stream or channel that serves the USART RX request. Defaults to
+// DMA2_Stream2, which serves USART1_RX on the STM32F429xx.
+#ifndef PW_SYS_IO_STM32CUBE_RX_DMA_INSTANCE
+#define PW_SYS_IO_STM32CUBE_RX_DMA_INSTANCE DMA2_Stream2
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_INSTANCE
+
+// The DMA channel (on STM32F2, F4 and F7 devices) or request (on devices with a
+// DMA request multiplexer) for the USART RX request. Unused on devices where
+// DMA requests are hard-wired.
+#ifndef PW_SYS_IO_STM32CUBE_RX_DMA_REQUEST
+#define PW_SYS_IO_STM32CUBE_RX_DMA_REQUEST DMA_CHANNEL_4
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_REQUEST
@@ -14,7 +14,11 @@
 
 #include "pw_sys_io/sys_io.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <limits>
 
 #include "pw_preprocessor/concat.h"
 #include "pw_status/status.h"
@@ -61,6 +65,80 @@
 
 static UART_HandleTypeDef uart;
 
+#if PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
+
+// USART_RX_DMA_ENABLE defined to __HAL_RCC_DMAn_CLK_ENABLE, where n is the DMA
+// controller index.
+#define USART_RX_DMA_ENABLE \
+  PW_CONCAT(__HAL_RCC_DMA, PW_SYS_IO_STM32CUBE_RX_DMA_NUM, _CLK_ENABLE)
+
+static DMA_HandleTypeDef uart_rx_dma;
+
+// Received bytes are written here by DMA, which wraps around to the start of
+// the buffer once it is full.
+static uint8_t rx_buffer[PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE];
+
+// The index of the next byte in rx_buffer to read.
+static size_t rx_read_index = 0;
+
+static void InitRxDma() {
+  USART_RX_DMA_ENABLE();
+#ifdef __HAL_RCC_DMAMUX1_CLK_ENABLE
+  __HAL_RCC_DMAMUX1_CLK_ENABLE();
+#endif  // __HAL_RCC_DMAMUX1_CLK_ENABLE
+
+  uart_rx_dma.Instance = PW_SYS_IO_STM32CUBE_RX_DMA_INSTANCE;
+#if defined(STM32F2) || defined(STM32F4) || defined(STM32F7)
+  uart_rx_dma.Init.Channel = PW_SYS_IO_STM32CUBE_RX_DMA_REQUEST;
+  uart_rx_dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+#elif defined(DMAMUX1)
+  uart_rx_dma.Init.Request = PW_SYS_IO_STM32CUBE_RX_DMA_REQUEST;
+#endif
+  uart_rx_dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  uart_rx_dma.Init.PeriphInc = DMA_PINC_DISABLE;
+  uart_rx_dma.Init.MemInc = DMA_MINC_ENABLE;
+  uart_rx_dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  uart_rx_dma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  uart_rx_dma.Init.Mode = DMA_CIRCULAR;
+  uart_rx_dma.Init.Priority = DMA_PRIORITY_HIGH;
+  HAL_DMA_Init(&uart_rx_dma);
+  __HAL_LINKDMA(&uart, hdmarx, uart_rx_dma);
+}
+
+// Returns the number of received bytes that have not been read yet. The DMA
+// transfer's remaining count tracks where the next byte will be written.
+static size_t RxBytesAvailable() {
+  const size_t write_index =
+      (sizeof(rx_buffer) - __HAL_DMA_GET_COUNTER(uart.hdmarx)) %
+      sizeof(rx_buffer);
+  return (write_index + sizeof(rx_buffer) - rx_read_index) % sizeof(rx_buffer);
+}
+
+static std::byte PopRxByte() {
+  std::byte b = static_cast<std::byte>(rx_buffer[rx_read_index]);
+  rx_read_index = (rx_read_index + 1) % sizeof(rx_buffer);
+  return b;
+}
+
+// Copies up to dest.size() received bytes into dest, without waiting. Returns
+// the number of bytes copied.
+static size_t PopRxBytes(pw::ByteSpan dest) {
+  size_t copied = 0;
+  size_t available = std::min(RxBytesAvailable(), dest.size());
+  while (available > 0) {
+    // Copy up to the end of the buffer, then wrap around to the start.
+    const size_t chunk =
+        std::min(available, sizeof(rx_buffer) - rx_read_index);
+    std::memcpy(&dest[copied], &rx_buffer[rx_read_index], chunk);
+    rx_read_index = (rx_read_index + chunk) % sizeof(rx_buffer);
+    copied += chunk;
+    available -= chunk;
+  }
+  return copied;
+}
+
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
+
 extern "C" void pw_sys_io_Init() {
   GPIO_InitTypeDef GPIO_InitStruct = {};
 
@@ -98,12 +176,51 @@ extern "C" void pw_sys_io_Init() {
   uart.Init.Mode = UART_MODE_TX_RX;
   uart.Init.HwFlowCtl = UART_HWCONTROL_NONE;
   uart.Init.OverSampling = UART_OVERSAMPLING_16;
+
+#if PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
+  InitRxDma();
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
   HAL_UART_Init(&uart);
+
+#if PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
+  // The DMA and USART interrupts are left disabled; reads poll the transfer's
+  // progress instead.
+  HAL_UART_Receive_DMA(&uart, rx_buffer, sizeof(rx_buffer));
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
 }
 
-// This whole implementation is very inefficient because it uses the synchronous
-// polling UART API and only reads / writes 1 byte at a time.
+// Writes and blocking reads of several bytes are passed to the UART API in one
+// call. Unless PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE is set, reads use the
+// synchronous polling UART API, so bytes that arrive between reads are lost.
 namespace pw::sys_io {
+
+// The HAL's transfer functions take a 16-bit size.
+constexpr size_t kMaxTransferSize = std::numeric_limits<uint16_t>::max();
+
+#if PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
+Status ReadByte(std::byte* dest) {
+  while (RxBytesAvailable() == 0) {
+  }
+  *dest = PopRxByte();
+  return OkStatus();
+}
+
+Status TryReadByte(std::byte* dest) {
+  if (RxBytesAvailable() == 0) {
+    return Status::Unavailable();
+  }
+  *dest = PopRxByte();
+  return OkStatus();
+}
+
+StatusWithSize ReadBytes(ByteSpan dest) {
+  size_t bytes_read = 0;
+  while (bytes_read < dest.size()) {
+    bytes_read += PopRxBytes(dest.subspan(bytes_read));
+  }
+  return StatusWithSize(bytes_read);
+}
+#else
 Status ReadByte(std::byte* dest) {
   if (HAL_UART_Receive(
           &uart, reinterpret_cast<uint8_t*>(dest), 1, HAL_MAX_DELAY) !=
@@ -115,6 +232,22 @@ Status ReadByte(std::byte* dest) {
 
 Status TryReadByte(std::byte* dest) { return Status::Unimplemented(); }
 
+StatusWithSize ReadBytes(ByteSpan dest) {
+  size_t bytes_read = 0;
+  while (bytes_read < dest.size()) {
+    const size_t chunk = std::min(dest.size() - bytes_read, kMaxTransferSize);
+    if (HAL_UART_Receive(&uart,
+                         reinterpret_cast<uint8_t*>(&dest[bytes_read]),
+                         static_cast<uint16_t>(chunk),
+                         HAL_MAX_DELAY) != HAL_OK) {
+      return StatusWithSize::ResourceExhausted(bytes_read);
+    }
+    bytes_read += chunk;
+  }
+  return StatusWithSize(bytes_read);
+}
+#endif  // PW_SYS_IO_STM32CUBE_RX_DMA_BUFFER_SIZE > 0
+
 Status WriteByte(std::byte b) {
   if (HAL_UART_Transmit(
           &uart, reinterpret_cast<uint8_t*>(&b), 1, HAL_MAX_DELAY) != HAL_OK) {
@@ -123,6 +256,24 @@ Status WriteByte(std::byte b) {
   return OkStatus();
 }
 
+StatusWithSize WriteBytes(ConstByteSpan src) {
+  size_t bytes_written = 0;
+  while (bytes_written < src.size()) {
+    const size_t chunk = std::min(src.size() - bytes_written, kMaxTransferSize);
+    // HAL_UART_Transmit takes a non-const pointer, but does not modify the
+    // data.
+    if (HAL_UART_Transmit(&uart,
+                          reinterpret_cast<uint8_t*>(
+                              const_cast<std::byte*>(&src[bytes_written])),
+                          static_cast<uint16_t>(chunk),
+                          HAL_MAX_DELAY) != HAL_OK) {
+      return StatusWithSize::ResourceExhausted(bytes_written);
+    }
+    bytes_written += chunk;
+  }
+  return StatusWithSize(bytes_written);
+}
+
 // Writes a string using pw::sys_io, and add newline characters at the end.
 StatusWithSize WriteLine(const std::string_view& s) {
   size_t chars_written = 0;
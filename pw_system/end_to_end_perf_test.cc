@@ -0,0 +1,434 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+#include "pw_assert/assert.h"
+#include "pw_blob_store/blob_store.h"
+#include "pw_bytes/span.h"
+#include "pw_hdlc/decoder.h"
+#include "pw_hdlc/default_addresses.h"
+#include "pw_hdlc/encoded_size.h"
+#include "pw_hdlc/encoder.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_log/proto/log.raw_rpc.pb.h"
+#include "pw_log/proto_utils.h"
+#include "pw_log_rpc/log_service.h"
+#include "pw_log_rpc/rpc_log_drain.h"
+#include "pw_log_rpc/rpc_log_drain_map.h"
+#include "pw_multisink/multisink.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_perf_test/state.h"
+#include "pw_rpc/benchmark.h"
+#include "pw_rpc/benchmark.pwpb.h"
+#include "pw_rpc/benchmark.raw_rpc.pb.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/client.h"
+#include "pw_rpc/server.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_sync/borrow.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_system/config.h"
+#include "pw_system/target_hooks.h"
+#include "pw_thread/detached_thread.h"
+#include "pw_thread/yield.h"
+#include "pw_transfer/blob_store_write_handler.h"
+#include "pw_transfer/client.h"
+#include "pw_transfer/transfer.h"
+#include "pw_transfer/transfer_thread.h"
+
+namespace pw::system {
+namespace {
+
+// Benchmark parameters.
+//
+// Each benchmark runs a device-side RPC server and a host-side RPC client in
+// the same process, connected by a loopback link that carries HDLC frames as a
+// UART or socket would. Each iteration moves one payload through the whole
+// pipeline, so the reported durations are end-to-end latencies, and the
+// throughput is the bytes per iteration divided by the mean duration.
+//
+// The buffers are sized from the pw_system configuration, so that the
+// benchmarks measure the pipelines as a pw_system device would run them.
+constexpr uint32_t kChannelId = 1;
+constexpr size_t kLinkBufferSize = 4096;
+constexpr size_t kMaxPayloadSize = 4096;
+
+constexpr size_t kMaxLogEntrySize = PW_SYSTEM_MAX_LOG_ENTRY_SIZE;
+constexpr size_t kLogBufferSize = PW_SYSTEM_LOG_BUFFER_SIZE;
+
+constexpr size_t kMaxTransferChunkSize = PW_SYSTEM_TRANSFER_CHUNK_SIZE_BYTES;
+constexpr size_t kMaxBytesToReceive = PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE;
+constexpr uint32_t kBlobResourceId = 1;
+constexpr size_t kFlashSectorSize = 1024;
+constexpr size_t kBlobSectors = kMaxPayloadSize / kFlashSectorSize;
+constexpr size_t kKvsSectors = 4;
+constexpr size_t kBlobWriteSize = 256;
+
+// The number of payloads each `TimedServerStream` RPC streams.
+constexpr uint32_t kMessagesPerStream = 8;
+
+/// Returns a payload with every byte value, including the HDLC flag and
+/// escape bytes, so that encoding it does the same escaping as real data.
+constexpr std::array<std::byte, kMaxPayloadSize> MakePayload() {
+  std::array<std::byte, kMaxPayloadSize> payload = {};
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<std::byte>(i * 7);
+  }
+  return payload;
+}
+
+constexpr std::array<std::byte, kMaxPayloadSize> kPayload = MakePayload();
+
+/// One direction of a loopback link. Packets sent through the `ChannelOutput`
+/// are HDLC-encoded into a buffer, as if written to a UART, and the frames are
+/// decoded and delivered to the receiving endpoint when the link is pumped.
+///
+/// Frames are queued rather than delivered from `Send()`, which runs with the
+/// RPC lock held and must not call into an RPC endpoint. The link keeps two
+/// buffers, so that packets can be sent into one while the frames in the other
+/// are delivered.
+class LoopbackLink : public rpc::ChannelOutput {
+ public:
+  explicit LoopbackLink(const char* name)
+      : rpc::ChannelOutput(name) {}
+
+  Status Send(ConstByteSpan packet) override {
+    std::lock_guard lock(mutex_);
+    ByteSpan buffer = span(buffers_[sending_]).subspan(size_);
+    Result<ConstByteSpan> frame =
+        hdlc::EncodeUIFrame(hdlc::kDefaultRpcAddress, packet, buffer);
+    if (!frame.ok()) {
+      return Status::ResourceExhausted();
+    }
+    size_ += frame->size();
+    peak_size_ = std::max(peak_size_, size_);
+    return OkStatus();
+  }
+
+  /// Delivers the queued frames to `endpoint`, which is an `rpc::Server` or an
+  /// `rpc::Client`. Returns the number of encoded bytes delivered.
+  template <typename Endpoint>
+  size_t Pump(Endpoint& endpoint) {
+    size_t delivering;
+    size_t size;
+    {
+      std::lock_guard lock(mutex_);
+      delivering = sending_;
+      size = size_;
+      sending_ ^= 1;
+      size_ = 0;
+    }
+    decoder_.Process(span(buffers_[delivering]).first(size),
+                     [&endpoint](const Result<hdlc::Frame>& frame) {
+                       if (frame.ok() &&
+                           frame->address() == hdlc::kDefaultRpcAddress) {
+                         endpoint.ProcessPacket(frame->data()).IgnoreError();
+                       }
+                     });
+    return size;
+  }
+
+  /// Returns the largest number of encoded bytes that were queued at once.
+  size_t peak_size() PW_LOCKS_EXCLUDED(mutex_) {
+    std::lock_guard lock(mutex_);
+    return peak_size_;
+  }
+
+  void ResetPeakSize() PW_LOCKS_EXCLUDED(mutex_) {
+    std::lock_guard lock(mutex_);
+    peak_size_ = 0;
+  }
+
+ private:
+  sync::Mutex mutex_;
+
+  // The buffer at `sending_` is guarded by `mutex_`. The other one is only
+  // used by the thread that pumps the link.
+  std::array<std::array<std::byte, kLinkBufferSize>, 2> buffers_;
+  size_t sending_ PW_GUARDED_BY(mutex_) = 0;
+  size_t size_ PW_GUARDED_BY(mutex_) = 0;
+  size_t peak_size_ PW_GUARDED_BY(mutex_) = 0;
+  hdlc::DecoderBuffer<hdlc::Decoder::RequiredBufferSizeForFrameSize(
+      hdlc::MaxEncodedFrameSize(rpc::cfg::kEncodingBufferSizeBytes))>
+      decoder_;
+};
+
+/// The device and host sides of every pipeline: an RPC server with the
+/// benchmark, log, and transfer services, and an RPC client, connected by a
+/// loopback link.
+class Pipelines {
+ public:
+  Pipelines()
+      : to_server_("to server"),
+        to_client_("to client"),
+        server_channels_{rpc::Channel::Create<kChannelId>(&to_client_)},
+        client_channels_{rpc::Channel::Create<kChannelId>(&to_server_)},
+        server_(server_channels_),
+        client_(client_channels_),
+        multisink_(multisink_buffer_),
+        drains_{log_rpc::RpcLogDrain(
+            kChannelId,
+            drain_buffer_,
+            drain_mutex_,
+            log_rpc::RpcLogDrain::LogDrainErrorHandling::kIgnoreWriterErrors)},
+        drain_map_(drains_),
+        log_service_(drain_map_),
+        kvs_(&kvs_partition_, kvs_format_),
+        blob_(
+            "benchmark",
+            blob_partition_,
+            &blob_checksum_,
+            sync::Borrowable<kvs::KeyValueStore>(kvs_, kvs_mutex_),
+            kBlobWriteSize),
+        blob_writer_(blob_),
+        blob_handler_(kBlobResourceId, blob_writer_),
+        transfer_thread_(transfer_chunk_buffer_, transfer_encode_buffer_),
+        transfer_service_(transfer_thread_, kMaxBytesToReceive),
+        transfer_client_(client_, kChannelId, transfer_thread_) {
+    PW_ASSERT(kvs_.Init().ok());
+    PW_ASSERT(blob_.Init().ok());
+    multisink_.AttachDrain(drains_[0]);
+
+    server_.RegisterService(benchmark_service_);
+    server_.RegisterService(log_service_);
+    server_.RegisterService(transfer_service_);
+
+    // Handlers may only be registered once the transfer thread is running.
+    thread::DetachedThread(TransferThreadOptions(), transfer_thread_);
+    transfer_service_.RegisterHandler(blob_handler_);
+  }
+
+  rpc::Client& client() { return client_; }
+  multisink::MultiSink& multisink() { return multisink_; }
+  log_rpc::RpcLogDrain& drain() { return drains_[0]; }
+  transfer::Client& transfer_client() { return transfer_client_; }
+
+  /// Delivers frames in both directions until the link is idle.
+  void Pump() {
+    while (to_server_.Pump(server_) + to_client_.Pump(client_) != 0) {
+    }
+  }
+
+  /// Returns the largest number of encoded bytes queued on the link at once,
+  /// in either direction, since the last call to `ResetPeakLinkBytes()`.
+  size_t peak_link_bytes() {
+    return std::max(to_server_.peak_size(), to_client_.peak_size());
+  }
+
+  void ResetPeakLinkBytes() {
+    to_server_.ResetPeakSize();
+    to_client_.ResetPeakSize();
+  }
+
+ private:
+  LoopbackLink to_server_;
+  LoopbackLink to_client_;
+  std::array<rpc::Channel, 1> server_channels_;
+  std::array<rpc::Channel, 1> client_channels_;
+  rpc::Server server_;
+  rpc::Client client_;
+
+  // RPC benchmark pipeline.
+  rpc::BenchmarkService benchmark_service_;
+
+  // Log pipeline.
+  std::array<std::byte, kLogBufferSize> multisink_buffer_;
+  multisink::MultiSink multisink_;
+  std::array<std::byte, kMaxLogEntrySize> drain_buffer_;
+  sync::Mutex drain_mutex_;
+  std::array<log_rpc::RpcLogDrain, 1> drains_;
+  log_rpc::RpcLogDrainMap drain_map_;
+  log_rpc::LogService log_service_;
+
+  // Transfer pipeline, which writes into a blob store that keeps its metadata
+  // in a key-value store.
+  kvs::FakeFlashMemoryBuffer<kFlashSectorSize, kKvsSectors> kvs_flash_;
+  kvs::FlashPartition kvs_partition_{&kvs_flash_};
+  kvs::ChecksumCrc16 kvs_checksum_;
+  const kvs::EntryFormat kvs_format_{.magic = 0x5e2c6ba5,
+                                     .checksum = &kvs_checksum_};
+  kvs::KeyValueStoreBuffer<8, kKvsSectors> kvs_;
+  sync::VirtualMutex kvs_mutex_;
+
+  kvs::FakeFlashMemoryBuffer<kFlashSectorSize, kBlobSectors> blob_flash_;
+  kvs::FlashPartition blob_partition_{&blob_flash_};
+  kvs::ChecksumCrc16 blob_checksum_;
+  blob_store::BlobStoreBuffer<kBlobWriteSize> blob_;
+  blob_store::BlobStore::BlobWriterWithBuffer<0> blob_writer_;
+  transfer::BlobStoreWriteHandler blob_handler_;
+
+  std::array<std::byte, kMaxTransferChunkSize> transfer_chunk_buffer_;
+  std::array<std::byte, rpc::cfg::kEncodingBufferSizeBytes>
+      transfer_encode_buffer_;
+  transfer::Thread<1, 1> transfer_thread_;
+  transfer::TransferService transfer_service_;
+  transfer::Client transfer_client_;
+};
+
+/// Returns the pipelines, which are set up the first time they are used and
+/// shared by every benchmark, since the transfer thread never exits.
+Pipelines& GetPipelines() {
+  static Pipelines pipelines;
+  return pipelines;
+}
+
+/// Sends a payload to the benchmark service, which echoes it back.
+void UnaryEchoPerfTest(perf_test::State& state, size_t payload_size) {
+  PW_ASSERT(payload_size <= rpc::MaxSafePayloadSize());
+  Pipelines& pipelines = GetPipelines();
+  rpc::pw_rpc::raw::Benchmark::Client benchmark(pipelines.client(), kChannelId);
+  ConstByteSpan payload = span(kPayload).first(payload_size);
+
+  // The payload crosses the link in both directions.
+  pipelines.ResetPeakLinkBytes();
+  state.SetBytesPerIteration(payload_size * 2);
+  while (state.KeepRunning()) {
+    size_t received = 0;
+    rpc::RawUnaryReceiver call = benchmark.UnaryEcho(
+        payload,
+        [&received](ConstByteSpan response, Status) {
+          received = response.size();
+        });
+    pipelines.Pump();
+    PW_ASSERT(received == payload_size);
+  }
+  state.SetMetric("link_peak_bytes", pipelines.peak_link_bytes());
+}
+
+/// Asks the benchmark service to stream payloads of the given size.
+void ServerStreamPerfTest(perf_test::State& state, uint32_t payload_size) {
+  PW_ASSERT(payload_size <= rpc::BenchmarkService::kMaxTimedPayloadSizeBytes);
+  Pipelines& pipelines = GetPipelines();
+  rpc::pw_rpc::raw::Benchmark::Client benchmark(pipelines.client(), kChannelId);
+
+  std::array<std::byte, 16> request_buffer;
+  rpc::pwpb::PayloadRequest::MemoryEncoder encoder(request_buffer);
+  encoder.WritePayloadSize(payload_size).IgnoreError();
+  encoder.WriteCount(kMessagesPerStream).IgnoreError();
+  PW_ASSERT(encoder.status().ok());
+  ConstByteSpan request = encoder;
+
+  pipelines.ResetPeakLinkBytes();
+  state.SetBytesPerIteration(uint64_t{payload_size} * kMessagesPerStream);
+  while (state.KeepRunning()) {
+    uint32_t received = 0;
+    bool completed = false;
+    rpc::RawClientReader call = benchmark.TimedServerStream(
+        request,
+        [&received](ConstByteSpan) { ++received; },
+        [&completed](Status) { completed = true; });
+    pipelines.Pump();
+    PW_ASSERT(completed);
+    PW_ASSERT(received == kMessagesPerStream);
+  }
+  state.SetMetric("link_peak_bytes", pipelines.peak_link_bytes());
+}
+
+/// Logs a message, which the RPC log drain reads from the multisink and
+/// streams to the client.
+void LogPerfTest(perf_test::State& state, size_t message_size) {
+  static constexpr std::string_view kMessage =
+      "The quick brown fox jumps over the lazy dog. "
+      "The quick brown fox jumps over the lazy dog.";
+  PW_ASSERT(message_size <= kMessage.size());
+  Pipelines& pipelines = GetPipelines();
+  log::pw_rpc::raw::Logs::Client logs(pipelines.client(), kChannelId);
+
+  size_t received = 0;
+  rpc::RawClientReader call = logs.Listen(
+      {}, [&received](ConstByteSpan entries) { received += entries.size(); });
+  pipelines.Pump();
+
+  static std::array<std::byte, kMaxLogEntrySize> entry_buffer;
+  static std::array<std::byte, rpc::MaxSafePayloadSize()> packing_buffer;
+  std::string_view message = kMessage.substr(0, message_size);
+  pipelines.ResetPeakLinkBytes();
+  state.SetBytesPerIteration(message_size);
+  while (state.KeepRunning()) {
+    Result<ConstByteSpan> entry = log::EncodeLog(/*level=*/2,
+                                                 /*flags=*/0,
+                                                 "BENCH",
+                                                 "main",
+                                                 "end_to_end_perf_test.cc",
+                                                 __LINE__,
+                                                 /*ticks_since_epoch=*/0,
+                                                 message,
+                                                 entry_buffer);
+    PW_ASSERT(entry.ok());
+    pipelines.multisink().HandleEntry(*entry);
+    received = 0;
+    pipelines.drain().Flush(packing_buffer).IgnoreError();
+    pipelines.Pump();
+    PW_ASSERT(received != 0);
+  }
+  state.SetMetric("link_peak_bytes", pipelines.peak_link_bytes());
+
+  // Close the drain's stream, so that the next case can open it again.
+  call.Cancel().IgnoreError();
+  pipelines.Pump();
+}
+
+/// Writes a resource with pw_transfer into a blob store.
+void TransferWritePerfTest(perf_test::State& state, size_t size) {
+  PW_ASSERT(size <= kMaxPayloadSize);
+  Pipelines& pipelines = GetPipelines();
+
+  pipelines.ResetPeakLinkBytes();
+  state.SetBytesPerIteration(size);
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(ConstByteSpan(kPayload).first(size));
+    // Set by the transfer thread once the transfer completes.
+    struct {
+      Status status;
+      std::atomic<bool> done = false;
+    } result;
+    PW_ASSERT(pipelines.transfer_client()
+                  .Write(kBlobResourceId,
+                         reader,
+                         [&result](Status status) {
+                           result.status = status;
+                           result.done = true;
+                         })
+                  .ok());
+    while (!result.done) {
+      pipelines.Pump();
+      this_thread::yield();
+    }
+    PW_ASSERT(result.status.ok());
+  }
+  state.SetMetric("link_peak_bytes", pipelines.peak_link_bytes());
+}
+
+PW_PERF_TEST(UnaryEcho32, UnaryEchoPerfTest, 32);
+PW_PERF_TEST(UnaryEcho256, UnaryEchoPerfTest, 256);
+PW_PERF_TEST(ServerStream32, ServerStreamPerfTest, 32);
+PW_PERF_TEST(ServerStream256, ServerStreamPerfTest, 256);
+PW_PERF_TEST(Log16, LogPerfTest, 16);
+PW_PERF_TEST(Log64, LogPerfTest, 64);
+PW_PERF_TEST(TransferWrite1K, TransferWritePerfTest, 1024);
+PW_PERF_TEST(TransferWrite4K, TransferWritePerfTest, 4096);
+
+}  // namespace
+}  // namespace pw::system
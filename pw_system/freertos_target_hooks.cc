@@ -21,21 +21,32 @@
 
 namespace pw::system {
 
-// Low to high priorities.
+// Thread priorities, as levels above the lowest pw_system priority. See the
+// PW_SYSTEM_*_THREAD_PRIORITY options.
+//
+// TODO(amontanez): These should ideally be at different priority levels by
+// default, but there's synchronization issues when they are.
+static constexpr UBaseType_t kLowestPriority = tskIDLE_PRIORITY + 1;
+
 enum class ThreadPriority : UBaseType_t {
-  kWorkQueue = tskIDLE_PRIORITY + 1,
-  // TODO(amontanez): These should ideally be at different priority levels, but
-  // there's synchronization issues when they are.
-  kLog = kWorkQueue,
-  kRpc = kWorkQueue,
+  kWorkQueue = kLowestPriority + PW_SYSTEM_WORK_QUEUE_THREAD_PRIORITY,
+  kLog = kLowestPriority + PW_SYSTEM_LOG_THREAD_PRIORITY,
+  kRpc = kLowestPriority + PW_SYSTEM_RPC_THREAD_PRIORITY,
 #if PW_SYSTEM_ENABLE_TRANSFER_SERVICE
-  kTransfer = kWorkQueue,
+  kTransfer = kLowestPriority + PW_SYSTEM_TRANSFER_THREAD_PRIORITY,
 #endif  // PW_SYSTEM_ENABLE_TRANSFER_SERVICE
-  kNumPriorities,
 };
 
-static_assert(static_cast<UBaseType_t>(ThreadPriority::kNumPriorities) <=
+static_assert(static_cast<UBaseType_t>(ThreadPriority::kWorkQueue) <
+              configMAX_PRIORITIES);
+static_assert(static_cast<UBaseType_t>(ThreadPriority::kLog) <
+              configMAX_PRIORITIES);
+static_assert(static_cast<UBaseType_t>(ThreadPriority::kRpc) <
               configMAX_PRIORITIES);
+#if PW_SYSTEM_ENABLE_TRANSFER_SERVICE
+static_assert(static_cast<UBaseType_t>(ThreadPriority::kTransfer) <
+              configMAX_PRIORITIES);
+#endif  // PW_SYSTEM_ENABLE_TRANSFER_SERVICE
 
 static constexpr size_t kLogThreadStackWords = 1024;
 static thread::freertos::StaticContextWithStack<kLogThreadStackWords>
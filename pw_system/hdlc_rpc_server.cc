@@ -12,6 +12,9 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include "pw_system/hdlc_rpc_server.h"
+
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -24,6 +27,7 @@
 #include "pw_hdlc/encoded_size.h"
 #include "pw_hdlc/rpc_channel.h"
 #include "pw_log/log.h"
+#include "pw_metric/global.h"
 #include "pw_rpc/channel.h"
 #include "pw_sync/mutex.h"
 #include "pw_system/config.h"
@@ -48,7 +52,7 @@ static_assert(kMaxTransmissionUnit ==
 #if PW_SYSTEM_DEFAULT_CHANNEL_ID == PW_SYSTEM_LOGGING_CHANNEL_ID
 hdlc::FixedMtuChannelOutput<kMaxTransmissionUnit> hdlc_channel_output(
     GetWriter(), PW_SYSTEM_DEFAULT_RPC_HDLC_ADDRESS, "HDLC channel");
-rpc::Channel channels[] = {
+rpc::Channel channels[1 + PW_SYSTEM_EXTRA_RPC_CHANNELS] = {
     rpc::Channel::Create<kDefaultRpcChannelId>(&hdlc_channel_output)};
 #else
 class SynchronizedChannelOutput : public rpc::ChannelOutput {
@@ -84,55 +88,63 @@ SynchronizedChannelOutput hdlc_channel_output[] = {
                               PW_SYSTEM_LOGGING_RPC_HDLC_ADDRESS,
                               "HDLC logging channel"),
 };
-rpc::Channel channels[] = {
+rpc::Channel channels[2 + PW_SYSTEM_EXTRA_RPC_CHANNELS] = {
     rpc::Channel::Create<kDefaultRpcChannelId>(&hdlc_channel_output[0]),
     rpc::Channel::Create<kLoggingRpcChannelId>(&hdlc_channel_output[1]),
 };
 #endif
 rpc::Server server(channels);
 
-constexpr size_t kDecoderBufferSize =
-    hdlc::Decoder::RequiredBufferSizeForFrameSize(kMaxTransmissionUnit);
-// Declare a buffer for decoding incoming HDLC frames.
-std::array<std::byte, kDecoderBufferSize> input_buffer;
-hdlc::Decoder decoder(input_buffer);
-
-std::array<std::byte, 1> data;
+constexpr uint64_t kRpcAddresses[] = {PW_SYSTEM_DEFAULT_RPC_HDLC_ADDRESS,
+                                      PW_SYSTEM_LOGGING_RPC_HDLC_ADDRESS};
 
 }  // namespace
 
 rpc::Server& GetRpcServer() { return server; }
 
-class RpcDispatchThread final : public thread::ThreadCore {
- public:
-  RpcDispatchThread() = default;
-  RpcDispatchThread(const RpcDispatchThread&) = delete;
-  RpcDispatchThread(RpcDispatchThread&&) = delete;
-  RpcDispatchThread& operator=(const RpcDispatchThread&) = delete;
-  RpcDispatchThread& operator=(RpcDispatchThread&&) = delete;
-
-  void Run() override {
-    PW_LOG_INFO("Running RPC server");
-    while (true) {
-      auto ret_val = GetReader().Read(data);
-      if (ret_val.ok()) {
-        for (std::byte byte : ret_val.value()) {
-          if (auto result = decoder.Process(byte); result.ok()) {
-            hdlc::Frame& frame = result.value();
-            PW_TRACE_SCOPE("RPC process frame");
-            if (frame.address() == PW_SYSTEM_DEFAULT_RPC_HDLC_ADDRESS ||
-                frame.address() == PW_SYSTEM_LOGGING_RPC_HDLC_ADDRESS) {
-              server.ProcessPacket(frame.data());
-            }
-          }
-        }
-      }
+void HdlcRpcDispatcher::Run() {
+  PW_LOG_INFO("Running RPC server");
+  while (true) {
+    Result<ByteSpan> read = reader_.Read(read_buffer_);
+    if (!read.ok()) {
+      continue;
+    }
+    const uint32_t read_size = static_cast<uint32_t>(read->size());
+    bytes_received_.Increment(read_size);
+    if (read_size > max_read_size_.value()) {
+      max_read_size_.Set(read_size);
     }
+    decoder_.Process(*read, [this](const Result<hdlc::Frame>& result) {
+      if (result.ok()) {
+        ProcessFrame(*result);
+      } else {
+        decode_errors_.Increment();
+      }
+    });
   }
-};
+}
+
+void HdlcRpcDispatcher::ProcessFrame(const hdlc::Frame& frame) {
+  PW_TRACE_SCOPE("RPC process frame");
+  frames_received_.Increment();
+  if (std::find(addresses_.begin(), addresses_.end(), frame.address()) ==
+      addresses_.end()) {
+    frames_dropped_.Increment();
+    return;
+  }
+  if (!server_.ProcessPacket(frame.data()).ok()) {
+    packet_errors_.Increment();
+  }
+}
 
 thread::ThreadCore& GetRpcDispatchThread() {
-  static RpcDispatchThread rpc_dispatch_thread;
+  static HdlcRpcDispatcherWithBuffer<kMaxTransmissionUnit> rpc_dispatch_thread(
+      GetReader(), kRpcAddresses, server);
+  static const bool metrics_registered = [] {
+    metric::global_groups.push_front(rpc_dispatch_thread.metrics());
+    return true;
+  }();
+  static_cast<void>(metrics_registered);
   return rpc_dispatch_thread;
 }
 
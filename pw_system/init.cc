@@ -44,6 +44,11 @@
 
 namespace pw::system {
 namespace {
+// Reports the configuration profile, to identify it when comparing metrics
+// from devices.
+PW_METRIC_GROUP_GLOBAL(system_metrics, "pw_system");
+PW_METRIC(system_metrics, profile_metric, "profile", PW_SYSTEM_PROFILE);
+
 metric::MetricService metric_service(metric::global_metrics,
                                      metric::global_groups);
 
@@ -15,8 +15,11 @@
 #include "pw_system_private/log.h"
 
 #include <array>
+#include <chrono>
 #include <cstddef>
+#include <limits>
 
+#include "pw_chrono/system_clock.h"
 #include "pw_log_rpc/rpc_log_drain.h"
 #include "pw_log_rpc/rpc_log_drain_map.h"
 #include "pw_multisink/multisink.h"
@@ -49,6 +52,16 @@ std::array<std::byte, PW_SYSTEM_MAX_LOG_ENTRY_SIZE> log_decode_buffer_extra
     PW_GUARDED_BY(drains_mutex);
 #endif
 
+// Pacing of the drains, so that a burst of logs does not occupy the transport
+// to the detriment of other RPCs.
+constexpr size_t kMaxBundlesPerTrickle =
+    PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE == 0
+        ? std::numeric_limits<size_t>::max()
+        : PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE;
+constexpr chrono::SystemClock::duration kTrickleDelay =
+    chrono::SystemClock::for_at_least(
+        std::chrono::milliseconds(PW_SYSTEM_LOG_TRICKLE_DELAY_MS));
+
 #if PW_SYSTEM_EXTRA_LOGGING_CHANNEL_ID != PW_SYSTEM_LOGGING_CHANNEL_ID
 constexpr size_t drain_count = 2;
 #else
@@ -58,12 +71,18 @@ std::array<RpcLogDrain, drain_count> drains{{
     RpcLogDrain(kLoggingRpcChannelId,
                 log_decode_buffer,
                 drains_mutex,
-                RpcLogDrain::LogDrainErrorHandling::kIgnoreWriterErrors),
+                RpcLogDrain::LogDrainErrorHandling::kIgnoreWriterErrors,
+                /*filter=*/nullptr,
+                kMaxBundlesPerTrickle,
+                kTrickleDelay),
 #if PW_SYSTEM_EXTRA_LOGGING_CHANNEL_ID != PW_SYSTEM_LOGGING_CHANNEL_ID
     RpcLogDrain(kExtraLoggingRpcChannelId,
                 log_decode_buffer_extra,
                 drains_mutex,
-                RpcLogDrain::LogDrainErrorHandling::kIgnoreWriterErrors),
+                RpcLogDrain::LogDrainErrorHandling::kIgnoreWriterErrors,
+                /*filter=*/nullptr,
+                kMaxBundlesPerTrickle,
+                kTrickleDelay),
 #endif
 }};
 
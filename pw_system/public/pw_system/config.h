@@ -13,22 +13,83 @@
 // the License.
 #pragma once
 
+// Named configuration profiles, which set the defaults of the thread priority,
+// buffer size, log pacing, and transfer options below to suit a goal. Options
+// that are explicitly set override the profile's default.
+//
+// PW_SYSTEM_PROFILE_DEFAULT: A balance of RAM use and performance.
+// PW_SYSTEM_PROFILE_THROUGHPUT: Larger log and transfer buffers and windows,
+//   for moving bulk data, such as logs and files, as fast as possible.
+// PW_SYSTEM_PROFILE_LATENCY: Prioritizes the RPC thread, followed by the
+//   transfer thread, and paces log output so that it does not delay RPC
+//   responses.
+// PW_SYSTEM_PROFILE_LOW_MEMORY: Smaller buffers and fewer concurrent
+//   transfers.
+#define PW_SYSTEM_PROFILE_DEFAULT 0
+#define PW_SYSTEM_PROFILE_THROUGHPUT 1
+#define PW_SYSTEM_PROFILE_LATENCY 2
+#define PW_SYSTEM_PROFILE_LOW_MEMORY 3
+
+// PW_SYSTEM_PROFILE selects the configuration profile. It is reported as the
+// "profile" metric in the "pw_system" metric group.
+//
+// Defaults to PW_SYSTEM_PROFILE_DEFAULT.
+#ifndef PW_SYSTEM_PROFILE
+#define PW_SYSTEM_PROFILE PW_SYSTEM_PROFILE_DEFAULT
+#endif  // PW_SYSTEM_PROFILE
+
 // PW_SYSTEM_LOG_BUFFER_SIZE is the log buffer size which determines how many
 // log entries can be buffered prior to streaming them.
 //
-// Defaults to 4KiB.
+// Defaults to 4KiB, 8KiB for PW_SYSTEM_PROFILE_THROUGHPUT, or 1KiB for
+// PW_SYSTEM_PROFILE_LOW_MEMORY.
 #ifndef PW_SYSTEM_LOG_BUFFER_SIZE
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_THROUGHPUT
+#define PW_SYSTEM_LOG_BUFFER_SIZE 8192
+#elif PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_LOG_BUFFER_SIZE 1024
+#else
 #define PW_SYSTEM_LOG_BUFFER_SIZE 4096
+#endif  // PW_SYSTEM_PROFILE
 #endif  // PW_SYSTEM_LOG_BUFFER_SIZE
 
 // PW_SYSTEM_MAX_LOG_ENTRY_SIZE limits the proto-encoded log entry size. This
 // value might depend on a target interface's MTU.
 //
-// Defaults to 256B.
+// Defaults to 256B, or 128B for PW_SYSTEM_PROFILE_LOW_MEMORY.
 #ifndef PW_SYSTEM_MAX_LOG_ENTRY_SIZE
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_MAX_LOG_ENTRY_SIZE 128
+#else
 #define PW_SYSTEM_MAX_LOG_ENTRY_SIZE 256
+#endif  // PW_SYSTEM_PROFILE
 #endif  // PW_SYSTEM_MAX_LOG_ENTRY_SIZE
 
+// PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE limits how many bundles of log entries
+// the log thread sends at once before yielding the output for
+// PW_SYSTEM_LOG_TRICKLE_DELAY_MS. 0 means no limit.
+//
+// Defaults to 0, or 1 for PW_SYSTEM_PROFILE_LATENCY.
+#ifndef PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LATENCY
+#define PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE 1
+#else
+#define PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE 0
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE
+
+// PW_SYSTEM_LOG_TRICKLE_DELAY_MS is the minimum time, in milliseconds, between
+// the log thread's sends once PW_SYSTEM_LOG_MAX_BUNDLES_PER_TRICKLE is reached.
+//
+// Defaults to 0, or 10 for PW_SYSTEM_PROFILE_LATENCY.
+#ifndef PW_SYSTEM_LOG_TRICKLE_DELAY_MS
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LATENCY
+#define PW_SYSTEM_LOG_TRICKLE_DELAY_MS 10
+#else
+#define PW_SYSTEM_LOG_TRICKLE_DELAY_MS 0
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_LOG_TRICKLE_DELAY_MS
+
 // PW_SYSTEM_MAX_TRANSMISSION_UNIT target's MTU.
 //
 // Defaults to 1055 bytes, which is enough to fit 512-byte payloads when using
@@ -78,6 +139,33 @@
 #define PW_SYSTEM_EXTRA_LOGGING_CHANNEL_ID PW_SYSTEM_LOGGING_CHANNEL_ID
 #endif  // PW_SYSTEM_EXTRA_LOGGING_CHANNEL_ID
 
+// PW_SYSTEM_EXTRA_RPC_CHANNELS is the number of unassigned RPC channels to
+// reserve in the RPC server, which may be opened with
+// pw::system::GetRpcServer().OpenChannel(). This allows serving RPCs over
+// additional transports, each with its own channel output.
+//
+// Defaults to 0.
+#ifndef PW_SYSTEM_EXTRA_RPC_CHANNELS
+#define PW_SYSTEM_EXTRA_RPC_CHANNELS 0
+#endif  // PW_SYSTEM_EXTRA_RPC_CHANNELS
+
+// PW_SYSTEM_RPC_READ_BUFFER_SIZE is the number of bytes that the RPC thread
+// requests from the transport at once. The received bytes are HDLC-decoded in
+// bulk. The transport's reader should return the bytes that are available
+// rather than waiting for the buffer to fill.
+//
+// Defaults to 64B, 256B for PW_SYSTEM_PROFILE_THROUGHPUT, or 16B for
+// PW_SYSTEM_PROFILE_LOW_MEMORY.
+#ifndef PW_SYSTEM_RPC_READ_BUFFER_SIZE
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_THROUGHPUT
+#define PW_SYSTEM_RPC_READ_BUFFER_SIZE 256
+#elif PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_RPC_READ_BUFFER_SIZE 16
+#else
+#define PW_SYSTEM_RPC_READ_BUFFER_SIZE 64
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_RPC_READ_BUFFER_SIZE
+
 // PW_SYSTEM_ENABLE_TRACE_SERVICE specifies if the trace RPC service is enabled.
 //
 // Defaults to 1.
@@ -104,11 +192,96 @@
 // PW_SYSTEM_WORK_QUEUE_MAX_ENTRIES specifies the maximum number of work queue
 // entries that may be staged at once.
 //
-// Defaults to 32.
+// Defaults to 32, or 8 for PW_SYSTEM_PROFILE_LOW_MEMORY.
 #ifndef PW_SYSTEM_WORK_QUEUE_MAX_ENTRIES
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_WORK_QUEUE_MAX_ENTRIES 8
+#else
 #define PW_SYSTEM_WORK_QUEUE_MAX_ENTRIES 32
+#endif  // PW_SYSTEM_PROFILE
 #endif  // PW_SYSTEM_WORK_QUEUE_MAX_ENTRIES
 
+// PW_SYSTEM_TRANSFER_MAX_CLIENT_TRANSFERS and
+// PW_SYSTEM_TRANSFER_MAX_SERVER_TRANSFERS are the maximum numbers of concurrent
+// transfers that the transfer thread supports as a client and as a server.
+//
+// Default to 5 and 3, or 1 and 1 for PW_SYSTEM_PROFILE_LOW_MEMORY.
+#ifndef PW_SYSTEM_TRANSFER_MAX_CLIENT_TRANSFERS
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_TRANSFER_MAX_CLIENT_TRANSFERS 1
+#else
+#define PW_SYSTEM_TRANSFER_MAX_CLIENT_TRANSFERS 5
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_TRANSFER_MAX_CLIENT_TRANSFERS
+
+#ifndef PW_SYSTEM_TRANSFER_MAX_SERVER_TRANSFERS
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_TRANSFER_MAX_SERVER_TRANSFERS 1
+#else
+#define PW_SYSTEM_TRANSFER_MAX_SERVER_TRANSFERS 3
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_TRANSFER_MAX_SERVER_TRANSFERS
+
+// PW_SYSTEM_TRANSFER_CHUNK_SIZE_BYTES is the maximum amount of data to send in
+// a single transfer chunk. Must be less than 512, the size of the transfer
+// thread's encode buffer.
+//
+// Defaults to 480B, or 224B for PW_SYSTEM_PROFILE_LOW_MEMORY.
+#ifndef PW_SYSTEM_TRANSFER_CHUNK_SIZE_BYTES
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_TRANSFER_CHUNK_SIZE_BYTES 224
+#else
+#define PW_SYSTEM_TRANSFER_CHUNK_SIZE_BYTES 480
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_TRANSFER_CHUNK_SIZE_BYTES
+
+// PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE is the transfer window: in a write
+// transfer, the maximum number of bytes to receive at one time (potentially
+// across multiple chunks), unless the handler's writer specifies otherwise.
+//
+// Defaults to 1KiB, 4KiB for PW_SYSTEM_PROFILE_THROUGHPUT, or 512B for
+// PW_SYSTEM_PROFILE_LOW_MEMORY.
+#ifndef PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_THROUGHPUT
+#define PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE 4096
+#elif PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LOW_MEMORY
+#define PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE 512
+#else
+#define PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE 1024
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE
+
+// PW_SYSTEM_WORK_QUEUE_THREAD_PRIORITY, PW_SYSTEM_LOG_THREAD_PRIORITY,
+// PW_SYSTEM_RPC_THREAD_PRIORITY, and PW_SYSTEM_TRANSFER_THREAD_PRIORITY are the
+// priorities of pw_system's threads, as a number of levels above the lowest of
+// them. The target hooks map these onto the RTOS's priorities.
+//
+// All default to 0, except for PW_SYSTEM_PROFILE_LATENCY, where the RPC thread
+// defaults to 2 and the transfer thread to 1.
+#ifndef PW_SYSTEM_WORK_QUEUE_THREAD_PRIORITY
+#define PW_SYSTEM_WORK_QUEUE_THREAD_PRIORITY 0
+#endif  // PW_SYSTEM_WORK_QUEUE_THREAD_PRIORITY
+
+#ifndef PW_SYSTEM_LOG_THREAD_PRIORITY
+#define PW_SYSTEM_LOG_THREAD_PRIORITY 0
+#endif  // PW_SYSTEM_LOG_THREAD_PRIORITY
+
+#ifndef PW_SYSTEM_RPC_THREAD_PRIORITY
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LATENCY
+#define PW_SYSTEM_RPC_THREAD_PRIORITY 2
+#else
+#define PW_SYSTEM_RPC_THREAD_PRIORITY 0
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_RPC_THREAD_PRIORITY
+
+#ifndef PW_SYSTEM_TRANSFER_THREAD_PRIORITY
+#if PW_SYSTEM_PROFILE == PW_SYSTEM_PROFILE_LATENCY
+#define PW_SYSTEM_TRANSFER_THREAD_PRIORITY 1
+#else
+#define PW_SYSTEM_TRANSFER_THREAD_PRIORITY 0
+#endif  // PW_SYSTEM_PROFILE
+#endif  // PW_SYSTEM_TRANSFER_THREAD_PRIORITY
+
 // PW_SYSTEM_SOCKET_IO_PORT specifies the port number to use for the socket
 // stream implementation of pw_system's I/O interface.
 //
@@ -0,0 +1,125 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_hdlc/decoder.h"
+#include "pw_metric/metric.h"
+#include "pw_rpc/server.h"
+#include "pw_span/span.h"
+#include "pw_stream/stream.h"
+#include "pw_system/config.h"
+#include "pw_system/rpc_server.h"
+#include "pw_thread/thread_core.h"
+
+namespace pw::system {
+
+/// Reads HDLC frames from a transport and passes the RPC packets in them to
+/// an RPC server.
+///
+/// `pw_system` runs one of these on the RPC thread to serve `GetReader()`.
+/// Targets with more transports, such as a USB endpoint in addition to a UART,
+/// can serve each one concurrently by running another `HdlcRpcDispatcher` on
+/// its own thread. Responses go out through the channel that a packet was
+/// sent on, so open a channel on the transport's writer with
+/// `GetRpcServer().OpenChannel()`; `PW_SYSTEM_EXTRA_RPC_CHANNELS` reserves
+/// room for these channels.
+///
+/// Data is read up to `PW_SYSTEM_RPC_READ_BUFFER_SIZE` bytes at a time and
+/// decoded in bulk, so the reader should return the bytes that are available
+/// rather than waiting to fill the whole buffer.
+///
+/// RPC handlers run on the dispatcher's thread, and no more data is read from
+/// the transport until they return. Long-running handlers should defer their
+/// work, e.g. to `GetWorkQueue()`, and respond asynchronously.
+///
+/// The dispatcher counts the data it reads and the frames it decodes in its
+/// `metrics()`, which help to check that the read buffer size and MTU suit the
+/// traffic on the transport.
+class HdlcRpcDispatcher : public thread::ThreadCore {
+ public:
+  /// @param[in] reader The transport to read HDLC frames from.
+  ///
+  /// @param[in] decode_buffer Buffer for decoding frames. Must be large enough
+  /// for the largest frame.
+  ///
+  /// @param[in] addresses The HDLC addresses to accept RPC packets on. Frames
+  /// for other addresses are dropped. Must outlive the dispatcher.
+  ///
+  /// @param[in] server The RPC server to pass packets to.
+  HdlcRpcDispatcher(stream::Reader& reader,
+                    ByteSpan decode_buffer,
+                    span<const uint64_t> addresses,
+                    rpc::Server& server = GetRpcServer())
+      : reader_(reader),
+        decoder_(decode_buffer),
+        addresses_(addresses),
+        server_(server) {}
+
+  HdlcRpcDispatcher(const HdlcRpcDispatcher&) = delete;
+  HdlcRpcDispatcher& operator=(const HdlcRpcDispatcher&) = delete;
+
+  /// Reads and dispatches packets forever.
+  void Run() override;
+
+  /// The dispatcher's metrics. `pw_system` registers the metrics of the RPC
+  /// thread's dispatcher as a global group, so that they are available through
+  /// the metric service.
+  metric::Group& metrics() { return metrics_; }
+
+ private:
+  void ProcessFrame(const hdlc::Frame& frame);
+
+  stream::Reader& reader_;
+  hdlc::Decoder decoder_;
+  const span<const uint64_t> addresses_;
+  rpc::Server& server_;
+  std::array<std::byte, PW_SYSTEM_RPC_READ_BUFFER_SIZE> read_buffer_;
+
+  PW_METRIC_GROUP(metrics_, "pw::system::HdlcRpcDispatcher");
+  PW_METRIC(metrics_, bytes_received_, "bytes_received", 0u);
+  // The most data returned by one read. If this is the read buffer size, data
+  // may be arriving faster than it is read.
+  PW_METRIC(metrics_, max_read_size_, "max_read_size", 0u);
+  PW_METRIC(metrics_, frames_received_, "frames_received", 0u);
+  // Frames that failed to decode, e.g. due to corruption or because they are
+  // larger than the decode buffer.
+  PW_METRIC(metrics_, decode_errors_, "decode_errors", 0u);
+  // Frames for addresses that the dispatcher does not accept.
+  PW_METRIC(metrics_, frames_dropped_, "frames_dropped", 0u);
+  // Packets that the RPC server failed to process.
+  PW_METRIC(metrics_, packet_errors_, "packet_errors", 0u);
+};
+
+/// An `HdlcRpcDispatcher` with a decode buffer for frames of up to
+/// `kMaxFrameSize` bytes.
+template <size_t kMaxFrameSize = PW_SYSTEM_MAX_TRANSMISSION_UNIT>
+class HdlcRpcDispatcherWithBuffer : public HdlcRpcDispatcher {
+ public:
+  HdlcRpcDispatcherWithBuffer(stream::Reader& reader,
+                              span<const uint64_t> addresses,
+                              rpc::Server& server = GetRpcServer())
+      : HdlcRpcDispatcher(reader, decode_buffer_, addresses, server) {}
+
+ private:
+  std::array<std::byte,
+             hdlc::Decoder::RequiredBufferSizeForFrameSize(kMaxFrameSize)>
+      decode_buffer_;
+};
+
+}  // namespace pw::system
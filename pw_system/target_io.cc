@@ -14,13 +14,35 @@
 
 #include "pw_stream/stream.h"
 #include "pw_stream/sys_io_stream.h"
+#include "pw_sys_io/sys_io.h"
 #include "pw_system/io.h"
 
 namespace pw::system {
 namespace {
 
+// Waits for one byte, then reads any more that have already been received, so
+// that reads return as soon as data is available instead of waiting to fill
+// the RPC server's read buffer.
+class AvailableBytesSysIoReader : public stream::NonSeekableReader {
+ private:
+  StatusWithSize DoRead(ByteSpan dest) override {
+    if (dest.empty()) {
+      return StatusWithSize(0);
+    }
+    if (Status status = sys_io::ReadByte(&dest[0]); !status.ok()) {
+      return StatusWithSize(status, 0);
+    }
+    size_t bytes_read = 1;
+    while (bytes_read < dest.size() &&
+           sys_io::TryReadByte(&dest[bytes_read]).ok()) {
+      ++bytes_read;
+    }
+    return StatusWithSize(bytes_read);
+  }
+};
+
 stream::SysIoWriter writer;
-stream::SysIoReader reader;
+AvailableBytesSysIoReader reader;
 
 }  // namespace
 
@@ -14,6 +14,7 @@
 
 #include "pw_system/transfer_service.h"
 
+#include "pw_system/config.h"
 #include "pw_system/file_manager.h"
 
 namespace pw::system {
@@ -21,8 +22,10 @@ namespace {
 // The maximum number of concurrent transfers the thread should support as
 // either a client or a server. These can be set to 0 (if only using one or
 // the other).
-constexpr size_t kMaxConcurrentClientTransfers = 5;
-constexpr size_t kMaxConcurrentServerTransfers = 3;
+constexpr size_t kMaxConcurrentClientTransfers =
+    PW_SYSTEM_TRANSFER_MAX_CLIENT_TRANSFERS;
+constexpr size_t kMaxConcurrentServerTransfers =
+    PW_SYSTEM_TRANSFER_MAX_SERVER_TRANSFERS;
 
 // The maximum payload size that can be transmitted by the system's
 // transport stack. This would typically be defined within some transport
@@ -34,12 +37,15 @@ constexpr size_t kMaxTransmissionUnit = 512;
 //
 // pw_transfer requires some additional per-packet overhead, so the actual
 // amount of data it sends may be lower than this.
-constexpr size_t kMaxTransferChunkSizeBytes = 480;
+constexpr size_t kMaxTransferChunkSizeBytes =
+    PW_SYSTEM_TRANSFER_CHUNK_SIZE_BYTES;
+static_assert(kMaxTransferChunkSizeBytes < kMaxTransmissionUnit);
 
 // In a write transfer, the maximum number of bytes to receive at one time
 // (potentially across multiple chunks), unless specified otherwise by the
 // transfer handler's stream::Writer.
-constexpr size_t kDefaultMaxBytesToReceive = 1024;
+constexpr size_t kDefaultMaxBytesToReceive =
+    PW_SYSTEM_TRANSFER_MAX_BYTES_TO_RECEIVE;
 
 // Buffers for storing and encoding chunks (see documentation above).
 std::array<std::byte, kMaxTransferChunkSizeBytes> chunk_buffer;
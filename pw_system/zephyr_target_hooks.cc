@@ -12,6 +12,7 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include "pw_system/config.h"
 #include "pw_thread/thread.h"
 #include "pw_thread_zephyr/config.h"
 #include "pw_thread_zephyr/options.h"
@@ -20,16 +21,24 @@ namespace pw::system {
 
 using namespace pw::thread::zephyr::config;
 
-// Low to high priorities.
+// Thread priorities, as levels above the default priority. Zephyr runs lower
+// priority values first. See the PW_SYSTEM_*_THREAD_PRIORITY options.
+//
+// TODO(amontanez): These should ideally be at different priority levels by
+// default, but there's synchronization issues when they are.
 enum class ThreadPriority : int {
-  kWorkQueue = kDefaultPriority,
-  // TODO(amontanez): These should ideally be at different priority levels, but
-  // there's synchronization issues when they are.
-  kLog = kWorkQueue,
-  kRpc = kWorkQueue,
-  kNumPriorities,
+  kWorkQueue = kDefaultPriority - PW_SYSTEM_WORK_QUEUE_THREAD_PRIORITY,
+  kLog = kDefaultPriority - PW_SYSTEM_LOG_THREAD_PRIORITY,
+  kRpc = kDefaultPriority - PW_SYSTEM_RPC_THREAD_PRIORITY,
 };
 
+static_assert(static_cast<int>(ThreadPriority::kWorkQueue) >=
+              kHighestSchedulerPriority);
+static_assert(static_cast<int>(ThreadPriority::kLog) >=
+              kHighestSchedulerPriority);
+static_assert(static_cast<int>(ThreadPriority::kRpc) >=
+              kHighestSchedulerPriority);
+
 static constexpr size_t kLogThreadStackWords =
     CONFIG_PIGWEED_SYSTEM_TARGET_HOOKS_LOG_STACK_SIZE;
 static thread::zephyr::StaticContextWithStack<kLogThreadStackWords>
@@ -29,6 +29,9 @@ namespace pw::thread {
 //     stack_end_pointer
 //     stack_est_peak_pointer
 //     thread_name
+//     run_time
+//     context_switches
+//     cpu_usage_hundredths
 class ThreadInfo {
  public:
   ThreadInfo() = default;
@@ -85,6 +88,50 @@ class ThreadInfo {
 
   void clear_thread_name() { clear_stack_info_ptr(kThreadName); }
 
+  // The accumulated time the thread has run, in the units of the backend's
+  // run-time counter. Only comparable to other threads' run times.
+  constexpr std::optional<uint64_t> run_time() const {
+    return has_value_[kRunTime] ? std::make_optional(run_time_)
+                                : std::nullopt;
+  }
+
+  void set_run_time(uint64_t val) {
+    run_time_ = val;
+    has_value_.set(kRunTime, true);
+  }
+
+  void clear_run_time() { has_value_.set(kRunTime, false); }
+
+  // The number of times the thread has been switched in to run.
+  constexpr std::optional<uint64_t> context_switches() const {
+    return has_value_[kContextSwitches] ? std::make_optional(context_switches_)
+                                        : std::nullopt;
+  }
+
+  void set_context_switches(uint64_t val) {
+    context_switches_ = val;
+    has_value_.set(kContextSwitches, true);
+  }
+
+  void clear_context_switches() { has_value_.set(kContextSwitches, false); }
+
+  // The percentage of CPU time the thread has been active, in hundredths of a
+  // percent (e.g. 5.00% = 500u).
+  constexpr std::optional<uint32_t> cpu_usage_hundredths() const {
+    return has_value_[kCpuUsageHundredths]
+               ? std::make_optional(cpu_usage_hundredths_)
+               : std::nullopt;
+  }
+
+  void set_cpu_usage_hundredths(uint32_t val) {
+    cpu_usage_hundredths_ = val;
+    has_value_.set(kCpuUsageHundredths, true);
+  }
+
+  void clear_cpu_usage_hundredths() {
+    has_value_.set(kCpuUsageHundredths, false);
+  }
+
  private:
   enum ThreadInfoIndex {
     kStackLowAddress,
@@ -92,6 +139,9 @@ class ThreadInfo {
     kStackPointer,
     kStackPeakAddress,
     kThreadName,
+    kRunTime,
+    kContextSwitches,
+    kCpuUsageHundredths,
     kMaxNumMembersDoNotUse,
   };
 
@@ -113,6 +163,9 @@ class ThreadInfo {
   std::bitset<ThreadInfoIndex::kMaxNumMembersDoNotUse> has_value_;
   uintptr_t stack_info_ptrs_[ThreadInfoIndex::kMaxNumMembersDoNotUse];
   span<const std::byte> thread_name_;
+  uint64_t run_time_;
+  uint64_t context_switches_;
+  uint32_t cpu_usage_hundredths_;
 };
 
 }  // namespace pw::thread
@@ -182,8 +182,12 @@ class ThreadInfo:
         )
 
     def __str__(self) -> str:
-        output = [
-            f'Est CPU usage: {self._cpu_used_str()}',
+        output = [f'Est CPU usage: {self._cpu_used_str()}']
+        if self._thread.HasField('run_time'):
+            output.append(f'Run time: {self._thread.run_time}')
+        if self._thread.HasField('context_switches'):
+            output.append(f'Context switches: {self._thread.context_switches}')
+        output += [
             'Stack info',
             f'  Current usage:   {self._stack_used_range_str()}',
             f'  Est peak usage:  {self._stack_pointer_est_peak_str()}',
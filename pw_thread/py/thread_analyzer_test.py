@@ -57,6 +57,25 @@ class ThreadInfoTest(unittest.TestCase):
         self.assertFalse(thread_info.has_stack_used())
         self.assertEqual(expected, str(thread_info))
 
+    def test_thread_with_run_time_stats(self):
+        thread = thread_pb2.Thread()
+        thread.run_time = 123456789
+        thread.context_switches = 4242
+        thread_info = ThreadInfo(thread)
+
+        expected = '\n'.join(
+            (
+                'Est CPU usage: unknown',
+                'Run time: 123456789',
+                'Context switches: 4242',
+                'Stack info',
+                '  Current usage:   0x???????? - 0x???????? (size unknown)',
+                '  Est peak usage:  size unknown',
+                '  Stack limits:    0x???????? - 0x???????? (size unknown)',
+            )
+        )
+        self.assertEqual(expected, str(thread_info))
+
     def test_thread_with_stack_pointer(self):
         thread = thread_pb2.Thread()
         thread.stack_pointer = 0x5AC6A86C
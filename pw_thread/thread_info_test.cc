@@ -95,5 +95,43 @@ TEST(ThreadInfo, PeakAddr) {
   EXPECT_EQ(thread_info.stack_peak_addr(), std::nullopt);
 }
 
+TEST(ThreadInfo, RunTime) {
+  ThreadInfo thread_info;
+  // Getter.
+  EXPECT_EQ(thread_info.run_time(), std::nullopt);
+  // Setter.
+  thread_info.set_run_time(0u);
+  EXPECT_EQ(thread_info.run_time(), 0u);
+  thread_info.set_run_time(0x123456789abcu);
+  EXPECT_EQ(thread_info.run_time(), 0x123456789abcu);
+  // Clear.
+  thread_info.clear_run_time();
+  EXPECT_EQ(thread_info.run_time(), std::nullopt);
+}
+
+TEST(ThreadInfo, ContextSwitches) {
+  ThreadInfo thread_info;
+  // Getter.
+  EXPECT_EQ(thread_info.context_switches(), std::nullopt);
+  // Setter.
+  thread_info.set_context_switches(42u);
+  EXPECT_EQ(thread_info.context_switches(), 42u);
+  // Clear.
+  thread_info.clear_context_switches();
+  EXPECT_EQ(thread_info.context_switches(), std::nullopt);
+}
+
+TEST(ThreadInfo, CpuUsageHundredths) {
+  ThreadInfo thread_info;
+  // Getter.
+  EXPECT_EQ(thread_info.cpu_usage_hundredths(), std::nullopt);
+  // Setter.
+  thread_info.set_cpu_usage_hundredths(1234u);
+  EXPECT_EQ(thread_info.cpu_usage_hundredths(), 1234u);
+  // Clear.
+  thread_info.clear_cpu_usage_hundredths();
+  EXPECT_EQ(thread_info.cpu_usage_hundredths(), std::nullopt);
+}
+
 }  // namespace
 }  // namespace pw::thread
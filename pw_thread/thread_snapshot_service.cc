@@ -55,6 +55,18 @@ Status ProtoEncodeThreadInfo(pwpb::SnapshotThreadInfo::StreamEncoder& encoder,
         proto_encoder.WriteStackPointer(thread_info.stack_pointer().value()));
   }
 
+  if (thread_info.run_time().has_value()) {
+    PW_TRY(proto_encoder.WriteRunTime(thread_info.run_time().value()));
+  }
+  if (thread_info.context_switches().has_value()) {
+    PW_TRY(proto_encoder.WriteContextSwitches(
+        thread_info.context_switches().value()));
+  }
+  if (thread_info.cpu_usage_hundredths().has_value()) {
+    PW_TRY(proto_encoder.WriteCpuUsageHundredths(
+        thread_info.cpu_usage_hundredths().value()));
+  }
+
   if (thread_info.stack_peak_addr().has_value()) {
     PW_TRY(proto_encoder.WriteStackPointerEstPeak(
         thread_info.stack_peak_addr().value()));
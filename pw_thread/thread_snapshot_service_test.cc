@@ -184,6 +184,57 @@ TEST(ThreadSnapshotService, FailedPrecondition) {
             Status::FailedPrecondition());
 }
 
+TEST(ThreadSnapshotService, EncodesRunTimeStats) {
+  std::array<std::byte, RequiredServiceBufferSize(1)> encode_buffer;
+
+  proto::pwpb::SnapshotThreadInfo::MemoryEncoder encoder(encode_buffer);
+
+  ConstByteSpan name = bytes::String("MyThread\0");
+  ThreadInfo thread_info =
+      CreateThreadInfoObject(std::make_optional(name),
+                             std::make_optional(static_cast<uintptr_t>(0u)),
+                             std::make_optional(static_cast<uintptr_t>(0u)),
+                             std::make_optional(static_cast<uintptr_t>(0u)));
+  thread_info.set_run_time(123456789u);
+  thread_info.set_context_switches(4242u);
+  thread_info.set_cpu_usage_hundredths(1234u);
+  ASSERT_EQ(OkStatus(), ProtoEncodeThreadInfo(encoder, thread_info));
+
+  ConstByteSpan response_span(encoder);
+  protobuf::Decoder decoder(response_span);
+  ASSERT_EQ(OkStatus(), decoder.Next());
+  ConstByteSpan thread_buffer;
+  ASSERT_EQ(OkStatus(), decoder.ReadBytes(&thread_buffer));
+
+  std::optional<uint64_t> run_time;
+  std::optional<uint64_t> context_switches;
+  std::optional<uint32_t> cpu_usage_hundredths;
+  protobuf::Decoder thread_decoder(thread_buffer);
+  while (thread_decoder.Next().ok()) {
+    uint64_t value64;
+    uint32_t value32;
+    switch (thread_decoder.FieldNumber()) {
+      case static_cast<uint32_t>(proto::pwpb::Thread::Fields::kRunTime):
+        ASSERT_EQ(OkStatus(), thread_decoder.ReadUint64(&value64));
+        run_time = value64;
+        break;
+      case static_cast<uint32_t>(
+          proto::pwpb::Thread::Fields::kContextSwitches):
+        ASSERT_EQ(OkStatus(), thread_decoder.ReadUint64(&value64));
+        context_switches = value64;
+        break;
+      case static_cast<uint32_t>(
+          proto::pwpb::Thread::Fields::kCpuUsageHundredths):
+        ASSERT_EQ(OkStatus(), thread_decoder.ReadUint32(&value32));
+        cpu_usage_hundredths = value32;
+        break;
+    }
+  }
+  EXPECT_EQ(run_time, 123456789u);
+  EXPECT_EQ(context_switches, 4242u);
+  EXPECT_EQ(cpu_usage_hundredths, 1234u);
+}
+
 TEST(ThreadSnapshotService, Unimplemented) {
   static std::array<std::byte, RequiredServiceBufferSize(1)> encode_buffer;
 
@@ -121,6 +121,19 @@ Status SnapshotThread(const OS_TASK& thread,
 
   CaptureThreadState(thread, encoder);
 
+  // The embOS statistics functions take a non-const task pointer but do not
+  // modify the task.
+  [[maybe_unused]] OS_TASK* const task = const_cast<OS_TASK*>(&thread);
+#if defined(OS_PROFILE) && OS_PROFILE
+  encoder.WriteContextSwitches(OS_STAT_GetNumActivations(task));
+#endif  // OS_PROFILE
+#if defined(OS_SUPPORT_STAT) && OS_SUPPORT_STAT
+  encoder.WriteRunTime(OS_STAT_GetTaskExecTime(task));
+  // The load is in permille and is updated by OS_STAT_Sample().
+  encoder.WriteCpuUsageHundredths(
+      static_cast<uint32_t>(OS_STAT_GetLoad(task)) * 10u);
+#endif  // OS_SUPPORT_STAT
+
 #if OS_CHECKSTACK || OS_SUPPORT_MPU
   const StackContext thread_ctx = {
       .thread_name = thread.Name,
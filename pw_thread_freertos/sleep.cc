@@ -45,12 +45,13 @@ void sleep_for(SystemClock::duration sleep_duration) {
   constexpr SystemClock::duration kMaxTimeoutMinusOne =
       pw::chrono::freertos::kMaxTimeout - SystemClock::duration(1);
   while (sleep_duration > kMaxTimeoutMinusOne) {
-    vTaskDelay(static_cast<TickType_t>(kMaxTimeoutMinusOne.count()));
+    vTaskDelay(pw::chrono::freertos::ToTicks(kMaxTimeoutMinusOne));
     sleep_duration -= kMaxTimeoutMinusOne;
   }
   // On a tick based kernel we cannot tell how far along we are on the current
   // tick, ergo we add one whole tick to the final duration.
-  vTaskDelay(static_cast<TickType_t>(sleep_duration.count() + 1));
+  vTaskDelay(static_cast<TickType_t>(
+      pw::chrono::freertos::ToTicks(sleep_duration) + 1));
 }
 
 }  // namespace pw::this_thread
@@ -130,6 +130,10 @@ Status SnapshotThread(
 
   CaptureThreadState(thread_state, encoder);
 
+#if configGENERATE_RUN_TIME_STATS == 1
+  PW_TRY(encoder.WriteRunTime(tcb.ulRunTimeCounter));
+#endif  // configGENERATE_RUN_TIME_STATS == 1
+
   // TODO: b/234890430 - Update this once we add support for ascending stacks.
   static_assert(portSTACK_GROWTH < 0, "Ascending stacks are not yet supported");
 
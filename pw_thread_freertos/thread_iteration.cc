@@ -27,6 +27,22 @@
 
 namespace pw::thread {
 namespace freertos {
+namespace {
+
+#if configGENERATE_RUN_TIME_STATS == 1
+// Returns the run-time counter that task run times are accumulated from.
+uint64_t TotalRunTime() {
+#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+  uint64_t total_run_time = 0;
+  portALT_GET_RUN_TIME_COUNTER_VALUE(total_run_time);
+  return total_run_time;
+#else
+  return portGET_RUN_TIME_COUNTER_VALUE();
+#endif  // portALT_GET_RUN_TIME_COUNTER_VALUE
+}
+#endif  // configGENERATE_RUN_TIME_STATS == 1
+
+}  // namespace
 
 bool StackInfoCollector(TaskHandle_t current_thread,
                         const pw::thread::ThreadCallback& cb) {
@@ -59,6 +75,19 @@ bool StackInfoCollector(TaskHandle_t current_thread,
 #endif  // INCLUDE_uxTaskGetStackHighWaterMark
 #endif  // configRECORD_STACK_HIGH_ADDRESS
 
+#if configGENERATE_RUN_TIME_STATS == 1
+  // FreeRTOS has no per-task count of context switches, so only run time is
+  // reported.
+  thread_info.set_run_time(tcb.ulRunTimeCounter);
+  // Scale the total down rather than the task's run time up, which could
+  // overflow.
+  if (const uint64_t total_run_time = TotalRunTime();
+      total_run_time >= 10000u) {
+    thread_info.set_cpu_usage_hundredths(static_cast<uint32_t>(
+        tcb.ulRunTimeCounter / (total_run_time / 10000u)));
+  }
+#endif  // configGENERATE_RUN_TIME_STATS == 1
+
   return cb(thread_info);
 }
 
@@ -0,0 +1,207 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "pw_thread/id.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::thread::stl {
+namespace {
+
+TEST(Options, DefaultOptions_NoAttributes) {
+  constexpr Options options;
+  static_assert(options.stack_size() == 0);
+  static_assert(options.scheduling_policy() == SchedulingPolicy::kDefault);
+  static_assert(options.cpu_affinity() == 0);
+}
+
+TEST(Options, Setters_Chain) {
+  constexpr Options options = Options()
+                                  .set_stack_size(65536)
+                                  .set_scheduling(SchedulingPolicy::kFifo, 10)
+                                  .set_cpu_affinity(0b101);
+  static_assert(options.stack_size() == 65536);
+  static_assert(options.scheduling_policy() == SchedulingPolicy::kFifo);
+  static_assert(options.priority() == 10);
+  static_assert(options.cpu_affinity() == 0b101);
+}
+
+#if defined(__linux__)
+
+// Returns the lowest CPU this process may run on.
+int FirstAllowedCpu() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    return -1;
+  }
+  for (int cpu = 0; cpu < 64; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) {
+      return cpu;
+    }
+  }
+  return -1;
+}
+
+TEST(Thread, CpuAffinity_AppliedBeforeEntry) {
+  const int cpu = FirstAllowedCpu();
+  ASSERT_GE(cpu, 0);
+
+  struct {
+    cpu_set_t cpu_set;
+    int result;
+  } observed = {};
+  Thread thread(
+      Options().set_cpu_affinity(uint64_t{1} << cpu),
+      [](void* arg) {
+        auto& out = *static_cast<decltype(observed)*>(arg);
+        CPU_ZERO(&out.cpu_set);
+        out.result = sched_getaffinity(0, sizeof(out.cpu_set), &out.cpu_set);
+      },
+      &observed);
+  thread.join();
+
+  ASSERT_EQ(observed.result, 0);
+  EXPECT_EQ(CPU_COUNT(&observed.cpu_set), 1);
+  EXPECT_TRUE(CPU_ISSET(cpu, &observed.cpu_set));
+}
+
+#endif  // defined(__linux__)
+
+#if defined(__GLIBC__)
+
+// Returns the stack size of the calling thread, or 0 on failure.
+size_t CurrentStackSize() {
+  size_t stack_size = 0;
+  pthread_attr_t attributes;
+  if (pthread_getattr_np(pthread_self(), &attributes) == 0) {
+    pthread_attr_getstacksize(&attributes, &stack_size);
+    pthread_attr_destroy(&attributes);
+  }
+  return stack_size;
+}
+
+// Returns the stack size used by threads created without attributes.
+size_t DefaultStackSize() {
+  size_t stack_size = 0;
+  pthread_attr_t attributes;
+  if (pthread_getattr_default_np(&attributes) == 0) {
+    pthread_attr_getstacksize(&attributes, &stack_size);
+    pthread_attr_destroy(&attributes);
+  }
+  return stack_size;
+}
+
+TEST(Thread, StackSize_Applied) {
+  constexpr size_t kStackSize = 256 * 1024;
+  size_t stack_size = 0;
+  Thread thread(
+      Options().set_stack_size(kStackSize),
+      [](void* arg) { *static_cast<size_t*>(arg) = CurrentStackSize(); },
+      &stack_size);
+  thread.join();
+  EXPECT_GE(stack_size, kStackSize);
+  EXPECT_LT(stack_size, 2 * kStackSize);
+}
+
+TEST(Thread, StackSize_DoesNotChangeProcessDefault) {
+  constexpr size_t kStackSize = 256 * 1024;
+  const size_t default_stack_size = DefaultStackSize();
+  ASSERT_NE(default_stack_size, kStackSize);
+
+  // Threads created while the thread with a stack size runs still get the
+  // process default.
+  struct {
+    size_t default_stack_size;
+    size_t other_thread_stack_size;
+  } observed = {};
+  Thread thread(
+      Options().set_stack_size(kStackSize),
+      [](void* arg) {
+        auto& out = *static_cast<decltype(observed)*>(arg);
+        out.default_stack_size = DefaultStackSize();
+        std::thread other(
+            [&out] { out.other_thread_stack_size = CurrentStackSize(); });
+        other.join();
+      },
+      &observed);
+  thread.join();
+
+  EXPECT_EQ(observed.default_stack_size, default_stack_size);
+  EXPECT_GE(observed.other_thread_stack_size, default_stack_size);
+}
+
+#endif  // defined(__GLIBC__)
+
+#if PW_THREAD_STL_HAS_PTHREADS
+
+TEST(Thread, StackSize_IdMatchesThread) {
+  Id id_in_thread;
+  Thread thread(
+      Options().set_stack_size(256 * 1024),
+      [](void* arg) { *static_cast<Id*>(arg) = this_thread::get_id(); },
+      &id_in_thread);
+  const Id id = thread.get_id();
+  EXPECT_NE(id, Id());
+  EXPECT_NE(id, this_thread::get_id());
+  EXPECT_TRUE(thread.joinable());
+
+  thread.join();
+  EXPECT_EQ(id_in_thread, id);
+  EXPECT_FALSE(thread.joinable());
+}
+
+TEST(Thread, StackSize_Detach) {
+  std::atomic<bool> done = false;
+  Thread thread(
+      Options().set_stack_size(256 * 1024),
+      [](void* arg) { static_cast<std::atomic<bool>*>(arg)->store(true); },
+      &done);
+  thread.detach();
+  EXPECT_FALSE(thread.joinable());
+
+  while (!done.load()) {
+    std::this_thread::yield();
+  }
+}
+
+TEST(Thread, StackSize_MoveAndSwap) {
+  Thread thread(Options().set_stack_size(256 * 1024), [](void*) {});
+  const Id id = thread.get_id();
+
+  Thread moved;
+  moved = std::move(thread);
+  EXPECT_FALSE(thread.joinable());
+  EXPECT_EQ(moved.get_id(), id);
+
+  thread.swap(moved);
+  EXPECT_FALSE(moved.joinable());
+  EXPECT_EQ(thread.get_id(), id);
+  thread.join();
+}
+
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+
+}  // namespace
+}  // namespace pw::thread::stl
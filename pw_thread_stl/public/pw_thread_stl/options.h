@@ -13,17 +13,95 @@
 // the License.
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include "pw_thread/thread.h"
 
 namespace pw::thread::stl {
 
+// Scheduling policies which may be requested for an STL thread. The real-time
+// policies map onto POSIX's SCHED_FIFO and SCHED_RR.
+enum class SchedulingPolicy {
+  // Inherit the default, non-real-time policy of the process.
+  kDefault,
+  // Run until blocked, yielded, or preempted by a higher priority thread.
+  kFifo,
+  // Like kFifo, but time-sliced between threads of the same priority.
+  kRoundRobin,
+};
+
+// pw::thread::Options for the STL.
+//
 // Unfortunately std::thread:attributes was not accepted into the C++ standard.
-// Instead, users are expected to start the thread and after dynamically adjust
-// the thread's attributes using std::thread::native_handle based on the native
-// threading APIs.
+// By default, threads are started with the platform's default attributes and
+// users may adjust them afterwards through native_handle().native_handle(),
+// which returns the handle for the native threading APIs (e.g. a pthread_t).
+//
+// On POSIX platforms, a stack size, a real-time scheduling policy, and a CPU
+// affinity may instead be requested up front. The scheduling policy and CPU
+// affinity are applied by the new thread before it invokes its entry function.
+// Requesting an attribute which the platform does not support, or which the
+// process lacks the privileges to set, is a fatal error.
+//
+// Example usage:
+//
+//   // Pins the thread to CPU 2 and runs it with SCHED_FIFO priority 10.
+//   pw::thread::Thread example_thread(
+//     pw::thread::stl::Options()
+//         .set_scheduling(pw::thread::stl::SchedulingPolicy::kFifo, 10)
+//         .set_cpu_affinity(1u << 2),
+//     example_thread_function);
+//
 class Options : public thread::Options {
  public:
   constexpr Options() {}
+  constexpr Options(const Options&) = default;
+  constexpr Options(Options&&) = default;
+
+  // Sets the size of the thread's stack in bytes. 0 uses the platform default.
+  //
+  // std::thread offers no way to pass a stack size, so a thread with a stack
+  // size is created with pthread_create and its own attributes instead. This
+  // is only supported on POSIX platforms.
+  constexpr Options& set_stack_size(size_t stack_size_bytes) {
+    stack_size_bytes_ = stack_size_bytes;
+    return *this;
+  }
+
+  // Sets the scheduling policy and its priority. The priority must be within
+  // sched_get_priority_min() and sched_get_priority_max() for the policy, and
+  // is ignored for SchedulingPolicy::kDefault.
+  //
+  // Real-time policies typically require elevated privileges such as
+  // CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO.
+  constexpr Options& set_scheduling(SchedulingPolicy policy, int priority) {
+    scheduling_policy_ = policy;
+    priority_ = priority;
+    return *this;
+  }
+
+  // Restricts the thread to run on the CPUs whose bits are set in cpu_mask,
+  // where bit N corresponds to CPU N. 0 lets the thread run on any CPU.
+  //
+  // This is only supported on Linux.
+  constexpr Options& set_cpu_affinity(uint64_t cpu_mask) {
+    cpu_mask_ = cpu_mask;
+    return *this;
+  }
+
+  constexpr size_t stack_size() const { return stack_size_bytes_; }
+  constexpr SchedulingPolicy scheduling_policy() const {
+    return scheduling_policy_;
+  }
+  constexpr int priority() const { return priority_; }
+  constexpr uint64_t cpu_affinity() const { return cpu_mask_; }
+
+ private:
+  size_t stack_size_bytes_ = 0;
+  SchedulingPolicy scheduling_policy_ = SchedulingPolicy::kDefault;
+  int priority_ = 0;
+  uint64_t cpu_mask_ = 0;
 };
 
 }  // namespace pw::thread::stl
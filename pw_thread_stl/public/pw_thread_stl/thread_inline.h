@@ -35,10 +35,6 @@ namespace internal {
 
 inline Thread::Thread() : native_type_() {}
 
-inline Thread::Thread(const Options&, ThreadRoutine entry, void* arg) {
-  native_type_ = std::thread(entry, arg);
-}
-
 inline Thread& Thread::operator=(Thread&& other) {
   native_type_ = std::move(other.native_type_);
   return *this;
@@ -13,13 +13,101 @@
 // the License.
 #pragma once
 
+#include <exception>
 #include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#define PW_THREAD_STL_HAS_PTHREADS 1
+#else
+#define PW_THREAD_STL_HAS_PTHREADS 0
+#endif  // defined(__linux__) || defined(__APPLE__)
 
 #define PW_THREAD_JOINING_ENABLED 1
 
 namespace pw::thread::backend {
 
-using NativeThread = std::thread;
-using NativeThreadHandle = std::thread&;
+// The thread represented by a pw::thread::Thread. This is normally a
+// std::thread. std::thread cannot be given a stack size, so on POSIX platforms
+// threads with a stack size are instead created with pthread_create, and are
+// tracked by their pthread_t and the std::thread::id they report on startup.
+class NativeThread {
+ public:
+  using native_handle_type = std::thread::native_handle_type;
+
+  NativeThread() = default;
+  explicit NativeThread(std::thread&& thread) : thread_(std::move(thread)) {}
+#if PW_THREAD_STL_HAS_PTHREADS
+  NativeThread(pthread_t pthread, std::thread::id id)
+      : pthread_(pthread), pthread_id_(id) {}
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+
+  NativeThread(const NativeThread&) = delete;
+  NativeThread& operator=(const NativeThread&) = delete;
+
+  NativeThread(NativeThread&& other) noexcept { swap(other); }
+
+  // Like std::thread, terminates if this still represents a joinable thread.
+  NativeThread& operator=(NativeThread&& other) noexcept {
+    if (joinable()) {
+      std::terminate();
+    }
+    swap(other);
+    return *this;
+  }
+
+  ~NativeThread() {
+    if (joinable()) {
+      std::terminate();
+    }
+  }
+
+  std::thread::id get_id() const {
+#if PW_THREAD_STL_HAS_PTHREADS
+    if (pthread_id_ != std::thread::id()) {
+      return pthread_id_;
+    }
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+    return thread_.get_id();
+  }
+
+  bool joinable() const { return get_id() != std::thread::id(); }
+
+  void join();
+  void detach();
+
+  void swap(NativeThread& other) noexcept {
+    thread_.swap(other.thread_);
+#if PW_THREAD_STL_HAS_PTHREADS
+    std::swap(pthread_, other.pthread_);
+    std::swap(pthread_id_, other.pthread_id_);
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+  }
+
+  // Returns the handle for the platform's native threading APIs, such as the
+  // pthread_t on POSIX platforms.
+  native_handle_type native_handle() {
+#if PW_THREAD_STL_HAS_PTHREADS
+    if (pthread_id_ != std::thread::id()) {
+      return pthread_;
+    }
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+    return thread_.native_handle();
+  }
+
+ private:
+  std::thread thread_;
+#if PW_THREAD_STL_HAS_PTHREADS
+  static_assert(std::is_same_v<native_handle_type, pthread_t>);
+
+  // Only represents a thread while pthread_id_ is not std::thread::id().
+  pthread_t pthread_ = {};
+  std::thread::id pthread_id_;
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+};
+
+using NativeThreadHandle = NativeThread&;
 
 }  // namespace pw::thread::backend
@@ -0,0 +1,212 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_thread/thread.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "pw_assert/check.h"
+#include "pw_thread_stl/options.h"
+
+#if PW_THREAD_STL_HAS_PTHREADS
+#include <pthread.h>
+#include <sched.h>
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+
+namespace pw::thread {
+namespace {
+
+// Applies the attributes which std::thread cannot pass at creation. This is
+// invoked by the new thread before it runs its entry function.
+void ApplyToCurrentThread(stl::SchedulingPolicy policy,
+                          int priority,
+                          uint64_t cpu_mask) {
+  if (cpu_mask != 0) {
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (unsigned cpu = 0; cpu < 64u; ++cpu) {
+      if ((cpu_mask >> cpu) & 1u) {
+        CPU_SET(cpu, &cpu_set);
+      }
+    }
+    const int result =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    PW_CHECK_INT_EQ(result,
+                    0,
+                    "Failed to set the thread's CPU affinity: %s",
+                    std::strerror(result));
+#else
+    PW_CRASH("CPU affinity is not supported on this platform");
+#endif  // defined(__linux__)
+  }
+
+  if (policy != stl::SchedulingPolicy::kDefault) {
+#if PW_THREAD_STL_HAS_PTHREADS
+    sched_param param = {};
+    param.sched_priority = priority;
+    const int native_policy =
+        policy == stl::SchedulingPolicy::kFifo ? SCHED_FIFO : SCHED_RR;
+    const int result =
+        pthread_setschedparam(pthread_self(), native_policy, &param);
+    PW_CHECK_INT_EQ(result,
+                    0,
+                    "Failed to set the thread's scheduling policy: %s",
+                    std::strerror(result));
+#else
+    static_cast<void>(priority);
+    PW_CRASH("Scheduling policies are not supported on this platform");
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+  }
+}
+
+std::thread CreateThread(const stl::Options& options,
+                         Thread::ThreadRoutine entry,
+                         void* arg) {
+  const stl::SchedulingPolicy policy = options.scheduling_policy();
+  const int priority = options.priority();
+  const uint64_t cpu_mask = options.cpu_affinity();
+  if (policy == stl::SchedulingPolicy::kDefault && cpu_mask == 0) {
+    return std::thread(entry, arg);
+  }
+  return std::thread([policy, priority, cpu_mask, entry, arg] {
+    ApplyToCurrentThread(policy, priority, cpu_mask);
+    entry(arg);
+  });
+}
+
+#if PW_THREAD_STL_HAS_PTHREADS
+
+// Passed to a thread created with pthread_create, which reports its
+// std::thread::id before it runs its entry function.
+struct PthreadStart {
+  Thread::ThreadRoutine entry;
+  void* arg;
+  stl::SchedulingPolicy policy;
+  int priority;
+  uint64_t cpu_mask;
+
+  std::mutex mutex;
+  std::condition_variable started;
+  std::thread::id id;
+};
+
+void* RunPthread(void* void_start) {
+  PthreadStart& start = *static_cast<PthreadStart*>(void_start);
+  const Thread::ThreadRoutine entry = start.entry;
+  void* const arg = start.arg;
+  const stl::SchedulingPolicy policy = start.policy;
+  const int priority = start.priority;
+  const uint64_t cpu_mask = start.cpu_mask;
+  {
+    std::lock_guard lock(start.mutex);
+    start.id = std::this_thread::get_id();
+    start.started.notify_one();
+  }
+  // The creating thread may destroy `start` from here on.
+
+  ApplyToCurrentThread(policy, priority, cpu_mask);
+  entry(arg);
+  return nullptr;
+}
+
+// Creates a thread with its own attributes, which unlike std::thread can
+// include a stack size.
+backend::NativeThread CreatePthread(const stl::Options& options,
+                                    Thread::ThreadRoutine entry,
+                                    void* arg) {
+  pthread_attr_t attributes;
+  PW_CHECK_INT_EQ(pthread_attr_init(&attributes), 0);
+  PW_CHECK_INT_EQ(pthread_attr_setstacksize(&attributes, options.stack_size()),
+                  0,
+                  "Invalid thread stack size of %zu bytes",
+                  options.stack_size());
+
+  PthreadStart start;
+  start.entry = entry;
+  start.arg = arg;
+  start.policy = options.scheduling_policy();
+  start.priority = options.priority();
+  start.cpu_mask = options.cpu_affinity();
+
+  pthread_t pthread;
+  const int result = pthread_create(&pthread, &attributes, RunPthread, &start);
+  pthread_attr_destroy(&attributes);
+  PW_CHECK_INT_EQ(result,
+                  0,
+                  "Failed to create the thread: %s",
+                  std::strerror(result));
+
+  std::unique_lock lock(start.mutex);
+  start.started.wait(lock, [&start] { return start.id != std::thread::id(); });
+  return backend::NativeThread(pthread, start.id);
+}
+
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+
+}  // namespace
+
+namespace backend {
+
+void NativeThread::join() {
+#if PW_THREAD_STL_HAS_PTHREADS
+  if (pthread_id_ != std::thread::id()) {
+    const int result = pthread_join(pthread_, nullptr);
+    PW_CHECK_INT_EQ(
+        result, 0, "Failed to join the thread: %s", std::strerror(result));
+    pthread_id_ = std::thread::id();
+    return;
+  }
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+  thread_.join();
+}
+
+void NativeThread::detach() {
+#if PW_THREAD_STL_HAS_PTHREADS
+  if (pthread_id_ != std::thread::id()) {
+    const int result = pthread_detach(pthread_);
+    PW_CHECK_INT_EQ(
+        result, 0, "Failed to detach the thread: %s", std::strerror(result));
+    pthread_id_ = std::thread::id();
+    return;
+  }
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+  thread_.detach();
+}
+
+}  // namespace backend
+
+Thread::Thread(const thread::Options& facade_options,
+               ThreadRoutine entry,
+               void* arg) {
+  // Cast the generic facade options to the backend specific option of which
+  // only one type can exist at compile time.
+  const auto& options = static_cast<const stl::Options&>(facade_options);
+  if (options.stack_size() == 0) {
+    native_type_ = backend::NativeThread(CreateThread(options, entry, arg));
+    return;
+  }
+
+#if PW_THREAD_STL_HAS_PTHREADS
+  native_type_ = CreatePthread(options, entry, arg);
+#else
+  PW_CRASH("Thread stack sizes are not supported on this platform");
+#endif  // PW_THREAD_STL_HAS_PTHREADS
+}
+
+}  // namespace pw::thread
@@ -125,6 +125,12 @@ Status SnapshotThread(const TX_THREAD& thread,
 
   CaptureThreadState(thread, encoder);
 
+  // ThreadX increments the run count each time the thread is scheduled.
+  encoder.WriteContextSwitches(thread.tx_thread_run_count);
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+  encoder.WriteRunTime(thread.tx_thread_execution_time_total);
+#endif  // TX_EXECUTION_PROFILE_ENABLE
+
   const StackContext thread_ctx = {
       .thread_name = thread.tx_thread_name,
 
@@ -31,9 +31,38 @@ void zephyr_adapter(const struct k_thread* thread, void* user_data) {
 
 #ifdef CONFIG_THREAD_STACK_INFO
   thread_info.set_stack_low_addr(thread->stack_info.start);
+  thread_info.set_stack_high_addr(thread->stack_info.start +
+                                  thread->stack_info.size);
   thread_info.set_stack_pointer(thread->stack_info.start +
                                 thread->stack_info.size);
-#endif
+#ifdef CONFIG_INIT_STACKS
+  // Stacks grow down, so the deepest use is just above the unused space.
+  size_t unused_bytes;
+  if (k_thread_stack_space_get(thread, &unused_bytes) == 0) {
+    thread_info.set_stack_peak_addr(thread->stack_info.start + unused_bytes);
+  }
+#endif  // CONFIG_INIT_STACKS
+#endif  // CONFIG_THREAD_STACK_INFO
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+  k_thread_runtime_stats_t thread_stats;
+  k_thread_runtime_stats_t all_stats;
+  if (k_thread_runtime_stats_get((k_tid_t)thread, &thread_stats) == 0) {
+    thread_info.set_run_time(thread_stats.execution_cycles);
+    // Scale the total down rather than the thread's cycles up, which could
+    // overflow.
+    if (k_thread_runtime_stats_all_get(&all_stats) == 0 &&
+        all_stats.execution_cycles >= 10000u) {
+      thread_info.set_cpu_usage_hundredths(static_cast<uint32_t>(
+          thread_stats.execution_cycles /
+          (all_stats.execution_cycles / 10000u)));
+    }
+  }
+#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+  // Each usage window starts when the thread is switched in.
+  thread_info.set_context_switches(thread->base.usage.num_windows);
+#endif  // CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+#endif  // CONFIG_SCHED_THREAD_USAGE
 
   cb(thread_info);
 }
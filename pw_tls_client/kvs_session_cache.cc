@@ -0,0 +1,63 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tls_client/kvs_session_cache.h"
+
+#include <cstring>
+
+namespace pw::tls_client {
+
+std::string_view KvsSessionCache::MakeKey(std::string_view server_name,
+                                          KeyBuffer& buffer) const {
+  if (server_name.empty() ||
+      key_prefix_.size() + server_name.size() > sizeof(buffer)) {
+    return {};
+  }
+  std::memcpy(buffer, key_prefix_.data(), key_prefix_.size());
+  std::memcpy(
+      buffer + key_prefix_.size(), server_name.data(), server_name.size());
+  return std::string_view(buffer, key_prefix_.size() + server_name.size());
+}
+
+StatusWithSize KvsSessionCache::Load(std::string_view server_name,
+                                     ByteSpan dest) {
+  KeyBuffer buffer;
+  std::string_view key = MakeKey(server_name, buffer);
+  if (key.empty()) {
+    return StatusWithSize::InvalidArgument();
+  }
+  return kvs_.Get(key, dest);
+}
+
+Status KvsSessionCache::Store(std::string_view server_name,
+                              ConstByteSpan session) {
+  KeyBuffer buffer;
+  std::string_view key = MakeKey(server_name, buffer);
+  if (key.empty()) {
+    return Status::InvalidArgument();
+  }
+  return kvs_.Put(key, session);
+}
+
+Status KvsSessionCache::Erase(std::string_view server_name) {
+  KeyBuffer buffer;
+  std::string_view key = MakeKey(server_name, buffer);
+  if (key.empty()) {
+    return Status::InvalidArgument();
+  }
+  Status status = kvs_.Delete(key);
+  return status.IsNotFound() ? OkStatus() : status;
+}
+
+}  // namespace pw::tls_client
@@ -0,0 +1,132 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tls_client/kvs_session_cache.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include "pw_bytes/array.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::tls_client {
+namespace {
+
+constexpr size_t kSectorSize = 512;
+constexpr size_t kSectors = 4;
+constexpr size_t kMaxEntries = 8;
+
+constexpr auto kSession = bytes::Array<0x01, 0x02, 0x03, 0x04, 0x05>();
+constexpr auto kOtherSession = bytes::Array<0xa1, 0xa2, 0xa3>();
+
+kvs::ChecksumCrc16 checksum;
+
+class KvsSessionCacheTest : public ::testing::Test {
+ protected:
+  KvsSessionCacheTest()
+      : flash_(16),
+        partition_(&flash_),
+        kvs_(&partition_,
+             kvs::EntryFormat{.magic = 0x5e55c0de, .checksum = &checksum}),
+        cache_(kvs_) {}
+
+  void SetUp() override {
+    ASSERT_EQ(OkStatus(), flash_.Erase(0, flash_.sector_count()));
+    ASSERT_EQ(OkStatus(), kvs_.Init());
+  }
+
+  kvs::FakeFlashMemoryBuffer<kSectorSize, kSectors> flash_;
+  kvs::FlashPartition partition_;
+  kvs::KeyValueStoreBuffer<kMaxEntries, kSectors> kvs_;
+  KvsSessionCache cache_;
+};
+
+TEST_F(KvsSessionCacheTest, LoadMissingSession) {
+  std::array<std::byte, 16> buffer;
+  EXPECT_EQ(Status::NotFound(),
+            cache_.Load("www.example.com", buffer).status());
+}
+
+TEST_F(KvsSessionCacheTest, StoreAndLoad) {
+  ASSERT_EQ(OkStatus(), cache_.Store("www.example.com", kSession));
+  ASSERT_EQ(OkStatus(), cache_.Store("api.example.com", kOtherSession));
+
+  std::array<std::byte, 16> buffer;
+  StatusWithSize result = cache_.Load("www.example.com", buffer);
+  ASSERT_EQ(OkStatus(), result.status());
+  ASSERT_EQ(kSession.size(), result.size());
+  EXPECT_EQ(0, std::memcmp(buffer.data(), kSession.data(), kSession.size()));
+
+  result = cache_.Load("api.example.com", buffer);
+  ASSERT_EQ(OkStatus(), result.status());
+  ASSERT_EQ(kOtherSession.size(), result.size());
+  EXPECT_EQ(0,
+            std::memcmp(
+                buffer.data(), kOtherSession.data(), kOtherSession.size()));
+}
+
+TEST_F(KvsSessionCacheTest, StoreReplacesSession) {
+  ASSERT_EQ(OkStatus(), cache_.Store("www.example.com", kSession));
+  ASSERT_EQ(OkStatus(), cache_.Store("www.example.com", kOtherSession));
+
+  std::array<std::byte, 16> buffer;
+  StatusWithSize result = cache_.Load("www.example.com", buffer);
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(kOtherSession.size(), result.size());
+}
+
+TEST_F(KvsSessionCacheTest, LoadIntoSmallBuffer) {
+  ASSERT_EQ(OkStatus(), cache_.Store("www.example.com", kSession));
+  std::array<std::byte, 2> buffer;
+  EXPECT_EQ(Status::ResourceExhausted(),
+            cache_.Load("www.example.com", buffer).status());
+}
+
+TEST_F(KvsSessionCacheTest, Erase) {
+  ASSERT_EQ(OkStatus(), cache_.Store("www.example.com", kSession));
+  ASSERT_EQ(OkStatus(), cache_.Erase("www.example.com"));
+
+  std::array<std::byte, 16> buffer;
+  EXPECT_EQ(Status::NotFound(),
+            cache_.Load("www.example.com", buffer).status());
+  EXPECT_EQ(OkStatus(), cache_.Erase("www.example.com"));
+}
+
+TEST_F(KvsSessionCacheTest, KeysUsePrefix) {
+  ASSERT_EQ(OkStatus(), cache_.Store("www.example.com", kSession));
+  EXPECT_EQ(OkStatus(), kvs_.ValueSize("tls/www.example.com").status());
+
+  KvsSessionCache other_cache(kvs_, "other/");
+  std::array<std::byte, 16> buffer;
+  EXPECT_EQ(Status::NotFound(),
+            other_cache.Load("www.example.com", buffer).status());
+}
+
+TEST_F(KvsSessionCacheTest, ServerNameTooLong) {
+  constexpr std::string_view kLongName =
+      "a-very-long-server-name-that-does-not-fit-in-a-kvs-key.example.com";
+  std::array<std::byte, 16> buffer;
+  EXPECT_EQ(Status::InvalidArgument(), cache_.Store(kLongName, kSession));
+  EXPECT_EQ(Status::InvalidArgument(), cache_.Load(kLongName, buffer).status());
+  EXPECT_EQ(Status::InvalidArgument(), cache_.Erase(kLongName));
+  EXPECT_EQ(Status::InvalidArgument(), cache_.Store("", kSession));
+}
+
+}  // namespace
+}  // namespace pw::tls_client
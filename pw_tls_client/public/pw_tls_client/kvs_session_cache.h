@@ -0,0 +1,57 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <string_view>
+
+#include "pw_kvs/key_value_store.h"
+#include "pw_tls_client/session_cache.h"
+
+namespace pw::tls_client {
+
+// A SessionCache that saves session state in a KVS, so that sessions can be
+// resumed after a reboot. Each server's state is saved under the key
+// |key_prefix| followed by the server name. The KVS must be initialized
+// before the cache is used, and must have room for values as large as the
+// backend's serialized sessions.
+class KvsSessionCache final : public SessionCache {
+ public:
+  static constexpr std::string_view kDefaultKeyPrefix = "tls/";
+
+  // The longest key, including the prefix, that a KVS accepts.
+  static constexpr size_t kMaxKeyLength = 63;
+
+  constexpr KvsSessionCache(kvs::KeyValueStore& kvs,
+                            std::string_view key_prefix = kDefaultKeyPrefix)
+      : kvs_(kvs), key_prefix_(key_prefix) {}
+
+  // Returns INVALID_ARGUMENT if the key for |server_name| is too long.
+  StatusWithSize Load(std::string_view server_name, ByteSpan dest) override;
+  Status Store(std::string_view server_name, ConstByteSpan session) override;
+  Status Erase(std::string_view server_name) override;
+
+ private:
+  using KeyBuffer = char[kMaxKeyLength];
+
+  // Writes the key for |server_name| to |buffer| and returns it, or returns
+  // an empty key if it does not fit.
+  std::string_view MakeKey(std::string_view server_name,
+                           KeyBuffer& buffer) const;
+
+  kvs::KeyValueStore& kvs_;
+  const std::string_view key_prefix_;
+};
+
+}  // namespace pw::tls_client
@@ -20,6 +20,7 @@
 #include "pw_assert/check.h"
 #include "pw_stream/stream.h"
 #include "pw_string/util.h"
+#include "pw_tls_client/session_cache.h"
 
 namespace pw::tls_client {
 
@@ -47,13 +48,26 @@ class SessionOptions {
     return *this;
   }
 
+  // Sets a cache for TLS session state. If set, Open() tries to resume the
+  // session saved for the server name, which skips the certificate exchange
+  // and key agreement of a full handshake, and saves the session state after
+  // each successful handshake. Callers should guarantee that the cache object
+  // outlives the Session instance to be built.
+  constexpr SessionOptions& set_session_cache(SessionCache& session_cache) {
+    session_cache_ = &session_cache;
+    return *this;
+  }
+
   constexpr pw::stream::ReaderWriter* transport() const { return transport_; }
 
   constexpr std::string_view server_name() const { return server_name_; }
 
+  constexpr SessionCache* session_cache() const { return session_cache_; }
+
  private:
   std::string_view server_name_;
   pw::stream::ReaderWriter* transport_ = nullptr;
+  SessionCache* session_cache_ = nullptr;
 
   // TODO(zyecheng): Expand the list as necessary to cover aspects such as
   // certificate verification/revocation check policies.
@@ -0,0 +1,52 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw::tls_client {
+
+// SessionCache is an interface for saving TLS session state, such as session
+// tickets, so that a later connection to the same server can resume the
+// session with an abbreviated handshake instead of a full one. Implementations
+// may keep the state in RAM, or in persistent storage such as a KVS so that
+// sessions survive reboots.
+//
+// The saved state includes the session's master secret. It should only be
+// stored where the device's private keys could be stored.
+class SessionCache {
+ public:
+  virtual ~SessionCache() = default;
+
+  // Loads the session state saved for |server_name| into |dest|. Returns the
+  // number of bytes loaded, NOT_FOUND if no state is saved for the server, or
+  // RESOURCE_EXHAUSTED if |dest| is too small to hold the state.
+  virtual StatusWithSize Load(std::string_view server_name,
+                              ByteSpan dest) = 0;
+
+  // Saves |session| for |server_name|, replacing any state saved for it.
+  virtual Status Store(std::string_view server_name,
+                       ConstByteSpan session) = 0;
+
+  // Discards the session state saved for |server_name|, e.g. because it could
+  // not be used. Returns OK if no state is saved for the server.
+  virtual Status Erase(std::string_view server_name) = 0;
+};
+
+}  // namespace pw::tls_client
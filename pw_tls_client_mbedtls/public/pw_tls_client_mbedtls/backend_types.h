@@ -24,15 +24,25 @@ PW_MODIFY_DIAGNOSTIC(ignored, "-Wswitch-enum");
 #include "mbedtls/ssl.h"
 PW_MODIFY_DIAGNOSTICS_POP();
 
+#include "pw_bytes/span.h"
 #include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
 #include "pw_tls_client/options.h"
 
 namespace pw::tls_client::backend {
 class SessionImplementation {
  public:
+  // The largest serialized session that is saved to or loaded from a
+  // SessionCache.
+  static constexpr size_t kMaxSerializedSessionSize = 1024;
+
   SessionImplementation(SessionOptions options);
   ~SessionImplementation();
   Status Setup();
+  Status Open();
+  Status Close();
+  StatusWithSize Read(ByteSpan dest);
+  Status Write(ConstByteSpan data);
   void SetTlsStatus(TLSStatus status) { tls_status_ = status; }
   TLSStatus GetTlsStatus() { return tls_status_; }
 
@@ -56,6 +66,14 @@ class SessionImplementation {
 
   TLSStatus tls_status_ = TLSStatus::kOk;
 
+  bool is_open_ = false;
+
+  // Resumes the session saved in the session cache, if any.
+  void LoadCachedSession();
+
+  // Saves the current session to the session cache, if any.
+  void StoreSession();
+
   static int MbedTlsWrite(void* ctx, const uint8_t* buf, size_t len);
   static int MbedTlsRead(void* ctx, unsigned char* buf, size_t len);
   static int MbedTlsEntropySource(void* ctx,
@@ -12,6 +12,8 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <string_view>
+
 #include "pw_assert/check.h"
 #include "pw_log/log.h"
 #include "pw_tls_client/entropy.h"
@@ -84,6 +86,9 @@ SessionImplementation::SessionImplementation(SessionOptions options)
 }
 
 SessionImplementation::~SessionImplementation() {
+  if (is_open_) {
+    PW_CHECK_OK(Close());
+  }
   mbedtls_ssl_free(&ssl_ctx_);
   mbedtls_ssl_config_free(&ssl_config_);
   mbedtls_ctr_drbg_free(&drbg_ctx_);
@@ -144,6 +149,13 @@ Status SessionImplementation::Setup() {
   // The API does not fail.
   mbedtls_ssl_conf_authmode(&ssl_config_, MBEDTLS_SSL_VERIFY_REQUIRED);
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+  // Ask servers for session tickets, so that sessions can be resumed without
+  // the servers keeping any state. The API does not fail.
+  mbedtls_ssl_conf_session_tickets(&ssl_config_,
+                                   MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif  // MBEDTLS_SSL_SESSION_TICKETS
+
   // TODO: b/235289501 - Add logic for loading trust anchors.
 
   // Load configuration to SSL.
@@ -165,6 +177,153 @@ Status SessionImplementation::Setup() {
   return OkStatus();
 }
 
+void SessionImplementation::LoadCachedSession() {
+  SessionCache* cache = session_options_.session_cache();
+  if (cache == nullptr) {
+    return;
+  }
+
+  const std::string_view server_name = session_options_.server_name();
+  unsigned char buffer[kMaxSerializedSessionSize];
+  StatusWithSize loaded =
+      cache->Load(server_name, as_writable_bytes(span(buffer)));
+  if (!loaded.ok()) {
+    // Nothing usable is saved. Perform a full handshake.
+    return;
+  }
+
+  mbedtls_ssl_session session;
+  mbedtls_ssl_session_init(&session);
+  int ret = mbedtls_ssl_session_load(&session, buffer, loaded.size());
+  if (ret == 0) {
+    ret = mbedtls_ssl_set_session(&ssl_ctx_, &session);
+  }
+  mbedtls_ssl_session_free(&session);
+
+  if (ret) {
+    // The saved session is corrupt or from an incompatible configuration.
+    // Discard it, and perform a full handshake.
+    PW_LOG_DEBUG("Failed to load cached session");
+    cache->Erase(server_name).IgnoreError();
+  }
+}
+
+void SessionImplementation::StoreSession() {
+  SessionCache* cache = session_options_.session_cache();
+  if (cache == nullptr) {
+    return;
+  }
+
+  mbedtls_ssl_session session;
+  mbedtls_ssl_session_init(&session);
+  unsigned char buffer[kMaxSerializedSessionSize];
+  size_t size = 0;
+  int ret = mbedtls_ssl_get_session(&ssl_ctx_, &session);
+  if (ret == 0) {
+    ret = mbedtls_ssl_session_save(&session, buffer, sizeof(buffer), &size);
+  }
+  mbedtls_ssl_session_free(&session);
+
+  if (ret) {
+    PW_LOG_DEBUG("Failed to save session");
+    return;
+  }
+
+  // Failing to cache the session only costs a full handshake next time.
+  Status status = cache->Store(session_options_.server_name(),
+                               as_bytes(span(buffer, size)));
+  if (!status.ok()) {
+    PW_LOG_DEBUG("Failed to store session in the cache");
+  }
+}
+
+Status SessionImplementation::Open() {
+  if (is_open_) {
+    return Status::FailedPrecondition();
+  }
+
+  LoadCachedSession();
+
+  int ret;
+  do {
+    ret = mbedtls_ssl_handshake(&ssl_ctx_);
+  } while (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+  if (ret) {
+    if (tls_status_ == TLSStatus::kOk) {
+      tls_status_ = TLSStatus::kUnknownError;
+    }
+    return Status::Internal();
+  }
+
+  is_open_ = true;
+  StoreSession();
+  return OkStatus();
+}
+
+Status SessionImplementation::Close() {
+  if (!is_open_) {
+    return Status::FailedPrecondition();
+  }
+  is_open_ = false;
+
+  int ret;
+  do {
+    ret = mbedtls_ssl_close_notify(&ssl_ctx_);
+  } while (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+  if (ret) {
+    tls_status_ = TLSStatus::kUnknownError;
+    return Status::Internal();
+  }
+  return OkStatus();
+}
+
+StatusWithSize SessionImplementation::Read(ByteSpan dest) {
+  if (!is_open_) {
+    return StatusWithSize::FailedPrecondition();
+  }
+
+  // Records are decrypted directly into the caller's buffer, without an
+  // intermediate copy.
+  int ret = mbedtls_ssl_read(
+      &ssl_ctx_, reinterpret_cast<unsigned char*>(dest.data()), dest.size());
+  if (ret > 0) {
+    return StatusWithSize(static_cast<size_t>(ret));
+  }
+  if (ret == 0 || ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
+    return StatusWithSize::OutOfRange();
+  }
+  if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+    return StatusWithSize::ResourceExhausted();
+  }
+  tls_status_ = TLSStatus::kUnknownError;
+  return StatusWithSize::Internal();
+}
+
+Status SessionImplementation::Write(ConstByteSpan data) {
+  if (!is_open_) {
+    return Status::FailedPrecondition();
+  }
+
+  // mbedtls_ssl_write() writes at most one record at a time.
+  const auto* next = reinterpret_cast<const unsigned char*>(data.data());
+  size_t remaining = data.size();
+  while (remaining > 0) {
+    int ret = mbedtls_ssl_write(&ssl_ctx_, next, remaining);
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+      continue;
+    }
+    if (ret < 0) {
+      tls_status_ = TLSStatus::kUnknownError;
+      return Status::Internal();
+    }
+    next += ret;
+    remaining -= static_cast<size_t>(ret);
+  }
+  return OkStatus();
+}
+
 }  // namespace backend
 
 Session::Session(const SessionOptions& options) : session_impl_(options) {}
@@ -196,24 +355,16 @@ Result<Session*> Session::Create(const SessionOptions& options) {
   return sess;
 }
 
-Status Session::Open() {
-  // TODO: b/235289501 - To implement
-  return Status::Unimplemented();
-}
+Status Session::Open() { return session_impl_.Open(); }
 
-Status Session::Close() {
-  // TODO: b/235289501 - To implement
-  return Status::Unimplemented();
-}
+Status Session::Close() { return session_impl_.Close(); }
 
-StatusWithSize Session::DoRead(ByteSpan) {
-  // TODO: b/235289501 - To implement
-  return StatusWithSize(Status::Unimplemented(), 0);
+StatusWithSize Session::DoRead(ByteSpan dest) {
+  return session_impl_.Read(dest);
 }
 
-Status Session::DoWrite(ConstByteSpan) {
-  // TODO: b/235289501 - To implement
-  return Status::Unimplemented();
+Status Session::DoWrite(ConstByteSpan data) {
+  return session_impl_.Write(data);
 }
 
 TLSStatus Session::GetLastTLSStatus() { return session_impl_.GetTlsStatus(); }
@@ -12,11 +12,45 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <cstring>
+#include <optional>
+
+#include "pw_bytes/array.h"
 #include "pw_stream/null_stream.h"
 #include "pw_tls_client/session.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::tls_client {
+namespace {
+
+// A SessionCache that holds one session in memory.
+class FakeSessionCache final : public SessionCache {
+ public:
+  StatusWithSize Load(std::string_view, ByteSpan dest) override {
+    if (!session_.has_value()) {
+      return StatusWithSize::NotFound();
+    }
+    std::memcpy(dest.data(), session_->data(), session_->size());
+    return StatusWithSize(session_->size());
+  }
+
+  Status Store(std::string_view, ConstByteSpan) override {
+    return Status::Unimplemented();
+  }
+
+  Status Erase(std::string_view) override {
+    session_.reset();
+    return OkStatus();
+  }
+
+  void set_session(ConstByteSpan session) { session_ = session; }
+  bool has_session() const { return session_.has_value(); }
+
+ private:
+  std::optional<ConstByteSpan> session_;
+};
+
+}  // namespace
 
 TEST(TLSClientMbedTLS, CreateSucceed) {
   auto options = SessionOptions().set_transport(stream::NullStream::Instance());
@@ -38,4 +72,36 @@ TEST(TLSClientMbedTLS, EntropySourceFail) {
   ASSERT_NE(res.status(), OkStatus());
 }
 
+TEST(TLSClientMbedTLS, ReadWriteCloseFailBeforeOpen) {
+  auto options = SessionOptions().set_transport(stream::NullStream::Instance());
+  auto res = Session::Create(options);
+  ASSERT_EQ(res.status(), OkStatus());
+  Session& session = *res.value();
+
+  std::byte buffer[4] = {};
+  EXPECT_EQ(session.Read(buffer).status(), Status::FailedPrecondition());
+  EXPECT_EQ(session.Write(buffer), Status::FailedPrecondition());
+  EXPECT_EQ(session.Close(), Status::FailedPrecondition());
+  delete res.value();
+}
+
+TEST(TLSClientMbedTLS, CorruptCachedSessionIsErased) {
+  constexpr auto kCorruptSession = bytes::Array<0xde, 0xad, 0xbe, 0xef>();
+  FakeSessionCache cache;
+  cache.set_session(kCorruptSession);
+
+  auto options = SessionOptions()
+                     .set_server_name("www.example.com")
+                     .set_transport(stream::NullStream::Instance())
+                     .set_session_cache(cache);
+  auto res = Session::Create(options);
+  ASSERT_EQ(res.status(), OkStatus());
+
+  // The handshake fails, since nothing answers on the transport, but the
+  // corrupt session has already been discarded.
+  EXPECT_NE(res.value()->Open(), OkStatus());
+  EXPECT_FALSE(cache.has_session());
+  delete res.value();
+}
+
 }  // namespace pw::tls_client
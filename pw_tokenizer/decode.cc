@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cmath>
 #include <cstring>
 
 #include "pw_varint/varint.h"
@@ -90,6 +91,33 @@ std::string ErrorMessage(ArgStatus status,
   return result;
 }
 
+// Converts an IEEE 754 half-precision float to a float.
+float HalfToFloat(uint16_t half) {
+  const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1Fu;
+  const uint32_t mantissa = half & 0x3FFu;
+
+  if (exponent == 0u) {  // Zero or subnormal
+    const float value = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign != 0u ? -value : value;
+  }
+
+  uint32_t bits;
+  if (exponent == 0x1Fu) {  // Infinity or NaN
+    bits = sign | 0x7F800000u | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// V1 strings that share a prefix with the previous string argument start with
+// this byte, followed by the length of the prefix.
+constexpr uint8_t kSharedPrefixMarker = 0x7F;
+
 }  // namespace
 
 DecodedArg::DecodedArg(ArgStatus error,
@@ -171,20 +199,36 @@ StringSegment::ArgSize StringSegment::VarargSize(std::array<char, 2> length,
   return VarargSize<int>();
 }
 
-DecodedArg StringSegment::DecodeString(
-    const span<const uint8_t>& arguments) const {
+DecodedArg StringSegment::DecodeString(const span<const uint8_t>& arguments,
+                                       const ArgEncoding& encoding,
+                                       std::string& previous_string) const {
   if (arguments.empty()) {
     return DecodedArg(ArgStatus::kMissing, text_);
   }
 
+  // V1 strings may start with a prefix of the previous string argument.
+  size_t prefix_size = 0;
+  size_t header_size = 1;
+  if (encoding.version == ArgEncoding::kV1 &&
+      arguments[0] == kSharedPrefixMarker) {
+    if (arguments.size() < 3u || arguments[1] > previous_string.size()) {
+      return DecodedArg(ArgStatus::kDecodeError,
+                        text_,
+                        std::min(arguments.size(), size_t{3}));
+    }
+    prefix_size = arguments[1];
+    header_size = 3;
+  }
+
+  const uint8_t status_byte = arguments[header_size - 1];
   ArgStatus status =
-      (arguments[0] & 0x80u) == 0u ? ArgStatus::kOk : ArgStatus::kTruncated;
+      (status_byte & 0x80u) == 0u ? ArgStatus::kOk : ArgStatus::kTruncated;
 
-  const uint_fast8_t size = arguments[0] & 0x7Fu;
+  const uint_fast8_t size = status_byte & 0x7Fu;
 
-  if (arguments.size() - 1 < size) {
+  if (arguments.size() - header_size < size) {
     status.Update(ArgStatus::kDecodeError);
-    span<const uint8_t> arg_val = arguments.subspan(1);
+    span<const uint8_t> arg_val = arguments.subspan(header_size);
     return DecodedArg(
         status,
         text_,
@@ -192,13 +236,17 @@ DecodedArg StringSegment::DecodeString(
         {reinterpret_cast<const char*>(arg_val.data()), arg_val.size()});
   }
 
-  std::string value(reinterpret_cast<const char*>(arguments.data() + 1), size);
+  std::string value = previous_string.substr(0, prefix_size);
+  value.append(reinterpret_cast<const char*>(arguments.data() + header_size),
+               size);
+  previous_string = value;
 
   if (status.HasError(ArgStatus::kTruncated)) {
     value.append("[...]");
   }
 
-  return DecodedArg::FromValue(text_.c_str(), value.c_str(), 1 + size, status);
+  return DecodedArg::FromValue(
+      text_.c_str(), value.c_str(), header_size + size, status);
 }
 
 DecodedArg StringSegment::DecodeInteger(
@@ -230,7 +278,36 @@ DecodedArg StringSegment::DecodeInteger(
 }
 
 DecodedArg StringSegment::DecodeFloatingPoint(
-    const span<const uint8_t>& arguments) const {
+    const span<const uint8_t>& arguments, const ArgEncoding& encoding) const {
+  if (encoding.floats() == ArgEncoding::kFloat16) {
+    if (arguments.size() < sizeof(uint16_t)) {
+      return DecodedArg(ArgStatus::kMissing, text_);
+    }
+    const uint16_t half =
+        static_cast<uint16_t>(arguments[0] | (arguments[1] << 8));
+    return DecodedArg::FromValue(
+        text_.c_str(), HalfToFloat(half), sizeof(uint16_t));
+  }
+
+  if (encoding.floats() == ArgEncoding::kFixedPoint) {
+    if (arguments.empty()) {
+      return DecodedArg(ArgStatus::kMissing, text_);
+    }
+    int64_t value;
+    const size_t bytes = varint::Decode(as_bytes(arguments), &value);
+    if (bytes == 0u) {
+      return DecodedArg(ArgStatus::kDecodeError,
+                        text_,
+                        std::min(varint::kMaxVarint64SizeBytes,
+                                 static_cast<size_t>(arguments.size())));
+    }
+    return DecodedArg::FromValue(
+        text_.c_str(),
+        std::ldexp(static_cast<double>(value),
+                   -static_cast<int>(encoding.fixed_point_fractional_bits)),
+        bytes);
+  }
+
   static_assert(sizeof(float) == 4u);
   if (arguments.size() < sizeof(float)) {
     return DecodedArg(ArgStatus::kMissing, text_);
@@ -241,20 +318,22 @@ DecodedArg StringSegment::DecodeFloatingPoint(
   return DecodedArg::FromValue(text_.c_str(), value, sizeof(value));
 }
 
-DecodedArg StringSegment::Decode(const span<const uint8_t>& arguments) const {
+DecodedArg StringSegment::Decode(const span<const uint8_t>& arguments,
+                                 const ArgEncoding& encoding,
+                                 std::string& previous_string) const {
   switch (type_) {
     case kLiteral:
       return DecodedArg(text_);
     case kPercent:
       return DecodedArg("%");
     case kString:
-      return DecodeString(arguments);
+      return DecodeString(arguments, encoding, previous_string);
     case kSignedInt:
     case kUnsigned32:
     case kUnsigned64:
       return DecodeInteger(arguments);
     case kFloatingPoint:
-      return DecodeFloatingPoint(arguments);
+      return DecodeFloatingPoint(arguments, encoding);
   }
 
   return DecodedArg(ArgStatus::kDecodeError, text_);
@@ -286,14 +365,10 @@ std::string DecodedFormatString::value() const {
   return output;
 }
 
-std::string DecodedFormatString::value_with_errors() const {
-  std::string output;
-
+void DecodedFormatString::AppendValueWithErrors(std::string& output) const {
   for (const DecodedArg& arg : segments_) {
     output.append(arg.value());
   }
-
-  return output;
 }
 
 size_t DecodedFormatString::argument_count() const {
@@ -336,15 +411,17 @@ FormatString::FormatString(const char* format) {
   }
 }
 
-DecodedFormatString FormatString::Format(span<const uint8_t> arguments) const {
+DecodedFormatString FormatString::Format(span<const uint8_t> arguments,
+                                         const ArgEncoding& encoding) const {
   std::vector<DecodedArg> results;
+  std::string previous_string;
   bool skip = false;
 
   for (const auto& segment : segments_) {
     if (skip) {
       results.push_back(segment.Skip());
     } else {
-      results.push_back(segment.Decode(arguments));
+      results.push_back(segment.Decode(arguments, encoding, previous_string));
       arguments = arguments.subspan(results.back().raw_size_bytes());
 
       // If an error occurred, skip decoding the remaining arguments.
@@ -136,6 +136,56 @@ TEST(TokenizedStringDecode, MissingArguments_IsDecodeError) {
   EXPECT_EQ(result.decoding_errors(), 2u);
 }
 
+constexpr ArgEncoding kV1Float16{ArgEncoding::kV1, ArgEncoding::kFloat16, 8};
+constexpr ArgEncoding kV1FixedPoint{
+    ArgEncoding::kV1, ArgEncoding::kFixedPoint, 8};
+
+TEST(TokenizedStringDecode, V1_Float16) {
+  if (!kSupportsFloatPrintf) {
+    return;
+  }
+  const FormatString format("%.2f %.2f %g");
+  auto result = format.Format("\x00\x3E\x00\xC0\x00\x7C"sv, kV1Float16);
+  EXPECT_EQ(result.value(), "1.50 -2.00 inf");
+  EXPECT_TRUE(result.ok());
+}
+
+TEST(TokenizedStringDecode, V1_Float16_Missing) {
+  const FormatString format("%f");
+  auto result = format.Format("\x00"sv, kV1Float16);
+  EXPECT_EQ(result.value_with_errors(), ERR("%f MISSING"));
+}
+
+TEST(TokenizedStringDecode, V1_FixedPoint) {
+  if (!kSupportsFloatPrintf) {
+    return;
+  }
+  const FormatString format("%.3f %.3f");
+  auto result = format.Format("\x80\x06\x7F"sv, kV1FixedPoint);
+  EXPECT_EQ(result.value(), "1.500 -0.250");
+  EXPECT_TRUE(result.ok());
+}
+
+TEST(TokenizedStringDecode, V1_StringSharesPrefixWithPreviousString) {
+  const FormatString format("%s, %s, %s");
+  auto result = format.Format(
+      "\x0bsensor/temp\x7f\x07\x08humidity\x7f\x06\2ed"sv, kV1Float16);
+  EXPECT_EQ(result.value(), "sensor/temp, sensor/humidity, sensored");
+  EXPECT_TRUE(result.ok());
+}
+
+TEST(TokenizedStringDecode, V1_SharedPrefixLongerThanPreviousString_IsError) {
+  const FormatString format("%s %s");
+  auto result = format.Format("\2ab\x7f\3\1c"sv, kV1Float16);
+  EXPECT_EQ(result.value_with_errors(), "ab " ERR("%s ERROR"));
+  EXPECT_EQ(result.decoding_errors(), 1u);
+}
+
+TEST(TokenizedStringDecode, V0_SharedPrefixMarkerIsALength) {
+  auto result = kOneArg.Format("\x7f\x07\x08humidity"sv);
+  EXPECT_EQ(result.decoding_errors(), 1u);
+}
+
 TEST(VarintDecode, VarintDecodeTestCases) {
   const auto& test_data = test::varint_decoding::kTestData;
   static_assert(sizeof(test_data) / sizeof(*test_data) > 100u);
@@ -27,69 +27,6 @@
 namespace pw::tokenizer {
 namespace {
 
-class NestedMessageDetokenizer {
- public:
-  NestedMessageDetokenizer(const Detokenizer& detokenizer)
-      : detokenizer_(detokenizer) {}
-
-  void Detokenize(std::string_view chunk) {
-    for (char next_char : chunk) {
-      Detokenize(next_char);
-    }
-  }
-
-  void Detokenize(char next_char) {
-    switch (state_) {
-      case kNonMessage:
-        if (next_char == PW_TOKENIZER_NESTED_PREFIX) {
-          message_buffer_.push_back(next_char);
-          state_ = kMessage;
-        } else {
-          output_.push_back(next_char);
-        }
-        break;
-      case kMessage:
-        if (base64::IsValidChar(next_char)) {
-          message_buffer_.push_back(next_char);
-        } else {
-          HandleEndOfMessage();
-          if (next_char == PW_TOKENIZER_NESTED_PREFIX) {
-            message_buffer_.push_back(next_char);
-          } else {
-            output_.push_back(next_char);
-            state_ = kNonMessage;
-          }
-        }
-        break;
-    }
-  }
-
-  std::string Flush() {
-    if (state_ == kMessage) {
-      HandleEndOfMessage();
-      state_ = kNonMessage;
-    }
-    return std::move(output_);
-  }
-
- private:
-  void HandleEndOfMessage() {
-    if (auto result = detokenizer_.DetokenizeBase64Message(message_buffer_);
-        result.ok()) {
-      output_ += result.BestString();
-    } else {
-      output_ += message_buffer_;  // Keep the original if it doesn't decode.
-    }
-    message_buffer_.clear();
-  }
-
-  const Detokenizer& detokenizer_;
-  std::string output_;
-  std::string message_buffer_;
-
-  enum { kNonMessage, kMessage } state_ = kNonMessage;
-};
-
 std::string UnknownTokenMessage(uint32_t value) {
   std::string output(PW_TOKENIZER_ARG_DECODING_ERROR_PREFIX "unknown token ");
 
@@ -139,12 +76,14 @@ bool IsBetterResult(const DecodingResult& lhs, const DecodingResult& rhs) {
 DetokenizedString::DetokenizedString(
     uint32_t token,
     const span<const TokenizedStringEntry>& entries,
-    const span<const uint8_t>& arguments)
+    const span<const uint8_t>& arguments,
+    const ArgEncoding& encoding)
     : token_(token), has_token_(true) {
   std::vector<DecodingResult> results;
 
   for (const auto& [format, date_removed] : entries) {
-    results.push_back(DecodingResult{format.Format(arguments), date_removed});
+    results.push_back(
+        DecodingResult{format.Format(arguments, encoding), date_removed});
   }
 
   std::sort(results.begin(), results.end(), IsBetterResult);
@@ -166,14 +105,16 @@ std::string DetokenizedString::BestStringWithErrors() const {
   return matches_[0].value_with_errors();
 }
 
-Detokenizer::Detokenizer(const TokenDatabase& database) {
+Detokenizer::Detokenizer(const TokenDatabase& database,
+                         const ArgEncoding& arg_encoding)
+    : arg_encoding_(arg_encoding) {
   for (const auto& entry : database) {
     database_[entry.token].emplace_back(entry.string, entry.date_removed);
   }
 }
 
 Result<Detokenizer> Detokenizer::FromElfSection(
-    span<const uint8_t> elf_section) {
+    span<const uint8_t> elf_section, const ArgEncoding& arg_encoding) {
   size_t index = 0;
   std::unordered_map<uint32_t, std::vector<TokenizedStringEntry>> database;
 
@@ -199,7 +140,25 @@ Result<Detokenizer> Detokenizer::FromElfSection(
                                           TokenDatabase::kDateRemovedNever);
     }
   }
-  return Detokenizer(std::move(database));
+  return Detokenizer(std::move(database), arg_encoding);
+}
+
+span<const TokenizedStringEntry> Detokenizer::FindEntries(
+    uint32_t token) const {
+  if (!indexed_database_.ok()) {
+    const auto result = database_.find(token);
+    return result == database_.end() ? span<const TokenizedStringEntry>()
+                                     : span(result->second);
+  }
+
+  std::lock_guard lock(indexed_cache_->mutex);
+  auto [result, inserted] = indexed_cache_->entries.try_emplace(token);
+  if (inserted) {
+    for (const auto& entry : indexed_database_.Find(token)) {
+      result->second.emplace_back(entry.string, entry.date_removed);
+    }
+  }
+  return result->second;
 }
 
 DetokenizedString Detokenizer::Detokenize(
@@ -212,14 +171,58 @@ DetokenizedString Detokenizer::Detokenize(
   uint32_t token = bytes::ReadInOrder<uint32_t>(
       endian::little, encoded.data(), encoded.size());
 
-  const auto result = database_.find(token);
-
   return DetokenizedString(
       token,
-      result == database_.end() ? span<TokenizedStringEntry>()
-                                : span(result->second),
+      FindEntries(token),
       encoded.size() < sizeof(token) ? span<const uint8_t>()
-                                     : encoded.subspan(sizeof(token)));
+                                     : encoded.subspan(sizeof(token)),
+      arg_encoding_);
+}
+
+void Detokenizer::DetokenizeBatch(
+    span<const span<const uint8_t>> messages,
+    std::string& output,
+    std::vector<std::string_view>& results) const {
+  output.clear();
+  results.clear();
+
+  // Record where each result ends, since output may be reallocated as it
+  // grows.
+  std::vector<size_t> ends;
+  ends.reserve(messages.size());
+
+  for (const span<const uint8_t>& encoded : messages) {
+    if (encoded.empty()) {
+      output.append(PW_TOKENIZER_ARG_DECODING_ERROR("missing token"));
+      ends.push_back(output.size());
+      continue;
+    }
+
+    const uint32_t token = bytes::ReadInOrder<uint32_t>(
+        endian::little, encoded.data(), encoded.size());
+    const span<const uint8_t> arguments = encoded.size() < sizeof(token)
+                                              ? span<const uint8_t>()
+                                              : encoded.subspan(sizeof(token));
+    const span<const TokenizedStringEntry> entries = FindEntries(token);
+
+    if (entries.empty()) {
+      output.append(UnknownTokenMessage(token));
+    } else if (entries.size() == 1u) {
+      // Without collisions, there is no need to rank the results.
+      entries[0].first.Format(arguments, arg_encoding_)
+          .AppendValueWithErrors(output);
+    } else {
+      output.append(DetokenizedString(token, entries, arguments, arg_encoding_)
+                        .BestStringWithErrors());
+    }
+    ends.push_back(output.size());
+  }
+
+  size_t start = 0;
+  for (size_t end : ends) {
+    results.emplace_back(std::string_view(output).substr(start, end - start));
+    start = end;
+  }
 }
 
 DetokenizedString Detokenizer::DetokenizeBase64Message(
@@ -230,9 +233,76 @@ DetokenizedString Detokenizer::DetokenizeBase64Message(
 }
 
 std::string Detokenizer::DetokenizeBase64(std::string_view text) const {
-  NestedMessageDetokenizer nested_detokenizer(*this);
+  std::string output;
+  NestedMessageDetokenizer nested_detokenizer(
+      *this, [&output](std::string_view result) { output.append(result); });
   nested_detokenizer.Detokenize(text);
-  return nested_detokenizer.Flush();
+  nested_detokenizer.Flush();
+  return output;
+}
+
+void NestedMessageDetokenizer::Detokenize(std::string_view chunk) {
+  // Plain text is written in runs rather than character by character.
+  size_t text_start = 0;
+
+  for (size_t i = 0; i < chunk.size(); ++i) {
+    const char next_char = chunk[i];
+    switch (state_) {
+      case kNonMessage:
+        if (next_char == PW_TOKENIZER_NESTED_PREFIX) {
+          Write(chunk.substr(text_start, i - text_start));
+          message_buffer_.push_back(next_char);
+          state_ = kMessage;
+        }
+        break;
+      case kMessage:
+        if (base64::IsValidChar(next_char)) {
+          message_buffer_.push_back(next_char);
+        } else {
+          HandleEndOfMessage();
+          if (next_char == PW_TOKENIZER_NESTED_PREFIX) {
+            message_buffer_.push_back(next_char);
+          } else {
+            text_start = i;
+            state_ = kNonMessage;
+          }
+        }
+        break;
+    }
+  }
+
+  if (state_ == kNonMessage) {
+    Write(chunk.substr(text_start));
+  }
+}
+
+void NestedMessageDetokenizer::Flush() {
+  if (state_ == kMessage) {
+    HandleEndOfMessage();
+    state_ = kNonMessage;
+  }
+}
+
+void NestedMessageDetokenizer::HandleEndOfMessage() {
+  if (auto result = detokenizer_.DetokenizeBase64Message(message_buffer_);
+      result.ok()) {
+    std::string detokenized = result.BestString();
+    if (max_recursion_ > 0u &&
+        detokenized.find(PW_TOKENIZER_NESTED_PREFIX) != std::string::npos) {
+      std::string nested;
+      NestedMessageDetokenizer nested_detokenizer(
+          detokenizer_,
+          [&nested](std::string_view text) { nested.append(text); },
+          max_recursion_ - 1);
+      nested_detokenizer.Detokenize(detokenized);
+      nested_detokenizer.Flush();
+      detokenized = std::move(nested);
+    }
+    Write(detokenized);
+  } else {
+    Write(message_buffer_);  // Keep the original if it doesn't decode.
+  }
+  message_buffer_.clear();
 }
 
 }  // namespace pw::tokenizer
@@ -14,7 +14,9 @@
 
 #include "pw_tokenizer/detokenize.h"
 
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "pw_tokenizer/example_binary_with_tokenized_strings.h"
 #include "pw_unit_test/framework.h"
@@ -60,6 +62,84 @@ class Detokenize : public ::testing::Test {
   Detokenizer detok_;
 };
 
+// kBasicData as a v1 database.
+constexpr std::string_view kBasicDataV1 =
+    "TOKENS\1\0"
+    "\x04\x00\x00\x00"
+    "\0\0\0\0"
+    "\x01\x00\x00\x00----\x00\0\0\0"
+    "\x05\x00\x00\x00----\x04\0\0\0"
+    "\xFF\x00\x00\x00----\x08\0\0\0"
+    "\xFF\xEE\xEE\xDD----\x0C\0\0\0"
+    "One\0"
+    "TWO\0"
+    "333\0"
+    "FOUR\0"sv;
+
+TEST(DetokenizeIndexed, MatchesTokenDatabase) {
+  const Detokenizer indexed(IndexedTokenDatabase::Create(kBasicDataV1));
+  const Detokenizer hashed(TokenDatabase::Create<kBasicData>());
+  for (std::string_view data : {"\1\0\0\0"sv,
+                                "\5\0\0\0"sv,
+                                "\xff"sv,
+                                "\xff\xee\xee\xdd"sv,
+                                "\xee\xee\xee\xee"sv,
+                                ""sv}) {
+    EXPECT_EQ(indexed.Detokenize(data).BestString(),
+              hashed.Detokenize(data).BestString());
+    EXPECT_EQ(indexed.Detokenize(data).BestStringWithErrors(),
+              hashed.Detokenize(data).BestStringWithErrors());
+  }
+  EXPECT_EQ(indexed.Detokenize("\xff\xee\xee\xdd"sv).BestString(), "FOUR");
+}
+
+TEST(DetokenizeIndexed, CachesParsedEntries) {
+  Detokenizer detok(IndexedTokenDatabase::Create(kBasicDataV1));
+  EXPECT_EQ(detok.Detokenize("\1\0\0\0"sv).BestString(), "One");
+  EXPECT_EQ(detok.Detokenize("\1\0\0\0"sv).BestString(), "One");
+  EXPECT_EQ(detok.Detokenize("\xee\xee\xee\xee"sv).BestString(), "");
+  EXPECT_EQ(detok.Detokenize("\xee\xee\xee\xee"sv).BestString(), "");
+
+  // The cache moves with the Detokenizer.
+  const Detokenizer moved(std::move(detok));
+  EXPECT_EQ(moved.Detokenize("\1\0\0\0"sv).BestString(), "One");
+  EXPECT_EQ(moved.Detokenize("\5\0\0\0"sv).BestString(), "TWO");
+}
+
+TEST(DetokenizeIndexed, Batch) {
+  const Detokenizer indexed(IndexedTokenDatabase::Create(kBasicDataV1));
+  const Detokenizer hashed(TokenDatabase::Create<kBasicData>());
+
+  constexpr std::string_view kMessages[] = {"\1\0\0\0"sv,
+                                            "\5\0\0\0"sv,
+                                            "\1\0\0\0"sv,
+                                            "\xee\xee\xee\xee"sv,
+                                            ""sv};
+  std::vector<span<const uint8_t>> messages;
+  for (std::string_view message : kMessages) {
+    messages.emplace_back(reinterpret_cast<const uint8_t*>(message.data()),
+                          message.size());
+  }
+
+  std::string output;
+  std::vector<std::string_view> results;
+  for (const Detokenizer* detok : {&indexed, &hashed}) {
+    detok->DetokenizeBatch(messages, output, results);
+    ASSERT_EQ(results.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+      EXPECT_EQ(results[i],
+                hashed.Detokenize(kMessages[i]).BestStringWithErrors());
+    }
+  }
+  EXPECT_EQ(results[0], "One");
+  EXPECT_EQ(results[1], "TWO");
+
+  // Each batch replaces the previous results.
+  indexed.DetokenizeBatch(span(messages).first(1), output, results);
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(output, "One");
+}
+
 TEST_F(Detokenize, NoFormatting) {
   EXPECT_EQ(detok_.Detokenize("\1\0\0\0"sv).BestString(), "One");
   EXPECT_EQ(detok_.Detokenize("\5\0\0\0"sv).BestString(), "TWO");
@@ -159,6 +239,73 @@ TEST_F(Detokenize, Base64_NoArguments) {
   }
 }
 
+TEST_F(Detokenize, NestedMessageDetokenizer_WritesTextAsSoonAsPossible) {
+  std::string output;
+  NestedMessageDetokenizer nested(
+      detok_, [&output](std::string_view text) { output.append(text); });
+
+  nested.Detokenize("abc $AQA"sv);
+  EXPECT_EQ(output, "abc ");
+  nested.Detokenize("AAA"sv);
+  EXPECT_EQ(output, "abc ");
+  nested.Detokenize("== def"sv);
+  EXPECT_EQ(output, "abc One def");
+
+  for (char c : std::string_view(TWO THREE "!")) {
+    nested.Detokenize(c);
+  }
+  EXPECT_EQ(output, "abc One defTWO333!");
+
+  nested.Detokenize(FOUR);
+  EXPECT_EQ(output, "abc One defTWO333!");
+  nested.Flush();
+  EXPECT_EQ(output, "abc One defTWO333!FOUR");
+}
+
+TEST_F(Detokenize, NestedMessageDetokenizer_KeepsMessagesThatDontDecode) {
+  std::string output;
+  NestedMessageDetokenizer nested(
+      detok_, [&output](std::string_view text) { output.append(text); });
+  nested.Detokenize("$123456== $/+7u3Q="sv);
+  nested.Flush();
+  EXPECT_EQ(output, "$123456== $/+7u3Q=");
+}
+
+// Database with the following entries:
+// {
+//   0x00000001: "One",
+//   0x00000002: "Two contains " ONE,
+//   0x00000003: "Three contains $AgAAAA==", (Base64 for token 2)
+// }
+constexpr char kNestedData[] =
+    "TOKENS\0\0"
+    "\x03\x00\x00\x00"
+    "\0\0\0\0"
+    "\x01\x00\x00\x00----"
+    "\x02\x00\x00\x00----"
+    "\x03\x00\x00\x00----"
+    "One\0"
+    "Two contains " ONE "\0"
+    "Three contains $AgAAAA==\0";
+
+TEST(NestedMessageDetokenizer, MaxRecursion) {
+  const Detokenizer detok(TokenDatabase::Create<kNestedData>());
+  for (auto [max_recursion, expected] :
+       {std::pair(0u, "Three contains $AgAAAA=="),
+        std::pair(1u, "Three contains Two contains " ONE),
+        std::pair(2u, "Three contains Two contains One"),
+        std::pair(9u, "Three contains Two contains One")}) {
+    std::string output;
+    NestedMessageDetokenizer nested(
+        detok,
+        [&output](std::string_view text) { output.append(text); },
+        max_recursion);
+    nested.Detokenize("$AwAAAA=="sv);
+    nested.Flush();
+    EXPECT_EQ(output, expected);
+  }
+}
+
 constexpr char kDataWithArguments[] =
     "TOKENS\0\0"
     "\x09\x00\x00\x00"
@@ -240,6 +387,15 @@ TEST_F(DetokenizeWithArgs, DecodingError) {
             "Now there are " ERR("%d ERROR") " of " ERR("%s SKIPPED") "!");
 }
 
+TEST(DetokenizeWithArgEncoding, V1) {
+  const Detokenizer detok(
+      kWithArgs, ArgEncoding{ArgEncoding::kV1, ArgEncoding::kFloat16, 8});
+  EXPECT_EQ(detok.arg_encoding().version, ArgEncoding::kV1);
+  EXPECT_EQ(
+      detok.Detokenize("\x0A\x0B\x0C\x0D\4Luke\x7f\3\2ia"sv).BestString(),
+      "Use the Luke, Lukia.");
+}
+
 constexpr char kDataWithCollisions[] =
     "TOKENS\0\0"
     "\x0F\x00\x00\x00"
@@ -296,6 +452,25 @@ TEST_F(DetokenizeWithCollisions, Collision_AlwaysPreferSuccessfulDecode) {
   }
 }
 
+TEST_F(DetokenizeWithCollisions, Batch_MatchesDetokenize) {
+  constexpr std::string_view kMessages[] = {
+      "\0\0\0\0"sv, "\0\0\0\0\x01"sv, "\0\0\0\0\4Hey!\x04"sv};
+  std::vector<span<const uint8_t>> messages;
+  for (std::string_view message : kMessages) {
+    messages.emplace_back(reinterpret_cast<const uint8_t*>(message.data()),
+                          message.size());
+  }
+
+  std::string output;
+  std::vector<std::string_view> results;
+  detok_.DetokenizeBatch(messages, output, results);
+  ASSERT_EQ(results.size(), messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ(results[i],
+              detok_.Detokenize(kMessages[i]).BestStringWithErrors());
+  }
+}
+
 TEST_F(DetokenizeWithCollisions, Collision_PreferDecodingAllBytes) {
   for (auto [data, expected] :
        TestCases(Case{"\0\0\0\0\x80\x80\x80\x80\x00"sv, "Two args [...] 0"},
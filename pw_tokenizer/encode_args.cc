@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 #include "pw_preprocessor/compiler.h"
 #include "pw_varint/varint.h"
@@ -36,6 +37,16 @@ enum class ArgType : uint8_t {
   kString = PW_TOKENIZER_ARG_TYPE_STRING,
 };
 
+// The status byte that marks a V1 string argument that shares a prefix with
+// the previous string argument. It is followed by the length of the shared
+// prefix and the rest of the string, encoded as usual. 0x7F is never a V0
+// status byte, since strings are at most 126 bytes.
+constexpr std::byte kSharedPrefixMarker{0x7F};
+
+// The marker and prefix length take two bytes, so shorter prefixes don't save
+// any space.
+constexpr size_t kMinSharedPrefixLength = 3;
+
 size_t EncodeInt(int value, const span<std::byte>& output) {
   // Use the 64-bit function to avoid instantiating both 32-bit and 64-bit.
   return pw_tokenizer_EncodeInt64(value, output.data(), output.size());
@@ -53,7 +64,83 @@ size_t EncodeFloat(float value, const span<std::byte>& output) {
   return sizeof(value);
 }
 
-size_t EncodeString(const char* string, const span<std::byte>& output) {
+// Converts a float to an IEEE 754 half-precision float, rounding to nearest
+// even. Values that are too large become infinity.
+uint16_t FloatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  const uint32_t exponent = (bits >> 23) & 0xFFu;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+
+  if (exponent == 0xFFu) {  // Infinity or NaN
+    const uint32_t quiet_nan_bit = mantissa != 0u ? 0x200u : 0u;
+    return static_cast<uint16_t>(sign | 0x7C00u | quiet_nan_bit);
+  }
+
+  const int half_exponent = static_cast<int>(exponent) - 127 + 15;
+  if (half_exponent >= 0x1F) {
+    return static_cast<uint16_t>(sign | 0x7C00u);
+  }
+
+  uint32_t half;
+  uint32_t shift;
+  if (half_exponent > 0) {
+    half = (static_cast<uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+    shift = 13;
+  } else {  // Subnormal half, or too small to represent.
+    if (half_exponent < -10) {
+      return static_cast<uint16_t>(sign);
+    }
+    mantissa |= 0x800000u;  // Add the implicit leading 1.
+    shift = static_cast<uint32_t>(14 - half_exponent);
+    half = mantissa >> shift;
+  }
+
+  // Round to nearest even. A carry into the exponent is still correct.
+  const uint32_t remainder = mantissa & ((1u << shift) - 1);
+  const uint32_t halfway = 1u << (shift - 1);
+  if (remainder > halfway || (remainder == halfway && (half & 1u) != 0u)) {
+    half += 1;
+  }
+  return static_cast<uint16_t>(sign | half);
+}
+
+size_t EncodeFloat16(float value, const span<std::byte>& output) {
+  if (output.size() < sizeof(uint16_t)) {
+    return 0;
+  }
+  const uint16_t half = FloatToHalf(value);
+  output[0] = static_cast<std::byte>(half & 0xFFu);
+  output[1] = static_cast<std::byte>(half >> 8);
+  return sizeof(uint16_t);
+}
+
+size_t EncodeFixedPoint(float value,
+                        uint8_t fractional_bits,
+                        const span<std::byte>& output) {
+  // Scaling by a power of 2 is exact, so float math loses no precision.
+  const float scaled = value * static_cast<float>(1u << fractional_bits);
+
+  int fixed;
+  if (scaled != scaled) {  // NaN
+    fixed = 0;
+  } else if (scaled >= 2147483648.0f) {
+    fixed = std::numeric_limits<int32_t>::max();
+  } else if (scaled <= -2147483648.0f) {
+    fixed = std::numeric_limits<int32_t>::min();
+  } else {
+    fixed = static_cast<int>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+  }
+  return EncodeInt(fixed, output);
+}
+
+// Writes the length/status byte and as much of the string as fits. Sets
+// string_bytes to the number of characters that were encoded.
+size_t EncodeString(const char* string,
+                    const span<std::byte>& output,
+                    size_t& string_bytes) {
   // The top bit of the status byte indicates if the string was truncated.
   static constexpr size_t kMaxStringLength = 0x7Fu;
 
@@ -61,10 +148,6 @@ size_t EncodeString(const char* string, const span<std::byte>& output) {
     return 0;
   }
 
-  if (string == nullptr) {
-    string = "NULL";
-  }
-
   // Subtract 1 to save room for the status byte.
   const size_t max_bytes =
       std::min(static_cast<size_t>(output.size()), kMaxStringLength) - 1;
@@ -84,17 +167,55 @@ size_t EncodeString(const char* string, const span<std::byte>& output) {
   output[0] = static_cast<std::byte>(bytes_to_copy) | overflow_bit;
   std::memcpy(output.data() + 1, string, bytes_to_copy);
 
+  string_bytes = bytes_to_copy;
   return bytes_to_copy + 1;  // include the status byte in the total
 }
 
+// Encodes a V1 string. If the string shares a long enough prefix with the
+// first previous_bytes characters of the previous string argument, only the
+// rest of the string is encoded.
+size_t EncodeStringWithSharedPrefix(const char* string,
+                                    const char* previous,
+                                    size_t previous_bytes,
+                                    const span<std::byte>& output,
+                                    size_t& string_bytes) {
+  const size_t max_prefix = std::min(previous_bytes, size_t{0xFF});
+  size_t prefix = 0;
+  while (prefix < max_prefix && string[prefix] == previous[prefix]) {
+    prefix += 1;
+  }
+
+  if (prefix < kMinSharedPrefixLength || output.size() < 3u) {
+    return EncodeString(string, output, string_bytes);
+  }
+
+  output[0] = kSharedPrefixMarker;
+  output[1] = static_cast<std::byte>(prefix);
+  const size_t bytes =
+      EncodeString(string + prefix, output.subspan(2), string_bytes);
+  string_bytes += prefix;
+  return bytes + 2;
+}
+
 }  // namespace
 
 size_t EncodeArgs(pw_tokenizer_ArgTypes types,
                   va_list args,
                   span<std::byte> output) {
+  return EncodeArgs(ArgEncoding::Configured(), types, args, output);
+}
+
+size_t EncodeArgs(const ArgEncoding& encoding,
+                  pw_tokenizer_ArgTypes types,
+                  va_list args,
+                  span<std::byte> output) {
   size_t arg_count = types & PW_TOKENIZER_TYPE_COUNT_MASK;
   types >>= PW_TOKENIZER_TYPE_COUNT_SIZE_BITS;
 
+  // The encoded characters of the previous string argument, for V1 encoding.
+  const char* previous_string = nullptr;
+  size_t previous_string_bytes = 0;
+
   size_t encoded_bytes = 0;
   while (arg_count != 0u) {
     // How many bytes were encoded; 0 indicates that there wasn't enough space.
@@ -107,13 +228,43 @@ size_t EncodeArgs(pw_tokenizer_ArgTypes types,
       case ArgType::kInt64:
         argument_bytes = EncodeInt64(va_arg(args, int64_t), output);
         break;
-      case ArgType::kDouble:
-        argument_bytes =
-            EncodeFloat(static_cast<float>(va_arg(args, double)), output);
+      case ArgType::kDouble: {
+        const float value = static_cast<float>(va_arg(args, double));
+        switch (encoding.floats()) {
+          case ArgEncoding::kFloat16:
+            argument_bytes = EncodeFloat16(value, output);
+            break;
+          case ArgEncoding::kFixedPoint:
+            argument_bytes = EncodeFixedPoint(
+                value, encoding.fixed_point_fractional_bits, output);
+            break;
+          case ArgEncoding::kFloat32:
+          default:
+            argument_bytes = EncodeFloat(value, output);
+            break;
+        }
         break;
-      case ArgType::kString:
-        argument_bytes = EncodeString(va_arg(args, const char*), output);
+      }
+      case ArgType::kString: {
+        const char* string = va_arg(args, const char*);
+        if (string == nullptr) {
+          string = "NULL";
+        }
+        size_t string_bytes = 0;
+        if (encoding.version == ArgEncoding::kV1 &&
+            previous_string != nullptr) {
+          argument_bytes = EncodeStringWithSharedPrefix(string,
+                                                        previous_string,
+                                                        previous_string_bytes,
+                                                        output,
+                                                        string_bytes);
+        } else {
+          argument_bytes = EncodeString(string, output, string_bytes);
+        }
+        previous_string = string;
+        previous_string_bytes = string_bytes;
         break;
+      }
     }
 
     // If zero bytes were encoded, the encoding buffer is full.
@@ -14,11 +14,16 @@
 
 #include "pw_tokenizer/encode_args.h"
 
+#include <cstdarg>
+#include <string_view>
+
 #include "pw_unit_test/framework.h"
 
 namespace pw {
 namespace tokenizer {
 
+using namespace std::literals::string_view_literals;
+
 static_assert(MinEncodingBufferSizeBytes<>() == 4);
 static_assert(MinEncodingBufferSizeBytes<bool>() == 4 + 2);
 static_assert(MinEncodingBufferSizeBytes<char>() == 4 + 2);
@@ -50,5 +55,85 @@ TEST(TokenizerCEncodingFunctions, EncodeInt64) {
   EXPECT_EQ(buffer[0], 2);  // 1 encodes to 2 with ZigZag
 }
 
+static_assert(ArgEncoding::Configured().version == ArgEncoding::kV0);
+static_assert(ArgEncoding().floats() == ArgEncoding::kFloat32);
+static_assert(
+    ArgEncoding{ArgEncoding::kV0, ArgEncoding::kFloat16, 8}.floats() ==
+    ArgEncoding::kFloat32);
+
+class EncodeArgsV1 : public ::testing::Test {
+ protected:
+  // Encodes the arguments to buffer_ and returns them as a string_view.
+  std::string_view Encode(const ArgEncoding& encoding,
+                          pw_tokenizer_ArgTypes types,
+                          ...) {
+    va_list args;
+    va_start(args, types);
+    const size_t size =
+        EncodeArgs(encoding, types, args, span(buffer_, sizeof(buffer_)));
+    va_end(args);
+    return std::string_view(reinterpret_cast<const char*>(buffer_), size);
+  }
+
+  static constexpr ArgEncoding kFloat16{
+      ArgEncoding::kV1, ArgEncoding::kFloat16, 8};
+  static constexpr ArgEncoding kFixedPoint{
+      ArgEncoding::kV1, ArgEncoding::kFixedPoint, 8};
+
+  std::byte buffer_[64];
+};
+
+#define ENCODE(encoding, ...) \
+  Encode(encoding, PW_TOKENIZER_ARG_TYPES(__VA_ARGS__), __VA_ARGS__)
+
+TEST_F(EncodeArgsV1, Float16) {
+  EXPECT_EQ(ENCODE(kFloat16, 1.5f), "\x00\x3E"sv);
+  EXPECT_EQ(ENCODE(kFloat16, -2.0), "\x00\xC0"sv);
+  EXPECT_EQ(ENCODE(kFloat16, 0.0f), "\x00\x00"sv);
+  EXPECT_EQ(ENCODE(kFloat16, 65504.0f), "\xFF\x7B"sv);
+}
+
+TEST_F(EncodeArgsV1, Float16_RoundsToNearestEven) {
+  EXPECT_EQ(ENCODE(kFloat16, 1.0f + 0x1p-11f), "\x00\x3C"sv);
+  EXPECT_EQ(ENCODE(kFloat16, 1.0f + 0x3p-11f), "\x02\x3C"sv);
+  EXPECT_EQ(ENCODE(kFloat16, 65520.0f), "\x00\x7C"sv);  // Rounds to infinity
+}
+
+TEST_F(EncodeArgsV1, Float16_Subnormal) {
+  EXPECT_EQ(ENCODE(kFloat16, 0x1p-24f), "\x01\x00"sv);
+  EXPECT_EQ(ENCODE(kFloat16, 0x1p-14f - 0x1p-24f), "\xFF\x03"sv);
+  EXPECT_EQ(ENCODE(kFloat16, 0x1p-26f), "\x00\x00"sv);
+}
+
+TEST_F(EncodeArgsV1, Float16_TooLargeIsInfinity) {
+  EXPECT_EQ(ENCODE(kFloat16, 1e6f), "\x00\x7C"sv);
+  EXPECT_EQ(ENCODE(kFloat16, -1e6f), "\x00\xFC"sv);
+}
+
+TEST_F(EncodeArgsV1, FixedPoint) {
+  EXPECT_EQ(ENCODE(kFixedPoint, 1.5f), "\x80\x06"sv);   // 384 zig-zag encoded
+  EXPECT_EQ(ENCODE(kFixedPoint, -0.25f), "\x7F"sv);      // -64
+  EXPECT_EQ(ENCODE(kFixedPoint, 0.001f), "\x00"sv);      // Rounds to 0
+  EXPECT_EQ(ENCODE(kFixedPoint, 1e20f), "\xFE\xFF\xFF\xFF\x0F"sv);
+}
+
+TEST_F(EncodeArgsV1, StringSharesPrefixWithPreviousString) {
+  EXPECT_EQ(ENCODE(kFloat16, "sensor/temp", "sensor/humidity"),
+            "\x0bsensor/temp\x7f\x07\x08humidity"sv);
+}
+
+TEST_F(EncodeArgsV1, StringWithShortSharedPrefix_IsEncodedNormally) {
+  EXPECT_EQ(ENCODE(kFloat16, "abc", "abd"), "\3abc\3abd"sv);
+}
+
+TEST_F(EncodeArgsV1, V0StringsAreEncodedNormally) {
+  EXPECT_EQ(ENCODE(ArgEncoding(), "sensor/temp", "sensor/humidity"),
+            "\x0bsensor/temp\x0fsensor/humidity"sv);
+}
+
+TEST_F(EncodeArgsV1, V0FloatsAreEncodedAsFloat32) {
+  EXPECT_EQ(ENCODE(ArgEncoding(), 1.5f), "\x00\x00\xc0\x3f"sv);
+}
+
 }  // namespace tokenizer
 }  // namespace pw
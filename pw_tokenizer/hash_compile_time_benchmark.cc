@@ -0,0 +1,103 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the compile-time cost of the constexpr pw::tokenizer::Hash, which
+// PW_TOKENIZE_STRING evaluates once for every tokenized string. This file
+// hashes 2000 strings, each in its own constant evaluation as with
+// PW_TOKENIZE_STRING. Time the compilation of this file, e.g. by building the
+// hash_compile_time_benchmark target, or with Clang's -ftime-trace.
+//
+// Define PW_TOKENIZER_HASH_BENCHMARK_REFERENCE=1 to hash one character at a
+// time instead, for comparison. Running the program prints the combined hash,
+// which is the same either way.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+#include "pw_preprocessor/compiler.h"
+#include "pw_tokenizer/hash.h"
+
+#ifndef PW_TOKENIZER_HASH_BENCHMARK_REFERENCE
+#define PW_TOKENIZER_HASH_BENCHMARK_REFERENCE 0
+#endif  // PW_TOKENIZER_HASH_BENCHMARK_REFERENCE
+
+namespace {
+
+// Strings are taken from this text at different offsets, with lengths
+// typical of log messages.
+constexpr std::string_view kText =
+    "Sensor %s reported %d readings out of range in the last %u ms; "
+    "resetting the bus and retrying. Battery at %d%%, temperature %f C. "
+    "Failed to open file %s for writing: status %s. Received %u bytes from "
+    "0x%08x, expected %u. Connection %d closed by peer after %u seconds.";
+
+constexpr size_t kMinLength = 24;
+
+constexpr std::string_view BenchmarkString(size_t index) {
+  return kText.substr(index % (kText.size() - 64),
+                      kMinLength + index % (64 - kMinLength));
+}
+
+#if PW_TOKENIZER_HASH_BENCHMARK_REFERENCE
+
+constexpr uint32_t BenchmarkHash(std::string_view string)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
+  uint32_t hash = static_cast<uint32_t>(string.size());
+  uint32_t coefficient = pw::tokenizer::k65599HashConstant;
+  for (char ch : string) {
+    hash += coefficient * static_cast<uint8_t>(ch);
+    coefficient *= pw::tokenizer::k65599HashConstant;
+  }
+  return hash;
+}
+
+#else
+
+constexpr uint32_t BenchmarkHash(std::string_view string) {
+  return pw::tokenizer::Hash(string);
+}
+
+#endif  // PW_TOKENIZER_HASH_BENCHMARK_REFERENCE
+
+// Each token is a separate constant evaluation, like the token of each
+// PW_TOKENIZE_STRING. __COUNTER__ selects a different string for each.
+#define HASH_STRING                                  \
+  {                                                  \
+    constexpr uint32_t token =                       \
+        BenchmarkHash(BenchmarkString(__COUNTER__)); \
+    tokens ^= token;                                 \
+  }
+#define HASH_10_STRINGS                                       \
+  HASH_STRING HASH_STRING HASH_STRING HASH_STRING HASH_STRING \
+  HASH_STRING HASH_STRING HASH_STRING HASH_STRING HASH_STRING
+#define HASH_100_STRINGS                                          \
+  HASH_10_STRINGS HASH_10_STRINGS HASH_10_STRINGS HASH_10_STRINGS \
+  HASH_10_STRINGS HASH_10_STRINGS HASH_10_STRINGS HASH_10_STRINGS \
+  HASH_10_STRINGS HASH_10_STRINGS
+#define HASH_1000_STRINGS                                             \
+  HASH_100_STRINGS HASH_100_STRINGS HASH_100_STRINGS HASH_100_STRINGS \
+  HASH_100_STRINGS HASH_100_STRINGS HASH_100_STRINGS HASH_100_STRINGS \
+  HASH_100_STRINGS HASH_100_STRINGS
+
+}  // namespace
+
+int main() {
+  uint32_t tokens = 0;
+  HASH_1000_STRINGS
+  HASH_1000_STRINGS
+  std::printf("%08x\n", static_cast<unsigned>(tokens));
+  return 0;
+}
@@ -18,6 +18,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string_view>
 
 #include "pw_preprocessor/util.h"
 #include "pw_tokenizer/internal/pw_tokenizer_65599_fixed_length_128_hash_macro.h"
@@ -90,6 +91,44 @@ TEST(Hashing, Runtime) PW_NO_SANITIZE("unsigned-integer-overflow") {
             StringLength("123456") + k2 * '1' + k3 * '2' + k4 * '3' + k5 * '4');
 }
 
+// Hashes one character at a time, as the hash is defined.
+constexpr uint32_t ReferenceHash(std::string_view string, size_t hash_length)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
+  uint32_t hash = static_cast<uint32_t>(string.size());
+  uint32_t coefficient = k65599HashConstant;
+  for (char ch : string.substr(0, hash_length)) {
+    hash += coefficient * static_cast<uint8_t>(ch);
+    coefficient *= k65599HashConstant;
+  }
+  return hash;
+}
+
+// Check every length, since the hash handles blocks of 4 characters and the
+// remaining characters separately.
+constexpr bool MatchesReferenceHashAtEveryLength() {
+  constexpr std::string_view kText =
+      "The quick brown fox jumps over the lazy dog.\x80\xff\0!";
+  for (size_t length = 0; length <= kText.size(); ++length) {
+    const std::string_view string = kText.substr(0, length);
+    if (Hash(string) != ReferenceHash(string, length)) {
+      return false;
+    }
+    for (size_t hash_length = 0; hash_length <= length + 1; ++hash_length) {
+      if (PwTokenizer65599FixedLengthHash(string, hash_length) !=
+          ReferenceHash(string, hash_length)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(MatchesReferenceHashAtEveryLength());
+
+TEST(Hashing, MatchesReferenceHashAtRuntime) {
+  EXPECT_TRUE(MatchesReferenceHashAtEveryLength());
+}
+
 #define _CHECK_HASH_LENGTH(string, length)                                   \
   static_assert(PwTokenizer65599FixedLengthHash(                             \
                     std::string_view(string, sizeof(string) - 1), length) == \
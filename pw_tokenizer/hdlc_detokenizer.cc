@@ -0,0 +1,301 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Reads HDLC frames from a serial device, socket, or capture file, detokenizes
+// their contents, and prints each message with the time it was received.
+//
+//   hdlc_detokenizer [OPTIONS] DATABASE
+//
+// DATABASE is a binary token database. Indexed (binary-v1) databases are used
+// in place without building a lookup table, so they load fastest. Frames that
+// contain text are printed with any prefixed Base64 messages in them decoded.
+//
+// This is a native alternative to serial_detokenizer.py for high baud rates.
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "pw_bytes/span.h"
+#include "pw_hdlc/decoder.h"
+#include "pw_span/span.h"
+#include "pw_stream/posix_file_stream.h"
+#include "pw_stream/socket_stream.h"
+#include "pw_stream/stream.h"
+#include "pw_stream_uart_linux/stream.h"
+#include "pw_tokenizer/detokenize.h"
+#include "pw_tokenizer/indexed_token_database.h"
+#include "pw_tokenizer/token_database.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr const char* kUsage =
+    "Usage: %s [OPTIONS] DATABASE\n"
+    "\n"
+    "Input (exactly one):\n"
+    "  -d, --device PATH      Serial device to read from\n"
+    "  -s, --socket HOST:PORT Socket to connect to and read from\n"
+    "  -f, --file PATH        Capture file to read from\n"
+    "\n"
+    "Options:\n"
+    "  -b, --baudrate RATE    Serial baud rate (default: 115200)\n"
+    "  -a, --address ADDRESS  Only print frames with this HDLC address\n"
+    "      --no-timestamps    Do not prefix messages with the receive time\n";
+
+// A serial read returns once this many bytes arrived, or the line was idle for
+// kReadTimeoutDeciseconds. Waking up once per burst instead of once per byte
+// is what lets the tool keep up with fast links.
+constexpr uint8_t kMinReadBytes = 255;
+constexpr uint8_t kReadTimeoutDeciseconds = 1;
+
+constexpr size_t kReadBufferSizeBytes = 16384;
+constexpr size_t kMaxFrameSizeBytes = 4096;
+
+struct Options {
+  const char* database = nullptr;
+  const char* device = nullptr;
+  const char* socket = nullptr;
+  const char* file = nullptr;
+  uint32_t baud_rate = 115200;
+  std::optional<uint64_t> address;
+  bool timestamps = true;
+};
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+  const auto [end, error] =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == std::errc() && end == text.data() + text.size();
+}
+
+bool ParseArgs(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const bool has_value = i + 1 < argc;
+
+    if (arg == "--no-timestamps") {
+      options.timestamps = false;
+    } else if ((arg == "-d" || arg == "--device") && has_value) {
+      options.device = argv[++i];
+    } else if ((arg == "-s" || arg == "--socket") && has_value) {
+      options.socket = argv[++i];
+    } else if ((arg == "-f" || arg == "--file") && has_value) {
+      options.file = argv[++i];
+    } else if ((arg == "-b" || arg == "--baudrate") && has_value) {
+      if (!ParseNumber(argv[++i], options.baud_rate)) {
+        return false;
+      }
+    } else if ((arg == "-a" || arg == "--address") && has_value) {
+      uint64_t address;
+      if (!ParseNumber(argv[++i], address)) {
+        return false;
+      }
+      options.address = address;
+    } else if (!arg.empty() && arg[0] != '-' && options.database == nullptr) {
+      options.database = argv[i];
+    } else {
+      return false;
+    }
+  }
+
+  const int inputs = (options.device != nullptr) +
+                     (options.socket != nullptr) + (options.file != nullptr);
+  return options.database != nullptr && inputs == 1;
+}
+
+// Writes detokenized messages to stdout. Messages from each read are collected
+// and written together, so output costs one write per read, not per message.
+class MessagePrinter {
+ public:
+  MessagePrinter(const Detokenizer& detokenizer, const Options& options)
+      : detokenizer_(detokenizer), options_(options) {}
+
+  // Starts a batch of messages that were received at the current time.
+  void StartBatch() {
+    output_.clear();
+    if (!options_.timestamps) {
+      return;
+    }
+
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            now.time_since_epoch())
+                            .count() %
+                        1000;
+    std::tm local_time;
+    localtime_r(&seconds, &local_time);
+
+    char time_text[16];
+    const size_t length =
+        std::strftime(time_text, sizeof(time_text), "%H:%M:%S", &local_time);
+    std::snprintf(time_text + length,
+                  sizeof(time_text) - length,
+                  ".%03d  ",
+                  static_cast<int>(millis));
+    timestamp_ = time_text;
+  }
+
+  void AddFrame(const hdlc::Frame& frame) {
+    if (options_.address.has_value() && frame.address() != *options_.address) {
+      return;
+    }
+    const span<const uint8_t> data(
+        reinterpret_cast<const uint8_t*>(frame.data().data()),
+        frame.data().size());
+
+    output_.append(timestamp_);
+
+    // Binary frames start with a token. Anything else is printed as text, with
+    // nested Base64 messages decoded.
+    const DetokenizedString result = detokenizer_.Detokenize(data);
+    if (!result.matches().empty()) {
+      output_.append(result.BestStringWithErrors());
+    } else {
+      std::string_view text(reinterpret_cast<const char*>(data.data()),
+                            data.size());
+      while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+        text.remove_suffix(1);
+      }
+      output_.append(detokenizer_.DetokenizeBase64(text));
+    }
+    output_.push_back('\n');
+  }
+
+  void FinishBatch() {
+    if (!output_.empty()) {
+      std::fwrite(output_.data(), 1, output_.size(), stdout);
+      std::fflush(stdout);
+    }
+  }
+
+ private:
+  const Detokenizer& detokenizer_;
+  const Options& options_;
+  std::string timestamp_;
+  std::string output_;  // Reused for each batch to avoid reallocating.
+};
+
+Status Detokenize(stream::Reader& input, MessagePrinter& printer) {
+  hdlc::DecoderBuffer<kMaxFrameSizeBytes> decoder;
+  std::array<std::byte, kReadBufferSizeBytes> buffer;
+
+  while (true) {
+    const Result<ByteSpan> read = input.Read(buffer);
+    if (!read.ok()) {
+      return read.status().IsOutOfRange() ? OkStatus() : read.status();
+    }
+
+    printer.StartBatch();
+    decoder.Process(*read, [&printer](const Result<hdlc::Frame>& frame) {
+      // Corrupt frames are dropped; the decoder resyncs on the next flag.
+      if (frame.ok()) {
+        printer.AddFrame(*frame);
+      }
+    });
+    printer.FinishBatch();
+  }
+}
+
+Status OpenSocket(const char* address, stream::SocketStream& socket) {
+  const std::string_view text = address;
+  const size_t colon = text.rfind(':');
+  const std::string host =
+      colon == std::string_view::npos ? "localhost"
+                                      : std::string(text.substr(0, colon));
+  uint16_t port;
+  if (!ParseNumber(colon == std::string_view::npos ? text
+                                                   : text.substr(colon + 1),
+                   port)) {
+    return Status::InvalidArgument();
+  }
+  return socket.Connect(host.c_str(), port);
+}
+
+int Run(int argc, char** argv) {
+  Options options;
+  if (!ParseArgs(argc, argv, options)) {
+    std::fprintf(stderr, kUsage, argv[0]);
+    return 2;
+  }
+
+  // The database is mapped rather than read, so an indexed database can be
+  // searched without copying it.
+  stream::MmapFileReader database_file;
+  if (Status status = database_file.Open(options.database); !status.ok()) {
+    std::fprintf(stderr,
+                 "Failed to open database %s: %s\n",
+                 options.database,
+                 status.str());
+    return 1;
+  }
+  const span<const uint8_t> database_bytes(
+      reinterpret_cast<const uint8_t*>(database_file.data().data()),
+      database_file.data().size());
+
+  std::optional<Detokenizer> detokenizer;
+  if (IndexedTokenDatabase::IsValid(database_bytes)) {
+    detokenizer.emplace(IndexedTokenDatabase::Create(database_bytes));
+  } else if (TokenDatabase database = TokenDatabase::Create(database_bytes);
+             database.ok()) {
+    detokenizer.emplace(database);
+  } else {
+    std::fprintf(stderr,
+                 "%s is not a binary token database; convert it with "
+                 "database.py create --type binary-v1\n",
+                 options.database);
+    return 1;
+  }
+
+  MessagePrinter printer(*detokenizer, options);
+  Status status;
+
+  if (options.device != nullptr) {
+    stream::UartStreamLinux uart;
+    stream::UartStreamLinux::Config config{options.baud_rate};
+    config.min_read_bytes = kMinReadBytes;
+    config.read_timeout_deciseconds = kReadTimeoutDeciseconds;
+    if (status = uart.Open(options.device, config); status.ok()) {
+      status = Detokenize(uart, printer);
+    }
+  } else if (options.socket != nullptr) {
+    stream::SocketStream socket;
+    if (status = OpenSocket(options.socket, socket); status.ok()) {
+      status = Detokenize(socket, printer);
+    }
+  } else {
+    stream::MmapFileReader file;
+    if (status = file.Open(options.file); status.ok()) {
+      status = Detokenize(file, printer);
+    }
+  }
+
+  if (!status.ok()) {
+    std::fprintf(stderr, "Failed to read input: %s\n", status.str());
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace pw::tokenizer
+
+int main(int argc, char** argv) { return pw::tokenizer::Run(argc, argv); }
@@ -0,0 +1,94 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_tokenizer/indexed_token_database.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "pw_bytes/endian.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr std::array<uint8_t, 8> kMagicAndVersion = {
+    'T', 'O', 'K', 'E', 'N', 'S', 1, 0};
+
+uint32_t ReadUint32(const uint8_t* bytes) {
+  return bytes::ReadInOrder<uint32_t>(endian::little, bytes);
+}
+
+}  // namespace
+
+IndexedTokenDatabase::Entry IndexedTokenDatabase::iterator::operator*() const {
+  return Entry{ReadUint32(raw_),
+               ReadUint32(raw_ + 4),
+               strings_ + ReadUint32(raw_ + 8)};
+}
+
+bool IndexedTokenDatabase::IsValid(span<const uint8_t> bytes) {
+  if (bytes.size() < kHeaderSize ||
+      std::memcmp(bytes.data(), kMagicAndVersion.data(), 8) != 0) {
+    return false;
+  }
+
+  const size_t entries = ReadUint32(bytes.data() + 8);
+  if ((bytes.size() - kHeaderSize) / kEntrySize < entries) {
+    return false;
+  }
+
+  // Each string starts within the string table, which ends with a null
+  // terminator, so every string is terminated.
+  const span<const uint8_t> strings =
+      bytes.subspan(kHeaderSize + entries * kEntrySize);
+  if (entries != 0u && (strings.empty() || strings.back() != '\0')) {
+    return false;
+  }
+
+  for (size_t i = 0; i < entries; ++i) {
+    const uint8_t* entry = bytes.data() + kHeaderSize + i * kEntrySize;
+    if (ReadUint32(entry + 8) >= strings.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+IndexedTokenDatabase IndexedTokenDatabase::Create(span<const uint8_t> bytes) {
+  if (!IsValid(bytes)) {
+    return IndexedTokenDatabase();
+  }
+  const uint8_t* entries = bytes.data() + kHeaderSize;
+  const uint8_t* entries_end =
+      entries + ReadUint32(bytes.data() + 8) * kEntrySize;
+  return IndexedTokenDatabase(
+      entries, entries_end, reinterpret_cast<const char*>(entries_end));
+}
+
+IndexedTokenDatabase::Entries IndexedTokenDatabase::Find(
+    uint32_t token) const {
+  const iterator first = std::partition_point(
+      begin(), end(), [token](const Entry& entry) {
+        return entry.token < token;
+      });
+  const iterator last = std::partition_point(
+      first, end(), [token](const Entry& entry) {
+        return entry.token == token;
+      });
+  return Entries(first, last);
+}
+
+}  // namespace pw::tokenizer
@@ -0,0 +1,124 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_tokenizer/indexed_token_database.h"
+
+#include <string_view>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::tokenizer {
+namespace {
+
+using namespace std::literals::string_view_literals;
+
+// Database with the following entries:
+// {
+//   0x00000001: "hi!",
+//   0x00000002: "goodbye" (removed 2024-01-02),
+//   0x00000002: "hi!",
+//   0x000000ff: ":)",
+// }
+constexpr std::string_view kBasicData =
+    "TOKENS\1\0\x04\x00\x00\x00\0\0\0\0"
+    "\x01\0\0\0\xff\xff\xff\xff\x00\0\0\0"
+    "\x02\0\0\0\x02\x01\xe8\x07\x04\0\0\0"
+    "\x02\0\0\0\xff\xff\xff\xff\x00\0\0\0"
+    "\xff\0\0\0\xff\xff\xff\xff\x0c\0\0\0"
+    "hi!\0"
+    "goodbye\0"
+    ":)\0"sv;
+
+constexpr std::string_view kEmptyData = "TOKENS\1\0\0\0\0\0\0\0\0\0"sv;
+
+TEST(IndexedTokenDatabase, ValidCheck) {
+  EXPECT_TRUE(IndexedTokenDatabase::Create(kBasicData).ok());
+  EXPECT_TRUE(IndexedTokenDatabase::Create(kEmptyData).ok());
+
+  // A v0 database is not a v1 database.
+  EXPECT_FALSE(
+      IndexedTokenDatabase::Create("TOKENS\0\0\0\0\0\0\0\0\0\0"sv).ok());
+  // Too short.
+  EXPECT_FALSE(IndexedTokenDatabase::Create("TOKENS\1\0\0\0"sv).ok());
+  // Not enough data for the entries.
+  EXPECT_FALSE(IndexedTokenDatabase::Create(
+                   "TOKENS\1\0\x01\0\0\0\0\0\0\0TOKNdate\0\0\0"sv)
+                   .ok());
+  // The string table must end with a null terminator.
+  EXPECT_FALSE(IndexedTokenDatabase::Create(
+                   "TOKENS\1\0\x01\0\0\0\0\0\0\0TOKNdate\0\0\0\0hi"sv)
+                   .ok());
+  // String offset past the end of the string table.
+  EXPECT_FALSE(IndexedTokenDatabase::Create(
+                   "TOKENS\1\0\x01\0\0\0\0\0\0\0TOKNdate\x03\0\0\0hi\0"sv)
+                   .ok());
+  EXPECT_TRUE(IndexedTokenDatabase::Create(
+                  "TOKENS\1\0\x01\0\0\0\0\0\0\0TOKNdate\x02\0\0\0hi\0"sv)
+                  .ok());
+}
+
+TEST(IndexedTokenDatabase, InvalidDatabaseIsEmpty) {
+  const IndexedTokenDatabase db = IndexedTokenDatabase::Create("TOKENS"sv);
+  EXPECT_FALSE(db.ok());
+  EXPECT_TRUE(db.empty());
+  EXPECT_EQ(db.begin(), db.end());
+  EXPECT_TRUE(db.Find(1).empty());
+}
+
+TEST(IndexedTokenDatabase, Iterate) {
+  const IndexedTokenDatabase db = IndexedTokenDatabase::Create(kBasicData);
+  ASSERT_EQ(db.size(), 4u);
+
+  auto it = db.begin();
+  EXPECT_EQ((*it).token, 1u);
+  EXPECT_STREQ((*it).string, "hi!");
+  ++it;
+  EXPECT_EQ((*it).token, 2u);
+  EXPECT_EQ((*it).date_removed, 0x07e80102u);
+  EXPECT_STREQ((*it).string, "goodbye");
+  EXPECT_STREQ(it[2].string, ":)");
+  EXPECT_EQ(db.end() - it, 3);
+}
+
+TEST(IndexedTokenDatabase, Find) {
+  const IndexedTokenDatabase db = IndexedTokenDatabase::Create(kBasicData);
+
+  const auto one = db.Find(1);
+  ASSERT_EQ(one.size(), 1u);
+  EXPECT_STREQ(one[0].string, "hi!");
+
+  const auto two = db.Find(2);
+  ASSERT_EQ(two.size(), 2u);
+  EXPECT_STREQ(two[0].string, "goodbye");
+  EXPECT_STREQ(two[1].string, "hi!");
+
+  const auto last = db.Find(0xff);
+  ASSERT_EQ(last.size(), 1u);
+  EXPECT_STREQ(last[0].string, ":)");
+
+  EXPECT_TRUE(db.Find(0).empty());
+  EXPECT_TRUE(db.Find(3).empty());
+  EXPECT_TRUE(db.Find(0xffffffff).empty());
+}
+
+TEST(IndexedTokenDatabase, FindInEmptyDatabase) {
+  const IndexedTokenDatabase db = IndexedTokenDatabase::Create(kEmptyData);
+  EXPECT_TRUE(db.ok());
+  EXPECT_TRUE(db.empty());
+  EXPECT_TRUE(db.Find(1).empty());
+}
+
+}  // namespace
+}  // namespace pw::tokenizer
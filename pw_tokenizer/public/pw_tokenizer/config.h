@@ -50,6 +50,49 @@
 #define PW_TOKENIZER_CFG_C_HASH_LENGTH 128
 #endif  // PW_TOKENIZER_CFG_C_HASH_LENGTH
 
+/// Tokenized string argument encodings. `PW_TOKENIZER_ARG_ENCODING_V0` is the
+/// original encoding: integers are zig-zag varints, floating point values are
+/// 4-byte floats, and strings are a length/status byte followed by the string.
+///
+/// `PW_TOKENIZER_ARG_ENCODING_V1` encodes floating point values as selected by
+/// @c_macro{PW_TOKENIZER_CFG_FLOAT_ENCODING}, and a string argument that shares
+/// a prefix of 3 or more characters with the previous string argument in the
+/// same message only stores the rest of the string. Messages are still
+/// independent of each other, so dropped messages don't affect decoding.
+#define PW_TOKENIZER_ARG_ENCODING_V0 0
+#define PW_TOKENIZER_ARG_ENCODING_V1 1
+
+/// Selects the tokenized string argument encoding. Detokenizers must be
+/// configured with the same encoding as the device that encoded the messages.
+#ifndef PW_TOKENIZER_CFG_ARG_ENCODING
+#define PW_TOKENIZER_CFG_ARG_ENCODING PW_TOKENIZER_ARG_ENCODING_V0
+#endif  // PW_TOKENIZER_CFG_ARG_ENCODING
+
+/// Floating point argument encodings for `PW_TOKENIZER_ARG_ENCODING_V1`.
+///
+/// - `PW_TOKENIZER_FLOAT_ENCODING_FLOAT32`: 4-byte IEEE 754 float.
+/// - `PW_TOKENIZER_FLOAT_ENCODING_FLOAT16`: 2-byte IEEE 754 half-precision
+///   float, with about 3 significant decimal digits and a maximum of 65504.
+/// - `PW_TOKENIZER_FLOAT_ENCODING_FIXED_POINT`: Zig-zag varint of the value
+///   multiplied by 2^@c_macro{PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS}
+///   and rounded, saturated to 32 bits. Small values take 1-3 bytes. NaN is
+///   encoded as 0.
+#define PW_TOKENIZER_FLOAT_ENCODING_FLOAT32 0
+#define PW_TOKENIZER_FLOAT_ENCODING_FLOAT16 1
+#define PW_TOKENIZER_FLOAT_ENCODING_FIXED_POINT 2
+
+/// Selects the floating point argument encoding when
+/// @c_macro{PW_TOKENIZER_CFG_ARG_ENCODING} is `PW_TOKENIZER_ARG_ENCODING_V1`.
+#ifndef PW_TOKENIZER_CFG_FLOAT_ENCODING
+#define PW_TOKENIZER_CFG_FLOAT_ENCODING PW_TOKENIZER_FLOAT_ENCODING_FLOAT16
+#endif  // PW_TOKENIZER_CFG_FLOAT_ENCODING
+
+/// The number of fractional bits for `PW_TOKENIZER_FLOAT_ENCODING_FIXED_POINT`.
+/// Must be less than 32.
+#ifndef PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS
+#define PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS 8
+#endif  // PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS
+
 /// `PW_TOKENIZER_CFG_ENCODING_BUFFER_SIZE_BYTES` is deprecated. It is used as
 /// the default value for pw_log_tokenized's
 /// @c_macro{PW_LOG_TOKENIZED_ENCODING_BUFFER_SIZE_BYTES}. This value should not
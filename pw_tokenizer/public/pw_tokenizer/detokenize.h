@@ -26,13 +26,18 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "pw_function/function.h"
 #include "pw_result/result.h"
 #include "pw_span/span.h"
+#include "pw_tokenizer/indexed_token_database.h"
 #include "pw_tokenizer/internal/decode.h"
 #include "pw_tokenizer/token_database.h"
 
@@ -46,7 +51,8 @@ class DetokenizedString {
  public:
   DetokenizedString(uint32_t token,
                     const span<const TokenizedStringEntry>& entries,
-                    const span<const uint8_t>& arguments);
+                    const span<const uint8_t>& arguments,
+                    const ArgEncoding& encoding = ArgEncoding());
 
   DetokenizedString() : has_token_(false) {}
 
@@ -73,23 +79,47 @@ class DetokenizedString {
   std::vector<DecodedFormatString> matches_;
 };
 
-// Decodes and detokenizes strings from a TokenDatabase. This class builds a
-// hash table from the TokenDatabase to give O(1) token lookups.
+// Decodes and detokenizes strings from a token database. A TokenDatabase is
+// loaded into a hash table to give O(1) token lookups. An IndexedTokenDatabase
+// is searched in place, which avoids the startup time and memory of building
+// the hash table for large databases.
+//
+// Arguments are decoded with the ArgEncoding passed to the constructor, which
+// must match the PW_TOKENIZER_CFG_ARG_ENCODING options of the device that
+// encoded the messages.
 class Detokenizer {
  public:
   // Constructs a detokenizer from a TokenDatabase. The TokenDatabase is not
   // referenced by the Detokenizer after construction; its memory can be freed.
-  Detokenizer(const TokenDatabase& database);
+  Detokenizer(const TokenDatabase& database,
+              const ArgEncoding& arg_encoding = ArgEncoding());
+
+  // Constructs a detokenizer that looks up tokens directly in an
+  // IndexedTokenDatabase with O(log n) binary searches. The database's memory
+  // is referenced by the Detokenizer and must outlive it. Each token's format
+  // strings are parsed the first time it is looked up and cached for later
+  // messages.
+  explicit Detokenizer(const IndexedTokenDatabase& database,
+                       const ArgEncoding& arg_encoding = ArgEncoding())
+      : indexed_database_(database),
+        indexed_cache_(std::make_shared<IndexedCache>()),
+        arg_encoding_(arg_encoding) {}
 
   // Constructs a detokenier by directly passing the parsed database.
   explicit Detokenizer(
       std::unordered_map<uint32_t, std::vector<TokenizedStringEntry>>&&
-          database)
-      : database_(std::move(database)) {}
+          database,
+      const ArgEncoding& arg_encoding = ArgEncoding())
+      : database_(std::move(database)), arg_encoding_(arg_encoding) {}
 
   // Factory method which returns a detokenizer instance from the
   // .pw_tokenizer.entries section of an ELF binary.
-  static Result<Detokenizer> FromElfSection(span<const uint8_t> elf_section);
+  static Result<Detokenizer> FromElfSection(
+      span<const uint8_t> elf_section,
+      const ArgEncoding& arg_encoding = ArgEncoding());
+
+  // The encoding used to decode tokenized messages' arguments.
+  const ArgEncoding& arg_encoding() const { return arg_encoding_; }
 
   // Decodes and detokenizes the encoded message. Returns a DetokenizedString
   // that stores all possible detokenized string results.
@@ -104,6 +134,21 @@ class Detokenizer {
   // that fail to decode are left as is.
   std::string DetokenizeBase64(std::string_view text) const;
 
+  // Detokenizes a batch of binary messages. The best string for each message,
+  // with error messages for arguments that failed to decode (as from
+  // DetokenizedString::BestStringWithErrors()), is written to output, and
+  // results[i] is set to the string for messages[i], which points into output.
+  //
+  // output and results are cleared first. Passing the same output and results
+  // to each call reuses their memory, which avoids allocating strings for each
+  // message.
+  //
+  // A Detokenizer is not modified after it is constructed, so multiple threads
+  // may detokenize batches concurrently, each with their own output buffers.
+  void DetokenizeBatch(span<const span<const uint8_t>> messages,
+                       std::string& output,
+                       std::vector<std::string_view>& results) const;
+
   DetokenizedString Detokenize(std::string_view encoded) const {
     return Detokenize(encoded.data(), encoded.size());
   }
@@ -113,7 +158,81 @@ class Detokenizer {
   }
 
  private:
-  std::unordered_map<uint32_t, std::vector<TokenizedStringEntry>> database_;
+  using Database =
+      std::unordered_map<uint32_t, std::vector<TokenizedStringEntry>>;
+
+  // Entries from indexed_database_, parsed into FormatStrings the first time
+  // their token is looked up. Entries are never removed, and references to
+  // unordered_map elements survive rehashing, so looked up entries remain valid
+  // after the mutex is released.
+  struct IndexedCache {
+    std::mutex mutex;
+    Database entries;
+  };
+
+  // Returns the entries for a token, with their parsed format strings.
+  span<const TokenizedStringEntry> FindEntries(uint32_t token) const;
+
+  // Format strings are parsed when the Detokenizer is constructed, so decoding
+  // a message only decodes its arguments and concatenates the results.
+  Database database_;
+
+  // If ok(), tokens are looked up here instead of in database_, and their
+  // format strings are parsed into indexed_cache_ on first use.
+  IndexedTokenDatabase indexed_database_;
+  std::shared_ptr<IndexedCache> indexed_cache_;  // Shared by copies.
+
+  ArgEncoding arg_encoding_;
+};
+
+// Detokenizes prefixed Base64 messages in a stream of text, such as a live
+// console log. Text is passed in chunks of any size, and is written to the
+// output callback as soon as it is known not to be part of a message. Each
+// message is written once it ends, with its detokenized string if it decodes
+// successfully, or unmodified otherwise.
+//
+// Messages nested within detokenized strings are decoded up to max_recursion
+// levels deep. The default of 0 only decodes messages in the stream itself,
+// like Detokenizer::DetokenizeBase64.
+class NestedMessageDetokenizer {
+ public:
+  using Output = Function<void(std::string_view text)>;
+
+  NestedMessageDetokenizer(const Detokenizer& detokenizer,
+                           Output&& output,
+                           unsigned max_recursion = 0)
+      : detokenizer_(detokenizer),
+        output_(std::move(output)),
+        max_recursion_(max_recursion) {}
+
+  // Processes a chunk of text. A message may be split across chunks.
+  void Detokenize(std::string_view chunk);
+
+  void Detokenize(char next_char) {
+    Detokenize(std::string_view(&next_char, 1));
+  }
+
+  // Ends the message in progress, if any, and writes it to the output. Call
+  // this when the stream ends or pauses, e.g. at the end of a line.
+  void Flush();
+
+ private:
+  void Write(std::string_view text) {
+    if (!text.empty()) {
+      output_(text);
+    }
+  }
+
+  void HandleEndOfMessage();
+
+  const Detokenizer& detokenizer_;
+  Output output_;
+  unsigned max_recursion_;
+
+  // Holds the message in progress; its memory is reused for later messages.
+  std::string message_buffer_;
+
+  enum { kNonMessage, kMessage } state_ = kNonMessage;
 };
 
 }  // namespace pw::tokenizer
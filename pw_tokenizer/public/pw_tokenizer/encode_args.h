@@ -32,14 +32,69 @@
 #include "pw_tokenizer/tokenize.h"
 
 namespace pw::tokenizer {
+
+/// Describes how a tokenized message's arguments are encoded. A
+/// default-constructed `ArgEncoding` is the original encoding,
+/// `PW_TOKENIZER_ARG_ENCODING_V0`. Detokenizers must use the same encoding as
+/// the encoder; see @c_macro{PW_TOKENIZER_CFG_ARG_ENCODING}.
+struct ArgEncoding {
+  enum Version : uint8_t {
+    kV0 = PW_TOKENIZER_ARG_ENCODING_V0,
+    kV1 = PW_TOKENIZER_ARG_ENCODING_V1,
+  };
+
+  enum Float : uint8_t {
+    kFloat32 = PW_TOKENIZER_FLOAT_ENCODING_FLOAT32,
+    kFloat16 = PW_TOKENIZER_FLOAT_ENCODING_FLOAT16,
+    kFixedPoint = PW_TOKENIZER_FLOAT_ENCODING_FIXED_POINT,
+  };
+
+  /// Returns the encoding selected by the `PW_TOKENIZER_CFG_*` options.
+  static constexpr ArgEncoding Configured() {
+    return {static_cast<Version>(PW_TOKENIZER_CFG_ARG_ENCODING),
+            static_cast<Float>(PW_TOKENIZER_CFG_FLOAT_ENCODING),
+            PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS};
+  }
+
+  /// Returns how floating point arguments are encoded. V0 always uses floats.
+  constexpr Float floats() const {
+    return version == kV0 ? kFloat32 : float_encoding;
+  }
+
+  Version version = kV0;
+  Float float_encoding = kFloat32;  // Ignored for kV0.
+  uint8_t fixed_point_fractional_bits = 8;
+};
+
+static_assert(ArgEncoding::Configured().version <= ArgEncoding::kV1,
+              "Unsupported PW_TOKENIZER_CFG_ARG_ENCODING");
+static_assert(ArgEncoding::Configured().float_encoding <=
+                  ArgEncoding::kFixedPoint,
+              "Unsupported PW_TOKENIZER_CFG_FLOAT_ENCODING");
+static_assert(PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS < 32,
+              "PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS must be < 32");
+
 namespace internal {
 
+// Returns the maximum encoded size of a floating point argument.
+constexpr size_t FloatEncodedSizeBytes(ArgEncoding::Float encoding) {
+  switch (encoding) {
+    case ArgEncoding::kFloat16:
+      return 2;
+    case ArgEncoding::kFixedPoint:
+      return 5;  // Max size of zig-zag varint integer <= 32-bits
+    case ArgEncoding::kFloat32:
+    default:
+      return sizeof(float);
+  }
+}
+
 // Returns the maximum encoded size of an argument of the specified type.
 template <typename T>
 constexpr size_t ArgEncodedSizeBytes() {
   constexpr pw_tokenizer_ArgTypes kType = VarargsType<T>();
   if constexpr (kType == PW_TOKENIZER_ARG_TYPE_DOUBLE) {
-    return sizeof(float);
+    return FloatEncodedSizeBytes(ArgEncoding::Configured().floats());
   } else if constexpr (kType == PW_TOKENIZER_ARG_TYPE_STRING) {
     return 1;  // Size of the length byte only
   } else if constexpr (kType == PW_TOKENIZER_ARG_TYPE_INT64) {
@@ -83,6 +138,13 @@ size_t EncodeArgs(pw_tokenizer_ArgTypes types,
                   va_list args,
                   span<std::byte> output);
 
+/// Encodes a tokenized string's arguments with a specific `ArgEncoding`
+/// rather than the configured one.
+size_t EncodeArgs(const ArgEncoding& encoding,
+                  pw_tokenizer_ArgTypes types,
+                  va_list args,
+                  span<std::byte> output);
+
 /// Encodes a tokenized message to a fixed size buffer. This class is used to
 /// encode tokenized messages passed in from tokenization macros.
 ///
@@ -34,6 +34,48 @@ namespace pw::tokenizer {
 // of all hashes, so do not change it randomly.
 inline constexpr uint32_t k65599HashConstant = 65599u;
 
+namespace internal {
+
+// Powers of the hash constant, modulo 0x100000000.
+inline constexpr uint32_t k65599HashConstant2 =
+    static_cast<uint32_t>(uint64_t{k65599HashConstant} * k65599HashConstant);
+inline constexpr uint32_t k65599HashConstant3 = static_cast<uint32_t>(
+    uint64_t{k65599HashConstant2} * k65599HashConstant);
+inline constexpr uint32_t k65599HashConstant4 = static_cast<uint32_t>(
+    uint64_t{k65599HashConstant3} * k65599HashConstant);
+
+// Adds the characters of a string to a hash. Characters are hashed four at a
+// time, which takes fewer constant evaluation steps than hashing them one at a
+// time. This matters when hashing every tokenized string in a program at
+// compile time, since each string is hashed in its own constant evaluation.
+//
+// The coefficient calculation is done modulo 0x100000000, so the unsigned
+// integer overflows are intentional.
+constexpr uint32_t Hash65599Characters(std::string_view string, uint32_t hash)
+    PW_NO_SANITIZE("unsigned-integer-overflow") {
+  uint32_t coefficient = k65599HashConstant;
+  const char* ch = string.data();
+  const char* const end = ch + string.size();
+
+  for (; end - ch >= 4; ch += 4) {
+    hash += coefficient *
+            (static_cast<uint8_t>(ch[0]) +
+             k65599HashConstant * static_cast<uint8_t>(ch[1]) +
+             k65599HashConstant2 * static_cast<uint8_t>(ch[2]) +
+             k65599HashConstant3 * static_cast<uint8_t>(ch[3]));
+    coefficient *= k65599HashConstant4;
+  }
+
+  for (; ch != end; ++ch) {
+    hash += coefficient * static_cast<uint8_t>(*ch);
+    coefficient *= k65599HashConstant;
+  }
+
+  return hash;
+}
+
+}  // namespace internal
+
 // Calculates the hash of a string. This function calculates hashes at either
 // runtime or compile time in C++ code.
 //
@@ -54,21 +96,11 @@ inline constexpr uint32_t k65599HashConstant = 65599u;
 //   - Characters are hashed in reverse order.
 //   - The string length is hashed as the first character in the string.
 //
-constexpr uint32_t Hash(std::string_view string)
-    PW_NO_SANITIZE("unsigned-integer-overflow") {
-  // The length is hashed as if it were the first character.
-  uint32_t hash = static_cast<uint32_t>(string.size());
-  uint32_t coefficient = k65599HashConstant;
-
-  // Hash all of the characters in the string as unsigned ints.
-  // The coefficient calculation is done modulo 0x100000000, so the unsigned
-  // integer overflows are intentional.
-  for (char ch : string) {
-    hash += coefficient * static_cast<uint8_t>(ch);
-    coefficient *= k65599HashConstant;
-  }
-
-  return hash;
+constexpr uint32_t Hash(std::string_view string) {
+  // The length is hashed as if it were the first character. The characters are
+  // hashed as unsigned ints.
+  return internal::Hash65599Characters(string,
+                                       static_cast<uint32_t>(string.size()));
 }
 
 // Take the string as an array to support either literals or character arrays,
@@ -83,17 +115,9 @@ constexpr uint32_t Hash(const char (&string)[kSize]) {
 // up to a maximum length.
 constexpr uint32_t PwTokenizer65599FixedLengthHash(
     std::string_view string,
-    size_t hash_length = PW_TOKENIZER_CFG_C_HASH_LENGTH)
-    PW_NO_SANITIZE("unsigned-integer-overflow") {
-  uint32_t hash = static_cast<uint32_t>(string.size());
-  uint32_t coefficient = k65599HashConstant;
-
-  for (char ch : string.substr(0, hash_length)) {
-    hash += coefficient * static_cast<uint8_t>(ch);
-    coefficient *= k65599HashConstant;
-  }
-
-  return hash;
+    size_t hash_length = PW_TOKENIZER_CFG_C_HASH_LENGTH) {
+  return internal::Hash65599Characters(string.substr(0, hash_length),
+                                       static_cast<uint32_t>(string.size()));
 }
 
 // Character array version of PwTokenizer65599FixedLengthHash.
@@ -0,0 +1,200 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "pw_span/span.h"
+#include "pw_tokenizer/token_database.h"
+
+namespace pw::tokenizer {
+
+/// Reads entries from a v1 binary token string database. Like
+/// `TokenDatabase`, this class does not copy or modify the contents of the
+/// database, so the database may be memory-mapped directly from a file.
+///
+/// The v1 database is the v0 database with a string offset added to each
+/// entry, which gives O(1) access to any entry's string. Combined with entries
+/// sorted by token, this makes `Find` an `O(log n)` binary search over the
+/// data, without preprocessing the database.
+///
+/// @rst
+///   ======  ====  =========================
+///   Header (16 bytes)
+///   ---------------------------------------
+///   Offset  Size  Field
+///   ======  ====  =========================
+///        0     6  Magic number (``TOKENS``)
+///        6     2  Version (``01 00``)
+///        8     4  Entry count
+///       12     4  Reserved
+///   ======  ====  =========================
+///
+///   ======  ====  ==================================
+///   Entry (12 bytes)
+///   ------------------------------------------------
+///   Offset  Size  Field
+///   ======  ====  ==================================
+///        0     4  Token
+///        4     1  Removal day (1-31, 255 if unset)
+///        5     1  Removal month (1-12, 255 if unset)
+///        6     2  Removal year (65535 if unset)
+///        8     4  String offset in the string table
+///   ======  ====  ==================================
+/// @endrst
+///
+/// Entries must be sorted by token. A table of null-terminated strings follows
+/// the entries. All fields are little-endian.
+class IndexedTokenDatabase {
+ public:
+  using Entry = TokenDatabase::Entry;
+
+  /// Random access iterator for `IndexedTokenDatabase` values.
+  class iterator {
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = Entry;
+    using pointer = void;
+    using reference = Entry;
+    using iterator_category = std::random_access_iterator_tag;
+
+    constexpr iterator() = default;
+
+    iterator& operator+=(difference_type entries) {
+      raw_ += entries * static_cast<difference_type>(kEntrySize);
+      return *this;
+    }
+    iterator& operator-=(difference_type entries) { return *this += -entries; }
+    iterator& operator++() { return *this += 1; }
+    iterator& operator--() { return *this -= 1; }
+    iterator operator++(int) {
+      iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    iterator operator--(int) {
+      iterator previous = *this;
+      --*this;
+      return previous;
+    }
+    iterator operator+(difference_type entries) const {
+      return iterator(*this) += entries;
+    }
+    iterator operator-(difference_type entries) const {
+      return iterator(*this) -= entries;
+    }
+    difference_type operator-(const iterator& rhs) const {
+      return (raw_ - rhs.raw_) / static_cast<difference_type>(kEntrySize);
+    }
+
+    bool operator==(const iterator& rhs) const { return raw_ == rhs.raw_; }
+    bool operator!=(const iterator& rhs) const { return raw_ != rhs.raw_; }
+    bool operator<(const iterator& rhs) const { return raw_ < rhs.raw_; }
+
+    /// Reads the entry. The returned `Entry` is a value, not a reference into
+    /// the database, though its string points into the database.
+    Entry operator*() const;
+
+    Entry operator[](difference_type index) const { return *(*this + index); }
+
+   private:
+    friend class IndexedTokenDatabase;
+
+    constexpr iterator(const uint8_t* raw, const char* strings)
+        : raw_(raw), strings_(strings) {}
+
+    const uint8_t* raw_ = nullptr;
+    const char* strings_ = nullptr;
+  };
+
+  using value_type = Entry;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_iterator = iterator;
+
+  /// The entries returned from a `Find` operation. Unlike
+  /// `TokenDatabase::Entries`, indexing into the list is `O(1)`.
+  class Entries {
+   public:
+    constexpr Entries(const iterator& begin, const iterator& end)
+        : begin_(begin), end_(end) {}
+
+    size_type size() const { return static_cast<size_type>(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+
+    Entry operator[](size_type index) const {
+      return begin_[static_cast<difference_type>(index)];
+    }
+
+    const iterator& begin() const { return begin_; }
+    const iterator& end() const { return end_; }
+
+   private:
+    iterator begin_;
+    iterator end_;
+  };
+
+  /// Returns true if the provided data is a valid v1 token database. This
+  /// checks the header, that the data is large enough for the entries, and that
+  /// each entry's string is within the null-terminated string table. It does
+  /// not check that the entries are sorted.
+  static bool IsValid(span<const uint8_t> bytes);
+
+  /// Creates an `IndexedTokenDatabase` from the provided data, which must
+  /// outlive the database. If the data is not valid, returns a
+  /// default-constructed database for which `ok()` is false.
+  static IndexedTokenDatabase Create(span<const uint8_t> bytes);
+
+  template <typename ByteArray>
+  static IndexedTokenDatabase Create(const ByteArray& bytes) {
+    static_assert(sizeof(*std::data(bytes)) == 1u);
+    return Create(span(reinterpret_cast<const uint8_t*>(std::data(bytes)),
+                       std::size(bytes)));
+  }
+
+  /// Creates a database with no data. `ok()` returns false.
+  constexpr IndexedTokenDatabase() = default;
+
+  /// Returns all entries associated with this token. This is `O(log n)`.
+  Entries Find(uint32_t token) const;
+
+  /// Returns the total number of entries (unique token-string pairs).
+  size_type size() const { return static_cast<size_type>(end() - begin()); }
+
+  bool empty() const { return size() == 0u; }
+
+  /// True if this database was constructed with valid data.
+  constexpr bool ok() const { return entries_ != nullptr; }
+
+  iterator begin() const { return iterator(entries_, strings_); }
+  iterator end() const { return iterator(entries_end_, strings_); }
+
+ private:
+  static constexpr size_t kHeaderSize = 16;
+  static constexpr size_t kEntrySize = 12;
+
+  constexpr IndexedTokenDatabase(const uint8_t* entries,
+                                 const uint8_t* entries_end,
+                                 const char* strings)
+      : entries_(entries), entries_end_(entries_end), strings_(strings) {}
+
+  const uint8_t* entries_ = nullptr;
+  const uint8_t* entries_end_ = nullptr;
+  const char* strings_ = nullptr;
+};
+
+}  // namespace pw::tokenizer
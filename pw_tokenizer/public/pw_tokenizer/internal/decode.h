@@ -27,6 +27,7 @@
 
 #include "pw_preprocessor/compiler.h"
 #include "pw_span/span.h"
+#include "pw_tokenizer/encode_args.h"
 
 // Decoding errors are marked with prefix and suffix so that they stand out from
 // the rest of the decoded strings. These macros are used to build decoding
@@ -132,8 +133,12 @@ class StringSegment {
   StringSegment(const std::string_view& text) : StringSegment(text, kLiteral) {}
 
   // Returns the DecodedArg with this StringSegment decoded according to the
-  // provided arguments.
-  DecodedArg Decode(const span<const uint8_t>& arguments) const;
+  // provided arguments. previous_string is the previous string argument in the
+  // message, which V1 string arguments may share a prefix with; it is updated
+  // if this is a string argument.
+  DecodedArg Decode(const span<const uint8_t>& arguments,
+                    const ArgEncoding& encoding,
+                    std::string& previous_string) const;
 
   // Skips decoding this StringSegment. Literals and %% are expanded as normal.
   DecodedArg Skip() const;
@@ -171,11 +176,14 @@ class StringSegment {
   StringSegment(const std::string_view& text, Type type, ArgSize local_size)
       : text_(text), type_(type), local_size_(local_size) {}
 
-  DecodedArg DecodeString(const span<const uint8_t>& arguments) const;
+  DecodedArg DecodeString(const span<const uint8_t>& arguments,
+                          const ArgEncoding& encoding,
+                          std::string& previous_string) const;
 
   DecodedArg DecodeInteger(const span<const uint8_t>& arguments) const;
 
-  DecodedArg DecodeFloatingPoint(const span<const uint8_t>& arguments) const;
+  DecodedArg DecodeFloatingPoint(const span<const uint8_t>& arguments,
+                                 const ArgEncoding& encoding) const;
 
   std::string text_;
   Type type_;
@@ -203,7 +211,14 @@ class DecodedFormatString {
 
   // Returns the decoded format string, with error messages for any arguments
   // that failed to decode.
-  std::string value_with_errors() const;
+  std::string value_with_errors() const {
+    std::string output;
+    AppendValueWithErrors(output);
+    return output;
+  }
+
+  // Appends value_with_errors() to output, reusing its memory.
+  void AppendValueWithErrors(std::string& output) const;
 
   bool ok() const { return remaining_bytes() == 0u && decoding_errors() == 0u; }
 
@@ -229,12 +244,16 @@ class FormatString {
   FormatString(const char* format_string);
 
   // Formats this format string according to the provided encoded arguments and
-  // returns a string.
-  DecodedFormatString Format(span<const uint8_t> arguments) const;
+  // returns a string. The arguments must have been encoded with encoding.
+  DecodedFormatString Format(span<const uint8_t> arguments,
+                             const ArgEncoding& encoding = ArgEncoding()) const;
 
-  DecodedFormatString Format(const std::string_view& arguments) const {
+  DecodedFormatString Format(
+      const std::string_view& arguments,
+      const ArgEncoding& encoding = ArgEncoding()) const {
     return Format(span(reinterpret_cast<const uint8_t*>(arguments.data()),
-                       arguments.size()));
+                       arguments.size()),
+                  encoding);
   }
 
  private:
@@ -26,7 +26,7 @@ import tempfile
 import unittest
 from unittest import mock
 
-from pw_tokenizer import database
+from pw_tokenizer import database, tokens
 
 # This is an ELF file with only the pw_tokenizer sections. It was created
 # from a tokenize_test binary built for the STM32F429i Discovery board. The
@@ -288,6 +288,57 @@ class DatabaseCommandLineTest(unittest.TestCase):
             self._csv.read_text().splitlines(),
         )
 
+    def test_compact(self) -> None:
+        old = self._dir / 'old.csv'
+        old.write_text(
+            '00000001,2020-01-01,"removed three releases ago"\n'
+            '00000002,2021-01-01,"removed two releases ago"\n'
+            '00000003,2022-01-01,"removed last release"\n'
+            '00000004,          ,"present"\n'
+        )
+        new = self._dir / 'new.csv'
+        new.write_text(
+            '00000004,          ,"present"\n'
+            '00000005,          ,"added"\n'
+        )
+        binary = self._dir / 'db.bin'
+
+        run_cli(
+            'compact', '--database', binary, '--releases', '2', old, new
+        )
+
+        # Write the binary database as CSV to verify its contents.
+        run_cli('create', '--database', self._csv, binary)
+
+        self.assertEqual(
+            [
+                '00000003,2022-01-01,"removed last release"',
+                '00000004,          ,"present"',
+                '00000005,          ,"added"',
+            ],
+            self._csv.read_text().splitlines(),
+        )
+        with binary.open('rb') as fd:
+            self.assertEqual(tokens.binary_database_version(fd), 1)
+
+    def test_compact_too_few_releases_to_purge(self) -> None:
+        self._csv.write_text('00000001,2020-01-01,"removed"\n')
+
+        run_cli(
+            'compact',
+            '--database',
+            self._csv,
+            '--type',
+            'csv',
+            '--releases',
+            '2',
+            self._csv,
+        )
+
+        self.assertEqual(
+            '00000001,2020-01-01,"removed"\n', self._csv.read_text()
+        )
+
     @mock.patch('sys.stdout', new_callable=_mock_output)
     def test_report(self, mock_stdout) -> None:
         run_cli('report', self._elf)
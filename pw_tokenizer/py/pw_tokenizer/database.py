@@ -31,6 +31,7 @@ import struct
 import sys
 from typing import (
     Any,
+    BinaryIO,
     Callable,
     Dict,
     Iterable,
@@ -282,6 +283,19 @@ def generate_reports(paths: Iterable[Path]) -> _DatabaseReport:
     return reports
 
 
+def _write_database(
+    db: tokens.Database, fd: BinaryIO, output_type: str
+) -> None:
+    if output_type == 'csv':
+        tokens.write_csv(db, fd)
+    elif output_type == 'binary':
+        tokens.write_binary(db, fd)
+    elif output_type == 'binary-v1':
+        tokens.write_binary(db, fd, version=1)
+    else:
+        raise ValueError(f'Unknown database type "{output_type}"')
+
+
 def _handle_create(
     databases,
     database: Path,
@@ -320,12 +334,7 @@ def _handle_create(
     db.filter(include, exclude, replace)
 
     with fd:
-        if output_type == 'csv':
-            tokens.write_csv(db, fd)
-        elif output_type == 'binary':
-            tokens.write_binary(db, fd)
-        else:
-            raise ValueError(f'Unknown database type "{output_type}"')
+        _write_database(db, fd, output_type)
 
     _LOG.info(
         'Wrote database with %d entries to %s as %s',
@@ -393,6 +402,41 @@ def _handle_purge(
     _LOG.info('Removed %d entries from %s', len(purged), token_database.path)
 
 
+def _handle_compact(
+    databases: List[tokens.Database],
+    database: Path,
+    output_type: str,
+    releases: Optional[int],
+    before: Optional[datetime],
+) -> None:
+    """Merges databases and writes them without long-removed entries."""
+    db = tokens.Database.merged(*databases)
+    merged = len(db)
+
+    if releases is not None:
+        before = db.removal_date_cutoff(releases)
+
+    # If there are too few releases to purge any entries, before is None.
+    purged = db.purge(before) if before is not None else []
+
+    if not database.parent.exists():
+        database.parent.mkdir(parents=True)
+
+    with database.open('wb') as fd:
+        _write_database(db, fd, output_type)
+
+    _LOG.info(
+        'Merged %d databases into %d unique entries, purged %d, and wrote %d '
+        'entries to %s as %s',
+        len(databases),
+        merged,
+        len(purged),
+        len(db),
+        database,
+        output_type,
+    )
+
+
 def _handle_report(token_database_or_elf: List[Path], output: TextIO) -> None:
     json.dump(generate_reports(token_database_or_elf), output, indent=2)
     output.write('\n')
@@ -559,7 +603,7 @@ def _parse_args():
         '-t',
         '--type',
         dest='output_type',
-        choices=('csv', 'binary', 'directory'),
+        choices=('csv', 'binary', 'binary-v1', 'directory'),
         default='csv',
         help='Which type of database to create. (default: csv)',
     )
@@ -684,6 +728,54 @@ def _parse_args():
         ),
     )
 
+    # The 'compact' command merges databases and purges old entries.
+    subparser = subparsers.add_parser(
+        'compact',
+        parents=[option_tokens],
+        help=(
+            'Merges token databases, removes duplicate entries, and purges '
+            'entries that were removed long ago. By default, writes a sorted '
+            'binary-v1 database, which the C++ Detokenizer can search in '
+            'place with an IndexedTokenDatabase.'
+        ),
+    )
+    subparser.set_defaults(handler=_handle_compact)
+    subparser.add_argument(
+        '-d',
+        '--database',
+        required=True,
+        type=Path,
+        help='Path to the database file to write; may be one of the inputs.',
+    )
+    subparser.add_argument(
+        '-t',
+        '--type',
+        dest='output_type',
+        choices=('csv', 'binary', 'binary-v1'),
+        default='binary-v1',
+        help='Which type of database to write. (default: binary-v1)',
+    )
+    purge_group = subparser.add_mutually_exclusive_group(required=True)
+    purge_group.add_argument(
+        '-r',
+        '--releases',
+        type=int,
+        help=(
+            'Purge entries that have been missing from this many releases. '
+            'Each distinct removal date in the merged database, as set by '
+            'mark_removed, counts as one release.'
+        ),
+    )
+    purge_group.add_argument(
+        '-b',
+        '--before',
+        type=year_month_day,
+        help=(
+            'Purge all entries removed on or before this date. '
+            'May be YYYY-MM-DD or "today".'
+        ),
+    )
+
     # The 'report' command prints a report about a database.
     subparser = subparsers.add_parser(
         'report', help='Prints a report about a database.'
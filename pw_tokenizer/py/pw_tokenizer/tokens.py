@@ -274,6 +274,24 @@ class Database:
 
         return to_delete
 
+    def removal_date_cutoff(self, releases: int) -> Optional[datetime]:
+        """Returns the date to purge entries missing from `releases` releases.
+
+        mark_removed gives every string removed from a build the same date, so
+        each distinct removal date in the database is treated as a release.
+        Entries removed on or before the returned date have been missing from
+        at least `releases` releases. Returns None if the database has fewer
+        than `releases` removal dates.
+        """
+        if releases < 1:
+            raise ValueError(f'releases must be at least 1, not {releases}')
+
+        dates = sorted(
+            {e.date_removed for e in self._database.values() if e.date_removed},
+            reverse=True,
+        )
+        return dates[releases - 1] if len(dates) >= releases else None
+
     def merge(self, *databases: 'Database') -> None:
         """Merges two or more databases together, keeping the newest dates."""
         self._cache = None
@@ -405,20 +423,37 @@ class _BinaryFileFormat(NamedTuple):
 
 BINARY_FORMAT = _BinaryFileFormat()
 
+# The v1 binary format adds each string's offset in the string table to its
+# entry, so entries can be looked up directly in memory-mapped databases.
+BINARY_FORMAT_V1 = _BinaryFileFormat(
+    magic=b'TOKENS\1\0', entry=struct.Struct('<IBBHI')
+)
+
+_BINARY_FORMATS = {0: BINARY_FORMAT, 1: BINARY_FORMAT_V1}
+
 
 class DatabaseFormatError(Exception):
     """Failed to parse a token database file."""
 
 
-def file_is_binary_database(fd: BinaryIO) -> bool:
-    """True if the file starts with the binary token database magic string."""
+def binary_database_version(fd: BinaryIO) -> Optional[int]:
+    """Returns the binary database version, or None if fd isn't one."""
     try:
         fd.seek(0)
         magic = fd.read(len(BINARY_FORMAT.magic))
         fd.seek(0)
-        return BINARY_FORMAT.magic == magic
     except IOError:
-        return False
+        return None
+
+    for version, binary_format in _BINARY_FORMATS.items():
+        if binary_format.magic == magic:
+            return version
+    return None
+
+
+def file_is_binary_database(fd: BinaryIO) -> bool:
+    """True if the file starts with a binary token database magic string."""
+    return binary_database_version(fd) is not None
 
 
 def _check_that_file_is_csv_database(path: Path) -> None:
@@ -445,22 +480,26 @@ def _check_that_file_is_csv_database(path: Path) -> None:
 
 
 def parse_binary(fd: BinaryIO) -> Iterable[TokenizedStringEntry]:
-    """Parses TokenizedStringEntries from a binary token database file."""
+    """Parses TokenizedStringEntries from a v0 or v1 binary token database."""
     magic, entry_count = BINARY_FORMAT.header.unpack(
         fd.read(BINARY_FORMAT.header.size)
     )
 
-    if magic != BINARY_FORMAT.magic:
+    binary_format = next(
+        (f for f in _BINARY_FORMATS.values() if f.magic == magic), None
+    )
+    if binary_format is None:
         raise DatabaseFormatError(
             f'Binary token database magic number mismatch (found {magic!r}, '
-            f'expected {BINARY_FORMAT.magic!r}) while reading from {fd}'
+            f'expected {BINARY_FORMAT.magic!r} or {BINARY_FORMAT_V1.magic!r}) '
+            f'while reading from {fd}'
         )
 
     entries = []
 
     for _ in range(entry_count):
-        token, day, month, year = BINARY_FORMAT.entry.unpack(
-            fd.read(BINARY_FORMAT.entry.size)
+        token, day, month, year, *string_offset = binary_format.entry.unpack(
+            fd.read(binary_format.entry.size)
         )
 
         try:
@@ -468,7 +507,7 @@ def parse_binary(fd: BinaryIO) -> Iterable[TokenizedStringEntry]:
         except ValueError:
             date_removed = None
 
-        entries.append((token, date_removed))
+        entries.append((token, date_removed, string_offset))
 
     # Read the entire string table and define a function for looking up strings.
     string_table = fd.read()
@@ -481,16 +520,24 @@ def parse_binary(fd: BinaryIO) -> Iterable[TokenizedStringEntry]:
         )
 
     offset = 0
-    for token, removed in entries:
-        string, offset = read_string(offset)
+    for token, removed, string_offset in entries:
+        # v1 entries store their string's offset; v0 strings are in order.
+        string, offset = read_string(
+            string_offset[0] if string_offset else offset
+        )
         yield TokenizedStringEntry(token, string, DEFAULT_DOMAIN, removed)
 
 
-def write_binary(database: Database, fd: BinaryIO) -> None:
-    """Writes the database as packed binary to the provided binary file."""
+def write_binary(database: Database, fd: BinaryIO, version: int = 0) -> None:
+    """Writes the database as packed binary to the provided binary file.
+
+    Version 1 databases store the offset of each entry's string, which allows
+    C++ to search them in place with pw::tokenizer::IndexedTokenDatabase.
+    """
+    binary_format = _BINARY_FORMATS[version]
     entries = sorted(database.entries())
 
-    fd.write(BINARY_FORMAT.header.pack(BINARY_FORMAT.magic, len(entries)))
+    fd.write(binary_format.header.pack(binary_format.magic, len(entries)))
 
     string_table = bytearray()
 
@@ -507,14 +554,14 @@ def write_binary(database: Database, fd: BinaryIO) -> None:
             removed_month = 0xFF
             removed_year = 0xFFFF
 
+        fields = [entry.token, removed_day, removed_month, removed_year]
+        if version == 1:
+            fields.append(len(string_table))
+
         string_table += entry.string.encode()
         string_table.append(0)
 
-        fd.write(
-            BINARY_FORMAT.entry.pack(
-                entry.token, removed_day, removed_month, removed_year
-            )
-        )
+        fd.write(binary_format.entry.pack(*fields))
 
     fd.write(string_table)
 
@@ -540,8 +587,9 @@ class DatabaseFile(Database):
 
         # Read the path as a packed binary file.
         with path.open('rb') as fd:
-            if file_is_binary_database(fd):
-                return _BinaryDatabase(path, fd)
+            version = binary_database_version(fd)
+            if version is not None:
+                return _BinaryDatabase(path, fd, version)
 
         # Read the path as a CSV file.
         _check_that_file_is_csv_database(path)
@@ -563,14 +611,15 @@ class DatabaseFile(Database):
 
 
 class _BinaryDatabase(DatabaseFile):
-    def __init__(self, path: Path, fd: BinaryIO) -> None:
+    def __init__(self, path: Path, fd: BinaryIO, version: int = 0) -> None:
         super().__init__(path, parse_binary(fd))
+        self._version = version
 
     def write_to_file(self, *, rewrite: bool = False) -> None:
         """Exports in the binary format to the original path."""
         del rewrite  # Binary databases are always rewritten
         with self.path.open('wb') as fd:
-            write_binary(self, fd)
+            write_binary(self, fd, self._version)
 
     def add_and_discard_temporary(
         self, entries: Iterable[TokenizedStringEntry], commit: str
@@ -266,6 +266,18 @@ class TokenDatabaseTest(unittest.TestCase):
         self.assertEqual(db.token_to_entries[0xCC6D3131][0].string, 'Jello?')
         self.assertFalse(db.token_to_entries[0xE65AEFEF])
 
+    def test_removal_date_cutoff(self) -> None:
+        db = read_db_from_csv(CSV_DATABASE)
+
+        # The removal dates are 2020-01-01, 2019-06-12, 2019-06-11, 2019-06-10.
+        self.assertEqual(db.removal_date_cutoff(1), datetime(2020, 1, 1))
+        self.assertEqual(db.removal_date_cutoff(3), datetime(2019, 6, 11))
+        self.assertEqual(db.removal_date_cutoff(4), datetime(2019, 6, 10))
+        self.assertIsNone(db.removal_date_cutoff(5))
+
+        with self.assertRaises(ValueError):
+            db.removal_date_cutoff(0)
+
     def test_merge(self) -> None:
         """Tests the tokens.Database merge method."""
 
@@ -556,6 +568,20 @@ class TokenDatabaseTest(unittest.TestCase):
 
         self.assertEqual(str(db), CSV_DATABASE)
 
+    def test_binary_v1_format_round_trip(self) -> None:
+        db = read_db_from_csv(CSV_DATABASE)
+
+        with io.BytesIO() as fd:
+            tokens.write_binary(db, fd, version=1)
+            binary_db = fd.getvalue()
+
+        self.assertTrue(binary_db.startswith(b'TOKENS\1\0'))
+        with io.BytesIO(binary_db) as fd:
+            self.assertEqual(tokens.binary_database_version(fd), 1)
+            parsed = tokens.Database(tokens.parse_binary(fd))
+
+        self.assertEqual(str(parsed), CSV_DATABASE)
+
 
 class TestDatabaseFile(unittest.TestCase):
     """Tests the DatabaseFile class."""
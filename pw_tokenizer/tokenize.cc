@@ -63,6 +63,9 @@ constexpr Metadata metadata[] PW_TOKENIZER_INFO_SECTION = {
     {"sizeof_intmax_t", sizeof(intmax_t)},    // %j conversion specifier
     {"sizeof_size_t", sizeof(size_t)},        // %z conversion specifier
     {"sizeof_ptrdiff_t", sizeof(ptrdiff_t)},  // %t conversion specifier
+    {"arg_encoding", PW_TOKENIZER_CFG_ARG_ENCODING},
+    {"float_encoding", PW_TOKENIZER_CFG_FLOAT_ENCODING},
+    {"fixed_point_bits", PW_TOKENIZER_CFG_FIXED_POINT_FRACTIONAL_BITS},
 };
 
 }  // namespace
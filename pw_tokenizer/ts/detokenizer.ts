@@ -37,9 +37,16 @@ interface TokenAndArgs {
 
 export class Detokenizer {
   private database: TokenDatabase;
+  // Decoders are stateless between calls, so share them across messages.
+  private printfDecoder = new PrintfDecoder();
+  private textDecoder = new TextDecoder();
 
-  constructor(csvDatabase: string) {
-    this.database = new TokenDatabase(csvDatabase);
+  /**
+   * Creates a detokenizer from a CSV token database or a binary token
+   * database. Binary databases are smaller and faster to load.
+   */
+  constructor(database: string | Uint8Array) {
+    this.database = new TokenDatabase(database);
   }
 
   /**
@@ -61,14 +68,24 @@ export class Detokenizer {
    * returned as string as-is.
    */
   detokenizeUint8Array(data: Uint8Array): string {
-    const { token, args } = this.decodeUint8Array(data);
-    // Parse arguments if this is printf-style text.
-    const format = this.database.get(token);
-    if (format) {
-      return new PrintfDecoder().decode(String(format), args);
+    if (data.length >= 4) {
+      const { token, args } = this.decodeUint8Array(data);
+      // Parse arguments if this is printf-style text.
+      const format = this.database.get(token);
+      if (format !== undefined) {
+        return this.printfDecoder.decode(format, args);
+      }
     }
 
-    return new TextDecoder().decode(data);
+    return this.textDecoder.decode(data);
+  }
+
+  /**
+   * Detokenize a batch of binary messages, such as all entries from one log
+   * RPC response. Equivalent to calling `detokenizeUint8Array` on each.
+   */
+  detokenizeUint8Arrays(messages: Uint8Array[]): string[] {
+    return messages.map((data) => this.detokenizeUint8Array(data));
   }
 
   /**
@@ -82,7 +99,7 @@ export class Detokenizer {
     tokenizedFrame: Frame,
     maxRecursion: number = MAX_RECURSIONS,
   ): string {
-    const base64String = new TextDecoder().decode(tokenizedFrame.data);
+    const base64String = this.textDecoder.decode(tokenizedFrame.data);
     return this.detokenizeBase64String(base64String, maxRecursion);
   }
 
@@ -94,11 +111,8 @@ export class Detokenizer {
       const { token, args } = this.decodeBase64TokenFrame(base64Substring);
       const format = this.database.get(token);
       // Parse arguments if this is printf-style text.
-      if (format) {
-        const decodedOriginal = new PrintfDecoder().decode(
-          String(format),
-          args,
-        );
+      if (format !== undefined) {
+        const decodedOriginal = this.printfDecoder.decode(format, args);
         // Detokenize nested Base64 tokens and their arguments.
         if (recursions > 0) {
           return this.detokenizeBase64String(decodedOriginal, recursions - 1);
@@ -109,30 +123,24 @@ export class Detokenizer {
     });
   }
 
+  // Splits the token from its arguments without copying the arguments.
   private decodeUint8Array(data: Uint8Array): TokenAndArgs {
     const token = new DataView(data.buffer, data.byteOffset, 4).getUint32(
       0,
       true,
     );
-    const args = new Uint8Array(data.buffer.slice(data.byteOffset + 4));
+    const args = data.subarray(4);
 
     return { token, args };
   }
 
   private decodeBase64TokenFrame(base64Data: string): TokenAndArgs {
     // Remove the prefix '$' and convert from Base64.
-    const prefixRemoved = base64Data.slice(1);
-    const noBase64 = Buffer.from(prefixRemoved, 'base64').toString('binary');
-    // Convert back to bytes and return token and arguments.
-    const bytes = noBase64.split('').map((ch) => ch.charCodeAt(0));
-    const uIntArray = new Uint8Array(bytes);
-    const token = new DataView(
-      uIntArray.buffer,
-      uIntArray.byteOffset,
-      4,
-    ).getUint32(0, true);
-    const args = new Uint8Array(bytes.slice(4));
-
-    return { token, args };
+    const bytes = Buffer.from(base64Data.slice(1), 'base64');
+    if (bytes.length < 4) {
+      // Too short to hold a token. Tokens are unsigned, so -1 never matches.
+      return { token: -1, args: bytes };
+    }
+    return this.decodeUint8Array(bytes);
   }
 }
@@ -32,6 +32,25 @@ function generateFrame(text: string): Frame {
   return decodedFrames[0];
 }
 
+// Builds a binary token database, as written by database.py.
+function binaryDatabase(entries: [number, string][]): Uint8Array {
+  const strings = entries.map(([, text]) => new TextEncoder().encode(text));
+  const size =
+    16 + entries.length * 8 + strings.reduce((n, s) => n + s.length + 1, 0);
+  const data = new Uint8Array(size);
+  const view = new DataView(data.buffer);
+  data.set(new TextEncoder().encode('TOKENS'));
+  view.setUint32(8, entries.length, true);
+  let offset = 16 + entries.length * 8;
+  entries.forEach(([token], i) => {
+    view.setUint32(16 + i * 8, token, true);
+    view.setUint32(20 + i * 8, 0xffffffff, true);
+    data.set(strings[i], offset);
+    offset += strings[i].length + 1;
+  });
+  return data;
+}
+
 describe('Detokenizer', () => {
   let detokenizer: Detokenizer;
 
@@ -77,4 +96,40 @@ describe('Detokenizer', () => {
       'Regular Token: Cat and Nested Token: (token: $7YYdRQ==, string: Camel, int: 44, float: 1.2300000190734863)',
     );
   });
+
+  it('detokenizes a batch of messages', () => {
+    const encoder = new TextEncoder();
+    expect(
+      detokenizer.detokenizeUint8Arrays([
+        encoder.encode('abcde'),
+        encoder.encode('aabbcc'),
+        encoder.encode('ab'),
+      ]),
+    ).toEqual(['regular token', 'aabbcc', 'ab']);
+  });
+
+  it('leaves Base64 too short for a token as-is', () => {
+    expect(detokenizer.detokenizeBase64(generateFrame('$AAA='))).toEqual(
+      '$AAA=',
+    );
+  });
+
+  it('loads a binary token database', () => {
+    const binary = new Detokenizer(
+      binaryDatabase([
+        [0x64636261, 'regular token'],
+        [0x86fc33f3, 'base64 token'],
+      ]),
+    );
+    expect(binary.detokenize(generateFrame('abcde'))).toEqual(
+      'regular token',
+    );
+    expect(binary.detokenizeBase64(generateFrame('$8zP8hg=='))).toEqual(
+      'base64 token',
+    );
+  });
+
+  it('rejects binary data without a database header', () => {
+    expect(() => new Detokenizer(new Uint8Array(16))).toThrow();
+  });
 });
@@ -21,6 +21,7 @@ const SPECIFIER_REGEX =
 const SIGNED_INT = 'di'.split('');
 const UNSIGNED_INT = 'oxXup'.split('');
 const FLOATING_POINT = 'fFeEaAgG'.split('');
+const TEXT_DECODER = new TextDecoder();
 
 enum DecodedStatusFlags {
   // Status flags for a decoded argument. These values should match the
@@ -66,13 +67,13 @@ export class PrintfDecoder {
       sizeAndStatus &= 0x7f;
     }
 
-    const rawData = args.slice(0, sizeAndStatus + 1);
-    const data = rawData.slice(1);
+    const rawData = args.subarray(0, sizeAndStatus + 1);
+    const data = rawData.subarray(1);
     if (data.length < sizeAndStatus) {
       status |= DecodedStatusFlags.DECODE_ERROR;
     }
 
-    const decoded = new TextDecoder().decode(data);
+    const decoded = TEXT_DECODER.decode(data);
     return { size: rawData.length, value: decoded };
   }
 
@@ -185,7 +186,8 @@ export class PrintfDecoder {
           precision,
           lengthSpecifier,
         );
-        args = args.slice(decodedArg.size);
+        // Advance past the argument without copying the remaining data.
+        args = args.subarray(decodedArg.size);
         if (decodedArg === null) return '';
         return String(decodedArg.value);
       },
@@ -12,13 +12,36 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
-/** Parses CSV Database for easier lookups */
+/** Parses CSV or binary databases for easier lookups */
+
+// The binary database starts with "TOKENS", a two-byte version, a uint32 entry
+// count, and four reserved bytes. See pw_tokenizer/token_database.h.
+const BINARY_MAGIC = 'TOKENS\0\0';
+const BINARY_HEADER_SIZE = 16;
+const BINARY_ENTRY_SIZE = 8;
 
 export class TokenDatabase {
   private tokens: Map<number, string> = new Map();
 
-  constructor(readonly csv: string) {
-    this.parseTokensToTokensMap(csv.split(/\r?\n/));
+  /**
+   * Loads a token database from CSV text or from the binary format produced by
+   * `database.py create --type binary`.
+   */
+  constructor(database: string | Uint8Array) {
+    if (typeof database === 'string') {
+      this.parseTokensToTokensMap(database.split(/\r?\n/));
+    } else {
+      this.parseBinaryDatabase(database);
+    }
+  }
+
+  /** Returns true if the data starts with the binary database magic. */
+  static isBinary(data: Uint8Array): boolean {
+    if (data.length < BINARY_HEADER_SIZE) return false;
+    for (let i = 0; i < BINARY_MAGIC.length; i++) {
+      if (data[i] !== BINARY_MAGIC.charCodeAt(i)) return false;
+    }
+    return true;
   }
 
   has(token: number): boolean {
@@ -54,4 +77,32 @@ export class TokenDatabase {
       this.tokens.set(tokenNumber, data);
     }
   }
+
+  private parseBinaryDatabase(data: Uint8Array) {
+    if (!TokenDatabase.isBinary(data)) {
+      throw new Error('TokenDatabase binary data has an invalid header');
+    }
+    const view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+    const entryCount = view.getUint32(8, true);
+    let stringOffset = BINARY_HEADER_SIZE + entryCount * BINARY_ENTRY_SIZE;
+    if (stringOffset > data.length) {
+      throw new Error(
+        `TokenDatabase binary data is truncated; expected ${entryCount} ` +
+          'entries',
+      );
+    }
+
+    // Entries are followed by their null-terminated strings, in order.
+    const decoder = new TextDecoder();
+    for (let i = 0; i < entryCount; i++) {
+      const token = view.getUint32(
+        BINARY_HEADER_SIZE + i * BINARY_ENTRY_SIZE,
+        true,
+      );
+      let end = data.indexOf(0, stringOffset);
+      if (end === -1) end = data.length;
+      this.tokens.set(token, decoder.decode(data.subarray(stringOffset, end)));
+      stringOffset = end + 1;
+    }
+  }
 }
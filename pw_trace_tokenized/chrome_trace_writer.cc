@@ -0,0 +1,341 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_trace_tokenized/chrome_trace_writer.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "pw_bytes/endian.h"
+#include "pw_status/try.h"
+#include "pw_varint/varint.h"
+
+namespace pw::trace {
+namespace {
+
+constexpr size_t kTokenIndexEventType = 0;
+constexpr size_t kTokenIndexModule = 2;
+constexpr size_t kTokenIndexGroup = 3;
+constexpr size_t kTokenIndexLabel = 4;
+constexpr size_t kTokenIndexDataFormat = 5;
+
+// Appends a JSON string, escaping any characters that JSON requires.
+void AppendString(std::string& line, std::string_view value) {
+  line.push_back('"');
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      line.push_back('\\');
+      line.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[sizeof("\\u0000")];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      line.append(escaped);
+    } else {
+      line.push_back(c);
+    }
+  }
+  line.push_back('"');
+}
+
+void AppendKey(std::string& line, std::string_view key) {
+  line.push_back(',');
+  AppendString(line, key);
+  line.push_back(':');
+}
+
+}  // namespace
+
+ChromeTraceWriter::ChromeTraceWriter(const tokenizer::Detokenizer& detokenizer,
+                                     stream::Writer& output,
+                                     uint32_t ticks_per_second,
+                                     double time_offset_us)
+    : detokenizer_(detokenizer),
+      output_(output),
+      microseconds_per_tick_(1e6 / ticks_per_second),
+      time_offset_us_(time_offset_us) {}
+
+StatusWithSize ChromeTraceWriter::WriteEntries(ConstByteSpan entries) {
+  size_t consumed = 0;
+  while (consumed < entries.size()) {
+    ConstByteSpan remaining = entries.subspan(consumed);
+    uint64_t entry_size = 0;
+    const size_t prefix_size = varint::Decode(remaining, &entry_size);
+    if (prefix_size == 0) {
+      if (remaining.size() >= varint::kMaxVarint64SizeBytes) {
+        return StatusWithSize::DataLoss(consumed);
+      }
+      break;  // The size prefix is incomplete.
+    }
+    if (entry_size > remaining.size() - prefix_size) {
+      break;  // The entry is incomplete.
+    }
+    if (Status status =
+            WriteEntry(remaining.subspan(prefix_size, entry_size));
+        !status.ok()) {
+      return StatusWithSize(status, consumed);
+    }
+    consumed += prefix_size + entry_size;
+  }
+  return StatusWithSize(consumed);
+}
+
+Status ChromeTraceWriter::WriteEntry(ConstByteSpan entry) {
+  if (entry.size() < sizeof(uint32_t)) {
+    skipped_entries_ += 1;
+    return OkStatus();
+  }
+  const uint32_t token =
+      bytes::ReadInOrder<uint32_t>(endian::little, entry.data());
+  entry = entry.subspan(sizeof(token));
+
+  uint64_t delta = 0;
+  size_t bytes_read = varint::Decode(entry, &delta);
+  if (bytes_read == 0) {
+    skipped_entries_ += 1;
+    return OkStatus();
+  }
+  entry = entry.subspan(bytes_read);
+  // Keep time in ticks, so rounding errors don't accumulate across events.
+  ticks_ += delta;
+
+  const TokenInfo& info = LookUpToken(token);
+  if (info.type == EventType::kInvalid) {
+    skipped_entries_ += 1;
+    return OkStatus();
+  }
+
+  const bool is_async = info.type == EventType::kAsyncStart ||
+                        info.type == EventType::kAsyncStep ||
+                        info.type == EventType::kAsyncEnd;
+  uint64_t trace_id = 0;
+  if (is_async && !entry.empty()) {
+    bytes_read = varint::Decode(entry, &trace_id);
+    if (bytes_read == 0) {
+      skipped_entries_ += 1;
+      return OkStatus();
+    }
+    entry = entry.subspan(bytes_read);
+  }
+
+  std::string_view name = info.label;
+  std::string_view tid;
+  bool has_tid = true;
+  const char* phase = "I";
+  switch (info.type) {
+    case EventType::kDurationStart:
+      phase = "B";
+      tid = info.label;
+      break;
+    case EventType::kDurationEnd:
+      phase = "E";
+      tid = info.label;
+      break;
+    case EventType::kDurationGroupStart:
+      phase = "B";
+      tid = info.group;
+      break;
+    case EventType::kDurationGroupEnd:
+      phase = "E";
+      tid = info.group;
+      break;
+    case EventType::kInstant:
+      has_tid = false;
+      break;
+    case EventType::kInstantGroup:
+      tid = info.group;
+      break;
+    case EventType::kAsyncStart:
+      phase = "b";
+      tid = info.group;
+      break;
+    case EventType::kAsyncStep:
+      phase = "n";
+      tid = info.group;
+      break;
+    case EventType::kAsyncEnd:
+      phase = "e";
+      tid = info.group;
+      break;
+    case EventType::kInvalid:
+      break;
+  }
+
+  // Arguments attached by the pw_trace data macros can replace the event's
+  // name or group, or make it a counter. Other data is written as hex.
+  const std::string_view data(reinterpret_cast<const char*>(entry.data()),
+                              entry.size());
+  bool is_counter = false;
+  bool has_hex_data = false;
+  if (info.has_data) {
+    if (info.data_format == "@pw_arg_label") {
+      name = data;
+    } else if (info.data_format == "@pw_arg_group") {
+      tid = data;
+      has_tid = true;
+    } else if (info.data_format == "@pw_arg_counter") {
+      phase = "C";
+      is_counter = true;
+    } else {
+      has_hex_data = true;
+    }
+  }
+
+  line_.clear();
+  line_.append(events_written_ == 0 ? "[\n{" : ",\n{");
+  AppendString(line_, "pid");
+  line_.push_back(':');
+  AppendString(line_, info.module);
+  AppendKey(line_, "name");
+  AppendString(line_, name);
+  AppendKey(line_, "ts");
+  char number[32];
+  std::snprintf(number,
+                sizeof(number),
+                "%.3f",
+                time_offset_us_ + static_cast<double>(ticks_) *
+                                      microseconds_per_tick_);
+  line_.append(number);
+  AppendKey(line_, "ph");
+  AppendString(line_, phase);
+  if (info.type == EventType::kInstant) {
+    AppendKey(line_, "s");
+    AppendString(line_, "p");
+  } else if (info.type == EventType::kInstantGroup) {
+    AppendKey(line_, "s");
+    AppendString(line_, "t");
+  } else if (is_async) {
+    AppendKey(line_, "scope");
+    AppendString(line_, info.group);
+  }
+  if (has_tid) {
+    AppendKey(line_, "tid");
+    AppendString(line_, tid);
+  }
+  char id[24];
+  if (is_async) {
+    std::snprintf(id, sizeof(id), "%" PRIu64, trace_id);
+    AppendKey(line_, "cat");
+    AppendString(line_, info.module);
+    AppendKey(line_, "id");
+    line_.append(id);
+  }
+
+  if (is_counter) {
+    uint64_t value = 0;
+    std::memcpy(&value, entry.data(), std::min(entry.size(), sizeof(value)));
+    value = bytes::ConvertOrderFrom(endian::little, value);
+    std::snprintf(number, sizeof(number), "%" PRIu64, value);
+    AppendKey(line_, "args");
+    line_.push_back('{');
+    AppendString(line_, name);
+    line_.push_back(':');
+    line_.append(number);
+    line_.push_back('}');
+  } else if (has_hex_data) {
+    AppendKey(line_, "args");
+    line_.append("{\"data\":\"");
+    for (std::byte b : entry) {
+      std::snprintf(number, sizeof(number), "%02x", static_cast<unsigned>(b));
+      line_.append(number);
+    }
+    line_.append("\"}");
+  } else if (is_async) {
+    AppendKey(line_, "args");
+    line_.append("{\"id\":");
+    line_.append(id);
+    line_.push_back('}');
+  }
+  line_.push_back('}');
+
+  PW_TRY(WriteLine());
+  events_written_ += 1;
+  return OkStatus();
+}
+
+Status ChromeTraceWriter::Finish() {
+  line_ = events_written_ == 0 ? "[]\n" : "\n]\n";
+  return WriteLine();
+}
+
+const ChromeTraceWriter::TokenInfo& ChromeTraceWriter::LookUpToken(
+    uint32_t token) {
+  auto [entry, inserted] = tokens_.try_emplace(token);
+  TokenInfo& info = entry->second;
+  if (!inserted) {
+    return info;
+  }
+
+  const auto encoded_token = bytes::CopyInOrder(endian::little, token);
+  const std::string token_string =
+      detokenizer_
+          .Detokenize(
+              span(reinterpret_cast<const uint8_t*>(encoded_token.data()),
+                   encoded_token.size()))
+          .BestString();
+
+  std::string_view fields[kTokenIndexDataFormat + 1];
+  size_t field_count = 0;
+  std::string_view remaining = token_string;
+  while (field_count < std::size(fields)) {
+    const size_t end = field_count == kTokenIndexDataFormat
+                           ? std::string_view::npos
+                           : remaining.find('|');
+    fields[field_count++] = remaining.substr(0, end);
+    if (end == std::string_view::npos) {
+      break;
+    }
+    remaining.remove_prefix(end + 1);
+  }
+  if (field_count <= kTokenIndexLabel) {
+    return info;  // Not a trace token; leave it marked invalid.
+  }
+
+  static constexpr std::pair<std::string_view, EventType> kEventTypes[] = {
+      {"PW_TRACE_EVENT_TYPE_INSTANT", EventType::kInstant},
+      {"PW_TRACE_EVENT_TYPE_INSTANT_GROUP", EventType::kInstantGroup},
+      {"PW_TRACE_EVENT_TYPE_ASYNC_START", EventType::kAsyncStart},
+      {"PW_TRACE_EVENT_TYPE_ASYNC_STEP", EventType::kAsyncStep},
+      {"PW_TRACE_EVENT_TYPE_ASYNC_END", EventType::kAsyncEnd},
+      {"PW_TRACE_EVENT_TYPE_DURATION_START", EventType::kDurationStart},
+      {"PW_TRACE_EVENT_TYPE_DURATION_END", EventType::kDurationEnd},
+      {"PW_TRACE_EVENT_TYPE_DURATION_GROUP_START",
+       EventType::kDurationGroupStart},
+      {"PW_TRACE_EVENT_TYPE_DURATION_GROUP_END", EventType::kDurationGroupEnd},
+  };
+  for (const auto& [type_name, type] : kEventTypes) {
+    if (fields[kTokenIndexEventType] == type_name) {
+      info.type = type;
+      break;
+    }
+  }
+  info.module = fields[kTokenIndexModule];
+  info.group = fields[kTokenIndexGroup];
+  info.label = fields[kTokenIndexLabel];
+  if (field_count > kTokenIndexDataFormat) {
+    info.has_data = true;
+    info.data_format = fields[kTokenIndexDataFormat];
+  }
+  return info;
+}
+
+Status ChromeTraceWriter::WriteLine() {
+  return output_.Write(as_bytes(span(line_.data(), line_.size())));
+}
+
+}  // namespace pw::trace
@@ -0,0 +1,182 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_trace_tokenized/chrome_trace_writer.h"
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "pw_bytes/endian.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_unit_test/framework.h"
+#include "pw_varint/varint.h"
+
+namespace pw::trace {
+namespace {
+
+using tokenizer::Detokenizer;
+using tokenizer::TokenizedStringEntry;
+
+constexpr uint32_t kInstant = 1;
+constexpr uint32_t kDurationStart = 2;
+constexpr uint32_t kDurationEnd = 3;
+constexpr uint32_t kAsyncStart = 4;
+constexpr uint32_t kCounter = 5;
+constexpr uint32_t kHexData = 6;
+constexpr uint32_t kNotATraceToken = 7;
+
+Detokenizer TestDetokenizer() {
+  std::unordered_map<uint32_t, std::vector<TokenizedStringEntry>> database;
+  auto add = [&database](uint32_t token, const char* string) {
+    database[token].emplace_back(string, 0);
+  };
+  add(kInstant, "PW_TRACE_EVENT_TYPE_INSTANT|0|mod|grp|Tick");
+  add(kDurationStart, "PW_TRACE_EVENT_TYPE_DURATION_START|0|mod|grp|Work");
+  add(kDurationEnd, "PW_TRACE_EVENT_TYPE_DURATION_END|0|mod|grp|Work");
+  add(kAsyncStart, "PW_TRACE_EVENT_TYPE_ASYNC_START|0|mod|grp|\"Job\"");
+  add(kCounter,
+      "PW_TRACE_EVENT_TYPE_INSTANT|0|mod|grp|Depth|@pw_arg_counter");
+  add(kHexData, "PW_TRACE_EVENT_TYPE_INSTANT|0|mod|grp|Blob|@pw_py_fmt:H");
+  add(kNotATraceToken, "Hello, world");
+  return Detokenizer(std::move(database));
+}
+
+// Encodes a trace entry the way TokenizedTracer does, with a size prefix.
+void AppendEntry(std::vector<std::byte>& buffer,
+                 uint32_t token,
+                 uint32_t delta,
+                 std::optional<uint32_t> trace_id = std::nullopt,
+                 ConstByteSpan data = {}) {
+  std::byte entry[32];
+  const auto token_bytes = bytes::CopyInOrder(endian::little, token);
+  std::copy(token_bytes.begin(), token_bytes.end(), entry);
+  size_t size = token_bytes.size();
+  size += varint::Encode(delta, span(entry).subspan(size));
+  if (trace_id.has_value()) {
+    size += varint::Encode(*trace_id, span(entry).subspan(size));
+  }
+  std::copy(data.begin(), data.end(), entry + size);
+  size += data.size();
+
+  buffer.push_back(static_cast<std::byte>(size));
+  buffer.insert(buffer.end(), entry, entry + size);
+}
+
+class ChromeTraceWriterTest : public ::testing::Test {
+ protected:
+  ChromeTraceWriterTest()
+      : detokenizer_(TestDetokenizer()),
+        writer_(detokenizer_, output_, /*ticks_per_second=*/1000) {}
+
+  std::string_view Output() const {
+    return std::string_view(reinterpret_cast<const char*>(output_.data()),
+                            output_.bytes_written());
+  }
+
+  Detokenizer detokenizer_;
+  stream::MemoryWriterBuffer<1024> output_;
+  ChromeTraceWriter writer_;
+};
+
+TEST_F(ChromeTraceWriterTest, NoEvents) {
+  ASSERT_EQ(writer_.Finish(), OkStatus());
+  EXPECT_EQ(Output(), "[]\n");
+}
+
+TEST_F(ChromeTraceWriterTest, WritesEvents) {
+  std::vector<std::byte> buffer;
+  AppendEntry(buffer, kDurationStart, 0);
+  AppendEntry(buffer, kInstant, 2);
+  AppendEntry(buffer, kAsyncStart, 1, 17);
+  AppendEntry(buffer, kDurationEnd, 3);
+
+  StatusWithSize result = writer_.WriteEntries(buffer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), buffer.size());
+  ASSERT_EQ(writer_.Finish(), OkStatus());
+  EXPECT_EQ(writer_.events_written(), 4u);
+  EXPECT_EQ(
+      Output(),
+      "[\n"
+      R"({"pid":"mod","name":"Work","ts":0.000,"ph":"B","tid":"Work"},)"
+      "\n"
+      R"({"pid":"mod","name":"Tick","ts":2000.000,"ph":"I","s":"p"},)"
+      "\n"
+      R"({"pid":"mod","name":"\"Job\"","ts":3000.000,"ph":"b",)"
+      R"("scope":"grp","tid":"grp","cat":"mod","id":17,"args":{"id":17}},)"
+      "\n"
+      R"({"pid":"mod","name":"Work","ts":6000.000,"ph":"E","tid":"Work"})"
+      "\n]\n");
+}
+
+TEST_F(ChromeTraceWriterTest, WritesEventData) {
+  constexpr std::byte kDepth[] = {std::byte{0x2a}, std::byte{0x01}};
+  constexpr std::byte kBlob[] = {std::byte{0xab}, std::byte{0xcd}};
+  std::vector<std::byte> buffer;
+  AppendEntry(buffer, kCounter, 0, std::nullopt, kDepth);
+  AppendEntry(buffer, kHexData, 0, std::nullopt, kBlob);
+
+  StatusWithSize result = writer_.WriteEntries(buffer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), buffer.size());
+  ASSERT_EQ(writer_.Finish(), OkStatus());
+  EXPECT_EQ(Output(),
+            "[\n"
+            R"({"pid":"mod","name":"Depth","ts":0.000,"ph":"C","s":"p",)"
+            R"("args":{"Depth":298}},)"
+            "\n"
+            R"({"pid":"mod","name":"Blob","ts":0.000,"ph":"I","s":"p",)"
+            R"("args":{"data":"abcd"}})"
+            "\n]\n");
+}
+
+TEST_F(ChromeTraceWriterTest, IncompleteEntriesAreNotConsumed) {
+  std::vector<std::byte> buffer;
+  AppendEntry(buffer, kInstant, 1);
+  const size_t first_entry_size = buffer.size();
+  AppendEntry(buffer, kInstant, 1);
+
+  const ConstByteSpan data(buffer);
+  StatusWithSize result = writer_.WriteEntries(data.first(buffer.size() - 1));
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), first_entry_size);
+  EXPECT_EQ(writer_.events_written(), 1u);
+
+  result = writer_.WriteEntries(data.subspan(result.size()));
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), buffer.size() - first_entry_size);
+  EXPECT_EQ(writer_.events_written(), 2u);
+}
+
+TEST_F(ChromeTraceWriterTest, SkipsUndecodableEntries) {
+  std::vector<std::byte> buffer;
+  AppendEntry(buffer, 0xdeadbeef, 1);
+  AppendEntry(buffer, kNotATraceToken, 1);
+  AppendEntry(buffer, kInstant, 1);
+
+  StatusWithSize result = writer_.WriteEntries(buffer);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), buffer.size());
+  EXPECT_EQ(writer_.skipped_entries(), 2u);
+  EXPECT_EQ(writer_.events_written(), 1u);
+  // Time still advances for skipped entries.
+  EXPECT_NE(Output().find(R"("ts":3000.000)"), std::string_view::npos);
+}
+
+}  // namespace
+}  // namespace pw::trace
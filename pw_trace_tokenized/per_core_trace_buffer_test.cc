@@ -0,0 +1,133 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include "pw_trace_tokenized/per_core_trace_buffer.h"
+
+#include <cstdint>
+#include <limits>
+
+#include "pw_containers/vector.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::trace {
+namespace {
+
+PerCoreTraceEvent Event(uint32_t token, PW_TRACE_TIME_TYPE time) {
+  return {
+      .trace_token = token,
+      .event_type = PW_TRACE_EVENT_TYPE_INSTANT,
+      .trace_id = 0,
+      .time = time,
+  };
+}
+
+template <size_t kNumCores, size_t kEventsPerCore>
+Vector<uint32_t, 16> MergeTokens(
+    PerCoreTraceBuffer<kNumCores, kEventsPerCore>& buffer,
+    size_t* lost = nullptr) {
+  Vector<uint32_t, 16> tokens;
+  const size_t events_lost = buffer.Merge(
+      [&tokens](const PerCoreTraceEvent& event) {
+        tokens.push_back(event.trace_token);
+      });
+  if (lost != nullptr) {
+    *lost = events_lost;
+  }
+  return tokens;
+}
+
+TEST(PerCoreTraceBuffer, MergesCoresInTimeOrder) {
+  PerCoreTraceBuffer<2, 4> buffer;
+  EXPECT_TRUE(buffer.Record(0, Event(1, 10)));
+  EXPECT_TRUE(buffer.Record(1, Event(2, 15)));
+  EXPECT_TRUE(buffer.Record(1, Event(3, 20)));
+  EXPECT_TRUE(buffer.Record(0, Event(4, 30)));
+  EXPECT_FALSE(buffer.Record(2, Event(5, 40)));
+
+  size_t lost = 1;
+  const Vector<uint32_t, 16> tokens = MergeTokens(buffer, &lost);
+  EXPECT_EQ(lost, 0u);
+  ASSERT_EQ(tokens.size(), 4u);
+  EXPECT_EQ(tokens[0], 1u);
+  EXPECT_EQ(tokens[1], 2u);
+  EXPECT_EQ(tokens[2], 3u);
+  EXPECT_EQ(tokens[3], 4u);
+
+  // Merged events are not merged again.
+  EXPECT_TRUE(MergeTokens(buffer).empty());
+  EXPECT_TRUE(buffer.Record(1, Event(6, 50)));
+  const Vector<uint32_t, 16> more_tokens = MergeTokens(buffer);
+  ASSERT_EQ(more_tokens.size(), 1u);
+  EXPECT_EQ(more_tokens[0], 6u);
+}
+
+TEST(PerCoreTraceBuffer, KeepsOrderOfEachCore) {
+  PerCoreTraceBuffer<2, 4> buffer;
+  // An event recorded by an interrupt may have an earlier time than the
+  // event it preempted.
+  EXPECT_TRUE(buffer.Record(0, Event(1, 20)));
+  EXPECT_TRUE(buffer.Record(0, Event(2, 10)));
+  EXPECT_TRUE(buffer.Record(1, Event(3, 15)));
+
+  const Vector<uint32_t, 16> tokens = MergeTokens(buffer);
+  ASSERT_EQ(tokens.size(), 3u);
+  EXPECT_EQ(tokens[0], 3u);
+  EXPECT_EQ(tokens[1], 1u);
+  EXPECT_EQ(tokens[2], 2u);
+}
+
+TEST(PerCoreTraceBuffer, OrdersTimesThatWrap) {
+  PerCoreTraceBuffer<2, 4> buffer;
+  constexpr PW_TRACE_TIME_TYPE kBeforeWrap =
+      std::numeric_limits<PW_TRACE_TIME_TYPE>::max() - 5;
+  EXPECT_TRUE(buffer.Record(0, Event(1, 3)));
+  EXPECT_TRUE(buffer.Record(1, Event(2, kBeforeWrap)));
+
+  const Vector<uint32_t, 16> tokens = MergeTokens(buffer);
+  ASSERT_EQ(tokens.size(), 2u);
+  EXPECT_EQ(tokens[0], 2u);
+  EXPECT_EQ(tokens[1], 1u);
+}
+
+TEST(PerCoreTraceBuffer, OverwritesOldestEvents) {
+  PerCoreTraceBuffer<1, 2> buffer;
+  for (uint32_t i = 0; i < 5; ++i) {
+    EXPECT_TRUE(buffer.Record(0, Event(i, i)));
+  }
+
+  size_t lost = 0;
+  const Vector<uint32_t, 16> tokens = MergeTokens(buffer, &lost);
+  EXPECT_EQ(lost, 3u);
+  ASSERT_EQ(tokens.size(), 2u);
+  EXPECT_EQ(tokens[0], 3u);
+  EXPECT_EQ(tokens[1], 4u);
+}
+
+TEST(PerCoreTraceBuffer, Clear) {
+  PerCoreTraceBuffer<2, 2> buffer;
+  EXPECT_TRUE(buffer.Record(0, Event(1, 1)));
+  EXPECT_TRUE(buffer.Record(1, Event(2, 2)));
+  buffer.Clear();
+  EXPECT_TRUE(MergeTokens(buffer).empty());
+}
+
+TEST(PerCoreTraceBuffer, NoStorageDropsEvents) {
+  PerCoreTraceBuffer<1, 0> buffer;
+  EXPECT_FALSE(buffer.Record(0, Event(1, 1)));
+  EXPECT_TRUE(MergeTokens(buffer).empty());
+}
+
+}  // namespace
+}  // namespace pw::trace
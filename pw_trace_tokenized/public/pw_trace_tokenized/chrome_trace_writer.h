@@ -0,0 +1,119 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_stream/stream.h"
+#include "pw_tokenizer/detokenize.h"
+
+namespace pw::trace {
+
+// Decodes tokenized trace data on the host and writes it as a JSON trace that
+// can be opened in chrome://tracing or https://ui.perfetto.dev. This produces
+// the same events as the trace_tokenized.py Python decoder, but decodes each
+// token only once and writes events as they are decoded, so a capture of any
+// length can be converted in a single pass over its data.
+//
+// A ChromeTraceWriter is not thread-safe.
+class ChromeTraceWriter {
+ public:
+  // Events are timestamped by converting their tick deltas to microseconds
+  // using ticks_per_second, starting at time_offset_us.
+  ChromeTraceWriter(const tokenizer::Detokenizer& detokenizer,
+                    stream::Writer& output,
+                    uint32_t ticks_per_second,
+                    double time_offset_us = 0);
+
+  ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+  ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+  // Decodes and writes trace entries, each prefixed with its varint-encoded
+  // size, as in the trace buffer or a StreamEvents batch. Data may be passed
+  // in chunks of any size: an incomplete entry at the end of `entries` is not
+  // consumed, and should be passed again at the start of the next chunk.
+  //
+  // Returns the number of bytes consumed, with one of:
+  //
+  //   OK - All complete entries were written.
+  //   DATA_LOSS - An entry's size prefix is corrupt.
+  //   Any error from writing to the output.
+  //
+  StatusWithSize WriteEntries(ConstByteSpan entries);
+
+  // Decodes and writes a single trace entry, without its size prefix. Entries
+  // that cannot be decoded, such as those with unknown tokens, are skipped
+  // and counted in skipped_entries(). Returns any error from writing to the
+  // output.
+  Status WriteEntry(ConstByteSpan entry);
+
+  // Ends the JSON trace. No more entries may be written after this.
+  Status Finish();
+
+  size_t events_written() const { return events_written_; }
+  size_t skipped_entries() const { return skipped_entries_; }
+
+ private:
+  enum class EventType : uint8_t {
+    kInvalid,
+    kInstant,
+    kInstantGroup,
+    kAsyncStart,
+    kAsyncStep,
+    kAsyncEnd,
+    kDurationStart,
+    kDurationEnd,
+    kDurationGroupStart,
+    kDurationGroupEnd,
+  };
+
+  // The fields of a trace token's string, which is formatted as
+  // "event_type|flags|module|group|label" with an optional "|data_format".
+  struct TokenInfo {
+    EventType type = EventType::kInvalid;
+    bool has_data = false;
+    std::string module;
+    std::string group;
+    std::string label;
+    std::string data_format;
+  };
+
+  const TokenInfo& LookUpToken(uint32_t token);
+
+  Status WriteLine();
+
+  const tokenizer::Detokenizer& detokenizer_;
+  stream::Writer& output_;
+  const double microseconds_per_tick_;
+  const double time_offset_us_;
+
+  uint64_t ticks_ = 0;
+  size_t events_written_ = 0;
+  size_t skipped_entries_ = 0;
+
+  std::unordered_map<uint32_t, TokenInfo> tokens_;
+
+  // Reused for each event to avoid allocating.
+  std::string line_;
+};
+
+}  // namespace pw::trace
@@ -109,6 +109,29 @@ static_assert(
 #define PW_TRACE_QUEUE_UNLOCK()
 #endif  // PW_TRACE_QUEUE_UNLOCK
 
+// --- Config options for per-core event buffers ---
+
+// PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS is the number of events stored for each
+// core in the per-core event buffers. When not 0, trace events without data
+// are recorded into the current core's buffer without taking any locks,
+// instead of going through the event queue. They are written to the sinks when
+// the buffers are merged, e.g. when the trace buffer is read.
+#ifndef PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS
+#define PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS 0
+#endif  // PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS
+
+// PW_TRACE_CONFIG_NUM_CORES is the number of per-core event buffers.
+#ifndef PW_TRACE_CONFIG_NUM_CORES
+#define PW_TRACE_CONFIG_NUM_CORES 1
+#endif  // PW_TRACE_CONFIG_NUM_CORES
+
+// PW_TRACE_GET_CORE_INDEX is the macro which is called to get the index of the
+// core a trace event is recorded on. It must be less than
+// PW_TRACE_CONFIG_NUM_CORES; events from other cores are dropped.
+#ifndef PW_TRACE_GET_CORE_INDEX
+#define PW_TRACE_GET_CORE_INDEX() (0)
+#endif  // PW_TRACE_GET_CORE_INDEX
+
 // --- Config options for optional trace buffer ---
 
 // PW_TRACE_BUFFER_SIZE_BYTES is the size in bytes of the optional trace buffer.
@@ -0,0 +1,175 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+//==============================================================================
+//
+// This file provides lock-free, per-core buffers of fixed-size trace events.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "pw_trace_tokenized/config.h"
+#include "pw_trace_tokenized/internal/trace_tokenized_internal.h"
+
+namespace pw {
+namespace trace {
+
+// A trace event without data, as stored in a PerCoreTraceBuffer.
+struct PerCoreTraceEvent {
+  uint32_t trace_token;
+  pw_trace_EventType event_type;
+  uint32_t trace_id;
+  PW_TRACE_TIME_TYPE time;
+};
+
+// Records trace events in a separate ring of kEventsPerCore events for each of
+// kNumCores cores, so that cores never contend for a lock or cache line while
+// tracing. Each core's ring keeps its most recent events, overwriting the
+// oldest ones. Merge() reads the events of all cores back in time order.
+//
+// Record() is lock-free, so it may be called from any context, including
+// interrupts that preempt another Record() call on the same core. Merge() and
+// Clear() must not run concurrently with Record(), so disable tracing before
+// calling them.
+template <size_t kNumCores, size_t kEventsPerCore>
+class PerCoreTraceBuffer {
+ public:
+  constexpr PerCoreTraceBuffer() = default;
+
+  // Not copyable nor movable.
+  PerCoreTraceBuffer(const PerCoreTraceBuffer&) = delete;
+  PerCoreTraceBuffer& operator=(const PerCoreTraceBuffer&) = delete;
+
+  // Records an event for the provided core. Returns false if the event was
+  // dropped because the core index is out of range or the buffer has no
+  // storage.
+  bool Record(size_t core, const PerCoreTraceEvent& event) {
+    if constexpr (kEventsPerCore == 0) {
+      return false;
+    } else {
+      if (core >= kNumCores) {
+        return false;
+      }
+      Core& buffer = cores_[core];
+      const size_t index = buffer.claimed.fetch_add(1);
+      Slot& slot = buffer.slots[index % kEventsPerCore];
+      slot.sequence.store(0, std::memory_order_relaxed);
+      slot.event = event;
+      // Publish the event. Merge() skips slots whose sequence doesn't match
+      // the index it expects.
+      slot.sequence.store(index + 1, std::memory_order_release);
+      return true;
+    }
+  }
+
+  // Calls `handler` with each event recorded since the last Merge() or
+  // Clear(), in time order across all cores, then marks them as merged.
+  // Events of a single core are always passed in the order they were recorded.
+  //
+  // Returns the number of events that were lost because they were overwritten
+  // or not fully recorded.
+  template <typename Handler>
+  size_t Merge(Handler&& handler) {
+    if constexpr (kEventsPerCore == 0) {
+      return 0;
+    } else {
+      std::array<size_t, kNumCores> next;
+      std::array<size_t, kNumCores> end;
+      size_t lost = 0;
+      for (size_t i = 0; i < kNumCores; ++i) {
+        end[i] = cores_[i].claimed.load(std::memory_order_acquire);
+        next[i] = cores_[i].merged;
+        if (end[i] - next[i] > kEventsPerCore) {
+          lost += end[i] - next[i] - kEventsPerCore;
+          next[i] = end[i] - kEventsPerCore;
+        }
+      }
+
+      while (true) {
+        const PerCoreTraceEvent* earliest = nullptr;
+        size_t earliest_core = 0;
+        for (size_t i = 0; i < kNumCores; ++i) {
+          while (next[i] != end[i] && !IsRecorded(i, next[i])) {
+            ++lost;
+            ++next[i];
+          }
+          if (next[i] == end[i]) {
+            continue;
+          }
+          const PerCoreTraceEvent& event =
+              cores_[i].slots[next[i] % kEventsPerCore].event;
+          if (earliest == nullptr || IsBefore(event.time, earliest->time)) {
+            earliest = &event;
+            earliest_core = i;
+          }
+        }
+        if (earliest == nullptr) {
+          break;
+        }
+        handler(*earliest);
+        ++next[earliest_core];
+      }
+
+      for (size_t i = 0; i < kNumCores; ++i) {
+        cores_[i].merged = end[i];
+      }
+      return lost;
+    }
+  }
+
+  // Discards all events that have not been merged.
+  void Clear() {
+    for (Core& buffer : cores_) {
+      buffer.merged = buffer.claimed.load(std::memory_order_acquire);
+    }
+  }
+
+ private:
+  struct Slot {
+    // One more than the index of the event in the slot, or 0 while the slot
+    // is being written.
+    std::atomic<size_t> sequence{0};
+    PerCoreTraceEvent event{};
+  };
+
+  struct Core {
+    // The number of events claimed by Record() on this core.
+    std::atomic<size_t> claimed{0};
+    // The number of events on this core passed to Merge() or Clear().
+    size_t merged = 0;
+    std::array<Slot, kEventsPerCore> slots{};
+  };
+
+  bool IsRecorded(size_t core, size_t index) const {
+    return cores_[core].slots[index % kEventsPerCore].sequence.load(
+               std::memory_order_acquire) == index + 1;
+  }
+
+  // Returns true if `time` comes before `other`. Times that wrap are ordered
+  // correctly as long as they are less than half the time range apart.
+  static bool IsBefore(PW_TRACE_TIME_TYPE time, PW_TRACE_TIME_TYPE other) {
+    return PW_TRACE_GET_TIME_DELTA(time, other) <
+           PW_TRACE_GET_TIME_DELTA(other, time);
+  }
+
+  std::array<Core, kNumCores> cores_{};
+};
+
+}  // namespace trace
+}  // namespace pw
@@ -26,17 +26,30 @@ namespace pw {
 namespace trace {
 
 // pw_TraceClearBuffer resets the trace buffer, and all data currently stored
-// in the buffer is lost.
+// in the buffer is lost. This also resets the count of dropped events.
 void ClearBuffer();
 
-// Get the ring buffer which contains the data.
+// Get the ring buffer which contains the data. Events recorded in the per-core
+// event buffers are merged into it first, so ensure that tracing is disabled
+// when calling this function if PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS is set.
 pw::ring_buffer::PrefixedEntryRingBuffer* GetBuffer();
 
 // View underlying buffer trace_tokenized provided ring_buffer at time of
 // construction. This allows for bulk access to the trace events buffer. Since
-// this also derings the underlying ring_buffer, ensure that tracing is disabled
-// when calling this function.
+// this also merges the per-core event buffers and derings the underlying
+// ring_buffer, ensure that tracing is disabled when calling this function.
 ConstByteSpan DeringAndViewRawBuffer();
 
+// Moves whole entries from the front of the trace buffer into `destination`,
+// each prefixed with its varint-encoded size, until the next entry doesn't
+// fit. Unlike the functions above, this may be called while tracing is
+// enabled. Returns the number of bytes written to `destination`.
+size_t PopEntries(ByteSpan destination);
+
+// Returns the number of trace events that were dropped since the last call,
+// either because they were evicted from the full trace buffer or because they
+// were larger than PW_TRACE_BUFFER_MAX_BLOCK_SIZE_BYTES, and resets the count.
+size_t TakeDroppedEventCount();
+
 }  // namespace trace
 }  // namespace pw
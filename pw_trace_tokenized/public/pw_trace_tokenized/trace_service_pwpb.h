@@ -13,6 +13,8 @@
 // the License.
 #pragma once
 
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
 #include "pw_trace_protos/trace_service.rpc.pwpb.h"
 #include "pw_trace_tokenized/base_trace_service.h"
 
@@ -33,6 +35,30 @@ class TraceService final
   Status GetClockParameters(
       const proto::pwpb::ClockParametersRequest::Message& request,
       proto::pwpb::ClockParametersResponse::Message& response);
+
+  void StreamEvents(
+      const proto::pwpb::StreamEventsRequest::Message& request,
+      ServerWriter<proto::pwpb::StreamEventsResponse::Message>& writer)
+      PW_LOCKS_EXCLUDED(stream_mutex_);
+
+  // Sends the entries in the trace buffer to the open StreamEvents call, in
+  // batches, until the trace buffer is empty. This should be called
+  // periodically, e.g. from a low-priority thread, while streaming. Returns:
+  //
+  //   OK - The trace buffer was drained.
+  //   FAILED_PRECONDITION - No StreamEvents call is open.
+  //   Any error from writing to the stream - The unsent batch is kept and sent
+  //       by the next call, so entries aren't lost while the channel is busy.
+  //
+  Status FlushEventStream() PW_LOCKS_EXCLUDED(stream_mutex_);
+
+ private:
+  sync::Mutex stream_mutex_;
+  ServerWriter<proto::pwpb::StreamEventsResponse::Message> stream_writer_
+      PW_GUARDED_BY(stream_mutex_);
+  proto::pwpb::StreamEventsResponse::Message pending_batch_
+      PW_GUARDED_BY(stream_mutex_);
+  bool batch_pending_ PW_GUARDED_BY(stream_mutex_) = false;
 };
 
 }  // namespace pw::trace
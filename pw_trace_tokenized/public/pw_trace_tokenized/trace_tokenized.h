@@ -34,6 +34,9 @@
 #include "pw_trace_tokenized/internal/trace_tokenized_internal.h"
 
 #ifdef __cplusplus
+#include "pw_span/span.h"
+#include "pw_trace_tokenized/per_core_trace_buffer.h"
+
 namespace pw {
 namespace trace {
 
@@ -138,15 +141,34 @@ class TokenizedTracer {
                         const void* data_buffer,
                         size_t data_size);
 
+  // Writes the events recorded in the per-core event buffers to the sinks, in
+  // time order. Tracing should be disabled while merging. Does nothing unless
+  // PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS is set.
+  void MergePerCoreEvents();
+
+  // Discards the events in the per-core event buffers that have not been
+  // merged.
+  void ClearPerCoreEvents() { per_core_events_.Clear(); }
+
  private:
   using TraceQueue = internal::TraceQueue<PW_TRACE_QUEUE_SIZE_EVENTS>;
   PW_TRACE_TIME_TYPE last_trace_time_ = 0;
   bool enabled_ = false;
   TraceQueue event_queue_;
+  PerCoreTraceBuffer<PW_TRACE_CONFIG_NUM_CORES,
+                     PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS>
+      per_core_events_;
   Callbacks& callbacks_;
 
   void HandleNextItemInQueue(
       const volatile TraceQueue::QueueEventBlock* event_block);
+
+  // Encodes an event and sends it to the sinks.
+  void EncodeEvent(uint32_t trace_token,
+                   EventType event_type,
+                   uint32_t trace_id,
+                   PW_TRACE_TIME_TYPE delta,
+                   span<const std::byte> data);
 };
 
 // Returns a reference of the global tokenized tracer
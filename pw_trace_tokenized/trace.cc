@@ -73,31 +73,43 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
     return;
   }
 
-  // Create trace event
-  PW_TRACE_QUEUE_LOCK();
-  if (!event_queue_
-           .TryPushBack(event.trace_token,
-                        event.event_type,
-                        event.module,
-                        event.trace_id,
-                        event.flags,
-                        event.data_buffer,
-                        event.data_size)
-           .ok()) {
-    // Queue full dropping sample
-    // TODO(rgoliver): Allow other strategies, for example: drop oldest, try
-    // empty queue, or block.
-  }
-  PW_TRACE_QUEUE_UNLOCK();
-
-  // Sample is now in queue (if not dropped), try to empty the queue if not
-  // already being emptied.
-  if (PW_TRACE_TRY_LOCK()) {
-    while (!event_queue_.IsEmpty()) {
-      HandleNextItemInQueue(event_queue_.PeekFront());
-      event_queue_.PopFront();
+  if (PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS > 0 && event.data_size == 0) {
+    // Record the event without taking any locks. It is sent to the sinks when
+    // the per-core buffers are merged.
+    per_core_events_.Record(PW_TRACE_GET_CORE_INDEX(),
+                            {
+                                .trace_token = event.trace_token,
+                                .event_type = event.event_type,
+                                .trace_id = event.trace_id,
+                                .time = pw_trace_GetTraceTime(),
+                            });
+  } else {
+    // Create trace event
+    PW_TRACE_QUEUE_LOCK();
+    if (!event_queue_
+             .TryPushBack(event.trace_token,
+                          event.event_type,
+                          event.module,
+                          event.trace_id,
+                          event.flags,
+                          event.data_buffer,
+                          event.data_size)
+             .ok()) {
+      // Queue full dropping sample
+      // TODO(rgoliver): Allow other strategies, for example: drop oldest, try
+      // empty queue, or block.
+    }
+    PW_TRACE_QUEUE_UNLOCK();
+
+    // Sample is now in queue (if not dropped), try to empty the queue if not
+    // already being emptied.
+    if (PW_TRACE_TRY_LOCK()) {
+      while (!event_queue_.IsEmpty()) {
+        HandleNextItemInQueue(event_queue_.PeekFront());
+        event_queue_.PopFront();
+      }
+      PW_TRACE_UNLOCK();
     }
-    PW_TRACE_UNLOCK();
   }
 
   // Disable after processing if an event callback had set the flag.
@@ -116,6 +128,52 @@ void TokenizedTracer::HandleNextItemInQueue(
       const_cast<const std::byte*>(event_block->data_buffer);
   size_t data_size = event_block->data_size;
 
+  // Compute delta of time elapsed since last trace entry.
+  PW_TRACE_TIME_TYPE trace_time = pw_trace_GetTraceTime();
+  PW_TRACE_TIME_TYPE delta =
+      (last_trace_time_ == 0)
+          ? 0
+          : PW_TRACE_GET_TIME_DELTA(last_trace_time_, trace_time);
+  last_trace_time_ = trace_time;
+
+  EncodeEvent(trace_token,
+              event_type,
+              trace_id,
+              delta,
+              span<const std::byte>(data_buffer, data_size));
+}
+
+void TokenizedTracer::MergePerCoreEvents() {
+  if (PW_TRACE_PER_CORE_BUFFER_SIZE_EVENTS == 0) {
+    return;
+  }
+  PW_TRACE_LOCK();
+  per_core_events_.Merge([this](const PerCoreTraceEvent& event) {
+    // Events with data are sent to the sinks as they happen, so a merged event
+    // may be older than the last event sent. Report no time elapsed for it,
+    // rather than a delta that wraps around.
+    PW_TRACE_TIME_TYPE delta = 0;
+    if (last_trace_time_ == 0) {
+      last_trace_time_ = event.time;
+    } else if (PW_TRACE_GET_TIME_DELTA(last_trace_time_, event.time) <=
+               PW_TRACE_GET_TIME_DELTA(event.time, last_trace_time_)) {
+      delta = PW_TRACE_GET_TIME_DELTA(last_trace_time_, event.time);
+      last_trace_time_ = event.time;
+    }
+    EncodeEvent(event.trace_token,
+                event.event_type,
+                event.trace_id,
+                delta,
+                span<const std::byte>());
+  });
+  PW_TRACE_UNLOCK();
+}
+
+void TokenizedTracer::EncodeEvent(uint32_t trace_token,
+                                  EventType event_type,
+                                  uint32_t trace_id,
+                                  PW_TRACE_TIME_TYPE delta,
+                                  span<const std::byte> data) {
   // Create header to store trace info
   static constexpr size_t kMaxHeaderSize =
       sizeof(trace_token) + pw::varint::kMaxVarint64SizeBytes +  // time
@@ -124,16 +182,9 @@ void TokenizedTracer::HandleNextItemInQueue(
   memcpy(header, &trace_token, sizeof(trace_token));
   size_t header_size = sizeof(trace_token);
 
-  // Compute delta of time elapsed since last trace entry.
-  PW_TRACE_TIME_TYPE trace_time = pw_trace_GetTraceTime();
-  PW_TRACE_TIME_TYPE delta =
-      (last_trace_time_ == 0)
-          ? 0
-          : PW_TRACE_GET_TIME_DELTA(last_trace_time_, trace_time);
   header_size += pw::varint::Encode(
       delta,
       span<std::byte>(&header[header_size], kMaxHeaderSize - header_size));
-  last_trace_time_ = trace_time;
 
   // Calculate packet id if needed.
   if (PW_TRACE_HAS_TRACE_ID(event_type)) {
@@ -143,10 +194,7 @@ void TokenizedTracer::HandleNextItemInQueue(
   }
 
   // Send encoded output to any registered trace sinks.
-  callbacks_.CallSinks(
-      span<const std::byte>(header, header_size),
-      span<const std::byte>(reinterpret_cast<const std::byte*>(data_buffer),
-                            data_size));
+  callbacks_.CallSinks(span<const std::byte>(header, header_size), data);
 }
 
 pw_trace_TraceEventReturnFlags Callbacks::CallEventCallbacks(
@@ -38,6 +38,7 @@ class TraceBuffer {
     TraceBuffer* buffer = reinterpret_cast<TraceBuffer*>(user_data);
     if (size > PW_TRACE_BUFFER_MAX_BLOCK_SIZE_BYTES) {
       buffer->block_size_ = 0;  // Skip this block
+      buffer->dropped_events_ += 1;
       return;
     }
     buffer->block_size_ = static_cast<uint16_t>(size);
@@ -61,10 +62,18 @@ class TraceBuffer {
     if (buffer->block_idx_ != buffer->block_size_) {
       return;  // Block is too large, skipping.
     }
-    buffer->ring_buffer_
-        .PushBack(span<const std::byte>(&buffer->current_block_[0],
-                                        buffer->block_size_))
-        .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+    // The ring buffer evicts the oldest entries to make room for new ones, so
+    // count how many were lost to keep track of dropped events.
+    const size_t entries_before = buffer->ring_buffer_.EntryCount();
+    if (!buffer->ring_buffer_
+             .PushBack(span<const std::byte>(&buffer->current_block_[0],
+                                             buffer->block_size_))
+             .ok()) {
+      buffer->dropped_events_ += 1;
+      return;
+    }
+    buffer->dropped_events_ +=
+        entries_before + 1 - buffer->ring_buffer_.EntryCount();
   }
 
   pw::ring_buffer::PrefixedEntryRingBuffer& RingBuffer() {
@@ -77,10 +86,43 @@ class TraceBuffer {
     return ByteSpan(raw_buffer_, ring_buffer_.TotalUsedBytes());
   }
 
+  // Must be called with the trace lock held, since the sink writes to the ring
+  // buffer and the dropped count while holding it.
+  size_t PopEntries(ByteSpan destination) {
+    size_t bytes_written = 0;
+    while (ring_buffer_.EntryCount() > 0 &&
+           ring_buffer_.FrontEntryTotalSizeBytes() <=
+               destination.size() - bytes_written) {
+      size_t entry_size = 0;
+      if (!ring_buffer_
+               .PeekFrontWithPreamble(destination.subspan(bytes_written),
+                                      &entry_size)
+               .ok()) {
+        break;
+      }
+      ring_buffer_.PopFront()
+          .IgnoreError();  // Cannot fail, since an entry was just read.
+      bytes_written += entry_size;
+    }
+    return bytes_written;
+  }
+
+  size_t TakeDroppedEventCount() {
+    const size_t dropped_events = dropped_events_;
+    dropped_events_ = 0;
+    return dropped_events;
+  }
+
+  void Clear() {
+    ring_buffer_.Clear();
+    dropped_events_ = 0;
+  }
+
  private:
   Callbacks& callbacks_;
   uint16_t block_size_ = 0;
   uint16_t block_idx_ = 0;
+  size_t dropped_events_ = 0;
   std::byte current_block_[PW_TRACE_BUFFER_MAX_BLOCK_SIZE_BYTES];
   std::byte raw_buffer_[PW_TRACE_BUFFER_SIZE_BYTES];
   pw::ring_buffer::PrefixedEntryRingBuffer ring_buffer_{false};
@@ -92,15 +134,39 @@ TraceBuffer trace_buffer_instance(GetCallbacks());
 
 }  // namespace
 
-void ClearBuffer() { trace_buffer_instance.RingBuffer().Clear(); }
+void ClearBuffer() {
+  GetTokenizedTracer().ClearPerCoreEvents();
+  PW_TRACE_LOCK();
+  trace_buffer_instance.Clear();
+  PW_TRACE_UNLOCK();
+}
 
 pw::ring_buffer::PrefixedEntryRingBuffer* GetBuffer() {
+  // Events recorded in the per-core buffers are only added to the trace buffer
+  // when they are merged, so merge them before the trace buffer is read.
+  GetTokenizedTracer().MergePerCoreEvents();
   return &trace_buffer_instance.RingBuffer();
 }
 
 ConstByteSpan DeringAndViewRawBuffer() {
+  GetTokenizedTracer().MergePerCoreEvents();
   return trace_buffer_instance.DeringAndViewRawBuffer();
 }
 
+size_t PopEntries(ByteSpan destination) {
+  GetTokenizedTracer().MergePerCoreEvents();
+  PW_TRACE_LOCK();
+  const size_t bytes_written = trace_buffer_instance.PopEntries(destination);
+  PW_TRACE_UNLOCK();
+  return bytes_written;
+}
+
+size_t TakeDroppedEventCount() {
+  PW_TRACE_LOCK();
+  const size_t dropped_events = trace_buffer_instance.TakeDroppedEventCount();
+  PW_TRACE_UNLOCK();
+  return dropped_events;
+}
+
 }  // namespace trace
 }  // namespace pw
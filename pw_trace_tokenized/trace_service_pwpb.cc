@@ -14,7 +14,10 @@
 
 #include "pw_trace_tokenized/trace_service_pwpb.h"
 
+#include <mutex>
+
 #include "pw_chrono/system_clock.h"
+#include "pw_trace_tokenized/trace_buffer.h"
 
 namespace pw::trace {
 
@@ -72,4 +75,38 @@ Status TraceService::GetClockParameters(
   return pw::OkStatus();
 }
 
+void TraceService::StreamEvents(
+    const proto::pwpb::StreamEventsRequest::Message& /*request*/,
+    ServerWriter<proto::pwpb::StreamEventsResponse::Message>& writer) {
+  std::lock_guard lock(stream_mutex_);
+  // Replacing the writer closes any previously open stream.
+  stream_writer_ = std::move(writer);
+}
+
+Status TraceService::FlushEventStream() {
+  std::lock_guard lock(stream_mutex_);
+  if (!stream_writer_.active()) {
+    return Status::FailedPrecondition();
+  }
+
+  while (true) {
+    if (!batch_pending_) {
+      pending_batch_.entries.resize(pending_batch_.entries.max_size());
+      pending_batch_.entries.resize(PopEntries(pending_batch_.entries));
+      pending_batch_.dropped_events =
+          static_cast<uint32_t>(TakeDroppedEventCount());
+      if (pending_batch_.entries.empty() &&
+          pending_batch_.dropped_events == 0) {
+        return OkStatus();
+      }
+      batch_pending_ = true;
+    }
+
+    if (Status status = stream_writer_.Write(pending_batch_); !status.ok()) {
+      return status;
+    }
+    batch_pending_ = false;
+  }
+}
+
 }  // namespace pw::trace
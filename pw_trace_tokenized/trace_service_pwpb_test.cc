@@ -18,6 +18,7 @@
 #include "pw_rpc/pwpb/test_method_context.h"
 #include "pw_stream/memory_stream.h"
 #include "pw_trace/trace.h"
+#include "pw_trace_tokenized/trace_buffer.h"
 #include "pw_trace_tokenized/trace_tokenized.h"
 #include "pw_unit_test/framework.h"
 
@@ -127,4 +128,64 @@ TEST_F(TraceServiceTest, GetClockParameters) {
       static_cast<int32_t>(*context.response().clock_parameters.epoch_type));
 }
 
+TEST_F(TraceServiceTest, StreamEvents) {
+  auto& tracer = trace::GetTokenizedTracer();
+
+  std::array<std::byte, PW_TRACE_BUFFER_SIZE_BYTES> dest_buffer;
+  stream::MemoryWriter writer(dest_buffer);
+  PW_PWPB_TEST_METHOD_CONTEXT(TraceService, StreamEvents, 6, 1024)
+  context(tracer, writer);
+  ClearBuffer();
+
+  context.call({});
+  tracer.Enable(true);
+  PW_TRACE_INSTANT("TestTrace");
+  PW_TRACE_INSTANT("TestTrace");
+  tracer.Enable(false);
+
+  ASSERT_EQ(context.service().FlushEventStream(), OkStatus());
+  ASSERT_EQ(context.responses().size(), 1u);
+  EXPECT_LT(0u, context.responses()[0].entries.size());
+  EXPECT_EQ(0u, context.responses()[0].dropped_events);
+  EXPECT_EQ(0u, GetBuffer()->EntryCount());
+
+  // Nothing is sent when there are no new entries.
+  ASSERT_EQ(context.service().FlushEventStream(), OkStatus());
+  EXPECT_EQ(context.responses().size(), 1u);
+  EXPECT_FALSE(context.done());
+}
+
+TEST_F(TraceServiceTest, StreamEventsReportsDroppedEvents) {
+  auto& tracer = trace::GetTokenizedTracer();
+
+  std::array<std::byte, PW_TRACE_BUFFER_SIZE_BYTES> dest_buffer;
+  stream::MemoryWriter writer(dest_buffer);
+  PW_PWPB_TEST_METHOD_CONTEXT(TraceService, StreamEvents, 6, 1024)
+  context(tracer, writer);
+  ClearBuffer();
+
+  context.call({});
+  tracer.Enable(true);
+  // Every event takes at least one byte, so this overflows the trace buffer.
+  for (size_t i = 0; i < PW_TRACE_BUFFER_SIZE_BYTES; ++i) {
+    PW_TRACE_INSTANT("TestTrace");
+  }
+  tracer.Enable(false);
+
+  ASSERT_EQ(context.service().FlushEventStream(), OkStatus());
+  ASSERT_LT(0u, context.responses().size());
+  EXPECT_LT(0u, context.responses()[0].dropped_events);
+  EXPECT_EQ(0u, GetBuffer()->EntryCount());
+}
+
+TEST_F(TraceServiceTest, FlushEventStreamNotStreaming) {
+  auto& tracer = trace::GetTokenizedTracer();
+
+  std::array<std::byte, PW_TRACE_BUFFER_SIZE_BYTES> dest_buffer;
+  stream::MemoryWriter writer(dest_buffer);
+  TraceService service(tracer, writer);
+
+  EXPECT_EQ(service.FlushEventStream(), Status::FailedPrecondition());
+}
+
 }  // namespace pw::trace
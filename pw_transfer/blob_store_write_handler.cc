@@ -0,0 +1,106 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#define PW_LOG_MODULE_NAME "TRN"
+
+#include "pw_transfer/blob_store_write_handler.h"
+
+#include <array>
+
+#include "pw_log/log.h"
+#include "pw_status/try.h"
+
+namespace pw::transfer {
+
+Status BlobStoreWriteHandler::PrepareWrite() {
+  if (blob_writer_.IsOpen()) {
+    PW_TRY(blob_writer_.Abandon());
+  }
+  PW_TRY(blob_writer_.Open());
+  checksum_.clear();
+  return OkStatus();
+}
+
+Status BlobStoreWriteHandler::PrepareWrite(uint32_t offset) {
+  if (!blob_writer_.IsOpen()) {
+    PW_TRY(Resume());
+  }
+
+  if (offset != blob_writer_.CurrentSizeBytes()) {
+    PW_LOG_WARN("Resource %u can't resume at offset %u; it has %u bytes",
+                static_cast<unsigned>(id()),
+                static_cast<unsigned>(offset),
+                static_cast<unsigned>(blob_writer_.CurrentSizeBytes()));
+    return Status::FailedPrecondition();
+  }
+  return OkStatus();
+}
+
+Status BlobStoreWriteHandler::FinalizeWrite(Status status) {
+  if (status.ok()) {
+    return blob_writer_.Close();
+  }
+  return blob_writer_.Abandon();
+}
+
+Status BlobStoreWriteHandler::GetStatus(uint64_t& readable_offset,
+                                        uint64_t& writeable_offset,
+                                        uint64_t& read_checksum,
+                                        uint64_t& write_checksum) {
+  readable_offset = 0;
+  read_checksum = 0;
+  writeable_offset = 0;
+  write_checksum = 0;
+
+  // Resuming only once keeps the writer open, so later calls report the same
+  // offset without backing up further.
+  if (!blob_writer_.IsOpen()) {
+    PW_TRY(Resume());
+  }
+
+  writeable_offset = blob_writer_.CurrentSizeBytes();
+  write_checksum = checksum_.value();
+  return OkStatus();
+}
+
+Status BlobStoreWriteHandler::Resume() {
+  const StatusWithSize resumed = blob_writer_.Resume();
+  PW_TRY(resumed.status());
+
+  checksum_.clear();
+  std::array<std::byte, 32> buffer;
+  size_t offset = 0;
+  while (offset < resumed.size()) {
+    const StatusWithSize read = blob_writer_.ReadCommittedData(offset, buffer);
+    if (!read.ok() || read.size() == 0u) {
+      blob_writer_.Abandon().IgnoreError();
+      return read.ok() ? Status::DataLoss() : read.status();
+    }
+    checksum_.Update(span(buffer).first(read.size()));
+    offset += read.size();
+  }
+
+  PW_LOG_INFO("Resource %u resumed at offset %u",
+              static_cast<unsigned>(id()),
+              static_cast<unsigned>(offset));
+  return OkStatus();
+}
+
+Status BlobStoreWriteHandler::ChecksumWriter::DoWrite(ConstByteSpan data) {
+  PW_TRY(handler_.blob_writer_.Write(data));
+  handler_.checksum_.Update(data);
+  return OkStatus();
+}
+
+}  // namespace pw::transfer
@@ -0,0 +1,198 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_transfer/blob_store_write_handler.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include "pw_blob_store/blob_store.h"
+#include "pw_checksum/crc32.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/test_key_value_store.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::transfer {
+namespace {
+
+constexpr uint32_t kResourceId = 7;
+constexpr size_t kSectorSize = 1024;
+constexpr size_t kSectorCount = 4;
+constexpr size_t kBufferSize = 64;
+
+class BlobStoreWriteHandlerTest : public ::testing::Test {
+ protected:
+  BlobStoreWriteHandlerTest() : partition_(&flash_) {
+    EXPECT_EQ(OkStatus(), partition_.Erase());
+    for (size_t i = 0; i < data_.size(); ++i) {
+      data_[i] = static_cast<std::byte>(i * 7);
+    }
+  }
+
+  // Writes part of a blob and abandons the write, as if the transfer had
+  // been interrupted.
+  void WriteInterrupted(size_t size_bytes) {
+    BlobStoreBuffer blob(partition_);
+    ASSERT_EQ(OkStatus(), blob.Init());
+    blob_store::BlobStore::BlobWriterWithBuffer<0> writer(blob);
+    ASSERT_EQ(OkStatus(), writer.Open());
+    ASSERT_EQ(OkStatus(), writer.Write(span(data_).first(size_bytes)));
+    ASSERT_EQ(OkStatus(), writer.Abandon());
+  }
+
+  uint32_t ChecksumOf(size_t size_bytes) const {
+    return checksum::Crc32::Calculate(span(data_).first(size_bytes));
+  }
+
+  class BlobStoreBuffer : public blob_store::BlobStoreBuffer<kBufferSize> {
+   public:
+    explicit BlobStoreBuffer(kvs::FlashPartition& partition)
+        : blob_store::BlobStoreBuffer<kBufferSize>(
+              "Blob", partition, &checksum_, kvs::TestKvs(), kBufferSize) {}
+
+   private:
+    kvs::ChecksumCrc16 checksum_;
+  };
+
+  kvs::FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash_;
+  kvs::FlashPartition partition_;
+  std::array<std::byte, kSectorSize * kSectorCount> data_;
+};
+
+TEST_F(BlobStoreWriteHandlerTest, GetStatus_NoInterruptedWrite) {
+  BlobStoreBuffer blob(partition_);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  blob_store::BlobStore::BlobWriterWithBuffer<0> writer(blob);
+  BlobStoreWriteHandler handler(kResourceId, writer);
+
+  uint64_t readable_offset = 1;
+  uint64_t writeable_offset = 1;
+  uint64_t read_checksum = 1;
+  uint64_t write_checksum = 1;
+  ASSERT_EQ(OkStatus(),
+            handler.GetStatus(readable_offset,
+                              writeable_offset,
+                              read_checksum,
+                              write_checksum));
+  EXPECT_EQ(0u, readable_offset);
+  EXPECT_EQ(0u, writeable_offset);
+  EXPECT_EQ(0u, read_checksum);
+  EXPECT_EQ(ChecksumOf(0), write_checksum);
+}
+
+TEST_F(BlobStoreWriteHandlerTest, GetStatus_ReportsResumeOffsetAndChecksum) {
+  WriteInterrupted(3 * kSectorSize - 100);
+
+  // Start over with a new blob store, as if the device had rebooted.
+  BlobStoreBuffer blob(partition_);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  blob_store::BlobStore::BlobWriterWithBuffer<0> writer(blob);
+  BlobStoreWriteHandler handler(kResourceId, writer);
+
+  uint64_t readable_offset, writeable_offset, read_checksum, write_checksum;
+  ASSERT_EQ(OkStatus(),
+            handler.GetStatus(readable_offset,
+                              writeable_offset,
+                              read_checksum,
+                              write_checksum));
+  // Resume keeps the full sectors, except for the last one.
+  EXPECT_EQ(kSectorSize, writeable_offset);
+  EXPECT_EQ(ChecksumOf(kSectorSize), write_checksum);
+
+  // Asking again reports the same offset.
+  ASSERT_EQ(OkStatus(),
+            handler.GetStatus(readable_offset,
+                              writeable_offset,
+                              read_checksum,
+                              write_checksum));
+  EXPECT_EQ(kSectorSize, writeable_offset);
+  EXPECT_EQ(ChecksumOf(kSectorSize), write_checksum);
+}
+
+TEST_F(BlobStoreWriteHandlerTest, PrepareWrite_AtResumeOffset) {
+  WriteInterrupted(3 * kSectorSize - 100);
+
+  BlobStoreBuffer blob(partition_);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  blob_store::BlobStore::BlobWriterWithBuffer<0> writer(blob);
+  BlobStoreWriteHandler handler(kResourceId, writer);
+
+  EXPECT_EQ(Status::FailedPrecondition(), handler.PrepareWrite(100));
+  ASSERT_EQ(OkStatus(), handler.PrepareWrite(kSectorSize));
+
+  // Finish the blob as the transfer would.
+  ASSERT_EQ(OkStatus(), writer.Write(span(data_).subspan(kSectorSize)));
+  ASSERT_EQ(OkStatus(), handler.FinalizeWrite(OkStatus()));
+
+  blob_store::BlobStore::BlobReader reader(blob);
+  ASSERT_EQ(OkStatus(), reader.Open());
+  Result<ConstByteSpan> contents = reader.GetMemoryMappedBlob();
+  ASSERT_EQ(OkStatus(), contents.status());
+  ASSERT_EQ(data_.size(), contents->size());
+  EXPECT_EQ(0, std::memcmp(data_.data(), contents->data(), data_.size()));
+  EXPECT_EQ(OkStatus(), reader.Close());
+}
+
+TEST_F(BlobStoreWriteHandlerTest, FinalizeWrite_FailureKeepsProgress) {
+  BlobStoreBuffer blob(partition_);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  blob_store::BlobStore::BlobWriterWithBuffer<0> writer(blob);
+  BlobStoreWriteHandler handler(kResourceId, writer);
+
+  ASSERT_EQ(OkStatus(), handler.PrepareWrite());
+  ASSERT_EQ(OkStatus(), writer.Write(span(data_).first(2 * kSectorSize + 1)));
+  ASSERT_EQ(OkStatus(), handler.FinalizeWrite(Status::DeadlineExceeded()));
+  EXPECT_FALSE(writer.IsOpen());
+
+  uint64_t readable_offset, writeable_offset, read_checksum, write_checksum;
+  ASSERT_EQ(OkStatus(),
+            handler.GetStatus(readable_offset,
+                              writeable_offset,
+                              read_checksum,
+                              write_checksum));
+  EXPECT_EQ(kSectorSize, writeable_offset);
+  EXPECT_EQ(ChecksumOf(kSectorSize), write_checksum);
+}
+
+TEST_F(BlobStoreWriteHandlerTest, PrepareWrite_StartsOver) {
+  WriteInterrupted(3 * kSectorSize - 100);
+
+  BlobStoreBuffer blob(partition_);
+  ASSERT_EQ(OkStatus(), blob.Init());
+  blob_store::BlobStore::BlobWriterWithBuffer<0> writer(blob);
+  BlobStoreWriteHandler handler(kResourceId, writer);
+
+  uint64_t readable_offset, writeable_offset, read_checksum, write_checksum;
+  ASSERT_EQ(OkStatus(),
+            handler.GetStatus(readable_offset,
+                              writeable_offset,
+                              read_checksum,
+                              write_checksum));
+  ASSERT_EQ(OkStatus(), handler.PrepareWrite());
+  EXPECT_EQ(0u, writer.CurrentSizeBytes());
+
+  ASSERT_EQ(OkStatus(),
+            handler.GetStatus(readable_offset,
+                              writeable_offset,
+                              read_checksum,
+                              write_checksum));
+  EXPECT_EQ(0u, writeable_offset);
+  EXPECT_EQ(ChecksumOf(0), write_checksum);
+}
+
+}  // namespace
+}  // namespace pw::transfer
@@ -17,12 +17,46 @@
 #include "pw_assert/check.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_protobuf/serialized_size.h"
+#include "pw_protobuf/wire_format.h"
 #include "pw_status/try.h"
+#include "pw_varint/varint.h"
 
 namespace pw::transfer::internal {
 
 namespace ProtoChunk = transfer::pwpb::Chunk;
 
+namespace {
+
+Status DecodeReceivedRange(ConstByteSpan message, Chunk::ReceivedRange& range) {
+  protobuf::Decoder decoder(message);
+  Status status;
+
+  range = {};
+  while ((status = decoder.Next()).ok()) {
+    switch (static_cast<ProtoChunk::ReceivedRange::Fields>(
+        decoder.FieldNumber())) {
+      case ProtoChunk::ReceivedRange::Fields::kStartOffset:
+        PW_TRY(decoder.ReadUint32(&range.start_offset));
+        break;
+      case ProtoChunk::ReceivedRange::Fields::kEndOffset:
+        PW_TRY(decoder.ReadUint32(&range.end_offset));
+        break;
+    }
+  }
+
+  return status.IsOutOfRange() ? OkStatus() : Status::DataLoss();
+}
+
+size_t ReceivedRangeEncodedSize(const Chunk::ReceivedRange& range) {
+  return protobuf::SizeOfVarintField(
+             ProtoChunk::ReceivedRange::Fields::kStartOffset,
+             range.start_offset) +
+         protobuf::SizeOfVarintField(
+             ProtoChunk::ReceivedRange::Fields::kEndOffset, range.end_offset);
+}
+
+}  // namespace
+
 Result<Chunk::Identifier> Chunk::ExtractIdentifier(ConstByteSpan message) {
   protobuf::Decoder decoder(message);
 
@@ -187,6 +221,20 @@ Result<Chunk> Chunk::Parse(ConstByteSpan message) {
         chunk.set_initial_offset(value);
         break;
 
+      case ProtoChunk::Fields::kReceivedRanges: {
+        ConstByteSpan range_message;
+        PW_TRY(decoder.ReadBytes(&range_message));
+
+        ReceivedRange range;
+        PW_TRY(DecodeReceivedRange(range_message, range));
+
+        // Drop any ranges that don't fit; the transmitter resends their data.
+        if (chunk.received_ranges_count_ < kMaxReceivedRanges) {
+          chunk.received_ranges_[chunk.received_ranges_count_++] = range;
+        }
+        break;
+      }
+
         // Silently ignore any unrecognized fields.
     }
   }
@@ -219,11 +267,28 @@ Result<ConstByteSpan> Chunk::Encode(ByteSpan buffer) const {
   PW_CHECK(protocol_version_ != ProtocolVersion::kUnknown,
            "Cannot encode a transfer chunk with an unknown protocol version");
 
-  ProtoChunk::MemoryEncoder encoder(buffer);
+  // A payload which was read directly into its encoded position is left in
+  // place; only the key and length prefix of its field are written.
+  size_t payload_field_size = 0;
+  if (has_payload()) {
+    const size_t payload_offset = PayloadOffset(payload_.size());
+    if (payload_.data() == buffer.data() + payload_offset &&
+        payload_offset + payload_.size() <= buffer.size()) {
+      const size_t key_size = varint::Encode(
+          static_cast<uint32_t>(protobuf::FieldKey(
+              static_cast<uint32_t>(ProtoChunk::Fields::kData),
+              protobuf::WireType::kDelimited)),
+          buffer);
+      varint::Encode(payload_.size(), buffer.subspan(key_size));
+      payload_field_size = payload_offset + payload_.size();
+    }
+  }
+
+  ProtoChunk::MemoryEncoder encoder(buffer.subspan(payload_field_size));
 
   // Write the payload first to avoid clobbering it if it shares the same buffer
   // as the encode buffer.
-  if (has_payload()) {
+  if (has_payload() && payload_field_size == 0) {
     encoder.WriteData(payload_).IgnoreError();
   }
 
@@ -300,8 +365,21 @@ Result<ConstByteSpan> Chunk::Encode(ByteSpan buffer) const {
     encoder.WriteStatus(status_.value().code()).IgnoreError();
   }
 
+  for (const ReceivedRange& range : received_ranges()) {
+    ProtoChunk::ReceivedRange::StreamEncoder range_encoder =
+        encoder.GetReceivedRangesEncoder();
+    range_encoder.WriteStartOffset(range.start_offset).IgnoreError();
+    range_encoder.WriteEndOffset(range.end_offset).IgnoreError();
+  }
+
   PW_TRY(encoder.status());
-  return ConstByteSpan(encoder);
+  return ConstByteSpan(buffer.first(payload_field_size +
+                                    ConstByteSpan(encoder).size()));
+}
+
+size_t Chunk::PayloadOffset(size_t payload_size) {
+  return protobuf::SizeOfDelimitedFieldWithoutValue(
+      ProtoChunk::Fields::kData, static_cast<uint32_t>(payload_size));
 }
 
 size_t Chunk::EncodedSize() const {
@@ -386,6 +464,12 @@ size_t Chunk::EncodedSize() const {
                                         status_.value().code());
   }
 
+  for (const ReceivedRange& range : received_ranges()) {
+    size += protobuf::SizeOfDelimitedField(
+        ProtoChunk::Fields::kReceivedRanges,
+        static_cast<uint32_t>(ReceivedRangeEncodedSize(range)));
+  }
+
   return size;
 }
 
@@ -62,5 +62,64 @@ TEST(Chunk, EncodedSizeMatchesBuffer) {
   EXPECT_EQ(chunk.EncodedSize(), result->size_bytes());
 }
 
+TEST(Chunk, ReceivedRanges_EncodeAndParse) {
+  constexpr Chunk::ReceivedRange kRanges[] = {{16, 32}, {48, 300}};
+
+  Chunk chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kParametersRetransmit);
+  chunk.set_session_id(42)
+      .set_offset(8)
+      .set_window_end_offset(512)
+      .set_received_ranges(kRanges);
+
+  std::array<std::byte, 64> buffer;
+  auto result = chunk.Encode(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(chunk.EncodedSize(), result->size_bytes());
+
+  Result<Chunk> parsed = Chunk::Parse(*result);
+  ASSERT_EQ(parsed.status(), OkStatus());
+  ASSERT_EQ(parsed->received_ranges().size(), 2u);
+  EXPECT_EQ(parsed->received_ranges()[0].start_offset, 16u);
+  EXPECT_EQ(parsed->received_ranges()[0].end_offset, 32u);
+  EXPECT_EQ(parsed->received_ranges()[1].start_offset, 48u);
+  EXPECT_EQ(parsed->received_ranges()[1].end_offset, 300u);
+}
+
+TEST(Chunk, ReceivedRanges_DropsRangesBeyondMaximum) {
+  std::array<Chunk::ReceivedRange, Chunk::kMaxReceivedRanges + 1> ranges;
+  for (uint32_t i = 0; i < ranges.size(); ++i) {
+    ranges[i] = {10 * (i + 1), 10 * (i + 1) + 5};
+  }
+
+  Chunk chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kParametersRetransmit);
+  chunk.set_received_ranges(ranges);
+  EXPECT_EQ(chunk.received_ranges().size(), Chunk::kMaxReceivedRanges);
+}
+
+TEST(Chunk, Encode_PayloadAtPayloadOffsetIsNotMoved) {
+  std::array<std::byte, 64> buffer;
+  ByteSpan payload = span(buffer).subspan(Chunk::PayloadOffset(16), 16);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<std::byte>(i);
+  }
+
+  Chunk chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kData);
+  chunk.set_session_id(42).set_offset(128).set_payload(payload);
+
+  auto result = chunk.Encode(buffer);
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(chunk.EncodedSize(), result->size_bytes());
+
+  Result<Chunk> parsed = Chunk::Parse(*result);
+  ASSERT_EQ(parsed.status(), OkStatus());
+  EXPECT_EQ(parsed->session_id(), 42u);
+  EXPECT_EQ(parsed->offset(), 128u);
+  ASSERT_EQ(parsed->payload().size(), 16u);
+  EXPECT_EQ(parsed->payload().data(), payload.data());
+  for (size_t i = 0; i < parsed->payload().size(); ++i) {
+    EXPECT_EQ(parsed->payload()[i], static_cast<std::byte>(i));
+  }
+}
+
 }  // namespace
 }  // namespace pw::transfer::internal
@@ -16,7 +16,13 @@
 
 #include "pw_transfer/client.h"
 
+#include <array>
+#include <limits>
+
 #include "pw_log/log.h"
+#include "pw_protobuf/decoder.h"
+#include "pw_status/try.h"
+#include "pw_transfer/transfer.pwpb.h"
 
 namespace pw::transfer {
 
@@ -28,6 +34,93 @@ Result<Client::Handle> Client::Read(
     chrono::SystemClock::duration timeout,
     chrono::SystemClock::duration initial_chunk_timeout,
     uint32_t initial_offset) {
+  return StartRead(resource_id,
+                   output,
+                   std::move(on_completion),
+                   protocol_version,
+                   timeout,
+                   initial_chunk_timeout,
+                   initial_offset,
+                   std::numeric_limits<size_t>::max());
+}
+
+Result<Client::Handle> Client::Write(
+    uint32_t resource_id,
+    stream::Reader& input,
+    CompletionFunc&& on_completion,
+    ProtocolVersion protocol_version,
+    chrono::SystemClock::duration timeout,
+    chrono::SystemClock::duration initial_chunk_timeout,
+    uint32_t initial_offset) {
+  return StartWrite(resource_id,
+                    input,
+                    std::move(on_completion),
+                    protocol_version,
+                    timeout,
+                    initial_chunk_timeout,
+                    initial_offset,
+                    std::numeric_limits<size_t>::max());
+}
+
+Result<Client::Handle> Client::ReadRange(
+    uint32_t resource_id,
+    uint32_t offset,
+    size_t size_bytes,
+    stream::Writer& output,
+    CompletionFunc&& on_completion,
+    chrono::SystemClock::duration timeout,
+    chrono::SystemClock::duration initial_chunk_timeout) {
+  if (!IsValidRange(offset, size_bytes)) {
+    return Status::InvalidArgument();
+  }
+  return StartRead(resource_id,
+                   output,
+                   std::move(on_completion),
+                   default_protocol_version,
+                   timeout,
+                   initial_chunk_timeout,
+                   offset,
+                   offset + size_bytes);
+}
+
+Result<Client::Handle> Client::WriteRange(
+    uint32_t resource_id,
+    uint32_t offset,
+    size_t size_bytes,
+    stream::Reader& input,
+    CompletionFunc&& on_completion,
+    chrono::SystemClock::duration timeout,
+    chrono::SystemClock::duration initial_chunk_timeout) {
+  if (!IsValidRange(offset, size_bytes)) {
+    return Status::InvalidArgument();
+  }
+  return StartWrite(resource_id,
+                    input,
+                    std::move(on_completion),
+                    default_protocol_version,
+                    timeout,
+                    initial_chunk_timeout,
+                    offset,
+                    offset + size_bytes);
+}
+
+bool Client::IsValidRange(uint32_t offset, size_t size_bytes) const {
+  // Ranges start at nonzero offsets, which is only supported by protocol
+  // version 2. Transfer offsets are 32 bits.
+  return default_protocol_version >= ProtocolVersion::kVersionTwo &&
+         size_bytes > 0 &&
+         size_bytes <= std::numeric_limits<uint32_t>::max() - offset;
+}
+
+Result<Client::Handle> Client::StartRead(
+    uint32_t resource_id,
+    stream::Writer& output,
+    CompletionFunc&& on_completion,
+    ProtocolVersion protocol_version,
+    chrono::SystemClock::duration timeout,
+    chrono::SystemClock::duration initial_chunk_timeout,
+    uint32_t initial_offset,
+    size_t transfer_size_bytes) {
   if (on_completion == nullptr ||
       protocol_version == ProtocolVersion::kUnknown) {
     return Status::InvalidArgument();
@@ -62,18 +155,20 @@ Result<Client::Handle> Client::Read(
                                        initial_chunk_timeout,
                                        max_retries_,
                                        max_lifetime_retries_,
-                                       initial_offset);
+                                       initial_offset,
+                                       transfer_size_bytes);
   return handle;
 }
 
-Result<Client::Handle> Client::Write(
+Result<Client::Handle> Client::StartWrite(
     uint32_t resource_id,
     stream::Reader& input,
     CompletionFunc&& on_completion,
     ProtocolVersion protocol_version,
     chrono::SystemClock::duration timeout,
     chrono::SystemClock::duration initial_chunk_timeout,
-    uint32_t initial_offset) {
+    uint32_t initial_offset,
+    size_t transfer_size_bytes) {
   if (on_completion == nullptr ||
       protocol_version == ProtocolVersion::kUnknown) {
     return Status::InvalidArgument();
@@ -108,11 +203,82 @@ Result<Client::Handle> Client::Write(
                                        initial_chunk_timeout,
                                        max_retries_,
                                        max_lifetime_retries_,
-                                       initial_offset);
+                                       initial_offset,
+                                       transfer_size_bytes);
 
   return handle;
 }
 
+Status Client::GetResourceStatus(uint32_t resource_id,
+                                 ResourceStatusFunc&& on_completion) {
+  if (on_completion == nullptr) {
+    return Status::InvalidArgument();
+  }
+
+  if (resource_status_call_.active()) {
+    return Status::Unavailable();
+  }
+
+  std::array<std::byte, pwpb::ResourceStatusRequest::kMaxEncodedSizeBytes>
+      buffer = {};
+  pwpb::ResourceStatusRequest::MemoryEncoder encoder(buffer);
+  PW_TRY(encoder.WriteResourceId(resource_id));
+
+  on_resource_status_ = std::move(on_completion);
+  resource_status_call_ = client_.GetResourceStatus(
+      ConstByteSpan(encoder),
+      [this](ConstByteSpan response, Status status) {
+        OnResourceStatus(response, status);
+      },
+      [this](Status status) { OnResourceStatus({}, status); });
+  return OkStatus();
+}
+
+void Client::OnResourceStatus(ConstByteSpan response, Status status) {
+  ResourceStatus resource_status = {};
+
+  protobuf::Decoder decoder(response);
+  Status decode_status;
+  while (status.ok() && (decode_status = decoder.Next()).ok()) {
+    switch (static_cast<pwpb::ResourceStatus::Fields>(decoder.FieldNumber())) {
+      case pwpb::ResourceStatus::Fields::kResourceId:
+        decode_status = decoder.ReadUint32(&resource_status.resource_id);
+        break;
+      case pwpb::ResourceStatus::Fields::kWriteableOffset:
+        decode_status = decoder.ReadUint64(&resource_status.writeable_offset);
+        break;
+      case pwpb::ResourceStatus::Fields::kReadableOffset:
+        decode_status = decoder.ReadUint64(&resource_status.readable_offset);
+        break;
+      case pwpb::ResourceStatus::Fields::kWriteChecksum:
+        decode_status = decoder.ReadUint64(&resource_status.write_checksum);
+        break;
+      case pwpb::ResourceStatus::Fields::kReadChecksum:
+        decode_status = decoder.ReadUint64(&resource_status.read_checksum);
+        break;
+      case pwpb::ResourceStatus::Fields::kStatus:
+        // The handler's status is also the status of the RPC.
+        break;
+    }
+    if (!decode_status.ok()) {
+      break;
+    }
+  }
+
+  if (status.ok() && !decode_status.IsOutOfRange()) {
+    PW_LOG_ERROR("Failed to decode resource status: %d",
+                 decode_status.code());
+    status = Status::DataLoss();
+  }
+
+  // Move the callback out first, so that it may request the status again.
+  ResourceStatusFunc on_completion = std::move(on_resource_status_);
+  on_resource_status_ = nullptr;
+  if (on_completion != nullptr) {
+    on_completion(status, resource_status);
+  }
+}
+
 Client::Handle Client::AssignHandle() {
   uint32_t handle_id = next_handle_id_++;
   if (handle_id == Handle::kUnassignedHandleId) {
@@ -14,14 +14,19 @@
 
 #include "pw_transfer/client.h"
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
+#include <optional>
 
 #include "pw_assert/check.h"
 #include "pw_bytes/array.h"
+#include "pw_metric/metric.h"
 #include "pw_rpc/raw/client_testing.h"
 #include "pw_rpc/test_helpers.h"
 #include "pw_thread/thread.h"
 #include "pw_thread_stl/options.h"
+#include "pw_tokenizer/tokenize.h"
 #include "pw_transfer_private/chunk_testing.h"
 #include "pw_unit_test/framework.h"
 
@@ -1870,6 +1875,89 @@ TEST_F(ReadTransfer, Version2_SingleChunk) {
           .set_session_id(1)));
 }
 
+TEST_F(ReadTransfer, Version2_ReadRange_CompletesAtEndOfRange) {
+  stream::MemoryWriterBuffer<64> writer;
+  Status transfer_status = Status::Unknown();
+
+  ASSERT_EQ(
+      OkStatus(),
+      client_
+          .ReadRange(
+              3,
+              /*offset=*/16,
+              /*size_bytes=*/16,
+              writer,
+              [&transfer_status](Status status) { transfer_status = status; },
+              cfg::kDefaultClientTimeout,
+              cfg::kDefaultClientTimeout)
+          .status());
+
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  // The initial chunk requests only the data within the range.
+  rpc::PayloadsView payloads =
+      context_.output().payloads<Transfer::Read>(context_.channel().id());
+  ASSERT_EQ(payloads.size(), 1u);
+
+  Chunk chunk = DecodeChunk(payloads[0]);
+  EXPECT_EQ(chunk.type(), Chunk::Type::kStart);
+  EXPECT_EQ(chunk.resource_id(), 3u);
+  EXPECT_EQ(chunk.offset(), 16u);
+  EXPECT_EQ(chunk.window_end_offset(), 32u);
+
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kStartAck)
+                      .set_session_id(1)
+                      .set_resource_id(3)
+                      .set_initial_offset(16)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), 2u);
+  chunk = DecodeChunk(payloads.back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kStartAckConfirmation);
+  EXPECT_EQ(chunk.offset(), 16u);
+  EXPECT_EQ(chunk.window_end_offset(), 32u);
+
+  // The server has more data after the range, so it does not mark the chunk
+  // as final. The client ends the transfer once it has the whole range.
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kData)
+                      .set_session_id(1)
+                      .set_offset(16)
+                      .set_payload(span(kData32).subspan(16))
+                      .set_remaining_bytes(32)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(payloads.size(), 3u);
+  chunk = DecodeChunk(payloads.back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kCompletion);
+  ASSERT_TRUE(chunk.status().has_value());
+  EXPECT_EQ(chunk.status().value(), OkStatus());
+
+  EXPECT_EQ(transfer_status, OkStatus());
+  ASSERT_EQ(writer.bytes_written(), 16u);
+  EXPECT_EQ(std::memcmp(writer.data(), kData32.data() + 16, 16), 0);
+
+  context_.server().SendServerStream<Transfer::Read>(EncodeChunk(
+      Chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kCompletionAck)
+          .set_session_id(1)));
+}
+
+TEST_F(ReadTransfer, ReadRange_InvalidArguments) {
+  stream::MemoryWriterBuffer<64> writer;
+
+  EXPECT_EQ(Status::InvalidArgument(),
+            legacy_client_.ReadRange(3, 16, 16, writer, [](Status) {}).status());
+  EXPECT_EQ(Status::InvalidArgument(),
+            client_.ReadRange(3, 16, 0, writer, [](Status) {}).status());
+  EXPECT_EQ(
+      Status::InvalidArgument(),
+      client_
+          .ReadRange(
+              3, std::numeric_limits<uint32_t>::max(), 1, writer, [](Status) {})
+          .status());
+}
+
 TEST_F(ReadTransfer, Version2_ServerRunsLegacy) {
   stream::MemoryWriterBuffer<64> writer;
   Status transfer_status = Status::Unknown();
@@ -3079,5 +3167,97 @@ TEST_F(WriteTransfer, Write_TransferSize_SmallerThanResource) {
   transfer_thread_.WaitUntilEventIsProcessed();
 }
 
+// These tests only run if the module is configured with
+// PW_TRANSFER_ENABLE_METRICS.
+#if PW_TRANSFER_ENABLE_METRICS
+
+// Returns the named metric of the session with the given ID from a transfer
+// thread's metrics.
+std::optional<uint32_t> SessionMetric(metric::Group& thread_metrics,
+                                      uint32_t session_id,
+                                      uint32_t name_token) {
+  constexpr uint32_t kSessionIdToken =
+      PW_TOKENIZE_STRING_MASK("metrics", 0x7fffffff, "session_id");
+
+  for (const metric::Group& session : thread_metrics.children()) {
+    auto is_session = [&](const metric::Metric& m) {
+      return m.name() == kSessionIdToken && m.as_int() == session_id;
+    };
+    if (std::none_of(
+            session.metrics().begin(), session.metrics().end(), is_session)) {
+      continue;
+    }
+    for (const metric::Metric& m : session.metrics()) {
+      if (m.name() == name_token) {
+        return m.as_int();
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+TEST_F(ReadTransfer, Metrics_RecordsReceivedData) {
+  stream::MemoryWriterBuffer<64> writer;
+  Status transfer_status = Status::Unknown();
+
+  // Each of the thread's contexts has a group of metrics.
+  EXPECT_EQ(transfer_thread_.metrics().children().size(), 2u);
+
+  ASSERT_EQ(
+      OkStatus(),
+      client_
+          .Read(
+              3,
+              writer,
+              [&transfer_status](Status status) { transfer_status = status; },
+              cfg::kDefaultClientTimeout,
+              cfg::kDefaultClientTimeout)
+          .status());
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kStartAck)
+                      .set_session_id(1)
+                      .set_resource_id(3)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kData)
+                      .set_session_id(1)
+                      .set_offset(0)
+                      .set_payload(span(kData32).first(16))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  context_.server().SendServerStream<Transfer::Read>(
+      EncodeChunk(Chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kData)
+                      .set_session_id(1)
+                      .set_offset(16)
+                      .set_payload(span(kData32).subspan(16))
+                      .set_remaining_bytes(0)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+  EXPECT_EQ(transfer_status, OkStatus());
+
+  constexpr uint32_t kBytes =
+      PW_TOKENIZE_STRING_MASK("metrics", 0x7fffffff, "bytes");
+  constexpr uint32_t kChunks =
+      PW_TOKENIZE_STRING_MASK("metrics", 0x7fffffff, "chunks");
+  constexpr uint32_t kMaxWindowSizeBytes =
+      PW_TOKENIZE_STRING_MASK("metrics", 0x7fffffff, "max_window_size_bytes");
+  constexpr uint32_t kRetransmits =
+      PW_TOKENIZE_STRING_MASK("metrics", 0x7fffffff, "retransmits");
+
+  metric::Group& metrics = transfer_thread_.metrics();
+  EXPECT_EQ(SessionMetric(metrics, 1, kBytes), 32u);
+  EXPECT_EQ(SessionMetric(metrics, 1, kChunks), 2u);
+  EXPECT_EQ(SessionMetric(metrics, 1, kMaxWindowSizeBytes), 64u);
+  EXPECT_EQ(SessionMetric(metrics, 1, kRetransmits), 0u);
+
+  context_.server().SendServerStream<Transfer::Read>(EncodeChunk(
+      Chunk(ProtocolVersion::kVersionTwo, Chunk::Type::kCompletionAck)
+          .set_session_id(1)));
+}
+
+#endif  // PW_TRANSFER_ENABLE_METRICS
+
 }  // namespace
 }  // namespace pw::transfer::test
@@ -17,6 +17,7 @@
 
 #include "pw_transfer/internal/context.h"
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 
@@ -24,6 +25,8 @@
 #include "pw_chrono/system_clock.h"
 #include "pw_log/log.h"
 #include "pw_protobuf/serialized_size.h"
+#include "pw_rpc/multibuf.h"
+#include "pw_trace/trace.h"
 #include "pw_transfer/transfer.pwpb.h"
 #include "pw_transfer/transfer_thread.h"
 #include "pw_varint/varint.h"
@@ -66,12 +69,16 @@ void Context::HandleEvent(const Event& event) {
     case EventType::kClientChunk:
     case EventType::kServerChunk:
       PW_CHECK(initialized());
-      HandleChunkEvent(event.chunk);
+      if (RestoreSharedStreamPosition()) {
+        HandleChunkEvent(event.chunk);
+      }
       return;
 
     case EventType::kClientTimeout:
     case EventType::kServerTimeout:
-      HandleTimeout();
+      if (RestoreSharedStreamPosition()) {
+        HandleTimeout();
+      }
       return;
 
     case EventType::kClientEndTransfer:
@@ -188,6 +195,61 @@ void Context::SendInitialLegacyTransmitChunk() {
   EncodeAndSendChunk(chunk);
 }
 
+bool Context::RestoreSharedStreamPosition() {
+  if (!active() || !stream_shared()) {
+    return true;
+  }
+
+  // Other transfers move the stream, so it has to be returned to where this
+  // transfer left off before reading or writing any data.
+  if (const Status status = stream_->Seek(offset_); !status.ok()) {
+    PW_LOG_ERROR(
+        "Transfer %u failed to seek shared stream to offset %u, status %u",
+        id_for_log(),
+        static_cast<unsigned>(offset_),
+        status.code());
+    TerminateTransfer(Status::DataLoss());
+    return false;
+  }
+  return true;
+}
+
+Result<ByteSpan> Context::ReadFromStream(ByteSpan buffer) {
+#if PW_TRANSFER_ENABLE_METRICS
+  const chrono::SystemClock::time_point start = chrono::SystemClock::now();
+  Result<ByteSpan> result = reader().Read(buffer);
+  metrics_.RecordStreamTime(chrono::SystemClock::now() - start);
+  return result;
+#else
+  return reader().Read(buffer);
+#endif  // PW_TRANSFER_ENABLE_METRICS
+}
+
+Status Context::WriteToStream(ConstByteSpan data) {
+#if PW_TRANSFER_ENABLE_METRICS
+  const chrono::SystemClock::time_point start = chrono::SystemClock::now();
+  const Status status = writer().Write(data);
+  metrics_.RecordStreamTime(chrono::SystemClock::now() - start);
+  if (status.ok()) {
+    metrics_.RecordData(data.size());
+  }
+  return status;
+#else
+  return writer().Write(data);
+#endif  // PW_TRANSFER_ENABLE_METRICS
+}
+
+void Context::RecordWindow() {
+#if PW_TRANSFER_ENABLE_METRICS
+  metrics_.RecordWindow(window_end_offset_ > offset_
+                            ? window_end_offset_ - offset_
+                            : 0);
+#endif  // PW_TRANSFER_ENABLE_METRICS
+#if PW_TRANSFER_ENABLE_TRACING
+  PW_TRACE_INSTANT("Window", "pw_transfer", session_id_);
+#endif  // PW_TRANSFER_ENABLE_TRACING
+}
+
 void Context::UpdateTransferParameters() {
   size_t pending_bytes =
       std::min(max_parameters_->pending_bytes(),
@@ -198,13 +260,308 @@ void Context::UpdateTransferParameters() {
 
   max_chunk_size_bytes_ = MaxWriteChunkSize(
       max_parameters_->max_chunk_size_bytes(), rpc_writer_->channel_id());
+
+  if (max_parameters_->adaptive_windowing()) {
+    // The adaptive window can only reduce the window end offset, so the chunk
+    // size calculated above remains valid.
+    uint64_t adaptive_window_size =
+        static_cast<uint64_t>(window_size_chunks_) * max_chunk_size_bytes_;
+    if (adaptive_window_size < pending_bytes) {
+      window_size_ = static_cast<uint32_t>(adaptive_window_size);
+      window_end_offset_ = offset_ + window_size_;
+    }
+  }
+
+  // A transfer of a range of a resource never requests data past its end.
+  if (const size_t end_offset = ReceiveEndOffset();
+      window_end_offset_ > end_offset) {
+    window_end_offset_ = static_cast<uint32_t>(end_offset);
+    window_size_ = window_end_offset_ - offset_;
+  }
+}
+
+void Context::GrowWindow() {
+  if (!max_parameters_->adaptive_windowing()) {
+    return;
+  }
+
+  // Don't grow the window beyond what the configured pending bytes allow, so
+  // that it does not take many losses to bring it back down.
+  const uint32_t max_window_size_chunks =
+      std::max(max_parameters_->pending_bytes() / max_chunk_size_bytes_,
+               kInitialWindowSizeChunks);
+
+  if (window_phase_ == WindowPhase::kSlowStart) {
+    window_size_chunks_ *= 2;
+    if (window_size_chunks_ >= slow_start_threshold_chunks_) {
+      window_size_chunks_ = slow_start_threshold_chunks_;
+      window_phase_ = WindowPhase::kCongestionAvoidance;
+    }
+  } else {
+    window_size_chunks_ += 1;
+  }
+
+  window_size_chunks_ = std::min(window_size_chunks_, max_window_size_chunks);
+}
+
+void Context::ShrinkWindowOnLoss() {
+  if (!max_parameters_->adaptive_windowing()) {
+    return;
+  }
+
+  window_size_chunks_ =
+      std::max(window_size_chunks_ / 2, kInitialWindowSizeChunks);
+  slow_start_threshold_chunks_ = window_size_chunks_;
+  window_phase_ = WindowPhase::kCongestionAvoidance;
+
+  PW_LOG_DEBUG("Transfer %u detected chunk loss; window reduced to %u chunks",
+               id_for_log(),
+               static_cast<unsigned>(window_size_chunks_));
+}
+
+void Context::ShrinkWindowOnTimeout() {
+  if (!max_parameters_->adaptive_windowing()) {
+    return;
+  }
+
+  slow_start_threshold_chunks_ =
+      std::max(window_size_chunks_ / 2, kInitialWindowSizeChunks);
+  window_size_chunks_ = kInitialWindowSizeChunks;
+  window_phase_ = WindowPhase::kSlowStart;
+
+  PW_LOG_DEBUG("Transfer %u timed out; restarting window at %u chunk(s)",
+               id_for_log(),
+               static_cast<unsigned>(window_size_chunks_));
+}
+
+void Context::HandleRttSample(chrono::SystemClock::duration rtt) {
+#if PW_TRANSFER_ENABLE_METRICS
+  metrics_.RecordRtt(rtt);
+#endif  // PW_TRANSFER_ENABLE_METRICS
+
+  if (min_rtt_ == chrono::SystemClock::duration::zero() || rtt < min_rtt_) {
+    min_rtt_ = rtt;
+    return;
+  }
+
+  // A round trip time well above the best observed one indicates that chunks
+  // are queueing somewhere along the link. Stop growing the window
+  // exponentially once the added delay becomes a meaningful fraction of the
+  // chunk timeout, before it starts triggering retries.
+  if (window_phase_ == WindowPhase::kSlowStart &&
+      rtt > min_rtt_ * kRttSaturationFactor &&
+      rtt > chunk_timeout_ / kRttSaturationTimeoutDivisor) {
+    slow_start_threshold_chunks_ = window_size_chunks_;
+    window_phase_ = WindowPhase::kCongestionAvoidance;
+
+    PW_LOG_DEBUG("Transfer %u round trip time increased to %u us; leaving "
+                 "slow start at %u chunks",
+                 id_for_log(),
+                 static_cast<unsigned>(
+                     std::chrono::ceil<std::chrono::microseconds>(rtt).count()),
+                 static_cast<unsigned>(window_size_chunks_));
+  }
+}
+
+bool Context::AddReceivedRange(uint32_t start_offset, uint32_t end_offset) {
+  size_t i = 0;
+  while (i < received_ranges_count_ &&
+         received_ranges_[i].end_offset < start_offset) {
+    ++i;
+  }
+
+  if (i < received_ranges_count_ &&
+      received_ranges_[i].start_offset <= end_offset) {
+    // The new range overlaps or touches an existing one. Extend it, then
+    // absorb any following ranges that it now reaches.
+    Chunk::ReceivedRange& merged = received_ranges_[i];
+    merged.start_offset = std::min(merged.start_offset, start_offset);
+    merged.end_offset = std::max(merged.end_offset, end_offset);
+
+    size_t next = i + 1;
+    while (next < received_ranges_count_ &&
+           received_ranges_[next].start_offset <= merged.end_offset) {
+      merged.end_offset =
+          std::max(merged.end_offset, received_ranges_[next].end_offset);
+      ++next;
+    }
+
+    std::copy(received_ranges_.begin() + next,
+              received_ranges_.begin() + received_ranges_count_,
+              received_ranges_.begin() + i + 1);
+    received_ranges_count_ -= static_cast<uint8_t>(next - (i + 1));
+    return true;
+  }
+
+  if (received_ranges_count_ == received_ranges_.size()) {
+    return false;
+  }
+
+  std::copy_backward(received_ranges_.begin() + i,
+                     received_ranges_.begin() + received_ranges_count_,
+                     received_ranges_.begin() + received_ranges_count_ + 1);
+  received_ranges_[i] = {start_offset, end_offset};
+  received_ranges_count_ += 1;
+  return true;
+}
+
+void Context::PopReceivedRange() {
+  PW_DASSERT(received_ranges_count_ > 0);
+  std::copy(received_ranges_.begin() + 1,
+            received_ranges_.begin() + received_ranges_count_,
+            received_ranges_.begin());
+  received_ranges_count_ -= 1;
+}
+
+bool Context::StoreOutOfOrderData(const Chunk& chunk) {
+  // The final chunk is never stored, as the transfer cannot complete until
+  // all data preceding it has arrived. It is simply resent.
+  if (!max_parameters_->selective_ack() || !chunk.has_payload() ||
+      chunk.IsFinalTransmitChunk() || chunk.offset() <= offset_ ||
+      chunk.offset() + chunk.payload().size() > window_end_offset_ ||
+      !writer().seekable(stream::Stream::kCurrent)) {
+    return false;
+  }
+
+  const uint32_t start_offset = chunk.offset();
+  const uint32_t end_offset = start_offset + chunk.payload().size();
+  const ptrdiff_t gap = static_cast<ptrdiff_t>(start_offset - offset_);
+
+  if (!writer().Seek(gap, stream::Stream::kCurrent).ok()) {
+    return false;
+  }
+
+  const Status write_status = WriteToStream(chunk.payload());
+  const ptrdiff_t rewind =
+      gap + (write_status.ok() ? static_cast<ptrdiff_t>(chunk.payload().size())
+                               : 0);
+
+  if (const Status status = writer().Seek(-rewind, stream::Stream::kCurrent);
+      !status.ok()) {
+    PW_LOG_ERROR(
+        "Transfer %u failed to restore writer position after out-of-order "
+        "write (status %u); aborting with DATA_LOSS",
+        id_for_log(),
+        status.code());
+    TerminateTransfer(Status::DataLoss());
+    return false;
+  }
+
+  // If the range does not fit, its data is resent and overwritten later.
+  if (!write_status.ok() || !AddReceivedRange(start_offset, end_offset)) {
+    return false;
+  }
+
+  PW_LOG_DEBUG("Transfer %u stored out-of-order data [%u, %u)",
+               id_for_log(),
+               static_cast<unsigned>(start_offset),
+               static_cast<unsigned>(end_offset));
+  return true;
+}
+
+bool Context::SkipReceivedData() {
+  bool skipped = false;
+
+  while (received_ranges_count_ > 0 &&
+         received_ranges_[0].start_offset <= offset_) {
+    const uint32_t end_offset = received_ranges_[0].end_offset;
+    PopReceivedRange();
+
+    if (end_offset <= offset_) {
+      continue;
+    }
+
+    const ptrdiff_t distance = static_cast<ptrdiff_t>(end_offset - offset_);
+    if (const Status status = writer().Seek(distance, stream::Stream::kCurrent);
+        !status.ok()) {
+      PW_LOG_ERROR(
+          "Transfer %u failed to seek past received data (status %u); "
+          "aborting with DATA_LOSS",
+          id_for_log(),
+          status.code());
+      TerminateTransfer(Status::DataLoss());
+      return false;
+    }
+
+    offset_ = end_offset;
+    skipped = true;
+  }
+
+  return skipped;
+}
+
+void Context::SetAcknowledgedRanges(const Chunk& parameters) {
+  received_ranges_count_ = 0;
+
+  uint32_t previous_end = parameters.offset();
+  for (const Chunk::ReceivedRange& range : parameters.received_ranges()) {
+    if (range.start_offset <= previous_end ||
+        range.end_offset <= range.start_offset) {
+      PW_LOG_WARN("Transfer %u received invalid received ranges; ignoring",
+                  id_for_log());
+      received_ranges_count_ = 0;
+      return;
+    }
+    received_ranges_[received_ranges_count_++] = range;
+    previous_end = range.end_offset;
+  }
+}
+
+bool Context::SkipAcknowledgedData() {
+  bool skipped = false;
+
+  while (received_ranges_count_ > 0 &&
+         received_ranges_[0].start_offset <= offset_) {
+    const Chunk::ReceivedRange range = received_ranges_[0];
+
+    if (range.end_offset <= offset_) {
+      PopReceivedRange();
+      continue;
+    }
+
+    if (range.end_offset > window_end_offset_) {
+      // Don't skip beyond the window; the receiver will advance past the range
+      // itself once it reaches it.
+      break;
+    }
+
+    if (Status status = SeekReader(range.end_offset); !status.ok()) {
+      // Fall back to resending everything from the current offset.
+      PW_LOG_DEBUG(
+          "Transfer %u cannot seek past received data (status %u); resending "
+          "it",
+          id_for_log(),
+          status.code());
+      received_ranges_count_ = 0;
+      break;
+    }
+
+    PW_LOG_DEBUG("Transfer %u skipping data [%u, %u) already received",
+                 id_for_log(),
+                 static_cast<unsigned>(offset_),
+                 static_cast<unsigned>(range.end_offset));
+
+    PopReceivedRange();
+    offset_ = range.end_offset;
+    skipped = true;
+  }
+
+  return skipped;
 }
 
 void Context::SetTransferParameters(Chunk& parameters) {
+  RecordWindow();
+
   parameters.set_window_end_offset(window_end_offset_)
       .set_max_chunk_size_bytes(max_chunk_size_bytes_)
       .set_min_delay_microseconds(kDefaultChunkDelayMicroseconds)
-      .set_offset(offset_);
+      .set_offset(offset_)
+      .set_received_ranges(received_ranges());
+
+  if (max_parameters_->adaptive_windowing() &&
+      rtt_sample_start_ == kNoTimeout) {
+    rtt_sample_start_ = chrono::SystemClock::now();
+  }
 }
 
 void Context::UpdateAndSendTransferParameters(TransmitAction action) {
@@ -235,6 +592,12 @@ void Context::SendTransferParameters(TransmitAction action) {
   parameters.set_session_id(session_id_);
   SetTransferParameters(parameters);
 
+#if PW_TRANSFER_ENABLE_METRICS
+  if (action == TransmitAction::kRetransmit) {
+    metrics_.RecordRetransmit();
+  }
+#endif  // PW_TRANSFER_ENABLE_METRICS
+
   PW_LOG_DEBUG(
       "Transfer %u sending transfer parameters: "
       "offset=%u, window_end_offset=%u, max_chunk_size=%u",
@@ -313,6 +676,13 @@ void Context::Initialize(const NewTransferEvent& new_transfer) {
   window_end_offset_ = 0;
   max_chunk_size_bytes_ = new_transfer.max_parameters->max_chunk_size_bytes();
 
+  window_phase_ = WindowPhase::kSlowStart;
+  window_size_chunks_ = kInitialWindowSizeChunks;
+  slow_start_threshold_chunks_ = std::numeric_limits<uint32_t>::max();
+  rtt_sample_start_ = kNoTimeout;
+  min_rtt_ = chrono::SystemClock::duration::zero();
+  received_ranges_count_ = 0;
+
   max_parameters_ = new_transfer.max_parameters;
   thread_ = new_transfer.transfer_thread;
 
@@ -325,6 +695,13 @@ void Context::Initialize(const NewTransferEvent& new_transfer) {
   next_timeout_ = kNoTimeout;
 
   transfer_rate_.Reset();
+
+#if PW_TRANSFER_ENABLE_METRICS
+  metrics_.Reset(session_id_, resource_id_);
+#endif  // PW_TRANSFER_ENABLE_METRICS
+#if PW_TRANSFER_ENABLE_TRACING
+  PW_TRACE_START("Transfer", "pw_transfer", session_id_);
+#endif  // PW_TRANSFER_ENABLE_TRACING
 }
 
 void Context::HandleChunkEvent(const ChunkEvent& event) {
@@ -561,6 +938,8 @@ void Context::HandleTransferParametersUpdate(const Chunk& chunk) {
   }
 
   window_end_offset_ = chunk.window_end_offset();
+  SetAcknowledgedRanges(chunk);
+  RecordWindow();
 
   if (chunk.max_chunk_size_bytes().has_value()) {
     max_chunk_size_bytes_ = std::min(chunk.max_chunk_size_bytes().value(),
@@ -586,6 +965,13 @@ void Context::HandleTransferParametersUpdate(const Chunk& chunk) {
 }
 
 void Context::TransmitNextChunk(bool retransmit_requested) {
+  if (SkipAcknowledgedData() && offset_ == window_end_offset_) {
+    // The receiver already has the rest of the window.
+    set_transfer_state(TransferState::kWaiting);
+    SetTimeout(chunk_timeout_);
+    return;
+  }
+
   Chunk chunk(configured_protocol_version_, Chunk::Type::kData);
   chunk.set_session_id(session_id_);
   chunk.set_offset(offset_);
@@ -604,17 +990,31 @@ void Context::TransmitNextChunk(bool retransmit_requested) {
   ByteSpan buffer = thread_->encode_buffer();
   Result<ByteSpan> data;
 
+  // If possible, encode the chunk into a MultiBuf which is passed to the RPC
+  // channel output as is, with room for pw_rpc to add its packet header.
+  std::optional<multibuf::MultiBuf> packet;
+  if (multibuf::MultiBufAllocator* allocator = thread_->multibuf_allocator();
+      allocator != nullptr) {
+    packet = allocator->AllocateContiguous(
+        buffer.size(), multibuf::Reservation{rpc::kMultiBufPacketHeadroom, 0});
+    if (packet.has_value()) {
+      multibuf::Chunk& packet_chunk = *packet->Chunks().begin();
+      buffer = ByteSpan(packet_chunk.data(), packet_chunk.size());
+    }
+  }
+
   if (offset_ < total_size) {
-    // Read the next chunk of data into the encode buffer.
-    ByteSpan data_buffer = buffer.subspan(reserved_size);
+    // Read the next chunk of data directly into its encoded position in the
+    // encode buffer so that encoding the chunk does not move it.
     size_t max_bytes_to_send =
-        std::min(window_end_offset_ - offset_, max_chunk_size_bytes_);
+        std::min<size_t>({window_end_offset_ - offset_,
+                          max_chunk_size_bytes_,
+                          buffer.size() - reserved_size});
 
-    if (max_bytes_to_send < data_buffer.size()) {
-      data_buffer = data_buffer.first(max_bytes_to_send);
-    }
+    ByteSpan data_buffer = buffer.subspan(
+        Chunk::PayloadOffset(max_bytes_to_send), max_bytes_to_send);
 
-    data = reader().Read(data_buffer);
+    data = ReadFromStream(data_buffer);
   } else {
     // The user-specified resource size has been reached: respect it.
     data = Status::OutOfRange();
@@ -673,7 +1073,15 @@ void Context::TransmitNextChunk(bool retransmit_requested) {
     return;
   }
 
-  if (const Status status = rpc_writer_->Write(*encoded_chunk); !status.ok()) {
+  Status status;
+  if (packet.has_value()) {
+    packet->Truncate(encoded_chunk->size());
+    status = rpc::WriteMultiBuf(*rpc_writer_, std::move(*packet));
+  } else {
+    status = rpc_writer_->Write(*encoded_chunk);
+  }
+
+  if (!status.ok()) {
     PW_LOG_ERROR("Transfer %u failed to send transmit chunk, status %u",
                  static_cast<unsigned>(session_id_),
                  status.code());
@@ -684,6 +1092,10 @@ void Context::TransmitNextChunk(bool retransmit_requested) {
   last_chunk_sent_ = chunk.type();
   flags_ |= kFlagsDataSent;
 
+#if PW_TRANSFER_ENABLE_METRICS
+  metrics_.RecordData(chunk.payload().size());
+#endif  // PW_TRANSFER_ENABLE_METRICS
+
   if (offset_ == window_end_offset_ || offset_ == total_size) {
     // Sent all requested data. Must now wait for next parameters from the
     // receiver.
@@ -733,6 +1145,12 @@ void Context::HandleReceiveChunk(const Chunk& chunk) {
 
     case TransferState::kRecovery:
       if (chunk.offset() != offset_) {
+        // Keep any data from the rest of the window which is still arriving.
+        StoreOutOfOrderData(chunk);
+        if (DataTransferComplete()) {
+          return;
+        }
+
         if (last_chunk_offset_ == chunk.offset()) {
           PW_LOG_DEBUG(
               "Transfer %u received repeated offset %u; retry detected, "
@@ -774,6 +1192,19 @@ void Context::HandleReceiveChunk(const Chunk& chunk) {
 
 void Context::HandleReceivedData(const Chunk& chunk) {
   if (chunk.offset() != offset_) {
+    if (max_parameters_->selective_ack() &&
+        chunk.offset() + chunk.payload().size() <= offset_ &&
+        !chunk.IsFinalTransmitChunk()) {
+      // This data was already received out of order and skipped over, but was
+      // resent before the transmitter learned of it. Drop it without resetting
+      // the timeout, so that a transmitter which never received the latest
+      // parameters is eventually recovered by a retry.
+      PW_LOG_DEBUG("Transfer %u ignoring already received data at offset %u",
+                   id_for_log(),
+                   static_cast<unsigned>(chunk.offset()));
+      return;
+    }
+
     // Bad offset; reset pending_bytes to send another parameters chunk.
     PW_LOG_DEBUG(
         "Transfer %u expected offset %u, received %u; entering recovery state",
@@ -781,13 +1212,24 @@ void Context::HandleReceivedData(const Chunk& chunk) {
         static_cast<unsigned>(offset_),
         static_cast<unsigned>(chunk.offset()));
 
+    StoreOutOfOrderData(chunk);
+    if (DataTransferComplete()) {
+      return;
+    }
+
     set_transfer_state(TransferState::kRecovery);
     SetTimeout(chunk_timeout_);
 
+    ShrinkWindowOnLoss();
     UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
     return;
   }
 
+  if (rtt_sample_start_ != kNoTimeout) {
+    HandleRttSample(chrono::SystemClock::now() - rtt_sample_start_);
+    rtt_sample_start_ = kNoTimeout;
+  }
+
   if (chunk.offset() + chunk.payload().size() > window_end_offset_) {
     // End the transfer, as this indicates a bug with the client implementation
     // where it doesn't respect pending_bytes. Trying to recover from here
@@ -807,7 +1249,7 @@ void Context::HandleReceivedData(const Chunk& chunk) {
 
   // Write staged data from the buffer to the stream.
   if (chunk.has_payload()) {
-    if (Status status = writer().Write(chunk.payload()); !status.ok()) {
+    if (Status status = WriteToStream(chunk.payload()); !status.ok()) {
       PW_LOG_ERROR(
           "Transfer %u write of %u B chunk failed with status %u; aborting "
           "with DATA_LOSS",
@@ -859,10 +1301,32 @@ void Context::HandleReceivedData(const Chunk& chunk) {
     window_end_offset_ = chunk.window_end_offset();
   }
 
+  const bool skipped_received_data = SkipReceivedData();
+  if (DataTransferComplete()) {
+    return;
+  }
+
+  if (offset_ >= ReceiveEndOffset()) {
+    // The entire requested range has been received, so the transfer ends
+    // without waiting for the transmitter to reach the end of the resource.
+    TerminateTransfer(OkStatus());
+    return;
+  }
+
   SetTimeout(chunk_timeout_);
 
-  if (offset_ == window_end_offset_) {
+  // Skipping over previously received data may move past the end of the
+  // window.
+  if (offset_ >= window_end_offset_) {
     // Received all pending data. Advance the transfer parameters.
+    GrowWindow();
+    UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
+    return;
+  }
+
+  if (skipped_received_data) {
+    // The transmitter may not know about all of the data that was skipped,
+    // so have it continue from the new offset.
     UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
     return;
   }
@@ -874,6 +1338,7 @@ void Context::HandleReceivedData(const Chunk& chunk) {
                        window_size_ / max_parameters_->extend_window_divisor();
 
   if (extend_window) {
+    GrowWindow();
     UpdateAndSendTransferParameters(TransmitAction::kExtend);
     return;
   }
@@ -971,6 +1436,10 @@ void Context::Finish(Status status) {
   status.Update(FinalCleanup(status));
   status_ = status;
 
+#if PW_TRANSFER_ENABLE_TRACING
+  PW_TRACE_END("Transfer", "pw_transfer", session_id_);
+#endif  // PW_TRANSFER_ENABLE_TRACING
+
   SetTimeout(kFinalChunkAckTimeout);
 }
 
@@ -1020,6 +1489,10 @@ void Context::HandleTimeout() {
 }
 
 void Context::Retry() {
+#if PW_TRANSFER_ENABLE_METRICS
+  metrics_.RecordTimeout();
+#endif  // PW_TRANSFER_ENABLE_METRICS
+
   if (retries_ == max_retries_ || lifetime_retries_ == max_lifetime_retries_) {
     PW_LOG_ERROR(
         "Transfer %u failed to receive a chunk after %u retries (lifetime %u).",
@@ -1054,12 +1527,30 @@ void Context::Retry() {
   }
 
   if (type() == TransferType::kReceive) {
+    if (max_parameters_->adaptive_windowing()) {
+      // The timeout likely indicates that the window overwhelmed the link.
+      // Restart it from a single chunk.
+      PW_LOG_DEBUG(
+          "Receive transfer %u timed out waiting for chunk; resending "
+          "reduced parameters",
+          static_cast<unsigned>(session_id_));
+
+      ShrinkWindowOnTimeout();
+      UpdateAndSendTransferParameters(TransmitAction::kRetransmit);
+      rtt_sample_start_ = kNoTimeout;
+      return;
+    }
+
     // Resend the most recent transfer parameters.
     PW_LOG_DEBUG(
         "Receive transfer %u timed out waiting for chunk; resending parameters",
         static_cast<unsigned>(session_id_));
 
     SendTransferParameters(TransmitAction::kRetransmit);
+
+    // Round trip times cannot be measured across a retransmission, as the
+    // response could belong to either copy of the parameters.
+    rtt_sample_start_ = kNoTimeout;
     return;
   }
 
@@ -1125,6 +1616,9 @@ void Context::RetryHandshake() {
   }
 
   EncodeAndSendChunk(retry_chunk);
+
+  // Round trip times cannot be measured across a retransmission.
+  rtt_sample_start_ = kNoTimeout;
 }
 
 uint32_t Context::MaxWriteChunkSize(uint32_t max_chunk_size_bytes,
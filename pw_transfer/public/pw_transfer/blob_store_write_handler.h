@@ -0,0 +1,117 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_blob_store/blob_store.h"
+#include "pw_bytes/span.h"
+#include "pw_checksum/crc32.h"
+#include "pw_status/status.h"
+#include "pw_stream/stream.h"
+#include "pw_transfer/handler.h"
+
+namespace pw::transfer {
+
+/// `BlobStoreWriteHandler` writes transfers into a `pw::blob_store::BlobStore`
+/// and lets an interrupted write transfer continue where it left off, even
+/// after a reboot or after the link was down for longer than the transfer
+/// timeout.
+///
+/// The data received so far persists in the blob store's flash. A client
+/// resumes a transfer by calling `Client::GetResourceStatus()`, which reports
+/// the offset at which the write can continue as `writeable_offset` and the
+/// CRC32 of the data before that offset as `write_checksum`. If its own data
+/// has the same CRC32, the client starts a write at that offset; otherwise it
+/// starts the write from the beginning. The offset is on a flash sector
+/// boundary, since `BlobWriter::Resume()` only keeps full sectors.
+///
+/// A write that fails is abandoned rather than discarded, so it can be
+/// resumed. The blob store must use `EraseMode::kFullPartition`.
+class BlobStoreWriteHandler : public WriteOnlyHandler {
+ public:
+  /// @param[in] resource_id An ID for the resource that's being transferred.
+  ///
+  /// @param[in] blob_writer The writer to use for the blob. It must not be
+  /// used by anything else while the handler is registered.
+  BlobStoreWriteHandler(uint32_t resource_id,
+                        blob_store::BlobStore::BlobWriter& blob_writer)
+      : WriteOnlyHandler(resource_id),
+        blob_writer_(blob_writer),
+        stream_(*this) {
+    set_writer(stream_);
+  }
+
+  BlobStoreWriteHandler(const BlobStoreWriteHandler&) = delete;
+  BlobStoreWriteHandler& operator=(const BlobStoreWriteHandler&) = delete;
+
+  /// Starts writing a new blob, discarding any interrupted write.
+  Status PrepareWrite() override;
+
+  /// Continues an interrupted write at `offset`, which must be the
+  /// `writeable_offset` reported by `GetStatus()`.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - The write continues at `offset`.
+  /// * @pw_status{FAILED_PRECONDITION} - The write can't continue at `offset`.
+  /// * Any error returned by `BlobWriter::Resume()`.
+  Status PrepareWrite(uint32_t offset) override;
+
+  /// Closes the blob if the transfer succeeded. Otherwise, abandons the write
+  /// so that it can be resumed.
+  Status FinalizeWrite(Status status) override;
+
+  /// Reports the offset at which an interrupted write can continue as
+  /// `writeable_offset`, and the CRC32 of the data before it as
+  /// `write_checksum`. Reads are not supported, so `readable_offset` and
+  /// `read_checksum` are 0.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - The status was reported.
+  /// * Any error returned by `BlobWriter::Resume()`, e.g.
+  ///   @pw_status{UNAVAILABLE} if the blob store holds a completed blob.
+  Status GetStatus(uint64_t& readable_offset,
+                   uint64_t& writeable_offset,
+                   uint64_t& read_checksum,
+                   uint64_t& write_checksum) override;
+
+ private:
+  // Writes to the blob and updates the running checksum.
+  class ChecksumWriter final : public stream::NonSeekableWriter {
+   public:
+    explicit ChecksumWriter(BlobStoreWriteHandler& handler)
+        : handler_(handler) {}
+
+   private:
+    Status DoWrite(ConstByteSpan data) override;
+
+    size_t ConservativeLimit(LimitType limit) const override {
+      return limit == LimitType::kWrite
+                 ? handler_.blob_writer_.ConservativeWriteLimit()
+                 : 0;
+    }
+
+    BlobStoreWriteHandler& handler_;
+  };
+
+  // Resumes the interrupted write, if any, and recalculates the checksum of
+  // the data that was kept.
+  Status Resume();
+
+  blob_store::BlobStore::BlobWriter& blob_writer_;
+  ChecksumWriter stream_;
+  checksum::Crc32 checksum_;
+};
+
+}  // namespace pw::transfer
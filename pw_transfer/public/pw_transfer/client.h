@@ -63,6 +63,9 @@ class Client {
 
   using CompletionFunc = Function<void(Status)>;
 
+  using ResourceStatus = internal::ResourceStatus;
+  using ResourceStatusFunc = Function<void(Status, const ResourceStatus&)>;
+
   // Initializes a transfer client on a specified RPC client and channel.
   // Transfers are processed on a work queue so as not to block any RPC threads.
   // The work queue does not have to be unique to the transfer client; it can be
@@ -167,6 +170,58 @@ class Client {
                  initial_offset);
   }
 
+  // Begins a read transfer of the size_bytes bytes of a resource starting at
+  // offset. The data is written to the provided writer as is, so the writer
+  // must already be positioned where the range belongs. The transfer completes
+  // with OK once the whole range is received, or once the end of the resource
+  // is reached if it is shorter.
+  //
+  // Several ranges of a resource can be read concurrently, over one or more
+  // clients or channels, to use more of the available bandwidth. Requires
+  // protocol version 2.
+  Result<Handle> ReadRange(
+      uint32_t resource_id,
+      uint32_t offset,
+      size_t size_bytes,
+      stream::Writer& output,
+      CompletionFunc&& on_completion,
+      chrono::SystemClock::duration timeout = cfg::kDefaultClientTimeout,
+      chrono::SystemClock::duration initial_chunk_timeout =
+          cfg::kDefaultInitialChunkTimeout);
+
+  // Begins a write transfer of the size_bytes bytes of a resource starting at
+  // offset. The data is read from the provided reader as is, so the reader
+  // must already be positioned at the start of the range. The server's handler
+  // must support writes starting at a nonzero offset.
+  //
+  // Several ranges of a resource can be written concurrently, over one or more
+  // clients or channels. Requires protocol version 2.
+  Result<Handle> WriteRange(
+      uint32_t resource_id,
+      uint32_t offset,
+      size_t size_bytes,
+      stream::Reader& input,
+      CompletionFunc&& on_completion,
+      chrono::SystemClock::duration timeout = cfg::kDefaultClientTimeout,
+      chrono::SystemClock::duration initial_chunk_timeout =
+          cfg::kDefaultInitialChunkTimeout);
+
+  // Requests the status of a resource from the server, e.g. to find where an
+  // interrupted write can be resumed. The callback is invoked with the status
+  // of the request and, if it is OK, the offsets and checksums reported by the
+  // resource's handler. Returns UNAVAILABLE if a status request is already in
+  // progress.
+  //
+  // To resume a write, compare the reported write_checksum against the
+  // checksum of the local data up to writeable_offset and, if they match,
+  // call Write() with writeable_offset as the initial_offset and the input
+  // positioned there. What checksum a resource reports is up to its handler.
+  //
+  // Unlike transfer completion callbacks, the callback runs on the thread that
+  // processes RPC packets, so it must not block.
+  Status GetResourceStatus(uint32_t resource_id,
+                           ResourceStatusFunc&& on_completion);
+
   Status set_extend_window_divisor(uint32_t extend_window_divisor) {
     if (extend_window_divisor <= 1) {
       return Status::InvalidArgument();
@@ -176,6 +231,19 @@ class Client {
     return OkStatus();
   }
 
+  // Enables or disables adaptive sizing of receive transfer windows. See the
+  // pw_transfer documentation for details.
+  void set_adaptive_windowing(bool adaptive_windowing) {
+    max_parameters_.set_adaptive_windowing(adaptive_windowing);
+  }
+
+  // Enables or disables keeping out-of-order data in receive transfers, so
+  // that the transmitter only resends what is missing. See the pw_transfer
+  // documentation for details.
+  void set_selective_ack(bool selective_ack) {
+    max_parameters_.set_selective_ack(selective_ack);
+  }
+
   constexpr Status set_max_retries(uint32_t max_retries) {
     if (max_retries < 1 || max_retries > max_lifetime_retries_) {
       return Status::InvalidArgument();
@@ -216,6 +284,31 @@ class Client {
 
   void OnRpcError(Status status, internal::TransferType type);
 
+  void OnResourceStatus(ConstByteSpan response, Status status);
+
+  // Starts a read or write transfer which ends at transfer_size_bytes, or at
+  // the end of the resource if that is SIZE_MAX.
+  Result<Handle> StartRead(uint32_t resource_id,
+                           stream::Writer& output,
+                           CompletionFunc&& on_completion,
+                           ProtocolVersion protocol_version,
+                           chrono::SystemClock::duration timeout,
+                           chrono::SystemClock::duration initial_chunk_timeout,
+                           uint32_t initial_offset,
+                           size_t transfer_size_bytes);
+
+  Result<Handle> StartWrite(uint32_t resource_id,
+                            stream::Reader& input,
+                            CompletionFunc&& on_completion,
+                            ProtocolVersion protocol_version,
+                            chrono::SystemClock::duration timeout,
+                            chrono::SystemClock::duration initial_chunk_timeout,
+                            uint32_t initial_offset,
+                            size_t transfer_size_bytes);
+
+  // Checks the arguments of a ReadRange or WriteRange call.
+  bool IsValidRange(uint32_t offset, size_t size_bytes) const;
+
   Handle AssignHandle();
 
   Transfer::Client client_;
@@ -229,6 +322,9 @@ class Client {
 
   bool has_read_stream_;
   bool has_write_stream_;
+
+  rpc::RawUnaryReceiver resource_status_call_;
+  ResourceStatusFunc on_resource_status_;
 };
 
 }  // namespace pw::transfer
@@ -25,6 +25,7 @@ namespace pw::transfer {
 namespace internal {
 
 class Context;
+class ServerContext;
 
 }  // namespace internal
 
@@ -122,6 +123,7 @@ class Handler : public IntrusiveList<Handler>::Item {
 
  private:
   friend class internal::Context;
+  friend class internal::ServerContext;
 
   // Prepares for either a read or write transfer.
   Status Prepare(internal::TransferType type, uint32_t offset = 0) {
@@ -142,6 +144,10 @@ class Handler : public IntrusiveList<Handler>::Item {
 
   uint32_t resource_id_;
 
+  // Number of transfers currently using this handler. When several ranges of
+  // the resource are transferred at once, they share the handler's stream.
+  uint16_t active_transfers_ = 0;
+
   // Use a union to support constexpr construction.
   union {
     stream::Reader* reader_;
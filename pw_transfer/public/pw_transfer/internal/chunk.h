@@ -13,10 +13,14 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <optional>
 
 #include "pw_bytes/span.h"
 #include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_transfer/internal/config.h"
 #include "pw_transfer/internal/protocol.h"
 #include "pw_transfer/transfer.pwpb.h"
 
@@ -26,6 +30,15 @@ class Chunk {
  public:
   using Type = transfer::pwpb::Chunk::Type;
 
+  // A range of data, [start_offset, end_offset), which a receiver has already
+  // received beyond its current offset.
+  struct ReceivedRange {
+    uint32_t start_offset;
+    uint32_t end_offset;
+  };
+
+  static constexpr size_t kMaxReceivedRanges = cfg::kMaxReceivedRanges;
+
   class Identifier {
    public:
     constexpr bool is_session() const { return type_ == kSession; }
@@ -84,8 +97,15 @@ class Chunk {
 
   // Encodes the chunk to the specified buffer, returning a span of the
   // serialized data on success.
+  //
+  // If the chunk's payload is located within the buffer at PayloadOffset(),
+  // it is encoded in place without being copied.
   Result<ConstByteSpan> Encode(ByteSpan buffer) const;
 
+  // Returns the offset from the start of an encode buffer at which a payload
+  // of the specified size must be located for Encode() to leave it in place.
+  static size_t PayloadOffset(size_t payload_size);
+
   // Returns the size of the serialized chunk based on the fields currently set
   // within the chunk object.
   size_t EncodedSize() const;
@@ -145,6 +165,19 @@ class Chunk {
     return *this;
   }
 
+  // Sets the received ranges reported by a parameters chunk. Ranges beyond
+  // kMaxReceivedRanges are dropped.
+  constexpr Chunk& set_received_ranges(span<const ReceivedRange> ranges) {
+    received_ranges_count_ = 0;
+    for (const ReceivedRange& range : ranges) {
+      if (received_ranges_count_ == kMaxReceivedRanges) {
+        break;
+      }
+      received_ranges_[received_ranges_count_++] = range;
+    }
+    return *this;
+  }
+
   // TODO(frolv): For some reason, the compiler complains if this setter is
   // marked constexpr. Leaving it off for now, but this should be investigated
   // and fixed.
@@ -191,6 +224,10 @@ class Chunk {
     return remaining_bytes_;
   }
 
+  constexpr span<const ReceivedRange> received_ranges() const {
+    return span(received_ranges_.data(), received_ranges_count_);
+  }
+
   constexpr ProtocolVersion protocol_version() const {
     return protocol_version_;
   }
@@ -274,7 +311,9 @@ class Chunk {
         remaining_bytes_(std::nullopt),
         status_(std::nullopt),
         type_(type),
-        protocol_version_(version) {}
+        protocol_version_(version),
+        received_ranges_{},
+        received_ranges_count_(0) {}
 
   constexpr Chunk() : Chunk(ProtocolVersion::kUnknown, std::nullopt) {}
 
@@ -303,6 +342,8 @@ class Chunk {
   std::optional<Status> status_;
   std::optional<Type> type_;
   ProtocolVersion protocol_version_;
+  std::array<ReceivedRange, kMaxReceivedRanges> received_ranges_;
+  size_t received_ranges_count_;
 };
 
 }  // namespace pw::transfer::internal
@@ -43,6 +43,9 @@ class ClientContext final : public Context {
 
   size_t TransferSizeBytes() const override { return transfer_size_bytes_; }
 
+  // Receive transfers of a range of a resource end at the transfer size.
+  size_t ReceiveEndOffset() const override { return transfer_size_bytes_; }
+
   // Seeks the reader to the offset, taking into account the client side reader
   // needs to be shifted back for the initial offset.
   Status SeekReader(uint32_t offset) override;
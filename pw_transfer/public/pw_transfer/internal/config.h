@@ -17,6 +17,7 @@
 
 #include <chrono>
 #include <cinttypes>
+#include <cstddef>
 #include <limits>
 
 #include "pw_chrono/system_clock.h"
@@ -151,6 +152,67 @@ static_assert(PW_TRANSFER_DEFAULT_INITIAL_TIMEOUT_MS > 0);
 
 static_assert(PW_TRANSFER_DEFAULT_EXTEND_WINDOW_DIVISOR > 1);
 
+// Whether receive transfers size their windows adaptively by default.
+//
+// When enabled, a receiver starts with a window of a single chunk and grows it
+// exponentially (slow start) and then linearly (congestion avoidance) as data
+// arrives in order, backing off when chunks are lost or the transfer times
+// out. The window never exceeds the configured pending bytes. When disabled,
+// the window is always as large as the pending bytes allow.
+#ifndef PW_TRANSFER_DEFAULT_ADAPTIVE_WINDOWING
+#define PW_TRANSFER_DEFAULT_ADAPTIVE_WINDOWING 0
+#endif  // PW_TRANSFER_DEFAULT_ADAPTIVE_WINDOWING
+
+// Whether receive transfers keep data which arrives out of order by default,
+// reporting it to the transmitter so that only missing data is resent.
+//
+// Out-of-order data is only kept when the transfer's writer supports seeking
+// from its current position. Transmitters always honor received ranges from
+// the receiver if their reader supports seeking.
+#ifndef PW_TRANSFER_DEFAULT_SELECTIVE_ACK
+#define PW_TRANSFER_DEFAULT_SELECTIVE_ACK 0
+#endif  // PW_TRANSFER_DEFAULT_SELECTIVE_ACK
+
+// The maximum number of out-of-order data ranges that a transfer tracks, and
+// that a single transfer chunk can carry. Each range occupies 8 bytes in every
+// transfer context and chunk.
+#ifndef PW_TRANSFER_MAX_RECEIVED_RANGES
+#define PW_TRANSFER_MAX_RECEIVED_RANGES 4
+#endif  // PW_TRANSFER_MAX_RECEIVED_RANGES
+
+static_assert(PW_TRANSFER_MAX_RECEIVED_RANGES > 0 &&
+              PW_TRANSFER_MAX_RECEIVED_RANGES <= 255);
+
+// The maximum amount of time, in milliseconds, that a transfer thread which
+// shards server transfers across worker threads waits for a busy worker to
+// accept a chunk before dropping it.
+//
+// Dropped chunks are recovered through the transfer protocol's regular retry
+// mechanism, so a worker blocked on slow handler I/O only slows down its own
+// transfers instead of stalling every other worker.
+#ifndef PW_TRANSFER_SERVER_WORKER_DISPATCH_TIMEOUT_MS
+#define PW_TRANSFER_SERVER_WORKER_DISPATCH_TIMEOUT_MS 10
+#endif  // PW_TRANSFER_SERVER_WORKER_DISPATCH_TIMEOUT_MS
+
+static_assert(PW_TRANSFER_SERVER_WORKER_DISPATCH_TIMEOUT_MS >= 0);
+
+// Whether transfer contexts record pw_metric statistics about their sessions,
+// such as bytes, chunks, retransmits, window sizes, stream access time, and
+// round trip times.
+//
+// This adds a TransferMetrics to every transfer context and reads the system
+// clock around every stream Read() and Write().
+#ifndef PW_TRANSFER_ENABLE_METRICS
+#define PW_TRANSFER_ENABLE_METRICS 0
+#endif  // PW_TRANSFER_ENABLE_METRICS
+
+// Whether transfers emit pw_trace events at the start and end of each session,
+// at every window boundary, and around each event the transfer thread handles.
+// Events are grouped by session ID.
+#ifndef PW_TRANSFER_ENABLE_TRACING
+#define PW_TRANSFER_ENABLE_TRACING 0
+#endif  // PW_TRANSFER_ENABLE_TRACING
+
 namespace pw::transfer::cfg {
 
 inline constexpr uint8_t kDefaultMaxClientRetries =
@@ -174,4 +236,18 @@ inline constexpr chrono::SystemClock::duration kDefaultInitialChunkTimeout =
 inline constexpr uint32_t kDefaultExtendWindowDivisor =
     PW_TRANSFER_DEFAULT_EXTEND_WINDOW_DIVISOR;
 
+inline constexpr bool kDefaultAdaptiveWindowing =
+    PW_TRANSFER_DEFAULT_ADAPTIVE_WINDOWING;
+
+inline constexpr bool kDefaultSelectiveAck = PW_TRANSFER_DEFAULT_SELECTIVE_ACK;
+
+inline constexpr size_t kMaxReceivedRanges = PW_TRANSFER_MAX_RECEIVED_RANGES;
+
+inline constexpr chrono::SystemClock::duration kServerWorkerDispatchTimeout =
+    chrono::SystemClock::for_at_least(std::chrono::milliseconds(
+        PW_TRANSFER_SERVER_WORKER_DISPATCH_TIMEOUT_MS));
+
+inline constexpr bool kEnableMetrics = PW_TRANSFER_ENABLE_METRICS;
+inline constexpr bool kEnableTracing = PW_TRANSFER_ENABLE_TRACING;
+
 }  // namespace pw::transfer::cfg
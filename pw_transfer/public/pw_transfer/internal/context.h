@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cinttypes>
 #include <cstddef>
 #include <limits>
@@ -20,13 +21,17 @@
 
 #include "pw_assert/assert.h"
 #include "pw_chrono/system_clock.h"
+#include "pw_result/result.h"
 #include "pw_rpc/writer.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_stream/stream.h"
 #include "pw_transfer/internal/chunk.h"
+#include "pw_transfer/internal/config.h"
 #include "pw_transfer/internal/event.h"
 #include "pw_transfer/internal/protocol.h"
 #include "pw_transfer/rate_estimate.h"
+#include "pw_transfer/transfer_metrics.h"
 
 namespace pw::transfer::internal {
 
@@ -39,7 +44,9 @@ class TransferParameters {
                                uint32_t extend_window_divisor)
       : pending_bytes_(pending_bytes),
         max_chunk_size_bytes_(max_chunk_size_bytes),
-        extend_window_divisor_(extend_window_divisor) {
+        extend_window_divisor_(extend_window_divisor),
+        adaptive_windowing_(cfg::kDefaultAdaptiveWindowing),
+        selective_ack_(cfg::kDefaultSelectiveAck) {
     PW_ASSERT(pending_bytes > 0);
     PW_ASSERT(max_chunk_size_bytes > 0);
     PW_ASSERT(extend_window_divisor > 1);
@@ -61,10 +68,24 @@ class TransferParameters {
     extend_window_divisor_ = extend_window_divisor;
   }
 
+  // Whether receive transfers grow and shrink their window in response to
+  // observed loss and latency, rather than always requesting pending_bytes.
+  bool adaptive_windowing() const { return adaptive_windowing_; }
+  void set_adaptive_windowing(bool adaptive_windowing) {
+    adaptive_windowing_ = adaptive_windowing;
+  }
+
+  // Whether receive transfers keep data that arrives out of order and report
+  // it to the transmitter, rather than discarding it.
+  bool selective_ack() const { return selective_ack_; }
+  void set_selective_ack(bool selective_ack) { selective_ack_ = selective_ack; }
+
  private:
   uint32_t pending_bytes_;
   uint32_t max_chunk_size_bytes_;
   uint32_t extend_window_divisor_;
+  bool adaptive_windowing_;
+  bool selective_ack_;
 };
 
 // Information about a single transfer.
@@ -104,6 +125,11 @@ class Context {
   // Processes an event for this transfer.
   void HandleEvent(const Event& event);
 
+#if PW_TRANSFER_ENABLE_METRICS
+  const TransferMetrics& metrics() const { return metrics_; }
+  TransferMetrics& metrics() { return metrics_; }
+#endif  // PW_TRANSFER_ENABLE_METRICS
+
  protected:
   ~Context() = default;
 
@@ -125,6 +151,13 @@ class Context {
         window_size_(0),
         window_end_offset_(0),
         max_chunk_size_bytes_(std::numeric_limits<uint32_t>::max()),
+        window_phase_(WindowPhase::kSlowStart),
+        window_size_chunks_(kInitialWindowSizeChunks),
+        slow_start_threshold_chunks_(std::numeric_limits<uint32_t>::max()),
+        rtt_sample_start_(kNoTimeout),
+        min_rtt_(chrono::SystemClock::duration::zero()),
+        received_ranges_{},
+        received_ranges_count_(0),
         max_parameters_(nullptr),
         thread_(nullptr),
         last_chunk_sent_(Chunk::Type::kData),
@@ -185,6 +218,15 @@ class Context {
     kTerminating,
   };
 
+  // Phase of an adaptively sized receive window.
+  enum class WindowPhase : uint8_t {
+    // The window doubles each time it is extended or completed.
+    kSlowStart,
+    // The window grows by a single chunk each time it is extended or
+    // completed.
+    kCongestionAvoidance,
+  };
+
   enum class TransmitAction {
     // Start of a new transfer.
     kBegin,
@@ -266,6 +308,21 @@ class Context {
   // seek method.
   virtual Status SeekReader(uint32_t offset) = 0;
 
+  // Returns the offset at which a receive transfer has received all of the
+  // data it requested, or `std::numeric_limits<size_t>::max()` if it runs
+  // until the transmitter finishes.
+  virtual size_t ReceiveEndOffset() const {
+    return std::numeric_limits<size_t>::max();
+  }
+
+  // Returns whether the transfer's stream is used by other active transfers,
+  // which may move its position between this transfer's events.
+  virtual bool stream_shared() const { return false; }
+
+  // If the stream is shared, seeks it back to the transfer's offset. Returns
+  // false if the seek failed, in which case the transfer is terminated.
+  bool RestoreSharedStreamPosition();
+
   // Processes a chunk in either a transfer or receive transfer.
   void HandleChunkEvent(const ChunkEvent& event);
 
@@ -292,6 +349,14 @@ class Context {
   // Sends the first chunk in a legacy transmit transfer.
   void SendInitialLegacyTransmitChunk();
 
+  // Reads from or writes to the transfer's stream, recording the time spent in
+  // the stream if metrics are enabled.
+  Result<ByteSpan> ReadFromStream(ByteSpan buffer);
+  Status WriteToStream(ConstByteSpan data);
+
+  // Records the start of a new transfer window in the metrics and trace.
+  void RecordWindow();
+
   // Updates the current receive transfer parameters based on the context's
   // configuration.
   void UpdateTransferParameters();
@@ -306,6 +371,51 @@ class Context {
   // Updates the current receive transfer parameters, then sends them.
   void UpdateAndSendTransferParameters(TransmitAction action);
 
+  // Adjusts an adaptive receive window following in-order receipt of data, a
+  // detected chunk loss, or a receive timeout, respectively. The new window
+  // takes effect on the next UpdateTransferParameters() call. No-ops if
+  // adaptive windowing is disabled.
+  void GrowWindow();
+  void ShrinkWindowOnLoss();
+  void ShrinkWindowOnTimeout();
+
+  // Records a round trip time sample for an adaptive receive window, ending
+  // slow start if the sample indicates that the link is saturated.
+  void HandleRttSample(chrono::SystemClock::duration rtt);
+
+  span<const Chunk::ReceivedRange> received_ranges() const {
+    return span(received_ranges_.data(), received_ranges_count_);
+  }
+
+  // Adds a range to the sorted set of received ranges, merging it with any
+  // ranges it overlaps or touches. Returns false if there is no space for it.
+  bool AddReceivedRange(uint32_t start_offset, uint32_t end_offset);
+
+  // Removes the first of the received ranges.
+  void PopReceivedRange();
+
+  // In a receive transfer, writes a data chunk which is ahead of offset_ to
+  // its position in the writer and records it as received, if selective
+  // acknowledgement is enabled and the writer can seek. Returns true if the
+  // chunk was stored. Terminates the transfer if the writer cannot be
+  // restored to offset_.
+  bool StoreOutOfOrderData(const Chunk& chunk);
+
+  // In a receive transfer, advances offset_ and the writer past any received
+  // ranges that it has reached. Returns true if offset_ moved. Terminates the
+  // transfer if the writer fails to seek.
+  bool SkipReceivedData();
+
+  // In a transmit transfer, replaces the received ranges with those reported
+  // by a parameters chunk, discarding them all if they are not sorted and
+  // disjoint.
+  void SetAcknowledgedRanges(const Chunk& parameters);
+
+  // In a transmit transfer, advances offset_ and the reader past any ranges
+  // the receiver reported as received that are within the window. Returns
+  // true if offset_ moved.
+  bool SkipAcknowledgedData();
+
   // Processes a chunk in a terminating state.
   void HandleTerminatingChunk(const Chunk& chunk);
 
@@ -355,6 +465,17 @@ class Context {
 
   static constexpr uint32_t kDefaultChunkDelayMicroseconds = 2000;
 
+  // Initial size of an adaptive receive window, in chunks.
+  static constexpr uint32_t kInitialWindowSizeChunks = 1;
+
+  // Factor by which a round trip time sample must exceed the minimum observed
+  // round trip time for an adaptive window to exit slow start.
+  static constexpr int kRttSaturationFactor = 2;
+
+  // The round trip time must also exceed this fraction of the chunk timeout
+  // for an adaptive window to exit slow start, ignoring jitter on fast links.
+  static constexpr int kRttSaturationTimeoutDivisor = 4;
+
   // How long to wait for the other side to ACK a final transfer chunk before
   // resetting the context so that it can be reused. During this time, the
   // status chunk will be re-sent for every non-ACK chunk received,
@@ -391,6 +512,24 @@ class Context {
   uint32_t window_end_offset_;
   uint32_t max_chunk_size_bytes_;
 
+  // Adaptive windowing state for receive transfers. Window sizes are measured
+  // in chunks of max_chunk_size_bytes_.
+  WindowPhase window_phase_;
+  uint32_t window_size_chunks_;
+  uint32_t slow_start_threshold_chunks_;
+
+  // When the transfer parameters for a pending round trip time sample were
+  // sent, or kNoTimeout if there is no sample in progress.
+  chrono::SystemClock::time_point rtt_sample_start_;
+  chrono::SystemClock::duration min_rtt_;
+
+  // Sorted, disjoint ranges of data beyond offset_ which have already been
+  // received. In a receive transfer, these are tracked locally and reported to
+  // the transmitter; in a transmit transfer, they are the ranges the receiver
+  // last reported.
+  std::array<Chunk::ReceivedRange, Chunk::kMaxReceivedRanges> received_ranges_;
+  uint8_t received_ranges_count_;
+
   const TransferParameters* max_parameters_;
   TransferThread* thread_;
 
@@ -415,6 +554,10 @@ class Context {
   chrono::SystemClock::time_point next_timeout_;
 
   RateEstimate transfer_rate_;
+
+#if PW_TRANSFER_ENABLE_METRICS
+  TransferMetrics metrics_;
+#endif  // PW_TRANSFER_ENABLE_METRICS
 };
 
 }  // namespace pw::transfer::internal
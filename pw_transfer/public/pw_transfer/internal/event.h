@@ -104,6 +104,9 @@ struct NewTransferEvent {
   size_t raw_chunk_size;
 
   uint64_t initial_offset;
+
+  // In client transfers, the offset at which the transferred range ends.
+  size_t transfer_size_bytes;
 };
 
 // A chunk received by a transfer client / server.
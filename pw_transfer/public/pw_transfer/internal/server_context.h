@@ -30,7 +30,10 @@ class ServerContext final : public Context {
 
   // Sets the handler. The handler isn't set by Context::Initialize() since
   // ClientContexts don't track it.
-  void set_handler(Handler& handler) { handler_ = &handler; }
+  void set_handler(Handler& handler) {
+    handler_ = &handler;
+    handler_->active_transfers_ += 1;
+  }
 
   // Returns the pointer to the current handler.
   const Handler* handler() { return handler_; }
@@ -50,6 +53,10 @@ class ServerContext final : public Context {
   // offset
   Status SeekReader(uint32_t offset) override;
 
+  bool stream_shared() const override {
+    return handler_ != nullptr && handler_->active_transfers_ > 1;
+  }
+
   Handler* handler_;
 };
 
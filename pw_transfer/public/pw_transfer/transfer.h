@@ -123,6 +123,19 @@ class TransferService : public pw_rpc::raw::Transfer::Service<TransferService> {
     return OkStatus();
   }
 
+  // Enables or disables adaptive sizing of receive transfer windows. See the
+  // pw_transfer documentation for details.
+  void set_adaptive_windowing(bool adaptive_windowing) {
+    max_parameters_.set_adaptive_windowing(adaptive_windowing);
+  }
+
+  // Enables or disables keeping out-of-order data in receive transfers, so
+  // that the transmitter only resends what is missing. See the pw_transfer
+  // documentation for details.
+  void set_selective_ack(bool selective_ack) {
+    max_parameters_.set_selective_ack(selective_ack);
+  }
+
   rpc::RawUnaryResponder resource_responder_;
 
  private:
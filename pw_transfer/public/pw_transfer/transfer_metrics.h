@@ -0,0 +1,110 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_metric/metric.h"
+
+namespace pw::transfer {
+namespace internal {
+
+class Context;
+class TransferThread;
+
+}  // namespace internal
+
+// Performance statistics for the most recent transfer session run by a single
+// transfer context. They are reset whenever the context starts a new session.
+//
+// These are only recorded if PW_TRANSFER_ENABLE_METRICS is set. A transfer
+// thread groups the metrics of all of its contexts; see
+// TransferThread::metrics().
+class TransferMetrics {
+ public:
+  constexpr TransferMetrics() = default;
+
+  TransferMetrics(const TransferMetrics&) = delete;
+  TransferMetrics& operator=(const TransferMetrics&) = delete;
+
+  const metric::Group& group() const { return group_; }
+  metric::Group& group() { return group_; }
+
+  // The session and resource of the transfer.
+  uint32_t session_id() const { return session_id_.value(); }
+  uint32_t resource_id() const { return resource_id_.value(); }
+
+  // Payload bytes and data chunks sent or received, including retransmissions.
+  uint32_t bytes() const { return bytes_.value(); }
+  uint32_t chunks() const { return chunks_.value(); }
+
+  // The number of times the receiver requested that data be retransmitted.
+  uint32_t retransmits() const { return retransmits_.value(); }
+
+  // The number of times the transfer timed out waiting for its peer.
+  uint32_t timeouts() const { return timeouts_.value(); }
+
+  // The size of the current and the largest transfer window, in bytes.
+  uint32_t window_size_bytes() const { return window_size_bytes_.value(); }
+  uint32_t max_window_size_bytes() const {
+    return max_window_size_bytes_.value();
+  }
+
+  // Total time spent in the stream's Read() or Write(), in microseconds.
+  uint32_t stream_time_us() const { return stream_time_us_.value(); }
+
+  // The last and the smallest measured round trip time between sending
+  // transfer parameters and receiving the data they requested, in
+  // microseconds. Round trip times are only measured by receivers using
+  // adaptive windowing.
+  uint32_t rtt_us() const { return rtt_us_.value(); }
+  uint32_t min_rtt_us() const { return min_rtt_us_.value(); }
+
+ private:
+  friend class internal::Context;
+  friend class internal::TransferThread;
+
+  // Adds the metrics to their group, and the group to the parent.
+  void Register(metric::Group& parent);
+
+  void Reset(uint32_t session_id, uint32_t resource_id);
+
+  void RecordData(size_t bytes) {
+    bytes_.Increment(static_cast<uint32_t>(bytes));
+    chunks_.Increment();
+  }
+
+  void RecordRetransmit() { retransmits_.Increment(); }
+  void RecordTimeout() { timeouts_.Increment(); }
+  void RecordWindow(uint32_t window_size_bytes);
+  void RecordStreamTime(chrono::SystemClock::duration duration);
+  void RecordRtt(chrono::SystemClock::duration rtt);
+
+  PW_METRIC_GROUP(group_, "session");
+  PW_METRIC(session_id_, "session_id", 0u);
+  PW_METRIC(resource_id_, "resource_id", 0u);
+  PW_METRIC(bytes_, "bytes", 0u);
+  PW_METRIC(chunks_, "chunks", 0u);
+  PW_METRIC(retransmits_, "retransmits", 0u);
+  PW_METRIC(timeouts_, "timeouts", 0u);
+  PW_METRIC(window_size_bytes_, "window_size_bytes", 0u);
+  PW_METRIC(max_window_size_bytes_, "max_window_size_bytes", 0u);
+  PW_METRIC(stream_time_us_, "stream_time_us", 0u);
+  PW_METRIC(rtt_us_, "rtt_us", 0u);
+  PW_METRIC(min_rtt_us_, "min_rtt_us", 0u);
+};
+
+}  // namespace pw::transfer
@@ -14,10 +14,13 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 
 #include "pw_assert/assert.h"
 #include "pw_chrono/system_clock.h"
 #include "pw_function/function.h"
+#include "pw_metric/metric.h"
+#include "pw_multibuf/allocator.h"
 #include "pw_rpc/raw/client_reader_writer.h"
 #include "pw_rpc/raw/server_reader_writer.h"
 #include "pw_span/span.h"
@@ -48,6 +51,35 @@ class TransferThread : public thread::ThreadCore {
         chunk_buffer_(chunk_buffer),
         encode_buffer_(encode_buffer) {}
 
+  // Shards this thread's server transfers across the provided worker threads,
+  // each of which runs handler I/O for its transfers independently of the
+  // others. Server transfers are assigned to a worker by their session ID, so
+  // the number of concurrent server transfers is bounded by each worker's own
+  // contexts. Client transfers, handler registration, and the RPC streams
+  // remain on this thread.
+  //
+  // Must be called before this thread or any of the workers start running.
+  // Each worker's chunk buffer must be at least as large as this thread's.
+  void SetServerWorkers(span<TransferThread* const> workers);
+
+  // Reads data chunks sent by this thread's transfers directly into MultiBufs
+  // allocated from `allocator` and writes them to the RPC stream as MultiBufs.
+  // If the stream's channel uses a pw::rpc::MultiBufChannelOutput, chunk data
+  // then reaches the channel output without being copied. If an allocation
+  // fails, the chunk is sent from the encode buffer instead.
+  //
+  // Must be called before this thread starts running. Server workers each use
+  // their own allocator, if any.
+  void set_multibuf_allocator(multibuf::MultiBufAllocator& allocator) {
+    multibuf_allocator_ = &allocator;
+  }
+
+  // Returns a group containing the TransferMetrics of each of this thread's
+  // transfer contexts. The group is empty unless PW_TRANSFER_ENABLE_METRICS is
+  // set. Add it to the groups served by a pw::metric::MetricService to
+  // retrieve the metrics over RPC.
+  metric::Group& metrics() { return metrics_; }
+
   void StartClientTransfer(TransferType type,
                            ProtocolVersion version,
                            uint32_t resource_id,
@@ -59,7 +91,9 @@ class TransferThread : public thread::ThreadCore {
                            chrono::SystemClock::duration initial_timeout,
                            uint8_t max_retries,
                            uint32_t max_lifetime_retries,
-                           uint32_t initial_offset = 0) {
+                           uint32_t initial_offset = 0,
+                           size_t transfer_size_bytes =
+                               std::numeric_limits<size_t>::max()) {
     StartTransfer(type,
                   version,
                   Context::kUnassignedSessionId,  // Assigned later.
@@ -73,7 +107,8 @@ class TransferThread : public thread::ThreadCore {
                   initial_timeout,
                   max_retries,
                   max_lifetime_retries,
-                  initial_offset);
+                  initial_offset,
+                  transfer_size_bytes);
   }
 
   void StartServerTransfer(TransferType type,
@@ -99,7 +134,8 @@ class TransferThread : public thread::ThreadCore {
                   timeout,
                   max_retries,
                   max_lifetime_retries,
-                  initial_offset);
+                  initial_offset,
+                  /*transfer_size_bytes=*/std::numeric_limits<size_t>::max());
   }
 
   void ProcessClientChunk(ConstByteSpan chunk) {
@@ -204,6 +240,11 @@ class TransferThread : public thread::ThreadCore {
   void EnqueueResourceEvent(uint32_t resource_id,
                             ResourceStatusCallback&& callback);
 
+ protected:
+  // Adds the metrics of each transfer context to metrics(). The contexts are
+  // owned by the derived class, so it calls this once they are constructed.
+  void RegisterContextMetrics();
+
  private:
   friend class transfer::Client;
   friend class Context;
@@ -272,11 +313,21 @@ class TransferThread : public thread::ThreadCore {
 
   const ByteSpan& encode_buffer() const { return encode_buffer_; }
 
+  multibuf::MultiBufAllocator* multibuf_allocator() const {
+    return multibuf_allocator_;
+  }
+
   void Run() final;
 
   void HandleTimeouts();
 
   rpc::Writer& stream_for(TransferStream stream) {
+    // Server workers send through the streams of the thread that dispatches
+    // to them.
+    if (dispatcher_ != nullptr) {
+      return dispatcher_->stream_for(stream);
+    }
+
     switch (stream) {
       case TransferStream::kClientRead:
         return client_read_stream_.as_writer();
@@ -310,7 +361,8 @@ class TransferThread : public thread::ThreadCore {
                      chrono::SystemClock::duration initial_timeout,
                      uint8_t max_retries,
                      uint32_t max_lifetime_retries,
-                     uint32_t initial_offset);
+                     uint32_t initial_offset,
+                     size_t transfer_size_bytes);
 
   void ProcessChunk(EventType type, ConstByteSpan chunk);
 
@@ -330,6 +382,14 @@ class TransferThread : public thread::ThreadCore {
   void HandleEvent(const Event& event);
   Context* FindContextForEvent(const Event& event) const;
 
+  // Forwards a server transfer event to the worker which owns its session.
+  void DispatchToServerWorker(const Event& event);
+
+  // Copies an event into this worker's event slot. If may_drop is true and the
+  // worker does not free its slot within the dispatch timeout, the event is
+  // not posted and false is returned.
+  bool PostWorkerEvent(const Event& event, bool may_drop);
+
   void SendStatusChunk(const SendStatusChunkEvent& event);
 
   void GetResourceState(uint32_t resource_id);
@@ -366,6 +426,17 @@ class TransferThread : public thread::ThreadCore {
   ByteSpan encode_buffer_;
 
   ResourceStatusCallback resource_status_callback_ = nullptr;
+
+  PW_METRIC_GROUP(metrics_, "transfer_thread");
+
+  // Threads to which server transfers are dispatched, if any.
+  span<TransferThread* const> server_workers_;
+
+  // If this thread is a server worker, the thread which dispatches to it.
+  TransferThread* dispatcher_ = nullptr;
+
+  // Allocator for outgoing data chunks, if they are sent as MultiBufs.
+  multibuf::MultiBufAllocator* multibuf_allocator_ = nullptr;
 };
 
 }  // namespace internal
@@ -378,7 +449,9 @@ class Thread final : public internal::TransferThread {
  public:
   Thread(ByteSpan chunk_buffer, ByteSpan encode_buffer)
       : internal::TransferThread(
-            client_contexts_, server_contexts_, chunk_buffer, encode_buffer) {}
+            client_contexts_, server_contexts_, chunk_buffer, encode_buffer) {
+    RegisterContextMetrics();
+  }
 
  private:
   std::array<internal::ClientContext, kMaxConcurrentClientTransfers>
@@ -387,4 +460,24 @@ class Thread final : public internal::TransferThread {
       server_contexts_;
 };
 
+// A thread which runs server transfers on behalf of a transfer::Thread, set up
+// through TransferThread::SetServerWorkers. Each worker must be run on its own
+// thread.
+template <size_t kMaxConcurrentServerTransfers>
+class ServerWorker final : public internal::TransferThread {
+ public:
+  ServerWorker(ByteSpan chunk_buffer, ByteSpan encode_buffer)
+      : internal::TransferThread(
+            /*client_transfers=*/{},
+            server_contexts_,
+            chunk_buffer,
+            encode_buffer) {
+    RegisterContextMetrics();
+  }
+
+ private:
+  std::array<internal::ServerContext, kMaxConcurrentServerTransfers>
+      server_contexts_;
+};
+
 }  // namespace pw::transfer
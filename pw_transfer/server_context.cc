@@ -35,6 +35,7 @@ Status ServerContext::FinalCleanup(const Status status) {
 
   Handler& handler = *handler_;
   handler_ = nullptr;
+  handler.active_transfers_ -= 1;
 
   if (type() == TransferType::kTransmit) {
     handler.FinalizeRead(status);
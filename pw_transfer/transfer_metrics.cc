@@ -0,0 +1,81 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_transfer/transfer_metrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace pw::transfer {
+namespace {
+
+uint32_t ToMicroseconds(chrono::SystemClock::duration duration) {
+  int64_t us =
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  return static_cast<uint32_t>(
+      std::clamp<int64_t>(us, 0, std::numeric_limits<uint32_t>::max()));
+}
+
+}  // namespace
+
+void TransferMetrics::Register(metric::Group& parent) {
+  group_.Add(session_id_);
+  group_.Add(resource_id_);
+  group_.Add(bytes_);
+  group_.Add(chunks_);
+  group_.Add(retransmits_);
+  group_.Add(timeouts_);
+  group_.Add(window_size_bytes_);
+  group_.Add(max_window_size_bytes_);
+  group_.Add(stream_time_us_);
+  group_.Add(rtt_us_);
+  group_.Add(min_rtt_us_);
+  parent.Add(group_);
+}
+
+void TransferMetrics::Reset(uint32_t session_id, uint32_t resource_id) {
+  session_id_.Set(session_id);
+  resource_id_.Set(resource_id);
+  bytes_.Set(0);
+  chunks_.Set(0);
+  retransmits_.Set(0);
+  timeouts_.Set(0);
+  window_size_bytes_.Set(0);
+  max_window_size_bytes_.Set(0);
+  stream_time_us_.Set(0);
+  rtt_us_.Set(0);
+  min_rtt_us_.Set(0);
+}
+
+void TransferMetrics::RecordWindow(uint32_t window_size_bytes) {
+  window_size_bytes_.Set(window_size_bytes);
+  if (window_size_bytes > max_window_size_bytes_.value()) {
+    max_window_size_bytes_.Set(window_size_bytes);
+  }
+}
+
+void TransferMetrics::RecordStreamTime(chrono::SystemClock::duration duration) {
+  stream_time_us_.Increment(ToMicroseconds(duration));
+}
+
+void TransferMetrics::RecordRtt(chrono::SystemClock::duration rtt) {
+  const uint32_t rtt_us = ToMicroseconds(rtt);
+  rtt_us_.Set(rtt_us);
+  if (min_rtt_us_.value() == 0 || rtt_us < min_rtt_us_.value()) {
+    min_rtt_us_.Set(rtt_us);
+  }
+}
+
+}  // namespace pw::transfer
@@ -323,6 +323,41 @@ TEST_F(ReadTransfer, OutOfOrder_SeekingSupported) {
       pw::containers::Equal(span(&kData[17], kData.end()), chunk.payload()));
 }
 
+TEST_F(ReadTransfer, OutOfOrder_SkipsReceivedRanges) {
+  rpc::test::WaitForPackets(ctx_.output(), 4, [this] {
+    ctx_.SendClientStream(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kStart)
+                        .set_session_id(3)
+                        .set_window_end_offset(32)
+                        .set_max_chunk_size_bytes(8)
+                        .set_offset(0)));
+  });
+  ASSERT_EQ(ctx_.total_responses(), 4u);
+
+  // The receiver lost [8, 16) but already has [16, 24).
+  constexpr Chunk::ReceivedRange kReceived[] = {{16, 24}};
+  rpc::test::WaitForPackets(ctx_.output(), 2, [this, &kReceived] {
+    ctx_.SendClientStream(EncodeChunk(
+        Chunk(ProtocolVersion::kLegacy, Chunk::Type::kParametersRetransmit)
+            .set_session_id(3)
+            .set_window_end_offset(32)
+            .set_max_chunk_size_bytes(8)
+            .set_offset(8)
+            .set_received_ranges(kReceived)));
+  });
+
+  ASSERT_EQ(ctx_.total_responses(), 6u);
+  Chunk chunk = DecodeChunk(ctx_.responses()[4]);
+  EXPECT_EQ(chunk.offset(), 8u);
+  EXPECT_TRUE(
+      pw::containers::Equal(span(kData).subspan(8, 8), chunk.payload()));
+
+  chunk = DecodeChunk(ctx_.responses()[5]);
+  EXPECT_EQ(chunk.offset(), 24u);
+  EXPECT_TRUE(
+      pw::containers::Equal(span(kData).subspan(24, 8), chunk.payload()));
+}
+
 TEST_F(ReadTransfer, OutOfOrder_SeekingNotSupported_EndsWithUnimplemented) {
   handler_.set_seek_status(Status::Unimplemented());
 
@@ -1268,6 +1303,199 @@ TEST_F(WriteTransfer, UnexpectedOffset) {
   EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), kData.size()), 0);
 }
 
+class WriteTransferAdaptiveWindow : public WriteTransfer {
+ protected:
+  WriteTransferAdaptiveWindow() : large_handler_(987, large_buffer_) {
+    ctx_.service().RegisterHandler(large_handler_);
+    ctx_.service().set_max_pending_bytes(
+        static_cast<uint32_t>(large_buffer_.size()));
+    ctx_.service().set_max_chunk_size_bytes(35);
+    ctx_.service().set_adaptive_windowing(true);
+  }
+
+  ~WriteTransferAdaptiveWindow() override {
+    ctx_.service().UnregisterHandler(large_handler_);
+  }
+
+  // Starts the transfer and returns the negotiated chunk size.
+  uint32_t Start() {
+    ctx_.SendClientStream(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kStart)
+                        .set_session_id(987)));
+    transfer_thread_.WaitUntilEventIsProcessed();
+
+    Chunk chunk = DecodeChunk(ctx_.responses().back());
+    PW_CHECK(chunk.max_chunk_size_bytes().has_value());
+    return chunk.max_chunk_size_bytes().value();
+  }
+
+  void SendData(uint32_t offset, uint32_t size) {
+    ctx_.SendClientStream<64>(
+        EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                        .set_session_id(987)
+                        .set_offset(offset)
+                        .set_payload(span(kLargeData).subspan(offset, size))));
+    transfer_thread_.WaitUntilEventIsProcessed();
+  }
+
+  static constexpr auto kLargeData =
+      bytes::Initialized<128>([](size_t i) { return i; });
+
+  std::array<std::byte, kLargeData.size()> large_buffer_ = {};
+  SimpleWriteTransfer large_handler_;
+};
+
+TEST_F(WriteTransferAdaptiveWindow, GrowsAndShrinksWindow) {
+  const uint32_t chunk_size = Start();
+
+  // The window starts at a single chunk.
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+  Chunk chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.offset(), 0u);
+  EXPECT_EQ(chunk.window_end_offset(), chunk_size);
+
+  // Completing the window doubles it.
+  SendData(0, chunk_size);
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kParametersRetransmit);
+  EXPECT_EQ(chunk.offset(), chunk_size);
+  EXPECT_EQ(chunk.window_end_offset(), 3 * chunk_size);
+
+  // Extending the window doubles it again.
+  SendData(chunk_size, chunk_size);
+  ASSERT_EQ(ctx_.total_responses(), 3u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kParametersContinue);
+  EXPECT_EQ(chunk.offset(), 2 * chunk_size);
+  EXPECT_EQ(chunk.window_end_offset(), 6 * chunk_size);
+
+  // A lost chunk halves the window.
+  SendData(3 * chunk_size, chunk_size);
+  ASSERT_EQ(ctx_.total_responses(), 4u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kParametersRetransmit);
+  EXPECT_EQ(chunk.offset(), 2 * chunk_size);
+  EXPECT_EQ(chunk.window_end_offset(), 4 * chunk_size);
+
+  // Following a loss, the window only grows by a single chunk.
+  SendData(2 * chunk_size, chunk_size);
+  ASSERT_EQ(ctx_.total_responses(), 5u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kParametersContinue);
+  EXPECT_EQ(chunk.offset(), 3 * chunk_size);
+  EXPECT_EQ(chunk.window_end_offset(), 6 * chunk_size);
+  EXPECT_EQ(chunk.max_chunk_size_bytes().value(), chunk_size);
+}
+
+TEST_F(WriteTransferAdaptiveWindow, TimeoutResetsWindow) {
+  const uint32_t chunk_size = Start();
+
+  SendData(0, chunk_size);
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+  Chunk chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.window_end_offset(), 3 * chunk_size);
+
+  // A timeout drops the window back to a single chunk.
+  transfer_thread_.SimulateServerTimeout(987);
+  transfer_thread_.WaitUntilEventIsProcessed();
+  ASSERT_EQ(ctx_.total_responses(), 3u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kParametersRetransmit);
+  EXPECT_EQ(chunk.offset(), chunk_size);
+  EXPECT_EQ(chunk.window_end_offset(), 2 * chunk_size);
+
+  // The slow start threshold was halved, so the window grows linearly.
+  SendData(chunk_size, chunk_size);
+  ASSERT_EQ(ctx_.total_responses(), 4u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.offset(), 2 * chunk_size);
+  EXPECT_EQ(chunk.window_end_offset(), 3 * chunk_size);
+
+  SendData(2 * chunk_size, chunk_size);
+  ASSERT_EQ(ctx_.total_responses(), 5u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.offset(), 3 * chunk_size);
+  EXPECT_EQ(chunk.window_end_offset(), 5 * chunk_size);
+}
+
+TEST_F(WriteTransfer, SelectiveAck_KeepsOutOfOrderData) {
+  ctx_.service().set_selective_ack(true);
+
+  ctx_.SendClientStream(EncodeChunk(
+      Chunk(ProtocolVersion::kLegacy, Chunk::Type::kStart).set_session_id(7)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+  Chunk chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.window_end_offset(), 32u);
+
+  ctx_.SendClientStream<64>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(7)
+                      .set_offset(0)
+                      .set_payload(span(kData).first(8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+
+  // Drop [8, 16). The receiver keeps [16, 24) and reports it.
+  ctx_.SendClientStream<64>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(7)
+                      .set_offset(16)
+                      .set_payload(span(kData).subspan(16, 8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kParametersRetransmit);
+  EXPECT_EQ(chunk.offset(), 8u);
+  EXPECT_EQ(chunk.window_end_offset(), 32u);
+  ASSERT_EQ(chunk.received_ranges().size(), 1u);
+  EXPECT_EQ(chunk.received_ranges()[0].start_offset, 16u);
+  EXPECT_EQ(chunk.received_ranges()[0].end_offset, 24u);
+
+  // Filling the gap skips over the data that was already received.
+  ctx_.SendClientStream<64>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(7)
+                      .set_offset(8)
+                      .set_payload(span(kData).subspan(8, 8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 3u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  EXPECT_EQ(chunk.type(), Chunk::Type::kParametersRetransmit);
+  EXPECT_EQ(chunk.offset(), 24u);
+  EXPECT_TRUE(chunk.received_ranges().empty());
+
+  // A late copy of the skipped data is ignored.
+  ctx_.SendClientStream<64>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(7)
+                      .set_offset(16)
+                      .set_payload(span(kData).subspan(16, 8))));
+  transfer_thread_.WaitUntilEventIsProcessed();
+  ASSERT_EQ(ctx_.total_responses(), 3u);
+
+  ctx_.SendClientStream<64>(
+      EncodeChunk(Chunk(ProtocolVersion::kLegacy, Chunk::Type::kData)
+                      .set_session_id(7)
+                      .set_offset(24)
+                      .set_payload(span(kData).subspan(24))
+                      .set_remaining_bytes(0)));
+  transfer_thread_.WaitUntilEventIsProcessed();
+
+  ASSERT_EQ(ctx_.total_responses(), 4u);
+  chunk = DecodeChunk(ctx_.responses().back());
+  ASSERT_TRUE(chunk.status().has_value());
+  EXPECT_EQ(chunk.status().value(), OkStatus());
+
+  EXPECT_TRUE(handler_.finalize_write_called);
+  EXPECT_EQ(handler_.finalize_write_status, OkStatus());
+  EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), kData.size()), 0);
+}
+
 TEST_F(WriteTransferMaxBytes16, TooMuchData) {
   ctx_.SendClientStream(EncodeChunk(
       Chunk(ProtocolVersion::kLegacy, Chunk::Type::kStart).set_session_id(7)));
@@ -20,12 +20,49 @@
 #include "pw_log/log.h"
 #include "pw_transfer/internal/chunk.h"
 #include "pw_transfer/internal/client_context.h"
+#include "pw_transfer/internal/config.h"
 #include "pw_transfer/internal/event.h"
+#include "pw_trace/trace.h"
 
 PW_MODIFY_DIAGNOSTICS_PUSH();
 PW_MODIFY_DIAGNOSTIC(ignored, "-Wmissing-field-initializers");
 
 namespace pw::transfer::internal {
+namespace {
+
+#if PW_TRANSFER_ENABLE_TRACING
+
+// Returns the identifier of the transfer an event is for, which is used as its
+// trace ID to group it with the transfer's other trace events. Events that are
+// not for a particular transfer use 0.
+uint32_t EventTraceId(const Event& event) {
+  switch (event.type) {
+    case EventType::kNewClientTransfer:
+    case EventType::kNewServerTransfer:
+      return event.new_transfer.session_id;
+    case EventType::kClientChunk:
+    case EventType::kServerChunk:
+    case EventType::kClientTimeout:
+    case EventType::kServerTimeout:
+      return event.chunk.context_identifier;
+    case EventType::kClientEndTransfer:
+    case EventType::kServerEndTransfer:
+      return event.end_transfer.id;
+    case EventType::kSendStatusChunk:
+      return event.send_status_chunk.session_id;
+    case EventType::kUpdateClientTransfer:
+    case EventType::kAddTransferHandler:
+    case EventType::kRemoveTransferHandler:
+    case EventType::kTerminate:
+    case EventType::kGetResourceStatus:
+      break;
+  }
+  return 0;
+}
+
+#endif  // PW_TRANSFER_ENABLE_TRACING
+
+}  // namespace
 
 void TransferThread::Terminate() {
   next_event_ownership_.acquire();
@@ -51,8 +88,17 @@ void TransferThread::Run() {
 
   while (true) {
     if (event_notification_.try_acquire_until(GetNextTransferTimeout())) {
+#if PW_TRANSFER_ENABLE_TRACING
+      const uint32_t trace_id = EventTraceId(next_event_);
+      PW_TRACE_START("Event", "pw_transfer", trace_id);
+#endif  // PW_TRANSFER_ENABLE_TRACING
+
       HandleEvent(next_event_);
 
+#if PW_TRANSFER_ENABLE_TRACING
+      PW_TRACE_END("Event", "pw_transfer", trace_id);
+#endif  // PW_TRANSFER_ENABLE_TRACING
+
       // Sample event type before we release ownership of next_event_.
       bool is_terminating = next_event_.type == EventType::kTerminate;
 
@@ -114,7 +160,8 @@ void TransferThread::StartTransfer(
     chrono::SystemClock::duration initial_timeout,
     uint8_t max_retries,
     uint32_t max_lifetime_retries,
-    uint32_t initial_offset) {
+    uint32_t initial_offset,
+    size_t transfer_size_bytes) {
   // Block until the last event has been processed.
   next_event_ownership_.acquire();
 
@@ -150,6 +197,7 @@ void TransferThread::StartTransfer(
       .raw_chunk_data = chunk_buffer_.data(),
       .raw_chunk_size = raw_chunk.size(),
       .initial_offset = initial_offset,
+      .transfer_size_bytes = transfer_size_bytes,
   };
 
   staged_on_completion_ = std::move(on_completion);
@@ -282,7 +330,117 @@ void TransferThread::TransferHandlerEvent(EventType type, Handler& handler) {
   event_notification_.release();
 }
 
+void TransferThread::RegisterContextMetrics() {
+#if PW_TRANSFER_ENABLE_METRICS
+  for (ClientContext& context : client_transfers_) {
+    context.metrics().Register(metrics_);
+  }
+  for (ServerContext& context : server_transfers_) {
+    context.metrics().Register(metrics_);
+  }
+#endif  // PW_TRANSFER_ENABLE_METRICS
+}
+
+void TransferThread::SetServerWorkers(span<TransferThread* const> workers) {
+  for (TransferThread* worker : workers) {
+    PW_CHECK(worker->chunk_buffer_.size() >= chunk_buffer_.size(),
+             "Server worker chunk buffers must fit any received chunk");
+    worker->dispatcher_ = this;
+  }
+  server_workers_ = workers;
+}
+
+void TransferThread::DispatchToServerWorker(const internal::Event& event) {
+  uint32_t session_id;
+  bool may_drop = false;
+
+  switch (event.type) {
+    case EventType::kNewServerTransfer:
+      session_id = event.new_transfer.session_id;
+      may_drop = true;
+      break;
+    case EventType::kServerChunk:
+      session_id = event.chunk.context_identifier;
+      may_drop = true;
+      break;
+    case EventType::kServerTimeout:
+      session_id = event.chunk.context_identifier;
+      break;
+    case EventType::kServerEndTransfer:
+      PW_DCHECK(event.end_transfer.id_type != IdentifierType::Handle);
+      session_id = event.end_transfer.id;
+      break;
+    default:
+      PW_CRASH("Event is not handled by a server worker");
+  }
+
+  TransferThread& worker =
+      *server_workers_[session_id % server_workers_.size()];
+
+  // Chunks are dropped rather than waiting indefinitely on a worker that is
+  // blocked in handler I/O. The transfer protocol recovers them through its
+  // regular retries.
+  if (!worker.PostWorkerEvent(event, may_drop)) {
+    PW_LOG_DEBUG("Server worker for transfer %u is busy; dropping chunk",
+                 static_cast<unsigned>(session_id));
+  }
+}
+
+bool TransferThread::PostWorkerEvent(const internal::Event& event,
+                                     bool may_drop) {
+  if (may_drop) {
+    if (!next_event_ownership_.try_acquire_for(
+            cfg::kServerWorkerDispatchTimeout)) {
+      return false;
+    }
+  } else {
+    next_event_ownership_.acquire();
+  }
+
+  next_event_ = event;
+
+  // Chunk data is staged in the dispatching thread's buffer, which is reused
+  // once this function returns, so copy it into the worker's own buffer.
+  if (event.type == EventType::kNewServerTransfer) {
+    std::memcpy(chunk_buffer_.data(),
+                event.new_transfer.raw_chunk_data,
+                event.new_transfer.raw_chunk_size);
+    next_event_.new_transfer.raw_chunk_data = chunk_buffer_.data();
+    next_event_.new_transfer.transfer_thread = this;
+  } else if (event.type == EventType::kServerChunk) {
+    std::memcpy(chunk_buffer_.data(), event.chunk.data, event.chunk.size);
+    next_event_.chunk.data = chunk_buffer_.data();
+  }
+
+  event_notification_.release();
+  return true;
+}
+
 void TransferThread::HandleEvent(const internal::Event& event) {
+  if (!server_workers_.empty()) {
+    switch (event.type) {
+      case EventType::kNewServerTransfer:
+      case EventType::kServerChunk:
+      case EventType::kServerTimeout:
+      case EventType::kServerEndTransfer:
+        DispatchToServerWorker(event);
+        return;
+
+      case EventType::kTerminate:
+      case EventType::kRemoveTransferHandler:
+        // Workers must stop using a handler (or terminate entirely) before
+        // this thread proceeds.
+        for (TransferThread* worker : server_workers_) {
+          worker->PostWorkerEvent(event, /*may_drop=*/false);
+          worker->WaitUntilEventIsProcessed();
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
   switch (event.type) {
     case EventType::kTerminate:
       // Terminate server contexts.
@@ -389,6 +547,7 @@ void TransferThread::HandleEvent(const internal::Event& event) {
     ClientContext* cctx = static_cast<ClientContext*>(ctx);
     cctx->set_on_completion(std::move(staged_on_completion_));
     cctx->set_handle_id(event.new_transfer.handle_id);
+    cctx->set_transfer_size_bytes(event.new_transfer.transfer_size_bytes);
   }
 
   if (event.type == EventType::kUpdateClientTransfer) {
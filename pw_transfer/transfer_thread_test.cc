@@ -19,6 +19,7 @@
 #include "pw_rpc/raw/client_testing.h"
 #include "pw_rpc/raw/test_method_context.h"
 #include "pw_rpc/test_helpers.h"
+#include "pw_sync/thread_notification.h"
 #include "pw_thread/thread.h"
 #include "pw_thread_stl/options.h"
 #include "pw_transfer/handler.h"
@@ -353,5 +354,149 @@ TEST_F(TransferThreadTest, VersionTwo_NoHandler) {
   transfer_thread_.RemoveTransferHandler(handler);
 }
 
+class BlockingReadTransfer final : public ReadOnlyHandler {
+ public:
+  BlockingReadTransfer(uint32_t session_id, ConstByteSpan data)
+      : ReadOnlyHandler(session_id), prepare_read_called(false), reader_(data) {}
+
+  Status PrepareRead() final {
+    unblock.acquire();
+    set_reader(reader_);
+    prepare_read_called = true;
+    return OkStatus();
+  }
+
+  sync::ThreadNotification unblock;
+  bool prepare_read_called;
+
+ private:
+  stream::MemoryReader reader_;
+};
+
+class TransferThreadServerWorkerTest : public ::testing::Test {
+ public:
+  TransferThreadServerWorkerTest()
+      : ctx_(transfer_thread_, 512),
+        max_parameters_(chunk_buffer_.size(),
+                        chunk_buffer_.size(),
+                        cfg::kDefaultExtendWindowDivisor),
+        transfer_thread_(chunk_buffer_, encode_buffer_),
+        worker_a_(worker_a_chunk_buffer_, worker_a_encode_buffer_),
+        worker_b_(worker_b_chunk_buffer_, worker_b_encode_buffer_),
+        workers_{&worker_a_, &worker_b_} {
+    transfer_thread_.SetServerWorkers(workers_);
+    system_thread_ = thread::Thread(TransferThreadOptions(), transfer_thread_);
+    worker_a_thread_ = thread::Thread(TransferThreadOptions(), worker_a_);
+    worker_b_thread_ = thread::Thread(TransferThreadOptions(), worker_b_);
+  }
+
+  ~TransferThreadServerWorkerTest() override {
+    // Terminating the dispatching thread also terminates its workers.
+    transfer_thread_.Terminate();
+    system_thread_.join();
+    worker_a_thread_.join();
+    worker_b_thread_.join();
+  }
+
+ protected:
+  void StartReadTransfer(uint32_t session_id) {
+    transfer_thread_.StartServerTransfer(
+        internal::TransferType::kTransmit,
+        ProtocolVersion::kLegacy,
+        session_id,
+        session_id,
+        EncodeChunk(
+            Chunk(ProtocolVersion::kLegacy, Chunk::Type::kParametersRetransmit)
+                .set_session_id(session_id)
+                // Ensure only one chunk is sent as end offset equals max size.
+                .set_window_end_offset(16)
+                .set_max_chunk_size_bytes(16)
+                .set_offset(0)),
+        max_parameters_,
+        kNeverTimeout,
+        3,
+        10);
+    transfer_thread_.WaitUntilEventIsProcessed();
+  }
+
+  PW_RAW_TEST_METHOD_CONTEXT(TransferService, Read) ctx_;
+
+  std::array<std::byte, 64> chunk_buffer_;
+  std::array<std::byte, 64> encode_buffer_;
+  std::array<std::byte, 64> worker_a_chunk_buffer_;
+  std::array<std::byte, 64> worker_a_encode_buffer_;
+  std::array<std::byte, 64> worker_b_chunk_buffer_;
+  std::array<std::byte, 64> worker_b_encode_buffer_;
+
+  internal::TransferParameters max_parameters_;
+
+  transfer::Thread<1, 0> transfer_thread_;
+  transfer::ServerWorker<1> worker_a_;
+  transfer::ServerWorker<1> worker_b_;
+  std::array<TransferThread*, 2> workers_;
+
+  thread::Thread system_thread_;
+  thread::Thread worker_a_thread_;
+  thread::Thread worker_b_thread_;
+};
+
+TEST_F(TransferThreadServerWorkerTest, ShardsTransfersAcrossWorkers) {
+  auto reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(reader_writer);
+
+  // Sessions 3 and 4 are assigned to different workers, each of which has a
+  // single context.
+  SimpleReadTransfer handler3(3, kData);
+  SimpleReadTransfer handler4(4, kData);
+  transfer_thread_.AddTransferHandler(handler3);
+  transfer_thread_.AddTransferHandler(handler4);
+
+  StartReadTransfer(3);
+  worker_b_.WaitUntilEventIsProcessed();
+  StartReadTransfer(4);
+  worker_a_.WaitUntilEventIsProcessed();
+
+  EXPECT_TRUE(handler3.prepare_read_called);
+  EXPECT_TRUE(handler4.prepare_read_called);
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+  EXPECT_EQ(DecodeChunk(ctx_.responses()[0]).session_id(), 3u);
+  EXPECT_EQ(DecodeChunk(ctx_.responses()[1]).session_id(), 4u);
+
+  transfer_thread_.RemoveTransferHandler(handler3);
+  transfer_thread_.RemoveTransferHandler(handler4);
+}
+
+TEST_F(TransferThreadServerWorkerTest, BlockedHandlerDoesNotStallOtherWorkers) {
+  auto reader_writer = ctx_.reader_writer();
+  transfer_thread_.SetServerReadStream(reader_writer);
+
+  BlockingReadTransfer slow_handler(4, kData);
+  SimpleReadTransfer fast_handler(3, kData);
+  transfer_thread_.AddTransferHandler(slow_handler);
+  transfer_thread_.AddTransferHandler(fast_handler);
+
+  // The first worker blocks in the slow handler's PrepareRead.
+  StartReadTransfer(4);
+
+  // The second worker continues to run its transfer.
+  StartReadTransfer(3);
+  worker_b_.WaitUntilEventIsProcessed();
+
+  EXPECT_TRUE(fast_handler.prepare_read_called);
+  EXPECT_FALSE(slow_handler.prepare_read_called);
+  ASSERT_EQ(ctx_.total_responses(), 1u);
+  EXPECT_EQ(DecodeChunk(ctx_.response()).session_id(), 3u);
+
+  slow_handler.unblock.release();
+  worker_a_.WaitUntilEventIsProcessed();
+
+  EXPECT_TRUE(slow_handler.prepare_read_called);
+  ASSERT_EQ(ctx_.total_responses(), 2u);
+  EXPECT_EQ(DecodeChunk(ctx_.responses()[1]).session_id(), 4u);
+
+  transfer_thread_.RemoveTransferHandler(slow_handler);
+  transfer_thread_.RemoveTransferHandler(fast_handler);
+}
+
 }  // namespace
 }  // namespace pw::transfer::test
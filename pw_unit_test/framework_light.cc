@@ -15,6 +15,14 @@
 #include <algorithm>
 #include <cstring>
 
+// Environment variables select the shard to run on platforms that have them.
+#if __has_include(<cstdlib>)
+#include <cstdlib>
+#define _PW_UNIT_TEST_HAS_ENVIRONMENT 1
+#else
+#define _PW_UNIT_TEST_HAS_ENVIRONMENT 0
+#endif  // __has_include(<cstdlib>)
+
 #include "light_public_overrides/pw_unit_test/framework_backend.h"
 #include "pw_assert/check.h"
 
@@ -58,9 +66,16 @@ int Framework::RunAllTests() {
   if (event_handler_ != nullptr) {
     event_handler_->RunAllTestsStart();
   }
+  uint32_t test_index = 0;
   for (const TestInfo* test = tests_; test != nullptr; test = test->next()) {
     if (ShouldRunTest(*test)) {
-      test->run();
+      // Tests in other shards are not counted, so that the summaries of all
+      // shards add up to the summary of an unsharded run.
+      if (InCurrentShard(test_index)) {
+        current_test_index_ = test_index;
+        test->run();
+      }
+      test_index++;
     } else if (!test->enabled()) {
       run_tests_summary_.disabled_tests++;
 
@@ -82,8 +97,14 @@ void Framework::SetUpTestSuiteIfNeeded(SetUpTestSuiteFunc set_up_ts) const {
     return;
   }
 
+  // Set up the suite unless an earlier test in it ran in this shard.
+  uint32_t test_index = 0;
   for (TestInfo* info = tests_; info != current_test_; info = info->next()) {
-    if (info->test_case().suite_name == current_test_->test_case().suite_name) {
+    if (!ShouldRunTest(*info)) {
+      continue;
+    }
+    if (InCurrentShard(test_index++) &&
+        info->test_case().suite_name == current_test_->test_case().suite_name) {
       return;
     }
   }
@@ -97,9 +118,15 @@ void Framework::TearDownTestSuiteIfNeeded(
     return;
   }
 
+  // Tear down the suite unless a later test in it runs in this shard.
+  uint32_t test_index = current_test_index_ + 1;
   for (TestInfo* info = current_test_->next(); info != nullptr;
        info = info->next()) {
-    if (info->test_case().suite_name == current_test_->test_case().suite_name) {
+    if (!ShouldRunTest(*info)) {
+      continue;
+    }
+    if (InCurrentShard(test_index++) &&
+        info->test_case().suite_name == current_test_->test_case().suite_name) {
       return;
     }
   }
@@ -173,6 +200,14 @@ void Framework::CurrentTestExpectSimple(const char* expression,
   event_handler_->TestCaseExpect(current_test_->test_case(), expectation);
 }
 
+void Framework::SetTestShard(uint32_t shard_index, uint32_t total_shards) {
+  PW_CHECK_UINT_LT(shard_index,
+                   total_shards,
+                   "The shard index must be less than the number of shards");
+  shard_index_ = shard_index;
+  total_shards_ = total_shards;
+}
+
 bool Framework::ShouldRunTest(const TestInfo& test_info) const {
 #if PW_CXX_STANDARD_IS_SUPPORTED(17)
   // Test suite filtering is only supported if using C++17.
@@ -202,3 +237,19 @@ bool TestInfo::enabled() const {
 }  // namespace internal
 }  // namespace unit_test
 }  // namespace pw
+
+namespace testing {
+
+void InitGoogleTest(int*, char**) {
+#if _PW_UNIT_TEST_HAS_ENVIRONMENT
+  const char* total_shards = std::getenv("GTEST_TOTAL_SHARDS");
+  const char* shard_index = std::getenv("GTEST_SHARD_INDEX");
+  if (total_shards != nullptr && shard_index != nullptr) {
+    ::pw::unit_test::SetTestShard(
+        static_cast<uint32_t>(std::strtoul(shard_index, nullptr, 10)),
+        static_cast<uint32_t>(std::strtoul(total_shards, nullptr, 10)));
+  }
+#endif  // _PW_UNIT_TEST_HAS_ENVIRONMENT
+}
+
+}  // namespace testing
@@ -420,6 +420,9 @@ class Framework {
                            .disabled_tests = 0},
         exit_status_(0),
         event_handler_(nullptr),
+        shard_index_(0),
+        total_shards_(1),
+        current_test_index_(0),
         memory_pool_() {}
 
   static Framework& Get() { return framework_; }
@@ -448,6 +451,12 @@ class Framework {
   }
 #endif  // PW_CXX_STANDARD_IS_SUPPORTED(17)
 
+  // Only run one shard of the tests during the next test run. The tests that
+  // would otherwise run are split across total_shards shards, and the tests in
+  // shard_index are run. Every test runs in exactly one shard, so running each
+  // shard in a separate process runs all of the tests.
+  void SetTestShard(uint32_t shard_index, uint32_t total_shards);
+
   bool ShouldRunTest(const TestInfo& test_info) const;
 
   // Whether the current test is skipped.
@@ -596,6 +605,12 @@ class Framework {
   // Dispatches event indicating that a test finished and clears current_test_.
   void EndCurrentTest();
 
+  // Whether a test runs in the current shard, given its index among the tests
+  // for which ShouldRunTest() is true.
+  bool InCurrentShard(uint32_t test_index) const {
+    return test_index % total_shards_ == shard_index_;
+  }
+
   // Singleton instance of the framework class.
   static Framework framework_;
 
@@ -618,6 +633,14 @@ class Framework {
   // Handler to which to dispatch test events.
   EventHandler* event_handler_;
 
+  // The shard of tests to run; see SetTestShard().
+  uint32_t shard_index_;
+  uint32_t total_shards_;
+
+  // Index of the current test among the tests for which ShouldRunTest() is
+  // true, which determines its shard.
+  uint32_t current_test_index_;
+
 #if PW_CXX_STANDARD_IS_SUPPORTED(17)
   span<std::string_view> test_suites_to_run_;
 #else
@@ -777,6 +800,13 @@ inline void SetTestSuitesToRun(span<std::string_view> test_suites) {
 }
 #endif  // PW_CXX_STANDARD_IS_SUPPORTED(17)
 
+// Only runs shard shard_index of total_shards during subsequent test runs. The
+// shards split the tests that pass the test suite filter, if any. Call with
+// (0, 1) to run all tests again.
+inline void SetTestShard(uint32_t shard_index, uint32_t total_shards) {
+  internal::Framework::Get().SetTestShard(shard_index, total_shards);
+}
+
 }  // namespace unit_test
 }  // namespace pw
 
@@ -899,7 +929,9 @@ namespace testing {
 // Alias Test as ::testing::Test for GoogleTest compatibility.
 using Test = ::pw::unit_test::internal::Test;
 
-// Provide a no-op init routine for GoogleTest compatibility.
-inline void InitGoogleTest(int*, char**) {}
+// Provide an init routine for GoogleTest compatibility. Like GoogleTest, this
+// reads the shard to run from the GTEST_TOTAL_SHARDS and GTEST_SHARD_INDEX
+// environment variables, on platforms that have environment variables.
+void InitGoogleTest(int*, char**);
 
 }  // namespace testing
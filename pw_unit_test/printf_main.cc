@@ -15,7 +15,8 @@
 #include "pw_unit_test/framework.h"
 #include "pw_unit_test/printf_event_handler.h"
 
-int main() {
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
   pw::unit_test::PrintfEventHandler handler;
   pw::unit_test::RegisterEventHandler(&handler);
   return RUN_ALL_TESTS();
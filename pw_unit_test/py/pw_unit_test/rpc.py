@@ -154,16 +154,24 @@ def run_tests(
     test_suites: Iterable[str] = (),
     event_handlers: Iterable[EventHandler] = (LoggingEventHandler(),),
     timeout_s: OptionalTimeout = UseDefault.VALUE,
+    shard_index: int = 0,
+    total_shards: int = 0,
 ) -> TestRecord:
     """Runs unit tests on a device over :ref:`module-pw_rpc`.
 
     Calls each of the provided event handlers as test events occur, and returns
     ``True`` if all tests pass.
+
+    If ``total_shards`` is set, only the tests in shard ``shard_index`` of
+    ``total_shards`` are run. Running every shard runs each test exactly once.
+    Sharding is only supported by the ``pw_unit_test:light`` backend.
     """
     unit_test_service = rpcs.pw.unit_test.UnitTest  # type: ignore[attr-defined]
     request = unit_test_service.Run.request(
         report_passed_expectations=report_passed_expectations,
         test_suite=test_suites,
+        shard_index=shard_index,
+        total_shards=total_shards,
     )
     call = unit_test_service.Run.invoke(request, timeout_s=timeout_s)
     test_responses = iter(call)
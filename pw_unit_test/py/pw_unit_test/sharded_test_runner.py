@@ -0,0 +1,238 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Runs a host unit test binary as several shards in parallel.
+
+Each shard is a separate process of the test binary that runs a subset of its
+tests, selected with the ``GTEST_TOTAL_SHARDS`` and ``GTEST_SHARD_INDEX``
+environment variables. Both ``pw_unit_test:light`` and GoogleTest binaries
+support these variables, as long as their ``main()`` calls
+``testing::InitGoogleTest()``. The shards' GoogleTest-style output is parsed and
+combined into one set of results.
+"""
+
+import argparse
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass, field
+import logging
+import os
+from pathlib import Path
+import subprocess
+import sys
+from typing import Iterable, List, Optional, Sequence
+
+_LOG = logging.getLogger('pw_unit_test')
+
+# Verification of test pass/failure depends on these strings. If the formatting
+# of the googletest_style_event_handler changes, this may need to be updated.
+_TEST_START = '[ RUN      ] '
+_TEST_OK = '[       OK ] '
+_TEST_FAILED = '[  FAILED  ] '
+_TEST_SKIPPED = '[  SKIPPED ] '
+_TEST_DISABLED = '[ DISABLED ] '
+
+
+@dataclass
+class ShardResult:
+    """The tests run by one shard, named ``Suite.Test``."""
+
+    passed: List[str] = field(default_factory=list)
+    failed: List[str] = field(default_factory=list)
+    skipped: List[str] = field(default_factory=list)
+    disabled: List[str] = field(default_factory=list)
+
+    def all_tests_passed(self) -> bool:
+        return not self.failed
+
+    def __bool__(self) -> bool:
+        return self.all_tests_passed()
+
+    def merge(self, other: 'ShardResult') -> None:
+        """Adds the results of another shard to these results."""
+        self.passed += other.passed
+        self.failed += other.failed
+        self.skipped += other.skipped
+        # Every shard reports the disabled tests, so only record them once.
+        self.disabled += (t for t in other.disabled if t not in self.disabled)
+
+
+def parse_test_output(
+    lines: Iterable[str], exited_cleanly: bool
+) -> ShardResult:
+    """Collects test results from GoogleTest-style output.
+
+    A test that started but did not finish is counted as failed, since the test
+    binary crashed while running it. If the binary did not exit cleanly for
+    another reason, the results are returned as is, and the caller must treat
+    the shard as failed.
+    """
+    result = ShardResult()
+    current_test: Optional[str] = None
+
+    for line in lines:
+        line = line.strip()
+        if line.startswith(_TEST_START):
+            current_test = line[len(_TEST_START) :]
+            continue
+
+        # Result lines only have a test name while a test is running. The
+        # summaries at the end of a run share the same prefixes.
+        if current_test is not None:
+            if line.startswith(_TEST_OK):
+                result.passed.append(current_test)
+            elif line.startswith(_TEST_FAILED):
+                result.failed.append(current_test)
+            elif line.startswith((_TEST_SKIPPED, _TEST_DISABLED)):
+                # The light backend reports skipped tests as disabled.
+                result.skipped.append(current_test)
+            else:
+                continue
+            current_test = None
+        elif line.startswith(_TEST_DISABLED):
+            name = line[len(_TEST_DISABLED) :]
+            if '.' in name and ' ' not in name:
+                result.disabled.append(name)
+
+    if current_test is not None and not exited_cleanly:
+        result.failed.append(current_test)
+
+    return result
+
+
+@dataclass
+class _Shard:
+    index: int
+    returncode: int
+    output: str
+
+
+def _run_shard(
+    command: Sequence[str], index: int, total_shards: int, timeout_s: float
+) -> _Shard:
+    env = dict(
+        os.environ,
+        GTEST_SHARD_INDEX=str(index),
+        GTEST_TOTAL_SHARDS=str(total_shards),
+    )
+    try:
+        process = subprocess.run(
+            command,
+            env=env,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            timeout=timeout_s,
+        )
+    except subprocess.TimeoutExpired as err:
+        output = err.output.decode(errors='replace') if err.output else ''
+        return _Shard(index, -1, output + '\nTimed out\n')
+
+    return _Shard(
+        index, process.returncode, process.stdout.decode(errors='replace')
+    )
+
+
+def run_sharded(
+    command: Sequence[str],
+    total_shards: Optional[int] = None,
+    timeout_s: float = 600.0,
+) -> ShardResult:
+    """Runs a test binary as ``total_shards`` shards in parallel.
+
+    Args:
+      command: The test binary and any arguments to pass to it.
+      total_shards: The number of shards to run. Defaults to the number of
+        CPUs.
+      timeout_s: How long each shard may run before it is considered failed.
+
+    Returns:
+      The combined results of all shards. A shard that exits with an error
+      without reporting a failed test adds a failure named after the shard.
+    """
+    if total_shards is None:
+        total_shards = os.cpu_count() or 1
+    if total_shards < 1:
+        raise ValueError('At least one shard is required')
+
+    with ThreadPoolExecutor(max_workers=total_shards) as executor:
+        shards = list(
+            executor.map(
+                lambda i: _run_shard(command, i, total_shards, timeout_s),
+                range(total_shards),
+            )
+        )
+
+    result = ShardResult()
+    for shard in shards:
+        shard_result = parse_test_output(
+            shard.output.splitlines(), shard.returncode == 0
+        )
+        if shard.returncode != 0:
+            _LOG.error(
+                'Shard %d of %d exited with %d:\n%s',
+                shard.index,
+                total_shards,
+                shard.returncode,
+                shard.output,
+            )
+            if not shard_result.failed:
+                shard_result.failed.append(f'<shard {shard.index}>')
+        result.merge(shard_result)
+
+    return result
+
+
+def _parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        '-j',
+        '--shards',
+        type=int,
+        default=None,
+        help='Number of shards to run in parallel (default: number of CPUs)',
+    )
+    parser.add_argument(
+        '--timeout',
+        type=float,
+        default=600.0,
+        help='Timeout in seconds for each shard',
+    )
+    parser.add_argument('binary', type=Path, help='Test binary to run')
+    parser.add_argument(
+        'args',
+        nargs=argparse.REMAINDER,
+        help='Arguments to pass to the test binary',
+    )
+    return parser.parse_args()
+
+
+def main(
+    binary: Path, args: List[str], shards: Optional[int], timeout: float
+) -> int:
+    result = run_sharded([str(binary), *args], shards, timeout)
+
+    _LOG.info('[  PASSED  ] %d test(s).', len(result.passed))
+    if result.skipped:
+        _LOG.info('[  SKIPPED ] %d test(s).', len(result.skipped))
+    if result.disabled:
+        _LOG.info('[ DISABLED ] %d test(s).', len(result.disabled))
+    if result.failed:
+        _LOG.error('[  FAILED  ] %d test(s):', len(result.failed))
+        for test in result.failed:
+            _LOG.error('[  FAILED  ] %s', test)
+
+    return 0 if result else 1
+
+
+if __name__ == '__main__':
+    logging.basicConfig(level=logging.INFO, format='%(message)s')
+    sys.exit(main(**vars(_parse_args())))
@@ -0,0 +1,107 @@
+# Copyright 2024 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Tests for the sharded host test runner."""
+
+from pathlib import Path
+import sys
+import tempfile
+import unittest
+
+from pw_unit_test.sharded_test_runner import parse_test_output, run_sharded
+
+_OUTPUT = """\
+[==========] Running all tests.
+[ RUN      ] Suite.Passes
+[       OK ] Suite.Passes
+[ RUN      ] Suite.Fails
+path/to/test.cc:10: Failure
+[  FAILED  ] Suite.Fails
+[ RUN      ] Suite.Skipped
+[ DISABLED ] Suite.Skipped
+[ DISABLED ] Suite.DISABLED_Test
+[==========] Done running all tests.
+[  PASSED  ] 1 test(s).
+[ DISABLED ] 1 test(s).
+[  FAILED  ] 1 test(s).
+"""
+
+# A fake test binary that runs every test whose index is in its shard.
+_FAKE_TEST_BINARY = """\
+import os
+import sys
+
+index = int(os.environ['GTEST_SHARD_INDEX'])
+total = int(os.environ['GTEST_TOTAL_SHARDS'])
+tests = ['Suite.Test{}'.format(i) for i in range(10)]
+print('[ DISABLED ] Suite.DISABLED_Test')
+for test in tests[index::total]:
+    print('[ RUN      ] ' + test)
+    if test == sys.argv[1]:
+        sys.exit(1)
+    print('[       OK ] ' + test)
+"""
+
+
+class ParseTestOutputTest(unittest.TestCase):
+    """Tests parsing GoogleTest-style output."""
+
+    def test_parse_results(self) -> None:
+        result = parse_test_output(_OUTPUT.splitlines(), exited_cleanly=True)
+        self.assertEqual(result.passed, ['Suite.Passes'])
+        self.assertEqual(result.failed, ['Suite.Fails'])
+        self.assertEqual(result.skipped, ['Suite.Skipped'])
+        self.assertEqual(result.disabled, ['Suite.DISABLED_Test'])
+        self.assertFalse(result)
+
+    def test_crashed_test_fails(self) -> None:
+        lines = ['[ RUN      ] Suite.Passes', '[ RUN      ] Suite.Crashes']
+        result = parse_test_output(lines, exited_cleanly=False)
+        self.assertEqual(result.failed, ['Suite.Crashes'])
+
+
+class RunShardedTest(unittest.TestCase):
+    """Tests running a fake test binary in shards."""
+
+    def setUp(self) -> None:
+        self._temp_dir = tempfile.TemporaryDirectory()
+        self._binary = Path(self._temp_dir.name, 'fake_test.py')
+        self._binary.write_text(_FAKE_TEST_BINARY)
+
+    def tearDown(self) -> None:
+        self._temp_dir.cleanup()
+
+    def _run(self, crashing_test: str, shards: int):
+        return run_sharded(
+            [sys.executable, str(self._binary), crashing_test], shards
+        )
+
+    def test_all_tests_run_once(self) -> None:
+        result = self._run('', shards=3)
+        self.assertTrue(result)
+        self.assertEqual(
+            sorted(result.passed), [f'Suite.Test{i}' for i in range(10)]
+        )
+        self.assertEqual(result.disabled, ['Suite.DISABLED_Test'])
+
+    def test_crash_fails_test(self) -> None:
+        with self.assertLogs('pw_unit_test', 'ERROR'):
+            result = self._run('Suite.Test4', shards=4)
+        self.assertEqual(result.failed, ['Suite.Test4'])
+        # Tests after the crash in the same shard don't run.
+        self.assertNotIn('Suite.Test8', result.passed)
+        self.assertEqual(len(result.passed), 8)
+
+
+if __name__ == '__main__':
+    unittest.main()
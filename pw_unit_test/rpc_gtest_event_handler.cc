@@ -29,12 +29,19 @@ RpcEventHandler::RpcEventHandler(UnitTestService& service) : service_(service) {
   delete default_listener;
 }
 
-void RpcEventHandler::ExecuteTests(span<std::string_view> suites_to_run) {
+void RpcEventHandler::ExecuteTests(span<std::string_view> suites_to_run,
+                                   uint32_t,
+                                   uint32_t total_shards) {
   if (!suites_to_run.empty()) {
     PW_LOG_WARN(
         "GoogleTest backend does not support test suite filtering. Running all "
         "suites.");
   }
+  if (total_shards > 1) {
+    PW_LOG_WARN(
+        "GoogleTest backend does not support sharding over RPC. Running all "
+        "shards.");
+  }
   if (service_.verbose_) {
     PW_LOG_WARN(
         "GoogleTest backend does not support reporting passed expectations.");
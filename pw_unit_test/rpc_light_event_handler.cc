@@ -20,17 +20,23 @@ namespace pw::unit_test::internal {
 RpcEventHandler::RpcEventHandler(UnitTestService& service)
     : service_(service) {}
 
-void RpcEventHandler::ExecuteTests(span<std::string_view> suites_to_run) {
+void RpcEventHandler::ExecuteTests(span<std::string_view> suites_to_run,
+                                   uint32_t shard_index,
+                                   uint32_t total_shards) {
   RegisterEventHandler(this);
   SetTestSuitesToRun(suites_to_run);
+  SetTestShard(shard_index, total_shards);
 
-  PW_LOG_DEBUG("%u test suite filters applied",
-               static_cast<unsigned>(suites_to_run.size()));
+  PW_LOG_DEBUG("%u test suite filters applied, running shard %u of %u",
+               static_cast<unsigned>(suites_to_run.size()),
+               static_cast<unsigned>(shard_index),
+               static_cast<unsigned>(total_shards));
 
   RUN_ALL_TESTS();
 
   RegisterEventHandler(nullptr);
   SetTestSuitesToRun({});
+  SetTestShard(0, 1);
 }
 
 void RpcEventHandler::RunAllTestsStart() { service_.WriteTestRunStart(); }
@@ -13,6 +13,8 @@
 // the License.
 #pragma once
 
+#include <cstdint>
+
 #include "pw_span/span.h"
 #include "pw_unit_test/framework.h"
 
@@ -26,7 +28,9 @@ namespace internal {
 class RpcEventHandler : public EventHandler {
  public:
   RpcEventHandler(UnitTestService& service);
-  void ExecuteTests(span<std::string_view> suites_to_run);
+  void ExecuteTests(span<std::string_view> suites_to_run,
+                    uint32_t shard_index,
+                    uint32_t total_shards);
 
   void TestProgramStart(const ProgramSummary&) override {}
   void EnvironmentsSetUpEnd() override {}
@@ -30,6 +30,10 @@ void UnitTestService::Run(ConstByteSpan request, RawServerWriter& writer) {
   // duration of this function.
   pw::Vector<std::string_view, 16> suites_to_run;
 
+  // The shard of tests to run. total_shards is 0 if the tests are not sharded.
+  uint32_t shard_index = 0;
+  uint32_t total_shards = 0;
+
   protobuf::Decoder decoder(request);
 
   Status status;
@@ -58,6 +62,16 @@ void UnitTestService::Run(ConstByteSpan request, RawServerWriter& writer) {
 
         break;
       }
+
+      case pwpb::TestRunRequest::Fields::kShardIndex:
+        decoder.ReadUint32(&shard_index)
+            .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+        break;
+
+      case pwpb::TestRunRequest::Fields::kTotalShards:
+        decoder.ReadUint32(&total_shards)
+            .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+        break;
     }
   }
 
@@ -67,8 +81,20 @@ void UnitTestService::Run(ConstByteSpan request, RawServerWriter& writer) {
     return;
   }
 
+  if (total_shards == 0) {
+    total_shards = 1;
+  }
+  if (shard_index >= total_shards) {
+    PW_LOG_ERROR("Shard index %u is out of range for %u shards",
+                 static_cast<unsigned>(shard_index),
+                 static_cast<unsigned>(total_shards));
+    writer_.Finish(Status::InvalidArgument())
+        .IgnoreError();  // TODO: b/242598609 - Handle Status properly
+    return;
+  }
+
   PW_LOG_INFO("Starting unit test run");
-  handler_.ExecuteTests(suites_to_run);
+  handler_.ExecuteTests(suites_to_run, shard_index, total_shards);
   PW_LOG_INFO("Unit test run complete");
 
   writer_.Finish().IgnoreError();  // TODO: b/242598609 - Handle Status properly
@@ -301,6 +301,23 @@ inline size_t Decode(const span<const std::byte>& input, uint64_t* value) {
   return pw_varint_Decode64(input.data(), input.size(), value);
 }
 
+/// Decodes consecutive varints, such as the contents of a packed repeated
+/// protobuf field, into `output`. Runs of single-byte varints are decoded 8 at
+/// a time.
+///
+/// Decoding stops when the input is exhausted, `output` is full, or an invalid
+/// varint is found. Compare `bytes_read` to the input size to detect the latter
+/// two cases.
+///
+/// @param[in] input The varints to decode.
+/// @param[out] output Where to store the decoded values.
+/// @param[out] bytes_read The number of bytes decoded from `input`.
+///
+/// @returns The number of values decoded.
+size_t DecodePacked(span<const std::byte> input,
+                    span<uint64_t> output,
+                    size_t* bytes_read);
+
 /// Describes a custom varint format.
 enum class Format {
   kZeroTerminatedLeastSignificant = PW_VARINT_ZERO_TERMINATED_LEAST_SIGNIFICANT,
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 namespace pw {
 namespace varint {
@@ -122,6 +123,42 @@ extern "C" size_t pw_varint_DecodeCustom(const void* input,
   return count;
 }
 
+size_t DecodePacked(span<const std::byte> input,
+                    span<uint64_t> output,
+                    size_t* bytes_read) {
+  size_t read = 0;
+  size_t decoded = 0;
+
+  while (read < input.size() && decoded < output.size()) {
+    // Packed fields often hold small values. If the next 8 bytes are all
+    // single-byte varints, widen them with a loop the compiler can vectorize.
+    if (input.size() - read >= sizeof(uint64_t) &&
+        output.size() - decoded >= sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, &input[read], sizeof(word));
+      if ((word & 0x8080808080808080u) == 0u) {
+        for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+          output[decoded + i] = static_cast<uint8_t>(input[read + i]);
+        }
+        read += sizeof(uint64_t);
+        decoded += sizeof(uint64_t);
+        continue;
+      }
+    }
+
+    const size_t bytes = pw_varint_Decode64(
+        &input[read], input.size() - read, &output[decoded]);
+    if (bytes == 0u) {
+      break;
+    }
+    read += bytes;
+    decoded += 1;
+  }
+
+  *bytes_read = read;
+  return decoded;
+}
+
 extern "C" size_t pw_varint_EncodedSizeBytes(uint64_t integer) {
   return EncodedSize(integer);
 }
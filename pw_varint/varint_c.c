@@ -14,6 +14,56 @@
 
 #include "pw_varint/varint.h"
 
+#include <string.h>
+
+// Decoding with 8-byte word loads requires a little-endian target, and is only
+// faster than the byte-at-a-time loop where 64-bit loads and bit scans are
+// cheap. Define PW_VARINT_WORD_DECODE to 0 or 1 to override the default.
+#ifndef PW_VARINT_WORD_DECODE
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && __SIZEOF_POINTER__ >= 8
+#define PW_VARINT_WORD_DECODE 1
+#else
+#define PW_VARINT_WORD_DECODE 0
+#endif
+#endif  // PW_VARINT_WORD_DECODE
+
+#if PW_VARINT_WORD_DECODE
+
+// Decodes a varint from the first 8 bytes of the buffer with a single load and
+// no per-byte branches. Returns the size of the varint, or 0 if it does not
+// terminate within 8 bytes.
+static inline size_t DecodeWord(const uint8_t* buffer, uint64_t* output) {
+  uint64_t word;
+  memcpy(&word, buffer, sizeof(word));
+
+  // The top bit of each byte is clear in the varint's last byte.
+  const uint64_t last_bytes = ~word & UINT64_C(0x8080808080808080);
+  if (last_bytes == 0u) {
+    return 0u;
+  }
+
+  const unsigned bits = (unsigned)__builtin_ctzll(last_bytes) + 1u;
+  if (bits < 64u) {
+    word &= (UINT64_C(1) << bits) - 1u;
+  }
+
+  // Drop the continuation bits and pack the 7-bit groups together: first in
+  // pairs of bytes, then pairs of 16-bit halves, then the two 32-bit halves.
+  word &= UINT64_C(0x7f7f7f7f7f7f7f7f);
+  word = ((word & UINT64_C(0x7f007f007f007f00)) >> 1) |
+         (word & UINT64_C(0x007f007f007f007f));
+  word = ((word & UINT64_C(0x3fff00003fff0000)) >> 2) |
+         (word & UINT64_C(0x00003fff00003fff));
+  word = ((word & UINT64_C(0x0fffffff00000000)) >> 4) |
+         (word & UINT64_C(0x000000000fffffff));
+
+  *output = word;
+  return bits / 8u;
+}
+
+#endif  // PW_VARINT_WORD_DECODE
+
 #define VARINT_ENCODE_FUNCTION_BODY(bits)                        \
   size_t written = 0;                                            \
   uint8_t* buffer = (uint8_t*)output;                            \
@@ -67,11 +117,31 @@ size_t pw_varint_Encode64(uint64_t integer,
 size_t pw_varint_Decode32(const void* input,
                           size_t input_size_bytes,
                           uint32_t* output) {
+#if PW_VARINT_WORD_DECODE
+  if (input_size_bytes >= sizeof(uint64_t)) {
+    uint64_t value;
+    const size_t count = DecodeWord((const uint8_t*)input, &value);
+    if (count == 0u || count > PW_VARINT_MAX_INT32_SIZE_BYTES) {
+      return 0u;
+    }
+    *output = (uint32_t)value;
+    return count;
+  }
+#endif  // PW_VARINT_WORD_DECODE
   VARINT_DECODE_FUNCTION_BODY(32);
 }
 
 size_t pw_varint_Decode64(const void* input,
                           size_t input_size_bytes,
                           uint64_t* output) {
+#if PW_VARINT_WORD_DECODE
+  if (input_size_bytes >= sizeof(uint64_t)) {
+    const size_t count = DecodeWord((const uint8_t*)input, output);
+    if (count != 0u) {
+      return count;
+    }
+    // 9- and 10-byte varints fall back to the loop below.
+  }
+#endif  // PW_VARINT_WORD_DECODE
   VARINT_DECODE_FUNCTION_BODY(64);
 }
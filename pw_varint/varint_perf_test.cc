@@ -0,0 +1,112 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+#include "pw_varint/varint.h"
+
+namespace pw::varint {
+namespace {
+
+// Encodes a value at the start of a buffer with room for word loads.
+std::array<std::byte, 16> EncodedValue(uint64_t value) {
+  std::array<std::byte, 16> buffer{};
+  Encode(value, buffer);
+  return buffer;
+}
+
+void EncodeTest(perf_test::State& state, uint64_t value) {
+  std::byte buffer[kMaxVarint64SizeBytes];
+  while (state.KeepRunning()) {
+    Encode(value, span(buffer));
+  }
+}
+
+void DecodeTest(perf_test::State& state, uint64_t value) {
+  const std::array<std::byte, 16> buffer = EncodedValue(value);
+  uint64_t decoded;
+  while (state.KeepRunning()) {
+    Decode(buffer, &decoded);
+  }
+}
+
+// Decodes a varint from a buffer that ends with it, so every byte is read one
+// at a time.
+void DecodeExactSizeTest(perf_test::State& state, uint64_t value) {
+  const std::array<std::byte, 16> buffer = EncodedValue(value);
+  const span<const std::byte> input =
+      span(buffer).first(pw_varint_EncodedSizeBytes(value));
+  uint64_t decoded;
+  while (state.KeepRunning()) {
+    Decode(input, &decoded);
+  }
+}
+
+// Decodes 64 varints, each of which is `value`, one at a time or in bulk.
+std::array<std::byte, 64 * kMaxVarint64SizeBytes> EncodedValues(
+    uint64_t value, size_t& size) {
+  std::array<std::byte, 64 * kMaxVarint64SizeBytes> buffer{};
+  size = 0;
+  for (size_t i = 0; i < 64; ++i) {
+    size += Encode(value, span(buffer).subspan(size));
+  }
+  return buffer;
+}
+
+void DecodeLoopTest(perf_test::State& state, uint64_t value) {
+  size_t size;
+  const auto buffer = EncodedValues(value, size);
+  uint64_t decoded;
+  while (state.KeepRunning()) {
+    span<const std::byte> input = span(buffer).first(size);
+    while (!input.empty()) {
+      input = input.subspan(Decode(input, &decoded));
+    }
+  }
+}
+
+void DecodePackedTest(perf_test::State& state, uint64_t value) {
+  size_t size;
+  const auto buffer = EncodedValues(value, size);
+  std::array<uint64_t, 64> decoded;
+  size_t bytes_read;
+  while (state.KeepRunning()) {
+    DecodePacked(span(buffer).first(size), decoded, &bytes_read);
+  }
+}
+
+PW_PERF_TEST(EncodeOneByte, EncodeTest, 100);
+PW_PERF_TEST(EncodeFourBytes, EncodeTest, 200000000);
+PW_PERF_TEST(EncodeTenBytes, EncodeTest, UINT64_MAX);
+
+PW_PERF_TEST(DecodeOneByte, DecodeTest, 100);
+PW_PERF_TEST(DecodeFourBytes, DecodeTest, 200000000);
+PW_PERF_TEST(DecodeEightBytes, DecodeTest, MaxValueInBytes(8));
+PW_PERF_TEST(DecodeTenBytes, DecodeTest, UINT64_MAX);
+
+PW_PERF_TEST(DecodeExactSizeOneByte, DecodeExactSizeTest, 100);
+PW_PERF_TEST(DecodeExactSizeFourBytes, DecodeExactSizeTest, 200000000);
+
+PW_PERF_TEST(DecodeLoopOneByte, DecodeLoopTest, 100);
+PW_PERF_TEST(DecodeLoopFourBytes, DecodeLoopTest, 200000000);
+PW_PERF_TEST(DecodePackedOneByte, DecodePackedTest, 100);
+PW_PERF_TEST(DecodePackedFourBytes, DecodePackedTest, 200000000);
+
+}  // namespace
+}  // namespace pw::varint
@@ -14,6 +14,7 @@
 
 #include "pw_varint/varint.h"
 
+#include <array>
 #include <cinttypes>
 #include <cstdint>
 #include <cstring>
@@ -729,6 +730,122 @@ TEST(VarintDecode, DecodeSigned64_MultiByte_C) {
   EXPECT_EQ(value, std::numeric_limits<int64_t>::max());
 }
 
+// Decodes each value from the start of a larger buffer, so the decoder reads
+// whole words rather than single bytes.
+template <typename T>
+void EncodeDecodePadded(T value) {
+  for (size_t padding = 0; padding <= sizeof(uint64_t); ++padding) {
+    std::array<std::byte, kMaxVarint64SizeBytes + sizeof(uint64_t)> buffer;
+    std::memset(buffer.data(), 0xff, buffer.size());
+    const size_t encoded = Encode(value, buffer);
+    ASSERT_GT(encoded, 0u);
+
+    T result;
+    EXPECT_EQ(Decode(span(buffer).first(encoded + padding), &result), encoded);
+    EXPECT_EQ(result, value);
+  }
+}
+
+TEST(VarintDecode, DecodeUnsigned64_Padded) {
+  for (size_t bytes = 0; bytes < kMaxVarint64SizeBytes; ++bytes) {
+    EncodeDecodePadded<uint64_t>(MaxValueInBytes(bytes));
+    EncodeDecodePadded<uint64_t>(MaxValueInBytes(bytes) + 1);
+  }
+  EncodeDecodePadded<uint64_t>(std::numeric_limits<uint64_t>::max());
+}
+
+TEST(VarintDecode, DecodeSigned64_Padded) {
+  EncodeDecodePadded<int64_t>(0);
+  EncodeDecodePadded<int64_t>(-65);
+  EncodeDecodePadded<int64_t>(std::numeric_limits<int32_t>::min());
+  EncodeDecodePadded<int64_t>(std::numeric_limits<int64_t>::min());
+  EncodeDecodePadded<int64_t>(std::numeric_limits<int64_t>::max());
+}
+
+TEST(VarintDecode, DecodeUnsigned32_Padded_C) {
+  std::array<std::byte, 16> buffer;
+  std::memset(buffer.data(), 0, buffer.size());
+  uint32_t value = 0;
+
+  ASSERT_EQ(pw_varint_Encode32(
+                std::numeric_limits<uint32_t>::max(), buffer.data(), 5),
+            5u);
+  EXPECT_EQ(pw_varint_CallDecode32(buffer.data(), buffer.size(), &value), 5u);
+  EXPECT_EQ(value, std::numeric_limits<uint32_t>::max());
+
+  // A 6-byte varint does not fit in a uint32_t.
+  buffer[4] |= std::byte{0x80};
+  value = 1234;
+  EXPECT_EQ(pw_varint_CallDecode32(buffer.data(), buffer.size(), &value), 0u);
+  EXPECT_EQ(value, 1234u);
+}
+
+TEST(VarintDecode, DecodeUnsigned64_Unterminated) {
+  std::array<std::byte, 16> buffer;
+  std::memset(buffer.data(), 0x80, buffer.size());
+  uint64_t value = 1234;
+
+  EXPECT_EQ(Decode(buffer, &value), 0u);
+  EXPECT_EQ(Decode(span(buffer).first(9), &value), 0u);
+  EXPECT_EQ(Decode(span(buffer).first(8), &value), 0u);
+  EXPECT_EQ(value, 1234u);
+}
+
+TEST(VarintDecodePacked, SingleByteValues) {
+  std::array<std::byte, 19> input;
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<std::byte>(i * 5);
+  }
+
+  std::array<uint64_t, 32> output{};
+  size_t bytes_read = 0;
+  ASSERT_EQ(DecodePacked(input, output, &bytes_read), input.size());
+  EXPECT_EQ(bytes_read, input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(output[i], i * 5);
+  }
+}
+
+TEST(VarintDecodePacked, MixedSizeValues) {
+  constexpr uint64_t kValues[] = {
+      1, 2, 300, 4, 5, 6, 7, 8, 9, 10, 11, 12, 1u << 20, 14, 15, 16, 17, 18,
+      std::numeric_limits<uint64_t>::max(), 0};
+
+  std::array<std::byte, 64> input;
+  size_t size = 0;
+  for (uint64_t value : kValues) {
+    size += Encode(value, span(input).subspan(size));
+  }
+
+  std::array<uint64_t, std::size(kValues)> output{};
+  size_t bytes_read = 0;
+  ASSERT_EQ(DecodePacked(span(input).first(size), output, &bytes_read),
+            std::size(kValues));
+  EXPECT_EQ(bytes_read, size);
+  for (size_t i = 0; i < std::size(kValues); ++i) {
+    EXPECT_EQ(output[i], kValues[i]);
+  }
+}
+
+TEST(VarintDecodePacked, OutputFull) {
+  std::array<std::byte, 12> input{};
+  std::array<uint64_t, 10> output{};
+  size_t bytes_read = 0;
+  EXPECT_EQ(DecodePacked(input, output, &bytes_read), output.size());
+  EXPECT_EQ(bytes_read, output.size());
+}
+
+TEST(VarintDecodePacked, InvalidVarint) {
+  std::array<std::byte, 12> input{};
+  input[10] = std::byte{0x80};
+  input[11] = std::byte{0x80};
+
+  std::array<uint64_t, 16> output{};
+  size_t bytes_read = 0;
+  EXPECT_EQ(DecodePacked(input, output, &bytes_read), 10u);
+  EXPECT_EQ(bytes_read, 10u);
+}
+
 TEST(Varint, ZigZagEncode_Int8) {
   EXPECT_EQ(ZigZagEncode(int8_t(0)), uint8_t(0));
   EXPECT_EQ(ZigZagEncode(int8_t(-1)), uint8_t(1));
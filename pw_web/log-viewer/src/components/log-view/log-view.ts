@@ -103,6 +103,12 @@ export class LogView extends LitElement {
   /** The number of elements in the `logs` array since last updated. */
   private _lastKnownLogLength: number = 0;
 
+  /**
+   * The first element in the `logs` array since last updated. If it changes,
+   * older logs were discarded and the `logs` array is processed again.
+   */
+  private _firstKnownLog: LogEntry | undefined = undefined;
+
   /** The amount of time, in ms, before the filter expression is executed. */
   private readonly FILTER_DELAY = 100;
 
@@ -130,15 +136,32 @@ export class LogView extends LitElement {
   updated(changedProperties: PropertyValues) {
     super.updated(changedProperties);
 
+    let refilter = changedProperties.has('searchText');
+
     if (changedProperties.has('logs')) {
-      const newLogs = this.logs.slice(this._lastKnownLogLength);
+      // Logs usually only get appended, so only the new logs need to be
+      // processed. Otherwise, process all of them again.
+      const appended =
+        this._lastKnownLogLength > 0 &&
+        this.logs.length >= this._lastKnownLogLength &&
+        this.logs[0] === this._firstKnownLog;
+      const newLogs = appended
+        ? this.logs.slice(this._lastKnownLogLength)
+        : this.logs;
       this._lastKnownLogLength = this.logs.length;
+      this._firstKnownLog = this.logs[0];
 
       this.updateFieldsFromNewLogs(newLogs);
       this.updateTitle();
+
+      if (appended && !refilter) {
+        this.filterNewLogs(newLogs);
+      } else {
+        refilter = true;
+      }
     }
 
-    if (changedProperties.has('logs') || changedProperties.has('searchText')) {
+    if (refilter) {
       this.filterLogs();
     }
 
@@ -280,20 +303,43 @@ export class LogView extends LitElement {
     this._lineWrap = !this._lineWrap;
   }
 
+  /** Whether a log entry passes all of the current filters. */
+  private combinedFilter(logEntry: LogEntry): boolean {
+    return this._timeFilter(logEntry) && this._stringFilter(logEntry);
+  }
+
   /**
    * Combines filter expressions and filters the logs. The filtered
    * logs are stored in the `_filteredLogs` property.
    */
   private filterLogs() {
-    const combinedFilter = (logEntry: LogEntry) =>
-      this._timeFilter(logEntry) && this._stringFilter(logEntry);
-
-    const newFilteredLogs = this.logs.filter(combinedFilter);
+    const newFilteredLogs = this.logs.filter((logEntry) =>
+      this.combinedFilter(logEntry),
+    );
 
-    if (
-      JSON.stringify(newFilteredLogs) !== JSON.stringify(this._filteredLogs)
-    ) {
+    const unchanged =
+      newFilteredLogs.length === this._filteredLogs.length &&
+      newFilteredLogs.every((log, i) => log === this._filteredLogs[i]);
+    if (!unchanged) {
       this._filteredLogs = newFilteredLogs;
+      this.requestUpdate();
+    }
+  }
+
+  /**
+   * Filters logs that were appended to the `logs` array since it was last
+   * filtered, and appends the matching logs to `_filteredLogs`.
+   *
+   * @param {LogEntry[]} newLogs - The appended logs.
+   */
+  private filterNewLogs(newLogs: LogEntry[]) {
+    const newFilteredLogs = newLogs.filter((logEntry) =>
+      this.combinedFilter(logEntry),
+    );
+
+    if (newFilteredLogs.length > 0) {
+      this._filteredLogs = this._filteredLogs.concat(newFilteredLogs);
+      this.requestUpdate();
     }
   }
 
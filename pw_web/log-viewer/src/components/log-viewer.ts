@@ -59,6 +59,12 @@ export class LogViewer extends LitElement {
   /** A map containing data from present log sources */
   private _sources: Map<string, SourceData> = new Map();
 
+  /** The number of elements in the `logs` array since last updated. */
+  private _lastKnownLogLength = 0;
+
+  /** The first element in the `logs` array since last updated. */
+  private _firstKnownLog: LogEntry | undefined = undefined;
+
   private _state: State;
 
   constructor(state: StateStore = new LocalStorageState()) {
@@ -112,11 +118,21 @@ export class LogViewer extends LitElement {
     }
 
     if (changedProperties.has('logs')) {
-      this.logs.forEach((logEntry) => {
+      // Only look for sources in logs appended since the last update, unless
+      // older logs were discarded.
+      const appended =
+        this.logs.length >= this._lastKnownLogLength &&
+        this.logs[0] === this._firstKnownLog;
+      const start = appended ? this._lastKnownLogLength : 0;
+      this._lastKnownLogLength = this.logs.length;
+      this._firstKnownLog = this.logs[0];
+
+      for (let i = start; i < this.logs.length; i++) {
+        const logEntry = this.logs[i];
         if (logEntry.sourceData && !this._sources.has(logEntry.sourceData.id)) {
           this._sources.set(logEntry.sourceData.id, logEntry.sourceData);
         }
-      });
+      }
     }
   }
 
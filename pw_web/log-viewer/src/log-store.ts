@@ -15,15 +15,34 @@
 import { LogEntry } from './shared/interfaces';
 import { titleCaseToKebabCase } from './utils/strings';
 
+/**
+ * Stores the most recent log entries. Once more than `maxLogs` entries are
+ * stored, the oldest entries are discarded in batches, so that discarding does
+ * not copy the array on every new entry.
+ */
 export class LogStore {
+  /** The number of log entries kept if no limit is given. */
+  static readonly DEFAULT_MAX_LOGS = 100_000;
+
   private logs: LogEntry[];
 
-  constructor() {
+  private readonly maxLogs: number;
+
+  /** The number of entries over `maxLogs` allowed before discarding. */
+  private readonly overflow: number;
+
+  constructor(maxLogs: number = LogStore.DEFAULT_MAX_LOGS) {
     this.logs = [];
+    this.maxLogs = maxLogs;
+    this.overflow = Math.max(1, Math.floor(maxLogs / 10));
   }
 
   addLogEntry(logEntry: LogEntry) {
     this.logs.push(logEntry);
+
+    if (this.logs.length >= this.maxLogs + this.overflow) {
+      this.logs = this.logs.slice(this.logs.length - this.maxLogs);
+    }
   }
 
   downloadLogs(event: CustomEvent) {
@@ -130,7 +130,8 @@ export class LogFilter {
   /**
    * Takes a condition node, which represents a specific filter condition, and
    * recursively generates a filter function that can be applied to log
-   * entries.
+   * entries. Regular expressions are compiled once here rather than for each
+   * entry, since filters run on every stored entry.
    *
    * @param {FilterCondition} condition - A filter condition to convert to a
    *   function.
@@ -141,15 +142,28 @@ export class LogFilter {
     condition: FilterCondition,
   ): (logEntry: LogEntry) => boolean {
     switch (condition.type) {
-      case ConditionType.StringSearch:
-        return (logEntry) =>
-          this.checkStringInColumns(logEntry, condition.searchString);
-      case ConditionType.ExactPhraseSearch:
-        return (logEntry) =>
-          this.checkExactPhraseInColumns(logEntry, condition.exactPhrase);
-      case ConditionType.ColumnSearch:
+      case ConditionType.StringSearch: {
+        const searchRegex = new RegExp(
+          this.escapeRegEx(condition.searchString),
+          'i',
+        );
+        return (logEntry) => this.checkRegExInColumns(logEntry, searchRegex);
+      }
+      case ConditionType.ExactPhraseSearch: {
+        const searchRegex = new RegExp(
+          this.escapeRegEx(condition.exactPhrase),
+          'i',
+        );
+        return (logEntry) => this.checkRegExInColumns(logEntry, searchRegex);
+      }
+      case ConditionType.ColumnSearch: {
+        const valueRegex =
+          condition.value === undefined
+            ? undefined
+            : new RegExp(condition.value, 'i');
         return (logEntry) =>
-          this.checkColumn(logEntry, condition.column, condition.value);
+          this.checkColumn(logEntry, condition.column, valueRegex);
+      }
       case ConditionType.NotExpression: {
         const innerFilter = this.createFilterFunction(condition.expression);
         return (logEntry) => !innerFilter(logEntry);
@@ -179,72 +193,44 @@ export class LogFilter {
    * @param {LogEntry} logEntry - The log entry to be searched.
    * @param {string} column - The name of the column (log entry field) to be
    *   checked for filtering.
-   * @param {string} value - An optional string that represents the value used
-   *   for filtering.
+   * @param {RegExp} valueRegex - An optional case-insensitive expression
+   *   that represents the value used for filtering.
    * @returns {boolean} True if the specified column exists in the log entry,
    *   or if a value is provided, returns true if the value matches a
-   *   substring of the column's value (case-insensitive).
+   *   substring of the column's value.
    */
   private static checkColumn(
     logEntry: LogEntry,
     column: string,
-    value?: string,
+    valueRegex?: RegExp,
   ): boolean {
     const field = logEntry.fields.find((field) => field.key === column);
     if (!field) return false;
 
-    if (value === undefined) {
+    if (valueRegex === undefined) {
       return true;
     }
 
-    const searchRegex = new RegExp(value, 'i');
-    return searchRegex.test(field.value.toString());
-  }
-
-  /**
-   * Checks if the provided search string exists in any of the log entry
-   * columns (excluding `severity`).
-   *
-   * @param {LogEntry} logEntry - The log entry to be searched.
-   * @param {string} searchString - The search string to be matched against
-   *   the log entry fields.
-   * @returns {boolean} True if the search string is found in any of the log
-   *   entry fields, otherwise false.
-   */
-  private static checkStringInColumns(
-    logEntry: LogEntry,
-    searchString: string,
-  ): boolean {
-    const escapedSearchString = this.escapeRegEx(searchString);
-    const columnsToSearch = logEntry.fields.filter(
-      (field) => field.key !== 'severity',
-    );
-    return columnsToSearch.some((field) =>
-      new RegExp(escapedSearchString, 'i').test(field.value.toString()),
-    );
+    return valueRegex.test(field.value.toString());
   }
 
   /**
-   * Checks if the exact phrase exists in any of the log entry columns
-   * (excluding `severity`).
+   * Checks if the provided expression matches any of the log entry columns
+   * (excluding `severity`). Used for both string and exact phrase searches.
    *
    * @param {LogEntry} logEntry - The log entry to be searched.
-   * @param {string} exactPhrase - The exact phrase to search for within the
-   *   log entry columns.
-   * @returns {boolean} True if the exact phrase is found in any column,
-   *   otherwise false.
+   * @param {RegExp} searchRegex - The case-insensitive expression to be
+   *   matched against the log entry fields.
+   * @returns {boolean} True if the expression matches any of the log entry
+   *   fields, otherwise false.
    */
-  private static checkExactPhraseInColumns(
+  private static checkRegExInColumns(
     logEntry: LogEntry,
-    exactPhrase: string,
+    searchRegex: RegExp,
   ): boolean {
-    const escapedExactPhrase = this.escapeRegEx(exactPhrase);
-    const searchRegex = new RegExp(escapedExactPhrase, 'i');
-    const columnsToSearch = logEntry.fields.filter(
-      (field) => field.key !== 'severity',
-    );
-    return columnsToSearch.some((field) =>
-      searchRegex.test(field.value.toString()),
+    return logEntry.fields.some(
+      (field) =>
+        field.key !== 'severity' && searchRegex.test(field.value.toString()),
     );
   }
 
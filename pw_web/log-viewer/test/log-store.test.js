@@ -75,4 +75,19 @@ describe('log-store', () => {
     expect(logs.length).equal(1);
     expect(logs[0]).equal(logEntry);
   });
+
+  it('should discard the oldest log entries beyond the maximum', () => {
+    const boundedLogStore = new LogStore(10);
+    const logEntries = [];
+    for (let i = 0; i < 25; i++) {
+      const logEntry = mockLogSource.readLogEntryFromHost();
+      logEntries.push(logEntry);
+      boundedLogStore.addLogEntry(logEntry);
+    }
+    const logs = boundedLogStore.getLogs();
+
+    expect(logs.length).equal(10);
+    expect(logs[0]).equal(logEntries[15]);
+    expect(logs[9]).equal(logEntries[24]);
+  });
 });
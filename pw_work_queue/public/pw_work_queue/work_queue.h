@@ -14,17 +14,23 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <mutex>
+#include <optional>
 
+#include "pw_assert/check.h"
+#include "pw_chrono/system_clock.h"
 #include "pw_containers/inline_queue.h"
+#include "pw_containers/vector.h"
 #include "pw_function/function.h"
 #include "pw_metric/metric.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_sync/interrupt_spin_lock.h"
 #include "pw_sync/lock_annotations.h"
-#include "pw_sync/thread_notification.h"
+#include "pw_sync/timed_thread_notification.h"
 #include "pw_thread/thread_core.h"
 
 namespace pw::work_queue {
@@ -34,29 +40,85 @@ using WorkItem = Function<void()>;
 /// Enables threads and interrupts to enqueue work as a
 /// `pw::work_queue::WorkItem` for execution by the work queue.
 ///
+/// `WorkQueue` stores work items that can hold callables of up to
+/// `PW_FUNCTION_INLINE_CALLABLE_SIZE` bytes. `BasicWorkQueue` instead sets the
+/// inline callable size of each work item, so that a queue of small work items
+/// can use compact slots while another queue accepts larger captures. Use the
+/// `kInlineCallableSize` parameter of `pw::work_queue::WorkQueueWithBuffer` to
+/// declare one.
+///
 /// **Queue sizing**: The number of outstanding work requests is limited
 /// based on the internal queue size. The queue size is set through either
 /// the size of the `queue_storage` buffer passed into the constructor or by
 /// using the templated `pw::work_queue::WorkQueueWithBuffer` helper. When the
 /// queue is full, the queue will not accept further work.
 ///
+/// **Delayed and periodic work**: Work may also be scheduled to run at a
+/// deadline with `PushWorkAt()` or repeatedly with `PushWorkEvery()`. These
+/// work items are kept in a min-heap ordered by deadline, and the work queue
+/// thread waits until the earliest deadline instead of using a timer per work
+/// item. The number of scheduled work items is limited by the size of the
+/// `timed_storage` buffer passed into the constructor or the
+/// `kTimedWorkQueueEntries` parameter of `pw::work_queue::WorkQueueWithBuffer`.
+/// Delayed work runs no earlier than its deadline, but may run later if the
+/// work queue is busy.
+///
 /// **Cooperative thread cancellation**: The class is a
 /// `pw::thread::ThreadCore`, meaning it should be executed as a single thread.
 /// To facilitate clean shutdown, it provides a `RequestStop()` method for
 /// cooperative cancellation which should be invoked before joining the thread.
 /// Once a stop has been requested the queue will no longer accept further work.
+/// Delayed and periodic work that is not yet due when stopping is discarded.
 ///
 /// The entire API is thread-safe and interrupt-safe.
-class WorkQueue : public thread::ThreadCore {
+template <size_t kInlineCallableSize>
+class BasicWorkQueue : public thread::ThreadCore {
  public:
+  /// The work item type, which stores callables of up to
+  /// `kInlineCallableSize` bytes inline.
+  using WorkItem = Function<void(), kInlineCallableSize>;
+
+  /// Storage for a delayed or periodic work item.
+  class TimedWorkItem {
+   public:
+    TimedWorkItem(chrono::SystemClock::time_point deadline,
+                  chrono::SystemClock::duration period,
+                  WorkItem&& work_item)
+        : deadline_(deadline),
+          period_(period),
+          work_item_(std::move(work_item)) {}
+
+   private:
+    friend class BasicWorkQueue;
+
+    chrono::SystemClock::time_point deadline_;
+    chrono::SystemClock::duration period_;  // Zero if not periodic.
+    WorkItem work_item_;
+  };
+
   /// @param[in] queue The work entries to enqueue.
   ///
   /// @param[in] queue_capacity The internal queue size which limits the number
   /// of outstanding work requests.
   ///
   /// @note The `ThreadNotification` prevents this from being `constexpr`.
-  WorkQueue(InlineQueue<WorkItem>& queue, size_t queue_capacity)
-      : stop_requested_(false), queue_(queue) {
+  BasicWorkQueue(InlineQueue<WorkItem>& queue, size_t queue_capacity)
+      : BasicWorkQueue(queue, queue_capacity, no_timed_storage_) {}
+
+  /// @param[in] queue The work entries to enqueue.
+  ///
+  /// @param[in] queue_capacity The internal queue size which limits the number
+  /// of outstanding work requests.
+  ///
+  /// @param[in] timed_storage Storage for delayed and periodic work items,
+  /// which limits how many may be scheduled at once.
+  BasicWorkQueue(InlineQueue<WorkItem>& queue,
+                 size_t queue_capacity,
+                 Vector<TimedWorkItem>& timed_storage)
+      : stop_requested_(false),
+        timed_work_running_(false),
+        queue_(queue),
+        timed_queue_(timed_storage) {
     min_queue_remaining_.Set(static_cast<uint32_t>(queue_capacity));
   }
 
@@ -89,22 +151,90 @@ class WorkQueue : public thread::ThreadCore {
   ///   not be in the process of shutting down.
   void CheckPushWork(WorkItem&& work_item) PW_LOCKS_EXCLUDED(lock_);
 
+  /// Schedules a `work_item` to be executed by the work queue thread once
+  /// `deadline` has been reached.
+  ///
+  /// @param[in] deadline The earliest time at which to run the entry.
+  ///
+  /// @param[in] work_item The entry to schedule.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - Success. Entry was scheduled for execution.
+  /// * @pw_status{FAILED_PRECONDITION} - The work queue is shutting down.
+  ///   Entries are no longer permitted.
+  /// * @pw_status{RESOURCE_EXHAUSTED} - The timed work storage is full.
+  ///   Entry was not scheduled.
+  Status PushWorkAt(chrono::SystemClock::time_point deadline,
+                    WorkItem&& work_item) PW_LOCKS_EXCLUDED(lock_) {
+    return InternalPushTimedWork(
+        deadline, chrono::SystemClock::duration::zero(), std::move(work_item));
+  }
+
+  /// Schedules a `work_item` to be executed by the work queue thread once
+  /// every `period`, starting one `period` from now. The work item remains
+  /// scheduled until the work queue is stopped.
+  ///
+  /// Deadlines advance by exactly `period` so that the work item does not
+  /// drift. If the work item falls more than a `period` behind, the missed
+  /// runs are skipped rather than run back to back.
+  ///
+  /// @param[in] period The interval between runs; must be positive.
+  ///
+  /// @param[in] work_item The entry to schedule.
+  ///
+  /// @returns
+  /// * @pw_status{OK} - Success. Entry was scheduled for execution.
+  /// * @pw_status{INVALID_ARGUMENT} - The period is not positive.
+  /// * @pw_status{FAILED_PRECONDITION} - The work queue is shutting down.
+  ///   Entries are no longer permitted.
+  /// * @pw_status{RESOURCE_EXHAUSTED} - The timed work storage is full.
+  ///   Entry was not scheduled.
+  Status PushWorkEvery(chrono::SystemClock::duration period,
+                       WorkItem&& work_item) PW_LOCKS_EXCLUDED(lock_);
+
   /// Locks the queue to prevent further work enqueing, finishes outstanding
   /// work, then shuts down the worker thread.
   ///
-  /// The `WorkQueue` cannot be resumed after stopping because the `ThreadCore`
-  /// thread returns and may be joined. The `WorkQueue` must be reconstructed
+  /// The work queue cannot be resumed after stopping because the `ThreadCore`
+  /// thread returns and may be joined. The work queue must be reconstructed
   /// for re-use after the thread has been joined.
   void RequestStop() PW_LOCKS_EXCLUDED(lock_);
 
  private:
   void Run() override PW_LOCKS_EXCLUDED(lock_);
   Status InternalPushWork(WorkItem&& work_item) PW_LOCKS_EXCLUDED(lock_);
+  Status InternalPushTimedWork(chrono::SystemClock::time_point deadline,
+                               chrono::SystemClock::duration period,
+                               WorkItem&& work_item) PW_LOCKS_EXCLUDED(lock_);
+
+  // Blocks until work may be available or the earliest deadline is reached.
+  void WaitForWork() PW_LOCKS_EXCLUDED(lock_);
+
+  // Removes the next work item to run, if any, preferring due timed work over
+  // immediate work so that periodic work keeps its deadlines.
+  std::optional<TimedWorkItem> TakeWork(chrono::SystemClock::time_point now)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  bool TimedWorkDue(chrono::SystemClock::time_point now) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Orders the heap so that the earliest deadline is at the front.
+  static bool LaterDeadline(const TimedWorkItem& lhs,
+                            const TimedWorkItem& rhs) {
+    return lhs.deadline_ > rhs.deadline_;
+  }
 
   sync::InterruptSpinLock lock_;
   bool stop_requested_ PW_GUARDED_BY(lock_);
+  // Set while a periodic work item runs outside of timed_queue_, reserving its
+  // slot for when it is rescheduled.
+  bool timed_work_running_ PW_GUARDED_BY(lock_);
   InlineQueue<WorkItem>& queue_ PW_GUARDED_BY(lock_);
-  sync::ThreadNotification work_notification_;
+  Vector<TimedWorkItem>& timed_queue_ PW_GUARDED_BY(lock_);
+  sync::TimedThreadNotification work_notification_;
+
+  // Used when no timed work storage is provided.
+  Vector<TimedWorkItem, 0> no_timed_storage_;
 
   // TODO(ewout): The group and/or its name token should be passed as a ctor
   // arg instead. Depending on the approach here the group should be exposed
@@ -118,13 +248,222 @@ class WorkQueue : public thread::ThreadCore {
   PW_METRIC(metrics_, min_queue_remaining_, "min_queue_remaining", 0u);
 };
 
-template <size_t kWorkQueueEntries>
-class WorkQueueWithBuffer : public WorkQueue {
+/// A work queue of `pw::work_queue::WorkItem`s.
+using WorkQueue =
+    BasicWorkQueue<function_internal::config::kInlineCallableSize>;
+
+/// A work queue with storage for `kWorkQueueEntries` work items and
+/// `kTimedWorkQueueEntries` delayed or periodic work items, each of which can
+/// store a callable of up to `kInlineCallableSize` bytes inline.
+template <size_t kWorkQueueEntries,
+          size_t kTimedWorkQueueEntries = 0,
+          size_t kInlineCallableSize =
+              function_internal::config::kInlineCallableSize>
+class WorkQueueWithBuffer : public BasicWorkQueue<kInlineCallableSize> {
+ private:
+  using Base = BasicWorkQueue<kInlineCallableSize>;
+
  public:
-  constexpr WorkQueueWithBuffer() : WorkQueue(queue_, kWorkQueueEntries) {}
+  constexpr WorkQueueWithBuffer()
+      : Base(queue_, kWorkQueueEntries, timed_queue_) {}
 
  private:
-  InlineQueue<WorkItem, kWorkQueueEntries> queue_;
+  InlineQueue<typename Base::WorkItem, kWorkQueueEntries> queue_;
+  Vector<typename Base::TimedWorkItem, kTimedWorkQueueEntries> timed_queue_;
 };
 
+// Template method implementations.
+
+template <size_t kInlineCallableSize>
+void BasicWorkQueue<kInlineCallableSize>::RequestStop() {
+  {
+    std::lock_guard lock(lock_);
+    stop_requested_ = true;
+  }  // Release lock before calling .release() on the semaphore.
+  work_notification_.release();
+}
+
+template <size_t kInlineCallableSize>
+void BasicWorkQueue<kInlineCallableSize>::Run() {
+  while (true) {
+    WaitForWork();
+
+    // Drain the work queue and any timed work that is due.
+    bool stop_requested;
+    bool work_remaining;
+    do {
+      const chrono::SystemClock::time_point now = chrono::SystemClock::now();
+      std::optional<TimedWorkItem> possible_work_item;
+      {
+        std::lock_guard lock(lock_);
+        possible_work_item = TakeWork(now);
+        work_remaining = !queue_.empty() || TimedWorkDue(now);
+        stop_requested = stop_requested_;
+      }
+      if (!possible_work_item.has_value()) {
+        continue;  // No work item to process.
+      }
+      TimedWorkItem& work_item = possible_work_item.value();
+      PW_CHECK(work_item.work_item_ != nullptr);
+      work_item.work_item_();
+
+      if (work_item.period_ == chrono::SystemClock::duration::zero()) {
+        continue;  // Not periodic.
+      }
+      // Reschedule the periodic work item, skipping any missed periods.
+      work_item.deadline_ += work_item.period_;
+      const chrono::SystemClock::time_point finished =
+          chrono::SystemClock::now();
+      if (work_item.deadline_ <= finished) {
+        const auto periods_behind =
+            (finished - work_item.deadline_) / work_item.period_ + 1;
+        work_item.deadline_ += work_item.period_ * periods_behind;
+      }
+      std::lock_guard lock(lock_);
+      timed_work_running_ = false;
+      if (!stop_requested_) {
+        timed_queue_.push_back(std::move(work_item));
+        std::push_heap(timed_queue_.begin(), timed_queue_.end(), LaterDeadline);
+        work_remaining = work_remaining || TimedWorkDue(finished);
+      }
+    } while (work_remaining);
+
+    // Queue was drained, return if we've been requested to stop.
+    if (stop_requested) {
+      std::lock_guard lock(lock_);
+      timed_queue_.clear();  // Discard timed work that is not yet due.
+      return;
+    }
+  }
+}
+
+template <size_t kInlineCallableSize>
+void BasicWorkQueue<kInlineCallableSize>::WaitForWork() {
+  std::optional<chrono::SystemClock::time_point> deadline;
+  {
+    std::lock_guard lock(lock_);
+    if (!timed_queue_.empty()) {
+      deadline = timed_queue_.front().deadline_;
+    }
+  }
+  if (deadline.has_value()) {
+    // Returns early if notified, e.g. when earlier timed work is pushed.
+    work_notification_.try_acquire_until(*deadline);
+  } else {
+    work_notification_.acquire();
+  }
+}
+
+template <size_t kInlineCallableSize>
+std::optional<typename BasicWorkQueue<kInlineCallableSize>::TimedWorkItem>
+BasicWorkQueue<kInlineCallableSize>::TakeWork(
+    chrono::SystemClock::time_point now) {
+  std::optional<TimedWorkItem> work_item;
+  if (TimedWorkDue(now)) {
+    std::pop_heap(timed_queue_.begin(), timed_queue_.end(), LaterDeadline);
+    work_item.emplace(std::move(timed_queue_.back()));
+    timed_queue_.pop_back();
+    if (work_item->period_ != chrono::SystemClock::duration::zero()) {
+      timed_work_running_ = true;
+    }
+  } else if (!queue_.empty()) {
+    work_item.emplace(chrono::SystemClock::time_point(),
+                      chrono::SystemClock::duration::zero(),
+                      std::move(queue_.front()));
+    queue_.pop();
+  }
+  return work_item;
+}
+
+template <size_t kInlineCallableSize>
+bool BasicWorkQueue<kInlineCallableSize>::TimedWorkDue(
+    chrono::SystemClock::time_point now) const {
+  return !timed_queue_.empty() && timed_queue_.front().deadline_ <= now;
+}
+
+template <size_t kInlineCallableSize>
+void BasicWorkQueue<kInlineCallableSize>::CheckPushWork(
+    WorkItem&& work_item) {
+  PW_CHECK_OK(InternalPushWork(std::move(work_item)),
+              "Failed to push work item into the work queue");
+}
+
+template <size_t kInlineCallableSize>
+Status BasicWorkQueue<kInlineCallableSize>::InternalPushWork(
+    WorkItem&& work_item) {
+  {
+    std::lock_guard lock(lock_);
+
+    if (stop_requested_) {
+      // Entries are not permitted to be enqueued once stop has been requested.
+      return Status::FailedPrecondition();
+    }
+
+    if (queue_.full()) {
+      return Status::ResourceExhausted();
+    }
+
+    queue_.emplace(std::move(work_item));
+
+    // Update the watermarks for the queue.
+    const uint32_t queue_entries = queue_.size();
+    if (queue_entries > max_queue_used_.value()) {
+      max_queue_used_.Set(queue_entries);
+    }
+    const uint32_t queue_remaining = queue_.capacity() - queue_entries;
+    if (queue_remaining < min_queue_remaining_.value()) {
+      min_queue_remaining_.Set(queue_entries);
+    }
+  }  // Release lock before calling .release() on the semaphore.
+  work_notification_.release();
+  return OkStatus();
+}
+
+template <size_t kInlineCallableSize>
+Status BasicWorkQueue<kInlineCallableSize>::PushWorkEvery(
+    chrono::SystemClock::duration period, WorkItem&& work_item) {
+  if (period <= chrono::SystemClock::duration::zero()) {
+    return Status::InvalidArgument();
+  }
+  return InternalPushTimedWork(
+      chrono::SystemClock::TimePointAfterAtLeast(period),
+      period,
+      std::move(work_item));
+}
+
+template <size_t kInlineCallableSize>
+Status BasicWorkQueue<kInlineCallableSize>::InternalPushTimedWork(
+    chrono::SystemClock::time_point deadline,
+    chrono::SystemClock::duration period,
+    WorkItem&& work_item) {
+  {
+    std::lock_guard lock(lock_);
+
+    if (stop_requested_) {
+      // Entries are not permitted to be enqueued once stop has been requested.
+      return Status::FailedPrecondition();
+    }
+
+    // A running periodic work item needs a slot when it is rescheduled.
+    const size_t reserved = timed_work_running_ ? 1 : 0;
+    if (timed_queue_.size() + reserved >= timed_queue_.max_size()) {
+      return Status::ResourceExhausted();
+    }
+
+    timed_queue_.emplace_back(deadline, period, std::move(work_item));
+    std::push_heap(timed_queue_.begin(), timed_queue_.end(), LaterDeadline);
+
+    // Only wake the work queue thread if its wait deadline changed.
+    if (timed_queue_.front().deadline_ != deadline) {
+      return OkStatus();
+    }
+  }  // Release lock before calling .release() on the semaphore.
+  work_notification_.release();
+  return OkStatus();
+}
+
+// The default-sized work queue is instantiated in work_queue.cc.
+extern template class BasicWorkQueue<
+    function_internal::config::kInlineCallableSize>;
+
 }  // namespace pw::work_queue
@@ -0,0 +1,150 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "pw_containers/inline_deque.h"
+#include "pw_metric/metric.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_thread/thread_core.h"
+#include "pw_work_queue/work_queue.h"
+
+namespace pw::work_queue {
+
+/// A work queue that runs work items on several worker threads.
+///
+/// Each worker has its own queue. `PushWork()` distributes work items across
+/// the workers' queues in turn. A worker runs the oldest item in its own queue
+/// and, when that is empty, steals the newest item from another worker's queue,
+/// so that work queued behind a long-running item still runs promptly on an
+/// idle worker. Work items may run concurrently and in any order.
+///
+/// **Queue sizing**: Each worker's queue has a fixed capacity. Work is only
+/// rejected when every worker's queue is full. The `max_queue_used` and
+/// `min_queue_remaining` metrics track the total across all queues.
+///
+/// **Threads**: Each worker is a `pw::thread::ThreadCore` that must be run on
+/// its own thread; see `worker()`. As with `WorkQueue`, `RequestStop()` stops
+/// accepting work and lets the workers finish outstanding work and return.
+///
+/// `PushWork()`, `CheckPushWork()`, and `RequestStop()` are thread-safe and
+/// interrupt-safe.
+class WorkQueuePool {
+ public:
+  /// A worker thread's queue of work.
+  class Worker final : public thread::ThreadCore {
+   public:
+    Worker(WorkQueuePool& pool, InlineDeque<WorkItem>& queue)
+        : pool_(pool), queue_(queue) {}
+
+   private:
+    friend class WorkQueuePool;
+
+    void Run() override { pool_.RunWorker(*this); }
+
+    WorkQueuePool& pool_;
+    sync::InterruptSpinLock lock_;
+    InlineDeque<WorkItem>& queue_ PW_GUARDED_BY(lock_);
+  };
+
+  /// @param[in] workers The workers, each of which must be run on a thread.
+  ///
+  /// @param[in] queue_capacity The total capacity of the workers' queues.
+  WorkQueuePool(span<Worker> workers, size_t queue_capacity)
+      : workers_(workers),
+        capacity_(static_cast<uint32_t>(queue_capacity)),
+        stop_requested_(false) {
+    min_queue_remaining_.Set(static_cast<uint32_t>(queue_capacity));
+  }
+
+  WorkQueuePool(const WorkQueuePool&) = delete;
+  WorkQueuePool& operator=(const WorkQueuePool&) = delete;
+
+  /// Returns the number of workers in the pool.
+  size_t num_workers() const { return workers_.size(); }
+
+  /// Returns a worker to run on a thread, e.g.
+  /// `pw::thread::Thread(options, pool.worker(i))`.
+  thread::ThreadCore& worker(size_t index) { return workers_[index]; }
+
+  /// @copydoc BasicWorkQueue::PushWork
+  Status PushWork(WorkItem&& work_item) PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc BasicWorkQueue::CheckPushWork
+  void CheckPushWork(WorkItem&& work_item) PW_LOCKS_EXCLUDED(lock_);
+
+  /// Stops accepting further work. Each worker returns once no outstanding
+  /// work remains.
+  void RequestStop() PW_LOCKS_EXCLUDED(lock_);
+
+ private:
+  void RunWorker(Worker& worker) PW_LOCKS_EXCLUDED(lock_);
+
+  // Takes the next work item for `worker`, stealing from the other workers if
+  // its own queue is empty. Returns `std::nullopt` if no work remains after a
+  // stop was requested.
+  std::optional<WorkItem> TakeWork(Worker& worker) PW_LOCKS_EXCLUDED(lock_);
+
+  const span<Worker> workers_;
+  const uint32_t capacity_;
+
+  // The number of items in all workers' queues. Only changed while holding
+  // the lock of the queue that changed.
+  std::atomic<uint32_t> queued_{0};
+
+  // Released once for each work item pushed and once for each worker when
+  // stopping.
+  sync::CountingSemaphore work_available_;
+
+  sync::InterruptSpinLock lock_;
+  bool stop_requested_ PW_GUARDED_BY(lock_);
+  size_t next_worker_ PW_GUARDED_BY(lock_) = 0;
+
+  PW_METRIC_GROUP(metrics_, "pw::work_queue::WorkQueuePool");
+  PW_METRIC(metrics_, max_queue_used_, "max_queue_used", 0u);
+  PW_METRIC(metrics_, min_queue_remaining_, "min_queue_remaining", 0u);
+};
+
+/// A `WorkQueuePool` with `kWorkers` workers, each of which can queue up to
+/// `kEntriesPerWorker` work items.
+template <size_t kWorkers, size_t kEntriesPerWorker>
+class WorkQueuePoolWithBuffer : public WorkQueuePool {
+ public:
+  static_assert(kWorkers > 0u, "A WorkQueuePool needs at least one worker");
+
+  WorkQueuePoolWithBuffer()
+      : WorkQueuePool(workers_, kWorkers * kEntriesPerWorker),
+        workers_(MakeWorkers(std::make_index_sequence<kWorkers>())) {}
+
+ private:
+  template <size_t... kIndices>
+  std::array<Worker, kWorkers> MakeWorkers(std::index_sequence<kIndices...>) {
+    return {{Worker(*this, queues_[kIndices])...}};
+  }
+
+  std::array<InlineDeque<WorkItem, kEntriesPerWorker>, kWorkers> queues_;
+  std::array<Worker, kWorkers> workers_;
+};
+
+}  // namespace pw::work_queue
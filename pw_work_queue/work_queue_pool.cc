@@ -0,0 +1,127 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_work_queue/work_queue_pool.h"
+
+#include <mutex>
+
+#include "pw_assert/check.h"
+
+namespace pw::work_queue {
+
+void WorkQueuePool::RequestStop() {
+  {
+    std::lock_guard lock(lock_);
+    if (stop_requested_) {
+      return;
+    }
+    stop_requested_ = true;
+  }  // Release lock before calling .release() on the semaphore.
+  // Release once per worker rather than all at once, since a backend may only
+  // wake one waiting thread per call.
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    work_available_.release();
+  }
+}
+
+void WorkQueuePool::RunWorker(Worker& worker) {
+  while (true) {
+    work_available_.acquire();
+    std::optional<WorkItem> work_item = TakeWork(worker);
+    if (!work_item.has_value()) {
+      return;  // Stop was requested and no work remains.
+    }
+    PW_CHECK(*work_item != nullptr);
+    (*work_item)();
+  }
+}
+
+std::optional<WorkItem> WorkQueuePool::TakeWork(Worker& worker) {
+  const size_t self = static_cast<size_t>(&worker - workers_.data());
+  while (true) {
+    // Prefer the oldest item in this worker's own queue. Otherwise, steal the
+    // newest item from another worker's queue.
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      Worker& victim = workers_[(self + i) % workers_.size()];
+      std::lock_guard queue_lock(victim.lock_);
+      if (victim.queue_.empty()) {
+        continue;
+      }
+      std::optional<WorkItem> work_item;
+      if (i == 0) {
+        work_item.emplace(std::move(victim.queue_.front()));
+        victim.queue_.pop_front();
+      } else {
+        work_item.emplace(std::move(victim.queue_.back()));
+        victim.queue_.pop_back();
+      }
+      queued_.fetch_sub(1);
+      return work_item;
+    }
+
+    // Each queued item was counted by the semaphore, so one is still queued
+    // unless this wakeup came from RequestStop(). The scan can miss items
+    // pushed to queues it already checked, so only give up once nothing is
+    // queued and no more work can arrive.
+    std::lock_guard lock(lock_);
+    if (stop_requested_ && queued_.load() == 0) {
+      return std::nullopt;
+    }
+  }
+}
+
+void WorkQueuePool::CheckPushWork(WorkItem&& work_item) {
+  PW_CHECK_OK(PushWork(std::move(work_item)),
+              "Failed to push work item into the work queue pool");
+}
+
+Status WorkQueuePool::PushWork(WorkItem&& work_item) {
+  {
+    std::lock_guard lock(lock_);
+
+    if (stop_requested_) {
+      // Entries are not permitted to be enqueued once stop has been requested.
+      return Status::FailedPrecondition();
+    }
+
+    // Starting with the next worker in turn, queue the work with the first
+    // worker that has room for it.
+    uint32_t queued = 0;
+    for (size_t i = 0; queued == 0 && i < workers_.size(); ++i) {
+      Worker& worker = workers_[(next_worker_ + i) % workers_.size()];
+      std::lock_guard queue_lock(worker.lock_);
+      if (!worker.queue_.full()) {
+        worker.queue_.push_back(std::move(work_item));
+        queued = queued_.fetch_add(1) + 1;
+      }
+    }
+    if (queued == 0) {
+      return Status::ResourceExhausted();
+    }
+    next_worker_ = (next_worker_ + 1) % workers_.size();
+
+    // Update the watermarks for the pool.
+    if (queued > max_queue_used_.value()) {
+      max_queue_used_.Set(queued);
+    }
+    const uint32_t queue_remaining = capacity_ - queued;
+    if (queue_remaining < min_queue_remaining_.value()) {
+      min_queue_remaining_.Set(queue_remaining);
+    }
+  }  // Release lock before calling .release() on the semaphore.
+  work_available_.release();
+  return OkStatus();
+}
+
+}  // namespace pw::work_queue
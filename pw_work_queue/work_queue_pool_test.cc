@@ -0,0 +1,131 @@
+// Copyright 2024 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_work_queue/work_queue_pool.h"
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+#include "pw_sync/counting_semaphore.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+#include "pw_work_queue/test_thread.h"
+
+namespace pw::work_queue {
+namespace {
+
+// Runs each of a pool's workers on its own thread.
+template <size_t kWorkers>
+class PoolThreads {
+ public:
+  explicit PoolThreads(WorkQueuePool& pool) {
+    for (size_t i = 0; i < kWorkers; ++i) {
+      threads_[i].emplace(test::WorkQueueThreadOptions(), pool.worker(i));
+    }
+  }
+
+  void Join() {
+    for (std::optional<thread::Thread>& thread : threads_) {
+      thread->join();
+    }
+  }
+
+ private:
+  std::array<std::optional<thread::Thread>, kWorkers> threads_;
+};
+
+TEST(WorkQueuePool, RunsAllWork) {
+  struct {
+    std::atomic<int> counter = 0;
+    sync::CountingSemaphore done;
+  } context;
+
+  WorkQueuePoolWithBuffer<3, 4> pool;
+  EXPECT_EQ(3u, pool.num_workers());
+  PoolThreads<3> threads(pool);
+
+  // Push more work than the queues can hold at once.
+  constexpr int kWorkItems = 300;
+  for (int i = 0; i < kWorkItems; ++i) {
+    pool.CheckPushWork([&context] {
+      context.counter.fetch_add(1);
+      context.done.release();
+    });
+    // Keep the queues from overflowing.
+    if (i >= 8) {
+      context.done.acquire();
+    }
+  }
+  for (int i = 0; i < 8; ++i) {
+    context.done.acquire();
+  }
+
+  pool.RequestStop();
+  threads.Join();
+  EXPECT_EQ(kWorkItems, context.counter.load());
+}
+
+TEST(WorkQueuePool, IdleWorkerStealsFromBusyWorker) {
+  sync::ThreadNotification unblock;
+  sync::CountingSemaphore done;
+
+  WorkQueuePoolWithBuffer<2, 8> pool;
+  PoolThreads<2> threads(pool);
+
+  // Block one worker. Work queued behind it must run on the other worker.
+  pool.CheckPushWork([&unblock] { unblock.acquire(); });
+  constexpr int kWorkItems = 10;
+  for (int i = 0; i < kWorkItems; ++i) {
+    pool.CheckPushWork([&done] { done.release(); });
+  }
+  for (int i = 0; i < kWorkItems; ++i) {
+    done.acquire();
+  }
+
+  unblock.release();
+  pool.RequestStop();
+  threads.Join();
+}
+
+TEST(WorkQueuePool, PushWork_AllQueuesFull_ResourceExhausted) {
+  WorkQueuePoolWithBuffer<2, 2> pool;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(OkStatus(), pool.PushWork([] {}));
+  }
+  EXPECT_EQ(Status::ResourceExhausted(), pool.PushWork([] {}));
+
+  PoolThreads<2> threads(pool);
+  pool.RequestStop();
+  threads.Join();
+}
+
+TEST(WorkQueuePool, RequestStop_FinishesOutstandingWork) {
+  std::atomic<int> counter = 0;
+  WorkQueuePoolWithBuffer<2, 4> pool;
+  for (int i = 0; i < 6; ++i) {
+    pool.CheckPushWork([&counter] { counter.fetch_add(1); });
+  }
+  pool.RequestStop();
+  EXPECT_EQ(Status::FailedPrecondition(), pool.PushWork([] {}));
+
+  // Start the workers after the stop. They run the queued work, then return.
+  PoolThreads<2> threads(pool);
+  threads.Join();
+  EXPECT_EQ(6, counter.load());
+}
+
+}  // namespace
+}  // namespace pw::work_queue
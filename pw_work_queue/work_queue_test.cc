@@ -14,6 +14,11 @@
 
 #include "pw_work_queue/work_queue.h"
 
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
 #include "pw_function/function.h"
 #include "pw_log/log.h"
 #include "pw_sync/thread_notification.h"
@@ -24,6 +29,9 @@
 namespace pw::work_queue {
 namespace {
 
+using namespace std::chrono_literals;
+using chrono::SystemClock;
+
 TEST(WorkQueue, PingPongOneRequestType) {
   struct {
     int counter = 0;
@@ -117,6 +125,128 @@ TEST(WorkQueue, PingPongTwoRequestTypesWithExtraRequests) {
   EXPECT_EQ(context_b.counter, kPingPongs);
 }
 
+TEST(WorkQueue, PushWorkAt_RunsInDeadlineOrder) {
+  struct {
+    int order[3] = {};
+    int next = 0;
+    sync::ThreadNotification done;
+  } context;
+
+  WorkQueueWithBuffer<4, 4> work_queue;
+  thread::Thread work_thread(test::WorkQueueThreadOptions(), work_queue);
+
+  const SystemClock::time_point start = SystemClock::now();
+  EXPECT_EQ(OkStatus(),
+            work_queue.PushWorkAt(start + SystemClock::for_at_least(30ms),
+                                  [&context] {
+                                    context.order[context.next++] = 2;
+                                    context.done.release();
+                                  }));
+  EXPECT_EQ(OkStatus(),
+            work_queue.PushWorkAt(start + SystemClock::for_at_least(10ms),
+                                  [&context] {
+                                    context.order[context.next++] = 1;
+                                  }));
+  EXPECT_EQ(OkStatus(), work_queue.PushWork([&context] {
+    context.order[context.next++] = 0;
+  }));
+
+  context.done.acquire();
+  EXPECT_GE(SystemClock::now() - start, SystemClock::for_at_least(30ms));
+  EXPECT_EQ(context.order[0], 0);
+  EXPECT_EQ(context.order[1], 1);
+  EXPECT_EQ(context.order[2], 2);
+
+  work_queue.RequestStop();
+  work_thread.join();
+}
+
+TEST(WorkQueue, PushWorkEvery_RunsRepeatedly) {
+  struct {
+    int counter = 0;
+    sync::ThreadNotification done;
+  } context;
+
+  WorkQueueWithBuffer<4, 1> work_queue;
+  thread::Thread work_thread(test::WorkQueueThreadOptions(), work_queue);
+
+  const SystemClock::time_point start = SystemClock::now();
+  EXPECT_EQ(OkStatus(),
+            work_queue.PushWorkEvery(SystemClock::for_at_least(5ms),
+                                     [&context] {
+                                       if (++context.counter == 3) {
+                                         context.done.release();
+                                       }
+                                     }));
+  // The periodic work item keeps its slot while it is scheduled.
+  EXPECT_EQ(Status::ResourceExhausted(),
+            work_queue.PushWorkAt(start, [] {}));
+
+  context.done.acquire();
+  EXPECT_GE(SystemClock::now() - start, SystemClock::for_at_least(15ms));
+
+  work_queue.RequestStop();
+  work_thread.join();
+  EXPECT_GE(context.counter, 3);
+}
+
+TEST(WorkQueue, PushWorkEvery_NonPositivePeriod_InvalidArgument) {
+  WorkQueueWithBuffer<4, 1> work_queue;
+  EXPECT_EQ(Status::InvalidArgument(),
+            work_queue.PushWorkEvery(SystemClock::duration::zero(), [] {}));
+}
+
+TEST(WorkQueue, PushWorkAt_NoTimedStorage_ResourceExhausted) {
+  WorkQueueWithBuffer<4> work_queue;
+  EXPECT_EQ(Status::ResourceExhausted(),
+            work_queue.PushWorkAt(SystemClock::now(), [] {}));
+}
+
+TEST(WorkQueue, RequestStop_DiscardsTimedWorkNotYetDue) {
+  bool ran = false;
+  WorkQueueWithBuffer<4, 2> work_queue;
+  thread::Thread work_thread(test::WorkQueueThreadOptions(), work_queue);
+
+  const SystemClock::time_point deadline =
+      SystemClock::TimePointAfterAtLeast(SystemClock::for_at_least(1h));
+  EXPECT_EQ(OkStatus(),
+            work_queue.PushWorkAt(deadline, [&ran] { ran = true; }));
+  work_queue.RequestStop();
+  work_thread.join();
+
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(Status::FailedPrecondition(),
+            work_queue.PushWorkAt(SystemClock::now(), [] {}));
+}
+
+TEST(WorkQueue, InlineCallableSize_StoresLargerCaptures) {
+  struct {
+    std::array<uint32_t, 4> values = {1, 2, 3, 4};
+    uint32_t sum = 0;
+    sync::ThreadNotification done;
+  } context;
+
+  // Each work item stores a pointer and a copy of the values inline.
+  constexpr size_t kCallableSize = sizeof(void*) + sizeof(context.values);
+  WorkQueueWithBuffer<4, 0, kCallableSize> work_queue;
+  BasicWorkQueue<kCallableSize>& generic_work_queue = work_queue;
+  thread::Thread work_thread(test::WorkQueueThreadOptions(), work_queue);
+
+  EXPECT_EQ(OkStatus(),
+            generic_work_queue.PushWork(
+                [&context, values = context.values] {
+                  for (uint32_t value : values) {
+                    context.sum += value;
+                  }
+                  context.done.release();
+                }));
+  context.done.acquire();
+  EXPECT_EQ(context.sum, 10u);
+
+  work_queue.RequestStop();
+  work_thread.join();
+}
+
 // TODO(ewout): Add unit tests for the metrics once they have been restructured.
 
 }  // namespace
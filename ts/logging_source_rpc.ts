@@ -27,9 +27,9 @@ export class PigweedRPCLogSource extends LogSource {
       this.detokenizer = new Detokenizer(tokenDB);
     }
     this.call = device.rpcs.pw.log.Logs.Listen((msg: any) => {
-      msg
-        .getEntriesList()
-        .forEach((entry: any) => this.processFrame(entry.getMessage()));
+      this.processFrames(
+        msg.getEntriesList().map((entry: any) => entry.getMessage()),
+      );
     });
   }
 
@@ -37,17 +37,20 @@ export class PigweedRPCLogSource extends LogSource {
     this.call.cancel();
   }
 
-  private processFrame(frame: Uint8Array) {
-    let entry: LogEntry;
+  // Decodes all entries from one RPC response together.
+  private processFrames(frames: Uint8Array[]) {
+    let messages: string[];
     if (this.detokenizer) {
-      const detokenized = this.detokenizer.detokenizeUint8Array(frame);
-      entry = this.parseLogMsg(detokenized);
+      messages = this.detokenizer.detokenizeUint8Arrays(frames);
     } else {
-      const decoded = new TextDecoder().decode(frame);
-      entry = this.parseLogMsg(decoded);
+      const decoder = new TextDecoder();
+      messages = frames.map((frame) => decoder.decode(frame));
+    }
+    for (const message of messages) {
+      const entry = this.parseLogMsg(message);
+      this.logs.push(entry);
+      this.publishLogEntry(entry);
     }
-    this.logs = [...this.logs, entry];
-    this.publishLogEntry(entry);
   }
 
   private parseLogMsg(msg: string): LogEntry {